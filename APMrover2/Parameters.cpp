@@ -701,6 +701,19 @@ const AP_Param::GroupInfo ParametersG2::var_info[] = {
     AP_SUBGROUPINFO(scripting, "SCR_", 41, ParametersG2, AP_Scripting),
 #endif
 
+    // @Group: OA_
+    // @Path: ../libraries/AC_Avoidance/AP_OAPathPlanner.cpp
+    AP_SUBGROUPINFO(oa, "OA_", 42, ParametersG2, AP_OAPathPlanner),
+
+    // @Param: NAV_RATE
+    // @DisplayName: Navigation rate
+    // @Description: Rate at which the waypoint navigation controller and path planner targets are updated. The steering and speed controllers still run every loop against the latest targets, so this can be set below the loop rate on vehicles with a fast loop. Set to zero to update navigation every loop
+    // @Units: Hz
+    // @Range: 0 400
+    // @Increment: 1
+    // @User: Advanced
+    AP_GROUPINFO("NAV_RATE", 43, ParametersG2, nav_rate, 0),
+
     AP_GROUPEND
 };
 
@@ -732,7 +745,8 @@ ParametersG2::ParametersG2(void)
     avoid(rover.ahrs, fence, rover.g2.proximity, &rover.g2.beacon),
     follow(),
     windvane(),
-    airspeed()
+    airspeed(),
+    oa()
 {
     AP_Param::setup_object_defaults(this, var_info);
 }
@@ -401,6 +401,11 @@ public:
     AP_Scripting scripting;
 #endif // ENABLE_SCRIPTING
 
+    // object avoidance path planning
+    AP_OAPathPlanner oa;
+
+    // rate of waypoint navigation updates, zero for every loop
+    AP_Int16 nav_rate;
 };
 
 extern const AP_Param::Info var_info[];
@@ -466,17 +466,36 @@ void Mode::calc_steering_to_waypoint(const struct Location &origin, const struct
     // record system time of call
     last_steer_to_wp_ms = AP_HAL::millis();
 
-    // Calculate the required turn of the wheels
-    // negative error = left turn
-    // positive error = right turn
-    rover.nav_controller->set_reverse(reversed);
-    rover.nav_controller->update_waypoint(origin, destination, g.waypoint_radius);
-    float desired_lat_accel = rover.nav_controller->lateral_acceleration();
-    float desired_heading = rover.nav_controller->target_bearing_cd();
-    if (reversed) {
-        desired_heading = wrap_360_cd(desired_heading + 18000);
-        desired_lat_accel *= -1.0f;
+    if (nav_update_due(origin, destination, reversed)) {
+        // Calculate the required turn of the wheels
+        // negative error = left turn
+        // positive error = right turn
+        // the object avoidance path planner may route around obstacles via
+        // an intermediate destination. While it has no result, or its result
+        // is too old, head for the destination and rely on AC_Avoid to stop
+        // short of obstacles
+        Location oa_origin = origin;
+        Location oa_destination = destination;
+        if (reversed ||
+            g2.oa.mission_avoidance(rover.current_loc, origin, destination, oa_origin, oa_destination) != AP_OAPathPlanner::OA_SUCCESS) {
+            oa_origin = origin;
+            oa_destination = destination;
+        }
+
+        rover.nav_controller->set_reverse(reversed);
+        rover.nav_controller->update_waypoint(oa_origin, oa_destination, g.waypoint_radius);
+        _nav.lat_accel = rover.nav_controller->lateral_acceleration();
+        _nav.heading_cd = rover.nav_controller->target_bearing_cd();
+        if (reversed) {
+            _nav.heading_cd = wrap_360_cd(_nav.heading_cd + 18000);
+            _nav.lat_accel *= -1.0f;
+        }
     }
+
+    // the steering controllers below run every loop against the latest
+    // navigation targets
+    float desired_lat_accel = _nav.lat_accel;
+    float desired_heading = _nav.heading_cd;
     _yaw_error_cd = wrap_180_cd(desired_heading - ahrs.yaw_sensor);
 
     if (rover.sailboat_use_indirect_route(desired_heading)) {
@@ -492,6 +511,29 @@ void Mode::calc_steering_to_waypoint(const struct Location &origin, const struct
     }
 }
 
+/*
+  return true if the navigation targets should be updated this loop,
+  which they are at NAV_RATE, or straight away on a new path or a
+  change of direction
+*/
+bool Mode::nav_update_due(const struct Location &origin, const struct Location &destination, bool reversed)
+{
+    const uint32_t now_us = AP_HAL::micros();
+    const uint16_t rate_hz = g2.nav_rate > 0 ? (uint16_t)g2.nav_rate : 0;
+    if (rate_hz != 0 &&
+        now_us - _nav.last_update_us < 1000000UL / rate_hz &&
+        reversed == _nav.reversed &&
+        origin.same_latlon_as(_nav.origin) &&
+        destination.same_latlon_as(_nav.destination)) {
+        return false;
+    }
+    _nav.last_update_us = now_us;
+    _nav.origin = origin;
+    _nav.destination = destination;
+    _nav.reversed = reversed;
+    return true;
+}
+
 /*
     calculate steering output given lateral_acceleration
 */
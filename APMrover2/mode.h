@@ -218,6 +218,20 @@ protected:
     float _speed_error;         // ground speed error in m/s
     uint32_t last_steer_to_wp_ms;   // system time of last call to calc_steering_to_waypoint
     bool _reversed;             // execute the mission by backing up
+
+    // navigation targets from the last navigation update, used by
+    // calc_steering_to_waypoint until the next update is due
+    struct {
+        uint32_t last_update_us;
+        Location origin;
+        Location destination;
+        bool reversed;
+        float lat_accel;
+        float heading_cd;
+    } _nav;
+
+    // return true if calc_steering_to_waypoint should update navigation this loop
+    bool nav_update_due(const struct Location &origin, const struct Location &destination, bool reversed);
 };
 
 
@@ -98,6 +98,9 @@ void Rover::init_ardupilot()
     // init proximity sensor
     init_proximity();
 
+    // start the object avoidance path planner
+    g2.oa.init();
+
     // init beacons used for non-gps position estimation
     init_beacon();
 
@@ -59,6 +59,7 @@
 #include <AP_OpticalFlow/AP_OpticalFlow.h>
 #include <AP_RangeFinder/AP_RangeFinder.h>
 #include <AP_Beacon/AP_Beacon.h>
+#include <AP_RTC/JitterCorrection.h>
 #include <AP_Common/AP_FWVersion.h>
 
 // Configuration
@@ -169,10 +170,11 @@ private:
         bool location_valid;    // true if we have a valid location for the vehicle
         Location location;      // lat, long in degrees * 10^7; alt in meters * 100
         Location location_estimate; // lat, long in degrees * 10^7; alt in meters * 100
-        uint32_t last_update_us;    // last position update in microseconds
+        uint32_t last_update_us;    // local time the last position was taken at in microseconds
         uint32_t last_update_ms;    // last position update in milliseconds
         Vector3f vel;           // the vehicle's velocity in m/s
         int32_t relative_alt;	// the vehicle's relative altitude in meters * 100
+        JitterCorrection lag_correction;    // maps the vehicle's position timestamps to local time
     } vehicle;
 
     // Navigation controller state
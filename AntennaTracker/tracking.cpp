@@ -134,6 +134,12 @@ void Tracker::update_tracking(void)
 
 /**
    handle an updated position from the aircraft
+
+   the position is timestamped with the vehicle's time_boot_ms mapped
+   to local time, so update_vehicle_pos_estimate() projects it forward
+   from when it was taken rather than from when it arrived. Over a
+   link with variable latency this stops the estimate jumping back and
+   forth with each packet
  */
 void Tracker::tracking_update_position(const mavlink_global_position_int_t &msg)
 {
@@ -142,7 +148,7 @@ void Tracker::tracking_update_position(const mavlink_global_position_int_t &msg)
     vehicle.location.alt = msg.alt/10;
     vehicle.relative_alt = msg.relative_alt/10;
     vehicle.vel = Vector3f(msg.vx/100.0f, msg.vy/100.0f, msg.vz/100.0f);
-    vehicle.last_update_us = AP_HAL::micros();
+    vehicle.last_update_us = vehicle.lag_correction.correct_offboard_timestamp_usec(msg.time_boot_ms*1000ULL, AP_HAL::micros64());
     vehicle.last_update_ms = AP_HAL::millis();
     // log vehicle as GPS2
     if (should_log(MASK_LOG_GPS)) {
@@ -104,9 +104,6 @@ const AP_Scheduler::Task Copter::scheduler_tasks[] = {
 #endif
 #if BEACON_ENABLED == ENABLED
     SCHED_TASK_CLASS(AP_Beacon,            &copter.g2.beacon,           update,         400,  50),
-#endif
-#if VISUAL_ODOMETRY_ENABLED == ENABLED
-    SCHED_TASK_CLASS(AP_VisualOdom,       &copter.g2.visual_odom,        update,         400,  50),
 #endif
     SCHED_TASK(update_altitude,       10,    100),
     SCHED_TASK(run_nav_updates,       50,    100),
@@ -164,7 +161,7 @@ const AP_Scheduler::Task Copter::scheduler_tasks[] = {
     SCHED_TASK(afs_fs_check,          10,    100),
 #endif
 #if AC_TERRAIN == ENABLED
-    SCHED_TASK(terrain_update,        10,    100),
+    SCHED_TASK_CLASS_ASYNC(Copter, &copter, terrain_update, 10, 100),
 #endif
 #if GRIPPER_ENABLED == ENABLED
     SCHED_TASK_CLASS(AP_Gripper,           &copter.g2.gripper,          update,          10,  75),
@@ -225,11 +222,16 @@ void Copter::fast_loop()
     // update INS immediately to get current gyro data populated
     ins.update();
 
-    // run low level rate controllers that only require IMU data
-    attitude_control->rate_controller_run();
+    if (!using_fast_rate_thread()) {
+        // run low level rate controllers that only require IMU data
+        attitude_control->rate_controller_run();
+
+        // send outputs to the motors library immediately
+        motors_output(ins.get_gyro_sample_us());
+    }
 
-    // send outputs to the motors library immediately
-    motors_output();
+    // move the gyro harmonic notch to follow the motors
+    update_dynamic_notch();
 
     // run EKF state estimator (expensive)
     // --------------------
@@ -246,6 +248,11 @@ void Copter::fast_loop()
     // check if ekf has reset target heading or position
     check_ekf_reset();
 
+#if PRECISION_LANDING == ENABLED
+    // record the IMU sample for the precision landing target estimator
+    precland.update_inertial();
+#endif
+
     // run the attitude controllers
     update_flight_mode();
 
@@ -255,6 +262,9 @@ void Copter::fast_loop()
     // check if we've landed or crashed
     update_land_and_crash_detectors();
 
+    // send high rate telemetry subscriptions
+    gcs().update_high_rate_send();
+
 #if MOUNT == ENABLED
     // camera mount's fast update
     camera_mount.update_fast();
@@ -409,6 +419,9 @@ void Copter::three_hz_loop()
 
     // update ch6 in flight tuning
     tuning();
+
+    // sample the throttle for the motor time statistics
+    g2.stats.set_motor_throttle(motors->armed() ? motors->get_throttle() : -1);
 }
 
 // one_hz_loop - runs at 1Hz
@@ -54,6 +54,8 @@
 #include <AP_Stats/AP_Stats.h>     // statistics library
 #include <AP_RSSI/AP_RSSI.h>                   // RSSI Library
 #include <Filter/Filter.h>             // Filter library
+#include <Filter/FrequencyResponse.h>
+#include <AP_Math/chirp.h>
 #include <AP_Relay/AP_Relay.h>           // APM relay
 #include <AP_ServoRelayEvents/AP_ServoRelayEvents.h>
 #include <AP_Airspeed/AP_Airspeed.h>        // needed for AHRS build
@@ -67,6 +69,7 @@
 #include <AP_RCMapper/AP_RCMapper.h>        // RC input mapping library
 #include <AP_Notify/AP_Notify.h>          // Notify library
 #include <AP_BattMonitor/AP_BattMonitor.h>     // Battery monitor library
+#include <AP_ESC_Telem/AP_ESC_Telem.h>         // ESC telemetry library
 #include <AP_BoardConfig/AP_BoardConfig.h>     // board configuration library
 #include <AP_BoardConfig/AP_BoardConfig_CAN.h>
 #include <AP_LandingGear/AP_LandingGear.h>     // Landing Gear library
@@ -407,6 +410,21 @@ private:
     int32_t baro_alt;            // barometer altitude in cm above home
     LowPassFilterVector3f land_accel_ef_filter; // accelerations for land and crash detector tests
 
+    // vehicle state shared by the land, crash, thrust loss and parachute
+    // checks and the throttle mix, updated once a loop by update_vehicle_state()
+    struct {
+        float accel_ef_length;      // earth frame acceleration with gravity removed in m/s/s
+        float accel_ef_filt_length; // land_accel_ef_filter's output in m/s/s
+        float att_error_deg;        // attitude controller's angle error in degrees
+        Vector3f att_target_cd;     // attitude controller's target euler angles in centi-degrees
+        float throttle_in;          // attitude controller's throttle input
+        float climb_rate_cms;       // inertial nav's vertical velocity in cm/s
+        // EKF variances, updated by ekf_check() at 10hz
+        float vel_variance;
+        float position_variance;
+        float mag_variance;
+    } vehicle_state;
+
     // filtered pilot's throttle input used to cancel landing if throttle held high
     LowPassFilterFloat rc_throttle_control_in_filter;
 
@@ -448,6 +466,19 @@ private:
     // Reference to the relay object
     AP_Relay relay;
 
+#if FAST_RATE_THREAD == ENABLED
+    // rate control thread state and timing since the last FRT log
+    struct {
+        bool active;
+        float rate_hz;
+        uint32_t samples;
+        uint32_t skipped;
+        uint32_t latency_sum_us;
+        uint32_t latency_max_us;
+        uint32_t last_log_ms;
+    } fast_rate;
+#endif
+
     // handle repeated servo and relay events
     AP_ServoRelayEvents ServoRelayEvents{relay};
 
@@ -701,6 +732,8 @@ private:
     void read_inertia();
 
     // landing_detector.cpp
+    void update_vehicle_state();
+    void update_vehicle_state_ekf();
     void update_land_and_crash_detectors();
     void update_land_detector();
     void set_land_complete(bool b);
@@ -729,6 +762,9 @@ private:
 #endif
     void Log_Write_Precland();
     void Log_Write_GuidedTarget(uint8_t target_type, const Vector3f& pos_target, const Vector3f& vel_target);
+    void Log_Write_Fast_Rate(float rate_hz, uint32_t skipped, uint32_t latency_avg_us, uint32_t latency_max_us);
+    void Log_Write_SysID_Data(float waveform_time, float waveform_sample, float waveform_freq, float input, float output);
+    void Log_Write_SysID_Result(uint8_t axis, uint8_t band, float frequency_hz, float gain, float phase_deg);
     void Log_Write_Vehicle_Startup_Messages();
     void log_init(void);
 
@@ -752,9 +788,14 @@ private:
     void auto_disarm_check();
     bool init_arm_motors(AP_Arming::Method method, bool do_arming_checks=true);
     void init_disarm_motors();
-    void motors_output();
+    void motors_output(uint64_t gyro_sample_us);
     void lost_vehicle_check();
 
+    // rate_thread.cpp
+    void fast_rate_thread_start();
+    void rate_controller_thread();
+    bool using_fast_rate_thread() const;
+
     // navigation.cpp
     void run_nav_updates(void);
     int32_t home_bearing();
@@ -787,6 +828,7 @@ private:
     void read_rangefinder(void);
     bool rangefinder_alt_ok();
     void rpm_update();
+    void update_dynamic_notch();
     void init_compass_location();
     void init_optflow();
     void update_optical_flow(void);
@@ -919,6 +961,9 @@ private:
 #if MODE_ZIGZAG_ENABLED == ENABLED
     ModeZigZag mode_zigzag;
 #endif
+#if MODE_SYSTEMID_ENABLED == ENABLED
+    ModeSystemId mode_systemid;
+#endif
 
     // mode.cpp
     Mode *mode_from_mode_num(const uint8_t mode);
@@ -1,4 +1,5 @@
 #include "Copter.h"
+#include <new>
 
 #if LOGGING_ENABLED == ENABLED
 
@@ -380,6 +381,86 @@ void Copter::Log_Write_GuidedTarget(uint8_t target_type, const Vector3f& pos_tar
     logger.WriteBlock(&pkt, sizeof(pkt));
 }
 
+#if FAST_RATE_THREAD == ENABLED
+struct PACKED log_Fast_Rate {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    float rate_hz;
+    uint32_t skipped;
+    uint32_t latency_avg_us;
+    uint32_t latency_max_us;
+};
+
+// Write the rate thread's rate and its gyro to motor latency
+void Copter::Log_Write_Fast_Rate(float rate_hz, uint32_t skipped, uint32_t latency_avg_us, uint32_t latency_max_us)
+{
+    struct log_Fast_Rate pkt = {
+        LOG_PACKET_HEADER_INIT(LOG_FAST_RATE_MSG),
+        time_us         : AP_HAL::micros64(),
+        rate_hz         : rate_hz,
+        skipped         : skipped,
+        latency_avg_us  : latency_avg_us,
+        latency_max_us  : latency_max_us
+    };
+    logger.WriteBlock(&pkt, sizeof(pkt));
+}
+#endif
+
+#if MODE_SYSTEMID_ENABLED == ENABLED
+struct PACKED log_SysIdD {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    float    waveform_time;
+    float    waveform_sample;
+    float    waveform_freq;
+    float    input;
+    float    output;
+};
+
+// Write the system identification waveform and response, at the loop
+// rate, straight into the logger's buffer
+void Copter::Log_Write_SysID_Data(float waveform_time, float waveform_sample, float waveform_freq, float input, float output)
+{
+    struct log_SysIdD fallback;
+    void *buf = logger.ReserveBlock(&fallback, sizeof(fallback));
+    new (buf) log_SysIdD {
+        LOG_PACKET_HEADER_INIT(LOG_SYSID_DATA_MSG),
+        time_us         : AP_HAL::micros64(),
+        waveform_time   : waveform_time,
+        waveform_sample : waveform_sample,
+        waveform_freq   : waveform_freq,
+        input           : input,
+        output          : output
+    };
+    logger.CommitBlock(buf, sizeof(fallback));
+}
+
+struct PACKED log_SysIdR {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t  axis;
+    uint8_t  band;
+    float    frequency_hz;
+    float    gain;
+    float    phase_deg;
+};
+
+// Write the system identification frequency response at a band
+void Copter::Log_Write_SysID_Result(uint8_t axis, uint8_t band, float frequency_hz, float gain, float phase_deg)
+{
+    struct log_SysIdR pkt = {
+        LOG_PACKET_HEADER_INIT(LOG_SYSID_RESULT_MSG),
+        time_us         : AP_HAL::micros64(),
+        axis            : axis,
+        band            : band,
+        frequency_hz    : frequency_hz,
+        gain            : gain,
+        phase_deg       : phase_deg
+    };
+    logger.WriteCriticalBlock(&pkt, sizeof(pkt));
+}
+#endif
+
 // type and unit information can be found in
 // libraries/AP_Logger/Logstructure.h; search for "log_Units" for
 // units and "Format characters" for field type information
@@ -411,6 +492,16 @@ const struct LogStructure Copter::log_structure[] = {
 #endif
     { LOG_GUIDEDTARGET_MSG, sizeof(log_GuidedTarget),
       "GUID",  "QBffffff",    "TimeUS,Type,pX,pY,pZ,vX,vY,vZ", "s-mmmnnn", "F-000000" },
+#if FAST_RATE_THREAD == ENABLED
+    { LOG_FAST_RATE_MSG, sizeof(log_Fast_Rate),
+      "FRT",   "QfIII",      "TimeUS,Rate,Skip,LatA,LatM", "sz-ss", "F--FF" },
+#endif
+#if MODE_SYSTEMID_ENABLED == ENABLED
+    { LOG_SYSID_DATA_MSG, sizeof(log_SysIdD),
+      "SIDD",  "Qfffff",      "TimeUS,Time,Targ,F,In,Out", "ss-z--", "F00000" },
+    { LOG_SYSID_RESULT_MSG, sizeof(log_SysIdR),
+      "SIDR",  "QBBfff",      "TimeUS,Axis,Band,F,Gain,Phase", "s--z-d", "F--000" },
+#endif
 };
 
 void Copter::Log_Write_Vehicle_Startup_Messages()
@@ -445,6 +536,9 @@ void Copter::Log_Write_Parameter_Tuning(uint8_t param, float tuning_val, float t
 void Copter::Log_Sensor_Health() {}
 void Copter::Log_Write_Precland() {}
 void Copter::Log_Write_GuidedTarget(uint8_t target_type, const Vector3f& pos_target, const Vector3f& vel_target) {}
+void Copter::Log_Write_Fast_Rate(float rate_hz, uint32_t skipped, uint32_t latency_avg_us, uint32_t latency_max_us) {}
+void Copter::Log_Write_SysID_Data(float waveform_time, float waveform_sample, float waveform_freq, float input, float output) {}
+void Copter::Log_Write_SysID_Result(uint8_t axis, uint8_t band, float frequency_hz, float gain, float phase_deg) {}
 void Copter::Log_Write_Vehicle_Startup_Messages() {}
 
 #if FRAME_CONFIG == HELI_FRAME
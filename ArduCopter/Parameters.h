@@ -580,12 +580,22 @@ public:
     void *autotune_ptr;
 #endif
 
+#if MODE_SYSTEMID_ENABLED == ENABLED
+    // we need a pointer to the mode for the G2 table
+    void *mode_systemid_ptr;
+#endif
+
 #ifdef ENABLE_SCRIPTING
     AP_Scripting scripting;
 #endif // ENABLE_SCRIPTING
 
     AP_Float tuning_min;
     AP_Float tuning_max;
+
+#if FAST_RATE_THREAD == ENABLED
+    AP_Int8 fast_rate_enable;
+    AP_Int8 fast_rate_div;
+#endif
 };
 
 extern const AP_Param::Info        var_info[];
@@ -247,6 +247,13 @@
  # define RPM_ENABLED !HAL_MINIMIZE_FEATURES
 #endif
 
+//////////////////////////////////////////////////////////////////////////////
+// rate control thread, running the rate controllers and motor output on
+// each gyro sample rather than at the main loop rate
+#ifndef FAST_RATE_THREAD
+ # define FAST_RATE_THREAD (FRAME_CONFIG != HELI_FRAME)
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 // Parachute release
 #ifndef PARACHUTE
@@ -361,6 +368,12 @@
 # define MODE_ZIGZAG_ENABLED !HAL_MINIMIZE_FEATURES
 #endif
 
+//////////////////////////////////////////////////////////////////////////////
+// SystemId - inject a chirp and estimate the vehicle's frequency response
+#ifndef MODE_SYSTEMID_ENABLED
+# define MODE_SYSTEMID_ENABLED !HAL_MINIMIZE_FEATURES
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 // Beacon support - support for local positioning systems
 #ifndef BEACON_ENABLED
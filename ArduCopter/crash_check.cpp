@@ -30,14 +30,13 @@ void Copter::crash_check()
     }
 
     // vehicle not crashed if 1hz filtered acceleration is more than 3m/s (1G on Z-axis has been subtracted)
-    if (land_accel_ef_filter.get().length() >= CRASH_CHECK_ACCEL_MAX) {
+    if (vehicle_state.accel_ef_filt_length >= CRASH_CHECK_ACCEL_MAX) {
         crash_counter = 0;
         return;
     }
 
     // check for angle error over 30 degrees
-    const float angle_error = attitude_control->get_att_error_angle_deg();
-    if (angle_error <= CRASH_CHECK_ANGLE_DEVIATION_DEG) {
+    if (vehicle_state.att_error_deg <= CRASH_CHECK_ANGLE_DEVIATION_DEG) {
         crash_counter = 0;
         return;
     }
@@ -75,33 +74,32 @@ void Copter::thrust_loss_check()
 
     // check for desired angle over 15 degrees
     // todo: add thrust angle to AC_AttitudeControl
-    const Vector3f angle_target = attitude_control->get_att_target_euler_cd();
+    const Vector3f &angle_target = vehicle_state.att_target_cd;
     if (sq(angle_target.x) + sq(angle_target.y) > sq(THRUST_LOSS_CHECK_ANGLE_DEVIATION_CD)) {
         thrust_loss_counter = 0;
         return;
     }
 
     // check for throttle over 90% or throttle saturation
-    if ((attitude_control->get_throttle_in() < THRUST_LOSS_CHECK_MINIMUM_THROTTLE) && (!motors->limit.throttle_upper)) {
+    if ((vehicle_state.throttle_in < THRUST_LOSS_CHECK_MINIMUM_THROTTLE) && (!motors->limit.throttle_upper)) {
         thrust_loss_counter = 0;
         return;
     }
 
     // check throttle is over 25% to prevent checks triggering from thrust limitations caused by low commanded throttle
-    if ((attitude_control->get_throttle_in() < 0.25f)) {
+    if ((vehicle_state.throttle_in < 0.25f)) {
         thrust_loss_counter = 0;
         return;
     }
 
     // check for descent
-    if (!is_negative(inertial_nav.get_velocity_z())) {
+    if (!is_negative(vehicle_state.climb_rate_cms)) {
         thrust_loss_counter = 0;
         return;
     }
 
     // check for angle error over 30 degrees to ensure the aircraft has attitude control
-    const float angle_error = attitude_control->get_att_error_angle_deg();
-    if (angle_error >= CRASH_CHECK_ANGLE_DEVIATION_DEG) {
+    if (vehicle_state.att_error_deg >= CRASH_CHECK_ANGLE_DEVIATION_DEG) {
         thrust_loss_counter = 0;
         return;
     }
@@ -169,8 +167,7 @@ void Copter::parachute_check()
     }
 
     // check for angle error over 30 degrees
-    const float angle_error = attitude_control->get_att_error_angle_deg();
-    if (angle_error <= CRASH_CHECK_ANGLE_DEVIATION_DEG) {
+    if (vehicle_state.att_error_deg <= CRASH_CHECK_ANGLE_DEVIATION_DEG) {
         if (control_loss_count > 0) {
             control_loss_count--;
         }
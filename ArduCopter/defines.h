@@ -54,6 +54,7 @@ enum control_mode_t {
     FLOWHOLD  =    22,  // FLOWHOLD holds position with optical flow without rangefinder
     FOLLOW    =    23,  // follow attempts to follow another vehicle or ground station
     ZIGZAG    =    24,  // ZIGZAG mode is able to fly in a zigzag manner with predefined point A and point B
+    SYSTEMID  =    25,  // System ID mode produces automated system identification signals in the controllers
 };
 
 enum mode_reason_t {
@@ -216,6 +217,9 @@ enum LoggingParameters {
      LOG_HELI_MSG,
      LOG_PRECLAND_MSG,
      LOG_GUIDEDTARGET_MSG,
+     LOG_FAST_RATE_MSG,
+     LOG_SYSID_DATA_MSG,
+     LOG_SYSID_RESULT_MSG,
 };
 
 #define MASK_LOG_ATTITUDE_FAST          (1<<0)
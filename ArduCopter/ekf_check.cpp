@@ -44,6 +44,7 @@ void Copter::ekf_check()
     }
 
     // compare compass and velocity variance vs threshold
+    update_vehicle_state_ekf();
     if (ekf_over_threshold()) {
         // if compass is not yet flagged as bad
         if (!ekf_check_state.bad_variance) {
@@ -92,15 +93,13 @@ bool Copter::ekf_over_threshold()
         return false;
     }
 
-    // use EKF to get variance
-    float position_variance, vel_variance, height_variance, tas_variance;
-    Vector3f mag_variance;
-    Vector2f offset;
-    ahrs.get_variances(vel_variance, position_variance, height_variance, mag_variance, tas_variance, offset);
+    // use EKF variances from the vehicle state
+    const float vel_variance = vehicle_state.vel_variance;
+    const float position_variance = vehicle_state.position_variance;
 
     // return true if two of compass, velocity and position variances are over the threshold OR velocity variance is twice the threshold
     uint8_t over_thresh_count = 0;
-    if (mag_variance.length() >= g.fs_ekf_thresh) {
+    if (vehicle_state.mag_variance >= g.fs_ekf_thresh) {
         over_thresh_count++;
     }
     if (vel_variance >= (2.0f * g.fs_ekf_thresh)) {
@@ -9,14 +9,40 @@
 // counter to verify landings
 static uint32_t land_detector_count = 0;
 
-// run land and crash detectors
+// update the vehicle state used by the detectors, so each quantity is
+// fetched once a loop and every detector sees the same values
 // called at MAIN_LOOP_RATE
-void Copter::update_land_and_crash_detectors()
+void Copter::update_vehicle_state()
 {
     // update 1hz filtered acceleration
     Vector3f accel_ef = ahrs.get_accel_ef_blended();
     accel_ef.z += GRAVITY_MSS;
     land_accel_ef_filter.apply(accel_ef, scheduler.get_loop_period_s());
+    vehicle_state.accel_ef_length = accel_ef.length();
+    vehicle_state.accel_ef_filt_length = land_accel_ef_filter.get().length();
+
+    vehicle_state.att_error_deg = attitude_control->get_att_error_angle_deg();
+    vehicle_state.att_target_cd = attitude_control->get_att_target_euler_cd();
+    vehicle_state.throttle_in = attitude_control->get_throttle_in();
+    vehicle_state.climb_rate_cms = inertial_nav.get_velocity_z();
+}
+
+// update the EKF variances of the vehicle state
+// called at 10hz by ekf_check()
+void Copter::update_vehicle_state_ekf()
+{
+    float height_variance, tas_variance;
+    Vector3f mag_variance;
+    Vector2f offset;
+    ahrs.get_variances(vehicle_state.vel_variance, vehicle_state.position_variance, height_variance, mag_variance, tas_variance, offset);
+    vehicle_state.mag_variance = mag_variance.length();
+}
+
+// run land and crash detectors
+// called at MAIN_LOOP_RATE
+void Copter::update_land_and_crash_detectors()
+{
+    update_vehicle_state();
 
     update_land_detector();
 
@@ -65,10 +91,10 @@ void Copter::update_land_detector()
 #endif
 
         // check that the airframe is not accelerating (not falling or braking after fast forward flight)
-        bool accel_stationary = (land_accel_ef_filter.get().length() <= LAND_DETECTOR_ACCEL_MAX);
+        bool accel_stationary = (vehicle_state.accel_ef_filt_length <= LAND_DETECTOR_ACCEL_MAX);
 
         // check that vertical speed is within 1m/s of zero
-        bool descent_rate_low = fabsf(inertial_nav.get_velocity_z()) < 100;
+        bool descent_rate_low = fabsf(vehicle_state.climb_rate_cms) < 100;
 
         // if we have a healthy rangefinder only allow landing detection below 2 meters
         bool rangefinder_check = (!rangefinder_alt_ok() || rangefinder_state.alt_cm_filt.get() < LAND_RANGEFINDER_MIN_ALT_CM);
@@ -157,17 +183,14 @@ void Copter::update_throttle_thr_mix()
         // autopilot controlled throttle
 
         // check for aggressive flight requests - requested roll or pitch angle below 15 degrees
-        const Vector3f angle_target = attitude_control->get_att_target_euler_cd();
+        const Vector3f &angle_target = vehicle_state.att_target_cd;
         bool large_angle_request = (norm(angle_target.x, angle_target.y) > LAND_CHECK_LARGE_ANGLE_CD);
 
         // check for large external disturbance - angle error over 30 degrees
-        const float angle_error = attitude_control->get_att_error_angle_deg();
-        bool large_angle_error = (angle_error > LAND_CHECK_ANGLE_ERROR_DEG);
+        bool large_angle_error = (vehicle_state.att_error_deg > LAND_CHECK_ANGLE_ERROR_DEG);
 
         // check for large acceleration - falling or high turbulence
-        Vector3f accel_ef = ahrs.get_accel_ef_blended();
-        accel_ef.z += GRAVITY_MSS;
-        bool accel_moving = (accel_ef.length() > LAND_CHECK_ACCEL_MOVING);
+        bool accel_moving = (vehicle_state.accel_ef_length > LAND_CHECK_ACCEL_MOVING);
 
         // check for requested decent
         bool descent_not_demanded = pos_control->get_desired_velocity().z >= 0.0f;
@@ -160,6 +160,12 @@ Copter::Mode *Copter::mode_from_mode_num(const uint8_t mode)
             break;
 #endif
 
+#if MODE_SYSTEMID_ENABLED == ENABLED
+        case SYSTEMID:
+            ret = (Copter::Mode *)g2.mode_systemid_ptr;
+            break;
+#endif
+
         default:
             break;
     }
@@ -308,6 +314,13 @@ void Copter::exit_mode(Copter::Mode *&old_flightmode,
     }
 #endif
 
+#if MODE_SYSTEMID_ENABLED == ENABLED
+    // report the results of a test cut short
+    if (old_flightmode == &mode_systemid) {
+        mode_systemid.exit();
+    }
+#endif
+
 #if FRAME_CONFIG == HELI_FRAME
     // firmly reset the flybar passthrough to false when exiting acro mode.
     if (old_flightmode == &mode_acro) {
@@ -1230,3 +1230,65 @@ private:
 
     uint32_t reach_wp_time_ms = 0;  // time since vehicle reached destination (or zero if not yet reached)
 };
+
+#if MODE_SYSTEMID_ENABLED == ENABLED
+/*
+  class to support SYSTEMID mode, which flies as stabilize while
+  injecting a chirp into one axis and measuring its frequency response
+ */
+class ModeSystemId : public Mode {
+
+public:
+    // need a constructor for parameters
+    ModeSystemId(void);
+
+    bool init(bool ignore_checks) override;
+    void run() override;
+    void exit();
+
+    bool requires_GPS() const override { return false; }
+    bool has_manual_throttle() const override { return true; }
+    bool allows_arming(bool from_gcs) const override { return false; };
+    bool is_autopilot() const override { return false; }
+
+    static const struct AP_Param::GroupInfo var_info[];
+
+protected:
+
+    const char *name() const override { return "SYSTEMID"; }
+    const char *name4() const override { return "SYSI"; }
+
+private:
+
+    void stop(const char *reason);
+
+    enum class AxisType : uint8_t {
+        NONE = 0,           // none
+        INPUT_ROLL = 1,     // angle input roll axis is being excited
+        INPUT_PITCH = 2,    // angle pitch axis is being excited
+        INPUT_YAW = 3,      // angle yaw axis is being excited
+        RATE_ROLL = 4,      // rate roll axis is being excited
+        RATE_PITCH = 5,     // rate pitch axis is being excited
+        RATE_YAW = 6,       // rate yaw axis is being excited
+    };
+
+    AP_Int8 axis;               // Controls which axis are being excited
+    AP_Float waveform_magnitude;// Magnitude of chirp waveform
+    AP_Float frequency_start;   // Frequency at the start of the chirp
+    AP_Float frequency_stop;    // Frequency at the end of the chirp
+    AP_Float time_fade_in;      // Time to reach maximum amplitude of chirp
+    AP_Float time_record;       // Time taken to complete the chirp waveform
+    AP_Float time_fade_out;     // Time to reach zero amplitude after chirp finishes
+
+    Chirp chirp;
+    FrequencyResponse response;
+
+    float waveform_time;        // Time reference for waveform
+    float waveform_sample;      // Current waveform sample
+
+    enum class SystemIDModeState {
+        Testing,
+        Stopped,
+    } state;
+};
+#endif
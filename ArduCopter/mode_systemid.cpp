@@ -0,0 +1,273 @@
+#include "Copter.h"
+
+#if MODE_SYSTEMID_ENABLED == ENABLED
+
+/*
+  implement SYSTEMID mode, which injects a chirp into one axis of the
+  attitude or rate controller while the pilot flies as in stabilize,
+  logs the response at the loop rate and estimates the frequency
+  response of the axis on board
+ */
+
+const AP_Param::GroupInfo Copter::ModeSystemId::var_info[] = {
+
+    // @Param: _AXIS
+    // @DisplayName: System identification axis
+    // @Description: Controls which axis the chirp is injected into. Input axes add it to the pilot's angle or yaw rate demand, rate axes add it to the body frame rate target
+    // @Values: 0:None,1:Input Roll Angle,2:Input Pitch Angle,3:Input Yaw Rate,4:Rate Roll,5:Rate Pitch,6:Rate Yaw
+    // @User: Standard
+    AP_GROUPINFO_FLAGS("_AXIS", 1, Copter::ModeSystemId, axis, 0, AP_PARAM_FLAG_ENABLE),
+
+    // @Param: _MAGNITUDE
+    // @DisplayName: System identification chirp magnitude
+    // @Description: Peak magnitude of the chirp, in degrees for angle axes and degrees per second for rate axes
+    // @Range: 1 30
+    // @User: Standard
+    AP_GROUPINFO("_MAGNITUDE", 2, Copter::ModeSystemId, waveform_magnitude, 15),
+
+    // @Param: _F_START_HZ
+    // @DisplayName: System identification start frequency
+    // @Description: Frequency at the start of the chirp
+    // @Range: 0.01 100
+    // @Units: Hz
+    // @User: Standard
+    AP_GROUPINFO("_F_START_HZ", 3, Copter::ModeSystemId, frequency_start, 0.5f),
+
+    // @Param: _F_STOP_HZ
+    // @DisplayName: System identification stop frequency
+    // @Description: Frequency at the end of the chirp
+    // @Range: 0.01 100
+    // @Units: Hz
+    // @User: Standard
+    AP_GROUPINFO("_F_STOP_HZ", 4, Copter::ModeSystemId, frequency_stop, 40),
+
+    // @Param: _T_FADE_IN
+    // @DisplayName: System identification fade in time
+    // @Description: Time at the start of the chirp over which its magnitude rises from zero
+    // @Range: 0 20
+    // @Units: s
+    // @User: Standard
+    AP_GROUPINFO("_T_FADE_IN", 5, Copter::ModeSystemId, time_fade_in, 5),
+
+    // @Param: _T_REC
+    // @DisplayName: System identification sweep time
+    // @Description: Time over which the chirp sweeps from the start to the stop frequency
+    // @Range: 0 255
+    // @Units: s
+    // @User: Standard
+    AP_GROUPINFO("_T_REC", 6, Copter::ModeSystemId, time_record, 70),
+
+    // @Param: _T_FADE_OUT
+    // @DisplayName: System identification fade out time
+    // @Description: Time at the end of the chirp over which its magnitude falls to zero
+    // @Range: 0 5
+    // @Units: s
+    // @User: Standard
+    AP_GROUPINFO("_T_FADE_OUT", 7, Copter::ModeSystemId, time_fade_out, 2),
+
+    AP_GROUPEND
+};
+
+Copter::ModeSystemId::ModeSystemId(void) : Mode()
+{
+    AP_Param::setup_object_defaults(this, var_info);
+}
+
+// systemid_init - initialise systemid controller
+bool Copter::ModeSystemId::init(bool ignore_checks)
+{
+    if (!motors->armed() || !ap.auto_armed || ap.land_complete) {
+        gcs().send_text(MAV_SEVERITY_WARNING, "SystemID: must be flying");
+        return false;
+    }
+    if ((AxisType)axis.get() == AxisType::NONE) {
+        gcs().send_text(MAV_SEVERITY_WARNING, "SystemID: SID_AXIS not set");
+        return false;
+    }
+
+    // the start frequency is held for two cycles so the response
+    // settles before the sweep
+    chirp.init(time_record, frequency_start, frequency_stop, time_fade_in, time_fade_out, 2.0f / MAX(frequency_start, 0.01f));
+    response.init(frequency_start, frequency_stop, FREQUENCY_RESPONSE_MAX_BANDS, copter.scheduler.get_loop_rate_hz());
+    waveform_time = 0;
+    waveform_sample = 0;
+    state = SystemIDModeState::Testing;
+
+    gcs().send_text(MAV_SEVERITY_INFO, "SystemID: starting, %.0fs", (double)chirp.get_duration_s());
+    return true;
+}
+
+// systemid_run - runs the systemid controller
+// should be called at the loop rate, which the response assumes
+void Copter::ModeSystemId::run()
+{
+    // apply simple mode transform to pilot inputs
+    update_simple_mode();
+
+    // convert pilot input to lean angles
+    float target_roll, target_pitch;
+    get_pilot_desired_lean_angles(target_roll, target_pitch, copter.aparm.angle_max, copter.aparm.angle_max);
+
+    // get pilot's desired yaw rate
+    float target_yaw_rate = get_pilot_desired_yaw_rate(channel_yaw->get_control_in());
+
+    if (!motors->armed()) {
+        // Motors should be Stopped
+        motors->set_desired_spool_state(AP_Motors::DESIRED_SHUT_DOWN);
+    } else if (ap.throttle_zero) {
+        // Attempting to Land
+        motors->set_desired_spool_state(AP_Motors::DESIRED_GROUND_IDLE);
+    } else {
+        motors->set_desired_spool_state(AP_Motors::DESIRED_THROTTLE_UNLIMITED);
+    }
+
+    if (motors->get_spool_mode() == AP_Motors::SHUT_DOWN) {
+        // Motors Stopped
+        attitude_control->set_yaw_target_to_current_heading();
+        attitude_control->reset_rate_controller_I_terms();
+    } else if (motors->get_spool_mode() == AP_Motors::GROUND_IDLE) {
+        // Landed
+        attitude_control->set_yaw_target_to_current_heading();
+        attitude_control->reset_rate_controller_I_terms();
+    } else if (motors->get_spool_mode() == AP_Motors::THROTTLE_UNLIMITED) {
+        // clear landing flag above zero throttle
+        if (!motors->limit.throttle_lower) {
+            set_land_complete(false);
+        }
+    }
+
+    if (state == SystemIDModeState::Testing) {
+        if (!motors->armed() || ap.land_complete) {
+            stop("landed");
+        } else {
+            waveform_time += G_Dt;
+            waveform_sample = chirp.update(waveform_time, waveform_magnitude);
+            if (chirp.completed()) {
+                stop("complete");
+            }
+        }
+    }
+    if (state != SystemIDModeState::Testing) {
+        waveform_sample = 0;
+    }
+
+    const AxisType axis_type = (AxisType)axis.get();
+    switch (axis_type) {
+    case AxisType::INPUT_ROLL:
+        target_roll += waveform_sample * 100.0f;
+        break;
+    case AxisType::INPUT_PITCH:
+        target_pitch += waveform_sample * 100.0f;
+        break;
+    case AxisType::INPUT_YAW:
+        target_yaw_rate += waveform_sample * 100.0f;
+        break;
+    default:
+        break;
+    }
+
+    // call attitude controller
+    attitude_control->input_euler_angle_roll_pitch_euler_rate_yaw(target_roll, target_pitch, target_yaw_rate);
+
+    // rate axes are excited after the attitude controller has set its
+    // rate targets, so the chirp isn't shaped by it
+    const Vector3f rate_targets = attitude_control->rate_bf_targets();
+    switch (axis_type) {
+    case AxisType::RATE_ROLL:
+        attitude_control->rate_bf_roll_target(degrees(rate_targets.x) * 100.0f + waveform_sample * 100.0f);
+        break;
+    case AxisType::RATE_PITCH:
+        attitude_control->rate_bf_pitch_target(degrees(rate_targets.y) * 100.0f + waveform_sample * 100.0f);
+        break;
+    case AxisType::RATE_YAW:
+        attitude_control->rate_bf_yaw_target(degrees(rate_targets.z) * 100.0f + waveform_sample * 100.0f);
+        break;
+    default:
+        break;
+    }
+
+    // output pilot's throttle
+    attitude_control->set_throttle_out(get_pilot_desired_throttle(),
+                                       true,
+                                       g.throttle_filt);
+
+    if (state != SystemIDModeState::Testing) {
+        return;
+    }
+
+    // the demand on the axis and the vehicle's response to it, in
+    // degrees or degrees per second
+    const Vector3f &gyro = ahrs.get_gyro();
+    float input = 0;
+    float output = 0;
+    switch (axis_type) {
+    case AxisType::INPUT_ROLL:
+        input = target_roll * 0.01f;
+        output = degrees(ahrs.roll);
+        break;
+    case AxisType::INPUT_PITCH:
+        input = target_pitch * 0.01f;
+        output = degrees(ahrs.pitch);
+        break;
+    case AxisType::INPUT_YAW:
+        input = target_yaw_rate * 0.01f;
+        output = degrees(gyro.z);
+        break;
+    case AxisType::RATE_ROLL:
+        input = degrees(attitude_control->rate_bf_targets().x);
+        output = degrees(gyro.x);
+        break;
+    case AxisType::RATE_PITCH:
+        input = degrees(attitude_control->rate_bf_targets().y);
+        output = degrees(gyro.y);
+        break;
+    case AxisType::RATE_YAW:
+        input = degrees(attitude_control->rate_bf_targets().z);
+        output = degrees(gyro.z);
+        break;
+    case AxisType::NONE:
+        break;
+    }
+    response.update(input, output);
+
+    copter.Log_Write_SysID_Data(waveform_time, waveform_sample, chirp.get_frequency_hz(), input, output);
+}
+
+// exit - called when leaving the mode, reports a test cut short
+void Copter::ModeSystemId::exit()
+{
+    if (state == SystemIDModeState::Testing) {
+        stop("aborted");
+    }
+}
+
+/*
+  end the test, then log the response at each band and report the
+  bandwidth of the axis, where its gain first falls below -3dB
+ */
+void Copter::ModeSystemId::stop(const char *reason)
+{
+    state = SystemIDModeState::Stopped;
+
+    uint8_t measured = 0;
+    float bandwidth_hz = 0;
+    for (uint8_t band=0; band<response.get_num_bands(); band++) {
+        float gain, phase_deg;
+        if (!response.get_response(band, gain, phase_deg)) {
+            continue;
+        }
+        measured++;
+        const float frequency_hz = response.get_frequency_hz(band);
+        if (is_zero(bandwidth_hz) && gain < 0.7071f) {
+            bandwidth_hz = frequency_hz;
+        }
+        copter.Log_Write_SysID_Result(axis, band, frequency_hz, gain, phase_deg);
+    }
+
+    gcs().send_text(MAV_SEVERITY_INFO, "SystemID: %s, %u bands", reason, (unsigned)measured);
+    if (is_positive(bandwidth_hz)) {
+        gcs().send_text(MAV_SEVERITY_INFO, "SystemID: bandwidth %.1fHz", (double)bandwidth_hz);
+    }
+}
+
+#endif
@@ -293,7 +293,9 @@ void Copter::init_disarm_motors()
 }
 
 // motors_output - send output to motors library which will adjust and send to ESCs and servos
-void Copter::motors_output()
+// gyro_sample_us is the time of the gyro sample the rate controllers
+// last ran on, for measuring the latency to the output
+void Copter::motors_output(uint64_t gyro_sample_us)
 {
 #if ADVANCED_FAILSAFE == ENABLED
     // this is to allow the failsafe module to deliberately crash
@@ -341,6 +343,8 @@ void Copter::motors_output()
 
     // push all channels
     SRV_Channels::push();
+
+    ins.record_output_latency(gyro_sample_us);
 }
 
 // check for pilot stick input to trigger lost vehicle alarm
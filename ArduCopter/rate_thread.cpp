@@ -0,0 +1,99 @@
+#include "Copter.h"
+
+/*
+  rate control thread. When enabled the rate controllers and motor
+  output run on each filtered gyro sample, in their own thread, rather
+  than once per main loop. Everything else, including the angle
+  controllers setting the rate targets, stays in the main loop
+ */
+
+#if FAST_RATE_THREAD == ENABLED
+
+// start the rate thread, if enabled. On failure the rate controllers
+// stay in the main loop
+void Copter::fast_rate_thread_start()
+{
+    if (g2.fast_rate_enable <= 0) {
+        return;
+    }
+    const uint8_t div = constrain_int16(g2.fast_rate_div, 1, 8);
+    const float rate_hz = ins.get_raw_gyro_rate_hz(ins.get_primary_gyro()) / div;
+    if (rate_hz < scheduler.get_loop_rate_hz()) {
+        gcs().send_text(MAV_SEVERITY_WARNING, "Rate thread: gyro rate %uHz too low", (unsigned)rate_hz);
+        return;
+    }
+    if (!ins.enable_fast_rate_buffer(div)) {
+        gcs().send_text(MAV_SEVERITY_WARNING, "Rate thread: out of memory");
+        return;
+    }
+    fast_rate.rate_hz = rate_hz;
+    if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&Copter::rate_controller_thread, void),
+                                      "rate", 2048, AP_HAL::Scheduler::PRIORITY_BOOST, 1)) {
+        gcs().send_text(MAV_SEVERITY_WARNING, "Rate thread: failed to start");
+        return;
+    }
+}
+
+bool Copter::using_fast_rate_thread() const
+{
+    return fast_rate.active;
+}
+
+void Copter::rate_controller_thread()
+{
+    const float dt = 1.0f / fast_rate.rate_hz;
+    motors->set_loop_rate(fast_rate.rate_hz);
+    // each sample's output is sent as soon as it is pushed, so the
+    // output rate follows the gyro
+    hal.rcout->set_output_sync(true);
+    fast_rate.last_log_ms = AP_HAL::millis();
+    fast_rate.active = true;
+
+    while (true) {
+        Vector3f gyro;
+        uint64_t sample_us;
+        if (!ins.get_next_gyro_sample(gyro, sample_us)) {
+            hal.scheduler->delay_microseconds(50);
+            continue;
+        }
+        // if we have fallen behind, run on the newest sample
+        Vector3f newer_gyro;
+        uint64_t newer_sample_us;
+        while (ins.get_next_gyro_sample(newer_gyro, newer_sample_us)) {
+            gyro = newer_gyro;
+            sample_us = newer_sample_us;
+            fast_rate.skipped++;
+        }
+
+        attitude_control->rate_controller_run_gyro(gyro + ahrs.get_gyro_drift(), dt);
+        motors_output(sample_us);
+
+        // time from the sample to the output being sent
+        const uint32_t latency_us = MIN(AP_HAL::micros64() - sample_us, (uint64_t)UINT32_MAX);
+        fast_rate.samples++;
+        fast_rate.latency_sum_us += latency_us;
+        fast_rate.latency_max_us = MAX(fast_rate.latency_max_us, latency_us);
+
+        const uint32_t now_ms = AP_HAL::millis();
+        if (now_ms - fast_rate.last_log_ms >= 100) {
+            if (should_log(MASK_LOG_PM)) {
+                Log_Write_Fast_Rate(fast_rate.rate_hz, fast_rate.skipped,
+                                    fast_rate.latency_sum_us / fast_rate.samples,
+                                    fast_rate.latency_max_us);
+            }
+            fast_rate.last_log_ms = now_ms;
+            fast_rate.samples = 0;
+            fast_rate.skipped = 0;
+            fast_rate.latency_sum_us = 0;
+            fast_rate.latency_max_us = 0;
+        }
+    }
+}
+
+#else
+
+void Copter::fast_rate_thread_start() {}
+void Copter::rate_controller_thread() {}
+bool Copter::using_fast_rate_thread() const { return false; }
+
+#endif // FAST_RATE_THREAD
@@ -85,6 +85,64 @@ void Copter::rpm_update(void)
 #endif
 }
 
+/*
+  set the gyro harmonic notch frequency from its reference. The base
+  frequency is a floor, so the notch can't move down into the range
+  the attitude controllers work in
+ */
+void Copter::update_dynamic_notch()
+{
+    const HarmonicNotchFilterParams &notch = ins.get_gyro_harmonic_notch_params();
+    if (!notch.enabled()) {
+        return;
+    }
+    const float ref_freq_hz = notch.center_freq_hz();
+    float freq_hz = ref_freq_hz;
+
+    switch (notch.reference()) {
+    case HarmonicNotchFilterParams::Reference::Throttle: {
+        // motor speed goes roughly as the square root of thrust
+        const float throttle_hover = motors->get_throttle_hover();
+        if (is_positive(throttle_hover)) {
+            freq_hz = ref_freq_hz * sqrtf(MAX(motors->get_throttle(), 0.0f) / throttle_hover);
+        }
+        break;
+    }
+
+    case HarmonicNotchFilterParams::Reference::RPMSensor:
+#if RPM_ENABLED == ENABLED
+        if (rpm_sensor.healthy(0)) {
+            freq_hz = rpm_sensor.get_rpm(0) * notch.rpm_scale() / 60.0f;
+        }
+#endif
+        break;
+
+    case HarmonicNotchFilterParams::Reference::ESCTelemetry: {
+        float rpm;
+        if (AP::esc_telem().get_average_rpm(rpm)) {
+            freq_hz = rpm * notch.rpm_scale() / 60.0f;
+        }
+        break;
+    }
+
+    case HarmonicNotchFilterParams::Reference::GyroFFT: {
+#if HAL_GYROFFT_ENABLED
+        const AP_GyroFFT *fft = AP::gyro_fft();
+        if (fft != nullptr) {
+            freq_hz = fft->get_weighted_frequency();
+        }
+#endif
+        break;
+    }
+
+    case HarmonicNotchFilterParams::Reference::Fixed:
+    default:
+        break;
+    }
+
+    ins.update_harmonic_notch_freq_hz(MAX(freq_hz, ref_freq_hz));
+}
+
 /*
   initialise compass's location used for declination
  */
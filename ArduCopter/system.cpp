@@ -1,5 +1,7 @@
 #include "Copter.h"
 
+#include <utility>
+
 /*****************************************************************************
 *   The init_ardupilot function processes everything we need for an in - air restart
 *        We will determine later if we are actually on the ground and process a
@@ -35,6 +37,7 @@ void Copter::init_ardupilot()
 
     // load parameters from EEPROM
     load_parameters();
+    logger.note_boot_stage("params");
 
     // time per loop - this gets updated in the main loop() based on
     // actual loop rate
@@ -63,6 +66,7 @@ void Copter::init_ardupilot()
 #if HAL_WITH_UAVCAN
     BoardConfig_CAN.init();
 #endif
+    logger.note_boot_stage("board");
 
     // init cargo gripper
 #if GRIPPER_ENABLED == ENABLED
@@ -83,6 +87,7 @@ void Copter::init_ardupilot()
     rssi.init();
     
     barometer.init();
+    logger.note_boot_stage("baro");
 
     // setup telem slots with serial ports
     gcs().setup_uarts(serial_manager);
@@ -90,10 +95,12 @@ void Copter::init_ardupilot()
 #if OSD_ENABLED == ENABLED
     osd.init();
 #endif
+    logger.note_boot_stage("osd");
 
 #if LOGGING_ENABLED == ENABLED
     log_init();
 #endif
+    logger.note_boot_stage("logger");
 
     // update motor interlock state
     update_using_interlock();
@@ -116,6 +123,7 @@ void Copter::init_ardupilot()
 
     // sets up motors and output to escs
     init_rc_out();
+    logger.note_boot_stage("rc");
 
     // motors initialised so parameters can be sent
     ap.initialised_params = true;
@@ -136,8 +144,10 @@ void Copter::init_ardupilot()
     // Do GPS init
     gps.set_log_gps_bit(MASK_LOG_GPS);
     gps.init(serial_manager);
+    logger.note_boot_stage("gps");
 
     AP::compass().init();
+    logger.note_boot_stage("compass");
 
 #if OPTFLOW == ENABLED
     // make optflow available to AHRS
@@ -165,6 +175,7 @@ void Copter::init_ardupilot()
     // initialise camera mount
     camera_mount.init(serial_manager);
 #endif
+    logger.note_boot_stage("mount");
 
 #if PRECISION_LANDING == ENABLED
     // initialise precision landing
@@ -194,6 +205,7 @@ void Copter::init_ardupilot()
     //-----------------------------
     barometer.set_log_baro_bit(MASK_LOG_IMU);
     barometer.calibrate();
+    logger.note_boot_stage("baro_cal");
 
     // initialise rangefinder
     init_rangefinder();
@@ -223,6 +235,7 @@ void Copter::init_ardupilot()
     // initialize SmartRTL
     g2.smart_rtl.init();
 #endif
+    logger.note_boot_stage("sensors");
 
     // initialise AP_Logger library
     logger.setVehicle_Startup_Writer(FUNCTOR_BIND(&copter, &Copter::Log_Write_Vehicle_Startup_Messages, void));
@@ -231,12 +244,14 @@ void Copter::init_ardupilot()
     rc().init();
 
     startup_INS_ground();
+    logger.note_boot_stage("ins");
 
 #ifdef ENABLE_SCRIPTING
     if (!g2.scripting.init()) {
         gcs().send_text(MAV_SEVERITY_ERROR, "Scripting failed to start");
     }
 #endif // ENABLE_SCRIPTING
+    logger.note_boot_stage("scripting");
 
     // set landed flags
     set_land_complete(true);
@@ -257,6 +272,9 @@ void Copter::init_ardupilot()
         enable_motor_output();
     }
 
+    // move the rate controllers to their own thread if enabled
+    fast_rate_thread_start();
+
     // disable safety if requested
     BoardConfig.init_safety();
 
@@ -264,6 +282,7 @@ void Copter::init_ardupilot()
 
     // flag that initialisation has completed
     ap.initialised = true;
+    logger.note_boot_stage("ready");
 }
 
 
@@ -480,6 +499,25 @@ const char* Copter::get_frame_string()
     }
 }
 
+/*
+  construct an object that is used on every loop in fast memory if
+  the board has it, falling back to normal memory. Objects made this
+  way can be deleted as usual
+ */
+template <typename T, typename... Args>
+static T *new_hot(Args&&... args)
+{
+#if HAL_HOT_DATA_FASTMEM
+    void *mem = hal.util->malloc_type(sizeof(T), AP_HAL::Util::MEM_FAST);
+    if (mem == nullptr) {
+        return nullptr;
+    }
+    return new (mem) T(std::forward<Args>(args)...);
+#else
+    return new T(std::forward<Args>(args)...);
+#endif
+}
+
 /*
   allocate the motors class
  */
@@ -548,10 +586,10 @@ void Copter::allocate_motors(void)
     const struct AP_Param::GroupInfo *ac_var_info;
 
 #if FRAME_CONFIG != HELI_FRAME
-    attitude_control = new AC_AttitudeControl_Multi(*ahrs_view, aparm, *motors, scheduler.get_loop_period_s());
+    attitude_control = new_hot<AC_AttitudeControl_Multi>(*ahrs_view, aparm, *motors, scheduler.get_loop_period_s());
     ac_var_info = AC_AttitudeControl_Multi::var_info;
 #else
-    attitude_control = new AC_AttitudeControl_Heli(*ahrs_view, aparm, *motors, scheduler.get_loop_period_s());
+    attitude_control = new_hot<AC_AttitudeControl_Heli>(*ahrs_view, aparm, *motors, scheduler.get_loop_period_s());
     ac_var_info = AC_AttitudeControl_Heli::var_info;
 #endif
     if (attitude_control == nullptr) {
@@ -559,7 +597,7 @@ void Copter::allocate_motors(void)
     }
     AP_Param::load_object_from_eeprom(attitude_control, ac_var_info);
         
-    pos_control = new AC_PosControl(*ahrs_view, inertial_nav, *motors, *attitude_control);
+    pos_control = new_hot<AC_PosControl>(*ahrs_view, inertial_nav, *motors, *attitude_control);
     if (pos_control == nullptr) {
         AP_HAL::panic("Unable to allocate PosControl");
     }
@@ -84,7 +84,7 @@ const AP_Scheduler::Task Plane::scheduler_tasks[] = {
 #endif
     SCHED_TASK(parachute_check,        10,    200),
 #if AP_TERRAIN_AVAILABLE
-    SCHED_TASK_CLASS(AP_Terrain, &plane.terrain, update, 10, 200),
+    SCHED_TASK_CLASS_ASYNC(AP_Terrain, &plane.terrain, update, 10, 200),
 #endif // AP_TERRAIN_AVAILABLE
     SCHED_TASK(update_is_flying_5Hz,    5,    100),
 #if LOGGING_ENABLED == ENABLED
@@ -174,6 +174,14 @@ void Plane::ahrs_update()
 
     // update inertial_nav for quadplane
     quadplane.inertial_nav.update(G_Dt);
+
+#if MOUNT == ENABLED
+    // stabilise the camera mount against the new attitude
+    camera_mount.update_fast();
+#endif
+
+    // send high rate telemetry subscriptions
+    gcs().update_high_rate_send();
 }
 
 /*
@@ -181,7 +189,7 @@ void Plane::ahrs_update()
  */
 void Plane::update_speed_height(void)
 {
-    if (auto_throttle_mode) {
+    if (auto_throttle_mode && !quadplane.in_vtol_mode()) {
 	    // Call TECS 50Hz update. Note that we call this regardless of
 	    // throttle suppressed, as this needs to be running for
 	    // takeoff detection
@@ -585,7 +593,10 @@ void Plane::update_alt()
 
     update_flight_stage();
 
-    if (auto_throttle_mode && !throttle_suppressed) {        
+    // in VTOL modes the quadplane code sets pitch and forward
+    // throttle itself, so TECS isn't run. It resets its state when
+    // it is next updated
+    if (auto_throttle_mode && !throttle_suppressed && !quadplane.in_vtol_mode()) {
 
         float distance_beyond_land_wp = 0;
         if (flight_stage == AP_Vehicle::FixedWing::FLIGHT_LAND && location_passed_point(current_loc, prev_WP_loc, next_WP_loc)) {
@@ -608,6 +619,7 @@ void Plane::update_alt()
                                                  tecs_hgt_afe(),
                                                  aerodynamic_load_factor,
                                                  soaring_active);
+        quadplane.stage_ran(QuadPlane::STAGE_FW_TECS);
     }
 }
 
@@ -412,6 +412,7 @@ void Plane::stabilize()
             stabilize_stick_mixing_direct();
         }
         stabilize_yaw(speed_scaler);
+        quadplane.stage_ran(QuadPlane::STAGE_FW_ATTITUDE);
     }
 
     /*
@@ -111,7 +111,7 @@ MAV_STATE GCS_MAVLINK_Plane::system_status() const
 }
 
 
-void GCS_MAVLINK_Plane::send_attitude() const
+void GCS_MAVLINK_Plane::pack_attitude(mavlink_attitude_t &packet) const
 {
     const AP_AHRS &ahrs = AP::ahrs();
 
@@ -126,15 +126,13 @@ void GCS_MAVLINK_Plane::send_attitude() const
     }
     
     const Vector3f &omega = ahrs.get_gyro();
-    mavlink_msg_attitude_send(
-        chan,
-        millis(),
-        r,
-        p,
-        y,
-        omega.x,
-        omega.y,
-        omega.z);
+    packet.time_boot_ms = ins_sample_time_us() / 1000;
+    packet.roll = r;
+    packet.pitch = p;
+    packet.yaw = y;
+    packet.rollspeed = omega.x;
+    packet.pitchspeed = omega.y;
+    packet.yawspeed = omega.z;
 }
 
 void Plane::send_aoa_ssa(mavlink_channel_t chan)
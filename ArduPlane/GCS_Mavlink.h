@@ -30,7 +30,7 @@ protected:
 
     virtual bool in_hil_mode() const override;
 
-    void send_attitude() const override;
+    void pack_attitude(mavlink_attitude_t &packet) const override;
     void send_simstate() const override;
 
     bool persist_streamrates() const override { return true; }
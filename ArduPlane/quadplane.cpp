@@ -825,7 +825,8 @@ void QuadPlane::run_z_controller(void)
         last_pidz_init_ms = now;
     }
     last_pidz_active_ms = now;
-    pos_control->update_z_controller();    
+    pos_control->update_z_controller();
+    stage_ran(STAGE_VTOL_POSITION);
 }
 
 /*
@@ -1773,6 +1774,7 @@ void QuadPlane::motors_output(bool run_rate_controller)
 {
     if (run_rate_controller) {
         attitude_control->rate_controller_run();
+        stage_ran(STAGE_VTOL_RATE);
     }
 
 #if ADVANCED_FAILSAFE == ENABLED
@@ -2586,8 +2588,10 @@ void QuadPlane::Log_Write_QControl_Tuning()
         target_climb_rate   : target_climb_rate_cms,
         climb_rate          : int16_t(inertial_nav.get_velocity_z()),
         throttle_mix        : attitude_control->get_throttle_mix(),
+        stages              : stages_run,
     };
     plane.logger.WriteBlock(&pkt, sizeof(pkt));
+    stages_run = 0;
 
     // write multicopter position control message
     pos_control->write_log();
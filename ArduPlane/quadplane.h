@@ -134,6 +134,19 @@ public:
 
     // return true if the user has set ENABLE
     bool enabled(void) const { return enable != 0; }
+
+    /*
+      controller stages that have run since the last QTUN message,
+      logged so it can be seen which of the fixed wing and VTOL
+      controllers are being run in each flight stage
+     */
+    enum controller_stage {
+        STAGE_FW_ATTITUDE   = (1U<<0),
+        STAGE_FW_TECS       = (1U<<1),
+        STAGE_VTOL_POSITION = (1U<<2),
+        STAGE_VTOL_RATE     = (1U<<3),
+    };
+    void stage_ran(enum controller_stage stage) { stages_run |= stage; }
     
     struct PACKED log_QControl_Tuning {
         LOG_PACKET_HEADER;
@@ -148,6 +161,7 @@ public:
         int16_t  target_climb_rate;
         int16_t  climb_rate;
         float    throttle_mix;
+        uint8_t  stages;
     };
 
     MAV_TYPE get_mav_type(void) const;
@@ -404,6 +418,9 @@ private:
     // time of last control log message
     uint32_t last_ctrl_log_ms;
 
+    // controller_stage bits for the QTUN log
+    uint8_t stages_run;
+
     // types of tilt mechanisms
     enum {TILT_TYPE_CONTINUOUS=0,
           TILT_TYPE_BINARY=1,
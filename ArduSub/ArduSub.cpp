@@ -36,6 +36,7 @@ const AP_Scheduler::Task Sub::scheduler_tasks[] = {
     SCHED_TASK(three_hz_loop,          3,     75),
     SCHED_TASK(update_turn_counter,   10,     50),
     SCHED_TASK_CLASS(AP_Baro,             &sub.barometer,    accumulate,          50,  90),
+    SCHED_TASK(read_barometer,        50,     90),
     SCHED_TASK_CLASS(AP_Notify,           &sub.notify,       update,              50,  90),
     SCHED_TASK(one_hz_loop,            1,    100),
     SCHED_TASK_CLASS(GCS,                 (GCS*)&sub._gcs,   update_receive,     400, 180),
@@ -330,12 +331,9 @@ void Sub::read_AHRS()
     ahrs_view.update(true);
 }
 
-// read baro and rangefinder altitude at 10hz
+// log altitude at 10hz, the depth sensor is read at 50hz by read_barometer
 void Sub::update_altitude()
 {
-    // read in baro altitude
-    read_barometer();
-
     if (should_log(MASK_LOG_CTUN)) {
         Log_Write_Control_Tuning();
     }
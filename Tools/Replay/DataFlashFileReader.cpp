@@ -3,6 +3,7 @@
 #include <fcntl.h>
 #include <string.h>
 #include <sys/types.h>
+#include <sys/mman.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <time.h>
@@ -25,6 +26,9 @@ AP_LoggerFileReader::AP_LoggerFileReader() :
 
 AP_LoggerFileReader::~AP_LoggerFileReader()
 {
+    if (map_data != nullptr) {
+        munmap((void *)map_data, map_len);
+    }
     const uint64_t micros = now();
     const uint64_t delta = micros - start_micros;
     ::printf("Replay counts: %" PRIu64 " bytes  %u entries\n", bytes_read, message_count);
@@ -37,12 +41,157 @@ bool AP_LoggerFileReader::open_log(const char *logfile)
     if (fd == -1) {
         return false;
     }
+
+    // map the whole log, so reading a message is a copy rather
+    // than a system call.  Other replays of the same log share the
+    // mapped pages.  Fall back to read() if the log can't be mapped
+    const off_t size = ::lseek(fd, 0, SEEK_END);
+    if (size > 0) {
+        void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            map_data = (const uint8_t *)p;
+            map_len = size;
+            madvise(p, size, MADV_SEQUENTIAL);
+        }
+    }
+    if (!seek_raw(0)) {
+        return false;
+    }
+
+    // detect compressed logs from the first frame header
+    uint8_t magic[2];
+    compressed = (read_raw(magic, 2) == 2 &&
+                  magic[0] == LOG_COMPRESS_MAGIC1 &&
+                  magic[1] == LOG_COMPRESS_MAGIC2);
+    frame_len = 0;
+    frame_ofs = 0;
+    if (!seek_raw(0)) {
+        return false;
+    }
+    if (compressed) {
+        ::printf("Reading compressed log\n");
+    }
+
+    seek_pending = false;
+    if (start_time_us != 0) {
+        if (!compressed && index.load(fd)) {
+            seek_pending = true;
+        } else {
+            ::printf("Log has no index; replaying from the start\n");
+        }
+        if (!seek_raw(0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ssize_t AP_LoggerFileReader::read_raw(void *buf, const size_t count)
+{
+    if (map_data == nullptr) {
+        return ::read(fd, buf, count);
+    }
+    const size_t n = MIN(count, map_len - map_ofs);
+    memcpy(buf, &map_data[map_ofs], n);
+    map_ofs += n;
+    return n;
+}
+
+bool AP_LoggerFileReader::seek_raw(const uint32_t ofs)
+{
+    if (map_data == nullptr) {
+        return ::lseek(fd, ofs, SEEK_SET) != (off_t)-1;
+    }
+    if (ofs > map_len) {
+        return false;
+    }
+    map_ofs = ofs;
+    return true;
+}
+
+/*
+  having read the startup messages, read the formats defined in the
+  part of the log being skipped, then jump to the start time
+ */
+bool AP_LoggerFileReader::seek_to_start_time()
+{
+    for (uint16_t type=0; type<LOGREADER_MAX_FORMATS; type++) {
+        const uint32_t ofs = index.format_offset(type);
+        if (ofs == 0) {
+            continue;
+        }
+        struct log_Format f;
+        if (!seek_raw(ofs) ||
+            read_raw(&f, sizeof(f)) != sizeof(f) ||
+            f.head1 != HEAD_BYTE1 || f.head2 != HEAD_BYTE2 ||
+            f.msgid != LOG_FORMAT_MSG || f.type != type) {
+            ::printf("bad format offset in index\n");
+            return false;
+        }
+        memcpy(&formats[f.type], &f, sizeof(formats[f.type]));
+        if (!handle_log_format_msg(f)) {
+            return false;
+        }
+    }
+    const uint32_t ofs = index.offset_for_time(start_time_us);
+    ::printf("Seeking to offset %u for time %.1fs\n", (unsigned)ofs, start_time_us*1.0e-6);
+    return seek_raw(ofs);
+}
+
+/*
+  read and decode the next compressed frame into frame_data
+ */
+bool AP_LoggerFileReader::read_frame()
+{
+    struct LogCompressor::frame_header hdr;
+    if (read_raw(&hdr, sizeof(hdr)) != sizeof(hdr)) {
+        return false;
+    }
+    if (hdr.magic1 != LOG_COMPRESS_MAGIC1 || hdr.magic2 != LOG_COMPRESS_MAGIC2) {
+        ::printf("bad compressed frame header\n");
+        return false;
+    }
+    if (read_raw(frame_buf, hdr.data_len) != hdr.data_len) {
+        // truncated final frame
+        return false;
+    }
+    if (!(hdr.flags & LogCompressor::FRAME_COMPRESSED)) {
+        memcpy(frame_data, frame_buf, hdr.data_len);
+        frame_len = hdr.data_len;
+    } else {
+        const int32_t len = LogCompressor::decompress_block(frame_buf, hdr.data_len, frame_data, sizeof(frame_data));
+        if (len != hdr.raw_len) {
+            ::printf("corrupt compressed frame\n");
+            return false;
+        }
+        frame_len = len;
+    }
+    frame_ofs = 0;
     return true;
 }
 
 ssize_t AP_LoggerFileReader::read_input(void *buffer, const size_t count)
 {
-    uint64_t ret = ::read(fd, buffer, count);
+    if (!compressed) {
+        const ssize_t ret = read_raw(buffer, count);
+        if (ret > 0) {
+            bytes_read += ret;
+        }
+        return ret;
+    }
+
+    // messages may span frame boundaries
+    uint8_t *b = (uint8_t *)buffer;
+    size_t ret = 0;
+    while (ret < count) {
+        if (frame_ofs == frame_len && !read_frame()) {
+            break;
+        }
+        const size_t n = MIN(count - ret, (size_t)(frame_len - frame_ofs));
+        memcpy(&b[ret], &frame_data[frame_ofs], n);
+        frame_ofs += n;
+        ret += n;
+    }
     bytes_read += ret;
     return ret;
 }
@@ -63,6 +212,13 @@ void AP_LoggerFileReader::get_packet_counts(uint64_t dest[])
 
 bool AP_LoggerFileReader::update(char type[5])
 {
+    if (seek_pending && bytes_read >= index.startup_end()) {
+        seek_pending = false;
+        if (!seek_to_start_time()) {
+            return false;
+        }
+    }
+
     uint8_t hdr[3];
     if (read_input(hdr, 3) != 3) {
         return false;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <AP_Logger/AP_Logger.h>
+#include <AP_Logger/LogCompress.h>
+#include <AP_Logger/AP_Logger_FileIndex.h>
 
 #define LOGREADER_MAX_FORMATS 255 // must be >= highest MESSAGE
 
@@ -12,6 +14,10 @@ public:
     ~AP_LoggerFileReader();
 
     bool open_log(const char *logfile);
+
+    // skip to log time time_us once the startup messages have been
+    // read, if the log has an index.  Must be called before open_log
+    void set_start_time(uint64_t time_us) { start_time_us = time_us; }
     bool update(char type[5]);
 
     virtual bool handle_log_format_msg(const struct log_Format &f) = 0;
@@ -28,6 +34,27 @@ protected:
 private:
     ssize_t read_input(void *buf, size_t count);
 
+    // the log mapped by open_log, or nullptr if reading with read()
+    const uint8_t *map_data = nullptr;
+    size_t map_len;
+    size_t map_ofs;
+    ssize_t read_raw(void *buf, size_t count);
+    bool seek_raw(uint32_t ofs);
+    bool read_frame();
+
+    AP_Logger_FileIndex index;
+    uint64_t start_time_us = 0;
+    bool seek_pending = false;
+    bool seek_to_start_time();
+
+    // logs written with LOG_FILE_COMPRESS are a sequence of
+    // compressed frames; frame_data holds the current decoded frame
+    bool compressed;
+    uint8_t frame_buf[UINT16_MAX];
+    uint8_t frame_data[UINT16_MAX];
+    uint16_t frame_len;
+    uint16_t frame_ofs;
+
     uint64_t bytes_read = 0;
     uint32_t message_count = 0;
     uint64_t start_micros;
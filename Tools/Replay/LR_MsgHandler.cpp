@@ -76,6 +76,15 @@ void LR_MsgHandler_ARSP::process_message(uint8_t *msg)
 void LR_MsgHandler_NKF1::process_message(uint8_t *msg)
 {
     wait_timestamp_from_msg(msg);
+    attitude_from_msg(msg, state.euler, "Roll", "Pitch", "Yaw");
+    state.euler *= radians(1);
+    require_field(msg, "VN", state.velocity.x);
+    require_field(msg, "VE", state.velocity.y);
+    require_field(msg, "VD", state.velocity.z);
+    require_field(msg, "PN", state.position.x);
+    require_field(msg, "PE", state.position.y);
+    require_field(msg, "PD", state.position.z);
+    state.updated = true;
 }
 
 
@@ -395,6 +404,56 @@ bool LR_MsgHandler_PARM::set_parameter(const char *name, const float value)
     return _set_parameter_callback(name, value);
 }
 
+void LR_MsgHandler_ISBC::process_message(uint8_t *msg)
+{
+    if (f.length != sizeof(struct log_ISBC)) {
+        ::printf("ISBC length mismatch (%u != %u)\n", f.length, (unsigned)sizeof(struct log_ISBC));
+        return;
+    }
+    struct log_ISBC pkt;
+    memcpy(&pkt, msg, sizeof(pkt));
+    wait_timestamp_usec(pkt.time_us);
+
+    int16_t x[ISBCodec::MAX_SAMPLES];
+    int16_t y[ISBCodec::MAX_SAMPLES];
+    int16_t z[ISBCodec::MAX_SAMPLES];
+    if (!ISBCodec::decode(pkt, x, y, z)) {
+        ::printf("Bad ISBC message\n");
+        return;
+    }
+
+    // ISBD messages carry 32 samples, aligned within the batch
+    const uint8_t n = ARRAY_SIZE(pending.x);
+    if (pending_count != 0 &&
+        (pending.isb_seqno != pkt.isb_seqno ||
+         pending.seqno*n + pending_count != pkt.sample_ofs)) {
+        ::printf("ISBC discontinuity; dropping %u samples\n", pending_count);
+        pending_count = 0;
+    }
+    for (uint8_t i=0; i<pkt.count; i++) {
+        const uint16_t ofs = pkt.sample_ofs + i;
+        if (pending_count == 0) {
+            if (ofs % n != 0) {
+                // wait for the start of the next ISBD
+                continue;
+            }
+            pending.isb_seqno = pkt.isb_seqno;
+            pending.seqno = ofs / n;
+        }
+        pending.x[pending_count] = x[i];
+        pending.y[pending_count] = y[i];
+        pending.z[pending_count] = z[i];
+        if (++pending_count == n) {
+            pending.head1 = HEAD_BYTE1;
+            pending.head2 = HEAD_BYTE2;
+            pending.msgid = isbd_msgid;
+            pending.time_us = pkt.time_us;
+            logger.WriteBlock(&pending, sizeof(pending));
+            pending_count = 0;
+        }
+    }
+}
+
 void LR_MsgHandler_PARM::process_message(uint8_t *msg)
 {
     const uint8_t parameter_name_len = AP_MAX_NAME_SIZE + 1; // null-term
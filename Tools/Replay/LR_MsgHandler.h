@@ -2,6 +2,8 @@
 
 #include "MsgHandler.h"
 
+#include <AP_Logger/ISBCodec.h>
+
 #include <functional>
 
 class LR_MsgHandler : public MsgHandler {
@@ -19,6 +21,14 @@ public:
         Vector3f velocity;
     };
 
+    // state from the logged NKF1 or XKF1 message of the primary core
+    struct EKFLogState {
+        Vector3f euler;         // radians
+        Vector3f velocity;      // NED, m/s
+        Vector3f position;      // NED from the origin, m
+        bool updated;           // set on each message, cleared by the user
+    };
+
 protected:
     AP_Logger &logger;
     void wait_timestamp(uint32_t timestamp);
@@ -70,14 +80,19 @@ private:
     AP_Airspeed &airspeed;
 };
 
+// handles NKF1 and XKF1, which share a format
 class LR_MsgHandler_NKF1 : public LR_MsgHandler
 {
 public:
     LR_MsgHandler_NKF1(log_Format &_f, AP_Logger &_logger,
-		    uint64_t &_last_timestamp_usec) :
-	LR_MsgHandler(_f, _logger, _last_timestamp_usec) { };
+		    uint64_t &_last_timestamp_usec, EKFLogState &_state) :
+	LR_MsgHandler(_f, _logger, _last_timestamp_usec),
+        state(_state) { };
 
     virtual void process_message(uint8_t *msg);
+
+private:
+    EKFLogState &state;
 };
 
 
@@ -457,6 +472,27 @@ private:
 
 };
 
+// expands delta-encoded ISBC messages into ISBD messages
+class LR_MsgHandler_ISBC : public LR_MsgHandler
+{
+public:
+    LR_MsgHandler_ISBC(log_Format &_f, AP_Logger &_logger,
+                       uint64_t &_last_timestamp_usec,
+                       uint8_t _isbd_msgid)
+        : LR_MsgHandler(_f, _logger, _last_timestamp_usec),
+          isbd_msgid(_isbd_msgid)
+        { };
+
+    virtual void process_message(uint8_t *msg);
+
+private:
+    const uint8_t isbd_msgid;
+
+    // samples carried over to the next ISBD message
+    struct log_ISBD pending {};
+    uint8_t pending_count = 0;
+};
+
 class LR_MsgHandler_SIM : public LR_MsgHandler
 {
 public:
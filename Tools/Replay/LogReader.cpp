@@ -201,6 +201,21 @@ uint8_t LogReader::map_fmt_type(const char *name, uint8_t intype)
         // already mapped
         return mapped_msgid[intype];
     }
+    mapped_msgid[intype] = allocate_msgid();
+    if (mapped_msgid[intype] == 0) {
+        ::fprintf(stderr, "mapping failed\n");
+        abort();
+    }
+
+    return mapped_msgid[intype];    
+}
+
+/*
+  find an output msgid not used by any mapped or generated message.
+  Returns 0 if none are left
+ */
+uint8_t LogReader::allocate_msgid()
+{
     for (uint8_t n=next_msgid; n<255; n++) {
         ::fprintf(stderr, "next_msgid=%u\n", next_msgid);
         bool already_mapped = false;
@@ -217,16 +232,50 @@ uint8_t LogReader::map_fmt_type(const char *name, uint8_t intype)
         if (AP::logger().msg_type_in_use(n)) {
             continue;
         }
-        mapped_msgid[intype] = n;
         next_msgid = n+1;
-        break;
-    }
-    if (mapped_msgid[intype] == 0) {
-        ::fprintf(stderr, "mapping failed\n");
-        abort();
+        return n;
     }
+    return 0;
+}
 
-    return mapped_msgid[intype];    
+/*
+  emit an FMT message to the output log
+ */
+void LogReader::write_format(const struct LogStructure &s)
+{
+    struct log_Format pkt {};
+    pkt.head1 = HEAD_BYTE1;
+    pkt.head2 = HEAD_BYTE2;
+    pkt.msgid = LOG_FORMAT_MSG;
+    pkt.type = s.msg_type;
+    pkt.length = s.msg_len;
+    strncpy(pkt.name, s.name, sizeof(pkt.name));
+    strncpy(pkt.format, s.format, sizeof(pkt.format));
+    strncpy(pkt.labels, s.labels, sizeof(pkt.labels));
+    logger.WriteCriticalBlock(&pkt, sizeof(pkt));
+}
+
+/*
+  ISBC messages are expanded into ISBD messages in the output log so
+  that existing batch-sampling tools can read them.  Returns the
+  output msgid allocated for ISBD
+ */
+uint8_t LogReader::define_isbd_format()
+{
+    for (uint8_t n=0; n<ARRAY_SIZE(running_codes_log_structure); n++) {
+        if (streq("ISBD", running_codes_log_structure[n].name)) {
+            struct LogStructure s = running_codes_log_structure[n];
+            s.msg_type = allocate_msgid();
+            if (s.msg_type == 0) {
+                ::fprintf(stderr, "mapping failed\n");
+                abort();
+            }
+            write_format(s);
+            return s.msg_type;
+        }
+    }
+    ::fprintf(stderr, "No ISBD format found in running code\n");
+    abort();
 }
 
 bool LogReader::save_message_type(const char *name)
@@ -246,6 +295,8 @@ bool LogReader::handle_log_format_msg(const struct log_Format &f)
 	memcpy(name, f.name, 4);
 	debug("Defining log format for type (%d) (%s)\n", f.type, name);
 
+    write_through[f.type] = WriteThrough::UNKNOWN;
+
     struct LogStructure s = _log_structure[_log_structure_count++];
     logger.set_num_types(_log_structure_count);
 
@@ -278,16 +329,7 @@ bool LogReader::handle_log_format_msg(const struct log_Format &f)
         }
 
         // emit the FMT to AP_Logger:
-        struct log_Format pkt {};
-        pkt.head1 = HEAD_BYTE1;
-        pkt.head2 = HEAD_BYTE2;
-        pkt.msgid = LOG_FORMAT_MSG;
-        pkt.type = s.msg_type;
-        pkt.length = s.msg_len;
-        strncpy(pkt.name, s.name, sizeof(pkt.name));
-        strncpy(pkt.format, s.format, sizeof(pkt.format));
-        strncpy(pkt.labels, s.labels, sizeof(pkt.labels));
-        logger.WriteCriticalBlock(&pkt, sizeof(pkt));
+        write_format(s);
     }
 
     if (msgparser[f.type] != NULL) {
@@ -390,7 +432,12 @@ bool LogReader::handle_log_format_msg(const struct log_Format &f)
                                                     airspeed);
 	} else if (streq(name, "NKF1")) {
 	    msgparser[f.type] = new LR_MsgHandler_NKF1(formats[f.type], logger,
-                                                       last_timestamp_usec);
+                                                       last_timestamp_usec,
+                                                       ekf2_log_state);
+	} else if (streq(name, "XKF1")) {
+	    msgparser[f.type] = new LR_MsgHandler_NKF1(formats[f.type], logger,
+                                                       last_timestamp_usec,
+                                                       ekf3_log_state);
 	} else if (streq(name, "CHEK")) {
 	  msgparser[f.type] = new LR_MsgHandler_CHEK(formats[f.type], logger,
                                                      last_timestamp_usec,
@@ -398,6 +445,13 @@ bool LogReader::handle_log_format_msg(const struct log_Format &f)
 	} else if (streq(name, "PM")) {
 	  msgparser[f.type] = new LR_MsgHandler_PM(formats[f.type], logger,
                                                    last_timestamp_usec);
+	} else if (streq(name, "ISBC")) {
+	  if (isbd_msgid == 0) {
+	      isbd_msgid = define_isbd_format();
+	  }
+	  msgparser[f.type] = new LR_MsgHandler_ISBC(formats[f.type], logger,
+                                                     last_timestamp_usec,
+                                                     isbd_msgid);
 	} else {
             debug("  No parser for (%s)\n", name);
 	}
@@ -406,11 +460,21 @@ bool LogReader::handle_log_format_msg(const struct log_Format &f)
 }
 
 bool LogReader::handle_msg(const struct log_Format &f, uint8_t *msg) {
-    char name[5];
-    memset(name, '\0', 5);
-    memcpy(name, f.name, 4);
+    WriteThrough &wt = write_through[f.type];
+    if (wt == WriteThrough::UNKNOWN) {
+        char name[5];
+        memset(name, '\0', 5);
+        memcpy(name, f.name, 4);
+        if (!save_message_type(name)) {
+            wt = WriteThrough::NO;
+        } else if (in_list(name, nottypes)) {
+            wt = WriteThrough::SAVE;
+        } else {
+            wt = WriteThrough::WRITE;
+        }
+    }
 
-    if (save_message_type(name)) {
+    if (wt != WriteThrough::NO) {
         // write this message through to output log, changing the ID
         // present in the input log to that used for the same message
         // name in the output log
@@ -419,8 +483,8 @@ bool LogReader::handle_msg(const struct log_Format &f, uint8_t *msg) {
             exit(1);
         }
         msg[2] = mapped_msgid[msg[2]];
-        if (!in_list(name, nottypes)) {
-            logger.WriteBlock(msg, f.length);        
+        if (wt == WriteThrough::WRITE) {
+            logger.WriteBlock(msg, f.length);
         }
         // a MsgHandler would probably have found a timestamp and
         // caled stop_clock.  This runs IO, clearing logger's
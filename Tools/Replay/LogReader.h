@@ -23,6 +23,8 @@ public:
     const Vector3f &get_sim_attitude(void) const { return sim_attitude; }
     const float &get_relalt(void) const { return rel_altitude; }
     const LR_MsgHandler::CheckState &get_check_state(void) const { return check_state; }
+    LR_MsgHandler::EKFLogState &get_ekf2_log_state(void) { return ekf2_log_state; }
+    LR_MsgHandler::EKFLogState &get_ekf3_log_state(void) { return ekf3_log_state; }
 
     VehicleType::vehicle_type vehicle;
 
@@ -72,7 +74,22 @@ private:
     // next available msgid for mapping
     uint8_t next_msgid = 1;
 
+    // output msgid for ISBD messages expanded from ISBC
+    uint8_t isbd_msgid = 0;
+
     LR_MsgHandler::CheckState check_state;
+    LR_MsgHandler::EKFLogState ekf2_log_state {};
+    LR_MsgHandler::EKFLogState ekf3_log_state {};
+
+    // how messages of each input type are passed through to the
+    // output log, so the name lists are only searched once per type
+    enum class WriteThrough : uint8_t {
+        UNKNOWN = 0,
+        NO,
+        SAVE,           // mapped and timed, but in --nottypes
+        WRITE,
+    };
+    WriteThrough write_through[LOGREADER_MAX_FORMATS] {};
 
     bool installed_vehicle_specific_parsers;
     const char **&nottypes;
@@ -83,6 +100,9 @@ private:
 
     void initialise_fmt_map();
     uint8_t map_fmt_type(const char *name, uint8_t intype);
+    uint8_t allocate_msgid();
+    void write_format(const struct LogStructure &s);
+    uint8_t define_isbd_format();
 
     bool save_message_type(const char *name);
 };
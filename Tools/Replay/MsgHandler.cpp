@@ -56,8 +56,16 @@ void MsgHandler::init_field_types()
 
 struct MsgHandler::format_field_info *MsgHandler::find_field_info(const char *label)
 {
+    // handlers look fields up by string literal on every message, so
+    // try the pointers they used before comparing strings
+    for(uint8_t i=0; i<next_field; i++) {
+        if (field_info[i].last_lookup == label) {
+            return &field_info[i];
+        }
+    }
     for(uint8_t i=0; i<next_field; i++) {
         if (streq(field_info[i].label, label)) {
+            field_info[i].last_lookup = label;
             return &field_info[i];
         }
     }
@@ -77,6 +85,7 @@ void MsgHandler::add_field(const char *_label, uint8_t _type, uint8_t _offset,
     field_info[next_field].type = _type;
     field_info[next_field].offset = _offset;
     field_info[next_field].length = _length;
+    field_info[next_field].last_lookup = NULL;
     next_field++;
 }
 
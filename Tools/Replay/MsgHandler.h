@@ -18,7 +18,9 @@ public:
     void string_for_labels(char *buffer, uint bufferlen);
 
     // field_value - retrieve the value of a field from the supplied message
-    // these return false if the field was not found
+    // these return false if the field was not found. Lookups are
+    // cached by the address of label, so it must not be a buffer
+    // reused for other labels
     template<typename R>
     bool field_value(uint8_t *msg, const char *label, R &ret);
 
@@ -51,6 +53,7 @@ private:
 
     struct format_field_info { // parsed field information
         char *label;
+        const char *last_lookup; // label string last used to find this field
         uint8_t type;
         uint8_t offset;
         uint8_t length;
@@ -34,6 +34,10 @@
 #include <SITL/SITL.h>
 #endif
 
+#if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+#include <AP_HAL_Linux/Perf.h>
+#endif
+
 #define streq(x, y) (!strcmp(x, y))
 
 const AP_HAL::HAL& hal = AP_HAL::get_HAL();
@@ -134,6 +138,15 @@ void ReplayVehicle::setup(void)
 
 Replay replay(replayvehicle);
 
+const char *Replay::diff_stat_names[DIFF_NUM_STATS] = {
+    "Roll", "Pitch", "Yaw", "Vel", "PosNE", "PosD",
+};
+
+const char *Replay::sweep_stat_names[SWEEP_NUM_STATS] = {
+    "VelRatio", "PosRatio", "HgtRatio", "MagRatio", "TasRatio",
+    "VelInnov", "PosInnov", "MagInnov",
+};
+
 void Replay::usage(void)
 {
     ::printf("Options:\n");
@@ -153,6 +166,11 @@ void Replay::usage(void)
     ::printf("\t--no-params        don't use parameters from the log\n");
     ::printf("\t--no-fpe           do not generate floating point exceptions\n");
     ::printf("\t--packet-counts    print packet counts at end of processing\n");
+    ::printf("\t--profile          print EKF timing and cache miss statistics at end of processing\n");
+    ::printf("\t--start-time TIME  start replaying at log time TIME (seconds) using the log's index\n");
+    ::printf("\t--sweep FILE       replay once for each line of NAME=VALUE parameters in FILE\n");
+    ::printf("\t--jobs N           number of sweep replays to run at once\n");
+    ::printf("\t--diff-ekf         compare the replayed EKF2 and EKF3 outputs with the logged NKF1 and XKF1\n");
 }
 
 
@@ -169,6 +187,11 @@ enum {
     OPT_PARAM_FILE,
     OPT_NO_FPE,
     OPT_PACKET_COUNTS,
+    OPT_PROFILE,
+    OPT_START_TIME,
+    OPT_SWEEP,
+    OPT_JOBS,
+    OPT_DIFF_EKF,
 };
 
 void Replay::flush_logger(void) {
@@ -226,6 +249,11 @@ void Replay::_parse_command_line(uint8_t argc, char * const argv[])
         {"no-params",       false,  0, OPT_NOPARAMS},
         {"no-fpe",          false,  0, OPT_NO_FPE},
         {"packet-counts",   false,  0, OPT_PACKET_COUNTS},
+        {"profile",         false,  0, OPT_PROFILE},
+        {"start-time",      true,   0, OPT_START_TIME},
+        {"sweep",           true,   0, OPT_SWEEP},
+        {"jobs",            true,   0, OPT_JOBS},
+        {"diff-ekf",        false,  0, OPT_DIFF_EKF},
         {0, false, 0, 0}
     };
 
@@ -313,6 +341,26 @@ void Replay::_parse_command_line(uint8_t argc, char * const argv[])
             packet_counts = true;
             break;
 
+        case OPT_PROFILE:
+            profile = true;
+            break;
+
+        case OPT_START_TIME:
+            start_time_us = atof(gopt.optarg) * 1.0e6;
+            break;
+
+        case OPT_SWEEP:
+            sweep_filename = gopt.optarg;
+            break;
+
+        case OPT_JOBS:
+            sweep_jobs = atoi(gopt.optarg);
+            break;
+
+        case OPT_DIFF_EKF:
+            diff_ekf = true;
+            break;
+
         case 'h':
         default:
             usage();
@@ -498,16 +546,23 @@ FILE *Replay::xfopen(const char *f, const char *mode)
     return ret;
 }
 
-void Replay::setup()
+/*
+  parse the command line before the HAL starts its threads, as sweep
+  workers are forked here and fork() only copies the calling thread
+ */
+void Replay::early_setup(int argc, char * const argv[])
 {
-    ::printf("Starting\n");
-
-    uint8_t argc;
-    char * const *argv;
+    _parse_command_line(argc, argv);
 
-    hal.util->commandline_arguments(argc, argv);
+    if (sweep_filename != nullptr) {
+        // only returns in a worker, set up for one configuration
+        run_sweep();
+    }
+}
 
-    _parse_command_line(argc, argv);
+void Replay::setup()
+{
+    ::printf("Starting\n");
 
     if (!check_generate) {
         logreader.set_save_chek_messages(true);
@@ -515,6 +570,10 @@ void Replay::setup()
 
     set_signal_handlers();
 
+    if (profile) {
+        setup_profile();
+    }
+
     hal.console->printf("Processing log %s\n", filename);
 
     // remember filename for reporting
@@ -527,6 +586,7 @@ void Replay::setup()
 
     hal.console->printf("Using an update rate of %u Hz\n", log_info.update_rate);
 
+    logreader.set_start_time(start_time_us);
     if (!logreader.open_log(filename)) {
         perror(filename);
         exit(1);
@@ -697,6 +757,9 @@ void Replay::read_sensors(const char *type)
     
     if (run_ahrs) {
         _vehicle.ahrs.update();
+        if (sweep_index >= 0) {
+            update_sweep_stats();
+        }
         if ((downsample == 0 || ++output_counter % downsample == 0) && !logmatch) {
             write_ekf_logs();
         }
@@ -787,13 +850,334 @@ void Replay::flush_and_exit()
         report_checks();
     }
 
+    if (diff_ekf) {
+        report_ekf_diff();
+    }
+
     if (packet_counts) {
         show_packet_counts();
     }
 
+    if (profile) {
+        show_profile();
+    }
+
+    if (sweep_index >= 0) {
+        write_sweep_summary();
+    }
+
     exit(0);
 }
 
+/*
+  Run the replay once per line of the sweep file, up to sweep_jobs at
+  a time.  The vehicle, parameters and HAL are all process globals,
+  so each configuration is replayed in a forked worker, in its own
+  directory sweep/NNN so that the output logs don't collide.  The
+  workers' summaries are gathered into sweep/results.txt
+ */
+void Replay::run_sweep()
+{
+    FILE *f = xfopen(sweep_filename, "r");
+    char **configs = nullptr;
+    uint16_t num_configs = 0;
+    char line[1000];
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = 0;
+        if (line[0] == '#' || line[strspn(line, " \t,")] == 0) {
+            continue;
+        }
+        configs = (char **)realloc(configs, (num_configs+1)*sizeof(char *));
+        if (configs == nullptr) {
+            ::printf("Out of memory reading %s\n", sweep_filename);
+            exit(1);
+        }
+        configs[num_configs++] = strdup(line);
+    }
+    fclose(f);
+    if (num_configs == 0) {
+        ::printf("No configurations in %s\n", sweep_filename);
+        exit(1);
+    }
+
+    // the workers change directory, so need the full path to the log
+    char *log_path = realpath(filename, nullptr);
+    if (log_path == nullptr) {
+        perror(filename);
+        exit(1);
+    }
+    filename = log_path;
+
+    if (sweep_jobs == 0) {
+        sweep_jobs = MAX(sysconf(_SC_NPROCESSORS_ONLN), 1);
+    }
+    if (mkdir("sweep", 0755) != 0 && errno != EEXIST) {
+        perror("sweep");
+        exit(1);
+    }
+    ::printf("Sweeping %u configurations, %u at a time\n",
+             (unsigned)num_configs, (unsigned)sweep_jobs);
+
+    // make sure buffered output isn't repeated by the workers
+    fflush(stdout);
+    fflush(stderr);
+
+    pid_t *pids = new pid_t[num_configs];
+    int *status = new int[num_configs];
+    uint16_t next = 0;
+    uint16_t running = 0;
+    while (next < num_configs || running > 0) {
+        if (next < num_configs && running < sweep_jobs) {
+            const pid_t pid = fork();
+            if (pid == -1) {
+                perror("fork");
+                exit(1);
+            }
+            if (pid == 0) {
+                start_sweep_worker(next, configs[next]);
+                return;
+            }
+            pids[next++] = pid;
+            running++;
+            continue;
+        }
+        int wstatus;
+        const pid_t pid = wait(&wstatus);
+        if (pid == -1) {
+            perror("wait");
+            exit(1);
+        }
+        for (uint16_t i=0; i<next; i++) {
+            if (pids[i] == pid) {
+                status[i] = wstatus;
+                running--;
+                ::printf("Configuration %u %s\n", (unsigned)i,
+                         (WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0) ? "done" : "FAILED");
+                break;
+            }
+        }
+    }
+
+    FILE *results = xfopen("sweep/results.txt", "w");
+    ::fprintf(results, "# N Samples");
+    for (uint8_t i=0; i<SWEEP_NUM_STATS; i++) {
+        ::fprintf(results, " %sRMS %sMax", sweep_stat_names[i], sweep_stat_names[i]);
+    }
+    ::fprintf(results, " Config\n");
+    for (uint16_t i=0; i<num_configs; i++) {
+        char path[32];
+        snprintf(path, sizeof(path), "sweep/%03u/summary.txt", (unsigned)i);
+        char summary[500] = "FAILED";
+        FILE *s = fopen(path, "r");
+        if (s != nullptr) {
+            if (fgets(summary, sizeof(summary), s) != nullptr) {
+                summary[strcspn(summary, "\n")] = 0;
+            }
+            fclose(s);
+        }
+        if (!WIFEXITED(status[i]) || WEXITSTATUS(status[i]) != 0) {
+            strcpy(summary, "FAILED");
+        }
+        ::fprintf(results, "%u %s %s\n", (unsigned)i, summary, configs[i]);
+    }
+    fclose(results);
+    ::printf("Results in sweep/results.txt\n");
+    exit(0);
+}
+
+/*
+  set up a forked worker to replay configuration index, given as a
+  line of NAME=VALUE pairs
+ */
+void Replay::start_sweep_worker(const uint16_t index, char *config)
+{
+    sweep_index = index;
+
+    char dir[16];
+    snprintf(dir, sizeof(dir), "sweep/%03u", (unsigned)index);
+    if ((mkdir(dir, 0755) != 0 && errno != EEXIST) || chdir(dir) != 0) {
+        perror(dir);
+        exit(1);
+    }
+    if (freopen("replay.out", "w", stdout) == nullptr ||
+        dup2(fileno(stdout), fileno(stderr)) == -1) {
+        exit(1);
+    }
+
+    // the sweep parameters go at the end of the list so they take
+    // precedence over --parm and --param-file
+    struct user_parameter **tail = &user_parameters;
+    while (*tail != nullptr) {
+        tail = &(*tail)->next;
+    }
+    char *saveptr = nullptr;
+    for (char *pname = strtok_r(config, ", =\t", &saveptr);
+         pname != nullptr;
+         pname = strtok_r(nullptr, ", =\t", &saveptr)) {
+        const char *value_s = strtok_r(nullptr, ", =\t", &saveptr);
+        if (value_s == nullptr || strlen(pname) > AP_MAX_NAME_SIZE) {
+            ::printf("Bad sweep parameter %s\n", pname);
+            exit(1);
+        }
+        struct user_parameter *u = new user_parameter;
+        strncpy(u->name, pname, sizeof(u->name));
+        u->value = atof(value_s);
+        u->next = nullptr;
+        *tail = u;
+        tail = &u->next;
+        ::printf("Sweep parameter %s=%f\n", u->name, u->value);
+    }
+}
+
+/*
+  accumulate the primary EKF2 core's test ratios and innovations for
+  the sweep summary
+ */
+void Replay::update_sweep_stats()
+{
+    float values[SWEEP_NUM_STATS];
+    Vector3f magVar;
+    Vector2f offset;
+    _vehicle.EKF2.getVariances(-1,
+                               values[SWEEP_VEL_RATIO],
+                               values[SWEEP_POS_RATIO],
+                               values[SWEEP_HGT_RATIO],
+                               magVar,
+                               values[SWEEP_TAS_RATIO],
+                               offset);
+    values[SWEEP_MAG_RATIO] = magVar.length();
+
+    Vector3f velInnov, posInnov, magInnov;
+    float tasInnov, yawInnov;
+    _vehicle.EKF2.getInnovations(-1, velInnov, posInnov, magInnov, tasInnov, yawInnov);
+    values[SWEEP_VEL_INNOV] = velInnov.length();
+    values[SWEEP_POS_INNOV] = posInnov.length();
+    values[SWEEP_MAG_INNOV] = magInnov.length();
+
+    for (uint8_t i=0; i<SWEEP_NUM_STATS; i++) {
+        if (isnan(values[i])) {
+            continue;
+        }
+        sweep_stats.sum_sq[i] += sq(values[i]);
+        sweep_stats.max[i] = MAX(sweep_stats.max[i], values[i]);
+    }
+    sweep_stats.samples++;
+}
+
+/*
+  compare the output of the primary core of each replayed EKF with the
+  logged output of the same core, when a new NKF1 or XKF1 message has
+  been read. Euler angle differences are in degrees
+ */
+void Replay::update_ekf_diff()
+{
+    for (uint8_t k=0; k<2; k++) {
+        LR_MsgHandler::EKFLogState &logged = k == 0 ? logreader.get_ekf2_log_state() : logreader.get_ekf3_log_state();
+        if (!logged.updated) {
+            continue;
+        }
+        logged.updated = false;
+
+        Vector3f euler, velocity;
+        Vector2f posNE;
+        float posD = 0;
+        if (k == 0) {
+            _vehicle.EKF2.getEulerAngles(0, euler);
+            _vehicle.EKF2.getVelNED(0, velocity);
+            _vehicle.EKF2.getPosNE(0, posNE);
+            _vehicle.EKF2.getPosD(0, posD);
+        } else {
+            _vehicle.EKF3.getEulerAngles(0, euler);
+            _vehicle.EKF3.getVelNED(0, velocity);
+            _vehicle.EKF3.getPosNE(0, posNE);
+            _vehicle.EKF3.getPosD(0, posD);
+        }
+
+        float values[DIFF_NUM_STATS];
+        values[DIFF_ROLL] = degrees(fabsf(wrap_PI(euler.x - logged.euler.x)));
+        values[DIFF_PITCH] = degrees(fabsf(wrap_PI(euler.y - logged.euler.y)));
+        values[DIFF_YAW] = degrees(fabsf(wrap_PI(euler.z - logged.euler.z)));
+        values[DIFF_VEL] = (velocity - logged.velocity).length();
+        values[DIFF_POS_NE] = norm(posNE.x - logged.position.x, posNE.y - logged.position.y);
+        values[DIFF_POS_D] = fabsf(posD - logged.position.z);
+
+        struct ekf_diff_stats &stats = ekf_diff[k];
+        for (uint8_t i=0; i<DIFF_NUM_STATS; i++) {
+            if (isnan(values[i])) {
+                continue;
+            }
+            stats.sum_sq[i] += sq(values[i]);
+            stats.max[i] = MAX(stats.max[i], values[i]);
+        }
+        stats.samples++;
+    }
+}
+
+/*
+  report results of --diff-ekf, exiting with an error if the largest
+  difference is beyond the tolerances
+ */
+void Replay::report_ekf_diff(void)
+{
+    bool failed = false;
+    for (uint8_t k=0; k<2; k++) {
+        const struct ekf_diff_stats &stats = ekf_diff[k];
+        if (stats.samples == 0) {
+            continue;
+        }
+        ::printf("EKF%u difference over %u samples (RMS/max):\n", k == 0 ? 2U : 3U, (unsigned)stats.samples);
+        for (uint8_t i=0; i<DIFF_NUM_STATS; i++) {
+            ::printf("  %-6s %8.4f %8.4f\n", diff_stat_names[i],
+                     sqrt(stats.sum_sq[i] / stats.samples), (double)stats.max[i]);
+        }
+        failed |= show_error("Roll error", stats.max[DIFF_ROLL], tolerance_euler);
+        failed |= show_error("Pitch error", stats.max[DIFF_PITCH], tolerance_euler);
+        failed |= show_error("Yaw error", stats.max[DIFF_YAW], tolerance_euler);
+        failed |= show_error("Position error", MAX(stats.max[DIFF_POS_NE], stats.max[DIFF_POS_D]), tolerance_pos);
+        failed |= show_error("Velocity error", stats.max[DIFF_VEL], tolerance_vel);
+    }
+    if (failed) {
+        printf("EKF diff failed\n");
+        exit(1);
+    }
+    printf("EKF diff passed\n");
+}
+
+void Replay::write_sweep_summary()
+{
+    FILE *f = xfopen("summary.txt", "w");
+    ::fprintf(f, "%u", (unsigned)sweep_stats.samples);
+    for (uint8_t i=0; i<SWEEP_NUM_STATS; i++) {
+        const float rms = sweep_stats.samples ? sqrt(sweep_stats.sum_sq[i] / sweep_stats.samples) : 0;
+        ::fprintf(f, " %.4f %.4f", rms, sweep_stats.max[i]);
+    }
+    ::fprintf(f, "\n");
+    fclose(f);
+}
+
+/*
+  the EKF cores wrap their update and fusion steps in perf counters,
+  so replaying a log with --profile gives per-call timing of those
+  functions on real sensor data
+ */
+void Replay::setup_profile()
+{
+#if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+    if (!Linux::Perf::get_singleton()->enable_cache_miss_counting()) {
+        ::printf("Cache miss counting not available\n");
+    }
+#else
+    ::printf("Profiling not supported on this board\n");
+#endif
+}
+
+void Replay::show_profile()
+{
+#if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+    Linux::Perf::get_singleton()->print_summary(stdout);
+#endif
+}
+
 void Replay::show_packet_counts()
 {
     uint64_t counts[LOGREADER_MAX_FORMATS];
@@ -845,6 +1229,10 @@ void Replay::loop()
     }
 
     read_sensors(type);
+
+    if (diff_ekf) {
+        update_ekf_diff();
+    }
 }
 
 
@@ -973,4 +1361,12 @@ bool AP_AdvancedFailsafe::gcs_terminate(bool should_terminate, const char *reaso
 // avoid building/linking Devo:
 void AP_DEVO_Telem::init() {};
 
-AP_HAL_MAIN_CALLBACKS(&replay);
+extern "C" {
+int AP_MAIN(int argc, char* const argv[]);
+int AP_MAIN(int argc, char* const argv[])
+{
+    replay.early_setup(argc, argv);
+    hal.run(argc, argv, &replay);
+    return 0;
+}
+}
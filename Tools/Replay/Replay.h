@@ -47,6 +47,8 @@
 #include <errno.h>
 #include <signal.h>
 #include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
 #include <AP_HAL/utility/getopt_cpp.h>
 
 class ReplayVehicle {
@@ -108,6 +110,8 @@ public:
         bool have_imt2:1;
     } log_info {};
 
+    void early_setup(int argc, char * const argv[]);
+
     // return true if a user parameter of name is set
     bool check_user_param(const char *name);
     
@@ -149,6 +153,32 @@ private:
     uint32_t output_counter = 0;
     uint64_t last_timestamp = 0;
     bool packet_counts = false;
+    bool profile = false;
+    // log time to start replaying from, using the log's index
+    uint64_t start_time_us = 0;
+
+    // parameter sweep; sweep_index is the configuration a worker is
+    // replaying, or -1 if not a sweep worker
+    const char *sweep_filename;
+    uint16_t sweep_jobs;
+    int32_t sweep_index = -1;
+    enum sweep_stat {
+        SWEEP_VEL_RATIO,
+        SWEEP_POS_RATIO,
+        SWEEP_HGT_RATIO,
+        SWEEP_MAG_RATIO,
+        SWEEP_TAS_RATIO,
+        SWEEP_VEL_INNOV,
+        SWEEP_POS_INNOV,
+        SWEEP_MAG_INNOV,
+        SWEEP_NUM_STATS
+    };
+    static const char *sweep_stat_names[SWEEP_NUM_STATS];
+    struct {
+        uint32_t samples;
+        double sum_sq[SWEEP_NUM_STATS];
+        float max[SWEEP_NUM_STATS];
+    } sweep_stats {};
 
     struct {
         float max_roll_error;
@@ -159,6 +189,24 @@ private:
         float max_vel_error;
     } check_result {};
 
+    // differences between the replayed and logged output of each EKF
+    bool diff_ekf = false;
+    enum {
+        DIFF_ROLL = 0,
+        DIFF_PITCH,
+        DIFF_YAW,
+        DIFF_VEL,
+        DIFF_POS_NE,
+        DIFF_POS_D,
+        DIFF_NUM_STATS
+    };
+    static const char *diff_stat_names[DIFF_NUM_STATS];
+    struct ekf_diff_stats {
+        uint32_t samples;
+        double sum_sq[DIFF_NUM_STATS];
+        float max[DIFF_NUM_STATS];
+    } ekf_diff[2] {};
+
     void _parse_command_line(uint8_t argc, char * const argv[]);
 
     struct user_parameter {
@@ -185,6 +233,14 @@ private:
     void load_param_file(const char *filename);
     void set_signal_handlers(void);
     void flush_and_exit();
+    void setup_profile();
+    void show_profile();
+    void run_sweep();
+    void start_sweep_worker(uint16_t index, char *config);
+    void update_sweep_stats();
+    void write_sweep_summary();
+    void update_ekf_diff();
+    void report_ekf_diff();
 
     FILE *xfopen(const char *f, const char *mode);
 
@@ -29,12 +29,14 @@ COMMON_VEHICLE_DEPENDENT_LIBRARIES = [
     'AP_Compass',
     'AP_Declination',
     'AP_GPS',
+    'AP_GyroFFT',
     'AP_HAL',
     'AP_HAL_Empty',
     'AP_InertialSensor',
     'AP_Math',
     'AP_Mission',
     'AP_NavEKF2',
+    'AP_NavEKF',
     'AP_NavEKF3',
     'AP_Notify',
     'AP_OpticalFlow',
@@ -60,6 +62,7 @@ COMMON_VEHICLE_DEPENDENT_LIBRARIES = [
     'AP_Button',
     'AP_ICEngine',
     'AP_Frsky_Telem',
+    'AP_RCTelemetry',
     'AP_FlashStorage',
     'AP_Relay',
     'AP_ServoRelayEvents',
@@ -83,6 +86,7 @@ COMMON_VEHICLE_DEPENDENT_LIBRARIES = [
     'AP_LandingGear',
     'AP_RobotisServo',
     'AP_ToshibaCAN',
+    'AP_ESC_Telem',
 ]
 
 def get_legacy_defines(sketch_name):
@@ -7,7 +7,13 @@ Andrew Tridgell
 May 2017
 '''
 
-import os, sys, tempfile, gzip
+import os, sys, zlib
+
+# must match AP_ROMFS_WINDOW_BITS in libraries/AP_ROMFS/AP_ROMFS.h
+romfs_window_bits = 12
+
+# files up to this size are not compressed
+uncompressed_max_size = 256
 
 def write_encode(out, s):
     out.write(s.encode())
@@ -18,7 +24,7 @@ def embed_file(out, f, idx, embedded_name):
         contents = open(f,'rb').read()
     except Exception:
         print("Failed to embed %s" % f)
-        return False
+        return None
 
     pad = 0
     if embedded_name.endswith("bootloader.bin"):
@@ -32,21 +38,21 @@ def embed_file(out, f, idx, embedded_name):
 
     write_encode(out, 'static const uint8_t ap_romfs_%u[] = {' % idx)
 
-    # compress it
-    compressed = tempfile.NamedTemporaryFile()
-    f = open(compressed.name, "wb")
-    with gzip.GzipFile(fileobj=f, mode='wb', filename='', compresslevel=9, mtime=0) as g:
-        g.write(contents)
-    f.close()
-
-    compressed.seek(0)
-    b = bytearray(compressed.read())
-    compressed.close()
-    
+    # compress it as gzip, with the window AP_ROMFS_WINDOW_BITS in
+    # AP_ROMFS.h allows for so the file can be decompressed as a stream
+    c = zlib.compressobj(9, zlib.DEFLATED, 16 + romfs_window_bits)
+    b = bytearray(c.compress(contents) + c.flush())
+
+    # small files, and those that don't compress, are stored as they
+    # are so they can be used in place
+    compressed = len(contents) > uncompressed_max_size and len(b) < len(contents)
+    if not compressed:
+        b = bytearray(contents)
+
     for c in b:
         write_encode(out, '%u,' % c)
     write_encode(out, '};\n\n');
-    return True
+    return compressed
 
 def create_embedded_h(filename, files):
     '''create a ap_romfs_embedded.h file'''
@@ -54,17 +60,20 @@ def create_embedded_h(filename, files):
     out = open(filename, "wb")
     write_encode(out, '''// generated embedded files for AP_ROMFS\n\n''')
 
+    compressed = []
     for i in range(len(files)):
         (name, filename) = files[i]
-        if not embed_file(out, filename, i, name):
+        c = embed_file(out, filename, i, name)
+        if c is None:
             return False
+        compressed.append(c)
 
     write_encode(out, '''const AP_ROMFS::embedded_file AP_ROMFS::files[] = {\n''')
 
     for i in range(len(files)):
         (name, filename) = files[i]
         print(("Embedding file %s:%s" % (name, filename)).encode())
-        write_encode(out, '{ "%s", sizeof(ap_romfs_%u), ap_romfs_%u },\n' % (name, i, i))
+        write_encode(out, '{ "%s", sizeof(ap_romfs_%u), ap_romfs_%u, %s },\n' % (name, i, i, "true" if compressed[i] else "false"))
     write_encode(out, '};\n')
     out.close()
     return True
@@ -1082,6 +1082,13 @@ Brakes have negligible effect (with=%0.2fm without=%0.2fm delta=%0.2fm)
             raise NotAchievedException("Did not get sptgi message")
         print("spgti: %s" % str(sptgi))
 
+    def benchmark_tests(self):
+        return [
+            ("DriveMission",
+             "Drive Mission %s" % "rover1.txt",
+             lambda: self.drive_mission("rover1.txt")),
+        ]
+
     def tests(self):
         '''return list of all tests'''
         ret = super(AutoTestRover, self).tests()
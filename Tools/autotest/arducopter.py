@@ -3161,6 +3161,13 @@ class AutoTestCopter(AutoTest):
         ])
         return ret
 
+    def benchmark_tests(self):
+        return [
+            ("AutoMission",
+             "Fly copter_mission in AUTO",
+             self.fly_auto_test),
+        ]
+
     def disabled_tests(self):
         return {
             "Parachute": "See https://github.com/ArduPilot/ardupilot/issues/4702",
@@ -846,6 +846,13 @@ class AutoTestPlane(AutoTest):
         self.change_mode("FBWA") # we don't update PIDs in MANUAL
         super(AutoTestPlane, self).test_pid_tuning()
 
+    def benchmark_tests(self):
+        return [
+            ("MainFlight",
+             "Lots of things in one flight",
+             self.test_main_flight),
+        ]
+
     def tests(self):
         '''return list of all tests'''
         ret = super(AutoTestPlane, self).tests()
@@ -306,6 +306,27 @@ tester_class_map = {
     "test.AntennaTracker": antennatracker.AutoTestTracker,
 }
 
+benchmark_class_map = {
+    "bench.ArduCopter": arducopter.AutoTestCopter,
+    "bench.ArduPlane": arduplane.AutoTestPlane,
+    "bench.APMrover2": apmrover2.AutoTestRover,
+}
+
+def run_benchmark(step, binary, **kwargs):
+    """Run the benchmark tests of a vehicle, comparing against a
+    baseline report of the same name in --perf-baseline-dir if given"""
+    tester = benchmark_class_map[step](binary, **kwargs)
+    report_name = "%s-perf.json" % step[6:]
+    baseline_path = None
+    if opts.perf_baseline_dir is not None:
+        baseline_path = os.path.join(opts.perf_baseline_dir, report_name)
+        if not os.path.exists(baseline_path):
+            print("No baseline %s, only writing report" % baseline_path)
+            baseline_path = None
+    return tester.benchmark(buildlogs_path(report_name),
+                            baseline_path=baseline_path,
+                            threshold=opts.perf_threshold)
+
 def run_specific_test(step, *args, **kwargs):
     t = split_specific_test_step(step)
     if t is None:
@@ -381,6 +402,9 @@ def run_step(step):
     if opts.speedup is not None:
         fly_opts["speedup"] = opts.speedup
 
+    if step in benchmark_class_map:
+        return run_benchmark(step, binary, **fly_opts)
+
     # handle "fly.ArduCopter" etc:
     if step in tester_class_map:
         return tester_class_map[step](binary, **fly_opts).autotest()
@@ -655,6 +679,14 @@ if __name__ == "__main__":
                       action="store_true",
                       default=False,
                       help="show how long each test took to run")
+    parser.add_option("--perf-baseline-dir",
+                      type='string',
+                      default=None,
+                      help="directory of baseline reports for the bench steps")
+    parser.add_option("--perf-threshold",
+                      type='float',
+                      default=0.2,
+                      help="fraction a bench metric may worsen by before failing")
 
     group_build = optparse.OptionGroup(parser, "Build options")
     group_build.add_option("--no-configure",
@@ -743,6 +775,10 @@ if __name__ == "__main__":
         'dive.ArduSub',
 
         'convertgpx',
+
+        'bench.ArduCopter',
+        'bench.ArduPlane',
+        'bench.APMrover2',
     ]
 
     skipsteps = opts.skip.split(',')
@@ -783,6 +819,9 @@ if __name__ == "__main__":
                 sys.exit(1)
             matched.extend(matches)
         steps = matched
+    else:
+        # benchmarks are only run when asked for
+        steps = [s for s in steps if not s.startswith('bench.')]
 
     # skip steps according to --skip option:
     steps_to_run = [s for s in steps if should_run_step(s)]
@@ -11,6 +11,7 @@ import time
 import traceback
 import pexpect
 import fnmatch
+import json
 import operator
 
 from pymavlink import mavwp, mavutil, DFReader
@@ -169,7 +170,8 @@ class AutoTest(ABC):
                  breakpoints=[],
                  viewerip=None,
                  use_map=False,
-                 _show_test_timings=False):
+                 _show_test_timings=False,
+                 lockstep=False):
 
         self.binary = binary
         self.valgrind = valgrind
@@ -179,6 +181,7 @@ class AutoTest(ABC):
         self.gdbserver = gdbserver
         self.breakpoints = breakpoints
         self.speedup = speedup
+        self.lockstep = lockstep
 
         self.mavproxy = None
         self.mav = None
@@ -1875,6 +1878,7 @@ class AutoTest(ABC):
                                     valgrind=self.valgrind,
                                     vicon=self.uses_vicon(),
                                     wipe=True,
+                                    lockstep=self.lockstep,
                                     )
         self.progress("Starting MAVProxy")
         self.mavproxy = util.start_MAVProxy_SITL(
@@ -2552,6 +2556,178 @@ switch value'''
         print("m=%s" % str(m))
         return m is not None
 
+    def sitl_cpu_time(self):
+        '''return CPU seconds used by the SITL process, or None if unknown'''
+        try:
+            with open("/proc/%u/stat" % self.sitl.pid) as f:
+                # skip past the command name, which may contain spaces
+                fields = f.read().rsplit(')', 1)[1].split()
+        except (IOError, OSError, IndexError):
+            return None
+        # utime and stime are fields 14 and 15 of the whole line
+        return (int(fields[11]) + int(fields[12])) / float(os.sysconf('SC_CLK_TCK'))
+
+    def perf_metrics(self, start_sim_time, start_cpu_time):
+        '''collect performance metrics since the given simulated and CPU
+        times, from the SITL process and the onboard log'''
+        sim_time = self.get_sim_time() - start_sim_time
+        cpu_time = self.sitl_cpu_time()
+        ret = {
+            "sim_time_s": sim_time,
+            "cpu_time_s": None,
+            "cpu_per_sim_s": None,
+            "speedup": None,
+            "loops": 0,
+            "long_loops": 0,
+            "max_loop_us": 0,
+            "internal_errors": 0,
+            "log_dropped": 0,
+            "tasks": {},
+        }
+        if cpu_time is not None and start_cpu_time is not None:
+            ret["cpu_time_s"] = cpu_time - start_cpu_time
+            if sim_time > 0:
+                ret["cpu_per_sim_s"] = ret["cpu_time_s"] / sim_time
+
+        # only look at the log messages from this test
+        start_us = start_sim_time * 1.0e6
+        speedups = []
+        dfreader = self.dfreader_for_current_onboard_log()
+        while True:
+            m = dfreader.recv_match(type=["PM", "TSK", "DSF", "SIMT"])
+            if m is None:
+                break
+            if m.TimeUS < start_us:
+                continue
+            t = m.get_type()
+            if t == "PM":
+                ret["loops"] += m.NLoop
+                ret["long_loops"] += m.NLon
+                ret["max_loop_us"] = max(ret["max_loop_us"], m.MaxT)
+                ret["internal_errors"] = max(ret["internal_errors"], m.IntErr)
+            elif t == "DSF":
+                ret["log_dropped"] = max(ret["log_dropped"], m.Dp)
+            elif t == "SIMT":
+                speedups.append(m.Speedup)
+            elif t == "TSK":
+                name = m.Name
+                if not isinstance(name, str):
+                    name = name.decode('ascii', 'ignore')
+                task = ret["tasks"].setdefault(name, {
+                    "runs": 0,
+                    "total_us": 0,
+                    "max_us": 0,
+                    "slips": 0,
+                    "overruns": 0,
+                })
+                task["runs"] += m.NRun
+                task["total_us"] += m.NRun * m.AvgT
+                task["max_us"] = max(task["max_us"], m.MaxT)
+                task["slips"] += m.NSlip
+                task["overruns"] += m.NOvr
+        for task in ret["tasks"].values():
+            task["avg_us"] = task["total_us"] / float(max(task["runs"], 1))
+            del task["total_us"]
+        if len(speedups):
+            ret["speedup"] = sum(speedups) / len(speedups)
+        return ret
+
+    @staticmethod
+    def perf_regressions(results, baseline, threshold):
+        '''return a list of descriptions of the metrics in results which
+        are more than threshold (a fraction) worse than in baseline'''
+        # metric, whether a higher value is worse, and the change in
+        # value always allowed so small counts don't trip the check
+        checks = [
+            ("cpu_per_sim_s", True, 0),
+            ("speedup", False, 0),
+            ("long_loops", True, 10),
+            ("log_dropped", True, 10),
+            ("internal_errors", True, 0),
+        ]
+        task_checks = [
+            ("avg_us", True, 5),
+            ("slips", True, 10),
+        ]
+
+        def worse(value, base, higher_is_worse, slack):
+            if value is None or base is None:
+                return False
+            if higher_is_worse:
+                return value > base * (1 + threshold) + slack
+            return value < base * (1 - threshold) - slack
+
+        ret = []
+        for (test, result) in results.items():
+            base = baseline.get(test)
+            if base is None:
+                continue
+            for (metric, higher_is_worse, slack) in checks:
+                if worse(result.get(metric), base.get(metric), higher_is_worse, slack):
+                    ret.append("%s: %s %s (baseline %s)" %
+                               (test, metric, result[metric], base[metric]))
+            base_tasks = base.get("tasks", {})
+            for (name, task) in result.get("tasks", {}).items():
+                base_task = base_tasks.get(name)
+                if base_task is None:
+                    continue
+                for (metric, higher_is_worse, slack) in task_checks:
+                    if worse(task.get(metric), base_task.get(metric), higher_is_worse, slack):
+                        ret.append("%s: task %s %s %s (baseline %s)" %
+                                   (test, name, metric, task[metric], base_task[metric]))
+        return ret
+
+    def benchmark_tests(self):
+        '''return the list of tests run by benchmark()'''
+        return []
+
+    def benchmark_setup(self):
+        '''turn on the logging the performance metrics come from, for all
+        the tests which follow'''
+        self.set_parameter("SCHED_OPTIONS", 1, add_to_context=False) # RecordTaskInfo
+        self.set_parameter("LOG_DISARMED", 1, add_to_context=False)
+        self.reboot_sitl()
+
+    def benchmark(self, report_path, baseline_path=None, threshold=0.2):
+        '''run benchmark_tests() in lockstep SITL, writing their performance
+        metrics to report_path as JSON. Returns False if a test fails or
+        a metric is more than threshold worse than in the baseline report
+        at baseline_path'''
+        self.lockstep = True
+        results = {}
+
+        def measure(name, func):
+            def run():
+                start_sim_time = self.get_sim_time()
+                start_cpu_time = self.sitl_cpu_time()
+                func()
+                results[name] = self.perf_metrics(start_sim_time, start_cpu_time)
+            return run
+
+        tests = [("BenchmarkSetup",
+                  "Enable performance logging",
+                  self.benchmark_setup)]
+        for (name, desc, func) in self.benchmark_tests():
+            tests.append((name, desc, measure(name, func)))
+        ret = self.run_tests(tests)
+
+        with open(report_path, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+        self.progress("Wrote performance report %s" % report_path)
+
+        if baseline_path is not None:
+            with open(baseline_path) as f:
+                baseline = json.load(f)
+            regressions = self.perf_regressions(results, baseline, threshold)
+            if len(regressions):
+                self.progress("Performance regressions against %s:" % baseline_path)
+                for regression in regressions:
+                    print("  %s" % regression)
+                ret = False
+            else:
+                self.progress("No performance regressions against %s" % baseline_path)
+        return ret
+
     def run_tests(self, tests):
         """Autotest vehicle in SITL."""
         if self.run_tests_called:
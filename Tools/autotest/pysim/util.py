@@ -227,7 +227,8 @@ def start_SITL(binary,
                unhide_parameters=False,
                gdbserver=False,
                breakpoints=[],
-               vicon=False):
+               vicon=False,
+               lockstep=False):
     """Launch a SITL instance."""
     cmd = []
     if valgrind and os.path.exists('/usr/bin/valgrind'):
@@ -283,6 +284,8 @@ def start_SITL(binary,
         cmd.extend(['--model', model])
     if speedup != 1:
         cmd.extend(['--speedup', str(speedup)])
+    if lockstep:
+        cmd.append('--lockstep')
     if defaults_file is not None:
         cmd.extend(['--defaults', defaults_file])
     if unhide_parameters:
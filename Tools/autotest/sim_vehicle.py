@@ -397,23 +397,25 @@ def get_user_locations_path():
     return user_locations_path
 
 
-def find_new_spawn(loc, file_path):
+def find_new_spawn(loc, file_path, instance=None):
+    if instance is None:
+        instance = cmd_opts.instance
     (lat, lon, alt, heading) = loc.split(",")
     swarminit_filepath = os.path.join(find_autotest_dir(), "swarminit.txt")
     for path2 in [file_path, swarminit_filepath]:
-        if os.path.isfile(path2):
+        if path2 is not None and os.path.isfile(path2):
             with open(path2, 'r') as swd:
                 next(swd)
                 for lines in swd:
                     if len(lines) == 0:
                         continue
-                    (instance, offset) = lines.split("=")
-                    if ((int)(instance) == (int)(cmd_opts.instance)):
+                    (line_instance, offset) = lines.split("=")
+                    if ((int)(line_instance) == (int)(instance)):
                         (x, y, z, head) = offset.split(",")
                         g = mavextra.gps_offset((float)(lat), (float)(lon), (float)(x), (float)(y))
-                        loc = str(g[0])+","+str(g[1])+","+str(alt+z)+","+str(head)
+                        loc = str(g[0])+","+str(g[1])+","+str(float(alt)+float(z))+","+str(head)
                         return loc
-        g = mavextra.gps_newpos((float)(lat), (float)(lon), 90, 20*(int)(cmd_opts.instance))
+        g = mavextra.gps_newpos((float)(lat), (float)(lon), 90, 20*(int)(instance))
         loc = str(g[0])+","+str(g[1])+","+str(alt)+","+str(heading)
         return loc
 
@@ -532,10 +534,12 @@ def start_antenna_tracker(autotest, opts):
     os.chdir(oldpwd)
 
 
-def start_vehicle(binary, autotest, opts, stuff, loc):
+def start_vehicle(binary, autotest, opts, stuff, loc, instance):
     """Run the ArduPilot binary"""
 
     cmd_name = opts.vehicle
+    if opts.count > 1:
+        cmd_name += " %u" % instance
     cmd = []
     if opts.valgrind:
         cmd_name += " (valgrind)"
@@ -568,12 +572,14 @@ def start_vehicle(binary, autotest, opts, stuff, loc):
 
     cmd.append(binary)
     cmd.append("-S")
-    cmd.append("-I" + str(opts.instance))
+    cmd.append("-I" + str(instance))
     cmd.extend(["--home", loc])
     if opts.wipe_eeprom:
         cmd.append("-w")
     cmd.extend(["--model", stuff["model"]])
     cmd.extend(["--speedup", str(opts.speedup)])
+    if opts.auto_sysid:
+        cmd.extend(["--sysid", str(instance + 1)])
     if opts.sitl_instance_args:
         # this could be a lot better:
         cmd.extend(opts.sitl_instance_args.split(" "))
@@ -626,7 +632,9 @@ def start_mavproxy(opts, stuff):
         if opts.mcast:
             cmd.extend(["--master", "mcast:"])
         else:
-            cmd.extend(["--master", mavlink_port])
+            for i in range(opts.count):
+                port = 5760 + 10 * (cmd_opts.instance + i)
+                cmd.extend(["--master", "tcp:127.0.0.1:" + str(port)])
         if stuff["sitl-port"]:
             cmd.extend(["--sitl", simout_port])
 
@@ -921,6 +929,15 @@ group_sim.add_option("-Z", "--swarm",
 group_sim.add_option("--flash-storage",
                      action='store_true',
                      help="enable use of flash storage emulation")
+group_sim.add_option("", "--count",
+                     type='int',
+                     default=1,
+                     help="number of vehicles to start, with instances counting up from -I. "
+                     "Each runs in its own subdirectory and spawns offset from the first")
+group_sim.add_option("", "--auto-sysid",
+                     action='store_true',
+                     default=False,
+                     help="set SYSID_THISMAV to the instance number plus one")
 parser.add_option_group(group_sim)
 
 
@@ -1083,11 +1100,32 @@ else:
         print("Vehicle binary (%s) does not exist" % (vehicle_binary,))
         sys.exit(1)
 
-    start_vehicle(vehicle_binary,
-                  find_autotest_dir(),
-                  cmd_opts,
-                  frame_infos,
-                  location)
+    for i in range(cmd_opts.count):
+        instance = cmd_opts.instance + i
+        if cmd_opts.count == 1:
+            start_vehicle(vehicle_binary,
+                          find_autotest_dir(),
+                          cmd_opts,
+                          frame_infos,
+                          location,
+                          instance)
+            continue
+        # each vehicle needs its own eeprom and logs
+        instance_dir = os.path.join(os.getcwd(), str(instance))
+        if not os.path.exists(instance_dir):
+            os.makedirs(instance_dir)
+        instance_location = location
+        if i > 0:
+            instance_location = find_new_spawn(location, cmd_opts.swarm, instance)
+        oldpwd = os.getcwd()
+        os.chdir(instance_dir)
+        start_vehicle(vehicle_binary,
+                      find_autotest_dir(),
+                      cmd_opts,
+                      frame_infos,
+                      instance_location,
+                      instance)
+        os.chdir(oldpwd)
 
 if cmd_opts.delay_start:
     progress("Sleeping for %f seconds" % (cmd_opts.delay_start,))
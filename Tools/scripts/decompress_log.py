@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+'''
+decompress a log written with LOG_FILE_COMPRESS=1 into a normal
+dataflash .bin log
+
+the compressed log is a sequence of frames, each with a 7 byte header
+(0xA3 0x96, flags, raw length, data length) followed by either raw log
+data or an LZ4 block
+'''
+
+from __future__ import print_function
+
+import argparse
+import struct
+import sys
+
+FRAME_HEADER = struct.Struct('<BBBHH')
+FRAME_MAGIC = (0xA3, 0x96)
+FRAME_COMPRESSED = 1
+
+
+def lz4_block_decompress(data, raw_len):
+    '''decode a single LZ4 block'''
+    src = bytearray(data)
+    out = bytearray()
+    i = 0
+    while i < len(src):
+        token = src[i]
+        i += 1
+        lit_len = token >> 4
+        if lit_len == 15:
+            while True:
+                b = src[i]
+                i += 1
+                lit_len += b
+                if b != 255:
+                    break
+        out += src[i:i+lit_len]
+        i += lit_len
+        if i >= len(src):
+            break
+        offset = src[i] | (src[i+1] << 8)
+        i += 2
+        match_len = token & 0x0F
+        if match_len == 15:
+            while True:
+                b = src[i]
+                i += 1
+                match_len += b
+                if b != 255:
+                    break
+        match_len += 4
+        if offset == 0 or offset > len(out):
+            raise ValueError("bad match offset")
+        start = len(out) - offset
+        for j in range(match_len):
+            out.append(out[start+j])
+    if len(out) != raw_len:
+        raise ValueError("bad block length %u != %u" % (len(out), raw_len))
+    return out
+
+
+def decompress(infile, outfile):
+    with open(infile, 'rb') as f:
+        data = f.read()
+    ofs = 0
+    nframes = 0
+    with open(outfile, 'wb') as out:
+        while ofs + FRAME_HEADER.size <= len(data):
+            (m1, m2, flags, raw_len, data_len) = FRAME_HEADER.unpack_from(data, ofs)
+            if (m1, m2) != FRAME_MAGIC:
+                print("Bad frame header at offset %u" % ofs)
+                break
+            ofs += FRAME_HEADER.size
+            if ofs + data_len > len(data):
+                print("Truncated frame at offset %u" % ofs)
+                break
+            block = data[ofs:ofs+data_len]
+            ofs += data_len
+            if flags & FRAME_COMPRESSED:
+                block = lz4_block_decompress(block, raw_len)
+            out.write(block)
+            nframes += 1
+    print("Decompressed %u frames" % nframes)
+
+
+parser = argparse.ArgumentParser(description=__doc__)
+parser.add_argument('infile', help='compressed log')
+parser.add_argument('outfile', help='decompressed .bin log')
+args = parser.parse_args()
+
+decompress(args.infile, args.outfile)
@@ -252,8 +252,11 @@ void AC_AttitudeControl::input_euler_angle_roll_pitch_euler_rate_yaw(float euler
     euler_roll_angle += get_roll_trim_rad();
 
     if (_rate_bf_ff_enabled) {
+        // the euler angles are the same for all the conversions below
+        const EulerTrig trig(_attitude_target_euler_angle);
+
         // translate the roll pitch and yaw acceleration limits to the euler axis
-        Vector3f euler_accel = euler_accel_limit(_attitude_target_euler_angle, Vector3f(get_accel_roll_max_radss(), get_accel_pitch_max_radss(), get_accel_yaw_max_radss()));
+        Vector3f euler_accel = euler_accel_limit(trig, Vector3f(get_accel_roll_max_radss(), get_accel_pitch_max_radss(), get_accel_yaw_max_radss()));
 
         // When acceleration limiting and feedforward are enabled, the sqrt controller is used to compute an euler
         // angular velocity that will cause the euler angle to smoothly stop at the input angle with limited deceleration
@@ -266,11 +269,11 @@ void AC_AttitudeControl::input_euler_angle_roll_pitch_euler_rate_yaw(float euler
         _attitude_target_euler_rate.z = input_shaping_ang_vel(_attitude_target_euler_rate.z, euler_yaw_rate, euler_accel.z, _dt);
 
         // Convert euler angle derivative of desired attitude into a body-frame angular velocity vector for feedforward
-        euler_rate_to_ang_vel(_attitude_target_euler_angle, _attitude_target_euler_rate, _attitude_target_ang_vel);
+        euler_rate_to_ang_vel(trig, _attitude_target_euler_rate, _attitude_target_ang_vel);
         // Limit the angular velocity
         ang_vel_limit(_attitude_target_ang_vel, radians(_ang_vel_roll_max), radians(_ang_vel_pitch_max), radians(_ang_vel_yaw_max));
         // Convert body-frame angular velocity into euler angle derivative of desired attitude
-        ang_vel_to_euler_rate(_attitude_target_euler_angle, _attitude_target_ang_vel, _attitude_target_euler_rate);
+        ang_vel_to_euler_rate(trig, _attitude_target_ang_vel, _attitude_target_euler_rate);
     } else {
         // When feedforward is not enabled, the target euler angle is input into the target and the feedforward rate is zeroed.
         _attitude_target_euler_angle.x = euler_roll_angle;
@@ -303,8 +306,11 @@ void AC_AttitudeControl::input_euler_angle_roll_pitch_yaw(float euler_roll_angle
     euler_roll_angle += get_roll_trim_rad();
 
     if (_rate_bf_ff_enabled) {
+        // the euler angles are the same for all the conversions below
+        const EulerTrig trig(_attitude_target_euler_angle);
+
         // translate the roll pitch and yaw acceleration limits to the euler axis
-        Vector3f euler_accel = euler_accel_limit(_attitude_target_euler_angle, Vector3f(get_accel_roll_max_radss(), get_accel_pitch_max_radss(), get_accel_yaw_max_radss()));
+        Vector3f euler_accel = euler_accel_limit(trig, Vector3f(get_accel_roll_max_radss(), get_accel_pitch_max_radss(), get_accel_yaw_max_radss()));
 
         // When acceleration limiting and feedforward are enabled, the sqrt controller is used to compute an euler
         // angular velocity that will cause the euler angle to smoothly stop at the input angle with limited deceleration
@@ -317,11 +323,11 @@ void AC_AttitudeControl::input_euler_angle_roll_pitch_yaw(float euler_roll_angle
         }
 
         // Convert euler angle derivative of desired attitude into a body-frame angular velocity vector for feedforward
-        euler_rate_to_ang_vel(_attitude_target_euler_angle, _attitude_target_euler_rate, _attitude_target_ang_vel);
+        euler_rate_to_ang_vel(trig, _attitude_target_euler_rate, _attitude_target_ang_vel);
         // Limit the angular velocity
         ang_vel_limit(_attitude_target_ang_vel, radians(_ang_vel_roll_max), radians(_ang_vel_pitch_max), radians(_ang_vel_yaw_max));
         // Convert body-frame angular velocity into euler angle derivative of desired attitude
-        ang_vel_to_euler_rate(_attitude_target_euler_angle, _attitude_target_ang_vel, _attitude_target_euler_rate);
+        ang_vel_to_euler_rate(trig, _attitude_target_ang_vel, _attitude_target_euler_rate);
     } else {
         // When feedforward is not enabled, the target euler angle is input into the target and the feedforward rate is zeroed.
         _attitude_target_euler_angle.x = euler_roll_angle;
@@ -431,7 +437,7 @@ void AC_AttitudeControl::input_euler_rate_yaw_euler_angle_pitch_bf_roll_p(float
 
     // Compute attitude error
     Quaternion attitude_vehicle_quat;
-    attitude_vehicle_quat.from_rotation_matrix(_ahrs.get_rotation_body_to_ned());
+    _ahrs.get_quat_body_to_ned(attitude_vehicle_quat);
 
     Quaternion error_quat;
     error_quat = attitude_vehicle_quat.inverse() * _attitude_target_quat;
@@ -454,8 +460,11 @@ void AC_AttitudeControl::input_euler_rate_roll_pitch_yaw(float euler_roll_rate_c
     _attitude_target_quat.to_euler(_attitude_target_euler_angle.x, _attitude_target_euler_angle.y, _attitude_target_euler_angle.z);
 
     if (_rate_bf_ff_enabled) {
+        // the euler angles are the same for all the conversions below
+        const EulerTrig trig(_attitude_target_euler_angle);
+
         // translate the roll pitch and yaw acceleration limits to the euler axis
-        Vector3f euler_accel = euler_accel_limit(_attitude_target_euler_angle, Vector3f(get_accel_roll_max_radss(), get_accel_pitch_max_radss(), get_accel_yaw_max_radss()));
+        Vector3f euler_accel = euler_accel_limit(trig, Vector3f(get_accel_roll_max_radss(), get_accel_pitch_max_radss(), get_accel_yaw_max_radss()));
 
         // When acceleration limiting is enabled, the input shaper constrains angular acceleration, slewing
         // the output rate towards the input rate.
@@ -464,7 +473,7 @@ void AC_AttitudeControl::input_euler_rate_roll_pitch_yaw(float euler_roll_rate_c
         _attitude_target_euler_rate.z = input_shaping_ang_vel(_attitude_target_euler_rate.z, euler_yaw_rate, euler_accel.z, _dt);
 
         // Convert euler angle derivative of desired attitude into a body-frame angular velocity vector for feedforward
-        euler_rate_to_ang_vel(_attitude_target_euler_angle, _attitude_target_euler_rate, _attitude_target_ang_vel);
+        euler_rate_to_ang_vel(trig, _attitude_target_euler_rate, _attitude_target_ang_vel);
     } else {
         // When feedforward is not enabled, the target euler angle is input into the target and the feedforward rate is zeroed.
         // Pitch angle is restricted to +- 85.0 degrees to avoid gimbal lock discontinuities.
@@ -670,17 +679,22 @@ void AC_AttitudeControl::attitude_controller_run_quat()
     _attitude_ang_error = attitude_vehicle_quat.inverse() * _attitude_target_quat;
 }
 
+// thrust_vector - the body z axis of an attitude in the inertial frame. This is the third
+// column of the rotation matrix of the quaternion, without forming the whole matrix
+Vector3f AC_AttitudeControl::thrust_vector(const Quaternion& att_quat)
+{
+    return Vector3f(2.0f*(att_quat.q2*att_quat.q4 + att_quat.q1*att_quat.q3),
+                    2.0f*(att_quat.q3*att_quat.q4 - att_quat.q1*att_quat.q2),
+                    1.0f-2.0f*(att_quat.q2*att_quat.q2 + att_quat.q3*att_quat.q3));
+}
+
 // thrust_heading_rotation_angles - calculates two ordered rotations to move the att_from_quat quaternion to the att_to_quat quaternion.
 // The first rotation corrects the thrust vector and the second rotation corrects the heading vector.
 void AC_AttitudeControl::thrust_heading_rotation_angles(Quaternion& att_to_quat, const Quaternion& att_from_quat, Vector3f& att_diff_angle, float& thrust_vec_dot)
 {
-    Matrix3f att_to_rot_matrix; // rotation from the target body frame to the inertial frame.
-    att_to_quat.rotation_matrix(att_to_rot_matrix);
-    Vector3f att_to_thrust_vec = att_to_rot_matrix*Vector3f(0.0f,0.0f,1.0f);
-
-    Matrix3f att_from_rot_matrix; // rotation from the current body frame to the inertial frame.
-    att_from_quat.rotation_matrix(att_from_rot_matrix);
-    Vector3f att_from_thrust_vec = att_from_rot_matrix*Vector3f(0.0f,0.0f,1.0f);
+    // thrust vectors of the target and current body frames in the inertial frame
+    const Vector3f att_to_thrust_vec = thrust_vector(att_to_quat);
+    const Vector3f att_from_thrust_vec = thrust_vector(att_from_quat);
 
     // the cross product of the desired and target thrust vector defines the rotation vector
     Vector3f thrust_vec_cross = att_from_thrust_vec % att_to_thrust_vec;
@@ -700,10 +714,11 @@ void AC_AttitudeControl::thrust_heading_rotation_angles(Quaternion& att_to_quat,
     thrust_vec_correction_quat.from_axis_angle(thrust_vec_cross, thrust_vec_dot);
 
     // Rotate thrust_vec_correction_quat to the att_from frame
-    thrust_vec_correction_quat = att_from_quat.inverse()*thrust_vec_correction_quat*att_from_quat;
+    const Quaternion att_from_quat_inv = att_from_quat.inverse();
+    thrust_vec_correction_quat = att_from_quat_inv*thrust_vec_correction_quat*att_from_quat;
 
     // calculate the remaining rotation required after thrust vector is rotated transformed to the att_from frame
-    Quaternion yaw_vec_correction_quat = thrust_vec_correction_quat.inverse()*att_from_quat.inverse()*att_to_quat;
+    Quaternion yaw_vec_correction_quat = thrust_vec_correction_quat.inverse()*att_from_quat_inv*att_to_quat;
 
     // calculate the angle error in x and y.
     Vector3f rotation;
@@ -796,9 +811,14 @@ void AC_AttitudeControl::ang_vel_limit(Vector3f& euler_rad, float ang_vel_roll_m
 // translates body frame acceleration limits to the euler axis
 Vector3f AC_AttitudeControl::euler_accel_limit(const Vector3f &euler_rad, const Vector3f &euler_accel)
 {
-    float sin_phi = constrain_float(fabsf(sinf(euler_rad.x)), 0.1f, 1.0f);
-    float cos_phi = constrain_float(fabsf(cosf(euler_rad.x)), 0.1f, 1.0f);
-    float sin_theta = constrain_float(fabsf(sinf(euler_rad.y)), 0.1f, 1.0f);
+    return euler_accel_limit(EulerTrig(euler_rad), euler_accel);
+}
+
+Vector3f AC_AttitudeControl::euler_accel_limit(const EulerTrig &trig, const Vector3f &euler_accel)
+{
+    float sin_phi = constrain_float(fabsf(trig.sin_phi), 0.1f, 1.0f);
+    float cos_phi = constrain_float(fabsf(trig.cos_phi), 0.1f, 1.0f);
+    float sin_theta = constrain_float(fabsf(trig.sin_theta), 0.1f, 1.0f);
 
     Vector3f rot_accel;
     if(is_zero(euler_accel.x) || is_zero(euler_accel.y) || is_zero(euler_accel.z) || is_negative(euler_accel.x) || is_negative(euler_accel.y) || is_negative(euler_accel.z)) {
@@ -836,13 +856,26 @@ void AC_AttitudeControl::inertial_frame_reset()
     _attitude_target_quat.to_euler(_attitude_target_euler_angle.x, _attitude_target_euler_angle.y, _attitude_target_euler_angle.z);
 }
 
+AC_AttitudeControl::EulerTrig::EulerTrig(const Vector3f& euler_rad) :
+    sin_phi(sinf(euler_rad.x)),
+    cos_phi(cosf(euler_rad.x)),
+    sin_theta(sinf(euler_rad.y)),
+    cos_theta(cosf(euler_rad.y))
+{
+}
+
 // Convert a 321-intrinsic euler angle derivative to an angular velocity vector
 void AC_AttitudeControl::euler_rate_to_ang_vel(const Vector3f& euler_rad, const Vector3f& euler_rate_rads, Vector3f& ang_vel_rads)
 {
-    float sin_theta = sinf(euler_rad.y);
-    float cos_theta = cosf(euler_rad.y);
-    float sin_phi = sinf(euler_rad.x);
-    float cos_phi = cosf(euler_rad.x);
+    euler_rate_to_ang_vel(EulerTrig(euler_rad), euler_rate_rads, ang_vel_rads);
+}
+
+void AC_AttitudeControl::euler_rate_to_ang_vel(const EulerTrig& trig, const Vector3f& euler_rate_rads, Vector3f& ang_vel_rads)
+{
+    const float sin_theta = trig.sin_theta;
+    const float cos_theta = trig.cos_theta;
+    const float sin_phi = trig.sin_phi;
+    const float cos_phi = trig.cos_phi;
 
     ang_vel_rads.x = euler_rate_rads.x - sin_theta * euler_rate_rads.z;
     ang_vel_rads.y = cos_phi  * euler_rate_rads.y + sin_phi * cos_theta * euler_rate_rads.z;
@@ -853,10 +886,15 @@ void AC_AttitudeControl::euler_rate_to_ang_vel(const Vector3f& euler_rad, const
 // Returns false if the vehicle is pitched 90 degrees up or down
 bool AC_AttitudeControl::ang_vel_to_euler_rate(const Vector3f& euler_rad, const Vector3f& ang_vel_rads, Vector3f& euler_rate_rads)
 {
-    float sin_theta = sinf(euler_rad.y);
-    float cos_theta = cosf(euler_rad.y);
-    float sin_phi = sinf(euler_rad.x);
-    float cos_phi = cosf(euler_rad.x);
+    return ang_vel_to_euler_rate(EulerTrig(euler_rad), ang_vel_rads, euler_rate_rads);
+}
+
+bool AC_AttitudeControl::ang_vel_to_euler_rate(const EulerTrig& trig, const Vector3f& ang_vel_rads, Vector3f& euler_rate_rads)
+{
+    const float sin_theta = trig.sin_theta;
+    const float cos_theta = trig.cos_theta;
+    const float sin_phi = trig.sin_phi;
+    const float cos_phi = trig.cos_phi;
 
     // When the vehicle pitches all the way up or all the way down, the euler angles become discontinuous. In this case, we just return false.
     if (is_zero(cos_theta)) {
@@ -160,12 +160,29 @@ public:
     // Run angular velocity controller and send outputs to the motors
     virtual void rate_controller_run() = 0;
 
+    // Run angular velocity controller on the given body rates with a
+    // time step of dt, for callers running it faster than the main
+    // loop. Controllers without support run at the main loop rate
+    virtual void rate_controller_run_gyro(const Vector3f &gyro_rads, float dt) { rate_controller_run(); }
+
+    // sines and cosines of the roll and pitch of a set of 321-intrinsic euler angles,
+    // so that conversions using the same angles only calculate them once
+    struct EulerTrig {
+        explicit EulerTrig(const Vector3f& euler_rad);
+        float sin_phi;
+        float cos_phi;
+        float sin_theta;
+        float cos_theta;
+    };
+
     // Convert a 321-intrinsic euler angle derivative to an angular velocity vector
     void euler_rate_to_ang_vel(const Vector3f& euler_rad, const Vector3f& euler_rate_rads, Vector3f& ang_vel_rads);
+    void euler_rate_to_ang_vel(const EulerTrig& trig, const Vector3f& euler_rate_rads, Vector3f& ang_vel_rads);
 
     // Convert an angular velocity vector to a 321-intrinsic euler angle derivative
     // Returns false if the vehicle is pitched 90 degrees up or down
     bool ang_vel_to_euler_rate(const Vector3f& euler_rad, const Vector3f& ang_vel_rads, Vector3f& euler_rate_rads);
+    bool ang_vel_to_euler_rate(const EulerTrig& trig, const Vector3f& ang_vel_rads, Vector3f& euler_rate_rads);
 
     // Specifies whether the attitude controller should use the square root controller in the attitude correction.
     // This is used during Autotune to ensure the P term is tuned without being influenced by the acceleration limit of the square root controller.
@@ -262,6 +279,10 @@ public:
 
     // translates body frame acceleration limits to the euler axis
     Vector3f euler_accel_limit(const Vector3f &euler_rad, const Vector3f &euler_accel);
+    Vector3f euler_accel_limit(const EulerTrig &trig, const Vector3f &euler_accel);
+
+    // thrust_vector - the body z axis of an attitude in the inertial frame
+    static Vector3f thrust_vector(const Quaternion& att_quat);
 
     // thrust_heading_rotation_angles - calculates two ordered rotations to move the att_from_quat quaternion to the att_to_quat quaternion.
     // The first rotation corrects the thrust vector and the second rotation corrects the heading vector.
@@ -237,28 +237,38 @@ float AC_AttitudeControl_Multi::get_throttle_avg_max(float throttle_in)
 }
 
 // update_throttle_rpy_mix - slew set_throttle_rpy_mix to requested value
-void AC_AttitudeControl_Multi::update_throttle_rpy_mix()
+void AC_AttitudeControl_Multi::update_throttle_rpy_mix(float dt)
 {
     // slew _throttle_rpy_mix to _throttle_rpy_mix_desired
     if (_throttle_rpy_mix < _throttle_rpy_mix_desired) {
         // increase quickly (i.e. from 0.1 to 0.9 in 0.4 seconds)
-        _throttle_rpy_mix += MIN(2.0f*_dt, _throttle_rpy_mix_desired-_throttle_rpy_mix);
+        _throttle_rpy_mix += MIN(2.0f*dt, _throttle_rpy_mix_desired-_throttle_rpy_mix);
     } else if (_throttle_rpy_mix > _throttle_rpy_mix_desired) {
         // reduce more slowly (from 0.9 to 0.1 in 1.6 seconds)
-        _throttle_rpy_mix -= MIN(0.5f*_dt, _throttle_rpy_mix-_throttle_rpy_mix_desired);
+        _throttle_rpy_mix -= MIN(0.5f*dt, _throttle_rpy_mix-_throttle_rpy_mix_desired);
     }
     _throttle_rpy_mix = constrain_float(_throttle_rpy_mix, 0.1f, AC_ATTITUDE_CONTROL_MAX);
 }
 
 void AC_AttitudeControl_Multi::rate_controller_run()
+{
+    rate_controller_run_gyro(_ahrs.get_gyro_latest(), _dt);
+}
+
+void AC_AttitudeControl_Multi::rate_controller_run_gyro(const Vector3f &gyro_rads, float dt)
 {
     // move throttle vs attitude mixing towards desired (called from here because this is conveniently called on every iteration)
-    update_throttle_rpy_mix();
+    update_throttle_rpy_mix(dt);
+
+    // run the three rate PIDs together, only the yaw input is fully filtered
+    AC_PID *const pids[3] { &_pid_rate_roll, &_pid_rate_pitch, &_pid_rate_yaw };
+    const bool filter_all[3] { false, false, true };
+    const bool limited[3] { bool(_motors.limit.roll_pitch), bool(_motors.limit.roll_pitch), bool(_motors.limit.yaw) };
+    const Vector3f output = AC_PID::update_rate_3axis(pids, _rate_target_ang_vel, gyro_rads, dt, filter_all, limited);
 
-    Vector3f gyro_latest = _ahrs.get_gyro_latest();
-    _motors.set_roll(rate_target_to_motor_roll(gyro_latest.x, _rate_target_ang_vel.x));
-    _motors.set_pitch(rate_target_to_motor_pitch(gyro_latest.y, _rate_target_ang_vel.y));
-    _motors.set_yaw(rate_target_to_motor_yaw(gyro_latest.z, _rate_target_ang_vel.z));
+    _motors.set_roll(output.x);
+    _motors.set_pitch(output.y);
+    _motors.set_yaw(output.z);
 
     control_monitor_update();
 }
@@ -178,6 +178,15 @@ const AP_Param::GroupInfo AC_PosControl::var_info[] = {
     // @User: Advanced
     AP_GROUPINFO("_ANGLE_MAX",  7, AC_PosControl, _lean_angle_max, 0.0f),
 
+    // @Param: _JERK_XY
+    // @DisplayName: Position Control horizontal jerk limit
+    // @Description: Maximum rate of change of the horizontal acceleration fed forward by input_pos_vel_xy and input_vel_xy.  Lower values give smoother but slower trajectories
+    // @Units: cm/s/s/s
+    // @Range: 100 5000
+    // @Increment: 10
+    // @User: Advanced
+    AP_GROUPINFO("_JERK_XY",  8, AC_PosControl, _jerk_xy_cmsss, POSCONTROL_JERK_XY),
+
     AP_GROUPEND
 };
 
@@ -793,6 +802,39 @@ void AC_PosControl::init_xy_controller()
     init_ekf_xy_reset();
 }
 
+/// input_pos_vel_xy - move the xy trajectory smoothly towards pos_cm, arriving moving at vel_cms
+void AC_PosControl::input_pos_vel_xy(const Vector2f& pos_cm, const Vector2f& vel_cms, float dt)
+{
+    Vector2f vel_desired(_vel_desired.x, _vel_desired.y);
+    Vector2f accel_desired(_accel_desired.x, _accel_desired.y);
+    shape_pos_vel_accel_xy(pos_cm, vel_cms, Vector2f(),
+                           Vector2f(_pos_target.x, _pos_target.y), vel_desired, accel_desired,
+                           _speed_cms, _accel_cms, _jerk_xy_cmsss, dt);
+    set_trajectory_xy(vel_desired, accel_desired, dt);
+}
+
+/// input_vel_xy - move the xy trajectory smoothly towards vel_cms
+void AC_PosControl::input_vel_xy(const Vector2f& vel_cms, float dt)
+{
+    Vector2f vel_desired(_vel_desired.x, _vel_desired.y);
+    Vector2f accel_desired(_accel_desired.x, _accel_desired.y);
+    shape_vel_accel_xy(vel_cms, Vector2f(), vel_desired, accel_desired, _accel_cms, _jerk_xy_cmsss, dt);
+    set_trajectory_xy(vel_desired, accel_desired, dt);
+}
+
+/// set_trajectory_xy - integrate the shaped acceleration into the desired velocity and store both as feed forward
+///     the position target follows in desired_vel_to_pos
+void AC_PosControl::set_trajectory_xy(const Vector2f& vel_desired, const Vector2f& accel_desired, float dt)
+{
+    if (!is_positive(dt)) {
+        return;
+    }
+    _vel_desired.x = vel_desired.x + accel_desired.x * dt;
+    _vel_desired.y = vel_desired.y + accel_desired.y * dt;
+    _accel_desired.x = accel_desired.x;
+    _accel_desired.y = accel_desired.y;
+}
+
 /// update_xy_controller - run the horizontal position controller - should be called at 100hz or higher
 void AC_PosControl::update_xy_controller()
 {
@@ -37,6 +37,7 @@
 #define POSCONTROL_THROTTLE_CUTOFF_FREQ         2.0f    // low-pass filter on accel error (unit: hz)
 #define POSCONTROL_ACCEL_FILTER_HZ              2.0f    // low-pass filter on acceleration (unit: hz)
 #define POSCONTROL_JERK_RATIO                   1.0f    // Defines the time it takes to reach the requested acceleration
+#define POSCONTROL_JERK_XY                      1000.0f // default horizontal jerk limit of the trajectory shaping in cm/s/s/s
 
 #define POSCONTROL_OVERSPEED_GAIN_Z             2.0f    // gain controlling rate at which z-axis speed is brought back within SPEED_UP and SPEED_DOWN range
 
@@ -227,6 +228,19 @@ public:
     // is_active_xy - returns true if the xy position controller has been run very recently
     bool is_active_xy() const;
 
+    /// input_pos_vel_xy - move the xy trajectory smoothly towards pos_cm, arriving moving at vel_cms
+    ///     the current position target, desired velocity and desired acceleration are the start of the trajectory
+    ///     the desired velocity and acceleration are updated within the speed, acceleration and jerk limits
+    ///     should be called once before each call to update_xy_controller, with dt the time between calls
+    void input_pos_vel_xy(const Vector2f& pos_cm, const Vector2f& vel_cms, float dt);
+
+    /// input_vel_xy - move the xy trajectory smoothly towards vel_cms
+    ///     as input_pos_vel_xy but without a position target, such as for pilot controlled velocity
+    void input_vel_xy(const Vector2f& vel_cms, float dt);
+
+    /// get_max_jerk_xy - returns the horizontal jerk limit of the trajectory shaping in cm/s/s/s
+    float get_max_jerk_xy() const { return _jerk_xy_cmsss; }
+
     /// update_xy_controller - run the horizontal position controller - should be called at 100hz or higher
     ///     when use_desired_velocity is true the desired velocity (i.e. feed forward) is incorporated at the pos_to_rate step
     void update_xy_controller();
@@ -345,6 +359,9 @@ protected:
     /// desired_vel_to_pos - move position target using desired velocities
     void desired_vel_to_pos(float nav_dt);
 
+    /// set_trajectory_xy - store the shaped xy velocity, advanced by dt, and acceleration as the desired feed forward
+    void set_trajectory_xy(const Vector2f& vel_desired, const Vector2f& accel_desired, float dt);
+
     /// run horizontal position controller correcting position and velocity
     ///     converts position (_pos_target) to target velocity (_vel_target)
     ///     desired velocity (_vel_desired) is combined into final target velocity
@@ -376,6 +393,7 @@ protected:
     // parameters
     AP_Float    _accel_xy_filt_hz;      // XY acceleration filter cutoff frequency
     AP_Float    _lean_angle_max;        // Maximum autopilot commanded angle (in degrees). Set to zero for Angle Max
+    AP_Float    _jerk_xy_cmsss;         // horizontal jerk limit of the trajectory shaping in cm/s/s/s
     AC_P        _p_pos_z;
     AC_P        _p_vel_z;
     AC_PID      _pid_accel_z;
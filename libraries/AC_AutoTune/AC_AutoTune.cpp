@@ -118,6 +118,13 @@ const AP_Param::GroupInfo AC_AutoTune::var_info[] = {
     // @User: Standard
     AP_GROUPINFO("MIN_D", 3, AC_AutoTune, min_d,  0.001f),
 
+    // @Param: PARALLEL
+    // @DisplayName: AutoTune roll and pitch in parallel
+    // @Description: Tune roll and pitch together, twitching both axes at once with orthogonal sequences of directions so their coupling cancels out. This roughly halves the time to tune them. Yaw is still tuned on its own afterwards
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Standard
+    AP_GROUPINFO("PARALLEL", 4, AC_AutoTune, parallel_enable, 0),
+
     AP_GROUPEND
 };
 
@@ -477,9 +484,12 @@ void AC_AutoTune::control_attitude()
 {
     rotation_rate = 0.0f;        // rotation rate in radians/second
     lean_angle = 0.0f;
-    const float direction_sign = positive_direction ? 1.0f : -1.0f;
     const uint32_t now = AP_HAL::millis();
 
+    // roll and pitch may be twitched together, each with its own state
+    const bool parallel = parallel_axes != 0;
+    const uint8_t axes = parallel ? parallel_axes : (1U<<axis);
+
     // check tuning step
     switch (step) {
 
@@ -500,19 +510,13 @@ void AC_AutoTune::control_attitude()
         }
 
         // if we have been level for a sufficient amount of time (0.5 seconds) move onto tuning step
-        if (now - step_start_time_ms > AUTOTUNE_REQUIRED_LEVEL_TIME_MS) {
+        const bool start_twitch = now - step_start_time_ms > AUTOTUNE_REQUIRED_LEVEL_TIME_MS;
+        if (start_twitch) {
             gcs().send_text(MAV_SEVERITY_INFO, "AutoTune: Twitch");
             // initiate variables for next step
             step = TWITCHING;
             step_start_time_ms = now;
-            step_time_limit_ms = AUTOTUNE_TESTING_STEP_TIMEOUT_MS;
             twitch_first_iter = true;
-            test_rate_max = 0.0f;
-            test_rate_min = 0.0f;
-            test_angle_max = 0.0f;
-            test_angle_min = 0.0f;
-            rotation_rate_filt.reset(0.0f);
-            rate_max = 0.0f;
             // set gains to their to-be-tested values
             load_gains(GAIN_TWITCH);
         } else {
@@ -520,40 +524,24 @@ void AC_AutoTune::control_attitude()
             load_gains(GAIN_INTRA_TEST);
         }
 
-        float target_max_rate;
-        switch (axis) {
-        case ROLL:
-            target_max_rate = MAX(AUTOTUNE_TARGET_MIN_RATE_RLLPIT_CDS, step_scaler*AUTOTUNE_TARGET_RATE_RLLPIT_CDS);
-            target_rate = constrain_float(ToDeg(attitude_control->max_rate_step_bf_roll())*100.0f, AUTOTUNE_TARGET_MIN_RATE_RLLPIT_CDS, target_max_rate);
-            target_angle = constrain_float(ToDeg(attitude_control->max_angle_step_bf_roll())*100.0f, AUTOTUNE_TARGET_MIN_ANGLE_RLLPIT_CD, AUTOTUNE_TARGET_ANGLE_RLLPIT_CD);
-            abort_angle = AUTOTUNE_TARGET_ANGLE_RLLPIT_CD;
-            start_rate = ToDeg(ahrs_view->get_gyro().x) * 100.0f;
-            start_angle = ahrs_view->roll_sensor;
-            rotation_rate_filt.set_cutoff_frequency(attitude_control->get_rate_roll_pid().filt_hz()*2.0f);
-            break;
-        case PITCH:
-            target_max_rate = MAX(AUTOTUNE_TARGET_MIN_RATE_RLLPIT_CDS, step_scaler*AUTOTUNE_TARGET_RATE_RLLPIT_CDS);
-            target_rate = constrain_float(ToDeg(attitude_control->max_rate_step_bf_pitch())*100.0f, AUTOTUNE_TARGET_MIN_RATE_RLLPIT_CDS, target_max_rate);
-            target_angle = constrain_float(ToDeg(attitude_control->max_angle_step_bf_pitch())*100.0f, AUTOTUNE_TARGET_MIN_ANGLE_RLLPIT_CD, AUTOTUNE_TARGET_ANGLE_RLLPIT_CD);
-            abort_angle = AUTOTUNE_TARGET_ANGLE_RLLPIT_CD;
-            start_rate = ToDeg(ahrs_view->get_gyro().y) * 100.0f;
-            start_angle = ahrs_view->pitch_sensor;
-            rotation_rate_filt.set_cutoff_frequency(attitude_control->get_rate_pitch_pid().filt_hz()*2.0f);
-            break;
-        case YAW:
-            target_max_rate = MAX(AUTOTUNE_TARGET_MIN_RATE_RLLPIT_CDS, step_scaler*AUTOTUNE_TARGET_RATE_YAW_CDS);
-            target_rate = constrain_float(ToDeg(attitude_control->max_rate_step_bf_yaw()*0.75f)*100.0f, AUTOTUNE_TARGET_MIN_RATE_YAW_CDS, target_max_rate);
-            target_angle = constrain_float(ToDeg(attitude_control->max_angle_step_bf_yaw()*0.75f)*100.0f, AUTOTUNE_TARGET_MIN_ANGLE_YAW_CD, AUTOTUNE_TARGET_ANGLE_YAW_CD);
-            abort_angle = AUTOTUNE_TARGET_ANGLE_YAW_CD;
-            start_rate = ToDeg(ahrs_view->get_gyro().z) * 100.0f;
-            start_angle = ahrs_view->yaw_sensor;
-            rotation_rate_filt.set_cutoff_frequency(AUTOTUNE_Y_FILT_FREQ);
-            break;
-        }
-        if ((tune_type == SP_DOWN) || (tune_type == SP_UP)) {
-            rotation_rate_filt.reset(start_rate);
-        } else {
-            rotation_rate_filt.reset(0);
+        for (uint8_t i=ROLL; i<=YAW; i++) {
+            if (!(axes & (1U<<i))) {
+                continue;
+            }
+            if (parallel) {
+                parallel_load(AxisType(i));
+                // roll and pitch directions follow orthogonal sequences
+                // (+-+- and ++--), so the coupling of one axis into the
+                // other cancels over each four twitches
+                positive_direction = (parallel_twitches & (1U<<i)) == 0;
+            }
+            twitch_setup(start_twitch);
+            if (parallel) {
+                parallel_save();
+                if (start_twitch) {
+                    parallel_state[i].twitch_done = false;
+                }
+            }
         }
         break;
     }
@@ -567,327 +555,495 @@ void AC_AutoTune::control_attitude()
         // hold current attitude
         attitude_control->input_rate_bf_roll_pitch_yaw(0.0f, 0.0f, 0.0f);
 
-        if ((tune_type == SP_DOWN) || (tune_type == SP_UP)) {
-            // step angle targets on first iteration
-            if (twitch_first_iter) {
-                twitch_first_iter = false;
-                // Testing increasing stabilize P gain so will set lean angle target
-                switch (axis) {
-                case ROLL:
-                    // request roll to 20deg
-                    attitude_control->input_angle_step_bf_roll_pitch_yaw(direction_sign * target_angle, 0.0f, 0.0f);
-                    break;
-                case PITCH:
-                    // request pitch to 20deg
-                    attitude_control->input_angle_step_bf_roll_pitch_yaw(0.0f, direction_sign * target_angle, 0.0f);
-                    break;
-                case YAW:
-                    // request pitch to 20deg
-                    attitude_control->input_angle_step_bf_roll_pitch_yaw(0.0f, 0.0f, direction_sign * target_angle);
-                    break;
+        // step angle targets on first iteration
+        if (twitch_first_iter) {
+            twitch_first_iter = false;
+            Vector3f angle_step_cd;
+            for (uint8_t i=ROLL; i<=YAW; i++) {
+                if (!(axes & (1U<<i))) {
+                    continue;
+                }
+                if (parallel) {
+                    parallel_load(AxisType(i));
+                }
+                if ((tune_type == SP_DOWN) || (tune_type == SP_UP)) {
+                    // Testing increasing stabilize P gain so will set lean angle target
+                    angle_step_cd[i] = (positive_direction ? 1.0f : -1.0f) * target_angle;
                 }
             }
-        } else {
-            // Testing rate P and D gains so will set body-frame rate targets.
-            // Rate controller will use existing body-frame rates and convert to motor outputs
-            // for all axes except the one we override here.
-            switch (axis) {
-            case ROLL:
-                // override body-frame roll rate
-                attitude_control->rate_bf_roll_target(direction_sign * target_rate + start_rate);
-                break;
-            case PITCH:
-                // override body-frame pitch rate
-                attitude_control->rate_bf_pitch_target(direction_sign * target_rate + start_rate);
-                break;
-            case YAW:
-                // override body-frame yaw rate
-                attitude_control->rate_bf_yaw_target(direction_sign * target_rate + start_rate);
-                break;
+            if (!angle_step_cd.is_zero()) {
+                attitude_control->input_angle_step_bf_roll_pitch_yaw(angle_step_cd.x, angle_step_cd.y, angle_step_cd.z);
+            }
+        }
+
+        bool twitch_complete = true;
+        for (uint8_t i=ROLL; i<=YAW; i++) {
+            if (!(axes & (1U<<i))) {
+                continue;
+            }
+            if (!parallel) {
+                twitching_axis();
+                continue;
+            }
+            parallel_load(AxisType(i));
+            if (parallel_state[i].twitch_done) {
+                continue;
+            }
+            // an axis which has finished holds its attitude until the
+            // others have finished too
+            twitching_axis();
+            if (step != TWITCHING) {
+                parallel_state[i].twitch_done = true;
+                parallel_state[i].twitch_result = step;
+                step = TWITCHING;
+            } else {
+                twitch_complete = false;
+            }
+            parallel_save();
+        }
+        if (parallel && twitch_complete) {
+            step = UPDATE_GAINS;
+        }
+        break;
+    }
+
+    case UPDATE_GAINS:
+
+        // re-enable rate limits
+        attitude_control->use_sqrt_controller(true);
+
+        for (uint8_t i=ROLL; i<=YAW; i++) {
+            if (!(axes & (1U<<i))) {
+                continue;
+            }
+            if (!parallel) {
+                update_gains_axis(false);
+                continue;
+            }
+            parallel_load(AxisType(i));
+            // an aborted twitch is repeated without updating the gains
+            if (parallel_state[i].twitch_result == UPDATE_GAINS) {
+                update_gains_axis(true);
+            }
+            parallel_save();
+        }
+        if (parallel) {
+            parallel_twitches++;
+            if (parallel_axes == 0) {
+                // roll and pitch are complete
+                next_axis();
             }
         }
 
-        // capture this iterations rotation rate and lean angle
-        float gyro_reading = 0;
+        // reverse direction
+        positive_direction = !positive_direction;
+
+        if (axis == YAW) {
+            attitude_control->input_euler_angle_roll_pitch_yaw(0.0f, 0.0f, ahrs_view->yaw_sensor, false);
+        }
+
+        // set gains to their intra-test values (which are very close to the original gains)
+        load_gains(GAIN_INTRA_TEST);
+
+        // reset testing step
+        step = WAITING_FOR_LEVEL;
+        step_start_time_ms = now;
+        level_start_time_ms = step_start_time_ms;
+        step_time_limit_ms = AUTOTUNE_REQUIRED_LEVEL_TIME_MS;
+        break;
+    }
+}
+
+// twitch_setup - set targets for the next twitch of the current axis,
+//  and reset its measurements when the twitch is starting
+void AC_AutoTune::twitch_setup(bool start_twitch)
+{
+    if (start_twitch) {
+        step_time_limit_ms = AUTOTUNE_TESTING_STEP_TIMEOUT_MS;
+        test_rate_max = 0.0f;
+        test_rate_min = 0.0f;
+        test_angle_max = 0.0f;
+        test_angle_min = 0.0f;
+        rotation_rate_filt.reset(0.0f);
+        rate_max = 0.0f;
+    }
+
+    float target_max_rate;
+    switch (axis) {
+    case ROLL:
+        target_max_rate = MAX(AUTOTUNE_TARGET_MIN_RATE_RLLPIT_CDS, step_scaler*AUTOTUNE_TARGET_RATE_RLLPIT_CDS);
+        target_rate = constrain_float(ToDeg(attitude_control->max_rate_step_bf_roll())*100.0f, AUTOTUNE_TARGET_MIN_RATE_RLLPIT_CDS, target_max_rate);
+        target_angle = constrain_float(ToDeg(attitude_control->max_angle_step_bf_roll())*100.0f, AUTOTUNE_TARGET_MIN_ANGLE_RLLPIT_CD, AUTOTUNE_TARGET_ANGLE_RLLPIT_CD);
+        abort_angle = AUTOTUNE_TARGET_ANGLE_RLLPIT_CD;
+        start_rate = ToDeg(ahrs_view->get_gyro().x) * 100.0f;
+        start_angle = ahrs_view->roll_sensor;
+        rotation_rate_filt.set_cutoff_frequency(attitude_control->get_rate_roll_pid().filt_hz()*2.0f);
+        break;
+    case PITCH:
+        target_max_rate = MAX(AUTOTUNE_TARGET_MIN_RATE_RLLPIT_CDS, step_scaler*AUTOTUNE_TARGET_RATE_RLLPIT_CDS);
+        target_rate = constrain_float(ToDeg(attitude_control->max_rate_step_bf_pitch())*100.0f, AUTOTUNE_TARGET_MIN_RATE_RLLPIT_CDS, target_max_rate);
+        target_angle = constrain_float(ToDeg(attitude_control->max_angle_step_bf_pitch())*100.0f, AUTOTUNE_TARGET_MIN_ANGLE_RLLPIT_CD, AUTOTUNE_TARGET_ANGLE_RLLPIT_CD);
+        abort_angle = AUTOTUNE_TARGET_ANGLE_RLLPIT_CD;
+        start_rate = ToDeg(ahrs_view->get_gyro().y) * 100.0f;
+        start_angle = ahrs_view->pitch_sensor;
+        rotation_rate_filt.set_cutoff_frequency(attitude_control->get_rate_pitch_pid().filt_hz()*2.0f);
+        break;
+    case YAW:
+        target_max_rate = MAX(AUTOTUNE_TARGET_MIN_RATE_RLLPIT_CDS, step_scaler*AUTOTUNE_TARGET_RATE_YAW_CDS);
+        target_rate = constrain_float(ToDeg(attitude_control->max_rate_step_bf_yaw()*0.75f)*100.0f, AUTOTUNE_TARGET_MIN_RATE_YAW_CDS, target_max_rate);
+        target_angle = constrain_float(ToDeg(attitude_control->max_angle_step_bf_yaw()*0.75f)*100.0f, AUTOTUNE_TARGET_MIN_ANGLE_YAW_CD, AUTOTUNE_TARGET_ANGLE_YAW_CD);
+        abort_angle = AUTOTUNE_TARGET_ANGLE_YAW_CD;
+        start_rate = ToDeg(ahrs_view->get_gyro().z) * 100.0f;
+        start_angle = ahrs_view->yaw_sensor;
+        rotation_rate_filt.set_cutoff_frequency(AUTOTUNE_Y_FILT_FREQ);
+        break;
+    }
+    if ((tune_type == SP_DOWN) || (tune_type == SP_UP)) {
+        rotation_rate_filt.reset(start_rate);
+    } else {
+        rotation_rate_filt.reset(0);
+    }
+}
+
+// twitching_axis - run the twitch of the current axis, setting step to
+//  UPDATE_GAINS or WAITING_FOR_LEVEL when it is finished
+void AC_AutoTune::twitching_axis()
+{
+    const float direction_sign = positive_direction ? 1.0f : -1.0f;
+
+    if ((tune_type != SP_DOWN) && (tune_type != SP_UP)) {
+        // Testing rate P and D gains so will set body-frame rate targets.
+        // Rate controller will use existing body-frame rates and convert to motor outputs
+        // for all axes except the one we override here.
         switch (axis) {
         case ROLL:
-            gyro_reading = ahrs_view->get_gyro().x;
-            lean_angle = direction_sign * (ahrs_view->roll_sensor - (int32_t)start_angle);
+            // override body-frame roll rate
+            attitude_control->rate_bf_roll_target(direction_sign * target_rate + start_rate);
             break;
         case PITCH:
-            gyro_reading = ahrs_view->get_gyro().y;
-            lean_angle = direction_sign * (ahrs_view->pitch_sensor - (int32_t)start_angle);
+            // override body-frame pitch rate
+            attitude_control->rate_bf_pitch_target(direction_sign * target_rate + start_rate);
             break;
         case YAW:
-            gyro_reading = ahrs_view->get_gyro().z;
-            lean_angle = direction_sign * wrap_180_cd(ahrs_view->yaw_sensor-(int32_t)start_angle);
+            // override body-frame yaw rate
+            attitude_control->rate_bf_yaw_target(direction_sign * target_rate + start_rate);
             break;
         }
+    }
 
-        // Add filter to measurements
-        float filter_value;
-        switch (tune_type) {
-        case SP_DOWN:
-        case SP_UP:
-            filter_value = direction_sign * (ToDeg(gyro_reading) * 100.0f);
+    // capture this iterations rotation rate and lean angle
+    float gyro_reading = 0;
+    switch (axis) {
+    case ROLL:
+        gyro_reading = ahrs_view->get_gyro().x;
+        lean_angle = direction_sign * (ahrs_view->roll_sensor - (int32_t)start_angle);
+        break;
+    case PITCH:
+        gyro_reading = ahrs_view->get_gyro().y;
+        lean_angle = direction_sign * (ahrs_view->pitch_sensor - (int32_t)start_angle);
+        break;
+    case YAW:
+        gyro_reading = ahrs_view->get_gyro().z;
+        lean_angle = direction_sign * wrap_180_cd(ahrs_view->yaw_sensor-(int32_t)start_angle);
+        break;
+    }
+
+    // Add filter to measurements
+    float filter_value;
+    switch (tune_type) {
+    case SP_DOWN:
+    case SP_UP:
+        filter_value = direction_sign * (ToDeg(gyro_reading) * 100.0f);
+        break;
+    default:
+        filter_value = direction_sign * (ToDeg(gyro_reading) * 100.0f - start_rate);
+        break;
+    }
+    rotation_rate = rotation_rate_filt.apply(filter_value,
+                    AP::scheduler().get_loop_period_s());
+
+    switch (tune_type) {
+    case RD_UP:
+    case RD_DOWN:
+        twitching_test_rate(rotation_rate, target_rate, test_rate_min, test_rate_max);
+        twitching_measure_acceleration(test_accel_max, rotation_rate, rate_max);
+        twitching_abort_rate(lean_angle, rotation_rate, abort_angle, test_rate_min);
+        if (lean_angle >= target_angle) {
+            step = UPDATE_GAINS;
+        }
+        break;
+    case RP_UP:
+        twitching_test_rate(rotation_rate, target_rate*(1+0.5f*aggressiveness), test_rate_min, test_rate_max);
+        twitching_measure_acceleration(test_accel_max, rotation_rate, rate_max);
+        twitching_abort_rate(lean_angle, rotation_rate, abort_angle, test_rate_min);
+        break;
+    case SP_DOWN:
+    case SP_UP:
+        twitching_test_angle(lean_angle, rotation_rate, target_angle*(1+0.5f*aggressiveness), test_angle_min, test_angle_max, test_rate_min, test_rate_max);
+        twitching_measure_acceleration(test_accel_max, rotation_rate - direction_sign * start_rate, rate_max);
+        break;
+    }
+
+    // log this iterations lean angle and rotation rate
+    Log_Write_AutoTuneDetails(lean_angle, rotation_rate);
+    AP::logger().Write_Rate(ahrs_view, *motors, *attitude_control, *pos_control);
+    log_pids();
+}
+
+// update_gains_axis - update the gains of the current axis from the
+//  results of its twitch
+void AC_AutoTune::update_gains_axis(bool parallel)
+{
+    // log the latest gains
+    if ((tune_type == SP_DOWN) || (tune_type == SP_UP)) {
+        switch (axis) {
+        case ROLL:
+            Log_Write_AutoTune(axis, tune_type, target_angle, test_angle_min, test_angle_max, tune_roll_rp, tune_roll_rd, tune_roll_sp, test_accel_max);
+            break;
+        case PITCH:
+            Log_Write_AutoTune(axis, tune_type, target_angle, test_angle_min, test_angle_max, tune_pitch_rp, tune_pitch_rd, tune_pitch_sp, test_accel_max);
             break;
-        default:
-            filter_value = direction_sign * (ToDeg(gyro_reading) * 100.0f - start_rate);
+        case YAW:
+            Log_Write_AutoTune(axis, tune_type, target_angle, test_angle_min, test_angle_max, tune_yaw_rp, tune_yaw_rLPF, tune_yaw_sp, test_accel_max);
             break;
         }
-        rotation_rate = rotation_rate_filt.apply(filter_value,
-                        AP::scheduler().get_loop_period_s());
-
-        switch (tune_type) {
-        case RD_UP:
-        case RD_DOWN:
-            twitching_test_rate(rotation_rate, target_rate, test_rate_min, test_rate_max);
-            twitching_measure_acceleration(test_accel_max, rotation_rate, rate_max);
-            twitching_abort_rate(lean_angle, rotation_rate, abort_angle, test_rate_min);
-            if (lean_angle >= target_angle) {
-                step = UPDATE_GAINS;
-            }
+    } else {
+        switch (axis) {
+        case ROLL:
+            Log_Write_AutoTune(axis, tune_type, target_rate, test_rate_min, test_rate_max, tune_roll_rp, tune_roll_rd, tune_roll_sp, test_accel_max);
             break;
-        case RP_UP:
-            twitching_test_rate(rotation_rate, target_rate*(1+0.5f*aggressiveness), test_rate_min, test_rate_max);
-            twitching_measure_acceleration(test_accel_max, rotation_rate, rate_max);
-            twitching_abort_rate(lean_angle, rotation_rate, abort_angle, test_rate_min);
+        case PITCH:
+            Log_Write_AutoTune(axis, tune_type, target_rate, test_rate_min, test_rate_max, tune_pitch_rp, tune_pitch_rd, tune_pitch_sp, test_accel_max);
             break;
-        case SP_DOWN:
-        case SP_UP:
-            twitching_test_angle(lean_angle, rotation_rate, target_angle*(1+0.5f*aggressiveness), test_angle_min, test_angle_max, test_rate_min, test_rate_max);
-            twitching_measure_acceleration(test_accel_max, rotation_rate - direction_sign * start_rate, rate_max);
+        case YAW:
+            Log_Write_AutoTune(axis, tune_type, target_rate, test_rate_min, test_rate_max, tune_yaw_rp, tune_yaw_rLPF, tune_yaw_sp, test_accel_max);
             break;
         }
+    }
 
-        // log this iterations lean angle and rotation rate
-        Log_Write_AutoTuneDetails(lean_angle, rotation_rate);
-        AP::logger().Write_Rate(ahrs_view, *motors, *attitude_control, *pos_control);
-        log_pids();
+    // Check results after mini-step to increase rate D gain
+    switch (tune_type) {
+    case RD_UP:
+        switch (axis) {
+        case ROLL:
+            updating_rate_d_up(tune_roll_rd, min_d, AUTOTUNE_RD_MAX, AUTOTUNE_RD_STEP, tune_roll_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+            break;
+        case PITCH:
+            updating_rate_d_up(tune_pitch_rd, min_d, AUTOTUNE_RD_MAX, AUTOTUNE_RD_STEP, tune_pitch_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+            break;
+        case YAW:
+            updating_rate_d_up(tune_yaw_rLPF, AUTOTUNE_RLPF_MIN, AUTOTUNE_RLPF_MAX, AUTOTUNE_RD_STEP, tune_yaw_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+            break;
+        }
+        break;
+    // Check results after mini-step to decrease rate D gain
+    case RD_DOWN:
+        switch (axis) {
+        case ROLL:
+            updating_rate_d_down(tune_roll_rd, min_d, AUTOTUNE_RD_STEP, tune_roll_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+            break;
+        case PITCH:
+            updating_rate_d_down(tune_pitch_rd, min_d, AUTOTUNE_RD_STEP, tune_pitch_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+            break;
+        case YAW:
+            updating_rate_d_down(tune_yaw_rLPF, AUTOTUNE_RLPF_MIN, AUTOTUNE_RD_STEP, tune_yaw_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+            break;
+        }
+        break;
+    // Check results after mini-step to increase rate P gain
+    case RP_UP:
+        switch (axis) {
+        case ROLL:
+            updating_rate_p_up_d_down(tune_roll_rd, min_d, AUTOTUNE_RD_STEP, tune_roll_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+            break;
+        case PITCH:
+            updating_rate_p_up_d_down(tune_pitch_rd, min_d, AUTOTUNE_RD_STEP, tune_pitch_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+            break;
+        case YAW:
+            updating_rate_p_up_d_down(tune_yaw_rLPF, AUTOTUNE_RLPF_MIN, AUTOTUNE_RD_STEP, tune_yaw_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+            break;
+        }
+        break;
+    // Check results after mini-step to increase stabilize P gain
+    case SP_DOWN:
+        switch (axis) {
+        case ROLL:
+            updating_angle_p_down(tune_roll_sp, AUTOTUNE_SP_MIN, AUTOTUNE_SP_STEP, target_angle, test_angle_max, test_rate_min, test_rate_max);
+            break;
+        case PITCH:
+            updating_angle_p_down(tune_pitch_sp, AUTOTUNE_SP_MIN, AUTOTUNE_SP_STEP, target_angle, test_angle_max, test_rate_min, test_rate_max);
+            break;
+        case YAW:
+            updating_angle_p_down(tune_yaw_sp, AUTOTUNE_SP_MIN, AUTOTUNE_SP_STEP, target_angle, test_angle_max, test_rate_min, test_rate_max);
+            break;
+        }
+        break;
+    // Check results after mini-step to increase stabilize P gain
+    case SP_UP:
+        switch (axis) {
+        case ROLL:
+            updating_angle_p_up(tune_roll_sp, AUTOTUNE_SP_MAX, AUTOTUNE_SP_STEP, target_angle, test_angle_max, test_rate_min, test_rate_max);
+            break;
+        case PITCH:
+            updating_angle_p_up(tune_pitch_sp, AUTOTUNE_SP_MAX, AUTOTUNE_SP_STEP, target_angle, test_angle_max, test_rate_min, test_rate_max);
+            break;
+        case YAW:
+            updating_angle_p_up(tune_yaw_sp, AUTOTUNE_SP_MAX, AUTOTUNE_SP_STEP, target_angle, test_angle_max, test_rate_min, test_rate_max);
+            break;
+        }
         break;
     }
 
-    case UPDATE_GAINS:
+    // we've complete this step, finalize pids and move to next step
+    if (counter >= AUTOTUNE_SUCCESS_COUNT) {
 
-        // re-enable rate limits
-        attitude_control->use_sqrt_controller(true);
+        // reset counter
+        counter = 0;
 
-        // log the latest gains
-        if ((tune_type == SP_DOWN) || (tune_type == SP_UP)) {
-            switch (axis) {
-            case ROLL:
-                Log_Write_AutoTune(axis, tune_type, target_angle, test_angle_min, test_angle_max, tune_roll_rp, tune_roll_rd, tune_roll_sp, test_accel_max);
-                break;
-            case PITCH:
-                Log_Write_AutoTune(axis, tune_type, target_angle, test_angle_min, test_angle_max, tune_pitch_rp, tune_pitch_rd, tune_pitch_sp, test_accel_max);
-                break;
-            case YAW:
-                Log_Write_AutoTune(axis, tune_type, target_angle, test_angle_min, test_angle_max, tune_yaw_rp, tune_yaw_rLPF, tune_yaw_sp, test_accel_max);
-                break;
-            }
-        } else {
-            switch (axis) {
-            case ROLL:
-                Log_Write_AutoTune(axis, tune_type, target_rate, test_rate_min, test_rate_max, tune_roll_rp, tune_roll_rd, tune_roll_sp, test_accel_max);
-                break;
-            case PITCH:
-                Log_Write_AutoTune(axis, tune_type, target_rate, test_rate_min, test_rate_max, tune_pitch_rp, tune_pitch_rd, tune_pitch_sp, test_accel_max);
-                break;
-            case YAW:
-                Log_Write_AutoTune(axis, tune_type, target_rate, test_rate_min, test_rate_max, tune_yaw_rp, tune_yaw_rLPF, tune_yaw_sp, test_accel_max);
-                break;
-            }
-        }
+        // reset scaling factor
+        step_scaler = 1;
 
-        // Check results after mini-step to increase rate D gain
+        // move to the next tuning type
         switch (tune_type) {
         case RD_UP:
-            switch (axis) {
-            case ROLL:
-                updating_rate_d_up(tune_roll_rd, min_d, AUTOTUNE_RD_MAX, AUTOTUNE_RD_STEP, tune_roll_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
-                break;
-            case PITCH:
-                updating_rate_d_up(tune_pitch_rd, min_d, AUTOTUNE_RD_MAX, AUTOTUNE_RD_STEP, tune_pitch_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
-                break;
-            case YAW:
-                updating_rate_d_up(tune_yaw_rLPF, AUTOTUNE_RLPF_MIN, AUTOTUNE_RLPF_MAX, AUTOTUNE_RD_STEP, tune_yaw_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
-                break;
-            }
+            tune_type = TuneType(tune_type + 1);
             break;
-        // Check results after mini-step to decrease rate D gain
         case RD_DOWN:
+            tune_type = TuneType(tune_type + 1);
             switch (axis) {
             case ROLL:
-                updating_rate_d_down(tune_roll_rd, min_d, AUTOTUNE_RD_STEP, tune_roll_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+                tune_roll_rd = MAX(min_d, tune_roll_rd * AUTOTUNE_RD_BACKOFF);
+                tune_roll_rp = MAX(AUTOTUNE_RP_MIN, tune_roll_rp * AUTOTUNE_RD_BACKOFF);
                 break;
             case PITCH:
-                updating_rate_d_down(tune_pitch_rd, min_d, AUTOTUNE_RD_STEP, tune_pitch_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+                tune_pitch_rd = MAX(min_d, tune_pitch_rd * AUTOTUNE_RD_BACKOFF);
+                tune_pitch_rp = MAX(AUTOTUNE_RP_MIN, tune_pitch_rp * AUTOTUNE_RD_BACKOFF);
                 break;
             case YAW:
-                updating_rate_d_down(tune_yaw_rLPF, AUTOTUNE_RLPF_MIN, AUTOTUNE_RD_STEP, tune_yaw_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+                tune_yaw_rLPF = MAX(AUTOTUNE_RLPF_MIN, tune_yaw_rLPF * AUTOTUNE_RD_BACKOFF);
+                tune_yaw_rp = MAX(AUTOTUNE_RP_MIN, tune_yaw_rp * AUTOTUNE_RD_BACKOFF);
                 break;
             }
             break;
-        // Check results after mini-step to increase rate P gain
         case RP_UP:
+            tune_type = TuneType(tune_type + 1);
             switch (axis) {
             case ROLL:
-                updating_rate_p_up_d_down(tune_roll_rd, min_d, AUTOTUNE_RD_STEP, tune_roll_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+                tune_roll_rp = MAX(AUTOTUNE_RP_MIN, tune_roll_rp * AUTOTUNE_RP_BACKOFF);
                 break;
             case PITCH:
-                updating_rate_p_up_d_down(tune_pitch_rd, min_d, AUTOTUNE_RD_STEP, tune_pitch_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+                tune_pitch_rp = MAX(AUTOTUNE_RP_MIN, tune_pitch_rp * AUTOTUNE_RP_BACKOFF);
                 break;
             case YAW:
-                updating_rate_p_up_d_down(tune_yaw_rLPF, AUTOTUNE_RLPF_MIN, AUTOTUNE_RD_STEP, tune_yaw_rp, AUTOTUNE_RP_MIN, AUTOTUNE_RP_MAX, AUTOTUNE_RP_STEP, target_rate, test_rate_min, test_rate_max);
+                tune_yaw_rp = MAX(AUTOTUNE_RP_MIN, tune_yaw_rp * AUTOTUNE_RP_BACKOFF);
                 break;
             }
             break;
-        // Check results after mini-step to increase stabilize P gain
         case SP_DOWN:
-            switch (axis) {
-            case ROLL:
-                updating_angle_p_down(tune_roll_sp, AUTOTUNE_SP_MIN, AUTOTUNE_SP_STEP, target_angle, test_angle_max, test_rate_min, test_rate_max);
-                break;
-            case PITCH:
-                updating_angle_p_down(tune_pitch_sp, AUTOTUNE_SP_MIN, AUTOTUNE_SP_STEP, target_angle, test_angle_max, test_rate_min, test_rate_max);
-                break;
-            case YAW:
-                updating_angle_p_down(tune_yaw_sp, AUTOTUNE_SP_MIN, AUTOTUNE_SP_STEP, target_angle, test_angle_max, test_rate_min, test_rate_max);
-                break;
-            }
+            tune_type = TuneType(tune_type + 1);
             break;
-        // Check results after mini-step to increase stabilize P gain
         case SP_UP:
+            // we've reached the end of a D-up-down PI-up-down tune type cycle
+            tune_type = RD_UP;
+
+            // advance to the next axis
             switch (axis) {
             case ROLL:
-                updating_angle_p_up(tune_roll_sp, AUTOTUNE_SP_MAX, AUTOTUNE_SP_STEP, target_angle, test_angle_max, test_rate_min, test_rate_max);
+                axes_completed |= AUTOTUNE_AXIS_BITMASK_ROLL;
+                tune_roll_sp = MAX(AUTOTUNE_SP_MIN, tune_roll_sp * AUTOTUNE_SP_BACKOFF);
+                tune_roll_accel = MAX(AUTOTUNE_RP_ACCEL_MIN, test_accel_max * AUTOTUNE_ACCEL_RP_BACKOFF);
                 break;
             case PITCH:
-                updating_angle_p_up(tune_pitch_sp, AUTOTUNE_SP_MAX, AUTOTUNE_SP_STEP, target_angle, test_angle_max, test_rate_min, test_rate_max);
+                axes_completed |= AUTOTUNE_AXIS_BITMASK_PITCH;
+                tune_pitch_sp = MAX(AUTOTUNE_SP_MIN, tune_pitch_sp * AUTOTUNE_SP_BACKOFF);
+                tune_pitch_accel = MAX(AUTOTUNE_RP_ACCEL_MIN, test_accel_max * AUTOTUNE_ACCEL_RP_BACKOFF);
                 break;
             case YAW:
-                updating_angle_p_up(tune_yaw_sp, AUTOTUNE_SP_MAX, AUTOTUNE_SP_STEP, target_angle, test_angle_max, test_rate_min, test_rate_max);
+                axes_completed |= AUTOTUNE_AXIS_BITMASK_YAW;
+                tune_yaw_sp = MAX(AUTOTUNE_SP_MIN, tune_yaw_sp * AUTOTUNE_SP_BACKOFF);
+                tune_yaw_accel = MAX(AUTOTUNE_Y_ACCEL_MIN, test_accel_max * AUTOTUNE_ACCEL_Y_BACKOFF);
                 break;
             }
-            break;
-        }
-
-        // we've complete this step, finalize pids and move to next step
-        if (counter >= AUTOTUNE_SUCCESS_COUNT) {
-
-            // reset counter
-            counter = 0;
 
-            // reset scaling factor
-            step_scaler = 1;
-
-            // move to the next tuning type
-            switch (tune_type) {
-            case RD_UP:
-                tune_type = TuneType(tune_type + 1);
-                break;
-            case RD_DOWN:
-                tune_type = TuneType(tune_type + 1);
-                switch (axis) {
-                case ROLL:
-                    tune_roll_rd = MAX(min_d, tune_roll_rd * AUTOTUNE_RD_BACKOFF);
-                    tune_roll_rp = MAX(AUTOTUNE_RP_MIN, tune_roll_rp * AUTOTUNE_RD_BACKOFF);
-                    break;
-                case PITCH:
-                    tune_pitch_rd = MAX(min_d, tune_pitch_rd * AUTOTUNE_RD_BACKOFF);
-                    tune_pitch_rp = MAX(AUTOTUNE_RP_MIN, tune_pitch_rp * AUTOTUNE_RD_BACKOFF);
-                    break;
-                case YAW:
-                    tune_yaw_rLPF = MAX(AUTOTUNE_RLPF_MIN, tune_yaw_rLPF * AUTOTUNE_RD_BACKOFF);
-                    tune_yaw_rp = MAX(AUTOTUNE_RP_MIN, tune_yaw_rp * AUTOTUNE_RD_BACKOFF);
-                    break;
-                }
-                break;
-            case RP_UP:
-                tune_type = TuneType(tune_type + 1);
-                switch (axis) {
-                case ROLL:
-                    tune_roll_rp = MAX(AUTOTUNE_RP_MIN, tune_roll_rp * AUTOTUNE_RP_BACKOFF);
-                    break;
-                case PITCH:
-                    tune_pitch_rp = MAX(AUTOTUNE_RP_MIN, tune_pitch_rp * AUTOTUNE_RP_BACKOFF);
-                    break;
-                case YAW:
-                    tune_yaw_rp = MAX(AUTOTUNE_RP_MIN, tune_yaw_rp * AUTOTUNE_RP_BACKOFF);
-                    break;
-                }
-                break;
-            case SP_DOWN:
-                tune_type = TuneType(tune_type + 1);
-                break;
-            case SP_UP:
-                // we've reached the end of a D-up-down PI-up-down tune type cycle
-                tune_type = RD_UP;
-
-                // advance to the next axis
-                bool complete = false;
-                switch (axis) {
-                case ROLL:
-                    axes_completed |= AUTOTUNE_AXIS_BITMASK_ROLL;
-                    tune_roll_sp = MAX(AUTOTUNE_SP_MIN, tune_roll_sp * AUTOTUNE_SP_BACKOFF);
-                    tune_roll_accel = MAX(AUTOTUNE_RP_ACCEL_MIN, test_accel_max * AUTOTUNE_ACCEL_RP_BACKOFF);
-                    if (pitch_enabled()) {
-                        axis = PITCH;
-                    } else if (yaw_enabled()) {
-                        axis = YAW;
-                    } else {
-                        complete = true;
-                    }
-                    break;
-                case PITCH:
-                    axes_completed |= AUTOTUNE_AXIS_BITMASK_PITCH;
-                    tune_pitch_sp = MAX(AUTOTUNE_SP_MIN, tune_pitch_sp * AUTOTUNE_SP_BACKOFF);
-                    tune_pitch_accel = MAX(AUTOTUNE_RP_ACCEL_MIN, test_accel_max * AUTOTUNE_ACCEL_RP_BACKOFF);
-                    if (yaw_enabled()) {
-                        axis = YAW;
-                    } else {
-                        complete = true;
-                    }
-                    break;
-                case YAW:
-                    axes_completed |= AUTOTUNE_AXIS_BITMASK_YAW;
-                    tune_yaw_sp = MAX(AUTOTUNE_SP_MIN, tune_yaw_sp * AUTOTUNE_SP_BACKOFF);
-                    tune_yaw_accel = MAX(AUTOTUNE_Y_ACCEL_MIN, test_accel_max * AUTOTUNE_ACCEL_Y_BACKOFF);
-                    complete = true;
-                    break;
-                }
-
-                // if we've just completed all axes we have successfully completed the autotune
-                // change to TESTING mode to allow user to fly with new gains
-                if (complete) {
-                    mode = SUCCESS;
-                    update_gcs(AUTOTUNE_MESSAGE_SUCCESS);
-                    Log_Write_Event(EVENT_AUTOTUNE_SUCCESS);
-                    AP_Notify::events.autotune_complete = true;
-                } else {
-                    AP_Notify::events.autotune_next_axis = true;
-                }
-                break;
+            // axes tuned in parallel move on together once the last is complete
+            parallel_axes &= ~(1U<<axis);
+            if (!parallel) {
+                next_axis();
             }
+            break;
         }
+    }
+}
 
-        // reverse direction
-        positive_direction = !positive_direction;
-
-        if (axis == YAW) {
-            attitude_control->input_euler_angle_roll_pitch_yaw(0.0f, 0.0f, ahrs_view->yaw_sensor, false);
-        }
+// next_axis - move on to the next axis to tune once one is complete,
+//  or finish the tune once all are
+void AC_AutoTune::next_axis()
+{
+    if (roll_enabled() && !(axes_completed & AUTOTUNE_AXIS_BITMASK_ROLL)) {
+        axis = ROLL;
+    } else if (pitch_enabled() && !(axes_completed & AUTOTUNE_AXIS_BITMASK_PITCH)) {
+        axis = PITCH;
+    } else if (yaw_enabled() && !(axes_completed & AUTOTUNE_AXIS_BITMASK_YAW)) {
+        axis = YAW;
+    } else {
+        // if we've just completed all axes we have successfully completed the autotune
+        // change to TESTING mode to allow user to fly with new gains
+        mode = SUCCESS;
+        update_gcs(AUTOTUNE_MESSAGE_SUCCESS);
+        Log_Write_Event(EVENT_AUTOTUNE_SUCCESS);
+        AP_Notify::events.autotune_complete = true;
+        return;
+    }
+    AP_Notify::events.autotune_next_axis = true;
+}
 
-        // set gains to their intra-test values (which are very close to the original gains)
-        load_gains(GAIN_INTRA_TEST);
+// parallel_load - make axis the current axis, from its saved state
+void AC_AutoTune::parallel_load(AxisType _axis)
+{
+    const struct parallel_axis_state &state = parallel_state[_axis];
+    axis = _axis;
+    tune_type = state.tune_type;
+    positive_direction = state.positive_direction;
+    ignore_next = state.ignore_next;
+    counter = state.counter;
+    step_time_limit_ms = state.step_time_limit_ms;
+    test_rate_min = state.test_rate_min;
+    test_rate_max = state.test_rate_max;
+    test_angle_min = state.test_angle_min;
+    test_angle_max = state.test_angle_max;
+    target_rate = state.target_rate;
+    start_rate = state.start_rate;
+    target_angle = state.target_angle;
+    start_angle = state.start_angle;
+    rate_max = state.rate_max;
+    test_accel_max = state.test_accel_max;
+    step_scaler = state.step_scaler;
+    abort_angle = state.abort_angle;
+    rotation_rate_filt = state.rotation_rate_filt;
+}
 
-        // reset testing step
-        step = WAITING_FOR_LEVEL;
-        step_start_time_ms = now;
-        level_start_time_ms = step_start_time_ms;
-        step_time_limit_ms = AUTOTUNE_REQUIRED_LEVEL_TIME_MS;
-        break;
-    }
+// parallel_save - save the state of the current axis
+void AC_AutoTune::parallel_save()
+{
+    struct parallel_axis_state &state = parallel_state[axis];
+    state.tune_type = tune_type;
+    state.positive_direction = positive_direction;
+    state.ignore_next = ignore_next;
+    state.counter = counter;
+    state.step_time_limit_ms = step_time_limit_ms;
+    state.test_rate_min = test_rate_min;
+    state.test_rate_max = test_rate_max;
+    state.test_angle_min = test_angle_min;
+    state.test_angle_max = test_angle_max;
+    state.target_rate = target_rate;
+    state.start_rate = start_rate;
+    state.target_angle = target_angle;
+    state.start_angle = start_angle;
+    state.rate_max = rate_max;
+    state.test_accel_max = test_accel_max;
+    state.step_scaler = step_scaler;
+    state.abort_angle = abort_angle;
+    state.rotation_rate_filt = rotation_rate_filt;
 }
 
 // backup_gains_and_initialise - store current gains as originals
@@ -905,6 +1061,13 @@ void AC_AutoTune::backup_gains_and_initialise()
     // no axes are complete
     axes_completed = 0;
 
+    // roll and pitch start together, from the same state
+    parallel_axes = 0;
+    parallel_twitches = 0;
+    if (parallel_enable && roll_enabled() && pitch_enabled()) {
+        parallel_axes = AUTOTUNE_AXIS_BITMASK_ROLL | AUTOTUNE_AXIS_BITMASK_PITCH;
+    }
+
     current_gain_type = GAIN_ORIGINAL;
     positive_direction = false;
     step = WAITING_FOR_LEVEL;
@@ -912,6 +1075,14 @@ void AC_AutoTune::backup_gains_and_initialise()
     level_start_time_ms = step_start_time_ms;
     tune_type = RD_UP;
     step_scaler = 1;
+    counter = 0;
+    ignore_next = false;
+    if (parallel_axes != 0) {
+        axis = PITCH;
+        parallel_save();
+        axis = ROLL;
+        parallel_save();
+    }
 
     desired_yaw_cd = ahrs_view->yaw_sensor;
 
@@ -1067,33 +1238,32 @@ void AC_AutoTune::load_intra_test_gains()
     }
 }
 
-// load_twitch_gains - load the to-be-tested gains for a single axis
+// load_twitch_gains - load the to-be-tested gains for the axes being twitched
 // called by control_attitude() just before it beings testing a gain (i.e. just before it twitches)
 void AC_AutoTune::load_twitch_gains()
 {
-    switch (axis) {
-    case ROLL:
+    const uint8_t axes = parallel_axes != 0 ? parallel_axes : (1U<<axis);
+    if (axes & AUTOTUNE_AXIS_BITMASK_ROLL) {
         attitude_control->get_rate_roll_pid().kP(tune_roll_rp);
         attitude_control->get_rate_roll_pid().kI(tune_roll_rp*0.01f);
         attitude_control->get_rate_roll_pid().kD(tune_roll_rd);
         attitude_control->get_rate_roll_pid().ff(0.0f);
         attitude_control->get_angle_roll_p().kP(tune_roll_sp);
-        break;
-    case PITCH:
+    }
+    if (axes & AUTOTUNE_AXIS_BITMASK_PITCH) {
         attitude_control->get_rate_pitch_pid().kP(tune_pitch_rp);
         attitude_control->get_rate_pitch_pid().kI(tune_pitch_rp*0.01f);
         attitude_control->get_rate_pitch_pid().kD(tune_pitch_rd);
         attitude_control->get_rate_pitch_pid().ff(0.0f);
         attitude_control->get_angle_pitch_p().kP(tune_pitch_sp);
-        break;
-    case YAW:
+    }
+    if (axes & AUTOTUNE_AXIS_BITMASK_YAW) {
         attitude_control->get_rate_yaw_pid().kP(tune_yaw_rp);
         attitude_control->get_rate_yaw_pid().kI(tune_yaw_rp*0.01f);
         attitude_control->get_rate_yaw_pid().kD(0.0f);
         attitude_control->get_rate_yaw_pid().ff(0.0f);
         attitude_control->get_rate_yaw_pid().filt_hz(tune_yaw_rLPF);
         attitude_control->get_angle_yaw_p().kP(tune_yaw_sp);
-        break;
     }
 }
 
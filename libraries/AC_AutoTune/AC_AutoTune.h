@@ -85,6 +85,10 @@ protected:
 
 private:
     void control_attitude();
+    void twitch_setup(bool start_twitch);
+    void twitching_axis();
+    void update_gains_axis(bool parallel);
+    void next_axis();
     void backup_gains_and_initialise();
     void load_orig_gains();
     void load_tuned_gains();
@@ -167,6 +171,34 @@ private:
     enum GainType current_gain_type;
     void load_gains(enum GainType gain_type);
 
+    /*
+      state of the tune of an axis while roll and pitch are tuned in
+      parallel. The state of each is loaded into the members below
+      while it is being tested or updated, so that the single axis
+      code runs unchanged on it
+     */
+    struct parallel_axis_state {
+        TuneType tune_type;
+        bool     positive_direction;
+        bool     ignore_next;
+        bool     twitch_done;           // this axis has finished its twitch
+        StepType twitch_result;         // UPDATE_GAINS, or WAITING_FOR_LEVEL if the twitch was aborted
+        int8_t   counter;
+        uint32_t step_time_limit_ms;
+        float    test_rate_min, test_rate_max;
+        float    test_angle_min, test_angle_max;
+        float    target_rate, start_rate;
+        float    target_angle, start_angle;
+        float    rate_max, test_accel_max;
+        float    step_scaler;
+        float    abort_angle;
+        LowPassFilterFloat rotation_rate_filt;
+    } parallel_state[2];                        // indexed by ROLL and PITCH
+    uint8_t  parallel_axes;                     // bitmask of axes being tuned in parallel
+    uint8_t  parallel_twitches;                 // number of parallel twitches, giving the direction of each axis
+    void parallel_load(AxisType _axis);
+    void parallel_save();
+
     TuneMode mode                : 2;    // see TuneMode for what modes are allowed
     bool     pilot_override      : 1;    // true = pilot is overriding controls so we suspend tuning temporarily
     AxisType axis                : 2;    // see AxisType for which things can be tuned
@@ -226,6 +258,7 @@ private:
     AP_Int8  axis_bitmask;
     AP_Float aggressiveness;
     AP_Float min_d;
+    AP_Int8  parallel_enable;
 
     // copies of object pointers to make code a bit clearer
     AC_AttitudeControl_Multi *attitude_control;
@@ -340,13 +340,44 @@ void AC_Avoid::adjust_velocity_polygon_fence(float kP, float accel_cmss, Vector2
         return;
     }
 
-    // get polygon boundary
-    // Note: first point in list is the return-point (which copter does not use)
-    uint16_t num_points;
-    const Vector2f* boundary = _fence.get_polygon_points(num_points);
+    // get polygon zones
+    const AC_PolyFence_zones *zones = _fence.get_polygon_zones();
+    if (zones == nullptr) {
+        return;
+    }
 
-    // adjust velocity using polygon
-    adjust_velocity_polygon(kP, accel_cmss, desired_vel_cms, boundary, num_points, true, _fence.get_margin(), dt);
+    // do not adjust velocity if vehicle is outside the zones
+    Vector2f position_xy;
+    if (!_ahrs.get_relative_position_NE_origin(position_xy)) {
+        // we have no idea where we are
+        return;
+    }
+    position_xy = position_xy * 100.0f;  // m to cm
+    if (zones->breached(position_xy)) {
+        return;
+    }
+
+    // calc margin in cm
+    const float margin_cm = MAX(_fence.get_margin() * 100.0f, 0.0f);
+
+    // for stopping
+    Vector2f safe_vel(desired_vel_cms);
+    const float speed = safe_vel.length();
+    const float stopping_dist_cm = 2.0f + margin_cm + get_stopping_distance(kP, accel_cmss, speed);
+    const Vector2f stopping_point_plus_margin = position_xy + safe_vel*(stopping_dist_cm/speed);
+
+    // only the edges within stopping distance can limit the velocity
+    uint8_t edges[255];
+    const uint16_t num_edges = zones->get_edges_near(position_xy, stopping_dist_cm, edges, ARRAY_SIZE(edges));
+    for (uint16_t i = 0; i < num_edges; i++) {
+        Vector2f start, end;
+        zones->get_edge(edges[i], start, end);
+        if (!adjust_velocity_edge(kP, accel_cmss, safe_vel, position_xy, stopping_point_plus_margin, start, end, margin_cm, dt)) {
+            return;
+        }
+    }
+
+    desired_vel_cms = safe_vel;
 }
 
 /*
@@ -390,12 +421,69 @@ void AC_Avoid::adjust_velocity_proximity(float kP, float accel_cmss, Vector2f &d
         return;
     }
 
+    // use the obstacles around the vehicle if it knows its position,
+    // limiting the velocity towards the nearest obstacle in each heading
+    const AP_Proximity_ObstacleMap *obstacle_map = _proximity.get_obstacle_map();
+    if (obstacle_map != nullptr) {
+        const float margin_cm = MAX(_margin * 100.0f, 0.0f);
+        for (uint8_t bin = 0; bin < PROXIMITY_MAP_BINS; bin++) {
+            float clearance;
+            if (obstacle_map->get_clearance(bin, clearance)) {
+                const float heading_rad = radians(AP_Proximity_ObstacleMap::bin_heading_deg(bin));
+                const Vector2f limit_direction(cosf(heading_rad), sinf(heading_rad));
+                limit_velocity(kP, accel_cmss, desired_vel_cms, limit_direction, MAX(clearance * 100.0f - margin_cm, 0.0f), dt);
+            }
+        }
+        return;
+    }
+
+    // otherwise use the sensor's scan if it keeps one, limiting the
+    // velocity towards each direction it has a distance in
+    const AP_Proximity_Scan *scan = _proximity.get_scan();
+    if (scan != nullptr) {
+        adjust_velocity_scan(kP, accel_cmss, desired_vel_cms, *scan, dt);
+        return;
+    }
+
     // get boundary from proximity sensor
     uint16_t num_points;
     const Vector2f *boundary = _proximity.get_boundary_points(num_points);
     adjust_velocity_polygon(kP, accel_cmss, desired_vel_cms, boundary, num_points, false, _margin, dt);
 }
 
+/*
+ * Adjusts the desired velocity for the body-frame distances of a proximity sensor's scan.
+ */
+void AC_Avoid::adjust_velocity_scan(float kP, float accel_cmss, Vector2f &desired_vel_cms, const AP_Proximity_Scan &scan, float dt)
+{
+    // rotate velocity vector from earth frame to body-frame
+    Vector2f safe_vel;
+    safe_vel.x = desired_vel_cms.y * _ahrs.sin_yaw() + desired_vel_cms.x * _ahrs.cos_yaw(); // forward
+    safe_vel.y = desired_vel_cms.y * _ahrs.cos_yaw() - desired_vel_cms.x * _ahrs.sin_yaw(); // right
+
+    const float margin_cm = MAX(_margin * 100.0f, 0.0f);
+
+    // the direction of each bin is that of the last rotated by a bin's
+    // width, rather than a sinf() and cosf() for each
+    const float bin_rad = radians(360.0f / PROXIMITY_SCAN_BINS);
+    const float cos_bin = cosf(bin_rad);
+    const float sin_bin = sinf(bin_rad);
+    const float first_rad = radians(AP_Proximity_Scan::bin_angle_deg(0));
+    Vector2f limit_direction(cosf(first_rad), sinf(first_rad));
+    for (uint16_t bin = 0; bin < PROXIMITY_SCAN_BINS; bin++) {
+        float distance;
+        if (scan.get_distance(bin, distance)) {
+            limit_velocity(kP, accel_cmss, safe_vel, limit_direction, MAX(distance * 100.0f - margin_cm, 0.0f), dt);
+        }
+        limit_direction = Vector2f(limit_direction.x * cos_bin - limit_direction.y * sin_bin,
+                                   limit_direction.x * sin_bin + limit_direction.y * cos_bin);
+    }
+
+    // rotate resulting vector back to earth-frame
+    desired_vel_cms.x = safe_vel.x * _ahrs.cos_yaw() - safe_vel.y * _ahrs.sin_yaw();
+    desired_vel_cms.y = safe_vel.x * _ahrs.sin_yaw() + safe_vel.y * _ahrs.cos_yaw();
+}
+
 /*
  * Adjusts the desired velocity for the polygon fence.
  */
@@ -441,46 +529,9 @@ void AC_Avoid::adjust_velocity_polygon(float kP, float accel_cmss, Vector2f &des
 
     uint16_t i, j;
     for (i = 0, j = num_points-1; i < num_points; j = i++) {
-        // end points of current edge
-        Vector2f start = boundary[j];
-        Vector2f end = boundary[i];
-        if ((AC_Avoid::BehaviourType)_behavior.get() == BEHAVIOR_SLIDE) {
-            // vector from current position to closest point on current edge
-            Vector2f limit_direction = Vector2f::closest_point(position_xy, start, end) - position_xy;
-            // distance to closest point
-            const float limit_distance_cm = limit_direction.length();
-            if (!is_zero(limit_distance_cm)) {
-                // We are strictly inside the given edge.
-                // Adjust velocity to not violate this edge.
-                limit_direction /= limit_distance_cm;
-                limit_velocity(kP, accel_cmss, safe_vel, limit_direction, MAX(limit_distance_cm - margin_cm, 0.0f), dt);
-            } else {
-                // We are exactly on the edge - treat this as a fence breach.
-                // i.e. do not adjust velocity.
-                return;
-            }
-        } else {
-            // find intersection with line segment
-            Vector2f intersection;
-            if (Vector2f::segment_intersection(position_xy, stopping_point_plus_margin, start, end, intersection)) {
-                // vector from current position to point on current edge
-                Vector2f limit_direction = intersection - position_xy;
-                const float limit_distance_cm = limit_direction.length();
-                if (!is_zero(limit_distance_cm)) {
-                    if (limit_distance_cm <= margin_cm) {
-                        // we are within the margin so stop vehicle
-                        safe_vel.zero();
-                    } else {
-                        // vehicle inside the given edge, adjust velocity to not violate this edge
-                        limit_direction /= limit_distance_cm;
-                        limit_velocity(kP, accel_cmss, safe_vel, limit_direction, MAX(limit_distance_cm - margin_cm, 0.0f), dt);
-                    }
-                } else {
-                    // We are exactly on the edge - treat this as a fence breach.
-                    // i.e. do not adjust velocity.
-                    return;
-                }
-            }
+        // limit by the edge from point j to point i
+        if (!adjust_velocity_edge(kP, accel_cmss, safe_vel, position_xy, stopping_point_plus_margin, boundary[j], boundary[i], margin_cm, dt)) {
+            return;
         }
     }
 
@@ -494,6 +545,53 @@ void AC_Avoid::adjust_velocity_polygon(float kP, float accel_cmss, Vector2f &des
     }
 }
 
+/*
+ * Adjusts safe_vel to not violate the edge from start to end.
+ * Returns false if the vehicle is exactly on the edge.
+ */
+bool AC_Avoid::adjust_velocity_edge(float kP, float accel_cmss, Vector2f &safe_vel, const Vector2f &position_xy, const Vector2f &stopping_point_plus_margin, const Vector2f &start, const Vector2f &end, float margin_cm, float dt)
+{
+    if ((AC_Avoid::BehaviourType)_behavior.get() == BEHAVIOR_SLIDE) {
+        // vector from current position to closest point on current edge
+        Vector2f limit_direction = Vector2f::closest_point(position_xy, start, end) - position_xy;
+        // distance to closest point
+        const float limit_distance_cm = limit_direction.length();
+        if (!is_zero(limit_distance_cm)) {
+            // We are strictly inside the given edge.
+            // Adjust velocity to not violate this edge.
+            limit_direction /= limit_distance_cm;
+            limit_velocity(kP, accel_cmss, safe_vel, limit_direction, MAX(limit_distance_cm - margin_cm, 0.0f), dt);
+        } else {
+            // We are exactly on the edge - treat this as a fence breach.
+            // i.e. do not adjust velocity.
+            return false;
+        }
+    } else {
+        // find intersection with line segment
+        Vector2f intersection;
+        if (Vector2f::segment_intersection(position_xy, stopping_point_plus_margin, start, end, intersection)) {
+            // vector from current position to point on current edge
+            Vector2f limit_direction = intersection - position_xy;
+            const float limit_distance_cm = limit_direction.length();
+            if (!is_zero(limit_distance_cm)) {
+                if (limit_distance_cm <= margin_cm) {
+                    // we are within the margin so stop vehicle
+                    safe_vel.zero();
+                } else {
+                    // vehicle inside the given edge, adjust velocity to not violate this edge
+                    limit_direction /= limit_distance_cm;
+                    limit_velocity(kP, accel_cmss, safe_vel, limit_direction, MAX(limit_distance_cm - margin_cm, 0.0f), dt);
+                }
+            } else {
+                // We are exactly on the edge - treat this as a fence breach.
+                // i.e. do not adjust velocity.
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 /*
  * Computes distance required to stop, given current speed.
  *
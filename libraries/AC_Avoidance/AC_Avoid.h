@@ -7,6 +7,8 @@
 #include <AC_AttitudeControl/AC_AttitudeControl.h> // Attitude controller library for sqrt controller
 #include <AC_Fence/AC_Fence.h>         // Failsafe fence library
 #include <AP_Proximity/AP_Proximity.h>
+#include <AP_Proximity/AP_Proximity_ObstacleMap.h>
+#include <AP_Proximity/AP_Proximity_Scan.h>
 #include <AP_Beacon/AP_Beacon.h>
 
 #define AC_AVOID_ACCEL_CMSS_MAX         100.0f  // maximum acceleration/deceleration in cm/s/s used to avoid hitting fence
@@ -109,6 +111,11 @@ private:
      */
     void adjust_velocity_proximity(float kP, float accel_cmss, Vector2f &desired_vel_cms, float dt);
 
+    /*
+     * Adjusts the desired velocity given a proximity sensor's scan of body-frame distances
+     */
+    void adjust_velocity_scan(float kP, float accel_cmss, Vector2f &desired_vel_cms, const AP_Proximity_Scan &scan, float dt);
+
     /*
      * Adjusts the desired velocity given an array of boundary points
      *   earth_frame should be true if boundary is in earth-frame, false for body-frame
@@ -116,6 +123,13 @@ private:
      */
     void adjust_velocity_polygon(float kP, float accel_cmss, Vector2f &desired_vel_cms, const Vector2f* boundary, uint16_t num_points, bool earth_frame, float margin, float dt);
 
+    /*
+     * Adjusts safe_vel to not violate a single edge of a boundary.
+     *   stopping_point_plus_margin is where the vehicle would stop, plus the margin
+     *   returns false if the vehicle is exactly on the edge
+     */
+    bool adjust_velocity_edge(float kP, float accel_cmss, Vector2f &safe_vel, const Vector2f &position_xy, const Vector2f &stopping_point_plus_margin, const Vector2f &start, const Vector2f &end, float margin_cm, float dt);
+
     /*
      * Computes distance required to stop, given current speed.
      */
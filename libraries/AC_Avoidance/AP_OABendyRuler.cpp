@@ -0,0 +1,139 @@
+#include "AP_OABendyRuler.h"
+#include <AC_Fence/AC_Fence.h>
+
+#define OA_BENDYRULER_BEARING_INC   5       // bearing step between probed lines in degrees
+#define OA_BENDYRULER_BEARING_MAX   170     // probe up to this far either side of the destination's bearing
+#define OA_BENDYRULER_STEP2_RATIO   0.5f    // length of the second step as a fraction of the lookahead
+
+// unit vector of a bearing in degrees, 0 north and clockwise
+static Vector2f bearing_vector(float bearing_deg)
+{
+    const float bearing_rad = radians(bearing_deg);
+    return Vector2f(cosf(bearing_rad), sinf(bearing_rad));
+}
+
+// distance between the segments a1-a2 and b1-b2, zero if they cross
+static float segment_distance(const Vector2f &a1, const Vector2f &a2, const Vector2f &b1, const Vector2f &b2)
+{
+    Vector2f intersection;
+    if (Vector2f::segment_intersection(a1, a2, b1, b2, intersection)) {
+        return 0;
+    }
+    float dist_sq = (Vector2f::closest_point(a1, b1, b2) - a1).length_squared();
+    dist_sq = MIN(dist_sq, (Vector2f::closest_point(a2, b1, b2) - a2).length_squared());
+    dist_sq = MIN(dist_sq, (Vector2f::closest_point(b1, a1, a2) - b1).length_squared());
+    dist_sq = MIN(dist_sq, (Vector2f::closest_point(b2, a1, a2) - b2).length_squared());
+    return sqrtf(dist_sq);
+}
+
+bool AP_OABendyRuler::update(const Vector2f &current, const Vector2f &destination, const Obstacles &obstacles, Vector2f &destination_new) const
+{
+    const Vector2f to_dest = destination - current;
+    const float distance_to_dest = to_dest.length();
+    if (is_zero(distance_to_dest)) {
+        return false;
+    }
+    const float bearing_to_dest = degrees(atan2f(to_dest.y, to_dest.x));
+    const float step1 = MIN(_lookahead * 100.0f, distance_to_dest);
+    const float step2 = _lookahead * 100.0f * OA_BENDYRULER_STEP2_RATIO;
+
+    // probe either side of the bearing to the destination, nearest first
+    float best_bearing = bearing_to_dest;
+    float best_margin = -FLT_MAX;
+    for (uint8_t i = 0; i <= OA_BENDYRULER_BEARING_MAX / OA_BENDYRULER_BEARING_INC; i++) {
+        for (uint8_t bdir = 0; bdir <= 1; bdir++) {
+            if (i == 0 && bdir > 0) {
+                continue;
+            }
+            const float bearing_test = bearing_to_dest + i * OA_BENDYRULER_BEARING_INC * (bdir == 0 ? -1.0f : 1.0f);
+            const Vector2f test = current + bearing_vector(bearing_test) * step1;
+            const float margin = calc_avoidance_margin(current, test, obstacles);
+            if (margin > best_margin) {
+                best_bearing = bearing_test;
+                best_margin = margin;
+            }
+            if (margin <= _margin_max) {
+                continue;
+            }
+            if (i == 0) {
+                // the direct path is clear
+                return false;
+            }
+
+            // check a second step from the end of this line, towards the
+            // destination or up to 45 degrees either side of it
+            const Vector2f from_test = destination - test;
+            const float bearing_test2 = degrees(atan2f(from_test.y, from_test.x));
+            for (int8_t k = -1; k <= 1; k++) {
+                const Vector2f test2 = test + bearing_vector(bearing_test2 + k * 45) * step2;
+                if (calc_avoidance_margin(test, test2, obstacles) > _margin_max) {
+                    destination_new = current + bearing_vector(bearing_test) * distance_to_dest;
+                    return true;
+                }
+            }
+        }
+    }
+
+    // no bearing has enough margin, take the one with the most
+    destination_new = current + bearing_vector(best_bearing) * step1;
+    return true;
+}
+
+float AP_OABendyRuler::calc_avoidance_margin(const Vector2f &start, const Vector2f &end, const Obstacles &obstacles) const
+{
+    float margin = calc_margin_from_circular_fence(start, end, obstacles);
+    margin = MIN(margin, calc_margin_from_polygon_fence(start, end));
+    margin = MIN(margin, calc_margin_from_obstacles(start, end, obstacles));
+    return margin;
+}
+
+float AP_OABendyRuler::calc_margin_from_circular_fence(const Vector2f &start, const Vector2f &end, const Obstacles &obstacles) const
+{
+    const AC_Fence *fence = AP::fence();
+    if (fence == nullptr || !obstacles.home_valid ||
+        (fence->get_enabled_fences() & AC_FENCE_TYPE_CIRCLE) == 0) {
+        return FLT_MAX;
+    }
+    // the line is inside the circle if both ends are
+    const float distance = MAX((start - obstacles.home).length(), (end - obstacles.home).length());
+    return fence->get_radius() - distance * 0.01f;
+}
+
+float AP_OABendyRuler::calc_margin_from_polygon_fence(const Vector2f &start, const Vector2f &end) const
+{
+    AC_Fence *fence = AP::fence();
+    if (fence == nullptr || (fence->get_enabled_fences() & AC_FENCE_TYPE_POLYGON) == 0) {
+        return FLT_MAX;
+    }
+    WITH_SEMAPHORE(fence->get_polygon_semaphore());
+    const AC_PolyFence_zones *zones = fence->get_polygon_zones();
+    if (zones == nullptr) {
+        return FLT_MAX;
+    }
+
+    // only the edges near the line can be closer than the margin which is enough
+    const Vector2f middle = (start + end) * 0.5f;
+    const float radius = (end - start).length() * 0.5f + _margin_max * 100.0f;
+    uint8_t edges[255];
+    const uint16_t num_edges = zones->get_edges_near(middle, radius, edges, ARRAY_SIZE(edges));
+    float distance = FLT_MAX;
+    for (uint16_t i = 0; i < num_edges; i++) {
+        Vector2f edge_start, edge_end;
+        zones->get_edge(edges[i], edge_start, edge_end);
+        distance = MIN(distance, segment_distance(start, end, edge_start, edge_end));
+    }
+    if (zones->breached(end)) {
+        return (distance == FLT_MAX) ? -radius * 0.01f : -distance * 0.01f;
+    }
+    return (distance == FLT_MAX) ? FLT_MAX : distance * 0.01f;
+}
+
+float AP_OABendyRuler::calc_margin_from_obstacles(const Vector2f &start, const Vector2f &end, const Obstacles &obstacles) const
+{
+    float distance_sq = FLT_MAX;
+    for (uint8_t i = 0; i < obstacles.num_points; i++) {
+        const Vector2f &point = obstacles.points[i];
+        distance_sq = MIN(distance_sq, (Vector2f::closest_point(point, start, end) - point).length_squared());
+    }
+    return (distance_sq == FLT_MAX) ? FLT_MAX : sqrtf(distance_sq) * 0.01f;
+}
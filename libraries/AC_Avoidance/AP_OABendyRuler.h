@@ -0,0 +1,47 @@
+#pragma once
+
+#include <AP_Common/AP_Common.h>
+#include <AP_Math/AP_Math.h>
+#include <AP_Proximity/AP_Proximity_ObstacleMap.h>
+
+/*
+  BendyRuler object avoidance.
+
+  Probes lines of the lookahead distance from the vehicle at bearings
+  fanning out from the bearing to the destination, and picks the first
+  with enough margin from the fences and obstacles, also checking a
+  second step from its end back towards the destination. Positions are
+  in cm NE from the EKF origin.
+
+  This is run by AP_OAPathPlanner in its own thread, so everything
+  from other threads is passed in as a copy, except the fence which is
+  used under its polygon semaphore.
+ */
+class AP_OABendyRuler {
+public:
+    // copy of the obstacles around the vehicle
+    struct Obstacles {
+        Vector2f home;                                  // centre of the circular fence
+        bool home_valid;
+        Vector2f points[PROXIMITY_MAP_BINS];            // obstacle positions
+        uint8_t num_points;
+    };
+
+    // set the length of the probed lines and the margin which is enough, in meters
+    void set_config(float lookahead_m, float margin_max_m) { _lookahead = lookahead_m; _margin_max = margin_max_m; }
+
+    // run the search. Returns true if the vehicle should head for
+    // destination_new instead of destination
+    bool update(const Vector2f &current, const Vector2f &destination, const Obstacles &obstacles, Vector2f &destination_new) const;
+
+private:
+    // get the smallest margin in meters from the line between start and
+    // end to the fences and obstacles. Negative if end is outside a fence
+    float calc_avoidance_margin(const Vector2f &start, const Vector2f &end, const Obstacles &obstacles) const;
+    float calc_margin_from_circular_fence(const Vector2f &start, const Vector2f &end, const Obstacles &obstacles) const;
+    float calc_margin_from_polygon_fence(const Vector2f &start, const Vector2f &end) const;
+    float calc_margin_from_obstacles(const Vector2f &start, const Vector2f &end, const Obstacles &obstacles) const;
+
+    float _lookahead;
+    float _margin_max;
+};
@@ -0,0 +1,196 @@
+#include "AP_OAPathPlanner.h"
+#include <AP_AHRS/AP_AHRS.h>
+#include <AP_Logger/AP_Logger.h>
+#include <GCS_MAVLink/GCS.h>
+#include <AP_Proximity/AP_Proximity.h>
+
+extern const AP_HAL::HAL& hal;
+
+#define OA_LOOKAHEAD_DEFAULT    5
+#define OA_MARGIN_MAX_DEFAULT   5
+#define OA_UPDATE_MS            100     // the thread runs a search with the latest request at 10Hz
+#define OA_TIMEOUT_MS           2000    // results which answer a request older than this are ignored
+
+const AP_Param::GroupInfo AP_OAPathPlanner::var_info[] = {
+
+    // @Param: TYPE
+    // @DisplayName: Object Avoidance Path Planning algorithm to use
+    // @Description: Enabled/disable path planning around obstacles
+    // @Values: 0:Disabled,1:BendyRuler
+    // @User: Standard
+    // @RebootRequired: True
+    AP_GROUPINFO_FLAGS("TYPE", 1,  AP_OAPathPlanner, _type, OA_PATHPLAN_DISABLED, AP_PARAM_FLAG_ENABLE),
+
+    // @Param: LOOKAHEAD
+    // @DisplayName: Object Avoidance look ahead distance maximum
+    // @Description: Object Avoidance will look this many meters ahead of vehicle
+    // @Units: m
+    // @Range: 1 100
+    // @Increment: 1
+    // @User: Standard
+    AP_GROUPINFO("LOOKAHEAD", 2, AP_OAPathPlanner, _lookahead, OA_LOOKAHEAD_DEFAULT),
+
+    // @Param: MARGIN_MAX
+    // @DisplayName: Object Avoidance wide margin distance
+    // @Description: Object Avoidance will ignore objects more than this many meters from vehicle
+    // @Units: m
+    // @Range: 1 10
+    // @Increment: 1
+    // @User: Standard
+    AP_GROUPINFO("MARGIN_MAX", 3, AP_OAPathPlanner, _margin_max, OA_MARGIN_MAX_DEFAULT),
+
+    AP_GROUPEND
+};
+
+AP_OAPathPlanner::AP_OAPathPlanner()
+{
+    _singleton = this;
+
+    AP_Param::setup_object_defaults(this, var_info);
+}
+
+// start the planner thread, if enabled
+void AP_OAPathPlanner::init()
+{
+    if (_type == OA_PATHPLAN_DISABLED || _thread_created) {
+        return;
+    }
+    // run below the IO thread, the search can take many milliseconds
+    if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&AP_OAPathPlanner::avoidance_thread, void),
+                                      "avoidance", 8192, AP_HAL::Scheduler::PRIORITY_IO, -1)) {
+        gcs().send_text(MAV_SEVERITY_ERROR, "Failed to start avoidance thread");
+        return;
+    }
+    _thread_created = true;
+}
+
+// get the origin and destination which avoid obstacles on the way
+// from current_loc to destination
+AP_OAPathPlanner::OA_RetState AP_OAPathPlanner::mission_avoidance(const Location &current_loc,
+                                                                  const Location &origin,
+                                                                  const Location &destination,
+                                                                  Location &result_origin,
+                                                                  Location &result_destination)
+{
+    if (!_thread_created) {
+        return OA_NOT_REQUIRED;
+    }
+
+    Vector2f current_ne, destination_ne;
+    if (!current_loc.get_vector_xy_from_origin_NE(current_ne) ||
+        !destination.get_vector_xy_from_origin_NE(destination_ne)) {
+        // no EKF origin
+        return OA_NOT_REQUIRED;
+    }
+    const uint32_t now_ms = AP_HAL::millis();
+
+    WITH_SEMAPHORE(_rsem);
+
+    // pass the thread the latest request
+    _request.current = current_ne;
+    _request.destination = destination_ne;
+    _request.obstacles.home_valid = AP::ahrs().home_is_set() &&
+        AP::ahrs().get_home().get_vector_xy_from_origin_NE(_request.obstacles.home);
+    _request.obstacles.num_points = 0;
+    const AP_Proximity *proximity = AP_Proximity::get_singleton();
+    const AP_Proximity_ObstacleMap *obstacle_map = (proximity == nullptr) ? nullptr : proximity->get_obstacle_map();
+    if (obstacle_map != nullptr) {
+        _request.obstacles.num_points = obstacle_map->get_obstacles(_request.obstacles.points, ARRAY_SIZE(_request.obstacles.points));
+        for (uint8_t i = 0; i < _request.obstacles.num_points; i++) {
+            // m to cm
+            _request.obstacles.points[i] *= 100.0f;
+        }
+    }
+    _request.time_ms = MAX(now_ms, 1U);
+
+    // use the result for this destination, if there is a recent one
+    if (_result.request_time_ms == 0 || _result.destination != destination_ne) {
+        return OA_PROCESSING;
+    }
+    if (now_ms - _result.request_time_ms > OA_TIMEOUT_MS) {
+        log_result(OA_ERROR, destination, destination, now_ms);
+        return OA_ERROR;
+    }
+    if (!_result.avoiding) {
+        log_result(OA_NOT_REQUIRED, destination, destination, now_ms);
+        return OA_NOT_REQUIRED;
+    }
+
+    // the result is relative to the position the request was made from
+    const Vector2f origin_offset = (_result.current - current_ne) * 0.01f;
+    const Vector2f destination_offset = (_result.destination_new - current_ne) * 0.01f;
+    result_origin = current_loc;
+    result_origin.offset(origin_offset.x, origin_offset.y);
+    result_destination = current_loc;
+    result_destination.offset(destination_offset.x, destination_offset.y);
+    log_result(OA_SUCCESS, destination, result_destination, now_ms);
+    return OA_SUCCESS;
+}
+
+// log a result as it is first used, with the time the search took and
+// how old its request is
+void AP_OAPathPlanner::log_result(OA_RetState state, const Location &destination, const Location &result_destination, uint32_t now_ms)
+{
+    if (_result.request_time_ms == _logged_request_ms) {
+        return;
+    }
+    _logged_request_ms = _result.request_time_ms;
+    AP::logger().Write_OA(state, _result.plan_us, now_ms - _result.request_time_ms, destination, result_destination);
+}
+
+// main loop of the planner thread
+void AP_OAPathPlanner::avoidance_thread()
+{
+    while (true) {
+        hal.scheduler->delay(OA_UPDATE_MS);
+
+        // take the latest request
+        Vector2f current, destination;
+        AP_OABendyRuler::Obstacles obstacles;
+        uint32_t request_time_ms;
+        {
+            WITH_SEMAPHORE(_rsem);
+            if (_request.time_ms == 0) {
+                continue;
+            }
+            current = _request.current;
+            destination = _request.destination;
+            obstacles = _request.obstacles;
+            request_time_ms = _request.time_ms;
+            _request.time_ms = 0;
+        }
+
+        const uint32_t start_us = AP_HAL::micros();
+        Vector2f destination_new;
+        bool avoiding = false;
+        switch (_type) {
+        case OA_PATHPLAN_BENDYRULER:
+            _oabendyruler.set_config(_lookahead, _margin_max);
+            avoiding = _oabendyruler.update(current, destination, obstacles, destination_new);
+            break;
+        default:
+            break;
+        }
+        const uint32_t plan_us = AP_HAL::micros() - start_us;
+
+        WITH_SEMAPHORE(_rsem);
+        _result.current = current;
+        _result.destination = destination;
+        _result.destination_new = destination_new;
+        _result.avoiding = avoiding;
+        _result.request_time_ms = request_time_ms;
+        _result.plan_us = plan_us;
+    }
+}
+
+// singleton instance
+AP_OAPathPlanner *AP_OAPathPlanner::_singleton;
+
+namespace AP {
+
+AP_OAPathPlanner *ap_oapathplanner()
+{
+    return AP_OAPathPlanner::get_singleton();
+}
+
+}
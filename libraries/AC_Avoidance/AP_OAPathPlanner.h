@@ -0,0 +1,99 @@
+#pragma once
+
+#include <AP_Common/AP_Common.h>
+#include <AP_Common/Location.h>
+#include <AP_Param/AP_Param.h>
+#include <AP_HAL/AP_HAL.h>
+#include "AP_OABendyRuler.h"
+
+/*
+  object avoidance path planner.
+
+  The search runs in its own low priority thread. The vehicle's
+  navigation passes its position and destination to
+  mission_avoidance() each loop, which hands them to the thread along
+  with a copy of the proximity obstacles, and returns the destination
+  the thread last worked out for them. A result which is older than
+  OA_TIMEOUT_MS is an error, so the latency of the avoidance is bounded
+  however long the search takes.
+ */
+class AP_OAPathPlanner {
+public:
+    AP_OAPathPlanner();
+
+    /* Do not allow copies */
+    AP_OAPathPlanner(const AP_OAPathPlanner &other) = delete;
+    AP_OAPathPlanner &operator=(const AP_OAPathPlanner&) = delete;
+
+    // get singleton instance
+    static AP_OAPathPlanner *get_singleton() {
+        return _singleton;
+    }
+
+    // start the planner thread, if enabled
+    void init();
+
+    // return values of mission_avoidance
+    enum OA_RetState {
+        OA_NOT_REQUIRED = 0,    // the path to the destination is clear, or the planner is disabled
+        OA_PROCESSING,          // the planner has not produced a result for this destination yet
+        OA_ERROR,               // the planner's result is too old
+        OA_SUCCESS              // use result_origin and result_destination to avoid obstacles
+    };
+
+    // get the origin and destination which avoid obstacles on the way
+    // from current_loc to destination. Called by the vehicle's
+    // navigation each loop
+    OA_RetState mission_avoidance(const Location &current_loc,
+                                  const Location &origin,
+                                  const Location &destination,
+                                  Location &result_origin,
+                                  Location &result_destination);
+
+    static const struct AP_Param::GroupInfo var_info[];
+
+private:
+    enum OAPathPlanTypes {
+        OA_PATHPLAN_DISABLED = 0,
+        OA_PATHPLAN_BENDYRULER = 1,
+    };
+
+    // main loop of the planner thread
+    void avoidance_thread();
+
+    // log a result as it is first used
+    void log_result(OA_RetState state, const Location &destination, const Location &result_destination, uint32_t now_ms);
+
+    // parameters
+    AP_Int8 _type;              // avoidance algorithm to use
+    AP_Float _lookahead;        // lookahead distance in meters
+    AP_Float _margin_max;       // object avoidance will ignore objects more than this many meters from vehicle
+
+    // the latest request from the navigation, and the thread's result
+    // for the last one it processed. Both protected by _rsem
+    HAL_Semaphore _rsem;
+    struct {
+        Vector2f current;                       // vehicle position, cm NE from the EKF origin
+        Vector2f destination;                   // final destination, cm NE from the EKF origin
+        AP_OABendyRuler::Obstacles obstacles;   // copy of the obstacles around the vehicle
+        uint32_t time_ms;                       // time of the request, zero when the thread has taken it
+    } _request;
+    struct {
+        Vector2f current;                       // vehicle position of the request
+        Vector2f destination;                   // final destination of the request
+        Vector2f destination_new;               // destination to head for instead
+        bool avoiding;                          // true if destination_new should be used
+        uint32_t request_time_ms;               // time of the request, zero if there is no result
+        uint32_t plan_us;                       // time the search took
+    } _result;
+
+    AP_OABendyRuler _oabendyruler;
+    bool _thread_created;
+    uint32_t _logged_request_ms;                // request time of the last logged result
+
+    static AP_OAPathPlanner *_singleton;
+};
+
+namespace AP {
+    AP_OAPathPlanner *ap_oapathplanner();
+};
@@ -76,6 +76,13 @@ const AP_Param::GroupInfo AC_Fence::var_info[] = {
     // @User: Standard
     AP_GROUPINFO_FRAME("ALT_MIN",     7,  AC_Fence,   _alt_min,       AC_FENCE_ALT_MIN_DEFAULT, AP_PARAM_FRAME_SUB),
 
+    // @Param: ZONE_INCL
+    // @DisplayName: Fence polygon inclusion zones
+    // @Description: The polygon fence points may hold several polygons one after another, each closed by repeating its first point. This is a bitmask of the polygons which are inclusion zones, which the vehicle must stay inside. The others are exclusion zones, which the vehicle must stay out of
+    // @Bitmask: 0:Zone1,1:Zone2,2:Zone3,3:Zone4,4:Zone5,5:Zone6,6:Zone7,7:Zone8
+    // @User: Advanced
+    AP_GROUPINFO("ZONE_INCL",   8,  AC_Fence,   _zone_inclusion, 1),
+
     AP_GROUPEND
 };
 
@@ -258,8 +265,9 @@ bool AC_Fence::polygon_fence_is_breached()
         return false;
     }
 
-    // check consistency of number of points
-    if (_boundary_num_points != _total) {
+    // check consistency of number of points and zones
+    if (_boundary_num_points != _total ||
+        _zones.get_inclusion_mask() != uint32_t(_zone_inclusion.get())) {
         // Fence is currently not completely loaded.  Can't breach it?!
         _boundary_loaded = false;
         load_polygon_from_eeprom();
@@ -278,7 +286,7 @@ bool AC_Fence::polygon_fence_is_breached()
     }
 
     position = position * 100.0f;  // m to cm
-    return _poly_loader.boundary_breached(position, _boundary_num_points, _boundary);
+    return _zones.breached(position);
 }
 
 bool AC_Fence::check_fence_circle()
@@ -386,11 +394,11 @@ bool AC_Fence::check_destination_within_fence(const Location& loc)
     }
 
     // polygon fence check
-    if ((get_enabled_fences() & AC_FENCE_TYPE_POLYGON) && _boundary_num_points > 0) {
+    if ((get_enabled_fences() & AC_FENCE_TYPE_POLYGON) && _boundary_valid) {
         // check ekf has a good location
         Vector2f posNE;
         if (loc.get_vector_xy_from_origin_NE(posNE)) {
-            if (_poly_loader.boundary_breached(posNE, _boundary_num_points, _boundary)) {
+            if (_zones.breached(posNE)) {
                 return false;
             }
         }
@@ -554,26 +562,35 @@ bool AC_Fence::load_polygon_from_eeprom(bool force_reload)
         return false;
     }
 
+    WITH_SEMAPHORE(_polygon_sem);
+
     // sanity check total
     _total = constrain_int16(_total, 0, _poly_loader.max_points());
 
-    // load each point from eeprom
-    Vector2l temp_latlon;
-    for (uint16_t index=0; index<_total; index++) {
-        // load boundary point as lat/lon point
-        if (!_poly_loader.load_point_from_eeprom(index, temp_latlon)) {
-            return false;
+    // load the points from eeprom as lat/lon a few at a time, and
+    // convert them to offsets in cm from the ekf origin
+    const LocationOrigin origin(ekf_origin);
+    Vector2l latlon[8];
+    for (uint16_t index=0; index<_total; index += ARRAY_SIZE(latlon)) {
+        const uint16_t n = MIN(_total - index, (int)ARRAY_SIZE(latlon));
+        for (uint16_t i=0; i<n; i++) {
+            if (!_poly_loader.load_point_from_eeprom(index+i, latlon[i])) {
+                return false;
+            }
+        }
+        origin.get_distances_NE(latlon, n, &_boundary[index]);
+        for (uint16_t i=0; i<n; i++) {
+            _boundary[index+i] *= 100.0f;
         }
-        // move into location structure and convert to offset from ekf origin
-        temp_loc.lat = temp_latlon.x;
-        temp_loc.lng = temp_latlon.y;
-        _boundary[index] = ekf_origin.get_distance_NE(temp_loc) * 100.0f;
     }
     _boundary_num_points = _total;
     _boundary_loaded = true;
 
-    // update validity of polygon
-    _boundary_valid = _poly_loader.boundary_valid(_boundary_num_points, _boundary);
+    // update validity of the zones, the return point must be within
+    // them. Point 0 is the return point
+    _boundary_valid = _total > 1 &&
+        _zones.build(&_boundary[1], _total-1, _zone_inclusion) &&
+        !_zones.breached(_boundary[0]);
 
     return true;
 }
@@ -6,6 +6,7 @@
 #include <AP_Math/AP_Math.h>
 #include <GCS_MAVLink/GCS.h>
 #include <AC_Fence/AC_PolyFence_loader.h>
+#include <AC_Fence/AC_PolyFence_zones.h>
 #include <AP_Common/Location.h>
 
 // bit masks for enabled fence types.  Used for TYPE parameter
@@ -102,6 +103,12 @@ public:
     /// returns pointer to array of polygon points and num_points is filled in with the total number
     Vector2f* get_polygon_points(uint16_t& num_points) const;
 
+    /// returns the polygon fence zones, or nullptr if they are not valid
+    const AC_PolyFence_zones *get_polygon_zones() const { return _boundary_valid ? &_zones : nullptr; }
+
+    /// semaphore held while the polygon is loaded. Other threads must hold it while using the zones
+    HAL_Semaphore &get_polygon_semaphore() { return _polygon_sem; }
+
     /// returns true if we've breached the polygon boundary.  simple passthrough to underlying _poly_loader object
     bool boundary_breached(const Vector2f& location, uint16_t num_points, const Vector2f* points) const;
 
@@ -156,6 +163,7 @@ private:
     AP_Float        _circle_radius;         // circle fence radius in meters
     AP_Float        _margin;                // distance in meters that autopilot's should maintain from the fence to avoid a breach
     AP_Int8         _total;                 // number of polygon points saved in eeprom
+    AP_Int32        _zone_inclusion;        // bit mask of the polygon zones which are inclusion zones
 
     // backup fences
     float           _alt_max_backup;        // backup altitude upper limit in meters used to refire the breach if the vehicle continues to move further away
@@ -183,7 +191,9 @@ private:
     uint8_t         _boundary_num_points = 0;       // number of points in the boundary array (should equal _total parameter after load has completed)
     bool            _boundary_create_attempted = false; // true if we have attempted to create the boundary array
     bool            _boundary_loaded = false;       // true if boundary array has been loaded from eeprom
-    bool            _boundary_valid = false;        // true if boundary forms a closed polygon
+    bool            _boundary_valid = false;        // true if boundary forms closed polygon zones around the return point
+    AC_PolyFence_zones _zones;                      // inclusion and exclusion zones of the boundary
+    HAL_Semaphore   _polygon_sem;                   // protects the boundary and zones from other threads while loading
 };
 
 namespace AP {
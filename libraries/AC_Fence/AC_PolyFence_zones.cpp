@@ -0,0 +1,224 @@
+#include "AC_PolyFence_zones.h"
+
+// _edge_zone value of a point which closes a zone
+#define ZONE_NO_EDGE 0xFF
+
+AC_PolyFence_zones::~AC_PolyFence_zones()
+{
+    clear();
+}
+
+void AC_PolyFence_zones::clear()
+{
+    free(_edge_zone);
+    free(_cell_start);
+    free(_cell_edges);
+    _edge_zone = nullptr;
+    _cell_start = nullptr;
+    _cell_edges = nullptr;
+    _points = nullptr;
+    _num_zones = 0;
+    _cols = 0;
+    _rows = 0;
+}
+
+// find the zones in _points, marking the points which start an edge
+// with their zone
+bool AC_PolyFence_zones::find_zones(uint16_t num_points)
+{
+    uint16_t first = 0;
+    while (first < num_points) {
+        if (_num_zones >= AC_FENCE_MAX_ZONES) {
+            return false;
+        }
+        // a zone needs at least a triangle and its closing point
+        uint16_t last = first + 3;
+        while (last < num_points && _points[last] != _points[first]) {
+            last++;
+        }
+        if (last >= num_points) {
+            // not closed
+            return false;
+        }
+        for (uint16_t i=first; i<last; i++) {
+            _edge_zone[i] = _num_zones;
+        }
+        _edge_zone[last] = ZONE_NO_EDGE;
+        _num_zones++;
+        first = last + 1;
+    }
+    return _num_zones > 0;
+}
+
+bool AC_PolyFence_zones::build(const Vector2f *points, uint16_t num_points, uint32_t inclusion_mask)
+{
+    clear();
+    _inclusion_mask = inclusion_mask;
+    if (points == nullptr || num_points == 0 || num_points > 255) {
+        return false;
+    }
+    _points = points;
+    _edge_zone = (uint8_t *)calloc(num_points, sizeof(uint8_t));
+    if (_edge_zone == nullptr) {
+        clear();
+        return false;
+    }
+    if (!find_zones(num_points)) {
+        clear();
+        return false;
+    }
+
+    // size the grid to have about one cell per edge, keeping the
+    // cells roughly square
+    Vector2f grid_max = _points[0];
+    _grid_min = _points[0];
+    uint16_t num_edges = 0;
+    for (uint16_t i=0; i<num_points; i++) {
+        _grid_min.x = MIN(_grid_min.x, _points[i].x);
+        _grid_min.y = MIN(_grid_min.y, _points[i].y);
+        grid_max.x = MAX(grid_max.x, _points[i].x);
+        grid_max.y = MAX(grid_max.y, _points[i].y);
+        if (_edge_zone[i] != ZONE_NO_EDGE) {
+            num_edges++;
+        }
+    }
+    const Vector2f size(MAX(grid_max.x - _grid_min.x, 1.0f),
+                        MAX(grid_max.y - _grid_min.y, 1.0f));
+    _cols = constrain_int16(lrintf(sqrtf(num_edges * size.x / size.y)), 1, AC_FENCE_GRID_MAX_CELLS);
+    _rows = constrain_int16(lrintf(num_edges / float(_cols)), 1, AC_FENCE_GRID_MAX_CELLS);
+    _cell_size.x = size.x / _cols;
+    _cell_size.y = size.y / _rows;
+
+    // count the edges in each cell, then fill in the lists
+    const uint16_t num_cells = _cols * _rows;
+    _cell_start = (uint16_t *)calloc(num_cells + 1, sizeof(uint16_t));
+    if (_cell_start == nullptr) {
+        clear();
+        return false;
+    }
+    for (uint8_t pass=0; pass<2; pass++) {
+        for (uint16_t e=0; e<num_points; e++) {
+            if (_edge_zone[e] == ZONE_NO_EDGE) {
+                continue;
+            }
+            const Vector2f &a = _points[e];
+            const Vector2f &b = _points[e+1];
+            const uint8_t col_min = cell_col(MIN(a.x, b.x));
+            const uint8_t col_max = cell_col(MAX(a.x, b.x));
+            const uint8_t row_min = cell_row(MIN(a.y, b.y));
+            const uint8_t row_max = cell_row(MAX(a.y, b.y));
+            for (uint8_t row=row_min; row<=row_max; row++) {
+                for (uint8_t col=col_min; col<=col_max; col++) {
+                    const uint16_t cell = row * _cols + col;
+                    if (pass == 0) {
+                        _cell_start[cell+1]++;
+                    } else {
+                        // _cell_start[cell] counts up to the start of
+                        // the next cell as the list is filled
+                        _cell_edges[_cell_start[cell]++] = e;
+                    }
+                }
+            }
+        }
+        if (pass == 0) {
+            for (uint16_t cell=0; cell<num_cells; cell++) {
+                _cell_start[cell+1] += _cell_start[cell];
+            }
+            _cell_edges = (uint8_t *)calloc(MAX(_cell_start[num_cells], 1), sizeof(uint8_t));
+            if (_cell_edges == nullptr) {
+                clear();
+                return false;
+            }
+        } else {
+            // each start has moved on to the start of the next cell
+            for (uint16_t cell=num_cells; cell>0; cell--) {
+                _cell_start[cell] = _cell_start[cell-1];
+            }
+            _cell_start[0] = 0;
+        }
+    }
+    return true;
+}
+
+uint8_t AC_PolyFence_zones::cell_col(float x) const
+{
+    return constrain_int16(int16_t(floorf((x - _grid_min.x) / _cell_size.x)), 0, _cols-1);
+}
+
+uint8_t AC_PolyFence_zones::cell_row(float y) const
+{
+    return constrain_int16(int16_t(floorf((y - _grid_min.y) / _cell_size.y)), 0, _rows-1);
+}
+
+bool AC_PolyFence_zones::breached(const Vector2f &location) const
+{
+    if (_num_zones == 0) {
+        return false;
+    }
+    const uint32_t zones_mask = (_num_zones == 32) ? UINT32_MAX : ((1U << _num_zones) - 1);
+    const uint32_t inclusion = _inclusion_mask & zones_mask;
+
+    // the zones the location is inside, from the parity of the
+    // crossings of a ray from it towards +x. Edges which cross the ray
+    // are all in the location's row, and the clamps make the rows and
+    // columns match those the edges were listed in
+    uint32_t inside = 0;
+    const uint8_t row = cell_row(location.y);
+    for (uint8_t col=cell_col(location.x); col<_cols; col++) {
+        const uint16_t cell = row * _cols + col;
+        for (uint16_t i=_cell_start[cell]; i<_cell_start[cell+1]; i++) {
+            const uint8_t e = _cell_edges[i];
+            const Vector2f &a = _points[e];
+            const Vector2f &b = _points[e+1];
+            if ((a.y > location.y) == (b.y > location.y)) {
+                continue;
+            }
+            const float x = constrain_float(a.x + (location.y - a.y) * (b.x - a.x) / (b.y - a.y),
+                                            MIN(a.x, b.x), MAX(a.x, b.x));
+            // an edge can be in several cells of the row, count it
+            // only in the cell holding the crossing
+            if (x <= location.x || cell_col(x) != col) {
+                continue;
+            }
+            inside ^= 1U << _edge_zone[e];
+        }
+    }
+
+    if (inclusion != 0 && (inside & inclusion) == 0) {
+        return true;
+    }
+    return (inside & ~inclusion) != 0;
+}
+
+uint16_t AC_PolyFence_zones::get_edges_near(const Vector2f &location, float radius, uint8_t *edges, uint16_t max_edges) const
+{
+    if (_num_zones == 0) {
+        return 0;
+    }
+    // an edge can be in several of the cells
+    uint32_t seen[256/32] {};
+    uint16_t count = 0;
+    const uint8_t row_max = cell_row(location.y + radius);
+    const uint8_t col_max = cell_col(location.x + radius);
+    for (uint8_t row=cell_row(location.y - radius); row<=row_max; row++) {
+        for (uint8_t col=cell_col(location.x - radius); col<=col_max; col++) {
+            const uint16_t cell = row * _cols + col;
+            for (uint16_t i=_cell_start[cell]; i<_cell_start[cell+1]; i++) {
+                const uint8_t e = _cell_edges[i];
+                if (seen[e/32] & (1U << (e%32))) {
+                    continue;
+                }
+                seen[e/32] |= 1U << (e%32);
+                const Vector2f closest = Vector2f::closest_point(location, _points[e], _points[e+1]);
+                if ((closest - location).length_squared() > sq(radius)) {
+                    continue;
+                }
+                if (count >= max_edges) {
+                    return count;
+                }
+                edges[count++] = e;
+            }
+        }
+    }
+    return count;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <AP_Common/AP_Common.h>
+#include <AP_Math/AP_Math.h>
+
+// maximum number of polygon fence zones
+#define AC_FENCE_MAX_ZONES                          32
+
+// maximum number of grid cells along each axis
+#define AC_FENCE_GRID_MAX_CELLS                     16
+
+/*
+  polygon fence zones with a uniform grid over their edges.
+
+  The fence points hold the zones one after another, each closed by
+  repeating its first point. Each zone is an inclusion zone, which the
+  vehicle must be inside, or an exclusion zone, which it must stay
+  out of. The grid covers the bounding box of all the zones and has
+  about one cell per edge. Each cell lists the edges whose bounding
+  boxes overlap it.
+
+  A breach check casts a ray from the location along the cells of its
+  row, and a query for the edges near a location only looks at the
+  cells within range. Neither query walks every edge, so their cost
+  depends on how dense the edges are per cell, not on the total.
+ */
+class AC_PolyFence_zones
+{
+public:
+    ~AC_PolyFence_zones();
+
+    // build the zones and grid from num_points points, which must stay
+    // allocated while the zones are in use. Zone i is an inclusion zone
+    // if bit i of inclusion_mask is set. Returns false if out of memory
+    // or the points are not a series of closed polygons
+    bool build(const Vector2f *points, uint16_t num_points, uint32_t inclusion_mask);
+
+    // free the grid and forget the zones
+    void clear();
+
+    uint8_t num_zones() const { return _num_zones; }
+    uint32_t get_inclusion_mask() const { return _inclusion_mask; }
+
+    // returns true if location is outside every inclusion zone, when
+    // there are any, or inside any exclusion zone
+    bool breached(const Vector2f &location) const;
+
+    // fill edges with up to max_edges edges which pass within radius
+    // of location, returning how many there are
+    uint16_t get_edges_near(const Vector2f &location, float radius, uint8_t *edges, uint16_t max_edges) const;
+
+    // get the end points of an edge returned by get_edges_near()
+    void get_edge(uint8_t edge, Vector2f &start, Vector2f &end) const {
+        start = _points[edge];
+        end = _points[edge+1];
+    }
+
+private:
+    // find the zones in _points, returning false if they are not a
+    // series of closed polygons
+    bool find_zones(uint16_t num_points);
+
+    // get the cell column or row holding a coordinate, clamped to the grid
+    uint8_t cell_col(float x) const;
+    uint8_t cell_row(float y) const;
+
+    const Vector2f *_points = nullptr;
+    uint8_t _num_zones = 0;
+    uint32_t _inclusion_mask = 0;
+
+    // zone of each edge, indexed by the edge's first point. Edges are
+    // only stored for points which start one
+    uint8_t *_edge_zone = nullptr;
+
+    // the grid. Cell (col, row) lists the edges from
+    // _cell_edges[_cell_start[row*_cols+col]] up to the start of the
+    // next cell
+    Vector2f _grid_min;
+    Vector2f _cell_size;
+    uint8_t _cols = 0;
+    uint8_t _rows = 0;
+    uint16_t *_cell_start = nullptr;
+    uint8_t *_cell_edges = nullptr;
+};
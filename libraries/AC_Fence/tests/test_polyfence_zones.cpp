@@ -0,0 +1,161 @@
+#include <AP_gtest.h>
+
+#include <AC_Fence/AC_PolyFence_zones.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// a star shaped polygon with n outer points, closed by repeating the first
+static uint16_t make_star(Vector2f *points, uint8_t n, const Vector2f &centre, float radius)
+{
+    for (uint8_t i=0; i<n; i++) {
+        const float r = (i % 2) ? radius * 0.4f : radius;
+        const float angle = M_2PI * i / n;
+        points[i] = centre + Vector2f(r * cosf(angle), r * sinf(angle));
+    }
+    points[n] = points[0];
+    return n + 1;
+}
+
+// distance from p to the nearest edge of a closed polygon
+static float edge_distance(const Vector2f &p, const Vector2f *points, uint16_t num_points)
+{
+    float distance = FLT_MAX;
+    for (uint16_t i=0; i+1<num_points; i++) {
+        distance = MIN(distance, (Vector2f::closest_point(p, points[i], points[i+1]) - p).length());
+    }
+    return distance;
+}
+
+static float rand_float(float low, float high)
+{
+    return low + (high - low) * (random() / float(RAND_MAX));
+}
+
+TEST(PolyFenceZonesTest, Invalid)
+{
+    AC_PolyFence_zones zones;
+    const Vector2f open[] { {0,0}, {100,0}, {100,100}, {0,100} };
+    EXPECT_FALSE(zones.build(open, ARRAY_SIZE(open), 1));
+    EXPECT_FALSE(zones.build(open, 0, 1));
+
+    // a closed triangle followed by points which are not closed
+    const Vector2f leftover[] { {0,0}, {100,0}, {100,100}, {0,0}, {500,500} };
+    EXPECT_FALSE(zones.build(leftover, ARRAY_SIZE(leftover), 1));
+    EXPECT_TRUE(zones.build(leftover, ARRAY_SIZE(leftover)-1, 1));
+    EXPECT_EQ(zones.num_zones(), 1);
+
+    // nothing is breached once cleared
+    zones.clear();
+    EXPECT_FALSE(zones.breached(Vector2f(500,500)));
+}
+
+/*
+  a single inclusion zone should match the plain polygon test. That
+  works in whole cm, so skip locations within a few cm of an edge
+ */
+TEST(PolyFenceZonesTest, MatchesPolygonOutside)
+{
+    Vector2f points[64];
+    const uint16_t num_points = make_star(points, 40, Vector2f(1000, -3000), 5000);
+
+    AC_PolyFence_zones zones;
+    ASSERT_TRUE(zones.build(points, num_points, 1));
+    EXPECT_EQ(zones.num_zones(), 1);
+
+    srandom(7);
+    for (uint16_t i=0; i<20000; i++) {
+        const Vector2f p(rand_float(-5000, 7000), rand_float(-9000, 3000));
+        if (edge_distance(p, points, num_points) < 2) {
+            continue;
+        }
+        ASSERT_EQ(zones.breached(p), Polygon_outside(p, points, num_points))
+            << "at " << p.x << "," << p.y;
+    }
+}
+
+TEST(PolyFenceZonesTest, ExclusionZones)
+{
+    Vector2f points[64];
+    uint16_t num_points = 0;
+    // inclusion zone: square of 10000cm
+    const Vector2f square[] { {0,0}, {10000,0}, {10000,10000}, {0,10000}, {0,0} };
+    memcpy(points, square, sizeof(square));
+    num_points += ARRAY_SIZE(square);
+    // two exclusion zones inside it
+    num_points += make_star(&points[num_points], 10, Vector2f(3000, 3000), 1000);
+    num_points += make_star(&points[num_points], 12, Vector2f(7000, 6000), 1500);
+
+    AC_PolyFence_zones zones;
+    ASSERT_TRUE(zones.build(points, num_points, 1));
+    EXPECT_EQ(zones.num_zones(), 3);
+
+    EXPECT_FALSE(zones.breached(Vector2f(500, 9000)));
+    EXPECT_TRUE(zones.breached(Vector2f(3000, 3000)));
+    EXPECT_TRUE(zones.breached(Vector2f(7000, 6000)));
+    EXPECT_TRUE(zones.breached(Vector2f(-100, 5000)));
+    EXPECT_TRUE(zones.breached(Vector2f(5000, 20000)));
+
+    srandom(11);
+    for (uint16_t i=0; i<20000; i++) {
+        const Vector2f p(rand_float(-1000, 11000), rand_float(-1000, 11000));
+        if (edge_distance(p, points, num_points) < 2) {
+            continue;
+        }
+        const bool expected = Polygon_outside(p, &points[0], 5) ||
+                              !Polygon_outside(p, &points[5], 11) ||
+                              !Polygon_outside(p, &points[16], 13);
+        ASSERT_EQ(zones.breached(p), expected) << "at " << p.x << "," << p.y;
+    }
+
+    // with no inclusion zones only the exclusion zones are breached
+    ASSERT_TRUE(zones.build(points, num_points, 0));
+    EXPECT_FALSE(zones.breached(Vector2f(-100, 5000)));
+    EXPECT_TRUE(zones.breached(Vector2f(3000, 3000)));
+}
+
+/*
+  the edges near a location should be exactly those a walk over
+  every edge finds
+ */
+TEST(PolyFenceZonesTest, EdgesNear)
+{
+    Vector2f points[128];
+    uint16_t num_points = make_star(points, 60, Vector2f(0, 0), 20000);
+    num_points += make_star(&points[num_points], 30, Vector2f(2000, -1000), 3000);
+
+    AC_PolyFence_zones zones;
+    ASSERT_TRUE(zones.build(points, num_points, 1));
+
+    srandom(3);
+    for (uint16_t i=0; i<2000; i++) {
+        const Vector2f p(rand_float(-22000, 22000), rand_float(-22000, 22000));
+        const float radius = rand_float(10, 8000);
+        uint8_t edges[255];
+        const uint16_t count = zones.get_edges_near(p, radius, edges, ARRAY_SIZE(edges));
+
+        uint16_t expected = 0;
+        for (uint16_t e=0; e+1<num_points; e++) {
+            if (e == 60) {
+                // closing point of the first zone
+                continue;
+            }
+            const Vector2f closest = Vector2f::closest_point(p, points[e], points[e+1]);
+            if ((closest - p).length() > radius) {
+                continue;
+            }
+            expected++;
+            bool found = false;
+            for (uint16_t j=0; j<count; j++) {
+                found |= (edges[j] == e);
+            }
+            ASSERT_TRUE(found) << "edge " << e;
+            Vector2f start, end;
+            zones.get_edge(e, start, end);
+            EXPECT_EQ(start, points[e]);
+            EXPECT_EQ(end, points[e+1]);
+        }
+        ASSERT_EQ(count, expected);
+    }
+}
+
+AP_GTEST_MAIN()
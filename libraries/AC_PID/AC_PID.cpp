@@ -47,7 +47,8 @@ AC_PID::AC_PID(float initial_p, float initial_i, float initial_d, float initial_
     _dt(dt),
     _integrator(0.0f),
     _input(0.0f),
-    _derivative(0.0f)
+    _derivative(0.0f),
+    _filt_alpha_valid(false)
 {
     // load parameter values from eeprom
     AP_Param::setup_object_defaults(this, var_info);
@@ -79,6 +80,7 @@ void AC_PID::filt_hz(float hz)
 
     // sanity check _filt_hz
     _filt_hz = MAX(_filt_hz, AC_PID_FILT_HZ_MIN);
+    _filt_alpha_valid = false;
 }
 
 // set_input_filter_all - set input to PID controller
@@ -177,6 +179,99 @@ float AC_PID::get_pid()
     return get_p() + get_i() + get_d();
 }
 
+/*
+  run three rate PIDs in one pass. The gains and state of all the axes
+  are gathered into arrays, updated together without calls through
+  the objects, then stored back so the AC_PID accessors, resets and
+  logging see the same values as when each axis is run on its own
+ */
+Vector3f AC_PID::update_rate_3axis(AC_PID *const pid[3], const Vector3f &target, const Vector3f &actual, float dt,
+                                   const bool filter_all[3], const bool limited[3])
+{
+    struct {
+        float error[3];
+        float input[3];
+        float derivative[3];
+        float integrator[3];
+        float kp[3];
+        float ki[3];
+        float kd[3];
+        float ff[3];
+        float imax[3];
+        float alpha[3];
+    } axes;
+
+    for (uint8_t i=0; i<3; i++) {
+        AC_PID &p = *pid[i];
+        p._dt = dt;
+        p._pid_info.desired = target[i];
+        axes.error[i] = target[i] - actual[i];
+        if (p._flags._reset_filter && isfinite(axes.error[i])) {
+            // reset input filter to value received
+            p._flags._reset_filter = false;
+            p._input = axes.error[i];
+            p._derivative = 0.0f;
+        }
+        axes.input[i] = p._input;
+        axes.derivative[i] = p._derivative;
+        axes.integrator[i] = p._integrator;
+        axes.kp[i] = p._kp;
+        axes.ki[i] = p._ki;
+        axes.kd[i] = p._kd;
+        axes.ff[i] = p._ff;
+        axes.imax[i] = p._imax;
+        axes.alpha[i] = p.get_filt_alpha();
+    }
+
+    Vector3f out;
+    for (uint8_t i=0; i<3; i++) {
+        const float error = axes.error[i];
+        // don't process inf or NaN
+        if (isfinite(error)) {
+            if (filter_all[i]) {
+                const float input_filt_change = axes.alpha[i] * (error - axes.input[i]);
+                axes.input[i] += input_filt_change;
+                if (dt > 0.0f) {
+                    axes.derivative[i] = input_filt_change / dt;
+                }
+            } else {
+                if (dt > 0.0f) {
+                    const float derivative = (error - axes.input[i]) / dt;
+                    axes.derivative[i] += axes.alpha[i] * (derivative - axes.derivative[i]);
+                }
+                axes.input[i] = error;
+            }
+        }
+
+        float integrator = axes.integrator[i];
+        // when limited the integrator can only be reduced
+        if (!limited[i] || (is_positive(integrator) && is_negative(error)) || (is_negative(integrator) && is_positive(error))) {
+            if (!is_zero(axes.ki[i]) && !is_zero(dt)) {
+                axes.integrator[i] = constrain_float(axes.integrator[i] + axes.input[i] * axes.ki[i] * dt,
+                                                     -axes.imax[i], axes.imax[i]);
+                integrator = axes.integrator[i];
+                pid[i]->_pid_info.I = integrator;
+            } else {
+                integrator = 0;
+            }
+        }
+
+        const float P = axes.input[i] * axes.kp[i];
+        const float D = axes.derivative[i] * axes.kd[i];
+        const float FF = target[i] * axes.ff[i];
+        out[i] = P + integrator + D + FF;
+
+        AC_PID &p = *pid[i];
+        p._input = axes.input[i];
+        p._derivative = axes.derivative[i];
+        p._integrator = axes.integrator[i];
+        p._pid_info.P = P;
+        p._pid_info.D = D;
+        p._pid_info.FF = FF;
+    }
+    return out;
+}
+
 void AC_PID::reset_I()
 {
     _integrator = 0;
@@ -212,16 +307,27 @@ void AC_PID::operator() (float p, float i, float d, float imaxval, float input_f
     _filt_hz = input_filt_hz;
     _dt = dt;
     _ff = ffval;
+    _filt_alpha_valid = false;
 }
 
-// calc_filt_alpha - recalculate the input filter alpha
+// get_filt_alpha - get the input filter alpha, recalculating it only
+// when the time step or a parameter may have changed
 float AC_PID::get_filt_alpha() const
 {
-    if (is_zero(_filt_hz)) {
-        return 1.0f;
+    const uint16_t change_count = AP_Param::get_change_count();
+    if (_filt_alpha_valid && _filt_alpha_dt == _dt && _filt_alpha_change_count == change_count) {
+        return _filt_alpha;
     }
+    _filt_alpha_valid = true;
+    _filt_alpha_dt = _dt;
+    _filt_alpha_change_count = change_count;
 
-    // calculate alpha
-    float rc = 1/(M_2PI*_filt_hz);
-    return _dt / (_dt + rc);
+    if (is_zero(_filt_hz)) {
+        _filt_alpha = 1.0f;
+    } else {
+        // calculate alpha
+        float rc = 1/(M_2PI*_filt_hz);
+        _filt_alpha = _dt / (_dt + rc);
+    }
+    return _filt_alpha;
 }
@@ -5,6 +5,7 @@
 
 #include <AP_Common/AP_Common.h>
 #include <AP_Param/AP_Param.h>
+#include <AP_Math/AP_Math.h>
 #include <stdlib.h>
 #include <cmath>
 #include <AP_Logger/AP_Logger.h>
@@ -41,6 +42,14 @@ public:
     float       get_d();
     float       get_ff(float requested_rate);
     
+    // update_rate_3axis - run the roll, pitch and yaw rate PIDs together
+    //  for each axis this is set_dt(), set_input_filter_d() (or
+    //  set_input_filter_all() if filter_all is set) on the rate error,
+    //  set_desired_rate() and get_p() + get_i() + get_d() + get_ff(),
+    //  except that while limited is set the integrator may only shrink
+    static Vector3f update_rate_3axis(AC_PID *const pid[3], const Vector3f &target, const Vector3f &actual, float dt,
+                                      const bool filter_all[3], const bool limited[3]);
+
     // reset_I - reset the integrator
     void        reset_I();
 
@@ -106,5 +115,12 @@ protected:
     float           _input;                 // last input for derivative
     float           _derivative;            // last derivative for low-pass filter
 
+    // input filter alpha, recalculated by get_filt_alpha() when _dt,
+    // the filter parameter or any other parameter may have changed
+    mutable float       _filt_alpha;
+    mutable float       _filt_alpha_dt;
+    mutable uint16_t    _filt_alpha_change_count;
+    mutable bool        _filt_alpha_valid;
+
     AP_Logger::PID_Info        _pid_info;
 };
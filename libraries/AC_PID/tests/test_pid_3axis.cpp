@@ -0,0 +1,118 @@
+#include <AP_gtest.h>
+
+#include <AC_PID/AC_PID.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  update_rate_3axis() must give the same outputs, state and logging
+  as running each axis on its own the way the attitude controller
+  did before the axes were fused
+ */
+
+static float run_axis(AC_PID &pid, float target, float actual, float dt, bool filter_all, bool limited)
+{
+    const float error = target - actual;
+    pid.set_dt(dt);
+    if (filter_all) {
+        pid.set_input_filter_all(error);
+    } else {
+        pid.set_input_filter_d(error);
+    }
+    pid.set_desired_rate(target);
+    float integrator = pid.get_integrator();
+    if (!limited || ((is_positive(integrator) && is_negative(error)) || (is_negative(integrator) && is_positive(error)))) {
+        integrator = pid.get_i();
+    }
+    return pid.get_p() + integrator + pid.get_d() + pid.get_ff(target);
+}
+
+static void check_same(const AC_PID &a, const AC_PID &b)
+{
+    EXPECT_FLOAT_EQ(a.get_integrator(), b.get_integrator());
+    const AP_Logger::PID_Info &ia = a.get_pid_info();
+    const AP_Logger::PID_Info &ib = b.get_pid_info();
+    EXPECT_FLOAT_EQ(ia.desired, ib.desired);
+    EXPECT_FLOAT_EQ(ia.P, ib.P);
+    EXPECT_FLOAT_EQ(ia.I, ib.I);
+    EXPECT_FLOAT_EQ(ia.D, ib.D);
+    EXPECT_FLOAT_EQ(ia.FF, ib.FF);
+}
+
+static void compare(float ki, bool limit_after)
+{
+    const float dt = 1.0f/400;
+    AC_PID ref[3] {
+        { 0.135f, ki, 0.0036f, 0.5f, 20, dt },
+        { 0.135f, ki, 0.0036f, 0.5f, 20, dt, 0.01f },
+        { 0.18f, ki*0.1f, 0, 0.5f, 2.5f, dt },
+    };
+    AC_PID fused[3] {
+        { 0.135f, ki, 0.0036f, 0.5f, 20, dt },
+        { 0.135f, ki, 0.0036f, 0.5f, 20, dt, 0.01f },
+        { 0.18f, ki*0.1f, 0, 0.5f, 2.5f, dt },
+    };
+    AC_PID *const pids[3] { &fused[0], &fused[1], &fused[2] };
+    const bool filter_all[3] { false, false, true };
+
+    uint32_t seed = 1;
+    for (uint16_t n=0; n<2000; n++) {
+        bool limited[3] { false, false, false };
+        if (limit_after && n > 1000) {
+            limited[0] = limited[1] = (n & 1);
+            limited[2] = (n & 2);
+        }
+        Vector3f target, actual;
+        for (uint8_t i=0; i<3; i++) {
+            seed = seed * 1664525 + 1013904223;
+            target[i] = ((seed >> 16) / 65536.0f - 0.5f) * 4;
+            actual[i] = sinf(n * 0.01f * (i+1));
+        }
+        if (n == 500) {
+            // the filter reset has to be taken on the next sample
+            ref[0].reset_filter();
+            fused[0].reset_filter();
+        }
+        const Vector3f out = AC_PID::update_rate_3axis(pids, target, actual, dt, filter_all, limited);
+        for (uint8_t i=0; i<3; i++) {
+            EXPECT_FLOAT_EQ(run_axis(ref[i], target[i], actual[i], dt, filter_all[i], limited[i]), out[i]);
+            check_same(ref[i], fused[i]);
+        }
+    }
+}
+
+TEST(AC_PID3Axis, SameAsSeparate)
+{
+    compare(0.135f, false);
+}
+
+TEST(AC_PID3Axis, SameAsSeparateLimited)
+{
+    compare(0.135f, true);
+}
+
+TEST(AC_PID3Axis, SameAsSeparateNoI)
+{
+    compare(0, true);
+}
+
+TEST(AC_PID3Axis, NonFiniteInput)
+{
+    const float dt = 1.0f/400;
+    AC_PID pid[3] {
+        { 0.135f, 0.135f, 0.0036f, 0.5f, 20, dt },
+        { 0.135f, 0.135f, 0.0036f, 0.5f, 20, dt },
+        { 0.18f, 0.018f, 0, 0.5f, 2.5f, dt },
+    };
+    AC_PID *const pids[3] { &pid[0], &pid[1], &pid[2] };
+    const bool filter_all[3] { false, false, true };
+    const bool limited[3] { false, false, false };
+    AC_PID::update_rate_3axis(pids, Vector3f(0.1f, 0.1f, 0.1f), Vector3f(), dt, filter_all, limited);
+    const float integrator = pid[0].get_integrator();
+    AC_PID::update_rate_3axis(pids, Vector3f(NAN, 0.1f, 0.1f), Vector3f(), dt, filter_all, limited);
+    // the bad sample is ignored, the last good input is used again
+    EXPECT_FLOAT_EQ(2*integrator, pid[0].get_integrator());
+    EXPECT_TRUE(isfinite(pid[0].get_pid_info().D));
+}
+
+AP_GTEST_MAIN()
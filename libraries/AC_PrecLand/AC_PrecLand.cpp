@@ -134,8 +134,10 @@ void AC_PrecLand::init(uint16_t update_rate_hz)
     // constrain lag parameter to be within bounds
     _lag = constrain_float(_lag, 0.02f, 0.25f);
 
-    // calculate inertial buffer size from lag and minimum of main loop rate and update_rate_hz argument
-    const uint16_t inertial_buffer_size = MAX((uint16_t)roundf(_lag * MIN(update_rate_hz, AP::scheduler().get_loop_rate_hz())), 1);
+    // calculate inertial buffer size from lag at the rate inertial data is recorded, with room
+    // for the frames recorded between calls to update, plus one more call in case it is late
+    const uint16_t inertial_rate_hz = MIN(AP::scheduler().get_loop_rate_hz(), PRECLAND_INERTIAL_RATE_MAX);
+    const uint16_t inertial_buffer_size = (uint16_t)roundf(_lag * inertial_rate_hz) + 2 * MAX(inertial_rate_hz / MAX(update_rate_hz, 1), 1) + 1;
 
     // instantiate ring buffer to hold inertial history, return on failure so no backends are created
     _inertial_history = new ObjectArray<inertial_data_frame_s>(inertial_buffer_size);
@@ -143,6 +145,12 @@ void AC_PrecLand::init(uint16_t update_rate_hz)
         return;
     }
 
+    // line of sight measurements are held for the lag, so the buffer is sized for the fastest sensor
+    _los_meas_buffer_ok = _los_meas_buffer.init((uint8_t)(_lag * PRECLAND_LOS_MEAS_RATE_MAX) + 2);
+    if (!_los_meas_buffer_ok) {
+        return;
+    }
+
     // instantiate backend based on type parameter
     switch ((enum PrecLandType)(_type.get())) {
         // no type defined
@@ -173,18 +181,34 @@ void AC_PrecLand::init(uint16_t update_rate_hz)
     }
 }
 
-// update - give chance to driver to get updates from sensor
-void AC_PrecLand::update(float rangefinder_alt_cm, bool rangefinder_alt_valid)
+// update_inertial - record the delta velocity of the latest IMU sample, so that the target
+// estimator predicts over every sample however often update is run
+void AC_PrecLand::update_inertial()
 {
     // exit immediately if not enabled
     if (_backend == nullptr || _inertial_history == nullptr) {
         return;
     }
 
-    // append current velocity and attitude correction into history buffer
-    struct inertial_data_frame_s inertial_data_newest;
     const AP_AHRS_NavEKF &_ahrs = AP::ahrs_navekf();
-    _ahrs.getCorrectedDeltaVelocityNED(inertial_data_newest.correctedVehicleDeltaVelocityNED, inertial_data_newest.dt);
+    Vector3f delta_vel;
+    float delta_vel_dt;
+    _ahrs.getCorrectedDeltaVelocityNED(delta_vel, delta_vel_dt);
+    _inertial_accum_del_vel += delta_vel;
+    _inertial_accum_dt += delta_vel_dt;
+
+    // IMUs faster than PRECLAND_INERTIAL_RATE_MAX are accumulated over several samples,
+    // which bounds the size of the history and the time taken by the estimator
+    if (_inertial_accum_dt < 0.9f / PRECLAND_INERTIAL_RATE_MAX) {
+        return;
+    }
+
+    // append accumulated velocity and current attitude correction into history buffer
+    struct inertial_data_frame_s inertial_data_newest;
+    inertial_data_newest.correctedVehicleDeltaVelocityNED = _inertial_accum_del_vel;
+    inertial_data_newest.dt = _inertial_accum_dt;
+    _inertial_accum_del_vel.zero();
+    _inertial_accum_dt = 0.0f;
     inertial_data_newest.Tbn = _ahrs.get_rotation_body_to_ned();
     Vector3f curr_vel;
     nav_filter_status status;
@@ -198,11 +222,26 @@ void AC_PrecLand::update(float rangefinder_alt_cm, bool rangefinder_alt_valid)
 
     inertial_data_newest.time_usec = AP_HAL::micros64();
     _inertial_history->push_force(inertial_data_newest);
+}
+
+// update - give chance to driver to get updates from sensor
+void AC_PrecLand::update(float rangefinder_alt_cm, bool rangefinder_alt_valid)
+{
+    // exit immediately if not enabled
+    if (_backend == nullptr || _inertial_history == nullptr || !_los_meas_buffer_ok) {
+        return;
+    }
 
     // update estimator of target position
-    if (_backend != nullptr && _enabled) {
+    if (_enabled) {
         _backend->update();
-        run_estimator(rangefinder_alt_cm*0.01f, rangefinder_alt_valid);
+        buffer_los_meas(rangefinder_alt_cm*0.01f, rangefinder_alt_valid);
+        const uint16_t delayed_idx = run_estimator();
+
+        // Output prediction
+        if (target_acquired() && delayed_idx < _inertial_history->available()) {
+            run_output_prediction(delayed_idx);
+        }
     }
 }
 
@@ -263,94 +302,138 @@ void AC_PrecLand::handle_msg(mavlink_message_t* msg)
 // Private methods
 //
 
-void AC_PrecLand::run_estimator(float rangefinder_alt_m, bool rangefinder_alt_valid)
+/*
+  run the estimator over each frame of inertial data that has reached
+  the fusion time horizon, PLND_LAG behind the newest frame, since the
+  last call. Line of sight measurements are fused on the frame at
+  which they were taken, so the measurement and the vehicle attitude
+  and velocity it is combined with are from the same time. Returns the
+  index of the frame at the horizon, or the size of the history if no
+  frame has reached it yet
+ */
+uint16_t AC_PrecLand::run_estimator()
 {
-    const struct inertial_data_frame_s *inertial_data_delayed = (*_inertial_history)[0];
+    const uint16_t available = _inertial_history->available();
+    if (available == 0) {
+        return available;
+    }
 
-    switch (_estimator_type) {
-        case ESTIMATOR_TYPE_RAW_SENSOR: {
-            // Return if there's any invalid velocity data
-            for (uint8_t i=0; i<_inertial_history->available(); i++) {
-                const struct inertial_data_frame_s *inertial_data = (*_inertial_history)[i];
-                if (!inertial_data->inertialNavVelocityValid) {
-                    _target_acquired = false;
-                    return;
-                }
+    // raw sensor estimates use the velocity of every frame they are predicted or output over
+    if (_estimator_type == ESTIMATOR_TYPE_RAW_SENSOR) {
+        // Return if there's any invalid velocity data
+        for (uint16_t i=0; i<available; i++) {
+            const struct inertial_data_frame_s *inertial_data = (*_inertial_history)[i];
+            if (!inertial_data->inertialNavVelocityValid) {
+                _target_acquired = false;
+                return available;
             }
+        }
+    }
 
-            // Predict
-            if (target_acquired()) {
-                _target_pos_rel_est_NE.x -= inertial_data_delayed->inertialNavVelocity.x * inertial_data_delayed->dt;
-                _target_pos_rel_est_NE.y -= inertial_data_delayed->inertialNavVelocity.y * inertial_data_delayed->dt;
-                _target_vel_rel_est_NE.x = -inertial_data_delayed->inertialNavVelocity.x;
-                _target_vel_rel_est_NE.y = -inertial_data_delayed->inertialNavVelocity.y;
-            }
+    const uint64_t lag_usec = (uint64_t)(_lag * 1.0e6f);
+    const uint64_t newest_usec = (*_inertial_history)[available-1]->time_usec;
+    if (newest_usec < lag_usec) {
+        return available;
+    }
+    const uint64_t horizon_usec = newest_usec - lag_usec;
 
-            // Update if a new Line-Of-Sight measurement is available
-            if (construct_pos_meas_using_rangefinder(rangefinder_alt_m, rangefinder_alt_valid)) {
-                _target_pos_rel_est_NE.x = _target_pos_rel_meas_NED.x;
-                _target_pos_rel_est_NE.y = _target_pos_rel_meas_NED.y;
-                _target_vel_rel_est_NE.x = -inertial_data_delayed->inertialNavVelocity.x;
-                _target_vel_rel_est_NE.y = -inertial_data_delayed->inertialNavVelocity.y;
+    uint16_t delayed_idx = available;
+    for (uint16_t i=0; i<available; i++) {
+        const struct inertial_data_frame_s *inertial_data = (*_inertial_history)[i];
+        if (inertial_data->time_usec > horizon_usec) {
+            break;
+        }
+        delayed_idx = i;
+        if (inertial_data->time_usec <= _last_predict_time_usec) {
+            // already predicted over by an earlier call
+            continue;
+        }
+        _last_predict_time_usec = inertial_data->time_usec;
 
-                _last_update_ms = AP_HAL::millis();
-                _target_acquired = true;
-            }
+        // Predict
+        if (target_acquired()) {
+            predict(*inertial_data);
+        }
 
-            // Output prediction
-            if (target_acquired()) {
-                run_output_prediction();
-            }
-            break;
+        // Update with each Line-Of-Sight measurement taken by the time of this frame
+        struct los_meas_elements los_meas;
+        while (_los_meas_buffer.recall_oldest(los_meas, (uint32_t)(inertial_data->time_usec / 1000U))) {
+            fuse_los_meas(los_meas, *inertial_data);
         }
+    }
+
+    if (delayed_idx < available && target_acquired() && _estimator_type == ESTIMATOR_TYPE_KALMAN_FILTER) {
+        _target_pos_rel_est_NE.x = _ekf_x.getPos();
+        _target_pos_rel_est_NE.y = _ekf_y.getPos();
+        _target_vel_rel_est_NE.x = _ekf_x.getVel();
+        _target_vel_rel_est_NE.y = _ekf_y.getVel();
+    }
+
+    return delayed_idx;
+}
+
+void AC_PrecLand::predict(const struct inertial_data_frame_s &inertial_data)
+{
+    switch (_estimator_type) {
+        case ESTIMATOR_TYPE_RAW_SENSOR:
+            _target_pos_rel_est_NE.x -= inertial_data.inertialNavVelocity.x * inertial_data.dt;
+            _target_pos_rel_est_NE.y -= inertial_data.inertialNavVelocity.y * inertial_data.dt;
+            _target_vel_rel_est_NE.x = -inertial_data.inertialNavVelocity.x;
+            _target_vel_rel_est_NE.y = -inertial_data.inertialNavVelocity.y;
+            break;
         case ESTIMATOR_TYPE_KALMAN_FILTER: {
-            // Predict
-            if (target_acquired()) {
-                const float& dt = inertial_data_delayed->dt;
-                const Vector3f& vehicleDelVel = inertial_data_delayed->correctedVehicleDeltaVelocityNED;
+            const float& dt = inertial_data.dt;
+            const Vector3f& vehicleDelVel = inertial_data.correctedVehicleDeltaVelocityNED;
 
-                _ekf_x.predict(dt, -vehicleDelVel.x, _accel_noise*dt);
-                _ekf_y.predict(dt, -vehicleDelVel.y, _accel_noise*dt);
-            }
+            _ekf_x.predict(dt, -vehicleDelVel.x, _accel_noise*dt);
+            _ekf_y.predict(dt, -vehicleDelVel.y, _accel_noise*dt);
+            break;
+        }
+    }
+}
 
-            // Update if a new Line-Of-Sight measurement is available
-            if (construct_pos_meas_using_rangefinder(rangefinder_alt_m, rangefinder_alt_valid)) {
-                float xy_pos_var = sq(_target_pos_rel_meas_NED.z*(0.01f + 0.01f*AP::ahrs().get_gyro().length()) + 0.02f);
-                if (!target_acquired()) {
-                    // reset filter state
-                    if (inertial_data_delayed->inertialNavVelocityValid) {
-                        _ekf_x.init(_target_pos_rel_meas_NED.x, xy_pos_var, -inertial_data_delayed->inertialNavVelocity.x, sq(2.0f));
-                        _ekf_y.init(_target_pos_rel_meas_NED.y, xy_pos_var, -inertial_data_delayed->inertialNavVelocity.y, sq(2.0f));
-                    } else {
-                        _ekf_x.init(_target_pos_rel_meas_NED.x, xy_pos_var, 0.0f, sq(10.0f));
-                        _ekf_y.init(_target_pos_rel_meas_NED.y, xy_pos_var, 0.0f, sq(10.0f));
-                    }
+void AC_PrecLand::fuse_los_meas(const struct los_meas_elements &los_meas, const struct inertial_data_frame_s &inertial_data)
+{
+    if (!construct_pos_meas_using_rangefinder(los_meas, inertial_data)) {
+        return;
+    }
+
+    switch (_estimator_type) {
+        case ESTIMATOR_TYPE_RAW_SENSOR:
+            _target_pos_rel_est_NE.x = _target_pos_rel_meas_NED.x;
+            _target_pos_rel_est_NE.y = _target_pos_rel_meas_NED.y;
+            _target_vel_rel_est_NE.x = -inertial_data.inertialNavVelocity.x;
+            _target_vel_rel_est_NE.y = -inertial_data.inertialNavVelocity.y;
+
+            _last_update_ms = AP_HAL::millis();
+            _target_acquired = true;
+            break;
+        case ESTIMATOR_TYPE_KALMAN_FILTER: {
+            float xy_pos_var = sq(_target_pos_rel_meas_NED.z*(0.01f + 0.01f*AP::ahrs().get_gyro().length()) + 0.02f);
+            if (!target_acquired()) {
+                // reset filter state
+                if (inertial_data.inertialNavVelocityValid) {
+                    _ekf_x.init(_target_pos_rel_meas_NED.x, xy_pos_var, -inertial_data.inertialNavVelocity.x, sq(2.0f));
+                    _ekf_y.init(_target_pos_rel_meas_NED.y, xy_pos_var, -inertial_data.inertialNavVelocity.y, sq(2.0f));
+                } else {
+                    _ekf_x.init(_target_pos_rel_meas_NED.x, xy_pos_var, 0.0f, sq(10.0f));
+                    _ekf_y.init(_target_pos_rel_meas_NED.y, xy_pos_var, 0.0f, sq(10.0f));
+                }
+                _last_update_ms = AP_HAL::millis();
+                _target_acquired = true;
+            } else {
+                float NIS_x = _ekf_x.getPosNIS(_target_pos_rel_meas_NED.x, xy_pos_var);
+                float NIS_y = _ekf_y.getPosNIS(_target_pos_rel_meas_NED.y, xy_pos_var);
+                if (MAX(NIS_x, NIS_y) < 3.0f || _outlier_reject_count >= 3) {
+                    _outlier_reject_count = 0;
+                    _ekf_x.fusePos(_target_pos_rel_meas_NED.x, xy_pos_var);
+                    _ekf_y.fusePos(_target_pos_rel_meas_NED.y, xy_pos_var);
                     _last_update_ms = AP_HAL::millis();
                     _target_acquired = true;
                 } else {
-                    float NIS_x = _ekf_x.getPosNIS(_target_pos_rel_meas_NED.x, xy_pos_var);
-                    float NIS_y = _ekf_y.getPosNIS(_target_pos_rel_meas_NED.y, xy_pos_var);
-                    if (MAX(NIS_x, NIS_y) < 3.0f || _outlier_reject_count >= 3) {
-                        _outlier_reject_count = 0;
-                        _ekf_x.fusePos(_target_pos_rel_meas_NED.x, xy_pos_var);
-                        _ekf_y.fusePos(_target_pos_rel_meas_NED.y, xy_pos_var);
-                        _last_update_ms = AP_HAL::millis();
-                        _target_acquired = true;
-                    } else {
-                        _outlier_reject_count++;
-                    }
+                    _outlier_reject_count++;
                 }
             }
-
-            // Output prediction
-            if (target_acquired()) {
-                _target_pos_rel_est_NE.x = _ekf_x.getPos();
-                _target_pos_rel_est_NE.y = _ekf_y.getPos();
-                _target_vel_rel_est_NE.x = _ekf_x.getVel();
-                _target_vel_rel_est_NE.y = _ekf_y.getVel();
-
-                run_output_prediction();
-            }
             break;
         }
     }
@@ -378,44 +461,53 @@ bool AC_PrecLand::retrieve_los_meas(Vector3f& target_vec_unit_body)
     }
 }
 
-bool AC_PrecLand::construct_pos_meas_using_rangefinder(float rangefinder_alt_m, bool rangefinder_alt_valid)
+// measurements are taken PLND_LAG before the backend receives them
+void AC_PrecLand::buffer_los_meas(float rangefinder_alt_m, bool rangefinder_alt_valid)
 {
-    Vector3f target_vec_unit_body;
-    if (retrieve_los_meas(target_vec_unit_body)) {
-        const struct inertial_data_frame_s *inertial_data_delayed = (*_inertial_history)[0];
-
-        Vector3f target_vec_unit_ned = inertial_data_delayed->Tbn * target_vec_unit_body;
-        bool target_vec_valid = target_vec_unit_ned.z > 0.0f;
-        bool alt_valid = (rangefinder_alt_valid && rangefinder_alt_m > 0.0f) || (_backend->distance_to_target() > 0.0f);
-        if (target_vec_valid && alt_valid) {
-            float dist, alt;
-            if (_backend->distance_to_target() > 0.0f) {
-                dist = _backend->distance_to_target();
-                alt = dist * target_vec_unit_ned.z;
-            } else {
-                alt = MAX(rangefinder_alt_m, 0.0f);
-                dist = alt / target_vec_unit_ned.z;
-            }
-
-            // Compute camera position relative to IMU
-            Vector3f accel_body_offset = AP::ins().get_imu_pos_offset(AP::ahrs().get_primary_accel_index());
-            Vector3f cam_pos_ned = inertial_data_delayed->Tbn * (_cam_offset.get() - accel_body_offset);
+    struct los_meas_elements los_meas;
+    if (!retrieve_los_meas(los_meas.target_vec_unit_body)) {
+        return;
+    }
+    los_meas.distance_to_target = _backend->distance_to_target();
+    los_meas.rangefinder_alt_m = rangefinder_alt_m;
+    los_meas.rangefinder_alt_valid = rangefinder_alt_valid;
+    los_meas.time_ms = _last_backend_los_meas_ms - (uint32_t)(_lag * 1000.0f);
+    _los_meas_buffer.push(los_meas);
+}
 
-            // Compute target position relative to IMU
-            _target_pos_rel_meas_NED = Vector3f(target_vec_unit_ned.x*dist, target_vec_unit_ned.y*dist, alt) + cam_pos_ned;
-            return true;
+bool AC_PrecLand::construct_pos_meas_using_rangefinder(const struct los_meas_elements &los_meas, const struct inertial_data_frame_s &inertial_data)
+{
+    Vector3f target_vec_unit_ned = inertial_data.Tbn * los_meas.target_vec_unit_body;
+    bool target_vec_valid = target_vec_unit_ned.z > 0.0f;
+    bool alt_valid = (los_meas.rangefinder_alt_valid && los_meas.rangefinder_alt_m > 0.0f) || (los_meas.distance_to_target > 0.0f);
+    if (target_vec_valid && alt_valid) {
+        float dist, alt;
+        if (los_meas.distance_to_target > 0.0f) {
+            dist = los_meas.distance_to_target;
+            alt = dist * target_vec_unit_ned.z;
+        } else {
+            alt = MAX(los_meas.rangefinder_alt_m, 0.0f);
+            dist = alt / target_vec_unit_ned.z;
         }
+
+        // Compute camera position relative to IMU
+        Vector3f accel_body_offset = AP::ins().get_imu_pos_offset(AP::ahrs().get_primary_accel_index());
+        Vector3f cam_pos_ned = inertial_data.Tbn * (_cam_offset.get() - accel_body_offset);
+
+        // Compute target position relative to IMU
+        _target_pos_rel_meas_NED = Vector3f(target_vec_unit_ned.x*dist, target_vec_unit_ned.y*dist, alt) + cam_pos_ned;
+        return true;
     }
     return false;
 }
 
-void AC_PrecLand::run_output_prediction()
+void AC_PrecLand::run_output_prediction(uint16_t delayed_idx)
 {
     _target_pos_rel_out_NE = _target_pos_rel_est_NE;
     _target_vel_rel_out_NE = _target_vel_rel_est_NE;
 
     // Predict forward from delayed time horizon
-    for (uint8_t i=1; i<_inertial_history->available(); i++) {
+    for (uint16_t i=delayed_idx+1; i<_inertial_history->available(); i++) {
         const struct inertial_data_frame_s *inertial_data = (*_inertial_history)[i];
         _target_vel_rel_out_NE.x -= inertial_data->correctedVehicleDeltaVelocityNED.x;
         _target_vel_rel_out_NE.y -= inertial_data->correctedVehicleDeltaVelocityNED.y;
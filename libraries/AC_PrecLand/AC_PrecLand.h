@@ -5,6 +5,13 @@
 #include <stdint.h>
 #include "PosVelEKF.h"
 #include <AP_HAL/utility/RingBuffer.h>
+#include <AP_NavEKF3/AP_NavEKF3_Buffer.h>
+
+// highest rate inertial data is recorded at, faster IMUs are decimated to it
+#define PRECLAND_INERTIAL_RATE_MAX      400
+
+// highest line of sight measurement rate that can be delayed by PLND_LAG without measurements being lost
+#define PRECLAND_LOS_MEAS_RATE_MAX      50
 
 // declare backend classes
 class AC_PrecLand_Backend;
@@ -67,6 +74,9 @@ public:
     // returns ekf outlier count
     uint32_t ekf_outlier_count() const { return _outlier_reject_count; }
 
+    // record the vehicle's delta velocity and attitude for the target estimator, should be called after each IMU sample
+    void update_inertial();
+
     // give chance to driver to get updates from sensor, should be called at 400hz
     void update(float rangefinder_alt_cm, bool rangefinder_alt_valid);
 
@@ -100,18 +110,47 @@ private:
     // returns enabled parameter as an behaviour
     enum PrecLandBehaviour get_behaviour() const { return (enum PrecLandBehaviour)(_enabled.get()); }
 
-    // run target position estimator
-    void run_estimator(float rangefinder_alt_m, bool rangefinder_alt_valid);
+    // structure to hold a history of vehicle velocity
+    struct inertial_data_frame_s {
+        Matrix3f Tbn;                               // dcm rotation matrix to rotate body frame to north
+        Vector3f correctedVehicleDeltaVelocityNED;
+        Vector3f inertialNavVelocity;
+        bool inertialNavVelocityValid;
+        float dt;
+        uint64_t time_usec;
+    };
+
+    // structure to hold a line of sight measurement until the estimator reaches the time it was taken
+    struct los_meas_elements {
+        Vector3f target_vec_unit_body;              // unit vector towards the target in body frame, yaw aligned
+        float distance_to_target;                   // distance to target in meters, 0 if unknown
+        float rangefinder_alt_m;                    // rangefinder altitude when the measurement arrived
+        bool rangefinder_alt_valid;
+        uint32_t time_ms;                           // system time the measurement was taken
+    };
+
+    // buffer a new line of sight measurement from the backend at the time it was taken
+    void buffer_los_meas(float rangefinder_alt_m, bool rangefinder_alt_valid);
+
+    // run target position estimator up to the fusion time horizon, returns the index in the inertial history of the horizon
+    uint16_t run_estimator();
+
+    // predict the target's relative position forward over one frame of inertial data
+    void predict(const struct inertial_data_frame_s &inertial_data);
+
+    // fuse a line of sight measurement taken at the time of a frame of inertial data
+    void fuse_los_meas(const struct los_meas_elements &los_meas, const struct inertial_data_frame_s &inertial_data);
 
-    // If a new measurement was retrieved, sets _target_pos_rel_meas_NED and returns true
-    bool construct_pos_meas_using_rangefinder(float rangefinder_alt_m, bool rangefinder_alt_valid);
+    // sets _target_pos_rel_meas_NED from a line of sight measurement and returns true if it was valid
+    bool construct_pos_meas_using_rangefinder(const struct los_meas_elements &los_meas, const struct inertial_data_frame_s &inertial_data);
 
     // get vehicle body frame 3D vector from vehicle to target.  returns true on success, false on failure
     bool retrieve_los_meas(Vector3f& target_vec_unit_body);
 
     // calculate target's position and velocity relative to the vehicle (used as input to position controller)
+    // from the estimate at the fusion time horizon, at index delayed_idx of the inertial history
     // results are stored in_target_pos_rel_out_NE, _target_vel_rel_out_NE
-    void run_output_prediction();
+    void run_output_prediction(uint16_t delayed_idx);
 
     // parameters
     AP_Int8                     _enabled;           // enabled/disabled and behaviour
@@ -140,16 +179,15 @@ private:
     Vector2f                    _target_pos_rel_out_NE; // target's position relative to the camera, fed into position controller
     Vector2f                    _target_vel_rel_out_NE; // target's velocity relative to the CG, fed into position controller
 
-    // structure and buffer to hold a history of vehicle velocity
-    struct inertial_data_frame_s {
-        Matrix3f Tbn;                               // dcm rotation matrix to rotate body frame to north
-        Vector3f correctedVehicleDeltaVelocityNED;
-        Vector3f inertialNavVelocity;
-        bool inertialNavVelocityValid;
-        float dt;
-        uint64_t time_usec;
-    };
+    // buffer to hold a history of vehicle velocity, at up to PRECLAND_INERTIAL_RATE_MAX
     ObjectArray<inertial_data_frame_s> *_inertial_history;
+    Vector3f                    _inertial_accum_del_vel;    // delta velocity of IMU samples not yet in the history
+    float                       _inertial_accum_dt;         // time of IMU samples not yet in the history
+    uint64_t                    _last_predict_time_usec;    // time of the last inertial frame the estimator predicted over
+
+    // line of sight measurements waiting for the fusion time horizon
+    obs_ring_buffer_t<los_meas_elements> _los_meas_buffer;
+    bool                        _los_meas_buffer_ok;
 
     // backend state
     struct precland_state {
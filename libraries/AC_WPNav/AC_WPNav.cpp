@@ -836,6 +836,9 @@ void AC_WPNav::update_spline_solution(const Vector3f& origin, const Vector3f& de
     _hermite_spline_solution[1] = origin_vel;
     _hermite_spline_solution[2] = -origin*3.0f -origin_vel*2.0f + dest*3.0f - dest_vel;
     _hermite_spline_solution[3] = origin*2.0f + origin_vel -dest*2.0f + dest_vel;
+
+    // precompute the length along the segment so it is not recalculated each loop
+    update_spline_arc_length();
  }
 
 /// advance_spline_target_along_track - move target location along track from origin to destination
@@ -893,7 +896,7 @@ bool AC_WPNav::advance_spline_target_along_track(float dt)
         }
 
         // update velocity
-        float spline_dist_to_wp = (_destination - target_pos).length();
+        float spline_dist_to_wp = get_spline_dist_to_wp(_spline_time);
         float vel_limit = _pos_control.get_max_speed_xy();
         if (!is_zero(dt)) {
             vel_limit = MIN(vel_limit, track_leash_slack/dt);
@@ -963,6 +966,37 @@ void AC_WPNav::calc_spline_pos_vel(float spline_time, Vector3f& position, Vector
                _hermite_spline_solution[3] * 3.0f * spline_time_sqrd;
 }
 
+/// update_spline_arc_length - precompute the length along the spline at evenly spaced spline times
+/// 	relies on update_spline_solution being called first
+void AC_WPNav::update_spline_arc_length()
+{
+    Vector3f prev_pos = _hermite_spline_solution[0];
+    _spline_arc_length[0] = 0.0f;
+    for (uint8_t i = 1; i <= WPNAV_SPLINE_ARC_LEN_SAMPLES; i++) {
+        Vector3f pos, vel;
+        calc_spline_pos_vel(i / (float)WPNAV_SPLINE_ARC_LEN_SAMPLES, pos, vel);
+        _spline_arc_length[i] = _spline_arc_length[i-1] + (pos - prev_pos).length();
+        prev_pos = pos;
+    }
+}
+
+/// get_spline_dist_to_wp - returns the distance along the spline from the given spline time to the destination (in cm)
+///     interpolates between the lengths precomputed by update_spline_arc_length
+float AC_WPNav::get_spline_dist_to_wp(float spline_time) const
+{
+    const float total_length = _spline_arc_length[WPNAV_SPLINE_ARC_LEN_SAMPLES];
+    if (spline_time <= 0.0f) {
+        return total_length;
+    }
+    if (spline_time >= 1.0f) {
+        return 0.0f;
+    }
+    const float sample = spline_time * WPNAV_SPLINE_ARC_LEN_SAMPLES;
+    const uint8_t i = MIN((uint8_t)sample, WPNAV_SPLINE_ARC_LEN_SAMPLES-1);
+    const float length = _spline_arc_length[i] + (_spline_arc_length[i+1] - _spline_arc_length[i]) * (sample - i);
+    return total_length - length;
+}
+
 // get terrain's altitude (in cm above the ekf origin) at the current position (+ve means terrain below vehicle is above ekf origin's altitude)
 bool AC_WPNav::get_terrain_offset(float& offset_cm)
 {
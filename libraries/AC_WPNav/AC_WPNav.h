@@ -34,6 +34,8 @@
 
 #define WPNAV_RANGEFINDER_FILT_Z         0.25f      // range finder distance filtered at 0.25hz
 
+#define WPNAV_SPLINE_ARC_LEN_SAMPLES        16      // number of chords used to precompute the length along each spline segment
+
 class AC_WPNav
 {
 public:
@@ -263,6 +265,13 @@ protected:
     /// 	relies on update_spline_solution being called since the previous
     void calc_spline_pos_vel(float spline_time, Vector3f& position, Vector3f& velocity);
 
+    /// update_spline_arc_length - precompute the length along the spline at evenly spaced spline times
+    /// 	relies on update_spline_solution being called first
+    void update_spline_arc_length();
+
+    /// get_spline_dist_to_wp - returns the distance along the spline from the given spline time to the destination (in cm)
+    float get_spline_dist_to_wp(float spline_time) const;
+
     // get terrain's altitude (in cm above the ekf origin) at the current position (+ve means terrain below vehicle is above ekf origin's altitude)
     bool get_terrain_offset(float& offset_cm);
 
@@ -310,6 +319,7 @@ protected:
     Vector3f    _spline_origin_vel;     // the target velocity vector at the origin of the spline segment
     Vector3f    _spline_destination_vel;// the target velocity vector at the destination point of the spline segment
     Vector3f    _hermite_spline_solution[4]; // array describing spline path between origin and destination
+    float       _spline_arc_length[WPNAV_SPLINE_ARC_LEN_SAMPLES+1]; // length along the spline from the origin at spline times 0, 1/WPNAV_SPLINE_ARC_LEN_SAMPLES .. 1
     float       _spline_vel_scaler;	    //
     float       _yaw;                   // heading according to yaw
 
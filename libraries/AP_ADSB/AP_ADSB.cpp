@@ -32,7 +32,11 @@
 
 #define VEHICLE_TIMEOUT_MS              5000   // if no updates in this time, drop it from the list
 #define ADSB_VEHICLE_LIST_SIZE_DEFAULT  25
+#if HAL_MINIMIZE_FEATURES
 #define ADSB_VEHICLE_LIST_SIZE_MAX      100
+#else
+#define ADSB_VEHICLE_LIST_SIZE_MAX      400
+#endif
 #define ADSB_CHAN_TIMEOUT_MS            15000
 #define ADSB_SQUAWK_OCTAL_DEFAULT       1200
 
@@ -60,8 +64,8 @@ const AP_Param::GroupInfo AP_ADSB::var_info[] = {
 
     // @Param: LIST_MAX
     // @DisplayName: ADSB vehicle list size
-    // @Description: ADSB list size of nearest vehicles. Longer lists take longer to refresh with lower SRx_ADSB values.
-    // @Range: 1 100
+    // @Description: ADSB list size of nearest vehicles. Longer lists take longer to refresh with lower SRx_ADSB values. Boards with little RAM are limited to 100.
+    // @Range: 1 400
     // @User: Advanced
     AP_GROUPINFO("LIST_MAX",   2, AP_ADSB, in_state.list_size_param, ADSB_VEHICLE_LIST_SIZE_DEFAULT),
 
@@ -169,18 +173,31 @@ void AP_ADSB::init(void)
             in_state.list_size_param.save();
         }
         in_state.list_size = in_state.list_size_param;
+        uint16_t hash_size = 1;
+        while (hash_size < 2 * in_state.list_size) {
+            hash_size <<= 1;
+        }
+        in_state.hash_mask = hash_size - 1;
         in_state.vehicle_list = new adsb_vehicle_t[in_state.list_size];
-
-        if (in_state.vehicle_list == nullptr) {
+        in_state.hash_table = new uint16_t[hash_size];
+        in_state.heap = new uint16_t[in_state.list_size];
+        in_state.heap_pos = new uint16_t[in_state.list_size];
+        in_state.distance = new float[in_state.list_size];
+
+        if (in_state.vehicle_list == nullptr ||
+            in_state.hash_table == nullptr ||
+            in_state.heap == nullptr ||
+            in_state.heap_pos == nullptr ||
+            in_state.distance == nullptr) {
             // dynamic RAM allocation of _vehicle_list[] failed, disable gracefully
             hal.console->printf("Unable to initialize ADS-B vehicle list\n");
+            deinit();
             _enabled.set_and_notify(0);
+            return;
         }
+        memset(in_state.hash_table, 0, hash_size * sizeof(in_state.hash_table[0]));
     }
 
-    furthest_vehicle_distance = 0;
-    furthest_vehicle_index = 0;
-
     // out_state
     set_callsign("PING1234", false);
 }
@@ -191,10 +208,16 @@ void AP_ADSB::init(void)
 void AP_ADSB::deinit(void)
 {
     in_state.vehicle_count = 0;
-    if (in_state.vehicle_list != nullptr) {
-        delete [] in_state.vehicle_list;
-        in_state.vehicle_list = nullptr;
-    }
+    delete [] in_state.vehicle_list;
+    in_state.vehicle_list = nullptr;
+    delete [] in_state.hash_table;
+    in_state.hash_table = nullptr;
+    delete [] in_state.heap;
+    in_state.heap = nullptr;
+    delete [] in_state.heap_pos;
+    in_state.heap_pos = nullptr;
+    delete [] in_state.distance;
+    in_state.distance = nullptr;
 }
 
 /*
@@ -236,6 +259,8 @@ void AP_ADSB::update(void)
         }
     }
 
+    write_log_perf(now);
+
     if (_my_loc.is_zero()) {
         // if we don't have a GPS lock then there's nothing else to do
         return;
@@ -299,30 +324,6 @@ void AP_ADSB::update(void)
     } // chan_last_ms
 }
 
-/*
- * determine index and distance of furthest vehicle. This is
- * used to bump it off when a new closer aircraft is detected
- */
-void AP_ADSB::determine_furthest_aircraft(void)
-{
-    float max_distance = 0;
-    uint16_t max_distance_index = 0;
-
-    for (uint16_t index = 0; index < in_state.vehicle_count; index++) {
-        if (is_special_vehicle(in_state.vehicle_list[index].info.ICAO_address)) {
-            continue;
-        }
-        const float distance = _my_loc.get_distance(get_location(in_state.vehicle_list[index]));
-        if (max_distance < distance || index == 0) {
-            max_distance = distance;
-            max_distance_index = index;
-        }
-    } // for index
-
-    furthest_vehicle_index = max_distance_index;
-    furthest_vehicle_distance = max_distance;
-}
-
 /*
  * Convert/Extract a Location from a vehicle
  */
@@ -348,17 +349,28 @@ void AP_ADSB::delete_vehicle(const uint16_t index)
         return;
     }
 
-    // if the vehicle is the furthest, invalidate it. It has been bumped
-    if (index == furthest_vehicle_index && furthest_vehicle_distance > 0) {
-        furthest_vehicle_distance = 0;
-        furthest_vehicle_index = 0;
+    // take it out of the hash table, and move it to the end of the heap
+    const uint16_t last = in_state.vehicle_count-1;
+    const uint16_t pos = in_state.heap_pos[index];
+    hash_remove(in_state.vehicle_list[index].info.ICAO_address);
+    if (pos != last) {
+        heap_swap(pos, last);
     }
-    if (index != (in_state.vehicle_count-1)) {
-        in_state.vehicle_list[index] = in_state.vehicle_list[in_state.vehicle_count-1];
+
+    if (index != last) {
+        in_state.vehicle_list[index] = in_state.vehicle_list[last];
+        in_state.distance[index] = in_state.distance[last];
+        in_state.heap_pos[index] = in_state.heap_pos[last];
+        in_state.heap[in_state.heap_pos[index]] = index;
+        hash_set(in_state.vehicle_list[index].info.ICAO_address, index);
     }
     // TODO: is memset needed? When we decrement the index we essentially forget about it
-    memset(&in_state.vehicle_list[in_state.vehicle_count-1], 0, sizeof(adsb_vehicle_t));
+    memset(&in_state.vehicle_list[last], 0, sizeof(adsb_vehicle_t));
     in_state.vehicle_count--;
+
+    if (pos < in_state.vehicle_count) {
+        heap_fix(pos);
+    }
 }
 
 /*
@@ -368,13 +380,128 @@ void AP_ADSB::delete_vehicle(const uint16_t index)
  */
 bool AP_ADSB::find_index(const adsb_vehicle_t &vehicle, uint16_t *index) const
 {
-    for (uint16_t i = 0; i < in_state.vehicle_count; i++) {
-        if (in_state.vehicle_list[i].info.ICAO_address == vehicle.info.ICAO_address) {
-            *index = i;
-            return true;
+    if (in_state.hash_table == nullptr) {
+        return false;
+    }
+    const uint16_t entry = in_state.hash_table[hash_slot(vehicle.info.ICAO_address)];
+    if (entry == 0) {
+        return false;
+    }
+    *index = entry - 1;
+    return true;
+}
+
+// multiplicative hash, as ICAO addresses are allocated in blocks
+static uint16_t icao_hash(const uint32_t icao)
+{
+    return (uint32_t)(icao * 2654435761U) >> 16;
+}
+
+/*
+ * slot of the hash table holding icao, or the empty slot where it
+ * would be inserted. The table is never more than half full, so the
+ * linear probe is short and always finds an empty slot
+ */
+uint16_t AP_ADSB::hash_slot(const uint32_t icao) const
+{
+    uint16_t slot = icao_hash(icao) & in_state.hash_mask;
+    while (true) {
+        const uint16_t entry = in_state.hash_table[slot];
+        if (entry == 0 || in_state.vehicle_list[entry-1].info.ICAO_address == icao) {
+            return slot;
         }
+        slot = (slot + 1) & in_state.hash_mask;
+    }
+}
+
+/*
+ * point the hash entry for icao at index, adding it if needed
+ */
+void AP_ADSB::hash_set(const uint32_t icao, const uint16_t index)
+{
+    in_state.hash_table[hash_slot(icao)] = index+1;
+}
+
+/*
+ * remove icao from the hash table, moving later entries of the probe
+ * sequence back so that no lookup stops early at the hole
+ */
+void AP_ADSB::hash_remove(const uint32_t icao)
+{
+    uint16_t hole = hash_slot(icao);
+    if (in_state.hash_table[hole] == 0) {
+        return;
+    }
+    in_state.hash_table[hole] = 0;
+    uint16_t slot = hole;
+    while (true) {
+        slot = (slot + 1) & in_state.hash_mask;
+        const uint16_t entry = in_state.hash_table[slot];
+        if (entry == 0) {
+            return;
+        }
+        const uint32_t entry_icao = in_state.vehicle_list[entry-1].info.ICAO_address;
+        const uint16_t home = icao_hash(entry_icao) & in_state.hash_mask;
+        // the entry can fill the hole if its home slot isn't cyclically in (hole, slot]
+        if (((slot - home) & in_state.hash_mask) >= ((slot - hole) & in_state.hash_mask)) {
+            in_state.hash_table[hole] = entry;
+            in_state.hash_table[slot] = 0;
+            hole = slot;
+        }
+    }
+}
+
+void AP_ADSB::heap_swap(const uint16_t a, const uint16_t b)
+{
+    const uint16_t index_a = in_state.heap[a];
+    const uint16_t index_b = in_state.heap[b];
+    in_state.heap[a] = index_b;
+    in_state.heap[b] = index_a;
+    in_state.heap_pos[index_b] = a;
+    in_state.heap_pos[index_a] = b;
+}
+
+void AP_ADSB::heap_sift_up(uint16_t pos)
+{
+    while (pos > 0) {
+        const uint16_t parent = (pos - 1) / 2;
+        if (in_state.distance[in_state.heap[parent]] >= in_state.distance[in_state.heap[pos]]) {
+            return;
+        }
+        heap_swap(pos, parent);
+        pos = parent;
+    }
+}
+
+void AP_ADSB::heap_sift_down(uint16_t pos)
+{
+    while (true) {
+        const uint16_t left = 2 * pos + 1;
+        if (left >= in_state.vehicle_count) {
+            return;
+        }
+        uint16_t largest = left;
+        const uint16_t right = left + 1;
+        if (right < in_state.vehicle_count &&
+            in_state.distance[in_state.heap[right]] > in_state.distance[in_state.heap[left]]) {
+            largest = right;
+        }
+        if (in_state.distance[in_state.heap[pos]] >= in_state.distance[in_state.heap[largest]]) {
+            return;
+        }
+        heap_swap(pos, largest);
+        pos = largest;
+    }
+}
+
+// restore the heap after the distance of the vehicle at pos has changed
+void AP_ADSB::heap_fix(const uint16_t pos)
+{
+    if (pos > 0 && in_state.distance[in_state.heap[(pos - 1) / 2]] < in_state.distance[in_state.heap[pos]]) {
+        heap_sift_up(pos);
+    } else {
+        heap_sift_down(pos);
     }
-    return false;
 }
 
 /*
@@ -388,6 +515,7 @@ void AP_ADSB::handle_vehicle(const mavlink_message_t* packet)
         return;
     }
 
+    const uint32_t start_us = AP_HAL::micros();
     uint16_t index = in_state.list_size + 1; // initialize with invalid index
     adsb_vehicle_t vehicle {};
     mavlink_msg_adsb_vehicle_decode(packet, &vehicle.info);
@@ -418,42 +546,30 @@ void AP_ADSB::handle_vehicle(const mavlink_message_t* packet)
         if (is_tracked_in_list) {
             delete_vehicle(index);
         }
+        update_perf(start_us);
         return;
+    }
 
-    } else if (is_tracked_in_list) {
+    // special vehicles are never bumped off the list
+    const float distance = is_special ? -1.0f : my_loc_distance_to_vehicle;
+
+    if (is_tracked_in_list) {
 
         // found, update it
-        set_vehicle(index, vehicle);
+        set_vehicle(index, vehicle, distance);
 
     } else if (in_state.vehicle_count < in_state.list_size) {
 
         // not found and there's room, add it to the end of the list
-        set_vehicle(in_state.vehicle_count, vehicle);
-        in_state.vehicle_count++;
-
-    } else {
-        // buffer is full. if new vehicle is closer than furthest, replace furthest with new
-
-        if (my_loc_is_zero) {
-            // nothing else to do
-            furthest_vehicle_distance = 0;
-            furthest_vehicle_index = 0;
-
-        } else {
-            if (furthest_vehicle_distance <= 0) {
-                // ensure this is populated
-                determine_furthest_aircraft();
-            }
-
-            if (my_loc_distance_to_vehicle < furthest_vehicle_distance) { // is closer than the furthest
-                // replace with the furthest vehicle
-                set_vehicle(furthest_vehicle_index, vehicle);
-
-                // furthest_vehicle_index is now invalid because the vehicle was overwritten, need
-                // to run determine_furthest_aircraft() to determine a new one next time
-                furthest_vehicle_distance = 0;
-                furthest_vehicle_index = 0;
-            }
+        set_vehicle(in_state.vehicle_count, vehicle, distance);
+
+    } else if (!my_loc_is_zero) {
+        // buffer is full. if new vehicle is closer than furthest, replace furthest with new.
+        // Distances are from when each vehicle was last reported, so
+        // are as fresh as the reports
+        const uint16_t furthest_index = in_state.heap[0];
+        if (my_loc_distance_to_vehicle < in_state.distance[furthest_index]) {
+            set_vehicle(furthest_index, vehicle, distance);
         }
     } // if buffer full
 
@@ -466,18 +582,36 @@ void AP_ADSB::handle_vehicle(const mavlink_message_t* packet)
     if (vehicle.info.flags & required_flags_avoidance) {
         push_sample(vehicle); // note that set_vehicle modifies vehicle
     }
+
+    update_perf(start_us);
 }
 
 /*
- * Copy a vehicle's data into the list
+ * Copy a vehicle's data into the list, replacing the vehicle at
+ * index or appending it when index is vehicle_count
  */
-void AP_ADSB::set_vehicle(const uint16_t index, const adsb_vehicle_t &vehicle)
+void AP_ADSB::set_vehicle(const uint16_t index, const adsb_vehicle_t &vehicle, const float distance)
 {
-    if (index >= in_state.list_size) {
+    if (index >= in_state.list_size || index > in_state.vehicle_count) {
         // out of range
         return;
     }
-    in_state.vehicle_list[index] = vehicle;
+
+    if (index == in_state.vehicle_count) {
+        in_state.heap[index] = index;
+        in_state.heap_pos[index] = index;
+        in_state.vehicle_count++;
+        in_state.vehicle_list[index] = vehicle;
+        hash_set(vehicle.info.ICAO_address, index);
+    } else if (in_state.vehicle_list[index].info.ICAO_address != vehicle.info.ICAO_address) {
+        hash_remove(in_state.vehicle_list[index].info.ICAO_address);
+        in_state.vehicle_list[index] = vehicle;
+        hash_set(vehicle.info.ICAO_address, index);
+    } else {
+        in_state.vehicle_list[index] = vehicle;
+    }
+    in_state.distance[index] = distance;
+    heap_fix(in_state.heap_pos[index]);
 
     write_log(vehicle);
 }
@@ -920,3 +1054,39 @@ void AP_ADSB::write_log(const adsb_vehicle_t &vehicle)
     };
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
 }
+
+/*
+ * accumulate the processing time of an ADSB_VEHICLE message
+ */
+void AP_ADSB::update_perf(const uint32_t start_us)
+{
+    const uint32_t dt_us = AP_HAL::micros() - start_us;
+    perf.count++;
+    perf.total_us += dt_us;
+    perf.max_us = MAX(perf.max_us, dt_us);
+}
+
+/*
+ * write the ADSB_VEHICLE message processing time to the log once a second
+ */
+void AP_ADSB::write_log_perf(const uint32_t now)
+{
+    if (now - perf.last_log_ms < 1000) {
+        return;
+    }
+    perf.last_log_ms = now;
+    if (_log == logging::NONE || perf.count == 0) {
+        return;
+    }
+
+    // vehicles in the list, messages handled, and their average and longest processing time
+    AP::logger().Write("ADSP", "TimeUS,Count,Msgs,AvgUS,MaxUS", "QHIII",
+                       AP_HAL::micros64(),
+                       in_state.vehicle_count,
+                       perf.count,
+                       perf.total_us / perf.count,
+                       perf.max_us);
+    perf.count = 0;
+    perf.total_us = 0;
+    perf.max_us = 0;
+}
@@ -95,16 +95,25 @@ private:
     // free _vehicle_list
     void deinit();
 
-    // compares current vector against vehicle_list to detect threats
-    void determine_furthest_aircraft(void);
-
     // return index of given vehicle if ICAO_ADDRESS matches. return -1 if no match
     bool find_index(const adsb_vehicle_t &vehicle, uint16_t *index) const;
 
     // remove a vehicle from the list
     void delete_vehicle(const uint16_t index);
 
-    void set_vehicle(const uint16_t index, const adsb_vehicle_t &vehicle);
+    // copy a vehicle into the list at index, or append it when index is vehicle_count
+    void set_vehicle(const uint16_t index, const adsb_vehicle_t &vehicle, const float distance);
+
+    // ICAO hash index into vehicle_list
+    uint16_t hash_slot(const uint32_t icao) const;
+    void hash_set(const uint32_t icao, const uint16_t index);
+    void hash_remove(const uint32_t icao);
+
+    // max-heap of vehicle_list indices keyed by distance, for eviction
+    void heap_swap(const uint16_t a, const uint16_t b);
+    void heap_sift_up(uint16_t pos);
+    void heap_sift_down(uint16_t pos);
+    void heap_fix(const uint16_t pos);
 
     // Generates pseudorandom ICAO from gps time, lat, and lon
     uint32_t genICAO(const Location &loc);
@@ -140,6 +149,17 @@ private:
         uint16_t    list_size = 1; // start with tiny list, then change to param-defined size. This ensures it doesn't fail on start
         adsb_vehicle_t *vehicle_list = nullptr;
         uint16_t    vehicle_count;
+
+        // open addressed table of vehicle_list index+1 by ICAO, 0 is
+        // empty. Its size is a power of two of at least twice list_size
+        uint16_t    *hash_table = nullptr;
+        uint16_t    hash_mask;
+
+        // heap of vehicle_list indices with the furthest at the top,
+        // and the heap position and distance of each vehicle
+        uint16_t    *heap = nullptr;
+        uint16_t    *heap_pos = nullptr;
+        float       *distance = nullptr;
         AP_Int32    list_radius;
         AP_Int16    list_altitude;
 
@@ -181,10 +201,15 @@ private:
     } out_state;
 
 
-    // index of and distance to furthest vehicle in list
-    uint16_t    furthest_vehicle_index;
-    float       furthest_vehicle_distance;
-
+    // ADSB_VEHICLE message processing time, logged once a second
+    struct {
+        uint32_t    last_log_ms;
+        uint32_t    count;
+        uint32_t    total_us;
+        uint32_t    max_us;
+    } perf;
+    void update_perf(const uint32_t start_us);
+    void write_log_perf(const uint32_t now);
 
     // special ICAO of interest that ignored filters when != 0
     AP_Int32 _special_ICAO_target;
@@ -156,6 +156,13 @@ const AP_Param::GroupInfo AP_AHRS::var_info[] = {
     // @User: Advanced
     AP_GROUPINFO("CUSTOM_YAW", 17, AP_AHRS, _custom_yaw, 0),
 
+    // @Param: DCM_DECIM
+    // @DisplayName: DCM backup decimation
+    // @Description: While an EKF is active and healthy the DCM backup attitude estimate is only updated once in this many loops, to save CPU time. 1 updates it every loop
+    // @Range: 1 10
+    // @User: Advanced
+    AP_GROUPINFO("DCM_DECIM", 18, AP_AHRS, _dcm_decimation, 1),
+
     AP_GROUPEND
 };
 
@@ -24,6 +24,7 @@
 #include <inttypes.h>
 #include <AP_Compass/AP_Compass.h>
 #include <AP_Airspeed/AP_Airspeed.h>
+#include <AP_Airspeed/AP_Airspeed_Synthetic.h>
 #include <AP_Beacon/AP_Beacon.h>
 #include <AP_GPS/AP_GPS.h>
 #include <AP_InertialSensor/AP_InertialSensor.h>
@@ -191,6 +192,11 @@ public:
         return AP::ins().get_primary_gyro();
     }
 
+    // get the number of times the EKF has changed its primary core
+    virtual uint32_t get_lane_switch_count(void) const {
+        return 0;
+    }
+
     // accelerometer values in the earth frame in m/s/s
     virtual const Vector3f &get_accel_ef(uint8_t i) const {
         return _accel_ef[i];
@@ -610,6 +616,7 @@ protected:
     AP_Int8 _gps_minsats;
     AP_Int8 _gps_delay;
     AP_Int8 _ekf_type;
+    AP_Int8 _dcm_decimation;
     AP_Float _custom_roll;
     AP_Float _custom_pitch;
     AP_Float _custom_yaw;
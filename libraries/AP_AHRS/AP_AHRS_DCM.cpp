@@ -67,7 +67,8 @@ AP_AHRS_DCM::update(bool skip_ins_update)
     const AP_InertialSensor &_ins = AP::ins();
 
     // ask the IMU how much time this sensor reading represents
-    delta_t = _ins.get_delta_time();
+    delta_t = _ins.get_delta_time() + _skipped_delta_t;
+    _skipped_delta_t = 0;
 
     // if the update call took more than 0.2 seconds then discard it,
     // otherwise we may move too far. This happens when arming motors
@@ -98,6 +99,10 @@ AP_AHRS_DCM::update(bool skip_ins_update)
 
     // update AOA and SSA
     update_AOA_SSA();
+
+    // carry the synthetic airspeed forward every update, so it is ready
+    // if the airspeed sensor fails
+    _airspeed_synthetic.predict(_ins.get_accel().x, pitch, delta_t);
 }
 
 // update the DCM matrix using only the gyros
@@ -255,7 +260,7 @@ AP_AHRS_DCM::renorm(Vector3f const &a, Vector3f &result)
     // we don't want to compound the error by making DCM less
     // accurate.
 
-    const float renorm_val = 1.0f / a.length();
+    const float renorm_val = approx_inv_sqrtf(a.length_squared());
 
     // keep the average for reporting
     _renorm_val_sum += renorm_val;
@@ -647,7 +652,7 @@ AP_AHRS_DCM::drift_correction(float deltat)
         float airspeed;
         if (airspeed_sensor_enabled()) {
             airspeed = _airspeed->get_airspeed();
-        } else {
+        } else if (!_airspeed_synthetic.get_airspeed(airspeed, AP_HAL::millis())) {
             airspeed = _last_airspeed;
         }
         // use airspeed to estimate our ground velocity in
@@ -683,6 +688,7 @@ AP_AHRS_DCM::drift_correction(float deltat)
         // take positive component in X direction. This mimics a pitot
         // tube
         _last_airspeed = MAX(airspeed.x, 0);
+        _airspeed_synthetic.set_reference(_last_airspeed, AP_HAL::millis());
     }
 
     if (have_gps()) {
@@ -1007,8 +1013,11 @@ bool AP_AHRS_DCM::airspeed_estimate(float *airspeed_ret) const
         return false;
     }
 
-    // estimate it via GPS speed and wind
-    if (have_gps()) {
+    // estimate it via GPS speed and wind, smoothed by the IMU. This
+    // carries on over short losses of GPS
+    if (_airspeed_synthetic.get_airspeed(*airspeed_ret, AP_HAL::millis())) {
+        ret = true;
+    } else if (have_gps()) {
         *airspeed_ret = _last_airspeed;
         ret = true;
     }
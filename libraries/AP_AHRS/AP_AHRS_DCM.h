@@ -25,6 +25,7 @@ class AP_AHRS_DCM : public AP_AHRS {
 public:
     AP_AHRS_DCM()
         : AP_AHRS()
+        , _skipped_delta_t(0)
         , _error_rp(1.0f)
         , _error_yaw(1.0f)
         , _mag_earth(1, 0)
@@ -94,6 +95,12 @@ public:
     // if we have an estimate
     bool airspeed_estimate(float *airspeed_ret) const override;
 
+    // return the synthetic airspeed estimate, if valid. This is
+    // available whether or not there is an airspeed sensor
+    bool synthetic_airspeed(float &airspeed) const {
+        return _airspeed_synthetic.get_airspeed(airspeed, AP_HAL::millis());
+    }
+
     bool            use_compass() override;
 
     bool set_home(const Location &loc) override WARN_IF_UNUSED;
@@ -104,6 +111,11 @@ public:
 
     bool get_velocity_NED(Vector3f &vec) const override;
 
+protected:
+    // time of IMU samples not given to a decimated update(), which are
+    // integrated by the next one
+    float _skipped_delta_t;
+
 private:
     float _ki;
     float _ki_yaw;
@@ -183,6 +195,9 @@ private:
     float _last_airspeed;
     uint32_t _last_consistent_heading;
 
+    // airspeed estimated from the IMU, GPS and wind
+    AP_Airspeed_Synthetic _airspeed_synthetic;
+
     // estimated wind in m/s
     Vector3f _wind;
 
@@ -134,6 +134,21 @@ void AP_AHRS_NavEKF::update(bool skip_ins_update)
 
 void AP_AHRS_NavEKF::update_DCM(bool skip_ins_update)
 {
+    // with a healthy EKF, DCM is only a backup, so it may be run at a
+    // fraction of the loop rate. The IMU is still updated every loop
+    if (_dcm_decimation > 1 &&
+        active_EKF_type() != EKF_TYPE_NONE &&
+        healthy() &&
+        _skipped_delta_t < 0.05f &&
+        ++_dcm_skip_count < _dcm_decimation) {
+        if (!skip_ins_update) {
+            AP::ins().update();
+        }
+        _skipped_delta_t += AP::ins().get_delta_time();
+        return;
+    }
+    _dcm_skip_count = 0;
+
     // we need to restore the old DCM attitude values as these are
     // used internally in DCM to calculate error values for gyro drift
     // correction
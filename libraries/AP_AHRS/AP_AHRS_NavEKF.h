@@ -259,6 +259,11 @@ public:
     // get the index of the current primary gyro sensor
     uint8_t get_primary_gyro_index(void) const override;
 
+    // get the number of times the EKF2 and EKF3 have changed primary core
+    uint32_t get_lane_switch_count(void) const override {
+        return EKF2.getLaneSwitchCount() + EKF3.getLaneSwitchCount();
+    }
+
 private:
     enum EKF_TYPE {EKF_TYPE_NONE=0,
                    EKF_TYPE3=3,
@@ -293,6 +298,7 @@ private:
 
     uint8_t ekf_type(void) const;
     void update_DCM(bool skip_ins_update);
+    uint8_t _dcm_skip_count;
     void update_EKF2(void);
     void update_EKF3(void);
 
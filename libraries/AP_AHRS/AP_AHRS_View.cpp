@@ -69,6 +69,8 @@ void AP_AHRS_View::update(bool skip_ins_update)
     }
 
     rot_body_to_ned.to_euler(&roll, &pitch, &yaw);
+    quat_valid = false;
+    trig_valid = false;
 
     roll_sensor  = degrees(roll) * 100;
     pitch_sensor = degrees(pitch) * 100;
@@ -76,10 +78,18 @@ void AP_AHRS_View::update(bool skip_ins_update)
     if (yaw_sensor < 0) {
         yaw_sensor += 36000;
     }
+}
 
-    ahrs.calc_trig(rot_body_to_ned,
-                   trig.cos_roll, trig.cos_pitch, trig.cos_yaw,
-                   trig.sin_roll, trig.sin_pitch, trig.sin_yaw);
+// return the trig values, calculating them on the first use after an update
+const struct AP_AHRS_View::trig_values &AP_AHRS_View::get_trig(void) const
+{
+    if (!trig_valid) {
+        ahrs.calc_trig(rot_body_to_ned,
+                       trig.cos_roll, trig.cos_pitch, trig.cos_yaw,
+                       trig.sin_roll, trig.sin_pitch, trig.sin_yaw);
+        trig_valid = true;
+    }
+    return trig;
 }
 
 // return a smoothed and corrected gyro vector using the latest ins data (which may not have been consumed by the EKF yet)
@@ -92,13 +102,15 @@ Vector3f AP_AHRS_View::get_gyro_latest(void) const {
 // rotate a 2D vector from earth frame to body frame
 Vector2f AP_AHRS_View::rotate_earth_to_body2D(const Vector2f &ef) const
 {
-    return Vector2f(ef.x * trig.cos_yaw + ef.y * trig.sin_yaw,
-                    -ef.x * trig.sin_yaw + ef.y * trig.cos_yaw);
+    const struct trig_values &t = get_trig();
+    return Vector2f(ef.x * t.cos_yaw + ef.y * t.sin_yaw,
+                    -ef.x * t.sin_yaw + ef.y * t.cos_yaw);
 }
 
 // rotate a 2D vector from earth frame to body frame
 Vector2f AP_AHRS_View::rotate_body_to_earth2D(const Vector2f &bf) const
 {
-    return Vector2f(bf.x * trig.cos_yaw - bf.y * trig.sin_yaw,
-                    bf.x * trig.sin_yaw + bf.y * trig.cos_yaw);
+    const struct trig_values &t = get_trig();
+    return Vector2f(bf.x * t.cos_yaw - bf.y * t.sin_yaw,
+                    bf.x * t.sin_yaw + bf.y * t.cos_yaw);
 }
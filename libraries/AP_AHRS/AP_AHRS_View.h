@@ -49,7 +49,11 @@ public:
 
     // return a Quaternion representing our current attitude in this view
     void get_quat_body_to_ned(Quaternion &quat) const {
-        quat.from_rotation_matrix(rot_body_to_ned);
+        if (!quat_valid) {
+            quat_body_to_ned.from_rotation_matrix(rot_body_to_ned);
+            quat_valid = true;
+        }
+        quat = quat_body_to_ned;
     }
 
     // apply pitch trim
@@ -57,22 +61,22 @@ public:
 
     // helper trig value accessors
     float cos_roll() const {
-        return trig.cos_roll;
+        return get_trig().cos_roll;
     }
     float cos_pitch() const {
-        return trig.cos_pitch;
+        return get_trig().cos_pitch;
     }
     float cos_yaw() const {
-        return trig.cos_yaw;
+        return get_trig().cos_yaw;
     }
     float sin_roll() const {
-        return trig.sin_roll;
+        return get_trig().sin_roll;
     }
     float sin_pitch() const {
-        return trig.sin_pitch;
+        return get_trig().sin_pitch;
     }
     float sin_yaw() const {
-        return trig.sin_yaw;
+        return get_trig().sin_yaw;
     }
 
 
@@ -188,9 +192,14 @@ private:
     // transpose of rot_view
     Matrix3f rot_view_T;
     Matrix3f rot_body_to_ned;
+    // rot_body_to_ned as a quaternion and trig values, which are only
+    // calculated on the first use after each update
+    mutable Quaternion quat_body_to_ned;
+    mutable bool quat_valid;
+    mutable bool trig_valid;
     Vector3f gyro;
 
-    struct {
+    mutable struct trig_values {
         float cos_roll;
         float cos_pitch;
         float cos_yaw;
@@ -199,6 +208,8 @@ private:
         float sin_yaw;
     } trig;
 
+    const struct trig_values &get_trig(void) const;
+
     float y_angle;
     float _pitch_trim_deg;
 };
@@ -189,6 +189,11 @@ void AP_AccelCal::start(GCS_MAVLINK *gcs)
         _num_active_calibrators++;
     }
 
+    if (!_io_registered) {
+        _io_registered = true;
+        hal.scheduler->register_io_process(FUNCTOR_BIND_MEMBER(&AP_AccelCal::io_timer, void));
+    }
+
     _started = true;
     _saving = false;
     _gcs = gcs;
@@ -201,6 +206,22 @@ void AP_AccelCal::start(GCS_MAVLINK *gcs)
     update_status();
 }
 
+/*
+  the fits used to run in new_sample() as the last sample came in,
+  holding up the sensor thread for each IMU in turn. They run here
+  instead, and update() sees the result on its next call
+ */
+void AP_AccelCal::io_timer(void)
+{
+    if (!_started) {
+        return;
+    }
+    AccelCalibrator *cal;
+    for(uint8_t i=0; (cal = get_calibrator(i)); i++) {
+        cal->run_pending_fit();
+    }
+}
+
 void AP_AccelCal::success()
 {
     _printf("Calibration successful");
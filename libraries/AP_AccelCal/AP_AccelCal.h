@@ -12,7 +12,8 @@ public:
     AP_AccelCal():
     _use_gcs_snoop(true),
     _started(false),
-    _saving(false)
+    _saving(false),
+    _io_registered(false)
     { update_status(); }
 
     // start all the registered calibrations
@@ -70,6 +71,10 @@ private:
 
     bool _started;
     bool _saving;
+    bool _io_registered;
+
+    // runs the calibrator fits once all their samples are collected
+    void io_timer(void);
 
     uint8_t _num_active_calibrators;
 
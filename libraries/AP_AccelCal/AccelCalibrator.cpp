@@ -16,6 +16,7 @@
 #include "AccelCalibrator.h"
 #include <stdio.h>
 #include <AP_HAL/AP_HAL.h>
+#include <AP_Common/Semaphore.h>
 
 const extern AP_HAL::HAL& hal;
 /*
@@ -31,7 +32,7 @@ AccelCalibrator::AccelCalibrator() :
 _conf_tolerance(ACCEL_CAL_TOLERANCE),
 _sample_buffer(nullptr)
 {
-    clear();
+    set_status(ACCEL_CAL_NOT_STARTED);
 }
 /*
     Select options, initialise variables and initiate accel calibration
@@ -59,6 +60,7 @@ void AccelCalibrator::start(enum accel_cal_fit_type_t fit_type, uint8_t num_samp
     if (_status == ACCEL_CAL_FAILED || _status == ACCEL_CAL_SUCCESS) {
         clear();
     }
+    WITH_SEMAPHORE(_sem);
     if (_status != ACCEL_CAL_NOT_STARTED) {
         return;
     }
@@ -97,6 +99,7 @@ void AccelCalibrator::start(enum accel_cal_fit_type_t fit_type, uint8_t num_samp
 
 // set Accel calibrator status to make itself ready for future accel cals
 void AccelCalibrator::clear() {
+    WITH_SEMAPHORE(_sem);
     set_status(ACCEL_CAL_NOT_STARTED);
 }
 
@@ -112,7 +115,23 @@ void AccelCalibrator::collect_sample() {
 
 // collect and avg sample to be passed onto LSQ estimator after all requisite orientations are done
 void AccelCalibrator::new_sample(const Vector3f& delta_velocity, float dt) {
-    if (_status != ACCEL_CAL_COLLECTING_SAMPLE) {
+    if (_status != ACCEL_CAL_COLLECTING_SAMPLE || _fit_pending) {
+        return;
+    }
+
+    // don't block the sensor thread, losing a fragment of a sample
+    // only lengthens the sample time a little
+    if (!_sem.take_nonblocking()) {
+        return;
+    }
+
+    collect_fragment(delta_velocity, dt);
+
+    _sem.give();
+}
+
+void AccelCalibrator::collect_fragment(const Vector3f& delta_velocity, float dt) {
+    if (_status != ACCEL_CAL_COLLECTING_SAMPLE || _sample_buffer == nullptr) {
         return;
     }
 
@@ -136,19 +155,35 @@ void AccelCalibrator::new_sample(const Vector3f& delta_velocity, float dt) {
         _samples_collected++;
 
         if (_samples_collected >= _conf_num_samples) {
-            run_fit(MAX_ITERATIONS, _fitness);
-
-            if (_fitness < _conf_tolerance && accept_result()) {
-                set_status(ACCEL_CAL_SUCCESS);
-            } else {
-                set_status(ACCEL_CAL_FAILED);
-            }
+            // stay collecting until run_pending_fit() has run
+            _fit_pending = true;
         } else {
             set_status(ACCEL_CAL_WAITING_FOR_ORIENTATION);
         }
     }
 }
 
+void AccelCalibrator::run_pending_fit() {
+    if (!_fit_pending) {
+        return;
+    }
+
+    WITH_SEMAPHORE(_sem);
+
+    // may have been cleared while we waited
+    if (!_fit_pending || _status != ACCEL_CAL_COLLECTING_SAMPLE) {
+        return;
+    }
+
+    run_fit(MAX_ITERATIONS, _fitness);
+
+    if (_fitness < _conf_tolerance && accept_result()) {
+        set_status(ACCEL_CAL_SUCCESS);
+    } else {
+        set_status(ACCEL_CAL_FAILED);
+    }
+}
+
 // determines if the result is acceptable
 bool AccelCalibrator::accept_result() const {
     if (fabsf(_param.s.offset.x) > GRAVITY_MSS ||
@@ -193,6 +228,11 @@ bool AccelCalibrator::get_sample_corrected(uint8_t i, Vector3f& s) const {
 
 // checks if no new sample has been received for considerable amount of time
 void AccelCalibrator::check_for_timeout() {
+    if (_fit_pending) {
+        // samples are complete, waiting on the fit
+        return;
+    }
+    WITH_SEMAPHORE(_sem);
     const uint32_t timeout = _conf_sample_time*2*1000 + 500;
     if (_status == ACCEL_CAL_COLLECTING_SAMPLE && AP_HAL::millis() - _last_samp_frag_collected_ms > timeout) {
         set_status(ACCEL_CAL_FAILED);
@@ -262,6 +302,7 @@ void AccelCalibrator::set_status(enum accel_cal_status_t status) {
             _status = ACCEL_CAL_NOT_STARTED;
 
             _samples_collected = 0;
+            _fit_pending = false;
             if (_sample_buffer != nullptr) {
                 free(_sample_buffer);
                 _sample_buffer = nullptr;
@@ -305,6 +346,7 @@ void AccelCalibrator::set_status(enum accel_cal_status_t status) {
             }
 
             _status = ACCEL_CAL_SUCCESS;
+            _fit_pending = false;
             break;
 
         case ACCEL_CAL_FAILED:
@@ -315,6 +357,7 @@ void AccelCalibrator::set_status(enum accel_cal_status_t status) {
             }
 
             _status = ACCEL_CAL_FAILED;
+            _fit_pending = false;
             break;
     };
 }
@@ -332,6 +375,7 @@ void AccelCalibrator::run_fit(uint8_t max_iterations, float& fitness)
     float min_fitness = fitness;
     union param_u fit_param = _param;
     uint8_t num_iterations = 0;
+    const uint8_t num_params = get_num_params();
 
     while(num_iterations < max_iterations) {
         float JTJ[ACCEL_CAL_MAX_NUM_PARAMS*ACCEL_CAL_MAX_NUM_PARAMS] {};
@@ -344,25 +388,45 @@ void AccelCalibrator::run_fit(uint8_t max_iterations, float& fitness)
             VectorN<float,ACCEL_CAL_MAX_NUM_PARAMS> jacob;
 
             calc_jacob(sample, fit_param.s, jacob);
+            const float residual = calc_residual(sample, fit_param.s);
 
-            for(uint8_t i = 0; i < get_num_params(); i++) {
-                // compute JTJ
-                for(uint8_t j = 0; j < get_num_params(); j++) {
-                    JTJ[i*get_num_params()+j] += jacob[i] * jacob[j];
+            // JTJ is symmetric, accumulate the upper triangle only
+            for(uint8_t i = 0; i < num_params; i++) {
+                for(uint8_t j = i; j < num_params; j++) {
+                    JTJ[i*num_params+j] += jacob[i] * jacob[j];
                 }
-                // compute JTFI
-                JTFI[i] += jacob[i] * calc_residual(sample, fit_param.s);
+                JTFI[i] += jacob[i] * residual;
+            }
+        }
+        for(uint8_t i = 1; i < num_params; i++) {
+            for(uint8_t j = 0; j < i; j++) {
+                JTJ[i*num_params+j] = JTJ[j*num_params+i];
             }
         }
 
-        if (!inverse(JTJ, JTJ, get_num_params())) {
+        // JTJ is symmetric positive definite unless the samples don't
+        // constrain the fit, so the step is solved for directly
+        VectorP step;
+        bool solved;
+        switch (num_params) {
+            case 6:
+                solved = mat_cholesky_solve<6>(JTJ, &JTFI[0], &step[0]);
+                break;
+            case 9:
+                solved = mat_cholesky_solve<9>(JTJ, &JTFI[0], &step[0]);
+                break;
+            default:
+                solved = false;
+                break;
+        }
+        if (!solved) {
             return;
         }
 
-        for(uint8_t row=0; row < get_num_params(); row++) {
-            for(uint8_t col=0; col < get_num_params(); col++) {
-                fit_param.a[row] -= JTFI[col] * JTJ[row*get_num_params()+col];
-            }
+        float max_step = 0;
+        for(uint8_t row=0; row < num_params; row++) {
+            fit_param.a[row] -= step[row];
+            max_step = MAX(max_step, fabsf(step[row]));
         }
 
         fitness = calc_mean_squared_residuals(fit_param.s);
@@ -377,6 +441,13 @@ void AccelCalibrator::run_fit(uint8_t max_iterations, float& fitness)
         }
 
         num_iterations++;
+
+        // Gauss-Newton converges in a handful of iterations from the
+        // starting parameters. Once the step is down at float
+        // resolution further iterations don't change the result
+        if (max_step < ACCEL_CAL_CONVERGED_STEP) {
+            break;
+        }
     }
 }
 
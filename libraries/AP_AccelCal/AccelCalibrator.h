@@ -12,12 +12,15 @@
 */
 #pragma once
 
+#include <AP_HAL/AP_HAL.h>
 #include <AP_Math/AP_Math.h>
 #include <AP_Math/vectorN.h>
 
 #define ACCEL_CAL_MAX_NUM_PARAMS 9
 #define ACCEL_CAL_TOLERANCE 0.1
 #define MAX_ITERATIONS  50
+// largest parameter step at which the fit is converged
+#define ACCEL_CAL_CONVERGED_STEP 1.0e-6f
 enum accel_cal_status_t {
     ACCEL_CAL_NOT_STARTED=0,
     ACCEL_CAL_WAITING_FOR_ORIENTATION=1,
@@ -60,6 +63,14 @@ public:
     // collect and avg sample to be passed onto LSQ estimator after all requisite orientations are done
     void new_sample(const Vector3f& delta_velocity, float dt);
 
+    // returns true once all the samples are collected and the fit is waiting to be run
+    bool fit_pending() const { return _fit_pending; }
+
+    // run the LSQ fit once all the samples are collected. This is
+    // kept out of new_sample() as that is called from the sensor
+    // thread, and is called from the IO thread by AP_AccelCal
+    void run_pending_fit();
+
     // interface for LSq estimator to read sample buffer sent after conversion from delta velocity
     // to averaged acc over time
     bool get_sample(uint8_t i, Vector3f& s) const;
@@ -118,11 +129,19 @@ private:
     float _fitness;
     uint32_t _last_samp_frag_collected_ms;
     float _min_sample_dist;
+    volatile bool _fit_pending;
+
+    // protects the sample buffer and parameters between the sensor
+    // thread, the IO thread fitting and the main thread
+    HAL_Semaphore _sem;
 
     // private methods
     // check sanity of including the sample and add it to buffer if test is passed
     bool accept_sample(const Vector3f& sample);
 
+    // add a fragment to the current sample, with _sem held
+    void collect_fragment(const Vector3f& delta_velocity, float dt);
+
     // reset to calibrator state before the start of calibration
     void reset_state();
 
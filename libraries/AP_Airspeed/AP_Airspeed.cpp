@@ -386,8 +386,14 @@ void AP_Airspeed::read(uint8_t i)
     // remember raw pressure for logging
     state[i].corrected_pressure = airspeed_pressure;
 
-    // filter before clamping positive
-    if (!prev_healthy) {
+    // filter before clamping positive. Backends read by their own
+    // thread filter each sample as it arrives; as the filter is linear
+    // the offset can be removed from its output
+    float sample_filtered;
+    if (state[i].healthy && !state[i].hil_set &&
+        sensor[i]->get_filtered_pressure(sample_filtered)) {
+        state[i].filtered_pressure = sample_filtered - param[i].offset;
+    } else if (!prev_healthy) {
         // if the previous state was not healthy then we should not
         // use an IIR filter, otherwise a bad reading will last for
         // some time after the sensor becomees healthy again
@@ -28,6 +28,7 @@ AP_Airspeed_Backend::AP_Airspeed_Backend(AP_Airspeed &_frontend, uint8_t _instan
     frontend(_frontend),
     instance(_instance)
 {
+    samples.filter.set_cutoff_frequency(AIRSPEED_FILTER_CUTOFF_HZ);
 }
 
 AP_Airspeed_Backend::~AP_Airspeed_Backend(void)
@@ -49,3 +50,74 @@ uint8_t AP_Airspeed_Backend::get_bus(void) const
 {
     return frontend.param[instance].bus;
 }
+
+void AP_Airspeed_Backend::add_sample(float pressure, float temperature)
+{
+    const uint32_t now_ms = AP_HAL::millis();
+
+    WITH_SEMAPHORE(sem);
+
+    samples.press_sum += pressure;
+    samples.temp_sum += temperature;
+    samples.press_count++;
+    samples.temp_count++;
+
+    // filter in this thread, at the rate of the sensor, rather than at
+    // the rate the frontend is updated. After a gap the filter starts
+    // again, so a bad reading doesn't last after the sensor recovers
+    if (samples.last_ms == 0 || now_ms - samples.last_ms > AIRSPEED_SAMPLE_TIMEOUT_MS) {
+        samples.filter.reset(pressure);
+        samples.filtered = pressure;
+    } else {
+        samples.filtered = samples.filter.apply(pressure, (now_ms - samples.last_ms) * 0.001f);
+    }
+    samples.last_ms = now_ms;
+}
+
+bool AP_Airspeed_Backend::get_average_pressure(float &pressure)
+{
+    if ((AP_HAL::millis() - samples.last_ms) > AIRSPEED_SAMPLE_TIMEOUT_MS) {
+        return false;
+    }
+
+    WITH_SEMAPHORE(sem);
+
+    if (samples.press_count > 0) {
+        samples.pressure = samples.press_sum / samples.press_count;
+        samples.press_count = 0;
+        samples.press_sum = 0;
+    }
+
+    pressure = samples.pressure;
+    return true;
+}
+
+bool AP_Airspeed_Backend::get_average_temperature(float &temperature)
+{
+    if ((AP_HAL::millis() - samples.last_ms) > AIRSPEED_SAMPLE_TIMEOUT_MS) {
+        return false;
+    }
+
+    WITH_SEMAPHORE(sem);
+
+    if (samples.temp_count > 0) {
+        samples.temperature = samples.temp_sum / samples.temp_count;
+        samples.temp_count = 0;
+        samples.temp_sum = 0;
+    }
+
+    temperature = samples.temperature;
+    return true;
+}
+
+bool AP_Airspeed_Backend::get_sample_filtered_pressure(float &pressure)
+{
+    if (samples.last_ms == 0) {
+        return false;
+    }
+
+    WITH_SEMAPHORE(sem);
+
+    pressure = samples.filtered;
+    return true;
+}
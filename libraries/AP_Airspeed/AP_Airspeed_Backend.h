@@ -21,8 +21,15 @@
 #include <AP_Common/AP_Common.h>
 #include <AP_Common/Semaphore.h>
 #include <AP_HAL/AP_HAL.h>
+#include <Filter/LowPassFilter.h>
 #include "AP_Airspeed.h"
 
+// cutoff of the filter on the pressure of each sample, the equivalent
+// of the frontend's old 0.7/0.3 filter at its 10Hz update rate
+#define AIRSPEED_FILTER_CUTOFF_HZ   0.7f
+// samples older than this are stale and the sensor unhealthy
+#define AIRSPEED_SAMPLE_TIMEOUT_MS  100
+
 class AP_Airspeed_Backend {
 public:
     AP_Airspeed_Backend(AP_Airspeed &frontend, uint8_t instance);
@@ -37,6 +44,11 @@ public:
     // return the current temperature in degrees C, if available
     virtual bool get_temperature(float &temperature) = 0;
 
+    // return the differential pressure in Pascal filtered at each
+    // sample by the backend's thread, if it filters it. Called just
+    // after get_differential_pressure()
+    virtual bool get_filtered_pressure(float &pressure) { return false; }
+
 protected:
     int8_t get_pin(void) const;
     float get_psi_range(void) const;
@@ -67,8 +79,34 @@ protected:
     void set_offset(float ofs) {
         frontend.param[instance].offset.set(ofs);
     }
-    
+
+    /*
+      for sensors read by a periodic callback: add a sample from the
+      callback, and get the average of the samples since the last call
+      and the pressure filtered at each sample. These return false if
+      there has been no sample for AIRSPEED_SAMPLE_TIMEOUT_MS
+     */
+    void add_sample(float pressure, float temperature);
+    bool get_average_pressure(float &pressure);
+    bool get_average_temperature(float &temperature);
+    bool get_sample_filtered_pressure(float &pressure);
+
+    // system time of the last sample added, zero if there has been none
+    uint32_t last_sample_ms(void) const { return samples.last_ms; }
+
 private:
+    struct {
+        float press_sum;
+        float temp_sum;
+        uint16_t press_count;
+        uint16_t temp_count;
+        float pressure;
+        float temperature;
+        LowPassFilterFloat filter;
+        float filtered;
+        uint32_t last_ms;
+    } samples;
+
     AP_Airspeed &frontend;
     uint8_t instance;
 };
@@ -40,17 +40,13 @@ public:
     // return the current temperature in degrees C, if available
     bool get_temperature(float &temperature) override;
 
+    // return the differential pressure filtered at each sample
+    bool get_filtered_pressure(float &pressure) override {
+        return get_sample_filtered_pressure(pressure);
+    }
+
 private:
     void timer();
 
-    float pressure;
-    float temperature;
-    float temperature_sum;
-    float pressure_sum;
-    uint32_t temp_count;
-    uint32_t press_count;
-    
-    uint32_t last_sample_time_ms;
-
     AP_HAL::OwnPtr<AP_HAL::I2CDevice> dev;
 };
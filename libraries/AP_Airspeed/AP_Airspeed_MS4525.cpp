@@ -61,7 +61,7 @@ bool AP_Airspeed_MS4525::init()
         hal.scheduler->delay(10);
         _collect();
 
-        found = (_last_sample_time_ms != 0);
+        found = (last_sample_ms() != 0);
         if (found) {
             printf("MS4525: Found sensor on bus %u address 0x%02x\n", addresses[i].bus, addresses[i].addr);
             break;
@@ -126,11 +126,21 @@ void AP_Airspeed_MS4525::_collect()
 
     _measurement_started_ms = 0;
 
-    if (!_dev->transfer(nullptr, 0, data, sizeof(data))) {
-        return;
+    /*
+      read the data, then reread it so we can attempt to detect bad
+      inputs, and start a new measurement, all in one batch
+     */
+    uint8_t cmd = 0;
+    const AP_HAL::Device::BatchTransfer transfers[] {
+        { nullptr, 0, data, sizeof(data) },
+        { nullptr, 0, data2, sizeof(data2) },
+        { &cmd, 1, nullptr, 0 },
+    };
+    const uint8_t done = _dev->transfer_batch(transfers, ARRAY_SIZE(transfers));
+    if (done == ARRAY_SIZE(transfers)) {
+        _measurement_started_ms = AP_HAL::millis();
     }
-    // reread the data, so we can attempt to detect bad inputs
-    if (!_dev->transfer(nullptr, 0, data2, sizeof(data2))) {
+    if (done < 2) {
         return;
     }
 
@@ -173,14 +183,7 @@ void AP_Airspeed_MS4525::_collect()
     _voltage_correction(press, temp);
     _voltage_correction(press2, temp2);
 
-    WITH_SEMAPHORE(sem);
-
-    _press_sum += press + press2;
-    _temp_sum += temp + temp2;
-    _press_count += 2;
-    _temp_count += 2;
-
-    _last_sample_time_ms = AP_HAL::millis();
+    add_sample((press + press2) * 0.5f, (temp + temp2) * 0.5f);
 }
 
 /**
@@ -214,46 +217,22 @@ void AP_Airspeed_MS4525::_timer()
         return;
     }
     if ((AP_HAL::millis() - _measurement_started_ms) > 10) {
+        // collect also starts a new measurement
         _collect();
-        // start a new measurement
-        _measure();
+        if (_measurement_started_ms == 0) {
+            _measure();
+        }
     }
 }
 
 // return the current differential_pressure in Pascal
 bool AP_Airspeed_MS4525::get_differential_pressure(float &pressure)
 {
-    if ((AP_HAL::millis() - _last_sample_time_ms) > 100) {
-        return false;
-    }
-
-    WITH_SEMAPHORE(sem);
-
-    if (_press_count > 0) {
-        _pressure = _press_sum / _press_count;
-        _press_count = 0;
-        _press_sum = 0;
-    }
-
-    pressure = _pressure;
-    return true;
+    return get_average_pressure(pressure);
 }
 
 // return the current temperature in degrees C, if available
 bool AP_Airspeed_MS4525::get_temperature(float &temperature)
 {
-    if ((AP_HAL::millis() - _last_sample_time_ms) > 100) {
-        return false;
-    }
-
-    WITH_SEMAPHORE(sem);
-
-    if (_temp_count > 0) {
-        _temperature = _temp_sum / _temp_count;
-        _temp_count = 0;
-        _temp_sum = 0;
-    }
-
-    temperature = _temperature;
-    return true;
+    return get_average_temperature(temperature);
 }
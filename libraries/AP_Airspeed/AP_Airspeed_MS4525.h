@@ -41,6 +41,9 @@ public:
     // return the current temperature in degrees C, if available
     bool get_temperature(float &temperature) override;
 
+    // return the differential pressure in Pascal filtered at each sample
+    bool get_filtered_pressure(float &pressure) override { return get_sample_filtered_pressure(pressure); }
+
 private:
     void _measure();
     void _collect();
@@ -49,13 +52,6 @@ private:
     float _get_pressure(int16_t dp_raw) const;
     float _get_temperature(int16_t dT_raw) const;
 
-    float _temp_sum;
-    float _press_sum;
-    uint32_t _temp_count;
-    uint32_t _press_count;
-    float _temperature;
-    float _pressure;
-    uint32_t _last_sample_time_ms;
     uint32_t _measurement_started_ms;
     AP_HAL::OwnPtr<AP_HAL::I2CDevice> _dev;
 };
@@ -218,13 +218,7 @@ void AP_Airspeed_MS5525::calculate(void)
     }
 #endif
     
-    WITH_SEMAPHORE(sem);
-
-    pressure_sum += P_Pa;
-    temperature_sum += Temp_C;
-    press_count++;
-    temp_count++;
-    last_sample_time_ms = AP_HAL::millis();
+    add_sample(P_Pa, Temp_C);
 }
 
 // 80Hz timer
@@ -283,37 +277,11 @@ void AP_Airspeed_MS5525::timer()
 // return the current differential_pressure in Pascal
 bool AP_Airspeed_MS5525::get_differential_pressure(float &_pressure)
 {
-    if ((AP_HAL::millis() - last_sample_time_ms) > 100) {
-        return false;
-    }
-
-    WITH_SEMAPHORE(sem);
-
-    if (press_count > 0) {
-        pressure = pressure_sum / press_count;
-        press_count = 0;
-        pressure_sum = 0;
-    }
-    _pressure = pressure;
-
-    return true;
+    return get_average_pressure(_pressure);
 }
 
 // return the current temperature in degrees C, if available
 bool AP_Airspeed_MS5525::get_temperature(float &_temperature)
 {
-    if ((AP_HAL::millis() - last_sample_time_ms) > 100) {
-        return false;
-    }
-
-    WITH_SEMAPHORE(sem);
-
-    if (temp_count > 0) {
-        temperature = temperature_sum / temp_count;
-        temp_count = 0;
-        temperature_sum = 0;
-    }
-
-    _temperature = temperature;
-    return true;
+    return get_average_temperature(_temperature);
 }
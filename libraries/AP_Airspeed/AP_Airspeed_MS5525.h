@@ -47,6 +47,11 @@ public:
     // return the current temperature in degrees C, if available
     bool get_temperature(float &temperature) override;
 
+    // return the differential pressure filtered at each sample
+    bool get_filtered_pressure(float &pressure) override {
+        return get_sample_filtered_pressure(pressure);
+    }
+
 private:
     void measure();
     void collect();
@@ -56,15 +61,6 @@ private:
     int32_t read_adc();
     void calculate();
 
-    float pressure;
-    float temperature;
-    float temperature_sum;
-    float pressure_sum;
-    uint32_t temp_count;
-    uint32_t press_count;
-    
-    uint32_t last_sample_time_ms;
-
     uint16_t prom[8];
     uint8_t state;
     int32_t D1;
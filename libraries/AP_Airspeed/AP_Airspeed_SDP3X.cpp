@@ -163,7 +163,7 @@ void AP_Airspeed_SDP3X::_timer()
     int ret = _dev->transfer(nullptr, 0, &val[0], sizeof(val));
     uint32_t now = AP_HAL::millis();
     if (!ret) {
-        if (now - _last_sample_time_ms > 200) {
+        if (now - last_sample_ms() > 200) {
             // try and re-connect
             _send_command(SDP3X_CONT_MEAS_AVG_MODE);
         }
@@ -180,13 +180,7 @@ void AP_Airspeed_SDP3X::_timer()
     float diff_press_pa = float(P) / float(_scale);
     float temperature = float(temp) / SDP3X_SCALE_TEMPERATURE;
 
-    WITH_SEMAPHORE(sem);
-
-    _press_sum += diff_press_pa;
-    _temp_sum += temperature;
-    _press_count++;
-    _temp_count++;
-    _last_sample_time_ms = now;
+    add_sample(diff_press_pa, temperature);
 }
 
 /*
@@ -274,40 +268,30 @@ float AP_Airspeed_SDP3X::_correct_pressure(float press)
 // return the current differential_pressure in Pascal
 bool AP_Airspeed_SDP3X::get_differential_pressure(float &pressure)
 {
-    uint32_t now = AP_HAL::millis();
-    if (now - _last_sample_time_ms > 100) {
+    float press;
+    if (!get_average_pressure(press)) {
         return false;
     }
-
-    {
-        WITH_SEMAPHORE(sem);
-        if (_press_count > 0) {
-            _press = _press_sum / _press_count;
-            _press_count = 0;
-            _press_sum = 0;
-        }
-    }
-
-    pressure = _correct_pressure(_press);
+    pressure = _correct_pressure(press);
     return true;
 }
 
 // return the current temperature in degrees C, if available
 bool AP_Airspeed_SDP3X::get_temperature(float &temperature)
 {
-    if ((AP_HAL::millis() - _last_sample_time_ms) > 100) {
-        return false;
-    }
-
-    WITH_SEMAPHORE(sem);
+    return get_average_temperature(temperature);
+}
 
-    if (_temp_count > 0) {
-        _temp = _temp_sum / _temp_count;
-        _temp_count = 0;
-        _temp_sum = 0;
+// return the differential pressure filtered at each sample, with the
+// same correction as the average. The correction is nearly linear
+// over the filter's time constant
+bool AP_Airspeed_SDP3X::get_filtered_pressure(float &pressure)
+{
+    float press;
+    if (!get_sample_filtered_pressure(press)) {
+        return false;
     }
-
-    temperature = _temp;
+    pressure = _correct_pressure(press);
     return true;
 }
 
@@ -46,19 +46,15 @@ public:
     // return the current temperature in degrees C, if available
     bool get_temperature(float &temperature) override;
 
+    // return the differential pressure filtered at each sample
+    bool get_filtered_pressure(float &pressure) override;
+
 private:
     void _timer();
     bool _send_command(uint16_t cmd);
     bool _crc(const uint8_t data[], unsigned size, uint8_t checksum);
     float _correct_pressure(float press);
 
-    float _temp;
-    float _press;
-    uint16_t _temp_count;
-    uint16_t _press_count;
-    float _temp_sum;
-    float _press_sum;
-    uint32_t _last_sample_time_ms;
     uint16_t _scale;
 
     AP_HAL::OwnPtr<AP_HAL::I2CDevice> _dev;
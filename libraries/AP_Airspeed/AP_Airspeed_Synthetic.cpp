@@ -0,0 +1,47 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_Airspeed_Synthetic.h"
+#include <AP_Math/AP_Math.h>
+
+void AP_Airspeed_Synthetic::predict(float accel_x, float pitch, float dt)
+{
+    if (!_have_reference) {
+        return;
+    }
+    const float deriv = accel_x - GRAVITY_MSS * sinf(pitch) +
+        (_reference - _airspeed) / AIRSPEED_SYNTHETIC_TAU;
+    _airspeed = MAX(_airspeed + deriv * dt, 0);
+}
+
+void AP_Airspeed_Synthetic::set_reference(float airspeed, uint32_t now_ms)
+{
+    if (!_have_reference) {
+        // start from the reference
+        _airspeed = airspeed;
+        _have_reference = true;
+    }
+    _reference = airspeed;
+    _reference_ms = now_ms;
+}
+
+bool AP_Airspeed_Synthetic::get_airspeed(float &airspeed, uint32_t now_ms) const
+{
+    if (!_have_reference || now_ms - _reference_ms > AIRSPEED_SYNTHETIC_TIMEOUT_MS) {
+        return false;
+    }
+    airspeed = _airspeed;
+    return true;
+}
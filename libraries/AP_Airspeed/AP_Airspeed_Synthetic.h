@@ -0,0 +1,54 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+  synthetic airspeed, estimated without an airspeed sensor for use
+  when there is none or it has failed. The forward specific force from
+  the IMU, less gravity, is integrated at each update of the AHRS and
+  pulled towards a slower reference airspeed, that from the GPS
+  velocity less the wind estimate, with a time constant of
+  AIRSPEED_SYNTHETIC_TAU seconds. The integration smooths the noise of
+  the reference and carries the estimate over short losses of it
+ */
+
+#include <stdint.h>
+
+// time constant of the pull towards the reference airspeed
+#define AIRSPEED_SYNTHETIC_TAU          3.0f
+// the estimate is invalid once the reference is older than this
+#define AIRSPEED_SYNTHETIC_TIMEOUT_MS   5000
+
+class AP_Airspeed_Synthetic {
+public:
+    // advance the estimate by dt seconds, given the forward specific
+    // force in m/s/s and the pitch in radians
+    void predict(float accel_x, float pitch, float dt);
+
+    // set the reference airspeed in m/s at time now_ms
+    void set_reference(float airspeed, uint32_t now_ms);
+
+    // return the estimated airspeed in m/s, if there is a recent
+    // reference
+    bool get_airspeed(float &airspeed, uint32_t now_ms) const;
+
+    void reset(void) { _have_reference = false; }
+
+private:
+    float _airspeed;
+    float _reference;
+    uint32_t _reference_ms;
+    bool _have_reference;
+};
@@ -0,0 +1,65 @@
+#include <AP_gtest.h>
+
+#include <AP_Airspeed/AP_Airspeed_Synthetic.h>
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+TEST(AirspeedSyntheticTest, Reference)
+{
+    AP_Airspeed_Synthetic synthetic;
+    float airspeed;
+
+    // invalid until there is a reference
+    synthetic.predict(1.0f, 0, 0.01f);
+    EXPECT_FALSE(synthetic.get_airspeed(airspeed, 0));
+
+    // starts from the reference, and is invalid once it is stale
+    synthetic.set_reference(20.0f, 1000);
+    EXPECT_TRUE(synthetic.get_airspeed(airspeed, 1000));
+    EXPECT_FLOAT_EQ(20.0f, airspeed);
+    EXPECT_TRUE(synthetic.get_airspeed(airspeed, 1000 + AIRSPEED_SYNTHETIC_TIMEOUT_MS));
+    EXPECT_FALSE(synthetic.get_airspeed(airspeed, 1001 + AIRSPEED_SYNTHETIC_TIMEOUT_MS));
+
+    // converges on a new reference when not accelerating
+    synthetic.set_reference(25.0f, 2000);
+    for (uint16_t i=0; i<400*5*AIRSPEED_SYNTHETIC_TAU; i++) {
+        synthetic.predict(0, 0, 0.0025f);
+    }
+    EXPECT_TRUE(synthetic.get_airspeed(airspeed, 2000));
+    EXPECT_NEAR(25.0f, airspeed, 0.2f);
+}
+
+TEST(AirspeedSyntheticTest, Accel)
+{
+    AP_Airspeed_Synthetic synthetic;
+    float airspeed;
+
+    // follows an acceleration the reference lags behind
+    synthetic.set_reference(20.0f, 0);
+    for (uint16_t i=0; i<400; i++) {
+        synthetic.predict(2.0f, 0, 0.0025f);
+    }
+    EXPECT_TRUE(synthetic.get_airspeed(airspeed, 0));
+    EXPECT_GT(airspeed, 21.5f);
+    EXPECT_LT(airspeed, 22.0f);
+
+    // the specific force holding a steady climb adds no speed
+    synthetic.reset();
+    synthetic.set_reference(20.0f, 0);
+    const float pitch = radians(10);
+    for (uint16_t i=0; i<400; i++) {
+        synthetic.predict(GRAVITY_MSS * sinf(pitch), pitch, 0.0025f);
+    }
+    EXPECT_TRUE(synthetic.get_airspeed(airspeed, 0));
+    EXPECT_NEAR(20.0f, airspeed, 0.01f);
+
+    // never negative
+    for (uint16_t i=0; i<4000; i++) {
+        synthetic.predict(-20.0f, 0, 0.0025f);
+    }
+    EXPECT_TRUE(synthetic.get_airspeed(airspeed, 0));
+    EXPECT_GE(airspeed, 0);
+}
+
+AP_GTEST_MAIN()
@@ -44,6 +44,7 @@
 #define AP_ARMING_BOARD_VOLTAGE_MAX     5.8f
 #define AP_ARMING_ACCEL_ERROR_THRESHOLD 0.75f
 #define AP_ARMING_AHRS_GPS_ERROR_MAX    10      // accept up to 10m difference between AHRS and GPS
+#define AP_ARMING_PREARM_CHECKS_PER_CALL 3      // slow pre-arm checks made in each unreported call
 
 #if APM_BUILD_TYPE(APM_BUILD_ArduPlane)
   #define ARMING_RUDDER_DEFAULT         (uint8_t)RudderArming::ARMONLY
@@ -589,7 +590,7 @@ bool AP_Arming::mission_checks(bool report)
     return true;
 }
 
-bool AP_Arming::servo_checks(bool report) const
+bool AP_Arming::servo_checks(bool report)
 {
     bool check_passed = true;
     for (uint8_t i = 0; i < NUM_SERVO_CHANNELS; i++) {
@@ -722,6 +723,57 @@ bool AP_Arming::fence_checks(bool display_failure)
     return false;
 }
 
+const AP_Arming::PrearmCheck AP_Arming::prearm_check_table[] = {
+    { &AP_Arming::hardware_safety_check,     0 },
+    { &AP_Arming::barometer_checks,          0 },
+    { &AP_Arming::ins_checks,                2000 },
+    { &AP_Arming::compass_checks,            2000 },
+    { &AP_Arming::gps_checks,                2000 },
+    { &AP_Arming::battery_checks,            2000 },
+    { &AP_Arming::logging_checks,            0 },
+    { &AP_Arming::manual_transmitter_checks, 0 },
+    { &AP_Arming::mission_checks,            10000 },
+    { &AP_Arming::servo_checks,              5000 },
+    { &AP_Arming::board_voltage_checks,      0 },
+    { &AP_Arming::system_checks,             0 },
+    { &AP_Arming::can_checks,                2000 },
+};
+
+/*
+  a summary of the parameters and sensor health the cached pre-arm
+  results depend on. When it changes all the checks are made again
+ */
+uint32_t AP_Arming::prearm_signature() const
+{
+    const AP_InertialSensor &ins = AP::ins();
+    const Compass &compass = AP::compass();
+    const AP_GPS &gps = AP::gps();
+
+    uint32_t sig = checks_to_perform.get();
+    sig = sig * 31 + (uint32_t)_required_mission_items.get();
+    sig = sig * 31 + (uint32_t)(accel_error_threshold.get() * 1000);
+    sig = sig * 31 + (AP::baro().all_healthy() ? 1 : 0);
+    sig = sig * 31 + (ins.get_gyro_health_all() ? 1 : 0);
+    sig = sig * 31 + (ins.get_accel_health_all() ? 1 : 0);
+    sig = sig * 31 + (ins.accel_cal_requires_reboot() ? 1 : 0);
+    sig = sig * 31 + (compass.healthy() ? 1 : 0);
+    sig = sig * 31 + (compass.is_calibrating() ? 1 : 0);
+    sig = sig * 31 + (compass.compass_cal_requires_reboot() ? 1 : 0);
+    sig = sig * 31 + (uint32_t)gps.status();
+    sig = sig * 31 + (gps.is_healthy() ? 1 : 0);
+    sig = sig * 31 + (AP::ahrs().home_is_set() ? 1 : 0);
+    sig = sig * 31 + (AP_Notify::flags.failsafe_radio ? 1 : 0);
+    const AP_Mission *mission = AP::mission();
+    if (mission != nullptr) {
+        sig = sig * 31 + mission->last_change_time_ms();
+    }
+    const AP_Rally *rally = AP::rally();
+    if (rally != nullptr) {
+        sig = sig * 31 + rally->last_change_time_ms();
+    }
+    return sig;
+}
+
 bool AP_Arming::pre_arm_checks(bool report)
 {
 #if !APM_BUILD_TYPE(APM_BUILD_ArduCopter)
@@ -732,19 +784,53 @@ bool AP_Arming::pre_arm_checks(bool report)
     }
 #endif
 
-    return hardware_safety_check(report)
-        &  barometer_checks(report)
-        &  ins_checks(report)
-        &  compass_checks(report)
-        &  gps_checks(report)
-        &  battery_checks(report)
-        &  logging_checks(report)
-        &  manual_transmitter_checks(report)
-        &  mission_checks(report)
-        &  servo_checks(report)
-        &  board_voltage_checks(report)
-        &  system_checks(report)
-        &  can_checks(report);
+    static_assert(ARRAY_SIZE(prearm_check_table) == num_prearm_checks, "prearm_check_table size");
+
+    const uint32_t signature = prearm_signature();
+    if (signature != last_prearm_signature) {
+        last_prearm_signature = signature;
+        prearm_valid = 0;
+    }
+
+    /*
+      checks without a result are always made. Slow checks whose
+      result is out of date are made a few at a time when not
+      reporting, so the periodic checks are spread across calls. When
+      reporting, as when arming, every check not known to pass is
+      made, so that all failures are reported
+     */
+    const uint32_t now_ms = AP_HAL::millis();
+    uint8_t slow_checks = 0;
+    uint8_t next = prearm_next;
+    for (uint8_t n=0; n<num_prearm_checks; n++) {
+        const uint8_t i = (prearm_next + n) % num_prearm_checks;
+        const PrearmCheck &check = prearm_check_table[i];
+        const uint16_t mask = 1U << i;
+        if (check.max_age_ms != 0 && (prearm_valid & mask)) {
+            const bool fresh = now_ms - prearm_run_ms[i] < check.max_age_ms;
+            if (fresh && (!report || (prearm_passed & mask))) {
+                continue;
+            }
+            if (!report) {
+                if (slow_checks >= AP_ARMING_PREARM_CHECKS_PER_CALL) {
+                    continue;
+                }
+                slow_checks++;
+                next = (i + 1) % num_prearm_checks;
+            }
+        }
+        if ((this->*check.fn)(report)) {
+            prearm_passed |= mask;
+        } else {
+            prearm_passed &= ~mask;
+        }
+        prearm_valid |= mask;
+        prearm_run_ms[i] = now_ms;
+    }
+    prearm_next = next;
+
+    const uint16_t all_checks = (1U << num_prearm_checks) - 1;
+    return (prearm_passed & all_checks) == all_checks;
 }
 
 bool AP_Arming::arm_checks(AP_Arming::Method method)
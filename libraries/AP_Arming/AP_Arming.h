@@ -121,7 +121,7 @@ protected:
 
     bool can_checks(bool report);
     
-    bool servo_checks(bool report) const;
+    bool servo_checks(bool report);
     bool rc_checks_copter_sub(bool display_failure, const RC_Channel *channels[4]) const;
 
     // returns true if a particular check is enabled
@@ -133,6 +133,27 @@ protected:
 
 private:
 
+    /*
+      the checks made by pre_arm_checks(). Each result is kept, and
+      the check is only made again once the result is max_age_ms old,
+      or when the state summarised by prearm_signature() changes. A
+      max_age_ms of zero is for cheap checks made every time
+     */
+    struct PrearmCheck {
+        bool (AP_Arming::*fn)(bool report);
+        uint16_t max_age_ms;
+    };
+    static const PrearmCheck prearm_check_table[];
+    static const uint8_t num_prearm_checks = 13;
+
+    uint32_t prearm_signature() const;
+
+    uint16_t prearm_valid;      // checks with a result
+    uint16_t prearm_passed;     // checks whose result is a pass
+    uint32_t prearm_run_ms[num_prearm_checks];
+    uint32_t last_prearm_signature;
+    uint8_t prearm_next;        // slow check to start from next call
+
     bool ins_accels_consistent(const AP_InertialSensor &ins);
     bool ins_gyros_consistent(const AP_InertialSensor &ins);
 
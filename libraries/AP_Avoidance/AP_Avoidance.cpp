@@ -150,6 +150,9 @@ void AP_Avoidance::init(void)
         }
         _obstacles_allocated = _obstacles_max;
     }
+    if (_perf_check_threats == nullptr) {
+        _perf_check_threats = hal.util->perf_alloc(AP_HAL::Util::PC_ELAPSED, "AVD_check_threats");
+    }
     _obstacle_count = 0;
     _last_state_change_ms = 0;
     _threat_level = MAV_COLLISION_THREAT_LEVEL_NONE;
@@ -280,9 +283,17 @@ float closest_approach_xy(const Location &my_loc,
                           const Vector3f &obstacle_vel,
                           const uint8_t time_horizon)
 {
+    return closest_approach_xy(obstacle_loc.get_distance_NE(my_loc), my_vel, obstacle_vel, time_horizon);
+}
+
+// as above, with delta_pos_ne the N/E offset in metres from the obstacle to us
+float closest_approach_xy(const Vector2f &delta_pos_ne,
+                          const Vector3f &my_vel,
+                          const Vector3f &obstacle_vel,
+                          const uint8_t time_horizon)
+{
 
     Vector2f delta_vel_ne = Vector2f(obstacle_vel[0] - my_vel[0], obstacle_vel[1] - my_vel[1]);
-    const Vector2f delta_pos_ne = obstacle_loc.get_distance_NE(my_loc);
 
     Vector2f line_segment_ne = delta_vel_ne * time_horizon;
 
@@ -327,7 +338,13 @@ float closest_approach_z(const Location &my_loc,
     return ret/100.0f;
 }
 
-void AP_Avoidance::update_threat_level(const Location &my_loc,
+/*
+  update the threat level and closest approach of an obstacle. Returns
+  false without working out the closest approach if the obstacle is
+  too far away to be a threat within the time horizons
+ */
+bool AP_Avoidance::update_threat_level(const Location &my_loc,
+                                       const LocationOrigin &my_origin,
                                        const Vector3f &my_vel,
                                        AP_Avoidance::Obstacle &obstacle)
 {
@@ -337,12 +354,27 @@ void AP_Avoidance::update_threat_level(const Location &my_loc,
 
     obstacle.threat_level = MAV_COLLISION_THREAT_LEVEL_NONE;
 
+    // the horizontal offset is the same for all the checks below
+    const Vector2f delta_pos_ne = -my_origin.get_distance_NE(obstacle_loc);
+    const float current_distance = delta_pos_ne.length();
+    const Vector2f net_velocity_ne = Vector2f(my_vel[0] - obstacle_vel[0], my_vel[1] - obstacle_vel[1]);
+
     const uint32_t obstacle_age = AP_HAL::millis() - obstacle.timestamp_ms;
-    float closest_xy = closest_approach_xy(my_loc, my_vel, obstacle_loc, obstacle_vel, _fail_time_horizon + obstacle_age/1000);
+
+    // the obstacle can't get closer than its distance less the
+    // relative speed times the longer time horizon. When that is
+    // outside both distances it can't be a threat, which is the case
+    // for most traffic in busy airspace
+    const uint32_t max_time_horizon = MAX(_fail_time_horizon.get(), _warn_time_horizon.get()) + obstacle_age/1000;
+    if (current_distance - net_velocity_ne.length() * max_time_horizon > MAX(_fail_distance_xy.get(), _warn_distance_xy.get())) {
+        return false;
+    }
+
+    float closest_xy = closest_approach_xy(delta_pos_ne, my_vel, obstacle_vel, _fail_time_horizon + obstacle_age/1000);
     if (closest_xy < _fail_distance_xy) {
         obstacle.threat_level = MAV_COLLISION_THREAT_LEVEL_HIGH;
     } else {
-        closest_xy = closest_approach_xy(my_loc, my_vel, obstacle_loc, obstacle_vel, _warn_time_horizon + obstacle_age/1000);
+        closest_xy = closest_approach_xy(delta_pos_ne, my_vel, obstacle_vel, _warn_time_horizon + obstacle_age/1000);
         if (closest_xy < _warn_distance_xy) {
             obstacle.threat_level = MAV_COLLISION_THREAT_LEVEL_LOW;
         }
@@ -371,14 +403,13 @@ void AP_Avoidance::update_threat_level(const Location &my_loc,
     // level is none - but only *once the GCS has been informed*!
     obstacle.closest_approach_xy = closest_xy;
     obstacle.closest_approach_z = closest_z;
-    float current_distance = my_loc.get_distance(obstacle_loc);
     obstacle.distance_to_closest_approach = current_distance - closest_xy;
-    Vector2f net_velocity_ne = Vector2f(my_vel[0] - obstacle_vel[0], my_vel[1] - obstacle_vel[1]);
     obstacle.time_to_closest_approach = 0.0f;
     if (!is_zero(obstacle.distance_to_closest_approach) &&
         ! is_zero(net_velocity_ne.length())) {
         obstacle.time_to_closest_approach = obstacle.distance_to_closest_approach / net_velocity_ne.length();
     }
+    return true;
 }
 
 MAV_COLLISION_THREAT_LEVEL AP_Avoidance::current_threat_level() const {
@@ -453,15 +484,17 @@ void AP_Avoidance::check_for_threats()
     // we always check all obstacles to see if they are threats since it
     // is most likely our own position and/or velocity have changed
     // determine the current most-serious-threat
+    hal.util->perf_begin(_perf_check_threats);
     _current_most_serious_threat = -1;
+    const LocationOrigin my_origin(my_loc);
     for (uint8_t i=0; i<_obstacle_count; i++) {
 
         AP_Avoidance::Obstacle &obstacle = _obstacles[i];
         const uint32_t obstacle_age = AP_HAL::millis() - obstacle.timestamp_ms;
         debug("i=%d src_id=%d timestamp=%u age=%d", i, obstacle.src_id, obstacle.timestamp_ms, obstacle_age);
 
-        update_threat_level(my_loc, my_vel, obstacle);
-        debug("   threat-level=%d", obstacle.threat_level);
+        const bool in_range = update_threat_level(my_loc, my_origin, my_vel, obstacle);
+        debug("   threat-level=%d in-range=%d", obstacle.threat_level, in_range);
 
         // ignore any really old data:
         if (obstacle_age > MAX_OBSTACLE_AGE_MS) {
@@ -472,10 +505,13 @@ void AP_Avoidance::check_for_threats()
             continue;
         }
 
-        if (obstacle_is_more_serious_threat(obstacle)) {
+        // obstacles out of range have no closest approach to
+        // compare, so are never the most serious threat
+        if (in_range && obstacle_is_more_serious_threat(obstacle)) {
             _current_most_serious_threat = i;
         }
     }
+    hal.util->perf_end(_perf_check_threats);
     if (_current_most_serious_threat != -1) {
         debug("Current most serious threat: %d level=%d", _current_most_serious_threat, _obstacles[_current_most_serious_threat].threat_level);
     }
@@ -160,7 +160,8 @@ private:
     uint32_t src_id_for_adsb_vehicle(AP_ADSB::adsb_vehicle_t vehicle) const;
 
     void check_for_threats();
-    void update_threat_level(const Location &my_loc,
+    bool update_threat_level(const Location &my_loc,
+                             const LocationOrigin &my_origin,
                              const Vector3f &my_vel,
                              AP_Avoidance::Obstacle &obstacle);
 
@@ -199,6 +200,9 @@ private:
 
     // multi-thread support for avoidance
     HAL_Semaphore_Recursive _rsem;
+
+    // time taken by check_for_threats()
+    AP_HAL::Util::perf_counter_t _perf_check_threats = nullptr;
 };
 
 float closest_distance_between_radial_and_point(const Vector2f &w,
@@ -208,6 +212,10 @@ float closest_approach_xy(const Location &my_loc,
                           const Location &obstacle_loc,
                           const Vector3f &obstacle_vel,
                           uint8_t time_horizon);
+float closest_approach_xy(const Vector2f &delta_pos_ne,
+                          const Vector3f &my_vel,
+                          const Vector3f &obstacle_vel,
+                          uint8_t time_horizon);
 
 float closest_approach_z(const Location &my_loc,
                          const Vector3f &my_vel,
@@ -26,11 +26,13 @@
 #ifdef HAVE_AP_BLHELI_SUPPORT
 
 #include <AP_Math/crc.h>
+#include <AP_HAL/utility/DShotTelem.h>
 #include <AP_Motors/AP_Motors_Class.h>
 #include <GCS_MAVLink/GCS_MAVLink.h>
 #include <GCS_MAVLink/GCS.h>
 #include <AP_SerialManager/AP_SerialManager.h>
 #include <AP_Logger/AP_Logger.h>
+#include <AP_ESC_Telem/AP_ESC_Telem.h>
 
 extern const AP_HAL::HAL& hal;
 
@@ -115,6 +117,14 @@ const AP_Param::GroupInfo AP_BLHeli::var_info[] = {
     // @User: Advanced
     AP_GROUPINFO("REMASK",  10, AP_BLHeli, channel_reversible_mask, 0),
 
+    // @Param: BDMASK
+    // @DisplayName: BLHeli bitmask of bidirectional DShot channels
+    // @Description: Mask of channels which use bidirectional DShot, where the ESC replies to each DShot frame with the motor speed on the same wire. This needs ESC firmware with bidirectional DShot support. The speed is used as ESC telemetry RPM, for instance by the harmonic notch
+    // @Bitmask: 0:Channel1,1:Channel2,2:Channel3,3:Channel4,4:Channel5,5:Channel6,6:Channel7,7:Channel8,8:Channel9,9:Channel10,10:Channel11,11:Channel12,12:Channel13,13:Channel14,14:Channel15,15:Channel16
+    // @User: Advanced
+    // @RebootRequired: True
+    AP_GROUPINFO("BDMASK",  11, AP_BLHeli, channel_bidir_mask, 0),
+
     AP_GROUPEND
 };
 
@@ -1261,6 +1271,7 @@ void AP_BLHeli::update(void)
     SRV_Channels::set_digital_mask(mask);
     SRV_Channels::set_reversible_mask(uint16_t(channel_reversible_mask.get()) & mask);
     hal.rcout->set_reversible_mask(channel_reversible_mask.get() & mask);
+    hal.rcout->set_bidir_dshot_mask(uint16_t(channel_bidir_mask.get()) & mask);
 
     // add motors from channel mask
     for (uint8_t i=0; i<16 && num_motors < max_motors; i++) {
@@ -1294,6 +1305,28 @@ bool AP_BLHeli::get_telem_data(uint8_t esc_index, struct telem_data &td)
     return true;
 }
 
+/*
+  get the average RPM over the motors with recent telemetry
+ */
+bool AP_BLHeli::get_average_rpm(float &rpm) const
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    uint32_t sum = 0;
+    uint8_t count = 0;
+    for (uint8_t i=0; i<max_motors; i++) {
+        const struct telem_data &td = last_telem[i];
+        if (td.timestamp_ms != 0 && now_ms - td.timestamp_ms < 1000) {
+            sum += td.rpm;
+            count++;
+        }
+    }
+    if (count == 0) {
+        return false;
+    }
+    rpm = float(sum) / count;
+    return true;
+}
+
 /*
   implement the 8 bit CRC used by the BLHeli ESC telemetry protocol
  */
@@ -1346,6 +1379,17 @@ void AP_BLHeli::read_telemetry_packet(void)
     last_telem[last_telem_esc] = td;
     last_telem[last_telem_esc].count++;
 
+    AP_ESC_Telem::TelemetryData t {};
+    t.temperature = td.temperature;
+    t.voltage = td.voltage * 0.01f;
+    t.current = td.current * 0.01f;
+    t.consumption_mah = td.consumption;
+    t.rpm = td.rpm;
+    AP::esc_telem().update_telem_data(last_telem_esc, t,
+                                      AP_ESC_Telem::TELEM_RPM | AP_ESC_Telem::TELEM_VOLTAGE | AP_ESC_Telem::TELEM_CURRENT |
+                                      AP_ESC_Telem::TELEM_CONSUMPTION | AP_ESC_Telem::TELEM_TEMPERATURE,
+                                      AP_ESC_Telem::Source::BLHELI);
+
     AP_Logger *logger = AP_Logger::get_singleton();
     if (logger && logger->logging_enabled()) {
         logger->Write_ESC(uint8_t(last_telem_esc),
@@ -1367,12 +1411,36 @@ void AP_BLHeli::read_telemetry_packet(void)
     }
 }
 
+/*
+  take the motor RPM from bidirectional DShot replies. These come
+  with every frame, so they replace the RPM from the much slower
+  serial telemetry
+ */
+void AP_BLHeli::read_bidir_rpm(void)
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    for (uint8_t i=0; i<num_motors; i++) {
+        const uint8_t chan = motor_map[i];
+        uint32_t erpm;
+        if (!(channel_bidir_mask & (1U<<chan)) ||
+            !hal.rcout->get_erpm(chan, erpm)) {
+            continue;
+        }
+        last_telem[i].rpm = MIN(DShotTelem::erpm_to_rpm(erpm, motor_poles), uint32_t(UINT16_MAX));
+        last_telem[i].timestamp_ms = now_ms;
+        AP::esc_telem().update_rpm(i, last_telem[i].rpm, AP_ESC_Telem::Source::BLHELI);
+    }
+}
+
 /*
   update BLHeli telemetry handling
   This is called on push() in SRV_Channels
  */
 void AP_BLHeli::update_telemetry(void)
 {
+    if (motor_mask & uint16_t(channel_bidir_mask.get())) {
+        read_bidir_rpm();
+    }
     if (!telem_uart) {
         return;
     }
@@ -58,6 +58,10 @@ public:
     // get the most recent telemetry data packet for a motor
     bool get_telem_data(uint8_t esc_index, struct telem_data &td);
 
+    // get the average RPM of the motors with telemetry in the last
+    // second. Returns false if there are none
+    bool get_average_rpm(float &rpm) const;
+
     static AP_BLHeli *get_singleton(void) {
         return _singleton;
     }
@@ -71,6 +75,7 @@ private:
     // mask of channels to use for BLHeli protocol
     AP_Int32 channel_mask;
     AP_Int32 channel_reversible_mask;
+    AP_Int32 channel_bidir_mask;
     AP_Int8 channel_auto;
     AP_Int8 run_test;
     AP_Int16 timeout_sec;
@@ -279,6 +284,7 @@ private:
     void run_connection_test(uint8_t chan);
     uint8_t telem_crc8(uint8_t crc, uint8_t crc_seed) const;
     void read_telemetry_packet(void);
+    void read_bidir_rpm(void);
     
     // protocol handler hook
     bool protocol_handler(uint8_t , AP_HAL::UARTDriver *);
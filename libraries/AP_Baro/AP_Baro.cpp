@@ -197,8 +197,10 @@ void AP_Baro::calibrate(bool save)
 
     // let the barometer settle for a full second after startup
     // the MS5611 reads quite a long way off for the first second,
-    // leading to about 1m of error if we don't wait
-    for (uint8_t i = 0; i < 10; i++) {
+    // leading to about 1m of error if we don't wait. The second is
+    // counted from init(), so the rest of vehicle startup between
+    // init() and calibrate() counts towards it
+    while (true) {
         uint32_t tstart = AP_HAL::millis();
         do {
             update();
@@ -208,6 +210,9 @@ void AP_Baro::calibrate(bool save)
             }
             hal.scheduler->delay(10);
         } while (!healthy());
+        if (AP_HAL::millis() - _init_ms >= 1000) {
+            break;
+        }
         hal.scheduler->delay(100);
     }
 
@@ -610,6 +615,9 @@ void AP_Baro::init(void)
     _probe_i2c_barometers();
 #endif
 
+    // the settling time in calibrate() counts from here
+    _init_ms = AP_HAL::millis();
+
 #if !defined(HAL_BARO_ALLOW_INIT_NO_BARO) // most boards requires external baro
 
     if (_num_drivers == 0 || _num_sensors == 0 || drivers[0] == nullptr) {
@@ -749,19 +757,29 @@ void AP_Baro::update(void)
             if (!is_positive(ground_pressure) || isnan(ground_pressure) || isinf(ground_pressure)) {
                 sensors[i].ground_pressure = sensors[i].pressure;
             }
-            float altitude = sensors[i].altitude;
             float corrected_pressure = sensors[i].pressure + sensors[i].p_correction;
-            if (sensors[i].type == BARO_TYPE_AIR) {
-                altitude = get_altitude_difference(sensors[i].ground_pressure, corrected_pressure);
-            } else if (sensors[i].type == BARO_TYPE_WATER) {
-                //101325Pa is sea level air pressure, 9800 Pascal/ m depth in water.
-                //No temperature or depth compensation for density of water.
-                altitude = (sensors[i].ground_pressure - corrected_pressure) / 9800.0f / _specific_gravity;
+            // the altitude only needs recalculating when there is a
+            // new sample or the ground pressure has changed
+            if (!is_equal(corrected_pressure, sensors[i].alt_pressure) ||
+                !is_equal(sensors[i].ground_pressure.get(), sensors[i].alt_ground_pressure)) {
+                float altitude = sensors[i].alt_no_offset;
+                if (sensors[i].type == BARO_TYPE_AIR) {
+                    altitude = get_altitude_difference(sensors[i].ground_pressure, corrected_pressure);
+                } else if (sensors[i].type == BARO_TYPE_WATER) {
+                    //101325Pa is sea level air pressure, 9800 Pascal/ m depth in water.
+                    //No temperature or depth compensation for density of water.
+                    altitude = (sensors[i].ground_pressure - corrected_pressure) / 9800.0f / _specific_gravity;
+                }
+                // sanity check altitude
+                sensors[i].alt_ok = !(isnan(altitude) || isinf(altitude));
+                sensors[i].alt_pressure = corrected_pressure;
+                sensors[i].alt_ground_pressure = sensors[i].ground_pressure;
+                if (sensors[i].alt_ok) {
+                    sensors[i].alt_no_offset = altitude;
+                }
             }
-            // sanity check altitude
-            sensors[i].alt_ok = !(isnan(altitude) || isinf(altitude));
             if (sensors[i].alt_ok) {
-                sensors[i].altitude = altitude + _alt_offset_active;
+                sensors[i].altitude = sensors[i].alt_no_offset + _alt_offset_active;
             }
         }
         if (_hil.have_alt) {
@@ -772,9 +790,10 @@ void AP_Baro::update(void)
         }
     }
 
-    // ensure the climb rate filter is updated
-    if (healthy()) {
+    // ensure the climb rate filter is updated, it only takes new samples
+    if (healthy() && have_new_sample(_primary, _climb_rate_sample_count)) {
         _climb_rate_filter.update(get_altitude(), get_last_update());
+        _climb_rate_sample_count = get_sample_count(_primary);
     }
 
     // choose primary sensor
@@ -116,6 +116,13 @@ public:
     uint32_t get_last_update(void) const { return get_last_update(_primary); }
     uint32_t get_last_update(uint8_t instance) const { return sensors[instance].last_update_ms; }
 
+    // number of samples published by an instance. A consumer that
+    // keeps the count it last read can check for new data with
+    // have_new_sample()
+    uint32_t get_sample_count(void) const { return get_sample_count(_primary); }
+    uint32_t get_sample_count(uint8_t instance) const { return sensors[instance].sample_count; }
+    bool have_new_sample(uint8_t instance, uint32_t sample_count) const { return sensors[instance].sample_count != sample_count; }
+
     // settable parameters
     static const struct AP_Param::GroupInfo var_info[];
 
@@ -223,6 +230,12 @@ private:
         float altitude;                 // calculated altitude
         AP_Float ground_pressure;
         float p_correction;
+        uint32_t sample_count;          // incremented for each new sample from the backend
+        // inputs and result of the last altitude calculation, so it
+        // is only redone when they change
+        float alt_pressure;
+        float alt_ground_pressure;
+        float alt_no_offset;
     } sensors[BARO_MAX_INSTANCES];
 
     AP_Float                            _alt_offset;
@@ -234,6 +247,7 @@ private:
     float                               _external_temperature;
     uint32_t                            _last_external_temperature_ms;
     DerivativeFilterFloat_Size7         _climb_rate_filter;
+    uint32_t                            _climb_rate_sample_count;   // sample count of the last climb rate filter update
     AP_Float                            _specific_gravity; // the specific gravity of fluid for an ROV 1.00 for freshwater, 1.024 for salt water
     AP_Float                            _user_ground_temperature; // user override of the ground temperature used for EAS2TAS
     bool                                _hil_mode:1;
@@ -242,6 +256,9 @@ private:
     // when did we last notify the GCS of new pressure reference?
     uint32_t                            _last_notify_ms;
 
+    // time init() finished probing for sensors
+    uint32_t                            _init_ms;
+
     bool _add_backend(AP_Baro_Backend *backend);
     void _probe_i2c_barometers(void);
     AP_Int8                            _filter_range;  // valid value range from mean value
@@ -51,6 +51,7 @@ void AP_Baro_Backend::_copy_to_frontend(uint8_t instance, float pressure, float
     _frontend.sensors[instance].pressure = pressure;
     _frontend.sensors[instance].temperature = temperature;
     _frontend.sensors[instance].last_update_ms = now;
+    _frontend.sensors[instance].sample_count++;
 }
 
 static constexpr float FILTER_KOEF = 0.1f;
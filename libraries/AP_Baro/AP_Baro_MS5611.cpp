@@ -188,15 +188,6 @@ uint16_t AP_Baro_MS56XX::_read_prom_word(uint8_t word)
     return (val[0] << 8) | val[1];
 }
 
-uint32_t AP_Baro_MS56XX::_read_adc()
-{
-    uint8_t val[3];
-    if (!_dev->transfer(&CMD_MS56XX_READ_ADC, 1, val, sizeof(val))) {
-        return 0;
-    }
-    return (val[0] << 16) | (val[1] << 8) | val[2];
-}
-
 bool AP_Baro_MS56XX::_read_prom_5611(uint16_t prom[8])
 {
     /*
@@ -271,8 +262,24 @@ bool AP_Baro_MS56XX::_read_prom_5637(uint16_t prom[8])
 void AP_Baro_MS56XX::_timer(void)
 {
     uint8_t next_cmd;
-    uint8_t next_state;
-    uint32_t adc_val = _read_adc();
+    uint8_t next_state = (_state + 1) % 5;
+    uint8_t val[3];
+
+    /*
+     * read the ADC and start the next conversion in one batch,
+     * assuming the read will succeed
+     */
+    next_cmd = next_state == 0 ? ADDR_CMD_CONVERT_TEMPERATURE
+                               : ADDR_CMD_CONVERT_PRESSURE;
+    const AP_HAL::Device::BatchTransfer transfers[] {
+        { &CMD_MS56XX_READ_ADC, 1, val, sizeof(val) },
+        { &next_cmd, 1, nullptr, 0 },
+    };
+    const uint8_t done = _dev->transfer_batch(transfers, ARRAY_SIZE(transfers));
+    uint32_t adc_val = 0;
+    if (done > 0) {
+        adc_val = (val[0] << 16) | (val[1] << 8) | val[2];
+    }
 
     /*
      * If read fails, re-initiate a read command for current state or we are
@@ -280,13 +287,12 @@ void AP_Baro_MS56XX::_timer(void)
      */
     if (adc_val == 0) {
         next_state = _state;
-    } else {
-        next_state = (_state + 1) % 5;
-    }
-
-    next_cmd = next_state == 0 ? ADDR_CMD_CONVERT_TEMPERATURE
-                               : ADDR_CMD_CONVERT_PRESSURE;
-    if (!_dev->transfer(&next_cmd, 1, nullptr, 0)) {
+        next_cmd = next_state == 0 ? ADDR_CMD_CONVERT_TEMPERATURE
+                                   : ADDR_CMD_CONVERT_PRESSURE;
+        if (!_dev->transfer(&next_cmd, 1, nullptr, 0)) {
+            return;
+        }
+    } else if (done < 2) {
         return;
     }
 
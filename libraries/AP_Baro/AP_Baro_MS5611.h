@@ -61,7 +61,6 @@ private:
     bool _read_prom_5637(uint16_t prom[8]);
 
     uint16_t _read_prom_word(uint8_t word);
-    uint32_t _read_adc();
 
     void _timer();
 
@@ -60,7 +60,7 @@ void AP_Baro_SITL::_timer()
     }
 
     sim_alt += _sitl->baro_drift * now / 1000.0f;
-    sim_alt += _sitl->baro_noise * rand_float();
+    sim_alt += _sitl->baro_noise * _noise.next();
 
     // add baro glitch
     sim_alt += _sitl->baro_glitch;
@@ -4,6 +4,7 @@
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
 #include <SITL/SITL.h>
+#include <SITL/SITL_Noise.h>
 #include <AP_Math/vectorN.h>
 
 class AP_Baro_SITL : public AP_Baro_Backend {
@@ -19,6 +20,7 @@ protected:
 private:
     uint8_t _instance;
     SITL::SITL *_sitl;
+    SITL::Noise _noise;
 
     // barometer delay buffer variables
     struct readings_baro {
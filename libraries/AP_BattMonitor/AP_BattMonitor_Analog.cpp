@@ -38,6 +38,23 @@ AP_BattMonitor_Analog::read()
         // this copes with changing the pin at runtime
         _curr_pin_analog_source->set_pin(_params._curr_pin);
 
+        // if the analog input integrates the current sensor at the rate
+        // of the ADC then the charge drawn is exact, however often this
+        // is called, and the current is its average over the same time
+        float integral;
+        uint32_t interval_us;
+        if (_curr_pin_analog_source->voltage_integral(integral, interval_us)) {
+            const float interval = interval_us * 1.0e-6f;
+            const float amp_sec = (integral - _params._curr_amp_offset * interval) * _params._curr_amp_per_volt;
+            _state.current_amps = amp_sec / interval;
+            // .2778 is 1000/3600 (conversion from amp seconds to mAh)
+            const float mah = amp_sec * 0.2778f;
+            _state.consumed_mah += mah;
+            _state.consumed_wh  += 0.001f * mah * _state.voltage;
+            _state.last_time_micros = tnow;
+            return;
+        }
+
         // read current
         _state.current_amps = (_curr_pin_analog_source->voltage_average()-_params._curr_amp_offset)*_params._curr_amp_per_volt;
 
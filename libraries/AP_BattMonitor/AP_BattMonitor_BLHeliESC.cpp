@@ -16,6 +16,7 @@
 
 #include <AP_HAL/AP_HAL.h>
 #include <AP_BLHeli/AP_BLHeli.h>
+#include <AP_ESC_Telem/AP_ESC_Telem.h>
 
 #ifdef HAVE_AP_BLHELI_SUPPORT
 
@@ -29,10 +30,7 @@ void AP_BattMonitor_BLHeliESC::init(void)
 
 void AP_BattMonitor_BLHeliESC::read(void)
 {
-    AP_BLHeli *blheli = AP_BLHeli::get_singleton();
-    if (!blheli) {
-        return;
-    }
+    const AP_ESC_Telem &esc_telem = AP::esc_telem();
 
     uint8_t num_escs = 0;
     float voltage_sum = 0;
@@ -42,17 +40,17 @@ void AP_BattMonitor_BLHeliESC::read(void)
     uint32_t now = AP_HAL::millis();
     uint32_t highest_ms = 0;
 
-    for (uint8_t i=0; i<AP_BLHELI_MAX_ESCS; i++) {
-        AP_BLHeli::telem_data td;
-        if (!blheli->get_telem_data(i, td)) {
+    for (uint8_t i=0; i<ESC_TELEM_MAX_ESCS; i++) {
+        AP_ESC_Telem::TelemetryData td;
+        if (!esc_telem.get_telem_data(i, td)) {
             continue;
         }
 
         // accumulate consumed_sum regardless of age, to cope with ESC
         // dropping out
-        consumed_sum += td.consumption;
+        consumed_sum += td.consumption_mah;
 
-        if (now - td.timestamp_ms > 1000) {
+        if (now - td.last_update_ms > 1000) {
             // don't use old data
             continue;
         }
@@ -61,13 +59,13 @@ void AP_BattMonitor_BLHeliESC::read(void)
         voltage_sum += td.voltage;
         current_sum += td.current;
         temperature_sum += td.temperature;
-        if (td.timestamp_ms > highest_ms) {
-            highest_ms = td.timestamp_ms;
+        if (td.last_update_ms > highest_ms) {
+            highest_ms = td.last_update_ms;
         }
     }
 
     if (num_escs > 0) {
-        _state.voltage = (voltage_sum / num_escs) * 0.01;
+        _state.voltage = voltage_sum / num_escs;
         _state.temperature = temperature_sum / num_escs;
         _state.healthy = true;
     } else {
@@ -75,7 +73,7 @@ void AP_BattMonitor_BLHeliESC::read(void)
         _state.temperature = 0;
         _state.healthy = false;
     }
-    _state.current_amps = current_sum * 0.01;
+    _state.current_amps = current_sum;
     _state.consumed_mah = consumed_sum;
     _state.last_time_micros = highest_ms * 1000;
     _state.temperature_time = highest_ms;
@@ -122,6 +122,8 @@ void AP_Beacon::update(void)
     }
     _driver->update();
 
+    update_multilat();
+
     // update boundary for fence
     update_boundary_points();
 }
@@ -165,6 +167,54 @@ bool AP_Beacon::get_vehicle_position_ned(Vector3f &position, float& accuracy_est
     return true;
 }
 
+// solve for the position from the latest ranges to all beacons, once
+// there is a new one
+void AP_Beacon::update_multilat(void)
+{
+    static_assert(AP_BEACON_MAX_BEACONS <= AP_BEACON_MULTILAT_MAX_BEACONS, "too many beacons for multilateration");
+
+    const uint32_t now_ms = AP_HAL::millis();
+    Vector3f positions[AP_BEACON_MAX_BEACONS];
+    float ranges[AP_BEACON_MAX_BEACONS];
+    uint8_t n = 0;
+    uint32_t latest_ms = 0;
+    for (uint8_t i=0; i<num_beacons; i++) {
+        const BeaconState &bcn = beacon_state[i];
+        if (!bcn.healthy || now_ms - bcn.distance_update_ms > AP_BEACON_TIMEOUT_MS) {
+            continue;
+        }
+        positions[n] = bcn.position;
+        ranges[n] = bcn.distance;
+        multilat_index[n] = i;
+        n++;
+        latest_ms = MAX(latest_ms, bcn.distance_update_ms);
+    }
+    if (n < 3 || latest_ms == multilat_range_ms) {
+        return;
+    }
+    multilat_range_ms = latest_ms;
+    multilat_num_ranges = n;
+
+    // start from the last solution while it is valid, so coplanar
+    // beacons keep the vehicle on the same side of them
+    const Vector3f start = (now_ms - multilat_update_ms < AP_BEACON_TIMEOUT_MS) ? multilat_pos : Vector3f();
+    if (multilat.solve(positions, ranges, n, start, AP_BEACON_MULTILAT_GATE)) {
+        multilat_pos = multilat.position();
+        multilat_update_ms = now_ms;
+    }
+}
+
+// return position in NED from the ranges to all beacons
+bool AP_Beacon::get_multilat_position(Vector3f &pos, float &rms) const
+{
+    if (!device_ready() || AP_HAL::millis() - multilat_update_ms > AP_BEACON_TIMEOUT_MS) {
+        return false;
+    }
+    pos = multilat_pos;
+    rms = multilat.rms();
+    return true;
+}
+
 // return the number of beacons
 uint8_t AP_Beacon::count() const
 {
@@ -230,6 +280,18 @@ uint32_t AP_Beacon::beacon_last_update_ms(uint8_t beacon_instance) const
     return beacon_state[beacon_instance].distance_update_ms;
 }
 
+// return residual of beacon's range from the multilateration solution
+bool AP_Beacon::beacon_residual(uint8_t beacon_instance, float &residual) const
+{
+    for (uint8_t i=0; i<multilat_num_ranges; i++) {
+        if (multilat_index[i] == beacon_instance) {
+            residual = multilat.residual(i);
+            return multilat.used(i);
+        }
+    }
+    return false;
+}
+
 // create fence boundary points
 void AP_Beacon::update_boundary_points()
 {
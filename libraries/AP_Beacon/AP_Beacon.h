@@ -19,12 +19,22 @@
 #include <AP_Param/AP_Param.h>
 #include <AP_Math/AP_Math.h>
 #include <AP_SerialManager/AP_SerialManager.h>
+#include "AP_Beacon_Multilat.h"
 
 class AP_Beacon_Backend;
 
+#ifndef AP_BEACON_MAX_BEACONS
+#if HAL_MINIMIZE_FEATURES
 #define AP_BEACON_MAX_BEACONS 4
+#else
+#define AP_BEACON_MAX_BEACONS 8
+#endif
+#endif
 #define AP_BEACON_TIMEOUT_MS 300
 #define AP_BEACON_MINIMUM_FENCE_BEACONS 3
+// ranges whose residual from the multilateration solution is larger
+// than this are rejected (m)
+#define AP_BEACON_MULTILAT_GATE 1.0f
 
 class AP_Beacon
 {
@@ -68,6 +78,11 @@ public:
     // return vehicle position in NED from position estimate system's origin in meters
     bool get_vehicle_position_ned(Vector3f& pos, float& accuracy_estimate) const;
 
+    // return vehicle position in NED from position estimate system's
+    // origin in meters, solved from the latest ranges to all beacons,
+    // and the RMS of the residuals of the ranges used
+    bool get_multilat_position(Vector3f &pos, float &rms) const;
+
     // return the number of beacons
     uint8_t count() const;
 
@@ -91,6 +106,10 @@ public:
     // return last update time from beacon in milliseconds
     uint32_t beacon_last_update_ms(uint8_t beacon_instance) const;
 
+    // return the residual of the beacon's range from the
+    // multilateration solution in meters, and whether it was used
+    bool beacon_residual(uint8_t beacon_instance, float &residual) const;
+
     // update fence boundary array
     void update_boundary_points();
 
@@ -104,6 +123,9 @@ private:
     // check if device is ready
     bool device_ready(void) const;
 
+    // solve for the position from the latest ranges to all beacons
+    void update_multilat(void);
+
     // find next boundary point from an array of boundary points given the current index into that array
     // returns true if a next point can be found
     //   current_index should be an index into the boundary_pts array
@@ -132,6 +154,14 @@ private:
     uint8_t num_beacons = 0;
     BeaconState beacon_state[AP_BEACON_MAX_BEACONS];
 
+    // multilateration from the ranges
+    AP_Beacon_Multilat multilat;
+    uint8_t multilat_index[AP_BEACON_MAX_BEACONS];  // beacon of each range given to the solver
+    uint8_t multilat_num_ranges;
+    uint32_t multilat_range_ms;     // time of the latest range solved with
+    uint32_t multilat_update_ms;    // time of the last good solution
+    Vector3f multilat_pos;
+
     // fence boundary
     Vector2f boundary[AP_BEACON_MAX_BEACONS+1]; // array of boundary points (used for fence)
     uint8_t boundary_num_points;                // number of points in boundary
@@ -0,0 +1,181 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_Beacon_Multilat.h"
+
+bool AP_Beacon_Multilat::solve(const Vector3f *beacon_pos, const float *range, uint8_t n,
+                               const Vector3f &start, float gate)
+{
+    _num_used = 0;
+    if (n < 3 || n > AP_BEACON_MULTILAT_MAX_BEACONS) {
+        return false;
+    }
+    _used_mask = (1U<<n) - 1;
+    _num_used = n;
+
+    while (linear_solve(beacon_pos, range, n, start)) {
+        refine(beacon_pos, range, n);
+        const uint8_t worst = calc_residuals(beacon_pos, range, n);
+        if (fabsf(_residual[worst]) <= gate) {
+            return true;
+        }
+        if (_num_used <= AP_BEACON_MULTILAT_MIN_RANGES) {
+            // not enough ranges left to tell which are bad
+            return false;
+        }
+        // reject the worst range and solve again without it
+        _used_mask &= ~(1U<<worst);
+        _num_used--;
+    }
+    return false;
+}
+
+bool AP_Beacon_Multilat::linear_solve(const Vector3f *beacon_pos, const float *range, uint8_t n,
+                                      const Vector3f &start)
+{
+    // with c = |p|^2 - r^2 the range to each beacon at p gives
+    // 2 p.x - |x|^2 = c. Subtracting the mean of these removes |x|^2,
+    // leaving the linear equations 2 (p - p_mean).x = c - c_mean
+    Vector3f p_mean;
+    float c_mean = 0;
+    for (uint8_t i=0; i<n; i++) {
+        if (used(i)) {
+            p_mean += beacon_pos[i];
+            c_mean += beacon_pos[i].length_squared() - sq(range[i]);
+        }
+    }
+    p_mean /= _num_used;
+    c_mean /= _num_used;
+
+    Matrix3f M;
+    M.zero();
+    Vector3f v;
+    for (uint8_t i=0; i<n; i++) {
+        if (used(i)) {
+            const Vector3f a = (beacon_pos[i] - p_mean) * 2.0f;
+            const float b = beacon_pos[i].length_squared() - sq(range[i]) - c_mean;
+            M += a.mul_rowcol(a);
+            v += a * b;
+        }
+    }
+
+    const float trace = M.a.x + M.b.y + M.c.z;
+    if (!is_positive(trace)) {
+        return false;
+    }
+    Matrix3f M_inv;
+    if (M.det() > 1.0e-3f * powf(trace / 3, 3) && M.inverse(M_inv)) {
+        _pos = M_inv * v;
+        return true;
+    }
+
+    // the beacons are in one plane, or nearly, so the equations don't
+    // give the position across it. Its normal is the null space of M,
+    // the largest cross product of two of its rows
+    Vector3f normal = M.a % M.b;
+    const Vector3f normal2 = M.a % M.c;
+    const Vector3f normal3 = M.b % M.c;
+    if (normal2.length_squared() > normal.length_squared()) {
+        normal = normal2;
+    }
+    if (normal3.length_squared() > normal.length_squared()) {
+        normal = normal3;
+    }
+    if (normal.length() < 1.0e-6f * sq(trace)) {
+        // the beacons are in a line
+        return false;
+    }
+    normal.normalize();
+    if (normal.z < 0) {
+        normal = -normal;
+    }
+
+    // solve for the point in the plane, then leave it along the normal
+    // by the height that fits the ranges, on the side of start
+    M += normal.mul_rowcol(normal) * trace;
+    v += normal * (trace * (normal * p_mean));
+    if (!M.inverse(M_inv)) {
+        return false;
+    }
+    const Vector3f in_plane = M_inv * v;
+    float height_sq = 0;
+    for (uint8_t i=0; i<n; i++) {
+        if (used(i)) {
+            height_sq += sq(range[i]) - (in_plane - beacon_pos[i]).length_squared();
+        }
+    }
+    const float height = safe_sqrt(MAX(height_sq / _num_used, 0));
+    _pos = in_plane + normal * ((normal * (start - p_mean) < 0) ? -height : height);
+    return true;
+}
+
+void AP_Beacon_Multilat::refine(const Vector3f *beacon_pos, const float *range, uint8_t n)
+{
+    for (uint8_t iter=0; iter<AP_BEACON_MULTILAT_MAX_ITER; iter++) {
+        // normal equations of the range residuals, whose jacobians are
+        // the unit vectors from the beacons
+        Matrix3f H;
+        H.zero();
+        Vector3f g;
+        for (uint8_t i=0; i<n; i++) {
+            if (!used(i)) {
+                continue;
+            }
+            const Vector3f delta = _pos - beacon_pos[i];
+            const float length = delta.length();
+            if (length < 0.01f) {
+                continue;
+            }
+            const Vector3f J = delta / length;
+            H += J.mul_rowcol(J);
+            g += J * (length - range[i]);
+        }
+
+        // a little damping keeps the step bounded along a direction the
+        // ranges barely constrain
+        const float damping = 1.0e-3f * (H.a.x + H.b.y + H.c.z);
+        H.a.x += damping;
+        H.b.y += damping;
+        H.c.z += damping;
+        Matrix3f H_inv;
+        if (!H.inverse(H_inv)) {
+            return;
+        }
+        const Vector3f step = H_inv * g;
+        _pos -= step;
+        if (step.length() < AP_BEACON_MULTILAT_CONVERGED) {
+            return;
+        }
+    }
+}
+
+uint8_t AP_Beacon_Multilat::calc_residuals(const Vector3f *beacon_pos, const float *range, uint8_t n)
+{
+    uint8_t worst = 0;
+    float worst_abs = -1;
+    float sum_sq = 0;
+    for (uint8_t i=0; i<n; i++) {
+        _residual[i] = (_pos - beacon_pos[i]).length() - range[i];
+        if (used(i)) {
+            sum_sq += sq(_residual[i]);
+            if (fabsf(_residual[i]) > worst_abs) {
+                worst_abs = fabsf(_residual[i]);
+                worst = i;
+            }
+        }
+    }
+    _rms = safe_sqrt(sum_sq / _num_used);
+    return worst;
+}
@@ -0,0 +1,76 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <AP_Math/AP_Math.h>
+
+#define AP_BEACON_MULTILAT_MAX_BEACONS  16
+// Gauss-Newton iterations, and the step at which they stop early (m)
+#define AP_BEACON_MULTILAT_MAX_ITER     8
+#define AP_BEACON_MULTILAT_CONVERGED    0.001f
+// ranges to solve for a position with a residual to check it by
+#define AP_BEACON_MULTILAT_MIN_RANGES   4
+
+/*
+  batch multilateration: solve for a position from the ranges to all of
+  the beacons at once. A linear least squares solution, which also
+  handles beacons that are all in one plane, is refined by Gauss-Newton
+  iterations, each of which accumulates the 3x3 normal equations over
+  all of the ranges in one pass. Ranges that don't fit the others are
+  rejected, worst first, while there are enough left to check the
+  solution by
+ */
+class AP_Beacon_Multilat {
+public:
+    /*
+      solve for the position from the ranges to n beacons. start is a
+      guess at the position, such as the last solution; when the
+      beacons are in one plane it picks the side of the plane, which is
+      otherwise the side further down. Returns true if the residuals
+      of the ranges used are all within gate meters
+     */
+    bool solve(const Vector3f *beacon_pos, const float *range, uint8_t n,
+               const Vector3f &start, float gate);
+
+    const Vector3f &position(void) const { return _pos; }
+
+    // RMS of the residuals of the ranges used (m)
+    float rms(void) const { return _rms; }
+
+    // range to beacon i less its measured range at the solution,
+    // whether or not it was used (m)
+    float residual(uint8_t i) const { return _residual[i]; }
+
+    bool used(uint8_t i) const { return (_used_mask & (1U<<i)) != 0; }
+    uint8_t num_used(void) const { return _num_used; }
+
+private:
+    // linear least squares solution from the ranges in _used_mask
+    bool linear_solve(const Vector3f *beacon_pos, const float *range, uint8_t n,
+                      const Vector3f &start);
+
+    // Gauss-Newton refinement of _pos from the ranges in _used_mask
+    void refine(const Vector3f *beacon_pos, const float *range, uint8_t n);
+
+    // calculate the residuals and RMS, returning the index of the used
+    // range with the largest residual
+    uint8_t calc_residuals(const Vector3f *beacon_pos, const float *range, uint8_t n);
+
+    Vector3f _pos;
+    float _residual[AP_BEACON_MULTILAT_MAX_BEACONS];
+    float _rms;
+    uint16_t _used_mask;
+    uint8_t _num_used;
+};
@@ -0,0 +1,85 @@
+#include <AP_gtest.h>
+
+#include <AP_Beacon/AP_Beacon_Multilat.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// eight beacons around a warehouse, in NED, on the walls at two heights
+static const Vector3f warehouse[] {
+    {  0,  0, -2 }, { 30,  0, -6 }, { 30, 20, -2 }, {  0, 20, -6 },
+    { 15,  0, -4 }, { 30, 10, -5 }, { 15, 20, -3 }, {  0, 10, -5 },
+};
+static const uint8_t num_beacons = ARRAY_SIZE(warehouse);
+
+static void ranges_to(const Vector3f *beacons, uint8_t n, const Vector3f &pos, float *range)
+{
+    for (uint8_t i=0; i<n; i++) {
+        range[i] = (pos - beacons[i]).length();
+    }
+}
+
+TEST(MultilatTest, Exact)
+{
+    AP_Beacon_Multilat multilat;
+    float range[num_beacons];
+
+    for (const Vector3f &pos : { Vector3f(5, 5, -1), Vector3f(25, 17, -0.5f), Vector3f(15, 10, -4) }) {
+        ranges_to(warehouse, num_beacons, pos, range);
+        EXPECT_TRUE(multilat.solve(warehouse, range, num_beacons, Vector3f(), 0.5f));
+        EXPECT_NEAR(0, (multilat.position() - pos).length(), 0.01f);
+        EXPECT_NEAR(0, multilat.rms(), 0.01f);
+        EXPECT_EQ(num_beacons, multilat.num_used());
+    }
+
+    // too few beacons
+    EXPECT_FALSE(multilat.solve(warehouse, range, 2, Vector3f(), 0.5f));
+}
+
+TEST(MultilatTest, Coplanar)
+{
+    AP_Beacon_Multilat multilat;
+    // four beacons on the ceiling
+    const Vector3f ceiling[] {
+        { 0, 0, -5 }, { 20, 0, -5 }, { 20, 20, -5 }, { 0, 20, -5 },
+    };
+    float range[4];
+    const Vector3f pos(8, 13, -1);
+    ranges_to(ceiling, 4, pos, range);
+
+    // below the ceiling unless the guess is above it
+    EXPECT_TRUE(multilat.solve(ceiling, range, 4, Vector3f(), 0.5f));
+    EXPECT_NEAR(0, (multilat.position() - pos).length(), 0.01f);
+    EXPECT_TRUE(multilat.solve(ceiling, range, 4, Vector3f(10, 10, -9), 0.5f));
+    EXPECT_NEAR(-9, multilat.position().z, 0.01f);
+
+    // beacons in a line can't give a position
+    const Vector3f line[] {
+        { 0, 0, -5 }, { 10, 0, -5 }, { 20, 0, -5 },
+    };
+    ranges_to(line, 3, pos, range);
+    EXPECT_FALSE(multilat.solve(line, range, 3, Vector3f(), 0.5f));
+}
+
+TEST(MultilatTest, Outlier)
+{
+    AP_Beacon_Multilat multilat;
+    float range[num_beacons];
+    const Vector3f pos(12, 6, -1);
+    ranges_to(warehouse, num_beacons, pos, range);
+
+    // a noisy range from a reflection is rejected, and the others fit
+    range[5] += 4.0f;
+    range[1] += 0.05f;
+    range[3] -= 0.05f;
+    EXPECT_TRUE(multilat.solve(warehouse, range, num_beacons, Vector3f(), 0.5f));
+    EXPECT_NEAR(0, (multilat.position() - pos).length(), 0.1f);
+    EXPECT_FALSE(multilat.used(5));
+    EXPECT_EQ(num_beacons - 1, multilat.num_used());
+    EXPECT_NEAR(4.0f, -multilat.residual(5), 0.3f);
+    EXPECT_LT(multilat.rms(), 0.1f);
+
+    // with only four ranges a bad one can't be found
+    EXPECT_FALSE(multilat.solve(&warehouse[2], &range[2], 4, Vector3f(), 0.5f));
+}
+
+AP_GTEST_MAIN()
@@ -8,6 +8,7 @@
 #include <SRV_Channel/SRV_Channel.h>
 #include <AP_Logger/AP_Logger.h>
 #include <AP_GPS/AP_GPS.h>
+#include <AP_InertialSensor/AP_InertialSensor.h>
 
 // ------------------------------
 #define CAM_DEBUG DISABLED
@@ -274,22 +275,29 @@ void AP_Camera::control(float session, float zoom_pos, float zoom_step, float fo
  */
 void AP_Camera::send_feedback(mavlink_channel_t chan)
 {
+    // with a feedback pin report where the picture was actually taken
+    const bool use_feedback_state = using_feedback_pin() && _have_feedback_state;
+    const Location &loc = use_feedback_state ? _feedback_state.loc : current_loc;
+    const int32_t roll_cd = use_feedback_state ? _feedback_state.roll_cd : ahrs.roll_sensor;
+    const int32_t pitch_cd = use_feedback_state ? _feedback_state.pitch_cd : ahrs.pitch_sensor;
+    const int32_t yaw_cd = use_feedback_state ? _feedback_state.yaw_cd : ahrs.yaw_sensor;
+
     float altitude, altitude_rel;
-    if (current_loc.relative_alt) {
-        altitude = current_loc.alt+ahrs.get_home().alt;
-        altitude_rel = current_loc.alt;
+    if (loc.relative_alt) {
+        altitude = loc.alt+ahrs.get_home().alt;
+        altitude_rel = loc.alt;
     } else {
-        altitude = current_loc.alt;
-        altitude_rel = current_loc.alt - ahrs.get_home().alt;
+        altitude = loc.alt;
+        altitude_rel = loc.alt - ahrs.get_home().alt;
     }
 
     mavlink_msg_camera_feedback_send(
         chan,
         AP::gps().time_epoch_usec(),
         0, 0, _image_index,
-        current_loc.lat, current_loc.lng,
+        loc.lat, loc.lng,
         altitude*1e-2f, altitude_rel*1e-2f,
-        ahrs.roll_sensor*1e-2f, ahrs.pitch_sensor*1e-2f, ahrs.yaw_sensor*1e-2f,
+        roll_cd*1e-2f, pitch_cd*1e-2f, yaw_cd*1e-2f,
         0.0f, CAMERA_FEEDBACK_PHOTO, _camera_trigger_logged);
 }
 
@@ -298,6 +306,8 @@ void AP_Camera::send_feedback(mavlink_channel_t chan)
 */
 void AP_Camera::update()
 {
+    _distance_trigger_scheduled = false;
+
     if (AP::gps().status() < AP_GPS::GPS_OK_FIX_3D) {
         return;
     }
@@ -315,20 +325,61 @@ void AP_Camera::update()
         return;
     }
 
-    if (current_loc.get_distance(_last_location) < _trigg_dist) {
+    const uint32_t tnow = AP_HAL::millis();
+    const uint32_t update_interval_ms = tnow - _last_update_ms;
+    _last_update_ms = tnow;
+
+    const Vector2f ofs_ne = _last_location.get_distance_NE(current_loc);
+    const float dist = ofs_ne.length();
+    if (dist < _trigg_dist) {
+        /*
+          work out when the trigger distance will be reached from the
+          speed away from the last picture. If that is before the next
+          update() it is left to update_trigger() to take the picture
+          on time, rather than up to a GPS update late
+         */
+        const Vector3f &vel = AP::gps().velocity();
+        const float speed = is_zero(dist) ? norm(vel.x, vel.y) : (ofs_ne * Vector2f(vel.x, vel.y)) / dist;
+        if (speed < AP_CAMERA_PREDICT_MIN_SPEED) {
+            return;
+        }
+        const uint32_t due_ms = 1000 * (_trigg_dist - dist) / speed;
+        if (due_ms < MIN(update_interval_ms, (uint32_t)AP_CAMERA_PREDICT_MAX_MS)) {
+            _distance_trigger_ms = tnow + due_ms;
+            _distance_trigger_scheduled = true;
+        }
         return;
     }
 
+    distance_trigger(tnow);
+}
+
+/*
+  return true if a distance trigger may take a picture now
+ */
+bool AP_Camera::distance_trigger_allowed(uint32_t tnow) const
+{
     if (_max_roll > 0 && fabsf(ahrs.roll_sensor*1e-2f) > _max_roll) {
-        return;
+        return false;
     }
 
     if (_is_in_auto_mode != true && _auto_mode_only != 0) {
-        return;
+        return false;
     }
 
-    uint32_t tnow = AP_HAL::millis();
     if (tnow - _last_photo_time < (unsigned) _min_interval) {
+        return false;
+    }
+
+    return true;
+}
+
+/*
+  take a picture for having moved the trigger distance
+ */
+void AP_Camera::distance_trigger(uint32_t tnow)
+{
+    if (!distance_trigger_allowed(tnow)) {
         return;
     }
 
@@ -338,12 +389,29 @@ void AP_Camera::update()
     _last_photo_time = tnow;
 }
 
+/*
+  take a picture scheduled by update(), at the update_trigger() call
+  closest to when it is due
+ */
+void AP_Camera::update_distance_trigger(void)
+{
+    if (!_distance_trigger_scheduled) {
+        return;
+    }
+    const uint32_t tnow = AP_HAL::millis();
+    if ((int32_t)(_distance_trigger_ms - tnow) > AP_CAMERA_TRIGGER_PERIOD_MS/2) {
+        return;
+    }
+    _distance_trigger_scheduled = false;
+    distance_trigger(tnow);
+}
+
 /*
   interrupt handler for interrupt based feedback trigger
  */
 void AP_Camera::feedback_pin_isr(uint8_t pin, bool high, uint32_t timestamp_us)
 {
-    _feedback_timestamp_us = timestamp_us;
+    _feedback_timestamp_us[_camera_trigger_count % AP_CAMERA_FEEDBACK_QUEUE_LEN] = timestamp_us;
     _camera_trigger_count++;
 }
 
@@ -357,7 +425,7 @@ void AP_Camera::feedback_pin_timer(void)
     uint8_t trigger_polarity = _feedback_polarity==0?0:1;
     if (pin_state == trigger_polarity &&
         _last_pin_state != trigger_polarity) {
-        _feedback_timestamp_us = AP_HAL::micros();
+        _feedback_timestamp_us[_camera_trigger_count % AP_CAMERA_FEEDBACK_QUEUE_LEN] = AP_HAL::micros();
         _camera_trigger_count++;
     }
     _last_pin_state = pin_state;
@@ -430,25 +498,96 @@ void AP_Camera::take_picture()
     GCS_MAVLINK::send_to_components(&msg);
 }
 
+/*
+  record the vehicle state for geotagging feedback pin pictures
+ */
+void AP_Camera::record_state(void)
+{
+    vehicle_state &state = _history[_history_next];
+    state.time_us = AP::ins().get_last_update_usec();
+    state.loc = current_loc;
+    state.roll_cd = ahrs.roll_sensor;
+    state.pitch_cd = ahrs.pitch_sensor;
+    state.yaw_cd = ahrs.yaw_sensor;
+
+    _history_next = (_history_next + 1) % AP_CAMERA_HISTORY_LEN;
+    if (_history_count < AP_CAMERA_HISTORY_LEN) {
+        _history_count++;
+    }
+}
+
+/*
+  get the vehicle state at time_us, interpolated between the recorded
+  states either side of it. Times outside the history get the oldest
+  or newest state
+ */
+void AP_Camera::state_at(uint32_t time_us, vehicle_state &state) const
+{
+    uint8_t idx = (_history_next + AP_CAMERA_HISTORY_LEN - 1) % AP_CAMERA_HISTORY_LEN;
+    state = _history[idx];
+
+    for (uint8_t i=1; i<_history_count; i++) {
+        const vehicle_state &newer = _history[idx];
+        idx = (idx + AP_CAMERA_HISTORY_LEN - 1) % AP_CAMERA_HISTORY_LEN;
+        const vehicle_state &older = _history[idx];
+        state = older;
+        if ((int32_t)(time_us - older.time_us) < 0) {
+            // picture is older than this sample, keep looking
+            continue;
+        }
+        const uint32_t dt_us = newer.time_us - older.time_us;
+        if (dt_us == 0) {
+            return;
+        }
+        const float frac = constrain_float((time_us - older.time_us) / (float)dt_us, 0.0f, 1.0f);
+        state.time_us = time_us;
+        state.loc.lat += (newer.loc.lat - older.loc.lat) * frac;
+        state.loc.lng += (newer.loc.lng - older.loc.lng) * frac;
+        state.loc.alt += (newer.loc.alt - older.loc.alt) * frac;
+        state.roll_cd = wrap_180_cd(older.roll_cd + wrap_180_cd(newer.roll_cd - older.roll_cd) * frac);
+        state.pitch_cd += (newer.pitch_cd - older.pitch_cd) * frac;
+        state.yaw_cd = wrap_360_cd(older.yaw_cd + wrap_180_cd(newer.yaw_cd - older.yaw_cd) * frac);
+        return;
+    }
+}
+
 /*
   update camera trigger - 50Hz
  */
 void AP_Camera::update_trigger()
 {
     trigger_pic_cleanup();
-    
-    if (_camera_trigger_logged != _camera_trigger_count) {
-        uint32_t timestamp32 = _feedback_timestamp_us;
-        _camera_trigger_logged = _camera_trigger_count;
+
+    update_distance_trigger();
+
+    if (!using_feedback_pin()) {
+        return;
+    }
+
+    record_state();
+
+    const uint32_t trigger_count = _camera_trigger_count;
+    if (trigger_count - _camera_trigger_logged > AP_CAMERA_FEEDBACK_QUEUE_LEN) {
+        // more pictures since the last update than we keep times
+        // for, the oldest are not logged
+        _camera_trigger_logged = trigger_count - AP_CAMERA_FEEDBACK_QUEUE_LEN;
+    }
+
+    AP_Logger *logger = AP_Logger::get_singleton();
+    while (_camera_trigger_logged != trigger_count) {
+        const uint32_t timestamp32 = _feedback_timestamp_us[_camera_trigger_logged % AP_CAMERA_FEEDBACK_QUEUE_LEN];
+        _camera_trigger_logged++;
+
+        state_at(timestamp32, _feedback_state);
+        _have_feedback_state = true;
 
         gcs().send_message(MSG_CAMERA_FEEDBACK);
-        AP_Logger *logger = AP_Logger::get_singleton();
-        if (logger != nullptr) {
-            if (logger->should_log(log_camera_bit)) {
-                uint32_t tdiff = AP_HAL::micros() - timestamp32;
-                uint64_t timestamp = AP_HAL::micros64();
-                logger->Write_Camera(ahrs, current_loc, timestamp - tdiff);
-            }
+        if (logger != nullptr && logger->should_log(log_camera_bit)) {
+            const uint32_t tdiff = AP_HAL::micros() - timestamp32;
+            const uint64_t timestamp = AP_HAL::micros64() - tdiff;
+            logger->Write_Camera(ahrs, _feedback_state.loc,
+                                 _feedback_state.roll_cd, _feedback_state.pitch_cd, _feedback_state.yaw_cd,
+                                 timestamp);
         }
     }
 }
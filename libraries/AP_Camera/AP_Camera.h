@@ -19,6 +19,12 @@
 
 #define AP_CAMERA_FEEDBACK_DEFAULT_FEEDBACK_PIN -1  // default is to not use camera feedback pin
 
+#define AP_CAMERA_HISTORY_LEN               8       // number of update_trigger() samples of vehicle state kept for geotagging feedback
+#define AP_CAMERA_FEEDBACK_QUEUE_LEN        4       // number of feedback pin times queued between update_trigger() calls
+#define AP_CAMERA_PREDICT_MAX_MS            500     // longest time ahead a distance trigger is scheduled
+#define AP_CAMERA_PREDICT_MIN_SPEED         0.5f    // minimum speed (m/s) towards the next trigger point to schedule a trigger
+#define AP_CAMERA_TRIGGER_PERIOD_MS         20      // period update_trigger() is called at
+
 /// @class	Camera
 /// @brief	Object managing a Photo or video camera
 class AP_Camera {
@@ -107,6 +113,15 @@ private:
     AP_Int16        _max_roll;          // Maximum acceptable roll angle when trigging camera
     uint32_t        _last_photo_time;   // last time a photo was taken
     struct Location _last_location;
+    uint32_t        _last_update_ms;    // last time update() checked the trigger distance
+
+    // distance trigger predicted to be due before the next update()
+    bool            _distance_trigger_scheduled;
+    uint32_t        _distance_trigger_ms;
+
+    bool            distance_trigger_allowed(uint32_t tnow) const;
+    void            distance_trigger(uint32_t tnow);
+    void            update_distance_trigger(void);
     uint16_t        _image_index;       // number of pictures taken since boot
 
     // pin number for accurate camera feedback messages
@@ -115,13 +130,35 @@ private:
 
     uint32_t        _camera_trigger_count;
     uint32_t        _camera_trigger_logged;
-    uint32_t        _feedback_timestamp_us;
+    uint32_t        _feedback_timestamp_us[AP_CAMERA_FEEDBACK_QUEUE_LEN];
     bool            _timer_installed;
     bool            _isr_installed;
     uint8_t         _last_pin_state;
 
     void log_picture();
 
+    /*
+      vehicle state, recorded each update_trigger() while using a
+      feedback pin so pictures can be geotagged with where the
+      vehicle was when the hotshoe fired rather than when the main
+      loop got to it
+     */
+    struct vehicle_state {
+        uint32_t time_us;   // time of the IMU sample the state came from
+        Location loc;
+        int32_t roll_cd;
+        int32_t pitch_cd;
+        int32_t yaw_cd;
+    };
+    vehicle_state   _history[AP_CAMERA_HISTORY_LEN];
+    uint8_t         _history_next;
+    uint8_t         _history_count;
+    vehicle_state   _feedback_state;    // state at the last feedback, for send_feedback()
+    bool            _have_feedback_state;
+
+    void record_state(void);
+    void state_at(uint32_t time_us, vehicle_state &state) const;
+
     uint32_t log_camera_bit;
     const struct Location &current_loc;
     const AP_AHRS &ahrs;
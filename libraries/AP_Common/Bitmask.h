@@ -54,8 +54,8 @@ public:
             bits[i] = 0xffffffff;
         }
         // set most of the last word to 111.., leaving out-of-range bits to be 0
-        uint16_t num_valid_bits = numbits % 32;
-        bits[numwords-1] = (1 << num_valid_bits) - 1;
+        const uint16_t num_valid_bits = numbits % 32;
+        bits[numwords-1] = (num_valid_bits == 0) ? 0xffffffff : (1U << num_valid_bits) - 1;
     }
 
     // clear given bitnumber
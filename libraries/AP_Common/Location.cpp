@@ -252,14 +252,16 @@ void Location::offset(float ofs_north, float ofs_east)
  */
 void Location::offset_bearing(float bearing, float distance)
 {
-    const float ofs_north = cosf(radians(bearing)) * distance;
-    const float ofs_east  = sinf(radians(bearing)) * distance;
+    float sin_bearing, cos_bearing;
+    approx_sincosf(radians(bearing), sin_bearing, cos_bearing);
+    const float ofs_north = cos_bearing * distance;
+    const float ofs_east  = sin_bearing * distance;
     offset(ofs_north, ofs_east);
 }
 
 float Location::longitude_scale() const
 {
-    float scale = cosf(lat * (1.0e-7f * DEG_TO_RAD));
+    float scale = approx_cosf(lat * (1.0e-7f * DEG_TO_RAD));
     return constrain_float(scale, 0.01f, 1.0f);
 }
 
@@ -322,3 +324,38 @@ bool Location::check_latlng() const
 {
     return check_lat(lat) && check_lng(lng);
 }
+
+LocationOrigin::LocationOrigin(const Location &origin) :
+    _lat(origin.lat),
+    _lng(origin.lng),
+    _lng_scale(LOCATION_SCALING_FACTOR * origin.longitude_scale())
+{
+}
+
+Vector2f LocationOrigin::get_distance_NE(int32_t lat, int32_t lng) const
+{
+    return Vector2f((lat - _lat) * LOCATION_SCALING_FACTOR,
+                    (lng - _lng) * _lng_scale);
+}
+
+float LocationOrigin::get_distance(const Location &loc2) const
+{
+    return get_distance_NE(loc2).length();
+}
+
+void LocationOrigin::get_distances(const Vector2l *latlng, uint16_t n, float *distances) const
+{
+    for (uint16_t i = 0; i < n; i++) {
+        const float dn = (latlng[i].x - _lat) * LOCATION_SCALING_FACTOR;
+        const float de = (latlng[i].y - _lng) * _lng_scale;
+        distances[i] = sqrtf(dn*dn + de*de);
+    }
+}
+
+void LocationOrigin::get_distances_NE(const Vector2l *latlng, uint16_t n, Vector2f *ne) const
+{
+    for (uint16_t i = 0; i < n; i++) {
+        ne[i].x = (latlng[i].x - _lat) * LOCATION_SCALING_FACTOR;
+        ne[i].y = (latlng[i].y - _lng) * _lng_scale;
+    }
+}
@@ -109,4 +109,43 @@ private:
     static AP_Terrain *_terrain;
 };
 
+/*
+  a location that distances to many other locations are measured
+  from, such as the vehicle when checking ADS-B traffic, or the EKF
+  origin when loading fence points. The longitude scale is worked out
+  once rather than with a cosf() per distance, and the lat/lng
+  differences are done in integers.
+
+  All distances use the longitude scale of the origin. Location's own
+  methods use that of one of the two locations, and over the tens of
+  km these are used for the two agree to better than 0.1%
+ */
+class LocationOrigin
+{
+public:
+    explicit LocationOrigin(const Location &origin);
+
+    // return distance in meters from the origin to loc2
+    float get_distance(const Location &loc2) const;
+
+    // return the distance in meters in North/East plane as a N/E vector to loc2
+    Vector2f get_distance_NE(const Location &loc2) const {
+        return get_distance_NE(loc2.lat, loc2.lng);
+    }
+    Vector2f get_distance_NE(int32_t lat, int32_t lng) const;
+
+    /*
+      batch versions of the above, for n points given as lat (x) and
+      lng (y) pairs, the way fence and rally points are stored
+     */
+    void get_distances(const Vector2l *latlng, uint16_t n, float *distances) const;
+    void get_distances_NE(const Vector2l *latlng, uint16_t n, Vector2f *ne) const;
+
+private:
+    int32_t _lat;
+    int32_t _lng;
+    // LOCATION_SCALING_FACTOR * longitude_scale() of the origin
+    float _lng_scale;
+};
+
 #endif /* LOCATION_H */
@@ -0,0 +1,74 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Common/Location.h>
+
+/*
+  the waypoint geometry AP_L1_Control::update_waypoint() needs each
+  call: the offsets between the aircraft and the two waypoints and the
+  bearing to the next one. BM_WaypointGeometryLocation works these out
+  with Location's methods the way it used to, each with its own
+  longitude scale. BM_WaypointGeometryOrigin does it from a
+  LocationOrigin at the aircraft, the way it does now. The aircraft
+  steps along a 2km leg near CMAC
+ */
+
+static const Location prev_wp(-353632620, 1491652370, 10000, Location::AltFrame::ABOVE_HOME);
+static const Location next_wp(-353452620, 1491752370, 10000, Location::AltFrame::ABOVE_HOME);
+
+#define NUM_POSITIONS 64
+
+static void aircraft_position(uint8_t i, Location &loc)
+{
+    loc = prev_wp;
+    loc.lat += (next_wp.lat - prev_wp.lat) / NUM_POSITIONS * i + 150;
+    loc.lng += (next_wp.lng - prev_wp.lng) / NUM_POSITIONS * i - 150;
+}
+
+static void BM_WaypointGeometryLocation(benchmark::State& state)
+{
+    uint8_t i = 0;
+    Location loc;
+    while (state.KeepRunning()) {
+        aircraft_position(i, loc);
+        gbenchmark_escape(&loc);
+        int32_t bearing = loc.get_bearing_to(next_wp);
+        Vector2f AB = prev_wp.get_distance_NE(next_wp);
+        Vector2f A_air = prev_wp.get_distance_NE(loc);
+        Vector2f B_air = next_wp.get_distance_NE(loc);
+        gbenchmark_escape(&bearing);
+        gbenchmark_escape(&AB);
+        gbenchmark_escape(&A_air);
+        gbenchmark_escape(&B_air);
+        i = (i + 1) % NUM_POSITIONS;
+    }
+}
+
+static void BM_WaypointGeometryOrigin(benchmark::State& state)
+{
+    uint8_t i = 0;
+    Location loc;
+    while (state.KeepRunning()) {
+        aircraft_position(i, loc);
+        gbenchmark_escape(&loc);
+        const LocationOrigin aircraft(loc);
+        const Vector2f air_A = aircraft.get_distance_NE(prev_wp);
+        const Vector2f air_B = aircraft.get_distance_NE(next_wp);
+        int32_t bearing = atan2f(air_B.y, air_B.x) * DEGX100;
+        if (bearing < 0) {
+            bearing += 36000;
+        }
+        Vector2f AB = air_B - air_A;
+        Vector2f A_air = -air_A;
+        Vector2f B_air = -air_B;
+        gbenchmark_escape(&bearing);
+        gbenchmark_escape(&AB);
+        gbenchmark_escape(&A_air);
+        gbenchmark_escape(&B_air);
+        i = (i + 1) % NUM_POSITIONS;
+    }
+}
+
+BENCHMARK(BM_WaypointGeometryLocation);
+BENCHMARK(BM_WaypointGeometryOrigin);
+
+BENCHMARK_MAIN()
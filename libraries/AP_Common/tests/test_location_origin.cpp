@@ -0,0 +1,57 @@
+#include <AP_gtest.h>
+
+#include <AP_Common/Location.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// points within a few km of CMAC, where a vehicle, its fence and
+// rally points and nearby traffic would be
+static const Vector2l points[] {
+    { -353632620, 1491652370 },
+    { -353632620, 1491652371 },
+    { -353532620, 1491652370 },
+    { -353732620, 1491552370 },
+    { -353232620, 1492052370 },
+    { -353932620, 1491252370 },
+};
+
+TEST(LocationOrigin, Distances)
+{
+    const Location loc1(points[0].x, points[0].y, 0, Location::AltFrame::ABSOLUTE);
+    const LocationOrigin origin(loc1);
+
+    for (const Vector2l &p : points) {
+        const Location loc2(p.x, p.y, 0, Location::AltFrame::ABSOLUTE);
+
+        const Vector2f ne = origin.get_distance_NE(loc2);
+        const Vector2f ne_expected = loc1.get_distance_NE(loc2);
+        EXPECT_NEAR(ne_expected.x, ne.x, 1.0e-3);
+        EXPECT_NEAR(ne_expected.y, ne.y, 1.0e-3);
+
+        // Location uses the longitude scale of loc2 here
+        const float dist_expected = loc1.get_distance(loc2);
+        EXPECT_NEAR(dist_expected, origin.get_distance(loc2), 1.0e-3 * dist_expected + 1.0e-3);
+    }
+}
+
+TEST(LocationOrigin, Batch)
+{
+    const Location loc1(points[0].x, points[0].y, 0, Location::AltFrame::ABSOLUTE);
+    const LocationOrigin origin(loc1);
+
+    const uint16_t n = ARRAY_SIZE(points);
+    Vector2f ne[n];
+    float distances[n];
+    origin.get_distances_NE(points, n, ne);
+    origin.get_distances(points, n, distances);
+
+    for (uint16_t i = 0; i < n; i++) {
+        const Vector2f ne_expected = origin.get_distance_NE(points[i].x, points[i].y);
+        EXPECT_FLOAT_EQ(ne_expected.x, ne[i].x);
+        EXPECT_FLOAT_EQ(ne_expected.y, ne[i].y);
+        EXPECT_FLOAT_EQ(ne_expected.length(), distances[i]);
+    }
+    EXPECT_FLOAT_EQ(0, distances[0]);
+}
+
+AP_GTEST_MAIN()
@@ -981,6 +981,7 @@ Compass::read(void)
     if (_learn == LEARN_INFLIGHT && learn != nullptr) {
         learn->update();
     }
+    _per_motor.learn_update();
     return healthy();
 }
 
@@ -281,6 +281,13 @@ public:
     uint32_t last_update_ms(void) const { return _state[get_primary()].last_update_ms; }
     uint32_t last_update_ms(uint8_t i) const { return _state[i].last_update_ms; }
 
+    // number of filtered fields published by an instance. A consumer
+    // that keeps the count it last read can check for new data with
+    // have_new_sample()
+    uint32_t get_sample_count(void) const { return _state[get_primary()].sample_count; }
+    uint32_t get_sample_count(uint8_t i) const { return _state[i].sample_count; }
+    bool have_new_sample(uint8_t i, uint32_t sample_count) const { return _state[i].sample_count != sample_count; }
+
     static const struct AP_Param::GroupInfo var_info[];
 
     // HIL variables
@@ -341,6 +348,10 @@ private:
     bool _start_calibration_mask(uint8_t mask, bool retry=false, bool autosave=false, float delay_sec=0.0f, bool autoreboot=false);
     bool _auto_reboot() { return _compass_cal_autoreboot; }
 
+    // runs the calibrator fits, which take too long for the main loop
+    void _calibration_thread();
+    bool _start_calibration_thread();
+
     // see if we already have probed a i2c driver by bus number and address
     bool _have_i2c_driver(uint8_t bus_num, uint8_t address) const;
 
@@ -353,6 +364,12 @@ private:
     bool _cal_complete_requires_reboot;
     bool _cal_has_run;
 
+    // set by the calibration thread when a fit fails, for
+    // compass_cal_update() to notify
+    volatile bool _cal_fit_failed;
+    bool _cal_thread_started;
+    AP_HAL::Util::perf_counter_t _perf_cal_fit;
+
     // enum of drivers for COMPASS_TYPEMASK
     enum DriverType {
         DRIVER_HMC5883  =0,
@@ -450,6 +467,9 @@ private:
         uint32_t    last_update_ms;
         uint32_t    last_update_usec;
 
+        // incremented for each new filtered field
+        uint32_t    sample_count;
+
         // board specific orientation
         enum Rotation rotation;
 
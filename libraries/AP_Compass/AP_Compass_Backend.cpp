@@ -156,6 +156,7 @@ void AP_Compass_Backend::publish_filtered_field(const Vector3f &mag, uint8_t ins
 
     state.last_update_ms = AP_HAL::millis();
     state.last_update_usec = AP_HAL::micros();
+    state.sample_count++;
 }
 
 void AP_Compass_Backend::set_last_update_usec(uint32_t last_update, uint8_t instance)
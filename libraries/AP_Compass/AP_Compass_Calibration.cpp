@@ -11,11 +11,19 @@ Compass::compass_cal_update()
 {
     bool running = false;
 
+    if (_cal_fit_failed) {
+        _cal_fit_failed = false;
+        AP_Notify::events.compass_cal_failed = 1;
+    }
+
     for (uint8_t i=0; i<COMPASS_MAX_INSTANCES; i++) {
-        bool failure;
-        _calibrator[i].update(failure);
-        if (failure) {
-            AP_Notify::events.compass_cal_failed = 1;
+        if (!_cal_thread_started) {
+            // no thread, fit here as we always used to
+            bool failure;
+            _calibrator[i].update(failure);
+            if (failure) {
+                AP_Notify::events.compass_cal_failed = 1;
+            }
         }
 
         if (_calibrator[i].check_for_timeout()) {
@@ -41,6 +49,52 @@ Compass::compass_cal_update()
     }
 }
 
+/*
+  each fit step is a pass over all the samples, several milliseconds
+  on a F4 for an ellipsoid fit, and the main loop used to run one step
+  per compass per call. Running them here instead lets the fit finish
+  sooner without the main loop overrunning
+ */
+void
+Compass::_calibration_thread()
+{
+    while (true) {
+        bool fitting = false;
+        for (uint8_t i=0; i<COMPASS_MAX_INSTANCES; i++) {
+            if (!_calibrator[i].fitting()) {
+                continue;
+            }
+            fitting = true;
+            bool failure;
+            hal.util->perf_begin(_perf_cal_fit);
+            _calibrator[i].update(failure);
+            hal.util->perf_end(_perf_cal_fit);
+            if (failure) {
+                _cal_fit_failed = true;
+            }
+        }
+        // when fitting yield between steps, otherwise check for a
+        // full sample buffer at the rate samples arrive
+        hal.scheduler->delay(fitting ? 1 : 20);
+    }
+}
+
+bool
+Compass::_start_calibration_thread()
+{
+    if (_cal_thread_started) {
+        return true;
+    }
+    _perf_cal_fit = hal.util->perf_alloc(AP_HAL::Util::PC_ELAPSED, "CompassCal_fit");
+    if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&Compass::_calibration_thread, void),
+                                      "CompassCal", 4096, AP_HAL::Scheduler::PRIORITY_IO, -1)) {
+        gcs().send_text(MAV_SEVERITY_WARNING, "CompassCal: failed to start thread");
+        return false;
+    }
+    _cal_thread_started = true;
+    return true;
+}
+
 bool
 Compass::_start_calibration(uint8_t i, bool retry, float delay)
 {
@@ -67,6 +121,9 @@ Compass::_start_calibration(uint8_t i, bool retry, float delay)
             _calibrator[i].set_orientation(r, _state[i].external, _rotate_auto>=2);
         }
     }
+    // fall back to fitting in compass_cal_update() if there is no thread
+    _start_calibration_thread();
+
     _cal_saved[i] = false;
     _calibrator[i].start(retry, delay, get_offsets_max(), i);
 
@@ -202,13 +202,23 @@ void AP_Compass_IST8310::timer()
         le16_t rz;
     } buffer;
 
-    bool ret = _dev->read_registers(OUTPUT_X_L_REG, (uint8_t *) &buffer, sizeof(buffer));
-    if (!ret) {
+    // read the sample and start the next conversion in one batch
+    const uint8_t reg = OUTPUT_X_L_REG;
+    const uint8_t cntl1[2] = { CNTL1_REG, CNTL1_VAL_SINGLE_MEASUREMENT_MODE };
+    const AP_HAL::Device::BatchTransfer transfers[] {
+        { &reg, 1, (uint8_t *) &buffer, sizeof(buffer) },
+        { cntl1, sizeof(cntl1), nullptr, 0 },
+    };
+    const uint8_t done = _dev->transfer_batch(transfers, ARRAY_SIZE(transfers));
+    if (done == 0) {
         hal.util->perf_count(_perf_xfer_err);
         return;
     }
-
-    start_conversion();
+    if (done == 1) {
+        // as for a failed start_conversion()
+        hal.util->perf_count(_perf_xfer_err);
+        _ignore_next_sample = true;
+    }
 
     /* same period, but start counting from now */
     _dev->adjust_periodic_callback(_periodic_handle, SAMPLING_PERIOD_USEC);
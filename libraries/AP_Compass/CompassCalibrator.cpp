@@ -73,15 +73,17 @@ CompassCalibrator::CompassCalibrator():
 _tolerance(COMPASS_CAL_DEFAULT_TOLERANCE),
 _sample_buffer(nullptr)
 {
-    clear();
+    set_status(COMPASS_CAL_NOT_STARTED);
 }
 
 void CompassCalibrator::clear() {
+    WITH_SEMAPHORE(_sem);
     set_status(COMPASS_CAL_NOT_STARTED);
 }
 
 void CompassCalibrator::start(bool retry, float delay, uint16_t offset_max, uint8_t compass_idx)
 {
+    WITH_SEMAPHORE(_sem);
     if(running()) {
         return;
     }
@@ -95,6 +97,7 @@ void CompassCalibrator::start(bool retry, float delay, uint16_t offset_max, uint
 }
 
 void CompassCalibrator::get_calibration(Vector3f &offsets, Vector3f &diagonals, Vector3f &offdiagonals) {
+    WITH_SEMAPHORE(_sem);
     if (_status != COMPASS_CAL_SUCCESS) {
         return;
     }
@@ -153,18 +156,30 @@ CompassCalibrator::completion_mask_t& CompassCalibrator::get_completion_mask()
 }
 
 bool CompassCalibrator::check_for_timeout() {
+    // called from the main loop, which shouldn't wait for a fit step
+    if (!_sem.take_nonblocking()) {
+        return false;
+    }
+    bool timeout = false;
     uint32_t tnow = AP_HAL::millis();
     if(running() && tnow - _last_sample_ms > 1000) {
         _retry = false;
         set_status(COMPASS_CAL_FAILED);
-        return true;
+        timeout = true;
     }
-    return false;
+    _sem.give();
+    return timeout;
 }
 
 void CompassCalibrator::new_sample(const Vector3f& sample) {
     _last_sample_ms = AP_HAL::millis();
 
+    // don't hold up the backend while a fit step runs. The buffer is
+    // full while fitting so the sample would not have been used
+    if (!_sem.take_nonblocking()) {
+        return;
+    }
+
     if(_status == COMPASS_CAL_WAITING_TO_START) {
         set_status(COMPASS_CAL_RUNNING_STEP_ONE);
     }
@@ -175,11 +190,15 @@ void CompassCalibrator::new_sample(const Vector3f& sample) {
         _sample_buffer[_samples_collected].att.set_from_ahrs();
         _samples_collected++;
     }
+
+    _sem.give();
 }
 
 void CompassCalibrator::update(bool &failure) {
     failure = false;
 
+    WITH_SEMAPHORE(_sem);
+
     if(!fitting()) {
         return;
     }
@@ -486,6 +505,34 @@ void CompassCalibrator::calc_sphere_jacob(const Vector3f& sample, const param_t&
     ret[3] = -1.0f * (((offdiag.y * A) + (offdiag.z * B) + (diag.z    * C))/length);
 }
 
+/*
+  add one sample's jacobian to the upper triangle of JTJ and to JTFI.
+  The residual is worked out once per sample rather than once per
+  parameter, and as JTJ is symmetric the lower triangle is filled in
+  once at the end by fill_JTJ_lower(). With n known at each call this
+  inlines to straight line code
+ */
+static inline void accumulate_JTJ(const float *jacob, float residual, uint8_t n, float *JTJ, float *JTFI)
+{
+    for (uint8_t i = 0; i < n; i++) {
+        const float ji = jacob[i];
+        float *row = &JTJ[i*n];
+        for (uint8_t j = i; j < n; j++) {
+            row[j] += ji * jacob[j];
+        }
+        JTFI[i] += ji * residual;
+    }
+}
+
+static void fill_JTJ_lower(float *JTJ, uint8_t n)
+{
+    for (uint8_t i = 1; i < n; i++) {
+        for (uint8_t j = 0; j < i; j++) {
+            JTJ[i*n+j] = JTJ[j*n+i];
+        }
+    }
+}
+
 void CompassCalibrator::calc_initial_offset()
 {
     // Set initial offset to the average value of the samples
@@ -510,7 +557,7 @@ void CompassCalibrator::run_sphere_fit()
     fit1_params = fit2_params = _params;
 
     float JTJ[COMPASS_CAL_NUM_SPHERE_PARAMS*COMPASS_CAL_NUM_SPHERE_PARAMS] = { };
-    float JTJ2[COMPASS_CAL_NUM_SPHERE_PARAMS*COMPASS_CAL_NUM_SPHERE_PARAMS] = { };
+    float JTJ2[COMPASS_CAL_NUM_SPHERE_PARAMS*COMPASS_CAL_NUM_SPHERE_PARAMS];
     float JTFI[COMPASS_CAL_NUM_SPHERE_PARAMS] = { };
 
     // Gauss Newton Part common for all kind of extensions including LM
@@ -520,17 +567,12 @@ void CompassCalibrator::run_sphere_fit()
         float sphere_jacob[COMPASS_CAL_NUM_SPHERE_PARAMS];
 
         calc_sphere_jacob(sample, fit1_params, sphere_jacob);
+        const float residual = calc_residual(sample, fit1_params);
 
-        for(uint8_t i = 0;i < COMPASS_CAL_NUM_SPHERE_PARAMS; i++) {
-            // compute JTJ
-            for(uint8_t j = 0; j < COMPASS_CAL_NUM_SPHERE_PARAMS; j++) {
-                JTJ[i*COMPASS_CAL_NUM_SPHERE_PARAMS+j] += sphere_jacob[i] * sphere_jacob[j];
-                JTJ2[i*COMPASS_CAL_NUM_SPHERE_PARAMS+j] += sphere_jacob[i] * sphere_jacob[j];   //a backup JTJ for LM
-            }
-            // compute JTFI
-            JTFI[i] += sphere_jacob[i] * calc_residual(sample, fit1_params);
-        }
+        accumulate_JTJ(sphere_jacob, residual, COMPASS_CAL_NUM_SPHERE_PARAMS, JTJ, JTFI);
     }
+    fill_JTJ_lower(JTJ, COMPASS_CAL_NUM_SPHERE_PARAMS);
+    memcpy(JTJ2, JTJ, sizeof(JTJ2));   //a backup JTJ for LM
 
 
     //------------------------Levenberg-Marquardt-part-starts-here---------------------------------//
@@ -540,19 +582,20 @@ void CompassCalibrator::run_sphere_fit()
         JTJ2[i*COMPASS_CAL_NUM_SPHERE_PARAMS+i] += _sphere_lambda/lma_damping;
     }
 
-    if(!inverse(JTJ, JTJ, 4)) {
+    // the damped JTJ is positive definite, so the steps are solved for
+    // directly rather than through its inverse
+    float step1[COMPASS_CAL_NUM_SPHERE_PARAMS], step2[COMPASS_CAL_NUM_SPHERE_PARAMS];
+    if(!mat_cholesky_solve<COMPASS_CAL_NUM_SPHERE_PARAMS>(JTJ, JTFI, step1)) {
         return;
     }
 
-    if(!inverse(JTJ2, JTJ2, 4)) {
+    if(!mat_cholesky_solve<COMPASS_CAL_NUM_SPHERE_PARAMS>(JTJ2, JTFI, step2)) {
         return;
     }
 
     for(uint8_t row=0; row < COMPASS_CAL_NUM_SPHERE_PARAMS; row++) {
-        for(uint8_t col=0; col < COMPASS_CAL_NUM_SPHERE_PARAMS; col++) {
-            fit1_params.get_sphere_params()[row] -= JTFI[col] * JTJ[row*COMPASS_CAL_NUM_SPHERE_PARAMS+col];
-            fit2_params.get_sphere_params()[row] -= JTFI[col] * JTJ2[row*COMPASS_CAL_NUM_SPHERE_PARAMS+col];
-        }
+        fit1_params.get_sphere_params()[row] -= step1[row];
+        fit2_params.get_sphere_params()[row] -= step2[row];
     }
 
     fit1 = calc_mean_squared_residuals(fit1_params);
@@ -623,7 +666,7 @@ void CompassCalibrator::run_ellipsoid_fit()
 
 
     float JTJ[COMPASS_CAL_NUM_ELLIPSOID_PARAMS*COMPASS_CAL_NUM_ELLIPSOID_PARAMS] = { };
-    float JTJ2[COMPASS_CAL_NUM_ELLIPSOID_PARAMS*COMPASS_CAL_NUM_ELLIPSOID_PARAMS] = { };
+    float JTJ2[COMPASS_CAL_NUM_ELLIPSOID_PARAMS*COMPASS_CAL_NUM_ELLIPSOID_PARAMS];
     float JTFI[COMPASS_CAL_NUM_ELLIPSOID_PARAMS] = { };
 
     // Gauss Newton Part common for all kind of extensions including LM
@@ -633,17 +676,12 @@ void CompassCalibrator::run_ellipsoid_fit()
         float ellipsoid_jacob[COMPASS_CAL_NUM_ELLIPSOID_PARAMS];
 
         calc_ellipsoid_jacob(sample, fit1_params, ellipsoid_jacob);
+        const float residual = calc_residual(sample, fit1_params);
 
-        for(uint8_t i = 0;i < COMPASS_CAL_NUM_ELLIPSOID_PARAMS; i++) {
-            // compute JTJ
-            for(uint8_t j = 0; j < COMPASS_CAL_NUM_ELLIPSOID_PARAMS; j++) {
-                JTJ [i*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+j] += ellipsoid_jacob[i] * ellipsoid_jacob[j];
-                JTJ2[i*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+j] += ellipsoid_jacob[i] * ellipsoid_jacob[j];
-            }
-            // compute JTFI
-            JTFI[i] += ellipsoid_jacob[i] * calc_residual(sample, fit1_params);
-        }
+        accumulate_JTJ(ellipsoid_jacob, residual, COMPASS_CAL_NUM_ELLIPSOID_PARAMS, JTJ, JTFI);
     }
+    fill_JTJ_lower(JTJ, COMPASS_CAL_NUM_ELLIPSOID_PARAMS);
+    memcpy(JTJ2, JTJ, sizeof(JTJ2));
 
 
 
@@ -654,19 +692,20 @@ void CompassCalibrator::run_ellipsoid_fit()
         JTJ2[i*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+i] += _ellipsoid_lambda/lma_damping;
     }
 
-    if(!inverse(JTJ, JTJ, 9)) {
+    // the damped JTJ is positive definite, so the steps are solved for
+    // directly rather than through its inverse
+    float step1[COMPASS_CAL_NUM_ELLIPSOID_PARAMS], step2[COMPASS_CAL_NUM_ELLIPSOID_PARAMS];
+    if(!mat_cholesky_solve<COMPASS_CAL_NUM_ELLIPSOID_PARAMS>(JTJ, JTFI, step1)) {
         return;
     }
 
-    if(!inverse(JTJ2, JTJ2, 9)) {
+    if(!mat_cholesky_solve<COMPASS_CAL_NUM_ELLIPSOID_PARAMS>(JTJ2, JTFI, step2)) {
         return;
     }
 
     for(uint8_t row=0; row < COMPASS_CAL_NUM_ELLIPSOID_PARAMS; row++) {
-        for(uint8_t col=0; col < COMPASS_CAL_NUM_ELLIPSOID_PARAMS; col++) {
-            fit1_params.get_ellipsoid_params()[row] -= JTFI[col] * JTJ[row*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+col];
-            fit2_params.get_ellipsoid_params()[row] -= JTFI[col] * JTJ2[row*COMPASS_CAL_NUM_ELLIPSOID_PARAMS+col];
-        }
+        fit1_params.get_ellipsoid_params()[row] -= step1[row];
+        fit2_params.get_ellipsoid_params()[row] -= step2[row];
     }
 
     fit1 = calc_mean_squared_residuals(fit1_params);
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <AP_HAL/AP_HAL.h>
 #include <AP_Math/AP_Math.h>
 
 #define COMPASS_CAL_NUM_SPHERE_PARAMS 4
 #define COMPASS_CAL_NUM_ELLIPSOID_PARAMS 9
+
+// boards with the memory and CPU time to spare can collect more
+// samples for a better fit. Each sample takes 9 bytes per compass
+#ifndef COMPASS_CAL_NUM_SAMPLES
 #define COMPASS_CAL_NUM_SAMPLES 300
+#endif
 
 //RMS tolerance
 #define COMPASS_CAL_DEFAULT_TOLERANCE 5.0f
@@ -28,9 +34,15 @@ public:
     void start(bool retry, float delay, uint16_t offset_max, uint8_t compass_idx);
     void clear();
 
+    // run one step of the fit once the sample buffer is full. This
+    // may take several milliseconds, and is called from the compass
+    // calibration thread when there is one
     void update(bool &failure);
     void new_sample(const Vector3f &sample);
 
+    // true when the sample buffer is full and update() has fitting to do
+    bool fitting() const;
+
     bool check_for_timeout();
 
     bool running() const;
@@ -129,6 +141,11 @@ private:
     uint16_t _samples_thinned;
     float _orientation_confidence;
 
+    // protects the state above between update(), which may run in the
+    // calibration thread, new_sample(), called from the compass
+    // backends, and the main thread
+    HAL_Semaphore _sem;
+
     bool set_status(compass_cal_status_t status);
 
     // returns true if sample should be added to buffer
@@ -141,8 +158,6 @@ private:
     void reset_state();
     void initialize_fit();
 
-    bool fitting() const;
-
     // thins out samples between step one and step two
     void thin_samples();
 
@@ -5,6 +5,9 @@
 #include "AP_Compass.h"
 #include <GCS_MAVLink/GCS.h>
 #include <SRV_Channel/SRV_Channel.h>
+#include <AP_AHRS/AP_AHRS.h>
+#include <AP_Declination/AP_Declination.h>
+#include <AP_Logger/AP_Logger.h>
 
 extern const AP_HAL::HAL &hal;
 
@@ -87,6 +90,13 @@ const AP_Param::GroupInfo Compass_PerMotor::var_info[] = {
     // @Description: Compensation for Z axis of motor4
     // @User: Advanced
     AP_GROUPINFO("4",  6, Compass_PerMotor, compensation[3], 0),
+
+    // @Param: _LRN
+    // @DisplayName: per-motor compass correction learning
+    // @Description: This enables learning of the per-motor compass corrections in flight. The corrections are used once they have converged, and are saved on landing
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO("_LRN", 7, Compass_PerMotor, learn, 0),
     
     AP_GROUPEND
 };
@@ -229,3 +239,188 @@ void Compass_PerMotor::compensate(Vector3f &offset)
         offset += c * output;
     }
 }
+
+/*
+  in-flight learning
+
+  With the attitude from the AHRS and the earth field from the tables
+  in AP_Declination, the field the compass should read is known. The
+  difference between that and the field without per-motor compensation
+  is modelled as the sum of each motor's output times its compensation
+  vector, plus a bias for whatever offset and earth field errors
+  remain, and fitted by recursive least squares with forgetting.
+
+  The update is one 5x5 covariance per sample, about 100 multiplies,
+  so it runs on every new sample from the first compass
+ */
+
+// initial covariance, in (mGauss per unit output)^2
+static const float learn_P_init = 1.0e4f;
+// forgetting factor, the estimate follows a few hundred samples
+static const float learn_forgetting = 0.998f;
+// motor covariance below which the compensation is used
+static const float learn_P_converged = 0.05f;
+
+void Compass_PerMotor::learn_reset(void)
+{
+    memset(rls.P, 0, sizeof(rls.P));
+    for (uint8_t i=0; i<num_learn_params; i++) {
+        rls.P[i][i] = learn_P_init;
+        rls.theta[i].zero();
+    }
+    // start from the current compensation
+    for (uint8_t i=0; i<4; i++) {
+        rls.theta[i] = compensation[i].get();
+    }
+    rls.converged = false;
+}
+
+/*
+  one recursive least squares step for regressor phi and observed
+  field error y
+ */
+void Compass_PerMotor::learn_sample(const float phi[num_learn_params], const Vector3f &y)
+{
+    const uint8_t n = num_learn_params;
+
+    // Pphi = P * phi, and the innovation variance
+    float Pphi[n];
+    float denom = learn_forgetting;
+    for (uint8_t i=0; i<n; i++) {
+        Pphi[i] = 0;
+        for (uint8_t j=0; j<n; j++) {
+            Pphi[i] += rls.P[i][j] * phi[j];
+        }
+        denom += phi[i] * Pphi[i];
+    }
+    if (!is_positive(denom)) {
+        return;
+    }
+
+    // prediction error, per axis
+    Vector3f err = y;
+    for (uint8_t i=0; i<n; i++) {
+        err -= rls.theta[i] * phi[i];
+    }
+
+    // gain and parameter update
+    float k[n];
+    for (uint8_t i=0; i<n; i++) {
+        k[i] = Pphi[i] / denom;
+        rls.theta[i] += err * k[i];
+    }
+
+    // P = (P - k * Pphi^T) / lambda. Only forget while the covariance
+    // is below its initial size, so it doesn't wind up when the motors
+    // aren't changing enough to tell them apart
+    float trace = 0;
+    for (uint8_t i=0; i<n; i++) {
+        trace += rls.P[i][i];
+    }
+    const float scale = trace < n * learn_P_init ? 1.0f / learn_forgetting : 1.0f;
+    for (uint8_t i=0; i<n; i++) {
+        for (uint8_t j=i; j<n; j++) {
+            const float v = (rls.P[i][j] - k[i] * Pphi[j]) * scale;
+            rls.P[i][j] = v;
+            rls.P[j][i] = v;
+        }
+    }
+}
+
+bool Compass_PerMotor::learn_check_converged(void) const
+{
+    for (uint8_t i=0; i<4; i++) {
+        if (rls.P[i][i] > learn_P_converged) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Compass_PerMotor::learn_update(void)
+{
+    if (learn.get() == 0 || running) {
+        return;
+    }
+    const AP_AHRS &ahrs = AP::ahrs();
+    const bool flying = hal.util->get_soft_armed() && ahrs.get_time_flying_ms() > 3000;
+
+    if (!flying) {
+        if (rls.was_flying) {
+            rls.was_flying = false;
+            if (rls.converged) {
+                // save what we learnt on landing
+                for (uint8_t i=0; i<4; i++) {
+                    compensation[i].save();
+                }
+                enable.set_and_save(1);
+                gcs().send_text(MAV_SEVERITY_INFO, "PerMotor: saved learnt compensation");
+            }
+        }
+        return;
+    }
+
+    if (!rls.was_flying) {
+        rls.was_flying = true;
+        learn_reset();
+    }
+
+    if (!rls.have_earth_field) {
+        Location loc;
+        if (!ahrs.get_position(loc)) {
+            return;
+        }
+        float declination_deg=0, inclination_deg=0, intensity_gauss=0;
+        if (!AP_Declination::get_mag_field_ef(loc.lat*1.0e-7f, loc.lng*1.0e-7f, intensity_gauss, declination_deg, inclination_deg)) {
+            return;
+        }
+        Matrix3f R;
+        R.from_euler(0.0f, -ToRad(inclination_deg), ToRad(declination_deg));
+        rls.mag_ef = R * Vector3f(intensity_gauss*1000, 0.0, 0.0);
+        rls.have_earth_field = true;
+    }
+
+    // per-motor compensation only applies to the first compass
+    if (!compass.healthy(0) || !compass.have_new_sample(0, rls.last_compass_sample)) {
+        return;
+    }
+    rls.last_compass_sample = compass.get_sample_count(0);
+
+    float phi[num_learn_params];
+    for (uint8_t i=0; i<4; i++) {
+        phi[i] = scaled_output(i);
+    }
+    phi[4] = 1;
+
+    // expected field in body frame, less the field without motor compensation
+    const Vector3f expected = ahrs.get_rotation_body_to_ned().mul_transpose(rls.mag_ef);
+    const Vector3f uncompensated = compass.get_field(0) - compass.get_motor_offsets(0);
+
+    learn_sample(phi, expected - uncompensated);
+
+    if (!rls.converged && learn_check_converged()) {
+        rls.converged = true;
+        gcs().send_text(MAV_SEVERITY_INFO, "PerMotor: compensation learnt");
+    }
+    if (rls.converged) {
+        for (uint8_t i=0; i<4; i++) {
+            compensation[i].set(rls.theta[i]);
+        }
+        enable.set(1);
+    }
+
+    const uint32_t now = AP_HAL::millis();
+    if (now - rls.last_log_ms >= 100) {
+        rls.last_log_ms = now;
+        AP::logger().Write("PMLN", "TimeUS,BX,BY,BZ,P1,P2,P3,P4,C", "QfffffffB",
+                           AP_HAL::micros64(),
+                           (double)rls.theta[4].x,
+                           (double)rls.theta[4].y,
+                           (double)rls.theta[4].z,
+                           (double)rls.P[0][0],
+                           (double)rls.P[1][1],
+                           (double)rls.P[2][2],
+                           (double)rls.P[3][3],
+                           rls.converged);
+    }
+}
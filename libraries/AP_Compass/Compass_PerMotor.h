@@ -28,12 +28,16 @@ public:
     void calibration_update(void);
     void calibration_end(void);
     void compensate(Vector3f &offset);
+
+    // in-flight learning of the compensation, called on each compass read
+    void learn_update(void);
     
 private:
     Compass &compass;
     AP_Int8 enable;
     AP_Float expo;
     AP_Vector3f compensation[4];
+    AP_Int8 learn;
 
     // base field on test start
     Vector3f base_field;
@@ -62,5 +66,27 @@ private:
     // map of motors
     bool have_motor_map;
     uint8_t motor_map[4];
+
+    /*
+      recursive least squares state for in-flight learning. The
+      regressor is the 4 motor outputs and a constant for the bias, and
+      is the same for each axis, so one covariance serves all three
+      axes and theta holds a vector per regressor
+     */
+    static const uint8_t num_learn_params = 5;
+    struct {
+        float P[num_learn_params][num_learn_params];
+        Vector3f theta[num_learn_params];
+        Vector3f mag_ef;
+        uint32_t last_compass_sample;
+        uint32_t last_log_ms;
+        bool have_earth_field;
+        bool converged;
+        bool was_flying;
+    } rls;
+
+    void learn_reset(void);
+    void learn_sample(const float phi[num_learn_params], const Vector3f &y);
+    bool learn_check_converged(void) const;
 };
 
@@ -0,0 +1,132 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_ESC_Telem.h"
+
+#include <AP_Math/AP_Math.h>
+
+// weight of each new interval in the update rate filter
+#define ESC_TELEM_RATE_FILTER_ALPHA     0.1f
+
+// telemetry older than this is not used for the average RPM
+#define ESC_TELEM_DATA_TIMEOUT_MS       1000
+
+static AP_ESC_Telem instance;
+
+void AP_ESC_Telem::update_telem_data(uint8_t esc_index, const TelemetryData &new_data, uint8_t data_mask, Source source)
+{
+    if (esc_index >= ESC_TELEM_MAX_ESCS) {
+        return;
+    }
+    Slot &slot = _slots[esc_index];
+
+    // we are the only writer of this slot, so can work on a copy of
+    // it outside the write
+    TelemetryData td = slot.data;
+    if (data_mask & TELEM_RPM) {
+        td.rpm = new_data.rpm;
+    }
+    if (data_mask & TELEM_VOLTAGE) {
+        td.voltage = new_data.voltage;
+    }
+    if (data_mask & TELEM_CURRENT) {
+        td.current = new_data.current;
+    }
+    if (data_mask & TELEM_CONSUMPTION) {
+        td.consumption_mah = new_data.consumption_mah;
+    }
+    if (data_mask & TELEM_TEMPERATURE) {
+        td.temperature = new_data.temperature;
+    }
+    td.types |= data_mask;
+    td.source = source;
+    td.count++;
+
+    const uint32_t now_us = AP_HAL::micros();
+    if (td.last_update_us != 0 && now_us != td.last_update_us) {
+        const float rate_hz = 1.0e6f / (now_us - td.last_update_us);
+        if (is_zero(td.update_rate_hz)) {
+            td.update_rate_hz = rate_hz;
+        } else {
+            td.update_rate_hz += (rate_hz - td.update_rate_hz) * ESC_TELEM_RATE_FILTER_ALPHA;
+        }
+    }
+    td.last_update_us = now_us;
+    td.last_update_ms = AP_HAL::millis();
+
+    const uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.data = td;
+    slot.seq.store(seq + 2, std::memory_order_release);
+}
+
+void AP_ESC_Telem::update_rpm(uint8_t esc_index, float rpm, Source source)
+{
+    TelemetryData td {};
+    td.rpm = rpm;
+    update_telem_data(esc_index, td, TELEM_RPM, source);
+}
+
+bool AP_ESC_Telem::get_telem_data(uint8_t esc_index, TelemetryData &td) const
+{
+    if (esc_index >= ESC_TELEM_MAX_ESCS) {
+        return false;
+    }
+    const Slot &slot = _slots[esc_index];
+    for (uint8_t i=0; i<read_attempts; i++) {
+        const uint32_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq & 1U) {
+            // being written
+            continue;
+        }
+        td = slot.data;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) == seq) {
+            return td.count != 0;
+        }
+    }
+    return false;
+}
+
+bool AP_ESC_Telem::get_average_rpm(float &rpm) const
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    float sum = 0;
+    uint8_t count = 0;
+    for (uint8_t i=0; i<ESC_TELEM_MAX_ESCS; i++) {
+        TelemetryData td;
+        if (get_telem_data(i, td) &&
+            (td.types & TELEM_RPM) &&
+            now_ms - td.last_update_ms < ESC_TELEM_DATA_TIMEOUT_MS) {
+            sum += td.rpm;
+            count++;
+        }
+    }
+    if (count == 0) {
+        return false;
+    }
+    rpm = sum / count;
+    return true;
+}
+
+namespace AP {
+
+AP_ESC_Telem &esc_telem()
+{
+    return instance;
+}
+
+};
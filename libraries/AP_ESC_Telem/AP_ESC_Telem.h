@@ -0,0 +1,104 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  common store of the latest telemetry from each ESC
+
+  The BLHeli, KDECAN and ToshibaCAN drivers each write the telemetry
+  they decode here, indexed by motor, and consumers such as the
+  harmonic notch and the ESC battery monitor read it without needing
+  to know which driver it came from.
+
+  Each ESC has one writer, the thread of the driver for that ESC, and
+  any number of readers. Readers never take a lock: each slot has a
+  sequence number that is odd while the slot is being written, and a
+  read is retried if the sequence number changed while it copied the
+  slot.
+ */
+#pragma once
+
+#include <AP_Common/AP_Common.h>
+#include <AP_HAL/AP_HAL.h>
+#include <atomic>
+
+#define ESC_TELEM_MAX_ESCS  12
+
+class AP_ESC_Telem {
+public:
+    AP_ESC_Telem() {}
+
+    /* Do not allow copies */
+    AP_ESC_Telem(const AP_ESC_Telem &other) = delete;
+    AP_ESC_Telem &operator=(const AP_ESC_Telem&) = delete;
+
+    // the driver telemetry for an ESC came from
+    enum class Source : uint8_t {
+        NONE       = 0,
+        BLHELI     = 1,
+        KDECAN     = 2,
+        TOSHIBACAN = 3,
+    };
+
+    // the fields of TelemetryData a driver is providing in an update
+    enum DataType : uint8_t {
+        TELEM_RPM         = (1U << 0),
+        TELEM_VOLTAGE     = (1U << 1),
+        TELEM_CURRENT     = (1U << 2),
+        TELEM_CONSUMPTION = (1U << 3),
+        TELEM_TEMPERATURE = (1U << 4),
+    };
+
+    struct TelemetryData {
+        float rpm;                  // motor speed in RPM
+        float voltage;              // volts
+        float current;              // amps
+        float consumption_mah;      // mAh
+        float temperature;          // degrees C
+        uint8_t types;              // mask of DataType this ESC has reported
+        Source source;              // driver of the last update
+        uint16_t count;             // number of updates received
+        uint32_t last_update_ms;    // system time of the last update
+        uint32_t last_update_us;    // system time of the last update in microseconds
+        float update_rate_hz;       // filtered rate updates are arriving at
+    };
+
+    // store new telemetry for an ESC. Only the fields in data_mask are
+    // taken from data, the others keep their last values. Called by
+    // the driver of that ESC only
+    void update_telem_data(uint8_t esc_index, const TelemetryData &data, uint8_t data_mask, Source source);
+
+    // store a new RPM for an ESC, for drivers that get the RPM on its own
+    void update_rpm(uint8_t esc_index, float rpm, Source source);
+
+    // get the latest telemetry for an ESC. Returns false if the ESC has
+    // never reported, or if it was being written each time we tried
+    bool get_telem_data(uint8_t esc_index, TelemetryData &td) const;
+
+    // get the average RPM of the ESCs that have reported RPM in the
+    // last second. Returns false if there are none
+    bool get_average_rpm(float &rpm) const;
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq{0};   // odd while the data is being written
+        TelemetryData data {};
+    } _slots[ESC_TELEM_MAX_ESCS];
+
+    // number of times a reader retries a slot that is being written
+    static const uint8_t read_attempts = 3;
+};
+
+namespace AP {
+    AP_ESC_Telem &esc_telem();
+};
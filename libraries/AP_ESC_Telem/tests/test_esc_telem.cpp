@@ -0,0 +1,61 @@
+#include <AP_gtest.h>
+
+#include <AP_ESC_Telem/AP_ESC_Telem.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+TEST(ESCTelem, NoData)
+{
+    AP_ESC_Telem telem;
+    AP_ESC_Telem::TelemetryData td;
+    float rpm;
+
+    EXPECT_FALSE(telem.get_telem_data(0, td));
+    EXPECT_FALSE(telem.get_telem_data(ESC_TELEM_MAX_ESCS, td));
+    EXPECT_FALSE(telem.get_average_rpm(rpm));
+
+    // out of range updates are ignored
+    telem.update_rpm(ESC_TELEM_MAX_ESCS, 1000, AP_ESC_Telem::Source::BLHELI);
+    EXPECT_FALSE(telem.get_average_rpm(rpm));
+}
+
+TEST(ESCTelem, MergeFields)
+{
+    AP_ESC_Telem telem;
+    AP_ESC_Telem::TelemetryData td {};
+    td.voltage = 16.2f;
+    td.current = 3.5f;
+    td.temperature = 40;
+    telem.update_telem_data(2, td, AP_ESC_Telem::TELEM_VOLTAGE | AP_ESC_Telem::TELEM_CURRENT, AP_ESC_Telem::Source::TOSHIBACAN);
+    telem.update_rpm(2, 12000, AP_ESC_Telem::Source::TOSHIBACAN);
+
+    AP_ESC_Telem::TelemetryData out;
+    ASSERT_TRUE(telem.get_telem_data(2, out));
+    EXPECT_FLOAT_EQ(16.2f, out.voltage);
+    EXPECT_FLOAT_EQ(3.5f, out.current);
+    EXPECT_FLOAT_EQ(12000, out.rpm);
+    // temperature was not in the mask, so was not taken
+    EXPECT_FLOAT_EQ(0, out.temperature);
+    EXPECT_EQ(AP_ESC_Telem::TELEM_VOLTAGE | AP_ESC_Telem::TELEM_CURRENT | AP_ESC_Telem::TELEM_RPM, out.types);
+    EXPECT_EQ(2, out.count);
+    EXPECT_TRUE(out.source == AP_ESC_Telem::Source::TOSHIBACAN);
+    EXPECT_FALSE(telem.get_telem_data(1, out));
+}
+
+TEST(ESCTelem, AverageRPM)
+{
+    AP_ESC_Telem telem;
+    AP_ESC_Telem::TelemetryData td {};
+    td.voltage = 12;
+
+    // an ESC that has not reported RPM is left out of the average
+    telem.update_telem_data(0, td, AP_ESC_Telem::TELEM_VOLTAGE, AP_ESC_Telem::Source::KDECAN);
+    telem.update_rpm(1, 1000, AP_ESC_Telem::Source::KDECAN);
+    telem.update_rpm(3, 3000, AP_ESC_Telem::Source::BLHELI);
+
+    float rpm;
+    ASSERT_TRUE(telem.get_average_rpm(rpm));
+    EXPECT_FLOAT_EQ(2000, rpm);
+}
+
+AP_GTEST_MAIN()
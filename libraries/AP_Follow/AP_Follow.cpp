@@ -33,6 +33,10 @@ extern const AP_HAL::HAL& hal;
 
 #define AP_FOLLOW_POS_P_DEFAULT 0.1f    // position error gain default
 
+#define AP_FOLLOW_POS_NOISE     1.0f    // reported position noise in meters
+#define AP_FOLLOW_VEL_NOISE     0.5f    // reported velocity noise in m/s
+#define AP_FOLLOW_ACCEL_NOISE   2.0f    // target acceleration noise in m/s/s, how quickly the filter follows manoeuvres
+
 // table of user settable parameters
 const AP_Param::GroupInfo AP_Follow::var_info[] = {
 
@@ -132,35 +136,74 @@ AP_Follow::AP_Follow() :
 
 // get target's estimated location
 bool AP_Follow::get_target_location_and_velocity(Location &loc, Vector3f &vel_ned) const
+{
+    return get_target_location_and_velocity((uint8_t)_sysid.get(), loc, vel_ned);
+}
+
+// get estimated location of any tracked vehicle.  This only extrapolates
+// the filter from the last update, so is cheap enough to call every loop
+bool AP_Follow::get_target_location_and_velocity(uint8_t sysid, Location &loc, Vector3f &vel_ned) const
 {
     // exit immediately if not enabled
     if (!_enabled) {
         return false;
     }
 
+    const target_t *target = find_target(sysid);
+    if (target == nullptr) {
+        return false;
+    }
+
     // check for timeout
-    if ((_last_location_update_ms == 0) || (AP_HAL::millis() - _last_location_update_ms > AP_FOLLOW_TIMEOUT_MS)) {
+    if ((target->last_location_update_ms == 0) || (AP_HAL::millis() - target->last_location_update_ms > AP_FOLLOW_TIMEOUT_MS)) {
         return false;
     }
 
     // calculate time since last actual position update
-    const float dt = (AP_HAL::millis() - _last_location_update_ms) * 0.001f;
+    const float dt = (AP_HAL::millis() - target->last_location_update_ms) * 0.001f;
 
     // get velocity estimate
-    if (!get_velocity_ned(vel_ned, dt)) {
-        return false;
-    }
+    vel_ned.x = target->filter[0].get_vel();
+    vel_ned.y = target->filter[1].get_vel();
+    vel_ned.z = target->filter[2].get_vel();
 
     // project the vehicle position
-    Location last_loc = _target_location;
-    last_loc.offset(vel_ned.x * dt, vel_ned.y * dt);
-    last_loc.alt -= vel_ned.z * 100.0f * dt; // convert m/s to cm/s, multiply by dt.  minus because NED
+    Location last_loc = target->origin;
+    last_loc.offset(target->filter[0].get_pos(dt), target->filter[1].get_pos(dt));
+    last_loc.alt -= target->filter[2].get_pos(dt) * 100.0f; // convert m to cm.  minus because NED
 
     // return latest position estimate
     loc = last_loc;
     return true;
 }
 
+// get number of vehicles being tracked
+uint8_t AP_Follow::get_num_targets() const
+{
+    uint8_t count = 0;
+    for (uint8_t i=0; i<AP_FOLLOW_MAX_TARGETS; i++) {
+        if (_targets[i].sysid != 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// get mavlink system id of a tracked vehicle
+uint8_t AP_Follow::get_target_sysid(uint8_t instance) const
+{
+    for (uint8_t i=0; i<AP_FOLLOW_MAX_TARGETS; i++) {
+        if (_targets[i].sysid == 0) {
+            continue;
+        }
+        if (instance == 0) {
+            return _targets[i].sysid;
+        }
+        instance--;
+    }
+    return 0;
+}
+
 // get distance vector to target (in meters) and target's velocity all in NED frame
 bool AP_Follow::get_target_dist_and_vel_ned(Vector3f &dist_ned, Vector3f &dist_with_offs, Vector3f &vel_ned)
 {
@@ -227,13 +270,18 @@ bool AP_Follow::get_target_heading_deg(float &heading) const
         return false;
     }
 
+    const target_t *target = find_target((uint8_t)_sysid.get());
+    if (target == nullptr) {
+        return false;
+    }
+
     // check for timeout
-    if ((_last_heading_update_ms == 0) || (AP_HAL::millis() - _last_heading_update_ms > AP_FOLLOW_TIMEOUT_MS)) {
+    if ((target->last_heading_update_ms == 0) || (AP_HAL::millis() - target->last_heading_update_ms > AP_FOLLOW_TIMEOUT_MS)) {
         return false;
     }
 
     // return latest heading estimate
-    heading = _target_heading;
+    heading = target->heading;
     return true;
 }
 
@@ -250,96 +298,220 @@ void AP_Follow::handle_msg(const mavlink_message_t &msg)
         return;
     }
 
-    // skip message if not from our target
-    if (_sysid != 0 && msg.sysid != _sysid) {
-        if (_automatic_sysid) {
-            // maybe timeout who we were following...
-            if ((_last_location_update_ms == 0) || (AP_HAL::millis() - _last_location_update_ms > AP_FOLLOW_SYSID_TIMEOUT_MS)) {
-                _sysid.set(0);
-            }
-        }
+    // only position reports are used
+    if (msg.msgid != MAVLINK_MSG_ID_GLOBAL_POSITION_INT) {
         return;
     }
 
+    // maybe timeout who we were following...
+    if (_sysid != 0 && msg.sysid != _sysid && _automatic_sysid) {
+        const target_t *followed = find_target((uint8_t)_sysid.get());
+        if (followed == nullptr || (AP_HAL::millis() - followed->last_location_update_ms > AP_FOLLOW_SYSID_TIMEOUT_MS)) {
+            _sysid.set(0);
+        }
+    }
+
     // decode global-position-int message
-    if (msg.msgid == MAVLINK_MSG_ID_GLOBAL_POSITION_INT) {
+    mavlink_global_position_int_t packet;
+    mavlink_msg_global_position_int_decode(&msg, &packet);
 
-        // get estimated location and velocity (for logging)
-        Location loc_estimate{};
-        Vector3f vel_estimate;
-        UNUSED_RESULT(get_target_location_and_velocity(loc_estimate, vel_estimate));
+    // ignore message if lat and lon are (exactly) zero
+    if ((packet.lat == 0 && packet.lon == 0)) {
+        return;
+    }
 
-        // decode message
-        mavlink_global_position_int_t packet;
-        mavlink_msg_global_position_int_decode(&msg, &packet);
+    // every vehicle reporting its position is tracked as a candidate
+    // target, so there is an estimate ready when switching to it
+    target_t *target = find_or_add_target(msg.sysid);
+    if (target == nullptr) {
+        return;
+    }
+    const bool followed = (_sysid == 0 || msg.sysid == _sysid);
 
-        // ignore message if lat and lon are (exactly) zero
-        if ((packet.lat == 0 && packet.lon == 0)) {
-            return;
-        }
+    // get estimated location and velocity (for logging)
+    Location loc_estimate{};
+    Vector3f vel_estimate;
+    if (followed) {
+        UNUSED_RESULT(get_target_location_and_velocity(msg.sysid, loc_estimate, vel_estimate));
+    }
 
-        _target_location.lat = packet.lat;
-        _target_location.lng = packet.lon;
-
-        // select altitude source based on FOLL_ALT_TYPE param 
-        if (_alt_type == AP_FOLLOW_ALTITUDE_TYPE_RELATIVE) {
-            // relative altitude
-            _target_location.alt = packet.relative_alt / 10;        // convert millimeters to cm
-            _target_location.relative_alt = 1;                // set relative_alt flag
-        } else {
-            // absolute altitude
-            _target_location.alt = packet.alt / 10;                 // convert millimeters to cm
-            _target_location.relative_alt = 0;                // reset relative_alt flag
-        }
+    Location loc;
+    loc.lat = packet.lat;
+    loc.lng = packet.lon;
 
-        _target_velocity_ned.x = packet.vx * 0.01f; // velocity north
-        _target_velocity_ned.y = packet.vy * 0.01f; // velocity east
-        _target_velocity_ned.z = packet.vz * 0.01f; // velocity down
+    // select altitude source based on FOLL_ALT_TYPE param
+    if (_alt_type == AP_FOLLOW_ALTITUDE_TYPE_RELATIVE) {
+        // relative altitude
+        loc.alt = packet.relative_alt / 10;         // convert millimeters to cm
+        loc.relative_alt = 1;                       // set relative_alt flag
+    } else {
+        // absolute altitude
+        loc.alt = packet.alt / 10;                  // convert millimeters to cm
+        loc.relative_alt = 0;                       // reset relative_alt flag
+    }
+
+    const Vector3f vel_ned(packet.vx * 0.01f,       // velocity north
+                           packet.vy * 0.01f,       // velocity east
+                           packet.vz * 0.01f);      // velocity down
+
+    // get a local timestamp with correction for transport jitter
+    const uint32_t time_ms = target->jitter.correct_offboard_timestamp_msec(packet.time_boot_ms, AP_HAL::millis());
+    update_target(*target, loc, vel_ned, time_ms);
+    if (packet.hdg <= 36000) {                      // heading (UINT16_MAX if unknown)
+        target->heading = packet.hdg * 0.01f;       // convert centi-degrees to degrees
+        target->last_heading_update_ms = time_ms;
+    }
+
+    if (!followed) {
+        return;
+    }
+
+    // initialise _sysid if zero to sender's id
+    if (_sysid == 0) {
+        _sysid.set(msg.sysid);
+        _automatic_sysid = true;
+    }
+
+    // log lead's estimated vs reported position
+    AP::logger().Write("FOLL",
+                                           "TimeUS,Lat,Lon,Alt,VelN,VelE,VelD,LatE,LonE,AltE",  // labels
+                                           "sDUmnnnDUm",    // units
+                                           "F--B000--B",    // mults
+                                           "QLLifffLLi",    // fmt
+                                           AP_HAL::micros64(),
+                                           loc.lat,
+                                           loc.lng,
+                                           loc.alt,
+                                           (double)vel_ned.x,
+                                           (double)vel_ned.y,
+                                           (double)vel_ned.z,
+                                           loc_estimate.lat,
+                                           loc_estimate.lng,
+                                           loc_estimate.alt
+                                           );
+}
+
+// find a tracked vehicle by system id
+const AP_Follow::target_t *AP_Follow::find_target(uint8_t sysid) const
+{
+    if (sysid == 0) {
+        return nullptr;
+    }
+    for (uint8_t i=0; i<AP_FOLLOW_MAX_TARGETS; i++) {
+        if (_targets[i].sysid == sysid) {
+            return &_targets[i];
+        }
+    }
+    return nullptr;
+}
 
-        // get a local timestamp with correction for transport jitter
-        _last_location_update_ms = _jitter.correct_offboard_timestamp_msec(packet.time_boot_ms, AP_HAL::millis());
-        if (packet.hdg <= 36000) {                  // heading (UINT16_MAX if unknown)
-            _target_heading = packet.hdg * 0.01f;   // convert centi-degrees to degrees
-            _last_heading_update_ms = _last_location_update_ms;
+// find a tracked vehicle by system id, or take a free slot or one whose
+// vehicle has timed out.  The vehicle being followed is kept for longer
+AP_Follow::target_t *AP_Follow::find_or_add_target(uint8_t sysid)
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    target_t *slot = nullptr;
+    for (uint8_t i=0; i<AP_FOLLOW_MAX_TARGETS; i++) {
+        target_t &target = _targets[i];
+        if (target.sysid == sysid) {
+            return &target;
+        }
+        if (slot != nullptr && slot->sysid == 0) {
+            continue;
         }
-        // initialise _sysid if zero to sender's id
-        if (_sysid == 0) {
-            _sysid.set(msg.sysid);
-            _automatic_sysid = true;
+        const uint32_t timeout_ms = (target.sysid == _sysid) ? AP_FOLLOW_SYSID_TIMEOUT_MS : AP_FOLLOW_TIMEOUT_MS;
+        if (target.sysid == 0 || (now_ms - target.last_location_update_ms > timeout_ms)) {
+            slot = &target;
         }
+    }
+    if (slot == nullptr) {
+        return nullptr;
+    }
+    slot->sysid = sysid;
+    slot->last_location_update_ms = 0;
+    slot->last_heading_update_ms = 0;
+    slot->jitter.reset();
+    return slot;
+}
 
-        // log lead's estimated vs reported position
-        AP::logger().Write("FOLL",
-                                               "TimeUS,Lat,Lon,Alt,VelN,VelE,VelD,LatE,LonE,AltE",  // labels
-                                               "sDUmnnnDUm",    // units
-                                               "F--B000--B",    // mults
-                                               "QLLifffLLi",    // fmt
-                                               AP_HAL::micros64(),
-                                               _target_location.lat,
-                                               _target_location.lng,
-                                               _target_location.alt,
-                                               (double)_target_velocity_ned.x,
-                                               (double)_target_velocity_ned.y,
-                                               (double)_target_velocity_ned.z,
-                                               loc_estimate.lat,
-                                               loc_estimate.lng,
-                                               loc_estimate.alt
-                                               );
+// update a vehicle from a position report.  The filters are predicted
+// to the time of the report, corrected by it and then moved to be
+// relative to it, so positions stay small
+void AP_Follow::update_target(target_t &target, const Location &loc, const Vector3f &vel_ned, uint32_t time_ms)
+{
+    const int32_t dt_ms = time_ms - target.last_location_update_ms;
+    if (target.last_location_update_ms == 0 ||
+        dt_ms > AP_FOLLOW_TIMEOUT_MS ||
+        target.origin.relative_alt != loc.relative_alt) {
+        // start again from the report
+        for (uint8_t i=0; i<3; i++) {
+            target.filter[i].init(0.0f, vel_ned[i]);
+        }
+    } else {
+        const float dt = MAX(dt_ms, 0) * 0.001f;
+        const Vector3f pos_ned = location_3d_diff_NED(target.origin, loc);
+        for (uint8_t i=0; i<3; i++) {
+            target.filter[i].predict(dt);
+            target.filter[i].fuse(pos_ned[i], vel_ned[i]);
+            target.filter[i].shift(pos_ned[i]);
+        }
     }
+    target.origin = loc;
+    target.last_location_update_ms = time_ms;
 }
 
-// get velocity estimate in m/s in NED frame using dt since last update
-bool AP_Follow::get_velocity_ned(Vector3f &vel_ned, float dt) const
+// initialise the filter at a position and velocity
+void AP_Follow::AxisFilter::init(float pos, float vel)
 {
-    vel_ned = _target_velocity_ned + (_target_accel_ned * dt);
-    return true;
+    _pos = pos;
+    _vel = vel;
+    _P00 = sq(AP_FOLLOW_POS_NOISE);
+    _P01 = 0.0f;
+    _P11 = sq(AP_FOLLOW_VEL_NOISE);
+}
+
+// predict the filter forward dt seconds at constant velocity
+void AP_Follow::AxisFilter::predict(float dt)
+{
+    const float q = sq(AP_FOLLOW_ACCEL_NOISE);
+    const float dt2 = sq(dt);
+    _pos += _vel * dt;
+    _P00 += dt * (2.0f * _P01 + dt * _P11) + 0.25f * q * sq(dt2);
+    _P01 += dt * _P11 + 0.5f * q * dt2 * dt;
+    _P11 += q * dt2;
+}
+
+// fuse a reported position and velocity
+void AP_Follow::AxisFilter::fuse(float pos, float vel)
+{
+    // position
+    float S = _P00 + sq(AP_FOLLOW_POS_NOISE);
+    float K0 = _P00 / S;
+    float K1 = _P01 / S;
+    float innov = pos - _pos;
+    _pos += K0 * innov;
+    _vel += K1 * innov;
+    _P11 -= K1 * _P01;
+    _P00 *= (1.0f - K0);
+    _P01 *= (1.0f - K0);
+
+    // velocity
+    S = _P11 + sq(AP_FOLLOW_VEL_NOISE);
+    K0 = _P01 / S;
+    K1 = _P11 / S;
+    innov = vel - _vel;
+    _pos += K0 * innov;
+    _vel += K1 * innov;
+    _P00 -= K0 * _P01;
+    _P01 *= (1.0f - K1);
+    _P11 *= (1.0f - K1);
 }
 
 // initialise offsets to provided distance vector to other vehicle (in meters in NED frame) if required
 void AP_Follow::init_offsets_if_required(const Vector3f &dist_vec_ned)
 {
     // return immediately if offsets have already been set
-    if (!_offset.get().is_zero()) {
+    if (_formation_offset_set || !_offset.get().is_zero()) {
         return;
     }
 
@@ -358,7 +530,7 @@ void AP_Follow::init_offsets_if_required(const Vector3f &dist_vec_ned)
 // get offsets in meters in NED frame
 bool AP_Follow::get_offsets_ned(Vector3f &offset) const
 {
-    const Vector3f &off = _offset.get();
+    const Vector3f &off = _formation_offset_set ? _formation_offset : _offset.get();
 
     // if offsets are zero or type is NED, simply return offset vector
     if (off.is_zero() || (_offset_type == AP_FOLLOW_OFFSET_TYPE_NED)) {
@@ -22,6 +22,8 @@
 #include <AC_PID/AC_P.h>
 #include <AP_RTC/JitterCorrection.h>
 
+#define AP_FOLLOW_MAX_TARGETS   4   // number of vehicles tracked as candidate targets
+
 class AP_Follow
 {
 
@@ -54,9 +56,21 @@ public:
     // get target's estimated location and velocity (in NED)
     bool get_target_location_and_velocity(Location &loc, Vector3f &vel_ned) const;
 
+    // get estimated location and velocity (in NED) of any tracked vehicle by its mavlink system id
+    bool get_target_location_and_velocity(uint8_t sysid, Location &loc, Vector3f &vel_ned) const;
+
+    // get number of vehicles being tracked, and the mavlink system id of each (0 if none)
+    uint8_t get_num_targets() const;
+    uint8_t get_target_sysid(uint8_t instance) const;
+
     // get distance vector to target (in meters), target plus offsets, and target's velocity all in NED frame
     bool get_target_dist_and_vel_ned(Vector3f &dist_ned, Vector3f &dist_with_ofs, Vector3f &vel_ned);
 
+    // set offsets from the lead vehicle in meters, in the frame given by FOLL_OFS_TYPE.  These replace
+    // FOLL_OFS until cleared, so that each vehicle of a swarm can be given its place in a formation
+    void set_formation_offset(const Vector3f &offset) { _formation_offset = offset; _formation_offset_set = true; }
+    void clear_formation_offset() { _formation_offset_set = false; }
+
     // get position controller.  this controller is not used within this library but it is convenient to hold it here
     const AC_P& get_pos_p() const { return _p_pos; }
 
@@ -88,8 +102,41 @@ public:
 
 private:
 
-    // get velocity estimate in m/s in NED frame using dt since last update
-    bool get_velocity_ned(Vector3f &vel_ned, float dt) const;
+    // constant velocity Kalman filter of one axis of a vehicle's position
+    class AxisFilter {
+    public:
+        void init(float pos, float vel);
+        void predict(float dt);
+        void fuse(float pos, float vel);
+        // move the origin of the position by pos
+        void shift(float pos) { _pos -= pos; }
+        // position extrapolated dt seconds
+        float get_pos(float dt) const { return _pos + _vel * dt; }
+        float get_vel() const { return _vel; }
+    private:
+        float _pos, _vel;
+        float _P00, _P01, _P11;     // covariance
+    };
+
+    // a vehicle being tracked, updated when its position arrives and extrapolated in between
+    struct target_t {
+        uint8_t sysid;                      // mavlink system id, 0 if unused
+        uint32_t last_location_update_ms;   // system time of last position update
+        uint32_t last_heading_update_ms;    // system time of last heading update
+        float heading;                      // heading in degrees
+        Location origin;                    // last reported location, which the filters are relative to
+        AxisFilter filter[3];               // north, east and down in meters from origin
+        JitterCorrection jitter{3000};      // jitter correction with max transport lag of 3s
+    };
+
+    // find a tracked vehicle by system id, nullptr if it isn't tracked
+    const target_t *find_target(uint8_t sysid) const;
+
+    // find or make room for a vehicle to track, nullptr if all are busy
+    target_t *find_or_add_target(uint8_t sysid);
+
+    // update a vehicle from a position report
+    void update_target(target_t &target, const Location &loc, const Vector3f &vel_ned, uint32_t time_ms);
 
     // initialise offsets to provided distance vector to other vehicle (in meters in NED frame) if required
     void init_offsets_if_required(const Vector3f &dist_vec_ned);
@@ -115,16 +162,10 @@ private:
 
     // local variables
     bool _healthy;                  // true if we are receiving mavlink messages (regardless of whether they have target position info within them)
-    uint32_t _last_location_update_ms;  // system time of last position update
-    Location _target_location;      // last known location of target
-    Vector3f _target_velocity_ned;  // last known velocity of target in NED frame in m/s
-    Vector3f _target_accel_ned;     // last known acceleration of target in NED frame in m/s/s
-    uint32_t _last_heading_update_ms;   // system time of last heading update
-    float _target_heading;          // heading in degrees
+    target_t _targets[AP_FOLLOW_MAX_TARGETS];   // candidate targets, including the one being followed
     bool _automatic_sysid;          // did we lock onto a sysid automatically?
     float   _dist_to_target;        // latest distance to target in meters (for reporting purposes)
     float   _bearing_to_target;     // latest bearing to target in degrees (for reporting purposes)
-
-    // setup jitter correction with max transport lag of 3s
-    JitterCorrection _jitter{3000};
+    Vector3f _formation_offset;     // offset set by set_formation_offset()
+    bool    _formation_offset_set;  // true if _formation_offset replaces FOLL_OFS
 };
@@ -28,6 +28,7 @@
 #include <AP_Common/AP_FWVersion.h>
 #include <GCS_MAVLink/GCS.h>
 #include <AP_Common/Location.h>
+#include <AP_Logger/AP_Logger.h>
 
 #include <stdio.h>
 
@@ -49,6 +50,7 @@ void AP_Frsky_Telem::init()
         _protocol = AP_SerialManager::SerialProtocol_FrSky_SPort; // FrSky SPort protocol (X-receivers)
     } else if ((_port = serial_manager.find_serial(AP_SerialManager::SerialProtocol_FrSky_SPort_Passthrough, 0))) {
         _protocol = AP_SerialManager::SerialProtocol_FrSky_SPort_Passthrough; // FrSky SPort and SPort Passthrough (OpenTX) protocols (X-receivers)
+        setup_passthrough_rates();
         // make frsky_telemetry available to GCS_MAVLINK (used to queue statustext messages from GCS_MAVLINK)
         // add firmware and frame info to message queue
         const char* _frame_string = gcs().frame_string();
@@ -96,78 +98,116 @@ void AP_Frsky_Telem::send_SPort_Passthrough(void)
     }
 
     if ((prev_byte == START_STOP_SPORT) && (_passthrough.new_byte == SENSOR_ID_28)) { // byte 0x7E is the header of each poll request
-        if (_passthrough.send_chunk) { // skip other data and send a message chunk during this iteration
-            _passthrough.send_chunk = false;
-            if (get_next_msg_chunk()) {
-                send_uint32(DIY_FIRST_ID, _msg_chunk.chunk);
-            }
-        } else {
-            // build message queue for sensor_status_flags
-            check_sensor_status_flags();
-            // build message queue for ekf_status
-            check_ekf_status();
-            // if there are pending messages in the queue, send them during next iteration
-            if (!_statustext_queue.empty()) {
-                _passthrough.send_chunk = true;
-            }
-            if (_passthrough.send_attiandrng) { // skip other data, send attitude (roll, pitch) and range only this iteration
-                _passthrough.send_attiandrng = false; // next iteration, check if we should send something other
-            } else { // send other sensor data if it's time for them, and reset the corresponding timer if sent
-                _passthrough.send_attiandrng = true; // next iteration, send attitude b/c it needs frequent updates to remain smooth
-                uint32_t now = AP_HAL::millis();
-                if ((now - _passthrough.params_timer) >= 1000) {
-                    send_uint32(DIY_FIRST_ID+7, calc_param());
-                    _passthrough.params_timer = AP_HAL::millis();
-                    return;
-                }
-                if ((now - _passthrough.ap_status_timer) >= 500) {
-                    if (gcs().vehicle_initialised()) {  // send ap status only once vehicle has been initialised
-                        send_uint32(DIY_FIRST_ID+1, calc_ap_status());
-                        _passthrough.ap_status_timer = AP_HAL::millis();
-                        return;
-                    }
-                }
-                if ((now - _passthrough.batt_timer) >= 1000) {
-                    send_uint32(DIY_FIRST_ID+3, calc_batt(0));
-                    _passthrough.batt_timer = AP_HAL::millis();
-                    return;
-                }
-                if (AP::battery().num_instances() > 1) {
-                    if ((now - _passthrough.batt_timer2) >= 1000) {
-                        send_uint32(DIY_FIRST_ID+8, calc_batt(1));
-                        _passthrough.batt_timer2 = AP_HAL::millis();
-                        return;
-                    }
-                }
-                if ((now - _passthrough.gps_status_timer) >= 1000) {
-                    send_uint32(DIY_FIRST_ID+2, calc_gps_status());
-                    _passthrough.gps_status_timer = AP_HAL::millis();
-                    return;
-                }
-                if ((now - _passthrough.home_timer) >= 500) {
-                    send_uint32(DIY_FIRST_ID+4, calc_home());
-                    _passthrough.home_timer = AP_HAL::millis();
-                    return;
-                }
-                if ((now - _passthrough.velandyaw_timer) >= 500) {
-                    send_uint32(DIY_FIRST_ID+5, calc_velandyaw());
-                    _passthrough.velandyaw_timer = AP_HAL::millis();
-                    return;
-                }
-                if ((now - _passthrough.gps_latlng_timer) >= 1000) {
-                    send_uint32(GPS_LONG_LATI_FIRST_ID, calc_gps_latlng(&_passthrough.send_latitude)); // gps latitude or longitude
-                    if (!_passthrough.send_latitude) { // we've cycled and sent one each of longitude then latitude, so reset the timer
-                        _passthrough.gps_latlng_timer = AP_HAL::millis();
-                    }
-                    return;
-                }
-            }
-            // if nothing else needed to be sent, send attitude (roll, pitch) and range data
-            send_uint32(DIY_FIRST_ID+6, calc_attiandrng());
+        // build message queue for sensor_status_flags
+        check_sensor_status_flags();
+        // build message queue for ekf_status
+        check_ekf_status();
+
+        uint32_t ready = ~0U;
+        if (_statustext_queue.empty()) {
+            ready &= ~(1U << PASSTHROUGH_TEXT);
+        }
+        if (!gcs().vehicle_initialised()) {  // send ap status only once vehicle has been initialised
+            ready &= ~(1U << PASSTHROUGH_AP_STATUS);
+        }
+        if (AP::battery().num_instances() < 2) {
+            ready &= ~(1U << PASSTHROUGH_BATT2);
+        }
+
+        const uint32_t now = AP_HAL::millis();
+        const int8_t packet = _passthrough.scheduler.select(now, ready);
+        if (packet >= 0) {
+            send_passthrough_packet(packet);
+            _passthrough.scheduler.sent(packet, now);
+        }
+        if (_passthrough.scheduler.update_rates(now)) {
+            log_passthrough_rates();
         }
     }
 }
 
+/*
+ * target rates in Hz of each passthrough packet type. When the
+ * receiver polls us less often than these add up to, all are slowed
+ * down in proportion. Attitude needs frequent updates to remain
+ * smooth, and text is sent as chunks of four characters, each
+ * repeated three times
+ */
+void AP_Frsky_Telem::setup_passthrough_rates(void)
+{
+    AP_RCTelemetry_Scheduler &sched = _passthrough.scheduler;
+    sched.set_rate(PASSTHROUGH_TEXT,        15);
+    sched.set_rate(PASSTHROUGH_ATTIANDRNG,  20);
+    sched.set_rate(PASSTHROUGH_AP_STATUS,   2);
+    sched.set_rate(PASSTHROUGH_GPS_LATLNG,  2);  // latitude and longitude alternate
+    sched.set_rate(PASSTHROUGH_HOME,        2);
+    sched.set_rate(PASSTHROUGH_VELANDYAW,   2);
+    sched.set_rate(PASSTHROUGH_BATT,        1);
+    sched.set_rate(PASSTHROUGH_BATT2,       1);
+    sched.set_rate(PASSTHROUGH_GPS_STATUS,  1);
+    sched.set_rate(PASSTHROUGH_PARAM,       1);
+}
+
+void AP_Frsky_Telem::send_passthrough_packet(uint8_t packet)
+{
+    switch (packet) {
+    case PASSTHROUGH_TEXT:
+        if (get_next_msg_chunk()) {
+            send_uint32(DIY_FIRST_ID, _msg_chunk.chunk);
+        }
+        break;
+    case PASSTHROUGH_ATTIANDRNG:
+        send_uint32(DIY_FIRST_ID+6, calc_attiandrng());
+        break;
+    case PASSTHROUGH_AP_STATUS:
+        send_uint32(DIY_FIRST_ID+1, calc_ap_status());
+        break;
+    case PASSTHROUGH_GPS_LATLNG:
+        send_uint32(GPS_LONG_LATI_FIRST_ID, calc_gps_latlng(&_passthrough.send_latitude)); // gps latitude or longitude
+        break;
+    case PASSTHROUGH_HOME:
+        send_uint32(DIY_FIRST_ID+4, calc_home());
+        break;
+    case PASSTHROUGH_VELANDYAW:
+        send_uint32(DIY_FIRST_ID+5, calc_velandyaw());
+        break;
+    case PASSTHROUGH_BATT:
+        send_uint32(DIY_FIRST_ID+3, calc_batt(0));
+        break;
+    case PASSTHROUGH_BATT2:
+        send_uint32(DIY_FIRST_ID+8, calc_batt(1));
+        break;
+    case PASSTHROUGH_GPS_STATUS:
+        send_uint32(DIY_FIRST_ID+2, calc_gps_status());
+        break;
+    case PASSTHROUGH_PARAM:
+        send_uint32(DIY_FIRST_ID+7, calc_param());
+        break;
+    }
+}
+
+/*
+ * log the measured poll rate and the rate each packet type got over
+ * the last measurement window
+ */
+void AP_Frsky_Telem::log_passthrough_rates(void)
+{
+    AP_Logger *logger = AP_Logger::get_singleton();
+    if (logger == nullptr || !logger->logging_started()) {
+        return;
+    }
+    const AP_RCTelemetry_Scheduler &sched = _passthrough.scheduler;
+    const uint64_t now_us = AP_HAL::micros64();
+    for (uint8_t i = 0; i < sched.num_packets(); i++) {
+        logger->Write("FRSK", "TimeUS,Pkt,Poll,Target,Rate", "QBfff",
+                      now_us,
+                      i,
+                      (double)sched.get_slot_rate(),
+                      (double)sched.get_target_rate(i),
+                      (double)sched.get_rate(i));
+    }
+}
+
 /*
  * send telemetry data
  * for FrSky SPort protocol (X-receivers)
@@ -372,34 +412,54 @@ void AP_Frsky_Telem::send_crc(void)
 
 
 /*
-  send 1 byte and do byte stuffing
+  add 1 byte to the frame and do byte stuffing
 */
 void AP_Frsky_Telem::send_byte(uint8_t byte)
 {
     if (_protocol == AP_SerialManager::SerialProtocol_FrSky_D) { // FrSky D protocol (D-receivers)
         if (byte == START_STOP_D) {
-            _port->write(0x5D);
-            _port->write(0x3E);
+            frame_add(0x5D);
+            frame_add(0x3E);
         } else if (byte == BYTESTUFF_D) {
-            _port->write(0x5D);
-            _port->write(0x3D);
+            frame_add(0x5D);
+            frame_add(0x3D);
         } else {
-            _port->write(byte);
+            frame_add(byte);
         }
     } else { // FrSky SPort protocol (X-receivers)
         if (byte == START_STOP_SPORT) {
-            _port->write(0x7D);
-            _port->write(0x5E);
+            frame_add(0x7D);
+            frame_add(0x5E);
         } else if (byte == BYTESTUFF_SPORT) {
-            _port->write(0x7D);
-            _port->write(0x5D);
+            frame_add(0x7D);
+            frame_add(0x5D);
         } else {
-            _port->write(byte);
+            frame_add(byte);
         }
         calc_crc(byte);
     }
 }
 
+/*
+  add 1 byte to the frame without stuffing
+*/
+void AP_Frsky_Telem::frame_add(uint8_t byte)
+{
+    if (_frame_len < sizeof(_frame)) {
+        _frame[_frame_len++] = byte;
+    }
+}
+
+/*
+  write the frame with one call, so the port is locked once per frame
+  instead of once per byte
+*/
+void AP_Frsky_Telem::send_frame(void)
+{
+    _port->write(_frame, _frame_len);
+    _frame_len = 0;
+}
+
 /*
  * send one uint32 frame of FrSky data - for FrSky SPort protocol (X-receivers)
  */
@@ -415,6 +475,7 @@ void  AP_Frsky_Telem::send_uint32(uint16_t id, uint32_t data)
     send_byte(bytes[2]);
     send_byte(bytes[3]); // MSB
     send_crc();
+    send_frame();
 }
 
 /*
@@ -422,12 +483,13 @@ void  AP_Frsky_Telem::send_uint32(uint16_t id, uint32_t data)
  */
 void  AP_Frsky_Telem::send_uint16(uint16_t id, uint16_t data)
 {
-    _port->write(START_STOP_D);    // send a 0x5E start byte
+    frame_add(START_STOP_D);    // send a 0x5E start byte
     uint8_t *bytes = (uint8_t*)&id;
     send_byte(bytes[0]);
     bytes = (uint8_t*)&data;
     send_byte(bytes[0]); // LSB
     send_byte(bytes[1]); // MSB
+    send_frame();
 }
 
 /*
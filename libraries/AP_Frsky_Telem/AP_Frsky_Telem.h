@@ -18,6 +18,7 @@
 #include <AP_Notify/AP_Notify.h>
 #include <AP_SerialManager/AP_SerialManager.h>
 #include <AP_HAL/utility/RingBuffer.h>
+#include <AP_RCTelemetry/AP_RCTelemetry_Scheduler.h>
 
 #define FRSKY_TELEM_PAYLOAD_STATUS_CAPACITY          5 // size of the message buffer queue (max number of messages waiting to be sent)
 
@@ -138,6 +139,10 @@ private:
     bool _initialised_uart;
     uint16_t _crc;
 
+    // a byte stuffed frame being built, written to the port in one go
+    uint8_t _frame[16];
+    uint8_t _frame_len;
+
     uint32_t check_sensor_status_timer;
     uint32_t check_ekf_status_timer;
     uint8_t _paramID;
@@ -157,20 +162,26 @@ private:
         uint16_t speed_in_centimeter;
     } _gps;
 
+    // passthrough packet types, in priority order for ties
+    enum PassthroughPacket {
+        PASSTHROUGH_TEXT = 0,
+        PASSTHROUGH_ATTIANDRNG,
+        PASSTHROUGH_AP_STATUS,
+        PASSTHROUGH_GPS_LATLNG,
+        PASSTHROUGH_HOME,
+        PASSTHROUGH_VELANDYAW,
+        PASSTHROUGH_BATT,
+        PASSTHROUGH_BATT2,
+        PASSTHROUGH_GPS_STATUS,
+        PASSTHROUGH_PARAM,
+        PASSTHROUGH_NUM_PACKETS
+    };
+
     struct
     {
         uint8_t new_byte;
-        bool send_attiandrng;
         bool send_latitude;
-        bool send_chunk;
-        uint32_t params_timer;
-        uint32_t ap_status_timer;
-        uint32_t batt_timer;
-        uint32_t batt_timer2;
-        uint32_t gps_status_timer;
-        uint32_t home_timer;
-        uint32_t velandyaw_timer;
-        uint32_t gps_latlng_timer;
+        AP_RCTelemetry_Scheduler scheduler;
     } _passthrough;
     
     struct
@@ -197,6 +208,9 @@ private:
     
     // main transmission function when protocol is FrSky SPort Passthrough (OpenTX)
     void send_SPort_Passthrough(void);
+    void setup_passthrough_rates(void);
+    void send_passthrough_packet(uint8_t packet);
+    void log_passthrough_rates(void);
     // main transmission function when protocol is FrSky SPort
     void send_SPort(void);
     // main transmission function when protocol is FrSky D
@@ -208,6 +222,8 @@ private:
     void calc_crc(uint8_t byte);
     void send_crc(void);
     void send_byte(uint8_t value);
+    void frame_add(uint8_t byte);
+    void send_frame(void);
     void send_uint32(uint16_t id, uint32_t data);
     void send_uint16(uint16_t id, uint16_t data);
 
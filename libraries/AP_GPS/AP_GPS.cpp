@@ -46,6 +46,8 @@
 #include <AP_Logger/AP_Logger.h>
 
 #define GPS_RTK_INJECT_TO_ALL 127
+#define GPS_RTCM_LOW_PRIORITY_RESERVE 256 // extra space a GPS port needs to be sent a low priority RTCM frame
+#define GPS_RTCM_REPORT_MS 5000 // minimum time between reports of lost RTCM data
 #define GPS_MAX_RATE_MS 200 // maximum value of rate_ms (i.e. slowest update rate) is 5hz or 200ms
 #define GPS_BAUD_TIME_MS 1200
 #define GPS_TIMEOUT_MS 4000u
@@ -298,6 +300,7 @@ void AP_GPS::init(const AP_SerialManager& serial_manager)
 
     // Initialise class variables used to do GPS blending
     _omega_lpf = 1.0f / constrain_float(_blend_tc, 5.0f, 30.0f);
+    _perf_blend = hal.util->perf_alloc(AP_HAL::Util::PC_ELAPSED, "GPS_blend");
 
     // prep the state instance fields
     for (uint8_t i = 0; i < GPS_MAX_INSTANCES; i++) {
@@ -687,27 +690,35 @@ void AP_GPS::update(void)
         }
     }
 
-    // if blending is requested, attempt to calculate weighting for each GPS
+    // if blending is requested, attempt to calculate weighting for each
+    // GPS. Between receiver updates the last blend still stands
     if (_auto_switch == 2) {
-        _output_is_blended = calc_blend_weights();
-        // adjust blend health counter
-        if (!_output_is_blended) {
-            _blend_health_counter = MIN(_blend_health_counter+BLEND_COUNTER_FAILURE_INCREMENT, 100);
-        } else if (_blend_health_counter > 0) {
-            _blend_health_counter--;
-        }
-        // stop blending if unhealthy
-        if (_blend_health_counter >= 50) {
-            _output_is_blended = false;
+        if (blend_inputs_changed()) {
+            hal.util->perf_begin(_perf_blend);
+            _output_is_blended = calc_blend_weights();
+            // adjust blend health counter
+            if (!_output_is_blended) {
+                _blend_health_counter = MIN(_blend_health_counter+BLEND_COUNTER_FAILURE_INCREMENT, 100);
+            } else if (_blend_health_counter > 0) {
+                _blend_health_counter--;
+            }
+            // stop blending if unhealthy
+            if (_blend_health_counter >= 50) {
+                _output_is_blended = false;
+            }
+            if (_output_is_blended) {
+                // Use the weighting to calculate blended GPS states
+                calc_blended_state();
+            }
+            hal.util->perf_end(_perf_blend);
         }
     } else {
         _output_is_blended = false;
         _blend_health_counter = 0;
+        _blend_cached = false;
     }
 
     if (_output_is_blended) {
-        // Use the weighting to calculate blended GPS states
-        calc_blended_state();
         // set primary to the virtual instance
         primary_instance = GPS_BLENDED_INSTANCE;
     } else {
@@ -877,23 +888,122 @@ void AP_GPS::lock_port(uint8_t instance, bool lock)
     }
 }
 
+/*
+  RTCM3 messages which can wait when a GPS is short of space to send
+  them: antenna and receiver descriptors, ephemerides, text and GLONASS
+  biases. These are repeated every few seconds, while the observations
+  and station position are needed every epoch
+ */
+static bool rtcm_low_priority(uint16_t msg_type)
+{
+    switch (msg_type) {
+    case 1007:
+    case 1008:
+    case 1019:
+    case 1020:
+    case 1029:
+    case 1033:
+    case 1042:
+    case 1044:
+    case 1045:
+    case 1046:
+    case 1230:
+        return true;
+    }
+    return false;
+}
+
 // Inject a packet of raw binary to a GPS
-void AP_GPS::inject_data(uint8_t *data, uint16_t len)
+void AP_GPS::inject_data(const uint8_t *data, uint16_t len)
 {
-    //Support broadcasting to all GPSes.
-    if (_inject_to == GPS_RTK_INJECT_TO_ALL) {
-        for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
-            inject_data(i, data, len);
+    RTCM3_Stream::Segment seg;
+    while (rtcm_stream.next(data, len, seg)) {
+        //Support broadcasting to all GPSes.
+        if (_inject_to == GPS_RTK_INJECT_TO_ALL) {
+            for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+                inject_rtcm_segment(i, seg);
+            }
+        } else {
+            inject_rtcm_segment(_inject_to, seg);
         }
-    } else {
-        inject_data(_inject_to, data, len);
     }
+    report_rtcm_stats();
 }
 
-void AP_GPS::inject_data(uint8_t instance, uint8_t *data, uint16_t len)
+void AP_GPS::inject_rtcm_segment(uint8_t instance, const RTCM3_Stream::Segment &seg)
 {
-    if (instance < GPS_MAX_RECEIVERS && drivers[instance] != nullptr) {
-        drivers[instance]->inject_data(data, len);
+    if (instance >= GPS_MAX_RECEIVERS || drivers[instance] == nullptr) {
+        return;
+    }
+    AP_GPS_Backend *driver = drivers[instance];
+    const uint8_t mask = 1U << instance;
+
+    switch (seg.type) {
+    case RTCM3_Stream::SegmentType::RAW:
+        if (driver->inject_space() > seg.len) {
+            driver->inject_data(seg.data, seg.len);
+        } else {
+            rtcm_stats[instance].bytes_dropped += seg.len;
+        }
+        break;
+
+    case RTCM3_Stream::SegmentType::FRAME_START: {
+        // only start a frame we have room to finish
+        uint32_t needed = seg.frame_len;
+        if (rtcm_low_priority(seg.msg_type)) {
+            needed += GPS_RTCM_LOW_PRIORITY_RESERVE;
+        }
+        if (driver->inject_space() > needed) {
+            rtcm_sending |= mask;
+            driver->inject_data(seg.data, seg.len);
+        } else {
+            rtcm_sending &= ~mask;
+            rtcm_stats[instance].bytes_dropped += seg.frame_len;
+            rtcm_stats[instance].frames_dropped++;
+        }
+        break;
+    }
+
+    case RTCM3_Stream::SegmentType::FRAME_DATA:
+        if ((rtcm_sending & mask) == 0) {
+            // dropped when it started
+            break;
+        }
+        if (driver->inject_space() > seg.len) {
+            driver->inject_data(seg.data, seg.len);
+        } else {
+            // something else used the space. The GPS will reject the
+            // rest of the frame, so don't send it
+            rtcm_sending &= ~mask;
+            rtcm_stats[instance].bytes_dropped += seg.len;
+        }
+        break;
+    }
+}
+
+/*
+  let the GCS know if RTCM data is being lost, at most every few seconds
+ */
+void AP_GPS::report_rtcm_stats(void)
+{
+    const uint32_t now = AP_HAL::millis();
+    if (now - rtcm_last_report_ms < GPS_RTCM_REPORT_MS) {
+        return;
+    }
+    rtcm_last_report_ms = now;
+    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+        if (rtcm_stats[i].bytes_dropped != 0) {
+            gcs().send_text(MAV_SEVERITY_WARNING, "GPS %d: RTCM dropped %u bytes, %u frames",
+                            i + 1,
+                            (unsigned)rtcm_stats[i].bytes_dropped,
+                            (unsigned)rtcm_stats[i].frames_dropped);
+            rtcm_stats[i].bytes_dropped = 0;
+            rtcm_stats[i].frames_dropped = 0;
+        }
+    }
+    if (rtcm_bytes_late != 0) {
+        gcs().send_text(MAV_SEVERITY_WARNING, "GPS: RTCM %u bytes late", (unsigned)rtcm_bytes_late);
+        rtcm_bytes_late = 0;
     }
 }
 
@@ -1057,7 +1167,15 @@ void AP_GPS::handle_gps_rtcm_data(const mavlink_message_t *msg)
         (rtcm_buffer->sequence != sequence ||
         (rtcm_buffer->fragments_received & (1U<<fragment)))) {
         // we have one or more partial fragments already received
-        // which conflict with the new fragment, discard previous fragments
+        // which conflict with the new fragment. Discard any held
+        // fragments; if one was missed then the frame being sent was
+        // cut short, so look for a new one
+        for (uint8_t i=rtcm_buffer->fragments_injected; i<4; i++) {
+            if (rtcm_buffer->fragments_received & (1U<<i)) {
+                rtcm_bytes_late += rtcm_buffer->fragment_len[i];
+            }
+        }
+        rtcm_stream.reset();
         memset(rtcm_buffer, 0, sizeof(*rtcm_buffer));
     }
 
@@ -1065,28 +1183,38 @@ void AP_GPS::handle_gps_rtcm_data(const mavlink_message_t *msg)
     rtcm_buffer->sequence = sequence;
     rtcm_buffer->fragments_received |= (1U << fragment);
 
-    // copy the data
-    memcpy(&rtcm_buffer->buffer[MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN*(uint16_t)fragment], packet.data, packet.len);
-
     // when we get a fragment of less than max size then we know the
     // number of fragments. Note that this means if you want to send a
     // block of RTCM data of an exact multiple of the buffer size you
     // need to send a final packet of zero length
     if (packet.len < MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN) {
         rtcm_buffer->fragment_count = fragment+1;
-        rtcm_buffer->total_length = (MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN*fragment) + packet.len;
     } else if (rtcm_buffer->fragments_received == 0x0F) {
         // special case of 4 full fragments
         rtcm_buffer->fragment_count = 4;
-        rtcm_buffer->total_length = MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN*4;
     }
 
+    if (fragment == rtcm_buffer->fragments_injected) {
+        // the next in order, so inject it straight from the packet,
+        // followed by any later fragments which are waiting for it
+        inject_data(packet.data, packet.len);
+        rtcm_buffer->fragments_injected++;
+        while (rtcm_buffer->fragments_injected < 4 &&
+               (rtcm_buffer->fragments_received & (1U<<rtcm_buffer->fragments_injected))) {
+            const uint8_t f = rtcm_buffer->fragments_injected;
+            inject_data(&rtcm_buffer->buffer[MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN*(uint16_t)f],
+                        rtcm_buffer->fragment_len[f]);
+            rtcm_buffer->fragments_injected++;
+        }
+    } else {
+        // hold it until the fragments before it arrive
+        memcpy(&rtcm_buffer->buffer[MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN*(uint16_t)fragment], packet.data, packet.len);
+        rtcm_buffer->fragment_len[fragment] = packet.len;
+    }
 
-    // see if we have all fragments
+    // see if we have injected all fragments
     if (rtcm_buffer->fragment_count != 0 &&
-        rtcm_buffer->fragments_received == (1U << rtcm_buffer->fragment_count) - 1) {
-        // we have them all, inject
-        inject_data(rtcm_buffer->buffer, rtcm_buffer->total_length);
+        rtcm_buffer->fragments_injected >= rtcm_buffer->fragment_count) {
         memset(rtcm_buffer, 0, sizeof(*rtcm_buffer));
     }
 }
@@ -1332,6 +1460,25 @@ bool AP_GPS::calc_blend_weights(void)
     return true;
 }
 
+/*
+  returns true if any receiver has had a message or changed status
+  since the blend was last calculated, and records its new state
+ */
+bool AP_GPS::blend_inputs_changed(void)
+{
+    bool changed = !_blend_cached;
+    for (uint8_t i=0; i<GPS_MAX_RECEIVERS; i++) {
+        if (timing[i].last_message_time_ms != _blend_message_ms[i] ||
+            state[i].status != _blend_status[i]) {
+            _blend_message_ms[i] = timing[i].last_message_time_ms;
+            _blend_status[i] = state[i].status;
+            changed = true;
+        }
+    }
+    _blend_cached = true;
+    return changed;
+}
+
 /*
  calculate a blended GPS state
 */
@@ -20,6 +20,7 @@
 #include <AP_Common/Location.h>
 #include <AP_Param/AP_Param.h>
 #include "GPS_detect_state.h"
+#include "RTCM3_Stream.h"
 #include <AP_SerialManager/AP_SerialManager.h>
 
 /**
@@ -506,22 +507,25 @@ private:
     void update_instance(uint8_t instance);
 
     /*
-      buffer for re-assembling RTCM data for GPS injection.
+      state for streaming fragmented RTCM data for GPS injection.
       The 8 bit flags field in GPS_RTCM_DATA is interpreted as:
               1 bit for "is fragmented"
               2 bits for fragment number
               5 bits for sequence number
 
-      The rtcm_buffer is allocated on first use. Once a block of data
-      is successfully reassembled it is injected into all active GPS
-      backends. This assumes we don't want more than 4*180=720 bytes
-      in a RTCM data block
+      Fragments are injected as soon as all the fragments before them
+      in their sequence have been. A fragment which arrives early is
+      held in the buffer until the ones before it arrive, and discarded
+      if they never do. The rtcm_buffer is allocated on first use. This
+      assumes we don't want more than 4*180=720 bytes in a RTCM data
+      block
      */
     struct rtcm_buffer {
         uint8_t fragments_received;
+        uint8_t fragments_injected;
         uint8_t sequence;
         uint8_t fragment_count;
-        uint16_t total_length;
+        uint8_t fragment_len[4];
         uint8_t buffer[MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN*4];
     } *rtcm_buffer;
 
@@ -529,10 +533,25 @@ private:
     void handle_gps_rtcm_data(const mavlink_message_t *msg);
     void handle_gps_inject(const mavlink_message_t *msg);
 
-    //Inject a packet of raw binary to a GPS
-    void inject_data(uint8_t *data, uint16_t len);
-    void inject_data(uint8_t instance, uint8_t *data, uint16_t len);
+    /*
+      injected data is split into RTCM3 frames, and each GPS is given a
+      whole frame or none of it, depending on the space it has to send
+      it. Low priority frames need more space, so they are dropped
+      before the observations which make up a fix
+     */
+    RTCM3_Stream rtcm_stream;
+    uint8_t rtcm_sending;                       // bitmask of instances being sent the current frame
+    struct {
+        uint32_t bytes_dropped;                 // for lack of space, since the last report
+        uint16_t frames_dropped;
+    } rtcm_stats[GPS_MAX_RECEIVERS];
+    uint32_t rtcm_bytes_late;                   // held fragments discarded since the last report
+    uint32_t rtcm_last_report_ms;
 
+    //Inject a packet of raw binary to a GPS
+    void inject_data(const uint8_t *data, uint16_t len);
+    void inject_rtcm_segment(uint8_t instance, const RTCM3_Stream::Segment &seg);
+    void report_rtcm_stats(void);
 
     // GPS blending and switching
     Vector2f _NE_pos_offset_m[GPS_MAX_RECEIVERS]; // Filtered North,East position offset from GPS instance to blended solution in _output_state.location (m)
@@ -545,6 +564,16 @@ private:
     bool _output_is_blended; // true when a blended GPS solution being output
     uint8_t _blend_health_counter;  // 0 = perfectly health, 100 = very unhealthy
 
+    // the blend only changes when a receiver does, so it is only
+    // calculated when one has a new message or a change of status
+    bool _blend_cached; // true when the blend was calculated from the last receiver data
+    uint32_t _blend_message_ms[GPS_MAX_RECEIVERS]; // receiver message times the blend was calculated from
+    GPS_Status _blend_status[GPS_MAX_RECEIVERS]; // receiver statuses the blend was calculated from
+    AP_HAL::Util::perf_counter_t _perf_blend;
+
+    // returns true if a receiver has changed since the blend was calculated
+    bool blend_inputs_changed(void);
+
     // calculate the blend weight.  Returns true if blend could be calculated, false if not
     bool calc_blend_weights(void);
 
@@ -52,23 +52,33 @@ extern const AP_HAL::HAL& hal;
 
 bool AP_GPS_NMEA::read(void)
 {
-    int16_t numc;
     bool parsed = false;
 
-    numc = port->available();
-    while (numc--) {
-        char c = port->read();
+    uint32_t numc = port->available();
+    while (rx_fill(numc)) {
 #ifdef NMEA_LOG_PATH
         static FILE *logf = nullptr;
         if (logf == nullptr) {
             logf = fopen(NMEA_LOG_PATH, "wb");
         }
         if (logf != nullptr) {
-            ::fwrite(&c, 1, 1, logf);
+            ::fwrite(rx_ptr(), 1, rx_remaining(), logf);
         }
 #endif
-        if (_decode(c)) {
-            parsed = true;
+        while (rx_remaining() > 0) {
+            if (_between_sentences) {
+                // nothing but the start of the next sentence is of
+                // interest, so look for it in the whole buffer at once
+                if (!rx_skip_to('$')) {
+                    break;
+                }
+                _between_sentences = false;
+            }
+            const char c = rx_byte();
+            if (_decode(c)) {
+                parsed = true;
+            }
+            _between_sentences = (c == '\n');
         }
     }
     return parsed;
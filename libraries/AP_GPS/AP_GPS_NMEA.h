@@ -122,6 +122,7 @@ private:
 
     uint8_t _parity;                                                    ///< NMEA message checksum accumulator
     bool _is_checksum_term;                                     ///< current term is the checksum
+    bool _between_sentences;                                    ///< the last sentence has ended, so skip to the next '$'
     char _term[15];                                                     ///< buffer for the current term within the current sentence
     uint8_t _sentence_type;                                     ///< the sentence type currently being processed
     uint8_t _term_number;                                       ///< term index within the current sentence
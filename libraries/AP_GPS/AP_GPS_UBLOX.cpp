@@ -341,7 +341,6 @@ bool
 AP_GPS_UBLOX::read(void)
 {
     uint8_t data;
-    int16_t numc;
     bool parsed = false;
     uint32_t millis_now = AP_HAL::millis();
 
@@ -370,11 +369,30 @@ AP_GPS_UBLOX::read(void)
         }
     }
 
-    numc = port->available();
-    for (int16_t i = 0; i < numc; i++) {        // Process bytes received
+    uint32_t numc = port->available();
+    while (rx_remaining() > 0 || rx_fill(numc)) {   // Process bytes received
+
+        if (_step == 0) {
+            // nothing but a preamble is of interest, so look for one
+            // in the whole buffer at once
+            if (!rx_skip_to(PREAMBLE1)) {
+                continue;
+            }
+        } else if (_step == 6) {
+            // take as much of the payload as has been received in one go
+            const uint16_t n = MIN(rx_remaining(), _payload_length - _payload_counter);
+            fletcher8_update(rx_ptr(), n, _ck_a, _ck_b);
+            memcpy(&_buffer[_payload_counter], rx_ptr(), n);
+            rx_skip(n);
+            _payload_counter += n;
+            if (_payload_counter == _payload_length) {
+                _step++;
+            }
+            continue;
+        }
 
         // read the next byte
-        data = port->read();
+        data = rx_byte();
 
 	reset:
         switch(_step) {
@@ -438,18 +456,13 @@ AP_GPS_UBLOX::read(void)
 				goto reset;
             }
             _payload_counter = 0;                       // prepare to receive payload
+            if (_payload_length == 0) {
+                _step++;                                // no payload to receive
+            }
             break;
 
-        // Receive message data
+        // Message data is received above, straight from the buffer
         //
-        case 6:
-            _ck_b += (_ck_a += data);                   // checksum byte
-            if (_payload_counter < sizeof(_buffer)) {
-                _buffer[_payload_counter] = data;
-            }
-            if (++_payload_counter == _payload_length)
-                _step++;
-            break;
 
         // Checksum and message processing
         //
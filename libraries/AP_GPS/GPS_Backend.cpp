@@ -225,10 +225,62 @@ void AP_GPS_Backend::send_mavlink_gps_rtk(mavlink_channel_t chan)
 void AP_GPS_Backend::set_uart_timestamp(uint16_t nbytes)
 {
     if (port) {
-        state.uart_timestamp_ms = port->receive_time_constraint_us(nbytes) / 1000U;
+        // bytes still in the receive buffer arrived after the current one
+        state.uart_timestamp_ms = port->receive_time_constraint_us(nbytes + rx_remaining()) / 1000U;
     }
 }
 
+bool AP_GPS_Backend::rx_fill(uint32_t &nbytes)
+{
+    _rx_len = _rx_ofs = 0;
+    if (nbytes == 0) {
+        return false;
+    }
+    const ssize_t n = port->read(_rx_buf, MIN(nbytes, sizeof(_rx_buf)));
+    if (n <= 0) {
+        nbytes = 0;
+        return false;
+    }
+    _rx_len = n;
+    nbytes -= n;
+    return true;
+}
+
+bool AP_GPS_Backend::rx_skip_to(uint8_t c)
+{
+    const uint8_t *p = (const uint8_t *)memchr(rx_ptr(), c, rx_remaining());
+    if (p == nullptr) {
+        _rx_ofs = _rx_len;
+        return false;
+    }
+    _rx_ofs = p - _rx_buf;
+    return true;
+}
+
+/*
+  the sums wrap at a multiple of 256, so they are kept in 32 bits and
+  truncated at the end. Over four bytes b0..b3 ck_a gains their sum and
+  ck_b gains 4*ck_a + 4*b0 + 3*b1 + 2*b2 + b3, so a whole word is added
+  without a dependency between each byte
+ */
+void AP_GPS_Backend::fletcher8_update(const uint8_t *data, uint16_t len, uint8_t &ck_a, uint8_t &ck_b)
+{
+    uint32_t a = ck_a;
+    uint32_t b = ck_b;
+    while (len >= 4) {
+        b += 4*a + 4*data[0] + 3*data[1] + 2*data[2] + data[3];
+        a += data[0] + data[1] + data[2] + data[3];
+        data += 4;
+        len -= 4;
+    }
+    while (len--) {
+        a += *data++;
+        b += a;
+    }
+    ck_a = a;
+    ck_b = b;
+}
+
 
 void AP_GPS_Backend::check_new_itow(uint32_t itow, uint32_t msg_length)
 {
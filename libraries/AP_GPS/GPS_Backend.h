@@ -22,6 +22,11 @@
 #include <AP_RTC/JitterCorrection.h>
 #include "AP_GPS.h"
 
+// size of the buffer drivers parse received bytes from
+#ifndef AP_GPS_RX_BULK_SIZE
+#define AP_GPS_RX_BULK_SIZE 128
+#endif
+
 class AP_GPS_Backend
 {
 public:
@@ -44,6 +49,10 @@ public:
 
     virtual void inject_data(const uint8_t *data, uint16_t len);
 
+    // how many bytes inject_data() can take now. Backends without a
+    // port take anything, and discard it
+    virtual uint32_t inject_space(void) const { return port != nullptr ? port->txspace() : UINT32_MAX; }
+
     //MAVLink methods
     virtual bool supports_mavlink_gps_rtk_message() { return false; }
     virtual void send_mavlink_gps_rtk(mavlink_channel_t chan);
@@ -96,7 +105,28 @@ protected:
     void set_uart_timestamp(uint16_t nbytes);
 
     void check_new_itow(uint32_t itow, uint32_t msg_length);
-    
+
+    /*
+      bulk receive. Rather than calling port->read() for each byte, a
+      driver calls rx_fill() to read a block of bytes into the receive
+      buffer, then consumes them all with the functions below before
+      filling it again. nbytes is how many more bytes the driver wants
+      to read this call, and is reduced by the number read. Returns
+      false once there is nothing more to read
+     */
+    bool rx_fill(uint32_t &nbytes);
+    uint16_t rx_remaining(void) const { return _rx_len - _rx_ofs; }
+    const uint8_t *rx_ptr(void) const { return &_rx_buf[_rx_ofs]; }
+    uint8_t rx_byte(void) { return _rx_buf[_rx_ofs++]; }
+    void rx_skip(uint16_t n) { _rx_ofs += n; }
+
+    // skip to the next c in the receive buffer, without consuming it.
+    // If there is none the buffer is emptied and false returned
+    bool rx_skip_to(uint8_t c);
+
+    // add len bytes to an 8 bit Fletcher checksum, as used by u-blox
+    static void fletcher8_update(const uint8_t *data, uint16_t len, uint8_t &ck_a, uint8_t &ck_b);
+
 private:
     // itow from previous message
     uint32_t _last_itow;
@@ -107,4 +137,8 @@ private:
     uint16_t _rate_counter;
 
     JitterCorrection jitter_correction;
+
+    uint8_t _rx_buf[AP_GPS_RX_BULK_SIZE];
+    uint16_t _rx_len;
+    uint16_t _rx_ofs;
 };
@@ -0,0 +1,87 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  RTCM3 framing of injected GPS data
+ */
+
+#include "RTCM3_Stream.h"
+
+#include <string.h>
+
+const uint8_t RTCM3_Stream::PREAMBLE;
+const uint8_t RTCM3_Stream::HEADER_LEN;
+
+bool RTCM3_Stream::next(const uint8_t *&data, uint16_t &len, Segment &seg)
+{
+    while (len > 0) {
+        switch (state) {
+        case State::IDLE: {
+            if (data[0] == PREAMBLE) {
+                header[0] = PREAMBLE;
+                header_len = 1;
+                data++;
+                len--;
+                state = State::HEADER;
+                break;
+            }
+            // pass through everything up to the next preamble
+            const uint8_t *p = (const uint8_t *)memchr(data, PREAMBLE, len);
+            const uint16_t n = p ? p - data : len;
+            seg = { SegmentType::RAW, data, n, 0, 0 };
+            data += n;
+            len -= n;
+            return true;
+        }
+
+        case State::HEADER: {
+            const uint8_t c = data[0];
+            if ((header_len == 1 && (c & 0xFC) != 0) ||
+                (header_len == 2 && (((header[1] & 0x03) << 8) | c) < 2)) {
+                // not a frame after all. Pass through what was taken
+                // for its header, and look at this byte again
+                state = State::IDLE;
+                seg = { SegmentType::RAW, header, header_len, 0, 0 };
+                return true;
+            }
+            header[header_len++] = c;
+            data++;
+            len--;
+            if (header_len < HEADER_LEN) {
+                break;
+            }
+            const uint16_t payload_len = ((header[1] & 0x03) << 8) | header[2];
+            const uint16_t frame_len = 3 + payload_len + 3;
+            body_remaining = frame_len - HEADER_LEN;
+            state = State::BODY;
+            seg = { SegmentType::FRAME_START, header, HEADER_LEN, frame_len,
+                    uint16_t((header[3] << 4) | (header[4] >> 4)) };
+            return true;
+        }
+
+        case State::BODY: {
+            const uint16_t n = len < body_remaining ? len : body_remaining;
+            seg = { SegmentType::FRAME_DATA, data, n, 0, 0 };
+            data += n;
+            len -= n;
+            body_remaining -= n;
+            if (body_remaining == 0) {
+                state = State::IDLE;
+            }
+            return true;
+        }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,78 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+  split a stream of data injected for the GPS into RTCM3 frames,
+  without copying it.
+
+  A frame is a 0xD3 preamble, 6 zero bits and a 10 bit payload length,
+  the payload, which starts with a 12 bit message type, then a 24 bit
+  CRC. The frame header, up to and including the message type, is held
+  here until it is complete, so a driver can decide whether it has
+  room for the whole frame before sending any of it. The rest of the
+  frame is passed straight from the input. Anything which isn't part
+  of a frame, such as another protocol's corrections, is passed through
+  as RAW. The CRC is left to the GPS to check.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class RTCM3_Stream {
+public:
+    enum class SegmentType {
+        RAW,            // not part of a frame
+        FRAME_START,    // the header of a frame
+        FRAME_DATA,     // the next part of the current frame
+    };
+
+    struct Segment {
+        SegmentType type;
+        const uint8_t *data;
+        uint16_t len;
+        // for FRAME_START, the length of the whole frame and its message type
+        uint16_t frame_len;
+        uint16_t msg_type;
+    };
+
+    static const uint8_t PREAMBLE = 0xD3;
+    static const uint8_t HEADER_LEN = 5;
+
+    /*
+      get the next segment of data, advancing data and len past it.
+      Returns false once all of data has been consumed. The segment may
+      point into data or into this object, and is only valid until the
+      next call
+     */
+    bool next(const uint8_t *&data, uint16_t &len, Segment &seg);
+
+    // forget any partial frame, for when data has been lost
+    void reset(void) { state = State::IDLE; header_len = 0; }
+
+    // true if in the middle of a frame
+    bool in_frame(void) const { return state != State::IDLE; }
+
+private:
+    enum class State {
+        IDLE,
+        HEADER,
+        BODY,
+    } state = State::IDLE;
+
+    uint8_t header[HEADER_LEN];
+    uint8_t header_len = 0;
+    uint16_t body_remaining = 0;
+};
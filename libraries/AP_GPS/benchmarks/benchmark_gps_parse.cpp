@@ -0,0 +1,109 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_GPS/AP_GPS.h>
+#include <AP_GPS/AP_GPS_NMEA.h>
+#include <AP_GPS/AP_GPS_UBLOX.h>
+#include <AP_GPS/tests/GPS_TestUART.h>
+
+/*
+  byte throughput of the GPS drivers reading a stream of messages from
+  their UART. The NMEA stream is a second of RMC, GGA, VTG and GSA
+  sentences. The u-blox stream is NAV-PVT messages, as sent at
+  10Hz. BM_GPSNoise feeds random bytes, the cost of traffic the
+  NMEA driver doesn't understand
+ */
+
+#define STREAM_REPEATS 10
+
+static AP_GPS gps;
+static GPS_TestUART uart;
+
+static void BM_GPSParseNMEA(benchmark::State& state)
+{
+    AP_GPS::GPS_State gps_state {};
+    AP_GPS_NMEA nmea(gps, gps_state, &uart);
+    uint8_t stream[STREAM_REPEATS*256];
+    uint16_t len = 0;
+    for (uint8_t i=0; i<STREAM_REPEATS; i++) {
+        len += gps_test_nmea_stream(&stream[len], sizeof(stream) - len);
+    }
+    uint64_t bytes = 0;
+    while (state.KeepRunning()) {
+        uart.set_data(stream, len);
+        nmea.read();
+        bytes += len;
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+// fill buf with a u-blox message, returning its length
+static uint16_t ublox_message(uint8_t msg_class, uint8_t msg_id,
+                              const void *payload, uint16_t payload_len,
+                              uint8_t *buf)
+{
+    buf[0] = 0xb5;
+    buf[1] = 0x62;
+    buf[2] = msg_class;
+    buf[3] = msg_id;
+    buf[4] = payload_len & 0xFF;
+    buf[5] = payload_len >> 8;
+    memcpy(&buf[6], payload, payload_len);
+    uint8_t ck_a = 0, ck_b = 0;
+    for (uint16_t i=2; i<6+payload_len; i++) {
+        ck_a += buf[i];
+        ck_b += ck_a;
+    }
+    buf[6+payload_len] = ck_a;
+    buf[7+payload_len] = ck_b;
+    return 8 + payload_len;
+}
+
+static void BM_GPSParseUBLOX(benchmark::State& state)
+{
+    AP_GPS::GPS_State gps_state {};
+    AP_GPS_UBLOX ublox(gps, gps_state, &uart);
+
+    // NAV-PVT with a 3D fix
+    uint8_t pvt[92] {};
+    pvt[20] = 3;
+    pvt[23] = 12;
+    uint8_t stream[STREAM_REPEATS*(sizeof(pvt)+8)];
+    uint16_t len = 0;
+    for (uint8_t i=0; i<STREAM_REPEATS; i++) {
+        // a new time of week each message
+        pvt[0] = i;
+        len += ublox_message(0x01, 0x07, pvt, sizeof(pvt), &stream[len]);
+    }
+    uint64_t bytes = 0;
+    while (state.KeepRunning()) {
+        uart.set_data(stream, len);
+        ublox.read();
+        bytes += len;
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+static void BM_GPSNoise(benchmark::State& state)
+{
+    AP_GPS::GPS_State gps_state {};
+    AP_GPS_NMEA nmea(gps, gps_state, &uart);
+    uint8_t noise[1024];
+    uint32_t seed = 1;
+    for (uint16_t i=0; i<sizeof(noise); i++) {
+        seed = seed * 1664525 + 1013904223;
+        noise[i] = seed >> 24;
+    }
+    uint64_t bytes = 0;
+    while (state.KeepRunning()) {
+        uart.set_data(noise, sizeof(noise));
+        nmea.read();
+        bytes += sizeof(noise);
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+BENCHMARK(BM_GPSParseNMEA);
+BENCHMARK(BM_GPSParseUBLOX);
+BENCHMARK(BM_GPSNoise);
+
+BENCHMARK_MAIN()
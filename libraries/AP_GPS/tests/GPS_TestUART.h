@@ -0,0 +1,96 @@
+/*
+  a UART for running the GPS drivers without a GPS. Reads return the
+  bytes of a buffer and writes are discarded. Used by the fuzz test
+  and the benchmarks
+ */
+
+#pragma once
+
+#include <AP_HAL/AP_HAL.h>
+
+#include <AP_Math/AP_Math.h>
+
+#include <stdio.h>
+#include <string.h>
+
+class GPS_TestUART : public AP_HAL::UARTDriver {
+public:
+    // make the next reads return the len bytes at data, which must
+    // stay allocated while they are read
+    void set_data(const uint8_t *data, uint32_t len) {
+        _data = data;
+        _len = len;
+        _ofs = 0;
+    }
+
+    void begin(uint32_t baud) override {}
+    void begin(uint32_t baud, uint16_t rxSpace, uint16_t txSpace) override {}
+    void end() override {}
+    void flush() override {}
+    bool is_initialized() override { return true; }
+    void set_blocking_writes(bool blocking) override {}
+    bool tx_pending() override { return false; }
+
+    uint32_t available() override { return _len - _ofs; }
+    uint32_t txspace() override { return 1024; }
+    int16_t read() override {
+        if (_ofs >= _len) {
+            return -1;
+        }
+        return _data[_ofs++];
+    }
+    ssize_t read(uint8_t *buffer, uint16_t count) override {
+        const uint32_t n = MIN(uint32_t(count), _len - _ofs);
+        memcpy(buffer, &_data[_ofs], n);
+        _ofs += n;
+        return n;
+    }
+
+    size_t write(uint8_t c) override { return 1; }
+    size_t write(const uint8_t *buffer, size_t size) override { return size; }
+
+private:
+    const uint8_t *_data = nullptr;
+    uint32_t _len = 0;
+    uint32_t _ofs = 0;
+};
+
+/*
+  fill buf with the sentence $body*XX\r\n, where XX is the checksum of
+  body, returning its length or 0 if it doesn't fit
+ */
+static inline uint16_t gps_test_nmea_sentence(const char *body, char *buf, uint16_t buflen)
+{
+    uint8_t checksum = 0;
+    for (const char *p = body; *p; p++) {
+        checksum ^= *p;
+    }
+    const int n = snprintf(buf, buflen, "$%s*%02X\r\n", body, checksum);
+    if (n <= 0 || n >= buflen) {
+        return 0;
+    }
+    return n;
+}
+
+/*
+  a second of NMEA output from a receiver with a 3D fix at
+  48.1173N 11.5167E
+ */
+static inline uint16_t gps_test_nmea_stream(uint8_t *buf, uint16_t buflen)
+{
+    static const char *bodies[] = {
+        "GPRMC,123519.00,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W",
+        "GPGGA,123519.00,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,",
+        "GPVTG,084.4,T,087.5,M,022.4,N,041.5,K",
+        "GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1",
+    };
+    uint16_t len = 0;
+    for (uint8_t i=0; i<ARRAY_SIZE(bodies); i++) {
+        const uint16_t n = gps_test_nmea_sentence(bodies[i], (char *)&buf[len], buflen - len);
+        if (n == 0) {
+            break;
+        }
+        len += n;
+    }
+    return len;
+}
@@ -0,0 +1,115 @@
+#include <AP_gtest.h>
+
+#include <AP_GPS/AP_GPS.h>
+#include <AP_GPS/AP_GPS_NMEA.h>
+
+#include "GPS_TestUART.h"
+
+const AP_HAL::HAL &hal = AP_HAL::get_HAL();
+
+/*
+  feed the NMEA driver mutated copies of a recorded stream. Each case
+  flips bits, drops, duplicates or changes bytes, so the driver sees
+  sentences which are nearly valid as well as garbage. It must not
+  touch memory it doesn't own, which the sanitizers catch, and must
+  still decode the stream once it is clean again
+ */
+
+#define FUZZ_CASES 5000
+
+static AP_GPS gps;
+static GPS_TestUART uart;
+
+// deterministic so failures can be reproduced
+static uint32_t fuzz_seed = 1;
+static uint32_t fuzz_rand()
+{
+    fuzz_seed ^= fuzz_seed << 13;
+    fuzz_seed ^= fuzz_seed >> 17;
+    fuzz_seed ^= fuzz_seed << 5;
+    return fuzz_seed;
+}
+
+static uint16_t mutate(const uint8_t *in, uint16_t inlen, uint8_t *buf, uint16_t buflen)
+{
+    uint16_t len = 0;
+    for (uint16_t i=0; i<inlen && len < buflen; i++) {
+        uint8_t b = in[i];
+        switch (fuzz_rand() % 32) {
+        case 0:
+            // flip a bit
+            b ^= 1U << (fuzz_rand() % 8);
+            break;
+        case 1:
+            // drop the byte
+            continue;
+        case 2:
+            // duplicate the byte
+            buf[len++] = b;
+            break;
+        case 3:
+            // a byte which starts, separates or ends a term
+            b = "$,*\r\n"[fuzz_rand() % 5];
+            break;
+        case 4:
+            b = fuzz_rand();
+            break;
+        }
+        if (len < buflen) {
+            buf[len++] = b;
+        }
+    }
+    return len;
+}
+
+TEST(GPSFuzz, NMEADecodes)
+{
+    AP_GPS::GPS_State state {};
+    AP_GPS_NMEA nmea(gps, state, &uart);
+    uint8_t stream[512];
+    const uint16_t len = gps_test_nmea_stream(stream, sizeof(stream));
+    ASSERT_GT(len, 0);
+    uart.set_data(stream, len);
+    nmea.read();
+    EXPECT_EQ(state.status, AP_GPS::GPS_OK_FIX_3D);
+    EXPECT_NEAR(state.location.lat, 481173000, 100);
+    EXPECT_NEAR(state.location.lng, 115166667, 100);
+    EXPECT_EQ(state.num_sats, 8);
+}
+
+TEST(GPSFuzz, NMEAMutated)
+{
+    AP_GPS::GPS_State state {};
+    AP_GPS_NMEA nmea(gps, state, &uart);
+    uint8_t stream[512];
+    const uint16_t len = gps_test_nmea_stream(stream, sizeof(stream));
+    uint8_t buf[2*sizeof(stream)];
+    for (uint16_t c=0; c<FUZZ_CASES; c++) {
+        const uint16_t mutated_len = mutate(stream, len, buf, sizeof(buf));
+        uart.set_data(buf, mutated_len);
+        nmea.read();
+    }
+
+    // a clean stream is still decoded
+    state = {};
+    uart.set_data(stream, len);
+    nmea.read();
+    EXPECT_EQ(state.status, AP_GPS::GPS_OK_FIX_3D);
+    EXPECT_NEAR(state.location.lat, 481173000, 100);
+}
+
+TEST(GPSFuzz, NMEARandomBytes)
+{
+    AP_GPS::GPS_State state {};
+    AP_GPS_NMEA nmea(gps, state, &uart);
+    uint8_t buf[1024];
+    for (uint16_t c=0; c<500; c++) {
+        for (uint16_t i=0; i<sizeof(buf); i++) {
+            buf[i] = fuzz_rand();
+        }
+        uart.set_data(buf, sizeof(buf));
+        nmea.read();
+    }
+}
+
+AP_GTEST_MAIN()
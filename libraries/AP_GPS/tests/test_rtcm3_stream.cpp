@@ -0,0 +1,131 @@
+#include <AP_gtest.h>
+
+#include <AP_GPS/RTCM3_Stream.h>
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Math/AP_Math.h>
+
+#include <string.h>
+#include <vector>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+typedef std::vector<uint8_t> bytes;
+
+// a frame of message type msg_type with a payload of payload_len
+// bytes. The CRC is not checked by the stream, so is left as zero
+static bytes rtcm_frame(uint16_t msg_type, uint16_t payload_len)
+{
+    bytes frame { RTCM3_Stream::PREAMBLE, uint8_t(payload_len >> 8), uint8_t(payload_len & 0xFF),
+                  uint8_t(msg_type >> 4), uint8_t((msg_type & 0x0F) << 4) };
+    for (uint16_t i=2; i<payload_len; i++) {
+        frame.push_back(uint8_t(i * 7));
+    }
+    frame.insert(frame.end(), 3, 0);
+    return frame;
+}
+
+struct result {
+    bytes data;                 // everything passed on, in order
+    bytes raw;                  // what was passed on as RAW
+    std::vector<uint16_t> msg_types;
+    std::vector<uint16_t> frame_lens;
+};
+
+// pass data through a stream in chunks of chunk bytes
+static result split(const bytes &data, uint16_t chunk)
+{
+    RTCM3_Stream stream;
+    result r;
+    for (size_t ofs=0; ofs<data.size(); ofs += chunk) {
+        const uint8_t *p = &data[ofs];
+        uint16_t len = MIN(size_t(chunk), data.size() - ofs);
+        RTCM3_Stream::Segment seg;
+        while (stream.next(p, len, seg)) {
+            EXPECT_GT(seg.len, 0);
+            r.data.insert(r.data.end(), seg.data, seg.data + seg.len);
+            switch (seg.type) {
+            case RTCM3_Stream::SegmentType::RAW:
+                r.raw.insert(r.raw.end(), seg.data, seg.data + seg.len);
+                break;
+            case RTCM3_Stream::SegmentType::FRAME_START:
+                EXPECT_EQ(seg.len, RTCM3_Stream::HEADER_LEN);
+                r.msg_types.push_back(seg.msg_type);
+                r.frame_lens.push_back(seg.frame_len);
+                break;
+            case RTCM3_Stream::SegmentType::FRAME_DATA:
+                break;
+            }
+        }
+        EXPECT_EQ(len, 0);
+    }
+    return r;
+}
+
+TEST(RTCM3_Stream, Frames)
+{
+    bytes data;
+    const uint16_t types[] { 1005, 1077, 1087, 1230, 4095 };
+    const uint16_t lens[] { 19, 1023, 2, 300, 8 };
+    for (uint8_t i=0; i<ARRAY_SIZE(types); i++) {
+        const bytes frame = rtcm_frame(types[i], lens[i]);
+        data.insert(data.end(), frame.begin(), frame.end());
+    }
+
+    for (uint16_t chunk=1; chunk<=300; chunk++) {
+        const result r = split(data, chunk);
+        EXPECT_EQ(r.data, data);
+        EXPECT_TRUE(r.raw.empty());
+        ASSERT_EQ(r.msg_types.size(), ARRAY_SIZE(types));
+        for (uint8_t i=0; i<ARRAY_SIZE(types); i++) {
+            EXPECT_EQ(r.msg_types[i], types[i]);
+            EXPECT_EQ(r.frame_lens[i], lens[i] + 6);
+        }
+    }
+}
+
+TEST(RTCM3_Stream, PassThrough)
+{
+    // other protocols, a preamble with the reserved bits set and a
+    // frame with no message type are all passed through unchanged
+    bytes data { 0x55, 0x0b, 0x02, RTCM3_Stream::PREAMBLE, 0xFF, 0x10,
+                 RTCM3_Stream::PREAMBLE, 0x00, 0x00, 0x47, 0xEA, 0x4B,
+                 RTCM3_Stream::PREAMBLE, RTCM3_Stream::PREAMBLE };
+    const bytes frame = rtcm_frame(1074, 40);
+    bytes input = data;
+    input.insert(input.end(), frame.begin(), frame.end());
+    input.push_back(0x42);
+
+    for (uint16_t chunk=1; chunk<=input.size(); chunk++) {
+        const result r = split(input, chunk);
+        EXPECT_EQ(r.data, input);
+        bytes raw = data;
+        raw.push_back(0x42);
+        EXPECT_EQ(r.raw, raw);
+        ASSERT_EQ(r.msg_types.size(), 1U);
+        EXPECT_EQ(r.msg_types[0], 1074);
+    }
+}
+
+TEST(RTCM3_Stream, Reset)
+{
+    // losing part of a frame and resetting resyncs on the next one
+    const bytes frame = rtcm_frame(1005, 19);
+    bytes input(frame.begin(), frame.begin() + 10);
+
+    RTCM3_Stream stream;
+    RTCM3_Stream::Segment seg;
+    const uint8_t *p = &input[0];
+    uint16_t len = input.size();
+    while (stream.next(p, len, seg)) {}
+    EXPECT_TRUE(stream.in_frame());
+
+    stream.reset();
+    EXPECT_FALSE(stream.in_frame());
+    p = &frame[0];
+    len = frame.size();
+    ASSERT_TRUE(stream.next(p, len, seg));
+    EXPECT_EQ(seg.type, RTCM3_Stream::SegmentType::FRAME_START);
+    EXPECT_EQ(seg.msg_type, 1005);
+}
+
+AP_GTEST_MAIN()
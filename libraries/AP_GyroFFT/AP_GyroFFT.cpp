@@ -0,0 +1,322 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_GyroFFT.h"
+
+#if HAL_GYROFFT_ENABLED
+
+#include <AP_Common/Semaphore.h>
+#include <AP_Logger/AP_Logger.h>
+
+extern const AP_HAL::HAL& hal;
+
+AP_GyroFFT *AP_GyroFFT::_singleton;
+
+GyroFFT_Analyser::~GyroFFT_Analyser()
+{
+    free(_window);
+    free(_cos);
+    free(_sin);
+    free(_re);
+    free(_im);
+}
+
+bool GyroFFT_Analyser::init()
+{
+    const uint16_t n = GYROFFT_WINDOW_SIZE;
+    _window = (float *)calloc(n, sizeof(float));
+    _cos = (float *)calloc(n/2, sizeof(float));
+    _sin = (float *)calloc(n/2, sizeof(float));
+    _re = (float *)calloc(n, sizeof(float));
+    _im = (float *)calloc(n, sizeof(float));
+    if (_window == nullptr || _cos == nullptr || _sin == nullptr ||
+        _re == nullptr || _im == nullptr) {
+        return false;
+    }
+    for (uint16_t i=0; i<n; i++) {
+        _window[i] = 0.5f * (1 - cosf(M_2PI * i / n));
+    }
+    for (uint16_t i=0; i<n/2; i++) {
+        _cos[i] = cosf(M_2PI * i / n);
+        _sin[i] = sinf(M_2PI * i / n);
+    }
+    return true;
+}
+
+/*
+  in place radix 2 FFT of _re and _im
+ */
+void GyroFFT_Analyser::fft()
+{
+    const uint16_t n = GYROFFT_WINDOW_SIZE;
+
+    // bit reversed reordering
+    for (uint16_t i=1, j=0; i<n; i++) {
+        uint16_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            const float re = _re[i];
+            const float im = _im[i];
+            _re[i] = _re[j];
+            _im[i] = _im[j];
+            _re[j] = re;
+            _im[j] = im;
+        }
+    }
+
+    for (uint16_t len=2; len<=n; len<<=1) {
+        const uint16_t half = len / 2;
+        const uint16_t step = n / len;
+        for (uint16_t i=0; i<n; i+=len) {
+            for (uint16_t k=0; k<half; k++) {
+                const float wr = _cos[k*step];
+                const float wi = -_sin[k*step];
+                const uint16_t a = i + k;
+                const uint16_t b = a + half;
+                const float tr = _re[b] * wr - _im[b] * wi;
+                const float ti = _re[b] * wi + _im[b] * wr;
+                _re[b] = _re[a] - tr;
+                _im[b] = _im[a] - ti;
+                _re[a] += tr;
+                _im[a] += ti;
+            }
+        }
+    }
+}
+
+void GyroFFT_Analyser::analyse(const float *samples, uint16_t start, float sample_rate_hz,
+                               struct peak peaks[GYROFFT_MAX_PEAKS])
+{
+    const uint16_t n = GYROFFT_WINDOW_SIZE;
+
+    memset(peaks, 0, sizeof(peaks[0]) * GYROFFT_MAX_PEAKS);
+
+    // remove the mean, so it doesn't leak into the low bins
+    float mean = 0;
+    for (uint16_t i=0; i<n; i++) {
+        mean += samples[i];
+    }
+    mean /= n;
+    for (uint16_t i=0; i<n; i++) {
+        _re[i] = (samples[(start + i) % n] - mean) * _window[i];
+        _im[i] = 0;
+    }
+
+    fft();
+
+    // magnitudes of the bins up to the Nyquist frequency
+    for (uint16_t k=0; k<=n/2; k++) {
+        _re[k] = sqrtf(sq(_re[k]) + sq(_im[k]));
+    }
+
+    const float bin_hz = sample_rate_hz / n;
+    const uint16_t min_bin = MAX(1, (int)ceilf(GYROFFT_MIN_FREQ_HZ / bin_hz));
+    for (uint16_t k=min_bin; k<n/2; k++) {
+        const float m = _re[k];
+        if (m <= _re[k-1] || m < _re[k+1]) {
+            continue;
+        }
+        // the Hann window halves a sine's energy
+        const float amplitude = m * 4.0f / n;
+        if (amplitude <= peaks[GYROFFT_MAX_PEAKS-1].amplitude) {
+            continue;
+        }
+
+        // fit a parabola through the peak and its neighbours
+        float delta = 0;
+        const float denom = _re[k-1] - 2 * m + _re[k+1];
+        if (!is_zero(denom)) {
+            delta = constrain_float(0.5f * (_re[k-1] - _re[k+1]) / denom, -0.5f, 0.5f);
+        }
+
+        // insert, keeping the peaks strongest first
+        uint8_t i = GYROFFT_MAX_PEAKS-1;
+        while (i > 0 && peaks[i-1].amplitude < amplitude) {
+            peaks[i] = peaks[i-1];
+            i--;
+        }
+        peaks[i].freq_hz = (k + delta) * bin_hz;
+        peaks[i].amplitude = amplitude;
+    }
+}
+
+AP_GyroFFT::AP_GyroFFT()
+{
+    _singleton = this;
+}
+
+bool AP_GyroFFT::init(uint16_t sample_rate_hz)
+{
+    if (_samples != nullptr) {
+        return true;
+    }
+    if (sample_rate_hz < 2 * GYROFFT_MIN_FREQ_HZ) {
+        return false;
+    }
+    for (uint8_t axis=0; axis<3; axis++) {
+        _history[axis] = (float *)calloc(GYROFFT_WINDOW_SIZE, sizeof(float));
+        if (_history[axis] == nullptr) {
+            return false;
+        }
+    }
+    if (!_analyser.init()) {
+        return false;
+    }
+    _sample_rate_hz = sample_rate_hz;
+
+    // room for a full window, so the IO thread can be slow to run
+    _samples = new ObjectBuffer<Vector3f>(GYROFFT_WINDOW_SIZE);
+    if (_samples == nullptr || _samples->space() == 0) {
+        delete _samples;
+        _samples = nullptr;
+        return false;
+    }
+
+    hal.scheduler->register_io_process(FUNCTOR_BIND_MEMBER(&AP_GyroFFT::io_timer, void));
+    return true;
+}
+
+/*
+  take queued samples and, each time half a window has arrived,
+  analyse each axis in turn.  At most one FFT is done per call
+ */
+void AP_GyroFFT::io_timer()
+{
+    const uint16_t n = GYROFFT_WINDOW_SIZE;
+
+    if (_next_axis == 3) {
+        Vector3f gyro;
+        while ((_history_count < n || _new_samples < n/2) && _samples->pop(gyro)) {
+            _history[0][_history_idx] = gyro.x;
+            _history[1][_history_idx] = gyro.y;
+            _history[2][_history_idx] = gyro.z;
+            _history_idx = (_history_idx + 1) % n;
+            if (_history_count < n) {
+                _history_count++;
+            }
+            _new_samples++;
+        }
+        if (_history_count < n || _new_samples < n/2) {
+            return;
+        }
+        _new_samples = 0;
+        _next_axis = 0;
+    }
+
+    const uint32_t start_us = AP_HAL::micros();
+    peak peaks[GYROFFT_MAX_PEAKS];
+    _analyser.analyse(_history[_next_axis], _history_idx, _sample_rate_hz, peaks);
+    const uint16_t cost_us = MIN(AP_HAL::micros() - start_us, (uint32_t)UINT16_MAX);
+
+    WITH_SEMAPHORE(_sem);
+    memcpy(_peaks[_next_axis], peaks, sizeof(peaks));
+    _last_update_ms = AP_HAL::millis();
+    _cost.total_us += cost_us;
+    _cost.count++;
+    _cost.interval_max_us = MAX(_cost.interval_max_us, cost_us);
+    _next_axis++;
+}
+
+bool AP_GyroFFT::healthy() const
+{
+    return _samples != nullptr && AP_HAL::millis() - _last_update_ms < 1000;
+}
+
+bool AP_GyroFFT::get_peak(uint8_t axis, uint8_t idx, peak &p) const
+{
+    if (axis >= 3 || idx >= GYROFFT_MAX_PEAKS || !healthy()) {
+        return false;
+    }
+    WITH_SEMAPHORE(_sem);
+    p = _peaks[axis][idx];
+    return !is_zero(p.freq_hz);
+}
+
+float AP_GyroFFT::get_weighted_frequency() const
+{
+    if (!healthy()) {
+        return 0;
+    }
+    WITH_SEMAPHORE(_sem);
+    const peak &roll = _peaks[0][0];
+    const peak &pitch = _peaks[1][0];
+    const float total = roll.amplitude + pitch.amplitude;
+    if (!is_positive(total)) {
+        return 0;
+    }
+    return (roll.freq_hz * roll.amplitude + pitch.freq_hz * pitch.amplitude) / total;
+}
+
+/*
+  log the peaks and our cost at 10Hz
+ */
+void AP_GyroFFT::periodic()
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    if (_samples == nullptr || now_ms - _last_log_ms < 100) {
+        return;
+    }
+    _last_log_ms = now_ms;
+
+    peak peaks[3][GYROFFT_MAX_PEAKS];
+    {
+        WITH_SEMAPHORE(_sem);
+        memcpy(peaks, _peaks, sizeof(peaks));
+        _cost.avg_us = _cost.count ? _cost.total_us / _cost.count : 0;
+        _cost.max_us = _cost.interval_max_us;
+        _cost.total_us = 0;
+        _cost.count = 0;
+        _cost.interval_max_us = 0;
+    }
+    if (!healthy()) {
+        return;
+    }
+
+    AP_Logger *logger = AP_Logger::get_singleton();
+    if (logger == nullptr) {
+        return;
+    }
+    const uint64_t now_us = AP_HAL::micros64();
+    for (uint8_t axis=0; axis<3; axis++) {
+        const struct log_FTN pkt {
+            LOG_PACKET_HEADER_INIT(LOG_FTN_MSG),
+            time_us     : now_us,
+            axis        : axis,
+            freq1       : peaks[axis][0].freq_hz,
+            amp1        : peaks[axis][0].amplitude,
+            freq2       : peaks[axis][1].freq_hz,
+            amp2        : peaks[axis][1].amplitude,
+            freq3       : peaks[axis][2].freq_hz,
+            amp3        : peaks[axis][2].amplitude,
+            avg_cost_us : _cost.avg_us,
+            max_cost_us : _cost.max_us,
+        };
+        logger->WriteBlock(&pkt, sizeof(pkt));
+    }
+}
+
+namespace AP {
+
+AP_GyroFFT *gyro_fft()
+{
+    return AP_GyroFFT::get_singleton();
+}
+
+};
+
+#endif // HAL_GYROFFT_ENABLED
@@ -0,0 +1,159 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  on-board spectrum analysis of the primary gyro.
+
+  The IMU backend queues each raw gyro sample. The IO thread runs a
+  Hann windowed FFT over the last GYROFFT_WINDOW_SIZE samples of each
+  axis every half window, one axis per call so the time taken per
+  call is bounded, and keeps the strongest peaks found.
+ */
+#pragma once
+
+#include <AP_HAL/AP_HAL.h>
+
+#ifndef HAL_GYROFFT_ENABLED
+#define HAL_GYROFFT_ENABLED !HAL_MINIMIZE_FEATURES
+#endif
+
+#if HAL_GYROFFT_ENABLED
+
+#include <AP_HAL/utility/RingBuffer.h>
+#include <AP_Math/AP_Math.h>
+
+// samples per FFT window, a power of two
+#define GYROFFT_WINDOW_SIZE 128
+
+// peaks kept per axis
+#define GYROFFT_MAX_PEAKS 3
+
+// lower frequencies are flight motion rather than vibration
+#define GYROFFT_MIN_FREQ_HZ 20
+
+/*
+  finds the peaks in the spectrum of a window of samples
+ */
+class GyroFFT_Analyser {
+public:
+    struct peak {
+        float freq_hz;
+        // amplitude of the peak in the units of the samples
+        float amplitude;
+    };
+
+    ~GyroFFT_Analyser();
+
+    // allocate the tables; returns false if out of memory
+    bool init();
+
+    // fill peaks, strongest first, from GYROFFT_WINDOW_SIZE samples
+    // taken at sample_rate_hz.  samples is circular, the oldest being
+    // at index start.  Missing peaks have zero frequency
+    void analyse(const float *samples, uint16_t start, float sample_rate_hz,
+                 struct peak peaks[GYROFFT_MAX_PEAKS]);
+
+private:
+    void fft();
+
+    float *_window;     // Hann window
+    float *_cos;        // twiddle factors, half a window of each
+    float *_sin;
+    float *_re;         // transform in progress
+    float *_im;
+};
+
+class AP_GyroFFT {
+public:
+    AP_GyroFFT();
+
+    /* Do not allow copies */
+    AP_GyroFFT(const AP_GyroFFT &other) = delete;
+    AP_GyroFFT &operator=(const AP_GyroFFT&) = delete;
+
+    static AP_GyroFFT *get_singleton() {
+        return _singleton;
+    }
+
+    typedef GyroFFT_Analyser::peak peak;
+
+    // start analysing samples taken at sample_rate_hz.  Returns false
+    // if out of memory
+    bool init(uint16_t sample_rate_hz);
+
+    // queue a primary gyro sample, called from the IMU backend at
+    // the rate given to init()
+    void sample(const Vector3f &gyro) {
+        if (_samples != nullptr) {
+            _samples->push(gyro);
+        }
+    }
+
+    // log the latest peaks, called from the main thread
+    void periodic();
+
+    // true if the peaks are from the last second
+    bool healthy() const;
+
+    // get peak idx, the strongest being 0, on axis 0 (roll) to 2
+    // (yaw).  Returns false if there is no such peak
+    bool get_peak(uint8_t axis, uint8_t idx, peak &p) const;
+
+    // the frequency of the strongest roll and pitch peaks, weighted
+    // by their amplitudes, or zero if there are none
+    float get_weighted_frequency() const;
+
+    // time taken by each FFT over the last log interval
+    uint16_t get_average_cost_us() const { return _cost.avg_us; }
+    uint16_t get_max_cost_us() const { return _cost.max_us; }
+
+private:
+    static AP_GyroFFT *_singleton;
+
+    void io_timer();
+
+    uint16_t _sample_rate_hz;
+    ObjectBuffer<Vector3f> *_samples;
+    GyroFFT_Analyser _analyser;
+
+    // the latest window of samples of each axis, used only by the
+    // IO thread
+    float *_history[3];
+    uint16_t _history_idx;
+    uint16_t _history_count;
+    uint16_t _new_samples;
+    // next axis to analyse, or 3 when waiting for samples
+    uint8_t _next_axis = 3;
+
+    mutable HAL_Semaphore _sem;
+    peak _peaks[3][GYROFFT_MAX_PEAKS];
+    uint32_t _last_update_ms;
+
+    // FFT cost since the last log, and as of the last log
+    struct {
+        uint32_t total_us;
+        uint16_t count;
+        uint16_t interval_max_us;
+        uint16_t avg_us;
+        uint16_t max_us;
+    } _cost;
+
+    uint32_t _last_log_ms;
+};
+
+namespace AP {
+    AP_GyroFFT *gyro_fft();
+};
+
+#endif // HAL_GYROFFT_ENABLED
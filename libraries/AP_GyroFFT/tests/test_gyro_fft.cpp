@@ -0,0 +1,84 @@
+#include <AP_gtest.h>
+
+#include <AP_GyroFFT/AP_GyroFFT.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static const float sample_rate_hz = 1000;
+
+// fill samples with a 100Hz sine plus a weaker 230Hz one, a drift
+// below the minimum frequency and an offset
+static void make_samples(float samples[GYROFFT_WINDOW_SIZE])
+{
+    for (uint16_t i=0; i<GYROFFT_WINDOW_SIZE; i++) {
+        const float t = i / sample_rate_hz;
+        samples[i] = 0.3f +
+            1.0f * sinf(M_2PI * 100 * t) +
+            0.4f * sinf(M_2PI * 230 * t) +
+            2.0f * sinf(M_2PI * 2 * t);
+    }
+}
+
+TEST(GyroFFTTest, FindsPeaks)
+{
+    GyroFFT_Analyser analyser;
+    ASSERT_TRUE(analyser.init());
+
+    float samples[GYROFFT_WINDOW_SIZE];
+    make_samples(samples);
+
+    GyroFFT_Analyser::peak peaks[GYROFFT_MAX_PEAKS];
+    analyser.analyse(samples, 0, sample_rate_hz, peaks);
+
+    EXPECT_NEAR(peaks[0].freq_hz, 100, 1.5f);
+    EXPECT_NEAR(peaks[0].amplitude, 1.0f, 0.25f);
+    EXPECT_NEAR(peaks[1].freq_hz, 230, 1.5f);
+    EXPECT_NEAR(peaks[1].amplitude, 0.4f, 0.1f);
+    for (uint8_t i=0; i<GYROFFT_MAX_PEAKS; i++) {
+        if (!is_zero(peaks[i].freq_hz)) {
+            EXPECT_GE(peaks[i].freq_hz, GYROFFT_MIN_FREQ_HZ);
+        }
+    }
+}
+
+TEST(GyroFFTTest, CircularStart)
+{
+    GyroFFT_Analyser analyser;
+    ASSERT_TRUE(analyser.init());
+
+    // the same window, rotated
+    float samples[GYROFFT_WINDOW_SIZE];
+    float rotated[GYROFFT_WINDOW_SIZE];
+    make_samples(samples);
+    const uint16_t start = 37;
+    for (uint16_t i=0; i<GYROFFT_WINDOW_SIZE; i++) {
+        rotated[(start + i) % GYROFFT_WINDOW_SIZE] = samples[i];
+    }
+
+    GyroFFT_Analyser::peak peaks[GYROFFT_MAX_PEAKS];
+    GyroFFT_Analyser::peak rotated_peaks[GYROFFT_MAX_PEAKS];
+    analyser.analyse(samples, 0, sample_rate_hz, peaks);
+    analyser.analyse(rotated, start, sample_rate_hz, rotated_peaks);
+    for (uint8_t i=0; i<2; i++) {
+        EXPECT_NEAR(peaks[i].freq_hz, rotated_peaks[i].freq_hz, 0.01f);
+        EXPECT_NEAR(peaks[i].amplitude, rotated_peaks[i].amplitude, 0.001f);
+    }
+}
+
+TEST(GyroFFTTest, NoPeaksInSilence)
+{
+    GyroFFT_Analyser analyser;
+    ASSERT_TRUE(analyser.init());
+
+    float samples[GYROFFT_WINDOW_SIZE];
+    for (uint16_t i=0; i<GYROFFT_WINDOW_SIZE; i++) {
+        samples[i] = 0.5f;
+    }
+    GyroFFT_Analyser::peak peaks[GYROFFT_MAX_PEAKS];
+    analyser.analyse(samples, 0, sample_rate_hz, peaks);
+    for (uint8_t i=0; i<GYROFFT_MAX_PEAKS; i++) {
+        EXPECT_TRUE(is_zero(peaks[i].freq_hz));
+    }
+}
+
+AP_GTEST_MAIN()
@@ -206,6 +206,14 @@
 #define HAL_HAVE_GETTIME_SETTIME 0
 #endif
 
+// allocate the data used on every loop by the rate and position
+// controllers from fast memory (DTCM on F7/H7, CCM on F4) where the
+// board has it, as the EKF cores are. A board whose fast memory is
+// better left to the EKF cores can set this to 0 in its hwdef
+#ifndef HAL_HOT_DATA_FASTMEM
+#define HAL_HOT_DATA_FASTMEM 1
+#endif
+
 // this is used as a general mechanism to make a 'small' build by
 // dropping little used features. We use this to allow us to keep
 // FMUv2 going for as long as possible
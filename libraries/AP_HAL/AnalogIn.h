@@ -35,6 +35,22 @@ public:
     // return a voltage from 0.0 to 5.0V, assuming a ratiometric
     // sensor
     virtual float voltage_average_ratiometric() = 0;
+
+    // optionally return the integral of the voltage in volt seconds,
+    // over interval_us since the last call, from every sample of the
+    // ADC. Returns false if there have been no samples since the last
+    // call. This is for sensors such as current sensors where the total
+    // matters and shouldn't depend on how often the caller reads it
+    virtual bool voltage_integral(float &integral, uint32_t &interval_us) { return false; }
+
+    // optionally set the cutoff frequency of a low pass filter applied
+    // to each new value as it is read from the ADC, for read_latest()
+    // and voltage_latest(). Zero, the default, leaves them unfiltered
+    virtual void set_filter_cutoff(float cutoff_hz) {}
+
+    // system time in microseconds of the value given by read_latest(),
+    // or zero if not known
+    virtual uint32_t last_update_us() { return 0; }
 };
 
 class AP_HAL::AnalogIn {
@@ -127,6 +127,41 @@ public:
     virtual void initialized(bool val) = 0;
 
     uavcan::ICanDriver* get_driver() { return _driver; }
+
+    /*
+      transmit statistics for an interface, counted since it was
+      started. Latency is from a frame being queued until it has been
+      sent on the bus
+     */
+    struct TxStats {
+        uint32_t frames;            // frames sent
+        uint32_t timeouts;          // frames dropped at their deadline
+        uint32_t aborts;            // frames aborted on a bus error
+        uint16_t queue_len;         // frames waiting now
+        uint16_t queue_max;         // most frames waiting
+        uint16_t queue_size;        // frames the queue can hold
+        uint32_t latency_avg_us;
+        uint32_t latency_max_us;
+    };
+
+    virtual bool get_tx_stats(uint8_t iface, TxStats &stats) { return false; }
+
+    /*
+      receive statistics for an interface, counted since it was
+      started. The ISR time is that of the longest receive interrupt
+     */
+    struct RxStats {
+        uint32_t frames;            // frames received
+        uint32_t queue_overflows;   // frames dropped with the queue full
+        uint32_t fifo_overflows;    // frames lost in the controller
+        uint32_t bus_offs;          // times the controller went bus-off
+        uint32_t errors;            // all errors, including the above
+        uint16_t queue_len;         // frames waiting now
+        uint16_t queue_size;        // frames the queue can hold
+        uint32_t isr_max_us;
+    };
+
+    virtual bool get_rx_stats(uint8_t iface, RxStats &stats) { return false; }
 private:
     uavcan::ICanDriver* _driver;
 };
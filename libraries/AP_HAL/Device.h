@@ -117,6 +117,90 @@ public:
         return transfer(&first_reg, 1, recv, recv_len);
     }
 
+    /*
+     * Start a transfer which sends send_len bytes and then receives
+     * recv_len bytes, without waiting for the bytes to be received.
+     * send is used before returning, but recv must not be used until
+     * #transfer_finish() has returned. Only one transfer may be in
+     * progress on a device at a time and the bus semaphore must be
+     * held until it has finished.
+     *
+     * Devices without asynchronous transfers do the whole transfer
+     * here, so callers can always follow this with #transfer_finish().
+     *
+     * Return: true if the transfer was started, false on failure.
+     */
+    virtual bool transfer_start(const uint8_t *send, uint32_t send_len,
+                                uint8_t *recv, uint32_t recv_len)
+    {
+        return transfer(send, send_len, recv, recv_len);
+    }
+
+    /*
+     * Wait for the transfer started by #transfer_start() to complete.
+     *
+     * Return: true on a successful transfer, false on failure.
+     */
+    virtual bool transfer_finish() { return true; }
+
+    /**
+     * Wrapper function over #transfer_start() to start reading recv_len
+     * registers, starting by first_reg, into the array pointed by recv.
+     * The read completes with #transfer_finish().
+     *
+     * Return: true if the read was started, false on failure.
+     */
+    bool read_registers_start(uint8_t first_reg, uint8_t *recv, uint32_t recv_len)
+    {
+        first_reg |= _read_flag;
+        return transfer_start(&first_reg, 1, recv, recv_len);
+    }
+
+    /*
+     * one transfer of a batch passed to #transfer_batch()
+     */
+    struct BatchTransfer {
+        const uint8_t *send;
+        uint32_t send_len;
+        uint8_t *recv;
+        uint32_t recv_len;
+    };
+
+    /*
+     * Do count transfers back to back, so the bus is set up once for
+     * all of them rather than once for each. Stops at the first
+     * transfer to fail.
+     *
+     * Return: the number of transfers done, which may be less than
+     * count if a transfer failed.
+     */
+    virtual uint8_t transfer_batch(const BatchTransfer *transfers, uint8_t count)
+    {
+        for (uint8_t i = 0; i < count; i++) {
+            if (!transfer(transfers[i].send, transfers[i].send_len,
+                          transfers[i].recv, transfers[i].recv_len)) {
+                return i;
+            }
+        }
+        return count;
+    }
+
+    /*
+     * total time in microseconds this device has held its bus, for
+     * measuring bus utilisation. Wraps every 71 minutes. Returns zero
+     * on HALs that don't measure it.
+     */
+    virtual uint32_t get_bus_busy_us() const { return 0; }
+
+    /*
+     * totals for the whole bus this device is on: the time in
+     * microseconds any device has held it and the number of bus
+     * transactions.
+     *
+     * Return: false on HALs that don't measure them.
+     */
+    virtual bool get_bus_stats(uint32_t &busy_us, uint32_t &transactions) const { return false; }
+
     /**
      * Wrapper function over #transfer() to write a byte to the register reg.
      * The transfer is done by sending reg and val in that order.
@@ -12,4 +12,26 @@ HAL::FunCallbacks::FunCallbacks(void (*setup_fun)(void), void (*loop_fun)(void))
     assert(loop_fun);
 }
 
+UARTDriver* HAL::serial(uint8_t sernum) const
+{
+    // SERIALn numbering, which differs from the order of the letters
+    switch (sernum) {
+    case 0:
+        return uartA;
+    case 1:
+        return uartC;
+    case 2:
+        return uartD;
+    case 3:
+        return uartB;
+    case 4:
+        return uartE;
+    case 5:
+        return uartF;
+    case 6:
+        return uartG;
+    }
+    return nullptr;
+}
+
 }
@@ -101,6 +101,11 @@ public:
     AP_HAL::UARTDriver* uartE;
     AP_HAL::UARTDriver* uartF;
     AP_HAL::UARTDriver* uartG;
+
+    // get the UART for SERIALn, or nullptr if there is none
+    static const uint8_t num_serial = 7;
+    AP_HAL::UARTDriver* serial(uint8_t sernum) const;
+
     AP_HAL::I2CDeviceManager* i2c_mgr;
     AP_HAL::SPIDeviceManager* spi;
     AP_HAL::AnalogIn*   analogin;
@@ -70,6 +70,16 @@ public:
      */
     virtual void     push() = 0;
 
+    /*
+     * Synchronous output. When enabled push() sends the new values
+     * straight away, waiting for the output hardware to be free
+     * rather than leaving the update for a later resend, and
+     * periodic resends are held off while pushes keep coming. This
+     * is for a control loop that pushes once per gyro sample, so the
+     * time from the sample to the output is short and steady
+     */
+    virtual void     set_output_sync(bool sync) {}
+
     /* Read back current output state, as either single channel or
      * array of channels. On boards that have a separate IO controller,
      * this returns the latest output value that the IO controller has
@@ -196,4 +206,18 @@ public:
       with DShot to get telemetry feedback
      */
     virtual void set_telem_request_mask(uint16_t mask) {}
+
+    /*
+      enable bidirectional DShot for a mask of channels. The ESCs on
+      these channels answer each frame with their eRPM on the same
+      wire, which needs ESC firmware that supports it
+     */
+    virtual void set_bidir_dshot_mask(uint16_t mask) {}
+
+    /*
+      get the last eRPM received over bidirectional DShot for a
+      channel. Returns false if there has been no valid reply in the
+      last 100ms
+     */
+    virtual bool get_erpm(uint8_t chan, uint32_t &erpm) { return false; }
 };
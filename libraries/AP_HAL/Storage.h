@@ -10,4 +10,13 @@ public:
     virtual void write_block(uint16_t dst, const void* src, size_t n) = 0;
     virtual void _timer_tick(void) {};
     virtual bool healthy(void) { return true; }
+
+    // statistics on writes to the backing store, for diagnostics
+    struct Stats {
+        uint32_t writes;         // backend writes
+        uint32_t lines;          // lines written by them
+        uint32_t max_write_us;   // longest backend write
+        uint32_t max_pending_ms; // longest data waited to be written
+    };
+    virtual bool get_stats(Stats &stats) { return false; }
 };
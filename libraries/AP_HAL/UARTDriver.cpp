@@ -0,0 +1,22 @@
+#include "UARTDriver.h"
+
+/*
+  fallback for drivers without their own writev(). The space check
+  can't be made atomic here, so another thread's write may come
+  between the fragments
+ */
+size_t AP_HAL::UARTDriver::writev(const WriteVec *vec, uint8_t count)
+{
+    uint32_t total = 0;
+    for (uint8_t i=0; i<count; i++) {
+        total += vec[i].len;
+    }
+    if (txspace() < total) {
+        return 0;
+    }
+    size_t ret = 0;
+    for (uint8_t i=0; i<count; i++) {
+        ret += write(vec[i].data, vec[i].len);
+    }
+    return ret;
+}
@@ -47,6 +47,20 @@ public:
 
     // read from a locked port. If port is locked and key is not correct then 0 is returned
     virtual int16_t read_locked(uint32_t key) { return -1; }
+
+    // a fragment of a write for writev()
+    struct WriteVec {
+        const uint8_t *data;
+        uint16_t len;
+    };
+
+    /*
+      write count fragments as one write, with a single lock and space
+      check. Either all of the bytes are queued or none are, so a
+      packet is never cut short or split by another thread's write.
+      Returns the number of bytes written
+     */
+    virtual size_t writev(const WriteVec *vec, uint8_t count);
     
     // control optional features
     virtual bool set_options(uint8_t options) { return options==0; }
@@ -103,4 +117,26 @@ public:
     virtual uint32_t bw_in_kilobytes_per_second() const {
         return 57;
     }
+
+    /*
+      throughput and latency statistics, counted since boot. Counters
+      a driver can't see are left at zero
+     */
+    struct UARTStats {
+        uint32_t rx_bytes;          // bytes received from the device
+        uint32_t tx_bytes;          // bytes handed to the device
+        uint32_t irqs;              // interrupts taken for the port
+        uint32_t rx_overruns;       // times the hardware lost received bytes
+        uint32_t rx_dropped;        // bytes lost as the read buffer was full
+        uint32_t tx_full;           // writes which didn't all fit in the write buffer
+        uint32_t tx_dropped;        // bytes those writes couldn't queue
+        uint16_t rx_max_used;       // most bytes waiting in the read buffer
+        uint16_t tx_max_used;       // most bytes waiting in the write buffer
+        // time from write() until a byte is handed to the device,
+        // sampled one byte at a time
+        uint32_t tx_latency_avg_us;
+        uint32_t tx_latency_max_us;
+    };
+
+    virtual bool get_stats(UARTStats &stats) { return false; }
 };
@@ -10,37 +10,6 @@
 #include <time.h>
 #endif
 
-/* Helper class implements AP_HAL::Print so we can use utility/vprintf */
-class BufferPrinter : public AP_HAL::BetterStream {
-public:
-    BufferPrinter(char* str, size_t size)  : _offs(0), _str(str), _size(size)  {}
-
-    size_t write(uint8_t c) override {
-        if (_offs < _size) {
-            _str[_offs] = c;
-            _offs++;
-            return 1;
-        } else {
-            return 0;
-        }
-    }
-    size_t write(const uint8_t *buffer, size_t size) override {
-        size_t n = 0;
-        while (size--) {
-            n += write(*buffer++);
-        }
-        return n;
-    }
-
-    size_t _offs;
-    char* const  _str;
-    const size_t _size;
-
-    uint32_t available() override { return 0; }
-    int16_t read() override { return -1; }
-    uint32_t txspace() override { return 0; }
-};
-
 int AP_HAL::Util::snprintf(char* str, size_t size, const char *format, ...)
 {
     va_list ap;
@@ -55,11 +24,11 @@ int AP_HAL::Util::vsnprintf(char* str, size_t size, const char *format, va_list
     if (size == 0) {
         return 0;
     }
-    BufferPrinter buf(str, size-1);
-    print_vprintf(&buf, format, ap);
-    // null terminate
-    int ret = buf._offs;
-    buf.write(0);
+    // return the length written, not the length there would have been
+    const int ret = print_vsnprintf(str, size, format, ap);
+    if (ret >= (int)size) {
+        return size-1;
+    }
     return ret;
 }
 
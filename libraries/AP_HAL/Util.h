@@ -96,6 +96,13 @@ public:
     virtual void perf_end(perf_counter_t h) {}
     virtual void perf_count(perf_counter_t h) {}
 
+    /*
+      write the events recorded by the perf counters to path as a
+      Chrome trace, which Perfetto and chrome://tracing load. Returns
+      false if the HAL doesn't trace or nothing was recorded
+     */
+    virtual bool perf_trace_dump(const char *path) { return false; }
+
     // allocate and free DMA-capable memory if possible. Otherwise return normal memory
     enum Memory_Type {
         MEM_DMA_SAFE,
@@ -115,11 +122,48 @@ public:
      */
     virtual uint32_t available_memory(void) { return 4096; }
 
+    /**
+       how much free DMA-capable memory do we have in bytes. Boards
+       where all memory is DMA-capable return available_memory()
+     */
+    virtual uint32_t available_memory_dma(void) { return available_memory(); }
+
+    /*
+      get the size, free space and board specific flags of memory
+      region i. Returns false past the last region, or if the board
+      doesn't have separate regions
+     */
+    virtual bool memory_region_info(uint8_t i, uint32_t &size, uint32_t &available, uint8_t &flags) { return false; }
+
     /*
       initialise (or re-initialise) filesystem storage
      */
     virtual bool fs_init(void) { return false; }
 
+    /*
+      statistics of a DMA stream shared between peripherals, since boot
+     */
+    static const uint8_t DMA_WAIT_BUCKETS = 8;
+    struct DMAStats {
+        uint8_t controller;     // DMA controller, from 1
+        uint8_t stream;         // stream on that controller
+        uint8_t owners;         // number of drivers which have locked it
+        uint32_t locks;
+        uint32_t contended;     // locks which found another driver holding it
+        uint32_t handovers;     // times the stream was taken from another driver
+        uint32_t hold_avg_us;
+        uint32_t hold_max_us;
+        // locks by time waited: bucket i is less than 16<<i us, the
+        // last bucket is anything longer
+        uint32_t wait_hist[DMA_WAIT_BUCKETS];
+    };
+
+    /*
+      get the statistics of the idx'th shared DMA stream which has
+      been used. Returns false if there is no such stream
+     */
+    virtual bool get_dma_stats(uint8_t idx, DMAStats &stats) { return false; }
+
 protected:
     // we start soft_armed false, so that actuators don't send any
     // values until the vehicle code has fully started
@@ -0,0 +1,76 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/print_vprintf.h>
+#include <AP_HAL/utility/tests/TestUART.h>
+
+/*
+  formatting of the sort done for STATUSTEXT, the OSD and the console,
+  into a string and to a stream. The test UART discards what is
+  written, so the stream ones measure the formatting and the calls
+  into the stream
+ */
+
+static TestUART uart;
+
+static int bench_snprintf(char *str, size_t size, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    const int ret = print_vsnprintf(str, size, fmt, ap);
+    va_end(ap);
+    return ret;
+}
+
+static void bench_printf(AP_HAL::BetterStream *s, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    print_vprintf(s, fmt, ap);
+    va_end(ap);
+}
+
+static void BM_StatusText(benchmark::State& state)
+{
+    char buf[50];
+    while (state.KeepRunning()) {
+        bench_snprintf(buf, sizeof(buf), "EKF2 IMU%u is using GPS", 1U);
+        gbenchmark_escape(buf);
+    }
+}
+
+static void BM_OSDFloat(benchmark::State& state)
+{
+    char buf[16];
+    float v = 12.3f;
+    while (state.KeepRunning()) {
+        bench_snprintf(buf, sizeof(buf), "%5.1f", v);
+        gbenchmark_escape(buf);
+        v += 0.01f;
+    }
+}
+
+static void BM_FloatPrec6(benchmark::State& state)
+{
+    char buf[32];
+    float v = -35.123456f;
+    while (state.KeepRunning()) {
+        bench_snprintf(buf, sizeof(buf), "%f", v);
+        gbenchmark_escape(buf);
+        v += 0.001f;
+    }
+}
+
+static void BM_ConsoleLine(benchmark::State& state)
+{
+    while (state.KeepRunning()) {
+        bench_printf(&uart, "Init %s: %u sensors, %.2f volts\n", "ArduCopter", 3U, 4.95f);
+    }
+}
+
+BENCHMARK(BM_StatusText);
+BENCHMARK(BM_OSDFloat);
+BENCHMARK(BM_FloatPrec6);
+BENCHMARK(BM_ConsoleLine);
+
+BENCHMARK_MAIN()
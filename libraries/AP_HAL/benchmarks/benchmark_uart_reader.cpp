@@ -0,0 +1,122 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/UARTReader.h>
+#include <AP_HAL/utility/tests/TestUART.h>
+
+/*
+  the framing of the serial rangefinder and proximity drivers, on a
+  stream of frames with some junk between them. The PerByte benchmarks
+  gather frames a uart->read() at a time, the way the drivers used to;
+  the Reader ones do it through UARTReader, the way they do now. The
+  test UART's read() is cheaper than a HAL's, which takes a lock for
+  each byte, so this understates the difference on a board
+ */
+
+static TestUART uart;
+
+#define NUM_FRAMES 32
+
+// fill buf with NUM_FRAMES frames of len bytes starting with the two
+// bytes of header, each after a couple of junk bytes
+static uint32_t make_stream(uint8_t *buf, uint8_t len, const uint8_t *header)
+{
+    uint32_t ofs = 0;
+    for (uint8_t i=0; i<NUM_FRAMES; i++) {
+        buf[ofs++] = 0x00;
+        buf[ofs++] = header[0];
+        buf[ofs++] = header[0];
+        buf[ofs++] = header[1];
+        for (uint8_t j=2; j<len; j++) {
+            buf[ofs++] = i + j;
+        }
+    }
+    return ofs;
+}
+
+static void run_per_byte(benchmark::State& state, uint8_t frame_len, const uint8_t *header)
+{
+    uint8_t stream[NUM_FRAMES*(64+2)];
+    const uint32_t len = make_stream(stream, frame_len, header);
+    uint8_t frame[64];
+    uint8_t frame_ofs = 0;
+    uint64_t bytes = 0;
+    uint32_t frames = 0;
+    while (state.KeepRunning()) {
+        uart.set_data(stream, len);
+        uint32_t nbytes = uart.available();
+        while (nbytes-- > 0) {
+            const uint8_t c = uart.read();
+            if (frame_ofs < 2 && c != header[frame_ofs]) {
+                frame_ofs = (c == header[0]) ? 1 : 0;
+                continue;
+            }
+            frame[frame_ofs++] = c;
+            if (frame_ofs == frame_len) {
+                frame_ofs = 0;
+                frames++;
+            }
+        }
+        gbenchmark_escape(frame);
+        bytes += len;
+    }
+    gbenchmark_escape(&frames);
+    state.SetBytesProcessed(bytes);
+}
+
+static void run_reader(benchmark::State& state, uint8_t frame_len, const uint8_t *header)
+{
+    uint8_t stream[NUM_FRAMES*(64+2)];
+    const uint32_t len = make_stream(stream, frame_len, header);
+    UARTReader reader;
+    uint8_t frame[64];
+    uint8_t frame_ofs = 0;
+    uint64_t bytes = 0;
+    uint32_t frames = 0;
+    while (state.KeepRunning()) {
+        uart.set_data(stream, len);
+        uint32_t nbytes = uart.available();
+        while (reader.fill(&uart, nbytes)) {
+            while (reader.get_frame(frame, frame_ofs, frame_len, header, 2)) {
+                frame_ofs = 0;
+                frames++;
+            }
+        }
+        gbenchmark_escape(frame);
+        bytes += len;
+    }
+    gbenchmark_escape(&frames);
+    state.SetBytesProcessed(bytes);
+}
+
+// Benewake TFmini and TF02
+static const uint8_t benewake_header[] { 0x59, 0x59 };
+// TeraRanger Tower
+static const uint8_t teraranger_header[] { 'T', 'H' };
+
+static void BM_BenewakePerByte(benchmark::State& state)
+{
+    run_per_byte(state, 9, benewake_header);
+}
+
+static void BM_BenewakeReader(benchmark::State& state)
+{
+    run_reader(state, 9, benewake_header);
+}
+
+static void BM_TeraRangerPerByte(benchmark::State& state)
+{
+    run_per_byte(state, 19, teraranger_header);
+}
+
+static void BM_TeraRangerReader(benchmark::State& state)
+{
+    run_reader(state, 19, teraranger_header);
+}
+
+BENCHMARK(BM_BenewakePerByte);
+BENCHMARK(BM_BenewakeReader);
+BENCHMARK(BM_TeraRangerPerByte);
+BENCHMARK(BM_TeraRangerReader);
+
+BENCHMARK_MAIN()
@@ -18,13 +18,26 @@ void AP_HAL::BetterStream::vprintf(const char *fmt, va_list ap)
 size_t AP_HAL::BetterStream::write(const uint8_t *buffer, size_t size)
 {
     for (size_t i=0; i<size;i++) {
-        if (write(buffer[i] == 0)) {
+        if (write(buffer[i]) == 0) {
             return i;
         }
     };
     return size;
 }
 
+ssize_t AP_HAL::BetterStream::read(uint8_t *buffer, uint16_t count)
+{
+    uint16_t offset = 0;
+    while (offset < count) {
+        const int16_t c = read();
+        if (c == -1) {
+            break;
+        }
+        buffer[offset++] = (uint8_t)c;
+    }
+    return offset;
+}
+
 size_t AP_HAL::BetterStream::write(const char *str)
 {
     return write((const uint8_t *)str, strlen(str));
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <stdarg.h>
+#include <sys/types.h>
 
 #include <AP_Common/AP_Common.h>
 #include <AP_HAL/AP_HAL_Namespace.h>
@@ -43,6 +44,11 @@ public:
      * -1 if nothing available, uint8_t value otherwise. */
     virtual int16_t read() = 0;
 
+    /* read up to count bytes into buffer, returning the number read,
+     * which may be zero, or -1 on error. Drivers should override this
+     * with a single copy from their buffer */
+    virtual ssize_t read(uint8_t *buffer, uint16_t count);
+
     /* NB txspace was traditionally a member of BetterStream in the
      * FastSerial library. As far as concerns go, it belongs with available() */
     virtual uint32_t txspace() = 0;
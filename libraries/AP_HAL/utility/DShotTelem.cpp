@@ -0,0 +1,140 @@
+#include "DShotTelem.h"
+
+// 5 bit GCR codes for each 4 bit value
+static const uint8_t gcr_encode[16] = {
+    0x19, 0x1B, 0x12, 0x13, 0x1D, 0x15, 0x16, 0x17,
+    0x1A, 0x09, 0x0A, 0x0B, 0x1E, 0x0D, 0x0E, 0x0F
+};
+
+static const uint8_t frame_bits = 21;
+
+static int8_t gcr_decode(uint8_t code)
+{
+    for (uint8_t i=0; i<16; i++) {
+        if (gcr_encode[i] == code) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool DShotTelem::decode_frame(uint32_t levels, uint32_t &erpm)
+{
+    if (levels & (1U<<(frame_bits-1))) {
+        // no start bit
+        return false;
+    }
+    // each change of level is a 1
+    const uint32_t gcr = (levels ^ (levels >> 1)) & 0xFFFFF;
+
+    uint16_t value = 0;
+    for (uint8_t i=0; i<4; i++) {
+        const int8_t nibble = gcr_decode((gcr >> (15 - 5*i)) & 0x1F);
+        if (nibble < 0) {
+            return false;
+        }
+        value = (value << 4) | nibble;
+    }
+
+    const uint16_t csum = value ^ (value >> 4) ^ (value >> 8) ^ (value >> 12);
+    if ((csum & 0xF) != 0xF) {
+        return false;
+    }
+
+    const uint16_t packed = value >> 4;
+    if (packed == period_stopped) {
+        erpm = 0;
+        return true;
+    }
+    const uint32_t period_us = uint32_t(packed & 0x1FF) << (packed >> 9);
+    if (period_us == 0) {
+        return false;
+    }
+    erpm = (60000000UL + period_us/2) / period_us;
+    return true;
+}
+
+bool DShotTelem::decode_samples(const uint16_t *samples, uint16_t count, uint16_t pin_mask,
+                                uint32_t samples_per_bit_x256, uint32_t &erpm)
+{
+    if (samples_per_bit_x256 == 0) {
+        return false;
+    }
+
+    // the reply starts at the first low sample
+    uint16_t start = 0;
+    while (start < count && (samples[start] & pin_mask)) {
+        start++;
+    }
+    if (start == count) {
+        return false;
+    }
+
+    uint32_t levels = 0;
+    uint8_t nbits = 0;
+    bool level = false;
+    for (uint16_t i=start+1; i<=count && nbits < frame_bits; i++) {
+        if (i < count && bool(samples[i] & pin_mask) == level) {
+            continue;
+        }
+        // a run of one level has ended, round it to a number of bits
+        const uint32_t run = i - start;
+        uint32_t n = (run * 256 + samples_per_bit_x256/2) / samples_per_bit_x256;
+        if (n == 0) {
+            n = 1;
+        }
+        if (n > uint32_t(frame_bits - nbits)) {
+            n = frame_bits - nbits;
+        }
+        levels <<= n;
+        if (level) {
+            levels |= (1U<<n) - 1;
+        }
+        nbits += n;
+        level = !level;
+        start = i;
+    }
+
+    // the frame can end with the line back at its idle high level
+    while (nbits < frame_bits) {
+        levels = (levels << 1) | 1;
+        nbits++;
+    }
+
+    return decode_frame(levels, erpm);
+}
+
+uint32_t DShotTelem::encode_frame(uint32_t erpm)
+{
+    uint16_t packed = period_stopped;
+    uint32_t period_us = erpm == 0 ? 0 : (60000000UL + erpm/2) / erpm;
+    // too slow to send is sent as stopped
+    if (period_us != 0 && period_us <= (0x1FFU << 7)) {
+        uint8_t shift = 0;
+        while (period_us > 0x1FF) {
+            period_us >>= 1;
+            shift++;
+        }
+        packed = (shift << 9) | (period_us & 0x1FF);
+    }
+    const uint16_t csum = ~(packed ^ (packed >> 4) ^ (packed >> 8)) & 0xF;
+    const uint16_t value = (packed << 4) | csum;
+
+    uint32_t gcr = 0;
+    for (uint8_t i=0; i<4; i++) {
+        gcr = (gcr << 5) | gcr_encode[(value >> (12 - 4*i)) & 0xF];
+    }
+
+    // the start bit is a change from the idle high level, then each
+    // 1 is a change of level
+    gcr |= 1U<<20;
+    uint32_t levels = 0;
+    bool level = true;
+    for (int8_t i=frame_bits-1; i>=0; i--) {
+        if (gcr & (1U<<i)) {
+            level = !level;
+        }
+        levels = (levels << 1) | (level ? 1 : 0);
+    }
+    return levels;
+}
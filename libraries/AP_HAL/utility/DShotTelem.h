@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+  decoding of bidirectional DShot replies.
+
+  With bidirectional DShot the outputs idle high and the ESC answers
+  each command frame on the same wire about 30us later, at 5/4 of the
+  command bit rate. The reply is 21 bits: a low start bit, then 20
+  bits of GCR (4 bits sent as 5) where a 1 is a change of level and a
+  0 is no change. The 16 bits underneath are a 12 bit eRPM period,
+  as a 9 bit mantissa shifted by a 3 bit exponent, in microseconds per
+  electrical revolution, and an inverted 4 bit checksum.
+ */
+class DShotTelem {
+public:
+    // a period of 0xFFF is sent for a stopped motor
+    static const uint16_t period_stopped = 0xFFF;
+
+    /*
+      decode the 21 line levels of a reply, start bit first in bit 20,
+      into an eRPM. Returns false on a bad GCR code or checksum
+     */
+    static bool decode_frame(uint32_t levels, uint32_t &erpm);
+
+    /*
+      decode a reply from count samples of a GPIO input register,
+      looking at the pin given by pin_mask. samples_per_bit_x256 is
+      the number of samples per reply bit, times 256
+     */
+    static bool decode_samples(const uint16_t *samples, uint16_t count, uint16_t pin_mask,
+                               uint32_t samples_per_bit_x256, uint32_t &erpm);
+
+    // encode an eRPM as the reply line levels, as an ESC would
+    static uint32_t encode_frame(uint32_t erpm);
+
+    // true RPM from eRPM for a motor with the given number of poles
+    static uint32_t erpm_to_rpm(uint32_t erpm, uint8_t poles) {
+        return poles < 2 ? erpm : erpm * 2 / poles;
+    }
+};
@@ -0,0 +1,92 @@
+#include <AP_HAL/AP_HAL.h>
+
+#include "PerfTrace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if HAL_OS_POSIX_IO || HAL_OS_FATFS_IO
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+int16_t PerfTrace::add(const char *name)
+{
+    if (HAL_PERF_TRACE_EVENTS == 0) {
+        return -1;
+    }
+    // counters are allocated as drivers start, which only happens on
+    // one thread at a time
+    if (_events == nullptr) {
+        _events = (Entry *)calloc(HAL_PERF_TRACE_EVENTS, sizeof(Entry));
+        if (_events == nullptr) {
+            return -1;
+        }
+    }
+    if (_num_names >= HAL_PERF_TRACE_MAX_COUNTERS) {
+        return -1;
+    }
+    _names[_num_names] = name;
+    return _num_names++;
+}
+
+void PerfTrace::record(uint16_t id, Event event, uint16_t thread)
+{
+    if (_events == nullptr || id >= _num_names) {
+        return;
+    }
+    const uint32_t idx = __atomic_fetch_add(&_next, 1, __ATOMIC_RELAXED);
+    Entry &e = _events[idx % HAL_PERF_TRACE_EVENTS];
+    e.time_us = AP_HAL::micros();
+    e.thread = thread;
+    e.id_event = id | (uint16_t(event) << 14);
+}
+
+bool PerfTrace::write_chrome_trace(const char *path)
+{
+#if HAL_OS_POSIX_IO || HAL_OS_FATFS_IO
+    const uint32_t next = __atomic_load_n(&_next, __ATOMIC_RELAXED);
+    if (_events == nullptr || next == 0) {
+        return false;
+    }
+
+    int fd = ::open(path, O_WRONLY|O_CREAT|O_TRUNC, 0644);
+    if (fd == -1) {
+        return false;
+    }
+
+    // events still being recorded may overwrite the oldest ones as
+    // we go, which at worst shows a few of them out of place
+    const uint32_t count = next < HAL_PERF_TRACE_EVENTS ? next : HAL_PERF_TRACE_EVENTS;
+    static const char *phases[] = { "B", "E", "i" };
+    char line[128];
+    bool ok = ::write(fd, "{\"traceEvents\":[\n", 17) == 17;
+    bool first = true;
+
+    for (uint32_t i = 0; i < count && ok; i++) {
+        const Entry e = _events[(next - count + i) % HAL_PERF_TRACE_EVENTS];
+        const uint16_t id = e.id_event & 0x3FFF;
+        const uint8_t event = e.id_event >> 14;
+        if (id >= _num_names || event > uint8_t(Event::COUNT)) {
+            continue;
+        }
+        int n = snprintf(line, sizeof(line),
+                         "%s{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%u,\"pid\":1,\"tid\":%u%s}\n",
+                         first ? "" : ",",
+                         _names[id], phases[event],
+                         (unsigned)e.time_us, (unsigned)e.thread,
+                         event == uint8_t(Event::COUNT) ? ",\"s\":\"t\"" : "");
+        if (n <= 0 || n >= (int)sizeof(line)) {
+            continue;
+        }
+        ok = ::write(fd, line, n) == n;
+        first = false;
+    }
+
+    ok = ok && ::write(fd, "]}\n", 3) == 3;
+    ::close(fd);
+    return ok;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <AP_HAL/AP_HAL_Boards.h>
+
+/*
+  number of perf counter events kept in RAM, 8 bytes each. Zero
+  disables tracing
+ */
+#ifndef HAL_PERF_TRACE_EVENTS
+#if HAL_MINIMIZE_FEATURES
+#define HAL_PERF_TRACE_EVENTS 0
+#elif CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+#define HAL_PERF_TRACE_EVENTS 1024
+#else
+#define HAL_PERF_TRACE_EVENTS 16384
+#endif
+#endif
+
+#ifndef HAL_PERF_TRACE_MAX_COUNTERS
+#define HAL_PERF_TRACE_MAX_COUNTERS 128
+#endif
+
+/*
+  a ring of timestamped perf counter events, for HALs to record
+  perf_begin(), perf_end() and perf_count() calls into.
+
+  Recording takes a timestamp and one atomic add, and never blocks,
+  so it is safe from any thread. Once the ring is full the oldest
+  events are overwritten. The events can be written out as a Chrome
+  trace, in the JSON format which Perfetto and chrome://tracing load,
+  to see what ran when on each thread.
+ */
+class PerfTrace {
+public:
+    enum class Event : uint8_t {
+        BEGIN = 0,
+        END = 1,
+        COUNT = 2,
+    };
+
+    // name must stay valid. Returns the counter's id, or -1 if there
+    // is no room for another counter
+    int16_t add(const char *name);
+
+    // record an event of the counter id. thread is any number which
+    // tells the threads of the process apart
+    void record(uint16_t id, Event event, uint16_t thread);
+
+    /*
+      write the recorded events to path as a Chrome trace. Returns
+      false if there are none, or the file can't be written
+     */
+    bool write_chrome_trace(const char *path);
+
+private:
+    struct Entry {
+        uint32_t time_us;
+        uint16_t thread;
+        // the counter id in the low 14 bits, the event above it
+        uint16_t id_event;
+    };
+
+    static_assert(HAL_PERF_TRACE_MAX_COUNTERS <= (1U<<14), "too many trace counters");
+
+    // allocated on first use, so boards which never trace pay nothing
+    Entry *_events = nullptr;
+    const char *_names[HAL_PERF_TRACE_MAX_COUNTERS] {};
+    uint16_t _num_names = 0;
+
+    // count of events ever recorded
+    uint32_t _next = 0;
+};
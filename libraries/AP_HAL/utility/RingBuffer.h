@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <stdint.h>
+#include <string.h>
 
 /*
  * Circular buffer of bytes.
@@ -223,6 +224,224 @@ private:
 
 
 
+#ifndef RINGBUFFER_CACHE_LINE_SIZE
+#define RINGBUFFER_CACHE_LINE_SIZE 64
+#endif
+
+/*
+  lock-free ring buffer class for objects of fixed size with exactly
+  one producer thread and one consumer thread.
+
+  The read and write indexes live on separate cache lines and each
+  side keeps a cached copy of the other side's index, so the shared
+  atomics are only touched when the cached value says the buffer
+  looks full (producer) or empty (consumer). The capacity is rounded
+  up to a power of two so wrapping is a mask.
+
+  Besides the ObjectBuffer-style push()/pop() interface the producer
+  can reserve() a contiguous run of slots, fill them in place and
+  commit() them in one step, and the consumer can look at the front
+  object in place with peek_ptr()
+ */
+template <class T>
+class ObjectBufferSPSC {
+public:
+    ObjectBufferSPSC(uint32_t _size) {
+        uint32_t n = 1;
+        while (n < _size) {
+            n <<= 1;
+        }
+        buffer = new T[n];
+        mask = buffer != nullptr ? n - 1 : 0;
+    }
+    ~ObjectBufferSPSC(void) {
+        delete[] buffer;
+    }
+
+    /* Do not allow copies */
+    ObjectBufferSPSC(const ObjectBufferSPSC &other) = delete;
+    ObjectBufferSPSC &operator=(const ObjectBufferSPSC&) = delete;
+
+    // return total number of objects the buffer can hold
+    uint32_t get_size(void) const {
+        return buffer != nullptr ? mask + 1 : 0;
+    }
+
+    // Discards the buffer content, emptying it. Must only be called
+    // from the consumer
+    void clear(void) {
+        const uint32_t t = tail.load(std::memory_order_acquire);
+        cached_tail = t;
+        head.store(t, std::memory_order_release);
+    }
+
+    // return number of objects available to be read
+    uint32_t available(void) const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    // return number of objects that could be written
+    uint32_t space(void) const {
+        return get_size() - available();
+    }
+
+    // true is available() == 0
+    bool empty(void) const {
+        return available() == 0;
+    }
+
+    // push one object. Producer only
+    bool push(const T &object) {
+        T *ptr;
+        if (reserve(ptr, 1) == 0) {
+            return false;
+        }
+        *ptr = object;
+        commit(1);
+        return true;
+    }
+
+    // push N objects, all or nothing. Producer only
+    bool push(const T *object, uint32_t n) {
+        if (producer_space() < n) {
+            return false;
+        }
+        while (n > 0) {
+            T *ptr;
+            const uint32_t chunk = reserve(ptr, n);
+            memcpy((void *)ptr, (const void *)object, chunk * sizeof(T));
+            commit(chunk);
+            object += chunk;
+            n -= chunk;
+        }
+        return true;
+    }
+
+    /*
+      reserve up to n contiguous slots for writing in place. Returns
+      the number of slots reserved, which may be less than n when the
+      buffer is nearly full or the slots would wrap. The slots become
+      visible to the consumer on commit(). Producer only
+     */
+    uint32_t reserve(T *&ptr, uint32_t n) {
+        const uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t free = get_size() - (t - cached_head);
+        if (free < n) {
+            cached_head = head.load(std::memory_order_acquire);
+            free = get_size() - (t - cached_head);
+        }
+        const uint32_t idx = t & mask;
+        const uint32_t contiguous = get_size() - idx;
+        n = MIN_U32(n, MIN_U32(free, contiguous));
+        ptr = n > 0 ? &buffer[idx] : nullptr;
+        return n;
+    }
+
+    // publish n slots previously filled after reserve(). Producer only
+    void commit(uint32_t n) {
+        tail.store(tail.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    /*
+      throw away an object. Consumer only
+     */
+    bool pop(void) {
+        return advance(1);
+    }
+
+    /*
+      pop earliest object off the queue. Consumer only
+     */
+    bool pop(T &object) {
+        const T *ptr = peek_ptr();
+        if (ptr == nullptr) {
+            return false;
+        }
+        object = *ptr;
+        return advance(1);
+    }
+
+    /*
+      peek copies an object out without advancing the read
+      pointer. Consumer only
+     */
+    bool peek(T &object) {
+        const T *ptr = peek_ptr();
+        if (ptr == nullptr) {
+            return false;
+        }
+        object = *ptr;
+        return true;
+    }
+
+    /*
+      return a pointer to the object at the front of the queue
+      without copying it, or nullptr if empty. The object stays valid
+      until the consumer advances past it. Consumer only
+     */
+    const T *peek_ptr(void) {
+        uint32_t n;
+        return readptr(n);
+    }
+
+    /*
+      return a pointer to first contiguous array of available
+      objects. Return nullptr if none available. Consumer only
+     */
+    const T *readptr(uint32_t &n) {
+        const uint32_t h = head.load(std::memory_order_relaxed);
+        if (cached_tail == h) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (cached_tail == h) {
+                return nullptr;
+            }
+        }
+        const uint32_t idx = h & mask;
+        n = MIN_U32(cached_tail - h, get_size() - idx);
+        return &buffer[idx];
+    }
+
+    // advance the read pointer (discarding objects). Consumer only
+    bool advance(uint32_t n) {
+        const uint32_t h = head.load(std::memory_order_relaxed);
+        if (cached_tail - h < n) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (cached_tail - h < n) {
+                return false;
+            }
+        }
+        head.store(h + n, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static uint32_t MIN_U32(uint32_t a, uint32_t b) {
+        return a < b ? a : b;
+    }
+
+    // free space as seen by the producer
+    uint32_t producer_space(void) {
+        cached_head = head.load(std::memory_order_acquire);
+        return get_size() - (tail.load(std::memory_order_relaxed) - cached_head);
+    }
+
+    T *buffer;
+    uint32_t mask;
+
+    // written by the consumer. Indexes are free-running counts, the
+    // slot is index & mask
+    alignas(RINGBUFFER_CACHE_LINE_SIZE) std::atomic<uint32_t> head{0};
+    // consumer's copy of tail
+    uint32_t cached_tail = 0;
+
+    // written by the producer
+    alignas(RINGBUFFER_CACHE_LINE_SIZE) std::atomic<uint32_t> tail{0};
+    // producer's copy of head
+    uint32_t cached_head = 0;
+};
+
+
+
 /*
   ring buffer class for objects of fixed size with pointer
   access. Note that this is not thread safe, buf offers efficient
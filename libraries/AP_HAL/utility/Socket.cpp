@@ -138,6 +138,29 @@ ssize_t SocketAPM::sendto(const void *buf, size_t size, const char *address, uin
     return ::sendto(fd, buf, size, 0, (struct sockaddr *)&sockaddr, sizeof(sockaddr));
 }
 
+/*
+  send some data gathered from several buffers
+ */
+ssize_t SocketAPM::sendv(const struct iovec *iov, int count)
+{
+    struct msghdr msg {};
+    msg.msg_iov = const_cast<struct iovec *>(iov);
+    msg.msg_iovlen = count;
+    return ::sendmsg(fd, &msg, 0);
+}
+
+ssize_t SocketAPM::sendtov(const struct iovec *iov, int count, const char *address, uint16_t port)
+{
+    struct sockaddr_in sockaddr;
+    make_sockaddr(address, port, sockaddr);
+    struct msghdr msg {};
+    msg.msg_name = &sockaddr;
+    msg.msg_namelen = sizeof(sockaddr);
+    msg.msg_iov = const_cast<struct iovec *>(iov);
+    msg.msg_iovlen = count;
+    return ::sendmsg(fd, &msg, 0);
+}
+
 /*
   receive some data
  */
@@ -150,6 +173,58 @@ ssize_t SocketAPM::recv(void *buf, size_t size, uint32_t timeout_ms)
     return ::recvfrom(fd, buf, size, MSG_DONTWAIT, (sockaddr *)&in_addr, &len);
 }
 
+/*
+  turn on SO_TIMESTAMP, for recv_timestamped()
+ */
+bool SocketAPM::set_timestamping(void)
+{
+#ifdef SO_TIMESTAMP
+    int one = 1;
+    return (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMP, &one, sizeof(one)) != -1);
+#else
+    return false;
+#endif
+}
+
+/*
+  receive some data with the time the kernel received it
+ */
+ssize_t SocketAPM::recv_timestamped(void *buf, size_t size, uint32_t timeout_ms, uint64_t &timestamp_us)
+{
+    timestamp_us = 0;
+    if (!pollin(timeout_ms)) {
+        return -1;
+    }
+    struct iovec iov;
+    iov.iov_base = buf;
+    iov.iov_len = size;
+    union {
+        struct cmsghdr align;
+        uint8_t space[CMSG_SPACE(sizeof(struct timeval))];
+    } control;
+    struct msghdr msg {};
+    msg.msg_name = &in_addr;
+    msg.msg_namelen = sizeof(in_addr);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.space;
+    msg.msg_controllen = sizeof(control.space);
+    const ssize_t ret = ::recvmsg(fd, &msg, MSG_DONTWAIT);
+    if (ret < 0) {
+        return ret;
+    }
+#ifdef SO_TIMESTAMP
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMP) {
+            struct timeval tv;
+            memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+            timestamp_us = tv.tv_sec * 1000000ULL + tv.tv_usec;
+        }
+    }
+#endif
+    return ret;
+}
+
 /*
   return the IP address and port of the last received packet
  */
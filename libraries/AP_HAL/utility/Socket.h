@@ -24,6 +24,7 @@
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
@@ -44,8 +45,19 @@ public:
 
     ssize_t send(const void *pkt, size_t size);
     ssize_t sendto(const void *buf, size_t size, const char *address, uint16_t port);
+
+    // send count buffers as one packet, or one write on a stream
+    ssize_t sendv(const struct iovec *iov, int count);
+    ssize_t sendtov(const struct iovec *iov, int count, const char *address, uint16_t port);
     ssize_t recv(void *pkt, size_t size, uint32_t timeout_ms);
 
+    // ask the kernel to timestamp received packets
+    bool set_timestamping(void);
+
+    // as recv(), also returning when the kernel received the packet in
+    // CLOCK_REALTIME microseconds, or zero if it wasn't timestamped
+    ssize_t recv_timestamped(void *pkt, size_t size, uint32_t timeout_ms, uint64_t &timestamp_us);
+
     // return the IP address and port of the last received packet
     void last_recv_address(const char *&ip_addr, uint16_t &port);
 
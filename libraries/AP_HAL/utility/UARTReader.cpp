@@ -0,0 +1,78 @@
+#include <AP_HAL/AP_HAL.h>
+
+#include "UARTReader.h"
+
+#include <string.h>
+
+bool UARTReader::fill(AP_HAL::UARTDriver *uart, uint32_t &nbytes)
+{
+    if (remaining() > 0) {
+        return true;
+    }
+    _len = _ofs = 0;
+    if (uart == nullptr || nbytes == 0) {
+        return false;
+    }
+    uint16_t len = sizeof(_buf);
+    if (nbytes < len) {
+        len = nbytes;
+    }
+    const ssize_t n = uart->read(_buf, len);
+    if (n <= 0) {
+        nbytes = 0;
+        return false;
+    }
+    _len = n;
+    nbytes -= n;
+    return true;
+}
+
+bool UARTReader::skip_to(uint8_t c)
+{
+    const uint8_t *p = (const uint8_t *)memchr(ptr(), c, remaining());
+    if (p == nullptr) {
+        _ofs = _len;
+        return false;
+    }
+    _ofs = p - _buf;
+    return true;
+}
+
+bool UARTReader::get_frame(uint8_t *frame, uint8_t &len, uint8_t frame_len,
+                           const uint8_t *header, uint8_t header_len)
+{
+    while (remaining() > 0) {
+        if (len == 0) {
+            if (!skip_to(header[0])) {
+                return false;
+            }
+            frame[len++] = byte();
+            continue;
+        }
+        if (len < header_len) {
+            const uint8_t c = byte();
+            if (c == header[len]) {
+                frame[len++] = c;
+            } else {
+                // start again, from this byte if it could begin a header
+                len = 0;
+                if (c == header[0]) {
+                    frame[len++] = c;
+                }
+            }
+            continue;
+        }
+        // the header is in, so copy as much of the rest as there is
+        uint16_t n = frame_len - len;
+        if (n > remaining()) {
+            n = remaining();
+        }
+        memcpy(&frame[len], ptr(), n);
+        skip(n);
+        len += n;
+        if (len == frame_len) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <AP_HAL/AP_HAL_Namespace.h>
+#include <AP_HAL/UARTDriver.h>
+
+#ifndef UART_READER_BLOCK_SIZE
+#define UART_READER_BLOCK_SIZE 64
+#endif
+
+/*
+  bulk reading of a UART for the drivers of serial sensors. Rather
+  than calling uart->read() for each byte, a driver calls fill() to
+  read a block of bytes, then consumes all of them with the functions
+  below, or by gathering frames from them with get_frame(), before
+  filling it again. Bytes not consumed in one call of the driver are
+  kept for the next
+ */
+class UARTReader {
+public:
+    /*
+      read a block of the bytes waiting on uart, once the last block
+      has been consumed. nbytes is how many more bytes the driver
+      wants to read this call, normally available() to start with, and
+      is reduced by the number read. Returns false once there is
+      nothing left to consume
+     */
+    bool fill(AP_HAL::UARTDriver *uart, uint32_t &nbytes);
+
+    uint16_t remaining(void) const { return _len - _ofs; }
+    const uint8_t *ptr(void) const { return &_buf[_ofs]; }
+    uint8_t byte(void) { return _buf[_ofs++]; }
+    void skip(uint16_t n) { _ofs += n; }
+
+    // skip to the next c, without consuming it. If there is none the
+    // block is consumed and false returned
+    bool skip_to(uint8_t c);
+
+    /*
+      gather a frame of frame_len bytes starting with the header_len
+      bytes of header into frame, which holds len bytes of it from
+      earlier blocks. Bytes before the header are skipped, and a
+      partial header that doesn't match is dropped. Returns true once
+      the frame is whole, leaving the following bytes unconsumed; the
+      caller checks the frame and sets len to zero for the next one.
+      Returns false once the block is consumed
+     */
+    bool get_frame(uint8_t *frame, uint8_t &len, uint8_t frame_len,
+                   const uint8_t *header, uint8_t header_len);
+
+private:
+    uint8_t _buf[UART_READER_BLOCK_SIZE];
+    uint16_t _len = 0;
+    uint16_t _ofs = 0;
+};
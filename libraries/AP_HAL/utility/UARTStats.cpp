@@ -0,0 +1,58 @@
+#include <AP_HAL/AP_HAL.h>
+
+#include "UARTStats.h"
+
+void UARTStatsKeeper::received(uint32_t len, uint32_t stored, uint32_t used)
+{
+    _stats.rx_bytes += len;
+    _stats.rx_dropped += len - stored;
+    if (used > _stats.rx_max_used) {
+        _stats.rx_max_used = used > UINT16_MAX ? UINT16_MAX : used;
+    }
+}
+
+void UARTStatsKeeper::queued(uint32_t len, uint32_t stored, uint32_t used)
+{
+    if (stored < len) {
+        _stats.tx_full++;
+        _stats.tx_dropped += len - stored;
+    }
+    if (used > _stats.tx_max_used) {
+        _stats.tx_max_used = used > UINT16_MAX ? UINT16_MAX : used;
+    }
+    if (stored == 0) {
+        return;
+    }
+    _queued += stored;
+    if (!_marker_set) {
+        _marker = _queued;
+        _marker_us = AP_HAL::micros();
+        _marker_set = true;
+    }
+}
+
+void UARTStatsKeeper::sent(uint32_t len)
+{
+    _stats.tx_bytes += len;
+    // the difference wraps, so compare it as signed
+    if (!_marker_set || int32_t(_stats.tx_bytes - _marker) < 0) {
+        return;
+    }
+    _marker_set = false;
+    const uint32_t latency_us = AP_HAL::micros() - _marker_us;
+    if (_stats.tx_latency_avg_us == 0) {
+        _stats.tx_latency_avg_us = latency_us;
+    } else {
+        // average over about the last 16 samples
+        _stats.tx_latency_avg_us = (_stats.tx_latency_avg_us * 15 + latency_us) / 16;
+    }
+    if (latency_us > _stats.tx_latency_max_us) {
+        _stats.tx_latency_max_us = latency_us;
+    }
+}
+
+void UARTStatsKeeper::tx_cleared(void)
+{
+    _queued = _stats.tx_bytes;
+    _marker_set = false;
+}
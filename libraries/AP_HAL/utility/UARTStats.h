@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <AP_HAL/AP_HAL_Namespace.h>
+#include <AP_HAL/UARTDriver.h>
+
+/*
+  counts the throughput of a UART driver for get_stats().
+
+  Write latency is sampled with one marked byte at a time: when
+  nothing is marked, the last byte stored by a write() is marked with
+  the time, and when the count of bytes sent reaches it the time taken
+  is added to the average and maximum. This costs a compare per call
+  rather than a timestamp per byte.
+ */
+class UARTStatsKeeper {
+public:
+    // len bytes arrived from the device, of which stored fitted in the
+    // read buffer, leaving used bytes in it
+    void received(uint32_t len, uint32_t stored, uint32_t used);
+
+    // a write() of len bytes stored stored bytes in the write buffer,
+    // leaving used bytes in it
+    void queued(uint32_t len, uint32_t stored, uint32_t used);
+
+    // len bytes from the write buffer were handed to the device
+    void sent(uint32_t len);
+
+    // the write buffer was cleared, so its bytes will never be sent
+    void tx_cleared(void);
+
+    void count_irq(void) { _stats.irqs++; }
+    void count_overrun(void) { _stats.rx_overruns++; }
+
+    const AP_HAL::UARTDriver::UARTStats &get(void) const { return _stats; }
+
+private:
+    AP_HAL::UARTDriver::UARTStats _stats {};
+
+    // bytes ever stored in the write buffer, counted so that the
+    // bytes waiting are _queued - _stats.tx_bytes
+    uint32_t _queued = 0;
+
+    // the marked byte, as a value of _queued, and when it was stored
+    uint32_t _marker = 0;
+    uint32_t _marker_us = 0;
+    bool _marker_set = false;
+};
@@ -227,3 +227,45 @@ int16_t ftoa_engine(float val, char *buf, uint8_t precision, uint8_t maxDecimals
     return exp10;
 }
 
+
+bool ftoa_fixed(float val, uint8_t prec, uint64_t &digits)
+{
+    static const uint32_t pow10[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000
+    };
+    if (prec >= ARRAY_SIZE(pow10)) {
+        return false;
+    }
+
+    union {
+        float v;
+        uint32_t u;
+    } x;
+    x.v = val;
+    const uint8_t exp = (x.u >> 23) & 0xff;
+    if (exp == 0xff) {
+        return false;
+    }
+
+    // |val| is mant * 2^shift exactly, so the scaled value is exact
+    // and rounded once
+    uint64_t mant = x.u & 0x007fffffUL;
+    int16_t shift = -149;
+    if (exp != 0) {
+        mant |= (1UL<<23);
+        shift = exp - 150;
+    }
+    uint64_t scaled = mant * pow10[prec];
+    if (shift >= 0) {
+        if (shift > 8) {
+            return false;
+        }
+        scaled <<= shift;
+    } else if (shift > -64) {
+        scaled = (scaled + (1ULL << (-shift-1))) >> -shift;
+    } else {
+        scaled = 0;
+    }
+    digits = scaled;
+    return true;
+}
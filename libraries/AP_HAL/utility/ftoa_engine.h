@@ -35,6 +35,14 @@
 int16_t ftoa_engine(float val, char *buf,
 		    uint8_t precision, uint8_t maxDecimals);
 
+/*
+  |val| rounded to prec decimal places, as the integer of its digits,
+  for printing with 'f'. Unlike ftoa_engine() all of the digits are
+  exact. Returns false for nan, inf, a precision over 7 or a value of
+  2^32 or more, which are left to ftoa_engine()
+ */
+bool ftoa_fixed(float val, uint8_t prec, uint64_t &digits);
+
 /* '__ftoa_engine' return next flags (in buf[0]):	*/
 #define	FTOA_MINUS	1
 #define	FTOA_ZERO	2
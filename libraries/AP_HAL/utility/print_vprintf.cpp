@@ -66,7 +66,54 @@
 #define FL_FLTEXP   FL_PREC
 #define FL_FLTFIX   FL_LONG
 
-void print_vprintf(AP_HAL::BetterStream *s, const char *fmt, va_list ap)
+/*
+  the characters are gathered and written a block at a time: to the
+  stream when printing to one, saving a virtual write() for each
+  character, or straight into the caller's string. Characters that
+  don't fit in a string are counted but dropped
+ */
+class PrintOutput {
+public:
+    PrintOutput(AP_HAL::BetterStream *s) :
+        _s(s), _buf(_block), _size(sizeof(_block)) {}
+    PrintOutput(char *str, size_t size) :
+        _buf((uint8_t *)str), _size(size) {}
+
+    void write(uint8_t c) {
+        if (_len == _size && !flush()) {
+            _dropped++;
+            return;
+        }
+        _buf[_len++] = c;
+    }
+
+    // write any characters gathered to the stream
+    bool flush() {
+        if (_s == nullptr) {
+            return false;
+        }
+        if (_len > 0) {
+            _s->write(_buf, _len);
+            _len = 0;
+        }
+        return true;
+    }
+
+    // characters in the string, and the number there would have been
+    // if it were big enough
+    size_t length() const { return _len; }
+    size_t total() const { return _len + _dropped; }
+
+private:
+    AP_HAL::BetterStream *_s = nullptr;
+    uint8_t _block[32];
+    uint8_t *_buf;
+    size_t _size;
+    size_t _len = 0;
+    size_t _dropped = 0;
+};
+
+static void print_vprintf_out(PrintOutput &out, const char *fmt, va_list ap)
 {
         unsigned char c;        /* holds a char from the format string */
         uint16_t flags;
@@ -91,9 +138,9 @@ void print_vprintf(AP_HAL::BetterStream *s, const char *fmt, va_list ap)
                 }
                 /* emit cr before lf to make most terminals happy */
                 if (c == '\n') {
-                    s->write('\r');
+                    out.write('\r');
                 }
-                s->write(c);
+                out.write(c);
             }
 
             flags = 0;
@@ -193,6 +240,67 @@ flt_oper:
                     flags = (flags & ~FL_FLTFIX) | FL_FLTEXP;
                 }
 
+                /*
+                 * 'f' is done from the value as an integer of its
+                 * digits, which is faster than ftoa_engine() and gives
+                 * all of the digits asked for rather than eight
+                 */
+                uint64_t fixed;
+                if ((flags & FL_FLTFIX) && ftoa_fixed(value, prec, fixed)) {
+                    sign = 0;
+                    if (std::signbit(value))
+                        sign = '-';
+                    else if (flags & FL_PLUS)
+                        sign = '+';
+                    else if (flags & FL_SPACE)
+                        sign = ' ';
+
+                    /* digits in reverse, at least one before the point */
+                    if (fixed > UINT32_MAX) {
+                        ndigs = ulltoa_invert(fixed, (char *)buf, 10) - (char *)buf;
+                    } else {
+                        ndigs = ultoa_invert(fixed, (char *)buf, 10) - (char *)buf;
+                    }
+                    while (ndigs <= prec) {
+                        buf[ndigs++] = '0';
+                    }
+
+                    n = ndigs;
+                    if (sign) {
+                        n += 1;
+                    }
+                    if (prec) {
+                        n += 1;
+                    }
+                    width = width > n ? width - n : 0;
+
+                    if (!(flags & (FL_LPAD | FL_ZFILL))) {
+                        while (width) {
+                            out.write(' ');
+                            width--;
+                        }
+                    }
+                    if (sign) {
+                        out.write(sign);
+                    }
+                    if (!(flags & FL_LPAD)) {
+                        while (width) {
+                            out.write('0');
+                            width--;
+                        }
+                    }
+                    while (ndigs > prec) {
+                        out.write(buf[--ndigs]);
+                    }
+                    if (prec) {
+                        out.write('.');
+                        while (ndigs) {
+                            out.write(buf[--ndigs]);
+                        }
+                    }
+                    goto tail;
+                }
+
                 if (flags & FL_FLTFIX) {
                     vtype = 7;              /* 'prec' arg for 'ftoa_engine' */
                     ndigs = prec < 60 ? prec + 1 : 60;
@@ -221,14 +329,14 @@ flt_oper:
                         width -= ndigs;
                         if (!(flags & FL_LPAD)) {
                             do {
-                                s->write(' ');
+                                out.write(' ');
                             } while (--width);
                         }
                     } else {
                         width = 0;
                     }
                     if (sign) {
-                        s->write(sign);
+                        out.write(sign);
                     }
 
                     const char *p = "inf";
@@ -237,7 +345,7 @@ flt_oper:
                     while ((ndigs = *p) != 0) {
                         if (flags & FL_FLTUPP)
                             ndigs += 'I' - 'i';
-                        s->write(ndigs);
+                        out.write(ndigs);
                         p++;
                     }
                     goto tail;
@@ -284,16 +392,16 @@ flt_oper:
                 /* Output before first digit    */
                 if (!(flags & (FL_LPAD | FL_ZFILL))) {
                     while (width) {
-                        s->write(' ');
+                        out.write(' ');
                         width--;
                     }
                 }
                 if (sign) {
-                    s->write(sign);
+                    out.write(sign);
                 }
                 if (!(flags & FL_LPAD)) {
                     while (width) {
-                        s->write('0');
+                        out.write('0');
                         width--;
                     }
                 }
@@ -304,14 +412,14 @@ flt_oper:
                     unsigned char v = 0;
                     do {
                         if (n == -1) {
-                            s->write('.');
+                            out.write('.');
                         }
                         v = (n <= exp && n > exp - ndigs)
                             ? buf[exp - n + 1] : '0';
                         if (--n < -prec || v == 0) {
                             break;
                         }
-                        s->write(v);
+                        out.write(v);
                     } while (1);
                     if (n == exp
                         && (buf[1] > '5'
@@ -319,33 +427,33 @@ flt_oper:
                         v = '1';
                     }
                     if (v) {
-                        s->write(v);
+                        out.write(v);
                     }
                 } else {                                /* 'e(E)' format        */
                     /* mantissa     */
                     if (buf[1] != '1')
                         vtype &= ~FTOA_CARRY;
-                    s->write(buf[1]);
+                    out.write(buf[1]);
                     if (prec) {
-                        s->write('.');
+                        out.write('.');
                         sign = 2;
                         do {
-                            s->write(buf[sign++]);
+                            out.write(buf[sign++]);
                         } while (--prec);
                     }
 
                     /* exponent     */
-                    s->write(flags & FL_FLTUPP ? 'E' : 'e');
+                    out.write(flags & FL_FLTUPP ? 'E' : 'e');
                     ndigs = '+';
                     if (exp < 0 || (exp == 0 && (vtype & FTOA_CARRY) != 0)) {
                         exp = -exp;
                         ndigs = '-';
                     }
-                    s->write(ndigs);
+                    out.write(ndigs);
                     for (ndigs = '0'; exp >= 10; exp -= 10)
                         ndigs += 1;
-                    s->write(ndigs);
-                    s->write('0' + exp);
+                    out.write(ndigs);
+                    out.write('0' + exp);
                 }
 
                 goto tail;
@@ -376,13 +484,13 @@ flt_oper:
 
                 if (!(flags & FL_LPAD)) {
                     while (size < width) {
-                        s->write(' ');
+                        out.write(' ');
                         width--;
                     }
                 }
 
                 while (size) {
-                    s->write(*pnt++);
+                    out.write(*pnt++);
                     if (width) width -= 1;
                     size -= 1;
                 }
@@ -496,7 +604,7 @@ ultoa:
                         }
                     }
                     while (len < width) {
-                        s->write(' ');
+                        out.write(' ');
                         len++;
                     }
                 }
@@ -504,9 +612,9 @@ ultoa:
                 width =  (len < width) ? width - len : 0;
 
                 if (flags & FL_ALT) {
-                    s->write('0');
+                    out.write('0');
                     if (flags & FL_ALTHEX) {
-                        s->write(flags & FL_ALTUPP ? 'X' : 'x');
+                        out.write(flags & FL_ALTUPP ? 'X' : 'x');
                     }
                 } else if (flags & (FL_NEGATIVE | FL_PLUS | FL_SPACE)) {
                     unsigned char z = ' ';
@@ -516,24 +624,41 @@ ultoa:
                     if (flags & FL_NEGATIVE) {
                         z = '-';
                     }
-                    s->write(z);
+                    out.write(z);
                 }
 
                 while (prec > c) {
-                    s->write('0');
+                    out.write('0');
                     prec--;
                 }
 
                 do {
-                    s->write(buf[--c]);
+                    out.write(buf[--c]);
                 } while (c);
             }
 
 tail:
             /* Tail is possible.    */
             while (width) {
-                s->write(' ');
+                out.write(' ');
                 width--;
             }
         } /* for (;;) */
 }
+
+void print_vprintf(AP_HAL::BetterStream *s, const char *fmt, va_list ap)
+{
+    PrintOutput out(s);
+    print_vprintf_out(out, fmt, ap);
+    out.flush();
+}
+
+int print_vsnprintf(char *str, size_t size, const char *fmt, va_list ap)
+{
+    PrintOutput out(str, size > 0 ? size-1 : 0);
+    print_vprintf_out(out, fmt, ap);
+    if (size > 0) {
+        str[out.length()] = 0;
+    }
+    return out.total();
+}
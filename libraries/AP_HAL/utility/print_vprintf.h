@@ -5,3 +5,10 @@
 #include <AP_HAL/AP_HAL.h>
 
 void print_vprintf(AP_HAL::BetterStream *s, const char *fmt, va_list ap);
+
+/*
+  format into str, which holds size bytes including the null, with the
+  vsnprintf() return: the length the string would have had if size
+  were big enough
+ */
+int print_vsnprintf(char *str, size_t size, const char *fmt, va_list ap);
@@ -0,0 +1,56 @@
+/*
+  a UART for running serial sensor drivers without the sensor. Reads
+  return the bytes of a buffer and writes are discarded. Used by the
+  UARTReader test and benchmark
+ */
+
+#pragma once
+
+#include <AP_HAL/AP_HAL.h>
+
+#include <string.h>
+
+class TestUART : public AP_HAL::UARTDriver {
+public:
+    // make the next reads return the len bytes at data, which must
+    // stay allocated while they are read
+    void set_data(const uint8_t *data, uint32_t len) {
+        _data = data;
+        _len = len;
+        _ofs = 0;
+    }
+
+    void begin(uint32_t baud) override {}
+    void begin(uint32_t baud, uint16_t rxSpace, uint16_t txSpace) override {}
+    void end() override {}
+    void flush() override {}
+    bool is_initialized() override { return true; }
+    void set_blocking_writes(bool blocking) override {}
+    bool tx_pending() override { return false; }
+
+    uint32_t available() override { return _len - _ofs; }
+    uint32_t txspace() override { return 1024; }
+    int16_t read() override {
+        if (_ofs >= _len) {
+            return -1;
+        }
+        return _data[_ofs++];
+    }
+    ssize_t read(uint8_t *buffer, uint16_t count) override {
+        uint32_t n = _len - _ofs;
+        if (n > count) {
+            n = count;
+        }
+        memcpy(buffer, &_data[_ofs], n);
+        _ofs += n;
+        return n;
+    }
+
+    size_t write(uint8_t c) override { return 1; }
+    size_t write(const uint8_t *buffer, size_t size) override { return size; }
+
+private:
+    const uint8_t *_data = nullptr;
+    uint32_t _len = 0;
+    uint32_t _ofs = 0;
+};
@@ -0,0 +1,100 @@
+#include <AP_gtest.h>
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/DShotTelem.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// erpm values to try, checked against the period they are sent as
+static const uint32_t test_erpm[] = { 1000, 1234, 10000, 57000, 120000, 300000 };
+
+static uint32_t expected_erpm(uint32_t erpm)
+{
+    uint32_t period_us = (60000000UL + erpm/2) / erpm;
+    uint8_t shift = 0;
+    while (period_us > 0x1FF) {
+        period_us >>= 1;
+        shift++;
+    }
+    period_us <<= shift;
+    return (60000000UL + period_us/2) / period_us;
+}
+
+TEST(DShotTelemTest, Frame)
+{
+    uint32_t erpm;
+    for (uint32_t v : test_erpm) {
+        const uint32_t levels = DShotTelem::encode_frame(v);
+        EXPECT_EQ(0U, levels >> 20);
+        EXPECT_TRUE(DShotTelem::decode_frame(levels, erpm));
+        EXPECT_EQ(expected_erpm(v), erpm);
+    }
+
+    EXPECT_TRUE(DShotTelem::decode_frame(DShotTelem::encode_frame(0), erpm));
+    EXPECT_EQ(0U, erpm);
+    EXPECT_TRUE(DShotTelem::decode_frame(DShotTelem::encode_frame(100), erpm));
+    EXPECT_EQ(0U, erpm);
+}
+
+TEST(DShotTelemTest, BadFrames)
+{
+    uint32_t erpm;
+    const uint32_t levels = DShotTelem::encode_frame(10000);
+    // any single wrong bit is caught by the GCR code or the checksum
+    for (uint8_t i=0; i<20; i++) {
+        EXPECT_FALSE(DShotTelem::decode_frame(levels ^ (1U<<i), erpm)) << "bit " << unsigned(i);
+    }
+    // an idle line has no start bit
+    EXPECT_FALSE(DShotTelem::decode_frame(0x1FFFFF, erpm));
+}
+
+// sample a frame on pin 3 of a port, with other pins busy
+static uint16_t sample_frame(uint32_t levels, uint16_t *samples, uint16_t count,
+                             uint16_t lead, uint32_t samples_per_bit_x256)
+{
+    const uint16_t pin_mask = 1U<<3;
+    for (uint16_t i=0; i<count; i++) {
+        bool level = true;
+        if (i >= lead) {
+            const uint32_t bit = ((i - lead) * 256U) / samples_per_bit_x256;
+            if (bit < 21) {
+                level = levels & (1U<<(20 - bit));
+            }
+        }
+        samples[i] = (level ? pin_mask : 0) | ((i & 1) ? 0x8001 : 0x0100);
+    }
+    return pin_mask;
+}
+
+TEST(DShotTelemTest, Samples)
+{
+    uint16_t samples[160];
+    uint32_t erpm;
+
+    // sampling at 4 times the command bit rate gives 3.2 samples a
+    // reply bit, at the rate the ChibiOS RCOutput samples
+    const uint32_t spb = (4 * 256 * 4) / 5;
+    for (uint32_t v : test_erpm) {
+        const uint16_t pin_mask = sample_frame(DShotTelem::encode_frame(v), samples, 160, 57, spb);
+        EXPECT_TRUE(DShotTelem::decode_samples(samples, 160, pin_mask, spb, erpm));
+        EXPECT_EQ(expected_erpm(v), erpm);
+    }
+
+    // a reply cut short by the end of the samples
+    const uint16_t pin_mask = sample_frame(DShotTelem::encode_frame(10000), samples, 160, 150, spb);
+    EXPECT_FALSE(DShotTelem::decode_samples(samples, 160, pin_mask, spb, erpm));
+
+    // no reply at all
+    for (uint16_t i=0; i<160; i++) {
+        samples[i] = pin_mask;
+    }
+    EXPECT_FALSE(DShotTelem::decode_samples(samples, 160, pin_mask, spb, erpm));
+}
+
+TEST(DShotTelemTest, RPM)
+{
+    EXPECT_EQ(1000U, DShotTelem::erpm_to_rpm(7000, 14));
+    EXPECT_EQ(7000U, DShotTelem::erpm_to_rpm(7000, 0));
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,86 @@
+#include <AP_gtest.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/PerfTrace.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// count the occurrences of needle in the file at path
+static unsigned count_in_file(const char *path, const char *needle)
+{
+    FILE *f = fopen(path, "r");
+    if (f == nullptr) {
+        return 0;
+    }
+    unsigned count = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), f) != nullptr) {
+        for (const char *p = line; (p = strstr(p, needle)) != nullptr; p++) {
+            count++;
+        }
+    }
+    fclose(f);
+    return count;
+}
+
+static void temp_path(char path[32])
+{
+    strcpy(path, "/tmp/perf_traceXXXXXX");
+    int fd = mkstemp(path);
+    ASSERT_NE(-1, fd);
+    close(fd);
+}
+
+TEST(PerfTraceTest, Events)
+{
+    PerfTrace trace;
+    char path[32];
+    temp_path(path);
+
+    // nothing recorded, nothing written
+    EXPECT_FALSE(trace.write_chrome_trace(path));
+
+    const int16_t loop = trace.add("loop");
+    const int16_t errors = trace.add("errors");
+    EXPECT_EQ(0, loop);
+    EXPECT_EQ(1, errors);
+
+    trace.record(loop, PerfTrace::Event::BEGIN, 1);
+    trace.record(errors, PerfTrace::Event::COUNT, 2);
+    trace.record(loop, PerfTrace::Event::END, 1);
+    // an id which was never added is dropped
+    trace.record(7, PerfTrace::Event::COUNT, 1);
+
+    EXPECT_TRUE(trace.write_chrome_trace(path));
+    EXPECT_EQ(1U, count_in_file(path, "\"traceEvents\""));
+    EXPECT_EQ(2U, count_in_file(path, "\"name\":\"loop\""));
+    EXPECT_EQ(1U, count_in_file(path, "\"ph\":\"B\""));
+    EXPECT_EQ(1U, count_in_file(path, "\"ph\":\"E\""));
+    EXPECT_EQ(1U, count_in_file(path, "\"name\":\"errors\",\"ph\":\"i\""));
+    EXPECT_EQ(1U, count_in_file(path, "\"tid\":2"));
+    unlink(path);
+}
+
+TEST(PerfTraceTest, Overwrite)
+{
+    PerfTrace trace;
+    char path[32];
+    temp_path(path);
+
+    const int16_t id = trace.add("tick");
+    for (uint32_t i = 0; i < HAL_PERF_TRACE_EVENTS + 10; i++) {
+        trace.record(id, PerfTrace::Event::COUNT, 1);
+    }
+
+    // only the newest events are kept
+    EXPECT_TRUE(trace.write_chrome_trace(path));
+    EXPECT_EQ((unsigned)HAL_PERF_TRACE_EVENTS, count_in_file(path, "\"name\":\"tick\""));
+    unlink(path);
+}
+
+AP_GTEST_MAIN()
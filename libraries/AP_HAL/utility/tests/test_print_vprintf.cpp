@@ -0,0 +1,107 @@
+#include <AP_gtest.h>
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/print_vprintf.h>
+
+#include <math.h>
+#include <stdio.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// a stream keeping what is written to it, counting the writes
+class StringStream : public AP_HAL::BetterStream {
+public:
+    size_t write(uint8_t c) override {
+        return write(&c, 1);
+    }
+    size_t write(const uint8_t *buffer, size_t size) override {
+        if (len + size > sizeof(str) - 1) {
+            size = sizeof(str) - 1 - len;
+        }
+        memcpy(&str[len], buffer, size);
+        len += size;
+        str[len] = 0;
+        writes++;
+        return size;
+    }
+    uint32_t available() override { return 0; }
+    int16_t read() override { return -1; }
+    uint32_t txspace() override { return sizeof(str) - 1 - len; }
+
+    char str[256] {};
+    size_t len = 0;
+    uint16_t writes = 0;
+};
+
+static int test_snprintf(char *str, size_t size, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    const int ret = print_vsnprintf(str, size, fmt, ap);
+    va_end(ap);
+    return ret;
+}
+
+static void test_printf(StringStream &s, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    print_vprintf(&s, fmt, ap);
+    va_end(ap);
+}
+
+TEST(PrintTest, Truncate)
+{
+    char buf[8];
+    memset(buf, 'x', sizeof(buf));
+    // the return is the length without truncation, always terminated
+    EXPECT_EQ(11, test_snprintf(buf, sizeof(buf), "hello %s", "world"));
+    EXPECT_STREQ("hello w", buf);
+    EXPECT_EQ(5, test_snprintf(buf, sizeof(buf), "%d", -1234));
+    EXPECT_STREQ("-1234", buf);
+    EXPECT_EQ(3, test_snprintf(nullptr, 0, "%u", 123U));
+}
+
+TEST(PrintTest, Fixed)
+{
+    // exact halves round up, otherwise the same as the C library
+    const float values[] { 0, 1, -1, 0.3f, 0.0283099245f, 68.0375443f,
+                           -32.9554482f, 110.7f, 1234.567f, -9999.99f,
+                           0.000123f, 3.14159265f, 1e-20f, 9999999 };
+    const char *formats[] { "%f", "%.0f", "%.1f", "%.2f", "%.3f", "%.7f",
+                            "%8.2f", "%-8.2f|", "%08.3f", "%+.2f", "% .1f" };
+    for (const float v : values) {
+        for (const char *fmt : formats) {
+            char buf[64], expected[64];
+            snprintf(expected, sizeof(expected), fmt, v);
+            test_snprintf(buf, sizeof(buf), fmt, v);
+            EXPECT_STREQ(expected, buf) << fmt << " " << v;
+        }
+    }
+    char buf[16];
+    test_snprintf(buf, sizeof(buf), "%.2f", 1.125f);
+    EXPECT_STREQ("1.13", buf);
+    test_snprintf(buf, sizeof(buf), "%.1f", -0.01f);
+    EXPECT_STREQ("-0.0", buf);
+    test_snprintf(buf, sizeof(buf), "%5.1f", NAN);
+    EXPECT_STREQ("  nan", buf);
+}
+
+TEST(PrintTest, Stream)
+{
+    // the output is written in blocks, with cr before lf
+    StringStream s;
+    test_printf(s, "%s %d %5.1f %c\n", "text", 42, 2.25f, 'z');
+    EXPECT_STREQ("text 42   2.3 z\r\n", s.str);
+    EXPECT_EQ(1U, s.writes);
+
+    StringStream s2;
+    char expected[101];
+    memset(expected, 'a', 100);
+    expected[100] = 0;
+    test_printf(s2, "%s", expected);
+    EXPECT_STREQ(expected, s2.str);
+    EXPECT_LT(s2.writes, 10U);
+}
+
+AP_GTEST_MAIN()
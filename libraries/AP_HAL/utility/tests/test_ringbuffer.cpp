@@ -0,0 +1,103 @@
+#include <AP_gtest.h>
+
+#include <AP_HAL/utility/RingBuffer.h>
+
+TEST(ObjectBufferSPSCTest, PowerOfTwoSize)
+{
+    ObjectBufferSPSC<uint32_t> buf(10);
+
+    EXPECT_EQ(16U, buf.get_size());
+    EXPECT_TRUE(buf.empty());
+    EXPECT_EQ(16U, buf.space());
+}
+
+TEST(ObjectBufferSPSCTest, PushPop)
+{
+    ObjectBufferSPSC<uint32_t> buf(4);
+
+    for (uint32_t i = 0; i < 4; i++) {
+        EXPECT_TRUE(buf.push(i));
+    }
+    EXPECT_FALSE(buf.push(99));
+    EXPECT_EQ(4U, buf.available());
+
+    uint32_t v;
+    EXPECT_TRUE(buf.peek(v));
+    EXPECT_EQ(0U, v);
+    EXPECT_EQ(0U, *buf.peek_ptr());
+
+    for (uint32_t i = 0; i < 4; i++) {
+        EXPECT_TRUE(buf.pop(v));
+        EXPECT_EQ(i, v);
+    }
+    EXPECT_FALSE(buf.pop(v));
+    EXPECT_EQ(nullptr, buf.peek_ptr());
+}
+
+TEST(ObjectBufferSPSCTest, WrapAround)
+{
+    ObjectBufferSPSC<uint32_t> buf(8);
+    uint32_t v;
+
+    // move the indexes so the next bulk write wraps
+    for (uint32_t i = 0; i < 6; i++) {
+        EXPECT_TRUE(buf.push(i));
+        EXPECT_TRUE(buf.pop(v));
+    }
+
+    const uint32_t data[5] = { 10, 11, 12, 13, 14 };
+    EXPECT_TRUE(buf.push(data, 5));
+    EXPECT_EQ(5U, buf.available());
+
+    // first contiguous run stops at the end of the storage
+    uint32_t n = 0;
+    const uint32_t *ptr = buf.readptr(n);
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_EQ(2U, n);
+    EXPECT_EQ(10U, ptr[0]);
+    EXPECT_EQ(11U, ptr[1]);
+    EXPECT_TRUE(buf.advance(2));
+
+    for (uint32_t i = 12; i < 15; i++) {
+        EXPECT_TRUE(buf.pop(v));
+        EXPECT_EQ(i, v);
+    }
+    EXPECT_TRUE(buf.empty());
+}
+
+TEST(ObjectBufferSPSCTest, ReserveCommit)
+{
+    ObjectBufferSPSC<uint32_t> buf(8);
+    uint32_t *ptr = nullptr;
+
+    EXPECT_EQ(3U, buf.reserve(ptr, 3));
+    ASSERT_NE(nullptr, ptr);
+    ptr[0] = 1;
+    ptr[1] = 2;
+    ptr[2] = 3;
+
+    // nothing is visible until commit
+    EXPECT_TRUE(buf.empty());
+    buf.commit(3);
+    EXPECT_EQ(3U, buf.available());
+
+    // can't reserve more than the free space
+    EXPECT_EQ(5U, buf.reserve(ptr, 10));
+
+    EXPECT_FALSE(buf.advance(4));
+    EXPECT_TRUE(buf.advance(3));
+    EXPECT_TRUE(buf.empty());
+}
+
+TEST(ObjectBufferSPSCTest, Clear)
+{
+    ObjectBufferSPSC<uint32_t> buf(4);
+
+    EXPECT_TRUE(buf.push(1));
+    EXPECT_TRUE(buf.push(2));
+    buf.clear();
+    EXPECT_TRUE(buf.empty());
+    EXPECT_EQ(4U, buf.space());
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,97 @@
+#include <AP_gtest.h>
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/UARTReader.h>
+
+#include "TestUART.h"
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static const uint8_t header[] { 0x59, 0x59 };
+
+// fill buf with n frames of len bytes, each the header then a count,
+// with junk before each frame. Returns the length of the stream
+static uint32_t make_stream(uint8_t *buf, uint8_t n, uint8_t len)
+{
+    uint32_t ofs = 0;
+    for (uint8_t i=0; i<n; i++) {
+        // junk, including a lone header byte
+        buf[ofs++] = 0x01;
+        buf[ofs++] = 0x59;
+        buf[ofs++] = 0x02;
+        memcpy(&buf[ofs], header, sizeof(header));
+        for (uint8_t j=sizeof(header); j<len; j++) {
+            buf[ofs+j] = i;
+        }
+        ofs += len;
+    }
+    return ofs;
+}
+
+TEST(UARTReaderTest, Bytes)
+{
+    TestUART uart;
+    UARTReader reader;
+    uint8_t data[100];
+    for (uint8_t i=0; i<sizeof(data); i++) {
+        data[i] = i;
+    }
+    uart.set_data(data, sizeof(data));
+
+    // only the bytes asked for are read
+    uint32_t nbytes = 70;
+    uint32_t count = 0;
+    while (reader.fill(&uart, nbytes)) {
+        EXPECT_EQ(count, reader.byte());
+        count++;
+    }
+    EXPECT_EQ(70U, count);
+    EXPECT_EQ(0U, nbytes);
+    EXPECT_EQ(30U, uart.available());
+
+    // bytes not consumed are kept for the next call
+    nbytes = uart.available();
+    EXPECT_TRUE(reader.fill(&uart, nbytes));
+    EXPECT_EQ(70, reader.byte());
+    nbytes = 0;
+    EXPECT_TRUE(reader.fill(&uart, nbytes));
+    EXPECT_EQ(71, reader.byte());
+
+    EXPECT_TRUE(reader.skip_to(80));
+    EXPECT_EQ(80, reader.byte());
+    EXPECT_FALSE(reader.skip_to(5));
+    EXPECT_EQ(0U, reader.remaining());
+}
+
+TEST(UARTReaderTest, Frames)
+{
+    TestUART uart;
+    UARTReader reader;
+    uint8_t data[400];
+    const uint8_t frame_len = 9;
+    const uint32_t len = make_stream(data, 30, frame_len);
+    ASSERT_LE(len, sizeof(data));
+
+    // frames split across blocks and across calls are all found
+    for (uint32_t step : { 1U, 7U, 64U, 400U }) {
+        uart.set_data(data, len);
+        uint8_t frame[frame_len];
+        uint8_t frame_ofs = 0;
+        uint8_t count = 0;
+        while (uart.available() > 0) {
+            uint32_t nbytes = step;
+            while (reader.fill(&uart, nbytes)) {
+                while (reader.get_frame(frame, frame_ofs, frame_len, header, sizeof(header))) {
+                    frame_ofs = 0;
+                    EXPECT_EQ(0, memcmp(frame, header, sizeof(header)));
+                    EXPECT_EQ(count, frame[2]);
+                    EXPECT_EQ(count, frame[frame_len-1]);
+                    count++;
+                }
+            }
+        }
+        EXPECT_EQ(30, count);
+    }
+}
+
+AP_GTEST_MAIN()
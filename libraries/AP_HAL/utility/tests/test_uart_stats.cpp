@@ -0,0 +1,76 @@
+#include <AP_gtest.h>
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/UARTStats.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+TEST(UARTStatsKeeperTest, Counts)
+{
+    UARTStatsKeeper keeper;
+
+    keeper.received(10, 10, 10);
+    keeper.received(20, 15, 512);
+    keeper.received(5, 5, 3);
+    keeper.queued(8, 8, 8);
+    keeper.queued(8, 3, 100);
+    keeper.queued(4, 0, 100);
+    keeper.sent(11);
+    keeper.count_irq();
+    keeper.count_irq();
+    keeper.count_overrun();
+
+    const AP_HAL::UARTDriver::UARTStats &stats = keeper.get();
+    EXPECT_EQ(35U, stats.rx_bytes);
+    EXPECT_EQ(5U, stats.rx_dropped);
+    EXPECT_EQ(512U, stats.rx_max_used);
+    EXPECT_EQ(11U, stats.tx_bytes);
+    EXPECT_EQ(2U, stats.tx_full);
+    EXPECT_EQ(9U, stats.tx_dropped);
+    EXPECT_EQ(100U, stats.tx_max_used);
+    EXPECT_EQ(2U, stats.irqs);
+    EXPECT_EQ(1U, stats.rx_overruns);
+}
+
+static void wait_us(uint32_t us)
+{
+    const uint32_t start_us = AP_HAL::micros();
+    while (AP_HAL::micros() - start_us < us) {
+    }
+}
+
+TEST(UARTStatsKeeperTest, Latency)
+{
+    UARTStatsKeeper keeper;
+
+    // the first write is marked at its last byte
+    keeper.queued(10, 10, 10);
+    wait_us(2000);
+    keeper.sent(9);
+    EXPECT_EQ(0U, keeper.get().tx_latency_max_us);
+    keeper.sent(1);
+    const uint32_t first_us = keeper.get().tx_latency_max_us;
+    EXPECT_GE(first_us, 2000U);
+    EXPECT_EQ(first_us, keeper.get().tx_latency_avg_us);
+
+    // a quick byte brings the average down but not the maximum
+    keeper.queued(1, 1, 1);
+    keeper.sent(1);
+    EXPECT_EQ(first_us, keeper.get().tx_latency_max_us);
+    EXPECT_LT(keeper.get().tx_latency_avg_us, first_us);
+}
+
+TEST(UARTStatsKeeperTest, Cleared)
+{
+    UARTStatsKeeper keeper;
+
+    // bytes thrown away with the buffer must not be waited for
+    keeper.queued(100, 100, 100);
+    keeper.tx_cleared();
+    keeper.queued(1, 1, 1);
+    wait_us(500);
+    keeper.sent(1);
+    EXPECT_GE(keeper.get().tx_latency_max_us, 500U);
+}
+
+AP_GTEST_MAIN()
@@ -18,6 +18,7 @@
 #include "ch.h"
 #include "hal.h"
 #include <AP_Common/Semaphore.h>
+#include <AP_Math/AP_Math.h>
 
 #if HAL_USE_ADC == TRUE && !defined(HAL_DISABLE_ADC_DRIVER)
 
@@ -75,7 +76,11 @@ AnalogSource::AnalogSource(int16_t pin, float initial_value) :
     _latest_value(initial_value),
     _sum_count(0),
     _sum_value(0),
-    _sum_ratiometric(0)
+    _sum_ratiometric(0),
+    _integral(0),
+    _integral_us(0),
+    _filter_cutoff_hz(0),
+    _latest_us(0)
 {
 }
 
@@ -134,6 +139,26 @@ float AnalogSource::voltage_average_ratiometric()
     return _pin_scaler() * _value_ratiometric;
 }
 
+/*
+  return integral of voltage in Volt seconds since the last call, if
+  there have been samples since then
+ */
+bool AnalogSource::voltage_integral(float &integral, uint32_t &interval_us)
+{
+    const float scaler = _pin_scaler();
+
+    WITH_SEMAPHORE(_semaphore);
+
+    if (_integral_us == 0) {
+        return false;
+    }
+    integral = scaler * _integral;
+    interval_us = _integral_us;
+    _integral = 0;
+    _integral_us = 0;
+    return true;
+}
+
 /*
   return voltage in Volts
  */
@@ -155,16 +180,38 @@ void AnalogSource::set_pin(uint8_t pin)
     _latest_value = 0;
     _value = 0;
     _value_ratiometric = 0;
+    _integral = 0;
+    _integral_us = 0;
+    _latest_us = 0;
 }
 
 /*
-  apply a reading in ADC counts
+  apply a reading in ADC counts, the average of the DMA samples since
+  the last reading
  */
-void AnalogSource::_add_value(float v, float vcc5V)
+void AnalogSource::_add_value(float v, float vcc5V, uint32_t now_us)
 {
     WITH_SEMAPHORE(_semaphore);
 
-    _latest_value = v;
+    // the average of all of the samples times the time they cover is
+    // the integral of the sampled signal. Before the first reading, or
+    // after a long gap, there is nothing to integrate or filter from
+    const uint32_t dt_us = now_us - _latest_us;
+    if (_latest_us != 0 && dt_us < 100000) {
+        const float dt = dt_us * 1.0e-6f;
+        _integral += v * dt;
+        _integral_us += dt_us;
+        if (_filter_cutoff_hz > 0) {
+            const float rc = 1.0f / (M_2PI * _filter_cutoff_hz);
+            _latest_value += (v - _latest_value) * dt / (dt + rc);
+        } else {
+            _latest_value = v;
+        }
+    } else {
+        _latest_value = v;
+    }
+    _latest_us = now_us;
+
     _sum_value += v;
     if (vcc5V < 3.0f) {
         _sum_ratiometric += v;
@@ -256,17 +303,26 @@ void AnalogIn::init()
 }
 
 /*
-  calculate average sample since last read for all channels
+  calculate average sample since last read for all channels. The
+  average keeps its fraction, so oversampling by the DMA gives more
+  resolution than a single conversion. Returns false if there have been
+  no samples
  */
-void AnalogIn::read_adc(uint32_t *val)
+bool AnalogIn::read_adc(float *val)
 {
     chSysLock();
+    if (sample_count == 0) {
+        chSysUnlock();
+        return false;
+    }
+    const float scale = 1.0f / sample_count;
     for (uint8_t i = 0; i < ADC_GRP1_NUM_CHANNELS; i++) {
-        val[i] = sample_sum[i] / sample_count;
+        val[i] = sample_sum[i] * scale;
     }
     memset(sample_sum, 0, sizeof(sample_sum));
     sample_count = 0;
     chSysUnlock();
+    return true;
 }
 
 /*
@@ -280,12 +336,14 @@ void AnalogIn::_timer_tick(void)
     if (delta_t < 10000) {
         return;
     }
-    _last_run = now;
 
-    uint32_t buf_adc[ADC_GRP1_NUM_CHANNELS];
+    float buf_adc[ADC_GRP1_NUM_CHANNELS];
 
     /* read all channels available */
-    read_adc(buf_adc);
+    if (!read_adc(buf_adc)) {
+        return;
+    }
+    _last_run = now;
 
     // update power status flags
     update_power_flags();
@@ -316,9 +374,9 @@ void AnalogIn::_timer_tick(void)
             if (c != nullptr) {
                 if (pin_config[i].channel == c->_pin) {
                     // add a value
-                    c->_add_value(buf_adc[i], _board_voltage);
+                    c->_add_value(buf_adc[i], _board_voltage, now);
                 } else if (c->_pin == ANALOG_SERVO_VRSSI_PIN) {
-                    c->_add_value(_rssi_voltage / VOLTAGE_SCALING, 0);
+                    c->_add_value(_rssi_voltage / VOLTAGE_SCALING, 0, now);
                 }
             }
         }
@@ -22,7 +22,9 @@
 #define ANALOG_MAX_CHANNELS 16
 
 // number of samples on each channel to gather on each DMA callback
+#ifndef ADC_DMA_BUF_DEPTH
 #define ADC_DMA_BUF_DEPTH 8
+#endif
 
 #if HAL_USE_ADC == TRUE && !defined(HAL_DISABLE_ADC_DRIVER)
 
@@ -36,6 +38,9 @@ public:
     float voltage_average() override;
     float voltage_latest() override;
     float voltage_average_ratiometric() override;
+    bool voltage_integral(float &integral, uint32_t &interval_us) override;
+    void set_filter_cutoff(float cutoff_hz) override { _filter_cutoff_hz = cutoff_hz; }
+    uint32_t last_update_us() override { return _latest_us; }
     void set_stop_pin(uint8_t p) override {}
     void set_settle_time(uint16_t settle_time_ms) override {}
 
@@ -48,7 +53,11 @@ private:
     uint8_t _sum_count;
     float _sum_value;
     float _sum_ratiometric;
-    void _add_value(float v, float vcc5V);
+    float _integral;
+    uint32_t _integral_us;
+    float _filter_cutoff_hz;
+    uint32_t _latest_us;
+    void _add_value(float v, float vcc5V, uint32_t now_us);
     float _pin_scaler();
     HAL_Semaphore _semaphore;
 };
@@ -66,7 +75,7 @@ public:
     static void adccallback(ADCDriver *adcp);
 
 private:
-    void read_adc(uint32_t *val);
+    bool read_adc(float *val);
     void update_power_flags(void);
     
     int _battery_handle;
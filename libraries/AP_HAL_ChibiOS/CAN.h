@@ -32,7 +32,13 @@
 
 #define MAX_NUMBER_OF_CAN_INTERFACES    2
 #define MAX_NUMBER_OF_CAN_DRIVERS       2
+#ifndef CAN_STM32_RX_QUEUE_SIZE
 #define CAN_STM32_RX_QUEUE_SIZE         64
+#endif
+// frames per interface waiting for a TX mailbox. Can be set in hwdef.dat
+#ifndef CAN_STM32_TX_QUEUE_SIZE
+#define CAN_STM32_TX_QUEUE_SIZE         32
+#endif
 
 namespace ChibiOS {
 /**
@@ -64,9 +70,12 @@ public:
     bool is_initialized() override;
     void initialized(bool val) override;
 
+    bool get_tx_stats(uint8_t iface, TxStats &stats) override;
+    bool get_rx_stats(uint8_t iface, RxStats &stats) override;
+
 private:
     bool initialized_;
-    ChibiOS_CAN::CanInitHelper<CAN_STM32_RX_QUEUE_SIZE> can_helper;
+    ChibiOS_CAN::CanInitHelper<CAN_STM32_RX_QUEUE_SIZE, CAN_STM32_TX_QUEUE_SIZE> can_helper;
 };
 
 }
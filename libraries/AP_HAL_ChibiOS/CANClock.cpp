@@ -184,6 +184,20 @@ uavcan::uint64_t getUtcUSecFromCanInterrupt()
     return utc_set ? sampleUtcFromCriticalSection() : 0;
 }
 
+uavcan::uint64_t getMonotonicUSecFromCanInterrupt()
+{
+    UAVCAN_ASSERT(initialized);
+
+    volatile uavcan::uint64_t time = time_mono;
+    volatile uavcan::uint32_t cnt = TIMX->CNT;
+
+    if (TIMX->SR & TIM_SR_UIF) {
+        cnt = TIMX->CNT;
+        time += USecPerOverflow;
+    }
+    return time + cnt;
+}
+
 uavcan::MonotonicTime getMonotonic()
 {
     uavcan::uint64_t usec = 0;
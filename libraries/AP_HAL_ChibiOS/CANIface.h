@@ -71,14 +71,33 @@ static const uavcan::int16_t ErrFilterNumConfigs        = 1008; ///< Number of f
  */
 struct CanRxItem {
     uavcan::uint64_t utc_usec;
+    uavcan::uint64_t mono_usec;     ///< monotonic time of the receive interrupt
     uavcan::CanFrame frame;
     uavcan::CanIOFlags flags;
     CanRxItem()
         : utc_usec(0)
+        , mono_usec(0)
         , flags(0)
     { }
 };
 
+/**
+ * TX queue item.
+ * The application shall not use this directly.
+ */
+struct CanTxItem {
+    uavcan::MonotonicTime deadline;
+    uavcan::CanFrame frame;
+    uavcan::uint64_t queued_usec;   ///< monotonic time the frame was queued
+    bool loopback;
+    bool abort_on_error;
+    CanTxItem()
+        : queued_usec(0)
+        , loopback(false)
+        , abort_on_error(false)
+    { }
+};
+
 /**
  * Single CAN iface.
  * The application shall not use this directly.
@@ -105,8 +124,10 @@ class CanIface : public uavcan::ICanIface, uavcan::Noncopyable {
             , overflow_cnt_(0)
         { }
 
-        void push(const uavcan::CanFrame& frame, const uint64_t& utc_usec, uavcan::CanIOFlags flags);
-        void pop(uavcan::CanFrame& out_frame, uavcan::uint64_t& out_utc_usec, uavcan::CanIOFlags& out_flags);
+        void push(const uavcan::CanFrame& frame, const uint64_t& utc_usec, const uint64_t& mono_usec,
+                  uavcan::CanIOFlags flags);
+        void pop(uavcan::CanFrame& out_frame, uavcan::uint64_t& out_utc_usec, uavcan::uint64_t& out_mono_usec,
+                 uavcan::CanIOFlags& out_flags);
 
         void reset();
 
@@ -119,6 +140,69 @@ class CanIface : public uavcan::ICanIface, uavcan::Noncopyable {
         {
             return overflow_cnt_;
         }
+
+        unsigned getCapacity() const
+        {
+            return capacity_;
+        }
+    };
+
+    /**
+     * Frames waiting for a TX mailbox, highest priority first, so that the TX interrupt can
+     * refill the mailboxes without waiting for the UAVCAN thread.
+     * Frames are copied into a slot of the pool once and stay there; only the one byte slot
+     * indices are reordered. order_ is a permutation of the slots: the first len_ entries are
+     * the queued slots in priority order, and the rest are the free slots.
+     * Frames of equal priority keep the order they were queued in, which keeps the frames of
+     * a multi-frame transfer in order.
+     */
+    class TxQueue {
+        CanTxItem* const buf_;
+        uavcan::uint8_t* const order_;
+        const uavcan::uint8_t capacity_;
+        uavcan::uint8_t len_;
+        uavcan::uint8_t peak_len_;
+
+    public:
+        TxQueue(CanTxItem* buf, uavcan::uint8_t* order, uavcan::uint8_t capacity)
+            : buf_(buf)
+            , order_(order)
+            , capacity_(capacity)
+            , len_(0)
+            , peak_len_(0)
+        {
+            reset();
+        }
+
+        bool push(const CanTxItem& item);
+        void remove(uavcan::uint8_t index);
+
+        void reset();
+
+        const CanTxItem& get(uavcan::uint8_t index) const
+        {
+            return buf_[order_[index]];
+        }
+
+        bool isFull() const
+        {
+            return len_ >= capacity_;
+        }
+
+        unsigned getLength() const
+        {
+            return len_;
+        }
+
+        unsigned getPeakLength() const
+        {
+            return peak_len_;
+        }
+
+        unsigned getCapacity() const
+        {
+            return capacity_;
+        }
     };
 
     struct Timings {
@@ -138,12 +222,14 @@ class CanIface : public uavcan::ICanIface, uavcan::Noncopyable {
     struct TxItem {
         uavcan::MonotonicTime deadline;
         uavcan::CanFrame frame;
+        uavcan::uint64_t queued_usec;
         bool pending;
         bool loopback;
         bool abort_on_error;
 
         TxItem()
-            : pending(false)
+            : queued_usec(0)
+            , pending(false)
             , loopback(false)
             , abort_on_error(false)
         { }
@@ -153,8 +239,10 @@ class CanIface : public uavcan::ICanIface, uavcan::Noncopyable {
     enum { NumFilters = 14 };
 
     static const uavcan::uint32_t TSR_ABRQx[NumTxMailboxes];
+    static const uavcan::uint32_t TSR_TMEx[NumTxMailboxes];
 
     RxQueue rx_queue_;
+    TxQueue tx_queue_;
     bxcan::CanType* const can_;
     uavcan::uint64_t error_cnt_;
     uavcan::uint32_t served_aborts_cnt_;
@@ -164,6 +252,19 @@ class CanIface : public uavcan::ICanIface, uavcan::Noncopyable {
     const uavcan::uint8_t self_index_;
     bool had_activity_;
 
+    // TX statistics since init
+    uavcan::uint32_t tx_frames_cnt_;
+    uavcan::uint32_t tx_timeouts_cnt_;
+    uavcan::uint32_t tx_latency_avg_usec_;
+    uavcan::uint32_t tx_latency_max_usec_;
+
+    // RX statistics since init
+    uavcan::uint32_t rx_frames_cnt_;
+    uavcan::uint32_t rx_fifo_overflow_cnt_;
+    uavcan::uint32_t rx_isr_max_usec_;
+    uavcan::uint32_t bus_off_cnt_;
+    bool bus_off_;
+
     int computeTimings(uavcan::uint32_t target_bitrate, Timings& out_timings);
 
     virtual uavcan::int16_t send(const uavcan::CanFrame& frame, uavcan::MonotonicTime tx_deadline,
@@ -182,10 +283,14 @@ class CanIface : public uavcan::ICanIface, uavcan::Noncopyable {
 
     void handleTxMailboxInterrupt(uavcan::uint8_t mailbox_index, bool txok, uavcan::uint64_t utc_usec);
 
+    void loadTxMailbox(uavcan::uint8_t mailbox_index, const CanTxItem& item);
+    void fillTxMailboxes(uavcan::uint64_t mono_usec);
+
     bool waitMsrINakBitStateChange(bool target_state);
 
 public:
     enum { MaxRxQueueCapacity = 254 };
+    enum { MaxTxQueueCapacity = 254 };
 
     enum OperatingMode {
         NormalMode,
@@ -193,8 +298,10 @@ public:
     };
 
     CanIface(bxcan::CanType* can, BusEvent& update_event, uavcan::uint8_t self_index,
-             CanRxItem* rx_queue_buffer, uavcan::uint8_t rx_queue_capacity)
+             CanRxItem* rx_queue_buffer, uavcan::uint8_t rx_queue_capacity,
+             CanTxItem* tx_queue_buffer, uavcan::uint8_t* tx_queue_order, uavcan::uint8_t tx_queue_capacity)
         : rx_queue_(rx_queue_buffer, rx_queue_capacity)
+        , tx_queue_(tx_queue_buffer, tx_queue_order, tx_queue_capacity)
         , can_(can)
         , error_cnt_(0)
         , served_aborts_cnt_(0)
@@ -202,6 +309,15 @@ public:
         , peak_tx_mailbox_index_(0)
         , self_index_(self_index)
         , had_activity_(false)
+        , tx_frames_cnt_(0)
+        , tx_timeouts_cnt_(0)
+        , tx_latency_avg_usec_(0)
+        , tx_latency_max_usec_(0)
+        , rx_frames_cnt_(0)
+        , rx_fifo_overflow_cnt_(0)
+        , rx_isr_max_usec_(0)
+        , bus_off_cnt_(0)
+        , bus_off_(false)
     {
         UAVCAN_ASSERT(self_index_ < UAVCAN_STM32_NUM_IFACES);
     }
@@ -278,6 +394,66 @@ public:
     {
         return uavcan::uint8_t(peak_tx_mailbox_index_ + 1);
     }
+
+    /**
+     * TX statistics since initialization. The latency is from send() until the frame is on
+     * the bus, averaged over about the last 16 frames.
+     */
+    uavcan::uint32_t getTxFrameCount() const
+    {
+        return tx_frames_cnt_;
+    }
+    uavcan::uint32_t getTxTimeoutCount() const
+    {
+        return tx_timeouts_cnt_;
+    }
+    uavcan::uint32_t getTxLatencyAvgUSec() const
+    {
+        return tx_latency_avg_usec_;
+    }
+    uavcan::uint32_t getTxLatencyMaxUSec() const
+    {
+        return tx_latency_max_usec_;
+    }
+
+    /**
+     * Number of frames waiting in the TX queue now, at most, and the queue's capacity.
+     */
+    unsigned getTxQueueLength() const;
+    unsigned getPeakTxQueueLength() const
+    {
+        return tx_queue_.getPeakLength();
+    }
+    unsigned getTxQueueCapacity() const
+    {
+        return tx_queue_.getCapacity();
+    }
+
+    /**
+     * RX statistics since initialization. FIFO overflows are frames the controller lost because
+     * the RX interrupt was late, as opposed to the software queue overflowing. The ISR time is
+     * the longest RX interrupt, and bus-off the number of times the controller went bus-off.
+     */
+    uavcan::uint32_t getRxFrameCount() const
+    {
+        return rx_frames_cnt_;
+    }
+    uavcan::uint32_t getRxFifoOverflowCount() const
+    {
+        return rx_fifo_overflow_cnt_;
+    }
+    uavcan::uint32_t getRxIsrMaxUSec() const
+    {
+        return rx_isr_max_usec_;
+    }
+    uavcan::uint32_t getBusOffCount() const
+    {
+        return bus_off_cnt_;
+    }
+    unsigned getRxQueueCapacity() const
+    {
+        return rx_queue_.getCapacity();
+    }
 };
 
 /**
@@ -303,15 +479,20 @@ class CanDriver : public uavcan::ICanDriver, uavcan::Noncopyable {
     static void initOnce(uavcan::uint8_t can_number, bool enable_irqs);
 
 public:
-    template <unsigned RxQueueCapacity>
-    CanDriver(CanRxItem(&rx_queue_storage)[UAVCAN_STM32_NUM_IFACES][RxQueueCapacity])
+    template <unsigned RxQueueCapacity, unsigned TxQueueCapacity>
+    CanDriver(CanRxItem(&rx_queue_storage)[UAVCAN_STM32_NUM_IFACES][RxQueueCapacity],
+              CanTxItem(&tx_queue_storage)[UAVCAN_STM32_NUM_IFACES][TxQueueCapacity],
+              uavcan::uint8_t(&tx_order_storage)[UAVCAN_STM32_NUM_IFACES][TxQueueCapacity])
         : update_event_(*this)
-        , if0_(bxcan::Can[0], update_event_, 0, rx_queue_storage[0], RxQueueCapacity)
+        , if0_(bxcan::Can[0], update_event_, 0, rx_queue_storage[0], RxQueueCapacity,
+               tx_queue_storage[0], tx_order_storage[0], TxQueueCapacity)
 #if UAVCAN_STM32_NUM_IFACES > 1
-        , if1_(bxcan::Can[1], update_event_, 1, rx_queue_storage[1], RxQueueCapacity)
+        , if1_(bxcan::Can[1], update_event_, 1, rx_queue_storage[1], RxQueueCapacity,
+               tx_queue_storage[1], tx_order_storage[1], TxQueueCapacity)
 #endif
     {
         uavcan::StaticAssert<(RxQueueCapacity <= CanIface::MaxRxQueueCapacity)>::check();
+        uavcan::StaticAssert<(TxQueueCapacity <= CanIface::MaxTxQueueCapacity)>::check();
     }
 
     /**
@@ -353,10 +534,14 @@ public:
  * Helper class.
  * Normally only this class should be used by the application.
  * 145 usec per Extended CAN frame @ 1 Mbps, e.g. 32 RX slots * 145 usec --> 4.6 msec before RX queue overruns.
+ * The TX queue only needs to cover the frames sent between wakeups of the UAVCAN thread, as
+ * further frames wait in the library's own queue.
  */
-template <unsigned RxQueueCapacity = 128>
+template <unsigned RxQueueCapacity = 128, unsigned TxQueueCapacity = 32>
 class CanInitHelper {
     CanRxItem queue_storage_[UAVCAN_STM32_NUM_IFACES][RxQueueCapacity];
+    CanTxItem tx_queue_storage_[UAVCAN_STM32_NUM_IFACES][TxQueueCapacity];
+    uavcan::uint8_t tx_order_storage_[UAVCAN_STM32_NUM_IFACES][TxQueueCapacity];
 
 public:
     enum { BitRateAutoDetect = 0 };
@@ -364,7 +549,7 @@ public:
     CanDriver driver;
 
     CanInitHelper() :
-        driver(queue_storage_)
+        driver(queue_storage_, tx_queue_storage_, tx_order_storage_)
     { }
 
     /**
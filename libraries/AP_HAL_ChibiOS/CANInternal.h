@@ -99,6 +99,7 @@ struct CriticalSectionLocker {
 
 namespace clock {
 uint64_t getUtcUSecFromCanInterrupt();
+uint64_t getMonotonicUSecFromCanInterrupt();
 }
 }
 
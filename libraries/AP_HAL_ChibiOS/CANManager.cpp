@@ -33,6 +33,11 @@ uint64_t clock::getUtcUSecFromCanInterrupt()
     return AP_HAL::micros64();
 }
 
+uint64_t clock::getMonotonicUSecFromCanInterrupt()
+{
+    return AP_HAL::micros64();
+}
+
 uavcan::MonotonicTime clock::getMonotonic()
 {
     return uavcan::MonotonicTime::fromUSec(AP_HAL::micros64());
@@ -55,4 +60,44 @@ void CANManager::initialized(bool val)
     initialized_ = val;
 }
 
+bool CANManager::get_tx_stats(uint8_t iface, TxStats &stats)
+{
+    if (!initialized_) {
+        return false;
+    }
+    const ChibiOS_CAN::CanIface *can_iface = can_helper.driver.getIface(iface);
+    if (can_iface == nullptr) {
+        return false;
+    }
+    stats.frames = can_iface->getTxFrameCount();
+    stats.timeouts = can_iface->getTxTimeoutCount();
+    stats.aborts = can_iface->getVoluntaryTxAbortCount();
+    stats.queue_len = can_iface->getTxQueueLength();
+    stats.queue_max = can_iface->getPeakTxQueueLength();
+    stats.queue_size = can_iface->getTxQueueCapacity();
+    stats.latency_avg_us = can_iface->getTxLatencyAvgUSec();
+    stats.latency_max_us = can_iface->getTxLatencyMaxUSec();
+    return true;
+}
+
+bool CANManager::get_rx_stats(uint8_t iface, RxStats &stats)
+{
+    if (!initialized_) {
+        return false;
+    }
+    const ChibiOS_CAN::CanIface *can_iface = can_helper.driver.getIface(iface);
+    if (can_iface == nullptr) {
+        return false;
+    }
+    stats.frames = can_iface->getRxFrameCount();
+    stats.queue_overflows = can_iface->getRxQueueOverflowCount();
+    stats.fifo_overflows = can_iface->getRxFifoOverflowCount();
+    stats.bus_offs = can_iface->getBusOffCount();
+    stats.errors = can_iface->getErrorCount();
+    stats.queue_len = can_iface->getRxQueueLength();
+    stats.queue_size = can_iface->getRxQueueCapacity();
+    stats.isr_max_us = can_iface->getRxIsrMaxUSec();
+    return true;
+}
+
 #endif //HAL_WITH_UAVCAN
@@ -148,10 +148,12 @@ void CanIface::RxQueue::registerOverflow()
     }
 }
 
-void CanIface::RxQueue::push(const uavcan::CanFrame& frame, const uint64_t& utc_usec, uavcan::CanIOFlags flags)
+void CanIface::RxQueue::push(const uavcan::CanFrame& frame, const uint64_t& utc_usec, const uint64_t& mono_usec,
+                             uavcan::CanIOFlags flags)
 {
     buf_[in_].frame    = frame;
     buf_[in_].utc_usec = utc_usec;
+    buf_[in_].mono_usec = mono_usec;
     buf_[in_].flags    = flags;
     in_++;
     if (in_ >= capacity_)
@@ -171,12 +173,14 @@ void CanIface::RxQueue::push(const uavcan::CanFrame& frame, const uint64_t& utc_
     }
 }
 
-void CanIface::RxQueue::pop(uavcan::CanFrame& out_frame, uavcan::uint64_t& out_utc_usec, uavcan::CanIOFlags& out_flags)
+void CanIface::RxQueue::pop(uavcan::CanFrame& out_frame, uavcan::uint64_t& out_utc_usec, uavcan::uint64_t& out_mono_usec,
+                            uavcan::CanIOFlags& out_flags)
 {
     if (len_ > 0)
     {
         out_frame    = buf_[out_].frame;
         out_utc_usec = buf_[out_].utc_usec;
+        out_mono_usec = buf_[out_].mono_usec;
         out_flags    = buf_[out_].flags;
         out_++;
         if (out_ >= capacity_)
@@ -196,6 +200,63 @@ void CanIface::RxQueue::reset()
     overflow_cnt_ = 0;
 }
 
+/*
+ * CanIface::TxQueue
+ */
+bool CanIface::TxQueue::push(const CanTxItem& item)
+{
+    if (len_ >= capacity_)
+    {
+        return false;
+    }
+    // the first free slot, after the queued ones
+    const uavcan::uint8_t slot = order_[len_];
+    buf_[slot] = item;
+
+    // queue after every frame of the same or higher priority
+    uavcan::uint8_t pos = len_;
+    while (pos > 0 && item.frame.priorityHigherThan(buf_[order_[pos - 1]].frame))
+    {
+        order_[pos] = order_[pos - 1];
+        pos--;
+    }
+    order_[pos] = slot;
+
+    len_++;
+    if (len_ > peak_len_)
+    {
+        peak_len_ = len_;
+    }
+    return true;
+}
+
+void CanIface::TxQueue::remove(uavcan::uint8_t index)
+{
+    if (index >= len_)
+    {
+        UAVCAN_ASSERT(0);
+        return;
+    }
+    // the freed slot goes to the start of the free ones
+    const uavcan::uint8_t slot = order_[index];
+    for (uavcan::uint8_t i = index; i + 1 < len_; i++)
+    {
+        order_[i] = order_[i + 1];
+    }
+    len_--;
+    order_[len_] = slot;
+}
+
+void CanIface::TxQueue::reset()
+{
+    for (uavcan::uint8_t i = 0; i < capacity_; i++)
+    {
+        order_[i] = i;
+    }
+    len_ = 0;
+    peak_len_ = 0;
+}
+
 /*
  * CanIface
  */
@@ -206,6 +267,13 @@ const uavcan::uint32_t CanIface::TSR_ABRQx[CanIface::NumTxMailboxes] =
     bxcan::TSR_ABRQ2
 };
 
+const uavcan::uint32_t CanIface::TSR_TMEx[CanIface::NumTxMailboxes] =
+{
+    bxcan::TSR_TME0,
+    bxcan::TSR_TME1,
+    bxcan::TSR_TME2
+};
+
 int CanIface::computeTimings(const uavcan::uint32_t target_bitrate, Timings& out_timings)
 {
     if (target_bitrate < 1)
@@ -353,43 +421,71 @@ uavcan::int16_t CanIface::send(const uavcan::CanFrame& frame, uavcan::MonotonicT
         return -ErrUnsupportedFrame;
     }
 
-    /*
-     * Normally we should perform the same check as in @ref canAcceptNewTxFrame(), because
-     * it is possible that the highest-priority frame between select() and send() could have been
-     * replaced with a lower priority one due to TX timeout. But we don't do this check because:
-     *
-     *  - It is a highly unlikely scenario.
-     *
-     *  - Frames do not timeout on a properly functioning bus. Since frames do not timeout, the new
-     *    frame can only have higher priority, which doesn't break the logic.
-     *
-     *  - If high-priority frames are timing out in the TX queue, there's probably a lot of other
-     *    issues to take care of before this one becomes relevant.
-     *
-     *  - It takes CPU time. Not just CPU time, but critical section time, which is expensive.
-     */
+    CanTxItem item;
+    item.deadline       = tx_deadline;
+    item.frame          = frame;
+    item.loopback       = (flags & uavcan::CanIOFlagLoopback) != 0;
+    item.abort_on_error = (flags & uavcan::CanIOFlagAbortOnError) != 0;
+
     CriticalSectionLocker lock;
 
-    /*
-     * Seeking for an empty slot
-     */
-    uavcan::uint8_t txmailbox = 0xFF;
-    if ((can_->TSR & bxcan::TSR_TME0) == bxcan::TSR_TME0)
-    {
-        txmailbox = 0;
-    }
-    else if ((can_->TSR & bxcan::TSR_TME1) == bxcan::TSR_TME1)
-    {
-        txmailbox = 1;
-    }
-    else if ((can_->TSR & bxcan::TSR_TME2) == bxcan::TSR_TME2)
+    item.queued_usec = clock::getMonotonicUSecFromCanInterrupt();
+    if (!tx_queue_.push(item))
     {
-        txmailbox = 2;
+        return 0;       // No transmission for you.
     }
-    else
+    fillTxMailboxes(item.queued_usec);
+    return 1;
+}
+
+/*
+ * Move frames from the TX queue into free mailboxes, highest priority first.
+ * A frame only goes into a mailbox if it has a higher priority than every frame already in
+ * one: bxCAN sends equal identifiers in mailbox order, not queue order, so this keeps the
+ * frames of a transfer in order.
+ * Must be called with interrupts disabled, or from the CAN interrupts.
+ */
+void CanIface::fillTxMailboxes(const uavcan::uint64_t mono_usec)
+{
+    while (tx_queue_.getLength() > 0)
     {
-        return 0;       // No transmission for you.
+        const CanTxItem& item = tx_queue_.get(0);
+        if (item.deadline.toUSec() < mono_usec)
+        {
+            tx_queue_.remove(0);
+            tx_timeouts_cnt_++;
+            error_cnt_++;
+            continue;
+        }
+
+        uavcan::uint8_t txmailbox = 0xFF;
+        for (uavcan::uint8_t mbx = 0; mbx < NumTxMailboxes; mbx++)
+        {
+            if ((can_->TSR & TSR_TMEx[mbx]) == TSR_TMEx[mbx])
+            {
+                if (txmailbox == 0xFF)
+                {
+                    txmailbox = mbx;
+                }
+            }
+            else if (pending_tx_[mbx].pending && !item.frame.priorityHigherThan(pending_tx_[mbx].frame))
+            {
+                return;
+            }
+        }
+        if (txmailbox == 0xFF)
+        {
+            return;
+        }
+
+        loadTxMailbox(txmailbox, item);
+        tx_queue_.remove(0);
     }
+}
+
+void CanIface::loadTxMailbox(const uavcan::uint8_t txmailbox, const CanTxItem& item)
+{
+    const uavcan::CanFrame& frame = item.frame;
 
     peak_tx_mailbox_index_ = uavcan::max(peak_tx_mailbox_index_, txmailbox);    // Statistics
 
@@ -428,27 +524,31 @@ uavcan::int16_t CanIface::send(const uavcan::CanFrame& frame, uavcan::MonotonicT
      * Registering the pending transmission so we can track its deadline and loopback it as needed
      */
     TxItem& txi = pending_tx_[txmailbox];
-    txi.deadline       = tx_deadline;
+    txi.deadline       = item.deadline;
     txi.frame          = frame;
-    txi.loopback       = (flags & uavcan::CanIOFlagLoopback) != 0;
-    txi.abort_on_error = (flags & uavcan::CanIOFlagAbortOnError) != 0;
+    txi.queued_usec    = item.queued_usec;
+    txi.loopback       = item.loopback;
+    txi.abort_on_error = item.abort_on_error;
     txi.pending        = true;
-    return 1;
 }
 
 uavcan::int16_t CanIface::receive(uavcan::CanFrame& out_frame, uavcan::MonotonicTime& out_ts_monotonic,
                                   uavcan::UtcTime& out_ts_utc, uavcan::CanIOFlags& out_flags)
 {
-    out_ts_monotonic = clock::getMonotonic();  // High precision is not required for monotonic timestamps
     uavcan::uint64_t utc_usec = 0;
+    uavcan::uint64_t mono_usec = 0;
     {
         CriticalSectionLocker lock;
         if (rx_queue_.getLength() == 0)
         {
             return 0;
         }
-        rx_queue_.pop(out_frame, utc_usec, out_flags);
+        rx_queue_.pop(out_frame, utc_usec, mono_usec, out_flags);
     }
+    // the frame's monotonic time is taken in the receive interrupt, so
+    // sensor messages carry when they arrived rather than when the
+    // UAVCAN thread got to them
+    out_ts_monotonic = uavcan::MonotonicTime::fromUSec(mono_usec);
     out_ts_utc = uavcan::UtcTime::fromUSec(utc_usec);
     return 1;
 }
@@ -580,11 +680,21 @@ int CanIface::init(const uavcan::uint32_t bitrate, const OperatingMode mode)
      * Object state - interrupts are disabled, so it's safe to modify it now
      */
     rx_queue_.reset();
+    tx_queue_.reset();
     error_cnt_ = 0;
     served_aborts_cnt_ = 0;
     uavcan::fill_n(pending_tx_, NumTxMailboxes, TxItem());
     peak_tx_mailbox_index_ = 0;
     had_activity_ = false;
+    tx_frames_cnt_ = 0;
+    tx_timeouts_cnt_ = 0;
+    tx_latency_avg_usec_ = 0;
+    tx_latency_max_usec_ = 0;
+    rx_frames_cnt_ = 0;
+    rx_fifo_overflow_cnt_ = 0;
+    rx_isr_max_usec_ = 0;
+    bus_off_cnt_ = 0;
+    bus_off_ = false;
 
     /*
      * CAN timings for this bitrate
@@ -664,9 +774,28 @@ void CanIface::handleTxMailboxInterrupt(uavcan::uint8_t mailbox_index, bool txok
 
     TxItem& txi = pending_tx_[mailbox_index];
 
-    if (txi.loopback && txok && txi.pending)
+    if (txok && txi.pending)
     {
-        rx_queue_.push(txi.frame, utc_usec, uavcan::CanIOFlagLoopback);
+        const uavcan::uint64_t mono_usec = clock::getMonotonicUSecFromCanInterrupt();
+        if (txi.loopback)
+        {
+            rx_queue_.push(txi.frame, utc_usec, mono_usec, uavcan::CanIOFlagLoopback);
+        }
+
+        tx_frames_cnt_++;
+        const uavcan::uint32_t latency_usec = uavcan::uint32_t(mono_usec - txi.queued_usec);
+        if (tx_latency_avg_usec_ == 0)
+        {
+            tx_latency_avg_usec_ = latency_usec;
+        }
+        else
+        {
+            tx_latency_avg_usec_ = (tx_latency_avg_usec_ * 15 + latency_usec) / 16;
+        }
+        if (latency_usec > tx_latency_max_usec_)
+        {
+            tx_latency_max_usec_ = latency_usec;
+        }
     }
 
     txi.pending = false;
@@ -693,6 +822,10 @@ void CanIface::handleTxInterrupt(const uavcan::uint64_t utc_usec)
         can_->TSR = bxcan::TSR_RQCP2;
         handleTxMailboxInterrupt(2, txok, utc_usec);
     }
+
+    // refill the freed mailboxes now, rather than when the UAVCAN thread next runs
+    fillTxMailboxes(clock::getMonotonicUSecFromCanInterrupt());
+
     update_event_.signalFromInterrupt();
 
     pollErrorFlagsFromISR();
@@ -706,6 +839,8 @@ void CanIface::handleRxInterrupt(uavcan::uint8_t fifo_index, uavcan::uint64_t ut
 {
     UAVCAN_ASSERT(fifo_index < 2);
 
+    const uavcan::uint64_t mono_usec = clock::getMonotonicUSecFromCanInterrupt();
+
     volatile uavcan::uint32_t* const rfr_reg = (fifo_index == 0) ? &can_->RF0R : &can_->RF1R;
     if ((*rfr_reg & bxcan::RFR_FMP_MASK) == 0)
     {
@@ -719,6 +854,7 @@ void CanIface::handleRxInterrupt(uavcan::uint8_t fifo_index, uavcan::uint64_t ut
     if ((*rfr_reg & bxcan::RFR_FOVR) != 0)
     {
         error_cnt_++;
+        rx_fifo_overflow_cnt_++;
     }
 
     /*
@@ -758,7 +894,8 @@ void CanIface::handleRxInterrupt(uavcan::uint8_t fifo_index, uavcan::uint64_t ut
     /*
      * Store with timeout into the FIFO buffer and signal update event
      */
-    rx_queue_.push(frame, utc_usec, 0);
+    rx_queue_.push(frame, utc_usec, mono_usec, 0);
+    rx_frames_cnt_++;
  #if !HAL_MINIMIZE_FEATURES
     slcan_router().route_frame_to_slcan(this, frame, utc_usec);
 #endif
@@ -767,6 +904,12 @@ void CanIface::handleRxInterrupt(uavcan::uint8_t fifo_index, uavcan::uint64_t ut
 
     pollErrorFlagsFromISR();
 
+    const uavcan::uint32_t isr_usec = clock::getMonotonicUSecFromCanInterrupt() - mono_usec;
+    if (isr_usec > rx_isr_max_usec_)
+    {
+        rx_isr_max_usec_ = isr_usec;
+    }
+
     #if UAVCAN_STM32_FREERTOS
     update_event_.yieldFromISR();
     #endif
@@ -774,7 +917,19 @@ void CanIface::handleRxInterrupt(uavcan::uint8_t fifo_index, uavcan::uint64_t ut
 
 void CanIface::pollErrorFlagsFromISR()
 {
-    const uavcan::uint8_t lec = uavcan::uint8_t((can_->ESR & bxcan::ESR_LEC_MASK) >> bxcan::ESR_LEC_SHIFT);
+    const uavcan::uint32_t esr = can_->ESR;
+
+    /*
+     * Count each time the controller goes bus-off; it recovers by itself (ABOM)
+     */
+    const bool bus_off = (esr & bxcan::ESR_BOFF) != 0;
+    if (bus_off && !bus_off_)
+    {
+        bus_off_cnt_++;
+    }
+    bus_off_ = bus_off;
+
+    const uavcan::uint8_t lec = uavcan::uint8_t((esr & bxcan::ESR_LEC_MASK) >> bxcan::ESR_LEC_SHIFT);
     if (lec != 0)
     {
         can_->ESR = 0;
@@ -807,44 +962,31 @@ void CanIface::discardTimedOutTxMailboxes(uavcan::MonotonicTime current_time)
             error_cnt_++;
         }
     }
-}
-
-bool CanIface::canAcceptNewTxFrame(const uavcan::CanFrame& frame) const
-{
-    /*
-     * We can accept more frames only if the following conditions are satisfied:
-     *  - There is at least one TX mailbox free (obvious enough);
-     *  - The priority of the new frame is higher than priority of all TX mailboxes.
-     */
+    for (uavcan::uint8_t i = 0; i < tx_queue_.getLength();)
     {
-        static const uavcan::uint32_t TME = bxcan::TSR_TME0 | bxcan::TSR_TME1 | bxcan::TSR_TME2;
-        const uavcan::uint32_t tme = can_->TSR & TME;
-
-        if (tme == TME)     // All TX mailboxes are free (as in freedom).
+        if (tx_queue_.get(i).deadline < current_time)
         {
-            return true;
+            tx_queue_.remove(i);
+            tx_timeouts_cnt_++;
+            error_cnt_++;
         }
-
-        if (tme == 0)       // All TX mailboxes are busy transmitting.
+        else
         {
-            return false;
+            i++;
         }
     }
+    fillTxMailboxes(current_time.toUSec());
+}
 
+bool CanIface::canAcceptNewTxFrame(const uavcan::CanFrame& frame) const
+{
     /*
-     * The second condition requires a critical section.
+     * The TX queue orders frames by priority, so any frame can be accepted while it has room.
+     * When it is full the frame waits in the library's queue, which is also in priority order.
      */
+    (void)frame;
     CriticalSectionLocker lock;
-
-    for (int mbx = 0; mbx < NumTxMailboxes; mbx++)
-    {
-        if (pending_tx_[mbx].pending && !frame.priorityHigherThan(pending_tx_[mbx].frame))
-        {
-            return false;       // There's a mailbox whose priority is higher or equal the priority of the new frame.
-        }
-    }
-
-    return true;                // This new frame will be added to a free TX mailbox in the next @ref send().
+    return !tx_queue_.isFull();
 }
 
 bool CanIface::isRxBufferEmpty() const
@@ -865,6 +1007,12 @@ unsigned CanIface::getRxQueueLength() const
     return rx_queue_.getLength();
 }
 
+unsigned CanIface::getTxQueueLength() const
+{
+    CriticalSectionLocker lock;
+    return tx_queue_.getLength();
+}
+
 bool CanIface::hadActivity()
 {
     CriticalSectionLocker lock;
@@ -55,7 +55,9 @@ void DeviceBus::bus_thread(void *arg)
                 }
                 // call it with semaphore held
                 if (binfo->semaphore.take(HAL_SEMAPHORE_BLOCK_FOREVER)) {
+                    hal.util->perf_begin(binfo->perf_callbacks);
                     callback->cb();
+                    hal.util->perf_end(binfo->perf_callbacks);
                     binfo->semaphore.give();
                 }
             }
@@ -114,6 +116,8 @@ AP_HAL::Device::PeriodicHandle DeviceBus::register_periodic_callback(uint32_t pe
             break;
         }
 
+        perf_callbacks = hal.util->perf_alloc(AP_HAL::Util::PC_ELAPSED, name);
+
         thread_ctx = thread_create_alloc(THD_WORKING_AREA_SIZE(1024),
                                          name,
                                          thread_priority,           /* Initial priority.    */
@@ -42,6 +42,11 @@ public:
     void bouncebuffer_setup(const uint8_t *&buf_tx, uint16_t tx_len,
                             uint8_t *&buf_rx, uint16_t rx_len);
     void bouncebuffer_finish(const uint8_t *buf_tx, uint8_t *buf_rx, uint16_t rx_len);
+
+    // time the bus has been held by any device and the number of
+    // transactions on it, for AP_HAL::Device::get_bus_stats()
+    uint32_t busy_us;
+    uint32_t transactions;
     
 private:
     struct callback_info {
@@ -53,6 +58,8 @@ private:
     uint8_t thread_priority;
     thread_t* thread_ctx;
     bool thread_started;
+    // time spent in the bus thread's callbacks
+    AP_HAL::Util::perf_counter_t perf_callbacks;
     AP_HAL::Device *hal_device;
 
     // support for bounce buffers for DMA-safe transfers
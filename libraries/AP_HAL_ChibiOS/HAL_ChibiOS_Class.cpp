@@ -196,6 +196,7 @@ static void main_loop()
 
     while (true) {
         g_callbacks->loop();
+        schedulerInstance.main_loop_heartbeat();
 
         /*
           give up 50 microseconds of time if the INS loop hasn't
@@ -189,14 +189,8 @@ void I2CBus::dma_deallocate(Shared_DMA *)
 {
 }
 
-bool I2CDevice::transfer(const uint8_t *send, uint32_t send_len,
-                         uint8_t *recv, uint32_t recv_len)
+void I2CDevice::_set_op_mode()
 {
-    if (!bus.semaphore.check_owner()) {
-        hal.console->printf("I2C: not owner of 0x%x\n", (unsigned)get_bus_id());
-        return false;
-    }
-    
 #if defined(STM32F7) || defined(STM32H7)
     if (_use_smbus) {
         bus.i2ccfg.cr1 |= I2C_CR1_SMBHEN;
@@ -210,6 +204,25 @@ bool I2CDevice::transfer(const uint8_t *send, uint32_t send_len,
         bus.i2ccfg.op_mode = OPMODE_I2C;
     }
 #endif
+}
+
+void I2CDevice::_add_busy_time(uint32_t start_us, uint8_t transactions)
+{
+    const uint32_t held_us = AP_HAL::micros() - start_us;
+    busy_us += held_us;
+    bus.busy_us += held_us;
+    bus.transactions += transactions;
+}
+
+bool I2CDevice::transfer(const uint8_t *send, uint32_t send_len,
+                         uint8_t *recv, uint32_t recv_len)
+{
+    if (!bus.semaphore.check_owner()) {
+        hal.console->printf("I2C: not owner of 0x%x\n", (unsigned)get_bus_id());
+        return false;
+    }
+
+    _set_op_mode();
 
     if (_split_transfers) {
         /*
@@ -237,9 +250,78 @@ bool I2CDevice::transfer(const uint8_t *send, uint32_t send_len,
     return true;
 }
 
+/*
+  do a batch of transfers with the bus acquired and started once
+ */
+uint8_t I2CDevice::transfer_batch(const BatchTransfer *transfers, uint8_t count)
+{
+    if (!bus.semaphore.check_owner()) {
+        hal.console->printf("I2C: not owner of 0x%x\n", (unsigned)get_bus_id());
+        return 0;
+    }
+    if (_split_transfers || count == 0) {
+        return AP_HAL::I2CDevice::transfer_batch(transfers, count);
+    }
+
+    _set_op_mode();
+
+    const uint32_t start_us = AP_HAL::micros();
+    i2cAcquireBus(I2CD[bus.busnum].i2c);
+    bus.dma_handle->lock();
+    i2cStart(I2CD[bus.busnum].i2c, &bus.i2ccfg);
+    osalDbgAssert(I2CD[bus.busnum].i2c->state == I2C_READY, "i2cStart state");
+
+    uint8_t done = 0;
+    while (done < count &&
+           _transfer_started(transfers[done].send, transfers[done].send_len,
+                             transfers[done].recv, transfers[done].recv_len)) {
+        done++;
+    }
+
+    i2cStop(I2CD[bus.busnum].i2c);
+    osalDbgAssert(I2CD[bus.busnum].i2c->state == I2C_STOP, "i2cStart state");
+    bus.dma_handle->unlock();
+    i2cReleaseBus(I2CD[bus.busnum].i2c);
+    _add_busy_time(start_us, done < count ? done+1 : done);
+
+    // carry on from a failed transfer one at a time, with the retries
+    // and bus recovery of transfer()
+    while (done < count &&
+           _transfer(transfers[done].send, transfers[done].send_len,
+                     transfers[done].recv, transfers[done].recv_len)) {
+        done++;
+    }
+    return done;
+}
+
+/*
+  one attempt at a transfer on a started bus
+ */
+bool I2CDevice::_transfer_started(const uint8_t *send, uint32_t send_len,
+                                  uint8_t *recv, uint32_t recv_len)
+{
+    bus.bouncebuffer_setup(send, send_len, recv, recv_len);
+
+    // calculate a timeout as twice the expected transfer time, and set as min of 4ms
+    uint32_t timeout_ms = 1+2*(((8*1000000UL/bus.busclock)*MAX(send_len, recv_len))/1000);
+    timeout_ms = MAX(timeout_ms, _timeout_ms);
+
+    int ret;
+    if (send_len == 0) {
+        ret = i2cMasterReceiveTimeout(I2CD[bus.busnum].i2c, _address, recv, recv_len, chTimeMS2I(timeout_ms));
+    } else {
+        ret = i2cMasterTransmitTimeout(I2CD[bus.busnum].i2c, _address, send, send_len,
+                                       recv, recv_len, chTimeMS2I(timeout_ms));
+    }
+
+    bus.bouncebuffer_finish(send, recv, recv_len);
+    return ret == MSG_OK;
+}
+
 bool I2CDevice::_transfer(const uint8_t *send, uint32_t send_len,
                          uint8_t *recv, uint32_t recv_len)
 {
+    const uint32_t start_us = AP_HAL::micros();
     i2cAcquireBus(I2CD[bus.busnum].i2c);
 
     bus.bouncebuffer_setup(send, send_len, recv, recv_len);
@@ -273,6 +355,7 @@ bool I2CDevice::_transfer(const uint8_t *send, uint32_t send_len,
         if (ret == MSG_OK) {
             bus.bouncebuffer_finish(send, recv, recv_len);
             i2cReleaseBus(I2CD[bus.busnum].i2c);
+            _add_busy_time(start_us, i+1);
             return true;
         }
 #if HAL_I2C_CLEAR_ON_TIMEOUT
@@ -283,6 +366,7 @@ bool I2CDevice::_transfer(const uint8_t *send, uint32_t send_len,
     }
     bus.bouncebuffer_finish(send, recv, recv_len);
     i2cReleaseBus(I2CD[bus.busnum].i2c);
+    _add_busy_time(start_us, _retries+1);
     return false;
 }
 
@@ -77,9 +77,22 @@ public:
     bool transfer(const uint8_t *send, uint32_t send_len,
                   uint8_t *recv, uint32_t recv_len) override;
 
+    /* See AP_HAL::Device::transfer_batch() */
+    uint8_t transfer_batch(const BatchTransfer *transfers, uint8_t count) override;
+
     bool read_registers_multiple(uint8_t first_reg, uint8_t *recv,
                                  uint32_t recv_len, uint8_t times) override;
 
+    /* See AP_HAL::Device::get_bus_busy_us() */
+    uint32_t get_bus_busy_us() const override { return busy_us; }
+
+    /* See AP_HAL::Device::get_bus_stats() */
+    bool get_bus_stats(uint32_t &_busy_us, uint32_t &_transactions) const override {
+        _busy_us = bus.busy_us;
+        _transactions = bus.transactions;
+        return true;
+    }
+
     /* See AP_HAL::Device::register_periodic_callback() */
     AP_HAL::Device::PeriodicHandle register_periodic_callback(
         uint32_t period_usec, AP_HAL::Device::PeriodicCb) override;
@@ -100,6 +113,13 @@ private:
     I2CBus &bus;
     bool _transfer(const uint8_t *send, uint32_t send_len,
                          uint8_t *recv, uint32_t recv_len);
+    bool _transfer_started(const uint8_t *send, uint32_t send_len,
+                           uint8_t *recv, uint32_t recv_len);
+    void _set_op_mode();
+    void _add_busy_time(uint32_t start_us, uint8_t transactions);
+
+    // time this device has held the bus
+    uint32_t busy_us;
 
     /* I2C interface #2 */
     uint8_t _retries;
@@ -131,9 +131,22 @@ void RCInput::_timer_tick(void)
 #endif
 
 #if HAL_USE_EICU == TRUE
+    // hand the pulses over in lists, as for the ICU reader, so the
+    // protocol checks are done once a list rather than once a pulse
+    const uint8_t max_widths = 16;
+    uint32_t widths[max_widths];
+    uint8_t nwidths = 0;
     uint32_t width_s0, width_s1;
     while(sig_reader.read(width_s0, width_s1)) {
-        rcin_prot.process_pulse(width_s0, width_s1);
+        widths[nwidths++] = width_s0;
+        widths[nwidths++] = width_s0 + width_s1;
+        if (nwidths == max_widths) {
+            rcin_prot.process_pulse_list(widths, nwidths, false);
+            nwidths = 0;
+        }
+    }
+    if (nwidths > 0) {
+        rcin_prot.process_pulse_list(widths, nwidths, false);
     }
 #endif
 
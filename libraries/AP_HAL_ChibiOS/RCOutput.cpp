@@ -18,6 +18,7 @@
 #include <AP_Math/AP_Math.h>
 #include <AP_BoardConfig/AP_BoardConfig.h>
 #include <AP_HAL/utility/RingBuffer.h>
+#include <AP_HAL/utility/DShotTelem.h>
 #include "GPIO.h"
 #include "hwdef/common/stm32_util.h"
 
@@ -554,11 +555,14 @@ bool RCOutput::setup_group_DMA(pwm_group &group, uint32_t bitrate, uint32_t bit_
 
     for (uint8_t j=0; j<4; j++) {
         pwmmode_t mode = group.pwm_cfg.channels[j].mode;
+        // bidirectional DShot idles high, so the ESC can pull the
+        // line low to answer
+        const bool high = active_high && !(group.bdshot.mask & (1U<<j));
         if (mode != PWM_OUTPUT_DISABLED) {
             if(mode == PWM_COMPLEMENTARY_OUTPUT_ACTIVE_LOW || mode == PWM_COMPLEMENTARY_OUTPUT_ACTIVE_HIGH) {
-               group.pwm_cfg.channels[j].mode = active_high?PWM_COMPLEMENTARY_OUTPUT_ACTIVE_HIGH:PWM_COMPLEMENTARY_OUTPUT_ACTIVE_LOW;
+               group.pwm_cfg.channels[j].mode = high?PWM_COMPLEMENTARY_OUTPUT_ACTIVE_HIGH:PWM_COMPLEMENTARY_OUTPUT_ACTIVE_LOW;
             } else {
-               group.pwm_cfg.channels[j].mode = active_high?PWM_OUTPUT_ACTIVE_HIGH:PWM_OUTPUT_ACTIVE_LOW;
+               group.pwm_cfg.channels[j].mode = high?PWM_OUTPUT_ACTIVE_HIGH:PWM_OUTPUT_ACTIVE_LOW;
             }
         }
     }
@@ -589,6 +593,7 @@ void RCOutput::set_group_mode(pwm_group &group)
         pwmStop(group.pwm_drv);
         group.pwm_started = false;
     }
+    group.bdshot.count = 0;
     
     switch (group.current_mode) {
     case MODE_PWM_BRUSHED:
@@ -615,6 +620,20 @@ void RCOutput::set_group_mode(pwm_group &group)
 
         // calculate min time between pulses
         dshot_pulse_time_us = 1000000UL * dshot_bit_length / rate;
+
+        if (group.bdshot.mask != 0) {
+            if (!group.bdshot.buffer) {
+                group.bdshot.buffer = (uint16_t *)hal.util->malloc_type(bdshot_max_samples*sizeof(uint16_t),
+                                                                        AP_HAL::Util::MEM_DMA_SAFE);
+            }
+            if (group.bdshot.buffer) {
+                // sample from the end of the frame until a 21 bit
+                // reply at 5/4 of the bit rate must have finished
+                const uint32_t bits = (rate * bdshot_reply_delay_us) / 1000000UL + 21;
+                group.bdshot.count = MIN(bits * bdshot_samples_per_bit, bdshot_max_samples);
+                group.bdshot.sample_period = bit_period / bdshot_samples_per_bit;
+            }
+        }
         break;
     }
    
@@ -734,7 +753,11 @@ bool RCOutput::enable_px4io_sbus_out(uint16_t rate_hz)
  */
 void RCOutput::trigger_groups(void)
 {
-    if (!chMtxTryLock(&trigger_mutex)) {
+    if (output_sync) {
+        // wait out a trigger from timer_tick() rather than lose this
+        // update until the next one
+        chMtxLock(&trigger_mutex);
+    } else if (!chMtxTryLock(&trigger_mutex)) {
         return;
     }
     uint64_t now = AP_HAL::micros64();
@@ -764,7 +787,9 @@ void RCOutput::trigger_groups(void)
         for (uint8_t i = 0; i < NUM_GROUPS; i++) {
             pwm_group &group = pwm_group_list[i];
             if (group.current_mode >= MODE_PWM_DSHOT150 && group.current_mode <= MODE_PWM_DSHOT1200) {
-                dshot_send(group, false);
+                // with output sync, wait for the DMA to be free so the
+                // frame goes out now rather than at the next resend
+                dshot_send(group, output_sync);
             }
         }
     }
@@ -787,12 +812,13 @@ void RCOutput::timer_tick(void)
     safety_update();
     
     uint64_t now = AP_HAL::micros64();
+    const uint16_t keepalive_us = output_sync ? dshot_sync_keepalive_us : dshot_keepalive_us;
     for (uint8_t i = 0; i < NUM_GROUPS; i++ ) {
         pwm_group &group = pwm_group_list[i];
         if (!serial_group &&
             group.current_mode >= MODE_PWM_DSHOT150 &&
             group.current_mode <= MODE_PWM_DSHOT1200 &&
-            now - group.last_dshot_send_us > 400) {
+            now - group.last_dshot_send_us > keepalive_us) {
             // do a blocking send now, to guarantee DShot sends at
             // above 1000 Hz. This makes the protocol more reliable on
             // long cables, and also keeps some ESCs happy that don't
@@ -850,7 +876,7 @@ void RCOutput::dma_deallocate(Shared_DMA *ctx)
 /*
   create a DSHOT 16 bit packet. Based on prepareDshotPacket from betaflight
  */
-uint16_t RCOutput::create_dshot_packet(const uint16_t value, bool telem_request)
+uint16_t RCOutput::create_dshot_packet(const uint16_t value, bool telem_request, bool bidir)
 {
     uint16_t packet = (value << 1);
 
@@ -865,6 +891,10 @@ uint16_t RCOutput::create_dshot_packet(const uint16_t value, bool telem_request)
         csum ^= csum_data;
         csum_data >>= 4;
     }
+    // an inverted checksum asks the ESC for a bidirectional reply
+    if (bidir) {
+        csum = ~csum;
+    }
     csum &= 0xf;
     // append checksum
     packet = (packet << 4) | csum;
@@ -913,6 +943,11 @@ void RCOutput::dshot_send(pwm_group &group, bool blocking)
         }
     }
     
+    if (group.bdshot.have_samples) {
+        // the lock means the replies to the last frame are all in
+        bdshot_decode(group);
+    }
+
     bool safety_on = hal.util->safety_switch_state() == AP_HAL::Util::SAFETY_DISARMED;
 
     memset((uint8_t *)group.dma_buffer, 0, dshot_buffer_length);
@@ -953,7 +988,8 @@ void RCOutput::dshot_send(pwm_group &group, bool blocking)
             }
 
             bool request_telemetry = (telem_request_mask & chan_mask)?true:false;
-            uint16_t packet = create_dshot_packet(value, request_telemetry);
+            const bool bidir = group.bdshot.count != 0 && (group.bdshot.mask & (1U<<i));
+            uint16_t packet = create_dshot_packet(value, request_telemetry, bidir);
             if (request_telemetry) {
                 telem_request_mask &= ~chan_mask;
             }
@@ -1031,13 +1067,192 @@ void RCOutput::dma_irq_callback(void *p, uint32_t flags)
     if (group->in_serial_dma && irq.waiter) {
         // tell the waiting process we've done the DMA
         chEvtSignalI(irq.waiter, serial_event_mask);
+    } else if (group->bdshot.count != 0 && !group->bdshot.receiving) {
+        // the frame is out, keep the DMA to sample the replies
+        bdshot_start_receive(*group);
     } else {
+        if (group->bdshot.receiving) {
+            bdshot_finish_receive(*group);
+        }
         // this prevents us ever having two dshot pulses too close together
         chVTSetI(&group->dma_timeout, chTimeUS2I(dshot_min_gap_us), dma_unlock, p);
     }
     chSysUnlockFromISR();
 }
 
+/*
+  work out which channels of a group can do bidirectional DShot. The
+  replies are sampled from a single GPIO input register, so only the
+  channels on the same port as the first one are used
+ */
+uint8_t RCOutput::bdshot_group_mask(const pwm_group &group) const
+{
+#ifndef DISABLE_DSHOT
+    if (!group.have_up_dma) {
+        return 0;
+    }
+#if defined(STM32F4) || defined(STM32F7)
+    // only DMA2 can read the GPIO ports on these MCUs, which limits
+    // this to the groups on TIM1 and TIM8
+    if (group.dma_up_stream_id < STM32_DMA_STREAM_ID(2, 0)) {
+        return 0;
+    }
+#endif
+    uint8_t mask = 0;
+    ioportid_t port = nullptr;
+    for (uint8_t j=0; j<4; j++) {
+        const uint8_t chan = group.chan[j];
+        if (chan == CHAN_DISABLED || !(bidir_dshot_mask & (1U<<chan))) {
+            continue;
+        }
+        if (port == nullptr) {
+            port = PAL_PORT(group.pal_lines[j]);
+        }
+        if (PAL_PORT(group.pal_lines[j]) == port) {
+            mask |= 1U<<j;
+        }
+    }
+    return mask;
+#else
+    return 0;
+#endif
+}
+
+/*
+  enable bidirectional DShot for a mask of channels
+ */
+void RCOutput::set_bidir_dshot_mask(uint16_t mask)
+{
+    bidir_dshot_mask = mask >> chan_offset;
+    for (uint8_t i = 0; i < NUM_GROUPS; i++ ) {
+        pwm_group &group = pwm_group_list[i];
+        const uint8_t group_mask = bdshot_group_mask(group);
+        if (group_mask == group.bdshot.mask) {
+            continue;
+        }
+        group.bdshot.mask = group_mask;
+        if (group.current_mode >= MODE_PWM_DSHOT150 &&
+            group.current_mode <= MODE_PWM_DSHOT1200) {
+            // setup again for the new output polarity
+            set_group_mode(group);
+        }
+    }
+}
+
+/*
+  start sampling the replies once a bidirectional DShot frame is
+  out. The outputs are turned into inputs and the UP DMA that sent
+  the frame copies the GPIO input register into the sample buffer on
+  each update of the timer, which is sped up to the sample rate.
+  Called from the DMA interrupt
+ */
+void RCOutput::bdshot_start_receive(pwm_group &group)
+{
+#ifndef DISABLE_DSHOT
+    ioportid_t port = nullptr;
+    for (uint8_t j=0; j<4; j++) {
+        if (group.bdshot.mask & (1U<<j)) {
+            palSetLineMode(group.pal_lines[j], PAL_MODE_INPUT_PULLUP);
+            if (port == nullptr) {
+                port = PAL_PORT(group.pal_lines[j]);
+            }
+        }
+    }
+
+    stm32_tim_t *tim = group.pwm_drv->tim;
+    tim->ARR = group.bdshot.sample_period - 1;
+    tim->CNT = 0;
+
+    dmaStreamSetPeripheral(group.dma, &port->IDR);
+    dmaStreamSetMemory0(group.dma, group.bdshot.buffer);
+    dmaStreamSetTransactionSize(group.dma, group.bdshot.count);
+    dmaStreamSetFIFO(group.dma, STM32_DMA_FCR_DMDIS | STM32_DMA_FCR_FTH_FULL);
+    dmaStreamSetMode(group.dma,
+                     STM32_DMA_CR_CHSEL(group.dma_up_channel) |
+                     STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_PSIZE_HWORD | STM32_DMA_CR_MSIZE_HWORD |
+                     STM32_DMA_CR_MINC | STM32_DMA_CR_PL(3) |
+                     STM32_DMA_CR_TEIE | STM32_DMA_CR_TCIE);
+    group.bdshot.receiving = true;
+    dmaStreamEnable(group.dma);
+#endif //#ifndef DISABLE_DSHOT
+}
+
+/*
+  put a group back to sending frames once the replies are sampled.
+  Called from the DMA interrupt
+ */
+void RCOutput::bdshot_finish_receive(pwm_group &group)
+{
+#ifndef DISABLE_DSHOT
+    stm32_tim_t *tim = group.pwm_drv->tim;
+    tim->ARR = group.pwm_cfg.period - 1;
+    tim->CNT = 0;
+
+    for (uint8_t j=0; j<4; j++) {
+        if (group.bdshot.mask & (1U<<j)) {
+            palSetLineMode(group.pal_lines[j],
+                           PAL_MODE_ALTERNATE(group.alt_functions[j]) | PAL_STM32_OSPEED_MID2 | PAL_STM32_OTYPE_PUSHPULL);
+        }
+    }
+    group.bdshot.receiving = false;
+    group.bdshot.have_samples = true;
+#endif //#ifndef DISABLE_DSHOT
+}
+
+/*
+  decode the sampled replies of a group. Called with the DMA lock held
+ */
+void RCOutput::bdshot_decode(pwm_group &group)
+{
+#ifndef DISABLE_DSHOT
+    group.bdshot.have_samples = false;
+    cacheBufferInvalidate(group.bdshot.buffer, group.bdshot.count*sizeof(uint16_t));
+
+    // samples per reply bit, which is at 5/4 of the frame bit rate
+    const uint32_t samples_per_bit_x256 = (bdshot_samples_per_bit * 256U * 4U) / 5U;
+    const uint32_t now_ms = AP_HAL::millis();
+    for (uint8_t j=0; j<4; j++) {
+        if (!(group.bdshot.mask & (1U<<j))) {
+            continue;
+        }
+        const uint16_t pin_mask = 1U << PAL_PAD(group.pal_lines[j]);
+        uint32_t erpm;
+        if (DShotTelem::decode_samples(group.bdshot.buffer, group.bdshot.count, pin_mask,
+                                       samples_per_bit_x256, erpm)) {
+            group.bdshot.erpm[j] = erpm;
+            group.bdshot.erpm_ms[j] = now_ms;
+        }
+    }
+#endif //#ifndef DISABLE_DSHOT
+}
+
+/*
+  get the last eRPM received over bidirectional DShot
+ */
+bool RCOutput::get_erpm(uint8_t chan, uint32_t &erpm)
+{
+    if (chan < chan_offset) {
+        return false;
+    }
+    chan -= chan_offset;
+    for (uint8_t i = 0; i < NUM_GROUPS; i++ ) {
+        const pwm_group &group = pwm_group_list[i];
+        for (uint8_t j=0; j<4; j++) {
+            if (group.chan[j] != chan) {
+                continue;
+            }
+            if (!(group.bdshot.mask & (1U<<j)) ||
+                group.bdshot.erpm_ms[j] == 0 ||
+                AP_HAL::millis() - group.bdshot.erpm_ms[j] > 100) {
+                return false;
+            }
+            erpm = group.bdshot.erpm[j];
+            return true;
+        }
+    }
+    return false;
+}
+
 /*
   setup for serial output to an ESC using the given
   baudrate. Assumes 1 start bit, 1 stop bit, LSB first and 8
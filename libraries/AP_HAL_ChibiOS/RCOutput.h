@@ -56,6 +56,7 @@ public:
     
     void     cork(void) override;
     void     push(void) override;
+    void     set_output_sync(bool sync) override { output_sync = sync; }
 
     /*
       force the safety switch on, disabling PWM output from the IO board
@@ -131,6 +132,16 @@ public:
      */
     void set_telem_request_mask(uint16_t mask) override { telem_request_mask = (mask >> chan_offset); }
 
+    /*
+      enable bidirectional DShot for a mask of channels
+     */
+    void set_bidir_dshot_mask(uint16_t mask) override;
+
+    /*
+      get the last eRPM received over bidirectional DShot
+     */
+    bool get_erpm(uint8_t chan, uint32_t &erpm) override;
+
     /*
       get safety switch state, used by Util.cpp
     */
@@ -182,6 +193,23 @@ private:
         bool in_serial_dma;
         uint64_t last_dshot_send_us;
         virtual_timer_t dma_timeout;
+
+        // bidirectional DShot replies, sampled from the GPIO input
+        // register with the UP DMA once a frame is out
+        struct {
+            // channels within group (0 to 3) expecting replies
+            uint8_t mask;
+            // the UP DMA is sampling replies
+            bool receiving;
+            // samples are waiting to be decoded
+            bool have_samples;
+            uint16_t *buffer;
+            uint16_t count;
+            // timer ticks per sample
+            uint16_t sample_period;
+            uint32_t erpm[4];
+            uint32_t erpm_ms[4];
+        } bdshot;
         
         // serial output
         struct {
@@ -278,6 +306,9 @@ private:
     // are we using oneshot125 for the iomcu?
     bool iomcu_oneshot125;
 
+    // send on push() without dropping updates, see set_output_sync()
+    bool output_sync;
+
     // push out values to local PWM
     void push_local(void);
 
@@ -308,12 +339,25 @@ private:
     const uint16_t dshot_bit_length = 16 + dshot_pre + dshot_post;
     const uint16_t dshot_buffer_length = dshot_bit_length*4*sizeof(uint32_t);
     static const uint16_t dshot_min_gap_us = 100;
+    // DShot resend interval when there are no pushes. With output
+    // sync the pushes set the frame rate, and a resend just before a
+    // push would hold it up
+    static const uint16_t dshot_keepalive_us = 400;
+    static const uint16_t dshot_sync_keepalive_us = 2500;
     uint32_t dshot_pulse_time_us;
     uint16_t telem_request_mask;
-    
+    uint16_t bidir_dshot_mask;
+
+    // the ESC reply starts about 30us after the end of a frame. The
+    // replies are sampled at 4 times the frame bit rate, so 3.2
+    // samples per reply bit
+    static const uint16_t bdshot_reply_delay_us = 30;
+    static const uint8_t bdshot_samples_per_bit = 4;
+    static const uint16_t bdshot_max_samples = 256;
+
     void dma_allocate(Shared_DMA *ctx);
     void dma_deallocate(Shared_DMA *ctx);    
-    uint16_t create_dshot_packet(const uint16_t value, bool telem_request);
+    uint16_t create_dshot_packet(const uint16_t value, bool telem_request, bool bidir);
     void fill_DMA_buffer_dshot(uint32_t *buffer, uint8_t stride, uint16_t packet, uint16_t clockmul);
     void dshot_send(pwm_group &group, bool blocking);
     static void dma_irq_callback(void *p, uint32_t flags);
@@ -322,6 +366,10 @@ private:
     bool setup_group_DMA(pwm_group &group, uint32_t bitrate, uint32_t bit_width, bool active_high);
     void send_pulses_DMAR(pwm_group &group, uint32_t buffer_length);
     void set_group_mode(pwm_group &group);
+    uint8_t bdshot_group_mask(const pwm_group &group) const;
+    static void bdshot_start_receive(pwm_group &group);
+    static void bdshot_finish_receive(pwm_group &group);
+    void bdshot_decode(pwm_group &group);
 
     // serial output support
     static const eventmask_t serial_event_mask = EVENT_MASK(1);
@@ -279,6 +279,60 @@ bool SPIDevice::transfer_fullduplex(const uint8_t *send, uint8_t *recv, uint32_t
     return true;
 }
 
+/*
+  send the header and start the DMA receive of the rest of the
+  transfer, leaving the chip select asserted until transfer_finish()
+ */
+bool SPIDevice::transfer_start(const uint8_t *send, uint32_t send_len,
+                               uint8_t *recv, uint32_t recv_len)
+{
+#if defined(HAL_SPI_USE_POLLED)
+    return transfer(send, send_len, recv, recv_len);
+#else
+    if (!bus.semaphore.check_owner() || async.active) {
+        return false;
+    }
+    if (recv == nullptr || recv_len == 0) {
+        return transfer(send, send_len, nullptr, 0);
+    }
+    async.old_cs_forced = cs_forced;
+    if (!set_chip_select(true)) {
+        return false;
+    }
+    if (send_len > 0) {
+        do_transfer(send, nullptr, send_len);
+    }
+    const uint8_t *no_send = nullptr;
+    bus.bouncebuffer_setup(no_send, 0, recv, recv_len);
+    async.recv = recv;
+    async.len = recv_len;
+    async.active = true;
+    spiStartReceive(spi_devices[device_desc.bus].driver, recv_len, recv);
+    return true;
+#endif
+}
+
+/*
+  wait for the DMA receive started by transfer_start()
+ */
+bool SPIDevice::transfer_finish()
+{
+    if (!async.active) {
+        return true;
+    }
+    SPIDriver *spip = spi_devices[device_desc.bus].driver;
+    osalSysLock();
+    if (spip->state == SPI_ACTIVE) {
+        // woken by the end of transfer interrupt
+        osalThreadSuspendS(&spip->thread);
+    }
+    osalSysUnlock();
+    bus.bouncebuffer_finish(nullptr, async.recv, async.len);
+    async.active = false;
+    set_chip_select(async.old_cs_forced);
+    return true;
+}
+
 AP_HAL::Semaphore *SPIDevice::get_semaphore()
 {
     return &bus.semaphore;
@@ -314,8 +368,13 @@ bool SPIDevice::acquire_bus(bool set, bool skip_cs)
         spiReleaseBus(spi_devices[device_desc.bus].driver);              /* Ownership release.               */
         cs_forced = false;
         bus.dma_handle->unlock();
+        const uint32_t held_us = AP_HAL::micros() - acquire_us;
+        busy_us += held_us;
+        bus.busy_us += held_us;
+        bus.transactions++;
     } else {
         bus.dma_handle->lock();
+        acquire_us = AP_HAL::micros();
         spiAcquireBus(spi_devices[device_desc.bus].driver);              /* Acquire ownership of the bus.    */
         bus.spicfg.end_cb = nullptr;
         bus.spicfg.ssport = PAL_PORT(device_desc.pal_line);
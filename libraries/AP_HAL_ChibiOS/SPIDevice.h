@@ -85,6 +85,23 @@ public:
     bool transfer_fullduplex(const uint8_t *send, uint8_t *recv,
                              uint32_t len) override;
 
+    /* See AP_HAL::Device::transfer_start() */
+    bool transfer_start(const uint8_t *send, uint32_t send_len,
+                        uint8_t *recv, uint32_t recv_len) override;
+
+    /* See AP_HAL::Device::transfer_finish() */
+    bool transfer_finish() override;
+
+    /* See AP_HAL::Device::get_bus_busy_us() */
+    uint32_t get_bus_busy_us() const override { return busy_us; }
+
+    /* See AP_HAL::Device::get_bus_stats() */
+    bool get_bus_stats(uint32_t &_busy_us, uint32_t &_transactions) const override {
+        _busy_us = bus.busy_us;
+        _transactions = bus.transactions;
+        return true;
+    }
+
     /* 
      *  send N bytes of clock pulses without taking CS. This is used
      *  when initialising microSD interfaces over SPI
@@ -124,6 +141,18 @@ private:
     uint32_t freq_flag_high;
     char *pname;
     bool cs_forced;
+
+    // receive started by transfer_start()
+    struct {
+        bool active;
+        bool old_cs_forced;
+        uint8_t *recv;
+        uint32_t len;
+    } async;
+
+    // time the bus has been held, and when it was last acquired
+    uint32_t busy_us;
+    uint32_t acquire_us;
     static void *spi_thread(void *arg);
     static uint32_t derive_freq_flag_bus(uint8_t busid, uint32_t _frequency);
     uint32_t derive_freq_flag(uint32_t _frequency);
@@ -56,6 +56,28 @@ THD_WORKING_AREA(_io_thread_wa, IO_THD_WA_SIZE);
 #ifndef HAL_USE_EMPTY_STORAGE
 THD_WORKING_AREA(_storage_thread_wa, STORAGE_THD_WA_SIZE);
 #endif
+#ifndef HAL_NO_MONITOR_THREAD
+THD_WORKING_AREA(_monitor_thread_wa, MONITOR_THD_WA_SIZE);
+#endif
+
+/*
+  the first stall seen by the monitor thread, with the stack of the
+  stalled thread. This is in memory which isn't cleared at boot, so a
+  stall which ends in a watchdog or manual reset is logged after the
+  next boot
+ */
+#define STALL_RECORD_MAGIC 0x57a11ed0
+#define STALL_STACK_WORDS  8
+static struct {
+    uint32_t magic;
+    uint32_t duration_ms;
+    uint32_t sp;
+    uint32_t stack[STALL_STACK_WORDS];
+    uint8_t thread;
+    int8_t task;
+    bool active;    // the thread is still stalled
+} stall_record __attribute__((section(".ram0")));
+
 Scheduler::Scheduler()
 {
 }
@@ -100,6 +122,20 @@ void Scheduler::init()
                      this);                  /* Thread parameter.      */
 #endif
 
+#ifndef HAL_NO_MONITOR_THREAD
+    // a stall recorded before a reset has ended
+    if (stall_record.magic == STALL_RECORD_MAGIC) {
+        stall_record.active = false;
+    }
+
+    // the monitor thread runs above all others, so it can see any of
+    // them stall
+    _monitor_thread_ctx = chThdCreateStatic(_monitor_thread_wa,
+                     sizeof(_monitor_thread_wa),
+                     APM_MONITOR_PRIORITY,        /* Initial priority.      */
+                     _monitor_thread,             /* Thread function.       */
+                     this);                  /* Thread parameter.      */
+#endif
 }
 
 
@@ -174,8 +210,10 @@ void Scheduler::delay(uint16_t ms)
 
     while ((AP_HAL::micros64() - start)/1000 < ms) {
         delay_microseconds(1000);
-        if (_min_delay_cb_ms <= ms) {
-            if (in_main_thread()) {
+        if (in_main_thread()) {
+            // the main loop isn't stalled while it waits
+            heartbeat(MONITOR_MAIN);
+            if (_min_delay_cb_ms <= ms) {
                 call_delay_cb();
             }
         }
@@ -299,6 +337,7 @@ void Scheduler::_timer_thread(void *arg)
     }
     while (true) {
         sched->delay_microseconds(1000);
+        sched->heartbeat(MONITOR_TIMER);
 
         // run registered timers
         sched->_run_timers();
@@ -317,6 +356,7 @@ void Scheduler::_rcin_thread(void *arg)
     }
     while (true) {
         sched->delay_microseconds(2500);
+        sched->heartbeat(MONITOR_RCIN);
         ((RCInput *)hal.rcin)->_timer_tick();
     }
 }
@@ -352,10 +392,14 @@ void Scheduler::_io_thread(void* arg)
     uint32_t last_sd_start_ms = AP_HAL::millis();
     while (true) {
         sched->delay_microseconds(1000);
+        sched->heartbeat(MONITOR_IO);
 
         // run registered IO processes
         sched->_run_io();
 
+        // log any stall the monitor thread has seen end
+        sched->log_stall();
+
         if (!hal.util->get_soft_armed()) {
             // if sdcard hasn't mounted then retry it every 3s in the IO
             // thread when disarmed
@@ -377,12 +421,125 @@ void Scheduler::_storage_thread(void* arg)
     }
     while (true) {
         sched->delay_microseconds(10000);
+        sched->heartbeat(MONITOR_STORAGE);
 
         // process any pending storage writes
         hal.storage->_timer_tick();
     }
 }
 
+/*
+  return the thread the monitor thread watches with the given index
+ */
+thread_t *Scheduler::monitored_thread(uint8_t thread) const
+{
+    switch (thread) {
+    case MONITOR_MAIN:
+        return get_main_thread();
+    case MONITOR_TIMER:
+        return _timer_thread_ctx;
+    case MONITOR_RCIN:
+        return _rcin_thread_ctx;
+    case MONITOR_IO:
+        return _io_thread_ctx;
+    case MONITOR_STORAGE:
+        return _storage_thread_ctx;
+    }
+    return nullptr;
+}
+
+/*
+  check each watched thread has made a pass of its loop recently. The
+  first stall is recorded with the top of the thread's stack, which is
+  where it was switched out, and the scheduler task running at the
+  time, until the IO thread has logged it
+ */
+void Scheduler::check_stalls(void)
+{
+    // the IO and storage threads can wait on slow media
+    static const uint16_t limit_ms[MONITOR_NUM_THREADS] = { 200, 200, 200, 2000, 2000 };
+
+    for (uint8_t i=0; i<MONITOR_NUM_THREADS; i++) {
+        thread_t *tp = monitored_thread(i);
+        if (tp == nullptr) {
+            continue;
+        }
+        const uint32_t last_ms = _heartbeat_ms[i];
+        const uint32_t stalled_ms = AP_HAL::millis() - last_ms;
+        const bool recorded = stall_record.magic == STALL_RECORD_MAGIC;
+        if (stalled_ms < limit_ms[i]) {
+            if (recorded && stall_record.active && stall_record.thread == i) {
+                stall_record.active = false;
+            }
+            continue;
+        }
+        if (recorded) {
+            if (stall_record.active && stall_record.thread == i) {
+                stall_record.duration_ms = stalled_ms;
+            }
+            continue;
+        }
+
+        chSysLock();
+        const uint32_t *sp = (const uint32_t *)tp->ctx.sp;
+        stall_record.sp = (uint32_t)sp;
+        for (uint8_t w=0; w<STALL_STACK_WORDS; w++) {
+            stall_record.stack[w] = sp[w];
+        }
+        chSysUnlock();
+        stall_record.thread = i;
+        stall_record.task = AP_Scheduler::current_task;
+        stall_record.duration_ms = stalled_ms;
+        stall_record.active = true;
+        stall_record.magic = STALL_RECORD_MAGIC;
+    }
+}
+
+/*
+  log a stall which has ended, once logging has started
+ */
+void Scheduler::log_stall(void)
+{
+#ifndef NO_LOGGING
+    if (stall_record.magic != STALL_RECORD_MAGIC || stall_record.active) {
+        return;
+    }
+    AP_Logger *logger = AP_Logger::get_singleton();
+    if (logger == nullptr || !logger->logging_started()) {
+        return;
+    }
+    logger->Write("STAL", "TimeUS,Thr,Task,Ms,SP,S0,S1,S2,S3,S4,S5,S6,S7", "QBbIIIIIIIIII",
+                  AP_HAL::micros64(),
+                  stall_record.thread,
+                  stall_record.task,
+                  stall_record.duration_ms,
+                  stall_record.sp,
+                  stall_record.stack[0], stall_record.stack[1],
+                  stall_record.stack[2], stall_record.stack[3],
+                  stall_record.stack[4], stall_record.stack[5],
+                  stall_record.stack[6], stall_record.stack[7]);
+    stall_record.magic = 0;
+#endif
+}
+
+void Scheduler::_monitor_thread(void *arg)
+{
+    Scheduler *sched = (Scheduler *)arg;
+    chRegSetThreadName("apm_monitor");
+
+    // loops are allowed to be slow while the vehicle sets up
+    while (!sched->_initialized) {
+        sched->delay_microseconds(10000);
+    }
+    for (uint8_t i=0; i<MONITOR_NUM_THREADS; i++) {
+        sched->heartbeat(i);
+    }
+    while (true) {
+        sched->delay_microseconds(50000);
+        sched->check_stalls();
+    }
+}
+
 bool Scheduler::in_main_thread() const
 {
     return get_main_thread() == chThdGetSelfX();
@@ -22,6 +22,7 @@
 
 #define CHIBIOS_SCHEDULER_MAX_TIMER_PROCS 8
 
+#define APM_MONITOR_PRIORITY    183
 #define APM_MAIN_PRIORITY       180
 #define APM_TIMER_PRIORITY      181
 #define APM_RCIN_PRIORITY       177
@@ -68,6 +69,10 @@
 #define STORAGE_THD_WA_SIZE 2048
 #endif
 
+#ifndef MONITOR_THD_WA_SIZE
+#define MONITOR_THD_WA_SIZE 512
+#endif
+
 
 /* Scheduler implementation: */
 class ChibiOS::Scheduler : public AP_HAL::Scheduler {
@@ -92,6 +97,9 @@ public:
 
     bool     check_called_boost(void);
 
+    // called by the main thread after each loop, for the monitor thread
+    void     main_loop_heartbeat(void) { heartbeat(MONITOR_MAIN); }
+
     /*
       disable interrupts and return a context that can be used to
       restore the interrupt state. This can be used to protect
@@ -129,6 +137,23 @@ private:
     thread_t* _rcin_thread_ctx;
     thread_t* _io_thread_ctx;
     thread_t* _storage_thread_ctx;
+    thread_t* _monitor_thread_ctx;
+
+    // threads watched by the monitor thread, which each note the
+    // time of every pass of their loop
+    enum {
+        MONITOR_MAIN = 0,
+        MONITOR_TIMER,
+        MONITOR_RCIN,
+        MONITOR_IO,
+        MONITOR_STORAGE,
+        MONITOR_NUM_THREADS
+    };
+    volatile uint32_t _heartbeat_ms[MONITOR_NUM_THREADS];
+    void heartbeat(uint8_t thread) { _heartbeat_ms[thread] = AP_HAL::millis(); }
+    thread_t *monitored_thread(uint8_t thread) const;
+    void check_stalls(void);
+    void log_stall(void);
 
 #if CH_CFG_USE_SEMAPHORES == TRUE
     binary_semaphore_t _timer_semaphore;
@@ -138,6 +163,7 @@ private:
     static void _rcin_thread(void *arg);
     static void _io_thread(void *arg);
     static void _storage_thread(void *arg);
+    static void _monitor_thread(void *arg);
     static void _uart_thread(void *arg);
 
     void _run_timers();
@@ -82,14 +82,110 @@ void SoftSigReaderInt::init(EICUDriver* icu_drv, eicuchannel_t chan)
 #endif
     aux_channel_config.capture_cb = _irq_handler;
 
+#ifdef STM32_RCININT_DMA_STREAM
+    use_dma = setup_dma(chan);
+    if (use_dma) {
+        // the capture of the second edge requests the DMA burst
+        // instead of an interrupt
+        aux_channel_config.capture_cb = nullptr;
+        icucfg.dier = STM32_TIM_DIER_CC1DE << aux_chan;
+    }
+#endif
+
     eicuStart(_icu_drv, &icucfg);
     //sets input filtering to 4 timer clock
     stm32_timer_set_input_filter(_icu_drv->tim, chan, 2);
     //sets input for aux_chan 
     stm32_timer_set_channel_input(_icu_drv->tim, aux_chan, 2);
+#ifdef STM32_RCININT_DMA_STREAM
+    if (use_dma) {
+        // burst of two words from the capture register of the first
+        // channel of the pair
+        const uint8_t first_chan = (chan < aux_chan) ? chan : aux_chan;
+        _icu_drv->tim->DCR = STM32_TIM_DCR_DBA(0x0D + first_chan) | STM32_TIM_DCR_DBL(1);
+        dmaStreamEnable(dma);
+    }
+#endif
     eicuEnable(_icu_drv);
 }
 
+#ifdef STM32_RCININT_DMA_STREAM
+/*
+  allocate the DMA stream for capture. Returns false if it can't be
+  had, in which case the pulses are read with an interrupt each
+ */
+bool SoftSigReaderInt::setup_dma(eicuchannel_t chan)
+{
+    signal = (uint32_t*)hal.util->malloc_type(sizeof(uint32_t)*SOFTSIGINT_DMA_PULSES*2, AP_HAL::Util::MEM_DMA_SAFE);
+    if (signal == nullptr) {
+        return false;
+    }
+    chSysLock();
+    dma = dmaStreamAllocI(STM32_RCININT_DMA_STREAM,
+                          12,  //IRQ Priority
+                          (stm32_dmaisr_t)_dma_irq_handler,
+                          (void *)this);
+    chSysUnlock();
+    if (dma == nullptr) {
+        hal.util->free_type(signal, sizeof(uint32_t)*SOFTSIGINT_DMA_PULSES*2, AP_HAL::Util::MEM_DMA_SAFE);
+        signal = nullptr;
+        return false;
+    }
+#if STM32_DMA_SUPPORTS_DMAMUX
+    dmaSetRequestSource(dma, STM32_RCININT_DMA_CHANNEL);
+#endif
+    // the pair is read lowest channel first
+    need_swap = (chan == EICU_CHANNEL_2 || chan == EICU_CHANNEL_4);
+
+    dmaStreamSetPeripheral(dma, &_icu_drv->tim->DMAR);
+    dmamode = STM32_DMA_CR_DMEIE | STM32_DMA_CR_TEIE;
+    dmamode |= STM32_DMA_CR_CHSEL(STM32_RCININT_DMA_CHANNEL);
+    dmamode |= STM32_DMA_CR_PL(0);
+    dmamode |= STM32_DMA_CR_DIR_P2M | STM32_DMA_CR_PSIZE_WORD |
+        STM32_DMA_CR_MSIZE_WORD | STM32_DMA_CR_MINC | STM32_DMA_CR_TCIE;
+    dmaStreamSetMemory0(dma, signal);
+    dmaStreamSetTransactionSize(dma, SOFTSIGINT_DMA_PULSES*2);
+    dmaStreamSetMode(dma, dmamode);
+    return true;
+}
+
+void SoftSigReaderInt::_dma_irq_handler(void* self, uint32_t flags)
+{
+    SoftSigReaderInt* sig_reader = (SoftSigReaderInt*)self;
+    // copy out and restart the DMA straight away, as in SoftSigReader
+    cacheBufferInvalidate(sig_reader->signal, SOFTSIGINT_DMA_PULSES*2*4);
+    memcpy(sig_reader->signal2, sig_reader->signal, SOFTSIGINT_DMA_PULSES*2*4);
+    dmaStreamDisable(sig_reader->dma);
+    dmaStreamSetPeripheral(sig_reader->dma, &sig_reader->_icu_drv->tim->DMAR);
+    dmaStreamSetMemory0(sig_reader->dma, sig_reader->signal);
+    dmaStreamSetTransactionSize(sig_reader->dma, SOFTSIGINT_DMA_PULSES*2);
+    dmaStreamSetMode(sig_reader->dma, sig_reader->dmamode);
+    dmaStreamEnable(sig_reader->dma);
+
+    for (uint8_t i=0; i<SOFTSIGINT_DMA_PULSES; i++) {
+        pulse_t pulse;
+        pulse.w0 = sig_reader->signal2[2*i];
+        pulse.w1 = sig_reader->signal2[2*i+1];
+        if (sig_reader->need_swap) {
+            const uint16_t tmp = pulse.w0;
+            pulse.w0 = pulse.w1;
+            pulse.w1 = tmp;
+        }
+        sig_reader->sigbuf.push(pulse);
+    }
+
+    // an overcapture means pulses were lost, so reset the decoders
+    // with a zero width pulse as the interrupt path does
+    const uint32_t mask = STM32_TIM_SR_CC1OF | STM32_TIM_SR_CC2OF | STM32_TIM_SR_CC3OF | STM32_TIM_SR_CC4OF;
+    if ((sig_reader->_icu_drv->tim->SR & mask) != 0) {
+        pulse_t pulse {};
+        sig_reader->sigbuf.push(pulse);
+        sig_reader->sigbuf.push(pulse);
+        sig_reader->_icu_drv->tim->SR &= ~mask;
+    }
+}
+#endif // STM32_RCININT_DMA_STREAM
+
 void SoftSigReaderInt::_irq_handler(EICUDriver *eicup, eicuchannel_t aux_channel)
 {
     eicuchannel_t channel = get_pair_channel(aux_channel);
@@ -26,6 +26,10 @@
 #define SOFTSIG_MAX_SIGNAL_TRANSITIONS 128
 #endif
 
+// pulses captured by DMA between interrupts, when the timer channel
+// pair has a DMA stream
+#define SOFTSIGINT_DMA_PULSES 4
+
 
 class ChibiOS::SoftSigReaderInt {
 public:
@@ -59,6 +63,20 @@ private:
     EICUChannelConfig aux_channel_config;
     EICUDriver* _icu_drv = nullptr;
     uint16_t last_value;
+
+#ifdef STM32_RCININT_DMA_STREAM
+    // with DMA each capture of the second edge bursts both capture
+    // registers to memory, so there is an interrupt per
+    // SOFTSIGINT_DMA_PULSES pulses rather than per pulse
+    bool setup_dma(eicuchannel_t chan);
+    static void _dma_irq_handler(void* self, uint32_t flags);
+    uint32_t *signal;
+    uint32_t signal2[SOFTSIGINT_DMA_PULSES*2];
+    const stm32_dma_stream_t* dma;
+    uint32_t dmamode;
+    bool need_swap;
+    bool use_dma;
+#endif
 };
 
 #endif // HAL_USE_EICU
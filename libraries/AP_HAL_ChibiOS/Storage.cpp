@@ -16,6 +16,7 @@
  */
 #include <AP_HAL/AP_HAL.h>
 #include <AP_BoardConfig/AP_BoardConfig.h>
+#include <AP_Math/AP_Math.h>
 
 #include "Storage.h"
 #include "hwdef/common/flash.h"
@@ -156,6 +157,7 @@ void Storage::write_block(uint16_t loc, const void *src, size_t n)
         _storage_open();
         memcpy(&_buffer[loc], src, n);
         _mark_dirty(loc, n);
+        _last_write_ms = AP_HAL::millis();
     }
 }
 
@@ -164,53 +166,83 @@ void Storage::_timer_tick(void)
     if (!_initialised) {
         return;
     }
+    const uint32_t now = AP_HAL::millis();
     if (_dirty_mask.empty()) {
-        _last_empty_ms = AP_HAL::millis();
+        _last_empty_ms = now;
         return;
     }
 
-    // write out the first dirty line. We don't write more
-    // than one to keep the latency of this call to a minimum
-    uint16_t i;
-    for (i=0; i<CH_STORAGE_NUM_LINES; i++) {
-        if (_dirty_mask.get(i)) {
-            break;
-        }
+    // while writes are still arriving wait for them to finish, so a
+    // mission upload or a burst of parameter sets rewriting the same
+    // lines reaches the backend once
+    if (now - _last_write_ms < CH_STORAGE_SETTLE_MS &&
+        now - _last_empty_ms < CH_STORAGE_MAX_HOLD_MS) {
+        return;
+    }
+
+    // write out the first run of dirty lines. We don't write more
+    // than one run to keep the latency of this call to a minimum, but
+    // a run takes one flash log entry where line by line writes each
+    // need their own
+    const uint16_t line = _dirty_mask.first_set();
+    uint16_t nlines = 1;
+    while (nlines < CH_STORAGE_MAX_WRITE_LINES &&
+           line+nlines < CH_STORAGE_NUM_LINES &&
+           _dirty_mask.get(line+nlines)) {
+        nlines++;
     }
-    if (i == CH_STORAGE_NUM_LINES) {
-        // this shouldn't be possible
+
+    // mark the lines clean before writing them, so a write_block()
+    // while they are being written marks them dirty again
+    for (uint16_t i=0; i<nlines; i++) {
+        _dirty_mask.clear(line+i);
+    }
+
+    const uint32_t start_us = AP_HAL::micros();
+    if (!_write_lines(line, nlines)) {
+        for (uint16_t i=0; i<nlines; i++) {
+            _dirty_mask.set(line+i);
+        }
         return;
     }
+    const uint32_t write_us = AP_HAL::micros() - start_us;
+    _stats.writes++;
+    _stats.lines += nlines;
+    _stats.max_write_us = MAX(_stats.max_write_us, write_us);
+    _stats.max_pending_ms = MAX(_stats.max_pending_ms, now - _last_empty_ms);
+}
+
+/*
+  write nlines lines from line to the backend
+ */
+bool Storage::_write_lines(uint16_t line, uint16_t nlines)
+{
+    const uint32_t offset = CH_STORAGE_LINE_SIZE*line;
+    const uint16_t length = CH_STORAGE_LINE_SIZE*nlines;
 
 #if HAL_WITH_RAMTRON
     if (using_fram) {
-        if (fram.write(CH_STORAGE_LINE_SIZE*i, &_buffer[CH_STORAGE_LINE_SIZE*i], CH_STORAGE_LINE_SIZE)) {
-            _dirty_mask.clear(i);
-        }
-        return;
-    } 
+        return fram.write(offset, &_buffer[offset], length);
+    }
 #endif
 
 #ifdef USE_POSIX
     if (using_filesystem && log_fd != -1) {
-        uint32_t offset = CH_STORAGE_LINE_SIZE*i;
         if (lseek(log_fd, offset, SEEK_SET) != offset) {
-            return;
-        }
-        if (write(log_fd, &_buffer[offset], CH_STORAGE_LINE_SIZE) != CH_STORAGE_LINE_SIZE) {
-            return;
+            return false;
         }
-        if (fsync(log_fd) != 0) {
-            return;
+        if (write(log_fd, &_buffer[offset], length) != length) {
+            return false;
         }
-        _dirty_mask.clear(i);
-        return;
-    } 
+        return fsync(log_fd) == 0;
+    }
 #endif
-    
+
 #ifdef STORAGE_FLASH_PAGE
     // save to storage backend
-    _flash_write(i);
+    return _flash_write(line, nlines);
+#else
+    return false;
 #endif
 }
 
@@ -233,15 +265,14 @@ void Storage::_flash_load(void)
 }
 
 /*
-  write one storage line. This also updates _dirty_mask. 
+  write nlines storage lines to flash
 */
-void Storage::_flash_write(uint16_t line)
+bool Storage::_flash_write(uint16_t line, uint16_t nlines)
 {
 #ifdef STORAGE_FLASH_PAGE
-    if (_flash.write(line*CH_STORAGE_LINE_SIZE, CH_STORAGE_LINE_SIZE)) {
-        // mark the line clean
-        _dirty_mask.clear(line);
-    }
+    return _flash.write(line*CH_STORAGE_LINE_SIZE, nlines*CH_STORAGE_LINE_SIZE);
+#else
+    return false;
 #endif
 }
 
@@ -318,4 +349,10 @@ bool Storage::healthy(void)
     return _initialised && AP_HAL::millis() - _last_empty_ms < 2000;
 }
 
+bool Storage::get_stats(Stats &stats)
+{
+    stats = _stats;
+    return _initialised;
+}
+
 #endif // HAL_USE_EMPTY_STORAGE
@@ -34,6 +34,16 @@
 #define CH_STORAGE_LINE_SIZE (1<<CH_STORAGE_LINE_SHIFT)
 #define CH_STORAGE_NUM_LINES (CH_STORAGE_SIZE/CH_STORAGE_LINE_SIZE)
 
+// the most lines written in one go. 8 lines is the most AP_FlashStorage
+// puts in one log entry
+#define CH_STORAGE_MAX_WRITE_LINES 8
+
+// hold off writing while writes are arriving at least this often, so
+// repeated writes to the same lines are merged, but for no longer
+// than CH_STORAGE_MAX_HOLD_MS
+#define CH_STORAGE_SETTLE_MS 50
+#define CH_STORAGE_MAX_HOLD_MS 500
+
 class ChibiOS::Storage : public AP_HAL::Storage {
 public:
     void init() override {}
@@ -42,6 +52,7 @@ public:
 
     void _timer_tick(void) override;
     bool healthy(void) override;
+    bool get_stats(Stats &stats) override;
 
 private:
     volatile bool _initialised;
@@ -60,6 +71,10 @@ private:
     bool _flash_failed;
     uint32_t _last_re_init_ms;
     uint32_t _last_empty_ms;
+    volatile uint32_t _last_write_ms;
+    Stats _stats;
+
+    bool _write_lines(uint16_t line, uint16_t nlines);
 
 #ifdef STORAGE_FLASH_PAGE
     AP_FlashStorage _flash{_buffer,
@@ -71,7 +86,7 @@ private:
 #endif
     
     void _flash_load(void);
-    void _flash_write(uint16_t line);
+    bool _flash_write(uint16_t line, uint16_t nlines);
 
 #if HAL_WITH_RAMTRON
     AP_RAMTRON fram;
@@ -192,10 +192,12 @@ void UARTDriver::begin(uint32_t b, uint16_t rxS, uint16_t txS)
     if (txS != _writebuf.get_size()) {
         _initialised = false;
         _writebuf.set_size(txS);
+        _stats.tx_cleared();
     }
 
     if (clear_buffers) {
         _writebuf.clear();
+        _stats.tx_cleared();
     }
 
     if (sdef.is_usb) {
@@ -282,14 +284,7 @@ void UARTDriver::begin(uint32_t b, uint16_t rxS, uint16_t txS)
                 ((SerialDriver*)sdef.serial)->usart->CR1 &= ~USART_CR1_RXNEIE;
                 //Start DMA
                 if(!was_initialised) {
-                    uint32_t dmamode = STM32_DMA_CR_DMEIE | STM32_DMA_CR_TEIE;
-                    dmamode |= STM32_DMA_CR_CHSEL(sdef.dma_rx_channel_id);
-                    dmamode |= STM32_DMA_CR_PL(0);
-                    dmaStreamSetMemory0(rxdma, rx_bounce_buf);
-                    dmaStreamSetTransactionSize(rxdma, RX_BOUNCE_BUFSIZE);
-                    dmaStreamSetMode(rxdma, dmamode    | STM32_DMA_CR_DIR_P2M |
-                                         STM32_DMA_CR_MINC | STM32_DMA_CR_TCIE);
-                    dmaStreamEnable(rxdma);
+                    dma_rx_enable();
                 }
             }
         }
@@ -371,63 +366,150 @@ void UARTDriver::rx_irq_cb(void* self)
 {
 #if HAL_USE_SERIAL == TRUE
     UARTDriver* uart_drv = (UARTDriver*)self;
+    uart_drv->_stats.count_irq();
+#if defined(STM32F7) || defined(STM32H7)
+    const uint32_t isr = ((SerialDriver*)(uart_drv->sdef.serial))->usart->ISR;
+    if (isr & USART_ISR_ORE) {
+        uart_drv->_stats.count_overrun();
+    }
     if (!uart_drv->sdef.dma_rx) {
+        if (isr & USART_ISR_RXNE) {
+            uart_drv->_rx_irq_us = AP_HAL::micros();
+        }
         return;
     }
-#if defined(STM32F7) || defined(STM32H7)
-    //disable dma, triggering DMA transfer complete interrupt
-    uart_drv->rxdma->stream->CR &= ~STM32_DMA_CR_EN;
+    // the serial driver clears the flags. With RXNE off the only RX
+    // interrupt is the idle line, which is raised a byte time after
+    // the last byte, so take what the DMA has received
+    uart_drv->dma_rx_collect_from_ISR(AP_HAL::micros64() - uart_drv->byte_time_us());
 #else
     volatile uint16_t sr = ((SerialDriver*)(uart_drv->sdef.serial))->usart->SR;
+    if (sr & USART_SR_ORE) {
+        uart_drv->_stats.count_overrun();
+    }
+    if (!uart_drv->sdef.dma_rx) {
+        if (sr & USART_SR_RXNE) {
+            uart_drv->_rx_irq_us = AP_HAL::micros();
+        }
+        return;
+    }
     if(sr & USART_SR_IDLE) {
+        // reading DR after SR clears the flag
         volatile uint16_t dr = ((SerialDriver*)(uart_drv->sdef.serial))->usart->DR;
         (void)dr;
-        //disable dma, triggering DMA transfer complete interrupt
-        uart_drv->rxdma->stream->CR &= ~STM32_DMA_CR_EN;
+        // the line went idle a byte time after the last byte
+        uart_drv->dma_rx_collect_from_ISR(AP_HAL::micros64() - uart_drv->byte_time_us());
     }
 #endif // STM32F7
 #endif // HAL_USE_SERIAL
 }
 
+/*
+  RX DMA half transfer, transfer complete and error interrupt handler
+ */
 void UARTDriver::rxbuff_full_irq(void* self, uint32_t flags)
 {
 #if HAL_USE_SERIAL == TRUE
     UARTDriver* uart_drv = (UARTDriver*)self;
-    if (uart_drv->_lock_rx_in_timer_tick) {
-        return;
-    }
     if (!uart_drv->sdef.dma_rx) {
         return;
     }
-    cacheBufferInvalidate(uart_drv->rx_bounce_buf, RX_BOUNCE_BUFSIZE);
-    uint8_t len = RX_BOUNCE_BUFSIZE - dmaStreamGetTransactionSize(uart_drv->rxdma);
-    if (len > 0) {
-        if (uart_drv->half_duplex) {
-            uint32_t now = AP_HAL::micros();
-            if (now - uart_drv->hd_write_us < uart_drv->hd_read_delay_us) {
-                len = 0;
-            }
-        }
+    uart_drv->_stats.count_irq();
+    // the last byte of the half or whole buffer has just arrived
+    uart_drv->dma_rx_collect_from_ISR(AP_HAL::micros64());
+    if (flags & (STM32_DMA_ISR_TEIF | STM32_DMA_ISR_DMEIF)) {
+        // an error stops the stream, so start it again
+        uart_drv->dma_rx_enable();
+    }
+#endif // HAL_USE_SERIAL
+}
+
+/*
+  start the RX DMA running around rx_bounce_buf, without stopping, so
+  no bytes are missed while it is restarted. It interrupts when each
+  half of the buffer fills, and the UART interrupts when the line goes
+  idle, so bytes are passed on as a packet ends, or at most half a
+  buffer after they arrive
+ */
+void UARTDriver::dma_rx_enable(void)
+{
+#if HAL_USE_SERIAL == TRUE
+    uint32_t dmamode = STM32_DMA_CR_DMEIE | STM32_DMA_CR_TEIE;
+    dmamode |= STM32_DMA_CR_CHSEL(sdef.dma_rx_channel_id);
+    dmamode |= STM32_DMA_CR_PL(0);
+    // a direct mode error leaves the stream running
+    dmaStreamDisable(rxdma);
+    _rx_dma_pos = 0;
+    dmaStreamSetMemory0(rxdma, rx_bounce_buf);
+    dmaStreamSetTransactionSize(rxdma, RX_BOUNCE_BUFSIZE);
+    dmaStreamSetMode(rxdma, dmamode    | STM32_DMA_CR_DIR_P2M |
+                         STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC |
+                         STM32_DMA_CR_HTIE | STM32_DMA_CR_TCIE);
+    dmaStreamEnable(rxdma);
+#endif // HAL_USE_SERIAL
+}
 
-        cacheBufferInvalidate(uart_drv->rx_bounce_buf, len);
-        uart_drv->_readbuf.write(uart_drv->rx_bounce_buf, len);
+/*
+  pass on the bytes the RX DMA has written since the last call. Called
+  from the UART and DMA interrupts, which have the same priority so
+  can't preempt each other, and with the system locked from the timer
+  thread
+ */
+void UARTDriver::dma_rx_collect(uint64_t timestamp_us)
+{
+#if HAL_USE_SERIAL == TRUE
+    // the transfer count reloads as the DMA wraps, so it might just
+    // have read 0
+    uint16_t pos = RX_BOUNCE_BUFSIZE - dmaStreamGetTransactionSize(rxdma);
+    if (pos >= RX_BOUNCE_BUFSIZE) {
+        pos = 0;
+    }
+    if (pos == _rx_dma_pos) {
+        return;
+    }
+    cacheBufferInvalidate(rx_bounce_buf, RX_BOUNCE_BUFSIZE);
+    if (pos > _rx_dma_pos) {
+        receive_bytes(&rx_bounce_buf[_rx_dma_pos], pos - _rx_dma_pos, timestamp_us);
+    } else {
+        receive_bytes(&rx_bounce_buf[_rx_dma_pos], RX_BOUNCE_BUFSIZE - _rx_dma_pos, timestamp_us);
+        receive_bytes(rx_bounce_buf, pos, timestamp_us);
+    }
+    _rx_dma_pos = pos;
 
-        uart_drv->receive_timestamp_update();
+    if (_rts_is_active) {
+        update_rts_line();
     }
-    
-    //restart the DMA transfers
-    dmaStreamSetMemory0(uart_drv->rxdma, uart_drv->rx_bounce_buf);
-    dmaStreamSetTransactionSize(uart_drv->rxdma, RX_BOUNCE_BUFSIZE);
-    dmaStreamEnable(uart_drv->rxdma);
-    if (uart_drv->_wait.thread_ctx && uart_drv->_readbuf.available() >= uart_drv->_wait.n) {
+#endif // HAL_USE_SERIAL
+}
+
+// collect from the RX DMA in an interrupt, waking any waiting reader
+void UARTDriver::dma_rx_collect_from_ISR(uint64_t timestamp_us)
+{
+    dma_rx_collect(timestamp_us);
+    if (_wait.thread_ctx && _readbuf.available() >= _wait.n) {
         chSysLockFromISR();
-        chEvtSignalI(uart_drv->_wait.thread_ctx, EVT_DATA);                    
+        chEvtSignalI(_wait.thread_ctx, EVT_DATA);
         chSysUnlockFromISR();
     }
-    if (uart_drv->_rts_is_active) {
-        uart_drv->update_rts_line();
+}
+
+// add received bytes to the read buffer, the last of which arrived at
+// timestamp_us
+void UARTDriver::receive_bytes(const uint8_t *data, uint16_t len, uint64_t timestamp_us)
+{
+    if (len == 0) {
+        return;
     }
-#endif // HAL_USE_SERIAL
+    if (half_duplex) {
+        uint32_t now = AP_HAL::micros();
+        if (now - hd_write_us < hd_read_delay_us) {
+            // our own bytes read back
+            return;
+        }
+    }
+    const uint32_t stored = _readbuf.write(data, len);
+    _stats.received(len, stored, _readbuf.available());
+    receive_timestamp_update(timestamp_us);
 }
 
 void UARTDriver::begin(uint32_t b)
@@ -452,6 +534,7 @@ void UARTDriver::end()
     }
     _readbuf.set_size(0);
     _writebuf.set_size(0);
+    _stats.tx_cleared();
 }
 
 void UARTDriver::flush()
@@ -522,6 +605,25 @@ int16_t UARTDriver::read()
     return byte;
 }
 
+ssize_t UARTDriver::read(uint8_t *buffer, uint16_t count)
+{
+    if (lock_read_key != 0 || _uart_owner_thd != chThdGetSelfX()){
+        return -1;
+    }
+    if (!_initialised) {
+        return -1;
+    }
+
+    const uint32_t ret = _readbuf.read(buffer, count);
+    if (ret == 0) {
+        return 0;
+    }
+    if (!_rts_is_active) {
+        update_rts_line();
+    }
+    return ret;
+}
+
 int16_t UARTDriver::read_locked(uint32_t key)
 {
     if (lock_read_key != 0 && key != lock_read_key) {
@@ -554,12 +656,14 @@ size_t UARTDriver::write(uint8_t c)
 
     while (_writebuf.space() == 0) {
         if (!_blocking_writes) {
+            _stats.queued(1, 0, _writebuf.available());
             _write_mutex.give();
             return 0;
         }
         hal.scheduler->delay(1);
     }
     size_t ret = _writebuf.write(&c, 1);
+    _stats.queued(1, ret, _writebuf.available());
     if (unbuffered_writes) {
         write_pending_bytes();
     }
@@ -591,6 +695,7 @@ size_t UARTDriver::write(const uint8_t *buffer, size_t size)
     }
 
     size_t ret = _writebuf.write(buffer, size);
+    _stats.queued(size, ret, _writebuf.available());
     if (unbuffered_writes) {
         write_pending_bytes();
     }
@@ -598,6 +703,41 @@ size_t UARTDriver::write(const uint8_t *buffer, size_t size)
     return ret;
 }
 
+/*
+  queue all the fragments under one lock, or none of them
+ */
+size_t UARTDriver::writev(const WriteVec *vec, uint8_t count)
+{
+    if (!_initialised || lock_write_key != 0) {
+        return 0;
+    }
+    if (!_write_mutex.take_nonblocking()) {
+        return 0;
+    }
+
+    uint32_t total = 0;
+    for (uint8_t i=0; i<count; i++) {
+        total += vec[i].len;
+    }
+    while (_writebuf.space() < total) {
+        if (!_blocking_writes || total >= _writebuf.get_size()) {
+            _stats.queued(total, 0, _writebuf.available());
+            _write_mutex.give();
+            return 0;
+        }
+        hal.scheduler->delay(1);
+    }
+    for (uint8_t i=0; i<count; i++) {
+        _writebuf.write(vec[i].data, vec[i].len);
+    }
+    _stats.queued(total, total, _writebuf.available());
+    if (unbuffered_writes) {
+        write_pending_bytes();
+    }
+    _write_mutex.give();
+    return total;
+}
+
 /*
   lock the uart for exclusive use by write_locked() and read_locked() with the right key
  */
@@ -629,6 +769,7 @@ size_t UARTDriver::write_locked(const uint8_t *buffer, size_t size, uint32_t key
         return 0;
     }
     size_t ret = _writebuf.write(buffer, size);
+    _stats.queued(size, ret, _writebuf.available());
 
     _write_mutex.give();
 
@@ -701,6 +842,7 @@ void UARTDriver::write_pending_bytes_DMA(uint32_t n)
     /* TX DMA channel preparation.*/
     _total_written += tx_len;
     _writebuf.advance(tx_len);
+    _stats.sent(tx_len);
     tx_len = _writebuf.peekbytes(tx_bounce_buf, MIN(n, TX_BOUNCE_BUFSIZE));
     if (tx_len == 0) {
         return;
@@ -778,6 +920,7 @@ void UARTDriver::write_pending_bytes_NODMA(uint32_t n)
     }
 
     _total_written += nwritten;
+    _stats.sent(nwritten);
 
     if (half_duplex) {
         half_duplex_setup_delay(nwritten);
@@ -863,28 +1006,15 @@ void UARTDriver::_timer_tick(void)
     if (!_initialised) return;
 
     if (sdef.dma_rx && rxdma) {
-        _lock_rx_in_timer_tick = true;
         //Check if DMA is enabled
-        //if not, it might be because the DMA interrupt was silenced
-        //let's handle that here so that we can continue receiving
+        //if not, it was stopped by an error whose interrupt never got
+        //a chance to be handled, so take what it received and restart it
+        chSysLock();
         if (!(rxdma->stream->CR & STM32_DMA_CR_EN)) {
-            uint8_t len = RX_BOUNCE_BUFSIZE - dmaStreamGetTransactionSize(rxdma);
-            if (len != 0) {
-                cacheBufferInvalidate(rx_bounce_buf, len);
-                _readbuf.write(rx_bounce_buf, len);
-
-                receive_timestamp_update();
-                if (_rts_is_active) {
-                    update_rts_line();
-                }
-            }
-            //DMA disabled by idle interrupt never got a chance to be handled
-            //we will enable it here
-            dmaStreamSetMemory0(rxdma, rx_bounce_buf);
-            dmaStreamSetTransactionSize(rxdma, RX_BOUNCE_BUFSIZE);
-            dmaStreamEnable(rxdma);
+            dma_rx_collect(AP_HAL::micros64());
+            dma_rx_enable();
         }
-        _lock_rx_in_timer_tick = false;
+        chSysUnlock();
     }
 
     // don't try IO on a disconnected USB port
@@ -929,8 +1059,16 @@ void UARTDriver::_timer_tick(void)
                 }
             }
             _readbuf.commit((unsigned)ret);
+            _stats.received(ret, ret, _readbuf.available());
 
-            receive_timestamp_update();
+            // the newest byte arrived at the last receive interrupt.
+            // USB has no such interrupt, so use the time it was read
+            const uint64_t now_us = AP_HAL::micros64();
+            if (sdef.is_usb) {
+                receive_timestamp_update(now_us);
+            } else {
+                receive_timestamp_update(now_us - (AP_HAL::micros() - _rx_irq_us));
+            }
             
             /* stop reading as we read less than we asked for */
             if ((unsigned)ret < vec[i].len) {
@@ -1123,9 +1261,9 @@ void UARTDriver::set_stop_bits(int n)
 
 
 // record timestamp of new incoming data 
-void UARTDriver::receive_timestamp_update(void)
+void UARTDriver::receive_timestamp_update(uint64_t timestamp_us)
 {
-    _receive_timestamp[_receive_timestamp_idx^1] = AP_HAL::micros64();
+    _receive_timestamp[_receive_timestamp_idx^1] = timestamp_us;
     _receive_timestamp_idx ^= 1;
 }
 
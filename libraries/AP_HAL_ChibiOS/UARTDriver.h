@@ -17,12 +17,14 @@
 #pragma once
 
 #include <AP_HAL/utility/RingBuffer.h>
+#include <AP_HAL/utility/UARTStats.h>
 
 #include "AP_HAL_ChibiOS.h"
 #include "shared_dma.h"
 #include "Semaphores.h"
 
-#define RX_BOUNCE_BUFSIZE 128U
+// the RX DMA runs continuously around this buffer, interrupting at each half
+#define RX_BOUNCE_BUFSIZE 256U
 #define TX_BOUNCE_BUFSIZE 64U
 
 // enough for uartA to uartG, plus IOMCU
@@ -44,11 +46,13 @@ public:
     uint32_t available() override;
     uint32_t txspace() override;
     int16_t read() override;
+    ssize_t read(uint8_t *buffer, uint16_t count) override;
     int16_t read_locked(uint32_t key) override;
     void _timer_tick(void) override;
 
     size_t write(uint8_t c) override;
     size_t write(const uint8_t *buffer, size_t size) override;
+    size_t writev(const WriteVec *vec, uint8_t count) override;
 
     // lock a port for exclusive use. Use a key of 0 to unlock
     bool lock_port(uint32_t write_key, uint32_t read_key) override;
@@ -112,6 +116,12 @@ public:
         return _baudrate/(9*1024);
     }
 
+    // irqs counts UART and RX DMA interrupts
+    bool get_stats(UARTStats &stats) override {
+        stats = _stats.get();
+        return true;
+    }
+
 private:
     bool tx_bounce_buf_ready;
     const SerialDef &sdef;
@@ -157,7 +167,10 @@ private:
     bool _blocking_writes;
     bool _initialised;
     bool _device_initialised;
-    bool _lock_rx_in_timer_tick = false;
+
+    // position in rx_bounce_buf up to which the RX DMA has been read
+    uint16_t _rx_dma_pos;
+    UARTStatsKeeper _stats;
     Shared_DMA *dma_handle;
     static const SerialDef _serial_tab[];
 
@@ -165,6 +178,10 @@ private:
     uint64_t _receive_timestamp[2];
     uint8_t _receive_timestamp_idx;
 
+    // AP_HAL::micros() of the last receive interrupt on a port
+    // without RX DMA, giving when its newest byte arrived
+    volatile uint32_t _rx_irq_us;
+
     // handling of flow control
     enum flow_control _flow_control = FLOW_CONTROL_DISABLE;
     bool _rts_is_active;
@@ -188,6 +205,10 @@ private:
     
     static void rx_irq_cb(void* sd);
     static void rxbuff_full_irq(void* self, uint32_t flags);
+    void dma_rx_enable(void);
+    void dma_rx_collect(uint64_t timestamp_us);
+    void dma_rx_collect_from_ISR(uint64_t timestamp_us);
+    void receive_bytes(const uint8_t *data, uint16_t len, uint64_t timestamp_us);
     static void tx_complete(void* self, uint32_t flags);
     static void handle_tx_timeout(void *arg);
 
@@ -200,7 +221,12 @@ private:
     void write_pending_bytes_NODMA(uint32_t n);
     void write_pending_bytes(void);
 
-    void receive_timestamp_update(void);
+    void receive_timestamp_update(uint64_t timestamp_us);
+
+    // time to receive one byte, assuming 10 bits per byte
+    uint32_t byte_time_us(void) const {
+        return _baudrate > 0 ? 10000000UL / _baudrate : 0;
+    }
     
     void thread_init();
     static void uart_thread(void *);
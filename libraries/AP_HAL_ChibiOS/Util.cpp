@@ -20,6 +20,7 @@
 #include "Util.h"
 #include <ch.h>
 #include "RCOutput.h"
+#include "shared_dma.h"
 #include "hwdef/common/stm32_util.h"
 #include "hwdef/common/flash.h"
 #include <AP_ROMFS/AP_ROMFS.h>
@@ -45,6 +46,18 @@ uint32_t Util::available_memory(void)
     return mem_available();
 }
 
+uint32_t Util::available_memory_dma(void)
+{
+    // from malloc.c in hwdef
+    return mem_available_dma();
+}
+
+bool Util::memory_region_info(uint8_t i, uint32_t &size, uint32_t &available, uint8_t &flags)
+{
+    // from malloc.c in hwdef
+    return mem_region_info(i, &size, &available, &flags);
+}
+
 /*
     Special Allocation Routines
 */
@@ -301,6 +314,59 @@ bool Util::get_system_id_unformatted(uint8_t buf[], uint8_t &len)
     return true;
 }
 
+bool Util::get_dma_stats(uint8_t idx, DMAStats &stats)
+{
+#if CH_CFG_USE_SEMAPHORES == TRUE && STM32_DMA_ADVANCED
+    return Shared_DMA::get_stats(idx, stats);
+#else
+    return false;
+#endif
+}
+
+#if HAL_PERF_TRACE_EVENTS
+/*
+  a perf counter is its trace id plus one, so nullptr stays invalid
+ */
+Util::perf_counter_t Util::perf_alloc(perf_counter_type t, const char *name)
+{
+    const int16_t id = perf_trace.add(name);
+    if (id < 0) {
+        return nullptr;
+    }
+    return (perf_counter_t)(uintptr_t)(id + 1);
+}
+
+void Util::perf_record(perf_counter_t h, PerfTrace::Event event)
+{
+    if (h == nullptr) {
+        return;
+    }
+    // threads are told apart by their control block address
+    const uint16_t thread = (uintptr_t)chThdGetSelfX() >> 3;
+    perf_trace.record((uintptr_t)h - 1, event, thread);
+}
+
+void Util::perf_begin(perf_counter_t h)
+{
+    perf_record(h, PerfTrace::Event::BEGIN);
+}
+
+void Util::perf_end(perf_counter_t h)
+{
+    perf_record(h, PerfTrace::Event::END);
+}
+
+void Util::perf_count(perf_counter_t h)
+{
+    perf_record(h, PerfTrace::Event::COUNT);
+}
+
+bool Util::perf_trace_dump(const char *path)
+{
+    return perf_trace.write_chrome_trace(path);
+}
+#endif
+
 #ifdef USE_POSIX
 /*
   initialise filesystem
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/PerfTrace.h>
 #include "AP_HAL_ChibiOS_Namespace.h"
 #include "AP_HAL_ChibiOS.h"
 #include <ch.h>
@@ -29,6 +30,8 @@ public:
 
     bool run_debug_shell(AP_HAL::BetterStream *stream) override { return false; }
     uint32_t available_memory() override;
+    uint32_t available_memory_dma() override;
+    bool memory_region_info(uint8_t i, uint32_t &size, uint32_t &available, uint8_t &flags) override;
 
     // Special Allocation Routines
     void *malloc_type(size_t size, AP_HAL::Util::Memory_Type mem_type) override;
@@ -53,6 +56,18 @@ public:
     bool get_system_id(char buf[40]) override;
     bool get_system_id_unformatted(uint8_t buf[], uint8_t &len) override;
 
+    // get the statistics of a shared DMA stream
+    bool get_dma_stats(uint8_t idx, DMAStats &stats) override;
+
+#if HAL_PERF_TRACE_EVENTS
+    // perf counters record into a ring of events in RAM
+    perf_counter_t perf_alloc(perf_counter_type t, const char *name) override;
+    void perf_begin(perf_counter_t h) override;
+    void perf_end(perf_counter_t h) override;
+    void perf_count(perf_counter_t h) override;
+    bool perf_trace_dump(const char *path) override;
+#endif
+
 #ifdef HAL_PWM_ALARM
     bool toneAlarm_init() override;
     void toneAlarm_set_buzzer_tone(float frequency, float volume, uint32_t duration_ms) override;
@@ -105,4 +120,8 @@ private:
     static memory_heap_t scripting_heap;
 #endif // ENABLE_HEAP
 
+#if HAL_PERF_TRACE_EVENTS
+    PerfTrace perf_trace;
+    void perf_record(perf_counter_t h, PerfTrace::Event event);
+#endif
 };
@@ -102,10 +102,19 @@ static void *malloc_flags(size_t size, uint32_t flags)
         size = (size + (DMA_ALIGNMENT-1)) & ~(DMA_ALIGNMENT-1);
     }
 
-    // if no flags are set or this is a DMA request and default heap
-    // is DMA safe then start with default heap
-    if (flags == 0 || (flags == MEM_REGION_FLAG_DMA_OK &&
-                       (memory_regions[0].flags & MEM_REGION_FLAG_DMA_OK))) {
+    // general allocations keep out of fast memory while there is
+    // other memory left, so that fast memory is still free when the
+    // hot data that asks for it (such as the EKF cores) is allocated
+    // later in startup. On H7 the default heap is DTCM, which is fast
+
+    // if no flags are set and the default heap is not fast memory, or
+    // this is a DMA or fast request and default heap is of that type,
+    // then start with default heap
+    if ((flags == 0 && !(memory_regions[0].flags & MEM_REGION_FLAG_FAST)) ||
+        (flags == MEM_REGION_FLAG_DMA_OK &&
+         (memory_regions[0].flags & MEM_REGION_FLAG_DMA_OK)) ||
+        (flags == MEM_REGION_FLAG_FAST &&
+         (memory_regions[0].flags & MEM_REGION_FLAG_FAST))) {
         p = chHeapAllocAligned(NULL, size, alignment);
         if (p) {
             goto found;
@@ -114,6 +123,10 @@ static void *malloc_flags(size_t size, uint32_t flags)
 
     // try with matching flags
     for (i=1; i<NUM_MEMORY_REGIONS; i++) {
+        if (flags == 0 &&
+            (memory_regions[i].flags & MEM_REGION_FLAG_FAST)) {
+            continue;
+        }
         if ((flags & MEM_REGION_FLAG_DMA_OK) &&
             !(memory_regions[i].flags & MEM_REGION_FLAG_DMA_OK)) {
             continue;
@@ -243,6 +256,59 @@ size_t mem_available(void)
     return totalp;
 }
 
+/*
+  return available DMA-capable memory in bytes
+ */
+size_t mem_available_dma(void)
+{
+    size_t totalp = 0;
+    uint8_t i;
+
+    if (memory_regions[0].flags & MEM_REGION_FLAG_DMA_OK) {
+        chHeapStatus(NULL, &totalp, NULL);
+        totalp += chCoreGetStatusX();
+    }
+
+    for (i=1; i<NUM_MEMORY_REGIONS; i++) {
+        if (!(memory_regions[i].flags & MEM_REGION_FLAG_DMA_OK)) {
+            continue;
+        }
+        size_t available = 0;
+        chHeapStatus(&heaps[i], &available, NULL);
+        totalp += available;
+    }
+
+#if DMA_RESERVE_SIZE != 0
+    size_t available = 0;
+    chHeapStatus(&dma_reserve_heap, &available, NULL);
+    totalp += available;
+#endif
+
+    return totalp;
+}
+
+/*
+  get the size, free space and MEM_REGION_FLAG_* flags of memory
+  region i. Returns false past the last region
+ */
+bool mem_region_info(uint8_t i, uint32_t *size, uint32_t *available, uint8_t *flags)
+{
+    if (i >= NUM_MEMORY_REGIONS) {
+        return false;
+    }
+    size_t free_bytes = 0;
+    if (i == 0) {
+        chHeapStatus(NULL, &free_bytes, NULL);
+        free_bytes += chCoreGetStatusX();
+    } else {
+        chHeapStatus(&heaps[i], &free_bytes, NULL);
+    }
+    *size = memory_regions[i].size;
+    *available = free_bytes;
+    *flags = memory_regions[i].flags;
+    return true;
+}
+
 /*
   allocate a thread on any available heap
  */
@@ -30,6 +30,8 @@ void show_stack_usage(void);
 
 // allocation functions in malloc.c    
 size_t mem_available(void);
+size_t mem_available_dma(void);
+bool mem_region_info(uint8_t i, uint32_t *size, uint32_t *available, uint8_t *flags);
 void *malloc_dma(size_t size);
 void *malloc_sdcard_dma(size_t size);
 void *malloc_fastmem(size_t size);
@@ -65,6 +65,9 @@ romfs = {}
 # SPI bus list
 spi_list = []
 
+# DMA request for RCININT capture, if the MCU has one
+rcinint_dma = None
+
 # all config lines in order
 alllines = []
 
@@ -961,6 +964,13 @@ def write_PWM_config(f):
         f.write('#define STM32_EICU_USE_TIM%u TRUE\n' % n)
         f.write('#define RCININT_EICU_TIMER EICUD%u\n' % n)
         f.write('#define RCININT_EICU_CHANNEL EICU_CHANNEL_%u\n' % chan)
+        # capture with DMA if the resolver found a stream for the
+        # second channel of the pair
+        aux_chan = rcinint_aux_channel(chan)
+        f.write('#ifdef STM32_TIM_TIM%u_CH%u_DMA_STREAM\n' % (n, aux_chan))
+        f.write('#define STM32_RCININT_DMA_STREAM STM32_TIM_TIM%u_CH%u_DMA_STREAM\n' % (n, aux_chan))
+        f.write('#define STM32_RCININT_DMA_CHANNEL STM32_TIM_TIM%u_CH%u_DMA_CHAN\n' % (n, aux_chan))
+        f.write('#endif\n')
         f.write('\n')
 
     if alarm is not None:
@@ -1205,6 +1215,60 @@ def get_dma_exclude(periph_list):
             dma_exclude.append(periph)
     return dma_exclude
 
+def parse_speed(speed):
+    '''return a SPIDEV speed such as 8*MHZ in Hz'''
+    (value, unit) = speed.split('*')
+    if not is_int(value):
+        error("Bad SPI speed %s" % speed)
+    if unit == 'MHZ':
+        return int(value) * 1000000
+    return int(value) * 1000
+
+def get_throughput(periph):
+    '''estimate the bytes per second a peripheral moves by DMA'''
+    if periph.startswith('SDIO') or periph.startswith('SDMMC'):
+        # 4 bit bus at 25MHz
+        return 12500000
+    if periph.startswith('SPI'):
+        bus = periph.split('_')[0]
+        speeds = [parse_speed(dev[6]) for dev in spidev if dev[1] == bus]
+        if not speeds:
+            return 0
+        return max(speeds) // 8
+    if periph.endswith('_UP'):
+        # DShot, which is also timing critical
+        return 1000000
+    if periph.startswith('USART') or periph.startswith('UART'):
+        uart = periph.split('_')[0]
+        if 'IOMCU_UART' in config and config['IOMCU_UART'][0] == uart:
+            return 150000
+        return 11520
+    if periph.startswith('I2C'):
+        return 44000
+    # ADC and RC input
+    return 1000
+
+def get_dma_priority():
+    '''get the DMA priority list. DMA_PRIORITY AUTO orders the
+    peripherals by their likely throughput, so the busiest get their
+    own streams'''
+    dma_priority = get_config('DMA_PRIORITY', default='TIM* SPI*', spaces=True)
+    if dma_priority != 'AUTO':
+        return dma_priority
+    ranked = sorted(periph_list, key=lambda p: -get_throughput(p))
+    print("DMA priority by throughput: %s" % ' '.join(ranked))
+    return ' '.join(ranked)
+
+def resolve_dma(f, plist):
+    '''write the DMA mapping, returning the peripherals without DMA'''
+    unassigned = dma_resolver.write_dma_header(f, plist, mcu_type,
+                                               dma_exclude=get_dma_exclude(plist),
+                                               dma_priority=get_dma_priority(),
+                                               dma_noshare=get_config('DMA_NOSHARE',default='', spaces=True))
+    if unassigned is None:
+        return []
+    return unassigned
+
 def write_hwdef_header(outfilename):
     '''write hwdef header file'''
     print("Writing hwdef setup in %s" % outfilename)
@@ -1235,10 +1299,19 @@ def write_hwdef_header(outfilename):
     write_peripheral_enable(f)
     setup_apj_IDs()
 
-    dma_resolver.write_dma_header(f, periph_list, mcu_type,
-                                  dma_exclude=get_dma_exclude(periph_list),
-                                  dma_priority=get_config('DMA_PRIORITY',default='TIM* SPI*', spaces=True),
-                                  dma_noshare=get_config('DMA_NOSHARE',default='', spaces=True))
+    dma_list = periph_list
+    if rcinint_dma is not None:
+        # RC input capture only gets DMA if that takes a stream from
+        # nothing else, otherwise it uses an interrupt per pulse
+        devnull = open(os.devnull, 'w')
+        unassigned = set(resolve_dma(devnull, periph_list))
+        unassigned_rcin = set(resolve_dma(devnull, periph_list + [rcinint_dma]))
+        devnull.close()
+        if unassigned_rcin <= unassigned:
+            dma_list = periph_list + [rcinint_dma]
+        else:
+            print("No DMA for RCININT on %s" % rcinint_dma)
+    resolve_dma(f, dma_list)
 
     if not args.bootloader:
         write_PWM_config(f)
@@ -1336,8 +1409,22 @@ def write_hwdef_header(outfilename):
             f.write(")\n\n")
 
 
+def rcinint_aux_channel(chan):
+    '''return the other timer channel of the pair used by RCININT'''
+    if chan in [1, 3]:
+        return chan + 1
+    return chan - 1
+
+def have_dma_map(label):
+    '''see if the MCU has a DMA request for a peripheral'''
+    lib = get_mcu_lib(mcu_type)
+    if not hasattr(lib, 'DMA_Map'):
+        return False
+    return lib.DMA_Map is None or label in lib.DMA_Map
+
 def build_peripheral_list():
     '''build a list of peripherals for DMA resolver to work on'''
+    global rcinint_dma
     peripherals = []
     done = set()
     prefixes = ['SPI', 'USART', 'UART', 'I2C']
@@ -1367,7 +1454,14 @@ def build_peripheral_list():
                 if label[-1] == 'N':
                     label = label[:-1]
                 peripherals.append(label)
-            elif not p.has_extra('ALARM') and not p.has_extra('RCININT'):
+            elif p.has_extra('RCININT'):
+                # DMA capture is requested by the second channel of
+                # the pair
+                (n, chan, compl) = parse_timer(p.label)
+                label = 'TIM%u_CH%u' % (n, rcinint_aux_channel(chan))
+                if not p.has_extra('NODMA') and have_dma_map(label):
+                    rcinint_dma = label
+            elif not p.has_extra('ALARM'):
                 # get the TIMn_UP DMA channels for DShot
                 label = type + '_UP'
                 if not label in peripherals and not p.has_extra('NODMA'):
@@ -219,7 +219,8 @@ def generate_DMAMUX_map(peripheral_list, noshare_list, dma_exclude):
 
 def write_dma_header(f, peripheral_list, mcu_type, dma_exclude=[],
                      dma_priority='', dma_noshare=''):
-    '''write out a DMA resolver header file'''
+    '''write out a DMA resolver header file, returning the list of
+    peripherals that could not be given a DMA stream'''
     global dma_map, have_DMAMUX
 
     # form a list of DMA priorities
@@ -387,6 +388,8 @@ def write_dma_header(f, peripheral_list, mcu_type, dma_exclude=[],
         f.write('#define STM32_SPI_%s_DMA_STREAMS STM32_SPI_%s_TX_%s_STREAM, STM32_SPI_%s_RX_%s_STREAM\n' % (
             key, key, dma_name(key), key, dma_name(key)))
 
+    return unassigned
+
 
 if __name__ == '__main__':
     import optparse
@@ -65,6 +65,12 @@ void Shared_DMA::unregister()
 void Shared_DMA::lock_stream(uint8_t stream_id)
 {
     if (stream_id < SHARED_DMA_MAX_STREAM_ID) {
+        chSysLock();
+        if (chBSemGetStateI(&locks[stream_id].semaphore)) {
+            // some other driver has it, we will have to wait
+            locks[stream_id].stats.contended++;
+        }
+        chSysUnlock();
         chBSemWait(&locks[stream_id].semaphore);
     }
 }
@@ -94,9 +100,57 @@ bool Shared_DMA::lock_stream_nonblocking(uint8_t stream_id)
     return true;
 }
 
+// note a driver failing to get a stream held by another driver
+void Shared_DMA::note_contention(uint8_t stream_id)
+{
+    if (stream_id >= SHARED_DMA_MAX_STREAM_ID) {
+        return;
+    }
+    chSysDisable();
+    if (locks[stream_id].obj != nullptr && locks[stream_id].obj != this) {
+        locks[stream_id].obj->contention = true;
+    }
+    locks[stream_id].stats.contended++;
+    chSysEnable();
+}
+
+// update the statistics of a stream we have just locked
+void Shared_DMA::update_lock_stats(uint8_t stream_id, uint32_t wait_us)
+{
+    if (stream_id >= SHARED_DMA_MAX_STREAM_ID) {
+        return;
+    }
+    auto &stats = locks[stream_id].stats;
+    stats.locks++;
+    uint8_t b = 0;
+    while (b < AP_HAL::Util::DMA_WAIT_BUCKETS-1 && wait_us >= (16U<<b)) {
+        b++;
+    }
+    stats.wait_hist[b]++;
+    uint8_t i = 0;
+    while (i < stats.num_owners && stats.owners[i] != this) {
+        i++;
+    }
+    if (i == stats.num_owners && i < SHARED_DMA_MAX_OWNERS) {
+        stats.owners[stats.num_owners++] = this;
+    }
+    stats.lock_us = AP_HAL::micros();
+}
+
+// update the statistics of a stream we are about to unlock
+void Shared_DMA::update_unlock_stats(uint8_t stream_id)
+{
+    if (stream_id >= SHARED_DMA_MAX_STREAM_ID) {
+        return;
+    }
+    auto &stats = locks[stream_id].stats;
+    const uint32_t hold_us = AP_HAL::micros() - stats.lock_us;
+    stats.hold_total_us += hold_us;
+    stats.hold_max_us = MAX(stats.hold_max_us, hold_us);
+}
 
 // lock the DMA channels
-void Shared_DMA::lock_core(void)
+void Shared_DMA::lock_core(uint32_t wait_us)
 {
     // see if another driver has DMA allocated. If so, call their
     // deallocation function
@@ -104,11 +158,13 @@ void Shared_DMA::lock_core(void)
         locks[stream_id1].obj && locks[stream_id1].obj != this) {
         locks[stream_id1].deallocate(locks[stream_id1].obj);
         locks[stream_id1].obj = nullptr;
+        locks[stream_id1].stats.handovers++;
     }
     if (stream_id2 < SHARED_DMA_MAX_STREAM_ID &&
         locks[stream_id2].obj && locks[stream_id2].obj != this) {
         locks[stream_id2].deallocate(locks[stream_id2].obj);
         locks[stream_id2].obj = nullptr;
+        locks[stream_id2].stats.handovers++;
     }
     if ((stream_id1 < SHARED_DMA_MAX_STREAM_ID && locks[stream_id1].obj == nullptr) ||
         (stream_id2 < SHARED_DMA_MAX_STREAM_ID && locks[stream_id2].obj == nullptr)) {
@@ -130,40 +186,36 @@ void Shared_DMA::lock_core(void)
         allocate(this);
     }
 #endif
+    update_lock_stats(stream_id1, wait_us);
+    update_lock_stats(stream_id2, wait_us);
     have_lock = true;
 }
 
 // lock the DMA channels, blocking method
 void Shared_DMA::lock(void)
 {
+    const uint32_t start_us = AP_HAL::micros();
     lock_stream(stream_id1);
     lock_stream(stream_id2);
-    lock_core();
+    lock_core(AP_HAL::micros() - start_us);
 }
 
 // lock the DMA channels, non-blocking
 bool Shared_DMA::lock_nonblock(void)
 {
+    const uint32_t start_us = AP_HAL::micros();
     if (!lock_stream_nonblocking(stream_id1)) {
-        chSysDisable();
-        if (locks[stream_id1].obj != nullptr && locks[stream_id1].obj != this) {
-            locks[stream_id1].obj->contention = true;
-        }
-        chSysEnable();
+        note_contention(stream_id1);
         contention = true;
         return false;
     }
     if (!lock_stream_nonblocking(stream_id2)) {
         unlock_stream(stream_id1);
-        chSysDisable();
-        if (locks[stream_id2].obj != nullptr && locks[stream_id2].obj != this) {
-            locks[stream_id2].obj->contention = true;
-        }
-        chSysEnable();
+        note_contention(stream_id2);
         contention = true;
         return false;
     }
-    lock_core();
+    lock_core(AP_HAL::micros() - start_us);
     return true;
 }
 
@@ -171,6 +223,8 @@ bool Shared_DMA::lock_nonblock(void)
 void Shared_DMA::unlock(void)
 {
     osalDbgAssert(have_lock, "must have lock");
+    update_unlock_stats(stream_id2);
+    update_unlock_stats(stream_id1);
     unlock_stream(stream_id2);
     unlock_stream(stream_id1);
     have_lock = false;
@@ -180,6 +234,8 @@ void Shared_DMA::unlock(void)
 void Shared_DMA::unlock_from_lockzone(void)
 {
     osalDbgAssert(have_lock, "must have lock");
+    update_unlock_stats(stream_id2);
+    update_unlock_stats(stream_id1);
     if (stream_id2 < SHARED_DMA_MAX_STREAM_ID) {
         unlock_stream_from_IRQ(stream_id2);
         chSchRescheduleS();
@@ -195,6 +251,8 @@ void Shared_DMA::unlock_from_lockzone(void)
 void Shared_DMA::unlock_from_IRQ(void)
 {
     osalDbgAssert(have_lock, "must have lock");
+    update_unlock_stats(stream_id2);
+    update_unlock_stats(stream_id1);
     unlock_stream_from_IRQ(stream_id2);
     unlock_stream_from_IRQ(stream_id1);
     have_lock = false;
@@ -211,4 +269,33 @@ void Shared_DMA::lock_all(void)
     }
 }
 
+/*
+  get the statistics of the idx'th stream which has been locked
+ */
+bool Shared_DMA::get_stats(uint8_t idx, AP_HAL::Util::DMAStats &stats)
+{
+    for (uint8_t i=0; i<SHARED_DMA_MAX_STREAM_ID; i++) {
+        if (locks[i].stats.locks == 0) {
+            continue;
+        }
+        if (idx-- != 0) {
+            continue;
+        }
+        chSysLock();
+        const auto s = locks[i].stats;
+        chSysUnlock();
+        stats.controller = 1 + i / 8;
+        stats.stream = i % 8;
+        stats.owners = s.num_owners;
+        stats.locks = s.locks;
+        stats.contended = s.contended;
+        stats.handovers = s.handovers;
+        stats.hold_avg_us = s.hold_total_us / s.locks;
+        stats.hold_max_us = s.hold_max_us;
+        memcpy(stats.wait_hist, s.wait_hist, sizeof(stats.wait_hist));
+        return true;
+    }
+    return false;
+}
+
 #endif // CH_CFG_USE_SEMAPHORES && STM32_DMA_ADVANCED
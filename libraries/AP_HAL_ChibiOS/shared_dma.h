@@ -25,6 +25,9 @@
 // DMA stream ID for stream_id2 when only one is needed
 #define SHARED_DMA_NONE 255
 
+// drivers counted in the owners of a stream
+#define SHARED_DMA_MAX_OWNERS 8
+
 class ChibiOS::Shared_DMA
 {
 public:
@@ -66,7 +69,10 @@ public:
     
     // lock all shared DMA channels. Used on reboot
     static void lock_all(void);
-    
+
+    // get the statistics of the idx'th stream which has been locked
+    static bool get_stats(uint8_t idx, AP_HAL::Util::DMAStats &stats);
+
 private:
     dma_allocate_fn_t allocate;
     dma_allocate_fn_t deallocate;
@@ -78,8 +84,9 @@ private:
     // the UART driver uses this to change its max transmit size to reduce latency
     bool contention;
 
-    // core of lock call, after semaphores gained
-    void lock_core(void);
+    // core of lock call, after semaphores gained, having waited
+    // wait_us for them
+    void lock_core(uint32_t wait_us);
 
     // lock one stream
     static void lock_stream(uint8_t stream_id);
@@ -92,7 +99,14 @@ private:
 
     // lock one stream, non-blocking
     bool lock_stream_nonblocking(uint8_t stream_id);
-    
+
+    // note a driver failing to get, or waiting for, a stream
+    void note_contention(uint8_t stream_id);
+
+    // update the statistics of a stream on lock and unlock
+    void update_lock_stats(uint8_t stream_id, uint32_t wait_us);
+    void update_unlock_stats(uint8_t stream_id);
+
     static struct dma_lock {
         // semaphore to ensure only one peripheral uses a DMA channel at a time
 #if CH_CFG_USE_SEMAPHORES == TRUE
@@ -104,6 +118,21 @@ private:
 
         // point to object that holds the allocation, if allocated
         Shared_DMA *obj;
+
+        // statistics, updated while the stream is locked apart from
+        // contended
+        struct {
+            uint32_t locks;
+            uint32_t contended;
+            uint32_t handovers;
+            uint64_t hold_total_us;
+            uint32_t hold_max_us;
+            uint32_t lock_us;
+            uint32_t wait_hist[AP_HAL::Util::DMA_WAIT_BUCKETS];
+            // the drivers which have locked the stream
+            Shared_DMA *owners[SHARED_DMA_MAX_OWNERS];
+            uint8_t num_owners;
+        } stats;
     } locks[SHARED_DMA_MAX_STREAM_ID+1];
 };
 #endif //#if STM32_DMA_ADVANCED
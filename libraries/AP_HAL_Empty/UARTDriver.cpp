@@ -15,6 +15,7 @@ bool Empty::UARTDriver::tx_pending() { return false; }
 uint32_t Empty::UARTDriver::available() { return 0; }
 uint32_t Empty::UARTDriver::txspace() { return 1; }
 int16_t Empty::UARTDriver::read() { return -1; }
+ssize_t Empty::UARTDriver::read(uint8_t *buffer, uint16_t count) { return -1; }
 
 /* Empty implementations of Print virtual methods */
 size_t Empty::UARTDriver::write(uint8_t c) { return 0; }
@@ -68,6 +68,15 @@ ssize_t ConsoleDevice::write(const uint8_t *buf, uint16_t n)
     return ::write(_wr_fd, buf, n);
 }
 
+ssize_t ConsoleDevice::writev(const struct iovec *iov, uint8_t count)
+{
+    if (_closed) {
+        return -EAGAIN;
+    }
+
+    return ::writev(_wr_fd, iov, count);
+}
+
 void ConsoleDevice::set_blocking(bool blocking)
 {
     int rd_flags;
@@ -43,6 +43,22 @@
 #include <cmath>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FLOW_PX4_NEON 1
+
+/* add up the 8 lanes of a vector */
+static inline uint32_t sum_u16x8(uint16x8_t v)
+{
+    const uint64x2_t sum = vpaddlq_u32(vpaddlq_u16(v));
+    return vgetq_lane_u32(vreinterpretq_u32_u64(sum), 0) +
+           vgetq_lane_u32(vreinterpretq_u32_u64(sum), 2);
+}
+#else
+#define FLOW_PX4_NEON 0
+#endif
 
 extern const AP_HAL::HAL& hal;
 
@@ -137,6 +153,19 @@ static inline uint32_t compute_sad(uint8_t *image1, uint8_t *image2,
     unsigned int i,j;
     uint32_t acc = 0;
 
+#if FLOW_PX4_NEON
+    /* an 8x8 window is a row per vector, and 8 rows of differences
+     * can't overflow the 16 bit lanes */
+    if (window_size == 8) {
+        uint16x8_t sum = vdupq_n_u16(0);
+        for (j = 0; j < 8; j++) {
+            sum = vabal_u8(sum, vld1_u8(&image1[off1 + j*row_size]),
+                           vld1_u8(&image2[off2 + j*row_size]));
+        }
+        return sum_u16x8(sum);
+    }
+#endif
+
     for (i = 0; i < window_size; i++) {
         for (j = 0; j < window_size; j++) {
             acc += abs(image1[off1 + i + j*row_size] -
@@ -171,6 +200,48 @@ static inline uint32_t compute_subpixel(uint8_t *image1, uint8_t *image2,
 
     memset(acc, 0, window_size * sizeof(uint32_t));
 
+#if FLOW_PX4_NEON
+    /* a row of the window at a time. vhadd and the narrowing shift
+     * truncate as the divisions below do, so the distances are the
+     * same */
+    if (window_size == 8) {
+        uint16x8_t sum[8];
+        for (k = 0; k < 8; k++) {
+            sum[k] = vdupq_n_u16(0);
+        }
+        for (j = 0; j < 8; j++) {
+            const uint8_t *row = &image2[off2 + j*row_size];
+            const uint8x8_t base = vld1_u8(&image1[off1 + j*row_size]);
+            const uint8x8_t c = vld1_u8(row);
+            const uint8x8_t r = vld1_u8(row + 1);
+            const uint8x8_t l = vld1_u8(row - 1);
+            const uint8x8_t d = vld1_u8(row + row_size);
+            const uint8x8_t dr = vld1_u8(row + row_size + 1);
+            const uint8x8_t dl = vld1_u8(row + row_size - 1);
+            const uint8x8_t u = vld1_u8(row - row_size);
+            const uint8x8_t ur = vld1_u8(row - row_size + 1);
+            const uint8x8_t ul = vld1_u8(row - row_size - 1);
+
+            sum[0] = vabal_u8(sum[0], base, vhadd_u8(c, r));
+            sum[1] = vabal_u8(sum[1], base,
+                              vshrn_n_u16(vaddq_u16(vaddl_u8(c, r), vaddl_u8(d, dr)), 2));
+            sum[2] = vabal_u8(sum[2], base, vhadd_u8(c, dr));
+            sum[3] = vabal_u8(sum[3], base,
+                              vshrn_n_u16(vaddq_u16(vaddl_u8(c, l), vaddl_u8(dl, d)), 2));
+            sum[4] = vabal_u8(sum[4], base, vhadd_u8(c, dl));
+            sum[5] = vabal_u8(sum[5], base,
+                              vshrn_n_u16(vaddq_u16(vaddl_u8(c, l), vaddl_u8(ul, u)), 2));
+            sum[6] = vabal_u8(sum[6], base, vhadd_u8(c, u));
+            sum[7] = vabal_u8(sum[7], base,
+                              vshrn_n_u16(vaddq_u16(vaddl_u8(c, r), vaddl_u8(u, ur)), 2));
+        }
+        for (k = 0; k < 8; k++) {
+            acc[k] = sum_u16x8(sum[k]);
+        }
+        return 0;
+    }
+#endif
+
     for (i = 0; i < window_size; i++) {
         for (j = 0; j < window_size; j++) {
             /* the 8 s values are from following positions for each pixel (X):
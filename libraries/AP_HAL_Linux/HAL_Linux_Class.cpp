@@ -1,6 +1,7 @@
 #include "HAL_Linux_Class.h"
 
 #include <assert.h>
+#include <sched.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -233,6 +234,44 @@ HAL_Linux::HAL_Linux() :
         nullptr)
 {}
 
+/*
+  parse a list of CPUs such as "0,2-3"
+ */
+static bool _parse_cpu_set(const char *str, cpu_set_t &cpus)
+{
+    CPU_ZERO(&cpus);
+
+    while (*str != '\0') {
+        char *end;
+        long first = strtol(str, &end, 10);
+        long last = first;
+        if (end == str) {
+            return false;
+        }
+        if (*end == '-') {
+            str = end + 1;
+            last = strtol(str, &end, 10);
+            if (end == str) {
+                return false;
+            }
+        }
+        if (first < 0 || last < first || last >= CPU_SETSIZE) {
+            return false;
+        }
+        for (long cpu = first; cpu <= last; cpu++) {
+            CPU_SET(cpu, &cpus);
+        }
+        if (*end == ',') {
+            end++;
+        } else if (*end != '\0') {
+            return false;
+        }
+        str = end;
+    }
+
+    return CPU_COUNT(&cpus) > 0;
+}
+
 void _usage(void)
 {
     printf("Usage: -A uartAPath -B uartBPath -C uartCPath -D uartDPath -E uartEPath -F uartFPath -G uartGpath\n");
@@ -253,6 +292,15 @@ void _usage(void)
     printf("\tcustom terrain path:\n");
     printf("\t                   --terrain-directory /var/APM/terrain\n");
     printf("\t                   -t /var/APM/terrain\n");
+    printf("\tCPU affinity of the process:\n");
+    printf("\t                   --cpu-affinity 1-3\n");
+    printf("\t                   -c 1,3\n");
+    printf("\tpin a thread (main, timer, uart, rcin, io) to a CPU, isolated or not:\n");
+    printf("\t                   --thread-cpu main=2 --thread-cpu timer=3\n");
+    printf("\tSCHED_DEADLINE for the main loop, runtime:period in microseconds:\n");
+    printf("\t                   --main-deadline 1500:2500\n");
+    printf("\treport how late each loop wakes up:\n");
+    printf("\t                   --report-wakeups\n");
 #if AP_MODULE_SUPPORTED
     printf("\tmodule support:\n");
     printf("\t                   --module-directory %s\n", AP_MODULE_DEFAULT_DIRECTORY);
@@ -281,11 +329,15 @@ void HAL_Linux::run(int argc, char* const argv[], Callbacks* callbacks) const
         {"terrain-directory",   true,  0, 't'},
         {"storage-directory",   true,  0, 's'},
         {"module-directory",    true,  0, 'M'},
+        {"cpu-affinity",        true,  0, 'c'},
+        {"thread-cpu",          true,  0, 'T'},
+        {"main-deadline",       true,  0, 'L'},
+        {"report-wakeups",      false, 0, 'W'},
         {"help",                false,  0, 'h'},
         {0, false, 0, 0}
     };
 
-    GetOptLong gopt(argc, argv, "A:B:C:D:E:F:l:t:s:he:SM:",
+    GetOptLong gopt(argc, argv, "A:B:C:D:E:F:l:t:s:he:SM:c:",
                     options);
 
     /*
@@ -323,6 +375,38 @@ void HAL_Linux::run(int argc, char* const argv[], Callbacks* callbacks) const
         case 's':
             utilInstance.set_custom_storage_directory(gopt.optarg);
             break;
+        case 'c': {
+            cpu_set_t cpus;
+            if (!_parse_cpu_set(gopt.optarg, cpus)) {
+                printf("Bad CPU list '%s'\n", gopt.optarg);
+                exit(1);
+            }
+            schedulerInstance.set_cpu_affinity(cpus);
+            break;
+        }
+        case 'T': {
+            char name[16];
+            int cpu;
+            if (sscanf(gopt.optarg, "%15[^=]=%d", name, &cpu) != 2 ||
+                !schedulerInstance.set_thread_cpu(name, cpu)) {
+                printf("Bad thread CPU '%s'\n", gopt.optarg);
+                exit(1);
+            }
+            break;
+        }
+        case 'L': {
+            unsigned runtime_us, period_us;
+            if (sscanf(gopt.optarg, "%u:%u", &runtime_us, &period_us) != 2 ||
+                runtime_us == 0 || runtime_us > period_us) {
+                printf("Bad main deadline '%s'\n", gopt.optarg);
+                exit(1);
+            }
+            schedulerInstance.set_main_deadline(runtime_us, period_us);
+            break;
+        }
+        case 'W':
+            schedulerInstance.set_report_wakeups(true);
+            break;
 #if AP_MODULE_SUPPORTED
         case 'M':
             module_path = gopt.optarg;
@@ -370,6 +454,8 @@ void HAL_Linux::run(int argc, char* const argv[], Callbacks* callbacks) const
     AP_Module::call_hook_setup_complete();
 #endif
 
+    Scheduler::from(scheduler)->start_main_loop();
+
     while (!_should_exit) {
         callbacks->loop();
     }
@@ -94,6 +94,10 @@ public:
     int fd = -1;
     uint8_t bus;
     uint8_t ref;
+
+    // time spent in I2C_RDWR calls and the number of calls
+    uint32_t busy_us;
+    uint32_t transactions;
 };
 
 I2CBus::~I2CBus()
@@ -190,13 +194,80 @@ bool I2CDevice::transfer(const uint8_t *send, uint32_t send_len,
     i2c_data.msgs = msgs;
     i2c_data.nmsgs = nmsgs;
 
+    return _rdwr(&i2c_data) != -1;
+}
+
+/*
+  do the transfers as one I2C_RDWR call, which joins them with
+  repeated starts. Devices that need split transfers do them one at a
+  time. A failed call may have done some of the transfers, but reports
+  none as done
+ */
+uint8_t I2CDevice::transfer_batch(const BatchTransfer *transfers, uint8_t count)
+{
+    if (_split_transfers || count == 0 || 2 * count > I2C_RDRW_IOCTL_MAX_MSGS) {
+        return AP_HAL::I2CDevice::transfer_batch(transfers, count);
+    }
+
+    struct i2c_msg msgs[2 * count];
+    unsigned nmsgs = 0;
+
+    memset(msgs, 0, sizeof(msgs));
+
+    for (uint8_t i = 0; i < count; i++) {
+        const BatchTransfer &t = transfers[i];
+        if (t.send && t.send_len != 0) {
+            msgs[nmsgs].addr = _address;
+            msgs[nmsgs].flags = 0;
+            msgs[nmsgs].buf = const_cast<uint8_t*>(t.send);
+            msgs[nmsgs].len = t.send_len;
+            nmsgs++;
+        }
+        if (t.recv && t.recv_len != 0) {
+            msgs[nmsgs].addr = _address;
+            msgs[nmsgs].flags = I2C_M_RD;
+            msgs[nmsgs].buf = t.recv;
+            msgs[nmsgs].len = t.recv_len;
+            nmsgs++;
+        }
+    }
+
+    if (!nmsgs) {
+        return 0;
+    }
+
+    struct i2c_rdwr_ioctl_data i2c_data = { };
+
+    i2c_data.msgs = msgs;
+    i2c_data.nmsgs = nmsgs;
+
+    return _rdwr(&i2c_data) != -1 ? count : 0;
+}
+
+/*
+  I2C_RDWR with retries, counted in the bus statistics
+ */
+int I2CDevice::_rdwr(struct i2c_rdwr_ioctl_data *i2c_data)
+{
+    const uint32_t start_us = AP_HAL::micros();
     int r;
     unsigned retries = _retries;
     do {
-        r = ::ioctl(_bus.fd, I2C_RDWR, &i2c_data);
+        r = ::ioctl(_bus.fd, I2C_RDWR, i2c_data);
+        _bus.transactions++;
     } while (r == -1 && retries-- > 0);
 
-    return r != -1;
+    const uint32_t busy_us = AP_HAL::micros() - start_us;
+    _busy_us += busy_us;
+    _bus.busy_us += busy_us;
+    return r;
+}
+
+bool I2CDevice::get_bus_stats(uint32_t &busy_us, uint32_t &transactions) const
+{
+    busy_us = _bus.busy_us;
+    transactions = _bus.transactions;
+    return true;
 }
 
 bool I2CDevice::read_registers_multiple(uint8_t first_reg, uint8_t *recv,
@@ -229,13 +300,7 @@ bool I2CDevice::read_registers_multiple(uint8_t first_reg, uint8_t *recv,
             recv += recv_len;
         };
 
-        int r;
-        unsigned retries = _retries;
-        do {
-            r = ::ioctl(_bus.fd, I2C_RDWR, &i2c_data);
-        } while (r == -1 && retries-- > 0);
-
-        if (r == -1) {
+        if (_rdwr(&i2c_data) == -1) {
             return false;
         }
 
@@ -25,6 +25,8 @@
 
 #include "Semaphores.h"
 
+struct i2c_rdwr_ioctl_data;
+
 namespace Linux {
 
 class I2CBus;
@@ -57,9 +59,18 @@ public:
     bool transfer(const uint8_t *send, uint32_t send_len,
                   uint8_t *recv, uint32_t recv_len) override;
 
+    /* See AP_HAL::Device::transfer_batch() */
+    uint8_t transfer_batch(const BatchTransfer *transfers, uint8_t count) override;
+
     bool read_registers_multiple(uint8_t first_reg, uint8_t *recv,
                                  uint32_t recv_len, uint8_t times) override;
 
+    /* See AP_HAL::Device::get_bus_busy_us() */
+    uint32_t get_bus_busy_us() const override { return _busy_us; }
+
+    /* See AP_HAL::Device::get_bus_stats() */
+    bool get_bus_stats(uint32_t &busy_us, uint32_t &transactions) const override;
+
     /* See AP_HAL::Device::get_semaphore() */
     AP_HAL::Semaphore *get_semaphore() override;
 
@@ -81,6 +92,11 @@ protected:
     uint8_t _address;
     uint8_t _retries = 0;
     bool _split_transfers = false;
+
+    // time spent in I2C_RDWR calls for this device
+    uint32_t _busy_us;
+
+    int _rdwr(struct i2c_rdwr_ioctl_data *i2c_data);
 };
 
 class I2CDeviceManager : public AP_HAL::I2CDeviceManager {
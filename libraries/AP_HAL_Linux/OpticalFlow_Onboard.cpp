@@ -17,6 +17,7 @@
 #if CONFIG_HAL_BOARD_SUBTYPE == HAL_BOARD_SUBTYPE_LINUX_BEBOP
 #include "OpticalFlow_Onboard.h"
 
+#include <algorithm>
 #include <fcntl.h>
 #include <linux/v4l2-mediabus.h>
 #include <pthread.h>
@@ -90,7 +91,16 @@ void OpticalFlow_Onboard::init()
                                    V4L2_MBUS_FMT_UYVY8_2X8)) {
         AP_HAL::panic("OpticalFlow_Onboard: couldn't set subdev fmt\n");
     }
-    _format = V4L2_PIX_FMT_NV12;
+    /* prefer GREY where the video node offers it, as then only the
+     * luma plane is written to memory */
+    std::vector<uint32_t> formats;
+    _videoin->get_pixel_formats(&formats);
+    if (std::find(formats.begin(), formats.end(),
+                  (uint32_t)V4L2_PIX_FMT_GREY) != formats.end()) {
+        _format = V4L2_PIX_FMT_GREY;
+    } else {
+        _format = V4L2_PIX_FMT_NV12;
+    }
 #endif
 
     if (!_videoin->set_format(&_width, &_height, &_format, &_bytesperline,
@@ -139,6 +149,11 @@ void OpticalFlow_Onboard::init()
         }
     }
 
+    if (_format == V4L2_PIX_FMT_YUYV) {
+        /* the flow sees the packed grey image made from each frame */
+        _bytesperline = _width;
+    }
+
     if (!_videoin->allocate_buffers(nbufs)) {
         AP_HAL::panic("OpticalFlow_Onboard: couldn't allocate video buffers");
     }
@@ -170,7 +185,7 @@ void OpticalFlow_Onboard::init()
         AP_HAL::panic("OpticalFlow_Onboard: failed to create thread");
     }
 
-    _gyro_ring_buffer = new ObjectBuffer<GyroSample>(OPTICAL_FLOW_GYRO_BUFFER_LEN);
+    _gyro_ring_buffer = new ObjectBufferSPSC<GyroSample>(OPTICAL_FLOW_GYRO_BUFFER_LEN);
 
     _initialized = true;
 }
@@ -255,33 +270,41 @@ void OpticalFlow_Onboard::_run_optflow()
     uint32_t crop_left = 0, crop_top = 0;
     uint32_t shrink_scale = 0, shrink_width = 0, shrink_height = 0;
     uint32_t shrink_width_offset = 0, shrink_height_offset = 0;
-    uint8_t *convert_buffer = nullptr, *output_buffer = nullptr;
+    uint8_t *convert_buffer = nullptr, *output_buffers[2] = {};
+    uint8_t *last_image = nullptr;
+    uint8_t output_index = 0;
     uint8_t qual;
 
-    if (_format == V4L2_PIX_FMT_YUYV) {
-        if (_shrink_by_software || _crop_by_software) {
-            convert_buffer_size = _camera_output_width * _camera_output_height;
-        } else {
-            convert_buffer_size = _width * _height;
-        }
-
-        convert_buffer = (uint8_t *)calloc(1, convert_buffer_size);
-        if (!convert_buffer) {
-            AP_HAL::panic("OpticalFlow_Onboard: couldn't allocate conversion buffer\n");
-        }
-    }
+    /* a GREY or NV12 frame which the camera has already cropped and
+     * scaled is handed to the flow as it is, straight from the mmap'd
+     * buffer. Otherwise each frame is turned into one of two output
+     * buffers of our own, and the video buffer given back at once */
+    const bool direct = _format != V4L2_PIX_FMT_YUYV &&
+        !_shrink_by_software && !_crop_by_software;
 
-    if (_shrink_by_software || _crop_by_software) {
+    if (!direct) {
         output_buffer_size = HAL_OPTFLOW_ONBOARD_OUTPUT_WIDTH *
             HAL_OPTFLOW_ONBOARD_OUTPUT_HEIGHT;
 
-        output_buffer = (uint8_t *)calloc(1, output_buffer_size);
-        if (!output_buffer) {
-            if (convert_buffer) {
-                free(convert_buffer);
+        for (uint8_t i = 0; i < 2; i++) {
+            output_buffers[i] = (uint8_t *)calloc(1, output_buffer_size);
+            if (!output_buffers[i]) {
+                AP_HAL::panic("OpticalFlow_Onboard: couldn't allocate output buffer\n");
             }
+        }
+    }
+
+    if (_format == V4L2_PIX_FMT_YUYV) {
+        if (_shrink_by_software || _crop_by_software) {
+            convert_buffer_size = _camera_output_width * _camera_output_height;
 
-            AP_HAL::panic("OpticalFlow_Onboard: couldn't allocate crop buffer\n");
+            convert_buffer = (uint8_t *)calloc(1, convert_buffer_size);
+            if (!convert_buffer) {
+                AP_HAL::panic("OpticalFlow_Onboard: couldn't allocate conversion buffer\n");
+            }
+        } else {
+            /* converted straight into the output buffer */
+            convert_buffer_size = _width * _height;
         }
     }
 
@@ -309,48 +332,45 @@ void OpticalFlow_Onboard::_run_optflow()
     while(true) {
         /* wait for next frame to come */
         if (!_videoin->get_frame(video_frame)) {
-            if (convert_buffer) {
-               free(convert_buffer);
-            }
-
-            if (output_buffer) {
-               free(output_buffer);
-            }
-
             AP_HAL::panic("OpticalFlow_Onboard: couldn't get frame\n");
         }
 
-        if (_format == V4L2_PIX_FMT_YUYV) {
-            VideoIn::yuyv_to_grey((uint8_t *)video_frame.data,
-                convert_buffer_size * 2, convert_buffer);
+        /* the luma plane comes first in GREY and NV12 frames */
+        uint8_t *image = (uint8_t *)video_frame.data;
 
-            memset(video_frame.data, 0, convert_buffer_size * 2);
-            memcpy(video_frame.data, convert_buffer, convert_buffer_size);
-        }
+        if (!direct) {
+            uint8_t *output = output_buffers[output_index];
+            uint8_t *grey = image;
+
+            if (_format == V4L2_PIX_FMT_YUYV) {
+                grey = convert_buffer ? convert_buffer : output;
+                VideoIn::yuyv_to_grey(image, convert_buffer_size * 2, grey);
+            }
+
+            if (_shrink_by_software) {
+                /* shrink_8bpp() will shrink a selected area using the offsets,
+                 * therefore, we don't need the crop. */
+                VideoIn::shrink_8bpp(grey, output,
+                                     _camera_output_width, _camera_output_height,
+                                     shrink_width_offset, shrink_width,
+                                     shrink_height_offset, shrink_height,
+                                     shrink_scale, shrink_scale);
+            } else if (_crop_by_software) {
+                VideoIn::crop_8bpp(grey, output,
+                                   _camera_output_width,
+                                   crop_left, HAL_OPTFLOW_ONBOARD_OUTPUT_WIDTH,
+                                   crop_top, HAL_OPTFLOW_ONBOARD_OUTPUT_HEIGHT);
+            }
 
-        if (_shrink_by_software) {
-            /* shrink_8bpp() will shrink a selected area using the offsets,
-             * therefore, we don't need the crop. */
-            VideoIn::shrink_8bpp((uint8_t *)video_frame.data, output_buffer,
-                                 _camera_output_width, _camera_output_height,
-                                 shrink_width_offset, shrink_width,
-                                 shrink_height_offset, shrink_height,
-                                 shrink_scale, shrink_scale);
-            memset(video_frame.data, 0, _camera_output_width * _camera_output_height);
-            memcpy(video_frame.data, output_buffer, output_buffer_size);
-        } else if (_crop_by_software) {
-            VideoIn::crop_8bpp((uint8_t *)video_frame.data, output_buffer,
-                               _camera_output_width,
-                               crop_left, HAL_OPTFLOW_ONBOARD_OUTPUT_WIDTH,
-                               crop_top, HAL_OPTFLOW_ONBOARD_OUTPUT_HEIGHT);
-
-            memset(video_frame.data, 0, _camera_output_width * _camera_output_height);
-            memcpy(video_frame.data, output_buffer, output_buffer_size);
+            _videoin->put_frame(video_frame);
+            image = output;
+            output_index ^= 1;
         }
 
         /* if it is at least the second frame we receive
          * since we have to compare 2 frames */
-        if (_last_video_frame.data == nullptr) {
+        if (last_image == nullptr) {
+            last_image = image;
             _last_video_frame = video_frame;
             continue;
         }
@@ -363,7 +383,7 @@ void OpticalFlow_Onboard::_run_optflow()
                 | O_APPEND, S_IRUSR | S_IWUSR | S_IRGRP |
                 S_IWGRP | S_IROTH | S_IWOTH);
 	    if (fd != -1) {
-	        write(fd, video_frame.data, _sizeimage);
+	        write(fd, image, direct ? _sizeimage : output_buffer_size);
 #ifdef OPTICALFLOW_ONBOARD_RECORD_METADATAS
             struct PACKED {
                 uint32_t timestamp;
@@ -380,8 +400,7 @@ void OpticalFlow_Onboard::_run_optflow()
         /* compute gyro data and video frames
          * get flow rate to send it to the opticalflow driver
          */
-        qual = _flow->compute_flow((uint8_t*)_last_video_frame.data,
-                                   (uint8_t *)video_frame.data,
+        qual = _flow->compute_flow(last_image, image,
                                    video_frame.timestamp -
                                    _last_video_frame.timestamp,
                                    &flow_rate.x, &flow_rate.y);
@@ -405,18 +424,17 @@ void OpticalFlow_Onboard::_run_optflow()
         pthread_mutex_unlock(&_mutex);
 
         /* give the last frame back to the video input driver */
-        _videoin->put_frame(_last_video_frame);
+        if (direct) {
+            _videoin->put_frame(_last_video_frame);
+        }
+        last_image = image;
         _last_integration_time = gyro_sample.time_us;
         _last_video_frame = video_frame;
         _last_gyro_rate = gyro_sample.gyro;
     }
 
-    if (convert_buffer) {
-        free(convert_buffer);
-    }
-
-    if (output_buffer) {
-        free(output_buffer);
-    }
+    free(convert_buffer);
+    free(output_buffers[0]);
+    free(output_buffers[1]);
 }
 #endif
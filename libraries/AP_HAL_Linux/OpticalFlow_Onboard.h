@@ -73,7 +73,7 @@ private:
     Vector2f _gyro_bias;
     Vector2f _integrated_gyro;
     uint64_t _last_integration_time;
-    ObjectBuffer<GyroSample> *_gyro_ring_buffer;
+    ObjectBufferSPSC<GyroSample> *_gyro_ring_buffer;
 };
 
 }
@@ -15,8 +15,12 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <inttypes.h>
+#include <linux/perf_event.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/syscall.h>
 #include <time.h>
+#include <unistd.h>
 #include <vector>
 
 #include <AP_HAL/AP_HAL.h>
@@ -37,6 +41,17 @@ static const AP_HAL::HAL &hal = AP_HAL::get_HAL();
 
 Perf *Perf::_singleton;
 
+/* number the threads in the order they first trace */
+static inline uint16_t trace_thread()
+{
+    static std::atomic<uint16_t> num_threads;
+    static thread_local uint16_t thread;
+    if (thread == 0) {
+        thread = ++num_threads;
+    }
+    return thread;
+}
+
 static inline uint64_t now_nsec()
 {
     struct timespec ts;
@@ -92,6 +107,61 @@ void Perf::_debug_counters()
     _last_debug_msec = now;
 }
 
+void Perf::print_summary(FILE *f)
+{
+    pthread_rwlock_rdlock(&_perf_counters_lock);
+    auto v = _perf_counters;
+    pthread_rwlock_unlock(&_perf_counters_lock);
+
+    fprintf(f, "%-30s %10s %12s %12s %12s %12s %14s\n",
+            "counter", "count", "avg(ns)", "min(ns)", "max(ns)", "stddev(ns)",
+            _cache_miss_fd >= 0 ? "cachemiss/call" : "");
+
+    for (auto &c : v) {
+        if (!c.count || c.type != Util::PC_ELAPSED) {
+            continue;
+        }
+        fprintf(f, "%-30s %10" PRIu64 " %12.1f %12" PRIu64 " %12" PRIu64 " %12.1f",
+                c.name, c.count, c.avg, c.min, c.max, sqrt(c.m2 / c.count));
+        if (_cache_miss_fd >= 0) {
+            fprintf(f, " %14.1f", (double)c.cache_misses / c.count);
+        }
+        fprintf(f, "\n");
+    }
+}
+
+bool Perf::enable_cache_miss_counting()
+{
+    if (_cache_miss_fd >= 0) {
+        return true;
+    }
+
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    /* count on the calling thread only, on any CPU */
+    _cache_miss_fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+
+    return _cache_miss_fd >= 0;
+}
+
+uint64_t Perf::_read_cache_misses()
+{
+    uint64_t value = 0;
+
+    if (_cache_miss_fd < 0 ||
+        read(_cache_miss_fd, &value, sizeof(value)) != sizeof(value)) {
+        return 0;
+    }
+
+    return value;
+}
+
 Perf::Perf()
 {
     if (pthread_rwlock_init(&_perf_counters_lock, nullptr) != 0) {
@@ -132,8 +202,13 @@ void Perf::begin(Util::perf_counter_t pc)
 
     _update_count++;
 
+    perf.cache_miss_start = _read_cache_misses();
     perf.start = now_nsec();
 
+    if (perf.trace_id >= 0) {
+        _trace.record(perf.trace_id, PerfTrace::Event::BEGIN, trace_thread());
+    }
+
     perf.lttng.begin(perf.name);
 }
 
@@ -162,6 +237,9 @@ void Perf::end(Util::perf_counter_t pc)
     _update_count++;
 
     const uint64_t elapsed = now_nsec() - perf.start;
+    if (_cache_miss_fd >= 0) {
+        perf.cache_misses += _read_cache_misses() - perf.cache_miss_start;
+    }
     perf.count++;
     perf.total += elapsed;
 
@@ -183,6 +261,10 @@ void Perf::end(Util::perf_counter_t pc)
     perf.m2 += (delta_intvl * (elapsed - perf.avg));
     perf.start = 0;
 
+    if (perf.trace_id >= 0) {
+        _trace.record(perf.trace_id, PerfTrace::Event::END, trace_thread());
+    }
+
     perf.lttng.end(perf.name);
 }
 
@@ -205,6 +287,10 @@ void Perf::count(Util::perf_counter_t pc)
     _update_count++;
     perf.count++;
 
+    if (perf.trace_id >= 0) {
+        _trace.record(perf.trace_id, PerfTrace::Event::COUNT, trace_thread());
+    }
+
     perf.lttng.count(perf.name, perf.count);
 }
 
@@ -221,6 +307,7 @@ Util::perf_counter_t Perf::add(Util::perf_counter_type type, const char *name)
     pthread_rwlock_wrlock(&_perf_counters_lock);
     Util::perf_counter_t pc = (Util::perf_counter_t) _perf_counters.size();
     _perf_counters.emplace_back(type, name);
+    _perf_counters.back().trace_id = _trace.add(name);
     pthread_rwlock_unlock(&_perf_counters_lock);
 
     return pc;
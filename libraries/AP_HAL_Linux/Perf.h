@@ -19,8 +19,11 @@
 #include <atomic>
 #include <limits.h>
 #include <pthread.h>
+#include <stdio.h>
 #include <vector>
 
+#include <AP_HAL/utility/PerfTrace.h>
+
 #include "AP_HAL_Linux.h"
 #include "Perf_Lttng.h"
 #include "Thread.h"
@@ -37,12 +40,17 @@ public:
         : name{name_}
         , type{type_}
         , min{ULONG_MAX}
+        , cache_miss_start{0}
+        , cache_misses{0}
     {
     }
 
     const char *name;
     Perf_Lttng lttng;
 
+    /* id in the event trace, -1 if it isn't traced */
+    int16_t trace_id = -1;
+
     perf_counter_type type;
 
     uint64_t count;
@@ -55,6 +63,10 @@ public:
 
     double avg;
     double m2;
+
+    /* hardware cache misses, only counted when enabled */
+    uint64_t cache_miss_start;
+    uint64_t cache_misses;
 };
 
 class Perf {
@@ -74,6 +86,19 @@ public:
 
     unsigned int get_update_count() { return _update_count; }
 
+    /*
+     * Count hardware cache misses of the calling thread between begin() and
+     * end() of every PC_ELAPSED counter. Returns false if the kernel or CPU
+     * does not provide the hardware counter.
+     */
+    bool enable_cache_miss_counting();
+
+    /* print a summary of all counters with per-call averages */
+    void print_summary(FILE *f);
+
+    /* write the recorded events as a Chrome trace */
+    bool write_trace(const char *path) { return _trace.write_chrome_trace(path); }
+
 private:
     static Perf *_singleton;
 
@@ -83,8 +108,15 @@ private:
 
     uint64_t _last_debug_msec;
 
+    uint64_t _read_cache_misses();
+
+    /* perf_event file descriptor for the cache miss counter, -1 if disabled */
+    int _cache_miss_fd = -1;
+
     std::vector<Perf_Counter> _perf_counters;
 
+    PerfTrace _trace;
+
     /* synchronize addition of new perf counters */
     pthread_rwlock_t _perf_counters_lock;
 
@@ -76,8 +76,10 @@ bool TimerPollable::adjust_timer(uint32_t timeout_usec)
 
     struct itimerspec spec = { };
 
-    spec.it_interval.tv_nsec = timeout_usec * AP_NSEC_PER_USEC;
-    spec.it_value.tv_nsec = timeout_usec * AP_NSEC_PER_USEC;
+    /* tv_nsec must stay below a second */
+    spec.it_interval.tv_sec = timeout_usec / AP_USEC_PER_SEC;
+    spec.it_interval.tv_nsec = (timeout_usec % AP_USEC_PER_SEC) * AP_NSEC_PER_USEC;
+    spec.it_value = spec.it_interval;
 
     if (timerfd_settime(_fd, 0, &spec, nullptr) < 0) {
         return false;
@@ -106,11 +106,32 @@ int SPIUARTDriver::_write_fd(const uint8_t *buf, uint16_t size)
      * this operation since it's the same as in the
      * UARTDriver::write().
      */
-    _readbuf.write(_buffer, size);
+    _stats.received(size, _readbuf.write(_buffer, size), _readbuf.available());
 
     return ret;
 }
 
+int SPIUARTDriver::_writev_fd(const struct iovec *iov, uint8_t count)
+{
+    if (_external) {
+        return UARTDriver::_writev_fd(iov, count);
+    }
+
+    // each SPI transfer takes one buffer
+    int total = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        const int ret = _write_fd((const uint8_t *)iov[i].iov_base, iov[i].iov_len);
+        if (ret <= 0) {
+            break;
+        }
+        total += ret;
+        if ((size_t)ret < iov[i].iov_len) {
+            break;
+        }
+    }
+    return total;
+}
+
 int SPIUARTDriver::_read_fd(uint8_t *buf, uint16_t n)
 {
     static uint8_t ff_stub[100] = {0xff};
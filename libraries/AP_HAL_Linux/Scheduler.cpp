@@ -5,7 +5,9 @@
 #include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <sys/time.h>
 #include <unistd.h>
 
@@ -31,6 +33,24 @@ extern const AP_HAL::HAL& hal;
 #define APM_LINUX_IO_PRIORITY           10
 #define APM_LINUX_SCRIPTING_PRIORITY     1
 
+/* CPU each thread is pinned to, or -1 to let the kernel place it.
+ * Boards may set these, and --thread-cpu overrides them */
+#ifndef APM_LINUX_MAIN_CPU
+#define APM_LINUX_MAIN_CPU              -1
+#endif
+#ifndef APM_LINUX_TIMER_CPU
+#define APM_LINUX_TIMER_CPU             -1
+#endif
+#ifndef APM_LINUX_UART_CPU
+#define APM_LINUX_UART_CPU              -1
+#endif
+#ifndef APM_LINUX_RCIN_CPU
+#define APM_LINUX_RCIN_CPU              -1
+#endif
+#ifndef APM_LINUX_IO_CPU
+#define APM_LINUX_IO_CPU                -1
+#endif
+
 #define APM_LINUX_TIMER_RATE            1000
 #define APM_LINUX_UART_RATE             100
 #if CONFIG_HAL_BOARD_SUBTYPE == HAL_BOARD_SUBTYPE_LINUX_NAVIO ||    \
@@ -45,6 +65,13 @@ extern const AP_HAL::HAL& hal;
 #define APM_LINUX_IO_RATE               50
 #endif
 
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE                  6
+#endif
+#ifndef SCHED_FLAG_RESET_ON_FORK
+#define SCHED_FLAG_RESET_ON_FORK        0x01
+#endif
+
 #define SCHED_THREAD(name_, UPPER_NAME_)                        \
     {                                                           \
         .name = "ap-" #name_,                                   \
@@ -55,7 +82,14 @@ extern const AP_HAL::HAL& hal;
     }
 
 Scheduler::Scheduler()
-{ }
+{
+    CPU_ZERO(&_cpu_affinity);
+    _main_cpu = APM_LINUX_MAIN_CPU;
+    _timer_thread.set_cpu(APM_LINUX_TIMER_CPU);
+    _uart_thread.set_cpu(APM_LINUX_UART_CPU);
+    _rcin_thread.set_cpu(APM_LINUX_RCIN_CPU);
+    _io_thread.set_cpu(APM_LINUX_IO_CPU);
+}
 
 
 void Scheduler::init_realtime()
@@ -101,6 +135,12 @@ void Scheduler::init()
 
     init_realtime();
 
+    if (CPU_COUNT(&_cpu_affinity) > 0 &&
+        sched_setaffinity(0, sizeof(_cpu_affinity), &_cpu_affinity) != 0) {
+        AP_HAL::panic("Scheduler: failed to set CPU affinity: %s",
+                      strerror(errno));
+    }
+
     /* set barrier to N + 1 threads: worker threads + main */
     unsigned n_threads = ARRAY_SIZE(sched_table) + 1;
     ret = pthread_barrier_init(&_initialized_barrier, nullptr, n_threads);
@@ -120,6 +160,126 @@ void Scheduler::init()
 #if defined(DEBUG_STACK) && DEBUG_STACK
     register_timer_process(FUNCTOR_BIND_MEMBER(&Scheduler::_debug_stack, void));
 #endif
+
+    if (_report_wakeups) {
+        register_io_process(FUNCTOR_BIND_MEMBER(&Scheduler::_report_wakeup_stats, void));
+    }
+}
+
+bool Scheduler::set_thread_cpu(const char *name, int cpu)
+{
+    if (strcmp(name, "main") == 0) {
+        _main_cpu = cpu;
+        return true;
+    }
+
+    const struct {
+        const char *name;
+        SchedulerThread *thread;
+    } threads[] = {
+        { "timer", &_timer_thread },
+        { "uart", &_uart_thread },
+        { "rcin", &_rcin_thread },
+        { "io", &_io_thread },
+    };
+    for (uint8_t i = 0; i < ARRAY_SIZE(threads); i++) {
+        if (strcmp(name, threads[i].name) == 0) {
+            return threads[i].thread->set_cpu(cpu);
+        }
+    }
+    return false;
+}
+
+void Scheduler::set_main_deadline(uint32_t runtime_us, uint32_t period_us)
+{
+    _deadline_runtime_us = runtime_us;
+    _deadline_period_us = period_us;
+}
+
+void Scheduler::start_main_loop()
+{
+    if (_main_cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(_main_cpu, &cpus);
+        int r = pthread_setaffinity_np(_main_ctx, sizeof(cpus), &cpus);
+        if (r != 0) {
+            AP_HAL::panic("Scheduler: failed to pin main thread to CPU %d: %s",
+                          _main_cpu, strerror(r));
+        }
+    }
+
+    if (_deadline_period_us == 0) {
+        return;
+    }
+
+#ifdef SYS_sched_setattr
+    /* glibc has no wrapper for sched_setattr() */
+    struct {
+        uint32_t size;
+        uint32_t sched_policy;
+        uint64_t sched_flags;
+        int32_t sched_nice;
+        uint32_t sched_priority;
+        uint64_t sched_runtime;
+        uint64_t sched_deadline;
+        uint64_t sched_period;
+    } attr {};
+    attr.size = sizeof(attr);
+    attr.sched_policy = SCHED_DEADLINE;
+    // threads created later start as SCHED_OTHER rather than failing
+    attr.sched_flags = SCHED_FLAG_RESET_ON_FORK;
+    attr.sched_runtime = _deadline_runtime_us * 1000ULL;
+    attr.sched_deadline = _deadline_period_us * 1000ULL;
+    attr.sched_period = _deadline_period_us * 1000ULL;
+
+    /* the kernel refuses deadline tasks which can't run on every CPU
+     * of their root domain, so this fails if the main thread is
+     * pinned. Carry on with SCHED_FIFO then */
+    if (syscall(SYS_sched_setattr, 0, &attr, 0) != 0) {
+        fprintf(stderr, "Scheduler: failed to set SCHED_DEADLINE %u/%uus: %s\n",
+                (unsigned)_deadline_runtime_us, (unsigned)_deadline_period_us,
+                strerror(errno));
+    }
+#else
+    fprintf(stderr, "Scheduler: SCHED_DEADLINE not supported\n");
+#endif
+}
+
+void Scheduler::_report_wakeup_stats()
+{
+    uint64_t now = AP_HAL::millis64();
+
+    if (now - _last_wakeup_report_msec < 5000) {
+        return;
+    }
+    _last_wakeup_report_msec = now;
+
+    const struct {
+        const char *name;
+        const WakeupStats &stats;
+    } report[] = {
+        { "main", _main_wakeup_stats },
+        { "timer", _timer_thread.get_wakeup_stats() },
+        { "uart", _uart_thread.get_wakeup_stats() },
+        { "rcin", _rcin_thread.get_wakeup_stats() },
+        { "io", _io_thread.get_wakeup_stats() },
+    };
+
+    fprintf(stderr, "Wakeup latency (avg/max us):");
+    for (uint8_t i = 0; i < ARRAY_SIZE(report); i++) {
+        fprintf(stderr, " %s=%u/%u", report[i].name,
+                (unsigned)report[i].stats.late_avg_us,
+                (unsigned)report[i].stats.late_max_us);
+    }
+    fprintf(stderr, "\n");
+
+    // the maximum is of the last report period
+    _main_wakeup_stats.late_max_us = 0;
+    _timer_thread.clear_wakeup_max();
+    _uart_thread.clear_wakeup_max();
+    _rcin_thread.clear_wakeup_max();
+    _io_thread.clear_wakeup_max();
 }
 
 void Scheduler::_debug_stack()
@@ -170,7 +330,16 @@ void Scheduler::delay_microseconds(uint16_t us)
     if (_stopped_clock_usec) {
         return;
     }
+    if (!_report_wakeups || !in_main_thread()) {
+        microsleep(us);
+        return;
+    }
+
+    /* the main loop waits for the IMU here, so this is its wakeup */
+    const uint64_t start = AP_HAL::micros64();
     microsleep(us);
+    const uint64_t slept = AP_HAL::micros64() - start;
+    _main_wakeup_stats.update(slept > us ? slept - us : 0);
 }
 
 void Scheduler::register_timer_process(AP_HAL::MemberProc proc)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <pthread.h>
+#include <sched.h>
 
 #include "AP_HAL_Linux.h"
 #include "Semaphores.h"
@@ -47,6 +48,37 @@ public:
 
     void teardown();
 
+    /*
+      CPUs the process may run on, set before init(). HAL threads not
+      pinned to a CPU of their own run on any of them
+     */
+    void set_cpu_affinity(const cpu_set_t &cpus) { _cpu_affinity = cpus; }
+
+    /*
+      pin the main thread or one of the scheduler threads (timer,
+      uart, rcin or io) to a CPU, which may be one isolated from the
+      kernel's load balancing. A cpu of -1 leaves the thread free.
+      Returns false for an unknown thread
+     */
+    bool set_thread_cpu(const char *name, int cpu);
+
+    /*
+      run the main loop under SCHED_DEADLINE, with runtime_us of CPU
+      reserved for it in every period_us
+     */
+    void set_main_deadline(uint32_t runtime_us, uint32_t period_us);
+
+    // report how late each loop wakes up, every few seconds
+    void set_report_wakeups(bool enable) { _report_wakeups = enable; }
+
+    /*
+      called once setup() has returned. Pins the main thread and takes
+      its deadline reservation, which done earlier would throttle the
+      initialisation and pass the main thread's CPU on to every thread
+      it creates
+     */
+    void start_main_loop();
+
     /*
       create a new thread
      */
@@ -71,6 +103,7 @@ private:
     void _wait_all_threads();
 
     void     _debug_stack();
+    void     _report_wakeup_stats();
 
     AP_HAL::Proc _failsafe;
 
@@ -102,6 +135,15 @@ private:
     pthread_t _main_ctx;
 
     Semaphore _io_semaphore;
+
+    cpu_set_t _cpu_affinity;
+    int _main_cpu;
+    uint32_t _deadline_runtime_us;
+    uint32_t _deadline_period_us;
+
+    bool _report_wakeups;
+    WakeupStats _main_wakeup_stats;
+    uint64_t _last_wakeup_report_msec;
 };
 
 }
@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <sys/uio.h>
 
 #include "AP_HAL_Linux.h"
 
@@ -13,6 +14,34 @@ public:
     virtual bool close() = 0;
     virtual ssize_t write(const uint8_t *buf, uint16_t n) = 0;
     virtual ssize_t read(uint8_t *buf, uint16_t n) = 0;
+
+    /*
+      write count buffers, returning the bytes written or -1. Devices
+      which can should do it in one system call, sending them as one
+      packet
+     */
+    virtual ssize_t writev(const struct iovec *iov, uint8_t count)
+    {
+        ssize_t total = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            const ssize_t ret = write((const uint8_t *)iov[i].iov_base, iov[i].iov_len);
+            if (ret < 0) {
+                return total > 0 ? total : ret;
+            }
+            total += ret;
+            if ((size_t)ret < iov[i].iov_len) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    /*
+      the AP_HAL::micros64() time the newest byte given by read()
+      arrived, or zero if the device can't tell when it arrived
+     */
+    virtual uint64_t receive_time_us(void) { return 0; }
+
     virtual void set_blocking(bool blocking) = 0;
     virtual void set_speed(uint32_t speed) = 0;
     virtual AP_HAL::UARTDriver::flow_control get_flow_control(void) { return AP_HAL::UARTDriver::FLOW_CONTROL_ENABLE; }
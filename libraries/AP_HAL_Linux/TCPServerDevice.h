@@ -13,6 +13,7 @@ public:
     virtual void set_blocking(bool blocking) override;
     virtual void set_speed(uint32_t speed) override;
     virtual ssize_t write(const uint8_t *buf, uint16_t n) override;
+    virtual ssize_t writev(const struct iovec *iov, uint8_t count) override;
     virtual ssize_t read(uint8_t *buf, uint16_t n) override;
 
 private:
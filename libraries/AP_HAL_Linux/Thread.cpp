@@ -17,9 +17,13 @@
 #include "Thread.h"
 
 #include <alloca.h>
+#include <errno.h>
 #include <limits.h>
+#include <sched.h>
+#include <sys/timerfd.h>
 #include <sys/types.h>
 #include <stdio.h>
+#include <time.h>
 #include <unistd.h>
 #include <utility>
 
@@ -189,6 +193,16 @@ bool Thread::start(const char *name, int policy, int prio)
         }
     }
 
+    if (_cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(_cpu, &cpus);
+        if ((r = pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus)) != 0) {
+            AP_HAL::panic("Failed to set CPU %d for thread '%s': %s",
+                          _cpu, name, strerror(r));
+        }
+    }
+
     r = pthread_create(&_ctx, &attr, &Thread::_run_trampoline, this);
     if (r != 0) {
         AP_HAL::panic("Failed to create thread '%s': %s",
@@ -249,27 +263,80 @@ bool Thread::set_stack_size(size_t stack_size)
     return true;
 }
 
+bool Thread::set_cpu(int cpu)
+{
+    if (_started || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+
+    _cpu = cpu;
+
+    return true;
+}
+
+static inline uint64_t monotonic_nsec()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * AP_NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static inline struct timespec nsec_to_timespec(uint64_t nsec)
+{
+    struct timespec ts;
+    ts.tv_sec = nsec / AP_NSEC_PER_SEC;
+    ts.tv_nsec = nsec % AP_NSEC_PER_SEC;
+    return ts;
+}
+
 bool PeriodicThread::_run()
 {
     if (_period_usec == 0) {
         return false;
     }
 
-    uint64_t next_run_usec = AP_HAL::micros64() + _period_usec;
+    /*
+      a timerfd on an absolute schedule wakes the thread once a period,
+      so it sleeps in a single read() between runs and doesn't drift by
+      the time the task takes
+     */
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    const uint64_t period_nsec = _period_usec * AP_NSEC_PER_USEC;
+    uint64_t next_run_nsec = monotonic_nsec() + period_nsec;
+
+    struct itimerspec spec;
+    spec.it_interval = nsec_to_timespec(period_nsec);
+    spec.it_value = nsec_to_timespec(next_run_nsec);
+    if (timerfd_settime(fd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0) {
+        close(fd);
+        return false;
+    }
 
     while (!_should_exit) {
-        uint64_t dt = next_run_usec - AP_HAL::micros64();
-        if (dt > _period_usec) {
-            // we've lost sync - restart
-            next_run_usec = AP_HAL::micros64();
-        } else {
-            Scheduler::from(hal.scheduler)->microsleep(dt);
+        uint64_t expirations;
+        if (read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
         }
-        next_run_usec += _period_usec;
+
+        /* periods missed while the task overran are skipped, measuring
+         * against the latest one */
+        const uint64_t due_nsec = next_run_nsec + (expirations - 1) * period_nsec;
+        const uint64_t now_nsec = monotonic_nsec();
+        _wakeup_stats.update(now_nsec > due_nsec ? (now_nsec - due_nsec) / AP_NSEC_PER_USEC : 0);
+        next_run_nsec += expirations * period_nsec;
 
         _task();
     }
 
+    close(fd);
+
     _started = false;
     _should_exit = false;
 
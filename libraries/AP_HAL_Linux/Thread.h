@@ -24,6 +24,25 @@
 
 namespace Linux {
 
+/*
+ * How late a thread wakes up against the time it asked for
+ */
+struct WakeupStats {
+    uint32_t count;
+    uint32_t late_avg_us;
+    uint32_t late_max_us;
+
+    void update(uint32_t late_us)
+    {
+        count++;
+        // average over about the last 16 wakeups
+        late_avg_us = (late_avg_us * 15 + late_us) / 16;
+        if (late_us > late_max_us) {
+            late_max_us = late_us;
+        }
+    }
+};
+
 /*
  * Interface abstracting threads
  */
@@ -45,6 +64,9 @@ public:
 
     bool set_stack_size(size_t stack_size);
 
+    /* pin the thread to a CPU when it starts, -1 leaves it free */
+    bool set_cpu(int cpu);
+
     void set_auto_free(bool auto_free) { _auto_free = auto_free; }
 
     virtual bool stop() { return false; }
@@ -75,6 +97,7 @@ protected:
     } _stack_debug;
 
     size_t _stack_size = 0;
+    int _cpu = -1;
 };
 
 class PeriodicThread : public Thread {
@@ -87,10 +110,14 @@ public:
 
     bool stop() override;
 
+    const WakeupStats &get_wakeup_stats() const { return _wakeup_stats; }
+    void clear_wakeup_max() { _wakeup_stats.late_max_us = 0; }
+
 protected:
     bool _run() override;
 
     uint64_t _period_usec = 0;
+    WakeupStats _wakeup_stats {};
 };
 
 }
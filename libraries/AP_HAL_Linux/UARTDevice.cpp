@@ -67,6 +67,22 @@ ssize_t UARTDevice::write(const uint8_t *buf, uint16_t n)
     return ret;
 }
 
+ssize_t UARTDevice::writev(const struct iovec *iov, uint8_t count)
+{
+    struct pollfd fds;
+    fds.fd = _fd;
+    fds.events = POLLOUT;
+    fds.revents = 0;
+
+    ssize_t ret = 0;
+
+    if (poll(&fds, 1, 0) == 1) {
+        ret = ::writev(_fd, iov, count);
+    }
+
+    return ret;
+}
+
 void UARTDevice::set_blocking(bool blocking)
 {
     int flags = fcntl(_fd, F_GETFL, 0);
@@ -100,6 +100,7 @@ void UARTDriver::begin(uint32_t b, uint16_t rxS, uint16_t txS)
     if (clear_buffers) {
         _readbuf.clear();
         _writebuf.clear();
+        _stats.tx_cleared();
     }
 }
 
@@ -126,6 +127,7 @@ void UARTDriver::_deallocate_buffers()
 {
     _readbuf.set_size(0);
     _writebuf.set_size(0);
+    _stats.tx_cleared();
 }
 
 /*
@@ -291,6 +293,14 @@ int16_t UARTDriver::read()
     return byte;
 }
 
+ssize_t UARTDriver::read(uint8_t *buffer, uint16_t count)
+{
+    if (!_initialised) {
+        return -1;
+    }
+    return _readbuf.read(buffer, count);
+}
+
 /* Linux implementations of Print virtual methods */
 size_t UARTDriver::write(uint8_t c)
 {
@@ -303,12 +313,14 @@ size_t UARTDriver::write(uint8_t c)
 
     while (_writebuf.space() == 0) {
         if (_nonblocking_writes) {
+            _stats.queued(1, 0, _writebuf.available());
             _write_mutex.give();
             return 0;
         }
         hal.scheduler->delay(1);
     }
     size_t ret = _writebuf.write(&c, 1);
+    _stats.queued(1, ret, _writebuf.available());
     _write_mutex.give();
     return ret;
 }
@@ -338,10 +350,43 @@ size_t UARTDriver::write(const uint8_t *buffer, size_t size)
     }
 
     size_t ret = _writebuf.write(buffer, size);
+    _stats.queued(size, ret, _writebuf.available());
     _write_mutex.give();
     return ret;
 }
 
+/*
+  queue all the fragments under one lock, or none of them
+ */
+size_t UARTDriver::writev(const WriteVec *vec, uint8_t count)
+{
+    if (!_initialised) {
+        return 0;
+    }
+    if (!_write_mutex.take_nonblocking()) {
+        return 0;
+    }
+
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        total += vec[i].len;
+    }
+    while (_writebuf.space() < total) {
+        if (_nonblocking_writes || total >= _writebuf.get_size()) {
+            _stats.queued(total, 0, _writebuf.available());
+            _write_mutex.give();
+            return 0;
+        }
+        hal.scheduler->delay(1);
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        _writebuf.write(vec[i].data, vec[i].len);
+    }
+    _stats.queued(total, total, _writebuf.available());
+    _write_mutex.give();
+    return total;
+}
+
 /*
   try writing n bytes, handling an unresponsive port
  */
@@ -361,6 +406,21 @@ int UARTDriver::_write_fd(const uint8_t *buf, uint16_t n)
     return _device->write(buf, n);
 }
 
+/*
+  try writing count buffers in one go, handling an unresponsive port
+ */
+int UARTDriver::_writev_fd(const struct iovec *iov, uint8_t count)
+{
+    if (!_connected) {
+        _connected = _device->open();
+    }
+    if (!_connected) {
+        return 0;
+    }
+
+    return _device->writev(iov, count);
+}
+
 /*
   try reading n bytes, handling an unresponsive port
  */
@@ -386,30 +446,22 @@ bool UARTDriver::_write_pending_bytes(void)
     }
 
     if (n > 0) {
-        int ret;
-
-        if (_packetise) {
-            // keep as a single UDP packet
-            uint8_t tmpbuf[n];
-            _writebuf.peekbytes(tmpbuf, n);
-            ret = _write_fd(tmpbuf, n);
-            if (ret > 0)
-                _writebuf.advance(ret);
-        } else {
-            ByteBuffer::IoVec vec[2];
-            const auto n_vec = _writebuf.peekiovec(vec, n);
-            for (int i = 0; i < n_vec; i++) {
-                ret = _write_fd(vec[i].data, (uint16_t)vec[i].len);
-                if (ret < 0) {
-                    break;
-                }
-                _writebuf.advance(ret);
-
-                /* We wrote less than we asked for, stop */
-                if ((unsigned)ret != vec[i].len) {
-                    break;
-                }
-            }
+        /*
+          write both pieces of the ring buffer with one call. On a UDP
+          socket they go as a single packet, so there is no need to
+          copy them together to keep a packetised write whole
+         */
+        ByteBuffer::IoVec vec[2];
+        struct iovec iov[2];
+        const auto n_vec = _writebuf.peekiovec(vec, n);
+        for (int i = 0; i < n_vec; i++) {
+            iov[i].iov_base = vec[i].data;
+            iov[i].iov_len = vec[i].len;
+        }
+        const int ret = _writev_fd(iov, n_vec);
+        if (ret > 0) {
+            _writebuf.advance(ret);
+            _stats.sent(ret);
         }
     }
 
@@ -443,9 +495,15 @@ void UARTDriver::_timer_tick(void)
             break;
         }
         _readbuf.commit((unsigned)ret);
+        _stats.received(ret, ret, _readbuf.available());
 
-        // update receive timestamp
-        _receive_timestamp[_receive_timestamp_idx^1] = AP_HAL::micros64();
+        // update receive timestamp, using the device's time for the
+        // data if it has one
+        uint64_t receive_us = _device ? _device->receive_time_us() : 0;
+        if (receive_us == 0) {
+            receive_us = AP_HAL::micros64();
+        }
+        _receive_timestamp[_receive_timestamp_idx^1] = receive_us;
         _receive_timestamp_idx ^= 1;
         
         /* stop reading as we read less than we asked for */
@@ -2,6 +2,7 @@
 
 #include <AP_HAL/utility/OwnPtr.h>
 #include <AP_HAL/utility/RingBuffer.h>
+#include <AP_HAL/utility/UARTStats.h>
 
 #include "AP_HAL_Linux.h"
 #include "SerialDevice.h"
@@ -30,10 +31,12 @@ public:
     uint32_t available() override;
     uint32_t txspace() override;
     int16_t read() override;
+    ssize_t read(uint8_t *buffer, uint16_t count) override;
 
     /* Linux implementations of Print virtual methods */
     size_t write(uint8_t c) override;
     size_t write(const uint8_t *buffer, size_t size) override;
+    size_t writev(const WriteVec *vec, uint8_t count) override;
 
     void set_device_path(const char *path);
 
@@ -64,7 +67,12 @@ public:
       A return value of zero means the HAL does not support this API
      */
     uint64_t receive_time_constraint_us(uint16_t nbytes) override;
-    
+
+    bool get_stats(UARTStats &stats) override {
+        stats = _stats.get();
+        return true;
+    }
+
 private:
     AP_HAL::OwnPtr<SerialDevice> _device;
     bool _nonblocking_writes;
@@ -95,8 +103,10 @@ protected:
     // of ::read() and ::write() in the main loop
     ByteBuffer _readbuf{0};
     ByteBuffer _writebuf{0};
+    UARTStatsKeeper _stats;
 
     virtual int _write_fd(const uint8_t *buf, uint16_t n);
+    virtual int _writev_fd(const struct iovec *iov, uint8_t count);
     virtual int _read_fd(uint8_t *buf, uint16_t n);
 
     Linux::Semaphore _write_mutex;    
@@ -3,6 +3,7 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <sys/ioctl.h>
+#include <time.h>
 
 #include <AP_HAL/AP_HAL.h>
 
@@ -33,9 +34,37 @@ ssize_t UDPDevice::write(const uint8_t *buf, uint16_t n)
     return socket.sendto(buf, n, _ip, _port);
 }
 
+ssize_t UDPDevice::writev(const struct iovec *iov, uint8_t count)
+{
+    if (!socket.pollout(0)) {
+        return -1;
+    }
+    if (_connected) {
+        return socket.sendv(iov, count);
+    }
+    if (_input) {
+        // can't send yet
+        return -1;
+    }
+    return socket.sendtov(iov, count, _ip, _port);
+}
+
 ssize_t UDPDevice::read(uint8_t *buf, uint16_t n)
 {
-    ssize_t ret = socket.recv(buf, n, 0);
+    uint64_t rx_realtime_us;
+    ssize_t ret = socket.recv_timestamped(buf, n, 0, rx_realtime_us);
+    if (ret > 0) {
+        // move the kernel's receive time onto our clock
+        _receive_time_us = AP_HAL::micros64();
+        if (rx_realtime_us != 0) {
+            struct timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            const uint64_t now_realtime_us = ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+            if (rx_realtime_us < now_realtime_us) {
+                _receive_time_us -= now_realtime_us - rx_realtime_us;
+            }
+        }
+    }
     if (!_connected && ret > 0) {
         const char *ip;
         uint16_t port;
@@ -47,6 +76,7 @@ ssize_t UDPDevice::read(uint8_t *buf, uint16_t n)
 
 bool UDPDevice::open()
 {
+    socket.set_timestamping();
     if (_input) {
         socket.bind(_ip, _port);
         return true;
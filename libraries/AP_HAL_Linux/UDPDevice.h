@@ -13,7 +13,9 @@ public:
     virtual void set_blocking(bool blocking) override;
     virtual void set_speed(uint32_t speed) override;
     virtual ssize_t write(const uint8_t *buf, uint16_t n) override;
+    virtual ssize_t writev(const struct iovec *iov, uint8_t count) override;
     virtual ssize_t read(uint8_t *buf, uint16_t n) override;
+    virtual uint64_t receive_time_us(void) override { return _receive_time_us; }
 private:
     SocketAPM socket{true};
     const char *_ip;
@@ -21,4 +23,5 @@ private:
     bool _bcast;
     bool _input;
     bool _connected = false;
+    uint64_t _receive_time_us = 0;
 };
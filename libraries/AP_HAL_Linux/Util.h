@@ -93,6 +93,11 @@ public:
         return Perf::get_singleton()->count(perf);
     }
 
+    bool perf_trace_dump(const char *path) override
+    {
+        return Perf::get_singleton()->write_trace(path);
+    }
+
     int get_hw_arm32();
 
     bool toneAlarm_init() override { return _toneAlarm.init(); }
@@ -37,6 +37,13 @@
 #include <time.h>
 #include <unistd.h>
 
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define VIDEOIN_NEON 1
+#else
+#define VIDEOIN_NEON 0
+#endif
+
 extern const AP_HAL::HAL& hal;
 
 using namespace Linux;
@@ -249,42 +256,52 @@ void VideoIn::prepare_capture()
     }
 }
 
+/*
+  the frame conversions run on every camera frame, so on boards with
+  NEON the inner loops work 8 or 16 pixels at a time. Results are the
+  same as the plain C loops, which also handle the ends of rows
+ */
 void VideoIn::shrink_8bpp(uint8_t *buffer, uint8_t *new_buffer,
                           uint32_t width, uint32_t height, uint32_t left,
                           uint32_t selection_width, uint32_t top,
                           uint32_t selection_height, uint32_t fx, uint32_t fy)
 {
-    uint32_t i, j, k, kk, px, block_x, block_y, block_position;
+    uint32_t i, j, k, kk, x;
     uint32_t out_width = selection_width / fx;
     uint32_t out_height = selection_height / fy;
-    uint32_t width_per_fy = width * fy;
+    uint32_t used_width = out_width * fx;
     uint32_t fx_fy = fx * fy;
-    uint32_t width_sum, out_width_sum = 0;
-
-    /* selection offset */
-    block_y = top * width;
-    block_position = left + block_y;
+    /* sums of fy pixels of each column, which fit 16 bits for fy < 258 */
+    uint16_t column_sum[used_width];
 
     for (i = 0; i < out_height; i++) {
-        block_x = left;
-        for (j = 0; j < out_width; j++) {
-            px = 0;
-
-            width_sum = 0;
-            for(k = 0; k < fy; k++) {
-                for(kk = 0; kk < fx; kk++) {
-                    px += buffer[block_position + kk + width_sum];
-                }
-                width_sum += width;
+        const uint8_t *rows = &buffer[(top + i * fy) * width + left];
+
+        x = 0;
+#if VIDEOIN_NEON
+        for (; x + 8 <= used_width; x += 8) {
+            uint16x8_t sum = vmovl_u8(vld1_u8(&rows[x]));
+            for (k = 1; k < fy; k++) {
+                sum = vaddw_u8(sum, vld1_u8(&rows[x + k * width]));
             }
+            vst1q_u16(&column_sum[x], sum);
+        }
+#endif
+        for (; x < used_width; x++) {
+            uint16_t sum = 0;
+            for (k = 0; k < fy; k++) {
+                sum += rows[x + k * width];
+            }
+            column_sum[x] = sum;
+        }
 
-            new_buffer[j + out_width_sum] = px / (fx_fy);
-
-            block_x += fx;
-            block_position = block_x + block_y;
+        for (j = 0; j < out_width; j++) {
+            uint32_t px = 0;
+            for (kk = 0; kk < fx; kk++) {
+                px += column_sum[j * fx + kk];
+            }
+            new_buffer[i * out_width + j] = px / fx_fy;
         }
-        block_y += width_per_fy;
-        out_width_sum += out_width;
     }
 }
 
@@ -292,28 +309,28 @@ void VideoIn::crop_8bpp(uint8_t *buffer, uint8_t *new_buffer,
                         uint32_t width, uint32_t left, uint32_t crop_width,
                         uint32_t top, uint32_t crop_height)
 {
-    uint32_t crop_x = left + crop_width;
-    uint32_t crop_y = top + crop_height;
-    uint32_t buffer_index = top * width;
-    uint32_t new_buffer_index = 0;
-
-    for (uint32_t j = top; j < crop_y; j++) {
-        for (uint32_t i = left; i < crop_x; i++) {
-            new_buffer[i - left + new_buffer_index] =  buffer[i + buffer_index];
-        }
-        buffer_index += width;
-        new_buffer_index += crop_width;
+    const uint8_t *row = &buffer[top * width + left];
+
+    for (uint32_t j = 0; j < crop_height; j++) {
+        memcpy(&new_buffer[j * crop_width], row, crop_width);
+        row += width;
     }
 }
 
 void VideoIn::yuyv_to_grey(uint8_t *buffer, uint32_t buffer_size,
                            uint8_t *new_buffer)
 {
-    uint32_t new_buffer_position = 0;
+    uint32_t i = 0;
 
-    for (uint32_t i = 0; i < buffer_size; i += 2) {
-        new_buffer[new_buffer_position] = buffer[i];
-        new_buffer_position++;
+#if VIDEOIN_NEON
+    /* de-interleave 16 pixels, keeping the Y bytes */
+    for (; i + 32 <= buffer_size; i += 32) {
+        const uint8x16x2_t yuyv = vld2q_u8(&buffer[i]);
+        vst1q_u8(&new_buffer[i / 2], yuyv.val[0]);
+    }
+#endif
+    for (; i < buffer_size; i += 2) {
+        new_buffer[i / 2] = buffer[i];
     }
 }
 
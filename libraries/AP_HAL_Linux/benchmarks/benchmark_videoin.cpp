@@ -3,6 +3,7 @@
 
 #if CONFIG_HAL_BOARD_SUBTYPE == HAL_BOARD_SUBTYPE_LINUX_BEBOP
 
+#include <AP_HAL_Linux/Flow_PX4.h>
 #include <AP_HAL_Linux/VideoIn.h>
 
 static void BM_Crop8bpp(benchmark::State& state)
@@ -63,6 +64,101 @@ static void BM_YuyvToGrey(benchmark::State& state)
 }
 
 BENCHMARK(BM_YuyvToGrey)->Arg(64 * 64)->Arg(320 * 240)->Arg(640 * 480);
+
+static void BM_Shrink8bpp(benchmark::State& state)
+{
+    uint8_t *buffer, *new_buffer;
+    uint32_t width = 320;
+    uint32_t height = 240;
+    uint32_t scale = state.range_x();
+    uint32_t shrink_width = 64 * scale;
+    uint32_t shrink_height = 64 * scale;
+
+    buffer = (uint8_t *)calloc(1, width * height);
+    if (!buffer) {
+        fprintf(stderr, "error: couldn't malloc buffer\n");
+        return;
+    }
+
+    new_buffer = (uint8_t *)malloc(64 * 64);
+    if (!new_buffer) {
+        fprintf(stderr, "error: couldn't malloc new_buffer\n");
+        free(buffer);
+        return;
+    }
+
+    while (state.KeepRunning()) {
+        Linux::VideoIn::shrink_8bpp(buffer, new_buffer, width, height,
+            (width - shrink_width) / 2, shrink_width,
+            (height - shrink_height) / 2, shrink_height, scale, scale);
+    }
+
+    free(buffer);
+    free(new_buffer);
+}
+
+BENCHMARK(BM_Shrink8bpp)->Arg(1)->Arg(3);
+
+/*
+  the work done for each frame by OpticalFlow_Onboard on a Bebop: a
+  320x240 YUYV frame is converted to grey, shrunk to 64x64 and the flow
+  computed against the previous frame, which is the same texture moved
+  by a pixel
+ */
+static void BM_FlowPipeline(benchmark::State& state)
+{
+    const uint32_t width = 320;
+    const uint32_t height = 240;
+    const uint32_t scale = 3;
+    uint8_t *frame, *grey, *prev, *next;
+    float flow_x, flow_y;
+
+    frame = (uint8_t *)malloc(width * height * 2);
+    grey = (uint8_t *)malloc(width * height);
+    prev = (uint8_t *)malloc(64 * 64);
+    next = (uint8_t *)malloc(64 * 64);
+    if (!frame || !grey || !prev || !next) {
+        fprintf(stderr, "error: couldn't malloc buffers\n");
+        free(frame);
+        free(grey);
+        free(prev);
+        free(next);
+        return;
+    }
+
+    srand(1);
+    for (uint32_t i = 0; i < width * height * 2; i++) {
+        frame[i] = rand();
+    }
+    Linux::VideoIn::yuyv_to_grey(frame, width * height * 2, grey);
+    Linux::VideoIn::shrink_8bpp(grey, next, width, height,
+        (width - 64 * scale) / 2, 64 * scale,
+        (height - 64 * scale) / 2, 64 * scale, scale, scale);
+    for (uint32_t y = 0; y < 64; y++) {
+        for (uint32_t x = 0; x < 64; x++) {
+            prev[y * 64 + x] = next[y * 64 + (x + 1) % 64];
+        }
+    }
+
+    Linux::Flow_PX4 flow(64, 64, HAL_FLOW_PX4_MAX_FLOW_PIXEL,
+                         HAL_FLOW_PX4_BOTTOM_FLOW_FEATURE_THRESHOLD,
+                         HAL_FLOW_PX4_BOTTOM_FLOW_VALUE_THRESHOLD);
+
+    while (state.KeepRunning()) {
+        Linux::VideoIn::yuyv_to_grey(frame, width * height * 2, grey);
+        Linux::VideoIn::shrink_8bpp(grey, next, width, height,
+            (width - 64 * scale) / 2, 64 * scale,
+            (height - 64 * scale) / 2, 64 * scale, scale, scale);
+        flow.compute_flow(prev, next, 33333, &flow_x, &flow_y);
+    }
+
+    free(frame);
+    free(grey);
+    free(prev);
+    free(next);
+}
+
+BENCHMARK(BM_FlowPipeline);
 #endif
 
 BENCHMARK_MAIN()
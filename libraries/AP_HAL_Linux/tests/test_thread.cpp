@@ -117,4 +117,31 @@ TEST(LinuxThread, periodic_thread)
     EXPECT_TRUE(thr.join());
 }
 
+class TestPeriodicThread2 : public PeriodicThread {
+public:
+    TestPeriodicThread2() : PeriodicThread{FUNCTOR_BIND_MEMBER(&TestPeriodicThread2::_task, void)} { }
+
+    volatile int n_loop = 0;
+
+protected:
+    void _task() { n_loop++; }
+};
+
+TEST(LinuxThread, periodic_thread_rate)
+{
+    TestPeriodicThread2 thr;
+    EXPECT_TRUE(thr.set_rate(1000));
+    EXPECT_TRUE(thr.start(nullptr, 0, 0));
+
+    usleep(100000);
+
+    EXPECT_TRUE(thr.stop());
+    EXPECT_TRUE(thr.join());
+
+    // about 100 periods, with room for a loaded machine
+    EXPECT_GT(thr.n_loop, 20);
+    EXPECT_LT(thr.n_loop, 110);
+    EXPECT_EQ((uint32_t)thr.n_loop, thr.get_wakeup_stats().count);
+}
+
 AP_GTEST_MAIN()
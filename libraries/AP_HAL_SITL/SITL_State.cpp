@@ -13,6 +13,7 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <errno.h>
+#include <time.h>
 #include <sys/select.h>
 
 #include <AP_Param/AP_Param.h>
@@ -197,6 +198,41 @@ void SITL_State::_fdm_input_step(void)
     // trigger all APM timers.
     _scheduler->timer_event();
     _scheduler->sitl_end_atomic();
+
+    _bench_check_end();
+}
+
+static uint64_t wall_clock_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+/*
+  in --bench mode, report how fast the vehicle code ran and write the
+  perf counter trace when the simulated time is up
+ */
+void SITL_State::_bench_check_end(void)
+{
+    if (_bench_end_us == 0) {
+        return;
+    }
+    if (_bench_start_wall_us == 0) {
+        _bench_start_wall_us = wall_clock_us();
+    }
+    const uint64_t now_us = AP_HAL::micros64();
+    if (now_us < _bench_end_us) {
+        return;
+    }
+    const float wall_s = (wall_clock_us() - _bench_start_wall_us) * 1.0e-6f;
+    ::printf("Bench: %.1fs simulated in %.1fs, speedup %.1f\n",
+             (double)(now_us * 1.0e-6f), (double)wall_s,
+             (double)(now_us * 1.0e-6f / MAX(wall_s, 1.0e-3f)));
+    if (hal.util->perf_trace_dump("bench-trace.json")) {
+        ::printf("Bench: wrote bench-trace.json\n");
+    }
+    exit(0);
 }
 
 
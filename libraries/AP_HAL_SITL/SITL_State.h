@@ -169,6 +169,12 @@ private:
 
     bool _synthetic_clock_mode;
 
+    // simulated time to stop at in --bench mode, and the wall clock
+    // time it started at
+    uint64_t _bench_end_us;
+    uint64_t _bench_start_wall_us;
+    void _bench_check_end(void);
+
     bool _use_rtscts;
     bool _use_fg_view;
     
@@ -51,6 +51,8 @@ void SITL_State::_usage(void)
            "\t--wipe|-w                wipe eeprom\n"
            "\t--unhide-groups|-u       parameter enumeration ignores AP_PARAM_FLAG_ENABLE\n"
            "\t--speedup|-s SPEEDUP     set simulation speedup\n"
+           "\t--lockstep               run as fast as possible, with no sleeps to follow the wall clock\n"
+           "\t--bench SECONDS          run SECONDS of simulated time in lockstep with task perf counters, then exit\n"
            "\t--rate|-r RATE           set SITL framerate\n"
            "\t--console|-C             use console instead of TCP ports\n"
            "\t--instance|-I N          set instance of SITL (adds 10*instance to all port numbers)\n"
@@ -77,6 +79,7 @@ void SITL_State::_usage(void)
            "\t--sim-port-in PORT       set port num for simulator in\n"
            "\t--sim-port-out PORT      set port num for simulator out\n"
            "\t--irlock-port PORT       set port num for irlock\n"
+           "\t--sysid ID               set SYSID_THISMAV\n"
         );
 }
 
@@ -139,8 +142,10 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
 {
     int opt;
     float speedup = 1.0f;
+    bool lockstep = false;
     _instance = 0;
     _synthetic_clock_mode = false;
+    _bench_end_us = 0;
     // default to CMAC
     const char *home_str = "-35.363261,149.165230,584,353";
     const char *model_str = nullptr;
@@ -182,6 +187,9 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
         CMDLINE_SIM_PORT_IN,
         CMDLINE_SIM_PORT_OUT,
         CMDLINE_IRLOCK_PORT,
+        CMDLINE_LOCKSTEP,
+        CMDLINE_SYSID,
+        CMDLINE_BENCH,
     };
 
     const struct GetOptLong::option options[] = {
@@ -215,6 +223,9 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
         {"sim-port-in",     true,   0, CMDLINE_SIM_PORT_IN},
         {"sim-port-out",    true,   0, CMDLINE_SIM_PORT_OUT},
         {"irlock-port",     true,   0, CMDLINE_IRLOCK_PORT},
+        {"lockstep",        false,  0, CMDLINE_LOCKSTEP},
+        {"sysid",           true,   0, CMDLINE_SYSID},
+        {"bench",           true,   0, CMDLINE_BENCH},
         {0, false, 0, 0}
     };
 
@@ -329,6 +340,27 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
         case CMDLINE_IRLOCK_PORT:
             _irlock_port = atoi(gopt.optarg);
             break;
+        case CMDLINE_LOCKSTEP:
+            lockstep = true;
+            break;
+        case CMDLINE_SYSID: {
+            char sysid_string[24];
+            snprintf(sysid_string, sizeof(sysid_string), "SYSID_THISMAV=%s", gopt.optarg);
+            _set_param_default(sysid_string);
+            break;
+        }
+        case CMDLINE_BENCH:
+            // a reproducible CPU profile of the vehicle code: never
+            // sleep, don't wait for a GCS, and time each scheduler task
+            _bench_end_us = strtof(gopt.optarg, nullptr) * 1.0e6f;
+            lockstep = true;
+            _use_fg_view = false;
+            if (strcmp(_uart_path[0], "tcp:0:wait") == 0) {
+                _uart_path[0] = "tcp:0";
+            }
+            _set_param_default("SCHED_DEBUG=2");
+            _set_param_default("SCHED_OPTIONS=1");
+            break;
         default:
             _usage();
             exit(1);
@@ -346,6 +378,7 @@ void SITL_State::_parse_command_line(int argc, char * const argv[])
             sitl_model = model_constructors[i].constructor(home_str, model_str);
             sitl_model->set_interface_ports(simulator_address, simulator_port_in, simulator_port_out);
             sitl_model->set_speedup(speedup);
+            sitl_model->set_lockstep(lockstep);
             sitl_model->set_instance(_instance);
             sitl_model->set_autotest_dir(autotest_dir);
             _synthetic_clock_mode = true;
@@ -192,6 +192,7 @@ void Scheduler::_run_io_procs()
 
     _in_io_proc = false;
 
+    UARTDriver::_poll_fds();
     hal.uartA->_timer_tick();
     hal.uartB->_timer_tick();
     hal.uartC->_timer_tick();
@@ -1,4 +1,5 @@
 #include <AP_HAL/AP_HAL.h>
+#include <AP_Math/AP_Math.h>
 
 #include <assert.h>
 #include <sys/types.h>
@@ -93,6 +94,7 @@ void Storage::write_block(uint16_t loc, const void *src, size_t n)
         _storage_open();
         memcpy(&_buffer[loc], src, n);
         _mark_dirty(loc, n);
+        _last_write_ms = AP_HAL::millis();
     }
 }
 
@@ -101,41 +103,68 @@ void Storage::_timer_tick(void)
     if (!_initialised) {
         return;
     }
+    const uint32_t now = AP_HAL::millis();
     if (_dirty_mask.empty()) {
-        _last_empty_ms = AP_HAL::millis();
+        _last_empty_ms = now;
         return;
     }
 
-    // write out the first dirty line. We don't write more
-    // than one to keep the latency of this call to a minimum
-    uint16_t i;
-    for (i=0; i<STORAGE_NUM_LINES; i++) {
-        if (_dirty_mask.get(i)) {
-            break;
-        }
+    // wait for a burst of writes to finish, see AP_HAL_ChibiOS
+    if (now - _last_write_ms < STORAGE_SETTLE_MS &&
+        now - _last_empty_ms < STORAGE_MAX_HOLD_MS) {
+        return;
+    }
+
+    // write out the first run of dirty lines
+    const uint16_t line = _dirty_mask.first_set();
+    uint16_t nlines = 1;
+    while (nlines < STORAGE_MAX_WRITE_LINES &&
+           line+nlines < STORAGE_NUM_LINES &&
+           _dirty_mask.get(line+nlines)) {
+        nlines++;
+    }
+
+    // mark the lines clean before writing them, so a write_block()
+    // while they are being written marks them dirty again
+    for (uint16_t i=0; i<nlines; i++) {
+        _dirty_mask.clear(line+i);
     }
-    if (i == STORAGE_NUM_LINES) {
-        // this shouldn't be possible
+
+    const uint32_t start_us = AP_HAL::micros();
+    if (!_write_lines(line, nlines)) {
+        for (uint16_t i=0; i<nlines; i++) {
+            _dirty_mask.set(line+i);
+        }
         return;
     }
+    const uint32_t write_us = AP_HAL::micros() - start_us;
+    _stats.writes++;
+    _stats.lines += nlines;
+    _stats.max_write_us = MAX(_stats.max_write_us, write_us);
+    _stats.max_pending_ms = MAX(_stats.max_pending_ms, now - _last_empty_ms);
+}
 
+/*
+  write nlines lines from line to the backend
+ */
+bool Storage::_write_lines(uint16_t line, uint16_t nlines)
+{
 #if STORAGE_USE_POSIX
     if (using_filesystem && log_fd != -1) {
-        const off_t offset = STORAGE_LINE_SIZE*i;
+        const off_t offset = STORAGE_LINE_SIZE*line;
+        const ssize_t length = STORAGE_LINE_SIZE*nlines;
         if (lseek(log_fd, offset, SEEK_SET) != offset) {
-            return;
-        }
-        if (write(log_fd, &_buffer[offset], STORAGE_LINE_SIZE) != STORAGE_LINE_SIZE) {
-            return;
+            return false;
         }
-        _dirty_mask.clear(i);
-        return;
-    } 
+        return write(log_fd, &_buffer[offset], length) == length;
+    }
 #endif
-    
+
 #if STORAGE_USE_FLASH
     // save to storage backend
-    _flash_write(i);
+    return _flash_write(line, nlines);
+#else
+    return false;
 #endif
 }
 
@@ -154,15 +183,14 @@ void Storage::_flash_load(void)
 }
 
 /*
-  write one storage line. This also updates _dirty_mask. 
+  write nlines storage lines to flash
 */
-void Storage::_flash_write(uint16_t line)
+bool Storage::_flash_write(uint16_t line, uint16_t nlines)
 {
 #if STORAGE_USE_FLASH
-    if (_flash.write(line*STORAGE_LINE_SIZE, STORAGE_LINE_SIZE)) {
-        // mark the line clean
-        _dirty_mask.clear(line);
-    }
+    return _flash.write(line*STORAGE_LINE_SIZE, nlines*STORAGE_LINE_SIZE);
+#else
+    return false;
 #endif
 }
 
@@ -287,4 +315,10 @@ bool Storage::healthy(void)
     return _initialised && AP_HAL::millis() - _last_empty_ms < 2000;
 }
 
+bool Storage::get_stats(Stats &stats)
+{
+    stats = _stats;
+    return _initialised;
+}
+
 
@@ -22,6 +22,11 @@
 #define STORAGE_LINE_SIZE (1<<STORAGE_LINE_SHIFT)
 #define STORAGE_NUM_LINES (HAL_STORAGE_SIZE/STORAGE_LINE_SIZE)
 
+// the most lines written in one go, as for ChibiOS
+#define STORAGE_MAX_WRITE_LINES 8
+#define STORAGE_SETTLE_MS 50
+#define STORAGE_MAX_HOLD_MS 500
+
 class HALSITL::Storage : public AP_HAL::Storage {
 public:
     void init() override {}
@@ -30,6 +35,7 @@ public:
 
     void _timer_tick(void) override;
     bool healthy(void) override;
+    bool get_stats(Stats &stats) override;
 
 private:
     volatile bool _initialised;
@@ -50,6 +56,10 @@ private:
     bool _flash_failed;
     uint32_t _last_re_init_ms;
     uint32_t _last_empty_ms;
+    volatile uint32_t _last_write_ms;
+    Stats _stats;
+
+    bool _write_lines(uint16_t line, uint16_t nlines);
 
 #if STORAGE_USE_FLASH
     AP_FlashStorage _flash{_buffer,
@@ -61,7 +71,7 @@ private:
 #endif
     
     void _flash_load(void);
-    void _flash_write(uint16_t line);
+    bool _flash_write(uint16_t line, uint16_t nlines);
 
 #if STORAGE_USE_POSIX
     bool using_filesystem;
@@ -36,8 +36,12 @@
 #include <sys/select.h>
 #include <termios.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 
 #include "UARTDriver.h"
+#if SITL_UART_USE_EPOLL
+#include <sys/epoll.h>
+#endif
 #include "SITL_State.h"
 #include <AP_HAL/utility/packetise.h>
 
@@ -47,6 +51,13 @@ using namespace HALSITL;
 
 bool UARTDriver::_console;
 
+#if SITL_UART_USE_EPOLL
+int UARTDriver::_epoll_fd = -1;
+uint32_t UARTDriver::_fd_registered[SITL_UART_MAX_POLL_FDS/32];
+uint32_t UARTDriver::_fd_unpollable[SITL_UART_MAX_POLL_FDS/32];
+uint32_t UARTDriver::_fd_ready[SITL_UART_MAX_POLL_FDS/32];
+#endif
+
 /* UARTDriver method implementations */
 
 void UARTDriver::begin(uint32_t baud, uint16_t rxSpace, uint16_t txSpace)
@@ -134,6 +145,7 @@ void UARTDriver::begin(uint32_t baud, uint16_t rxSpace, uint16_t txSpace)
     if (hal.console != this) { // don't clear USB buffers (allows early startup messages to escape)
         _readbuffer.clear();
         _writebuffer.clear();
+        _stats.tx_cleared();
     }
 
     _set_nonblocking(_fd);
@@ -173,6 +185,14 @@ int16_t UARTDriver::read(void)
     return c;
 }
 
+ssize_t UARTDriver::read(uint8_t *buffer, uint16_t count)
+{
+    if (available() <= 0) {
+        return 0;
+    }
+    return _readbuffer.read(buffer, count);
+}
+
 void UARTDriver::flush(void)
 {
 }
@@ -180,37 +200,91 @@ void UARTDriver::flush(void)
 size_t UARTDriver::write(uint8_t c)
 {
     if (txspace() <= 0) {
+        _stats.queued(1, 0, _writebuffer.available());
         return 0;
     }
     _writebuffer.write(&c, 1);
+    _stats.queued(1, 1, _writebuffer.available());
     return 1;
 }
 
 size_t UARTDriver::write(const uint8_t *buffer, size_t size)
 {
+    const size_t len = size;
     if (txspace() <= size) {
         size = txspace();
     }
     if (size <= 0) {
+        _stats.queued(len, 0, _writebuffer.available());
         return 0;
     }
     if (_unbuffered_writes) {
         // write buffer straight to the file descriptor
         const ssize_t nwritten = ::write(_fd, buffer, size);
         if (nwritten == -1 && errno != EAGAIN && _uart_path) {
-            close(_fd);
+            _close_fd(_fd);
             _fd = -1;
             _connected = false;
         }
+        _stats.queued(len, size, 0);
+        _stats.sent(nwritten > 0 ? nwritten : 0);
+        if (nwritten < (ssize_t)size) {
+            // the rest is lost, so don't wait for it to be sent
+            _stats.tx_cleared();
+        }
         // these have no effect
         tcdrain(_fd);
     } else {
         _writebuffer.write(buffer, size);
+        _stats.queued(len, size, _writebuffer.available());
     }
     return size;
 }
 
-    
+
+/*
+  write all the fragments, or none of them. Unbuffered writes go to
+  the file descriptor with a single writev()
+ */
+size_t UARTDriver::writev(const WriteVec *vec, uint8_t count)
+{
+    uint32_t total = 0;
+    for (uint8_t i=0; i<count; i++) {
+        total += vec[i].len;
+    }
+    if (total == 0) {
+        return 0;
+    }
+    if (txspace() < total) {
+        _stats.queued(total, 0, _writebuffer.available());
+        return 0;
+    }
+    if (_unbuffered_writes) {
+        struct iovec iov[count];
+        for (uint8_t i=0; i<count; i++) {
+            iov[i].iov_base = const_cast<uint8_t *>(vec[i].data);
+            iov[i].iov_len = vec[i].len;
+        }
+        const ssize_t nwritten = ::writev(_fd, iov, count);
+        if (nwritten == -1 && errno != EAGAIN && _uart_path) {
+            _close_fd(_fd);
+            _fd = -1;
+            _connected = false;
+        }
+        _stats.queued(total, total, 0);
+        _stats.sent(nwritten > 0 ? nwritten : 0);
+        if (nwritten < (ssize_t)total) {
+            _stats.tx_cleared();
+        }
+    } else {
+        for (uint8_t i=0; i<count; i++) {
+            _writebuffer.write(vec[i].data, vec[i].len);
+        }
+        _stats.queued(total, total, _writebuffer.available());
+    }
+    return total;
+}
+
 /*
   start a TCP connection for the serial port. If wait_for_connection
   is true then block until a client connects
@@ -237,7 +311,7 @@ void UARTDriver::_tcp_start_connection(uint16_t port, bool wait_for_connection)
     }
 
     if (_fd != -1) {
-        close(_fd);
+        _close_fd(_fd);
     }
 
     if (_listen_fd == -1) {
@@ -326,7 +400,7 @@ void UARTDriver::_tcp_start_client(const char *address, uint16_t port)
     _use_send_recv = true;
     
     if (_fd != -1) {
-        close(_fd);
+        _close_fd(_fd);
     }
 
     memset(&sockaddr,0,sizeof(sockaddr));
@@ -382,7 +456,7 @@ void UARTDriver::_udp_start_client(const char *address, uint16_t port)
     _use_send_recv = true;
     
     if (_fd != -1) {
-        close(_fd);
+        _close_fd(_fd);
     }
 
     memset(&sockaddr,0,sizeof(sockaddr));
@@ -555,13 +629,30 @@ void UARTDriver::_check_connection(void)
 }
 
 /*
-  use select() to see if something is pending
+  see if something is pending on fd. Where epoll is available the
+  answer comes from the last _poll_fds() and costs no syscall
  */
 bool UARTDriver::_select_check(int fd)
 {
     if (fd == -1) {
         return false;
     }
+
+#if SITL_UART_USE_EPOLL
+    if (fd < SITL_UART_MAX_POLL_FDS && !_fd_bit(_fd_unpollable, fd)) {
+        if (_fd_bit(_fd_registered, fd)) {
+            if (!_fd_bit(_fd_ready, fd)) {
+                return false;
+            }
+            // report the fd once per poll as its data may now be read
+            _fd_ready[fd/32] &= ~(1U << (fd%32));
+            return true;
+        }
+        // register it for the next poll, and use select() this time
+        _poll_register(fd);
+    }
+#endif
+
     fd_set fds;
     struct timeval tv;
 
@@ -578,6 +669,74 @@ bool UARTDriver::_select_check(int fd)
     return false;
 }
 
+/*
+  find which of the registered fds are readable with a single
+  epoll_wait() for all the ports. Called before the ports are serviced
+  on each tick
+ */
+void UARTDriver::_poll_fds(void)
+{
+#if SITL_UART_USE_EPOLL
+    memset(_fd_ready, 0, sizeof(_fd_ready));
+    if (_epoll_fd == -1) {
+        return;
+    }
+    struct epoll_event events[32];
+    const int n = epoll_wait(_epoll_fd, events, ARRAY_SIZE(events), 0);
+    for (int i=0; i<n; i++) {
+        const int fd = events[i].data.fd;
+        _fd_ready[fd/32] |= 1U << (fd%32);
+    }
+    if (n == ARRAY_SIZE(events)) {
+        // some may not have been reported, let those ports use select()
+        for (uint16_t i=0; i<ARRAY_SIZE(_fd_ready); i++) {
+            _fd_ready[i] |= _fd_registered[i];
+        }
+    }
+#endif
+}
+
+#if SITL_UART_USE_EPOLL
+void UARTDriver::_poll_register(int fd)
+{
+    if (_epoll_fd == -1) {
+        _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll_fd == -1) {
+            _fd_unpollable[fd/32] |= 1U << (fd%32);
+            return;
+        }
+    }
+    struct epoll_event ev {};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev) == 0 || errno == EEXIST) {
+        _fd_registered[fd/32] |= 1U << (fd%32);
+    } else {
+        // such as a regular file, which epoll does not support
+        _fd_unpollable[fd/32] |= 1U << (fd%32);
+    }
+}
+#endif
+
+/*
+  close an fd, removing it from the poll set first
+ */
+void UARTDriver::_close_fd(int fd)
+{
+#if SITL_UART_USE_EPOLL
+    if (fd >= 0 && fd < SITL_UART_MAX_POLL_FDS) {
+        if (_fd_bit(_fd_registered, fd)) {
+            epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        }
+        const uint32_t mask = ~(1U << (fd%32));
+        _fd_registered[fd/32] &= mask;
+        _fd_unpollable[fd/32] &= mask;
+        _fd_ready[fd/32] &= mask;
+    }
+#endif
+    close(fd);
+}
+
 void UARTDriver::_set_nonblocking(int fd)
 {
     unsigned v = fcntl(fd, F_GETFL, 0);
@@ -636,12 +795,22 @@ void UARTDriver::_timer_tick(void)
             n = mavlink_packetise(_writebuffer, n);
         }
         if (n > 0) {
-            // keep as a single UDP packet
-            uint8_t tmpbuf[n];
-            _writebuffer.peekbytes(tmpbuf, n);
-            ssize_t ret = send(_fd, tmpbuf, n, MSG_DONTWAIT);
+            // keep as a single UDP packet, sent straight from both
+            // pieces of the ring buffer
+            ByteBuffer::IoVec vec[2];
+            struct iovec iov[2];
+            const auto n_vec = _writebuffer.peekiovec(vec, n);
+            for (uint8_t i=0; i<n_vec; i++) {
+                iov[i].iov_base = vec[i].data;
+                iov[i].iov_len = vec[i].len;
+            }
+            struct msghdr msg {};
+            msg.msg_iov = iov;
+            msg.msg_iovlen = n_vec;
+            ssize_t ret = sendmsg(_fd, &msg, MSG_DONTWAIT);
             if (ret > 0) {
                 _writebuffer.advance(ret);
+                _stats.sent(ret);
             }
         }
     } else {
@@ -652,7 +821,7 @@ void UARTDriver::_timer_tick(void)
             if (!_use_send_recv) {
                 nwritten = ::write(_fd, readptr, navail);
                 if (nwritten == -1 && errno != EAGAIN && _uart_path) {
-                    close(_fd);
+                    _close_fd(_fd);
                     _fd = -1;
                     _connected = false;
                 }
@@ -661,6 +830,7 @@ void UARTDriver::_timer_tick(void)
             }
             if (nwritten > 0) {
                 _writebuffer.advance(nwritten);
+                _stats.sent(nwritten);
             }
         }
     }
@@ -703,15 +873,18 @@ void UARTDriver::_timer_tick(void)
         int fd = _console?0:_fd;
         nread = ::read(fd, buf, space);
         if (nread == -1 && errno != EAGAIN && _uart_path) {
-            close(_fd);
+            _close_fd(_fd);
             _fd = -1;
             _connected = false;
         }
     } else if (_select_check(_fd)) {
         nread = recv(_fd, buf, space, MSG_DONTWAIT);
+        if (nread == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
         if (nread <= 0 && !_is_udp) {
             // the socket has reached EOF
-            close(_fd);
+            _close_fd(_fd);
             _fd = -1;
             _connected = false;
             fprintf(stdout, "Closed connection on serial port %u\n", _portNumber);
@@ -720,7 +893,8 @@ void UARTDriver::_timer_tick(void)
         }
     }
     if (nread > 0) {
-        _readbuffer.write((uint8_t *)buf, nread);
+        const uint32_t stored = _readbuffer.write((uint8_t *)buf, nread);
+        _stats.received(nread, stored, _readbuffer.available());
         _receive_timestamp = AP_HAL::micros64();
     }
 }
@@ -8,6 +8,17 @@
 #include "AP_HAL_SITL_Namespace.h"
 #include <AP_HAL/utility/Socket.h>
 #include <AP_HAL/utility/RingBuffer.h>
+#include <AP_HAL/utility/UARTStats.h>
+
+// use epoll to find the readable fds with one syscall per tick
+#if defined(__linux__)
+#define SITL_UART_USE_EPOLL 1
+#else
+#define SITL_UART_USE_EPOLL 0
+#endif
+
+// fds at or above this are always checked with select()
+#define SITL_UART_MAX_POLL_FDS 1024
 
 class HALSITL::UARTDriver : public AP_HAL::UARTDriver {
 public:
@@ -46,10 +57,12 @@ public:
     uint32_t available() override;
     uint32_t txspace() override;
     int16_t read() override;
+    ssize_t read(uint8_t *buffer, uint16_t count) override;
 
     /* Implementations of Print virtual methods */
     size_t write(uint8_t c) override;
     size_t write(const uint8_t *buffer, size_t size) override;
+    size_t writev(const WriteVec *vec, uint8_t count) override;
 
     // file descriptor, exposed so SITL_State::loop_hook() can use it
     int _fd;
@@ -67,6 +80,9 @@ public:
 
     void _timer_tick(void) override;
 
+    // find the readable fds of all ports, called once per tick before the ports' _timer_tick()
+    static void _poll_fds(void);
+
     /*
       return timestamp estimate in microseconds for when the start of
       a nbytes packet arrived on the uart. This should be treated as a
@@ -81,7 +97,12 @@ public:
       A return value of zero means the HAL does not support this API
      */
     uint64_t receive_time_constraint_us(uint16_t nbytes) override;
-    
+
+    bool get_stats(UARTStats &stats) override {
+        stats = _stats.get();
+        return true;
+    }
+
 private:
     uint8_t _portNumber;
     bool _connected = false; // true if a client has connected
@@ -92,6 +113,7 @@ private:
     bool _nonblocking_writes;
     ByteBuffer _readbuffer{16384};
     ByteBuffer _writebuffer{16384};
+    UARTStatsKeeper _stats;
 
     // default multicast IP and port
     const char *mcast_ip_default = "239.255.145.50";
@@ -111,6 +133,7 @@ private:
     void _udp_start_multicast(const char *address, uint16_t port);
     void _check_connection(void);
     static bool _select_check(int );
+    static void _close_fd(int fd);
     static void _set_nonblocking(int );
     bool set_speed(int speed);
 
@@ -120,6 +143,18 @@ private:
     bool _packetise;
     uint16_t _mc_myport;
     uint32_t last_tick_us;
+
+#if SITL_UART_USE_EPOLL
+    // poll set shared by all the ports, and bitmasks of its fds
+    static int _epoll_fd;
+    static uint32_t _fd_registered[SITL_UART_MAX_POLL_FDS/32];
+    static uint32_t _fd_unpollable[SITL_UART_MAX_POLL_FDS/32];
+    static uint32_t _fd_ready[SITL_UART_MAX_POLL_FDS/32];
+    static bool _fd_bit(const uint32_t *mask, int fd) {
+        return (mask[fd/32] & (1U << (fd%32))) != 0;
+    }
+    static void _poll_register(int fd);
+#endif
 };
 
 #endif
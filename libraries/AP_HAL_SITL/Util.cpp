@@ -68,6 +68,54 @@ bool HALSITL::Util::get_system_id(char buf[40])
     return get_system_id_unformatted((uint8_t *)buf, len);
 }
 
+#if HAL_PERF_TRACE_EVENTS
+/*
+  a perf counter is its trace id plus one, so nullptr stays invalid
+ */
+HALSITL::Util::perf_counter_t HALSITL::Util::perf_alloc(perf_counter_type t, const char *name)
+{
+    const int16_t id = perf_trace.add(name);
+    if (id < 0) {
+        return nullptr;
+    }
+    return (perf_counter_t)(uintptr_t)(id + 1);
+}
+
+void HALSITL::Util::perf_record(perf_counter_t h, PerfTrace::Event event)
+{
+    if (h == nullptr) {
+        return;
+    }
+    // number the threads in the order they first trace
+    static uint16_t num_threads;
+    static thread_local uint16_t thread;
+    if (thread == 0) {
+        thread = __atomic_add_fetch(&num_threads, 1, __ATOMIC_RELAXED);
+    }
+    perf_trace.record((uintptr_t)h - 1, event, thread);
+}
+
+void HALSITL::Util::perf_begin(perf_counter_t h)
+{
+    perf_record(h, PerfTrace::Event::BEGIN);
+}
+
+void HALSITL::Util::perf_end(perf_counter_t h)
+{
+    perf_record(h, PerfTrace::Event::END);
+}
+
+void HALSITL::Util::perf_count(perf_counter_t h)
+{
+    perf_record(h, PerfTrace::Event::COUNT);
+}
+
+bool HALSITL::Util::perf_trace_dump(const char *path)
+{
+    return perf_trace.write_chrome_trace(path);
+}
+#endif
+
 #ifdef ENABLE_HEAP
 void *HALSITL::Util::allocate_heap_memory(size_t size)
 {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/PerfTrace.h>
 #include "AP_HAL_SITL_Namespace.h"
 #include "AP_HAL_SITL.h"
 #include "Semaphores.h"
@@ -39,6 +40,15 @@ public:
     virtual void *heap_realloc(void *heap, void *ptr, size_t new_size);
 #endif // ENABLE_HEAP
 
+#if HAL_PERF_TRACE_EVENTS
+    // perf counters record into a ring of events, for perf_trace_dump()
+    perf_counter_t perf_alloc(perf_counter_type t, const char *name) override;
+    void perf_begin(perf_counter_t h) override;
+    void perf_end(perf_counter_t h) override;
+    void perf_count(perf_counter_t h) override;
+    bool perf_trace_dump(const char *path) override;
+#endif
+
 #ifdef WITH_SITL_TONEALARM
     bool toneAlarm_init() override { return _toneAlarm.init(); }
     void toneAlarm_set_buzzer_tone(float frequency, float volume, uint32_t duration_ms) override {
@@ -49,6 +59,11 @@ public:
 private:
     SITL_State *sitlState;
 
+#if HAL_PERF_TRACE_EVENTS
+    PerfTrace perf_trace;
+    void perf_record(perf_counter_t h, PerfTrace::Event event);
+#endif
+
 #ifdef WITH_SITL_TONEALARM
     static ToneAlarm_SF _toneAlarm;
 #endif
@@ -52,7 +52,7 @@ AP_IOMCU::AP_IOMCU(AP_HAL::UARTDriver &_uart) :
 void AP_IOMCU::init(void)
 {
     // uart runs at 1.5MBit
-    uart.begin(1500*1000, 256, 256);
+    uart.begin(link_baudrate, 256, 256);
     uart.set_blocking_writes(false);
     uart.set_unbuffered_writes(true);
 
@@ -91,7 +91,7 @@ void AP_IOMCU::thread_main(void)
     thread_ctx = chThdGetSelfX();
     chEvtSignal(thread_ctx, initial_event_mask);
 
-    uart.begin(1500*1000, 256, 256);
+    uart.begin(link_baudrate, 256, 256);
     uart.set_blocking_writes(false);
     uart.set_unbuffered_writes(true);
     
@@ -200,7 +200,13 @@ void AP_IOMCU::thread_main(void)
 
         // check for regular timed events
         uint32_t now = AP_HAL::millis();
-        if (now - last_rc_read_ms > 20) {
+        if (is_chibios_backend) {
+            // the status and RC input come back with each batch of
+            // outputs. Poll with an empty batch if outputs stop
+            if (AP_HAL::micros() - last_batch_us > 20000) {
+                batch_transfer(0, nullptr);
+            }
+        } else if (now - last_rc_read_ms > 20) {
             // read RC input at 50Hz
             read_rc_input();
             last_rc_read_ms = AP_HAL::millis();
@@ -212,6 +218,10 @@ void AP_IOMCU::thread_main(void)
             last_status_read_ms = AP_HAL::millis();
         }
 
+        if (now - link.last_update_ms >= 1000) {
+            update_link_stats(now);
+        }
+
         if (now - last_servo_read_ms > 50) {
             // read servo out at 20Hz
             read_servo();
@@ -268,7 +278,15 @@ void AP_IOMCU::send_servo_out()
             n = MIN(n, IOMCU_MAX_CHANNELS);
         }
         uint32_t now = AP_HAL::micros();
-        if (now - last_servo_out_us >= 2000) {
+        if (is_chibios_backend) {
+            // a batch replaces the separate status and RC reads, so
+            // there is room for outputs at up to 1kHz
+            if (now - last_servo_out_us >= 1000) {
+                if (batch_transfer(n, pwm_out.pwm)) {
+                    last_servo_out_us = now;
+                }
+            }
+        } else if (now - last_servo_out_us >= 2000) {
             // don't send data at more than 500Hz
             if (write_registers(PAGE_DIRECT_PWM, 0, n, pwm_out.pwm)) {
                 last_servo_out_us = now;
@@ -295,8 +313,11 @@ void AP_IOMCU::read_rc_input()
  */
 void AP_IOMCU::read_status()
 {
-    uint16_t *r = (uint16_t *)&reg_status;
-    read_registers(PAGE_STATUS, 0, sizeof(reg_status)/2, r);
+    if (!is_chibios_backend) {
+        // with batches the flags and voltages are already up to date
+        uint16_t *r = (uint16_t *)&reg_status;
+        read_registers(PAGE_STATUS, 0, sizeof(reg_status)/2, r);
+    }
 
     if (reg_status.flag_safety_off == 0) {
         // if the IOMCU is indicating that safety is on, then force a
@@ -380,10 +401,13 @@ bool AP_IOMCU::read_registers(uint8_t page, uint8_t offset, uint8_t count, uint1
       a large number of registers wastes a lot of serial bandwidth
      */
     pkt.crc = crc_crc8((const uint8_t *)&pkt, pkt_size);
+    const uint32_t start_us = AP_HAL::micros();
     if (uart.write((uint8_t *)&pkt, pkt_size) != pkt_size) {
         protocol_fail_count++;
         return false;
     }
+    link.requests++;
+    link.tx_bytes += pkt_size;
 
     // wait for the expected number of reply bytes or timeout
     if (!uart.wait_timeout(count*2+4, 10)) {
@@ -397,6 +421,7 @@ bool AP_IOMCU::read_registers(uint8_t page, uint8_t offset, uint8_t count, uint1
             b[i] = uart.read();
         }
     }
+    link.rx_bytes += n;
 
     uint8_t got_crc = pkt.crc;
     pkt.crc = 0;
@@ -421,6 +446,7 @@ bool AP_IOMCU::read_registers(uint8_t page, uint8_t offset, uint8_t count, uint1
     }
     memcpy(regs, pkt.regs, count*2);
     protocol_fail_count = 0;
+    link_reply(start_us);
     return true;
 }
 
@@ -450,10 +476,13 @@ bool AP_IOMCU::write_registers(uint8_t page, uint8_t offset, uint8_t count, cons
     pkt.crc = 0;
     memcpy(pkt.regs, regs, 2*count);
     pkt.crc = crc_crc8((const uint8_t *)&pkt, pkt.get_size());
+    const uint32_t start_us = AP_HAL::micros();
     if (uart.write((uint8_t *)&pkt, pkt.get_size()) != pkt.get_size()) {
         protocol_fail_count++;
         return false;
     }
+    link.requests++;
+    link.tx_bytes += pkt.get_size();
 
     // wait for the expected number of reply bytes or timeout
     if (!uart.wait_timeout(4, 10)) {
@@ -469,6 +498,7 @@ bool AP_IOMCU::write_registers(uint8_t page, uint8_t offset, uint8_t count, cons
             b[i] = uart.read();
         }
     }
+    link.rx_bytes += n;
 
     if (pkt.code != CODE_SUCCESS) {
         debug("bad code %02x write %u/%u/%u %02x/%02x n=%u\n",
@@ -486,9 +516,135 @@ bool AP_IOMCU::write_registers(uint8_t page, uint8_t offset, uint8_t count, cons
         return false;
     }
     protocol_fail_count = 0;
+    link_reply(start_us);
     return true;
 }
 
+/*
+  send count output values and get back the status flags, voltages
+  and RC input, all in one transaction. A count of zero only polls
+*/
+bool AP_IOMCU::batch_transfer(uint8_t count, const uint16_t *regs)
+{
+    IOPacket pkt;
+
+    last_batch_us = AP_HAL::micros();
+
+    discard_input();
+
+    memset(&pkt.regs[0], 0, sizeof(pkt.regs));
+
+    pkt.code = CODE_BATCH;
+    pkt.count = count;
+    pkt.page = PAGE_DIRECT_PWM;
+    pkt.offset = 0;
+    pkt.crc = 0;
+    if (count > 0) {
+        memcpy(pkt.regs, regs, 2*count);
+    }
+    pkt.crc = crc_crc8((const uint8_t *)&pkt, pkt.get_size());
+    const uint32_t start_us = AP_HAL::micros();
+    if (uart.write((uint8_t *)&pkt, pkt.get_size()) != pkt.get_size()) {
+        protocol_fail_count++;
+        return false;
+    }
+    link.requests++;
+    link.tx_bytes += pkt.get_size();
+
+    // the reply length depends on the number of RC channels, so
+    // wait for the fixed part first
+    const uint8_t min_size = 4 + PAGE_BATCH_HEADER_REGS*2;
+    if (!uart.wait_timeout(min_size, 10)) {
+        protocol_fail_count++;
+        return false;
+    }
+
+    uint8_t *b = (uint8_t *)&pkt;
+    uint8_t n = 0;
+    uint8_t avail = uart.available();
+    while (avail-- && n < sizeof(pkt)) {
+        b[n++] = uart.read();
+    }
+
+    if (pkt.code != CODE_SUCCESS || pkt.page != PAGE_BATCH ||
+        pkt.count < PAGE_BATCH_HEADER_REGS || pkt.count > PKT_MAX_REGS) {
+        debug("bad batch reply %02x %u/%u n=%u\n", pkt.code, pkt.page, pkt.count, n);
+        link.rx_bytes += n;
+        protocol_fail_count++;
+        return false;
+    }
+    if (n < pkt.get_size()) {
+        if (!uart.wait_timeout(pkt.get_size() - n, 10)) {
+            link.rx_bytes += n;
+            protocol_fail_count++;
+            return false;
+        }
+        avail = uart.available();
+        while (avail-- && n < sizeof(pkt)) {
+            b[n++] = uart.read();
+        }
+    }
+    link.rx_bytes += n;
+
+    uint8_t got_crc = pkt.crc;
+    pkt.crc = 0;
+    uint8_t expected_crc = crc_crc8((const uint8_t *)&pkt, pkt.get_size());
+    if (got_crc != expected_crc) {
+        debug("bad crc %02x should be %02x batch n=%u\n", got_crc, expected_crc, n);
+        protocol_fail_count++;
+        return false;
+    }
+
+    const struct page_batch &batch = *(const struct page_batch *)pkt.regs;
+    ((uint16_t *)&reg_status)[PAGE_REG_STATUS_FLAGS] = batch.status_flags;
+    reg_status.vservo = batch.vservo;
+    reg_status.vrssi = batch.vrssi;
+    memcpy(&rc_input, batch.rc_input, (pkt.count - 3) * 2);
+    if (rc_input.flags_rc_ok && !rc_input.flags_failsafe) {
+        rc_input.last_input_ms = AP_HAL::millis();
+    }
+
+    protocol_fail_count = 0;
+    link_reply(start_us);
+    return true;
+}
+
+/*
+  account for a good reply in the link statistics
+*/
+void AP_IOMCU::link_reply(uint32_t start_us)
+{
+    const uint32_t latency_us = AP_HAL::micros() - start_us;
+    link.replies++;
+    link.latency_sum_us += latency_us;
+    link.latency_max_us = MAX(link.latency_max_us, latency_us);
+}
+
+/*
+  work out the link statistics for the last interval and start a new one
+*/
+void AP_IOMCU::update_link_stats(uint32_t now_ms)
+{
+    const uint32_t dt_ms = now_ms - link.last_update_ms;
+    link.last_update_ms = now_ms;
+    if (dt_ms > 0 && dt_ms < 10000) {
+        last_link_stats.rate_hz = link.replies * 1000U / dt_ms;
+        last_link_stats.fail_hz = (link.requests - link.replies) * 1000U / dt_ms;
+        // 10 bits a byte, as a percentage of the bits the baudrate allows
+        const uint64_t bits = uint64_t(link.tx_bytes + link.rx_bytes) * 10U;
+        last_link_stats.util_pct = MIN(bits * 100U * 1000U / (uint64_t(link_baudrate) * dt_ms), 100U);
+        last_link_stats.latency_avg_us = link.replies ? link.latency_sum_us / link.replies : 0;
+        last_link_stats.latency_max_us = MIN(link.latency_max_us, UINT16_MAX);
+    }
+
+    link.requests = 0;
+    link.replies = 0;
+    link.tx_bytes = 0;
+    link.rx_bytes = 0;
+    link.latency_sum_us = 0;
+    link.latency_max_us = 0;
+}
+
 // modify a single register
 bool AP_IOMCU::modify_register(uint8_t page, uint8_t offset, uint16_t clearbits, uint16_t setbits)
 {
@@ -102,7 +102,17 @@ public:
     // setup for FMU failsafe mixing
     bool setup_mixing(RCMapper *rcmap, int8_t override_chan,
                       float mixing_gain, uint16_t manual_rc_mask);
-    
+
+    // statistics of the serial link over the last second
+    struct link_stats {
+        uint16_t rate_hz;           // good transactions a second
+        uint16_t fail_hz;           // failed transactions a second
+        uint8_t util_pct;           // link utilisation
+        uint16_t latency_avg_us;    // request to reply time
+        uint16_t latency_max_us;
+    };
+    const struct link_stats &get_link_stats(void) const { return last_link_stats; }
+
 private:
     AP_HAL::UARTDriver &uart;
 
@@ -118,6 +128,9 @@ private:
     bool write_register(uint8_t page, uint8_t offset, uint16_t v) {
         return write_registers(page, offset, 1, &v);
     }
+
+    // write outputs and read status and RC input in one transaction
+    bool batch_transfer(uint8_t count, const uint16_t *regs);
     
     // modify a single register
     bool modify_register(uint8_t page, uint8_t offset, uint16_t clearbits, uint16_t setbits);
@@ -194,6 +207,25 @@ private:
     uint8_t heater_duty_cycle;
 
     uint32_t last_servo_out_us;
+    uint32_t last_batch_us;
+
+    // the IOMCU runs its UART at the most its 24MHz clock allows
+    static const uint32_t link_baudrate = 1500000;
+
+    // link statistics being gathered, and the last published ones
+    struct {
+        uint32_t last_update_ms;
+        uint32_t requests;
+        uint32_t replies;
+        uint32_t tx_bytes;
+        uint32_t rx_bytes;
+        uint32_t latency_sum_us;
+        uint32_t latency_max_us;
+    } link;
+    struct link_stats last_link_stats;
+
+    void link_reply(uint32_t start_us);
+    void update_link_stats(uint32_t now_ms);
 
     bool corked;
     bool do_shutdown;
@@ -46,7 +46,7 @@ enum ioevents {
 };
 
 static struct {
-    uint32_t num_code_read, num_bad_crc, num_write_pkt, num_unknown_pkt;
+    uint32_t num_code_read, num_bad_crc, num_write_pkt, num_batch_pkt, num_unknown_pkt;
     uint32_t num_idle_rx, num_dma_complete_rx, num_total_rx, num_rx_error;
 } stats;
 
@@ -372,6 +372,18 @@ void AP_IOMCU_FW::process_io_packet()
         }
     }
     break;
+    case CODE_BATCH: {
+        stats.num_batch_pkt++;
+        if (!handle_code_batch()) {
+            tx_io_packet.count = 0;
+            tx_io_packet.code = CODE_ERROR;
+            tx_io_packet.crc = 0;
+            tx_io_packet.page = 0;
+            tx_io_packet.offset = 0;
+            tx_io_packet.crc =  crc_crc8((const uint8_t *)&tx_io_packet, tx_io_packet.get_size());
+        }
+    }
+    break;
     default: {
         stats.num_unknown_pkt++;
     }
@@ -543,32 +555,11 @@ bool AP_IOMCU_FW::handle_code_write()
         }
         break;
 
-    case PAGE_DIRECT_PWM: {
-        if (override_active) {
-            // no input when override is active
-            break;
-        }
-        /* copy channel data */
-        uint16_t i = 0, offset = rx_io_packet.offset, num_values = rx_io_packet.count;
-        if (offset + num_values > sizeof(reg_direct_pwm.pwm)/2) {
+    case PAGE_DIRECT_PWM:
+        if (!handle_direct_pwm()) {
             return false;
         }
-        while ((offset < IOMCU_MAX_CHANNELS) && (num_values > 0)) {
-            /* XXX range-check value? */
-            if (rx_io_packet.regs[i] != PWM_IGNORE_THIS_CHANNEL) {
-                reg_direct_pwm.pwm[offset] = rx_io_packet.regs[i];
-            }
-
-            offset++;
-            num_values--;
-            i++;
-        }
-        fmu_data_received_time = last_ms;
-        reg_status.flag_fmu_ok = true;
-        reg_status.flag_raw_pwm = true;
-        chEvtSignalI(thread_ctx, EVENT_MASK(IOEVENT_PWM));
         break;
-    }
 
     case PAGE_MIXING: {
         uint16_t offset = rx_io_packet.offset, num_values = rx_io_packet.count;
@@ -609,6 +600,67 @@ bool AP_IOMCU_FW::handle_code_write()
     return true;
 }
 
+/*
+  take new output values from a PAGE_DIRECT_PWM write or a batch
+ */
+bool AP_IOMCU_FW::handle_direct_pwm()
+{
+    if (override_active) {
+        // no input when override is active
+        return true;
+    }
+    /* copy channel data */
+    uint16_t i = 0, offset = rx_io_packet.offset, num_values = rx_io_packet.count;
+    if (offset + num_values > sizeof(reg_direct_pwm.pwm)/2) {
+        return false;
+    }
+    while ((offset < IOMCU_MAX_CHANNELS) && (num_values > 0)) {
+        /* XXX range-check value? */
+        if (rx_io_packet.regs[i] != PWM_IGNORE_THIS_CHANNEL) {
+            reg_direct_pwm.pwm[offset] = rx_io_packet.regs[i];
+        }
+
+        offset++;
+        num_values--;
+        i++;
+    }
+    fmu_data_received_time = last_ms;
+    reg_status.flag_fmu_ok = true;
+    reg_status.flag_raw_pwm = true;
+    chEvtSignalI(thread_ctx, EVENT_MASK(IOEVENT_PWM));
+    return true;
+}
+
+/*
+  handle a batch: outputs from the FMU, with the status and RC input
+  in the reply. A batch with no outputs only polls, and doesn't count
+  as data from the FMU for failsafe
+ */
+bool AP_IOMCU_FW::handle_code_batch()
+{
+    if (rx_io_packet.page != PAGE_DIRECT_PWM) {
+        return false;
+    }
+    if (rx_io_packet.count > 0 && !handle_direct_pwm()) {
+        return false;
+    }
+
+    struct page_batch &batch = *(struct page_batch *)tx_io_packet.regs;
+    batch.status_flags = ((const uint16_t *)&reg_status)[PAGE_REG_STATUS_FLAGS];
+    batch.vservo = reg_status.vservo;
+    batch.vrssi = reg_status.vrssi;
+    const uint8_t num_rc = MIN(rc_input.count, IOMCU_MAX_CHANNELS);
+    memcpy(batch.rc_input, &rc_input, (6 + num_rc) * sizeof(uint16_t));
+
+    tx_io_packet.count = PAGE_BATCH_HEADER_REGS + num_rc;
+    tx_io_packet.code = CODE_SUCCESS;
+    tx_io_packet.page = PAGE_BATCH;
+    tx_io_packet.offset = 0;
+    tx_io_packet.crc = 0;
+    tx_io_packet.crc =  crc_crc8((const uint8_t *)&tx_io_packet, tx_io_packet.get_size());
+    return true;
+}
+
 void AP_IOMCU_FW::schedule_reboot(uint32_t time_ms)
 {
     do_reboot = true;
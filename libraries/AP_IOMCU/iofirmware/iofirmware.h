@@ -29,6 +29,8 @@ private:
 
     bool handle_code_write();
     bool handle_code_read();
+    bool handle_code_batch();
+    bool handle_direct_pwm();
     void schedule_reboot(uint32_t time_ms);
     void safety_update();
     void rcout_mode_update();
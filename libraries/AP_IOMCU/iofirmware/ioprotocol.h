@@ -6,8 +6,8 @@
   common protocol definitions between AP_IOMCU and iofirmware
  */
 
-// 22 is enough for the rc_input page in one transfer
-#define PKT_MAX_REGS 22
+// 25 is enough for a batch reply with 16 RC channels in one transfer
+#define PKT_MAX_REGS 25
 #define IOMCU_MAX_CHANNELS 16
 
 //#define IOMCU_DEBUG
@@ -34,6 +34,8 @@ enum iocode {
     // read types
     CODE_READ = 0,
     CODE_WRITE = 1,
+    // write PAGE_DIRECT_PWM and get a PAGE_BATCH reply
+    CODE_BATCH = 2,
 
     // reply codes
     CODE_SUCCESS = 0,
@@ -51,6 +53,7 @@ enum iopage {
     PAGE_RCIN = 5,
     PAGE_RAW_ADC = 6,
     PAGE_PWM_INFO = 7,
+    PAGE_BATCH = 10,
     PAGE_SETUP = 50,
     PAGE_DIRECT_PWM = 54,
     PAGE_FAILSAFE_PWM = 55,
@@ -88,7 +91,7 @@ enum iopage {
 #define PAGE_CONFIG_PROTOCOL_VERSION  0
 #define PAGE_CONFIG_PROTOCOL_VERSION2 1
 #define IOMCU_PROTOCOL_VERSION       4
-#define IOMCU_PROTOCOL_VERSION2     10
+#define IOMCU_PROTOCOL_VERSION2     11
 
 // magic value for rebooting to bootloader
 #define REBOOT_BL_MAGIC 14662
@@ -132,6 +135,9 @@ struct PACKED page_reg_status {
     uint16_t prssi;
 };
 
+// register of the status flags in page_reg_status
+#define PAGE_REG_STATUS_FLAGS 2
+
 struct PACKED page_rc_input {
     uint16_t count;
     uint16_t flags_frame_drop:1;
@@ -150,6 +156,25 @@ struct PACKED page_rc_input {
     uint32_t last_input_ms;
 };
 
+/*
+  reply to a CODE_BATCH packet. This carries what the FMU polls for
+  each cycle, so one transaction sends the outputs and gets back the
+  status and RC input
+ */
+struct PACKED page_batch {
+    // the status flags register of page_reg_status
+    uint16_t status_flags;
+    uint16_t vservo;
+    uint16_t vrssi;
+
+    // the start of page_rc_input, with a pwm value for each RC
+    // channel. Only the channels in use are sent
+    uint16_t rc_input[6 + IOMCU_MAX_CHANNELS];
+};
+
+// registers in a batch reply ahead of the RC pwm values
+#define PAGE_BATCH_HEADER_REGS 9
+
 /*
   data for mixing on FMU failsafe
  */
@@ -9,6 +9,7 @@
 #include <AP_Vehicle/AP_Vehicle.h>
 #include <AP_BoardConfig/AP_BoardConfig.h>
 #include <AP_AHRS/AP_AHRS.h>
+#include <AP_Logger/AP_Logger.h>
 
 #include "AP_InertialSensor.h"
 #include "AP_InertialSensor_BMI160.h"
@@ -435,7 +436,7 @@ const AP_Param::GroupInfo AP_InertialSensor::var_info[] = {
 
     // @Group: NOTCH_
     // @Path: ../Filter/NotchFilter.cpp
-    AP_SUBGROUPINFO(_notch_filter, "NOTCH_",  37, AP_InertialSensor, NotchFilterVector3fParam),
+    AP_SUBGROUPINFO(_notch_filter, "NOTCH_",  37, AP_InertialSensor, NotchFilterParams),
 
     // @Group: LOG_
     // @Path: ../AP_InertialSensor/BatchSampler.cpp
@@ -449,6 +450,20 @@ const AP_Param::GroupInfo AP_InertialSensor::var_info[] = {
     // @Bitmask: 0:FirstIMU,1:SecondIMU,2:ThirdIMU
     AP_GROUPINFO("ENABLE_MASK",  40, AP_InertialSensor, _enable_mask, 0x7F),
 
+#if HAL_GYROFFT_ENABLED
+    // @Param: FFT_ENABLE
+    // @DisplayName: Gyro FFT analysis enable
+    // @Description: Enable on-board FFT analysis of the first gyro. The frequencies and amplitudes of the strongest vibration peaks on each axis are logged in FTN messages, along with the time taken by the analysis.
+    // @Values: 0:Disabled,1:Enabled
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("FFT_ENABLE",  41, AP_InertialSensor, _fft_enable, 0),
+#endif
+
+    // @Group: HNTCH_
+    // @Path: ../Filter/HarmonicNotchFilter.cpp
+    AP_SUBGROUPINFO(_harmonic_notch_filter, "HNTCH_",  42, AP_InertialSensor, HarmonicNotchFilterParams),
+
     /*
       NOTE: parameter indexes have gaps above. When adding new
       parameters check for conflicts carefully
@@ -642,7 +657,8 @@ AP_InertialSensor::init(uint16_t sample_rate)
 
     _sample_period_usec = 1000*1000UL / _sample_rate;
 
-    _notch_filter.init(sample_rate);
+    // the harmonic notch starts at its base frequency
+    _calculated_harmonic_notch_freq_hz = _harmonic_notch_filter.center_freq_hz();
     
     // establish the baseline time between samples
     _delta_time = 0;
@@ -652,6 +668,13 @@ AP_InertialSensor::init(uint16_t sample_rate)
 
     // initialise IMU batch logging
     batchsampler.init();
+
+#if HAL_GYROFFT_ENABLED
+    if (_fft_enable && _gyro_count > 0 &&
+        !_gyro_fft.init(_gyro_raw_sample_rates[0])) {
+        hal.console->printf("INS: gyro FFT failed to start\n");
+    }
+#endif
 }
 
 bool AP_InertialSensor::_add_backend(AP_InertialSensor_Backend *backend)
@@ -886,11 +909,156 @@ AP_InertialSensor::detect_backends(void)
     }
 }
 
+/*
+  start queueing gyro samples for a rate control thread
+ */
+bool AP_InertialSensor::enable_fast_rate_buffer(uint8_t rate_decimation)
+{
+    if (_fast_rate_buffer != nullptr) {
+        return true;
+    }
+    // a few samples; the thread is expected to keep up
+    ObjectBuffer<fast_gyro_sample> *buffer = new ObjectBuffer<fast_gyro_sample>(8);
+    if (buffer == nullptr || buffer->space() == 0) {
+        delete buffer;
+        return false;
+    }
+    _fast_rate_decimation = MAX(rate_decimation, 1);
+    _fast_rate_buffer = buffer;
+    return true;
+}
+
+bool AP_InertialSensor::get_next_gyro_sample(Vector3f &gyro, uint64_t &sample_us)
+{
+    fast_gyro_sample sample;
+    if (_fast_rate_buffer == nullptr || !_fast_rate_buffer->pop(sample)) {
+        return false;
+    }
+    gyro = sample.gyro;
+    sample_us = sample.sample_us;
+    return true;
+}
+
+void AP_InertialSensor::record_output_latency(uint64_t gyro_sample_us)
+{
+    if (gyro_sample_us == 0) {
+        return;
+    }
+    const uint32_t latency_us = MIN(AP_HAL::micros64() - gyro_sample_us, (uint64_t)UINT32_MAX);
+    uint8_t bucket = 0;
+    uint32_t v = latency_us >> 7;
+    while (v != 0 && bucket < ARRAY_SIZE(_output_latency.histogram)-1) {
+        v >>= 1;
+        bucket++;
+    }
+
+    WITH_SEMAPHORE(_latency_sem);
+    if (_output_latency.histogram[bucket] < UINT16_MAX) {
+        _output_latency.histogram[bucket]++;
+    }
+    _output_latency.count++;
+    _output_latency.sum_us += latency_us;
+    _output_latency.max_us = MAX(_output_latency.max_us, latency_us);
+}
+
+/*
+  log the output latency histogram once a second
+ */
+void AP_InertialSensor::log_output_latency()
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - _output_latency.last_log_ms < 1000) {
+        return;
+    }
+    _output_latency.last_log_ms = now_ms;
+
+    uint16_t histogram[ARRAY_SIZE(_output_latency.histogram)];
+    uint32_t count, sum_us, max_us;
+    {
+        WITH_SEMAPHORE(_latency_sem);
+        memcpy(histogram, _output_latency.histogram, sizeof(histogram));
+        count = _output_latency.count;
+        sum_us = _output_latency.sum_us;
+        max_us = _output_latency.max_us;
+        memset(_output_latency.histogram, 0, sizeof(_output_latency.histogram));
+        _output_latency.count = 0;
+        _output_latency.sum_us = 0;
+        _output_latency.max_us = 0;
+    }
+
+    AP_Logger *logger = AP_Logger::get_singleton();
+    if (count == 0 || logger == nullptr) {
+        return;
+    }
+    const struct log_GyroLatency pkt {
+        LOG_PACKET_HEADER_INIT(LOG_GYRO_LATENCY_MSG),
+        time_us : AP_HAL::micros64(),
+        count   : count,
+        avg_us  : sum_us / count,
+        max_us  : max_us,
+        h0      : histogram[0],
+        h1      : histogram[1],
+        h2      : histogram[2],
+        h3      : histogram[3],
+        h4      : histogram[4],
+        h5      : histogram[5],
+        h6      : histogram[6],
+        h7      : histogram[7],
+    };
+    logger->WriteBlock(&pkt, sizeof(pkt));
+}
+
+/*
+  log the bus utilisation of each gyro's device once a second
+ */
+void AP_InertialSensor::log_bus_utilisation()
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - _bus_log_ms < 1000) {
+        return;
+    }
+    _bus_log_ms = now_ms;
+
+    AP_Logger *logger = AP_Logger::get_singleton();
+    if (logger == nullptr) {
+        return;
+    }
+    const uint64_t now_us = AP_HAL::micros64();
+    for (uint8_t i=0; i<_gyro_count; i++) {
+        if (!is_positive(_bus_utilisation[i])) {
+            continue;
+        }
+        const struct log_IMUBus pkt {
+            LOG_PACKET_HEADER_INIT(LOG_IMU_BUS_MSG),
+            time_us     : now_us,
+            instance    : i,
+            utilisation : _bus_utilisation[i],
+        };
+        logger->WriteBlock(&pkt, sizeof(pkt));
+    }
+}
+
+/*
+  set the harmonic notch center frequency. The backends move their
+  filters when they next update
+ */
+void AP_InertialSensor::update_harmonic_notch_freq_hz(float freq_hz)
+{
+    if (is_positive(freq_hz)) {
+        _calculated_harmonic_notch_freq_hz = freq_hz;
+    }
+}
+
 // Armed, Copter, PixHawk:
 // ins_periodic: 57500 events, 0 overruns, 208754us elapsed, 3us avg, min 1us max 218us 40.662us rms
 void AP_InertialSensor::periodic()
 {
     batchsampler.periodic();
+    log_output_latency();
+    log_bus_utilisation();
+#if HAL_GYROFFT_ENABLED
+    _gyro_fft.periodic();
+#endif
 }
 
 
@@ -1339,9 +1507,6 @@ void AP_InertialSensor::update(void)
         }
     }
 
-    // apply notch filter to primary gyro
-    _gyro[_primary_gyro] = _notch_filter.apply(_gyro[_primary_gyro]);
-    
     _last_update_usec = AP_HAL::micros();
     
     _have_sample = false;
@@ -21,10 +21,13 @@
 
 #include <AP_AccelCal/AP_AccelCal.h>
 #include <AP_HAL/AP_HAL.h>
+#include <AP_HAL/utility/RingBuffer.h>
 #include <AP_Math/AP_Math.h>
 #include <Filter/LowPassFilter2p.h>
 #include <Filter/LowPassFilter.h>
 #include <Filter/NotchFilter.h>
+#include <Filter/HarmonicNotchFilter.h>
+#include <AP_GyroFFT/AP_GyroFFT.h>
 
 class AP_InertialSensor_Backend;
 class AuxiliaryBus;
@@ -98,6 +101,15 @@ public:
     const Vector3f     &get_gyro(uint8_t i) const { return _gyro[i]; }
     const Vector3f     &get_gyro(void) const { return get_gyro(_primary_gyro); }
 
+    // time in microseconds of the newest raw sample in the gyro
+    // reading, or of when it was read for sensors without sample times
+    uint64_t get_gyro_sample_us(uint8_t i) const { return _gyro_sample_us[i]; }
+    uint64_t get_gyro_sample_us(void) const { return get_gyro_sample_us(_primary_gyro); }
+
+    // record the time from a gyro sample to the motor outputs
+    // computed from it being pushed. Called just after the push
+    void record_output_latency(uint64_t gyro_sample_us);
+
     // set gyro offsets in radians/sec
     const Vector3f &get_gyro_offsets(uint8_t i) const { return _gyro_offset[i]; }
     const Vector3f &get_gyro_offsets(void) const { return get_gyro_offsets(_primary_gyro); }
@@ -124,6 +136,10 @@ public:
     const Vector3f     &get_accel(void) const { return get_accel(_primary_accel); }
 
     uint32_t get_gyro_error_count(uint8_t i) const { return _gyro_error_count[i]; }
+
+    // percentage of time the device of a gyro held its bus over the
+    // last second, or zero if the HAL doesn't measure it
+    float get_bus_utilisation(uint8_t i) const { return _bus_utilisation[i]; }
     uint32_t get_accel_error_count(uint8_t i) const { return _accel_error_count[i]; }
 
     // multi-device interface
@@ -147,6 +163,17 @@ public:
     uint16_t get_gyro_rate_hz(uint8_t instance) const { return uint16_t(_gyro_raw_sample_rates[instance] * _gyro_over_sampling[instance]); }
     uint16_t get_accel_rate_hz(uint8_t instance) const { return uint16_t(_accel_raw_sample_rates[instance] * _accel_over_sampling[instance]); }
 
+    // get the rate at which the backend filters samples of a gyro
+    float get_raw_gyro_rate_hz(uint8_t instance) const { return _gyro_raw_sample_rates[instance]; }
+
+    // queue every rate_decimation'th filtered sample of the primary
+    // gyro for a rate control thread. Returns false if out of memory
+    bool enable_fast_rate_buffer(uint8_t rate_decimation);
+
+    // get the oldest queued gyro sample and the time it was taken.
+    // Returns false if there is none
+    bool get_next_gyro_sample(Vector3f &gyro, uint64_t &sample_us);
+
     // get accel offsets in m/s/s
     const Vector3f &get_accel_offsets(uint8_t i) const { return _accel_offset[i]; }
     const Vector3f &get_accel_offsets(void) const { return get_accel_offsets(_primary_accel); }
@@ -208,6 +235,14 @@ public:
     // get the gyro filter rate in Hz
     uint8_t get_gyro_filter_hz(void) const { return _gyro_filter_cutoff; }
 
+    // harmonic notch parameters, for the vehicle to find the
+    // center frequency from
+    const HarmonicNotchFilterParams &get_gyro_harmonic_notch_params(void) const { return _harmonic_notch_filter; }
+
+    // set the harmonic notch center frequency, applied to all gyros
+    // on their next update
+    void update_harmonic_notch_freq_hz(float freq_hz);
+
     // get the accel filter rate in Hz
     uint8_t get_accel_filter_hz(void) const { return _accel_filter_cutoff; }
 
@@ -320,6 +355,7 @@ public:
 
         enum batch_opt_t {
             BATCH_OPT_SENSOR_RATE = (1<<0),
+            BATCH_OPT_COMPRESSED = (1<<1),
         };
 
         void rotate_to_next_sensor();
@@ -401,8 +437,49 @@ private:
     bool _new_accel_data[INS_MAX_INSTANCES];
     bool _new_gyro_data[INS_MAX_INSTANCES];
 
-    // optional notch filter on gyro
-    NotchFilterVector3fParam _notch_filter;
+    // optional notch filter on all gyros, at sensor rate
+    NotchFilterParams _notch_filter;
+    NotchFilterVector3f _gyro_notch_filter[INS_MAX_INSTANCES];
+
+    // optional harmonic notch filter bank on all gyros, at sensor rate
+    HarmonicNotchFilterParams _harmonic_notch_filter;
+    HarmonicNotchFilterVector3f _gyro_harmonic_notch_filter[INS_MAX_INSTANCES];
+    float _calculated_harmonic_notch_freq_hz;
+
+#if HAL_GYROFFT_ENABLED
+    // spectrum analysis of the first gyro
+    AP_Int8 _fft_enable;
+    AP_GyroFFT _gyro_fft;
+#endif
+
+    // sample times of the filtered and published gyro readings
+    uint64_t _gyro_filtered_sample_us[INS_MAX_INSTANCES];
+    uint64_t _gyro_sample_us[INS_MAX_INSTANCES];
+
+    void log_bus_utilisation();
+    uint32_t _bus_log_ms;
+
+    // log2 histogram of gyro sample to motor output latency. Bucket 0
+    // holds latencies below 128us, bucket N holds [2^(N+6), 2^(N+7))
+    // and the last bucket holds everything longer
+    void log_output_latency();
+    HAL_Semaphore _latency_sem;
+    struct {
+        uint16_t histogram[8];
+        uint32_t count;
+        uint32_t sum_us;
+        uint32_t max_us;
+        uint32_t last_log_ms;
+    } _output_latency;
+
+    // queue of filtered primary gyro samples for a rate control thread
+    struct fast_gyro_sample {
+        Vector3f gyro;
+        uint64_t sample_us;
+    };
+    ObjectBuffer<fast_gyro_sample> *_fast_rate_buffer;
+    uint8_t _fast_rate_decimation;
+    uint8_t _fast_rate_count;
 
     // Most recent gyro reading
     Vector3f _gyro[INS_MAX_INSTANCES];
@@ -527,6 +604,11 @@ private:
     uint32_t _accel_error_count[INS_MAX_INSTANCES];
     uint32_t _gyro_error_count[INS_MAX_INSTANCES];
 
+    // bus utilisation of the gyro devices, updated once a second
+    uint32_t _bus_check_us[INS_MAX_INSTANCES];
+    uint32_t _bus_busy_us[INS_MAX_INSTANCES];
+    float _bus_utilisation[INS_MAX_INSTANCES];
+
     // vibration and clipping
     uint32_t _accel_clip_count[INS_MAX_INSTANCES];
     LowPassFilterVector3f _accel_vibe_floor_filter[INS_VIBRATION_CHECK_INSTANCES];
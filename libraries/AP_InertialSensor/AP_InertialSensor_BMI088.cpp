@@ -57,6 +57,9 @@
 #define REGG_FIFO_CONFIG_1 0x3E
 #define REGG_FIFO_DATA     0x3F
 
+// most gyro FIFO frames read at a time
+#define BMI088_GYRO_FIFO_FRAMES 8
+
 extern const AP_HAL::HAL& hal;
 
 AP_InertialSensor_BMI088::AP_InertialSensor_BMI088(AP_InertialSensor &imu,
@@ -102,6 +105,11 @@ void AP_InertialSensor_BMI088::start()
     set_gyro_orientation(gyro_instance, rotation);
     set_accel_orientation(accel_instance, rotation);
     
+    gyro_fifo = (uint8_t *)hal.util->malloc_type(2 * BMI088_GYRO_FIFO_FRAMES * 6, AP_HAL::Util::MEM_DMA_SAFE);
+    if (gyro_fifo == nullptr) {
+        AP_HAL::panic("BMI088: Unable to allocate FIFO buffer");
+    }
+
     // setup callbacks
     dev_accel->register_periodic_callback(1000000UL / 1600,
                                           FUNCTOR_BIND_MEMBER(&AP_InertialSensor_BMI088::read_fifo_accel, void));
@@ -363,6 +371,8 @@ void AP_InertialSensor_BMI088::read_fifo_accel(void)
  */
 void AP_InertialSensor_BMI088::read_fifo_gyro(void)
 {
+    _update_bus_utilisation(gyro_instance, *dev_gyro);
+
     uint8_t num_frames;
     if (!dev_gyro->read_registers(REGG_FIFO_STATUS, &num_frames, 1)) {
         _inc_gyro_error_count(gyro_instance);
@@ -371,18 +381,47 @@ void AP_InertialSensor_BMI088::read_fifo_gyro(void)
     num_frames &= 0x7F;
     
     // don't read more than 8 frames at a time
-    if (num_frames > 8) {
-        num_frames = 8;
+    if (num_frames > BMI088_GYRO_FIFO_FRAMES) {
+        num_frames = BMI088_GYRO_FIFO_FRAMES;
     }
     if (num_frames == 0) {
         return;
     }
-    uint8_t data[6*num_frames];
-    if (!dev_gyro->read_registers(REGG_FIFO_DATA, data, num_frames*6)) {
+
+    /*
+      read the frames in two halves, processing the first while the
+      second is read
+     */
+    const uint8_t first = (num_frames+1)/2;
+    uint8_t *data = gyro_fifo;
+    uint8_t *data2 = gyro_fifo + BMI088_GYRO_FIFO_FRAMES * 6;
+    if (!dev_gyro->read_registers_start(REGG_FIFO_DATA, data, first*6) ||
+        !dev_gyro->transfer_finish()) {
         _inc_gyro_error_count(gyro_instance);
         return;
     }
+    if (first < num_frames) {
+        if (!dev_gyro->read_registers_start(REGG_FIFO_DATA, data2, (num_frames-first)*6)) {
+            _inc_gyro_error_count(gyro_instance);
+            return;
+        }
+        process_gyro_frames(data, first);
+        if (!dev_gyro->transfer_finish()) {
+            _inc_gyro_error_count(gyro_instance);
+            return;
+        }
+        process_gyro_frames(data2, num_frames-first);
+    } else {
+        process_gyro_frames(data, first);
+    }
+
+    if (!dev_gyro->check_next_register()) {
+        _inc_gyro_error_count(gyro_instance);
+    }
+}
 
+void AP_InertialSensor_BMI088::process_gyro_frames(const uint8_t *data, uint8_t num_frames)
+{
     // data is 16 bits with 2000dps range
     const float scale = radians(2000.0f) / 32767.0f;
     for (uint8_t i = 0; i < num_frames; i++) {
@@ -397,10 +436,6 @@ void AP_InertialSensor_BMI088::read_fifo_gyro(void)
         _rotate_and_correct_gyro(gyro_instance, gyro);
         _notify_new_gyro_raw_sample(gyro_instance, gyro);
     }
-
-    if (!dev_gyro->check_next_register()) {
-        _inc_gyro_error_count(gyro_instance);
-    }
 }
 
 bool AP_InertialSensor_BMI088::update()
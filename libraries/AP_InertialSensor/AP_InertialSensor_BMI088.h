@@ -58,6 +58,7 @@ private:
      */
     void read_fifo_accel();
     void read_fifo_gyro();
+    void process_gyro_frames(const uint8_t *data, uint8_t num_frames);
 
     /*
       read from accelerometer registers, special SPI handling needed
@@ -77,6 +78,10 @@ private:
     AP_HAL::OwnPtr<AP_HAL::Device> dev_accel;
     AP_HAL::OwnPtr<AP_HAL::Device> dev_gyro;
 
+    // two DMA safe buffers of gyro FIFO frames, one being read while
+    // the other is processed
+    uint8_t *gyro_fifo;
+
     uint8_t accel_instance;
     uint8_t gyro_instance;
     enum Rotation rotation;
@@ -174,6 +174,12 @@ void AP_InertialSensor_Backend::_notify_new_gyro_raw_sample(uint8_t instance,
     AP_Module::call_hook_gyro_sample(instance, dt, gyro);
 #endif
 
+#if HAL_GYROFFT_ENABLED
+    if (instance == 0) {
+        _imu._gyro_fft.sample(gyro);
+    }
+#endif
+
     // push gyros if optical flow present
     if (hal.opticalflow)
         hal.opticalflow->push_gyro(gyro.x, gyro.y, dt);
@@ -204,11 +210,36 @@ void AP_InertialSensor_Backend::_notify_new_gyro_raw_sample(uint8_t instance,
         _imu._last_delta_angle[instance] = delta_angle;
         _imu._last_raw_gyro[instance] = gyro;
 
-        _imu._gyro_filtered[instance] = _imu._gyro_filter[instance].apply(gyro);
+        Vector3f gyro_filtered = gyro;
+
+        // apply the notches before the low pass filter
+        if (_gyro_notch_enabled()) {
+            gyro_filtered = _imu._gyro_notch_filter[instance].apply(gyro_filtered);
+        }
+        if (_gyro_harmonic_notch_enabled()) {
+            gyro_filtered = _imu._gyro_harmonic_notch_filter[instance].apply(gyro_filtered);
+        }
+
+        _imu._gyro_filtered[instance] = _imu._gyro_filter[instance].apply(gyro_filtered);
         if (_imu._gyro_filtered[instance].is_nan() || _imu._gyro_filtered[instance].is_inf()) {
             _imu._gyro_filter[instance].reset();
+            _imu._gyro_notch_filter[instance].reset();
+            _imu._gyro_harmonic_notch_filter[instance].reset();
         }
         _imu._new_gyro_data[instance] = true;
+
+        // FIFO sensors don't give a sample time, so take the time the
+        // sample was read
+        _imu._gyro_filtered_sample_us[instance] = sample_us != 0 ? sample_us : AP_HAL::micros64();
+
+        if (_imu._fast_rate_buffer != nullptr && instance == _imu._primary_gyro &&
+            ++_imu._fast_rate_count >= _imu._fast_rate_decimation) {
+            _imu._fast_rate_count = 0;
+            const AP_InertialSensor::fast_gyro_sample sample {
+                _imu._gyro_filtered[instance], _imu._gyro_filtered_sample_us[instance]
+            };
+            _imu._fast_rate_buffer->push(sample);
+        }
     }
 
     log_gyro_raw(instance, sample_us, gyro);
@@ -401,6 +432,21 @@ void AP_InertialSensor_Backend::_inc_gyro_error_count(uint8_t instance)
     _imu._gyro_error_count[instance]++;
 }
 
+void AP_InertialSensor_Backend::_update_bus_utilisation(uint8_t instance, const AP_HAL::Device &dev)
+{
+    const uint32_t now_us = AP_HAL::micros();
+    const uint32_t busy_us = dev.get_bus_busy_us();
+    const uint32_t dt_us = now_us - _imu._bus_check_us[instance];
+    if (dt_us < 1000000) {
+        return;
+    }
+    if (_imu._bus_check_us[instance] != 0) {
+        _imu._bus_utilisation[instance] = (busy_us - _imu._bus_busy_us[instance]) * 100.0f / dt_us;
+    }
+    _imu._bus_check_us[instance] = now_us;
+    _imu._bus_busy_us[instance] = busy_us;
+}
+
 // return the requested sample rate in Hz
 uint16_t AP_InertialSensor_Backend::get_sample_rate_hz(void) const
 {
@@ -430,6 +476,7 @@ void AP_InertialSensor_Backend::update_gyro(uint8_t instance)
 
     if (_imu._new_gyro_data[instance]) {
         _publish_gyro(instance, _imu._gyro_filtered[instance]);
+        _imu._gyro_sample_us[instance] = _imu._gyro_filtered_sample_us[instance];
         _imu._new_gyro_data[instance] = false;
     }
 
@@ -438,6 +485,40 @@ void AP_InertialSensor_Backend::update_gyro(uint8_t instance)
         _imu._gyro_filter[instance].set_cutoff_frequency(_gyro_raw_sample_rate(instance), _gyro_filter_cutoff());
         _last_gyro_filter_hz[instance] = _gyro_filter_cutoff();
     }
+
+    // possibly update the notch parameters, which are only checked
+    // when a parameter may have changed, or the notch isn't set up
+    const NotchFilterParams &notch_params = _imu._notch_filter;
+    const uint16_t change_count = AP_Param::get_change_count();
+    if (_gyro_notch_enabled() && _gyro_raw_sample_rate(instance) > 0 &&
+        (_last_notch_change_count[instance] != change_count || is_zero(_last_notch_center_freq_hz[instance]))) {
+        _last_notch_change_count[instance] = change_count;
+        if (!is_equal(_last_notch_center_freq_hz[instance], notch_params.center_freq_hz()) ||
+            !is_equal(_last_notch_bandwidth_hz[instance], notch_params.bandwidth_hz()) ||
+            !is_equal(_last_notch_attenuation_dB[instance], notch_params.attenuation_dB())) {
+            _imu._gyro_notch_filter[instance].init(_gyro_raw_sample_rate(instance), notch_params.center_freq_hz(),
+                                                   notch_params.bandwidth_hz(), notch_params.attenuation_dB());
+            _last_notch_center_freq_hz[instance] = notch_params.center_freq_hz();
+            _last_notch_bandwidth_hz[instance] = notch_params.bandwidth_hz();
+            _last_notch_attenuation_dB[instance] = notch_params.attenuation_dB();
+        }
+    }
+
+    // possibly move the harmonic notch
+    const float notch_freq_hz = _gyro_harmonic_notch_center_freq_hz();
+    if (_gyro_harmonic_notch_enabled() && _gyro_raw_sample_rate(instance) > 0 &&
+        !is_equal(_last_harmonic_notch_center_freq_hz[instance], notch_freq_hz)) {
+        HarmonicNotchFilterVector3f &notch = _imu._gyro_harmonic_notch_filter[instance];
+        if (is_zero(_last_harmonic_notch_center_freq_hz[instance])) {
+            // the notch shape is set by the parameters at the base frequency
+            const HarmonicNotchFilterParams &params = _imu._harmonic_notch_filter;
+            notch.allocate_filters(params.harmonics());
+            notch.init(_gyro_raw_sample_rate(instance), params.center_freq_hz(),
+                       params.bandwidth_hz(), params.attenuation_dB());
+        }
+        notch.update(notch_freq_hz);
+        _last_harmonic_notch_center_freq_hz[instance] = notch_freq_hz;
+    }
 }
 
 /*
@@ -219,6 +219,10 @@ protected:
 
     // increment gyro error_count
     void _inc_gyro_error_count(uint8_t instance);
+
+    // update the share of time the device of a gyro holds its bus,
+    // called after each read of the device
+    void _update_bus_utilisation(uint8_t instance, const AP_HAL::Device &dev);
     
     // backend unique identifier or -1 if backend doesn't identify itself
     int16_t _id = -1;
@@ -229,6 +233,15 @@ protected:
     // return the default filter frequency in Hz for the sample rate
     uint8_t _gyro_filter_cutoff(void) const { return _imu._gyro_filter_cutoff; }
 
+    // true if the notch is enabled
+    bool _gyro_notch_enabled(void) const { return _imu._notch_filter.enabled(); }
+
+    // true if the harmonic notch is enabled
+    bool _gyro_harmonic_notch_enabled(void) const { return _imu._harmonic_notch_filter.enabled(); }
+
+    // return the harmonic notch center frequency in Hz
+    float _gyro_harmonic_notch_center_freq_hz(void) const { return _imu._calculated_harmonic_notch_freq_hz; }
+
     // return the requested sample rate in Hz
     uint16_t get_sample_rate_hz(void) const;
 
@@ -241,6 +254,11 @@ protected:
     // support for updating filter at runtime
     int8_t _last_accel_filter_hz[INS_MAX_INSTANCES];
     int8_t _last_gyro_filter_hz[INS_MAX_INSTANCES];
+    float _last_notch_center_freq_hz[INS_MAX_INSTANCES];
+    float _last_notch_bandwidth_hz[INS_MAX_INSTANCES];
+    float _last_notch_attenuation_dB[INS_MAX_INSTANCES];
+    uint16_t _last_notch_change_count[INS_MAX_INSTANCES];
+    float _last_harmonic_notch_center_freq_hz[INS_MAX_INSTANCES];
 
     void set_gyro_orientation(uint8_t instance, enum Rotation rotation) {
         _imu._gyro_orientation[instance] = rotation;
@@ -70,7 +70,7 @@ AP_InertialSensor_Invensensev2::AP_InertialSensor_Invensensev2(AP_InertialSensor
 AP_InertialSensor_Invensensev2::~AP_InertialSensor_Invensensev2()
 {
     if (_fifo_buffer != nullptr) {
-        hal.util->free_type(_fifo_buffer, INV2_FIFO_BUFFER_LEN * INV2_SAMPLE_SIZE, AP_HAL::Util::MEM_DMA_SAFE);
+        hal.util->free_type(_fifo_buffer, 2 * INV2_FIFO_BUFFER_LEN * INV2_SAMPLE_SIZE, AP_HAL::Util::MEM_DMA_SAFE);
     }
     //delete _auxiliary_bus;
 }
@@ -231,12 +231,12 @@ void AP_InertialSensor_Invensensev2::start()
     set_gyro_orientation(_gyro_instance, _rotation);
     set_accel_orientation(_accel_instance, _rotation);
 
-    // setup scale factors for fifo data after downsampling
-    _fifo_accel_scale = _accel_scale / (MAX(_fifo_downsample_rate,2)/2);
-    _fifo_gyro_scale = GYRO_SCALE / _fifo_downsample_rate;
+    // setup decimation of fifo data, the accel being at half the rate
+    _accum.accel_cic.set_ratio(MAX(_fifo_downsample_rate,2)/2);
+    _accum.gyro_cic.set_ratio(_fifo_downsample_rate);
     
     // allocate fifo buffer
-    _fifo_buffer = (uint8_t *)hal.util->malloc_type(INV2_FIFO_BUFFER_LEN * INV2_SAMPLE_SIZE, AP_HAL::Util::MEM_DMA_SAFE);
+    _fifo_buffer = (uint8_t *)hal.util->malloc_type(2 * INV2_FIFO_BUFFER_LEN * INV2_SAMPLE_SIZE, AP_HAL::Util::MEM_DMA_SAFE);
     if (_fifo_buffer == nullptr) {
         AP_HAL::panic("Invensense: Unable to allocate FIFO buffer");
     }
@@ -346,10 +346,10 @@ bool AP_InertialSensor_Invensensev2::_accumulate(uint8_t *samples, uint8_t n_sam
 /*
   when doing fast sampling the sensor gives us 9k samples/second. Every 2nd accel sample is a duplicate.
 
-  To filter this we first apply a 1p low pass filter at 188Hz, then we
-  average over 8 samples to bring the data rate down to 1kHz. This
-  gives very good aliasing rejection at frequencies well above what
-  can be handled with 1kHz sample rates.
+  To bring the data rate down to the backend rate we decimate with a
+  third order CIC filter. This gives very good aliasing rejection at
+  frequencies well above what can be handled at the backend rate, with
+  less delay than the low pass filter and average used before.
  */
 bool AP_InertialSensor_Invensensev2::_accumulate_sensor_rate_sampling(uint8_t *samples, uint8_t n_samples)
 {
@@ -372,40 +372,39 @@ bool AP_InertialSensor_Invensensev2::_accumulate_sensor_rate_sampling(uint8_t *s
         tsum += t2;
         // accel data is at 4kHz
         if ((_accum.count & 1) == 0) {
-            Vector3f a(int16_val(data, 1),
-                    int16_val(data, 0),
-                    -int16_val(data, 2));
+            const int32_t ax = int16_val(data, 1);
+            const int32_t ay = int16_val(data, 0);
+            const int32_t az = -int16_val(data, 2);
+            Vector3f a(ax, ay, az);
             if (fabsf(a.x) > unscaled_clip_limit ||
                 fabsf(a.y) > unscaled_clip_limit ||
                 fabsf(a.z) > unscaled_clip_limit) {
                 clipped = true;
             }
-            _accum.accel += _accum.accel_filter.apply(a);
+            _accum.accel_cic.apply(ax, ay, az, _accum.accel);
             Vector3f a2 = a * _accel_scale;
             _notify_new_accel_sensor_rate_sample(_accel_instance, a2);
         }
 
-        Vector3f g(int16_val(data, 4),
-                   int16_val(data, 3),
-                   -int16_val(data, 5));
+        const int32_t gx = int16_val(data, 4);
+        const int32_t gy = int16_val(data, 3);
+        const int32_t gz = -int16_val(data, 5);
+        Vector3f g(gx, gy, gz);
 
         Vector3f g2 = g * GYRO_SCALE;
         _notify_new_gyro_sensor_rate_sample(_gyro_instance, g2);
 
-        _accum.gyro += _accum.gyro_filter.apply(g);
+        _accum.gyro_cic.apply(gx, gy, gz, _accum.gyro);
         _accum.count++;
 
         if (_accum.count == _fifo_downsample_rate) {
-            _accum.accel *= _fifo_accel_scale;
-            _accum.gyro *= _fifo_gyro_scale;
+            _accum.accel *= _accel_scale;
+            _accum.gyro *= GYRO_SCALE;
             _rotate_and_correct_accel(_accel_instance, _accum.accel);
             _rotate_and_correct_gyro(_gyro_instance, _accum.gyro);
             
             _notify_new_accel_raw_sample(_accel_instance, _accum.accel, 0, false);
             _notify_new_gyro_raw_sample(_gyro_instance, _accum.gyro);
-            
-            _accum.accel.zero();
-            _accum.gyro.zero();
             _accum.count = 0;
         }
     }
@@ -422,6 +421,42 @@ bool AP_InertialSensor_Invensensev2::_accumulate_sensor_rate_sampling(uint8_t *s
     return ret;
 }
 
+/*
+  start a read of n samples from the FIFO into buf, completed by
+  _dev->transfer_finish()
+ */
+bool AP_InertialSensor_Invensensev2::_fifo_read_start(uint8_t *buf, uint8_t n)
+{
+    _select_bank(GET_BANK(INV2REG_FIFO_R_W));
+    return _dev->read_registers_start(GET_REG(INV2REG_FIFO_R_W), buf, n * INV2_SAMPLE_SIZE);
+}
+
+/*
+  true if checking the temperature of the samples won't need the bus
+ */
+bool AP_InertialSensor_Invensensev2::_raw_temps_cached(const uint8_t *samples, uint8_t n_samples) const
+{
+    for (uint8_t i = 0; i < n_samples; i++) {
+        const int16_t t2 = int16_val(samples + INV2_SAMPLE_SIZE * i, 3);
+        if (abs(t2 - _raw_temp) >= 400) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AP_InertialSensor_Invensensev2::_accumulate_fifo(uint8_t *samples, uint8_t n_samples)
+{
+    if (_fast_sampling) {
+        if (!_accumulate_sensor_rate_sampling(samples, n_samples)) {
+            debug("IMU[%u] stop in fifo read", _accel_instance);
+            return false;
+        }
+        return true;
+    }
+    return _accumulate(samples, n_samples);
+}
+
 void AP_InertialSensor_Invensensev2::_read_fifo()
 {
     uint8_t n_samples;
@@ -429,6 +464,8 @@ void AP_InertialSensor_Invensensev2::_read_fifo()
     uint8_t *rx = _fifo_buffer;
     bool need_reset = false;
 
+    _update_bus_utilisation(_gyro_instance, *_dev);
+
     if (!_block_read(INV2REG_FIFO_COUNTH, rx, 2)) {
         goto check_registers;
     }
@@ -462,40 +499,51 @@ void AP_InertialSensor_Invensensev2::_read_fifo()
             n_samples = 24;
         }
     }
-    while (n_samples > 0) {
-        uint8_t n = MIN(n_samples, INV2_FIFO_BUFFER_LEN);
-        if (!_dev->set_chip_select(true)) {
-            if (!_block_read(INV2REG_FIFO_R_W, rx, n * INV2_SAMPLE_SIZE)) {
-                goto check_registers;
-            }
-        } else {
-            // this ensures we keep things nicely setup for DMA
-            _select_bank(GET_BANK(INV2REG_FIFO_R_W));
-            uint8_t reg = GET_REG(INV2REG_FIFO_R_W) | 0x80;
-            if (!_dev->transfer(&reg, 1, nullptr, 0)) {
-                _dev->set_chip_select(false);
-                goto check_registers;
-            }
-            memset(rx, 0, n * INV2_SAMPLE_SIZE);
-            if (!_dev->transfer(rx, n * INV2_SAMPLE_SIZE, rx, n * INV2_SAMPLE_SIZE)) {
+    /*
+      read the FIFO in chunks into alternate halves of _fifo_buffer,
+      processing each chunk while the next is read. On SPI even a
+      small read is split in two so there is something to overlap
+     */
+    {
+        const uint8_t chunk = MIN(_dev->bus_type() == AP_HAL::Device::BUS_TYPE_SPI ? (n_samples+1)/2 : n_samples,
+                                  INV2_FIFO_BUFFER_LEN);
+        uint8_t *next_rx = _fifo_buffer + INV2_FIFO_BUFFER_LEN * INV2_SAMPLE_SIZE;
+        uint8_t n = MIN(n_samples, chunk);
+        if (!_fifo_read_start(rx, n)) {
+            goto check_registers;
+        }
+        while (n_samples > 0) {
+            if (!_dev->transfer_finish()) {
                 hal.console->printf("INV2: error in fifo read %u bytes\n", n * INV2_SAMPLE_SIZE);
-                _dev->set_chip_select(false);
                 goto check_registers;
             }
-            _dev->set_chip_select(false);
-        }
-
-        if (_fast_sampling) {
-            if (!_accumulate_sensor_rate_sampling(rx, n)) {
-                debug("IMU[%u] stop at %u of %u", _accel_instance, n_samples, bytes_read/INV2_SAMPLE_SIZE);
-                break;
+            const uint8_t n_rx = n;
+            n_samples -= n;
+
+            // checking the temperature of the samples may need the
+            // bus, in which case the next read waits for them
+            const bool overlap = n_samples > 0 && _raw_temps_cached(rx, n_rx);
+            if (overlap) {
+                n = MIN(n_samples, chunk);
+                if (!_fifo_read_start(next_rx, n)) {
+                    goto check_registers;
+                }
             }
-        } else {
-            if (!_accumulate(rx, n)) {
+            if (!_accumulate_fifo(rx, n_rx)) {
+                // the FIFO has been reset. This can't happen with a
+                // read in progress as the temperatures were cached
                 break;
             }
+            if (n_samples > 0 && !overlap) {
+                n = MIN(n_samples, chunk);
+                if (!_fifo_read_start(next_rx, n)) {
+                    goto check_registers;
+                }
+            }
+            uint8_t *tmp = rx;
+            rx = next_rx;
+            next_rx = tmp;
         }
-        n_samples -= n;
     }
 
     if (need_reset) {
@@ -10,6 +10,7 @@
 #include <AP_HAL/SPIDevice.h>
 #include <AP_HAL/utility/OwnPtr.h>
 #include <AP_Math/AP_Math.h>
+#include <Filter/CICDecimator.h>
 #include <Filter/Filter.h>
 #include <Filter/LowPassFilter.h>
 #include <Filter/LowPassFilter2p.h>
@@ -95,6 +96,9 @@ private:
 
     bool _accumulate(uint8_t *samples, uint8_t n_samples);
     bool _accumulate_sensor_rate_sampling(uint8_t *samples, uint8_t n_samples);
+    bool _accumulate_fifo(uint8_t *samples, uint8_t n_samples);
+    bool _fifo_read_start(uint8_t *buf, uint8_t n);
+    bool _raw_temps_cached(const uint8_t *samples, uint8_t n_samples) const;
 
     bool _check_raw_temp(int16_t t2);
 
@@ -109,8 +113,6 @@ private:
     
     float _temp_filtered;
     float _accel_scale;
-    float _fifo_accel_scale;
-    float _fifo_gyro_scale;
     LowPassFilter2pFloat _temp_filter;
 
     enum Rotation _rotation;
@@ -146,8 +148,8 @@ private:
         Vector3f accel;
         Vector3f gyro;
         uint8_t count;
-        LowPassFilterVector3f accel_filter{4500, 188};
-        LowPassFilterVector3f gyro_filter{9000, 188};
+        CICDecimator accel_cic;
+        CICDecimator gyro_cic;
     } _accum;
 };
 
@@ -48,6 +48,8 @@ bool AP_InertialSensor_SITL::init_sensor(void)
         if (enable_fast_sampling(gyro_instance[i])) {
             _set_gyro_raw_sample_rate(gyro_instance[i], gyro_sample_hz[i]*8);
         }
+        accel_noise_source[i].init(0x1000 + i);
+        gyro_noise_source[i].init(0x2000 + i);
     }
 
     hal.scheduler->register_timer_process(FUNCTOR_BIND_MEMBER(&AP_InertialSensor_SITL::timer_update, void));
@@ -56,9 +58,10 @@ bool AP_InertialSensor_SITL::init_sensor(void)
 }
 
 /*
-  generate an accelerometer sample
+  generate an accelerometer sample from the body frame acceleration
+  and rates, in radians/s, of the simulation
  */
-void AP_InertialSensor_SITL::generate_accel(uint8_t instance)
+void AP_InertialSensor_SITL::generate_accel(uint8_t instance, const Vector3f &accel_body, const Vector3f &gyro_rad)
 {
     // minimum noise levels are 2 bits, but averaged over many
     // samples, giving around 0.01 m/s/s
@@ -71,14 +74,15 @@ void AP_InertialSensor_SITL::generate_accel(uint8_t instance)
 
     // add accel bias and noise
     Vector3f accel_bias = instance==0?sitl->accel_bias.get():sitl->accel2_bias.get();
-    float xAccel = sitl->state.xAccel + accel_bias.x;
-    float yAccel = sitl->state.yAccel + accel_bias.y;
-    float zAccel = sitl->state.zAccel + accel_bias.z;
+    float xAccel = accel_body.x + accel_bias.x;
+    float yAccel = accel_body.y + accel_bias.y;
+    float zAccel = accel_body.z + accel_bias.z;
     const Vector3f &vibe_freq = sitl->vibe_freq;
     if (vibe_freq.is_zero()) {
-        xAccel += accel_noise * rand_float();
-        yAccel += accel_noise * rand_float();
-        zAccel += accel_noise * rand_float();
+        SITL::Noise &noise = accel_noise_source[instance];
+        xAccel += accel_noise * noise.next();
+        yAccel += accel_noise * noise.next();
+        zAccel += accel_noise * noise.next();
     } else {
         float t = AP_HAL::micros() * 1.0e-6f;
         xAccel += sinf(t * 2 * M_PI * vibe_freq.x) * accel_noise;
@@ -97,8 +101,7 @@ void AP_InertialSensor_SITL::generate_accel(uint8_t instance)
         Vector3f lever_arm_accel = angular_accel % pos_offset;
 
         // calculate sensed acceleration due to centripetal acceleration
-        Vector3f angular_rate = Vector3f(radians(sitl->state.rollRate), radians(sitl->state.pitchRate), radians(sitl->state.yawRate));
-        Vector3f centripetal_accel = angular_rate % (angular_rate % pos_offset);
+        Vector3f centripetal_accel = gyro_rad % (gyro_rad % pos_offset);
 
         // apply corrections
         xAccel += lever_arm_accel.x + centripetal_accel.x;
@@ -123,9 +126,10 @@ void AP_InertialSensor_SITL::generate_accel(uint8_t instance)
 }
 
 /*
-  generate a gyro sample
+  generate a gyro sample from the body rates, in radians/s, of the
+  simulation and the drift given by gyro_drift()
  */
-void AP_InertialSensor_SITL::generate_gyro(uint8_t instance)
+void AP_InertialSensor_SITL::generate_gyro(uint8_t instance, const Vector3f &gyro_rad, float drift)
 {
     // minimum gyro noise is less than 1 bit
     float gyro_noise = ToRad(0.04f);
@@ -135,15 +139,16 @@ void AP_InertialSensor_SITL::generate_gyro(uint8_t instance)
         gyro_noise += ToRad(sitl->gyro_noise);
     }
 
-    float p = radians(sitl->state.rollRate) + gyro_drift();
-    float q = radians(sitl->state.pitchRate) + gyro_drift();
-    float r = radians(sitl->state.yawRate) + gyro_drift();
+    float p = gyro_rad.x + drift;
+    float q = gyro_rad.y + drift;
+    float r = gyro_rad.z + drift;
 
     const Vector3f &vibe_freq = sitl->vibe_freq;
     if (vibe_freq.is_zero()) {
-        p += gyro_noise * rand_float();
-        q += gyro_noise * rand_float();
-        r += gyro_noise * rand_float();
+        SITL::Noise &noise = gyro_noise_source[instance];
+        p += gyro_noise * noise.next();
+        q += gyro_noise * noise.next();
+        r += gyro_noise * noise.next();
     } else {
         float t = AP_HAL::micros() * 1.0e-6f;
         p += sinf(t * 2 * M_PI * vibe_freq.x) * gyro_noise;
@@ -177,15 +182,27 @@ void AP_InertialSensor_SITL::timer_update(void)
         return;
     }
 #endif
+
+    // the simulation state is read once for all the instances due
+    const SITL::sitl_fdm &fdm = sitl->state;
+    const Vector3f accel_body(fdm.xAccel, fdm.yAccel, fdm.zAccel);
+    const Vector3f gyro_rad(radians(fdm.rollRate), radians(fdm.pitchRate), radians(fdm.yawRate));
+    bool have_drift = false;
+    float drift = 0;
+
     for (uint8_t i=0; i<INS_SITL_INSTANCES; i++) {
         if (now >= next_accel_sample[i]) {
-            generate_accel(i);
+            generate_accel(i, accel_body, gyro_rad);
             while (now >= next_accel_sample[i]) {
                 next_accel_sample[i] += 1000000UL / accel_sample_hz[i];
             }
         }
         if (now >= next_gyro_sample[i]) {
-            generate_gyro(i);
+            if (!have_drift) {
+                drift = gyro_drift();
+                have_drift = true;
+            }
+            generate_gyro(i, gyro_rad, drift);
             while (now >= next_gyro_sample[i]) {
                 next_gyro_sample[i] += 1000000UL / gyro_sample_hz[i];
             }
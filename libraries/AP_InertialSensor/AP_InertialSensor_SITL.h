@@ -1,6 +1,7 @@
 #pragma once
 
 #include <SITL/SITL.h>
+#include <SITL/SITL_Noise.h>
 
 #include "AP_InertialSensor.h"
 #include "AP_InertialSensor_Backend.h"
@@ -22,8 +23,8 @@ private:
     bool init_sensor(void);
     void timer_update();
     float gyro_drift(void);
-    void generate_accel(uint8_t instance);
-    void generate_gyro(uint8_t instance);
+    void generate_accel(uint8_t instance, const Vector3f &accel_body, const Vector3f &gyro_rad);
+    void generate_gyro(uint8_t instance, const Vector3f &gyro_rad, float drift);
 
     SITL::SITL *sitl;
 
@@ -35,4 +36,7 @@ private:
     uint8_t accel_instance[INS_SITL_INSTANCES];
     uint64_t next_gyro_sample[INS_SITL_INSTANCES];
     uint64_t next_accel_sample[INS_SITL_INSTANCES];
+
+    SITL::Noise accel_noise_source[INS_SITL_INSTANCES];
+    SITL::Noise gyro_noise_source[INS_SITL_INSTANCES];
 };
@@ -22,7 +22,7 @@ const AP_Param::GroupInfo AP_InertialSensor::BatchSampler::var_info[] = {
     // @Param: BAT_OPT
     // @DisplayName: Batch Logging Options Mask
     // @Description: Options for the BatchSampler
-    // @Bitmask: 0:Sensor-Rate Logging (sample at full sensor rate seen by AP)
+    // @Bitmask: 0:Sensor-Rate Logging (sample at full sensor rate seen by AP),1:Delta-compressed logging (ISBC instead of ISBD)
     // @User: Advanced
     AP_GROUPINFO("BAT_OPT",  3, AP_InertialSensor::BatchSampler, _batch_options_mask, 0),
 
@@ -213,15 +213,30 @@ void AP_InertialSensor::BatchSampler::push_data_to_log()
         isbh_sent = true;
     }
     // pack and send a data packet:
-    if (!logger->Write_ISBD(isb_seqnum,
-                                   data_read_offset/samples_per_msg,
-                                   &data_x[data_read_offset],
-                                   &data_y[data_read_offset],
-                                   &data_z[data_read_offset])) {
-        // maybe later?!
-        return;
+    if ((batch_opt_t)(_batch_options_mask.get()) & BATCH_OPT_COMPRESSED) {
+        // as many of the available samples as will pack into one message
+        const uint8_t sent = logger->Write_ISBC(isb_seqnum,
+                                                data_read_offset,
+                                                &data_x[data_read_offset],
+                                                &data_y[data_read_offset],
+                                                &data_z[data_read_offset],
+                                                data_write_offset - data_read_offset);
+        if (sent == 0) {
+            // maybe later?!
+            return;
+        }
+        data_read_offset += sent;
+    } else {
+        if (!logger->Write_ISBD(isb_seqnum,
+                                       data_read_offset/samples_per_msg,
+                                       &data_x[data_read_offset],
+                                       &data_y[data_read_offset],
+                                       &data_z[data_read_offset])) {
+            // maybe later?!
+            return;
+        }
+        data_read_offset += samples_per_msg;
     }
-    data_read_offset += samples_per_msg;
     last_sent_ms = AP_HAL::millis();
     if (data_read_offset >= _required_count) {
         // that was the last one.  Clean up:
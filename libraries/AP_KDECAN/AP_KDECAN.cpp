@@ -35,6 +35,7 @@
 #include <AP_Math/AP_Math.h>
 #include <AP_Motors/AP_Motors.h>
 #include <AP_Logger/AP_Logger.h>
+#include <AP_ESC_Telem/AP_ESC_Telem.h>
 
 #include "AP_KDECAN.h"
 
@@ -103,6 +104,21 @@ void AP_KDECAN::init(uint8_t driver_index, bool enable_filters)
         return;
     }
 
+    // only accept extended frames addressed to us in hardware, so
+    // other traffic on the bus doesn't fill the receive queue
+    if (enable_filters) {
+        frame_id_t filter_id { .value = 0 };
+        filter_id.destination_id = AUTOPILOT_NODE_ID;
+        frame_id_t filter_mask { .value = 0 };
+        filter_mask.destination_id = 0xFF;
+        uavcan::CanFilterConfig filter;
+        filter.id = filter_id.value | uavcan::CanFrame::FlagEFF;
+        filter.mask = filter_mask.value | uavcan::CanFrame::FlagEFF | uavcan::CanFrame::FlagRTR;
+        if (_can_driver->getIface(CAN_IFACE_INDEX)->configureFilters(&filter, 1) < 0) {
+            debug_can(1, "KDECAN: couldn't configure filters\n\r");
+        }
+    }
+
     // find available KDE ESCs
     frame_id_t id = { { .object_address = ESC_INFO_OBJ_ADDR,
                       .destination_id = BROADCAST_NODE_ID,
@@ -464,6 +480,17 @@ void AP_KDECAN::loop()
                             _telemetry[id.source_id - ESC_NODE_ID_FIRST].temp = frame.data[6];
                             _telemetry[id.source_id - ESC_NODE_ID_FIRST].new_data = true;
                             _telem_sem.give();
+
+                            const uint8_t num_poles = _num_poles > 0 ? _num_poles : DEFAULT_NUM_POLES;
+                            AP_ESC_Telem::TelemetryData td {};
+                            td.voltage = (frame.data[0] << 8 | frame.data[1]) * 0.01f;
+                            td.current = (frame.data[2] << 8 | frame.data[3]) * 0.01f;
+                            td.rpm = (frame.data[4] << 8 | frame.data[5]) * 60.0f * 2 / num_poles;
+                            td.temperature = frame.data[6];
+                            AP::esc_telem().update_telem_data(id.source_id - ESC_NODE_ID_FIRST, td,
+                                                              AP_ESC_Telem::TELEM_RPM | AP_ESC_Telem::TELEM_VOLTAGE |
+                                                              AP_ESC_Telem::TELEM_CURRENT | AP_ESC_Telem::TELEM_TEMPERATURE,
+                                                              AP_ESC_Telem::Source::KDECAN);
                             break;
                         }
                         default:
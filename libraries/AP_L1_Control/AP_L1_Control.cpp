@@ -3,6 +3,16 @@
 
 extern const AP_HAL::HAL& hal;
 
+// bearing in centi-degrees (0 to 36000) of a NE offset, as Location::get_bearing_to()
+static int32_t bearing_cd(const Vector2f &ofs_ne)
+{
+    int32_t bearing = atan2f(ofs_ne.y, ofs_ne.x) * DEGX100;
+    if (bearing < 0) {
+        bearing += 36000;
+    }
+    return bearing;
+}
+
 // table of user settable parameters
 const AP_Param::GroupInfo AP_L1_Control::var_info[] = {
     // @Param: PERIOD
@@ -223,8 +233,13 @@ void AP_L1_Control::update_waypoint(const struct Location &prev_WP, const struct
 
     Vector2f _groundspeed_vector = _ahrs.groundspeed_vector();
 
+    // the waypoints relative to the aircraft, all with the one longitude scale
+    const LocationOrigin aircraft(_current_loc);
+    const Vector2f air_A = aircraft.get_distance_NE(prev_WP);
+    const Vector2f air_B = aircraft.get_distance_NE(next_WP);
+
     // update _target_bearing_cd
-    _target_bearing_cd = _current_loc.get_bearing_to(next_WP);
+    _target_bearing_cd = bearing_cd(air_B);
 
     //Calculate groundspeed
     float groundSpeed = _groundspeed_vector.length();
@@ -241,13 +256,13 @@ void AP_L1_Control::update_waypoint(const struct Location &prev_WP, const struct
     _L1_dist = MAX(0.3183099f * _L1_damping * _L1_period * groundSpeed, dist_min);
 
     // Calculate the NE position of WP B relative to WP A
-    Vector2f AB = prev_WP.get_distance_NE(next_WP);
+    Vector2f AB = air_B - air_A;
     float AB_length = AB.length();
 
     // Check for AB zero length and track directly to the destination
     // if too small
-    if (AB.length() < 1.0e-6f) {
-        AB = _current_loc.get_distance_NE(next_WP);
+    if (AB_length < 1.0e-6f) {
+        AB = air_B;
         if (AB.length() < 1.0e-6f) {
             AB = Vector2f(cosf(get_yaw()), sinf(get_yaw()));
         }
@@ -255,7 +270,7 @@ void AP_L1_Control::update_waypoint(const struct Location &prev_WP, const struct
     AB.normalize();
 
     // Calculate the NE position of the aircraft relative to WP A
-    const Vector2f A_air = prev_WP.get_distance_NE(_current_loc);
+    const Vector2f A_air = -air_A;
 
     // calculate distance to target track, for reporting
     _crosstrack_error = A_air % AB;
@@ -271,28 +286,28 @@ void AP_L1_Control::update_waypoint(const struct Location &prev_WP, const struct
         Vector2f A_air_unit = (A_air).normalized(); // Unit vector from WP A to aircraft
         xtrackVel = _groundspeed_vector % (-A_air_unit); // Velocity across line
         ltrackVel = _groundspeed_vector * (-A_air_unit); // Velocity along line
-        Nu = atan2f(xtrackVel,ltrackVel);
+        Nu = approx_atan2f(xtrackVel,ltrackVel);
         _nav_bearing = atan2f(-A_air_unit.y , -A_air_unit.x); // bearing (radians) from AC to L1 point
     } else if (alongTrackDist > AB_length + groundSpeed*3) {
         // we have passed point B by 3 seconds. Head towards B
         // Calc Nu to fly To WP B
-        const Vector2f B_air = next_WP.get_distance_NE(_current_loc);
+        const Vector2f B_air = -air_B;
         Vector2f B_air_unit = (B_air).normalized(); // Unit vector from WP B to aircraft
         xtrackVel = _groundspeed_vector % (-B_air_unit); // Velocity across line
         ltrackVel = _groundspeed_vector * (-B_air_unit); // Velocity along line
-        Nu = atan2f(xtrackVel,ltrackVel);
+        Nu = approx_atan2f(xtrackVel,ltrackVel);
         _nav_bearing = atan2f(-B_air_unit.y , -B_air_unit.x); // bearing (radians) from AC to L1 point
     } else { //Calc Nu to fly along AB line
 
         //Calculate Nu2 angle (angle of velocity vector relative to line connecting waypoints)
         xtrackVel = _groundspeed_vector % AB; // Velocity cross track
         ltrackVel = _groundspeed_vector * AB; // Velocity along track
-        float Nu2 = atan2f(xtrackVel,ltrackVel);
+        float Nu2 = approx_atan2f(xtrackVel,ltrackVel);
         //Calculate Nu1 angle (Angle to L1 reference point)
         float sine_Nu1 = _crosstrack_error/MAX(_L1_dist, 0.1f);
         //Limit sine of Nu1 to provide a controlled track capture angle of 45 deg
         sine_Nu1 = constrain_float(sine_Nu1, -0.7071f, 0.7071f);
-        float Nu1 = asinf(sine_Nu1);
+        float Nu1 = approx_asinf(sine_Nu1);
 
         // compute integral error component to converge to a crosstrack of zero when traveling
         // straight but reset it when disabled or if it changes. That allows for much easier
@@ -319,7 +334,7 @@ void AP_L1_Control::update_waypoint(const struct Location &prev_WP, const struct
 
     //Limit Nu to +-(pi/2)
     Nu = constrain_float(Nu, -1.5708f, +1.5708f);
-    _latAccDem = K_L1 * groundSpeed * groundSpeed / _L1_dist * sinf(Nu);
+    _latAccDem = K_L1 * groundSpeed * groundSpeed / _L1_dist * approx_sinf(Nu);
 
     // Waypoint capture status is always false during waypoint following
     _WPcircle = false;
@@ -359,8 +374,11 @@ void AP_L1_Control::update_loiter(const struct Location &center_WP, float radius
     float groundSpeed = MAX(_groundspeed_vector.length() , 1.0f);
 
 
+    // the centre relative to the aircraft
+    const Vector2f air_center = LocationOrigin(_current_loc).get_distance_NE(center_WP);
+
     // update _target_bearing_cd
-    _target_bearing_cd = _current_loc.get_bearing_to(center_WP);
+    _target_bearing_cd = bearing_cd(air_center);
 
 
     // Calculate time varying control parameters
@@ -369,7 +387,7 @@ void AP_L1_Control::update_loiter(const struct Location &center_WP, float radius
     _L1_dist = 0.3183099f * _L1_damping * _L1_period * groundSpeed;
 
     //Calculate the NE position of the aircraft relative to WP A
-    const Vector2f A_air = center_WP.get_distance_NE(_current_loc);
+    const Vector2f A_air = -air_center;
 
     // Calculate the unit vector from WP A to aircraft
     // protect against being on the waypoint and having zero velocity
@@ -389,7 +407,7 @@ void AP_L1_Control::update_loiter(const struct Location &center_WP, float radius
     //Calculate Nu to capture center_WP
     float xtrackVelCap = A_air_unit % _groundspeed_vector; // Velocity across line - perpendicular to radial inbound to WP
     float ltrackVelCap = - (_groundspeed_vector * A_air_unit); // Velocity along line - radial inbound to WP
-    float Nu = atan2f(xtrackVelCap,ltrackVelCap);
+    float Nu = approx_atan2f(xtrackVelCap,ltrackVelCap);
 
     _prevent_indecision(Nu);
     _last_Nu = Nu;
@@ -397,7 +415,7 @@ void AP_L1_Control::update_loiter(const struct Location &center_WP, float radius
     Nu = constrain_float(Nu, -M_PI_2, M_PI_2); //Limit Nu to +- Pi/2
 
     //Calculate lat accln demand to capture center_WP (use L1 guidance law)
-    float latAccDemCap = K_L1 * groundSpeed * groundSpeed / _L1_dist * sinf(Nu);
+    float latAccDemCap = K_L1 * groundSpeed * groundSpeed / _L1_dist * approx_sinf(Nu);
 
     //Calculate radial position and velocity errors
     float xtrackVelCirc = -ltrackVelCap; // Radial outbound velocity - reuse previous radial inbound velocity
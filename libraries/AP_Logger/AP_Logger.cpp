@@ -6,6 +6,7 @@
 #include "AP_Logger_SITL.h"
 #include "AP_Logger_DataFlash.h"
 #include "AP_Logger_MAVLink.h"
+#include "ISBCodec.h"
 
 #include <AP_InternalError/AP_InternalError.h>
 #include <GCS_MAVLink/GCS.h>
@@ -73,6 +74,31 @@ const AP_Param::GroupInfo AP_Logger::var_info[] = {
     // @Units: kB
     AP_GROUPINFO("_MAV_BUFSIZE",  5, AP_Logger, _params.mav_bufsize,       HAL_LOGGING_MAV_BUFSIZE),
 
+    // @Param: _FILE_COMPRESS
+    // @DisplayName: Compress File backend logs
+    // @Description: When enabled the AP_Logger_File backend compresses log data in the IO thread before writing it to the SD card, reducing the bytes written and the size of logs to download. Compressed logs must be decompressed (e.g. with Tools/scripts/decompress_log.py) before being loaded into tools which do not understand the compressed format. Takes effect on reboot.
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO("_FILE_COMPRESS",  6, AP_Logger, _params.file_compress,       0),
+
+    // @Group: _RL_
+    // @Path: AP_Logger_RateLimit.cpp
+    AP_SUBGROUPINFO(_rate_limit, "_RL_", 7, AP_Logger, AP_Logger_RateLimit),
+
+    // @Param: _MAV_ADAPT
+    // @DisplayName: Adaptive AP_Logger MAVLink Backend window
+    // @Description: When enabled the AP_Logger-over-mavlink backend limits the number of unacknowledged blocks in flight to a window sized from the measured round-trip time and loss, and resends unacknowledged blocks after a timeout derived from the round-trip time rather than a fixed 100ms. RADIO_STATUS from the link's radio, when present, also limits the window. This allows much higher throughput on high-latency links.
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO("_MAV_ADAPT",  8, AP_Logger, _params.mav_adaptive,       0),
+
+    // @Param: _FILE_INDEX
+    // @DisplayName: Index File backend logs
+    // @Description: When enabled the AP_Logger_File backend appends an index of log offsets by time, the offsets of late format messages and per-message-type counts to each log when it is closed. Replay uses the index to start replaying at a given time without processing the whole log. Closing an indexed log writes out everything still buffered. Not used when LOG_FILE_COMPRESS is set. Takes effect on reboot.
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO("_FILE_INDEX",  9, AP_Logger, _params.file_index,       0),
+
     AP_GROUPEND
 };
 
@@ -542,6 +568,48 @@ void AP_Logger::setVehicle_Startup_Writer(vehicle_startup_message_Writer writer)
     _vehicle_messages = writer;
 }
 
+void AP_Logger::note_boot_stage(const char *name)
+{
+    if (_num_boot_stages >= LOGGER_MAX_BOOT_STAGES) {
+        return;
+    }
+    auto &stage = _boot_stages[_num_boot_stages];
+    stage.name = name;
+    stage.end_ms = AP_HAL::millis();
+    stage.free_mem = hal.util->available_memory();
+    stage.free_mem_dma = hal.util->available_memory_dma();
+    _num_boot_stages++;
+}
+
+/*
+  "Boot <stage> <end>+<duration>ms mem <used> dma <used>", where the
+  memory used is the drop in free memory over the stage. The first
+  stage has no previous one to compare with, so shows free memory
+ */
+bool AP_Logger::format_boot_stage(uint8_t i, char *buf, uint8_t buflen) const
+{
+    if (i >= _num_boot_stages) {
+        return false;
+    }
+    const auto &stage = _boot_stages[i];
+    if (i == 0) {
+        hal.util->snprintf(buf, buflen, "Boot %s %ums free %u dma %u",
+                           stage.name,
+                           (unsigned)stage.end_ms,
+                           (unsigned)stage.free_mem,
+                           (unsigned)stage.free_mem_dma);
+        return true;
+    }
+    const auto &prev = _boot_stages[i-1];
+    hal.util->snprintf(buf, buflen, "Boot %s %u+%ums mem %d dma %d",
+                       stage.name,
+                       (unsigned)stage.end_ms,
+                       (unsigned)(stage.end_ms - prev.end_ms),
+                       (int)(prev.free_mem - stage.free_mem),
+                       (int)(prev.free_mem_dma - stage.free_mem_dma));
+    return true;
+}
+
 void AP_Logger::set_vehicle_armed(const bool armed_state)
 {
     if (armed_state == _armed) {
@@ -560,6 +628,9 @@ void AP_Logger::set_vehicle_armed(const bool armed_state)
 
 // start functions pass straight through to backend:
 void AP_Logger::WriteBlock(const void *pBuffer, uint16_t size) {
+    if (_rate_limit.should_drop(((const uint8_t *)pBuffer)[2])) {
+        return;
+    }
     FOR_EACH_BACKEND(WriteBlock(pBuffer, size));
 }
 
@@ -568,6 +639,39 @@ void AP_Logger::WriteCriticalBlock(const void *pBuffer, uint16_t size) {
 }
 
 void AP_Logger::WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical) {
+    if (!is_critical && _rate_limit.should_drop(((const uint8_t *)pBuffer)[2])) {
+        return;
+    }
+    FOR_EACH_BACKEND(WritePrioritisedBlock(pBuffer, size, is_critical));
+}
+
+// messages are only built in place by the main thread with a single
+// backend; otherwise the message is built in fallback and copied to
+// each backend as usual
+void *AP_Logger::ReserveBlock(void *fallback, uint16_t size, bool is_critical)
+{
+    if (_next_backend != 1 || !hal.scheduler->in_main_thread()) {
+        return fallback;
+    }
+    void *ret = backends[0]->ReservePrioritisedBlock(size, is_critical);
+    if (ret == nullptr) {
+        return fallback;
+    }
+    return ret;
+}
+
+void AP_Logger::CommitBlock(const void *pBuffer, uint16_t size, bool is_critical)
+{
+    if (!is_critical && _rate_limit.should_drop(((const uint8_t *)pBuffer)[2])) {
+        // release any reservation without writing anything
+        if (_next_backend == 1) {
+            backends[0]->CommitReservedBlock(pBuffer, 0);
+        }
+        return;
+    }
+    if (_next_backend == 1 && backends[0]->CommitReservedBlock(pBuffer, size)) {
+        return;
+    }
     FOR_EACH_BACKEND(WritePrioritisedBlock(pBuffer, size, is_critical));
 }
 
@@ -635,6 +739,11 @@ bool AP_Logger::logging_started(void) {
     return false;
 }
 
+void AP_Logger::handle_radio_status(mavlink_channel_t chan, uint8_t txbuf)
+{
+    FOR_EACH_BACKEND(remote_log_radio_status(chan, txbuf));
+}
+
 void AP_Logger::handle_mavlink_msg(GCS_MAVLINK &link, mavlink_message_t* msg)
 {
     switch (msg->msgid) {
@@ -656,6 +765,16 @@ void AP_Logger::handle_mavlink_msg(GCS_MAVLINK &link, mavlink_message_t* msg)
 void AP_Logger::periodic_tasks() {
     handle_log_send();
     FOR_EACH_BACKEND(periodic_tasks());
+
+    const uint32_t now = AP_HAL::millis();
+    if (now - _last_rate_limit_log_ms > 1000) {
+        _last_rate_limit_log_ms = now;
+        _rate_limit.Write_RateLimits();
+        Write_DMA();
+        Write_UART();
+        Write_CAN();
+        Write_IOMCU();
+    }
 }
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
@@ -801,15 +920,73 @@ void AP_Logger::assert_same_fmt_for_name(const AP_Logger::log_write_fmt *f,
 }
 #endif
 
+static inline uint8_t log_write_fmt_hash(const char *name, uint8_t size)
+{
+    return (((uintptr_t)name * 2654435761U) >> 8) & (size-1);
+}
+
+AP_Logger::log_write_fmt *AP_Logger::log_write_fmt_cache_find(const char *name) const
+{
+    if (log_write_fmt_cache == nullptr) {
+        return nullptr;
+    }
+    uint8_t idx = log_write_fmt_hash(name, LOG_WRITE_FMT_CACHE_SIZE);
+    for (uint8_t i=0; i<LOG_WRITE_FMT_CACHE_SIZE; i++) {
+        const struct log_write_fmt_cache_entry &e = log_write_fmt_cache[idx];
+        if (e.name == name) {
+            return e.fmt;
+        }
+        if (e.name == nullptr) {
+            break;
+        }
+        idx = (idx + 1) & (LOG_WRITE_FMT_CACHE_SIZE-1);
+    }
+    return nullptr;
+}
+
+void AP_Logger::log_write_fmt_cache_insert(const char *name, struct log_write_fmt *f)
+{
+    if (log_write_fmt_cache == nullptr) {
+        log_write_fmt_cache = (struct log_write_fmt_cache_entry *)calloc(LOG_WRITE_FMT_CACHE_SIZE, sizeof(*log_write_fmt_cache));
+        if (log_write_fmt_cache == nullptr) {
+            return;
+        }
+    }
+    if (log_write_fmt_cache_count >= LOG_WRITE_FMT_CACHE_SIZE - LOG_WRITE_FMT_CACHE_SIZE/8) {
+        // keep probe sequences short; the rest are found from the list
+        return;
+    }
+    uint8_t idx = log_write_fmt_hash(name, LOG_WRITE_FMT_CACHE_SIZE);
+    while (log_write_fmt_cache[idx].name != nullptr) {
+        idx = (idx + 1) & (LOG_WRITE_FMT_CACHE_SIZE-1);
+    }
+    // fmt is set before name so a concurrent lookup never sees a
+    // matching name without its fmt
+    log_write_fmt_cache[idx].fmt = f;
+    log_write_fmt_cache[idx].name = name;
+    log_write_fmt_cache_count++;
+}
+
 AP_Logger::log_write_fmt *AP_Logger::msg_fmt_for_name(const char *name, const char *labels, const char *units, const char *mults, const char *fmt)
 {
-    struct log_write_fmt *f;
+    struct log_write_fmt *f = log_write_fmt_cache_find(name);
+    if (f != nullptr) {
+        // already have an ID for this name:
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
+        assert_same_fmt_for_name(f, name, labels, units, mults, fmt);
+#endif
+        return f;
+    }
     for (f = log_write_fmts; f; f=f->next) {
-        if (f->name == name) { // ptr comparison
+        // the same name may come from string literals at different
+        // addresses in different translation units
+        if (f->name == name ||
+            (streq(f->name, name) && streq(f->fmt, fmt) && streq(f->labels, labels))) {
             // already have an ID for this name:
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
-            assert_same_fmt_for_name(f, name, labels, units, mults, fmt);
+            assert_same_fmt_for_name(f, f->name, labels, units, mults, fmt);
 #endif
+            log_write_fmt_cache_insert(name, f);
             return f;
         }
     }
@@ -842,6 +1019,7 @@ AP_Logger::log_write_fmt *AP_Logger::msg_fmt_for_name(const char *name, const ch
     // add to front of list
     f->next = log_write_fmts;
     log_write_fmts = f;
+    log_write_fmt_cache_insert(name, f);
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
     char ls_name[LS_NAME_SIZE] = {};
@@ -1085,6 +1263,37 @@ bool AP_Logger::Write_ISBD(const uint16_t isb_seqno,
     return backends[0]->WriteBlock(&pkt, sizeof(pkt));
 }
 
+// Write a delta-encoded series of IMU readings to log.  Returns the
+// number of the count samples written, or zero on failure
+uint8_t AP_Logger::Write_ISBC(const uint16_t isb_seqno,
+                              const uint16_t sample_ofs,
+                              const int16_t *x,
+                              const int16_t *y,
+                              const int16_t *z,
+                              const uint16_t count)
+{
+    if (_next_backend == 0) {
+        return 0;
+    }
+    struct log_ISBC pkt = {
+        LOG_PACKET_HEADER_INIT(LOG_ISBC_MSG),
+        time_us    : AP_HAL::micros64(),
+        isb_seqno  : isb_seqno,
+        sample_ofs : sample_ofs
+    };
+    const uint8_t packed = ISBCodec::encode(pkt, x, y, z, count);
+
+    // only the first backend need succeed for us to be successful
+    for (uint8_t i=1; i<_next_backend; i++) {
+        backends[i]->WriteBlock(&pkt, sizeof(pkt));
+    }
+
+    if (!backends[0]->WriteBlock(&pkt, sizeof(pkt))) {
+        return 0;
+    }
+    return packed;
+}
+
 // Wrote an event packet
 void AP_Logger::Write_Event(Log_Event id)
 {
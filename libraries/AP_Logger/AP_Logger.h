@@ -22,6 +22,7 @@
 #include <stdint.h>
 
 #include "LoggerMessageWriter.h"
+#include "AP_Logger_RateLimit.h"
 
 class AP_Logger_Backend;
 
@@ -200,6 +201,17 @@ public:
     /* Write an *important* block of data at current offset */
     void WriteCriticalBlock(const void *pBuffer, uint16_t size);
 
+    /*
+      get a buffer to build a message of size bytes in. Where possible
+      this is space in the backend's write buffer, so the message does
+      not have to be copied from the stack. Otherwise fallback is
+      returned. The returned buffer must always be passed to
+      CommitBlock() once the message has been filled in, with no other
+      log writes in between.
+     */
+    void *ReserveBlock(void *fallback, uint16_t size, bool is_critical=false);
+    void CommitBlock(const void *pBuffer, uint16_t size, bool is_critical=false);
+
     // high level interface
     uint16_t find_last_log() const;
     void get_log_boundaries(uint16_t log_num, uint32_t & start_page, uint32_t & end_page);
@@ -207,6 +219,17 @@ public:
 
     void setVehicle_Startup_Writer(vehicle_startup_message_Writer writer);
 
+    /*
+      record that a stage of vehicle startup has finished, with the
+      time it took and the memory it used. The stages are written as
+      messages at the start of each log, giving a boot timeline, and
+      are sent to the GCS on request. name must be a string constant
+     */
+    void note_boot_stage(const char *name);
+    uint8_t num_boot_stages() const { return _num_boot_stages; }
+    // format stage i as a message, returns false past the last stage
+    bool format_boot_stage(uint8_t i, char *buf, uint8_t buflen) const;
+
     void PrepForArming();
 
     void EnableWrites(bool enable) { _writes_enabled = enable; }
@@ -234,12 +257,23 @@ public:
                         const int16_t x[32],
                         const int16_t y[32],
                         const int16_t z[32]);
+    uint8_t Write_ISBC(uint16_t isb_seqno,
+                       uint16_t sample_ofs,
+                       const int16_t *x,
+                       const int16_t *y,
+                       const int16_t *z,
+                       uint16_t count);
     void Write_Vibration();
     void Write_RCIN(void);
     void Write_RCOUT(void);
     void Write_RSSI();
     void Write_Baro(uint64_t time_us=0);
     void Write_Power(void);
+    void Write_DMA(void);
+    void Write_UART(void);
+    void Write_CAN(void);
+    void Write_IOMCU(void);
+    void Write_OA(uint8_t state, uint32_t plan_us, uint32_t age_ms, const Location &destination, const Location &oa_destination);
     void Write_AHRS2(AP_AHRS &ahrs);
     void Write_POS(AP_AHRS &ahrs);
 #if AP_AHRS_NAVEKF_AVAILABLE
@@ -249,7 +283,11 @@ public:
     void Write_Message(const char *message);
     void Write_MessageF(const char *fmt, ...);
     void Write_CameraInfo(enum LogMessages msg, const AP_AHRS &ahrs, const Location &current_loc, uint64_t timestamp_us=0);
+    void Write_CameraInfo(enum LogMessages msg, const AP_AHRS &ahrs, const Location &loc, int32_t roll_cd, int32_t pitch_cd, int32_t yaw_cd, uint64_t timestamp_us);
     void Write_Camera(const AP_AHRS &ahrs, const Location &current_loc, uint64_t timestamp_us=0);
+    // write a Camera packet for the vehicle state at timestamp_us,
+    // which may be some time in the past
+    void Write_Camera(const AP_AHRS &ahrs, const Location &loc, int32_t roll_cd, int32_t pitch_cd, int32_t yaw_cd, uint64_t timestamp_us);
     void Write_Trigger(const AP_AHRS &ahrs, const Location &current_loc);
     void Write_ESC(uint8_t id, uint64_t time_us, int32_t rpm, uint16_t voltage, uint16_t current, int16_t temperature, uint16_t current_tot);
     void Write_Attitude(AP_AHRS &ahrs, const Vector3f &targets);
@@ -270,7 +308,7 @@ public:
     void Write_RallyPoint(uint8_t total,
                           uint8_t sequence,
                           const RallyLocation &rally_point);
-    void Write_VisualOdom(float time_delta, const Vector3f &angle_delta, const Vector3f &position_delta, float confidence);
+    void Write_VisualOdom(float time_delta, const Vector3f &angle_delta, const Vector3f &position_delta, float confidence, uint32_t receive_lag_ms, uint32_t fusion_lag_ms);
     void Write_AOA_SSA(AP_AHRS &ahrs);
     void Write_Beacon(AP_Beacon &beacon);
     void Write_Proximity(AP_Proximity &proximity);
@@ -303,6 +341,9 @@ public:
 #endif
 
     void handle_mavlink_msg(class GCS_MAVLINK &, mavlink_message_t* msg);
+    // percentage of free space in the radio's transmit buffer, as
+    // reported in RADIO_STATUS received on chan
+    void handle_radio_status(mavlink_channel_t chan, uint8_t txbuf);
 
     void periodic_tasks(); // may want to split this into GCS/non-GCS duties
 
@@ -318,6 +359,9 @@ public:
         return _params.log_disarmed != 0;
     }
     uint8_t log_replay(void) const { return _params.log_replay; }
+
+    // per-message-type rate limits
+    AP_Logger_RateLimit &rate_limit() { return _rate_limit; }
     
     vehicle_startup_message_Writer _vehicle_messages;
 
@@ -330,8 +374,13 @@ public:
         AP_Int8 log_disarmed;
         AP_Int8 log_replay;
         AP_Int8 mav_bufsize; // in kilobytes
+        AP_Int8 file_compress;
+        AP_Int8 mav_adaptive;
+        AP_Int8 file_index;
     } _params;
 
+    AP_Logger_RateLimit _rate_limit;
+
     const struct LogStructure *structure(uint16_t num) const;
     const struct UnitStructure *unit(uint16_t num) const;
     const struct MultiplierStructure *multiplier(uint16_t num) const;
@@ -403,6 +452,17 @@ private:
         const char *mults;
     } *log_write_fmts;
 
+    // open-addressed cache from name pointer to log_write_fmt so
+    // lookups don't walk log_write_fmts.  Allocated on first use
+    static const uint8_t LOG_WRITE_FMT_CACHE_SIZE = 64; // power of two
+    struct log_write_fmt_cache_entry {
+        const char *name;
+        struct log_write_fmt *fmt;
+    } *log_write_fmt_cache;
+    uint8_t log_write_fmt_cache_count;
+    struct log_write_fmt *log_write_fmt_cache_find(const char *name) const;
+    void log_write_fmt_cache_insert(const char *name, struct log_write_fmt *f);
+
     // return (possibly allocating) a log_write_fmt for a name
     struct log_write_fmt *msg_fmt_for_name(const char *name, const char *labels, const char *units, const char *mults, const char *fmt);
     const struct log_write_fmt *log_write_fmt_for_msg_type(uint8_t msg_type) const;
@@ -469,6 +529,19 @@ private:
     bool _writes_enabled:1;
     bool _force_log_disarmed:1;
 
+    // last time suppressed message counts were logged
+    uint32_t _last_rate_limit_log_ms;
+
+    // boot timeline, see note_boot_stage()
+    #define LOGGER_MAX_BOOT_STAGES 24
+    struct {
+        const char *name;
+        uint32_t end_ms;
+        uint32_t free_mem;
+        uint32_t free_mem_dma;
+    } _boot_stages[LOGGER_MAX_BOOT_STAGES];
+    uint8_t _num_boot_stages;
+
     /* support for retrieving logs via mavlink: */
 
     enum transfer_activity_t : uint8_t {
@@ -501,6 +574,18 @@ private:
     // start page of log data
     uint32_t _log_data_page;
 
+    // further ranges of _log_num_data requested on _log_sending_link
+    // while sending, served in order once the current range is done
+    static const uint8_t LOG_DATA_RANGES_MAX = 8;
+    struct log_data_range {
+        uint32_t ofs;
+        uint32_t count;
+    } _log_data_ranges[LOG_DATA_RANGES_MAX];
+    uint8_t _log_data_range_count;
+    void set_log_data_range(uint32_t ofs, uint32_t count);
+    void queue_log_data_range(uint32_t ofs, uint32_t count);
+    bool start_next_log_data_range();
+
     GCS_MAVLINK *_log_sending_link;
     HAL_Semaphore_Recursive _log_send_sem;
 
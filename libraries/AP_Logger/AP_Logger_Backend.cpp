@@ -366,6 +366,39 @@ bool AP_Logger_Backend::WritePrioritisedBlock(const void *pBuffer, uint16_t size
     return _WritePrioritisedBlock(pBuffer, size, is_critical);
 }
 
+void *AP_Logger_Backend::ReservePrioritisedBlock(uint16_t size, bool is_critical)
+{
+    if (!ShouldLog(is_critical)) {
+        return nullptr;
+    }
+    if (StartNewLogOK()) {
+        start_new_log();
+    }
+    if (!WritesOK()) {
+        return nullptr;
+    }
+    void *ret = _ReservePrioritisedBlock(size, is_critical);
+    if (ret != nullptr) {
+        _reserved_block = ret;
+    }
+    return ret;
+}
+
+bool AP_Logger_Backend::CommitReservedBlock(const void *pBuffer, uint16_t size)
+{
+    if (_reserved_block == nullptr || pBuffer != _reserved_block) {
+        return false;
+    }
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
+    if (size != 0) {
+        validate_WritePrioritisedBlock(pBuffer, size);
+    }
+#endif
+    _reserved_block = nullptr;
+    _CommitReservedBlock(size);
+    return true;
+}
+
 bool AP_Logger_Backend::ShouldLog(bool is_critical)
 {
     if (!_front.WritesEnabled()) {
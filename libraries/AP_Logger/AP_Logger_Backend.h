@@ -34,6 +34,16 @@ public:
 
     bool WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical);
 
+    /* reserve size contiguous bytes in the write buffer so a message
+     * can be built in place. Returns nullptr if that is not possible,
+     * in which case the message should be written with
+     * WritePrioritisedBlock(). A successful reservation must be
+     * completed with CommitReservedBlock() before any other write */
+    void *ReservePrioritisedBlock(uint16_t size, bool is_critical);
+    // returns false if pBuffer is not the outstanding reservation.  A
+    // size of zero releases the reservation without writing anything
+    bool CommitReservedBlock(const void *pBuffer, uint16_t size);
+
     // high level interface
     virtual uint16_t find_last_log() = 0;
     virtual void get_log_boundaries(uint16_t log_num, uint32_t & start_page, uint32_t & end_page) = 0;
@@ -70,6 +80,8 @@ public:
      // for Logger_MAVlink
     virtual void remote_log_block_status_msg(mavlink_channel_t chan,
                                              mavlink_message_t* msg) { }
+    virtual void remote_log_radio_status(mavlink_channel_t chan,
+                                         uint8_t txbuf) { }
     // end for Logger_MAVlink
 
    virtual void periodic_tasks();
@@ -154,6 +166,10 @@ protected:
 
     virtual bool _WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical) = 0;
 
+    // backends which can build messages in their write buffer override these
+    virtual void *_ReservePrioritisedBlock(uint16_t size, bool is_critical) { return nullptr; }
+    virtual void _CommitReservedBlock(uint16_t size) { }
+
     bool _initialised;
 
 private:
@@ -162,5 +178,8 @@ private:
     uint32_t _last_periodic_10Hz;
     bool have_logged_armed;
 
+    // outstanding in-place reservation, nullptr if none
+    const void *_reserved_block;
+
     void validate_WritePrioritisedBlock(const void *pBuffer, uint16_t size);
 };
@@ -120,6 +120,27 @@ bool AP_Logger_Block::_WritePrioritisedBlock(const void *pBuffer, uint16_t size,
     return true;
 }
 
+// reserve space in writebuf for a message to be built in place
+void *AP_Logger_Block::_ReservePrioritisedBlock(uint16_t size, bool is_critical)
+{
+    if (!WriteBlockCheckStartupMessages() || _writing_startup_messages) {
+        return nullptr;
+    }
+
+    ByteBuffer::IoVec vec[2];
+    if (writebuf.space() < size ||
+        writebuf.reserve(vec, size) != 1) {
+        return nullptr;
+    }
+
+    return vec[0].data;
+}
+
+void AP_Logger_Block::_CommitReservedBlock(uint16_t size)
+{
+    writebuf.commit(size);
+}
+
 
 void AP_Logger_Block::StartRead(uint32_t PageAdr)
 {
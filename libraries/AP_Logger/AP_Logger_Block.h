@@ -35,6 +35,8 @@ public:
 protected:
     /* Write a block of data at current offset */
     bool _WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical) override;
+    void *_ReservePrioritisedBlock(uint16_t size, bool is_critical) override;
+    void _CommitReservedBlock(uint16_t size) override;
 
 private:
     /*
@@ -54,6 +54,39 @@ extern const AP_HAL::HAL& hal;
 #define HAL_LOGGER_WRITE_CHUNK_SIZE 4096
 #endif
 
+// writes are trimmed to end on a multiple of this to avoid the
+// filesystem having to read partial blocks back
+#ifndef HAL_LOGGER_WRITE_ALIGN
+#if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+#define HAL_LOGGER_WRITE_ALIGN 4096
+#else
+#define HAL_LOGGER_WRITE_ALIGN 512
+#endif
+#endif
+
+// size of the buffer used to read ahead of log downloads; 0 disables
+#ifndef HAL_LOGGER_READAHEAD_SIZE
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+#define HAL_LOGGER_READAHEAD_SIZE (64*1024UL)
+#else
+#define HAL_LOGGER_READAHEAD_SIZE (8*1024UL)
+#endif
+#endif
+// reads ahead are done in chunks of at most this, never crossing a
+// multiple of it
+#define LOGGER_READAHEAD_CHUNK 4096U
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+// size of each file preallocation
+#ifndef HAL_LOGGER_PREALLOC_SIZE
+#define HAL_LOGGER_PREALLOC_SIZE (8*1024*1024UL)
+#endif
+// how far behind the write offset we wait for writeback to complete
+#ifndef HAL_LOGGER_SYNC_LAG
+#define HAL_LOGGER_SYNC_LAG (256*1024UL)
+#endif
+#endif
+
 /*
   constructor
  */
@@ -71,6 +104,7 @@ AP_Logger_File::AP_Logger_File(AP_Logger &front,
     _perf_errors(hal.util->perf_alloc(AP_HAL::Util::PC_COUNT, "DF_errors")),
     _perf_overruns(hal.util->perf_alloc(AP_HAL::Util::PC_COUNT, "DF_overruns"))
 {
+    _readahead.fd = -1;
     df_stats_clear();
 }
 
@@ -115,6 +149,28 @@ void AP_Logger_File::Init()
 
     hal.console->printf("AP_Logger_File: buffer size=%u\n", (unsigned)bufsize);
 
+    if (_front._params.file_compress) {
+        _compressor = new LogCompressor();
+        _compress_buf = (uint8_t *)malloc(LogCompressor::max_frame_size(_writebuf_chunk));
+        if (_compressor == nullptr || _compress_buf == nullptr) {
+            hal.console->printf("AP_Logger_File: Out of memory for compression\n");
+            delete _compressor;
+            _compressor = nullptr;
+            free(_compress_buf);
+            _compress_buf = nullptr;
+        }
+    }
+
+    // offsets into a compressed log aren't seekable
+    if (_front._params.file_index && _compressor == nullptr) {
+        _index = new AP_Logger_FileIndex();
+        if (_index == nullptr || !_index->init()) {
+            hal.console->printf("AP_Logger_File: Out of memory for index\n");
+            delete _index;
+            _index = nullptr;
+        }
+    }
+
     _initialised = true;
     hal.scheduler->register_io_process(FUNCTOR_BIND_MEMBER(&AP_Logger_File::_io_timer, void));
 }
@@ -471,6 +527,7 @@ void AP_Logger_File::EraseAll()
     }
 
     _cached_oldest_log = 0;
+    read_ahead_stop();
 
     if (was_logging) {
         start_new_log();
@@ -545,10 +602,103 @@ bool AP_Logger_File::_WritePrioritisedBlock(const void *pBuffer, uint16_t size,
 
     _writebuf.write((uint8_t*)pBuffer, size);
     df_stats_gather(size);
+    index_message((const uint8_t *)pBuffer, size);
     semaphore.give();
     return true;
 }
 
+/*
+  reserve space in _writebuf for a message to be built in place. The
+  semaphore is held until _CommitReservedBlock() so the reservation
+  can't be interleaved with other writers. Anything other than the
+  simple case is left to _WritePrioritisedBlock()
+ */
+void *AP_Logger_File::_ReservePrioritisedBlock(uint16_t size, bool is_critical)
+{
+    if (!WriteBlockCheckStartupMessages() || _writing_startup_messages) {
+        return nullptr;
+    }
+
+    if (!semaphore.take(1)) {
+        return nullptr;
+    }
+
+    const uint32_t space = _writebuf.space();
+    if ((!is_critical && space < critical_message_reserved_space()) ||
+        space < size) {
+        semaphore.give();
+        return nullptr;
+    }
+
+    ByteBuffer::IoVec vec[2];
+    if (_writebuf.reserve(vec, size) != 1) {
+        // the message would wrap around the end of the buffer
+        semaphore.give();
+        return nullptr;
+    }
+
+    _reserved_block = vec[0].data;
+    return vec[0].data;
+}
+
+void AP_Logger_File::_CommitReservedBlock(uint16_t size)
+{
+    _writebuf.commit(size);
+    if (size != 0) {
+        df_stats_gather(size);
+        index_message(_reserved_block, size);
+    }
+    semaphore.give();
+}
+
+/*
+  add a message accepted into _writebuf to the index.  Called with
+  the semaphore held
+ */
+void AP_Logger_File::index_message(const uint8_t *msg, const uint16_t size)
+{
+    if (_index == nullptr) {
+        return;
+    }
+    if (!_index->startup_done() && !_writing_startup_messages &&
+        _startup_messagewriter->finished()) {
+        _index->note_startup_done(_index_ofs);
+    }
+    _index->note_message(AP_HAL::micros64(), _index_ofs, msg, size);
+    _index_ofs += size;
+}
+
+/*
+  append the index to the log being closed.  The index must follow a
+  complete message, so everything buffered is written out first.
+  Called with write_fd_semaphore held
+ */
+void AP_Logger_File::write_index(const int fd)
+{
+    WITH_SEMAPHORE(semaphore);
+    uint32_t nbytes;
+    while ((nbytes = _writebuf.available()) > 0) {
+        uint32_t size;
+        const uint8_t *head = _writebuf.readptr(size);
+        nbytes = MIN(nbytes, size);
+        const ssize_t nwritten = ::write(fd, head, nbytes);
+        if (nwritten <= 0) {
+            hal.util->perf_count(_perf_errors);
+            return;
+        }
+        _writebuf.advance(nwritten);
+        _write_offset += nwritten;
+    }
+    if (!_index->write(fd, _write_offset)) {
+        hal.util->perf_count(_perf_errors);
+        return;
+    }
+    const off_t end = ::lseek(fd, 0, SEEK_CUR);
+    if (end != (off_t)-1) {
+        _write_offset = end;
+    }
+}
+
 /*
   find the highest log number
  */
@@ -710,6 +860,11 @@ int16_t AP_Logger_File::get_log_data(const uint16_t list_entry, const uint16_t p
     }
     uint32_t ofs = page * (uint32_t)LOGGER_PAGE_SIZE + offset;
 
+    const int16_t cached = read_ahead_get(log_num, ofs, len, data);
+    if (cached >= 0) {
+        return cached;
+    }
+
     /*
       this rather strange bit of code is here to work around a bug
       in file offsets in NuttX. Every few hundred blocks of reads
@@ -750,6 +905,134 @@ int16_t AP_Logger_File::get_log_data(const uint16_t list_entry, const uint16_t p
     return ret;
 }
 
+/*
+  copy log data from the read-ahead buffer and tell the IO thread
+  where the reader has got to.  Returns -1 if the data isn't buffered
+ */
+int16_t AP_Logger_File::read_ahead_get(const uint16_t log_num, const uint32_t ofs, uint16_t len, uint8_t *data)
+{
+    if (HAL_LOGGER_READAHEAD_SIZE == 0) {
+        return -1;
+    }
+    WITH_SEMAPHORE(_readahead_sem);
+
+    if (_readahead.buf == nullptr) {
+        _readahead.buf = (uint8_t *)malloc(HAL_LOGGER_READAHEAD_SIZE);
+        if (_readahead.buf == nullptr) {
+            return -1;
+        }
+        _readahead.log_num = 0;
+        _readahead.len = 0;
+    }
+    _readahead.want_log_num = log_num;
+    _readahead.want_ofs = ofs + len;
+
+    if (log_num != _readahead.log_num || ofs < _readahead.ofs) {
+        return -1;
+    }
+    const uint32_t end = _readahead.ofs + _readahead.len;
+    if (ofs + len > end) {
+        if (!_readahead.eof || ofs > end) {
+            return -1;
+        }
+        len = end - ofs;
+    }
+    memcpy(data, &_readahead.buf[ofs - _readahead.ofs], len);
+    return len;
+}
+
+/*
+  have the IO thread close the read-ahead file and free its buffer
+ */
+void AP_Logger_File::read_ahead_stop()
+{
+    WITH_SEMAPHORE(_readahead_sem);
+    _readahead.want_log_num = 0;
+}
+
+/*
+  called from the IO thread to keep the read-ahead buffer full
+ */
+void AP_Logger_File::read_ahead()
+{
+    uint16_t want_log_num;
+    {
+        WITH_SEMAPHORE(_readahead_sem);
+        if (_readahead.buf == nullptr) {
+            return;
+        }
+        want_log_num = _readahead.want_log_num;
+        const uint32_t want_ofs = _readahead.want_ofs;
+        if (want_log_num != _readahead.log_num ||
+            want_ofs < _readahead.ofs ||
+            want_ofs > _readahead.ofs + _readahead.len) {
+            // the reader has moved away from what we have
+            _readahead.ofs = want_ofs;
+            _readahead.len = 0;
+            _readahead.eof = false;
+        } else if (want_ofs - _readahead.ofs >= HAL_LOGGER_READAHEAD_SIZE/2) {
+            // drop what has been read to make room
+            const uint32_t consumed = want_ofs - _readahead.ofs;
+            memmove(_readahead.buf, &_readahead.buf[consumed], _readahead.len - consumed);
+            _readahead.ofs = want_ofs;
+            _readahead.len -= consumed;
+        }
+        if (want_log_num == 0) {
+            free(_readahead.buf);
+            _readahead.buf = nullptr;
+        }
+    }
+
+    if (want_log_num != _readahead.log_num) {
+        if (_readahead.fd != -1) {
+            ::close(_readahead.fd);
+            _readahead.fd = -1;
+        }
+        // on failure log_num is still set so we don't retry the open;
+        // get_log_data will read the file directly
+        _readahead.log_num = want_log_num;
+        if (want_log_num == 0) {
+            return;
+        }
+        char *fname = _log_file_name(want_log_num);
+        if (fname == nullptr) {
+            return;
+        }
+        _readahead.fd = ::open(fname, O_RDONLY|O_CLOEXEC);
+        free(fname);
+    }
+    if (_readahead.fd == -1 || _readahead.eof) {
+        return;
+    }
+
+    // only this thread changes len, so it is safe to read it and to
+    // fill beyond it without the semaphore
+    const uint32_t read_ofs = _readahead.ofs + _readahead.len;
+    uint32_t nbytes = LOGGER_READAHEAD_CHUNK - (read_ofs % LOGGER_READAHEAD_CHUNK);
+    if (nbytes > HAL_LOGGER_READAHEAD_SIZE - _readahead.len) {
+        // full; wait for the reader to make room
+        return;
+    }
+    // seek every time; see the NuttX note in get_log_data
+    if (::lseek(_readahead.fd, read_ofs, SEEK_SET) == (off_t)-1) {
+        ::close(_readahead.fd);
+        _readahead.fd = -1;
+        return;
+    }
+    last_io_operation = "read_ahead";
+    const ssize_t nread = ::read(_readahead.fd, &_readahead.buf[_readahead.len], nbytes);
+    last_io_operation = "";
+    if (nread < 0) {
+        ::close(_readahead.fd);
+        _readahead.fd = -1;
+        return;
+    }
+
+    WITH_SEMAPHORE(_readahead_sem);
+    _readahead.len += nread;
+    _readahead.eof = ((uint32_t)nread < nbytes);
+}
+
 /*
   find size and date of a log
  */
@@ -794,6 +1077,23 @@ uint16_t AP_Logger_File::get_num_logs()
     return ret;
 }
 
+/*
+  write the events of the HAL's perf counters, covering the end of the
+  log just closed, to TRACE.JSON in the log directory. It loads in
+  Perfetto or chrome://tracing
+ */
+void AP_Logger_File::write_trace()
+{
+    char *path;
+    if (asprintf(&path, "%s/TRACE.JSON", _log_directory) == -1) {
+        return;
+    }
+    last_io_operation = "write_trace";
+    hal.util->perf_trace_dump(path);
+    last_io_operation = "";
+    free(path);
+}
+
 /*
   stop logging
  */
@@ -804,7 +1104,19 @@ void AP_Logger_File::stop_logging(void)
     if (_write_fd != -1) {
         int fd = _write_fd;
         _write_fd = -1;
+        if (_index != nullptr && have_sem) {
+            write_index(fd);
+        }
+#if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+        if (_prealloc_offset > _write_offset) {
+            // release the preallocated space past the end of the log
+            if (::ftruncate(fd, _write_offset) == -1) {
+                hal.util->perf_count(_perf_errors);
+            }
+        }
+#endif
         ::close(fd);
+        _trace_dump_pending = true;
     }
     if (have_sem) {
         write_fd_semaphore.give();
@@ -840,6 +1152,7 @@ uint16_t AP_Logger_File::start_new_log(void)
         ::close(_read_fd);
         _read_fd = -1;
     }
+    read_ahead_stop();
 
     if (disk_space_avail() < _free_space_min_avail) {
         hal.console->printf("Out of space for logging\n");
@@ -891,6 +1204,17 @@ uint16_t AP_Logger_File::start_new_log(void)
     _last_write_ms = AP_HAL::millis();
     _write_offset = 0;
     _writebuf.clear();
+    if (_index != nullptr) {
+        _index->reset();
+    }
+    _index_ofs = 0;
+    _compress_len = 0;
+    _compress_ofs = 0;
+#if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+    _prealloc_offset = 0;
+    _synced_offset = 0;
+    _prealloc_failed = false;
+#endif
     write_fd_semaphore.give();
 
     // now update lastlog.txt with the new log number
@@ -929,7 +1253,8 @@ void AP_Logger_File::flush(void)
 #if APM_BUILD_TYPE(APM_BUILD_Replay) || APM_BUILD_TYPE(APM_BUILD_UNKNOWN)
 {
     uint32_t tnow = AP_HAL::millis();
-    while (_write_fd != -1 && _initialised && !_open_error && _writebuf.available()) {
+    while (_write_fd != -1 && _initialised && !_open_error &&
+           (_writebuf.available() || _compress_ofs < _compress_len)) {
         // convince the IO timer that it really is OK to write out
         // less than _writebuf_chunk bytes:
         if (tnow > 2001) { // avoid resetting _last_write_time to 0
@@ -957,15 +1282,26 @@ void AP_Logger_File::_io_timer(void)
 {
     uint32_t tnow = AP_HAL::millis();
     _io_timer_heartbeat = tnow;
+    if (_trace_dump_pending) {
+        _trace_dump_pending = false;
+        write_trace();
+    }
+    if (_write_fd == -1 && _initialised) {
+        read_ahead();
+    }
     if (_write_fd == -1 || !_initialised || _open_error) {
         return;
     }
 
+    // a partially written compressed frame must be finished off
+    // before anything else goes to the file
+    const bool frame_pending = _compress_ofs < _compress_len;
+
     uint32_t nbytes = _writebuf.available();
-    if (nbytes == 0) {
+    if (nbytes == 0 && !frame_pending) {
         return;
     }
-    if (nbytes < _writebuf_chunk && 
+    if (nbytes < _writebuf_chunk && !frame_pending &&
         tnow - _last_write_time < 2000UL) {
         // write in _writebuf_chunk-sized chunks, but always write at
         // least once per 2 seconds if data is available
@@ -996,9 +1332,9 @@ void AP_Logger_File::_io_timer(void)
     const uint8_t *head = _writebuf.readptr(size);
     nbytes = MIN(nbytes, size);
 
-    // try to align writes on a 512 byte boundary to avoid filesystem reads
-    if ((nbytes + _write_offset) % 512 != 0) {
-        uint32_t ofs = (nbytes + _write_offset) % 512;
+    // try to align writes on a block boundary to avoid filesystem reads
+    if (_compressor == nullptr && (nbytes + _write_offset) % HAL_LOGGER_WRITE_ALIGN != 0) {
+        uint32_t ofs = (nbytes + _write_offset) % HAL_LOGGER_WRITE_ALIGN;
         if (ofs < nbytes) {
             nbytes -= ofs;
         }
@@ -1012,6 +1348,30 @@ void AP_Logger_File::_io_timer(void)
         write_fd_semaphore.give();
         return;
     }
+    if (_compressor != nullptr) {
+        // compressing under the semaphore stops start_new_log()
+        // resetting the frame state underneath us
+        if (_compress_ofs >= _compress_len) {
+            if (nbytes == 0) {
+                // a new log was started since frame_pending was read
+                write_fd_semaphore.give();
+                return;
+            }
+            last_io_operation = "compress";
+            _compress_len = _compressor->compress_frame(head, nbytes, _compress_buf);
+            _compress_ofs = 0;
+            _writebuf.advance(nbytes);
+        }
+        head = &_compress_buf[_compress_ofs];
+        nbytes = _compress_len - _compress_ofs;
+        last_io_operation = "write";
+    }
+#if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+    last_io_operation = "fallocate";
+    preallocate(_write_offset + nbytes);
+    last_io_operation = "write";
+#endif
+    const uint32_t write_start_us = AP_HAL::micros();
     ssize_t nwritten = ::write(_write_fd, head, nbytes);
     last_io_operation = "";
     if (nwritten <= 0) {
@@ -1029,24 +1389,75 @@ void AP_Logger_File::_io_timer(void)
         }
     } else {
         _last_write_ms = tnow;
+#if CONFIG_HAL_BOARD == HAL_BOARD_LINUX && CONFIG_HAL_BOARD_SUBTYPE != HAL_BOARD_SUBTYPE_LINUX_NONE
+        sync_written(_write_offset, nwritten);
+#endif
         _write_offset += nwritten;
-        _writebuf.advance(nwritten);
+        if (_compressor != nullptr) {
+            _compress_ofs += nwritten;
+        } else {
+            _writebuf.advance(nwritten);
+        }
         /*
           the best strategy for minimizing corruption on microSD cards
           seems to be to write in 4k chunks and fsync the file on each
           chunk, ensuring the directory entry is updated after each
           write.
          */
-#if CONFIG_HAL_BOARD != HAL_BOARD_SITL && CONFIG_HAL_BOARD_SUBTYPE != HAL_BOARD_SUBTYPE_LINUX_NONE
+#if CONFIG_HAL_BOARD != HAL_BOARD_SITL && CONFIG_HAL_BOARD != HAL_BOARD_LINUX
         last_io_operation = "fsync";
+        hal.util->perf_begin(_perf_fsync);
         ::fsync(_write_fd);
+        hal.util->perf_end(_perf_fsync);
         last_io_operation = "";
 #endif
     }
     write_fd_semaphore.give();
+    df_stats_gather_latency(AP_HAL::micros() - write_start_us);
     hal.util->perf_end(_perf_write);
 }
 
+#if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+/*
+  extend the file's allocation ahead of the data so the filesystem
+  is not allocating blocks on every write
+ */
+void AP_Logger_File::preallocate(const uint32_t write_end)
+{
+    if (_prealloc_failed || write_end + HAL_LOGGER_PREALLOC_SIZE/2 < _prealloc_offset) {
+        return;
+    }
+    if (::fallocate(_write_fd, FALLOC_FL_KEEP_SIZE, _prealloc_offset, HAL_LOGGER_PREALLOC_SIZE) != 0) {
+        // not supported by this filesystem; don't keep trying
+        _prealloc_failed = true;
+        return;
+    }
+    _prealloc_offset += HAL_LOGGER_PREALLOC_SIZE;
+}
+
+/*
+  start writeback of the data just written without waiting for it,
+  then wait for the writeback started HAL_LOGGER_SYNC_LAG bytes ago,
+  which has normally completed by now.  This stops dirty pages
+  piling up in the page cache without stalling the IO thread in fsync
+ */
+void AP_Logger_File::sync_written(const uint32_t ofs, const uint32_t len)
+{
+    last_io_operation = "sync_file_range";
+    hal.util->perf_begin(_perf_fsync);
+    ::sync_file_range(_write_fd, ofs, len, SYNC_FILE_RANGE_WRITE);
+    const uint32_t end = ofs + len;
+    if (end > _synced_offset + 2*HAL_LOGGER_SYNC_LAG) {
+        const uint32_t sync_end = end - HAL_LOGGER_SYNC_LAG;
+        ::sync_file_range(_write_fd, _synced_offset, sync_end - _synced_offset,
+                          SYNC_FILE_RANGE_WAIT_BEFORE|SYNC_FILE_RANGE_WRITE|SYNC_FILE_RANGE_WAIT_AFTER);
+        _synced_offset = sync_end;
+    }
+    hal.util->perf_end(_perf_fsync);
+    last_io_operation = "";
+}
+#endif
+
 // this sensor is enabled if we should be logging at the moment
 bool AP_Logger_File::logging_enabled() const
 {
@@ -1120,6 +1531,53 @@ void AP_Logger_File::df_stats_gather(const uint16_t bytes_written) {
     stats.blocks++;
 }
 
+void AP_Logger_File::df_stats_gather_latency(const uint32_t write_us) {
+    uint8_t bucket;
+    if (write_us < 4) {
+        bucket = write_us;
+    } else {
+        const uint8_t msb = 31 - __builtin_clz(write_us);
+        bucket = MIN((msb-1)*4 + ((write_us >> (msb-2)) & 3), WRITE_LATENCY_BUCKETS-1);
+    }
+    stats.write_latency[bucket]++;
+    stats.writes++;
+    stats.write_latency_max = MAX(stats.write_latency_max, write_us);
+}
+
+// lower bound of the latency bucket containing the given percentile
+static uint32_t latency_percentile(const uint16_t *hist, uint8_t nbuckets, uint16_t count, uint8_t percent)
+{
+    const uint32_t target = (count * (uint32_t)percent + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t b=0; b<nbuckets; b++) {
+        seen += hist[b];
+        if (seen >= target) {
+            if (b < 4) {
+                return b;
+            }
+            return (4U + (b & 3)) << (b/4 - 1);
+        }
+    }
+    return 0;
+}
+
+void AP_Logger_File::Write_AP_Logger_Latency_File(const struct df_stats &_stats)
+{
+    if (_stats.writes == 0) {
+        return;
+    }
+    struct log_DSFL pkt = {
+        LOG_PACKET_HEADER_INIT(LOG_DF_FILE_LATENCY),
+        time_us : AP_HAL::micros64(),
+        writes  : _stats.writes,
+        p50     : latency_percentile(_stats.write_latency, WRITE_LATENCY_BUCKETS, _stats.writes, 50),
+        p95     : latency_percentile(_stats.write_latency, WRITE_LATENCY_BUCKETS, _stats.writes, 95),
+        p99     : latency_percentile(_stats.write_latency, WRITE_LATENCY_BUCKETS, _stats.writes, 99),
+        max     : _stats.write_latency_max,
+    };
+    WriteBlock(&pkt, sizeof(pkt));
+}
+
 void AP_Logger_File::df_stats_clear() {
     memset(&stats, '\0', sizeof(stats));
     stats.buf_space_min = -1;
@@ -1127,6 +1585,7 @@ void AP_Logger_File::df_stats_clear() {
 
 void AP_Logger_File::df_stats_log() {
     Write_AP_Logger_Stats_File(stats);
+    Write_AP_Logger_Latency_File(stats);
     df_stats_clear();
 }
 
@@ -10,6 +10,8 @@
 
 #include <AP_HAL/utility/RingBuffer.h>
 #include "AP_Logger_Backend.h"
+#include "LogCompress.h"
+#include "AP_Logger_FileIndex.h"
 
 class AP_Logger_File : public AP_Logger_Backend
 {
@@ -32,6 +34,8 @@ public:
 
     /* Write a block of data at current offset */
     bool _WritePrioritisedBlock(const void *pBuffer, uint16_t size, bool is_critical) override;
+    void *_ReservePrioritisedBlock(uint16_t size, bool is_critical) override;
+    void _CommitReservedBlock(uint16_t size) override;
     uint32_t bufferspace_available() override;
 
     // high level interface
@@ -83,6 +87,28 @@ private:
 
     uint16_t _log_num_from_list_entry(const uint16_t list_entry);
 
+    // read-ahead of the log being downloaded, filled by the IO thread
+    // so get_log_data() rarely has to wait on the filesystem.  The
+    // want_ fields are set by the reader, the rest by the IO thread
+    struct {
+        uint8_t *buf;
+        uint16_t want_log_num; // zero to close the file and free buf
+        uint32_t want_ofs;     // offset the reader expects to read next
+        uint16_t log_num;      // log open on fd
+        int fd;
+        uint32_t ofs;          // file offset of buf[0]
+        uint32_t len;          // bytes of buf holding file data
+        bool eof;              // file ends at ofs+len
+    } _readahead;
+    HAL_Semaphore _readahead_sem;
+    void read_ahead();
+    int16_t read_ahead_get(uint16_t log_num, uint32_t ofs, uint16_t len, uint8_t *data);
+    void read_ahead_stop();
+
+    // write the perf counter trace once a log has been closed
+    volatile bool _trace_dump_pending = false;
+    void write_trace();
+
     // possibly time-consuming preparations handling
     void Prep_MinSpace();
     uint16_t find_oldest_log();
@@ -104,6 +130,22 @@ private:
     const uint16_t _writebuf_chunk;
     uint32_t _last_write_time;
 
+    // optional compression of the write stream.  A compressed frame
+    // is held in _compress_buf until it has been completely written
+    LogCompressor *_compressor = nullptr;
+    uint8_t *_compress_buf = nullptr;
+    uint32_t _compress_len = 0;
+    uint32_t _compress_ofs = 0;
+
+    // optional index appended to each log when it is closed.
+    // _index_ofs counts the bytes accepted into _writebuf for the
+    // current log, which is where they will land in the file
+    AP_Logger_FileIndex *_index = nullptr;
+    uint32_t _index_ofs;
+    uint8_t *_reserved_block;
+    void index_message(const uint8_t *msg, uint16_t size);
+    void write_index(int fd);
+
     /* construct a file name given a log number. Caller must free. */
     char *_log_file_name(const uint16_t log_num) const;
     char *_log_file_name_long(const uint16_t log_num) const;
@@ -160,17 +202,36 @@ private:
 
     const char *last_io_operation = "";
 
+#if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+    // the file is preallocated ahead of the write offset and written
+    // back with sync_file_range rather than fsync
+    uint32_t _prealloc_offset;
+    uint32_t _synced_offset;
+    bool _prealloc_failed;
+    void preallocate(uint32_t write_end);
+    void sync_written(uint32_t ofs, uint32_t len);
+#endif
+
+    // write latencies are binned in quarter-octaves of microseconds,
+    // giving percentiles to within 25% up to 16 seconds
+    static const uint8_t WRITE_LATENCY_BUCKETS = 92;
+
     struct df_stats {
         uint16_t blocks;
         uint32_t bytes;
         uint32_t buf_space_min;
         uint32_t buf_space_max;
         uint32_t buf_space_sigma;
+        uint16_t writes;
+        uint16_t write_latency[WRITE_LATENCY_BUCKETS];
+        uint32_t write_latency_max;
     };
     struct df_stats stats;
 
     void Write_AP_Logger_Stats_File(const struct df_stats &_stats);
+    void Write_AP_Logger_Latency_File(const struct df_stats &_stats);
     void df_stats_gather(uint16_t bytes_written);
+    void df_stats_gather_latency(uint32_t write_us);
     void df_stats_log();
     void df_stats_clear();
 
@@ -0,0 +1,291 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_Logger_FileIndex.h"
+
+#include <AP_HAL/AP_HAL.h>
+
+#if HAL_OS_POSIX_IO || HAL_OS_FATFS_IO
+
+#include <stdlib.h>
+#include <string.h>
+#if HAL_OS_POSIX_IO
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+#if HAL_OS_FATFS_IO
+#include <stdio.h>
+#endif
+
+AP_Logger_FileIndex::~AP_Logger_FileIndex()
+{
+    free(_data);
+}
+
+bool AP_Logger_FileIndex::init()
+{
+    if (_data == nullptr) {
+        _data = (struct storage *)calloc(1, sizeof(struct storage));
+        if (_data == nullptr) {
+            return false;
+        }
+    }
+    reset();
+    return true;
+}
+
+void AP_Logger_FileIndex::reset()
+{
+    if (_data != nullptr) {
+        memset(_data, 0, sizeof(*_data));
+    }
+    _num_times = 0;
+    _interval_us = INITIAL_INTERVAL_US;
+    _next_time_us = 0;
+    _startup_end = 0;
+}
+
+void AP_Logger_FileIndex::note_message(const uint64_t now_us, const uint32_t ofs, const uint8_t *msg, const uint16_t len)
+{
+    if (_data == nullptr || len < 3 || msg[0] != HEAD_BYTE1 || msg[1] != HEAD_BYTE2) {
+        return;
+    }
+    const uint8_t type = msg[2];
+    _data->counts[type]++;
+
+    if (!startup_done()) {
+        // the reader always processes the startup messages
+        return;
+    }
+
+    if (type == LOG_FORMAT_MSG && len >= sizeof(struct log_Format)) {
+        const uint8_t defined = ((const struct log_Format *)msg)->type;
+        if (_data->format_ofs[defined] == 0) {
+            _data->format_ofs[defined] = ofs;
+        }
+    }
+
+    if (now_us < _next_time_us) {
+        return;
+    }
+    if (_num_times == MAX_TIMES) {
+        // halve the resolution to make room
+        for (uint16_t i=0; i<MAX_TIMES/2; i++) {
+            _data->times[i] = _data->times[i*2];
+        }
+        _num_times = MAX_TIMES/2;
+        _interval_us *= 2;
+        const uint64_t next_us = _data->times[_num_times-1].time_us + _interval_us;
+        if (now_us < next_us) {
+            _next_time_us = next_us;
+            return;
+        }
+    }
+    _data->times[_num_times].time_us = now_us;
+    _data->times[_num_times].ofs = ofs;
+    _num_times++;
+    _next_time_us = now_us + _interval_us;
+}
+
+void AP_Logger_FileIndex::note_startup_done(const uint32_t ofs)
+{
+    if (_startup_end == 0) {
+        _startup_end = ofs;
+    }
+}
+
+/*
+  add a message to the index being written, writing out buf first if
+  it is full
+ */
+bool AP_Logger_FileIndex::append(const int fd, struct write_buffer &wb, const void *pkt, const uint16_t size) const
+{
+    if (wb.len + size > sizeof(wb.buf)) {
+        if (::write(fd, wb.buf, wb.len) != (ssize_t)wb.len) {
+            return false;
+        }
+        wb.len = 0;
+    }
+    memcpy(&wb.buf[wb.len], pkt, size);
+    wb.len += size;
+    return true;
+}
+
+bool AP_Logger_FileIndex::write(const int fd, const uint32_t end_ofs) const
+{
+    if (_data == nullptr || !startup_done() || _startup_end > end_ofs) {
+        // nothing worth indexing
+        return true;
+    }
+
+    // messages are gathered to keep the number of writes down
+    struct write_buffer wb;
+    wb.len = 0;
+    bool ok = true;
+
+    struct log_IndexEnd end {
+        LOG_PACKET_HEADER_INIT(LOG_INDEX_END_MSG),
+        start       : end_ofs,
+        startup_end : _startup_end,
+        num_times   : 0,
+        num_formats : 0,
+        num_counts  : 0,
+    };
+
+    for (uint16_t i=0; i<_num_times && _data->times[i].ofs < end_ofs; i++) {
+        const struct log_Index pkt {
+            LOG_PACKET_HEADER_INIT(LOG_INDEX_MSG),
+            kind  : ENTRY_TIME,
+            key   : _data->times[i].time_us,
+            value : _data->times[i].ofs,
+        };
+        ok = ok && append(fd, wb, &pkt, sizeof(pkt));
+        end.num_times++;
+    }
+    for (uint16_t type=0; type<256; type++) {
+        const uint32_t fmt_ofs = _data->format_ofs[type];
+        if (fmt_ofs == 0 || fmt_ofs >= end_ofs) {
+            continue;
+        }
+        const struct log_Index pkt {
+            LOG_PACKET_HEADER_INIT(LOG_INDEX_MSG),
+            kind  : ENTRY_FORMAT,
+            key   : type,
+            value : fmt_ofs,
+        };
+        ok = ok && append(fd, wb, &pkt, sizeof(pkt));
+        end.num_formats++;
+    }
+    for (uint16_t type=0; type<256; type++) {
+        if (_data->counts[type] == 0) {
+            continue;
+        }
+        const struct log_Index pkt {
+            LOG_PACKET_HEADER_INIT(LOG_INDEX_MSG),
+            kind  : ENTRY_COUNT,
+            key   : type,
+            value : _data->counts[type],
+        };
+        ok = ok && append(fd, wb, &pkt, sizeof(pkt));
+        end.num_counts++;
+    }
+    ok = ok && append(fd, wb, &end, sizeof(end));
+
+    if (ok && wb.len > 0) {
+        ok = (::write(fd, wb.buf, wb.len) == (ssize_t)wb.len);
+    }
+    return ok;
+}
+
+bool AP_Logger_FileIndex::load(const int fd)
+{
+    struct log_IndexEnd end;
+    const off_t size = ::lseek(fd, 0, SEEK_END);
+    if (size < (off_t)sizeof(end) || size > (off_t)UINT32_MAX) {
+        return false;
+    }
+    const uint32_t end_ofs = size - sizeof(end);
+    if (::lseek(fd, end_ofs, SEEK_SET) == (off_t)-1 ||
+        ::read(fd, &end, sizeof(end)) != sizeof(end)) {
+        return false;
+    }
+    if (end.head1 != HEAD_BYTE1 || end.head2 != HEAD_BYTE2 ||
+        end.msgid != LOG_INDEX_END_MSG ||
+        end.num_times > MAX_TIMES || end.num_formats > 256 || end.num_counts > 256) {
+        return false;
+    }
+    const uint32_t num_entries = end.num_times + end.num_formats + end.num_counts;
+    const uint32_t index_len = num_entries * sizeof(struct log_Index);
+    if (end.start > end_ofs || end_ofs - end.start != index_len ||
+        end.startup_end > end.start) {
+        return false;
+    }
+
+    uint8_t *buf = (uint8_t *)malloc(index_len);
+    if (buf == nullptr && index_len != 0) {
+        return false;
+    }
+    bool ok = (::lseek(fd, end.start, SEEK_SET) != (off_t)-1 &&
+               ::read(fd, buf, index_len) == (ssize_t)index_len &&
+               init());
+
+    const struct log_Index *entries = (const struct log_Index *)buf;
+    for (uint16_t i=0; ok && i<num_entries; i++) {
+        const struct log_Index &e = entries[i];
+        enum entry_kind kind = ENTRY_COUNT;
+        if (i < end.num_times) {
+            kind = ENTRY_TIME;
+        } else if (i < end.num_times + end.num_formats) {
+            kind = ENTRY_FORMAT;
+        }
+        if (e.head1 != HEAD_BYTE1 || e.head2 != HEAD_BYTE2 ||
+            e.msgid != LOG_INDEX_MSG || e.kind != kind ||
+            (kind != ENTRY_TIME && e.key > UINT8_MAX)) {
+            ok = false;
+            break;
+        }
+        switch (kind) {
+        case ENTRY_TIME:
+            _data->times[i].time_us = e.key;
+            _data->times[i].ofs = e.value;
+            break;
+        case ENTRY_FORMAT:
+            _data->format_ofs[e.key] = e.value;
+            break;
+        case ENTRY_COUNT:
+            _data->counts[e.key] = e.value;
+            break;
+        }
+    }
+    free(buf);
+
+    if (!ok) {
+        reset();
+        return false;
+    }
+    _num_times = end.num_times;
+    _startup_end = end.startup_end;
+    return true;
+}
+
+uint32_t AP_Logger_FileIndex::offset_for_time(const uint64_t time_us) const
+{
+    uint32_t ret = _startup_end;
+    if (_data == nullptr) {
+        return ret;
+    }
+    for (uint16_t i=0; i<_num_times && _data->times[i].time_us <= time_us; i++) {
+        ret = _data->times[i].ofs;
+    }
+    return ret;
+}
+
+uint32_t AP_Logger_FileIndex::format_offset(const uint8_t type) const
+{
+    if (_data == nullptr) {
+        return 0;
+    }
+    return _data->format_ofs[type];
+}
+
+uint32_t AP_Logger_FileIndex::count(const uint8_t type) const
+{
+    if (_data == nullptr) {
+        return 0;
+    }
+    return _data->counts[type];
+}
+
+#endif // HAL_OS_POSIX_IO || HAL_OS_FATFS_IO
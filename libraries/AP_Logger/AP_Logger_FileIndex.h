@@ -0,0 +1,91 @@
+/*
+  seekable index for AP_Logger_File logs
+
+  While logging, the offset of the log at regular intervals, the
+  offset of every format message written after the startup messages
+  and the number of messages of each type are gathered.  When the log
+  is closed these are appended as IDX messages, times first, then
+  formats, then counts, followed by a single IDXE message which must
+  be the last thing in the file.  A reader finds IDXE at the end of the file, and from it
+  the rest of the index, so it can seek straight to a time while
+  still seeing every format definition.
+
+  Offsets are 32 bits, so only the first 4GB of a log are indexed.
+ */
+#pragma once
+
+#include "LogStructure.h"
+
+class AP_Logger_FileIndex {
+public:
+
+    // time entries kept; when full every other entry is dropped and
+    // the interval doubled, so any length of log fits
+    static const uint16_t MAX_TIMES = 256;
+    static const uint32_t INITIAL_INTERVAL_US = 1000000;
+
+    enum entry_kind : uint8_t {
+        ENTRY_TIME = 0,    // key is a time, value its offset
+        ENTRY_FORMAT = 1,  // key is a message type, value the offset of its FMT
+        ENTRY_COUNT = 2,   // key is a message type, value its count
+    };
+
+    ~AP_Logger_FileIndex();
+
+    // allocate the index; returns false if out of memory
+    bool init();
+
+    // forget everything, ready for a new log
+    void reset();
+
+    // the len bytes at msg, starting with a message header, have
+    // been accepted to be written at offset ofs
+    void note_message(uint64_t now_us, uint32_t ofs, const uint8_t *msg, uint16_t len);
+
+    // all messages before offset ofs are startup messages
+    void note_startup_done(uint32_t ofs);
+    bool startup_done() const { return _startup_end != 0; }
+
+    // append the index to fd, which is positioned at end_ofs.  Only
+    // data before end_ofs is indexed.  Returns false on write error
+    bool write(int fd, uint32_t end_ofs) const;
+
+    // read the index from the end of a log.  Returns false if the
+    // log has no index
+    bool load(int fd);
+
+    // offset to start reading from to see all messages from time_us,
+    // or the end of the startup messages if time_us is before the
+    // first entry
+    uint32_t offset_for_time(uint64_t time_us) const;
+
+    uint32_t startup_end() const { return _startup_end; }
+
+    // offset of the format message for type written after the
+    // startup messages, or 0 if there isn't one
+    uint32_t format_offset(uint8_t type) const;
+
+    uint32_t count(uint8_t type) const;
+
+private:
+    struct time_entry {
+        uint64_t time_us;
+        uint32_t ofs;
+    };
+    struct storage {
+        struct time_entry times[MAX_TIMES];
+        uint32_t format_ofs[256];
+        uint32_t counts[256];
+    } *_data = nullptr;
+
+    struct write_buffer {
+        uint8_t buf[256];
+        uint16_t len;
+    };
+    bool append(int fd, struct write_buffer &wb, const void *pkt, uint16_t size) const;
+
+    uint16_t _num_times;
+    uint32_t _interval_us = INITIAL_INTERVAL_US;
+    uint64_t _next_time_us;
+    uint32_t _startup_end;
+};
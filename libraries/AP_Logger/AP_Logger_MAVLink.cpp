@@ -18,10 +18,24 @@
 #endif
 
 #include <AP_InternalError/AP_InternalError.h>
+#include <AP_Math/AP_Math.h>
 #include <GCS_MAVLink/GCS.h>
 
 extern const AP_HAL::HAL& hal;
 
+// adaptive window limits
+#define DM_WINDOW_MIN 4
+#define DM_RESEND_TIMEOUT_MIN_MS 100
+#define DM_RESEND_TIMEOUT_MAX_MS 3000
+// resend timeout before we have a round-trip time measurement
+#define DM_RESEND_TIMEOUT_INITIAL_MS 1000
+
+// RADIO_STATUS txbuf (percent free) below which the window stops
+// growing, and below which it is treated as a loss
+#define DM_RADIO_TXBUF_LOW 50
+#define DM_RADIO_TXBUF_CRITICAL 20
+#define DM_RADIO_STATUS_TIMEOUT_MS 3000
+
 
 // initialisation
 void AP_Logger_MAVLink::Init()
@@ -97,18 +111,13 @@ struct AP_Logger_MAVLink::dm_block *AP_Logger_MAVLink::dequeue_seqno(AP_Logger_M
     return nullptr;
 }
 
-bool AP_Logger_MAVLink::free_seqno_from_queue(uint32_t seqno, dm_block_queue_t &queue)
+void AP_Logger_MAVLink::free_block(struct dm_block *block)
 {
-    struct dm_block *block = dequeue_seqno(queue, seqno);
-    if (block != nullptr) {
-        block->next = _blocks_free;
-        _blocks_free = block;
-        _blockcount_free++; // comment me out to expose a bug!
-        return true;
-    }
-    return false;
+    block->next = _blocks_free;
+    _blocks_free = block;
+    _blockcount_free++; // comment me out to expose a bug!
 }
-    
+
 
 bool AP_Logger_MAVLink::WritesOK() const
 {
@@ -181,6 +190,7 @@ struct AP_Logger_MAVLink::dm_block *AP_Logger_MAVLink::next_block()
         _blockcount_free--;
         ret->seqno = _next_seq_num++;
         ret->last_sent = 0;
+        ret->send_count = 0;
         ret->next = nullptr;
         _latest_block_len = 0;
     }
@@ -210,8 +220,85 @@ void AP_Logger_MAVLink::free_all_blocks()
         _blocks[i].seqno = 9876543;
     }
     _blockcount_free = _blockcount;
+    _blocks_in_flight = 0;
 
     _latest_block_len = 0;
+
+    window_reset();
+}
+
+void AP_Logger_MAVLink::window_reset()
+{
+    _window.size = DM_WINDOW_MIN;
+    _window.threshold = _blockcount;
+    _window.last_decrease_ms = 0;
+    _srtt_ms = 0;
+    _rttvar_ms = 0;
+}
+
+// called with the semaphore held when block is acked
+void AP_Logger_MAVLink::window_ack(const uint32_t now, const struct dm_block &block)
+{
+    if (block.send_count == 1) {
+        // RFC6298 estimator; resent blocks are ambiguous so ignored
+        const float sample = now - block.last_sent;
+        if (is_zero(_srtt_ms)) {
+            _srtt_ms = sample;
+            _rttvar_ms = sample * 0.5f;
+        } else {
+            _rttvar_ms = 0.75f * _rttvar_ms + 0.25f * fabsf(_srtt_ms - sample);
+            _srtt_ms = 0.875f * _srtt_ms + 0.125f * sample;
+        }
+    }
+
+    if (_window.radio_txbuf_ms != 0 &&
+        now - _window.radio_txbuf_ms < DM_RADIO_STATUS_TIMEOUT_MS &&
+        _window.radio_txbuf < DM_RADIO_TXBUF_LOW) {
+        // the radio is queueing; more blocks in flight only adds latency
+        return;
+    }
+    if (_window.size < _window.threshold) {
+        _window.size += 1;
+    } else {
+        _window.size += 1.0f / _window.size;
+    }
+    if (_window.size > _blockcount) {
+        _window.size = _blockcount;
+    }
+}
+
+// called with the semaphore held when a block is NACKed or times out
+void AP_Logger_MAVLink::window_loss(const uint32_t now)
+{
+    if (_window.last_decrease_ms != 0 &&
+        now - _window.last_decrease_ms < _srtt_ms) {
+        // part of a loss event we have already reacted to
+        return;
+    }
+    _window.last_decrease_ms = now;
+    _window.threshold = _window.size * 0.5f;
+    if (_window.threshold < DM_WINDOW_MIN) {
+        _window.threshold = DM_WINDOW_MIN;
+    }
+    _window.size = _window.threshold;
+}
+
+bool AP_Logger_MAVLink::window_full() const
+{
+    return adaptive() && _blocks_in_flight >= (uint8_t)_window.size;
+}
+
+uint32_t AP_Logger_MAVLink::resend_timeout_ms() const
+{
+    if (!adaptive()) {
+        return 100;
+    }
+    if (is_zero(_srtt_ms)) {
+        return DM_RESEND_TIMEOUT_INITIAL_MS;
+    }
+    return constrain_float(_srtt_ms + 4 * _rttvar_ms,
+                           DM_RESEND_TIMEOUT_MIN_MS,
+                           DM_RESEND_TIMEOUT_MAX_MS);
 }
 
 void AP_Logger_MAVLink::stop_logging()
@@ -257,15 +344,22 @@ void AP_Logger_MAVLink::handle_ack(mavlink_channel_t chan,
     }
 
     // check SENT blocks (VERY likely to be first on the list):
-    if (free_seqno_from_queue(seqno, _blocks_sent)) {
+    struct dm_block *block = dequeue_seqno(_blocks_sent, seqno);
+    if (block != nullptr) {
         // celebrate
-        _last_response_time = AP_HAL::millis();
-    } else if(free_seqno_from_queue(seqno, _blocks_retry)) {
-        // party
-        _last_response_time = AP_HAL::millis();
+        _blocks_in_flight--;
     } else {
+        block = dequeue_seqno(_blocks_retry, seqno);
+    }
+    if (block == nullptr) {
         // probably acked already and put on the free list.
+        return;
     }
+    const uint32_t now = AP_HAL::millis();
+    _last_response_time = now;
+    stats.acked_bytes += sizeof(block->buf);
+    window_ack(now, *block);
+    free_block(block);
 }
 
 void AP_Logger_MAVLink::remote_log_block_status_msg(mavlink_channel_t chan,
@@ -292,14 +386,36 @@ void AP_Logger_MAVLink::handle_retry(uint32_t seqno)
 
     struct dm_block *victim = dequeue_seqno(_blocks_sent, seqno);
     if (victim != nullptr) {
-        _last_response_time = AP_HAL::millis();
+        const uint32_t now = AP_HAL::millis();
+        _last_response_time = now;
+        _blocks_in_flight--;
         enqueue_block(_blocks_retry, victim);
+        window_loss(now);
+    }
+}
+
+void AP_Logger_MAVLink::remote_log_radio_status(mavlink_channel_t chan, uint8_t txbuf)
+{
+    if (!_initialised || !_sending_to_client || chan != _chan) {
+        return;
+    }
+    if (!semaphore.take_nonblocking()) {
+        return;
     }
+    const uint32_t now = AP_HAL::millis();
+    _window.radio_txbuf = txbuf;
+    _window.radio_txbuf_ms = now;
+    if (adaptive() && txbuf < DM_RADIO_TXBUF_CRITICAL) {
+        // the radio will start dropping packets soon
+        window_loss(now);
+    }
+    semaphore.give();
 }
 
 void AP_Logger_MAVLink::stats_init() {
     _dropped = 0;
     stats.resends = 0;
+    _stats_last_logged_time = AP_HAL::millis();
     stats_reset();
 }
 void AP_Logger_MAVLink::stats_reset() {
@@ -316,6 +432,7 @@ void AP_Logger_MAVLink::stats_reset() {
     stats.state_sent_min = -1; // unsigned wrap
     stats.state_sent_max = 0;
     stats.collection_count = 0;
+    stats.acked_bytes = 0;
 }
 
 void AP_Logger_MAVLink::Write_logger_MAV(AP_Logger_MAVLink &logger_mav)
@@ -323,9 +440,15 @@ void AP_Logger_MAVLink::Write_logger_MAV(AP_Logger_MAVLink &logger_mav)
     if (logger_mav.stats.collection_count == 0) {
         return;
     }
+    const uint32_t now = AP_HAL::millis();
+    uint32_t throughput = 0;
+    if (now > logger_mav._stats_last_logged_time) {
+        throughput = (uint64_t)logger_mav.stats.acked_bytes * 1000 / (now - logger_mav._stats_last_logged_time);
+    }
+    logger_mav._stats_last_logged_time = now;
     struct log_MAV_Stats pkt = {
         LOG_PACKET_HEADER_INIT(LOG_MAV_STATS),
-        timestamp         : AP_HAL::millis(),
+        timestamp         : now,
         seqno             : logger_mav._next_seq_num-1,
         dropped           : logger_mav._dropped,
         retries           : logger_mav._blocks_retry.sent_count,
@@ -339,6 +462,9 @@ void AP_Logger_MAVLink::Write_logger_MAV(AP_Logger_MAVLink &logger_mav)
         state_sent_avg    : (uint8_t)(logger_mav.stats.state_sent/logger_mav.stats.collection_count),
         state_sent_min    : logger_mav.stats.state_sent_min,
         state_sent_max    : logger_mav.stats.state_sent_max,
+        window            : (uint8_t)(logger_mav.adaptive() ? logger_mav._window.size : 0),
+        rtt               : (uint16_t)MIN(logger_mav._srtt_ms, (float)UINT16_MAX),
+        throughput        : throughput,
     };
     WriteBlock(&pkt,sizeof(pkt));
 }
@@ -448,6 +574,9 @@ bool AP_Logger_MAVLink::send_log_blocks_from_queue(dm_block_queue_t &queue)
         if (sent_count++ > _max_blocks_per_send_blocks) {
             return false;
         }
+        if (window_full()) {
+            return false;
+        }
         if (! send_log_block(*queue.oldest)) {
             return false;
         }
@@ -455,6 +584,7 @@ bool AP_Logger_MAVLink::send_log_blocks_from_queue(dm_block_queue_t &queue)
         struct AP_Logger_MAVLink::dm_block *tmp = dequeue_seqno(queue,queue.oldest->seqno);
         if (tmp != nullptr) { // should never be nullptr
             enqueue_block(_blocks_sent, tmp);
+            _blocks_in_flight++;
         } else {
             AP::internalerror().error(AP_InternalError::error_t::logger_dequeue_failure);
         }
@@ -496,7 +626,7 @@ void AP_Logger_MAVLink::do_resends(uint32_t now)
     if (_blockcount < count_to_send) {
         count_to_send = _blockcount;
     }
-    uint32_t oldest = now - 100; // 100 milliseconds before resend.  Hmm.
+    uint32_t oldest = now - resend_timeout_ms();
     while (count_to_send-- > 0) {
         if (!semaphore.take_nonblocking()) {
             return;
@@ -510,6 +640,9 @@ void AP_Logger_MAVLink::do_resends(uint32_t now)
                     return;
                 }
                 stats.resends++;
+                if (adaptive()) {
+                    window_loss(now);
+                }
             }
         }
         semaphore.give();
@@ -587,6 +720,9 @@ bool AP_Logger_MAVLink::send_log_block(struct dm_block &block)
 #endif
 
     block.last_sent = AP_HAL::millis();
+    if (block.send_count < UINT8_MAX) {
+        block.send_count++;
+    }
     chan_status->current_tx_seq = saved_seq;
 
     // _last_send_time is set even if we fail to send the packet; if
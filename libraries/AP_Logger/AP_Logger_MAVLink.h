@@ -62,6 +62,7 @@ public:
     void push_log_blocks() override;
 
     void remote_log_block_status_msg(mavlink_channel_t chan, mavlink_message_t* msg) override;
+    void remote_log_radio_status(mavlink_channel_t chan, uint8_t txbuf) override;
 
 protected:
 
@@ -73,6 +74,7 @@ private:
         uint32_t seqno;
         uint8_t buf[MAVLINK_MSG_REMOTE_LOG_DATA_BLOCK_FIELD_DATA_LEN];
         uint32_t last_sent;
+        uint8_t send_count; // only blocks sent once give an RTT sample
         struct dm_block *next;
     };
     bool send_log_block(struct dm_block &block);
@@ -91,7 +93,7 @@ private:
     void enqueue_block(dm_block_queue_t &queue, struct dm_block *block);
     bool queue_has_block(dm_block_queue_t &queue, struct dm_block *block);
     struct dm_block *dequeue_seqno(dm_block_queue_t &queue, uint32_t seqno);
-    bool free_seqno_from_queue(uint32_t seqno, dm_block_queue_t &queue);
+    void free_block(struct dm_block *block);
     bool send_log_blocks_from_queue(dm_block_queue_t &queue);
     uint8_t stack_size(struct dm_block *stack);
     uint8_t queue_size(dm_block_queue_t queue);
@@ -100,10 +102,33 @@ private:
     dm_block_queue_t _blocks_sent;
     dm_block_queue_t _blocks_pending;
     dm_block_queue_t _blocks_retry;
+    uint8_t _blocks_in_flight; // length of _blocks_sent
+
+    // adaptive window, used when LOG_MAV_ADAPT is set.  The number of
+    // blocks in flight grows by one per acked block until the first
+    // loss and by one per window after that, and halves at most once
+    // per round trip on loss, so a burst of NACKs counts as one loss
+    struct {
+        float size;
+        float threshold;
+        uint32_t last_decrease_ms;
+        uint8_t radio_txbuf;
+        uint32_t radio_txbuf_ms;
+    } _window;
+    // smoothed round-trip time and its mean deviation, in ms
+    float _srtt_ms;
+    float _rttvar_ms;
+    bool adaptive() const { return _front._params.mav_adaptive != 0; }
+    void window_reset();
+    void window_ack(uint32_t now, const struct dm_block &block);
+    void window_loss(uint32_t now);
+    bool window_full() const;
+    uint32_t resend_timeout_ms() const;
 
     struct _stats {
         // the following are reset any time we log stats (see "reset_stats")
         uint32_t resends;
+        uint32_t acked_bytes;
         uint8_t collection_count;
         uint16_t state_free; // cumulative across collection period
         uint8_t state_free_min;
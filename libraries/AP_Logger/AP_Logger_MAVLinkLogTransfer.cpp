@@ -106,20 +106,22 @@ void AP_Logger::handle_log_request_data(GCS_MAVLINK &link, mavlink_message_t *ms
 {
     WITH_SEMAPHORE(_log_send_sem);
 
+    mavlink_log_request_data_t packet;
+    mavlink_msg_log_request_data_decode(msg, &packet);
+
     if (_log_sending_link != nullptr) {
         // some GCS (e.g. MAVProxy) attempt to stream request_data
         // messages when they're filling gaps in the downloaded logs.
-        // This channel check avoids complaining to them, at the cost
-        // of silently dropping any repeated attempts to start logging
+        // This channel check avoids complaining to them, and requests
+        // for the log being sent are queued behind the current range
         if (_log_sending_link->get_chan() != link.get_chan()) {
             link.send_text(MAV_SEVERITY_INFO, "Log download in progress");
+        } else if (transfer_activity == SENDING && packet.id == _log_num_data) {
+            queue_log_data_range(packet.ofs, packet.count);
         }
         return;
     }
 
-    mavlink_log_request_data_t packet;
-    mavlink_msg_log_request_data_decode(msg, &packet);
-
     // consider opening or switching logs:
     if (transfer_activity != SENDING || _log_num_data != packet.id) {
 
@@ -139,20 +141,69 @@ void AP_Logger::handle_log_request_data(GCS_MAVLINK &link, mavlink_message_t *ms
         get_log_boundaries(packet.id, _log_data_page, end);
     }
 
-    _log_data_offset = packet.ofs;
+    set_log_data_range(packet.ofs, packet.count);
+    _log_data_range_count = 0;
+
+    transfer_activity = SENDING;
+    _log_sending_link = &link;
+
+    handle_log_send();
+}
+
+/**
+   make ofs/count the range of _log_num_data being sent
+ */
+void AP_Logger::set_log_data_range(uint32_t ofs, uint32_t count)
+{
+    _log_data_offset = ofs;
     if (_log_data_offset >= _log_data_size) {
         _log_data_remaining = 0;
     } else {
         _log_data_remaining = _log_data_size - _log_data_offset;
     }
-    if (_log_data_remaining > packet.count) {
-        _log_data_remaining = packet.count;
+    if (_log_data_remaining > count) {
+        _log_data_remaining = count;
     }
+}
 
-    transfer_activity = SENDING;
-    _log_sending_link = &link;
+/**
+   remember a range to send after the current one
+ */
+void AP_Logger::queue_log_data_range(uint32_t ofs, uint32_t count)
+{
+    if (ofs == _log_data_offset) {
+        // repeat of the range being sent
+        return;
+    }
+    for (uint8_t i=0; i<_log_data_range_count; i++) {
+        if (_log_data_ranges[i].ofs == ofs) {
+            if (_log_data_ranges[i].count < count) {
+                _log_data_ranges[i].count = count;
+            }
+            return;
+        }
+    }
+    if (_log_data_range_count >= LOG_DATA_RANGES_MAX) {
+        // the GCS will ask again for anything it is missing
+        return;
+    }
+    _log_data_ranges[_log_data_range_count].ofs = ofs;
+    _log_data_ranges[_log_data_range_count].count = count;
+    _log_data_range_count++;
+}
 
-    handle_log_send();
+/**
+   move on to the oldest queued range; returns false if none are queued
+ */
+bool AP_Logger::start_next_log_data_range()
+{
+    if (_log_data_range_count == 0) {
+        return false;
+    }
+    set_log_data_range(_log_data_ranges[0].ofs, _log_data_ranges[0].count);
+    _log_data_range_count--;
+    memmove(&_log_data_ranges[0], &_log_data_ranges[1], _log_data_range_count*sizeof(_log_data_ranges[0]));
+    return true;
 }
 
 /**
@@ -177,6 +228,7 @@ void AP_Logger::handle_log_request_end(GCS_MAVLINK &link, mavlink_message_t *msg
 
     transfer_activity = IDLE;
     _log_sending_link = nullptr;
+    _log_data_range_count = 0;
 }
 
 /**
@@ -211,20 +263,19 @@ void AP_Logger::handle_log_sending()
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
     // assume USB speeds in SITL for the purposes of log download
-    const uint8_t num_sends = 40;
+    const bool fast_link = true;
 #else
+    const bool fast_link = (_log_sending_link->is_high_bandwidth() && hal.gpio->usb_connected()) ||
+        _log_sending_link->have_flow_control();
+#endif
     uint8_t num_sends = 1;
-    if (_log_sending_link->is_high_bandwidth() && hal.gpio->usb_connected()) {
-        // when on USB we can send a lot more data
-        num_sends = 250;
-    } else if (_log_sending_link->have_flow_control()) {
-    #if CONFIG_HAL_BOARD == HAL_BOARD_LINUX
-        num_sends = 80;
-    #else
-        num_sends = 10;
-    #endif
+    if (fast_link) {
+        // fill the space the link has, but bound the time spent in
+        // any one loop
+        const uint16_t packet_len = MAVLINK_MSG_ID_LOG_DATA_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+        const uint16_t fit = comm_get_txspace(_log_sending_link->get_chan()) / packet_len;
+        num_sends = MIN(fit, (uint16_t)250U);
     }
-#endif
 
     for (uint8_t i=0; i<num_sends; i++) {
         if (transfer_activity != SENDING) {
@@ -319,8 +370,10 @@ bool AP_Logger::handle_log_send_data()
     _log_data_offset += len;
     _log_data_remaining -= len;
     if (ret < MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN || _log_data_remaining == 0) {
-        transfer_activity = IDLE;
-        _log_sending_link = nullptr;
+        if (!start_next_log_data_range()) {
+            transfer_activity = IDLE;
+            _log_sending_link = nullptr;
+        }
     }
     return true;
 }
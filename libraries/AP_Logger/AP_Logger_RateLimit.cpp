@@ -0,0 +1,150 @@
+#include "AP_Logger_RateLimit.h"
+
+#include "AP_Logger.h"
+
+extern const AP_HAL::HAL& hal;
+
+const AP_Param::GroupInfo AP_Logger_RateLimit::var_info[] = {
+    // @Param: 1_ID
+    // @DisplayName: Rate limit 1 first message ID
+    // @Description: ID of the first log message type this rate limit applies to, as found in the FMT messages of a log.  Zero disables the limit
+    // @Range: 0 255
+    // @User: Advanced
+    AP_GROUPINFO("1_ID",  1, AP_Logger_RateLimit, _limit[0].msg_id, 0),
+
+    // @Param: 1_CNT
+    // @DisplayName: Rate limit 1 message ID count
+    // @Description: Number of consecutive message IDs, starting at the first message ID, this rate limit applies to.  Each ID is limited separately
+    // @Range: 1 32
+    // @User: Advanced
+    AP_GROUPINFO("1_CNT", 2, AP_Logger_RateLimit, _limit[0].msg_count, 1),
+
+    // @Param: 1_HZ
+    // @DisplayName: Rate limit 1 rate
+    // @Description: Maximum rate at which each of the message types is logged.  Messages of the same type logged in one burst, such as one per EKF core, count as one.  Zero disables the limit
+    // @Units: Hz
+    // @Range: 0 1000
+    // @User: Advanced
+    AP_GROUPINFO("1_HZ",  3, AP_Logger_RateLimit, _limit[0].rate_hz, 0),
+
+    // @Param: 2_ID
+    // @CopyFieldsFrom: LOG_RL_1_ID
+    // @DisplayName: Rate limit 2 first message ID
+    AP_GROUPINFO("2_ID",  4, AP_Logger_RateLimit, _limit[1].msg_id, 0),
+
+    // @Param: 2_CNT
+    // @CopyFieldsFrom: LOG_RL_1_CNT
+    // @DisplayName: Rate limit 2 message ID count
+    AP_GROUPINFO("2_CNT", 5, AP_Logger_RateLimit, _limit[1].msg_count, 1),
+
+    // @Param: 2_HZ
+    // @CopyFieldsFrom: LOG_RL_1_HZ
+    // @DisplayName: Rate limit 2 rate
+    AP_GROUPINFO("2_HZ",  6, AP_Logger_RateLimit, _limit[1].rate_hz, 0),
+
+    // @Param: 3_ID
+    // @CopyFieldsFrom: LOG_RL_1_ID
+    // @DisplayName: Rate limit 3 first message ID
+    AP_GROUPINFO("3_ID",  7, AP_Logger_RateLimit, _limit[2].msg_id, 0),
+
+    // @Param: 3_CNT
+    // @CopyFieldsFrom: LOG_RL_1_CNT
+    // @DisplayName: Rate limit 3 message ID count
+    AP_GROUPINFO("3_CNT", 8, AP_Logger_RateLimit, _limit[2].msg_count, 1),
+
+    // @Param: 3_HZ
+    // @CopyFieldsFrom: LOG_RL_1_HZ
+    // @DisplayName: Rate limit 3 rate
+    AP_GROUPINFO("3_HZ",  9, AP_Logger_RateLimit, _limit[2].rate_hz, 0),
+
+    // @Param: 4_ID
+    // @CopyFieldsFrom: LOG_RL_1_ID
+    // @DisplayName: Rate limit 4 first message ID
+    AP_GROUPINFO("4_ID",  10, AP_Logger_RateLimit, _limit[3].msg_id, 0),
+
+    // @Param: 4_CNT
+    // @CopyFieldsFrom: LOG_RL_1_CNT
+    // @DisplayName: Rate limit 4 message ID count
+    AP_GROUPINFO("4_CNT", 11, AP_Logger_RateLimit, _limit[3].msg_count, 1),
+
+    // @Param: 4_HZ
+    // @CopyFieldsFrom: LOG_RL_1_HZ
+    // @DisplayName: Rate limit 4 rate
+    AP_GROUPINFO("4_HZ",  12, AP_Logger_RateLimit, _limit[3].rate_hz, 0),
+
+    AP_GROUPEND
+};
+
+// messages of a limited type logged within this long of the first
+// kept one are treated as part of the same burst, e.g. one per EKF
+// core from a single logging call.  This must be shorter than the
+// fastest main loop period
+#define RATE_LIMIT_BURST_US 500
+
+AP_Logger_RateLimit::AP_Logger_RateLimit()
+{
+    AP_Param::setup_object_defaults(this, var_info);
+}
+
+bool AP_Logger_RateLimit::should_drop(const uint8_t msgid)
+{
+    for (uint8_t i=0; i<LOGGER_NUM_RATE_LIMITS; i++) {
+        const struct limit &l = _limit[i];
+        if (l.msg_id == 0 || l.rate_hz <= 0 ||
+            msgid < l.msg_id || msgid >= l.msg_id + MAX(l.msg_count.get(), 1)) {
+            continue;
+        }
+        // all IDs in the run share one schedule; the messages of a
+        // family are normally logged together in one burst
+        struct limit_state &s = _state[i];
+        const uint32_t now = AP_HAL::micros();
+        if (now - s.window_us < RATE_LIMIT_BURST_US) {
+            return false;
+        }
+        if ((int32_t)(now - s.next_due_us) < 0) {
+            s.suppressed++;
+            return true;
+        }
+        const uint32_t interval_us = 1000000UL / l.rate_hz;
+        s.window_us = now;
+        s.next_due_us += interval_us;
+        if ((int32_t)(now - s.next_due_us) >= 0) {
+            // we've fallen more than a period behind; resynchronise
+            s.next_due_us = now + interval_us;
+        }
+        return false;
+    }
+    return false;
+}
+
+bool AP_Logger_RateLimit::set_rate(const uint8_t idx, const uint8_t first_msgid, const uint8_t count, const int16_t rate_hz)
+{
+    if (idx >= LOGGER_NUM_RATE_LIMITS) {
+        return false;
+    }
+    _limit[idx].msg_id.set_and_notify(first_msgid);
+    _limit[idx].msg_count.set_and_notify(count);
+    _limit[idx].rate_hz.set_and_notify(rate_hz);
+    _state[idx].suppressed = 0;
+    return true;
+}
+
+void AP_Logger_RateLimit::Write_RateLimits()
+{
+    for (uint8_t i=0; i<LOGGER_NUM_RATE_LIMITS; i++) {
+        const struct limit &l = _limit[i];
+        if (l.msg_id == 0 || l.rate_hz <= 0) {
+            continue;
+        }
+        const struct log_RateLimit pkt {
+            LOG_PACKET_HEADER_INIT(LOG_RATE_LIMIT_MSG),
+            time_us    : AP_HAL::micros64(),
+            instance   : i,
+            msg_id     : (uint8_t)l.msg_id.get(),
+            msg_count  : (uint8_t)l.msg_count.get(),
+            rate_hz    : l.rate_hz,
+            suppressed : _state[i].suppressed,
+        };
+        AP::logger().WriteBlock(&pkt, sizeof(pkt));
+    }
+}
@@ -0,0 +1,41 @@
+/*
+  per-message-type rate limiting for AP_Logger
+
+  Each limit applies to a run of consecutive message IDs, so a whole
+  family such as NKF1..NKQ2 can be decimated with a single entry.
+ */
+#pragma once
+
+#include <AP_Param/AP_Param.h>
+
+#define LOGGER_NUM_RATE_LIMITS 4
+
+class AP_Logger_RateLimit {
+public:
+    AP_Logger_RateLimit();
+
+    static const struct AP_Param::GroupInfo var_info[];
+
+    // return true if a message of type msgid should be dropped to
+    // keep it within its configured rate
+    bool should_drop(uint8_t msgid);
+
+    // called at 1Hz to log the suppressed message counts
+    void Write_RateLimits();
+
+    // set a limit from code; a rate of zero disables the limit
+    bool set_rate(uint8_t idx, uint8_t first_msgid, uint8_t count, int16_t rate_hz);
+
+private:
+    struct limit {
+        AP_Int16 msg_id;
+        AP_Int8 msg_count;
+        AP_Int16 rate_hz;
+    } _limit[LOGGER_NUM_RATE_LIMITS];
+
+    struct limit_state {
+        uint32_t next_due_us;  // earliest time the next message is kept
+        uint32_t window_us;    // start of the most recent kept burst
+        uint32_t suppressed;   // messages dropped since boot
+    } _state[LOGGER_NUM_RATE_LIMITS];
+};
@@ -0,0 +1,135 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ISBCodec.h"
+
+#include <AP_Math/AP_Math.h>
+
+#include <stddef.h>
+#include <string.h>
+
+// the delta between two int16 samples needs at most 17 bits
+#define ISBC_MAX_BITS 17
+
+// map signed deltas to unsigned so small negative deltas stay small
+static inline uint32_t zigzag(int32_t v)
+{
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t v)
+{
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static inline uint8_t bits_needed(uint32_t v)
+{
+    uint8_t ret = 0;
+    while (v != 0) {
+        ret++;
+        v >>= 1;
+    }
+    return ret;
+}
+
+uint8_t ISBCodec::encode(struct log_ISBC &pkt,
+                         const int16_t *x, const int16_t *y, const int16_t *z,
+                         uint16_t count)
+{
+    const int16_t *axes[3] { x, y, z };
+    const uint16_t max_bits = sizeof(pkt.data) * 8;
+
+    if (count > MAX_SAMPLES) {
+        count = MAX_SAMPLES;
+    }
+
+    // find how many samples fit; the widths only grow as samples are
+    // added so the first sample which doesn't fit ends the run
+    uint8_t bits[3] {};
+    uint16_t n = (count > 0) ? 1 : 0;
+    while (n < count) {
+        uint8_t b[3];
+        for (uint8_t a=0; a<3; a++) {
+            b[a] = MAX(bits[a], bits_needed(zigzag(axes[a][n] - axes[a][n-1])));
+        }
+        if (n * (b[0] + b[1] + b[2]) > max_bits) {
+            break;
+        }
+        memcpy(bits, b, sizeof(bits));
+        n++;
+    }
+
+    pkt.count = n;
+    pkt.x0 = (n > 0) ? x[0] : 0;
+    pkt.y0 = (n > 0) ? y[0] : 0;
+    pkt.z0 = (n > 0) ? z[0] : 0;
+    pkt.x_bits = bits[0];
+    pkt.y_bits = bits[1];
+    pkt.z_bits = bits[2];
+
+    uint8_t *out = (uint8_t *)&pkt + offsetof(struct log_ISBC, data);
+    memset(out, 0, sizeof(pkt.data));
+    uint32_t acc = 0;
+    uint8_t acc_bits = 0;
+    for (uint8_t a=0; a<3; a++) {
+        for (uint16_t i=1; i<n; i++) {
+            acc |= zigzag(axes[a][i] - axes[a][i-1]) << acc_bits;
+            acc_bits += bits[a];
+            while (acc_bits >= 8) {
+                *out++ = acc & 0xFF;
+                acc >>= 8;
+                acc_bits -= 8;
+            }
+        }
+    }
+    if (acc_bits > 0) {
+        *out = acc & 0xFF;
+    }
+
+    return n;
+}
+
+bool ISBCodec::decode(const struct log_ISBC &pkt,
+                      int16_t *x, int16_t *y, int16_t *z)
+{
+    int16_t *axes[3] { x, y, z };
+    const uint8_t bits[3] { pkt.x_bits, pkt.y_bits, pkt.z_bits };
+    const int16_t first[3] { pkt.x0, pkt.y0, pkt.z0 };
+    const uint16_t max_bits = sizeof(pkt.data) * 8;
+
+    if (pkt.count == 0 ||
+        bits[0] > ISBC_MAX_BITS || bits[1] > ISBC_MAX_BITS || bits[2] > ISBC_MAX_BITS ||
+        (pkt.count - 1) * (bits[0] + bits[1] + bits[2]) > max_bits) {
+        return false;
+    }
+
+    const uint8_t *in = (const uint8_t *)&pkt + offsetof(struct log_ISBC, data);
+    uint32_t acc = 0;
+    uint8_t acc_bits = 0;
+    for (uint8_t a=0; a<3; a++) {
+        const uint32_t mask = (1UL << bits[a]) - 1;
+        axes[a][0] = first[a];
+        for (uint16_t i=1; i<pkt.count; i++) {
+            while (acc_bits < bits[a]) {
+                acc |= (uint32_t)*in++ << acc_bits;
+                acc_bits += 8;
+            }
+            axes[a][i] = axes[a][i-1] + unzigzag(acc & mask);
+            acc >>= bits[a];
+            acc_bits -= bits[a];
+        }
+    }
+    return true;
+}
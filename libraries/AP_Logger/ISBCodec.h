@@ -0,0 +1,31 @@
+/*
+  packing of IMU batch samples into ISBC log messages
+
+  Each ISBC message holds a run of consecutive samples.  The first
+  sample is stored as-is; for each axis the remaining samples are
+  stored as zigzag-encoded deltas from the previous sample, bit-packed
+  at a fixed width per axis.  The x deltas come first, then y, then z,
+  packed LSB-first into the little-endian bytes of the data field.
+ */
+#pragma once
+
+#include "LogStructure.h"
+
+class ISBCodec {
+public:
+
+    // most samples which can be carried in one message
+    static const uint8_t MAX_SAMPLES = 255;
+
+    // fill all but the header and time of pkt with as many of the
+    // count samples as will fit.  Returns the number of samples
+    // packed, which is at least one if count is non-zero
+    static uint8_t encode(struct log_ISBC &pkt,
+                          const int16_t *x, const int16_t *y, const int16_t *z,
+                          uint16_t count);
+
+    // unpack pkt.count samples into x, y and z, which must have
+    // space for MAX_SAMPLES.  Returns false if pkt is malformed
+    static bool decode(const struct log_ISBC &pkt,
+                       int16_t *x, int16_t *y, int16_t *z);
+};
@@ -0,0 +1,227 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  LZ4 block format encoder and decoder for log compression.
+
+  The encoder is a simple greedy single-probe matcher; it is tuned for
+  the short repeated field patterns in log messages rather than for
+  ratio, so it stays cheap enough to run in the IO thread.
+ */
+
+#include "LogCompress.h"
+
+#include <AP_Math/AP_Math.h>
+
+#include <string.h>
+
+// the LZ4 block format requires the last match to start at least
+// MFLIMIT bytes before the end of the block and the last LASTLITERALS
+// bytes to be literals
+#define LZ4_MINMATCH     4
+#define LZ4_MFLIMIT      12
+#define LZ4_LASTLITERALS 5
+
+static inline uint32_t read32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// write a length continuation: a run of 255s then the remainder
+static inline uint8_t *write_length(uint8_t *op, uint32_t len)
+{
+    while (len >= 255) {
+        *op++ = 255;
+        len -= 255;
+    }
+    *op++ = len;
+    return op;
+}
+
+uint32_t LogCompressor::compress_frame(const uint8_t *in, uint16_t len, uint8_t *out)
+{
+    struct frame_header &hdr = *(struct frame_header *)out;
+    uint8_t *data = out + sizeof(frame_header);
+
+    hdr.magic1 = LOG_COMPRESS_MAGIC1;
+    hdr.magic2 = LOG_COMPRESS_MAGIC2;
+    hdr.raw_len = len;
+
+    // only keep the compressed block if it actually saves space
+    const uint32_t clen = len > 0 ? compress_block(in, len, data, len - 1) : 0;
+    if (clen == 0) {
+        memcpy(data, in, len);
+        hdr.flags = 0;
+        hdr.data_len = len;
+    } else {
+        hdr.flags = FRAME_COMPRESSED;
+        hdr.data_len = clen;
+    }
+    return sizeof(frame_header) + hdr.data_len;
+}
+
+uint32_t LogCompressor::compress_block(const uint8_t *in, uint16_t len, uint8_t *out, uint32_t out_max)
+{
+    const uint8_t *ip = in;
+    const uint8_t *anchor = in;
+    const uint8_t *const iend = in + len;
+    const uint8_t *const mflimit = iend - LZ4_MFLIMIT;
+    const uint8_t *const matchlimit = iend - LZ4_LASTLITERALS;
+    uint8_t *op = out;
+    uint8_t *const oend = out + out_max;
+
+    memset(hash_table, 0, sizeof(hash_table));
+
+    if (len > LZ4_MFLIMIT) {
+        // skip ahead faster through data which isn't matching
+        uint32_t misses = 0;
+        while (ip < mflimit) {
+            const uint32_t seq = read32(ip);
+            const uint32_t h = (seq * 2654435761U) >> (32 - HASH_LOG);
+            const uint8_t *ref = in + hash_table[h];
+            hash_table[h] = ip - in;
+            if (ref >= ip || read32(ref) != seq) {
+                ip += 1 + (misses++ >> 5);
+                continue;
+            }
+            misses = 0;
+
+            // extend the match backwards over pending literals
+            while (ip > anchor && ref > in && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            }
+
+            // and forwards as far as the format allows
+            const uint8_t *mp = ip + LZ4_MINMATCH;
+            const uint8_t *mr = ref + LZ4_MINMATCH;
+            while (mp < matchlimit && *mp == *mr) {
+                mp++;
+                mr++;
+            }
+
+            const uint32_t lit_len = ip - anchor;
+            const uint32_t match_len = (mp - ip) - LZ4_MINMATCH;
+
+            // worst case sequence size: token, literal length,
+            // literals, offset and match length
+            if (op + 1 + lit_len/255 + 1 + lit_len + 2 + match_len/255 + 1 > oend) {
+                return 0;
+            }
+
+            uint8_t *token = op++;
+            *token = (MIN(lit_len, 15U) << 4) | MIN(match_len, 15U);
+            if (lit_len >= 15) {
+                op = write_length(op, lit_len - 15);
+            }
+            memcpy(op, anchor, lit_len);
+            op += lit_len;
+
+            const uint16_t offset = ip - ref;
+            *op++ = offset & 0xFF;
+            *op++ = offset >> 8;
+            if (match_len >= 15) {
+                op = write_length(op, match_len - 15);
+            }
+
+            ip = mp;
+            anchor = ip;
+        }
+    }
+
+    // the remainder of the block is emitted as literals
+    const uint32_t lit_len = iend - anchor;
+    if (op + 1 + lit_len/255 + 1 + lit_len > oend) {
+        return 0;
+    }
+    uint8_t *token = op++;
+    *token = MIN(lit_len, 15U) << 4;
+    if (lit_len >= 15) {
+        op = write_length(op, lit_len - 15);
+    }
+    memcpy(op, anchor, lit_len);
+    op += lit_len;
+
+    return op - out;
+}
+
+int32_t LogCompressor::decompress_block(const uint8_t *in, uint16_t in_len, uint8_t *out, uint16_t out_max)
+{
+    const uint8_t *ip = in;
+    const uint8_t *const iend = in + in_len;
+    uint8_t *op = out;
+    uint8_t *const oend = out + out_max;
+
+    while (ip < iend) {
+        const uint8_t token = *ip++;
+
+        uint32_t lit_len = token >> 4;
+        if (lit_len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                b = *ip++;
+                lit_len += b;
+            } while (b == 255);
+        }
+        if (lit_len > (uint32_t)(iend - ip) || lit_len > (uint32_t)(oend - op)) {
+            return -1;
+        }
+        memcpy(op, ip, lit_len);
+        ip += lit_len;
+        op += lit_len;
+
+        if (ip == iend) {
+            // the last sequence has no match
+            break;
+        }
+
+        if (iend - ip < 2) {
+            return -1;
+        }
+        const uint16_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > op - out) {
+            return -1;
+        }
+
+        uint32_t match_len = token & 0x0F;
+        if (match_len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                b = *ip++;
+                match_len += b;
+            } while (b == 255);
+        }
+        match_len += LZ4_MINMATCH;
+        if (match_len > (uint32_t)(oend - op)) {
+            return -1;
+        }
+
+        // copy byte-by-byte as the match may overlap its own output
+        const uint8_t *ref = op - offset;
+        while (match_len--) {
+            *op++ = *ref++;
+        }
+    }
+
+    return op - out;
+}
@@ -0,0 +1,60 @@
+/*
+  lightweight streaming compression for AP_Logger_File
+
+  Log data is compressed in chunks using the LZ4 block format, and
+  each chunk is written to the log file as a self-contained frame so a
+  file truncated by a power loss can still be decoded up to the last
+  complete frame.
+ */
+#pragma once
+
+#include <AP_Common/AP_Common.h>
+#include <stdint.h>
+
+// frames start with HEAD_BYTE1 followed by a byte which is never a
+// valid second header byte of an uncompressed log message
+#define LOG_COMPRESS_MAGIC1 0xA3
+#define LOG_COMPRESS_MAGIC2 0x96
+
+class LogCompressor {
+public:
+
+    enum frame_flags : uint8_t {
+        FRAME_COMPRESSED = (1U<<0),  // data is LZ4, otherwise stored raw
+    };
+
+    struct PACKED frame_header {
+        uint8_t magic1;
+        uint8_t magic2;
+        uint8_t flags;
+        uint16_t raw_len;   // length of the data once decompressed
+        uint16_t data_len;  // length of the data following this header
+    };
+
+    // largest frame which can be produced for raw_len bytes of input
+    static constexpr uint32_t max_frame_size(uint32_t raw_len) {
+        return sizeof(frame_header) + raw_len;
+    }
+
+    // compress len bytes from in into a complete frame at out, which
+    // must have space for max_frame_size(len) bytes.  Returns the
+    // number of bytes in the frame
+    uint32_t compress_frame(const uint8_t *in, uint16_t len, uint8_t *out);
+
+    // decompress a single LZ4 block.  Returns the number of bytes
+    // written to out, or -1 if the block is corrupt or would overflow
+    // out_max
+    static int32_t decompress_block(const uint8_t *in, uint16_t in_len, uint8_t *out, uint16_t out_max);
+
+private:
+
+    static const uint8_t HASH_LOG = 11;
+
+    // returns the number of bytes written, or 0 if the compressed
+    // block would not fit in out_max bytes
+    uint32_t compress_block(const uint8_t *in, uint16_t len, uint8_t *out, uint32_t out_max);
+
+    // offsets into the current block of the last position seen with
+    // each hash; only valid while compressing a block
+    uint16_t hash_table[1U<<HASH_LOG];
+};
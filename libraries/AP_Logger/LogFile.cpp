@@ -1,4 +1,5 @@
 #include <stdlib.h>
+#include <new>
 
 #include <AP_AHRS/AP_AHRS.h>
 #include <AP_Baro/AP_Baro.h>
@@ -12,6 +13,7 @@
 #include <AC_AttitudeControl/AC_PosControl.h>
 #include <AP_RangeFinder/RangeFinder_Backend.h>
 #include <AP_RSSI/AP_RSSI.h>
+#include <AP_IOMCU/AP_IOMCU.h>
 
 #include "AP_Logger.h"
 #include "AP_Logger_File.h"
@@ -20,6 +22,10 @@
 
 extern const AP_HAL::HAL& hal;
 
+#if HAL_WITH_IO_MCU
+extern AP_IOMCU iomcu;
+#endif
+
 
 /*
   write a structure format to the log - should be in frontend
@@ -302,7 +308,9 @@ void AP_Logger::Write_IMU_instance(const uint64_t time_us, const uint8_t imu_ins
     const AP_InertialSensor &ins = AP::ins();
     const Vector3f &gyro = ins.get_gyro(imu_instance);
     const Vector3f &accel = ins.get_accel(imu_instance);
-    struct log_IMU pkt = {
+    struct log_IMU fallback;
+    void *buf = ReserveBlock(&fallback, sizeof(fallback));
+    new (buf) log_IMU {
         LOG_PACKET_HEADER_INIT(type),
         time_us : time_us,
         gyro_x  : gyro.x,
@@ -319,7 +327,7 @@ void AP_Logger::Write_IMU_instance(const uint64_t time_us, const uint8_t imu_ins
         gyro_rate : ins.get_gyro_rate_hz(imu_instance),
         accel_rate : ins.get_accel_rate_hz(imu_instance),
     };
-    WriteBlock(&pkt, sizeof(pkt));
+    CommitBlock(buf, sizeof(fallback));
 }
 
 // Write an raw accel/gyro data packet
@@ -354,7 +362,9 @@ void AP_Logger::Write_IMUDT_instance(const uint64_t time_us, const uint8_t imu_i
     ins.get_delta_angle(imu_instance, delta_angle);
     ins.get_delta_velocity(imu_instance, delta_velocity);
 
-    struct log_IMUDT pkt = {
+    struct log_IMUDT fallback;
+    void *buf = ReserveBlock(&fallback, sizeof(fallback));
+    new (buf) log_IMUDT {
         LOG_PACKET_HEADER_INIT(type),
         time_us : time_us,
         delta_time   : delta_t,
@@ -367,7 +377,7 @@ void AP_Logger::Write_IMUDT_instance(const uint64_t time_us, const uint8_t imu_i
         delta_vel_y  : delta_velocity.y,
         delta_vel_z  : delta_velocity.z
     };
-    WriteBlock(&pkt, sizeof(pkt));
+    CommitBlock(buf, sizeof(fallback));
 }
 
 void AP_Logger::Write_IMUDT(uint64_t time_us, uint8_t imu_mask)
@@ -473,6 +483,157 @@ void AP_Logger::Write_Power(void)
 #endif
 }
 
+// Write the statistics of each shared DMA stream in use
+void AP_Logger::Write_DMA(void)
+{
+    const uint64_t now_us = AP_HAL::micros64();
+    AP_HAL::Util::DMAStats stats;
+    for (uint8_t i=0; hal.util->get_dma_stats(i, stats); i++) {
+        const struct log_DMA pkt {
+            LOG_PACKET_HEADER_INIT(LOG_DMA_MSG),
+            time_us     : now_us,
+            id          : uint8_t(stats.controller * 10 + stats.stream),
+            owners      : stats.owners,
+            locks       : stats.locks,
+            contended   : stats.contended,
+            handovers   : stats.handovers,
+            hold_avg_us : stats.hold_avg_us,
+            hold_max_us : stats.hold_max_us,
+            w0          : stats.wait_hist[0],
+            w1          : stats.wait_hist[1],
+            w2          : stats.wait_hist[2],
+            w3          : stats.wait_hist[3],
+            w4          : stats.wait_hist[4],
+            w5          : stats.wait_hist[5],
+            w6          : stats.wait_hist[6],
+            w7          : stats.wait_hist[7],
+        };
+        WriteBlock(&pkt, sizeof(pkt));
+    }
+}
+
+// Write the statistics of each serial port whose driver keeps them
+void AP_Logger::Write_UART(void)
+{
+    const uint64_t now_us = AP_HAL::micros64();
+    AP_HAL::UARTDriver::UARTStats stats;
+    for (uint8_t i=0; i<hal.num_serial; i++) {
+        AP_HAL::UARTDriver *uart = hal.serial(i);
+        if (uart == nullptr || !uart->get_stats(stats)) {
+            continue;
+        }
+        const struct log_UART pkt {
+            LOG_PACKET_HEADER_INIT(LOG_UART_MSG),
+            time_us           : now_us,
+            instance          : i,
+            rx_bytes          : stats.rx_bytes,
+            tx_bytes          : stats.tx_bytes,
+            irqs              : stats.irqs,
+            rx_overruns       : stats.rx_overruns,
+            rx_dropped        : stats.rx_dropped,
+            tx_full           : stats.tx_full,
+            tx_dropped        : stats.tx_dropped,
+            rx_max_used       : stats.rx_max_used,
+            tx_max_used       : stats.tx_max_used,
+            tx_latency_avg_us : stats.tx_latency_avg_us,
+            tx_latency_max_us : stats.tx_latency_max_us,
+        };
+        WriteBlock(&pkt, sizeof(pkt));
+    }
+}
+
+// Write the transmit and receive statistics of each CAN interface
+// whose driver keeps them
+void AP_Logger::Write_CAN(void)
+{
+#if HAL_WITH_UAVCAN
+    const uint64_t now_us = AP_HAL::micros64();
+    AP_HAL::CANManager::TxStats stats;
+    AP_HAL::CANManager::RxStats rx_stats;
+    for (uint8_t d=0; d<MAX_NUMBER_OF_CAN_DRIVERS; d++) {
+        AP_HAL::CANManager *can_mgr = hal.can_mgr[d];
+        if (can_mgr == nullptr) {
+            continue;
+        }
+        for (uint8_t i=0; i<MAX_NUMBER_OF_CAN_INTERFACES; i++) {
+            if (!can_mgr->get_tx_stats(i, stats)) {
+                continue;
+            }
+            const struct log_CANT pkt {
+                LOG_PACKET_HEADER_INIT(LOG_CANT_MSG),
+                time_us        : now_us,
+                driver         : d,
+                iface          : i,
+                frames         : stats.frames,
+                timeouts       : stats.timeouts,
+                aborts         : stats.aborts,
+                queue_len      : stats.queue_len,
+                queue_max      : stats.queue_max,
+                queue_size     : stats.queue_size,
+                latency_avg_us : stats.latency_avg_us,
+                latency_max_us : stats.latency_max_us,
+            };
+            WriteBlock(&pkt, sizeof(pkt));
+        }
+        for (uint8_t i=0; i<MAX_NUMBER_OF_CAN_INTERFACES; i++) {
+            if (!can_mgr->get_rx_stats(i, rx_stats)) {
+                continue;
+            }
+            const struct log_CANR pkt {
+                LOG_PACKET_HEADER_INIT(LOG_CANR_MSG),
+                time_us         : now_us,
+                driver          : d,
+                iface           : i,
+                frames          : rx_stats.frames,
+                queue_overflows : rx_stats.queue_overflows,
+                fifo_overflows  : rx_stats.fifo_overflows,
+                bus_offs        : rx_stats.bus_offs,
+                errors          : rx_stats.errors,
+                queue_len       : rx_stats.queue_len,
+                queue_size      : rx_stats.queue_size,
+                isr_max_us      : rx_stats.isr_max_us,
+            };
+            WriteBlock(&pkt, sizeof(pkt));
+        }
+    }
+#endif
+}
+
+// Write the statistics of the link to the IO microcontroller
+void AP_Logger::Write_IOMCU(void)
+{
+#if HAL_WITH_IO_MCU
+    const AP_IOMCU::link_stats &stats = iomcu.get_link_stats();
+    const struct log_IOMCU pkt {
+        LOG_PACKET_HEADER_INIT(LOG_IOMCU_MSG),
+        time_us        : AP_HAL::micros64(),
+        rate_hz        : stats.rate_hz,
+        fail_hz        : stats.fail_hz,
+        util_pct       : stats.util_pct,
+        latency_avg_us : stats.latency_avg_us,
+        latency_max_us : stats.latency_max_us,
+    };
+    WriteBlock(&pkt, sizeof(pkt));
+#endif
+}
+
+// Write an object avoidance path planner result
+void AP_Logger::Write_OA(uint8_t state, uint32_t plan_us, uint32_t age_ms, const Location &destination, const Location &oa_destination)
+{
+    const struct log_OA pkt {
+        LOG_PACKET_HEADER_INIT(LOG_OA_MSG),
+        time_us         : AP_HAL::micros64(),
+        state           : state,
+        plan_us         : plan_us,
+        age_ms          : uint16_t(MIN(age_ms, UINT16_MAX)),
+        destination_lat : destination.lat,
+        destination_lng : destination.lng,
+        oa_lat          : oa_destination.lat,
+        oa_lng          : oa_destination.lng,
+    };
+    WriteBlock(&pkt, sizeof(pkt));
+}
+
 // Write an AHRS2 packet
 void AP_Logger::Write_AHRS2(AP_AHRS &ahrs)
 {
@@ -914,7 +1075,9 @@ void AP_Logger::Write_EKF3(AP_AHRS_NavEKF &ahrs)
     if (!ahrs.get_NavEKF3().getOriginLLH(0,originLLH)) {
         originLLH.alt = 0;
     }
-    struct log_EKF1 pkt = {
+    struct log_EKF1 fallback;
+    void *buf = ReserveBlock(&fallback, sizeof(fallback));
+    new (buf) log_EKF1 {
         LOG_PACKET_HEADER_INIT(LOG_XKF1_MSG),
         time_us : time_us,
         roll    : (int16_t)(100*degrees(euler.x)), // roll angle (centi-deg, displayed as deg due to format string)
@@ -932,7 +1095,7 @@ void AP_Logger::Write_EKF3(AP_AHRS_NavEKF &ahrs)
         gyrZ    : (int16_t)(100*degrees(gyroBias.z)), // cd/sec, displayed as deg/sec due to format string
         originHgt : originLLH.alt // WGS-84 altitude of EKF origin in cm
     };
-    WriteBlock(&pkt, sizeof(pkt));
+    CommitBlock(buf, sizeof(fallback));
 
     // Write second EKF packet
     Vector3f accelBias;
@@ -1308,14 +1471,19 @@ void AP_Logger::Write_Radio(const mavlink_radio_t &packet)
 
 // Write a Camera packet
 void AP_Logger::Write_CameraInfo(enum LogMessages msg, const AP_AHRS &ahrs, const Location &current_loc, uint64_t timestamp_us)
+{
+    Write_CameraInfo(msg, ahrs, current_loc, ahrs.roll_sensor, ahrs.pitch_sensor, ahrs.yaw_sensor, timestamp_us);
+}
+
+void AP_Logger::Write_CameraInfo(enum LogMessages msg, const AP_AHRS &ahrs, const Location &loc, int32_t roll_cd, int32_t pitch_cd, int32_t yaw_cd, uint64_t timestamp_us)
 {
     int32_t altitude, altitude_rel, altitude_gps;
-    if (current_loc.relative_alt) {
-        altitude = current_loc.alt+ahrs.get_home().alt;
-        altitude_rel = current_loc.alt;
+    if (loc.relative_alt) {
+        altitude = loc.alt+ahrs.get_home().alt;
+        altitude_rel = loc.alt;
     } else {
-        altitude = current_loc.alt;
-        altitude_rel = current_loc.alt - ahrs.get_home().alt;
+        altitude = loc.alt;
+        altitude_rel = loc.alt - ahrs.get_home().alt;
     }
     const AP_GPS &gps = AP::gps();
     if (gps.status() >= AP_GPS::GPS_OK_FIX_3D) {
@@ -1324,19 +1492,34 @@ void AP_Logger::Write_CameraInfo(enum LogMessages msg, const AP_AHRS &ahrs, cons
         altitude_gps = 0;
     }
 
+    const uint64_t now_us = AP_HAL::micros64();
+    if (timestamp_us == 0 || timestamp_us > now_us) {
+        timestamp_us = now_us;
+    }
+    // take the GPS time back to when the picture was taken
+    uint32_t gps_time_ms = gps.time_week_ms();
+    uint16_t gps_week = gps.time_week();
+    const uint32_t age_ms = (now_us - timestamp_us) / 1000U;
+    if (gps_time_ms >= age_ms) {
+        gps_time_ms -= age_ms;
+    } else if (gps_week > 0) {
+        gps_week--;
+        gps_time_ms += AP_MSEC_PER_WEEK - age_ms;
+    }
+
     struct log_Camera pkt = {
         LOG_PACKET_HEADER_INIT(static_cast<uint8_t>(msg)),
-        time_us     : timestamp_us?timestamp_us:AP_HAL::micros64(),
-        gps_time    : gps.time_week_ms(),
-        gps_week    : gps.time_week(),
-        latitude    : current_loc.lat,
-        longitude   : current_loc.lng,
+        time_us     : timestamp_us,
+        gps_time    : gps_time_ms,
+        gps_week    : gps_week,
+        latitude    : loc.lat,
+        longitude   : loc.lng,
         altitude    : altitude,
         altitude_rel: altitude_rel,
         altitude_gps: altitude_gps,
-        roll        : (int16_t)ahrs.roll_sensor,
-        pitch       : (int16_t)ahrs.pitch_sensor,
-        yaw         : (uint16_t)ahrs.yaw_sensor
+        roll        : (int16_t)roll_cd,
+        pitch       : (int16_t)pitch_cd,
+        yaw         : (uint16_t)yaw_cd
     };
     WriteCriticalBlock(&pkt, sizeof(pkt));
 }
@@ -1347,6 +1530,12 @@ void AP_Logger::Write_Camera(const AP_AHRS &ahrs, const Location &current_loc, u
     Write_CameraInfo(LOG_CAMERA_MSG, ahrs, current_loc, timestamp_us);
 }
 
+// Write a Camera packet for a vehicle state from the past
+void AP_Logger::Write_Camera(const AP_AHRS &ahrs, const Location &loc, int32_t roll_cd, int32_t pitch_cd, int32_t yaw_cd, uint64_t timestamp_us)
+{
+    Write_CameraInfo(LOG_CAMERA_MSG, ahrs, loc, roll_cd, pitch_cd, yaw_cd, timestamp_us);
+}
+
 // Write a Trigger packet
 void AP_Logger::Write_Trigger(const AP_AHRS &ahrs, const Location &current_loc)
 {
@@ -1538,7 +1727,9 @@ void AP_Logger::Write_ESC(uint8_t id, uint64_t time_us, int32_t rpm, uint16_t vo
 // Write a Yaw PID packet
 void AP_Logger::Write_PID(uint8_t msg_type, const PID_Info &info)
 {
-    struct log_PID pkt = {
+    struct log_PID fallback;
+    void *buf = ReserveBlock(&fallback, sizeof(fallback));
+    new (buf) log_PID {
         LOG_PACKET_HEADER_INIT(msg_type),
         time_us         : AP_HAL::micros64(),
         desired         : info.desired,
@@ -1548,7 +1739,7 @@ void AP_Logger::Write_PID(uint8_t msg_type, const PID_Info &info)
         D               : info.D,
         FF              : info.FF
     };
-    WriteBlock(&pkt, sizeof(pkt));
+    CommitBlock(buf, sizeof(fallback));
 }
 
 void AP_Logger::Write_Origin(uint8_t origin_type, const Location &loc)
@@ -1604,7 +1795,7 @@ void AP_Logger::Write_Rate(const AP_AHRS_View *ahrs,
 }
 
 // Write visual odometry sensor data
-void AP_Logger::Write_VisualOdom(float time_delta, const Vector3f &angle_delta, const Vector3f &position_delta, float confidence)
+void AP_Logger::Write_VisualOdom(float time_delta, const Vector3f &angle_delta, const Vector3f &position_delta, float confidence, uint32_t receive_lag_ms, uint32_t fusion_lag_ms)
 {
     struct log_VisualOdom pkt_visualodom = {
         LOG_PACKET_HEADER_INIT(LOG_VISUALODOM_MSG),
@@ -1616,7 +1807,9 @@ void AP_Logger::Write_VisualOdom(float time_delta, const Vector3f &angle_delta,
         position_delta_x    : position_delta.x,
         position_delta_y    : position_delta.y,
         position_delta_z    : position_delta.z,
-        confidence          : confidence
+        confidence          : confidence,
+        receive_lag_ms      : receive_lag_ms,
+        fusion_lag_ms       : fusion_lag_ms
     };
     WriteBlock(&pkt_visualodom, sizeof(log_VisualOdom));
 }
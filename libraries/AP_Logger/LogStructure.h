@@ -158,6 +158,45 @@ struct PACKED log_DSF {
     uint32_t buf_space_avg;
 };
 
+struct PACKED log_DSFL {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint16_t writes;
+    uint32_t p50;
+    uint32_t p95;
+    uint32_t p99;
+    uint32_t max;
+};
+
+// index appended to a log by AP_Logger_File when LOG_FILE_INDEX is
+// set; see AP_Logger_FileIndex.h
+struct PACKED log_Index {
+    LOG_PACKET_HEADER;
+    uint8_t kind;    // AP_Logger_FileIndex::entry_kind
+    uint64_t key;    // time in microseconds, or a message type
+    uint32_t value;  // file offset, or a message count
+};
+
+// always the last message in an indexed log
+struct PACKED log_IndexEnd {
+    LOG_PACKET_HEADER;
+    uint32_t start;        // offset of the first index message
+    uint32_t startup_end;  // offset just past the startup messages
+    uint16_t num_times;
+    uint16_t num_formats;
+    uint16_t num_counts;
+};
+
+struct PACKED log_RateLimit {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t instance;
+    uint8_t msg_id;
+    uint8_t msg_count;
+    int16_t rate_hz;
+    uint32_t suppressed;
+};
+
 struct PACKED log_Event {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -225,6 +264,134 @@ struct PACKED log_IMUDT {
     float delta_vel_x, delta_vel_y, delta_vel_z;
 };
 
+// gyro FFT peaks of one axis, strongest first
+struct PACKED log_FTN {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t axis;
+    float freq1;
+    float amp1;
+    float freq2;
+    float amp2;
+    float freq3;
+    float amp3;
+    uint16_t avg_cost_us;
+    uint16_t max_cost_us;
+};
+
+// gyro sample to motor output latency over the last second
+struct PACKED log_GyroLatency {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint32_t count;
+    uint32_t avg_us;
+    uint32_t max_us;
+    uint16_t h0, h1, h2, h3, h4, h5, h6, h7;
+};
+
+// share of time an IMU's device held its bus over the last second
+struct PACKED log_IMUBus {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t instance;
+    float utilisation;
+};
+
+// statistics of a shared DMA stream since boot. The id is the DMA
+// controller * 10 + the stream
+struct PACKED log_DMA {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t id;
+    uint8_t owners;
+    uint32_t locks;
+    uint32_t contended;
+    uint32_t handovers;
+    uint32_t hold_avg_us;
+    uint32_t hold_max_us;
+    uint32_t w0, w1, w2, w3, w4, w5, w6, w7;
+};
+
+// throughput of a serial port since boot. The instance is its SERIALn
+// number. Latency is from write() until a byte is handed to the device
+struct PACKED log_UART {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t instance;
+    uint32_t rx_bytes;
+    uint32_t tx_bytes;
+    uint32_t irqs;
+    uint32_t rx_overruns;
+    uint32_t rx_dropped;
+    uint32_t tx_full;
+    uint32_t tx_dropped;
+    uint16_t rx_max_used;
+    uint16_t tx_max_used;
+    uint32_t tx_latency_avg_us;
+    uint32_t tx_latency_max_us;
+};
+
+// transmit statistics of a CAN interface. D is the CAN driver, I the
+// interface on it. Latency is from a frame being queued until sent
+struct PACKED log_CANT {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t driver;
+    uint8_t iface;
+    uint32_t frames;
+    uint32_t timeouts;
+    uint32_t aborts;
+    uint16_t queue_len;
+    uint16_t queue_max;
+    uint16_t queue_size;
+    uint32_t latency_avg_us;
+    uint32_t latency_max_us;
+};
+
+// receive statistics of a CAN interface. QOvr are frames dropped with
+// the receive queue full, FOvr those lost in the controller, BOff the
+// times it went bus-off and IMax the longest receive interrupt
+struct PACKED log_CANR {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t driver;
+    uint8_t iface;
+    uint32_t frames;
+    uint32_t queue_overflows;
+    uint32_t fifo_overflows;
+    uint32_t bus_offs;
+    uint32_t errors;
+    uint16_t queue_len;
+    uint16_t queue_size;
+    uint32_t isr_max_us;
+};
+
+// statistics of the serial link to an IO microcontroller. Latency is
+// from a request being sent until its reply is in
+struct PACKED log_IOMCU {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint16_t rate_hz;
+    uint16_t fail_hz;
+    uint8_t util_pct;
+    uint16_t latency_avg_us;
+    uint16_t latency_max_us;
+};
+
+// object avoidance path planner result, logged as it is first used. Age
+// is how long ago the request it answers was made
+struct PACKED log_OA {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t state;
+    uint32_t plan_us;
+    uint16_t age_ms;
+    int32_t destination_lat;
+    int32_t destination_lng;
+    int32_t oa_lat;
+    int32_t oa_lng;
+};
+
 struct PACKED log_ISBH {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -249,6 +416,23 @@ struct PACKED log_ISBD {
 };
 static_assert(sizeof(log_ISBD) < 256, "log_ISBD is over-size");
 
+// delta-encoded variant of ISBD; see ISBCodec.h for the packing
+struct PACKED log_ISBC {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint16_t isb_seqno;
+    uint16_t sample_ofs; // index of first sample within isb_seqno
+    uint8_t count;       // number of samples in this message
+    int16_t x0;          // first sample; the rest are deltas
+    int16_t y0;
+    int16_t z0;
+    uint8_t x_bits;      // bits per zigzagged delta for each axis
+    uint8_t y_bits;
+    uint8_t z_bits;
+    int16_t data[64];    // bit-packed x deltas, then y, then z
+};
+static_assert(sizeof(log_ISBC) < 256, "log_ISBC is over-size");
+
 struct PACKED log_Vibe {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -339,6 +523,11 @@ struct PACKED log_MAV {
     uint16_t packet_tx_count;
     uint16_t packet_rx_success_count;
     uint16_t packet_rx_drop_count;
+    uint16_t stream_requested;
+    uint16_t stream_sent;
+    uint16_t stream_dropped;
+    uint16_t signing_count;
+    uint32_t signing_time_us;
 };
 
 struct PACKED log_RSSI {
@@ -607,6 +796,8 @@ struct PACKED log_VisualOdom {
     float position_delta_y;
     float position_delta_z;
     float confidence;
+    uint32_t receive_lag_ms;
+    uint32_t fusion_lag_ms;
 };
 
 struct PACKED log_ekfBodyOdomDebug {
@@ -799,6 +990,13 @@ struct PACKED log_TERRAIN {
     uint16_t loaded;
 };
 
+struct PACKED log_TERRAIN_IO {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint16_t queued;
+    uint16_t max_latency_ms;
+};
+
 /*
   UBlox logging
  */
@@ -936,6 +1134,9 @@ struct PACKED log_MAV_Stats {
     uint8_t state_sent_avg;
     uint8_t state_sent_min;
     uint8_t state_sent_max;
+    uint8_t window;
+    uint16_t rtt;
+    uint32_t throughput;
     // uint8_t state_retry_avg;
     // uint8_t state_retry_min;
     // uint8_t state_retry_max;
@@ -1089,6 +1290,21 @@ struct PACKED log_Performance {
     uint32_t internal_errors;
 };
 
+struct PACKED log_SchedTask {
+    LOG_PACKET_HEADER;
+    uint64_t time_us;
+    uint8_t task_id;
+    char name[16];
+    uint32_t num_runs;
+    uint16_t avg_time;
+    uint16_t max_time;
+    uint16_t p99_time;
+    uint16_t num_slips;
+    uint16_t num_overruns;
+    uint16_t avg_jitter;
+    uint16_t max_jitter;
+};
+
 struct PACKED log_SRTL {
     LOG_PACKET_HEADER;
     uint64_t time_us;
@@ -1172,6 +1388,11 @@ struct PACKED log_DSTL {
 #define ISBD_UNITS  "s--ooo"
 #define ISBD_MULTS  "F--???"
 
+#define ISBC_LABELS "TimeUS,N,ofs,cnt,x0,y0,z0,xb,yb,zb,d0,d1"
+#define ISBC_FMT    "QHHBhhhBBBaa"
+#define ISBC_UNITS  "s---ooo-----"
+#define ISBC_MULTS  "F---???-----"
+
 #define IMU_LABELS "TimeUS,GyrX,GyrY,GyrZ,AccX,AccY,AccZ,EG,EA,T,GH,AH,GHz,AHz"
 #define IMU_FMT   "QffffffIIfBBHH"
 #define IMU_UNITS "sEEEooo--O--zz"
@@ -1324,13 +1545,15 @@ Format characters in the format string for binary log messages
     { LOG_RFND_MSG, sizeof(log_RFND), \
       "RFND", "QCBBCBB", "TimeUS,Dist1,Stat1,Orient1,Dist2,Stat2,Orient2", "sm--m--", "FB--B--" }, \
     { LOG_MAV_STATS, sizeof(log_MAV_Stats), \
-      "DMS", "IIIIIBBBBBBBBB",         "TimeMS,N,Dp,RT,RS,Fa,Fmn,Fmx,Pa,Pmn,Pmx,Sa,Smn,Smx", "s-------------", "C-------------" }, \
+      "DMS", "IIIIIBBBBBBBBBBHI",         "TimeMS,N,Dp,RT,RS,Fa,Fmn,Fmx,Pa,Pmn,Pmx,Sa,Smn,Smx,W,RTT,TP", "s--------------s-", "C--------------C-" }, \
     { LOG_BEACON_MSG, sizeof(log_Beacon), \
       "BCN", "QBBfffffff",  "TimeUS,Health,Cnt,D0,D1,D2,D3,PosX,PosY,PosZ", "s--mmmmmmm", "F--BBBBBBB" }, \
     { LOG_PROXIMITY_MSG, sizeof(log_Proximity), \
       "PRX", "QBfffffffffff", "TimeUS,Health,D0,D45,D90,D135,D180,D225,D270,D315,DUp,CAn,CDis", "s-mmmmmmmmmhm", "F-BBBBBBBBB00" }, \
     { LOG_PERFORMANCE_MSG, sizeof(log_Performance),                     \
       "PM",  "QHHIIHI", "TimeUS,NLon,NLoop,MaxT,Mem,Load,IntErr", "s---b%-", "F---0A-" }, \
+    { LOG_SCHED_TASK_MSG, sizeof(log_SchedTask),                        \
+      "TSK", "QBNIHHHHHHH", "TimeUS,Id,Name,NRun,AvgT,MaxT,P99T,NSlip,NOvr,AvgJ,MaxJ", "s#--sss--ss", "F---FFF--FF" }, \
     { LOG_SRTL_MSG, sizeof(log_SRTL), \
       "SRTL", "QBHHBfff", "TimeUS,Active,NumPts,MaxPts,Action,N,E,D", "s----mmm", "F----000" }
 
@@ -1398,6 +1621,8 @@ Format characters in the format string for binary log messages
       "XKV2","Qffffffffffff","TimeUS,V12,V13,V14,V15,V16,V17,V18,V19,V20,V21,V22,V23", "s------------", "F------------" }, \
     { LOG_TERRAIN_MSG, sizeof(log_TERRAIN), \
       "TERR","QBLLHffHH","TimeUS,Status,Lat,Lng,Spacing,TerrH,CHeight,Pending,Loaded", "s-DU-mm--", "F-GG-00--" }, \
+    { LOG_TERRAIN_IO_MSG, sizeof(log_TERRAIN_IO), \
+      "TERI","QHH","TimeUS,Queued,MaxLat", "s-s", "F-C" }, \
     { LOG_GPS_UBX1_MSG, sizeof(log_Ubx1), \
       "UBX1", "QBHBBHI",  "TimeUS,Instance,noisePerMS,jamInd,aPower,agcCnt,config", "s------", "F------"  }, \
     { LOG_GPS_UBX2_MSG, sizeof(log_Ubx2), \
@@ -1474,10 +1699,38 @@ Format characters in the format string for binary log messages
       "ISBH",ISBH_FMT,ISBH_LABELS,ISBH_UNITS,ISBH_MULTS },  \
     { LOG_ISBD_MSG, sizeof(log_ISBD), \
       "ISBD",ISBD_FMT,ISBD_LABELS, ISBD_UNITS, ISBD_MULTS }, \
+    { LOG_ISBC_MSG, sizeof(log_ISBC), \
+      "ISBC",ISBC_FMT,ISBC_LABELS, ISBC_UNITS, ISBC_MULTS }, \
+    { LOG_FTN_MSG, sizeof(log_FTN), \
+      "FTN", "QBffffffHH", "TimeUS,Axis,F1,A1,F2,A2,F3,A3,AvgC,MaxC", "s#zEzEzEss", "F-------FF" }, \
+    { LOG_GYRO_LATENCY_MSG, sizeof(log_GyroLatency), \
+      "GLAT", "QIIIHHHHHHHH", "TimeUS,N,Avg,Max,H0,H1,H2,H3,H4,H5,H6,H7", "s-ss--------", "F-FF--------" }, \
+    { LOG_IMU_BUS_MSG, sizeof(log_IMUBus), \
+      "IBUS", "QBf", "TimeUS,I,Use", "s#%", "F--" }, \
+    { LOG_DMA_MSG, sizeof(log_DMA), \
+      "DMA", "QBBIIIIIIIIIIIII", "TimeUS,Id,Own,Lck,Cnt,Hnd,HAvg,HMax,W0,W1,W2,W3,W4,W5,W6,W7", "s#----ss--------", "F-----FF--------" }, \
+    { LOG_UART_MSG, sizeof(log_UART), \
+      "UART", "QBIIIIIIIHHII", "TimeUS,I,Rx,Tx,Irq,ROvr,RDrp,TFul,TDrp,RMax,TMax,LAvg,LMax", "s#bb----bbbss", "F-00----000FF" }, \
+    { LOG_CANT_MSG, sizeof(log_CANT), \
+      "CANT", "QBBIIIHHHII", "TimeUS,D,I,Tx,TO,Abt,QLen,QMax,QSz,LAvg,LMax", "s##------ss", "F--------FF" }, \
+    { LOG_CANR_MSG, sizeof(log_CANR), \
+      "CANR", "QBBIIIIIHHI", "TimeUS,D,I,Rx,QOvr,FOvr,BOff,Err,QLen,QSz,IMax", "s##-------s", "F---------F" }, \
+    { LOG_IOMCU_MSG, sizeof(log_IOMCU), \
+      "IOMC", "QHHBHH", "TimeUS,Rate,Fail,Util,LAvg,LMax", "szz%ss", "F---FF" }, \
+    { LOG_OA_MSG, sizeof(log_OA), \
+      "OA", "QBIHiiii", "TimeUS,State,PlanUS,Age,DLat,DLng,OALat,OALng", "s-ssDUDU", "F-FCGGGG" }, \
     { LOG_ORGN_MSG, sizeof(log_ORGN), \
       "ORGN","QBLLe","TimeUS,Type,Lat,Lng,Alt", "s-DUm", "F-GGB" },   \
     { LOG_DF_FILE_STATS, sizeof(log_DSF), \
       "DSF", "QIHIIII", "TimeUS,Dp,Blk,Bytes,FMn,FMx,FAv", "s--b---", "F--0---" }, \
+    { LOG_DF_FILE_LATENCY, sizeof(log_DSFL), \
+      "DSFL", "QHIIII", "TimeUS,N,P50,P95,P99,Max", "s-ssss", "F-FFFF" }, \
+    { LOG_RATE_LIMIT_MSG, sizeof(log_RateLimit), \
+      "LRL", "QBBBhI", "TimeUS,I,Id,Cnt,Rate,Sup", "s---z-", "F-----" }, \
+    { LOG_INDEX_MSG, sizeof(log_Index), \
+      "IDX", "BQI", "K,Key,Val", "---", "---" }, \
+    { LOG_INDEX_END_MSG, sizeof(log_IndexEnd), \
+      "IDXE", "IIHHH", "Start,Boot,NT,NF,NC", "-----", "-----" }, \
     { LOG_RPM_MSG, sizeof(log_RPM), \
       "RPM",  "Qff", "TimeUS,rpm1,rpm2", "sqq", "F00" }, \
     { LOG_GIMBAL1_MSG, sizeof(log_Gimbal1), \
@@ -1491,9 +1744,9 @@ Format characters in the format string for binary log messages
     { LOG_RALLY_MSG, sizeof(log_Rally), \
       "RALY", "QBBLLh", "TimeUS,Tot,Seq,Lat,Lng,Alt", "s--DUm", "F--GGB" },  \
     { LOG_MAV_MSG, sizeof(log_MAV),   \
-      "MAV", "QBHHH",   "TimeUS,chan,txp,rxp,rxdp", "s#---", "F-000" },   \
+      "MAV", "QBHHHHHHHI",   "TimeUS,chan,txp,rxp,rxdp,sreq,ssnt,sdrp,sgn,sgnt", "s#-------s", "F-0000000F" },   \
     { LOG_VISUALODOM_MSG, sizeof(log_VisualOdom), \
-      "VISO", "Qffffffff", "TimeUS,dt,AngDX,AngDY,AngDZ,PosDX,PosDY,PosDZ,conf", "ssrrrmmm-", "FF000000-" }, \
+      "VISO", "QffffffffII", "TimeUS,dt,AngDX,AngDY,AngDZ,PosDX,PosDY,PosDZ,conf,RLag,FLag", "ssrrrmmm-ss", "FF000000-CC" }, \
     { LOG_OPTFLOW_MSG, sizeof(log_Optflow), \
       "OF",   "QBffff",   "TimeUS,Qual,flowX,flowY,bodyX,bodyY", "s-EEEE", "F-0000" }, \
     { LOG_WHEELENCODER_MSG, sizeof(log_WheelEncoder), \
@@ -1552,6 +1805,23 @@ enum LogMessages : uint8_t {
     LOG_XKFD_MSG,
     LOG_XKV1_MSG,
     LOG_XKV2_MSG,
+    // the IDs above LOG_FORMAT_MSG have all been used
+    LOG_SCHED_TASK_MSG,
+    LOG_ISBC_MSG,
+    LOG_RATE_LIMIT_MSG,
+    LOG_INDEX_MSG,
+    LOG_INDEX_END_MSG,
+    LOG_FTN_MSG,
+    LOG_GYRO_LATENCY_MSG,
+    LOG_IMU_BUS_MSG,
+    LOG_DMA_MSG,
+    LOG_OA_MSG,
+    LOG_UART_MSG,
+    LOG_CANT_MSG,
+    LOG_IOMCU_MSG,
+    LOG_CANR_MSG,
+    LOG_TERRAIN_IO_MSG,
+    _LOG_LAST_LOW_MSG_,
 
     LOG_FORMAT_MSG = 128, // this must remain #128
 
@@ -1676,11 +1946,13 @@ enum LogMessages : uint8_t {
     LOG_MAV_MSG,
     LOG_ERROR_MSG,
     LOG_ADSB_MSG,
+    LOG_DF_FILE_LATENCY,
 
     _LOG_LAST_MSG_
 };
 
 static_assert(_LOG_LAST_MSG_ <= 255, "Too many message formats");
+static_assert(_LOG_LAST_LOW_MSG_ <= LOG_FORMAT_MSG, "Too many message formats below LOG_FORMAT_MSG");
 
 enum LogOriginType {
     ekf_origin = 0,
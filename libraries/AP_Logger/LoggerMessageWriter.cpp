@@ -137,6 +137,7 @@ void LoggerMessageWriter_WriteSysInfo::reset()
 {
     LoggerMessageWriter::reset();
     stage = ws_blockwriter_stage_formats;
+    _next_boot_stage = 0;
 }
 
 void LoggerMessageWriter_WriteSysInfo::process() {
@@ -181,6 +182,19 @@ void LoggerMessageWriter_WriteSysInfo::process() {
                 return; // call me again
             }
         }
+        stage = ws_blockwriter_stage_boot_timeline;
+        FALLTHROUGH;
+
+    case ws_blockwriter_stage_boot_timeline: {
+        const AP_Logger &logger = AP::logger();
+        char msg[65] {}; // sizeof(log_Message.msg) + null-termination
+        while (logger.format_boot_stage(_next_boot_stage, msg, sizeof(msg))) {
+            if (! _logger_backend->Write_Message(msg)) {
+                return; // call me again
+            }
+            _next_boot_stage++;
+        }
+    }
     }
 
     _finished = true;  // all done!
@@ -30,9 +30,11 @@ private:
         ws_blockwriter_stage_formats = 0,
         ws_blockwriter_stage_firmware_string,
         ws_blockwriter_stage_git_versions,
-        ws_blockwriter_stage_system_id
+        ws_blockwriter_stage_system_id,
+        ws_blockwriter_stage_boot_timeline,
     };
     write_sysinfo_blockwriter_stage stage;
+    uint8_t _next_boot_stage;
 };
 
 class LoggerMessageWriter_WriteEntireMission : public LoggerMessageWriter {
@@ -0,0 +1,76 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Logger/AP_Logger.h>
+
+#include <stdio.h>
+
+/*
+  cost of finding the format for AP_Logger::Write() with 60 formats
+  registered.  The logger has no backends so only the lookup and
+  argument handling is measured.  The argument is the index of the
+  format written; formats registered first sit deepest in
+  log_write_fmts.  BM_WriteFmtListWalk is the previous list walk for
+  comparison
+ */
+
+#define NUM_FORMATS 60
+
+static AP_Int32 log_bitmask;
+static AP_Logger logger{log_bitmask};
+
+// each name needs its own address, as string literals would have
+static char names[NUM_FORMATS][5];
+
+static void register_formats()
+{
+    static bool done;
+    if (done) {
+        return;
+    }
+    for (uint8_t i=0; i<NUM_FORMATS; i++) {
+        snprintf(names[i], sizeof(names[i]), "B%03u", (unsigned)i);
+        logger.Write(names[i], "TimeUS,V", "Qf", (uint64_t)0, 0.0f);
+    }
+    done = true;
+}
+
+static void BM_WriteFmtLookup(benchmark::State& state)
+{
+    register_formats();
+    const char *name = names[state.range(0)];
+    while (state.KeepRunning()) {
+        logger.Write(name, "TimeUS,V", "Qf", (uint64_t)1, 1.0f);
+    }
+}
+
+struct list_fmt {
+    struct list_fmt *next;
+    const char *name;
+};
+
+static void BM_WriteFmtListWalk(benchmark::State& state)
+{
+    static list_fmt fmts[NUM_FORMATS];
+    list_fmt *head = nullptr;
+    for (uint8_t i=0; i<NUM_FORMATS; i++) {
+        fmts[i].name = names[i];
+        fmts[i].next = head;
+        head = &fmts[i];
+    }
+    const char *name = names[state.range(0)];
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&name);
+        list_fmt *f;
+        for (f = head; f; f=f->next) {
+            if (f->name == name) {
+                break;
+            }
+        }
+        gbenchmark_escape(&f);
+    }
+}
+
+BENCHMARK(BM_WriteFmtLookup)->Arg(0)->Arg(NUM_FORMATS/2)->Arg(NUM_FORMATS-1);
+BENCHMARK(BM_WriteFmtListWalk)->Arg(0)->Arg(NUM_FORMATS/2)->Arg(NUM_FORMATS-1);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,63 @@
+#include <AP_gtest.h>
+
+#include <AP_Logger/ISBCodec.h>
+
+static int16_t x[1024];
+static int16_t y[1024];
+static int16_t z[1024];
+
+// pack the whole batch into ISBC messages and check it unpacks
+// unchanged; returns the number of messages used
+static uint16_t check_round_trip()
+{
+    int16_t dx[ISBCodec::MAX_SAMPLES];
+    int16_t dy[ISBCodec::MAX_SAMPLES];
+    int16_t dz[ISBCodec::MAX_SAMPLES];
+    uint16_t msgs = 0;
+    for (uint16_t ofs=0; ofs<ARRAY_SIZE(x); msgs++) {
+        struct log_ISBC pkt {};
+        const uint8_t n = ISBCodec::encode(pkt, &x[ofs], &y[ofs], &z[ofs], ARRAY_SIZE(x)-ofs);
+        EXPECT_GT(n, 0);
+        EXPECT_EQ(n, pkt.count);
+        EXPECT_TRUE(ISBCodec::decode(pkt, dx, dy, dz));
+        for (uint8_t i=0; i<n; i++) {
+            EXPECT_EQ(x[ofs+i], dx[i]);
+            EXPECT_EQ(y[ofs+i], dy[i]);
+            EXPECT_EQ(z[ofs+i], dz[i]);
+        }
+        ofs += n;
+    }
+    return msgs;
+}
+
+TEST(ISBCodec, RoundTrip)
+{
+    // slowly varying data packs far more densely than ISBD
+    for (uint16_t i=0; i<ARRAY_SIZE(x); i++) {
+        x[i] = 100 + (i % 8);
+        y[i] = -4000 - (i % 3);
+        z[i] = 32767 - i;
+    }
+    EXPECT_LE(check_round_trip(), ARRAY_SIZE(x) / 32 / 4);
+
+    // full-scale steps need 17 bit deltas but must still round-trip
+    for (uint16_t i=0; i<ARRAY_SIZE(x); i++) {
+        x[i] = (i & 1) ? INT16_MAX : INT16_MIN;
+        y[i] = (i & 2) ? INT16_MIN : INT16_MAX;
+        z[i] = 0;
+    }
+    check_round_trip();
+}
+
+TEST(ISBCodec, Corrupt)
+{
+    struct log_ISBC pkt {};
+    EXPECT_FALSE(ISBCodec::decode(pkt, x, y, z));
+
+    // more bits than the data field holds
+    pkt.count = 255;
+    pkt.x_bits = 17;
+    EXPECT_FALSE(ISBCodec::decode(pkt, x, y, z));
+}
+
+AP_GTEST_MAIN()
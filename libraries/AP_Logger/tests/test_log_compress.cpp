@@ -0,0 +1,68 @@
+#include <AP_gtest.h>
+
+#include <AP_Logger/LogCompress.h>
+#include <string.h>
+
+static LogCompressor compressor;
+static uint8_t raw[4096];
+static uint8_t frame[LogCompressor::max_frame_size(sizeof(raw))];
+static uint8_t decoded[sizeof(raw)];
+
+// compress len bytes of raw into frame and check they decode back
+static void check_round_trip(uint16_t len)
+{
+    const uint32_t frame_len = compressor.compress_frame(raw, len, frame);
+    EXPECT_LE(frame_len, LogCompressor::max_frame_size(len));
+
+    const LogCompressor::frame_header &hdr = *(const LogCompressor::frame_header *)frame;
+    EXPECT_EQ(LOG_COMPRESS_MAGIC1, hdr.magic1);
+    EXPECT_EQ(LOG_COMPRESS_MAGIC2, hdr.magic2);
+    EXPECT_EQ(len, hdr.raw_len);
+    EXPECT_EQ(frame_len, sizeof(hdr) + hdr.data_len);
+
+    const uint8_t *data = &frame[sizeof(hdr)];
+    if (hdr.flags & LogCompressor::FRAME_COMPRESSED) {
+        EXPECT_LT(hdr.data_len, len);
+        EXPECT_EQ(len, LogCompressor::decompress_block(data, hdr.data_len, decoded, sizeof(decoded)));
+    } else {
+        EXPECT_EQ(len, hdr.data_len);
+        memcpy(decoded, data, len);
+    }
+    EXPECT_EQ(0, memcmp(raw, decoded, len));
+}
+
+TEST(LogCompress, RoundTrip)
+{
+    // log-like data: repeated headers and slowly changing fields
+    for (uint16_t i=0; i<sizeof(raw); i++) {
+        raw[i] = (i % 40 < 3) ? 0xA3 + i % 40 : (i / 40) & 0x7;
+    }
+    for (uint16_t len : { 0, 1, 12, 13, 17, 100, 1000, 4096 }) {
+        check_round_trip(len);
+    }
+
+    // incompressible data is stored raw
+    uint32_t seed = 1;
+    for (uint16_t i=0; i<sizeof(raw); i++) {
+        seed = seed * 1103515245 + 12345;
+        raw[i] = seed >> 16;
+    }
+    check_round_trip(sizeof(raw));
+    EXPECT_EQ(0, ((const LogCompressor::frame_header *)frame)->flags);
+}
+
+TEST(LogCompress, Corrupt)
+{
+    memset(raw, 0x55, sizeof(raw));
+    compressor.compress_frame(raw, sizeof(raw), frame);
+    const LogCompressor::frame_header &hdr = *(const LogCompressor::frame_header *)frame;
+    const uint8_t *data = &frame[sizeof(hdr)];
+    ASSERT_NE(0, hdr.flags & LogCompressor::FRAME_COMPRESSED);
+
+    // output doesn't fit
+    EXPECT_EQ(-1, LogCompressor::decompress_block(data, hdr.data_len, decoded, sizeof(decoded)-1));
+    // truncated input
+    EXPECT_EQ(-1, LogCompressor::decompress_block(data, hdr.data_len-1, decoded, sizeof(decoded)));
+}
+
+AP_GTEST_MAIN()
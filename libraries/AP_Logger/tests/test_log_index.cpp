@@ -0,0 +1,98 @@
+#include <AP_gtest.h>
+
+#include <AP_Logger/AP_Logger_FileIndex.h>
+
+#include <stdio.h>
+#include <unistd.h>
+
+static const uint32_t startup_len = 5000;
+
+// feed one hour of 100 byte messages at 10Hz, with a late FMT after
+// ten minutes; returns the offset at the end
+static uint32_t fill(AP_Logger_FileIndex &index)
+{
+    struct log_Format fmt {};
+    fmt.head1 = HEAD_BYTE1;
+    fmt.head2 = HEAD_BYTE2;
+    fmt.msgid = LOG_FORMAT_MSG;
+    fmt.type = 200;
+
+    uint8_t msg[100] { HEAD_BYTE1, HEAD_BYTE2, LOG_PARAMETER_MSG };
+
+    uint32_t ofs = 0;
+    for (; ofs < startup_len; ofs += sizeof(msg)) {
+        index.note_message(0, ofs, msg, sizeof(msg));
+    }
+    index.note_startup_done(ofs);
+
+    msg[2] = LOG_IMU_MSG;
+    for (uint64_t t=0; t<3600000000ULL; t+=100000) {
+        if (t == 600000000ULL) {
+            index.note_message(t, ofs, (const uint8_t *)&fmt, sizeof(fmt));
+            ofs += sizeof(fmt);
+        }
+        index.note_message(t, ofs, msg, sizeof(msg));
+        ofs += sizeof(msg);
+    }
+    return ofs;
+}
+
+TEST(AP_Logger_FileIndex, RoundTrip)
+{
+    AP_Logger_FileIndex index;
+    ASSERT_TRUE(index.init());
+    const uint32_t end_ofs = fill(index);
+
+    // the whole hour must fit, to within 32 seconds
+    EXPECT_GE(index.offset_for_time(3590000000ULL), end_ofs - (10+32)*10*100);
+    EXPECT_EQ(startup_len, index.offset_for_time(0));
+
+    char path[] = "/tmp/log_index_XXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_NE(-1, fd);
+    unlink(path);
+    ASSERT_EQ(0, ftruncate(fd, end_ofs));
+    ASSERT_EQ((off_t)end_ofs, lseek(fd, end_ofs, SEEK_SET));
+    ASSERT_TRUE(index.write(fd, end_ofs));
+
+    AP_Logger_FileIndex loaded;
+    ASSERT_TRUE(loaded.load(fd));
+    EXPECT_EQ(startup_len, loaded.startup_end());
+    EXPECT_EQ(index.count(LOG_IMU_MSG), loaded.count(LOG_IMU_MSG));
+    EXPECT_EQ(36000U, loaded.count(LOG_IMU_MSG));
+    EXPECT_EQ(50U, loaded.count(LOG_PARAMETER_MSG));
+    EXPECT_EQ(startup_len + 6000*100, loaded.format_offset(200));
+    EXPECT_EQ(0U, loaded.format_offset(201));
+    for (uint64_t t=0; t<3600000000ULL; t+=60000000ULL) {
+        const uint32_t ofs = loaded.offset_for_time(t);
+        EXPECT_EQ(index.offset_for_time(t), ofs);
+        // the offset found must be at or before the data for t
+        const uint32_t exact = startup_len + t/100000*100 + (t >= 600000000ULL ? sizeof(log_Format) : 0);
+        EXPECT_LE(ofs, exact);
+    }
+    close(fd);
+}
+
+TEST(AP_Logger_FileIndex, NotIndexed)
+{
+    char path[] = "/tmp/log_index_XXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_NE(-1, fd);
+    unlink(path);
+    uint8_t junk[1000] {};
+    ASSERT_EQ((ssize_t)sizeof(junk), write(fd, junk, sizeof(junk)));
+
+    AP_Logger_FileIndex index;
+    EXPECT_FALSE(index.load(fd));
+
+    // data dropped before the file was closed is not indexed
+    ASSERT_TRUE(index.init());
+    const uint32_t end_ofs = fill(index);
+    ASSERT_EQ((off_t)sizeof(junk), lseek(fd, sizeof(junk), SEEK_SET));
+    EXPECT_TRUE(index.write(fd, sizeof(junk)));
+    EXPECT_FALSE(index.load(fd));
+    EXPECT_LT(0U, end_ofs);
+    close(fd);
+}
+
+AP_GTEST_MAIN()
@@ -17,7 +17,9 @@
 #include "vector2.h"
 #include "vector3.h"
 #include "spline5.h"
+#include "control.h"
 #include "location.h"
+#include "fast_math.h"
 
 // define AP_Param types AP_Vector3f and Ap_Matrix3f
 AP_PARAMDEFV(Vector3f, Vector3f, AP_PARAM_VECTOR3F);
@@ -93,6 +95,32 @@ float *mat_mul(float *A, float *B, uint8_t n);
 // matrix algebra
 bool inverse(float x[], float y[], uint16_t dim);
 
+/*
+  allocation free matrix algebra with the dimension fixed at compile
+  time, on caller owned NxN row major storage. These are instantiated
+  for N of 2 to 9. VectorN and MatrixN storage can be passed with
+  &v[0] and MatrixN::inverse()
+ */
+
+// out = A*B, out must not be A or B
+template <uint8_t N>
+void mat_mul(const float *A, const float *B, float *out);
+
+// inv = inverse of A, inv may be A. Returns false if A is singular
+template <uint8_t N>
+bool mat_inverse(const float *A, float *inv);
+
+// lower triangular L such that A = L*L', for symmetric A. L may be A.
+// Returns false if A is not positive definite
+template <uint8_t N>
+bool mat_cholesky(const float *A, float *L);
+
+// solve A*x = b for symmetric positive definite A, which is cheaper
+// and more accurate than multiplying b by the inverse of A. x may be
+// b. Returns false if A is not positive definite
+template <uint8_t N>
+bool mat_cholesky_solve(const float *A, const float *b, float *x);
+
 /*
  * Constrain an angle to be within the range: -180 to 180 degrees. The second
  * parameter changes the units. Default: 1 == degrees, 10 == dezi,
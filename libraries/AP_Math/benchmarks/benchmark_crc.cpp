@@ -0,0 +1,84 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/crc.h>
+
+/*
+  the table driven CRCs against bit at a time versions, over a 4k
+  block the size of a flash sector write
+ */
+
+static uint8_t buf[4096];
+
+static void setup_buf(void)
+{
+    for (uint16_t i=0; i<ARRAY_SIZE(buf); i++) {
+        buf[i] = i * 37 + 11;
+    }
+}
+
+static uint32_t crc32_bitwise(uint32_t crc, const uint8_t *p, uint32_t size)
+{
+    while (size--) {
+        crc ^= *p++;
+        for (uint8_t i=0; i<8; i++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+static uint16_t xmodem_bitwise(const uint8_t *p, uint16_t size)
+{
+    uint16_t crc = 0;
+    while (size--) {
+        crc ^= uint16_t(*p++) << 8;
+        for (uint8_t i=0; i<8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static void BM_CRC32Bitwise(benchmark::State& state)
+{
+    setup_buf();
+    while (state.KeepRunning()) {
+        uint32_t crc = crc32_bitwise(0, buf, sizeof(buf));
+        gbenchmark_escape(&crc);
+    }
+}
+
+static void BM_CRC32(benchmark::State& state)
+{
+    setup_buf();
+    while (state.KeepRunning()) {
+        uint32_t crc = crc_crc32(0, buf, sizeof(buf));
+        gbenchmark_escape(&crc);
+    }
+}
+
+static void BM_XModemBitwise(benchmark::State& state)
+{
+    setup_buf();
+    while (state.KeepRunning()) {
+        uint16_t crc = xmodem_bitwise(buf, sizeof(buf));
+        gbenchmark_escape(&crc);
+    }
+}
+
+static void BM_XModem(benchmark::State& state)
+{
+    setup_buf();
+    while (state.KeepRunning()) {
+        uint16_t crc = crc_xmodem(buf, sizeof(buf));
+        gbenchmark_escape(&crc);
+    }
+}
+
+BENCHMARK(BM_CRC32Bitwise);
+BENCHMARK(BM_CRC32);
+BENCHMARK(BM_XModemBitwise);
+BENCHMARK(BM_XModem);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,64 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+/*
+  libm against the approximations in fast_math.h. The inputs cycle
+  through a table so the compiler can't fold the calls away
+ */
+
+static float inputs[256];
+
+static void setup_inputs(float scale, float offset)
+{
+    for (uint16_t i=0; i<ARRAY_SIZE(inputs); i++) {
+        inputs[i] = offset + scale * i / ARRAY_SIZE(inputs);
+    }
+}
+
+#define BENCH_UNARY(name, func, scale, offset)              \
+static void name(benchmark::State& state)                   \
+{                                                           \
+    setup_inputs(scale, offset);                            \
+    uint8_t i = 0;                                          \
+    while (state.KeepRunning()) {                           \
+        float r = func(inputs[i++]);                        \
+        gbenchmark_escape(&r);                              \
+    }                                                       \
+}                                                           \
+BENCHMARK(name)
+
+BENCH_UNARY(BM_LibmSinf, sinf, 20, -10);
+BENCH_UNARY(BM_FastSinf, fast_sinf, 20, -10);
+BENCH_UNARY(BM_LibmCosf, cosf, 20, -10);
+BENCH_UNARY(BM_FastCosf, fast_cosf, 20, -10);
+BENCH_UNARY(BM_LibmAsinf, safe_asin, 2, -1);
+BENCH_UNARY(BM_FastAsinf, fast_asinf, 2, -1);
+BENCH_UNARY(BM_LibmInvSqrtf, 1.0f/sqrtf, 100, 0.01f);
+BENCH_UNARY(BM_FastInvSqrtf, fast_inv_sqrtf, 100, 0.01f);
+
+static void BM_LibmAtan2f(benchmark::State& state)
+{
+    setup_inputs(20, -10);
+    uint8_t i = 0;
+    while (state.KeepRunning()) {
+        float r = atan2f(inputs[i], inputs[uint8_t(i+77)]);
+        i++;
+        gbenchmark_escape(&r);
+    }
+}
+BENCHMARK(BM_LibmAtan2f);
+
+static void BM_FastAtan2f(benchmark::State& state)
+{
+    setup_inputs(20, -10);
+    uint8_t i = 0;
+    while (state.KeepRunning()) {
+        float r = fast_atan2f(inputs[i], inputs[uint8_t(i+77)]);
+        i++;
+        gbenchmark_escape(&r);
+    }
+}
+BENCHMARK(BM_FastAtan2f);
+
+BENCHMARK_MAIN()
@@ -1,22 +1,269 @@
 #include <AP_gbenchmark.h>
 
 #include <AP_Math/AP_Math.h>
+#include <AP_Math/matrixN.h>
+
+static const Matrix3f m1(Vector3f(1.0f, 2.0f, 3.0f),
+                         Vector3f(4.0f, 5.0f, 6.0f),
+                         Vector3f(7.0f, 8.0f, 9.0f));
+static const Matrix3f m2(Vector3f(1.0f, 2.0f, 3.0f),
+                         Vector3f(4.0f, 5.0f, 6.0f),
+                         Vector3f(7.0f, 8.0f, 9.0f));
+static const Vector3f v1(0.1f, -0.2f, 0.3f);
+
+/*
+  scalar reference versions of the products with SIMD implementations
+  selected in AP_Math/simd.h, used to show the gain from them
+ */
+static NOINLINE Matrix3f scalar_mul(const Matrix3f &l, const Matrix3f &m)
+{
+    return Matrix3f(Vector3f(l.a.x * m.a.x + l.a.y * m.b.x + l.a.z * m.c.x,
+                             l.a.x * m.a.y + l.a.y * m.b.y + l.a.z * m.c.y,
+                             l.a.x * m.a.z + l.a.y * m.b.z + l.a.z * m.c.z),
+                    Vector3f(l.b.x * m.a.x + l.b.y * m.b.x + l.b.z * m.c.x,
+                             l.b.x * m.a.y + l.b.y * m.b.y + l.b.z * m.c.y,
+                             l.b.x * m.a.z + l.b.y * m.b.z + l.b.z * m.c.z),
+                    Vector3f(l.c.x * m.a.x + l.c.y * m.b.x + l.c.z * m.c.x,
+                             l.c.x * m.a.y + l.c.y * m.b.y + l.c.z * m.c.y,
+                             l.c.x * m.a.z + l.c.y * m.b.z + l.c.z * m.c.z));
+}
+
+static NOINLINE Quaternion scalar_mul(const Quaternion &p, const Quaternion &q)
+{
+    return Quaternion(p.q1*q.q1 - p.q2*q.q2 - p.q3*q.q3 - p.q4*q.q4,
+                      p.q1*q.q2 + p.q2*q.q1 + p.q3*q.q4 - p.q4*q.q3,
+                      p.q1*q.q3 - p.q2*q.q4 + p.q3*q.q1 + p.q4*q.q2,
+                      p.q1*q.q4 + p.q2*q.q3 - p.q3*q.q2 + p.q4*q.q1);
+}
 
 static void BM_MatrixMultiplication(benchmark::State& state)
 {
-    Matrix3f m1(Vector3f(1.0f, 2.0f, 3.0f),
-                Vector3f(4.0f, 5.0f, 6.0f),
-                Vector3f(7.0f, 8.0f, 9.0f));
-    Matrix3f m2(Vector3f(1.0f, 2.0f, 3.0f),
-                Vector3f(4.0f, 5.0f, 6.0f),
-                Vector3f(7.0f, 8.0f, 9.0f));
+    Matrix3f a = m1;
+    Matrix3f b = m2;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&a);
+        gbenchmark_escape(&b);
+        Matrix3f m3 = a * b;
+        gbenchmark_escape(&m3);
+    }
+}
+
+static void BM_MatrixMultiplicationScalar(benchmark::State& state)
+{
+    Matrix3f a = m1;
+    Matrix3f b = m2;
 
     while (state.KeepRunning()) {
-        Matrix3f m3 = m1 * m2;
+        gbenchmark_escape(&a);
+        gbenchmark_escape(&b);
+        Matrix3f m3 = scalar_mul(a, b);
         gbenchmark_escape(&m3);
     }
 }
 
+static void BM_MatrixVectorMultiplication(benchmark::State& state)
+{
+    Matrix3f m = m1;
+    Vector3f v = v1;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&m);
+        gbenchmark_escape(&v);
+        Vector3f r = m * v;
+        gbenchmark_escape(&r);
+    }
+}
+
+static void BM_MatrixMulTranspose(benchmark::State& state)
+{
+    Matrix3f m = m1;
+    Vector3f v = v1;
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&m);
+        gbenchmark_escape(&v);
+        Vector3f r = m.mul_transpose(v);
+        gbenchmark_escape(&r);
+    }
+}
+
+static void BM_QuaternionMultiplication(benchmark::State& state)
+{
+    Quaternion p(0.9f, 0.1f, -0.2f, 0.3f);
+    Quaternion q(0.8f, -0.3f, 0.4f, 0.1f);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&p);
+        gbenchmark_escape(&q);
+        Quaternion r = p * q;
+        gbenchmark_escape(&r);
+    }
+}
+
+static void BM_QuaternionMultiplicationScalar(benchmark::State& state)
+{
+    Quaternion p(0.9f, 0.1f, -0.2f, 0.3f);
+    Quaternion q(0.8f, -0.3f, 0.4f, 0.1f);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&p);
+        gbenchmark_escape(&q);
+        Quaternion r = scalar_mul(p, q);
+        gbenchmark_escape(&r);
+    }
+}
+
+static void BM_QuaternionEarthToBody(benchmark::State& state)
+{
+    Quaternion q(0.9f, 0.1f, -0.2f, 0.3f);
+    q.normalize();
+
+    while (state.KeepRunning()) {
+        Vector3f v = v1;
+        gbenchmark_escape(&q);
+        q.earth_to_body(v);
+        gbenchmark_escape(&v);
+    }
+}
+
+/*
+  9x9 symmetric positive definite matrix, the size of the JTJ of the
+  ellipsoid fits in the compass and accel calibrators
+ */
+static void make_jtj(float JTJ[81], float JTFI[9])
+{
+    for (uint8_t i = 0; i < 9; i++) {
+        for (uint8_t j = 0; j < 9; j++) {
+            JTJ[i*9 + j] = (i == j) ? 10.0f : 1.0f / (1 + i + j);
+        }
+        JTFI[i] = 0.1f * i;
+    }
+}
+
+static void BM_MatrixMul9Generic(benchmark::State& state)
+{
+    float a[81], b[9];
+    make_jtj(a, b);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(a);
+        float *r = mat_mul(a, a, 9);
+        gbenchmark_escape(r);
+        delete[] r;
+    }
+}
+
+static void BM_MatrixMul9Fixed(benchmark::State& state)
+{
+    float a[81], b[9], r[81];
+    make_jtj(a, b);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(a);
+        mat_mul<9>(a, a, r);
+        gbenchmark_escape(r);
+    }
+}
+
+static void BM_MatrixInverse9Generic(benchmark::State& state)
+{
+    float a[81], b[9], inv[81];
+    make_jtj(a, b);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(a);
+        inverse(a, inv, 9);
+        gbenchmark_escape(inv);
+    }
+}
+
+static void BM_MatrixInverse9Fixed(benchmark::State& state)
+{
+    float a[81], b[9], inv[81];
+    make_jtj(a, b);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(a);
+        mat_inverse<9>(a, inv);
+        gbenchmark_escape(inv);
+    }
+}
+
+static void BM_MatrixCholeskySolve9(benchmark::State& state)
+{
+    float a[81], b[9], x[9];
+    make_jtj(a, b);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(a);
+        gbenchmark_escape(b);
+        mat_cholesky_solve<9>(a, b, x);
+        gbenchmark_escape(x);
+    }
+}
+
+template <uint8_t N>
+static void make_covariance(MatrixN<float,N> &F, MatrixN<float,N> &P, MatrixN<float,N> &Q)
+{
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            F[i][j] = (i == j) ? 1.0f : 0.01f * (i + j);
+            P[i][j] = (i == j) ? 1.0f : 0.1f;
+            Q[i][j] = (i == j) ? 0.01f : 0.0f;
+        }
+    }
+}
+
+// P = F*P*F' + Q with two multiplications, as a filter written without predict_covariance() would
+template <uint8_t N>
+static void BM_MatrixNCovarianceMultiply(benchmark::State& state)
+{
+    MatrixN<float,N> F, P, Q, FT, FP;
+    make_covariance(F, P, Q);
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            FT[i][j] = F[j][i];
+        }
+    }
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&F);
+        FP.mult(F, P);
+        P.mult(FP, FT);
+        P += Q;
+        gbenchmark_escape(&P);
+    }
+}
+
+template <uint8_t N>
+static void BM_MatrixNPredictCovariance(benchmark::State& state)
+{
+    MatrixN<float,N> F, P, Q;
+    make_covariance(F, P, Q);
+
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&F);
+        P.predict_covariance(F, Q);
+        gbenchmark_escape(&P);
+    }
+}
+
 BENCHMARK(BM_MatrixMultiplication);
+BENCHMARK(BM_MatrixMultiplicationScalar);
+BENCHMARK(BM_MatrixVectorMultiplication);
+BENCHMARK(BM_MatrixMulTranspose);
+BENCHMARK(BM_QuaternionMultiplication);
+BENCHMARK(BM_QuaternionMultiplicationScalar);
+BENCHMARK(BM_QuaternionEarthToBody);
+BENCHMARK(BM_MatrixMul9Generic);
+BENCHMARK(BM_MatrixMul9Fixed);
+BENCHMARK(BM_MatrixInverse9Generic);
+BENCHMARK(BM_MatrixInverse9Fixed);
+BENCHMARK(BM_MatrixCholeskySolve9);
+BENCHMARK_TEMPLATE(BM_MatrixNCovarianceMultiply, 4);
+BENCHMARK_TEMPLATE(BM_MatrixNPredictCovariance, 4);
+BENCHMARK_TEMPLATE(BM_MatrixNCovarianceMultiply, 24);
+BENCHMARK_TEMPLATE(BM_MatrixNPredictCovariance, 24);
 
 BENCHMARK_MAIN()
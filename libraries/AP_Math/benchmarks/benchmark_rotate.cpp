@@ -0,0 +1,92 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+
+/*
+  Vector3f::rotate_inverse() against the matrix it used to build on
+  each call, kept here as the reference, and against rotate() for
+  scale. BM_*Mixed steps through all the rotations
+ */
+static NOINLINE void matrix_rotate_inverse(Vector3f &v, enum Rotation rotation)
+{
+    Vector3f x_vec(1.0f,0.0f,0.0f);
+    Vector3f y_vec(0.0f,1.0f,0.0f);
+    Vector3f z_vec(0.0f,0.0f,1.0f);
+
+    x_vec.rotate(rotation);
+    y_vec.rotate(rotation);
+    z_vec.rotate(rotation);
+
+    Matrix3f M(
+        x_vec.x, y_vec.x, z_vec.x,
+        x_vec.y, y_vec.y, z_vec.y,
+        x_vec.z, y_vec.z, z_vec.z
+    );
+
+    v = M.mul_transpose(v);
+}
+
+static void BM_Rotate(benchmark::State& state)
+{
+    const enum Rotation rotation = (enum Rotation)state.range(0);
+    Vector3f v(0.1f, -0.2f, 0.3f);
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&v);
+        v.rotate(rotation);
+        gbenchmark_escape(&v);
+    }
+}
+
+static void BM_RotateInverse(benchmark::State& state)
+{
+    const enum Rotation rotation = (enum Rotation)state.range(0);
+    Vector3f v(0.1f, -0.2f, 0.3f);
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&v);
+        v.rotate_inverse(rotation);
+        gbenchmark_escape(&v);
+    }
+}
+
+static void BM_RotateInverseMatrix(benchmark::State& state)
+{
+    const enum Rotation rotation = (enum Rotation)state.range(0);
+    Vector3f v(0.1f, -0.2f, 0.3f);
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&v);
+        matrix_rotate_inverse(v, rotation);
+        gbenchmark_escape(&v);
+    }
+}
+
+static void BM_RotateInverseMixed(benchmark::State& state)
+{
+    Vector3f v(0.1f, -0.2f, 0.3f);
+    uint8_t r = 0;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&v);
+        v.rotate_inverse((enum Rotation)r);
+        gbenchmark_escape(&v);
+        r = (r + 7) % ROTATION_MAX;
+    }
+}
+
+static void BM_RotateInverseMatrixMixed(benchmark::State& state)
+{
+    Vector3f v(0.1f, -0.2f, 0.3f);
+    uint8_t r = 0;
+    while (state.KeepRunning()) {
+        gbenchmark_escape(&v);
+        matrix_rotate_inverse(v, (enum Rotation)r);
+        gbenchmark_escape(&v);
+        r = (r + 7) % ROTATION_MAX;
+    }
+}
+
+BENCHMARK(BM_Rotate)->Arg(ROTATION_NONE)->Arg(ROTATION_YAW_90)->Arg(ROTATION_ROLL_180_YAW_45)->Arg(ROTATION_ROLL_90_PITCH_68_YAW_293);
+BENCHMARK(BM_RotateInverse)->Arg(ROTATION_NONE)->Arg(ROTATION_YAW_90)->Arg(ROTATION_ROLL_180_YAW_45)->Arg(ROTATION_ROLL_90_PITCH_68_YAW_293);
+BENCHMARK(BM_RotateInverseMatrix)->Arg(ROTATION_NONE)->Arg(ROTATION_YAW_90)->Arg(ROTATION_ROLL_180_YAW_45)->Arg(ROTATION_ROLL_90_PITCH_68_YAW_293);
+BENCHMARK(BM_RotateInverseMixed);
+BENCHMARK(BM_RotateInverseMatrixMixed);
+
+BENCHMARK_MAIN()
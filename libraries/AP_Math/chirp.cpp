@@ -0,0 +1,80 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_Math.h"
+#include "chirp.h"
+
+/*
+  set up the waveform. It is complete after time_const_freq_s plus
+  time_record_s
+ */
+void Chirp::init(float time_record_s, float frequency_start_hz, float frequency_stop_hz,
+                 float time_fade_in_s, float time_fade_out_s, float time_const_freq_s)
+{
+    time_record = MAX(time_record_s, 0);
+    frequency_start = MAX(frequency_start_hz, 0.01f);
+    frequency_stop = MAX(frequency_stop_hz, frequency_start);
+    time_const_freq = MAX(time_const_freq_s, 0);
+
+    // the fades can't take more than the whole waveform
+    const float duration = get_duration_s();
+    time_fade_in = constrain_float(time_fade_in_s, 0, duration);
+    time_fade_out = constrain_float(time_fade_out_s, 0, duration - time_fade_in);
+
+    rise_rate = is_positive(time_record) ? logf(frequency_stop / frequency_start) / time_record : 0;
+    frequency_hz = frequency_start;
+    complete = false;
+}
+
+float Chirp::update(float time_s, float magnitude)
+{
+    const float duration = get_duration_s();
+    if (time_s >= duration) {
+        complete = true;
+        frequency_hz = frequency_stop;
+        return 0;
+    }
+    complete = false;
+    time_s = MAX(time_s, 0);
+
+    // raised cosine fades
+    float window = 1;
+    if (time_s < time_fade_in) {
+        window = 0.5f * (1 - cosf(M_PI * time_s / time_fade_in));
+    } else if (time_s > duration - time_fade_out) {
+        window = 0.5f * (1 - cosf(M_PI * (duration - time_s) / time_fade_out));
+    }
+
+    // the phase is the integral of the frequency, so it is continuous
+    // into the sweep
+    float cycles;
+    if (time_s < time_const_freq) {
+        frequency_hz = frequency_start;
+        cycles = frequency_start * time_s;
+    } else {
+        const float t = time_s - time_const_freq;
+        cycles = frequency_start * time_const_freq;
+        if (is_positive(rise_rate)) {
+            const float rise = expf(rise_rate * t);
+            frequency_hz = frequency_start * rise;
+            cycles += frequency_start * (rise - 1) / rise_rate;
+        } else {
+            frequency_hz = frequency_start;
+            cycles += frequency_start * t;
+        }
+    }
+
+    return magnitude * window * sinf(M_2PI * (cycles - floorf(cycles)));
+}
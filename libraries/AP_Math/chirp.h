@@ -0,0 +1,53 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+  logarithmic frequency sweep (chirp) for system identification. The
+  waveform holds the start frequency for time_const_freq_s, then its
+  frequency rises exponentially to the stop frequency over
+  time_record_s, so each octave gets the same time. The magnitude is
+  faded in and out so the waveform starts and ends without steps
+ */
+class Chirp {
+public:
+    void init(float time_record_s, float frequency_start_hz, float frequency_stop_hz,
+              float time_fade_in_s, float time_fade_out_s, float time_const_freq_s);
+
+    // waveform at time_s since the start, with a peak of magnitude
+    float update(float time_s, float magnitude);
+
+    // frequency of the waveform at the last update
+    float get_frequency_hz() const { return frequency_hz; }
+
+    // total length of the waveform
+    float get_duration_s() const { return time_const_freq + time_record; }
+
+    bool completed() const { return complete; }
+
+private:
+    float time_record;
+    float frequency_start;
+    float frequency_stop;
+    float time_fade_in;
+    float time_fade_out;
+    float time_const_freq;
+
+    // exponential rate of frequency rise, in 1/s
+    float rise_rate;
+
+    float frequency_hz;
+    bool complete;
+};
@@ -0,0 +1,100 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_Math.h"
+
+Vector2f sqrt_controller(const Vector2f &error, float p, float second_ord_lim, float dt)
+{
+    const float error_length = error.length();
+    if (!is_positive(error_length)) {
+        return Vector2f();
+    }
+
+    float correction_length;
+    if (!is_positive(second_ord_lim)) {
+        // no second order limit, use a plain proportional controller
+        correction_length = error_length * p;
+    } else if (is_zero(p)) {
+        correction_length = safe_sqrt(2.0f * second_ord_lim * error_length);
+    } else {
+        const float linear_dist = second_ord_lim / sq(p);
+        if (error_length > linear_dist) {
+            correction_length = safe_sqrt(2.0f * second_ord_lim * (error_length - (linear_dist * 0.5f)));
+        } else {
+            correction_length = error_length * p;
+        }
+    }
+
+    // don't step past the target in one call
+    if (is_positive(dt)) {
+        correction_length = MIN(correction_length, error_length / dt);
+    }
+    return error * (correction_length / error_length);
+}
+
+void shape_vel_accel_xy(const Vector2f &vel_input, const Vector2f &accel_input,
+                        const Vector2f &vel, Vector2f &accel,
+                        float accel_max, float jerk_max, float dt)
+{
+    if (!is_positive(accel_max) || !is_positive(jerk_max) || !is_positive(dt)) {
+        return;
+    }
+
+    // the acceleration reaches accel_max in accel_max / jerk_max seconds,
+    // so close the velocity error with the same time constant
+    const float kpa = jerk_max / accel_max;
+    Vector2f accel_target = sqrt_controller(vel_input - vel, kpa, jerk_max, dt) + accel_input;
+    const float accel_length = accel_target.length();
+    if (accel_length > accel_max) {
+        accel_target *= accel_max / accel_length;
+    }
+
+    // limit the jerk
+    Vector2f accel_delta = accel_target - accel;
+    const float delta_length = accel_delta.length();
+    const float delta_max = jerk_max * dt;
+    if (delta_length > delta_max) {
+        accel_delta *= delta_max / delta_length;
+    }
+    accel += accel_delta;
+}
+
+void shape_pos_vel_accel_xy(const Vector2f &pos_input, const Vector2f &vel_input, const Vector2f &accel_input,
+                            const Vector2f &pos, const Vector2f &vel, Vector2f &accel,
+                            float vel_max, float accel_max, float jerk_max, float dt)
+{
+    if (!is_positive(accel_max) || !is_positive(jerk_max) || !is_positive(dt)) {
+        return;
+    }
+
+    // close the position error with half the acceleration and four times
+    // the time constant of the velocity shaping. The velocity shaping lags
+    // by about accel_max / jerk_max, so anything faster overshoots
+    const float kpv = 0.25f * jerk_max / accel_max;
+    Vector2f vel_target = sqrt_controller(pos_input - pos, kpv, 0.5f * accel_max, dt);
+    const float vel_length = vel_target.length();
+    if (is_positive(vel_max) && vel_length > vel_max) {
+        vel_target *= vel_max / vel_length;
+    }
+    vel_target += vel_input;
+
+    shape_vel_accel_xy(vel_target, accel_input, vel, accel, accel_max, jerk_max, dt);
+}
+
+void update_pos_vel_accel_xy(Vector2f &pos, Vector2f &vel, const Vector2f &accel, float dt)
+{
+    pos += vel * dt + accel * (0.5f * sq(dt));
+    vel += accel * dt;
+}
@@ -0,0 +1,50 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+  jerk limited trajectory shaping shared by the position controllers.
+
+  The shaping functions move the acceleration of a trajectory towards
+  the acceleration needed to follow a target, changing it by no more
+  than jerk_max * dt each call. The caller keeps the trajectory and
+  integrates the acceleration, so the position, velocity and
+  acceleration fed forward to a controller are always consistent.
+ */
+
+#include "vector2.h"
+
+// sqrt_controller - proportional controller with a sqrt section beyond
+//     second_ord_lim / p^2 which limits the second derivative of the
+//     output to second_ord_lim. The correction never crosses zero error
+//     within dt
+Vector2f sqrt_controller(const Vector2f &error, float p, float second_ord_lim, float dt);
+
+// shape_vel_accel_xy - move accel towards the acceleration which brings
+//     vel to vel_input, plus accel_input. accel is limited to accel_max
+//     and changes by at most jerk_max * dt
+void shape_vel_accel_xy(const Vector2f &vel_input, const Vector2f &accel_input,
+                        const Vector2f &vel, Vector2f &accel,
+                        float accel_max, float jerk_max, float dt);
+
+// shape_pos_vel_accel_xy - move accel towards the acceleration which
+//     brings pos to pos_input moving at vel_input. The velocity used to
+//     close the position error is limited to vel_max
+void shape_pos_vel_accel_xy(const Vector2f &pos_input, const Vector2f &vel_input, const Vector2f &accel_input,
+                            const Vector2f &pos, const Vector2f &vel, Vector2f &accel,
+                            float vel_max, float accel_max, float jerk_max, float dt);
+
+// update_pos_vel_accel_xy - move pos and vel on by dt at constant accel
+void update_pos_vel_accel_xy(Vector2f &pos, Vector2f &vel, const Vector2f &accel, float dt);
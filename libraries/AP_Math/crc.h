@@ -21,3 +21,9 @@ uint8_t crc_crc8(const uint8_t *p, uint8_t len);
 uint16_t crc_xmodem_update(uint16_t crc, uint8_t data);
 uint16_t crc_xmodem(const uint8_t *data, uint16_t len);
 uint32_t crc_crc32(uint32_t crc, const uint8_t *buf, uint32_t size);
+
+// 8 bit sum of the bytes, as used by simple serial sensor protocols
+uint8_t crc_sum8(const uint8_t *p, uint16_t len);
+
+// CRC-16 of Modbus RTU, sent low byte first
+uint16_t crc_modbus(const uint8_t *p, uint16_t len);
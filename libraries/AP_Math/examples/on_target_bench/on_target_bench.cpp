@@ -0,0 +1,227 @@
+//
+// Micro-benchmarks of the maths, filter and CRC code, run on the
+// board itself. On ChibiOS boards the Cortex-M DWT cycle counter is
+// used, so the results include the effect of the FPU, caches and
+// flash wait states; elsewhere the time is taken from
+// AP_HAL::micros() and reported as nanoseconds
+//
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/crc.h>
+#include <Filter/LowPassFilter2p.h>
+#include <Filter/NotchFilter.h>
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+#include <hal.h>
+#endif
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// iterations in each timed run, and number of runs of each benchmark.
+// The fastest run is reported, to leave out runs hit by interrupts
+#define BENCH_ITERATIONS 1000
+#define BENCH_RUNS       5
+
+// keep the compiler from optimising away the value at p, as in
+// benchmarks/AP_gbenchmark.h
+static inline void escape(void *p)
+{
+    asm volatile("" : : "g"(p) : "memory");
+}
+
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+static void counter_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t counter_read(void)
+{
+    return DWT->CYCCNT;
+}
+
+static const char *counter_units = "cycles";
+#else
+static void counter_init(void) {}
+
+static inline uint32_t counter_read(void)
+{
+    return AP_HAL::micros();
+}
+
+static const char *counter_units = "ns";
+#endif
+
+static Matrix3f m1(Vector3f(1.0f, 0.2f, 0.3f),
+                   Vector3f(0.4f, 1.0f, 0.6f),
+                   Vector3f(0.7f, 0.8f, 1.0f));
+static Vector3f v1(0.1f, -0.2f, 0.3f);
+static float angle = 0.3f;
+static uint8_t buffer[256];
+
+static void bench_matrix_mul(void)
+{
+    Matrix3f m = m1 * m1;
+    escape(&m);
+}
+
+static void bench_matrix_invert(void)
+{
+    Matrix3f m;
+    m1.inverse(m);
+    escape(&m);
+}
+
+static void bench_matrix4_inverse(void)
+{
+    float m[16] = { 4, 1, 0, 0,  1, 4, 1, 0,  0, 1, 4, 1,  0, 0, 1, 4 };
+    float inv[16];
+    escape(m);
+    inverse4x4(m, inv);
+    escape(inv);
+}
+
+static void bench_quat_from_matrix(void)
+{
+    Quaternion q;
+    q.from_rotation_matrix(m1);
+    escape(&q);
+}
+
+static void bench_quat_rotate(void)
+{
+    Quaternion q(0.9f, 0.1f, 0.2f, 0.3f);
+    Vector3f v = v1;
+    escape(&q);
+    q.earth_to_body(v);
+    escape(&v);
+}
+
+static void bench_sqrtf(void)
+{
+    float f = sqrtf(angle);
+    escape(&f);
+}
+
+static void bench_sincosf(void)
+{
+    float s = sinf(angle);
+    float c = cosf(angle);
+    escape(&s);
+    escape(&c);
+}
+
+static void bench_fast_sincosf(void)
+{
+    float s, c;
+    fast_sincosf(angle, s, c);
+    escape(&s);
+    escape(&c);
+}
+
+static void bench_atan2f(void)
+{
+    float f = atan2f(v1.y, v1.x);
+    escape(&f);
+}
+
+static LowPassFilter2pFloat lpf(1000, 20);
+static void bench_lowpass2p(void)
+{
+    float f = lpf.apply(angle);
+    escape(&f);
+}
+
+static NotchFilterFloat notch;
+static void bench_notch(void)
+{
+    float f = notch.apply(angle);
+    escape(&f);
+}
+
+static void bench_crc32(void)
+{
+    uint32_t crc = crc_crc32(0, buffer, sizeof(buffer));
+    escape(&crc);
+}
+
+static void bench_crc_xmodem(void)
+{
+    uint16_t crc = crc_xmodem(buffer, sizeof(buffer));
+    escape(&crc);
+}
+
+static const struct {
+    const char *name;
+    void (*fn)(void);
+} benchmarks[] = {
+    { "Matrix3f multiply",   bench_matrix_mul },
+    { "Matrix3f inverse",    bench_matrix_invert },
+    { "inverse4x4",          bench_matrix4_inverse },
+    { "Quaternion from DCM", bench_quat_from_matrix },
+    { "Quaternion rotate",   bench_quat_rotate },
+    { "sqrtf",               bench_sqrtf },
+    { "sinf+cosf",           bench_sincosf },
+    { "fast_sincosf",        bench_fast_sincosf },
+    { "atan2f",              bench_atan2f },
+    { "LowPassFilter2p",     bench_lowpass2p },
+    { "NotchFilter",         bench_notch },
+    { "crc_crc32 256B",      bench_crc32 },
+    { "crc_xmodem 256B",     bench_crc_xmodem },
+};
+
+/*
+  run one benchmark, returning the fastest time per iteration in
+  thousandths of the reported units
+ */
+static uint32_t run_benchmark(void (*fn)(void))
+{
+    uint32_t best = UINT32_MAX;
+    for (uint8_t r = 0; r < BENCH_RUNS; r++) {
+        const uint32_t start = counter_read();
+        for (uint16_t i = 0; i < BENCH_ITERATIONS; i++) {
+            fn();
+        }
+        const uint32_t elapsed = counter_read() - start;
+        best = MIN(best, elapsed);
+    }
+#if CONFIG_HAL_BOARD == HAL_BOARD_CHIBIOS
+    return uint64_t(best) * 1000 / BENCH_ITERATIONS;
+#else
+    // microseconds to nanoseconds
+    return uint64_t(best) * 1000000 / BENCH_ITERATIONS;
+#endif
+}
+
+static void run_all(void)
+{
+    hal.console->printf("\nBenchmark, %s per iteration\n", counter_units);
+    for (uint8_t i = 0; i < ARRAY_SIZE(benchmarks); i++) {
+        const uint32_t t = run_benchmark(benchmarks[i].fn);
+        hal.console->printf("%-22s %7.2f\n", benchmarks[i].name, (double)(t * 0.001f));
+        hal.scheduler->delay(10);
+    }
+}
+
+void setup(void)
+{
+    counter_init();
+    notch.init(1000, 80, 20, 15);
+    for (uint16_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = i * 7;
+    }
+    hal.scheduler->delay(1000);
+    hal.console->printf("On target benchmarks\n");
+}
+
+void loop(void)
+{
+    run_all();
+    // repeat every 10 seconds, so a console opened late sees them
+    hal.scheduler->delay(10000);
+}
+
+AP_HAL_MAIN();
@@ -0,0 +1,178 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+  polynomial approximations of the float trig functions and of the
+  inverse square root, for boards where the libm versions are slow.
+  The polynomials are the Cephes single precision ones, so the errors
+  are close to float precision:
+
+    fast_sinf, fast_cosf, fast_sincosf  abs error < 2e-7 for |x| <= 100
+    fast_atan2f                         abs error < 3e-7 rad
+    fast_asinf                          abs error < 5e-7 rad
+    fast_inv_sqrtf                      rel error < 5e-6
+
+  tests/test_fast_math.cpp checks these bounds. Larger angles lose
+  accuracy in the range reduction, at about 2e-9 per radian.
+
+  The approx_*() versions are for call sites where the above errors
+  are acceptable. They use the approximations when
+  AP_MATH_ALLOW_FAST_APPROX is set to 1, and libm otherwise, which is
+  the default so results are unchanged unless a board asks for it.
+ */
+#ifndef AP_MATH_ALLOW_FAST_APPROX
+#define AP_MATH_ALLOW_FAST_APPROX 0
+#endif
+
+// core on [-pi/4, pi/4]
+inline float fast_sinf_core(float x)
+{
+    const float z = x * x;
+    return ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * x + x;
+}
+
+inline float fast_cosf_core(float x)
+{
+    const float z = x * x;
+    return ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f;
+}
+
+// reduce x to [-pi/4, pi/4], returning the quadrant
+inline uint8_t fast_trig_reduce(float x, float &r)
+{
+    const int32_t q = int32_t(x * 0.636619772f + (x >= 0 ? 0.5f : -0.5f));
+    const float qf = q;
+    // pi/2 in three parts, so that q * part is exact for the larger parts
+    r = ((x - qf * 1.5703125f) - qf * 4.837512969970703125e-4f) - qf * 7.54978995489188216e-8f;
+    return uint8_t(q) & 3;
+}
+
+inline void fast_sincosf(float x, float &s, float &c)
+{
+    float r;
+    const uint8_t quadrant = fast_trig_reduce(x, r);
+    const float sr = fast_sinf_core(r);
+    const float cr = fast_cosf_core(r);
+    switch (quadrant) {
+    case 0:
+        s = sr;
+        c = cr;
+        break;
+    case 1:
+        s = cr;
+        c = -sr;
+        break;
+    case 2:
+        s = -sr;
+        c = -cr;
+        break;
+    default:
+        s = -cr;
+        c = sr;
+        break;
+    }
+}
+
+inline float fast_sinf(float x)
+{
+    float r;
+    const uint8_t quadrant = fast_trig_reduce(x, r);
+    const float v = (quadrant & 1) ? fast_cosf_core(r) : fast_sinf_core(r);
+    return (quadrant & 2) ? -v : v;
+}
+
+inline float fast_cosf(float x)
+{
+    float r;
+    const uint8_t quadrant = fast_trig_reduce(x, r);
+    const float v = (quadrant & 1) ? fast_sinf_core(r) : fast_cosf_core(r);
+    return ((quadrant + 1) & 2) ? -v : v;
+}
+
+inline float fast_atan2f(float y, float x)
+{
+    const float ax = fabsf(x);
+    const float ay = fabsf(y);
+    const float mx = ax > ay ? ax : ay;
+    if (mx <= 0) {
+        return 0;
+    }
+    // atan of t in [0, 1], with t above tan(pi/8) moved down by pi/4
+    float t = (ax > ay ? ay : ax) / mx;
+    float a = 0;
+    if (t > 0.4142135623730950f) {
+        t = (t - 1.0f) / (t + 1.0f);
+        a = 0.7853981633974483f;
+    }
+    const float z = t * t;
+    a += (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * t + t;
+    if (ay > ax) {
+        a = 1.5707963267948966f - a;
+    }
+    if (x < 0) {
+        a = 3.1415926535897932f - a;
+    }
+    return y < 0 ? -a : a;
+}
+
+// like safe_asin(), NaN gives zero and the input is limited to [-1, 1]
+inline float fast_asinf(float x)
+{
+    if (isnan(x)) {
+        return 0;
+    }
+    if (x >= 1.0f) {
+        return 1.5707963267948966f;
+    }
+    if (x <= -1.0f) {
+        return -1.5707963267948966f;
+    }
+    return fast_atan2f(x, sqrtf((1.0f - x) * (1.0f + x)));
+}
+
+// 1/sqrt(x) for x > 0, from the exponent trick and two Newton steps
+inline float fast_inv_sqrtf(float x)
+{
+    uint32_t i;
+    memcpy(&i, &x, sizeof(i));
+    i = 0x5f3759df - (i >> 1);
+    float y;
+    memcpy(&y, &i, sizeof(y));
+    const float half_x = 0.5f * x;
+    y = y * (1.5f - half_x * y * y);
+    y = y * (1.5f - half_x * y * y);
+    return y;
+}
+
+#if AP_MATH_ALLOW_FAST_APPROX
+inline float approx_sinf(float x) { return fast_sinf(x); }
+inline float approx_cosf(float x) { return fast_cosf(x); }
+inline void approx_sincosf(float x, float &s, float &c) { fast_sincosf(x, s, c); }
+inline float approx_atan2f(float y, float x) { return fast_atan2f(y, x); }
+inline float approx_asinf(float x) { return fast_asinf(x); }
+inline float approx_inv_sqrtf(float x) { return fast_inv_sqrtf(x); }
+#else
+inline float approx_sinf(float x) { return sinf(x); }
+inline float approx_cosf(float x) { return cosf(x); }
+inline void approx_sincosf(float x, float &s, float &c) { s = sinf(x); c = cosf(x); }
+inline float approx_atan2f(float y, float x) { return atan2f(y, x); }
+inline float approx_asinf(float x) { return isnan(x) ? 0 : asinf(x > 1.0f ? 1.0f : (x < -1.0f ? -1.0f : x)); }
+inline float approx_inv_sqrtf(float x) { return 1.0f / sqrtf(x); }
+#endif
@@ -20,6 +20,12 @@
 
 #include "AP_Math.h"
 
+#if AP_MATH_SIMD_SSE
+#include <xmmintrin.h>
+#elif AP_MATH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 // create a rotation matrix given some euler angles
 // this is based on http://gentlenav.googlecode.com/files/EulerAngles.pdf
 template <typename T>
@@ -260,6 +266,82 @@ void Matrix3<T>::from_axis_angle(const Vector3<T> &v, float theta)
 }
 
 
+#if AP_MATH_SIMD_SSE
+/*
+  load a Vector3f as (x, y, z, 0). A full 4 float load is not used as
+  it would read past the end of the last row of a Matrix3f
+ */
+static inline __m128 load_vector3(const Vector3f &v)
+{
+    const __m128 xy = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)&v.x);
+    return _mm_movelh_ps(xy, _mm_load_ss(&v.z));
+}
+
+static inline Vector3f store_vector3(__m128 v)
+{
+    Vector3f ret;
+    _mm_storel_pi((__m64 *)&ret.x, v);
+    _mm_store_ss(&ret.z, _mm_movehl_ps(v, v));
+    return ret;
+}
+
+// multiplication by another Matrix3f, each row of the result is a
+// weighted sum of the rows of m
+template <>
+Matrix3<float> Matrix3<float>::operator *(const Matrix3<float> &m) const
+{
+    const __m128 ma = load_vector3(m.a);
+    const __m128 mb = load_vector3(m.b);
+    const __m128 mc = load_vector3(m.c);
+    const Vector3f *rows[3] = { &a, &b, &c };
+    Matrix3<float> temp;
+    Vector3f *out[3] = { &temp.a, &temp.b, &temp.c };
+    for (uint8_t i=0; i<3; i++) {
+        const Vector3f &r = *rows[i];
+        __m128 row = _mm_mul_ps(ma, _mm_set1_ps(r.x));
+        row = _mm_add_ps(row, _mm_mul_ps(mb, _mm_set1_ps(r.y)));
+        row = _mm_add_ps(row, _mm_mul_ps(mc, _mm_set1_ps(r.z)));
+        *out[i] = store_vector3(row);
+    }
+    return temp;
+}
+#elif AP_MATH_SIMD_NEON
+// load a Vector3f as (x, y, z, 0) without reading past the end of it
+static inline float32x4_t load_vector3(const Vector3f &v)
+{
+    return vcombine_f32(vld1_f32(&v.x), vld1_lane_f32(&v.z, vdup_n_f32(0), 0));
+}
+
+static inline Vector3f store_vector3(float32x4_t v)
+{
+    Vector3f ret;
+    vst1_f32(&ret.x, vget_low_f32(v));
+    vst1q_lane_f32(&ret.z, v, 2);
+    return ret;
+}
+
+// multiplication by another Matrix3f, each row of the result is a
+// weighted sum of the rows of m
+template <>
+Matrix3<float> Matrix3<float>::operator *(const Matrix3<float> &m) const
+{
+    const float32x4_t ma = load_vector3(m.a);
+    const float32x4_t mb = load_vector3(m.b);
+    const float32x4_t mc = load_vector3(m.c);
+    const Vector3f *rows[3] = { &a, &b, &c };
+    Matrix3<float> temp;
+    Vector3f *out[3] = { &temp.a, &temp.b, &temp.c };
+    for (uint8_t i=0; i<3; i++) {
+        const Vector3f &r = *rows[i];
+        float32x4_t row = vmulq_n_f32(ma, r.x);
+        row = vaddq_f32(row, vmulq_n_f32(mb, r.y));
+        row = vaddq_f32(row, vmulq_n_f32(mc, r.z));
+        *out[i] = store_vector3(row);
+    }
+    return temp;
+}
+#endif // AP_MATH_SIMD_NEON
+
 // only define for float
 template void Matrix3<float>::zero(void);
 template void Matrix3<float>::rotate(const Vector3<float> &g);
@@ -272,7 +354,9 @@ template void Matrix3<float>::from_axis_angle(const Vector3<float> &v, float the
 template Vector3<float> Matrix3<float>::to_euler312(void) const;
 template Vector3<float> Matrix3<float>::operator *(const Vector3<float> &v) const;
 template Vector3<float> Matrix3<float>::mul_transpose(const Vector3<float> &v) const;
+#if !AP_MATH_SIMD
 template Matrix3<float> Matrix3<float>::operator *(const Matrix3<float> &m) const;
+#endif
 template Matrix3<float> Matrix3<float>::transposed(void) const;
 template float Matrix3<float>::det() const;
 template bool Matrix3<float>::inverse(Matrix3<float>& inv) const;
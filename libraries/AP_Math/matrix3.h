@@ -39,6 +39,7 @@
 
 #include "vector3.h"
 #include "vector2.h"
+#include "simd.h"
 
 // 3x3 matrix with elements of type T
 template <typename T>
@@ -273,3 +274,8 @@ typedef Matrix3<int32_t>                Matrix3l;
 typedef Matrix3<uint32_t>               Matrix3ul;
 typedef Matrix3<float>                  Matrix3f;
 typedef Matrix3<double>                 Matrix3d;
+
+#if AP_MATH_SIMD
+// SIMD implementation of the float matrix product, see simd.h
+template <> Matrix3<float> Matrix3<float>::operator *(const Matrix3<float> &m) const;
+#endif
@@ -1,10 +1,14 @@
 /*
  *  N dimensional matrix operations
+ *
+ *  N is known at compile time, so with O3 the loops are fully unrolled
+ *  for the small sizes and vectorised for the large ones
  */
 
 #pragma GCC optimize("O3")
 
 #include "matrixN.h"
+#include "AP_Math.h"
 
 
 // multiply two vectors to give a matrix, in-place
@@ -18,6 +22,47 @@ void MatrixN<T,N>::mult(const VectorN<T,N> &A, const VectorN<T,N> &B)
     }
 }
 
+// multiply two matrices to give a matrix, in-place
+template <typename T, uint8_t N>
+void MatrixN<T,N>::mult(const MatrixN<T,N> &A, const MatrixN<T,N> &B)
+{
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            T sum = 0;
+            for (uint8_t k = 0; k < N; k++) {
+                sum += A.v[i][k] * B.v[k][j];
+            }
+            v[i][j] = sum;
+        }
+    }
+}
+
+// covariance prediction, P = F * P * F' + Q
+template <typename T, uint8_t N>
+void MatrixN<T,N>::predict_covariance(const MatrixN<T,N> &F, const MatrixN<T,N> &Q)
+{
+    T FP[N][N];
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            T sum = 0;
+            for (uint8_t k = 0; k < N; k++) {
+                sum += F.v[i][k] * v[k][j];
+            }
+            FP[i][j] = sum;
+        }
+    }
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = i; j < N; j++) {
+            T sum = Q.v[i][j];
+            for (uint8_t k = 0; k < N; k++) {
+                sum += FP[i][k] * F.v[j][k];
+            }
+            v[i][j] = sum;
+            v[j][i] = sum;
+        }
+    }
+}
+
 // subtract B from the matrix
 template <typename T, uint8_t N>
 MatrixN<T,N> &MatrixN<T,N>::operator -=(const MatrixN<T,N> &B)
@@ -47,14 +92,42 @@ template <typename T, uint8_t N>
 void MatrixN<T,N>::force_symmetry(void)
 {
     for (uint8_t i = 0; i < N; i++) {
-        for (uint8_t j = 0; j < (i - 1); j++) {
+        for (uint8_t j = 0; j < i; j++) {
             v[i][j] = (v[i][j] + v[j][i]) / 2;
             v[j][i] = v[i][j];
         }
     }
 }
 
-template void MatrixN<float,4>::mult(const VectorN<float,4> &A, const VectorN<float,4> &B);
-template MatrixN<float,4> &MatrixN<float,4>::operator -=(const MatrixN<float,4> &B);
-template MatrixN<float,4> &MatrixN<float,4>::operator +=(const MatrixN<float,4> &B);
-template void MatrixN<float,4>::force_symmetry(void);
+// inverse of the matrix, without allocation
+template <typename T, uint8_t N>
+bool MatrixN<T,N>::inverse(MatrixN<T,N> &inv) const
+{
+    return mat_inverse<N>(&v[0][0], &inv.v[0][0]);
+}
+
+#define MATRIXN_INSTANTIATE(N) \
+    template void MatrixN<float,N>::mult(const VectorN<float,N> &A, const VectorN<float,N> &B); \
+    template void MatrixN<float,N>::mult(const MatrixN<float,N> &A, const MatrixN<float,N> &B); \
+    template void MatrixN<float,N>::predict_covariance(const MatrixN<float,N> &F, const MatrixN<float,N> &Q); \
+    template MatrixN<float,N> &MatrixN<float,N>::operator -=(const MatrixN<float,N> &B); \
+    template MatrixN<float,N> &MatrixN<float,N>::operator +=(const MatrixN<float,N> &B); \
+    template void MatrixN<float,N>::force_symmetry(void);
+
+// mat_inverse() is only available for the small sizes
+#define MATRIXN_INSTANTIATE_INVERSE(N) \
+    template bool MatrixN<float,N>::inverse(MatrixN<float,N> &inv) const;
+
+// the sizes of the small estimators, and of the EKF state
+MATRIXN_INSTANTIATE(2)
+MATRIXN_INSTANTIATE(3)
+MATRIXN_INSTANTIATE(4)
+MATRIXN_INSTANTIATE(5)
+MATRIXN_INSTANTIATE(6)
+MATRIXN_INSTANTIATE(24)
+MATRIXN_INSTANTIATE(28)
+MATRIXN_INSTANTIATE_INVERSE(2)
+MATRIXN_INSTANTIATE_INVERSE(3)
+MATRIXN_INSTANTIATE_INVERSE(4)
+MATRIXN_INSTANTIATE_INVERSE(5)
+MATRIXN_INSTANTIATE_INVERSE(6)
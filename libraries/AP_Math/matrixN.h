@@ -31,9 +31,28 @@ public:
         }
     }
 
+    // row access, so elements are m[i][j]
+    inline T *operator[](uint8_t i) {
+        return v[i];
+    }
+
+    inline const T *operator[](uint8_t i) const {
+        return v[i];
+    }
+
     // multiply two vectors to give a matrix, in-place
     void mult(const VectorN<T,N> &A, const VectorN<T,N> &B);
 
+    // multiply two matrices to give a matrix, in-place
+    // C = A * B, where neither A nor B is this matrix
+    void mult(const MatrixN<T,N> &A, const MatrixN<T,N> &B);
+
+    // covariance prediction, in-place
+    // P = F * P * F' + Q, for symmetric P and Q
+    // only the upper triangle of the result is calculated, which saves a
+    // quarter of the multiplications and leaves it exactly symmetric
+    void predict_covariance(const MatrixN<T,N> &F, const MatrixN<T,N> &Q);
+
     // subtract B from the matrix
     MatrixN<T,N> &operator -=(const MatrixN<T,N> &B);
 
@@ -43,6 +62,9 @@ public:
     // Matrix symmetry routine
     void force_symmetry(void);
 
+    // inverse of the matrix in inv, which may be this matrix. Returns false if it is singular
+    bool inverse(MatrixN<T,N> &inv) const;
+
 private:
     T v[N][N];
 };
@@ -438,3 +438,180 @@ bool inverse(float x[], float y[], uint16_t dim)
         default: return mat_inverse(x,y,dim);
     }
 }
+
+/*
+ *    fixed size matrix multiplication, unrolled by the compiler
+ *
+ *    @param     A,           Matrix A
+ *    @param     B,           Matrix B
+ *    @param     out,         A*B, not overlapping A or B
+ */
+template <uint8_t N>
+void mat_mul(const float *A, const float *B, float *out)
+{
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            float sum = 0;
+            for (uint8_t k = 0; k < N; k++) {
+                sum += A[i*N + k] * B[k*N + j];
+            }
+            out[i*N + j] = sum;
+        }
+    }
+}
+
+/*
+ *    fixed size matrix inverse using Gauss-Jordan elimination with
+ *    partial pivoting, with all temporaries on the stack
+ *
+ *    @param     A,           input NxN matrix
+ *    @param     inv,         Output inverted NxN matrix, may be A
+ *    @returns                false = matrix is Singular, true = matrix inversion successful
+ */
+template <uint8_t N>
+bool mat_inverse(const float *A, float *inv)
+{
+    float a[N*N];
+    memcpy(a, A, sizeof(a));
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            inv[i*N + j] = static_cast<float>(i==j);
+        }
+    }
+
+    for (uint8_t c = 0; c < N; c++) {
+        // bring the row with the largest element in this column onto the diagonal
+        uint8_t p = c;
+        for (uint8_t r = c+1; r < N; r++) {
+            if (fabsf(a[r*N + c]) > fabsf(a[p*N + c])) {
+                p = r;
+            }
+        }
+        if (a[p*N + c] == 0.0f) {
+            return false;
+        }
+        if (p != c) {
+            for (uint8_t k = 0; k < N; k++) {
+                swap(a[p*N + k], a[c*N + k]);
+                swap(inv[p*N + k], inv[c*N + k]);
+            }
+        }
+
+        const float d = 1.0f / a[c*N + c];
+        for (uint8_t k = 0; k < N; k++) {
+            a[c*N + k] *= d;
+            inv[c*N + k] *= d;
+        }
+        for (uint8_t r = 0; r < N; r++) {
+            const float f = a[r*N + c];
+            if (r == c || f == 0.0f) {
+                continue;
+            }
+            for (uint8_t k = 0; k < N; k++) {
+                a[r*N + k] -= f * a[c*N + k];
+                inv[r*N + k] -= f * inv[c*N + k];
+            }
+        }
+    }
+
+    //check sanity of results
+    for (uint8_t i = 0; i < N*N; i++) {
+        if (isnan(inv[i]) || isinf(inv[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ *    Cholesky decomposition of a symmetric positive definite matrix
+ *
+ *    @param     A,           input NxN matrix, only the lower triangle is used
+ *    @param     L,           Output lower triangular matrix with A = L*L', may be A
+ *    @returns                false = matrix is not positive definite, true = decomposition successful
+ */
+template <uint8_t N>
+bool mat_cholesky(const float *A, float *L)
+{
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j <= i; j++) {
+            float sum = A[i*N + j];
+            for (uint8_t k = 0; k < j; k++) {
+                sum -= L[i*N + k] * L[j*N + k];
+            }
+            if (i == j) {
+                if (!(sum > 0.0f)) {
+                    return false;
+                }
+                L[i*N + i] = sqrtf(sum);
+            } else {
+                L[i*N + j] = sum / L[j*N + j];
+            }
+        }
+    }
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = i+1; j < N; j++) {
+            L[i*N + j] = 0;
+        }
+    }
+    return true;
+}
+
+/*
+ *    solves A*x = b for a symmetric positive definite matrix by Cholesky
+ *    decomposition, then forward and backward substitution
+ *
+ *    @param     A,           input NxN matrix
+ *    @param     b,           input N vector
+ *    @param     x,           Output N vector, may be b
+ *    @returns                false = matrix is not positive definite, true = solve successful
+ */
+template <uint8_t N>
+bool mat_cholesky_solve(const float *A, const float *b, float *x)
+{
+    float L[N*N];
+    if (!mat_cholesky<N>(A, L)) {
+        return false;
+    }
+
+    // Forward substitution solve L*y = b
+    float y[N];
+    for (uint8_t i = 0; i < N; i++) {
+        float sum = b[i];
+        for (uint8_t k = 0; k < i; k++) {
+            sum -= L[i*N + k] * y[k];
+        }
+        y[i] = sum / L[i*N + i];
+    }
+
+    // Backward substitution solve L'*x = y
+    for (int8_t i = N-1; i >= 0; i--) {
+        float sum = y[i];
+        for (uint8_t k = i+1; k < N; k++) {
+            sum -= L[k*N + i] * x[k];
+        }
+        x[i] = sum / L[i*N + i];
+    }
+
+    for (uint8_t i = 0; i < N; i++) {
+        if (isnan(x[i]) || isinf(x[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#define MATRIX_ALG_INSTANTIATE(N) \
+    template void mat_mul<N>(const float *A, const float *B, float *out); \
+    template bool mat_inverse<N>(const float *A, float *inv); \
+    template bool mat_cholesky<N>(const float *A, float *L); \
+    template bool mat_cholesky_solve<N>(const float *A, const float *b, float *x);
+
+MATRIX_ALG_INSTANTIATE(2)
+MATRIX_ALG_INSTANTIATE(3)
+MATRIX_ALG_INSTANTIATE(4)
+MATRIX_ALG_INSTANTIATE(5)
+MATRIX_ALG_INSTANTIATE(6)
+MATRIX_ALG_INSTANTIATE(7)
+MATRIX_ALG_INSTANTIATE(8)
+MATRIX_ALG_INSTANTIATE(9)
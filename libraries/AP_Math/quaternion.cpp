@@ -20,6 +20,12 @@
 
 #include "AP_Math.h"
 
+#if AP_MATH_SIMD_SSE
+#include <xmmintrin.h>
+#elif AP_MATH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 // return the rotation matrix equivalent for this quaternion
 void Quaternion::rotation_matrix(Matrix3f &m) const
 {
@@ -306,6 +312,55 @@ void Quaternion::normalize(void)
     }
 }
 
+#if AP_MATH_SIMD
+/*
+  Hamilton product written as the sum of the lanes of v scaled by each
+  element of this quaternion:
+    w1 * ( w2,  x2,  y2,  z2)
+  + x1 * (-x2,  w2, -z2,  y2)
+  + y1 * (-y2,  z2,  w2, -x2)
+  + z1 * (-z2, -y2,  x2,  w2)
+  this is the same order of operations as the scalar code
+ */
+static inline void quaternion_multiply(const Quaternion &p, const Quaternion &v, Quaternion &ret)
+{
+#if AP_MATH_SIMD_SSE
+    const __m128 q = _mm_loadu_ps(&v.q1);
+    const __m128 sx = _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f);
+    const __m128 sy = _mm_set_ps(-0.0f, 0.0f, 0.0f, -0.0f);
+    const __m128 sz = _mm_set_ps(0.0f, 0.0f, -0.0f, -0.0f);
+    __m128 r = _mm_mul_ps(_mm_set1_ps(p.q1), q);
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(p.q2), _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(2,3,0,1)), sx)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(p.q3), _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(1,0,3,2)), sy)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(p.q4), _mm_xor_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(0,1,2,3)), sz)));
+    _mm_storeu_ps(&ret.q1, r);
+#else
+    static const float sx[4] = { -1.0f,  1.0f, -1.0f,  1.0f };
+    static const float sy[4] = { -1.0f,  1.0f,  1.0f, -1.0f };
+    static const float sz[4] = { -1.0f, -1.0f,  1.0f,  1.0f };
+    const float32x4_t q = vld1q_f32(&v.q1);
+    const float32x4_t qyzwx = vextq_f32(q, q, 2);
+    float32x4_t r = vmulq_n_f32(q, p.q1);
+    r = vaddq_f32(r, vmulq_n_f32(vmulq_f32(vrev64q_f32(q), vld1q_f32(sx)), p.q2));
+    r = vaddq_f32(r, vmulq_n_f32(vmulq_f32(qyzwx, vld1q_f32(sy)), p.q3));
+    r = vaddq_f32(r, vmulq_n_f32(vmulq_f32(vrev64q_f32(qyzwx), vld1q_f32(sz)), p.q4));
+    vst1q_f32(&ret.q1, r);
+#endif
+}
+
+Quaternion Quaternion::operator*(const Quaternion &v) const
+{
+    Quaternion ret;
+    quaternion_multiply(*this, v, ret);
+    return ret;
+}
+
+Quaternion &Quaternion::operator*=(const Quaternion &v)
+{
+    quaternion_multiply(*this, v, *this);
+    return *this;
+}
+#else
 Quaternion Quaternion::operator*(const Quaternion &v) const
 {
     Quaternion ret;
@@ -346,6 +401,7 @@ Quaternion &Quaternion::operator*=(const Quaternion &v)
 
     return *this;
 }
+#endif // AP_MATH_SIMD
 
 Quaternion Quaternion::operator/(const Quaternion &v) const
 {
@@ -23,6 +23,8 @@
 #endif
 #include <math.h>
 
+#include "simd.h"
+
 class Quaternion {
 public:
     float        q1, q2, q3, q4;
@@ -0,0 +1,48 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+  compile time selection of SIMD implementations for the float
+  Matrix3 * Matrix3 and Quaternion * Quaternion products. Matrix3 *
+  Vector3 and mul_transpose() are left scalar as benchmark_matrix shows
+  no gain once the vectors are loaded without reading past their end.
+
+  The SIMD versions perform the same multiplies and adds in the same
+  order as the scalar code, so without fused multiply-add the results
+  are bit identical. Define AP_MATH_ALLOW_SIMD to 0 to force the
+  scalar implementations.
+
+  Cortex-M boards have no floating point SIMD unit (the DSP extension
+  only covers integer types), so they always use the scalar code.
+ */
+#ifndef AP_MATH_ALLOW_SIMD
+#define AP_MATH_ALLOW_SIMD 1
+#endif
+
+#if AP_MATH_ALLOW_SIMD && defined(__SSE__)
+#define AP_MATH_SIMD_SSE 1
+#elif AP_MATH_ALLOW_SIMD && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define AP_MATH_SIMD_NEON 1
+#endif
+
+#ifndef AP_MATH_SIMD_SSE
+#define AP_MATH_SIMD_SSE 0
+#endif
+#ifndef AP_MATH_SIMD_NEON
+#define AP_MATH_SIMD_NEON 0
+#endif
+
+#define AP_MATH_SIMD (AP_MATH_SIMD_SSE || AP_MATH_SIMD_NEON)
@@ -0,0 +1,47 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/chirp.h>
+
+static const float dt = 0.0025f;
+
+TEST(ChirpTest, Frequency)
+{
+    Chirp chirp;
+    chirp.init(20, 0.5f, 40, 1, 1, 4);
+    EXPECT_FLOAT_EQ(24, chirp.get_duration_s());
+
+    // constant frequency, then exponential in time
+    chirp.update(2, 1);
+    EXPECT_FLOAT_EQ(0.5f, chirp.get_frequency_hz());
+    chirp.update(14, 1);
+    EXPECT_NEAR(sqrtf(0.5f * 40), chirp.get_frequency_hz(), 1.0e-3f);
+    chirp.update(23.99f, 1);
+    EXPECT_NEAR(40, chirp.get_frequency_hz(), 0.2f);
+    EXPECT_FALSE(chirp.completed());
+
+    EXPECT_FLOAT_EQ(0, chirp.update(24, 1));
+    EXPECT_TRUE(chirp.completed());
+}
+
+TEST(ChirpTest, Waveform)
+{
+    Chirp chirp;
+    chirp.init(10, 1, 20, 1, 1, 2);
+
+    // bounded, starting and ending at zero without steps
+    float last = chirp.update(0, 2);
+    EXPECT_FLOAT_EQ(0, last);
+    float peak = 0;
+    for (float t=dt; t<12; t+=dt) {
+        const float v = chirp.update(t, 2);
+        EXPECT_LE(fabsf(v), 2);
+        EXPECT_LT(fabsf(v - last), 2 * M_2PI * 20 * dt);
+        peak = MAX(peak, fabsf(v));
+        last = v;
+    }
+    EXPECT_GT(peak, 1.99f);
+    EXPECT_LT(fabsf(last), 0.01f);
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,95 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#define DT         0.0025f
+#define VEL_MAX    1000.0f
+#define ACCEL_MAX  500.0f
+#define JERK_MAX   1000.0f
+
+TEST(ControlTest, SqrtController)
+{
+    // linear close to the target
+    Vector2f out = sqrt_controller(Vector2f(1.0f, 0.0f), 2.0f, 100.0f, 0.0f);
+    EXPECT_FLOAT_EQ(out.x, 2.0f);
+    EXPECT_FLOAT_EQ(out.y, 0.0f);
+
+    // sqrt far from it, continuous at the change over
+    const float linear_dist = 100.0f / sq(2.0f);
+    out = sqrt_controller(Vector2f(0.0f, linear_dist), 2.0f, 100.0f, 0.0f);
+    EXPECT_FLOAT_EQ(out.y, 2.0f * linear_dist);
+    out = sqrt_controller(Vector2f(0.0f, 1000.0f), 2.0f, 100.0f, 0.0f);
+    EXPECT_FLOAT_EQ(out.y, safe_sqrt(2.0f * 100.0f * (1000.0f - 0.5f * linear_dist)));
+
+    // never passes the target in one step
+    out = sqrt_controller(Vector2f(3.0f, -4.0f), 1000.0f, 0.0f, 0.1f);
+    EXPECT_FLOAT_EQ(out.x, 30.0f);
+    EXPECT_FLOAT_EQ(out.y, -40.0f);
+
+    EXPECT_TRUE(sqrt_controller(Vector2f(), 1.0f, 1.0f, DT).is_zero());
+}
+
+/*
+  a step in velocity gives a trapezoidal acceleration which respects
+  the limits and settles on the new velocity
+ */
+TEST(ControlTest, VelocityStep)
+{
+    const Vector2f vel_input(600.0f, -800.0f);
+    Vector2f pos, vel, accel;
+    for (uint32_t i=0; i<4000; i++) {
+        const Vector2f accel_last = accel;
+        shape_vel_accel_xy(vel_input, Vector2f(), vel, accel, ACCEL_MAX, JERK_MAX, DT);
+        ASSERT_LE((accel - accel_last).length(), JERK_MAX * DT * 1.001f);
+        ASSERT_LE(accel.length(), ACCEL_MAX * 1.001f);
+        update_pos_vel_accel_xy(pos, vel, accel, DT);
+        // no more than a small overshoot
+        ASSERT_LE(vel.length(), vel_input.length() * 1.01f);
+    }
+    EXPECT_NEAR((vel - vel_input).length(), 0.0f, 1.0f);
+    EXPECT_NEAR(accel.length(), 0.0f, 1.0f);
+}
+
+/*
+  moving to a distant position reaches it at no more than the speed
+  limit and stops there
+ */
+TEST(ControlTest, PositionStep)
+{
+    const Vector2f pos_input(5000.0f, 2000.0f);
+    Vector2f pos, vel, accel;
+    float overshoot = 0;
+    for (uint32_t i=0; i<8000; i++) {
+        const Vector2f accel_last = accel;
+        shape_pos_vel_accel_xy(pos_input, Vector2f(), Vector2f(), pos, vel, accel, VEL_MAX, ACCEL_MAX, JERK_MAX, DT);
+        ASSERT_LE((accel - accel_last).length(), JERK_MAX * DT * 1.001f);
+        ASSERT_LE(accel.length(), ACCEL_MAX * 1.001f);
+        update_pos_vel_accel_xy(pos, vel, accel, DT);
+        ASSERT_LE(vel.length(), VEL_MAX * 1.05f);
+        overshoot = MAX(overshoot, (pos - Vector2f()) * pos_input.normalized() - pos_input.length());
+    }
+    EXPECT_NEAR((pos - pos_input).length(), 0.0f, 1.0f);
+    EXPECT_NEAR(vel.length(), 0.0f, 1.0f);
+    EXPECT_LT(overshoot, 1.0f);
+}
+
+/*
+  following a target moving at constant velocity converges on it
+ */
+TEST(ControlTest, MovingTarget)
+{
+    const Vector2f target_vel(300.0f, 0.0f);
+    Vector2f target_pos(1000.0f, 0.0f);
+    Vector2f pos, vel, accel;
+    for (uint32_t i=0; i<8000; i++) {
+        shape_pos_vel_accel_xy(target_pos, target_vel, Vector2f(), pos, vel, accel, VEL_MAX, ACCEL_MAX, JERK_MAX, DT);
+        update_pos_vel_accel_xy(pos, vel, accel, DT);
+        target_pos += target_vel * DT;
+    }
+    EXPECT_NEAR((pos - target_pos).length(), 0.0f, 1.0f);
+    EXPECT_NEAR((vel - target_vel).length(), 0.0f, 1.0f);
+}
+
+AP_GTEST_MAIN()
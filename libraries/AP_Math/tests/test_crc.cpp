@@ -0,0 +1,72 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/crc.h>
+
+/*
+  check the table driven CRCs against bit at a time versions of them
+ */
+
+static uint32_t crc32_bitwise(uint32_t crc, const uint8_t *buf, uint32_t size)
+{
+    while (size--) {
+        crc ^= *buf++;
+        for (uint8_t i=0; i<8; i++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+static uint16_t xmodem_bitwise(const uint8_t *buf, uint16_t size)
+{
+    uint16_t crc = 0;
+    while (size--) {
+        crc ^= uint16_t(*buf++) << 8;
+        for (uint8_t i=0; i<8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static const uint8_t check[] = "123456789";
+
+TEST(CRCTest, CheckValues)
+{
+    // the standard check values for the nine byte string
+    EXPECT_EQ(0xCBF43926U, crc_crc32(0xFFFFFFFF, check, 9) ^ 0xFFFFFFFF);
+    EXPECT_EQ(0x31C3, crc_xmodem(check, 9));
+    EXPECT_EQ(0xF4, crc_crc8(check, 9));
+    EXPECT_EQ(0x4B37, crc_modbus(check, 9));
+}
+
+TEST(CRCTest, CRC32)
+{
+    uint8_t buf[300];
+    for (uint16_t i=0; i<sizeof(buf); i++) {
+        buf[i] = i * 37 + 11;
+    }
+    // every alignment and length, including the odd bytes after the
+    // words, and a running CRC carried across calls
+    for (uint8_t ofs=0; ofs<4; ofs++) {
+        for (uint16_t len=0; len<=sizeof(buf)-ofs; len++) {
+            EXPECT_EQ(crc32_bitwise(0, &buf[ofs], len), crc_crc32(0, &buf[ofs], len));
+        }
+    }
+    const uint32_t crc = crc_crc32(0x12345678, buf, 101);
+    EXPECT_EQ(crc32_bitwise(0x12345678, buf, 200), crc_crc32(crc, &buf[101], 99));
+}
+
+TEST(CRCTest, XModem)
+{
+    uint8_t buf[256];
+    for (uint16_t i=0; i<sizeof(buf); i++) {
+        buf[i] = i * 101 + 7;
+    }
+    for (uint16_t len=0; len<=sizeof(buf); len++) {
+        EXPECT_EQ(xmodem_bitwise(buf, len), crc_xmodem(buf, len));
+    }
+}
+
+AP_GTEST_MAIN()
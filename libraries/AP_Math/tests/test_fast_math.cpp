@@ -0,0 +1,66 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+
+/*
+  check the approximations in fast_math.h stay within the error
+  bounds documented there, against the double precision functions
+ */
+
+TEST(FastMathTest, SinCos)
+{
+    double max_err = 0;
+    for (int32_t i=-1000000; i<=1000000; i++) {
+        const float x = i * 1.0e-4f;
+        const float s = fast_sinf(x);
+        const float c = fast_cosf(x);
+        max_err = MAX(max_err, fabs(s - sin(double(x))));
+        max_err = MAX(max_err, fabs(c - cos(double(x))));
+        float s2, c2;
+        fast_sincosf(x, s2, c2);
+        EXPECT_EQ(s, s2);
+        EXPECT_EQ(c, c2);
+    }
+    EXPECT_LT(max_err, 2.0e-7);
+}
+
+TEST(FastMathTest, Atan2)
+{
+    EXPECT_EQ(0, fast_atan2f(0, 0));
+    double max_err = 0;
+    for (uint16_t i=0; i<3600; i++) {
+        const double angle = radians(i * 0.1) - M_PI;
+        for (float r = 1.0e-3f; r < 1.0e4f; r *= 3.7f) {
+            const float y = r * sin(angle);
+            const float x = r * cos(angle);
+            // compare against the angle of the float inputs
+            max_err = MAX(max_err, fabs(fast_atan2f(y, x) - atan2(double(y), double(x))));
+        }
+    }
+    EXPECT_LT(max_err, 3.0e-7);
+}
+
+TEST(FastMathTest, Asin)
+{
+    double max_err = 0;
+    for (int32_t i=-100000; i<=100000; i++) {
+        const float x = i * 1.0e-5f;
+        max_err = MAX(max_err, fabs(fast_asinf(x) - asin(double(x))));
+    }
+    EXPECT_LT(max_err, 5.0e-7);
+    EXPECT_FLOAT_EQ(M_PI_2, fast_asinf(1.5f));
+    EXPECT_FLOAT_EQ(-M_PI_2, fast_asinf(-1.5f));
+    EXPECT_EQ(0, fast_asinf(NAN));
+}
+
+TEST(FastMathTest, InvSqrt)
+{
+    double max_err = 0;
+    for (float x = 1.0e-6f; x < 1.0e6f; x *= 1.001f) {
+        const double expected = 1.0 / sqrt(double(x));
+        max_err = MAX(max_err, fabs(fast_inv_sqrtf(x) - expected) / expected);
+    }
+    EXPECT_LT(max_err, 5.0e-6);
+}
+
+AP_GTEST_MAIN()
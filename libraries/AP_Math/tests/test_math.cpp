@@ -71,6 +71,20 @@ TEST(VectorTest, Rotations)
     EXPECT_EQ(ROTATION_MAX, rotation_count) << "All rotations are expect to be tested";
 }
 
+TEST(VectorTest, RotationInverses)
+{
+    // rotate_inverse() has its own tables, check they match rotate()
+    for (uint8_t r = 0; r < ROTATION_MAX; r++) {
+        const Vector3f v(0.3f, -1.7f, 2.9f);
+        Vector3f v2 = v;
+        v2.rotate((enum Rotation)r);
+        v2.rotate_inverse((enum Rotation)r);
+        EXPECT_NEAR(v.x, v2.x, 1.0e-5) << "rotation " << unsigned(r);
+        EXPECT_NEAR(v.y, v2.y, 1.0e-5) << "rotation " << unsigned(r);
+        EXPECT_NEAR(v.z, v2.z, 1.0e-5) << "rotation " << unsigned(r);
+    }
+}
+
 TEST(MathTest, IsZero)
 {
     EXPECT_FALSE(is_zero(0.1));
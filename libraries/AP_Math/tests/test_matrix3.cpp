@@ -109,6 +109,57 @@ INSTANTIATE_TEST_CASE_P(NonInvertibleMatrices,
                         Matrix3fTest,
                         ::testing::ValuesIn(non_invertible));
 
+TEST(Matrix3fProductTest, Products)
+{
+    // the SIMD implementations in simd.h must agree with the
+    // element-wise definition of the product
+    const Matrix3f m1 = non_invertible[0].m;
+    const Matrix3f m2 = invertible[0].m;
+    const Matrix3f p = m1 * m2;
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            const float expected = m1[i][0] * m2[0][j] + m1[i][1] * m2[1][j] + m1[i][2] * m2[2][j];
+            EXPECT_FLOAT_EQ(expected, p[i][j]);
+        }
+    }
+
+    const Vector3f v(0.5f, -1.5f, 2.0f);
+    const Vector3f mv = m1 * v;
+    const Vector3f mtv = m1.mul_transpose(v);
+    const Vector3f mtv_expected = m1.transposed() * v;
+    for (uint8_t i = 0; i < 3; i++) {
+        EXPECT_FLOAT_EQ(m1[i] * v, mv[i]);
+        EXPECT_FLOAT_EQ(mtv_expected[i], mtv[i]);
+    }
+}
+
+TEST(QuaternionTest, Products)
+{
+    Quaternion q1, q2;
+    q1.from_euler(0.1f, -0.4f, 1.2f);
+    q2.from_euler(-0.7f, 0.2f, -2.5f);
+
+    // composing quaternions must match composing rotation matrices
+    Matrix3f m1, m2, mq;
+    q1.rotation_matrix(m1);
+    q2.rotation_matrix(m2);
+    const Matrix3f m = m1 * m2;
+    (q1 * q2).rotation_matrix(mq);
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            EXPECT_NEAR(m[i][j], mq[i][j], 1.0e-6);
+        }
+    }
+
+    Quaternion q3 = q1;
+    q3 *= q2;
+    const Quaternion q4 = q1 * q2;
+    EXPECT_FLOAT_EQ(q4.q1, q3.q1);
+    EXPECT_FLOAT_EQ(q4.q2, q3.q2);
+    EXPECT_FLOAT_EQ(q4.q3, q3.q3);
+    EXPECT_FLOAT_EQ(q4.q4, q3.q4);
+}
+
 AP_GTEST_MAIN()
 
 #pragma GCC diagnostic pop
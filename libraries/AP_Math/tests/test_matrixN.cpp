@@ -0,0 +1,85 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/matrixN.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+template <uint8_t N>
+static void fill(MatrixN<float,N> &m, float seed)
+{
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            m[i][j] = sinf(seed + i * 1.3f + j * 0.7f);
+        }
+    }
+}
+
+template <uint8_t N>
+static void check_predict_covariance()
+{
+    MatrixN<float,N> F, P, Q;
+    fill(F, 0.1f);
+    fill(P, 0.5f);
+    fill(Q, 0.9f);
+    P.force_symmetry();
+    Q.force_symmetry();
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            EXPECT_FLOAT_EQ(P[i][j], P[j][i]);
+        }
+    }
+
+    // reference with two multiplications
+    MatrixN<float,N> FT, FP, FPFT;
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            FT[i][j] = F[j][i];
+        }
+    }
+    FP.mult(F, P);
+    FPFT.mult(FP, FT);
+    FPFT += Q;
+
+    P.predict_covariance(F, Q);
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            EXPECT_NEAR(FPFT[i][j], P[i][j], 1.0e-4f * N);
+            EXPECT_FLOAT_EQ(P[i][j], P[j][i]);
+        }
+    }
+}
+
+TEST(MatrixNTest, PredictCovariance)
+{
+    check_predict_covariance<2>();
+    check_predict_covariance<4>();
+    check_predict_covariance<6>();
+    check_predict_covariance<24>();
+}
+
+TEST(MatrixNTest, Multiply)
+{
+    const float d[3] = { 2, 3, 4 };
+    MatrixN<float,3> D(d);
+    MatrixN<float,3> A, C;
+    fill(A, 0.2f);
+    C.mult(A, D);
+    for (uint8_t i = 0; i < 3; i++) {
+        for (uint8_t j = 0; j < 3; j++) {
+            EXPECT_FLOAT_EQ(A[i][j] * d[j], C[i][j]);
+        }
+    }
+
+    VectorN<float,3> v, r;
+    v[0] = 1;
+    v[1] = -1;
+    v[2] = 0.5f;
+    r.mult(D, v);
+    EXPECT_FLOAT_EQ(2, r[0]);
+    EXPECT_FLOAT_EQ(-3, r[1]);
+    EXPECT_FLOAT_EQ(2, r[2]);
+    EXPECT_FLOAT_EQ(2 + 3 + 1, r * v);
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,128 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Math/matrixN.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// symmetric positive definite, like the damped JTJ of the calibrators
+static void make_spd(float *A, uint8_t n)
+{
+    float M[9*9];
+    for (uint8_t i = 0; i < n*n; i++) {
+        M[i] = sinf(i * 1.7f + 0.3f);
+    }
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t j = 0; j < n; j++) {
+            float sum = (i == j) ? 0.5f : 0.0f;
+            for (uint8_t k = 0; k < n; k++) {
+                sum += M[i*n + k] * M[j*n + k];
+            }
+            A[i*n + j] = sum;
+        }
+    }
+}
+
+template <uint8_t N>
+static void check_inverse()
+{
+    float A[N*N], inv[N*N], I[N*N];
+    make_spd(A, N);
+    EXPECT_TRUE(mat_inverse<N>(A, inv));
+    mat_mul<N>(A, inv, I);
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            EXPECT_NEAR(i == j ? 1.0f : 0.0f, I[i*N + j], 1.0e-4f);
+        }
+    }
+
+    // matches the generic inverse
+    float inv2[N*N];
+    memcpy(inv2, A, sizeof(A));
+    EXPECT_TRUE(inverse(inv2, inv2, N));
+    for (uint8_t i = 0; i < N*N; i++) {
+        EXPECT_NEAR(inv2[i], inv[i], 1.0e-3f * fabsf(inv2[i]) + 1.0e-4f);
+    }
+
+    // in place
+    EXPECT_TRUE(mat_inverse<N>(A, A));
+    for (uint8_t i = 0; i < N*N; i++) {
+        EXPECT_FLOAT_EQ(inv[i], A[i]);
+    }
+}
+
+TEST(MatrixAlgTest, Inverse)
+{
+    check_inverse<2>();
+    check_inverse<4>();
+    check_inverse<6>();
+    check_inverse<9>();
+}
+
+TEST(MatrixAlgTest, InverseSingular)
+{
+    float A[9] = { 1, 2, 3,
+                   2, 4, 6,
+                   0, 1, 1 };
+    float inv[9];
+    EXPECT_FALSE(mat_inverse<3>(A, inv));
+}
+
+template <uint8_t N>
+static void check_cholesky_solve()
+{
+    float A[N*N], L[N*N], LLT[N*N], LT[N*N];
+    make_spd(A, N);
+    EXPECT_TRUE(mat_cholesky<N>(A, L));
+    for (uint8_t i = 0; i < N; i++) {
+        for (uint8_t j = 0; j < N; j++) {
+            LT[i*N + j] = L[j*N + i];
+        }
+    }
+    mat_mul<N>(L, LT, LLT);
+    for (uint8_t i = 0; i < N*N; i++) {
+        EXPECT_NEAR(A[i], LLT[i], 1.0e-4f);
+    }
+
+    float b[N], x[N];
+    for (uint8_t i = 0; i < N; i++) {
+        b[i] = i - 1.5f;
+    }
+    EXPECT_TRUE(mat_cholesky_solve<N>(A, b, x));
+    for (uint8_t i = 0; i < N; i++) {
+        float Ax = 0;
+        for (uint8_t k = 0; k < N; k++) {
+            Ax += A[i*N + k] * x[k];
+        }
+        EXPECT_NEAR(b[i], Ax, 1.0e-4f);
+    }
+}
+
+TEST(MatrixAlgTest, CholeskySolve)
+{
+    check_cholesky_solve<2>();
+    check_cholesky_solve<4>();
+    check_cholesky_solve<6>();
+    check_cholesky_solve<9>();
+}
+
+TEST(MatrixAlgTest, CholeskyNotPositiveDefinite)
+{
+    float A[4] = { 1, 2,
+                   2, 1 };
+    float b[2] = { 1, 1 };
+    float x[2];
+    EXPECT_FALSE(mat_cholesky_solve<2>(A, b, x));
+}
+
+TEST(MatrixAlgTest, MatrixN)
+{
+    const float d[4] = { 2, 4, 0.5f, 1 };
+    MatrixN<float,4> m(d);
+    MatrixN<float,4> inv;
+    EXPECT_TRUE(m.inverse(inv));
+    MatrixN<float,4> zero;
+    EXPECT_FALSE(zero.inverse(inv));
+}
+
+AP_GTEST_MAIN()
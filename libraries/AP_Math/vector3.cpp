@@ -249,24 +249,116 @@ void Vector3<T>::rotate(enum Rotation rotation)
     }
 }
 
+/*
+  the inverses of the standard rotations as constant tables, for
+  rotate_inverse(). Most rotations only swap and negate axes, so
+  output i is sign[i] * input axis[i]. The others have axis[0] == 3
+  and use rotation_inverse_matrices[matrix], which are the transposes
+  of the rotate() matrices
+ */
+struct rotation_perm {
+    uint8_t axis[3];
+    int8_t sign[3];
+    uint8_t matrix;
+};
+
+static constexpr struct rotation_perm rotation_inverse_perms[ROTATION_MAX] = {
+    { { 0, 1, 2 }, {  1,  1,  1 }, 0 }, // ROTATION_NONE
+    { { 3, 3, 3 }, {  0,  0,  0 }, 0 }, // ROTATION_YAW_45
+    { { 1, 0, 2 }, {  1, -1,  1 }, 0 }, // ROTATION_YAW_90
+    { { 3, 3, 3 }, {  0,  0,  0 }, 1 }, // ROTATION_YAW_135
+    { { 0, 1, 2 }, { -1, -1,  1 }, 0 }, // ROTATION_YAW_180
+    { { 3, 3, 3 }, {  0,  0,  0 }, 2 }, // ROTATION_YAW_225
+    { { 1, 0, 2 }, { -1,  1,  1 }, 0 }, // ROTATION_YAW_270
+    { { 3, 3, 3 }, {  0,  0,  0 }, 3 }, // ROTATION_YAW_315
+    { { 0, 1, 2 }, {  1, -1, -1 }, 0 }, // ROTATION_ROLL_180
+    { { 3, 3, 3 }, {  0,  0,  0 }, 4 }, // ROTATION_ROLL_180_YAW_45
+    { { 1, 0, 2 }, {  1,  1, -1 }, 0 }, // ROTATION_ROLL_180_YAW_90
+    { { 3, 3, 3 }, {  0,  0,  0 }, 5 }, // ROTATION_ROLL_180_YAW_135
+    { { 0, 1, 2 }, { -1,  1, -1 }, 0 }, // ROTATION_PITCH_180
+    { { 3, 3, 3 }, {  0,  0,  0 }, 6 }, // ROTATION_ROLL_180_YAW_225
+    { { 1, 0, 2 }, { -1, -1, -1 }, 0 }, // ROTATION_ROLL_180_YAW_270
+    { { 3, 3, 3 }, {  0,  0,  0 }, 7 }, // ROTATION_ROLL_180_YAW_315
+    { { 0, 2, 1 }, {  1,  1, -1 }, 0 }, // ROTATION_ROLL_90
+    { { 3, 3, 3 }, {  0,  0,  0 }, 8 }, // ROTATION_ROLL_90_YAW_45
+    { { 1, 2, 0 }, {  1,  1,  1 }, 0 }, // ROTATION_ROLL_90_YAW_90
+    { { 3, 3, 3 }, {  0,  0,  0 }, 9 }, // ROTATION_ROLL_90_YAW_135
+    { { 0, 2, 1 }, {  1, -1,  1 }, 0 }, // ROTATION_ROLL_270
+    { { 3, 3, 3 }, {  0,  0,  0 }, 10 }, // ROTATION_ROLL_270_YAW_45
+    { { 1, 2, 0 }, {  1, -1, -1 }, 0 }, // ROTATION_ROLL_270_YAW_90
+    { { 3, 3, 3 }, {  0,  0,  0 }, 11 }, // ROTATION_ROLL_270_YAW_135
+    { { 2, 1, 0 }, { -1,  1,  1 }, 0 }, // ROTATION_PITCH_90
+    { { 2, 1, 0 }, {  1,  1, -1 }, 0 }, // ROTATION_PITCH_270
+    { { 1, 0, 2 }, { -1, -1, -1 }, 0 }, // ROTATION_PITCH_180_YAW_90
+    { { 1, 0, 2 }, {  1,  1, -1 }, 0 }, // ROTATION_PITCH_180_YAW_270
+    { { 2, 0, 1 }, { -1,  1, -1 }, 0 }, // ROTATION_ROLL_90_PITCH_90
+    { { 2, 1, 0 }, { -1, -1, -1 }, 0 }, // ROTATION_ROLL_180_PITCH_90
+    { { 2, 0, 1 }, { -1, -1,  1 }, 0 }, // ROTATION_ROLL_270_PITCH_90
+    { { 0, 2, 1 }, { -1, -1, -1 }, 0 }, // ROTATION_ROLL_90_PITCH_180
+    { { 0, 2, 1 }, { -1,  1,  1 }, 0 }, // ROTATION_ROLL_270_PITCH_180
+    { { 2, 0, 1 }, {  1, -1, -1 }, 0 }, // ROTATION_ROLL_90_PITCH_270
+    { { 2, 1, 0 }, {  1, -1,  1 }, 0 }, // ROTATION_ROLL_180_PITCH_270
+    { { 2, 0, 1 }, {  1,  1,  1 }, 0 }, // ROTATION_ROLL_270_PITCH_270
+    { { 1, 2, 0 }, { -1, -1,  1 }, 0 }, // ROTATION_ROLL_90_PITCH_180_YAW_90
+    { { 1, 2, 0 }, { -1,  1, -1 }, 0 }, // ROTATION_ROLL_90_YAW_270
+    { { 3, 3, 3 }, {  0,  0,  0 }, 12 }, // ROTATION_ROLL_90_PITCH_68_YAW_293
+    { { 3, 3, 3 }, {  0,  0,  0 }, 13 }, // ROTATION_PITCH_315
+    { { 3, 3, 3 }, {  0,  0,  0 }, 14 }, // ROTATION_ROLL_90_PITCH_315
+};
+
+static constexpr float rotation_inverse_matrices[][3][3] = {
+    // ROTATION_YAW_45
+    {{ HALF_SQRT_2, HALF_SQRT_2, 0 }, { -HALF_SQRT_2, HALF_SQRT_2, 0 }, { 0, 0, 1 }},
+    // ROTATION_YAW_135
+    {{ -HALF_SQRT_2, HALF_SQRT_2, 0 }, { -HALF_SQRT_2, -HALF_SQRT_2, 0 }, { 0, 0, 1 }},
+    // ROTATION_YAW_225
+    {{ -HALF_SQRT_2, -HALF_SQRT_2, 0 }, { HALF_SQRT_2, -HALF_SQRT_2, 0 }, { 0, 0, 1 }},
+    // ROTATION_YAW_315
+    {{ HALF_SQRT_2, -HALF_SQRT_2, 0 }, { HALF_SQRT_2, HALF_SQRT_2, 0 }, { 0, 0, 1 }},
+    // ROTATION_ROLL_180_YAW_45
+    {{ HALF_SQRT_2, HALF_SQRT_2, 0 }, { HALF_SQRT_2, -HALF_SQRT_2, 0 }, { 0, 0, -1 }},
+    // ROTATION_ROLL_180_YAW_135
+    {{ -HALF_SQRT_2, HALF_SQRT_2, 0 }, { HALF_SQRT_2, HALF_SQRT_2, 0 }, { 0, 0, -1 }},
+    // ROTATION_ROLL_180_YAW_225
+    {{ -HALF_SQRT_2, -HALF_SQRT_2, 0 }, { -HALF_SQRT_2, HALF_SQRT_2, 0 }, { 0, 0, -1 }},
+    // ROTATION_ROLL_180_YAW_315
+    {{ HALF_SQRT_2, -HALF_SQRT_2, 0 }, { -HALF_SQRT_2, -HALF_SQRT_2, 0 }, { 0, 0, -1 }},
+    // ROTATION_ROLL_90_YAW_45
+    {{ HALF_SQRT_2, HALF_SQRT_2, 0 }, { 0, 0, 1 }, { HALF_SQRT_2, -HALF_SQRT_2, 0 }},
+    // ROTATION_ROLL_90_YAW_135
+    {{ -HALF_SQRT_2, HALF_SQRT_2, 0 }, { 0, 0, 1 }, { HALF_SQRT_2, HALF_SQRT_2, 0 }},
+    // ROTATION_ROLL_270_YAW_45
+    {{ HALF_SQRT_2, HALF_SQRT_2, 0 }, { 0, 0, -1 }, { -HALF_SQRT_2, HALF_SQRT_2, 0 }},
+    // ROTATION_ROLL_270_YAW_135
+    {{ -HALF_SQRT_2, HALF_SQRT_2, 0 }, { 0, 0, -1 }, { -HALF_SQRT_2, -HALF_SQRT_2, 0 }},
+    // ROTATION_ROLL_90_PITCH_68_YAW_293
+    {{ 0.143039f, -0.332133f, -0.932324f }, { 0.368776f, -0.856289f, 0.361625f }, { -0.918446f, -0.395546f, 0 }},
+    // ROTATION_PITCH_315
+    {{ HALF_SQRT_2, 0, HALF_SQRT_2 }, { 0, 1, 0 }, { -HALF_SQRT_2, 0, HALF_SQRT_2 }},
+    // ROTATION_ROLL_90_PITCH_315
+    {{ HALF_SQRT_2, 0, HALF_SQRT_2 }, { -HALF_SQRT_2, 0, HALF_SQRT_2 }, { 0, -1, 0 }}
+};
+
+// rotate a vector by the inverse of a standard rotation
 template <typename T>
 void Vector3<T>::rotate_inverse(enum Rotation rotation)
 {
-    Vector3<T> x_vec(1.0f,0.0f,0.0f);
-    Vector3<T> y_vec(0.0f,1.0f,0.0f);
-    Vector3<T> z_vec(0.0f,0.0f,1.0f);
-
-    x_vec.rotate(rotation);
-    y_vec.rotate(rotation);
-    z_vec.rotate(rotation);
-
-    Matrix3<T> M(
-        x_vec.x, y_vec.x, z_vec.x,
-        x_vec.y, y_vec.y, z_vec.y,
-        x_vec.z, y_vec.z, z_vec.z
-    );
-
-    (*this) = M.mul_transpose(*this);
+    if (rotation == ROTATION_NONE || rotation >= ROTATION_MAX) {
+        // custom rotations are done by the caller with a matrix
+        return;
+    }
+    const struct rotation_perm &p = rotation_inverse_perms[rotation];
+    const T v[3] { x, y, z };
+    if (p.axis[0] < 3) {
+        x = p.sign[0] * v[p.axis[0]];
+        y = p.sign[1] * v[p.axis[1]];
+        z = p.sign[2] * v[p.axis[2]];
+        return;
+    }
+    const float (&m)[3][3] = rotation_inverse_matrices[p.matrix];
+    x = m[0][0] * v[0] + m[0][1] * v[1] + m[0][2] * v[2];
+    y = m[1][0] * v[0] + m[1][1] * v[1] + m[1][2] * v[2];
+    z = m[2][0] * v[0] + m[2][1] * v[1] + m[2][2] * v[2];
 }
 
 // vector cross product
@@ -151,7 +151,7 @@ public:
 
     // dot product
     T operator *(const VectorN<T,N> &v) const {
-        float ret = 0;
+        T ret = 0;
         for (uint8_t i=0; i<N; i++) {
             ret += _v[i] * v._v[i];
         }
@@ -26,7 +26,7 @@ const AP_Param::GroupInfo AP_Mission::var_info[] = {
     // @Param: OPTIONS
     // @DisplayName: Mission options bitmask
     // @Description: Bitmask of what options to use in missions.
-    // @Bitmask: 0:Clear Mission on reboot
+    // @Bitmask: 0:Clear Mission on reboot,1:Pipelined mission upload
     // @User: Advanced
     AP_GROUPINFO("OPTIONS",  2, AP_Mission, _options, AP_MISSION_OPTIONS_DEFAULT),
 
@@ -57,6 +57,8 @@ void AP_Mission::init()
     	clear();	
     }
 
+    init_cache();
+
     _last_change_time_ms = AP_HAL::millis();
 }
 
@@ -349,6 +351,12 @@ bool AP_Mission::get_next_nav_cmd(uint16_t start_index, Mission_Command& cmd)
 {
     // search until the end of the mission command list
     for (uint16_t cmd_index = start_index; cmd_index < (unsigned)_cmd_total; cmd_index++) {
+        // skip straight past "do" commands, get_next_cmd would return them and we would move on
+        cmd_index = get_next_nav_or_jump_index(cmd_index);
+        if (cmd_index >= (unsigned)_cmd_total) {
+            break;
+        }
+
         // get next command
         if (!get_next_cmd(cmd_index, cmd, false)) {
             // no more commands so return failure
@@ -513,7 +521,10 @@ bool AP_Mission::read_cmd_from_storage(uint16_t index, Mission_Command& cmd) con
         cmd.id = MAV_CMD_NAV_WAYPOINT;
         cmd.p1 = 0;
         cmd.content.location = AP::ahrs().get_home();
-    }else{
+    } else if (index < _cmd_cache_size && _cmd_cache_valid->get(index)) {
+        // command was decoded earlier
+        cmd = _cmd_cache[index];
+    } else {
         // Find out proper location in memory by using the start_byte position + the index
         // we can load a command, we don't process it yet
         // read WP position
@@ -552,6 +563,12 @@ bool AP_Mission::read_cmd_from_storage(uint16_t index, Mission_Command& cmd) con
 
         // set command's index to it's position in eeprom
         cmd.index = index;
+
+        // keep the decoded command for next time
+        if (index < _cmd_cache_size) {
+            _cmd_cache[index] = cmd;
+            _cmd_cache_valid->set(index);
+        }
     }
 
     // return success
@@ -629,6 +646,12 @@ bool AP_Mission::write_cmd_to_storage(uint16_t index, const Mission_Command& cmd
         _storage.write_block(pos_in_storage+5, packed.bytes, 10);
     }
 
+    // the cached copy no longer matches storage, it is decoded again when next read
+    if (index < _cmd_cache_size) {
+        _cmd_cache_valid->clear(index);
+    }
+    update_nav_index(index, cmd);
+
     // remember when the mission last changed
     _last_change_time_ms = AP_HAL::millis();
 
@@ -1524,8 +1547,11 @@ bool AP_Mission::advance_current_nav_cmd(uint16_t starting_index)
                 }
             }
         }
-        // move onto next command
+        // move onto next command, skipping "do" commands once one has been started
         cmd_index = cmd.index+1;
+        if (_flags.do_cmd_loaded) {
+            cmd_index = get_next_nav_or_jump_index(cmd_index);
+        }
     }
 
     // if we have not found a do command then set flag to show there are no do-commands to be run before nav command completes
@@ -1750,6 +1776,122 @@ void AP_Mission::check_eeprom_version()
     }
 }
 
+///
+/// command cache and navigation index methods
+///
+
+// init_cache - allocate the navigation index and as much of the command cache as free memory allows
+void AP_Mission::init_cache()
+{
+    WITH_SEMAPHORE(_rsem);
+
+    // protect against repeated call to init
+    if (_nav_index != nullptr) {
+        return;
+    }
+
+    const uint16_t num_cmds = num_commands_max();
+
+#if AP_MISSION_CACHE_ENABLED
+    const uint32_t mem_available = hal.util->available_memory();
+    if (mem_available > AP_MISSION_CACHE_MEMORY_RESERVE + num_cmds * sizeof(uint16_t)) {
+        const uint32_t cache_max = (mem_available - AP_MISSION_CACHE_MEMORY_RESERVE - num_cmds * sizeof(uint16_t)) / sizeof(Mission_Command);
+        const uint16_t cache_size = MIN(cache_max, num_cmds);
+        if (cache_size > 0) {
+            _cmd_cache = (Mission_Command *)calloc(cache_size, sizeof(Mission_Command));
+            _cmd_cache_valid = new Bitmask(cache_size);
+            if (_cmd_cache == nullptr || _cmd_cache_valid == nullptr) {
+                free(_cmd_cache);
+                delete _cmd_cache_valid;
+                _cmd_cache = nullptr;
+                _cmd_cache_valid = nullptr;
+            } else {
+                _cmd_cache_size = cache_size;
+            }
+        }
+    }
+#endif
+
+    // build the navigation index now so the first search does not have to
+    _nav_index = (uint16_t *)calloc(num_cmds, sizeof(uint16_t));
+    rebuild_nav_index();
+}
+
+// update_nav_index - update the navigation index for a command written to storage
+//     works back through the commands before it until their entries are unchanged
+void AP_Mission::update_nav_index(uint16_t index, const Mission_Command& cmd)
+{
+    if (_nav_index == nullptr) {
+        return;
+    }
+
+    // a gap after the end of the index, rebuild it when it is next needed
+    if (index > _nav_index_count) {
+        _nav_index_count = 0;
+        return;
+    }
+    if (index == _nav_index_count) {
+        _nav_index_count++;
+    }
+
+    if (is_nav_cmd(cmd) || cmd.id == MAV_CMD_DO_JUMP) {
+        _nav_index[index] = index;
+    } else {
+        _nav_index[index] = (index+1 < _nav_index_count) ? _nav_index[index+1] : AP_MISSION_CMD_INDEX_NONE;
+    }
+
+    // earlier "do" commands lead to the same command as this one
+    for (uint16_t i = index; i > 0; i--) {
+        if (_nav_index[i-1] == i-1 || _nav_index[i-1] == _nav_index[i]) {
+            break;
+        }
+        _nav_index[i-1] = _nav_index[i];
+    }
+}
+
+// rebuild_nav_index - build the navigation index for the whole mission from storage
+void AP_Mission::rebuild_nav_index()
+{
+    if (_nav_index == nullptr) {
+        return;
+    }
+
+    const uint16_t count = MIN((uint16_t)_cmd_total, num_commands_max());
+    uint16_t next = AP_MISSION_CMD_INDEX_NONE;
+    for (uint16_t i = count; i > 0; i--) {
+        Mission_Command cmd;
+        if (!read_cmd_from_storage(i-1, cmd)) {
+            _nav_index_count = 0;
+            return;
+        }
+        if (is_nav_cmd(cmd) || cmd.id == MAV_CMD_DO_JUMP) {
+            next = i-1;
+        }
+        _nav_index[i-1] = next;
+    }
+    _nav_index_count = count;
+}
+
+// get_next_nav_or_jump_index - returns the index of the first navigation or do-jump command at or after index
+//     returns a value at or beyond the end of the mission if there is none
+uint16_t AP_Mission::get_next_nav_or_jump_index(uint16_t index)
+{
+    WITH_SEMAPHORE(_rsem);
+
+    const uint16_t count = MIN((uint16_t)_cmd_total, num_commands_max());
+    if (_nav_index == nullptr || index >= count) {
+        return index;
+    }
+    if (_nav_index_count < count) {
+        rebuild_nav_index();
+        if (_nav_index_count < count) {
+            // index could not be built, don't skip anything
+            return index;
+        }
+    }
+    return _nav_index[index];
+}
+
 /*
   return total number of commands that can fit in storage space
  */
@@ -19,6 +19,7 @@
 #include <AP_Common/AP_Common.h>
 #include <AP_Common/Location.h>
 #include <AP_Param/AP_Param.h>
+#include <AP_Common/Bitmask.h>
 #include <StorageManager/StorageManager.h>
 
 // definitions
@@ -39,6 +40,12 @@
 
 #define AP_MISSION_OPTIONS_DEFAULT          0       // Do not clear the mission when rebooting
 #define AP_MISSION_MASK_MISSION_CLEAR       (1<<0)  // If set then Clear the mission on boot
+#define AP_MISSION_MASK_PIPELINED_UPLOAD    (1<<1)  // If set then request mission items ahead during an upload
+
+#ifndef AP_MISSION_CACHE_ENABLED
+#define AP_MISSION_CACHE_ENABLED            !HAL_MINIMIZE_FEATURES  // keep decoded commands in RAM
+#endif
+#define AP_MISSION_CACHE_MEMORY_RESERVE     8192    // free memory (in bytes) to leave after allocating the command cache
 
 /// @class    AP_Mission
 /// @brief    Object managing Mission
@@ -478,6 +485,11 @@ public:
     // returns true if the mission contains the requested items
     bool contains_item(MAV_CMD command) const;
 
+    // returns true if uploads should request mission items ahead of the next expected item
+    bool pipelined_upload_enabled() const {
+        return (_options & AP_MISSION_MASK_PIPELINED_UPLOAD) != 0;
+    }
+
     // user settable parameters
     static const struct AP_Param::GroupInfo var_info[];
 
@@ -546,6 +558,22 @@ private:
     /// command list will be cleared if they do not match
     void check_eeprom_version();
 
+    ///
+    /// command cache and navigation index methods
+    ///
+    // init_cache - allocate the navigation index and as much of the command cache as free memory allows
+    void init_cache();
+
+    // update_nav_index - update the navigation index for a command written to storage
+    void update_nav_index(uint16_t index, const Mission_Command& cmd);
+
+    // rebuild_nav_index - build the navigation index for the whole mission from storage
+    void rebuild_nav_index();
+
+    // get_next_nav_or_jump_index - returns the index of the first navigation or do-jump command at or after index
+    //     returns a value at or beyond the end of the mission if there is none
+    uint16_t get_next_nav_or_jump_index(uint16_t index);
+
     /// sanity checks that the masked fields are not NaN's or infinite
     static MAV_MISSION_RESULT sanity_check_params(const mavlink_mission_item_int_t& packet);
 
@@ -575,6 +603,16 @@ private:
     // last time that mission changed
     uint32_t _last_change_time_ms;
 
+    // RAM cache of the commands decoded from storage, holding the first _cmd_cache_size commands
+    Mission_Command         *_cmd_cache = nullptr;
+    Bitmask                 *_cmd_cache_valid = nullptr;    // bit set for each cached command which matches storage
+    uint16_t                _cmd_cache_size;
+
+    // navigation index holding the index of the first navigation or do-jump command at or after each command,
+    // or AP_MISSION_CMD_INDEX_NONE if there is none.  Covers the first _nav_index_count commands
+    uint16_t                *_nav_index = nullptr;
+    uint16_t                _nav_index_count;
+
     // multi-thread support. This is static so it can be used from
     // const functions
     static HAL_Semaphore_Recursive _rsem;
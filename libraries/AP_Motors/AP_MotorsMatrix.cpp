@@ -191,28 +191,33 @@ void AP_MotorsMatrix::output_armed_stabilizing()
 
     // calculate amount of yaw we can fit into the throttle range
     // this is always equal to or less than the requested yaw from the pilot or rate controller
+    // the loops only visit the enabled motors, whose factors update_mix_factors() has packed into _mix_*
+    // thrust[] holds the roll, pitch and yaw part of each motor's output, in the same order
+    float thrust[AP_MOTORS_MAX_NUM_MOTORS];
+    const uint8_t lost_motor = _thrust_boost ? _motor_lost_index : AP_MOTORS_MAX_NUM_MOTORS;
+    uint8_t lost_slot = AP_MOTORS_MAX_NUM_MOTORS;
     float rp_low = 1.0f;    // lowest thrust value
     float rp_high = -1.0f;  // highest thrust value
-    for (i=0; i<AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            // calculate the thrust outputs for roll and pitch
-            _thrust_rpyt_out[i] = roll_thrust * _roll_factor[i] + pitch_thrust * _pitch_factor[i];
-            // record lowest roll+pitch command
-            if (_thrust_rpyt_out[i] < rp_low) {
-                rp_low = _thrust_rpyt_out[i];
-            }
-            // record highest roll+pitch command
-            if (_thrust_rpyt_out[i] > rp_high && (!_thrust_boost || i != _motor_lost_index)) {
-                rp_high = _thrust_rpyt_out[i];
-            }
+    for (i=0; i<_mix_num_motors; i++) {
+        // calculate the thrust outputs for roll and pitch
+        thrust[i] = roll_thrust * _mix_roll_factor[i] + pitch_thrust * _mix_pitch_factor[i];
+        // record lowest roll+pitch command
+        if (thrust[i] < rp_low) {
+            rp_low = thrust[i];
+        }
+        // record highest roll+pitch command, leaving out the lost motor
+        if (_mix_motor[i] == lost_motor) {
+            lost_slot = i;
+        } else if (thrust[i] > rp_high) {
+            rp_high = thrust[i];
         }
     }
 
     // include the lost motor scaled by _thrust_boost_ratio
-    if (_thrust_boost && motor_enabled[_motor_lost_index]) {
+    if (lost_slot < _mix_num_motors) {
         // record highest roll+pitch command
-        if (_thrust_rpyt_out[_motor_lost_index] > rp_high) {
-            rp_high = _thrust_boost_ratio*rp_high + (1.0f-_thrust_boost_ratio)*_thrust_rpyt_out[_motor_lost_index];
+        if (thrust[lost_slot] > rp_high) {
+            rp_high = _thrust_boost_ratio*rp_high + (1.0f-_thrust_boost_ratio)*thrust[lost_slot];
         }
     }
 
@@ -239,25 +244,23 @@ void AP_MotorsMatrix::output_armed_stabilizing()
     // add yaw control to thrust outputs
     float rpy_low = 1.0f;   // lowest thrust value
     float rpy_high = -1.0f; // highest thrust value
-    for (i=0; i<AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            _thrust_rpyt_out[i] = _thrust_rpyt_out[i] + yaw_thrust * _yaw_factor[i];
+    for (i=0; i<_mix_num_motors; i++) {
+        thrust[i] += yaw_thrust * _mix_yaw_factor[i];
 
-            // record lowest roll+pitch+yaw command
-            if (_thrust_rpyt_out[i] < rpy_low) {
-                rpy_low = _thrust_rpyt_out[i];
-            }
-            // record highest roll+pitch+yaw command
-            if (_thrust_rpyt_out[i] > rpy_high && (!_thrust_boost || i != _motor_lost_index)) {
-                rpy_high = _thrust_rpyt_out[i];
-            }
+        // record lowest roll+pitch+yaw command
+        if (thrust[i] < rpy_low) {
+            rpy_low = thrust[i];
+        }
+        // record highest roll+pitch+yaw command
+        if (thrust[i] > rpy_high && i != lost_slot) {
+            rpy_high = thrust[i];
         }
     }
     // include the lost motor scaled by _thrust_boost_ratio
-    if (_thrust_boost) {
+    if (lost_slot < _mix_num_motors) {
         // record highest roll+pitch+yaw command
-        if (_thrust_rpyt_out[_motor_lost_index] > rpy_high && motor_enabled[_motor_lost_index]) {
-            rpy_high = _thrust_boost_ratio*rpy_high + (1.0f-_thrust_boost_ratio)*_thrust_rpyt_out[_motor_lost_index];
+        if (thrust[lost_slot] > rpy_high) {
+            rpy_high = _thrust_boost_ratio*rpy_high + (1.0f-_thrust_boost_ratio)*thrust[lost_slot];
         }
     }
 
@@ -295,10 +298,9 @@ void AP_MotorsMatrix::output_armed_stabilizing()
     }
 
     // add scaled roll, pitch, constrained yaw and throttle for each motor
-    for (i=0; i<AP_MOTORS_MAX_NUM_MOTORS; i++) {
-        if (motor_enabled[i]) {
-            _thrust_rpyt_out[i] = throttle_thrust_best_rpy + thr_adj + (rpy_scale * _thrust_rpyt_out[i]);
-        }
+    const float thrust_base = throttle_thrust_best_rpy + thr_adj;
+    for (i=0; i<_mix_num_motors; i++) {
+        _thrust_rpyt_out[_mix_motor[i]] = thrust_base + (rpy_scale * thrust[i]);
     }
 
     // check for failed motor
@@ -832,6 +834,23 @@ void AP_MotorsMatrix::normalise_rpy_factors()
             }
         }
     }
+
+    update_mix_factors();
+}
+
+// update_mix_factors - pack the factors of the enabled motors for output_armed_stabilizing
+void AP_MotorsMatrix::update_mix_factors()
+{
+    _mix_num_motors = 0;
+    for (uint8_t i=0; i<AP_MOTORS_MAX_NUM_MOTORS; i++) {
+        if (motor_enabled[i]) {
+            _mix_motor[_mix_num_motors] = i;
+            _mix_roll_factor[_mix_num_motors] = _roll_factor[i];
+            _mix_pitch_factor[_mix_num_motors] = _pitch_factor[i];
+            _mix_yaw_factor[_mix_num_motors] = _yaw_factor[i];
+            _mix_num_motors++;
+        }
+    }
 }
 
 
@@ -78,8 +78,13 @@ protected:
     virtual void        setup_motors(motor_frame_class frame_class, motor_frame_type frame_type);
 
     // normalizes the roll, pitch and yaw factors so maximum magnitude is 0.5
+    //  and updates the packed factors used by output_armed_stabilizing
     void                normalise_rpy_factors();
 
+    // update_mix_factors - pack the factors of the enabled motors into the _mix_ arrays
+    //  must be called whenever motors are added or removed or their factors change
+    void                update_mix_factors();
+
     // call vehicle supplied thrust compensation if set
     void                thrust_compensation(void) override;
 
@@ -91,6 +96,13 @@ protected:
     motor_frame_class   _last_frame_class; // most recently requested frame class (i.e. quad, hexa, octa, etc)
     motor_frame_type    _last_frame_type; // most recently requested frame type (i.e. plus, x, v, etc)
 
+    // roll, pitch and yaw factors of the enabled motors packed together, in motor number order
+    float               _mix_roll_factor[AP_MOTORS_MAX_NUM_MOTORS];
+    float               _mix_pitch_factor[AP_MOTORS_MAX_NUM_MOTORS];
+    float               _mix_yaw_factor[AP_MOTORS_MAX_NUM_MOTORS];
+    uint8_t             _mix_motor[AP_MOTORS_MAX_NUM_MOTORS];   // motor number of each packed entry
+    uint8_t             _mix_num_motors = 0;                    // number of packed entries
+
     // motor failure handling
     float               _thrust_rpyt_out_filt[AP_MOTORS_MAX_NUM_MOTORS];    // filtered thrust outputs with 1 second time constant
     uint8_t             _motor_lost_index;  // index number of the lost motor
@@ -217,6 +217,7 @@ AP_MotorsMulticopter::AP_MotorsMulticopter(uint16_t loop_rate, uint16_t speed_hz
     // setup battery voltage filtering
     _batt_voltage_filt.set_cutoff_frequency(AP_MOTORS_BATT_VOLT_FILT_HZ);
     _batt_voltage_filt.reset(1.0f);
+    update_thrust_curve();
 
     // default throttle range
     _throttle_radio_min = 1100;
@@ -322,22 +323,36 @@ float AP_MotorsMulticopter::get_current_limit_max_throttle()
 // apply_thrust_curve_and_volt_scaling - returns throttle in the range 0 ~ 1
 float AP_MotorsMulticopter::apply_thrust_curve_and_volt_scaling(float thrust) const
 {
-    float throttle_ratio = thrust;
     // apply thrust curve - domain 0.0 to 1.0, range 0.0 to 1.0
-    float thrust_curve_expo = constrain_float(_thrust_curve_expo, -1.0f, 1.0f);
-    if (fabsf(thrust_curve_expo) < 0.001) {
+    if (_thrust_curve_linear) {
         // zero expo means linear, avoid floating point exception for small values
         return thrust;
     }
-    if(!is_zero(_batt_voltage_filt.get())) {
-        throttle_ratio = ((thrust_curve_expo-1.0f) + safe_sqrt((1.0f-thrust_curve_expo)*(1.0f-thrust_curve_expo) + 4.0f*thrust_curve_expo*_lift_max*thrust))/(2.0f*thrust_curve_expo*_batt_voltage_filt.get());
-    } else {
-        throttle_ratio = ((thrust_curve_expo-1.0f) + safe_sqrt((1.0f-thrust_curve_expo)*(1.0f-thrust_curve_expo) + 4.0f*thrust_curve_expo*_lift_max*thrust))/(2.0f*thrust_curve_expo);
-    }
+    const float throttle_ratio = (_thrust_curve_offset + safe_sqrt(_thrust_curve_offset_sq + _thrust_curve_gain*thrust)) * _thrust_curve_scale;
 
     return constrain_float(throttle_ratio, 0.0f, 1.0f);
 }
 
+// update_thrust_curve - calculate the terms of the thrust curve which do not depend on the thrust
+//  the curve is throttle = ((expo-1) + sqrt((1-expo)^2 + 4*expo*lift_max*thrust)) / (2*expo*batt_voltage_filt)
+void AP_MotorsMulticopter::update_thrust_curve()
+{
+    const float thrust_curve_expo = constrain_float(_thrust_curve_expo, -1.0f, 1.0f);
+    _thrust_curve_linear = fabsf(thrust_curve_expo) < 0.001f;
+    if (_thrust_curve_linear) {
+        return;
+    }
+    _thrust_curve_offset = thrust_curve_expo - 1.0f;
+    _thrust_curve_offset_sq = sq(_thrust_curve_offset);
+    _thrust_curve_gain = 4.0f * thrust_curve_expo * _lift_max;
+    const float batt_voltage_filt = _batt_voltage_filt.get();
+    if (!is_zero(batt_voltage_filt)) {
+        _thrust_curve_scale = 1.0f / (2.0f * thrust_curve_expo * batt_voltage_filt);
+    } else {
+        _thrust_curve_scale = 1.0f / (2.0f * thrust_curve_expo);
+    }
+}
+
 // update_lift_max from battery voltage - used for voltage compensation
 void AP_MotorsMulticopter::update_lift_max_from_batt_voltage()
 {
@@ -347,6 +362,7 @@ void AP_MotorsMulticopter::update_lift_max_from_batt_voltage()
     if((_batt_voltage_max <= 0) || (_batt_voltage_min >= _batt_voltage_max) || (_batt_voltage_resting_estimate < 0.25f*_batt_voltage_min)) {
         _batt_voltage_filt.reset(1.0f);
         _lift_max = 1.0f;
+        update_thrust_curve();
         return;
     }
 
@@ -361,6 +377,8 @@ void AP_MotorsMulticopter::update_lift_max_from_batt_voltage()
     // calculate lift max
     float thrust_curve_expo = constrain_float(_thrust_curve_expo, -1.0f, 1.0f);
     _lift_max = batt_voltage_filt*(1-thrust_curve_expo) + thrust_curve_expo*batt_voltage_filt*batt_voltage_filt;
+
+    update_thrust_curve();
 }
 
 float AP_MotorsMulticopter::get_compensation_gain() const
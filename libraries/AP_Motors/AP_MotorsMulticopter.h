@@ -110,8 +110,12 @@ protected:
     float               apply_thrust_curve_and_volt_scaling(float thrust) const;
 
     // update_lift_max_from_batt_voltage - used for voltage compensation
+    //  also updates the thrust curve terms
     void                update_lift_max_from_batt_voltage();
 
+    // update_thrust_curve - update the thrust curve terms from the expo, lift_max and filtered battery voltage
+    void                update_thrust_curve();
+
     // return gain scheduling gain based on voltage and air density
     float               get_compensation_gain() const;
 
@@ -183,6 +187,13 @@ protected:
     // battery voltage, current and air pressure compensation variables
     LowPassFilterFloat  _batt_voltage_filt;     // filtered battery voltage expressed as a percentage (0 ~ 1.0) of batt_voltage_max
     float               _lift_max;              // maximum lift ratio from battery voltage
+
+    // terms of the thrust curve calculated once per loop by update_thrust_curve()
+    bool                _thrust_curve_linear;   // true if the expo is close enough to zero for the curve to be linear
+    float               _thrust_curve_offset;   // expo - 1
+    float               _thrust_curve_offset_sq; // (expo - 1)^2
+    float               _thrust_curve_gain;     // 4 * expo * lift_max
+    float               _thrust_curve_scale;    // 1 / (2 * expo * batt_voltage_filt)
     float               _throttle_limit;        // ratio of throttle limit between hover and maximum
     float               _throttle_thrust_max;   // the maximum allowed throttle thrust 0.0 to 1.0 in the range throttle_min to throttle_max
     uint16_t            _disarm_safety_timer;
@@ -0,0 +1,93 @@
+/*
+ *  Benchmark of the AP_MotorsMatrix mixer
+ *
+ *  times calls to output() with the motors armed and spooled up, for
+ *  frames with from four to twelve motors. Roll, pitch and yaw sweep
+ *  through and beyond their limits so the saturation handling runs
+ */
+
+#include <AP_Common/AP_Common.h>
+#include <AP_Param/AP_Param.h>
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Math/AP_Math.h>
+#include <AP_Motors/AP_Motors.h>
+#include <AP_BattMonitor/AP_BattMonitor.h>
+#include <SRV_Channel/SRV_Channel.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+void setup();
+void loop();
+
+#define BENCHMARK_ITERATIONS    10000   // calls to output() timed for each frame
+
+SRV_Channels srvs;
+AP_BattMonitor _battmonitor{0, nullptr, nullptr};
+
+AP_MotorsMatrix motors(400);
+
+static const struct {
+    AP_Motors::motor_frame_class frame_class;
+    const char *name;
+} frames[] = {
+    { AP_Motors::MOTOR_FRAME_QUAD,       "quad" },
+    { AP_Motors::MOTOR_FRAME_HEXA,       "hexa" },
+    { AP_Motors::MOTOR_FRAME_OCTA,       "octa" },
+    { AP_Motors::MOTOR_FRAME_DODECAHEXA, "dodecahexa" },
+};
+
+static void benchmark_frame(AP_Motors::motor_frame_class frame_class, const char *name)
+{
+    motors.init(frame_class, AP_Motors::MOTOR_FRAME_TYPE_X);
+    if (!motors.initialised_ok()) {
+        hal.console->printf("%s: frame not supported\n", name);
+        return;
+    }
+    motors.set_update_rate(490);
+    motors.set_throttle_range(1000, 2000);
+    motors.set_throttle_avg_max(0.5f);
+    motors.armed(true);
+    motors.set_interlock(true);
+    motors.set_desired_spool_state(AP_Motors::DESIRED_THROTTLE_UNLIMITED);
+
+    // run long enough to finish spooling up
+    motors.set_throttle(0.5f);
+    for (uint16_t i=0; i<1000; i++) {
+        motors.output();
+    }
+
+    const uint32_t start_us = AP_HAL::micros();
+    for (uint16_t i=0; i<BENCHMARK_ITERATIONS; i++) {
+        motors.set_roll(1.2f * sinf(i * 0.010f));
+        motors.set_pitch(1.2f * sinf(i * 0.013f));
+        motors.set_yaw(1.2f * sinf(i * 0.007f));
+        motors.set_throttle(0.5f + 0.5f * sinf(i * 0.003f));
+        motors.output();
+    }
+    const uint32_t elapsed_us = AP_HAL::micros() - start_us;
+
+    hal.console->printf("%s: %.3f us per output\n", name, (double)(elapsed_us / float(BENCHMARK_ITERATIONS)));
+
+    motors.set_roll(0);
+    motors.set_pitch(0);
+    motors.set_yaw(0);
+    motors.set_throttle(0);
+    motors.armed(false);
+}
+
+void setup()
+{
+    hal.console->printf("AP_Motors benchmark\n");
+    hal.scheduler->delay(1000);
+
+    for (uint8_t i=0; i<ARRAY_SIZE(frames); i++) {
+        benchmark_frame(frames[i].frame_class, frames[i].name);
+    }
+}
+
+void loop()
+{
+    hal.scheduler->delay(1000);
+}
+
+AP_HAL_MAIN();
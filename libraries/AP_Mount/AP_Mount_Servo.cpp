@@ -2,6 +2,9 @@
 
 extern const AP_HAL::HAL& hal;
 
+// time after the last update_fast after which update moves the servos itself
+#define AP_MOUNT_SERVO_FAST_TIMEOUT_MS  100
+
 // init - performs any required initialisation for this instance
 void AP_Mount_Servo::init(const AP_SerialManager& serial_manager)
 {
@@ -34,6 +37,8 @@ void AP_Mount_Servo::update()
         _last_check_servo_map_ms = now;
     }
 
+    bool stabilizing = false;
+
     switch(get_mode()) {
         // move mount to a "retracted position" or to a position where a fourth servo can retract the entire mount into the fuselage
         case MAV_MOUNT_MODE_RETRACT:
@@ -53,7 +58,7 @@ void AP_Mount_Servo::update()
         case MAV_MOUNT_MODE_MAVLINK_TARGETING:
         {
             // earth-frame angle targets (i.e. _angle_ef_target_rad) should have already been set by a MOUNT_CONTROL message from GCS
-            stabilize();
+            stabilizing = true;
             break;
         }
 
@@ -62,7 +67,7 @@ void AP_Mount_Servo::update()
         {
             // update targets using pilot's rc inputs
             update_targets_from_rc();
-            stabilize();
+            stabilizing = true;
             break;
         }
 
@@ -71,7 +76,7 @@ void AP_Mount_Servo::update()
         {
             if(AP::gps().status() >= AP_GPS::GPS_OK_FIX_2D) {
                 calc_angle_to_location(_state._roi_target, _angle_ef_target_rad, _flags.tilt_control, _flags.pan_control, false);
-                stabilize();
+                stabilizing = true;
             }
             break;
         }
@@ -81,6 +86,8 @@ void AP_Mount_Servo::update()
             break;
     }
 
+    _stabilizing = stabilizing;
+
     // move mount to a "retracted position" into the fuselage with a fourth servo
     bool mount_open_new = (get_mode() == MAV_MOUNT_MODE_RETRACT) ? 0 : 1;
     if (mount_open != mount_open_new) {
@@ -88,10 +95,28 @@ void AP_Mount_Servo::update()
         move_servo(_open_idx, mount_open_new, 0, 1);
     }
 
-    // write the results to the servos
-    move_servo(_roll_idx, _angle_bf_output_deg.x*10, _state._roll_angle_min*0.1f, _state._roll_angle_max*0.1f);
-    move_servo(_tilt_idx, _angle_bf_output_deg.y*10, _state._tilt_angle_min*0.1f, _state._tilt_angle_max*0.1f);
-    move_servo(_pan_idx,  _angle_bf_output_deg.z*10, _state._pan_angle_min*0.1f, _state._pan_angle_max*0.1f);
+    // stabilisation is left to update_fast while it is being called,
+    // so it follows the attitude at the main loop rate
+    if (now - _last_update_fast_ms < AP_MOUNT_SERVO_FAST_TIMEOUT_MS) {
+        return;
+    }
+
+    if (_stabilizing) {
+        stabilize();
+    }
+    write_servos();
+}
+
+// update_fast - stabilise against the latest attitude and body rates and move the servos
+//  the targets are still worked out by update
+void AP_Mount_Servo::update_fast()
+{
+    _last_update_fast_ms = AP_HAL::millis();
+
+    if (_stabilizing) {
+        stabilize();
+    }
+    write_servos();
 }
 
 // set_mode - sets mount's mode
@@ -112,6 +137,14 @@ void AP_Mount_Servo::check_servo_map()
     _flags.pan_control = SRV_Channels::function_assigned(_pan_idx);
 }
 
+// write_servos - moves the servos to _angle_bf_output_deg
+void AP_Mount_Servo::write_servos()
+{
+    move_servo(_roll_idx, _angle_bf_output_deg.x*10, _state._roll_angle_min*0.1f, _state._roll_angle_max*0.1f);
+    move_servo(_tilt_idx, _angle_bf_output_deg.y*10, _state._tilt_angle_min*0.1f, _state._tilt_angle_max*0.1f);
+    move_servo(_pan_idx,  _angle_bf_output_deg.z*10, _state._pan_angle_min*0.1f, _state._pan_angle_max*0.1f);
+}
+
 // send_mount_status - called to allow mounts to send their status to GCS using the MOUNT_STATUS message
 void AP_Mount_Servo::send_mount_status(mavlink_channel_t chan)
 {
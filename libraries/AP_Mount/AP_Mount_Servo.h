@@ -30,6 +30,9 @@ public:
     // update mount position - should be called periodically
     virtual void update() override;
 
+    // stabilise and move the servos - called at the main loop rate by vehicles that support it
+    virtual void update_fast() override;
+
     // has_pan_control - returns true if this mount can control it's pan (required for multicopters)
     virtual bool has_pan_control() const override { return _flags.pan_control; }
 
@@ -55,6 +58,9 @@ private:
     // stabilize - stabilizes the mount relative to the Earth's frame
     void stabilize();
 
+    // write_servos - moves the servos to _angle_bf_output_deg
+    void write_servos();
+
     // closest_limit - returns closest angle to 'angle' taking into account limits.  all angles are in degrees * 10
     int16_t closest_limit(int16_t angle, int16_t angle_min, int16_t angle_max);
 
@@ -70,4 +76,7 @@ private:
     Vector3f _angle_bf_output_deg;  // final body frame output angle in degrees
 
     uint32_t _last_check_servo_map_ms;  // system time of latest call to check_servo_map function
+
+    bool _stabilizing;                  // true if the mode needs stabilize() to work out the output angles
+    uint32_t _last_update_fast_ms;      // system time of latest call to update_fast, while it is being called update leaves the servos to it
 };
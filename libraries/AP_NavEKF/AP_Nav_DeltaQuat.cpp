@@ -0,0 +1,36 @@
+/*
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_Nav_DeltaQuat.h"
+
+#include <string.h>
+
+// starts as a zero delta angle and the identity rotation, which match
+AP_Nav_DeltaQuat::entry AP_Nav_DeltaQuat::_cache[INS_MAX_INSTANCES];
+
+const Quaternion &AP_Nav_DeltaQuat::get(uint8_t imu_index, const Vector3f &delAng)
+{
+    if (imu_index >= INS_MAX_INSTANCES) {
+        imu_index = 0;
+    }
+    entry &e = _cache[imu_index];
+    // compared bit for bit, so a hit gives the same rotation as
+    // converting the delta angle again would
+    if (memcmp(&e.delAng, &delAng, sizeof(delAng)) != 0) {
+        e.delAng = delAng;
+        e.quat.from_axis_angle(delAng);
+    }
+    return e.quat;
+}
@@ -0,0 +1,45 @@
+/*
+  AP_Nav_DeltaQuat converts IMU delta angles to rotations once for
+  all the EKFs running
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <AP_Math/AP_Math.h>
+#include <AP_InertialSensor/AP_InertialSensor.h>
+
+/*
+  EKF2 and EKF3 both accumulate each IMU's delta angle into a
+  quaternion on every IMU sample, and converting a delta angle to a
+  rotation needs a sqrtf, sinf and cosf. When both are running, the
+  second estimator to read an IMU in a loop gets the rotation the
+  first one worked out.
+
+  The cache is keyed on the delta angle itself, so a core that falls
+  back to another IMU's gyro still gets the right rotation, just
+  without the saving. Only called from the main thread
+ */
+class AP_Nav_DeltaQuat {
+public:
+    // return the rotation for a delta angle from the given IMU
+    static const Quaternion &get(uint8_t imu_index, const Vector3f &delAng);
+
+private:
+    struct entry {
+        Vector3f delAng;
+        Quaternion quat;
+    };
+    static entry _cache[INS_MAX_INSTANCES];
+};
@@ -69,6 +69,9 @@ public:
     // return -1 if no primary core selected
     int8_t getPrimaryCoreIndex(void) const;
 
+    // returns the number of times the primary core has changed since boot
+    uint32_t getLaneSwitchCount(void) const { return laneSwitchCount; }
+
     // returns the index of the IMU of the primary core
     // return -1 if no primary core selected
     int8_t getPrimaryCoreIMUIndex(void) const;
@@ -344,6 +347,7 @@ public:
 private:
     uint8_t num_cores; // number of allocated cores
     uint8_t primary;   // current primary core
+    uint32_t laneSwitchCount; // number of primary core changes
     NavEKF2_core *core = nullptr;
     const AP_AHRS *_ahrs;
     const RangeFinder &_rng;
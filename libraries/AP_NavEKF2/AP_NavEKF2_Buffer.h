@@ -83,7 +83,7 @@ public:
      * Writes data and timestamp to a Ring buffer and advances indices that
      * define the location of the newest and oldest data
     */
-    inline void push(element_type element)
+    inline void push(const element_type &element)
     {
         // Advance head to next available index
         _head = (_head+1)%_size;
@@ -92,7 +92,7 @@ public:
         _new_data = true;
     }
     // writes the same data to all elements in the ring buffer
-    inline void reset_history(element_type element, uint32_t sample_time) {
+    inline void reset_history(const element_type &element, uint32_t sample_time) {
         for (uint8_t index=0; index<_size; index++) {
             buffer[index].element = element;
         }
@@ -111,6 +111,128 @@ private:
 };
 
 
+// this buffer model is a drop-in replacement for obs_ring_buffer_t
+// for sensors whose samples are pushed in time order. The size is
+// rounded up to a power of two so indexes wrap with a mask, and
+// recall() uses a binary search over the stored samples rather than
+// a linear scan
+template <typename element_type>
+class obs_monotonic_ring_buffer_t
+{
+public:
+    struct element_t{
+        element_type element;
+    } *buffer;
+
+    // initialise buffer, returns false when allocation has failed
+    bool init(uint32_t size)
+    {
+        uint16_t size2 = 1;
+        while (size2 < size && size2 < 256) {
+            size2 <<= 1;
+        }
+        buffer = new element_t[size2];
+        if(buffer == nullptr)
+        {
+            return false;
+        }
+        memset((void *)buffer,0,size2*sizeof(element_t));
+        _mask = size2 - 1;
+        _head = 0;
+        _tail = 0;
+        _new_data = false;
+        return true;
+    }
+
+    /*
+     * Searches through a ring buffer and return the newest data that is older than the
+     * time specified by sample_time_ms
+     * Zeros old data so it cannot not be used again
+     * Returns false if no data can be found that is less than 100msec old
+     * This gives the same result as obs_ring_buffer_t::recall() as long as the
+     * samples were pushed in time order
+    */
+    bool recall(element_type &element,uint32_t sample_time)
+    {
+        if(!_new_data) {
+            return false;
+        }
+        uint8_t bestIndex;
+
+        if(_head == _tail) {
+            // if head is equal to tail just check the one sample
+            bestIndex = _tail;
+        } else {
+            // find the first sample, counting from the tail, that is
+            // newer than the fusion time horizon. The sample at the
+            // head is not considered, matching obs_ring_buffer_t
+            uint8_t low = 0;
+            uint8_t high = (_head - _tail) & _mask;
+            while (low < high) {
+                const uint8_t mid = (low + high) / 2;
+                if (buffer[(_tail + mid) & _mask].element.time_ms > sample_time) {
+                    high = mid;
+                } else {
+                    low = mid + 1;
+                }
+            }
+            if (low == 0) {
+                // everything is newer than the time horizon
+                return false;
+            }
+            bestIndex = (_tail + low - 1) & _mask;
+        }
+
+        const uint32_t best_time_ms = buffer[bestIndex].element.time_ms;
+        if (best_time_ms == 0 || best_time_ms > sample_time ||
+            (sample_time - best_time_ms) >= 100) {
+            // unused, too new or stale. Older samples are staler still
+            return false;
+        }
+
+        element = buffer[bestIndex].element;
+        _tail = (bestIndex+1) & _mask;
+        if (bestIndex == _head) {
+            _new_data = false;
+        }
+        //make time zero to stop using it again,
+        //resolves corner case of reusing the element when head == tail
+        buffer[bestIndex].element.time_ms = 0;
+        return true;
+    }
+
+    /*
+     * Writes data and timestamp to a Ring buffer and advances indices that
+     * define the location of the newest and oldest data
+    */
+    inline void push(const element_type &element)
+    {
+        // Advance head to next available index
+        _head = (_head+1) & _mask;
+        // New data is written at the head
+        buffer[_head].element = element;
+        _new_data = true;
+    }
+    // writes the same data to all elements in the ring buffer
+    inline void reset_history(const element_type &element, uint32_t sample_time) {
+        for (uint16_t index=0; index<=_mask; index++) {
+            buffer[index].element = element;
+        }
+    }
+
+    // zeroes all data in the ring buffer
+    inline void reset() {
+        _head = 0;
+        _tail = 0;
+        _new_data = false;
+        memset((void *)buffer,0,(_mask+1)*sizeof(element_t));
+    }
+
+private:
+    uint8_t _mask,_head,_tail,_new_data;
+};
+
+
 // Following buffer model is for IMU data,
 // it achieves a distance of sample size
 // between youngest and oldest
@@ -140,7 +262,7 @@ public:
      * Writes data to a Ring buffer and advances indices that
      * define the location of the newest and oldest data
     */
-    inline void push_youngest_element(element_type element)
+    inline void push_youngest_element(const element_type &element)
     {
         // push youngest to the buffer
         _youngest = (_youngest+1)%_size;
@@ -163,7 +285,7 @@ public:
     }
 
     // writes the same data to all elements in the ring buffer
-    inline void reset_history(element_type element) {
+    inline void reset_history(const element_type &element) {
         for (uint8_t index=0; index<_size; index++) {
             buffer[index].element = element;
         }
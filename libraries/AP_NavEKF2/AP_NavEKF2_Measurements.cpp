@@ -6,6 +6,7 @@
 #include <AP_Vehicle/AP_Vehicle.h>
 #include <GCS_MAVLink/GCS.h>
 #include <AP_RangeFinder/RangeFinder_Backend.h>
+#include <AP_NavEKF/AP_Nav_DeltaQuat.h>
 
 #include <stdio.h>
 
@@ -48,7 +49,14 @@ void NavEKF2_core::readRangeFinder(void)
                 if (rngMeasIndex[sensorIndex] > 2) {
                     rngMeasIndex[sensorIndex] = 0;
                 }
-                storedRngMeasTime_ms[sensorIndex][rngMeasIndex[sensorIndex]] = imuSampleTime_ms - 25;
+                // use the time the reading arrived when the driver knows it,
+                // otherwise assume a typical 25msec sensor delay
+                const uint32_t readingTime_ms = sensor->reading_time_ms();
+                if (readingTime_ms != 0 && (imuSampleTime_ms - readingTime_ms) < 100) {
+                    storedRngMeasTime_ms[sensorIndex][rngMeasIndex[sensorIndex]] = readingTime_ms;
+                } else {
+                    storedRngMeasTime_ms[sensorIndex][rngMeasIndex[sensorIndex]] = imuSampleTime_ms - 25;
+                }
                 storedRngMeas[sensorIndex][rngMeasIndex[sensorIndex]] = sensor->distance_cm() * 0.01f;
             }
 
@@ -329,7 +337,7 @@ void NavEKF2_core::readIMUData()
 
     // Rotate quaternon atitude from previous to new and normalise.
     // Accumulation using quaternions prevents introduction of coning errors due to downsampling
-    imuQuatDownSampleNew.rotate(imuDataNew.delAng);
+    imuQuatDownSampleNew *= AP_Nav_DeltaQuat::get(imu_index, imuDataNew.delAng);
     imuQuatDownSampleNew.normalize();
 
     // Rotate the latest delta velocity into body frame at the start of accumulation
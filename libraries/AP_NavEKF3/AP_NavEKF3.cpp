@@ -587,6 +587,21 @@ const AP_Param::GroupInfo NavEKF3::var_info[] = {
     // @RebootRequired: True
     AP_GROUPINFO("FLOW_USE", 54, NavEKF3, _flowUse, FLOW_USE_DEFAULT),
 
+    // @Param: LANE_FUSEDIV
+    // @DisplayName: Non-primary lane fusion rate divider
+    // @Description: When set above 1, EKF cores that are not the primary only perform measurement fusion on every Nth prediction cycle, taking turns so that the fusion load is spread across frames. State and covariance prediction still runs on every cycle. All cores return to full rate fusion whenever the primary error score or health indicates a lane switch may be required, or when a core's error score is close to the primary's. Set to 1 to fuse on every cycle on all cores.
+    // @Range: 1 4
+    // @Increment: 1
+    // @User: Advanced
+    AP_GROUPINFO("LANE_FUSEDIV", 55, NavEKF3, _laneFusionDivider, 1),
+
+    // @Param: BCN_BATCH
+    // @DisplayName: Range beacon batch fusion
+    // @Description: When enabled, the ranges to all beacons that have new data are stored on each update, and all of those that have reached the fusion time horizon are fused in one update, rather than one range per update. This keeps up with many beacons at high rates. The initial beacon alignment is also started from the beacon library's solution for the position when it has one.
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO("BCN_BATCH", 56, NavEKF3, _rngBcnBatch, 0),
+
     AP_GROUPEND
 };
 
@@ -750,7 +765,7 @@ void NavEKF3::UpdateFilter(void)
         } else {
             statePredictEnabled[i] = true;
         }
-        core[i].UpdateFilter(statePredictEnabled[i]);
+        core[i].UpdateFilter(statePredictEnabled[i], getFusionDivider(i));
     }
 
     // If the current core selected has a bad error score or is unhealthy, switch to a healthy core with the lowest fault score
@@ -789,12 +804,33 @@ void NavEKF3::UpdateFilter(void)
             updateLaneSwitchPosResetData(newPrimaryIndex, primary);
             updateLaneSwitchPosDownResetData(newPrimaryIndex, primary);
             primary = newPrimaryIndex;
+            laneSwitchCount++;
         }
     }
 
     check_log_write();
 }
 
+// return the number of prediction cycles between measurement fusion steps for a core
+// the primary always fuses on every cycle. Other cores are decimated unless they
+// could become a lane switch candidate, in which case they are promoted to full rate
+uint8_t NavEKF3::getFusionDivider(uint8_t coreIndex) const
+{
+    if (_laneFusionDivider <= 1 || coreIndex == primary || !runCoreSelection) {
+        return 1;
+    }
+    const float primaryErrorScore = core[primary].errorScore();
+    if (!core[primary].healthy() || primaryErrorScore > 0.5f) {
+        // primary is heading towards the lane switch threshold
+        return 1;
+    }
+    if (!core[coreIndex].healthy() || core[coreIndex].errorScore() < 1.5f * primaryErrorScore) {
+        // core is changing health state or scoring close to the primary
+        return 1;
+    }
+    return (uint8_t)MIN(_laneFusionDivider.get(), 4);
+}
+
 // Check basic filter health metrics and return a consolidated health status
 bool NavEKF3::healthy(void) const
 {
@@ -1234,6 +1270,18 @@ uint32_t NavEKF3::getBodyFrameOdomDebug(int8_t instance, Vector3f &velInnov, Vec
     return ret;
 }
 
+// return the time from reception to fusion of the last body frame odometry measurement fused
+uint32_t NavEKF3::getBodyFrameOdomFusionDelay(int8_t instance) const
+{
+    if (instance < 0 || instance >= num_cores) {
+        instance = primary;
+    }
+    if (!core) {
+        return 0;
+    }
+    return core[instance].getBodyFrameOdomFusionDelay();
+}
+
 // return data for debugging range beacon fusion
 bool NavEKF3::getRangeBeaconDebug(int8_t instance, uint8_t &ID, float &rng, float &innov, float &innovVar, float &testRatio, Vector3f &beaconPosNED,
                                   float &offsetHigh, float &offsetLow, Vector3f &posNED) const
@@ -66,6 +66,9 @@ public:
     // return -1 if no primary core selected
     int8_t getPrimaryCoreIndex(void) const;
 
+    // returns the number of times the primary core has changed since boot
+    uint32_t getLaneSwitchCount(void) const { return laneSwitchCount; }
+
     // returns the index of the IMU of the primary core
     // return -1 if no primary core selected
     int8_t getPrimaryCoreIMUIndex(void) const;
@@ -246,6 +249,11 @@ public:
      */
     uint32_t getBodyFrameOdomDebug(int8_t instance, Vector3f &velInnov, Vector3f &velInnovVar) const;
 
+    // return the time in msec from reception to fusion of the last
+    // body frame odometry measurement fused by the specified instance
+    // An out of range instance (eg -1) returns data for the primary instance
+    uint32_t getBodyFrameOdomFusionDelay(int8_t instance) const;
+
     // return data for debugging optical flow fusion for the specified instance
     // An out of range instance (eg -1) returns data for the primary instance
     void getFlowDebug(int8_t instance, float &varFlow, float &gndOffset, float &flowInnovX, float &flowInnovY, float &auxInnov, float &HAGL, float &rngInnov, float &range, float &gndOffsetErr) const;
@@ -362,6 +370,7 @@ public:
 private:
     uint8_t num_cores; // number of allocated cores
     uint8_t primary;   // current primary core
+    uint32_t laneSwitchCount; // number of primary core changes
     NavEKF3_core *core = nullptr;
     const AP_AHRS *_ahrs;
     const RangeFinder &_rng;
@@ -422,6 +431,8 @@ private:
     AP_Float _visOdmVelErrMin;      // Observation 1-STD velocity error assumed for visual odometry sensor at highest reported quality (m/s)
     AP_Float _wencOdmVelErr;        // Observation 1-STD velocity error assumed for wheel odometry sensor (m/s)
     AP_Int8  _flowUse;              // Controls if the optical flow data is fused into the main navigation estimator and/or the terrain estimator.
+    AP_Int8  _laneFusionDivider;    // Number of prediction cycles between measurement fusion steps on cores that are not the primary
+    AP_Int8  _rngBcnBatch;          // Enables fusion of all new range beacon measurements on each update
 
 // Possible values for _flowUse
 #define FLOW_USE_NONE    0
@@ -495,6 +506,9 @@ private:
 
     bool inhibitGpsVertVelUse;  // true when GPS vertical velocity use is prohibited
 
+    // return the number of prediction cycles between measurement fusion steps for the specified core
+    uint8_t getFusionDivider(uint8_t coreIndex) const;
+
     // update the yaw reset data to capture changes due to a lane switch
     // new_primary - index of the ekf instance that we are about to switch to as the primary
     // old_primary - index of the ekf instance that we are currently using as the primary
@@ -151,31 +151,22 @@ void NavEKF3_core::FuseAirspeed()
             stateStruct.quat.normalize();
 
             // correct the covariance P = (I - K*H)*P
-            // take advantage of the empty columns in KH to reduce the
-            // number of operations
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                for (unsigned j = 0; j<=3; j++) {
-                    KH[i][j] = 0.0f;
-                }
-                for (unsigned j = 4; j<=6; j++) {
-                    KH[i][j] = Kfusion[i] * H_TAS[j];
-                }
-                for (unsigned j = 7; j<=21; j++) {
-                    KH[i][j] = 0.0f;
-                }
-                for (unsigned j = 22; j<=23; j++) {
-                    KH[i][j] = Kfusion[i] * H_TAS[j];
-                }
-            }
+            // KH is the outer product of Kfusion and H_TAS, so form the row
+            // vector H*P once using only the non-zero elements of H_TAS and
+            // take the outer product with unit stride inner loops
+            Vector24 HP;
             for (unsigned j = 0; j<=stateIndexLim; j++) {
-                for (unsigned i = 0; i<=stateIndexLim; i++) {
-                    ftype res = 0;
-                    res += KH[i][4] * P[4][j];
-                    res += KH[i][5] * P[5][j];
-                    res += KH[i][6] * P[6][j];
-                    res += KH[i][22] * P[22][j];
-                    res += KH[i][23] * P[23][j];
-                    KHP[i][j] = res;
+                ftype res = 0;
+                res += H_TAS[4] * P[4][j];
+                res += H_TAS[5] * P[5][j];
+                res += H_TAS[6] * P[6][j];
+                res += H_TAS[22] * P[22][j];
+                res += H_TAS[23] * P[23][j];
+                HP[j] = res;
+            }
+            for (unsigned i = 0; i<=stateIndexLim; i++) {
+                for (unsigned j = 0; j<=stateIndexLim; j++) {
+                    KHP[i][j] = Kfusion[i] * HP[j];
                 }
             }
             for (unsigned i = 0; i<=stateIndexLim; i++) {
@@ -419,32 +410,26 @@ void NavEKF3_core::FuseSideslip()
         stateStruct.quat.normalize();
 
         // correct the covariance P = (I - K*H)*P
-        // take advantage of the empty columns in KH to reduce the
-        // number of operations
-        for (unsigned i = 0; i<=stateIndexLim; i++) {
-            for (unsigned j = 0; j<=6; j++) {
-                KH[i][j] = Kfusion[i] * H_BETA[j];
-            }
-            for (unsigned j = 7; j<=21; j++) {
-                KH[i][j] = 0.0f;
-            }
-            for (unsigned j = 22; j<=23; j++) {
-                KH[i][j] = Kfusion[i] * H_BETA[j];
-            }
-        }
+        // KH is the outer product of Kfusion and H_BETA, so form the row
+        // vector H*P once using only the non-zero elements of H_BETA and
+        // take the outer product with unit stride inner loops
+        Vector24 HP;
         for (unsigned j = 0; j<=stateIndexLim; j++) {
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                ftype res = 0;
-                res += KH[i][0] * P[0][j];
-                res += KH[i][1] * P[1][j];
-                res += KH[i][2] * P[2][j];
-                res += KH[i][3] * P[3][j];
-                res += KH[i][4] * P[4][j];
-                res += KH[i][5] * P[5][j];
-                res += KH[i][6] * P[6][j];
-                res += KH[i][22] * P[22][j];
-                res += KH[i][23] * P[23][j];
-                KHP[i][j] = res;
+            ftype res = 0;
+            res += H_BETA[0] * P[0][j];
+            res += H_BETA[1] * P[1][j];
+            res += H_BETA[2] * P[2][j];
+            res += H_BETA[3] * P[3][j];
+            res += H_BETA[4] * P[4][j];
+            res += H_BETA[5] * P[5][j];
+            res += H_BETA[6] * P[6][j];
+            res += H_BETA[22] * P[22][j];
+            res += H_BETA[23] * P[23][j];
+            HP[j] = res;
+        }
+        for (unsigned i = 0; i<=stateIndexLim; i++) {
+            for (unsigned j = 0; j<=stateIndexLim; j++) {
+                KHP[i][j] = Kfusion[i] * HP[j];
             }
         }
         for (unsigned i = 0; i<=stateIndexLim; i++) {
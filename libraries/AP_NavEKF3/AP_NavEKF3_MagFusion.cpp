@@ -665,36 +665,27 @@ void NavEKF3_core::FuseMagnetometer()
             magFusePerformed = true;
         }
         // correct the covariance P = (I - K*H)*P
-        // take advantage of the empty columns in KH to reduce the
-        // number of operations
-        for (unsigned i = 0; i<=stateIndexLim; i++) {
-            for (unsigned j = 0; j<=3; j++) {
-                KH[i][j] = Kfusion[i] * H_MAG[j];
-            }
-            for (unsigned j = 4; j<=15; j++) {
-                KH[i][j] = 0.0f;
-            }
-            for (unsigned j = 16; j<=21; j++) {
-                KH[i][j] = Kfusion[i] * H_MAG[j];
-            }
-            for (unsigned j = 22; j<=23; j++) {
-                KH[i][j] = 0.0f;
-            }
-        }
+        // KH is the outer product of Kfusion and H_MAG, so form the row
+        // vector H*P once using only the non-zero elements of H_MAG and
+        // take the outer product with unit stride inner loops
+        Vector24 HP;
         for (unsigned j = 0; j<=stateIndexLim; j++) {
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                ftype res = 0;
-                res += KH[i][0] * P[0][j];
-                res += KH[i][1] * P[1][j];
-                res += KH[i][2] * P[2][j];
-                res += KH[i][3] * P[3][j];
-                res += KH[i][16] * P[16][j];
-                res += KH[i][17] * P[17][j];
-                res += KH[i][18] * P[18][j];
-                res += KH[i][19] * P[19][j];
-                res += KH[i][20] * P[20][j];
-                res += KH[i][21] * P[21][j];
-                KHP[i][j] = res;
+            ftype res = 0;
+            res += H_MAG[0] * P[0][j];
+            res += H_MAG[1] * P[1][j];
+            res += H_MAG[2] * P[2][j];
+            res += H_MAG[3] * P[3][j];
+            res += H_MAG[16] * P[16][j];
+            res += H_MAG[17] * P[17][j];
+            res += H_MAG[18] * P[18][j];
+            res += H_MAG[19] * P[19][j];
+            res += H_MAG[20] * P[20][j];
+            res += H_MAG[21] * P[21][j];
+            HP[j] = res;
+        }
+        for (unsigned i = 0; i<=stateIndexLim; i++) {
+            for (unsigned j = 0; j<=stateIndexLim; j++) {
+                KHP[i][j] = Kfusion[i] * HP[j];
             }
         }
         // Check that we are not going to drive any variances negative and skip the update if so
@@ -6,6 +6,7 @@
 #include <AP_Vehicle/AP_Vehicle.h>
 #include <GCS_MAVLink/GCS.h>
 #include <AP_RangeFinder/RangeFinder_Backend.h>
+#include <AP_NavEKF/AP_Nav_DeltaQuat.h>
 
 extern const AP_HAL::HAL& hal;
 
@@ -44,7 +45,14 @@ void NavEKF3_core::readRangeFinder(void)
                 if (rngMeasIndex[sensorIndex] > 2) {
                     rngMeasIndex[sensorIndex] = 0;
                 }
-                storedRngMeasTime_ms[sensorIndex][rngMeasIndex[sensorIndex]] = imuSampleTime_ms - 25;
+                // use the time the reading arrived when the driver knows it,
+                // otherwise assume a typical 25msec sensor delay
+                const uint32_t readingTime_ms = sensor->reading_time_ms();
+                if (readingTime_ms != 0 && (imuSampleTime_ms - readingTime_ms) < 100) {
+                    storedRngMeasTime_ms[sensorIndex][rngMeasIndex[sensorIndex]] = readingTime_ms;
+                } else {
+                    storedRngMeasTime_ms[sensorIndex][rngMeasIndex[sensorIndex]] = imuSampleTime_ms - 25;
+                }
                 storedRngMeas[sensorIndex][rngMeasIndex[sensorIndex]] = sensor->distance_cm() * 0.01f;
             }
 
@@ -121,6 +129,7 @@ void NavEKF3_core::writeBodyFrameOdom(float quality, const Vector3f &delPos, con
     bodyOdmDataNew.body_offset = &posOffset;
     bodyOdmDataNew.vel = delPos * (1.0f/delTime);
     bodyOdmDataNew.time_ms = timeStamp_ms;
+    bodyOdmDataNew.receive_ms = imuSampleTime_ms;
     bodyOdmDataNew.angRate = delAng * (1.0f/delTime);
     bodyOdmMeasTime_ms = timeStamp_ms;
 
@@ -375,7 +384,7 @@ void NavEKF3_core::readIMUData()
 
     // Rotate quaternon atitude from previous to new and normalise.
     // Accumulation using quaternions prevents introduction of coning errors due to downsampling
-    imuQuatDownSampleNew.rotate(imuDataNew.delAng);
+    imuQuatDownSampleNew *= AP_Nav_DeltaQuat::get(imu_index, imuDataNew.delAng);
     imuQuatDownSampleNew.normalize();
 
     // Rotate the latest delta velocity into body frame at the start of accumulation
@@ -741,11 +750,13 @@ void NavEKF3_core::readRngBcnData()
     N_beacons = beacon->count();
 
     // search through all the beacons for new data and if we find it stop searching and push the data into the observation buffer
+    // when fusing in batches, push the new data from all of the beacons
+    const bool batch = frontend->_rngBcnBatch > 0;
     bool newDataToPush = false;
     uint8_t numRngBcnsChecked = 0;
     // start the search one index up from where we left it last time
     uint8_t index = lastRngBcnChecked;
-    while (!newDataToPush && numRngBcnsChecked < N_beacons) {
+    while ((batch || !newDataToPush) && numRngBcnsChecked < N_beacons) {
         // track the number of beacons checked
         numRngBcnsChecked++;
 
@@ -776,7 +787,8 @@ void NavEKF3_core::readRngBcnData()
             // identify the beacon identifier
             rngBcnDataNew.beacon_ID = index;
 
-            // indicate we have new data to push to the buffer
+            // Save data into the buffer to be fused when the fusion time horizon catches up with it
+            storedRangeBeacon.push(rngBcnDataNew);
             newDataToPush = true;
 
             // update the last checked index
@@ -818,20 +830,27 @@ void NavEKF3_core::readRngBcnData()
         rngBcnGoodToAlign = false;
     }
 
-    // Save data into the buffer to be fused when the fusion time horizon catches up with it
-    if (newDataToPush) {
-        storedRangeBeacon.push(rngBcnDataNew);
-    }
-
     // Check the buffer for measurements that have been overtaken by the fusion time horizon and need to be fused
-    rngBcnDataToFuse = storedRangeBeacon.recall(rngBcnDataDelayed, imuDataDelayed.time_ms);
+    rngBcnDataToFuse = recallRngBcnData();
+}
+
+// recall range beacon data at the fusion time horizon, the oldest
+// first when fusing in batches, returning true if there is some
+bool NavEKF3_core::recallRngBcnData()
+{
+    bool ret;
+    if (frontend->_rngBcnBatch > 0) {
+        ret = storedRangeBeacon.recall_oldest(rngBcnDataDelayed, imuDataDelayed.time_ms);
+    } else {
+        ret = storedRangeBeacon.recall(rngBcnDataDelayed, imuDataDelayed.time_ms);
+    }
 
     // Correct the range beacon earth frame origin for estimated offset relative to the EKF earth frame origin
-    if (rngBcnDataToFuse) {
+    if (ret) {
         rngBcnDataDelayed.beacon_posNED.x += bcnPosOffsetNED.x;
         rngBcnDataDelayed.beacon_posNED.y += bcnPosOffsetNED.y;
     }
-
+    return ret;
 }
 
 /*
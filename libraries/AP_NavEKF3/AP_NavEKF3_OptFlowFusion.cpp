@@ -697,27 +697,24 @@ void NavEKF3_core::FuseOptFlow()
                 gcs().send_text(MAV_SEVERITY_INFO, "EKF3 IMU%u fusing optical flow",(unsigned)imu_index);
             }
             // correct the covariance P = (I - K*H)*P
-            // take advantage of the empty columns in KH to reduce the
-            // number of operations
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                for (unsigned j = 0; j<=6; j++) {
-                    KH[i][j] = Kfusion[i] * H_LOS[j];
-                }
-                for (unsigned j = 7; j<=stateIndexLim; j++) {
-                    KH[i][j] = 0.0f;
-                }
-            }
+            // KH is the outer product of Kfusion and H_LOS, so form the row
+            // vector H*P once using only the non-zero elements of H_LOS and
+            // take the outer product with unit stride inner loops
+            Vector24 HP;
             for (unsigned j = 0; j<=stateIndexLim; j++) {
-                for (unsigned i = 0; i<=stateIndexLim; i++) {
-                    ftype res = 0;
-                    res += KH[i][0] * P[0][j];
-                    res += KH[i][1] * P[1][j];
-                    res += KH[i][2] * P[2][j];
-                    res += KH[i][3] * P[3][j];
-                    res += KH[i][4] * P[4][j];
-                    res += KH[i][5] * P[5][j];
-                    res += KH[i][6] * P[6][j];
-                    KHP[i][j] = res;
+                ftype res = 0;
+                res += H_LOS[0] * P[0][j];
+                res += H_LOS[1] * P[1][j];
+                res += H_LOS[2] * P[2][j];
+                res += H_LOS[3] * P[3][j];
+                res += H_LOS[4] * P[4][j];
+                res += H_LOS[5] * P[5][j];
+                res += H_LOS[6] * P[6][j];
+                HP[j] = res;
+            }
+            for (unsigned i = 0; i<=stateIndexLim; i++) {
+                for (unsigned j = 0; j<=stateIndexLim; j++) {
+                    KHP[i][j] = Kfusion[i] * HP[j];
                 }
             }
 
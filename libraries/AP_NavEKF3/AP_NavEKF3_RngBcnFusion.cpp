@@ -19,7 +19,9 @@ void NavEKF3_core::SelectRngBcnFusion()
     readRngBcnData();
 
     // Determine if we need to fuse range beacon data on this time step
-    if (rngBcnDataToFuse) {
+    // When fusing in batches, fuse all of the data that has reached the fusion time horizon
+    bool dataToFuse = rngBcnDataToFuse;
+    while (dataToFuse) {
         if (PV_AidingMode == AID_ABSOLUTE) {
             if (!filterStatus.flags.using_gps && rngBcnAlignmentCompleted) {
                 if (!bcnOriginEstInit) {
@@ -43,6 +45,7 @@ void NavEKF3_core::SelectRngBcnFusion()
             // record that the beacon origin needs to be initialised
             bcnOriginEstInit = false;
         }
+        dataToFuse = (frontend->_rngBcnBatch > 0) && recallRngBcnData();
     }
 }
 
@@ -210,26 +213,20 @@ void NavEKF3_core::FuseRngBcn()
             lastRngBcnPassTime_ms = imuSampleTime_ms;
 
             // correct the covariance P = (I - K*H)*P
-            // take advantage of the empty columns in KH to reduce the
-            // number of operations
-            for (unsigned i = 0; i<=stateIndexLim; i++) {
-                for (unsigned j = 0; j<=6; j++) {
-                    KH[i][j] = 0.0f;
-                }
-                for (unsigned j = 7; j<=9; j++) {
-                    KH[i][j] = Kfusion[i] * H_BCN[j];
-                }
-                for (unsigned j = 10; j<=23; j++) {
-                    KH[i][j] = 0.0f;
-                }
-            }
+            // KH is the outer product of Kfusion and H_BCN, so form the row
+            // vector H*P once using only the non-zero elements of H_BCN and
+            // take the outer product with unit stride inner loops
+            Vector24 HP;
             for (unsigned j = 0; j<=stateIndexLim; j++) {
-                for (unsigned i = 0; i<=stateIndexLim; i++) {
-                    ftype res = 0;
-                    res += KH[i][7] * P[7][j];
-                    res += KH[i][8] * P[8][j];
-                    res += KH[i][9] * P[9][j];
-                    KHP[i][j] = res;
+                ftype res = 0;
+                res += H_BCN[7] * P[7][j];
+                res += H_BCN[8] * P[8][j];
+                res += H_BCN[9] * P[9][j];
+                HP[j] = res;
+            }
+            for (unsigned i = 0; i<=stateIndexLim; i++) {
+                for (unsigned j = 0; j<=stateIndexLim; j++) {
+                    KHP[i][j] = Kfusion[i] * HP[j];
                 }
             }
             // Check that we are not going to drive any variances negative and skip the update if so
@@ -291,6 +288,30 @@ void NavEKF3_core::FuseRngBcnStatic()
     initialise the initial position to the mean beacon position. The initial position uncertainty
     is set to the mean range measurement.
     */
+    const AP_Beacon *beacon = _ahrs->get_beacon();
+    Vector3f multilatPos;
+    float multilatErr;
+    if (!rngBcnAlignmentStarted && frontend->_rngBcnBatch > 0 && beacon != nullptr &&
+        beacon->get_multilat_position(multilatPos, multilatErr)) {
+        // The beacon library has solved for the position from the ranges to all of the beacons at once,
+        // which is a much better first guess than the centre of the beacons, so start from it
+        rngBcnAlignmentStarted = true;
+        rngBcnAlignmentSeeded = true;
+        receiverPos.x = multilatPos.x + bcnPosOffsetNED.x;
+        receiverPos.y = multilatPos.y + bcnPosOffsetNED.y;
+        receiverPos.z = multilatPos.z;
+        memset(&receiverPosCov, 0, sizeof(receiverPosCov));
+        receiverPosCov[2][2] = receiverPosCov[1][1] = receiverPosCov[0][0] = MAX(sq(multilatErr), R_RNG);
+        minBcnPosD = maxBcnPosD = beacon->beacon_position(0).z;
+        for (uint8_t i=1; i<N_beacons; i++) {
+            const float posD = beacon->beacon_position(i).z;
+            minBcnPosD = MIN(minBcnPosD, posD);
+            maxBcnPosD = MAX(maxBcnPosD, posD);
+        }
+        lastBeaconIndex  = 0;
+        numBcnMeas = 0;
+    }
+
     if (!rngBcnAlignmentStarted) {
         if (rngBcnDataDelayed.beacon_ID != lastBeaconIndex) {
             rngBcnPosSum += rngBcnDataDelayed.beacon_posNED;
@@ -320,10 +341,13 @@ void NavEKF3_core::FuseRngBcnStatic()
         }
     }
 
+    // a start from the solved position needs only a few observations of each beacon to check it
+    const uint8_t alignMeas = rngBcnAlignmentSeeded ? MAX(4 * N_beacons, 20) : 100;
+
     if (rngBcnAlignmentStarted) {
         numBcnMeas++;
 
-        if (numBcnMeas >= 100) {
+        if (numBcnMeas >= alignMeas) {
             // 100 observations is enough for a stable estimate under most conditions
             // TODO monitor stability of the position estimate
             rngBcnAlignmentCompleted = true;
@@ -497,7 +521,7 @@ void NavEKF3_core::FuseRngBcnStatic()
 
         }
 
-        if (numBcnMeas >= 100) {
+        if (numBcnMeas >= alignMeas) {
             // 100 observations is enough for a stable estimate under most conditions
             // TODO monitor stability of the position estimate
             rngBcnAlignmentCompleted = true;
@@ -60,6 +60,15 @@
 // mag fusion final reset altitude (using NED frame so altitude is negative)
 #define EKF3_MAG_FINAL_RESET_ALT 2.5f
 
+// store the IMU and output state buffers, which are sized to the
+// longest sensor delay in each core, in a compact encoding. This
+// saves 12 of 36 bytes per IMU element and 8 of 40 per output
+// element, for a small loss of precision, see imu_elements_compact
+// and output_elements_compact
+#ifndef EK3_COMPACT_BUFFERS
+#define EK3_COMPACT_BUFFERS 0
+#endif
+
 class AP_AHRS;
 
 class NavEKF3_core
@@ -77,7 +86,8 @@ public:
 
     // Update Filter States - this should be called whenever new IMU data is available
     // The predict flag is set true when a new prediction cycle can be started
-    void UpdateFilter(bool predict);
+    // The fusionDivider sets how many prediction cycles elapse between measurement fusion steps, 1 fuses on every cycle
+    void UpdateFilter(bool predict, uint8_t fusionDivider);
 
     // Check basic filter health metrics and return a consolidated health status
     bool healthy(void) const;
@@ -240,6 +250,9 @@ public:
      */
     uint32_t getBodyFrameOdomDebug(Vector3f &velInnov, Vector3f &velInnovVar);
 
+    // return the time from reception to fusion of the last body frame odometry measurement fused (msec)
+    uint32_t getBodyFrameOdomFusionDelay(void) const { return bodyOdmFusionDelay_ms; }
+
     /*
         Returns the following data for debugging range beacon fusion
         ID : beacon identifier
@@ -445,6 +458,105 @@ private:
         uint32_t    time_ms;        // measurement timestamp (msec)
     };
 
+#if EK3_COMPACT_BUFFERS
+    /*
+      a vector stored as int16 components sharing a power of two
+      scale, so the precision is 1/32768 of the largest component
+      whatever the magnitude
+     */
+    struct compact_vector3f {
+        int16_t v[3];
+        int8_t exponent;
+
+        void set(const Vector3f &vec) {
+            const float largest = MAX(MAX(fabsf(vec.x), fabsf(vec.y)), fabsf(vec.z));
+            int e = 0;
+            if (largest > 0) {
+                frexpf(largest, &e);
+            }
+            exponent = constrain_int16(e, -127, 127);
+            for (uint8_t i=0; i<3; i++) {
+                v[i] = constrain_int32(lroundf(ldexpf(vec[i], 15 - exponent)), -32767, 32767);
+            }
+        }
+        Vector3f get() const {
+            return Vector3f(ldexpf(v[0], exponent - 15),
+                            ldexpf(v[1], exponent - 15),
+                            ldexpf(v[2], exponent - 15));
+        }
+    };
+
+    // imu_elements with the time intervals in microseconds
+    struct imu_elements_compact {
+        compact_vector3f delAng;
+        compact_vector3f delVel;
+        uint16_t delAngDT_us;
+        uint16_t delVelDT_us;
+        uint32_t time_ms;
+
+        imu_elements_compact() = default;
+        imu_elements_compact(const imu_elements &e) {
+            delAng.set(e.delAng);
+            delVel.set(e.delVel);
+            delAngDT_us = constrain_float(e.delAngDT * 1.0e6f + 0.5f, 0, UINT16_MAX);
+            delVelDT_us = constrain_float(e.delVelDT * 1.0e6f + 0.5f, 0, UINT16_MAX);
+            time_ms = e.time_ms;
+        }
+        operator imu_elements() const {
+            imu_elements e;
+            e.delAng = delAng.get();
+            e.delVel = delVel.get();
+            e.delAngDT = delAngDT_us * 1.0e-6f;
+            e.delVelDT = delVelDT_us * 1.0e-6f;
+            e.time_ms = time_ms;
+            return e;
+        }
+    };
+
+    // a unit quaternion stored as int16 components
+    struct compact_quaternion {
+        int16_t q[4];
+
+        compact_quaternion &operator=(const Quaternion &quat) {
+            for (uint8_t i=0; i<4; i++) {
+                q[i] = constrain_int32(lroundf(quat[i] * 32767), -32767, 32767);
+            }
+            return *this;
+        }
+        operator Quaternion() const {
+            Quaternion quat(q[0], q[1], q[2], q[3]);
+            quat.normalize();
+            return quat;
+        }
+    };
+
+    /*
+      output_elements with a compact quaternion. The velocity and
+      position are kept as floats, as the small corrections
+      calcOutputStates() applies to the whole buffer on each step
+      would be lost to rounding
+     */
+    struct output_elements_compact {
+        compact_quaternion quat;
+        Vector3f velocity;
+        Vector3f position;
+
+        output_elements_compact() = default;
+        output_elements_compact(const output_elements &e) :
+            velocity(e.velocity),
+            position(e.position) {
+            quat = e.quat;
+        }
+        operator output_elements() const {
+            output_elements e;
+            e.quat = quat;
+            e.velocity = velocity;
+            e.position = position;
+            return e;
+        }
+    };
+#endif // EK3_COMPACT_BUFFERS
+
     struct gps_elements {
         Vector2f    pos;            // horizontal North East position of the GPS antenna in local NED earth frame (m)
         float       hgt;            // height of the GPS antenna in local NED earth frame (m)
@@ -496,6 +608,7 @@ private:
         const Vector3f *body_offset;// pointer to XYZ position of the velocity sensor in body frame (m)
         Vector3f        angRate;    // angular rate estimated from odometry (rad/sec)
         uint32_t        time_ms;    // measurement timestamp (msec)
+        uint32_t        receive_ms; // time the measurement was received, in IMU time (msec)
     };
 
     struct wheel_odm_elements {
@@ -633,6 +746,9 @@ private:
     // check for new range beacon data and update stored measurements if available
     void readRngBcnData();
 
+    // recall range beacon data at the fusion time horizon
+    bool recallRngBcnData();
+
     // determine when to perform fusion of GPS position and  velocity measurements
     void SelectVelPosFusion();
 
@@ -818,13 +934,21 @@ private:
     Matrix24 KH;                    // intermediate result used for covariance updates
     Matrix24 KHP;                   // intermediate result used for covariance updates
     Matrix24 P;                     // covariance matrix
+#if EK3_COMPACT_BUFFERS
+    imu_ring_buffer_t<imu_elements_compact> storedIMU;  // IMU data buffer
+#else
     imu_ring_buffer_t<imu_elements> storedIMU;      // IMU data buffer
-    obs_ring_buffer_t<gps_elements> storedGPS;      // GPS data buffer
-    obs_ring_buffer_t<mag_elements> storedMag;      // Magnetometer data buffer
-    obs_ring_buffer_t<baro_elements> storedBaro;    // Baro data buffer
-    obs_ring_buffer_t<tas_elements> storedTAS;      // TAS data buffer
+#endif
+    obs_monotonic_ring_buffer_t<gps_elements> storedGPS;      // GPS data buffer
+    obs_monotonic_ring_buffer_t<mag_elements> storedMag;      // Magnetometer data buffer
+    obs_monotonic_ring_buffer_t<baro_elements> storedBaro;    // Baro data buffer
+    obs_monotonic_ring_buffer_t<tas_elements> storedTAS;      // TAS data buffer
     obs_ring_buffer_t<range_elements> storedRange;  // Range finder data buffer
+#if EK3_COMPACT_BUFFERS
+    imu_ring_buffer_t<output_elements_compact> storedOutput;  // output state buffer
+#else
     imu_ring_buffer_t<output_elements> storedOutput;// output state buffer
+#endif
     Matrix3f prevTnb;               // previous nav to body transformation used for INS earth rotation compensation
     ftype accNavMag;                // magnitude of navigation accel - used to adjust GPS obs variance (m/s^2)
     ftype accNavMagHoriz;           // magnitude of navigation accel in horizontal plane (m/s^2)
@@ -951,6 +1075,7 @@ private:
     bool runUpdates;                // boolean true when the EKF updates can be run
     uint32_t framesSincePredict;    // number of frames lapsed since EKF instance did a state prediction
     bool startPredictEnabled;       // boolean true when the frontend has given permission to start a new state prediciton cycle
+    uint8_t fusionCycleCount;       // number of prediction cycles since measurement fusion was last run when fusion is decimated by the frontend
     uint8_t localFilterTimeStep_ms; // average number of msec between filter updates
     float posDownObsNoise;          // observation noise variance on the vertical position used by the state and covariance update step (m^2)
     Vector3f delAngCorrected;       // corrected IMU delta angle vector at the EKF time horizon (rad)
@@ -1010,7 +1135,7 @@ private:
     float lastInnovation;
 
     // variables added for optical flow fusion
-    obs_ring_buffer_t<of_elements> storedOF;    // OF data buffer
+    obs_monotonic_ring_buffer_t<of_elements> storedOF;    // OF data buffer
     of_elements ofDataNew;          // OF data at the current time horizon
     of_elements ofDataDelayed;      // OF data at the fusion time horizon
     uint8_t ofStoreIndex;           // OF data storage index
@@ -1077,6 +1202,7 @@ private:
     Vector3 innovBodyVel;               // Body velocity XYZ innovations (rad/sec)
     uint32_t prevBodyVelFuseTime_ms;    // previous time all body velocity measurement components passed their innovation consistency checks (msec)
     uint32_t bodyOdmMeasTime_ms;        // time body velocity measurements were accepted for input to the data buffer (msec)
+    uint32_t bodyOdmFusionDelay_ms;     // time from reception to fusion of the last body velocity measurement fused (msec)
     bool bodyVelFusionDelayed;          // true when body frame velocity fusion has been delayed
     bool bodyVelFusionActive;           // true when body frame velocity fusion is active
 
@@ -1110,6 +1236,7 @@ private:
     float receiverPosCov[3][3];         // Receiver position covariance (m^2) - alignment 3 state filter (
     bool rngBcnAlignmentStarted;        // True when the initial position alignment using range measurements has started
     bool rngBcnAlignmentCompleted;      // True when the initial position alignment using range measurements has finished
+    bool rngBcnAlignmentSeeded;         // True when the initial position alignment started from the beacon library's multilateration solution
     uint8_t lastBeaconIndex;            // Range beacon index last read -  used during initialisation of the 3-state filter
     Vector3f rngBcnPosSum;              // Sum of range beacon NED position (m) - used during initialisation of the 3-state filter
     uint8_t numBcnMeas;                 // Number of beacon measurements - used during initialisation of the 3-state filter
@@ -0,0 +1,50 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_NavEKF3/AP_NavEKF3_Buffer.h>
+
+/*
+  compare recall() of the linear-scan and binary-search observation
+  buffers. Samples arrive every 20ms and are recalled 150ms later,
+  which is representative of a GPS buffer with the default lag. The
+  argument is the buffer length
+ */
+
+struct bench_elements {
+    Vector3f data;
+    uint32_t time_ms;
+};
+
+template <typename buffer_type>
+static void run_recall(benchmark::State& state)
+{
+    buffer_type buf;
+    buf.init(state.range(0));
+
+    uint32_t now_ms = 1000;
+    bench_elements e {};
+    while (state.KeepRunning()) {
+        e.time_ms = now_ms;
+        buf.push(e);
+        bench_elements out;
+        bool found = buf.recall(out, now_ms - 150);
+        gbenchmark_escape(&found);
+        gbenchmark_escape(&out);
+        now_ms += 20;
+    }
+}
+
+static void BM_ObsBufferLinearRecall(benchmark::State& state)
+{
+    run_recall<obs_ring_buffer_t<bench_elements>>(state);
+}
+
+static void BM_ObsBufferMonotonicRecall(benchmark::State& state)
+{
+    run_recall<obs_monotonic_ring_buffer_t<bench_elements>>(state);
+}
+
+BENCHMARK(BM_ObsBufferLinearRecall)->Arg(8)->Arg(16)->Arg(32)->Arg(64);
+BENCHMARK(BM_ObsBufferMonotonicRecall)->Arg(8)->Arg(16)->Arg(32)->Arg(64);
+
+BENCHMARK_MAIN()
@@ -364,7 +364,7 @@ void Display::update()
 
     if (AP_Notify::flags.armed) {
         if (_screenpage != 1) {
-            _driver->clear_screen();
+            clear_screen();
             update_arm(3);
             _screenpage = 1;
             _driver->hw_update(); //update hw once , do not transmition to display in fly
@@ -373,7 +373,7 @@ void Display::update()
     }
 
     if (_screenpage != 2) {
-        _driver->clear_screen(); //once clear screen when page changed
+        clear_screen(); //once clear screen when page changed
         _screenpage = 2;
     }
 
@@ -414,6 +414,32 @@ void Display::draw_text(uint16_t x, uint16_t y, const char* c)
     }
 }
 
+/*
+  draw text at the start of row r, unless it is what was drawn there
+  last. Drawing is by far the most expensive part of an update, and the
+  backends only send the pages whose pixels changed
+ */
+void Display::draw_row(uint8_t r, const char *c)
+{
+    if (r >= DISPLAY_TEXT_ROWS) {
+        return;
+    }
+    if ((_rows_valid & (1U << r)) &&
+        strncmp(_row_text[r], c, sizeof(_row_text[r])-1) == 0) {
+        return;
+    }
+    strncpy(_row_text[r], c, sizeof(_row_text[r])-1);
+    _row_text[r][sizeof(_row_text[r])-1] = 0;
+    _rows_valid |= 1U << r;
+    draw_text(COLUMN(0), ROW(r), _row_text[r]);
+}
+
+void Display::clear_screen()
+{
+    _driver->clear_screen();
+    _rows_valid = 0;
+}
+
 void Display::draw_char(uint16_t x, uint16_t y, const char c)
 {
     uint8_t line;
@@ -440,18 +466,18 @@ void Display::draw_char(uint16_t x, uint16_t y, const char c)
 void Display::update_arm(uint8_t r)
 {
     if (AP_Notify::flags.armed) {
-        draw_text(COLUMN(0), ROW(r), ">>>>> ARMED! <<<<<");
+        draw_row(r, ">>>>> ARMED! <<<<<");
     } else {
-        draw_text(COLUMN(0), ROW(r), "     disarmed     ");
+        draw_row(r, "     disarmed     ");
     }
 }
 
 void Display::update_prearm(uint8_t r)
 {
     if (AP_Notify::flags.pre_arm_check) {
-        draw_text(COLUMN(0), ROW(r), "Prearm: passed    ");
+        draw_row(r, "Prearm: passed    ");
     } else {
-        draw_text(COLUMN(0), ROW(r), "Prearm: failed    ");
+        draw_row(r, "Prearm: failed    ");
     }
 }
 
@@ -487,12 +513,13 @@ void Display::update_gps(uint8_t r)
             break;
     }
     snprintf(msg, DISPLAY_MESSAGE_SIZE, "GPS:%-5s Sats:%2u", fixname, (unsigned)AP_Notify::flags.gps_num_sats) ;
-    draw_text(COLUMN(0), ROW(r), msg);
+    draw_row(r, msg);
 }
 
 void Display::update_gps_sats(uint8_t r)
 {
-    draw_text(COLUMN(0), ROW(r), "Sats:");
+    draw_row(r, "Sats:");
+    _rows_valid &= ~(1U << r);
     draw_char(COLUMN(8), ROW(r), (AP_Notify::flags.gps_num_sats / 10) + '0');
     draw_char(COLUMN(9), ROW(r), (AP_Notify::flags.gps_num_sats % 10) + '0');
 }
@@ -500,9 +527,9 @@ void Display::update_gps_sats(uint8_t r)
 void Display::update_ekf(uint8_t r)
 {
     if (AP_Notify::flags.ekf_bad) {
-        draw_text(COLUMN(0), ROW(r), "EKF:    fail");
+        draw_row(r, "EKF:    fail");
     } else {
-        draw_text(COLUMN(0), ROW(r), "EKF:    ok  ");
+        draw_row(r, "EKF:    ok  ");
     }
 }
 
@@ -510,7 +537,7 @@ void Display::update_battery(uint8_t r)
 {
     char msg [DISPLAY_MESSAGE_SIZE];
     snprintf(msg, DISPLAY_MESSAGE_SIZE, "BAT1: %4.2fV", (double)AP::battery().voltage()) ;
-    draw_text(COLUMN(0), ROW(r), msg);
+    draw_row(r, msg);
  }
 
 void Display::update_mode(uint8_t r)
@@ -518,7 +545,7 @@ void Display::update_mode(uint8_t r)
     char msg [DISPLAY_MESSAGE_SIZE];
     if (pNotify->get_flight_mode_str()) {
         snprintf(msg, DISPLAY_MESSAGE_SIZE, "Mode: %s", pNotify->get_flight_mode_str()) ;
-        draw_text(COLUMN(0), ROW(r), msg);
+        draw_row(r, msg);
     }
 }
 
@@ -528,7 +555,7 @@ void Display::update_text_empty(uint8_t r)
     memset(msg, ' ', sizeof(msg)-1);
     _movedelay = 0;
     _mstartpos = 0;
-    draw_text(COLUMN(0), ROW(r), msg);
+    draw_row(r, msg);
 }
 
 void Display::update_text(uint8_t r)
@@ -563,5 +590,5 @@ void Display::update_text(uint8_t r)
         _mstartpos++;
     }
 
-    draw_text(COLUMN(0), ROW(0), msg);
+    draw_row(r, msg);
  }
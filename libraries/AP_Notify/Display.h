@@ -6,6 +6,7 @@
 #define COLUMN(X) ((X *  7) + 0)
 
 #define DISPLAY_MESSAGE_SIZE 19
+#define DISPLAY_TEXT_ROWS 6
 
 class Display_Backend;
 
@@ -19,6 +20,8 @@ public:
 private:
     void draw_char(uint16_t x, uint16_t y, const char c);
     void draw_text(uint16_t x, uint16_t y, const char *c);
+    void draw_row(uint8_t r, const char *c);
+    void clear_screen();
     void update_all();
     void update_arm(uint8_t r);
     void update_prearm(uint8_t r);
@@ -36,6 +39,11 @@ private:
     uint8_t _movedelay; // ticker delay before shifting after new message displayed
     uint8_t _screenpage;
 
+    // text last drawn in each row, valid where the bit for the row is
+    // set in _rows_valid, so unchanged rows aren't drawn again
+    char _row_text[DISPLAY_TEXT_ROWS][DISPLAY_MESSAGE_SIZE];
+    uint8_t _rows_valid;
+
     // stop showing text in display after this many millis:
     const uint16_t _send_text_valid_millis = 20000;
 };
@@ -18,6 +18,7 @@
 
 #include <AP_HAL/AP_HAL.h>
 #include <AP_HAL/I2CDevice.h>
+#include <AP_Common/Semaphore.h>
 
 // constructor
 Display_SH1106_I2C::Display_SH1106_I2C(AP_HAL::OwnPtr<AP_HAL::Device> dev) :
@@ -79,7 +80,7 @@ bool Display_SH1106_I2C::hw_init()
     _dev->get_semaphore()->give();
 
     if (success) {
-        _need_hw_update = true;
+        _pages_to_send = 0xFF;
         _dev->register_periodic_callback(20000, FUNCTOR_BIND_MEMBER(&Display_SH1106_I2C::_timer, void));
     }
 
@@ -88,15 +89,22 @@ bool Display_SH1106_I2C::hw_init()
 
 void Display_SH1106_I2C::hw_update()
 {
-    _need_hw_update = true;
+    WITH_SEMAPHORE(_sem);
+    _pages_to_send |= _dirty_pages;
+    _dirty_pages = 0;
 }
 
 void Display_SH1106_I2C::_timer()
 {
-    if (!_need_hw_update) {
+    uint8_t pages;
+    {
+        WITH_SEMAPHORE(_sem);
+        pages = _pages_to_send;
+        _pages_to_send = 0;
+    }
+    if (pages == 0) {
         return;
     }
-    _need_hw_update = false;
 
     struct PACKED {
         uint8_t reg;
@@ -110,8 +118,11 @@ void Display_SH1106_I2C::_timer()
         uint8_t db[SH1106_COLUMNS/2];
     } display_buffer = { 0x40, {} };
 
-    // write buffer to display
+    // write the changed pages to the display
     for (uint8_t i = 0; i < (SH1106_ROWS / SH1106_ROWS_PER_PAGE); i++) {
+        if (!(pages & (1U << i))) {
+            continue;
+        }
         command.page = 0xB0 | (i & 0x0F);
         _dev->transfer((uint8_t *)&command, sizeof(command), nullptr, 0);
 
@@ -129,7 +140,12 @@ void Display_SH1106_I2C::set_pixel(uint16_t x, uint16_t y)
         return;
     }
     // set pixel in buffer
-    _displaybuffer[x + (y / 8 * SH1106_COLUMNS)] |= 1 << (y % 8);
+    uint8_t &b = _displaybuffer[x + (y / 8 * SH1106_COLUMNS)];
+    const uint8_t v = b | (1 << (y % 8));
+    if (v != b) {
+        b = v;
+        _dirty_pages |= 1U << (y / 8);
+    }
 }
 
 void Display_SH1106_I2C::clear_pixel(uint16_t x, uint16_t y)
@@ -139,10 +155,16 @@ void Display_SH1106_I2C::clear_pixel(uint16_t x, uint16_t y)
         return;
     }
     // clear pixel in buffer
-    _displaybuffer[x + (y / 8 * SH1106_COLUMNS)] &= ~(1 << (y % 8));
+    uint8_t &b = _displaybuffer[x + (y / 8 * SH1106_COLUMNS)];
+    const uint8_t v = b & ~(1 << (y % 8));
+    if (v != b) {
+        b = v;
+        _dirty_pages |= 1U << (y / 8);
+    }
 }
 
 void Display_SH1106_I2C::clear_screen()
 {
     memset(_displaybuffer, 0, SH1106_COLUMNS * SH1106_ROWS_PER_PAGE);
+    _dirty_pages = 0xFF;
 }
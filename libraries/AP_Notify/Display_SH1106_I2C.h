@@ -3,6 +3,7 @@
 #include "Display.h"
 #include "Display_Backend.h"
 #include <AP_HAL/I2CDevice.h>
+#include <AP_HAL/AP_HAL.h>
 
 #define SH1106_COLUMNS 132		// display columns
 #define SH1106_ROWS 64		    // display rows
@@ -32,6 +33,13 @@ private:
 
     AP_HAL::OwnPtr<AP_HAL::Device> _dev;
     uint8_t _displaybuffer[SH1106_COLUMNS * SH1106_ROWS_PER_PAGE];
-    bool _need_hw_update;
+
+    // bitmask of pages changed in _displaybuffer since the last
+    // hw_update(), only used by the main thread
+    uint8_t _dirty_pages;
+
+    // bitmask of pages for _timer() to send, protected by _sem
+    uint8_t _pages_to_send;
+    HAL_Semaphore _sem;
 
 };
@@ -3,6 +3,7 @@
 #include "Display.h"
 #include "Display_Backend.h"
 #include <AP_HAL/I2CDevice.h>
+#include <AP_HAL/AP_HAL.h>
 
 #define SSD1306_COLUMNS 128		// display columns
 #define SSD1306_ROWS 64		    // display rows
@@ -32,5 +33,12 @@ private:
 
     AP_HAL::OwnPtr<AP_HAL::Device> _dev;
     uint8_t _displaybuffer[SSD1306_COLUMNS * SSD1306_ROWS_PER_PAGE];
-    bool _need_hw_update;
+
+    // bitmask of pages changed in _displaybuffer since the last
+    // hw_update(), only used by the main thread
+    uint8_t _dirty_pages;
+
+    // bitmask of pages for _timer() to send, protected by _sem
+    uint8_t _pages_to_send;
+    HAL_Semaphore _sem;
 };
@@ -156,24 +156,28 @@ bool AP_OSD_MAX7456::init()
 
 bool AP_OSD_MAX7456::update_font()
 {
-    uint32_t font_size;
     uint8_t updated_chars = 0;
     char fontname[] = "font0.bin";
     last_font = get_font_num();
     fontname[4] = last_font + '0';
-    uint8_t *font_data = AP_ROMFS::find_decompress(fontname, font_size);
-    if (font_data == nullptr || font_size != NVM_RAM_SIZE * 256) {
+
+    // the font is read one character at a time rather than
+    // decompressing all 13k of it
+    AP_ROMFS::Reader font;
+    if (!font.open(fontname) || font.size() != NVM_RAM_SIZE * 256) {
         return false;
     }
 
+    uint8_t chr_font_data[NVM_RAM_SIZE];
     for (uint16_t chr=0; chr < 256; chr++) {
-        const uint8_t* chr_font_data = font_data + chr*NVM_RAM_SIZE;
+        if (font.read(chr_font_data, NVM_RAM_SIZE) != NVM_RAM_SIZE) {
+            return false;
+        }
         //check if char already up to date
         if (!check_font_char(chr, chr_font_data)) {
             //update char inside max7456 NVM
             if (!update_font_char(chr, chr_font_data)) {
                 hal.console->printf("AP_OSD: error during font char update\n");
-                free(font_data);
                 return false;
             }
             updated_chars++;
@@ -183,7 +187,6 @@ bool AP_OSD_MAX7456::update_font()
         hal.console->printf("AP_OSD: updated %d symbols.\n", updated_chars);
     }
     hal.console->printf("AP_OSD: osd font is up to date.\n");
-    free(font_data);
     return true;
 }
 
@@ -377,56 +380,75 @@ void AP_OSD_MAX7456::flush()
     transfer_frame();
 }
 
+/*
+  send the characters that differ from what is on the chip. Runs of
+  changed characters are sent in auto-increment mode, which costs 10
+  bytes to enter and leave, so gaps of a few unchanged characters are
+  sent as part of the run rather than starting a new one
+ */
 void AP_OSD_MAX7456::transfer_frame()
 {
-    uint16_t previous_pos = UINT16_MAX - 1;
-    bool autoincrement = false;
     if (!initialized) {
         return;
     }
 
+    // display memory is row after row, as is frame
+    const uint16_t num_cells = video_lines * video_columns;
+    const uint8_t *chars = &frame[0][0];
+    uint8_t *shadow = &shadow_frame[0][0];
+
+    if (memcmp(chars, shadow, num_cells) == 0) {
+        return;
+    }
+
+    // the longest unchanged gap cheaper to send than a new run
+    const uint8_t max_gap = 4;
+
     buffer_offset = 0;
-    for (uint8_t y=0; y<video_lines; y++) {
-        for (uint8_t x=0; x<video_columns; x++) {
-            if (!is_dirty(x, y)) {
-                continue;
-            }
-            //ensure space for 1 char and escape sequence
-            if (buffer_offset >= spi_buffer_size - 32) {
-                break;
-            }
-            shadow_frame[y][x] = frame[y][x];
-            uint8_t chr = frame[y][x];
-            uint16_t pos = y * video_columns + x;
-            bool position_changed = ((previous_pos + 1) != pos);
-
-            if (position_changed && autoincrement) {
-                //it is impossible to write to MAX7456ADD_DMAH/MAX7456ADD_DMAL in autoincrement mode
-                //so, exit autoincrement mode
-                buffer_add_cmd(MAX7456ADD_DMDI, 0xFF);
-                buffer_add_cmd(MAX7456ADD_DMM, 0);
-                autoincrement = false;
-            }
+    uint16_t pos = 0;
+    while (pos < num_cells) {
+        if (chars[pos] == shadow[pos]) {
+            pos++;
+            continue;
+        }
 
-            if (!autoincrement) {
-                buffer_add_cmd(MAX7456ADD_DMAH, pos >> 8);
-                buffer_add_cmd(MAX7456ADD_DMAL, pos & 0xFF);
+        // find the end of the run. 0xFF ends auto-increment mode, so
+        // those characters can only be written on their own
+        uint16_t end = pos + 1;
+        if (chars[pos] != 0xFF) {
+            for (uint16_t i = end; i < num_cells && i - end <= max_gap && chars[i] != 0xFF; i++) {
+                if (chars[i] != shadow[i]) {
+                    end = i + 1;
+                }
             }
+        }
+        uint16_t len = end - pos;
 
-            if (!autoincrement && is_dirty(x+1, y)) {
-                //(re)enter autoincrement mode
-                buffer_add_cmd(MAX7456ADD_DMM, DMM_AUTOINCREMENT);
-                autoincrement = true;
-            }
+        // address, then either one character or entering, the
+        // characters, and leaving auto-increment mode
+        const int space = spi_buffer_size - buffer_offset - 4;
+        if (space < 2) {
+            // the rest goes in the next frame
+            break;
+        }
+        if (len > 1 && space < 2 * len + 6) {
+            len = MAX((space - 6) / 2, 1);
+        }
 
-            buffer_add_cmd(MAX7456ADD_DMDI, chr);
-            previous_pos = pos;
+        buffer_add_cmd(MAX7456ADD_DMAH, pos >> 8);
+        buffer_add_cmd(MAX7456ADD_DMAL, pos & 0xFF);
+        if (len == 1) {
+            buffer_add_cmd(MAX7456ADD_DMDI, chars[pos]);
+        } else {
+            buffer_add_cmd(MAX7456ADD_DMM, DMM_AUTOINCREMENT);
+            for (uint16_t i = pos; i < pos + len; i++) {
+                buffer_add_cmd(MAX7456ADD_DMDI, chars[i]);
+            }
+            buffer_add_cmd(MAX7456ADD_DMDI, 0xFF);
+            buffer_add_cmd(MAX7456ADD_DMM, 0);
         }
-    }
-    if (autoincrement) {
-        buffer_add_cmd(MAX7456ADD_DMDI, 0xFF);
-        buffer_add_cmd(MAX7456ADD_DMM, 0);
-        autoincrement = false;
+        memcpy(&shadow[pos], &chars[pos], len);
+        pos += len;
     }
 
     if (buffer_offset > 0) {
@@ -436,14 +458,6 @@ void AP_OSD_MAX7456::transfer_frame()
     }
 }
 
-bool AP_OSD_MAX7456::is_dirty(uint8_t x, uint8_t y)
-{
-    if (y>=video_lines || x>=video_columns) {
-        return false;
-    }
-    return frame[y][x] != shadow_frame[y][x];
-}
-
 void AP_OSD_MAX7456::clear()
 {
     AP_OSD_Backend::clear();
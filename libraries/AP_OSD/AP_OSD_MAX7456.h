@@ -55,8 +55,6 @@ private:
 
     void transfer_frame();
 
-    bool is_dirty(uint8_t x, uint8_t y);
-
     AP_HAL::OwnPtr<AP_HAL::Device> _dev;
 
     uint8_t  video_signal_reg;
@@ -24,9 +24,11 @@
 #include "AP_Param.h"
 
 #include <cmath>
+#include <ctype.h>
 #include <string.h>
 
 #include <AP_Common/AP_Common.h>
+#include <AP_Common/Semaphore.h>
 #include <AP_HAL/AP_HAL.h>
 #include <AP_Math/AP_Math.h>
 #include <GCS_MAVLink/GCS.h>
@@ -62,6 +64,7 @@ uint16_t AP_Param::_num_vars;
 
 // cached parameter count
 uint16_t AP_Param::_parameter_count;
+uint16_t AP_Param::_change_count;
 
 // storage and naming information about all types that can be saved
 const AP_Param::Info *AP_Param::_var_info;
@@ -101,6 +104,27 @@ void AP_Param::eeprom_write_check(const void *ptr, uint16_t ofs, uint8_t size)
 
 bool AP_Param::_hide_disabled_groups = true;
 
+#if AP_PARAM_NAME_INDEX_ENABLED
+struct AP_Param::name_index_entry *AP_Param::_name_index;
+uint16_t AP_Param::_name_index_count;
+bool AP_Param::_name_index_stale = true;
+HAL_Semaphore AP_Param::_name_index_sem;
+#endif
+
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+struct AP_Param::storage_index_entry *AP_Param::_storage_index;
+uint16_t *AP_Param::_storage_index_start;
+uint16_t AP_Param::_storage_index_space;
+uint16_t AP_Param::_storage_index_sentinal;
+uint32_t AP_Param::_storage_index_generation;
+bool AP_Param::_storage_index_valid;
+HAL_Semaphore AP_Param::_storage_index_sem;
+uint32_t AP_Param::_storage_generation;
+
+// spare entries in the storage index for parameters saved after boot
+#define STORAGE_INDEX_SPARE 32
+#endif
+
 // write a sentinal value at the given offset
 void AP_Param::write_sentinal(uint16_t ofs)
 {
@@ -126,6 +150,11 @@ void AP_Param::erase_all(void)
 
     // add a sentinal directly after the header
     write_sentinal(sizeof(struct EEPROM_header));
+
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+    WITH_SEMAPHORE(_storage_index_sem);
+    _storage_generation++;
+#endif
 }
 
 /* the 'group_id' of a element of a group is the 18 bit identifier
@@ -673,6 +702,12 @@ bool AP_Param::is_sentinal(const Param_header &phdr)
 // if the sentinal isn't found either, the offset is set to 0xFFFF
 bool AP_Param::scan(const AP_Param::Param_header *target, uint16_t *pofs)
 {
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+    bool found;
+    if (scan_storage_index(target, pofs, found)) {
+        return found;
+    }
+#endif
     struct Param_header phdr;
     uint16_t ofs = sizeof(AP_Param::EEPROM_header);
     while (ofs < _storage.size()) {
@@ -696,6 +731,136 @@ bool AP_Param::scan(const AP_Param::Param_header *target, uint16_t *pofs)
     return false;
 }
 
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+/*
+  build the storage index, called with _storage_index_sem held. The
+  index isn't used if there isn't the memory for it or storage has no
+  sentinal
+ */
+void AP_Param::build_storage_index(void)
+{
+    _storage_index_valid = false;
+    _storage_index_generation = _storage_generation;
+
+    if (_storage_index_start == nullptr) {
+        _storage_index_start = (uint16_t *)calloc(_sentinal_key+1, sizeof(uint16_t));
+        if (_storage_index_start == nullptr) {
+            return;
+        }
+    }
+    uint16_t *start = _storage_index_start;
+    memset(start, 0, (_sentinal_key+1)*sizeof(uint16_t));
+
+    // count the headers with each key, one place along
+    struct Param_header phdr;
+    uint16_t count = 0;
+    uint16_t ofs = sizeof(AP_Param::EEPROM_header);
+    while (true) {
+        if (ofs >= _storage.size()) {
+            // leave it to the walk to report the missing sentinal
+            return;
+        }
+        _storage.read_block(&phdr, ofs, sizeof(phdr));
+        if (is_sentinal(phdr)) {
+            break;
+        }
+        start[get_key(phdr)+1]++;
+        count++;
+        ofs += type_size((enum ap_var_type)phdr.type) + sizeof(phdr);
+    }
+    const uint16_t sentinal = ofs;
+
+    free(_storage_index);
+    _storage_index_space = count + STORAGE_INDEX_SPARE;
+    _storage_index = (struct storage_index_entry *)calloc(_storage_index_space, sizeof(struct storage_index_entry));
+    if (_storage_index == nullptr) {
+        _storage_index_space = 0;
+        return;
+    }
+
+    // start[k] is now the first entry for key k
+    for (uint16_t k=1; k<=_sentinal_key; k++) {
+        start[k] += start[k-1];
+    }
+
+    // fill in storage order, which leaves start[k] at the first entry
+    // for key k+1, then move it back
+    for (ofs = sizeof(AP_Param::EEPROM_header); ofs < sentinal; ) {
+        _storage.read_block(&phdr, ofs, sizeof(phdr));
+        struct storage_index_entry &e = _storage_index[start[get_key(phdr)]++];
+        e.phdr = phdr;
+        e.ofs = ofs;
+        ofs += type_size((enum ap_var_type)phdr.type) + sizeof(phdr);
+    }
+    memmove(&start[1], &start[0], _sentinal_key*sizeof(uint16_t));
+    start[0] = 0;
+
+    _storage_index_sentinal = sentinal;
+    _storage_index_valid = true;
+}
+
+/*
+  scan for a header using the storage index, building it if
+  needed. Returns false if the index can't be used, otherwise sets
+  found and *pofs as scan() would
+ */
+bool AP_Param::scan_storage_index(const struct Param_header *target, uint16_t *pofs, bool &found)
+{
+    WITH_SEMAPHORE(_storage_index_sem);
+
+    if (!_storage_index_valid || _storage_index_generation != _storage_generation) {
+        build_storage_index();
+        if (!_storage_index_valid) {
+            return false;
+        }
+    }
+
+    const uint16_t key = get_key(*target);
+    if (key >= _sentinal_key) {
+        return false;
+    }
+    for (uint16_t i=_storage_index_start[key]; i<_storage_index_start[key+1]; i++) {
+        const struct storage_index_entry &e = _storage_index[i];
+        if (e.phdr.type == target->type &&
+            e.phdr.group_element == target->group_element) {
+            *pofs = e.ofs;
+            found = true;
+            return true;
+        }
+    }
+    *pofs = _storage_index_sentinal;
+    found = false;
+    return true;
+}
+
+/*
+  note a header just written at the old sentinal, called with
+  _storage_index_sem held
+ */
+void AP_Param::storage_index_add(const struct Param_header &phdr, uint16_t ofs)
+{
+    const uint16_t key = get_key(phdr);
+    uint16_t *start = _storage_index_start;
+    if (!_storage_index_valid ||
+        _storage_index_generation != _storage_generation ||
+        ofs != _storage_index_sentinal ||
+        start[_sentinal_key] >= _storage_index_space) {
+        // rebuild on the next scan
+        _storage_generation++;
+        return;
+    }
+    // it is the last in storage order, so goes at the end of its key
+    const uint16_t i = start[key+1];
+    memmove(&_storage_index[i+1], &_storage_index[i], (start[_sentinal_key]-i)*sizeof(struct storage_index_entry));
+    _storage_index[i].phdr = phdr;
+    _storage_index[i].ofs = ofs;
+    for (uint16_t k=key+1; k<=_sentinal_key; k++) {
+        start[k]++;
+    }
+    _storage_index_sentinal = ofs + sizeof(phdr) + type_size((enum ap_var_type)phdr.type);
+}
+#endif // AP_PARAM_STORAGE_INDEX_ENABLED
+
 /**
  * add a _X, _Y, _Z suffix to the name of a Vector3f element
  * @param buffer
@@ -822,10 +987,162 @@ AP_Param::find_group(const char *name, uint16_t vindex, ptrdiff_t group_offset,
 }
 
 
+#if AP_PARAM_NAME_INDEX_ENABLED
+/*
+  FNV-1a hash of a name, ignoring case
+ */
+uint16_t AP_Param::name_hash(const char *name)
+{
+    uint32_t h = 2166136261U;
+    for (; *name; name++) {
+        h ^= (uint8_t)toupper(*name);
+        h *= 16777619U;
+    }
+    return (h >> 16) ^ (h & 0xFFFF);
+}
+
+/*
+  build the name index, called with _name_index_sem held. If there
+  isn't the memory for it lookups fall back to walking the tree
+ */
+void AP_Param::build_name_index(void)
+{
+    free(_name_index);
+    _name_index = nullptr;
+    _name_index_count = 0;
+    _name_index_stale = false;
+
+    // an entry per object for find_object(), then one per variable
+    uint16_t count = _num_vars;
+    ParamToken token;
+    enum ap_var_type type;
+    for (AP_Param *ap = first(&token, &type); ap != nullptr; ap = next(&token, &type)) {
+        count++;
+    }
+    struct name_index_entry *index = (struct name_index_entry *)calloc(count, sizeof(struct name_index_entry));
+    if (index == nullptr) {
+        return;
+    }
+
+    uint16_t n = 0;
+    for (uint16_t i=0; i<_num_vars; i++) {
+        index[n].hash = name_hash(_var_info[i].name);
+        index[n].key = i;
+        index[n].type = _var_info[i].type;
+        n++;
+    }
+    for (AP_Param *ap = first(&token, &type);
+         ap != nullptr && n < count;
+         ap = next(&token, &type)) {
+        if (type == AP_PARAM_GROUP) {
+            continue;
+        }
+        // the first element of a Vector3f is at the same address as
+        // the vector, so needs its _X suffix asked for
+        const bool force_scalar = (type == AP_PARAM_FLOAT && token.idx == 1);
+        char name[AP_MAX_NAME_SIZE+1];
+        ap->copy_name_token(token, name, sizeof(name), force_scalar);
+        name[AP_MAX_NAME_SIZE] = 0;
+        if (name[0] == 0) {
+            continue;
+        }
+        index[n].ptr = ap;
+        index[n].hash = name_hash(name);
+        index[n].key = token.key;
+        index[n].type = type;
+        index[n].force_scalar = force_scalar;
+        n++;
+    }
+
+    // insertion sort keeps entries with the same hash in walk
+    // order, so a lookup finds the same variable as find_by_walk()
+    for (uint16_t i=1; i<n; i++) {
+        const struct name_index_entry e = index[i];
+        uint16_t j = i;
+        for (; j > 0 && index[j-1].hash > e.hash; j--) {
+            index[j] = index[j-1];
+        }
+        index[j] = e;
+    }
+
+    _name_index = index;
+    _name_index_count = n;
+}
+
+/*
+  look for a name in the index, building it if needed. Returns
+  nullptr if the name is not in the index
+ */
+AP_Param *AP_Param::find_in_name_index(const char *name, bool object, enum ap_var_type *ptype)
+{
+    WITH_SEMAPHORE(_name_index_sem);
+
+    if (_name_index_stale) {
+        build_name_index();
+    }
+
+    // find the first entry with this hash
+    const uint16_t hash = name_hash(name);
+    uint16_t lo = 0;
+    uint16_t hi = _name_index_count;
+    while (lo < hi) {
+        const uint16_t mid = (lo + hi) / 2;
+        if (_name_index[mid].hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    for (uint16_t i=lo; i<_name_index_count && _name_index[i].hash == hash; i++) {
+        const struct name_index_entry &e = _name_index[i];
+        if (object) {
+            if (e.ptr != nullptr || strcasecmp(name, _var_info[e.key].name) != 0) {
+                continue;
+            }
+            ptrdiff_t base;
+            if (!get_base(_var_info[e.key], base)) {
+                return nullptr;
+            }
+            return (AP_Param *)base;
+        }
+        if (e.ptr == nullptr) {
+            continue;
+        }
+        // check the variable still has this name, in case an object
+        // it is in has moved
+        ParamToken token {};
+        token.key = e.key;
+        char ename[AP_MAX_NAME_SIZE+1];
+        e.ptr->copy_name_token(token, ename, sizeof(ename), e.force_scalar);
+        ename[AP_MAX_NAME_SIZE] = 0;
+        if (strcmp(name, ename) == 0) {
+            *ptype = (enum ap_var_type)e.type;
+            return e.ptr;
+        }
+    }
+    return nullptr;
+}
+#endif // AP_PARAM_NAME_INDEX_ENABLED
+
 // Find a variable by name.
 //
 AP_Param *
 AP_Param::find(const char *name, enum ap_var_type *ptype)
+{
+#if AP_PARAM_NAME_INDEX_ENABLED
+    AP_Param *ap = find_in_name_index(name, false, ptype);
+    if (ap != nullptr) {
+        return ap;
+    }
+#endif
+    return find_by_walk(name, ptype);
+}
+
+// Find a variable by name, walking the var_info tree
+//
+AP_Param *
+AP_Param::find_by_walk(const char *name, enum ap_var_type *ptype)
 {
     for (uint16_t i=0; i<_num_vars; i++) {
         uint8_t type = _var_info[i].type;
@@ -944,6 +1261,18 @@ bool AP_Param::find_key_by_pointer(const void *ptr, uint16_t &key)
 //
 AP_Param *
 AP_Param::find_object(const char *name)
+{
+#if AP_PARAM_NAME_INDEX_ENABLED
+    AP_Param *ap = find_in_name_index(name, true, nullptr);
+    if (ap != nullptr) {
+        return ap;
+    }
+#endif
+    return find_object_by_walk(name);
+}
+
+AP_Param *
+AP_Param::find_object_by_walk(const char *name)
 {
     for (uint16_t i=0; i<_num_vars; i++) {
         if (strcasecmp(name, _var_info[i].name) == 0) {
@@ -959,6 +1288,8 @@ AP_Param::find_object(const char *name)
 
 // notify GCS of current value of parameter
 void AP_Param::notify() const {
+    count_change();
+
     uint32_t group_element = 0;
     const struct GroupInfo *ginfo;
     struct GroupNesting group_nesting {};
@@ -1070,10 +1401,20 @@ void AP_Param::save_sync(bool force_save)
         return;
     }
 
-    // write a new sentinal, then the data, then the header
-    write_sentinal(ofs + sizeof(phdr) + type_size((enum ap_var_type)phdr.type));
-    eeprom_write_check(ap, ofs+sizeof(phdr), type_size((enum ap_var_type)phdr.type));
-    eeprom_write_check(&phdr, ofs, sizeof(phdr));
+    {
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+        // hold the index while the headers change, so it isn't built
+        // from half an append
+        WITH_SEMAPHORE(_storage_index_sem);
+#endif
+        // write a new sentinal, then the data, then the header
+        write_sentinal(ofs + sizeof(phdr) + type_size((enum ap_var_type)phdr.type));
+        eeprom_write_check(ap, ofs+sizeof(phdr), type_size((enum ap_var_type)phdr.type));
+        eeprom_write_check(&phdr, ofs, sizeof(phdr));
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+        storage_index_add(phdr, ofs);
+#endif
+    }
 
     send_parameter(name, (enum ap_var_type)phdr.type, idx);
 }
@@ -1083,6 +1424,8 @@ void AP_Param::save_sync(bool force_save)
 */
 void AP_Param::save(bool force_save)
 {
+    count_change();
+
     struct param_save p;
     p.param = this;
     p.force_save = force_save;
@@ -1241,6 +1584,8 @@ bool AP_Param::configured_in_defaults_file(void) const
 // set a AP_Param variable to a specified value
 void AP_Param::set_value(enum ap_var_type type, void *ptr, float value)
 {
+    count_change();
+
     switch (type) {
     case AP_PARAM_INT8:
         ((AP_Int8 *)ptr)->set(value);
@@ -1332,14 +1677,30 @@ bool AP_Param::load_all()
         hal.scheduler->register_io_process(FUNCTOR_BIND((&save_dummy), &AP_Param::save_io_handler, void));
     }
     
+    const uint32_t start_us = AP_HAL::micros();
+    uint16_t count = 0;
     while (ofs < _storage.size()) {
         _storage.read_block(&phdr, ofs, sizeof(phdr));
         // note that this is an || not an && for robustness
         // against power off while adding a variable
         if (is_sentinal(phdr)) {
             // we've reached the sentinal
+            const uint32_t load_us = AP_HAL::micros() - start_us;
+            count_change();
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+            // index storage now, rather than on the first scan(), so
+            // the conversions and load() calls that follow are fast
+            WITH_SEMAPHORE(_storage_index_sem);
+            build_storage_index();
+            hal.console->printf("Loaded %u params in %uus, indexed in %uus\n",
+                                (unsigned)count, (unsigned)load_us,
+                                (unsigned)(AP_HAL::micros() - start_us - load_us));
+#else
+            hal.console->printf("Loaded %u params in %uus\n", (unsigned)count, (unsigned)load_us);
+#endif
             return true;
         }
+        count++;
 
         const struct AP_Param::Info *info;
         void *ptr;
@@ -1397,6 +1758,12 @@ void AP_Param::load_object_from_eeprom(const void *object_pointer, const struct
 
     // reset cached param counter as we may be loading a dynamic var_info
     _parameter_count = 0;
+#if AP_PARAM_NAME_INDEX_ENABLED
+    {
+        WITH_SEMAPHORE(_name_index_sem);
+        _name_index_stale = true;
+    }
+#endif
     
     if (!find_key_by_pointer(object_pointer, key)) {
         hal.console->printf("ERROR: Unable to find param pointer\n");
@@ -1787,6 +2154,8 @@ void AP_Param::set_float(float value, enum ap_var_type var_type)
         return;
     }
 
+    count_change();
+
     // add a small amount before casting parameter values
     // from float to integer to avoid truncating to the
     // next lower integer value.
@@ -42,6 +42,23 @@
 #define AP_PARAM_MAX_EMBEDDED_PARAM 8192
 #endif
 
+/*
+  index parameter names for find() and find_object(). This costs
+  about 8 bytes of RAM per parameter
+ */
+#ifndef AP_PARAM_NAME_INDEX_ENABLED
+#define AP_PARAM_NAME_INDEX_ENABLED !HAL_MINIMIZE_FEATURES
+#endif
+
+/*
+  index the offsets of the parameters in storage by key, so looking
+  for a saved value doesn't scan the whole of storage. This costs 6
+  bytes of RAM per saved parameter plus 1k
+ */
+#ifndef AP_PARAM_STORAGE_INDEX_ENABLED
+#define AP_PARAM_STORAGE_INDEX_ENABLED !HAL_MINIMIZE_FEATURES
+#endif
+
 /*
   flags for variables in var_info and group tables
  */
@@ -429,6 +446,14 @@ public:
     // count of parameters in tree
     static uint16_t count_parameters(void);
 
+    // count of parameter changes made through the GCS, set_by_name(),
+    // loads, notify() and saves. Code which derives values from its
+    // parameters can keep the count they were derived at and only
+    // recompute them when it differs. Changes made with set() are not
+    // counted, as the caller knows what it changed
+    static uint16_t get_change_count(void) { return _change_count; }
+    static void count_change(void) { _change_count++; }
+
     static void set_hide_disabled_groups(bool value) { _hide_disabled_groups = value; }
 
     // set frame type flags. Used to unhide frame specific parameters
@@ -558,6 +583,8 @@ private:
                                     char *buffer,
                                     size_t buffer_size,
                                     uint8_t idx) const;
+    static AP_Param *           find_by_walk(const char *name, enum ap_var_type *ptype);
+    static AP_Param *           find_object_by_walk(const char *name);
     static AP_Param *           find_group(
                                     const char *name,
                                     uint16_t vindex,
@@ -612,6 +639,7 @@ private:
     static StorageAccess        _storage;
     static uint16_t             _num_vars;
     static uint16_t             _parameter_count;
+    static uint16_t             _change_count;
     static const struct Info *  _var_info;
 
     /*
@@ -640,6 +668,59 @@ private:
     static ObjectBuffer<struct param_save> save_queue;
     static bool registered_save_handler;
 
+#if AP_PARAM_NAME_INDEX_ENABLED
+    /*
+      index of all parameter names, sorted by a hash of the name, so
+      that find() and find_object() don't have to walk the var_info
+      tree with string compares. It is built on first use and rebuilt
+      after a dynamic object is loaded. A name not in the index is
+      still looked for with a walk, so the index only needs to hold
+      the common case
+     */
+    struct PACKED name_index_entry {
+        AP_Param *ptr;          // nullptr for a find_object() entry
+        uint16_t hash;
+        uint16_t key:9;         // index in _var_info
+        uint16_t type:3;
+        uint16_t force_scalar:1; // first element of a Vector3f
+    };
+    static struct name_index_entry *_name_index;
+    static uint16_t _name_index_count;
+    static bool _name_index_stale;
+    static HAL_Semaphore _name_index_sem;
+
+    static uint16_t name_hash(const char *name);
+    static void build_name_index(void);
+    static AP_Param *find_in_name_index(const char *name, bool object, enum ap_var_type *ptype);
+#endif
+
+#if AP_PARAM_STORAGE_INDEX_ENABLED
+    /*
+      index of the headers in storage, bucketed by key and in storage
+      order within a key, so scan() only looks at the headers with the
+      key it wants. It is built by load_all(). A header added by
+      save_sync() goes into the spare entries; anything else that
+      changes the headers in storage bumps _storage_generation, and the
+      index is rebuilt on the next scan()
+     */
+    struct PACKED storage_index_entry {
+        struct Param_header phdr;
+        uint16_t ofs;
+    };
+    static struct storage_index_entry *_storage_index;
+    static uint16_t *_storage_index_start; // first entry for each key, and one past the end
+    static uint16_t _storage_index_space;    // entries allocated
+    static uint16_t _storage_index_sentinal;
+    static uint32_t _storage_index_generation;
+    static bool _storage_index_valid;
+    static HAL_Semaphore _storage_index_sem;
+    static uint32_t _storage_generation;
+
+    static void build_storage_index(void);
+    static bool scan_storage_index(const struct Param_header *target, uint16_t *pofs, bool &found);
+    static void storage_index_add(const struct Param_header &phdr, uint16_t ofs);
+#endif
+
     // background function for saving parameters
     void save_io_handler(void);
 };
@@ -675,6 +756,7 @@ public:
     void set_default(const T &v) {
         if (!configured()) {
             set(v);
+            count_change();
         }
     }
 
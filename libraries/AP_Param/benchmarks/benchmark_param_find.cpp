@@ -0,0 +1,88 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Param/AP_Param.h>
+
+#include <stdio.h>
+
+const AP_HAL::HAL &hal = AP_HAL::get_HAL();
+
+/*
+  cost of AP_Param::find() with a table of about the size of
+  Copter's: 32 groups, each of 31 floats and a vector, giving 1122
+  parameters. The argument is the group looked in; groups later in
+  var_info take longer to find with a walk of the tree.
+  BM_ParamFindMissing looks for a name that isn't in the index, so
+  pays for the index lookup and then the walk. Build with
+  AP_PARAM_NAME_INDEX_ENABLED=0 to compare with the walk alone
+ */
+
+#define NUM_GROUPS 32
+
+class ParamGroup {
+public:
+    static const struct AP_Param::GroupInfo var_info[];
+    AP_Float p[31];
+    AP_Vector3f v;
+};
+
+#define P(i) AP_GROUPINFO("P" #i, i, ParamGroup, p[i], 0)
+const struct AP_Param::GroupInfo ParamGroup::var_info[] = {
+    P(0),  P(1),  P(2),  P(3),  P(4),  P(5),  P(6),  P(7),
+    P(8),  P(9),  P(10), P(11), P(12), P(13), P(14), P(15),
+    P(16), P(17), P(18), P(19), P(20), P(21), P(22), P(23),
+    P(24), P(25), P(26), P(27), P(28), P(29), P(30),
+    AP_GROUPINFO("V", 31, ParamGroup, v, 0),
+    AP_GROUPEND
+};
+
+static AP_Int16 format_version;
+static ParamGroup groups[NUM_GROUPS];
+
+#define G(i) { AP_PARAM_GROUP, "G" #i "_", i+1, &groups[i], { group_info : ParamGroup::var_info } }
+static const AP_Param::Info var_info[] = {
+    { AP_PARAM_INT16, "FORMAT_VERSION", 0, &format_version, { def_value : 0 } },
+    G(0),  G(1),  G(2),  G(3),  G(4),  G(5),  G(6),  G(7),
+    G(8),  G(9),  G(10), G(11), G(12), G(13), G(14), G(15),
+    G(16), G(17), G(18), G(19), G(20), G(21), G(22), G(23),
+    G(24), G(25), G(26), G(27), G(28), G(29), G(30), G(31),
+    AP_VAREND
+};
+
+static AP_Param param_loader(var_info);
+
+static void BM_ParamFind(benchmark::State& state)
+{
+    char name[AP_MAX_NAME_SIZE+1];
+    snprintf(name, sizeof(name), "G%u_P30", (unsigned)state.range(0));
+    enum ap_var_type type;
+    while (state.KeepRunning()) {
+        AP_Param *ap = AP_Param::find(name, &type);
+        gbenchmark_escape(&ap);
+    }
+}
+
+static void BM_ParamFindMissing(benchmark::State& state)
+{
+    enum ap_var_type type;
+    while (state.KeepRunning()) {
+        AP_Param *ap = AP_Param::find("G31_P31", &type);
+        gbenchmark_escape(&ap);
+    }
+}
+
+static void BM_ParamFindObject(benchmark::State& state)
+{
+    char name[AP_MAX_NAME_SIZE+1];
+    snprintf(name, sizeof(name), "G%u_", (unsigned)state.range(0));
+    while (state.KeepRunning()) {
+        AP_Param *ap = AP_Param::find_object(name);
+        gbenchmark_escape(&ap);
+    }
+}
+
+BENCHMARK(BM_ParamFind)->Arg(0)->Arg(NUM_GROUPS/2)->Arg(NUM_GROUPS-1);
+BENCHMARK(BM_ParamFindMissing);
+BENCHMARK(BM_ParamFindObject)->Arg(0)->Arg(NUM_GROUPS-1);
+
+BENCHMARK_MAIN()
@@ -0,0 +1,110 @@
+#include <AP_gtest.h>
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Param/AP_Param.h>
+
+const AP_HAL::HAL &hal = AP_HAL::get_HAL();
+
+/*
+  a table shaped like a vehicle's: a format version, then groups of
+  floats and a vector
+ */
+class ParamGroup {
+public:
+    static const struct AP_Param::GroupInfo var_info[];
+    AP_Float p[8];
+    AP_Vector3f v;
+};
+
+#define P(i) AP_GROUPINFO("P" #i, i, ParamGroup, p[i], 0)
+const struct AP_Param::GroupInfo ParamGroup::var_info[] = {
+    P(0), P(1), P(2), P(3), P(4), P(5), P(6), P(7),
+    AP_GROUPINFO("V", 8, ParamGroup, v, 0),
+    AP_GROUPEND
+};
+
+static AP_Int16 format_version;
+static AP_Float top_level;
+static ParamGroup groups[4];
+
+#define G(i) { AP_PARAM_GROUP, "G" #i "_", i+2, &groups[i], { group_info : ParamGroup::var_info } }
+static const AP_Param::Info var_info[] = {
+    { AP_PARAM_INT16, "FORMAT_VERSION", 0, &format_version, { def_value : 0 } },
+    // shares a prefix with a group, like CAM_P_G
+    { AP_PARAM_FLOAT, "G1_TOP", 1, &top_level, { def_value : 0 } },
+    G(0), G(1), G(2), G(3),
+    AP_VAREND
+};
+
+static AP_Param param_loader(var_info);
+
+TEST(AP_Param, FindEveryName)
+{
+    AP_Param::ParamToken token;
+    enum ap_var_type type;
+    uint16_t count = 0;
+    for (AP_Param *ap = AP_Param::first(&token, &type); ap; ap = AP_Param::next(&token, &type)) {
+        const bool force_scalar = (type == AP_PARAM_FLOAT && token.idx == 1);
+        char name[AP_MAX_NAME_SIZE+1];
+        ap->copy_name_token(token, name, sizeof(name), force_scalar);
+        enum ap_var_type found_type;
+        EXPECT_EQ(ap, AP_Param::find(name, &found_type)) << name;
+        EXPECT_EQ(type, found_type) << name;
+        count++;
+    }
+    // two scalars, then per group 8 floats and a vector of 3
+    EXPECT_EQ(2U + 4*(8+1+3), count);
+}
+
+TEST(AP_Param, FindSpecialCases)
+{
+    enum ap_var_type type;
+    EXPECT_EQ(&groups[2].v, AP_Param::find("G2_V", &type));
+    EXPECT_EQ(AP_PARAM_VECTOR3F, type);
+    EXPECT_EQ((AP_Param *)&groups[2].v.get().y, AP_Param::find("G2_V_Y", &type));
+    EXPECT_EQ(AP_PARAM_FLOAT, type);
+    EXPECT_EQ(&top_level, AP_Param::find("G1_TOP", &type));
+    EXPECT_EQ(&groups[1].p[7], AP_Param::find("G1_P7", &type));
+
+    // leaf names are not case sensitive; these are found by the walk
+    EXPECT_EQ(&groups[3].p[5], AP_Param::find("G3_p5", &type));
+
+    EXPECT_EQ(nullptr, AP_Param::find("G3_P8", &type));
+    EXPECT_EQ(nullptr, AP_Param::find("G4_P0", &type));
+    EXPECT_EQ(nullptr, AP_Param::find("", &type));
+}
+
+TEST(AP_Param, FindObject)
+{
+    EXPECT_EQ((AP_Param *)&groups[2], AP_Param::find_object("G2_"));
+    EXPECT_EQ((AP_Param *)&groups[2], AP_Param::find_object("g2_"));
+    EXPECT_EQ(&format_version, AP_Param::find_object("FORMAT_VERSION"));
+    EXPECT_EQ(nullptr, AP_Param::find_object("G2_P0"));
+}
+
+TEST(AP_Param, SetByName)
+{
+    EXPECT_TRUE(AP_Param::set_by_name("G0_P3", 2.5f));
+    EXPECT_FLOAT_EQ(2.5f, groups[0].p[3].get());
+    EXPECT_TRUE(AP_Param::set_by_name("G3_V_Z", -1));
+    EXPECT_FLOAT_EQ(-1, groups[3].v.get().z);
+    EXPECT_FALSE(AP_Param::set_by_name("G0_P9", 1));
+}
+
+TEST(AP_Param, ChangeCount)
+{
+    uint16_t count = AP_Param::get_change_count();
+    EXPECT_TRUE(AP_Param::set_by_name("G1_P0", 3));
+    EXPECT_NE(count, AP_Param::get_change_count());
+
+    count = AP_Param::get_change_count();
+    groups[1].p[1].set_float(4, AP_PARAM_FLOAT);
+    EXPECT_NE(count, AP_Param::get_change_count());
+
+    // changes made with set() are left to the caller
+    count = AP_Param::get_change_count();
+    groups[1].p[2].set(5);
+    EXPECT_EQ(count, AP_Param::get_change_count());
+}
+
+AP_GTEST_MAIN()
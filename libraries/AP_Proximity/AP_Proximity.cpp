@@ -220,6 +220,8 @@ void AP_Proximity::update(void)
                 continue;
             }
             drivers[i]->update();
+            drivers[i]->update_obstacle_map();
+            drivers[i]->update_scan();
         }
     }
 
@@ -378,6 +380,26 @@ const Vector2f* AP_Proximity::get_boundary_points(uint16_t& num_points) const
     return get_boundary_points(primary_instance, num_points);
 }
 
+// get the map of obstacles around the vehicle from the primary sensor for use by avoidance
+//   returns nullptr if there is no map, e.g. because the vehicle position is unknown
+const AP_Proximity_ObstacleMap *AP_Proximity::get_obstacle_map() const
+{
+    if ((drivers[primary_instance] == nullptr) || (_type[primary_instance] == Proximity_Type_None)) {
+        return nullptr;
+    }
+    return drivers[primary_instance]->get_obstacle_map();
+}
+
+// get the scan of distances around the vehicle from the primary sensor for use by avoidance
+//   returns nullptr if the sensor doesn't keep one
+const AP_Proximity_Scan *AP_Proximity::get_scan() const
+{
+    if ((drivers[primary_instance] == nullptr) || (_type[primary_instance] == Proximity_Type_None)) {
+        return nullptr;
+    }
+    return drivers[primary_instance]->get_scan();
+}
+
 // get distance and angle to closest object (used for pre-arm check)
 //   returns true on success, false if no valid readings
 bool AP_Proximity::get_closest_object(float& angle_deg, float &distance) const
@@ -28,6 +28,8 @@
 #define PROXIMITY_SENSOR_ID_START 10
 
 class AP_Proximity_Backend;
+class AP_Proximity_ObstacleMap;
+class AP_Proximity_Scan;
 
 class AP_Proximity
 {
@@ -100,6 +102,14 @@ public:
     const Vector2f* get_boundary_points(uint8_t instance, uint16_t& num_points) const;
     const Vector2f* get_boundary_points(uint16_t& num_points) const;
 
+    // get the map of obstacles around the vehicle from the primary sensor for use by avoidance
+    //   returns nullptr if there is no map, e.g. because the vehicle position is unknown
+    const AP_Proximity_ObstacleMap *get_obstacle_map() const;
+
+    // get the scan of distances around the vehicle from the primary sensor for use by avoidance
+    //   returns nullptr if the sensor doesn't keep one
+    const AP_Proximity_Scan *get_scan() const;
+
     // get distance and angle to closest object (used for pre-arm check)
     //   returns true on success, false if no valid readings
     bool get_closest_object(float& angle_deg, float &distance) const;
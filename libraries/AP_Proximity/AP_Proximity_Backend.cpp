@@ -15,6 +15,7 @@
 
 #include <AP_Common/AP_Common.h>
 #include <AP_HAL/AP_HAL.h>
+#include <AP_AHRS/AP_AHRS.h>
 #include "AP_Proximity.h"
 #include "AP_Proximity_Backend.h"
 
@@ -226,6 +227,67 @@ void AP_Proximity_Backend::update_boundary_for_sector(uint8_t sector)
     if (!_distance_valid[prev_sector_ccw]) {
         _boundary_point[prev_sector_ccw] = _sector_edge_vector[prev_sector_ccw] * shortest_distance;
     }
+
+    // add the reading to the obstacle map
+    Vector2f position;
+    if (AP::ahrs().get_relative_position_NE_origin(position)) {
+        _obstacle_map.add_reading(position, degrees(AP::ahrs().yaw), _angle[sector], _distance[sector], _distance_valid[sector], AP_HAL::millis());
+    }
+}
+
+// update the obstacle map for the vehicle's current position
+void AP_Proximity_Backend::update_obstacle_map()
+{
+    Vector2f position;
+    if (!AP::ahrs().get_relative_position_NE_origin(position)) {
+        // obstacles can't be kept in earth-frame
+        _obstacle_map.clear();
+        return;
+    }
+    _obstacle_map.update(position, AP_HAL::millis());
+}
+
+// get the map of obstacles around the vehicle, or nullptr if the vehicle position is unknown
+const AP_Proximity_ObstacleMap *AP_Proximity_Backend::get_obstacle_map() const
+{
+    if (state.status != AP_Proximity::Proximity_Good || !_obstacle_map.valid()) {
+        return nullptr;
+    }
+    return &_obstacle_map;
+}
+
+// keep a scan of the distances around the vehicle
+void AP_Proximity_Backend::init_scan()
+{
+    if (_scan == nullptr) {
+        // the backend carries on with just its sectors if there is no memory for it
+        _scan = new AP_Proximity_Scan();
+    }
+}
+
+// add a reading to the scan, if there is one
+void AP_Proximity_Backend::add_scan_reading(float angle_deg, float width_deg, float distance, bool valid)
+{
+    if (_scan != nullptr) {
+        _scan->add_reading(angle_deg, width_deg, distance, valid, AP_HAL::millis());
+    }
+}
+
+// forget old readings in the scan
+void AP_Proximity_Backend::update_scan()
+{
+    if (_scan != nullptr) {
+        _scan->update(AP_HAL::millis());
+    }
+}
+
+// get the scan of distances around the vehicle, or nullptr if the sensor doesn't keep one or is unhealthy
+const AP_Proximity_Scan *AP_Proximity_Backend::get_scan() const
+{
+    if (state.status != AP_Proximity::Proximity_Good) {
+        return nullptr;
+    }
+    return _scan;
 }
 
 // set status and update valid count
@@ -17,6 +17,8 @@
 #include <AP_Common/AP_Common.h>
 #include <AP_HAL/AP_HAL.h>
 #include "AP_Proximity.h"
+#include "AP_Proximity_ObstacleMap.h"
+#include "AP_Proximity_Scan.h"
 
 #define PROXIMITY_SECTORS_MAX   12  // maximum number of sectors
 #define PROXIMITY_BOUNDARY_DIST_MIN 0.6f    // minimum distance for a boundary point.  This ensures the object avoidance code doesn't think we are outside the boundary.
@@ -30,7 +32,7 @@ public:
 
     // we declare a virtual destructor so that Proximity drivers can
     // override with a custom destructor if need be
-    virtual ~AP_Proximity_Backend(void) {}
+    virtual ~AP_Proximity_Backend(void) { delete _scan; }
 
     // update the state structure
     virtual void update() = 0;
@@ -64,11 +66,30 @@ public:
     // get distances in 8 directions. used for sending distances to ground station
     bool get_horizontal_distances(AP_Proximity::Proximity_Distance_Array &prx_dist_array) const;
 
+    // update the obstacle map for the vehicle's current position, called by the frontend after update()
+    void update_obstacle_map();
+
+    // get the map of obstacles around the vehicle, or nullptr if the vehicle position is unknown
+    const AP_Proximity_ObstacleMap *get_obstacle_map() const;
+
+    // forget old readings in the scan, called by the frontend after update()
+    void update_scan();
+
+    // get the scan of distances around the vehicle, or nullptr if the sensor doesn't keep one or is unhealthy
+    const AP_Proximity_Scan *get_scan() const;
+
 protected:
 
     // set status and update valid_count
     void set_status(AP_Proximity::Proximity_Status status);
 
+    // keep a scan of the distances around the vehicle at a higher
+    //   resolution than the sectors, for sensors which measure many directions
+    void init_scan();
+
+    // add a reading to the scan, if there is one. angle_deg and width_deg are as add_reading() takes them
+    void add_scan_reading(float angle_deg, float width_deg, float distance, bool valid);
+
     // find which sector a given angle falls into
     bool convert_angle_to_sector(float angle_degrees, uint8_t &sector) const;
 
@@ -102,4 +123,10 @@ protected:
     // fence boundary
     Vector2f _sector_edge_vector[PROXIMITY_SECTORS_MAX];    // vector for right-edge of each sector, used to speed up calculation of boundary
     Vector2f _boundary_point[PROXIMITY_SECTORS_MAX];        // bounding polygon around the vehicle calculated conservatively for object avoidance
+
+    // obstacles in earth-frame, which persist when sectors go invalid or out of view
+    AP_Proximity_ObstacleMap _obstacle_map;
+
+    // distances at the scan's resolution, nullptr unless init_scan() was called
+    AP_Proximity_Scan *_scan = nullptr;
 };
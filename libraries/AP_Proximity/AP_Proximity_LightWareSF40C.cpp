@@ -35,6 +35,8 @@ AP_Proximity_LightWareSF40C::AP_Proximity_LightWareSF40C(AP_Proximity &_frontend
     if (uart != nullptr) {
         uart->begin(serial_manager.find_baudrate(AP_SerialManager::SerialProtocol_Lidar360, 0));
     }
+    // keep each of the readings of the scan, not just the closest in each sector
+    init_scan();
 }
 
 // detect if a Lightware proximity sensor is connected by looking for a configured serial port
@@ -314,9 +316,9 @@ bool AP_Proximity_LightWareSF40C::check_for_reply()
     //        distance data appears after a <space>
     //    distance data is comma separated so we put into separate elements (i.e. <space>angle,distance)
     uint16_t count = 0;
-    int16_t nbytes = uart->available();
-    while (nbytes-- > 0) {
-        char c = uart->read();
+    uint32_t nbytes = uart->available();
+    while (reader.fill(uart, nbytes)) {
+        char c = reader.byte();
         // check for end of packet
         if (c == '\r' || c == '\n') {
             if ((element_len[0] > 0)) {
@@ -410,6 +412,7 @@ bool AP_Proximity_LightWareSF40C::process_reply()
         {
             float angle_deg = (float)atof(element_buf[0]);
             float distance_m = (float)atof(element_buf[1]);
+            add_scan_reading(angle_deg, 0, distance_m, is_positive(distance_m));
             uint8_t sector;
             if (convert_angle_to_sector(angle_deg, sector)) {
                 _angle[sector] = angle_deg;
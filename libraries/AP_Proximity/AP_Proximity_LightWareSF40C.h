@@ -2,6 +2,7 @@
 
 #include "AP_Proximity.h"
 #include "AP_Proximity_Backend.h"
+#include <AP_HAL/utility/UARTReader.h>
 
 #define PROXIMITY_SF40C_TIMEOUT_MS            200                               // requests timeout after 0.2 seconds
 
@@ -52,6 +53,7 @@ private:
 
     // reply related variables
     AP_HAL::UARTDriver *uart = nullptr;
+    UARTReader reader;
     char element_buf[2][10];
     uint8_t element_len[2];
     uint8_t element_num;
@@ -32,6 +32,8 @@ AP_Proximity_MAV::AP_Proximity_MAV(AP_Proximity &_frontend,
                                    AP_Proximity::Proximity_State &_state) :
     AP_Proximity_Backend(_frontend, _state)
 {
+    // keep the detail of OBSTACLE_DISTANCE messages
+    init_scan();
 }
 
 // update the state of the sensor
@@ -73,6 +75,7 @@ void AP_Proximity_MAV::handle_msg(mavlink_message_t *msg)
             _distance_valid[sector] = (_distance[sector] >= _distance_min) && (_distance[sector] <= _distance_max);
             _last_update_ms = AP_HAL::millis();
             update_boundary_for_sector(sector);
+            add_scan_reading(_angle[sector], _sector_width_deg[sector], _distance[sector], _distance_valid[sector]);
         }
 
         // store upward distance
@@ -125,6 +128,12 @@ void AP_Proximity_MAV::handle_msg(mavlink_message_t *msg)
             const float packet_distance_m = packet.distances[j] * 0.01f;
             const float mid_angle = wrap_360(j * increment * dir_correction + yaw_correction);
 
+            // keep each distance in the scan, unless the sensor doesn't know it
+            if (packet.distances[j] != UINT16_MAX) {
+                add_scan_reading(mid_angle, increment, packet_distance_m,
+                                 (packet_distance_m >= _distance_min) && (packet_distance_m <= _distance_max));
+            }
+
             // iterate over proximity sectors
             for (uint8_t i = 0; i < _num_sectors; i++) {
                 float angle_diff = fabsf(wrap_180(_sector_middle_deg[i] - mid_angle));
@@ -0,0 +1,110 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_Proximity_ObstacleMap.h"
+
+// get the heading bin of a vector from the vehicle
+uint8_t AP_Proximity_ObstacleMap::heading_to_bin(const Vector2f &ne)
+{
+    const float heading_deg = wrap_360(degrees(atan2f(ne.y, ne.x)));
+    return MIN(uint8_t(heading_deg * (PROXIMITY_MAP_BINS / 360.0f)), PROXIMITY_MAP_BINS-1);
+}
+
+// remove the obstacles in a heading bin from position
+void AP_Proximity_ObstacleMap::clear_bin(const Vector2f &position, uint8_t bin)
+{
+    for (uint8_t i=0; i<PROXIMITY_MAP_BINS; i++) {
+        if (_obstacle[i].last_seen_ms != 0 &&
+            heading_to_bin(_obstacle[i].position - position) == bin) {
+            _obstacle[i].last_seen_ms = 0;
+        }
+    }
+}
+
+void AP_Proximity_ObstacleMap::add_reading(const Vector2f &position, float yaw_deg, float angle_deg, float distance, bool valid, uint32_t now_ms)
+{
+    const float heading_rad = radians(yaw_deg + angle_deg);
+    const Vector2f direction(cosf(heading_rad), sinf(heading_rad));
+    const uint8_t bin = heading_to_bin(direction);
+    clear_bin(position, bin);
+    if (!valid) {
+        return;
+    }
+
+    // store in a free entry, or replace the oldest
+    uint8_t oldest = 0;
+    for (uint8_t i=0; i<PROXIMITY_MAP_BINS; i++) {
+        if (_obstacle[i].last_seen_ms == 0) {
+            oldest = i;
+            break;
+        }
+        if (now_ms - _obstacle[i].last_seen_ms > now_ms - _obstacle[oldest].last_seen_ms) {
+            oldest = i;
+        }
+    }
+    _obstacle[oldest].position = position + direction * distance;
+    // zero marks a free entry
+    _obstacle[oldest].last_seen_ms = MAX(now_ms, 1U);
+}
+
+void AP_Proximity_ObstacleMap::update(const Vector2f &position, uint32_t now_ms)
+{
+    for (uint8_t bin=0; bin<PROXIMITY_MAP_BINS; bin++) {
+        _clearance[bin] = -1.0f;
+    }
+    for (uint8_t i=0; i<PROXIMITY_MAP_BINS; i++) {
+        Obstacle &obstacle = _obstacle[i];
+        if (obstacle.last_seen_ms == 0) {
+            continue;
+        }
+        if (now_ms - obstacle.last_seen_ms > PROXIMITY_MAP_TIMEOUT_MS) {
+            obstacle.last_seen_ms = 0;
+            continue;
+        }
+        const Vector2f ne = obstacle.position - position;
+        const uint8_t bin = heading_to_bin(ne);
+        const float distance = ne.length();
+        if (_clearance[bin] < 0 || distance < _clearance[bin]) {
+            _clearance[bin] = distance;
+        }
+    }
+    _updated = true;
+}
+
+void AP_Proximity_ObstacleMap::clear()
+{
+    memset(_obstacle, 0, sizeof(_obstacle));
+    _updated = false;
+}
+
+bool AP_Proximity_ObstacleMap::get_clearance(uint8_t bin, float &distance) const
+{
+    if (!_updated || bin >= PROXIMITY_MAP_BINS || _clearance[bin] < 0) {
+        return false;
+    }
+    distance = _clearance[bin];
+    return true;
+}
+
+uint8_t AP_Proximity_ObstacleMap::get_obstacles(Vector2f *positions, uint8_t max_obstacles) const
+{
+    uint8_t count = 0;
+    for (uint8_t i=0; i<PROXIMITY_MAP_BINS && count<max_obstacles; i++) {
+        if (_obstacle[i].last_seen_ms != 0) {
+            positions[count++] = _obstacle[i].position;
+        }
+    }
+    return count;
+}
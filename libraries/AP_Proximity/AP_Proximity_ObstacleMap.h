@@ -0,0 +1,81 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <AP_Common/AP_Common.h>
+#include <AP_Math/AP_Math.h>
+
+#define PROXIMITY_MAP_BINS          36      // number of earth-frame heading bins, 10 degrees each
+#define PROXIMITY_MAP_TIMEOUT_MS    2000    // obstacles which are not seen again for this long are forgotten
+
+/*
+  rolling map of the obstacles around the vehicle for avoidance.
+
+  Each reading is stored as an obstacle position in earth-frame
+  (meters NE from the EKF origin), so obstacles stay put as the
+  vehicle moves and yaws, and persist for a while after they leave the
+  sensor's field of view. update() recomputes the clearance to the
+  nearest obstacle in each earth-frame heading bin once per loop, so
+  get_clearance() is a single array lookup.
+
+  A reading replaces any obstacle in its heading bin, as the sensor has
+  seen either through or up to it. A reading which finds nothing clears
+  its bin.
+ */
+class AP_Proximity_ObstacleMap
+{
+public:
+    // add a reading. position is the vehicle's in meters NE from the EKF
+    // origin and yaw_deg its heading. angle_deg is the body-frame angle
+    // of the reading, 0 forward and clockwise. valid is false if nothing
+    // was found within the sensor's range
+    void add_reading(const Vector2f &position, float yaw_deg, float angle_deg, float distance, bool valid, uint32_t now_ms);
+
+    // forget old obstacles and recompute the clearance in each heading
+    // bin from the vehicle's position
+    void update(const Vector2f &position, uint32_t now_ms);
+
+    // forget all obstacles, e.g. when the vehicle position is unknown
+    void clear();
+
+    // true once update() has been called since the last clear()
+    bool valid() const { return _updated; }
+
+    // get the distance in meters to the nearest obstacle in an earth-frame
+    // heading bin. Returns false if no obstacle is known in it
+    bool get_clearance(uint8_t bin, float &distance) const;
+
+    // copy the positions of up to max_obstacles obstacles, in meters NE
+    // from the EKF origin, returning how many were copied
+    uint8_t get_obstacles(Vector2f *positions, uint8_t max_obstacles) const;
+
+    // get the earth-frame heading in degrees of the middle of a bin
+    static float bin_heading_deg(uint8_t bin) { return (bin + 0.5f) * (360.0f / PROXIMITY_MAP_BINS); }
+
+private:
+    // get the heading bin of a vector from the vehicle
+    static uint8_t heading_to_bin(const Vector2f &ne);
+
+    // remove the obstacles in a heading bin from position
+    void clear_bin(const Vector2f &position, uint8_t bin);
+
+    struct Obstacle {
+        Vector2f position;      // meters NE from the EKF origin
+        uint32_t last_seen_ms;  // zero if the entry is free
+    } _obstacle[PROXIMITY_MAP_BINS];
+
+    float _clearance[PROXIMITY_MAP_BINS];   // distance to the nearest obstacle in each bin, negative if there is none
+    bool _updated;                          // true once update() has computed _clearance
+};
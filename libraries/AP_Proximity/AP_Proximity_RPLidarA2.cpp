@@ -78,6 +78,8 @@ AP_Proximity_RPLidarA2::AP_Proximity_RPLidarA2(AP_Proximity &_frontend,
     if (_uart != nullptr) {
         _uart->begin(serial_manager.find_baudrate(AP_SerialManager::SerialProtocol_Lidar360, 0));
     }
+    // keep each of the readings of the scan, not just the closest in each sector
+    init_scan();
     _cnt = 0 ;
     _sync_error = 0 ;
     _byte_count = 0;
@@ -250,9 +252,9 @@ void AP_Proximity_RPLidarA2::get_readings()
     Debug(2, "             CURRENT STATE: %d ", _rp_state);
     uint32_t nbytes = _uart->available();
 
-    while (nbytes-- > 0) {
+    while (reader.fill(_uart, nbytes)) {
 
-        uint8_t c = _uart->read();
+        uint8_t c = reader.byte();
         Debug(2, "UART READ %x <%c>", c, c); //show HEX values
 
         STATE:
@@ -325,6 +327,13 @@ void AP_Proximity_RPLidarA2::get_readings()
                 Debug(3, "READ PAYLOAD");
                 payload[_byte_count] = c;
                 _byte_count++;
+                {
+                    // the rest of the measurement is usually in the block already
+                    const uint16_t n = MIN(reader.remaining(), uint16_t(_payload_length - _byte_count));
+                    memcpy(&payload[_byte_count], reader.ptr(), n);
+                    reader.skip(n);
+                    _byte_count += n;
+                }
 
                 if (_byte_count == _payload_length) {
                     Debug(2, "LIDAR MEASUREMENT CATCHED");
@@ -401,6 +410,7 @@ void AP_Proximity_RPLidarA2::parse_response_data()
                 Debug(2, "                                       D%02.2f A%03.1f Q%02d", distance_m, angle_deg, quality);
 #endif
                 _last_distance_received_ms = AP_HAL::millis();
+                add_scan_reading(angle_deg, 0, distance_m, distance_m > distance_min());
                 uint8_t sector;
                 if (convert_angle_to_sector(angle_deg, sector)) {
                     if (distance_m > distance_min()) {
@@ -32,6 +32,7 @@
 #include "AP_Proximity.h"
 #include "AP_Proximity_Backend.h"
 #include <AP_HAL/AP_HAL.h>                   ///< for UARTDriver
+#include <AP_HAL/utility/UARTReader.h>
 
 
 class AP_Proximity_RPLidarA2 : public AP_Proximity_Backend
@@ -81,6 +82,7 @@ private:
 
     // reply related variables
     AP_HAL::UARTDriver *_uart;
+    UARTReader reader;
     uint8_t _descriptor[7];
     char _rp_systeminfo[63];
     bool _descriptor_data;
@@ -0,0 +1,92 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AP_Proximity_Scan.h"
+
+// get the bin of a body-frame angle in degrees
+uint16_t AP_Proximity_Scan::angle_to_bin(float angle_deg)
+{
+    const uint16_t bin = wrap_360(angle_deg) * (PROXIMITY_SCAN_BINS / 360.0f);
+    return MIN(bin, PROXIMITY_SCAN_BINS-1);
+}
+
+void AP_Proximity_Scan::add_reading(float angle_deg, float width_deg, float distance, bool valid, uint32_t now_ms)
+{
+    // zero marks an empty bin, so the closest an obstacle can be kept is 1cm
+    uint16_t distance_cm = 0;
+    if (valid) {
+        distance_cm = constrain_float(distance * 100.0f, 1, UINT16_MAX);
+    }
+
+    // the bins covered, at least the one the angle falls in
+    width_deg = constrain_float(width_deg, 0, 360);
+    const uint16_t count = constrain_int16(width_deg * (PROXIMITY_SCAN_BINS / 360.0f), 1, PROXIMITY_SCAN_BINS);
+    uint16_t bin;
+    if (count == 1) {
+        bin = angle_to_bin(angle_deg);
+    } else {
+        // the first bin whose middle is within the reading
+        bin = angle_to_bin(angle_deg - width_deg * 0.5f + (180.0f / PROXIMITY_SCAN_BINS));
+    }
+
+    for (uint16_t i=0; i<count; i++) {
+        _distance_cm[bin] = distance_cm;
+        _time_ms[bin] = now_ms & 0xFFFF;
+        if (++bin == PROXIMITY_SCAN_BINS) {
+            bin = 0;
+        }
+    }
+}
+
+void AP_Proximity_Scan::update(uint32_t now_ms)
+{
+    const uint16_t now16 = now_ms & 0xFFFF;
+    for (uint16_t bin=0; bin<PROXIMITY_SCAN_BINS; bin++) {
+        if (_distance_cm[bin] != 0 && uint16_t(now16 - _time_ms[bin]) > PROXIMITY_SCAN_TIMEOUT_MS) {
+            _distance_cm[bin] = 0;
+        }
+    }
+}
+
+void AP_Proximity_Scan::clear()
+{
+    memset(_distance_cm, 0, sizeof(_distance_cm));
+}
+
+bool AP_Proximity_Scan::get_distance(uint16_t bin, float &distance) const
+{
+    if (bin >= PROXIMITY_SCAN_BINS || _distance_cm[bin] == 0) {
+        return false;
+    }
+    distance = _distance_cm[bin] * 0.01f;
+    return true;
+}
+
+bool AP_Proximity_Scan::get_closest(float &angle_deg, float &distance) const
+{
+    uint16_t closest = 0;
+    for (uint16_t bin=0; bin<PROXIMITY_SCAN_BINS; bin++) {
+        if (_distance_cm[bin] != 0 &&
+            (_distance_cm[closest] == 0 || _distance_cm[bin] < _distance_cm[closest])) {
+            closest = bin;
+        }
+    }
+    if (_distance_cm[closest] == 0) {
+        return false;
+    }
+    angle_deg = bin_angle_deg(closest);
+    distance = _distance_cm[closest] * 0.01f;
+    return true;
+}
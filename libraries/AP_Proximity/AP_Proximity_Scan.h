@@ -0,0 +1,78 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <AP_Common/AP_Common.h>
+#include <AP_HAL/AP_HAL_Boards.h>
+#include <AP_Math/AP_Math.h>
+
+// number of body-frame angle bins in a scan. Each costs 4 bytes
+#ifndef PROXIMITY_SCAN_BINS
+#if HAL_MINIMIZE_FEATURES
+#define PROXIMITY_SCAN_BINS         72      // 5 degrees each, matching OBSTACLE_DISTANCE's 72 distances
+#else
+#define PROXIMITY_SCAN_BINS         360     // 1 degree each
+#endif
+#endif
+#define PROXIMITY_SCAN_TIMEOUT_MS   500     // readings which are not refreshed for this long are forgotten
+
+/*
+  the latest distance in each of PROXIMITY_SCAN_BINS body-frame
+  directions around the vehicle, for sensors which measure more
+  directions than the backend's sectors hold, such as a scanning lidar
+  or a companion computer's depth camera sending OBSTACLE_DISTANCE.
+
+  Readings are added as they arrive, each filling the bins its angle
+  and width cover, and each bin keeps the time of its reading so stale
+  ones expire on their own when a sensor sees only part of the circle.
+  Distances are kept in centimeters and times in the low 16 bits of
+  milliseconds, so the whole scan is 4 bytes a bin.
+ */
+class AP_Proximity_Scan
+{
+public:
+    // add a reading. angle_deg is the body-frame angle of its middle,
+    // 0 forward and clockwise, and width_deg how many degrees it
+    // covers; a reading narrower than a bin fills one bin. valid is
+    // false if nothing was found within the sensor's range, which
+    // clears the bins
+    void add_reading(float angle_deg, float width_deg, float distance, bool valid, uint32_t now_ms);
+
+    // forget readings older than PROXIMITY_SCAN_TIMEOUT_MS. Must be
+    // called more often than every 65 seconds, as the frontend's
+    // update does
+    void update(uint32_t now_ms);
+
+    // forget all readings
+    void clear();
+
+    // get the distance in meters in a bin. Returns false if there is
+    // no current reading of an obstacle in it
+    bool get_distance(uint16_t bin, float &distance) const;
+
+    // get the angle and distance of the closest obstacle. Returns
+    // false if none is known
+    bool get_closest(float &angle_deg, float &distance) const;
+
+    // get the body-frame angle in degrees of the middle of a bin
+    static float bin_angle_deg(uint16_t bin) { return (bin + 0.5f) * (360.0f / PROXIMITY_SCAN_BINS); }
+
+    // get the bin of a body-frame angle in degrees
+    static uint16_t angle_to_bin(float angle_deg);
+
+private:
+    uint16_t _distance_cm[PROXIMITY_SCAN_BINS]; // zero if there is no obstacle in the bin
+    uint16_t _time_ms[PROXIMITY_SCAN_BINS];     // low 16 bits of the time of the reading
+};
@@ -20,6 +20,9 @@
 #include <ctype.h>
 #include <stdio.h>
 
+// every message starts with TH
+static const uint8_t frame_header[] { 'T', 'H' };
+
 extern const AP_HAL::HAL& hal;
 
 /*
@@ -82,18 +85,11 @@ bool AP_Proximity_TeraRangerTower::read_sensor_data()
     }
 
     uint16_t message_count = 0;
-    int16_t nbytes = uart->available();
-
-    while (nbytes-- > 0) {
-        char c = uart->read();
-        if (c == 'T' ) {
-            buffer_count = 0;
-        }
-
-        buffer[buffer_count++] = c;
+    uint32_t nbytes = uart->available();
 
-        // we should always read 19 bytes THxxxxxxxxxxxxxxxxC
-        if (buffer_count >= 19){
+    // we should always read 19 bytes THxxxxxxxxxxxxxxxxC
+    while (reader.fill(uart, nbytes)) {
+        while (reader.get_frame(buffer, buffer_count, 19, frame_header, sizeof(frame_header))) {
             buffer_count = 0;
 
             // check if message has right CRC
@@ -20,6 +20,9 @@
 #include <ctype.h>
 #include <stdio.h>
 
+// every message starts with TH
+static const uint8_t frame_header[] { 'T', 'H' };
+
 extern const AP_HAL::HAL& hal;
 
 /*
@@ -114,7 +117,7 @@ bool AP_Proximity_TeraRangerTowerEvo::read_sensor_data()
     }
 
     uint16_t message_count = 0;
-    int16_t nbytes = uart->available();
+    uint32_t nbytes = uart->available();
 
     if(_current_init_state != InitState_Finished && nbytes == 4) {
 
@@ -137,15 +140,9 @@ bool AP_Proximity_TeraRangerTowerEvo::read_sensor_data()
         }
     }
 
-    while (nbytes-- > 0) {
-        char c = uart->read();
-        if (c == 'T' ) {
-            buffer_count = 0;
-        }
-        buffer[buffer_count++] = c;
-
-        // we should always read 19 bytes THxxxxxxxxxxxxxxxxMC
-        if (buffer_count >= 20){
+    // we should always read 20 bytes THxxxxxxxxxxxxxxxxMC
+    while (reader.fill(uart, nbytes)) {
+        while (reader.get_frame(buffer, buffer_count, 20, frame_header, sizeof(frame_header))) {
             buffer_count = 0;
 
             //check if message has right CRC
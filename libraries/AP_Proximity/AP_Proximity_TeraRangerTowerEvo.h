@@ -2,6 +2,7 @@
 
 #include "AP_Proximity.h"
 #include "AP_Proximity_Backend.h"
+#include <AP_HAL/utility/UARTReader.h>
 
 #define PROXIMITY_TRTOWER_TIMEOUT_MS            300                               // requests timeout after 0.3 seconds
 
@@ -39,6 +40,7 @@ private:
     
     // reply related variables
     AP_HAL::UARTDriver *uart = nullptr;
+    UARTReader reader;
     uint8_t buffer[21]; // buffer where to store data from serial
     uint8_t buffer_count;
 
@@ -0,0 +1,88 @@
+#include <AP_gtest.h>
+
+#include <AP_Proximity/AP_Proximity_ObstacleMap.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static uint8_t bin_of(float heading_deg)
+{
+    return uint8_t(heading_deg / (360.0f / PROXIMITY_MAP_BINS));
+}
+
+TEST(ObstacleMapTest, Clearance)
+{
+    AP_Proximity_ObstacleMap map;
+    float distance;
+    EXPECT_FALSE(map.valid());
+    EXPECT_FALSE(map.get_clearance(0, distance));
+
+    // facing east, an obstacle 10m to the right is south of the vehicle
+    map.add_reading(Vector2f(5, 5), 90, 90, 10, true, 1000);
+    map.update(Vector2f(5, 5), 1000);
+    EXPECT_TRUE(map.valid());
+    ASSERT_TRUE(map.get_clearance(bin_of(180), distance));
+    EXPECT_NEAR(distance, 10, 1.0e-4f);
+    EXPECT_FALSE(map.get_clearance(bin_of(90), distance));
+
+    // it stays put as the vehicle moves towards it
+    map.update(Vector2f(1, 5), 1100);
+    ASSERT_TRUE(map.get_clearance(bin_of(180), distance));
+    EXPECT_NEAR(distance, 6, 1.0e-4f);
+
+    // and is forgotten when not seen again
+    map.update(Vector2f(1, 5), 1000 + PROXIMITY_MAP_TIMEOUT_MS + 1);
+    EXPECT_FALSE(map.get_clearance(bin_of(180), distance));
+
+    map.clear();
+    EXPECT_FALSE(map.valid());
+}
+
+TEST(ObstacleMapTest, Replace)
+{
+    AP_Proximity_ObstacleMap map;
+    float distance;
+    const Vector2f position(0, 0);
+
+    // a further reading in the same direction sees through the obstacle
+    map.add_reading(position, 0, 0, 5, true, 1000);
+    map.add_reading(position, 0, 0, 8, true, 1010);
+    map.update(position, 1020);
+    ASSERT_TRUE(map.get_clearance(bin_of(0), distance));
+    EXPECT_NEAR(distance, 8, 1.0e-4f);
+
+    // a reading which finds nothing clears the direction
+    map.add_reading(position, 0, 0, 0, false, 1030);
+    map.update(position, 1040);
+    EXPECT_FALSE(map.get_clearance(bin_of(0), distance));
+
+    // obstacles in other directions persist after the sensor turns away
+    map.add_reading(position, 0, 45, 3, true, 1050);
+    map.add_reading(position, 0, 270, 4, true, 1060);
+    map.add_reading(position, 90, 0, 0, false, 1070);
+    map.update(position, 1080);
+    ASSERT_TRUE(map.get_clearance(bin_of(45), distance));
+    EXPECT_NEAR(distance, 3, 1.0e-4f);
+    ASSERT_TRUE(map.get_clearance(bin_of(270), distance));
+    EXPECT_NEAR(distance, 4, 1.0e-4f);
+}
+
+/*
+  a newer reading in a bin replaces the older one
+ */
+TEST(ObstacleMapTest, Full)
+{
+    AP_Proximity_ObstacleMap map;
+    const Vector2f position(0, 0);
+    for (uint16_t i=0; i<2*PROXIMITY_MAP_BINS; i++) {
+        // readings in different bins at increasing distances
+        map.add_reading(position, 0, AP_Proximity_ObstacleMap::bin_heading_deg(i % PROXIMITY_MAP_BINS), 1 + i, true, 1000 + i);
+    }
+    map.update(position, 1000 + 2*PROXIMITY_MAP_BINS);
+    for (uint8_t bin=0; bin<PROXIMITY_MAP_BINS; bin++) {
+        float distance;
+        ASSERT_TRUE(map.get_clearance(bin, distance));
+        EXPECT_NEAR(distance, 1 + PROXIMITY_MAP_BINS + bin, 1.0e-3f);
+    }
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,74 @@
+#include <AP_gtest.h>
+
+#include <AP_Proximity/AP_Proximity_Scan.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+TEST(ProximityScanTest, Readings)
+{
+    AP_Proximity_Scan scan;
+    scan.clear();
+    float angle, distance;
+    EXPECT_FALSE(scan.get_closest(angle, distance));
+
+    // a narrow reading fills only the bin its angle falls in
+    const uint16_t bin = AP_Proximity_Scan::angle_to_bin(100.2f);
+    scan.add_reading(100.2f, 0, 4.5f, true, 1000);
+    ASSERT_TRUE(scan.get_distance(bin, distance));
+    EXPECT_NEAR(distance, 4.5f, 0.01f);
+    EXPECT_FALSE(scan.get_distance(bin-1, distance));
+    EXPECT_FALSE(scan.get_distance(bin+1, distance));
+    ASSERT_TRUE(scan.get_closest(angle, distance));
+    EXPECT_NEAR(angle, 100.2f, 360.0f / PROXIMITY_SCAN_BINS);
+
+    // a closer one elsewhere is the closest
+    scan.add_reading(270, 0, 2, true, 1000);
+    ASSERT_TRUE(scan.get_closest(angle, distance));
+    EXPECT_NEAR(angle, 270, 360.0f / PROXIMITY_SCAN_BINS);
+    EXPECT_NEAR(distance, 2, 0.01f);
+
+    // and a reading finding nothing clears its bin
+    scan.add_reading(270, 0, 0, false, 1000);
+    ASSERT_TRUE(scan.get_closest(angle, distance));
+    EXPECT_NEAR(distance, 4.5f, 0.01f);
+    EXPECT_FALSE(scan.get_distance(scan.angle_to_bin(270), distance));
+}
+
+TEST(ProximityScanTest, Width)
+{
+    AP_Proximity_Scan scan;
+    scan.clear();
+    float distance;
+
+    // a wide reading across forward fills the bins on both sides and no others
+    scan.add_reading(0, 20, 3, true, 1000);
+    uint16_t count = 0;
+    for (uint16_t bin=0; bin<PROXIMITY_SCAN_BINS; bin++) {
+        if (scan.get_distance(bin, distance)) {
+            count++;
+            EXPECT_LT(fabsf(wrap_180(AP_Proximity_Scan::bin_angle_deg(bin))), 10.0f);
+        }
+    }
+    EXPECT_EQ(uint16_t(20 * PROXIMITY_SCAN_BINS / 360), count);
+    EXPECT_TRUE(scan.get_distance(scan.angle_to_bin(9), distance));
+    EXPECT_TRUE(scan.get_distance(scan.angle_to_bin(351), distance));
+}
+
+TEST(ProximityScanTest, Timeout)
+{
+    AP_Proximity_Scan scan;
+    scan.clear();
+    float distance;
+    const uint16_t bin = AP_Proximity_Scan::angle_to_bin(45);
+
+    // readings last PROXIMITY_SCAN_TIMEOUT_MS, including across the
+    // wrap of the 16 bit times
+    const uint32_t t0 = 0x1FFFF - 100;
+    scan.add_reading(45, 0, 7, true, t0);
+    scan.update(t0 + PROXIMITY_SCAN_TIMEOUT_MS);
+    EXPECT_TRUE(scan.get_distance(bin, distance));
+    scan.update(t0 + PROXIMITY_SCAN_TIMEOUT_MS + 1);
+    EXPECT_FALSE(scan.get_distance(bin, distance));
+}
+
+AP_GTEST_MAIN()
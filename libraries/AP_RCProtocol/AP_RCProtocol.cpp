@@ -93,13 +93,44 @@ void AP_RCProtocol::process_pulse(uint32_t width_s0, uint32_t width_s1)
 }
 
 /*
-  process an array of pulses. n must be even
+  process an array of pulses. n must be even. Each pair is the width
+  of the first part of a pulse and the width of the whole pulse, or
+  the other way round if need_swap is set
  */
 void AP_RCProtocol::process_pulse_list(const uint32_t *widths, uint16_t n, bool need_swap)
 {
     if (n & 1) {
         return;
     }
+    const uint32_t now = AP_HAL::millis();
+    const bool searching = (now - _last_input_ms >= 200);
+    if (_detected_protocol != AP_RCProtocol::NONE && !searching) {
+        if (_detected_with_bytes) {
+            // we're using byte inputs, discard pulses
+            return;
+        }
+        // once locked on only the detected protocol sees the pulses,
+        // and the checks are done once for the whole list
+        AP_RCProtocol_Backend *b = backend[_detected_protocol];
+        while (n) {
+            uint32_t widths0 = widths[0];
+            uint32_t widths1 = widths[1];
+            if (need_swap) {
+                uint32_t tmp = widths1;
+                widths1 = widths0;
+                widths0 = tmp;
+            }
+            b->process_pulse(widths0, widths1 - widths0);
+            widths += 2;
+            n -= 2;
+        }
+        if (b->new_input()) {
+            _new_input = true;
+            _last_input_ms = now;
+        }
+        return;
+    }
+
     while (n) {
         uint32_t widths0 = widths[0];
         uint32_t widths1 = widths[1];
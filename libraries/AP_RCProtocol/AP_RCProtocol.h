@@ -85,13 +85,13 @@ public:
 
 private:
     enum rcprotocol_t _detected_protocol = NONE;
-    uint16_t _disabled_for_pulses;
-    bool _detected_with_bytes;
-    AP_RCProtocol_Backend *backend[NONE];
+    uint16_t _disabled_for_pulses = 0;
+    bool _detected_with_bytes = false;
+    AP_RCProtocol_Backend *backend[NONE] = {};
     bool _new_input = false;
-    uint32_t _last_input_ms;
+    uint32_t _last_input_ms = 0;
     bool _valid_serial_prot = false;
-    uint8_t _good_frames[NONE];
+    uint8_t _good_frames[NONE] = {};
 
     static AP_RCProtocol *_singleton;
 };
@@ -56,7 +56,10 @@ void AP_RCProtocol_Backend::add_input(uint8_t num_values, uint16_t *values, bool
     _num_channels = num_values;
     rc_frame_count++;
 #if !APM_BUILD_TYPE(APM_BUILD_iofirmware)
-    if (rc().ignore_rc_failsafe()) {
+    // there are no RC channels when the decoders run standalone, as in
+    // the tests and benchmarks
+    const RC_Channels *channels = RC_Channels::get_singleton();
+    if (channels != nullptr && channels->ignore_rc_failsafe()) {
         in_failsafe = false;
     }
 #endif
@@ -106,8 +106,11 @@ void AP_RCProtocol_ST24::_process_byte(uint8_t byte)
 
     case ST24_DECODE_STATE_GOT_STX2:
 
-        /* ensure no data overflow failure or hack is possible */
-        if ((unsigned)byte <= sizeof(_rxpacket.length) + sizeof(_rxpacket.type) + sizeof(_rxpacket.st24_data)) {
+        /* ensure no data overflow failure or hack is possible. The
+           length must also cover the type, at least one data byte and
+           the crc, or the end of the data is never found */
+        if ((unsigned)byte >= 3 &&
+            (unsigned)byte <= sizeof(_rxpacket.length) + sizeof(_rxpacket.type) + sizeof(_rxpacket.st24_data)) {
             _rxpacket.length = byte;
             _rxlen = 0;
             _decode_state = ST24_DECODE_STATE_GOT_LEN;
@@ -0,0 +1,71 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_RCProtocol/AP_RCProtocol.h>
+#include <AP_RCProtocol/tests/rc_frames.h>
+
+/*
+  byte throughput of the RC protocol decoders. BM_RCProtocolFrames
+  feeds the recorded frames of one protocol, so after the first few
+  frames the detected decoder does the work. BM_RCProtocolNoise feeds
+  bytes no decoder accepts, so every decoder sees every byte, which is
+  the cost while searching for a protocol. BM_RCProtocolPulses feeds
+  lists of PPM-sum pulses, as timer capture DMA delivers them
+ */
+
+static void BM_RCProtocolFrames(benchmark::State& state)
+{
+    const rc_frame &frame = rc_frames[state.range(0)];
+    AP_RCProtocol rcprot;
+    rcprot.init();
+    uint64_t bytes = 0;
+    while (state.KeepRunning()) {
+        for (uint8_t i=0; i<frame.length; i++) {
+            rcprot.process_byte(frame.bytes[i], frame.baudrate);
+        }
+        bytes += frame.length;
+    }
+    state.SetBytesProcessed(bytes);
+    state.SetLabel(frame.protocol);
+}
+
+static void BM_RCProtocolNoise(benchmark::State& state)
+{
+    const uint32_t baudrate = state.range(0);
+    AP_RCProtocol rcprot;
+    rcprot.init();
+    uint32_t seed = 1;
+    uint64_t bytes = 0;
+    while (state.KeepRunning()) {
+        seed = seed * 1664525 + 1013904223;
+        rcprot.process_byte(seed >> 24, baudrate);
+        bytes++;
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+static void BM_RCProtocolPulses(benchmark::State& state)
+{
+    // 8 channels and a sync gap, as width of the low part and of the
+    // whole pulse
+    uint32_t widths[18];
+    for (uint8_t i=0; i<8; i++) {
+        widths[2*i] = 400;
+        widths[2*i+1] = 1100 + 100*i;
+    }
+    widths[16] = 400;
+    widths[17] = 6000;
+    AP_RCProtocol rcprot;
+    rcprot.init();
+    uint64_t pulses = 0;
+    while (state.KeepRunning()) {
+        rcprot.process_pulse_list(widths, ARRAY_SIZE(widths), false);
+        pulses += ARRAY_SIZE(widths)/2;
+    }
+    state.SetItemsProcessed(pulses);
+}
+
+BENCHMARK(BM_RCProtocolFrames)->DenseRange(0, ARRAY_SIZE(rc_frames)-1);
+BENCHMARK(BM_RCProtocolNoise)->Arg(100000)->Arg(115200);
+BENCHMARK(BM_RCProtocolPulses);
+
+BENCHMARK_MAIN()
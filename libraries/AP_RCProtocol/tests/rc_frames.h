@@ -0,0 +1,47 @@
+/*
+  recorded frames of each byte protocol, from
+  examples/RCProtocolTest. These are the corpus for the fuzz test and
+  the input for the benchmarks
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+struct rc_frame {
+    const char *protocol;
+    uint32_t baudrate;
+    const uint8_t *bytes;
+    uint8_t length;
+};
+
+static const uint8_t rc_frame_srxl[] = {
+    0xa5, 0x03, 0x0c, 0x04, 0x2f, 0x6c, 0x10, 0xb4, 0x26,
+    0x16, 0x34, 0x01, 0x04, 0x76, 0x1c, 0x40, 0xf5, 0x3b
+};
+
+static const uint8_t rc_frame_sbus[] = {
+    0x0F, 0x4C, 0x1C, 0x5F, 0x32, 0x34, 0x38, 0xDD, 0x89,
+    0x83, 0x0F, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static const uint8_t rc_frame_dsm[] = {
+    0x00, 0xab, 0x00, 0xae, 0x08, 0xbf, 0x10, 0xd0, 0x18,
+    0xe1, 0x20, 0xf2, 0x29, 0x03, 0x31, 0x14, 0x00, 0xab,
+    0x39, 0x25, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+static const uint8_t rc_frame_sumd[] = {
+    0xA8, 0x01, 0x0C, 0x22, 0x60, 0x2F, 0x60, 0x2E, 0xE0, 0x2E, 0xE0, 0x3B,
+    0x60, 0x3B, 0x60, 0x3B, 0x60, 0x3B, 0x60, 0x3B, 0x60, 0x3B, 0x60, 0x3B, 0x60, 0x3B,
+    0x60, 0x17, 0x02
+};
+
+static const rc_frame rc_frames[] = {
+    { "SRXL", 115200, rc_frame_srxl, sizeof(rc_frame_srxl) },
+    { "SBUS", 100000, rc_frame_sbus, sizeof(rc_frame_sbus) },
+    { "DSM",  115200, rc_frame_dsm,  sizeof(rc_frame_dsm) },
+    { "SUMD", 115200, rc_frame_sumd, sizeof(rc_frame_sumd) },
+};
@@ -0,0 +1,111 @@
+#include <AP_gtest.h>
+
+#include <AP_RCProtocol/AP_RCProtocol.h>
+
+#include "rc_frames.h"
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  feed mutated copies of the recorded frames through the byte
+  decoders. Each case flips bits, drops, duplicates or splices bytes
+  of a stream of frames, so the decoders see frames which are nearly
+  valid as well as garbage. The decoders must never report more
+  channels than they can hold, and must not touch memory they don't
+  own, which the sanitizers catch
+ */
+
+#define FUZZ_CASES          2000
+#define FUZZ_STREAM_FRAMES  8
+
+// deterministic so failures can be reproduced
+static uint32_t fuzz_seed = 1;
+static uint32_t fuzz_rand()
+{
+    fuzz_seed ^= fuzz_seed << 13;
+    fuzz_seed ^= fuzz_seed >> 17;
+    fuzz_seed ^= fuzz_seed << 5;
+    return fuzz_seed;
+}
+
+// fill buf with a mutated stream of frames, returning its length
+static uint16_t mutate(const rc_frame &frame, uint8_t *buf, uint16_t buflen)
+{
+    uint16_t len = 0;
+    for (uint8_t f=0; f<FUZZ_STREAM_FRAMES; f++) {
+        for (uint8_t i=0; i<frame.length && len < buflen; i++) {
+            uint8_t b = frame.bytes[i];
+            switch (fuzz_rand() % 64) {
+            case 0:
+                // flip a bit
+                b ^= 1U << (fuzz_rand() % 8);
+                break;
+            case 1:
+                // drop the byte
+                continue;
+            case 2:
+                // duplicate the byte
+                buf[len++] = b;
+                break;
+            case 3:
+                // splice in a byte of another protocol
+                {
+                    const rc_frame &other = rc_frames[fuzz_rand() % ARRAY_SIZE(rc_frames)];
+                    b = other.bytes[fuzz_rand() % other.length];
+                }
+                break;
+            case 4:
+                // random byte
+                b = fuzz_rand();
+                break;
+            }
+            if (len < buflen) {
+                buf[len++] = b;
+            }
+        }
+    }
+    return len;
+}
+
+static void check_decoder(AP_RCProtocol &rcprot)
+{
+    const uint8_t n = rcprot.num_channels();
+    ASSERT_LE(n, MAX_RCIN_CHANNELS);
+    for (uint8_t i=0; i<n; i++) {
+        rcprot.read(i);
+    }
+}
+
+TEST(RCProtocolFuzz, MutatedFrames)
+{
+    AP_RCProtocol rcprot;
+    rcprot.init();
+    uint8_t buf[FUZZ_STREAM_FRAMES * 64];
+    for (uint8_t p=0; p<ARRAY_SIZE(rc_frames); p++) {
+        const rc_frame &frame = rc_frames[p];
+        for (uint16_t c=0; c<FUZZ_CASES; c++) {
+            const uint16_t len = mutate(frame, buf, sizeof(buf));
+            for (uint16_t i=0; i<len; i++) {
+                rcprot.process_byte(buf[i], frame.baudrate);
+            }
+            check_decoder(rcprot);
+        }
+    }
+}
+
+TEST(RCProtocolFuzz, RandomBytes)
+{
+    AP_RCProtocol rcprot;
+    rcprot.init();
+    const uint32_t baudrates[] = { 100000, 115200 };
+    for (uint8_t b=0; b<ARRAY_SIZE(baudrates); b++) {
+        for (uint32_t i=0; i<200000; i++) {
+            rcprot.process_byte(fuzz_rand(), baudrates[b]);
+            if (i % 1000 == 0) {
+                check_decoder(rcprot);
+            }
+        }
+    }
+}
+
+AP_GTEST_MAIN()
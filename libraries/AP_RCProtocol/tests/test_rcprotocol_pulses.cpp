@@ -0,0 +1,75 @@
+#include <AP_gtest.h>
+
+#include <AP_RCProtocol/AP_RCProtocol.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+/*
+  feed PPM-sum frames as lists of pulses, as the timer capture DMA
+  hands them over. Each pulse is the width of the low part then the
+  width of the whole pulse
+ */
+
+static const uint16_t ppm_values[] = { 1100, 1200, 1300, 1400, 1500, 1600, 1700, 1800 };
+
+// fill widths with one frame, returning the number of values
+static uint16_t ppm_frame(uint32_t *widths, bool swap)
+{
+    uint16_t n = 0;
+    for (uint8_t i=0; i<ARRAY_SIZE(ppm_values); i++) {
+        widths[n++] = swap ? ppm_values[i] : 400;
+        widths[n++] = swap ? 400 : ppm_values[i];
+    }
+    // sync gap
+    widths[n++] = swap ? 6000 : 400;
+    widths[n++] = swap ? 400 : 6000;
+    return n;
+}
+
+static void check_ppm(AP_RCProtocol &rcprot, bool swap)
+{
+    uint32_t widths[2*(ARRAY_SIZE(ppm_values)+1)];
+    const uint16_t n = ppm_frame(widths, swap);
+    for (uint8_t f=0; f<6; f++) {
+        rcprot.process_pulse_list(widths, n, swap);
+    }
+    EXPECT_EQ(AP_RCProtocol::PPM, rcprot.protocol_detected());
+    EXPECT_TRUE(rcprot.new_input());
+    ASSERT_EQ(ARRAY_SIZE(ppm_values), rcprot.num_channels());
+    for (uint8_t i=0; i<ARRAY_SIZE(ppm_values); i++) {
+        EXPECT_EQ(ppm_values[i], rcprot.read(i));
+    }
+
+    // while locked each list gives new input
+    rcprot.process_pulse_list(widths, n, swap);
+    EXPECT_TRUE(rcprot.new_input());
+}
+
+TEST(RCProtocolPulses, PPM)
+{
+    AP_RCProtocol rcprot;
+    rcprot.init();
+    check_ppm(rcprot, false);
+}
+
+TEST(RCProtocolPulses, PPMSwapped)
+{
+    AP_RCProtocol rcprot;
+    rcprot.init();
+    check_ppm(rcprot, true);
+}
+
+TEST(RCProtocolPulses, OddCount)
+{
+    AP_RCProtocol rcprot;
+    rcprot.init();
+    uint32_t widths[2*(ARRAY_SIZE(ppm_values)+1)];
+    const uint16_t n = ppm_frame(widths, false);
+    for (uint8_t f=0; f<6; f++) {
+        rcprot.process_pulse_list(widths, n-1, false);
+    }
+    EXPECT_EQ(AP_RCProtocol::NONE, rcprot.protocol_detected());
+    EXPECT_FALSE(rcprot.new_input());
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,93 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "AP_RCTelemetry_Scheduler.h"
+
+void AP_RCTelemetry_Scheduler::set_rate(uint8_t packet, float rate_hz)
+{
+    if (packet >= RCTELEMETRY_SCHEDULER_MAX_PACKETS) {
+        return;
+    }
+    _target_rate[packet] = rate_hz;
+    if (packet >= _num_packets) {
+        _num_packets = packet + 1;
+    }
+}
+
+/*
+  pick the ready packet with the largest time since it was last sent,
+  measured in units of its own period. Ties go to the lowest packet
+  type, so the caller's enumeration order is the priority order
+ */
+int8_t AP_RCTelemetry_Scheduler::select(uint32_t now_ms, uint32_t ready_mask)
+{
+    _slot_count++;
+
+    int8_t best = -1;
+    float best_score = -1;
+    for (uint8_t i = 0; i < _num_packets; i++) {
+        if (!(ready_mask & (1U << i)) || _target_rate[i] <= 0) {
+            continue;
+        }
+        const float score = (now_ms - _last_sent_ms[i]) * _target_rate[i];
+        if (score > best_score) {
+            best_score = score;
+            best = i;
+        }
+    }
+    return best;
+}
+
+void AP_RCTelemetry_Scheduler::sent(uint8_t packet, uint32_t now_ms)
+{
+    if (packet >= _num_packets) {
+        return;
+    }
+    _last_sent_ms[packet] = now_ms;
+    _sent_count[packet]++;
+}
+
+bool AP_RCTelemetry_Scheduler::update_rates(uint32_t now_ms)
+{
+    const uint32_t dt_ms = now_ms - _window_start_ms;
+    if (dt_ms < RCTELEMETRY_SCHEDULER_RATE_WINDOW_MS) {
+        return false;
+    }
+    const float scale = 1000.0f / dt_ms;
+    _slot_rate = _slot_count * scale;
+    _slot_count = 0;
+    for (uint8_t i = 0; i < _num_packets; i++) {
+        _rate[i] = _sent_count[i] * scale;
+        _sent_count[i] = 0;
+    }
+    _window_start_ms = now_ms;
+    return true;
+}
+
+float AP_RCTelemetry_Scheduler::get_rate(uint8_t packet) const
+{
+    if (packet >= _num_packets) {
+        return 0;
+    }
+    return _rate[packet];
+}
+
+float AP_RCTelemetry_Scheduler::get_target_rate(uint8_t packet) const
+{
+    if (packet >= _num_packets) {
+        return 0;
+    }
+    return _target_rate[packet];
+}
@@ -0,0 +1,71 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <stdint.h>
+
+#define RCTELEMETRY_SCHEDULER_MAX_PACKETS       16
+#define RCTELEMETRY_SCHEDULER_RATE_WINDOW_MS    5000
+
+/*
+  packet scheduler for RC telemetry protocols where the receiver polls
+  us for one packet at a time, such as FrSky passthrough.
+
+  Each packet type is given a target rate. On each poll the packet
+  that is most overdue relative to its own period is sent, so when
+  the receiver polls less often than the sum of the target rates all
+  packet types are slowed down in proportion, rather than the ones at
+  the end of a fixed priority list being starved. Packets the caller
+  has nothing to send for are left out through the ready mask.
+
+  The poll rate and the rate each packet type actually got are
+  measured over RCTELEMETRY_SCHEDULER_RATE_WINDOW_MS
+ */
+class AP_RCTelemetry_Scheduler {
+public:
+    // set the target rate of a packet type in Hz
+    void set_rate(uint8_t packet, float rate_hz);
+
+    // returns the packet type to send in this slot, chosen among the
+    // bits set in ready_mask, or -1 if none are ready. The slot is
+    // counted towards the measured poll rate
+    int8_t select(uint32_t now_ms, uint32_t ready_mask);
+
+    // record that a packet of the given type was sent
+    void sent(uint8_t packet, uint32_t now_ms);
+
+    // update the measured rates, returns true when a new measurement
+    // window has completed
+    bool update_rates(uint32_t now_ms);
+
+    float get_slot_rate() const { return _slot_rate; }
+    float get_rate(uint8_t packet) const;
+    float get_target_rate(uint8_t packet) const;
+    uint8_t num_packets() const { return _num_packets; }
+
+private:
+    uint8_t _num_packets {};
+    float _target_rate[RCTELEMETRY_SCHEDULER_MAX_PACKETS] {};
+    uint32_t _last_sent_ms[RCTELEMETRY_SCHEDULER_MAX_PACKETS] {};
+
+    // counts over the current measurement window
+    uint16_t _sent_count[RCTELEMETRY_SCHEDULER_MAX_PACKETS] {};
+    uint16_t _slot_count {};
+    uint32_t _window_start_ms {};
+
+    // rates measured over the last completed window
+    float _rate[RCTELEMETRY_SCHEDULER_MAX_PACKETS] {};
+    float _slot_rate {};
+};
@@ -0,0 +1,66 @@
+#include <AP_gtest.h>
+
+#include <AP_RCTelemetry/AP_RCTelemetry_Scheduler.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+// run the scheduler with every packet ready for the given number of
+// polls at the given poll period, returning the packets sent
+static void run(AP_RCTelemetry_Scheduler &sched, uint32_t &now_ms, uint32_t period_ms,
+                uint32_t polls, uint32_t ready_mask, uint32_t *counts)
+{
+    for (uint32_t i = 0; i < polls; i++) {
+        now_ms += period_ms;
+        const int8_t pkt = sched.select(now_ms, ready_mask);
+        if (pkt >= 0) {
+            sched.sent(pkt, now_ms);
+            counts[pkt]++;
+        }
+        sched.update_rates(now_ms);
+    }
+}
+
+TEST(RCTelemetryScheduler, NothingReady)
+{
+    AP_RCTelemetry_Scheduler sched;
+    sched.set_rate(0, 10);
+    EXPECT_EQ(-1, sched.select(100, 0));
+    EXPECT_EQ(0, sched.select(100, 1));
+}
+
+TEST(RCTelemetryScheduler, Proportional)
+{
+    // 20Hz of polls shared by 20Hz + 10Hz + 10Hz of demand, each
+    // packet should get half its target rate
+    AP_RCTelemetry_Scheduler sched;
+    sched.set_rate(0, 20);
+    sched.set_rate(1, 10);
+    sched.set_rate(2, 10);
+
+    uint32_t now_ms = 0;
+    uint32_t counts[3] {};
+    run(sched, now_ms, 50, 2000, 0x7, counts);
+
+    EXPECT_NEAR(20, sched.get_slot_rate(), 0.1);
+    EXPECT_NEAR(10, sched.get_rate(0), 0.5);
+    EXPECT_NEAR(5, sched.get_rate(1), 0.5);
+    EXPECT_NEAR(5, sched.get_rate(2), 0.5);
+    EXPECT_EQ(2000U, counts[0] + counts[1] + counts[2]);
+}
+
+TEST(RCTelemetryScheduler, NoStarvation)
+{
+    // a busy high rate packet must not starve a slow one
+    AP_RCTelemetry_Scheduler sched;
+    sched.set_rate(0, 100);
+    sched.set_rate(1, 1);
+
+    uint32_t now_ms = 0;
+    uint32_t counts[2] {};
+    run(sched, now_ms, 25, 4000, 0x3, counts);
+
+    EXPECT_NEAR(40.0 / 101, sched.get_rate(1), 0.2);
+    EXPECT_GT(counts[1], 30U);
+}
+
+AP_GTEST_MAIN()
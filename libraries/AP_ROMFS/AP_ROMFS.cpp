@@ -28,17 +28,50 @@ const AP_ROMFS::embedded_file AP_ROMFS::files[] = {};
 /*
   find an embedded file
 */
-const uint8_t *AP_ROMFS::find_file(const char *name, uint32_t &size)
+const AP_ROMFS::embedded_file *AP_ROMFS::find_embedded(const char *name)
 {
     for (uint16_t i=0; i<ARRAY_SIZE(files); i++) {
         if (strcmp(name, files[i].filename) == 0) {
-            size = files[i].size;
-            return files[i].contents;
+            return &files[i];
         }
     }
     return nullptr;
 }
 
+/*
+  find an uncompressed file, giving direct access to its contents
+*/
+const uint8_t *AP_ROMFS::find_file(const char *name, uint32_t &size)
+{
+    const embedded_file *f = find_embedded(name);
+    if (f == nullptr || f->compressed) {
+        return nullptr;
+    }
+    size = f->size;
+    return f->contents;
+}
+
+uint32_t AP_ROMFS::decompressed_size(const embedded_file &f)
+{
+    if (!f.compressed) {
+        return f.size;
+    }
+    // last 4 bytes of gzip file are length of decompressed data
+    const uint8_t *p = &f.contents[f.size-4];
+    return p[0] | p[1] << 8 | p[2] << 16 | p[3] << 24;
+}
+
+bool AP_ROMFS::init_decompress(const embedded_file &f, TINF_DATA *d, uint8_t *window, uint32_t window_size)
+{
+    uzlib_uncompress_init(d, window, window_size);
+
+    d->source = f.contents;
+    d->source_limit = f.contents + f.size - 4;
+
+    // assume gzip format
+    return uzlib_gzip_parse_header(d) == TINF_OK;
+}
+
 /*
   find a compressed file and uncompress it. Space for decompressed
   data comes from malloc. Caller must be careful to free the resulting
@@ -47,15 +80,12 @@ const uint8_t *AP_ROMFS::find_file(const char *name, uint32_t &size)
 */
 uint8_t *AP_ROMFS::find_decompress(const char *name, uint32_t &size)
 {
-    uint32_t compressed_size;
-    const uint8_t *compressed_data = find_file(name, compressed_size);
-    if (!compressed_data) {
+    const embedded_file *f = find_embedded(name);
+    if (!f) {
         return nullptr;
     }
 
-    // last 4 bytes of gzip file are length of decompressed data
-    const uint8_t *p = &compressed_data[compressed_size-4];
-    uint32_t decompressed_size = p[0] | p[1] << 8 | p[2] << 16 | p[3] << 24;
+    const uint32_t decompressed_size = AP_ROMFS::decompressed_size(*f);
     
     uint8_t *decompressed_data = (uint8_t *)malloc(decompressed_size + 1);
     if (!decompressed_data) {
@@ -65,19 +95,20 @@ uint8_t *AP_ROMFS::find_decompress(const char *name, uint32_t &size)
     // explicitly null terimnate the data
     decompressed_data[decompressed_size] = 0;
 
+    if (!f->compressed) {
+        memcpy(decompressed_data, f->contents, decompressed_size);
+        size = decompressed_size;
+        return decompressed_data;
+    }
+
     TINF_DATA *d = (TINF_DATA *)malloc(sizeof(TINF_DATA));
     if (!d) {
         free(decompressed_data);
         return nullptr;
     }
-    uzlib_uncompress_init(d, NULL, 0);
-
-    d->source = compressed_data;
-    d->source_limit = compressed_data + compressed_size - 4;
 
-    // assume gzip format
-    int res = uzlib_gzip_parse_header(d);
-    if (res != TINF_OK) {
+    // decompressing into one buffer needs no window
+    if (!init_decompress(*f, d, nullptr, 0)) {
         free(decompressed_data);
         free(d);
         return nullptr;
@@ -88,7 +119,7 @@ uint8_t *AP_ROMFS::find_decompress(const char *name, uint32_t &size)
 
     // we don't check CRC, as it just wastes flash space for constant
     // ROMFS data
-    res = uzlib_uncompress(d);
+    int res = uzlib_uncompress(d);
 
     free(d);
     
@@ -100,3 +131,87 @@ uint8_t *AP_ROMFS::find_decompress(const char *name, uint32_t &size)
     size = decompressed_size;
     return decompressed_data;
 }
+
+/*
+  open a file for sequential reading
+*/
+bool AP_ROMFS::Reader::open(const char *name)
+{
+    close();
+
+    const embedded_file *f = find_embedded(name);
+    if (!f) {
+        return false;
+    }
+    _data = f->contents;
+    _size = decompressed_size(*f);
+    _ofs = 0;
+    if (!f->compressed) {
+        return true;
+    }
+
+    _d = (TINF_DATA *)malloc(sizeof(TINF_DATA));
+    _window = (uint8_t *)malloc(AP_ROMFS_WINDOW_SIZE);
+    if (!_d || !_window || !init_decompress(*f, _d, _window, AP_ROMFS_WINDOW_SIZE)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+int32_t AP_ROMFS::Reader::read(uint8_t *buf, uint32_t len)
+{
+    if (_data == nullptr) {
+        return -1;
+    }
+    if (len > _size - _ofs) {
+        len = _size - _ofs;
+    }
+    if (len == 0) {
+        return 0;
+    }
+
+    if (_d == nullptr) {
+        memcpy(buf, &_data[_ofs], len);
+        _ofs += len;
+        return len;
+    }
+
+    // uzlib produces destSize bytes, or fewer if the stream ends
+    _d->dest = buf;
+    _d->destSize = len;
+    const int res = uzlib_uncompress(_d);
+    if (res != TINF_OK && res != TINF_DONE) {
+        return -1;
+    }
+    const uint32_t n = _d->dest - buf;
+    _ofs += n;
+    return n;
+}
+
+void AP_ROMFS::Reader::close()
+{
+    free(_d);
+    _d = nullptr;
+    free(_window);
+    _window = nullptr;
+    _data = nullptr;
+    _size = 0;
+    _ofs = 0;
+}
+
+/*
+  list the files in a directory. Embedded files have no directories,
+  so a file is in dirname if its name starts with dirname and a '/'
+*/
+const char *AP_ROMFS::dir_list(const char *dirname, uint16_t &ofs)
+{
+    const size_t dlen = strlen(dirname);
+    for ( ; ofs < ARRAY_SIZE(files); ofs++) {
+        const char *name = files[ofs].filename;
+        if (strncmp(name, dirname, dlen) == 0 && name[dlen] == '/') {
+            return files[ofs++].filename;
+        }
+    }
+    return nullptr;
+}
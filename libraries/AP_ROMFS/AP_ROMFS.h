@@ -4,6 +4,15 @@
 
 #include <AP_HAL/AP_HAL.h>
 
+struct TINF_DATA;
+
+/*
+  size of the window streamed decompression needs. Tools/ardupilotwaf/embed.py
+  compresses with this window so back-references never reach further
+ */
+#define AP_ROMFS_WINDOW_BITS 12
+#define AP_ROMFS_WINDOW_SIZE (1U<<AP_ROMFS_WINDOW_BITS)
+
 class AP_ROMFS {
 public:
     // find a file and de-compress, assumning gzip format. The
@@ -11,15 +20,66 @@ public:
     // call free on the return value after use. The next byte after
     // the file data is guaranteed to be null.
     static uint8_t *find_decompress(const char *name, uint32_t &size);
-    
-private:
-    // find an embedded file
+
+    // find a file stored uncompressed, returning its contents in
+    // place. Returns nullptr if the file doesn't exist or is stored
+    // compressed, for which use find_decompress() or a Reader
     static const uint8_t *find_file(const char *name, uint32_t &size);
 
+    // list the files in a directory. ofs should start at 0 and is
+    // advanced past each file returned. Returns the full name of the
+    // next file in dirname, or nullptr when there are no more
+    static const char *dir_list(const char *dirname, uint16_t &ofs);
+
+    /*
+      sequential reader for files that are consumed in order. Data is
+      decompressed as it is read, needing AP_ROMFS_WINDOW_SIZE bytes
+      plus the decompressor state rather than the whole file
+     */
+    class Reader {
+    public:
+        Reader() {}
+        ~Reader() { close(); }
+
+        Reader(const Reader &other) = delete;
+        Reader &operator=(const Reader&) = delete;
+
+        // open a file, returns false if it is not found or there is no memory
+        bool open(const char *name);
+
+        // read up to len bytes into buf. Returns the number of bytes
+        // read, 0 at the end of the file and -1 on a decompression error
+        int32_t read(uint8_t *buf, uint32_t len);
+
+        // decompressed size of the file
+        uint32_t size() const { return _size; }
+
+        void close();
+
+    private:
+        const uint8_t *_data = nullptr;
+        uint32_t _size = 0;
+        uint32_t _ofs = 0;
+        // only for compressed files
+        struct TINF_DATA *_d = nullptr;
+        uint8_t *_window = nullptr;
+    };
+
+private:
     struct embedded_file {
         const char *filename;
         uint32_t size;
         const uint8_t *contents;
+        bool compressed;
     };
     static const struct embedded_file files[];
+
+    // find an embedded file
+    static const struct embedded_file *find_embedded(const char *name);
+
+    // size of the file once decompressed
+    static uint32_t decompressed_size(const struct embedded_file &f);
+
+    // setup decompression state for f, past the gzip header
+    static bool init_decompress(const struct embedded_file &f, struct TINF_DATA *d, uint8_t *window, uint32_t window_size);
 };
@@ -16,6 +16,9 @@ public:
     // correct an offboard timestamp to a jitter-free local
     // timestamp. See JitterCorrection.cpp for details
     uint32_t correct_offboard_timestamp_msec(uint32_t offboard_ms, uint32_t local_ms);
+
+    // forget the link offset, for when the remote system changes
+    void reset() { initialised = false; min_sample_counter = 0; }
     
 private:
     const uint16_t max_lag_ms;
@@ -60,6 +60,65 @@ AP_Rally::AP_Rally()
     AP_Param::setup_object_defaults(this, var_info);
 }
 
+/*
+  load the rally points into the RAM cache if they have changed since
+  it was filled, and sort the valid ones by latitude. Returns false if
+  the cache couldn't be allocated, in which case storage is used
+ */
+bool AP_Rally::update_cache(void) const
+{
+    if (_cache_total == _rally_point_total_count) {
+        return true;
+    }
+    if (_cache == nullptr) {
+        const uint8_t max = get_rally_max();
+        _cache = (RallyLocation *)calloc(max, sizeof(RallyLocation));
+        _cache_by_lat = (uint8_t *)calloc(max, sizeof(uint8_t));
+        if (_cache == nullptr || _cache_by_lat == nullptr) {
+            free(_cache);
+            free(_cache_by_lat);
+            _cache = nullptr;
+            _cache_by_lat = nullptr;
+            return false;
+        }
+    }
+
+    const uint8_t total = MIN((uint8_t)_rally_point_total_count, get_rally_max());
+    _cache_valid_count = 0;
+    for (uint8_t i = 0; i < total; i++) {
+        RallyLocation &loc = _cache[i];
+        _storage.read_block(&loc, i * sizeof(RallyLocation), sizeof(RallyLocation));
+        if (loc.lat == 0 && loc.lng == 0) {
+            continue;
+        }
+        // insertion sort, as there are at most a few tens of points
+        uint8_t j = _cache_valid_count++;
+        while (j > 0 && _cache[_cache_by_lat[j-1]].lat > loc.lat) {
+            _cache_by_lat[j] = _cache_by_lat[j-1];
+            j--;
+        }
+        _cache_by_lat[j] = i;
+    }
+    _cache_total = _rally_point_total_count;
+    return true;
+}
+
+// return the position in the latitude index of the first point at or north of lat
+uint8_t AP_Rally::cache_lower_bound(int32_t lat) const
+{
+    uint8_t lo = 0;
+    uint8_t hi = _cache_valid_count;
+    while (lo < hi) {
+        const uint8_t mid = (lo + hi) / 2;
+        if (_cache[_cache_by_lat[mid]].lat < lat) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
 // get a rally point from EEPROM
 bool AP_Rally::get_rally_point_with_index(uint8_t i, RallyLocation &ret) const
 {
@@ -67,7 +126,11 @@ bool AP_Rally::get_rally_point_with_index(uint8_t i, RallyLocation &ret) const
         return false;
     }
 
-    _storage.read_block(&ret, i * sizeof(RallyLocation), sizeof(RallyLocation));
+    if (i < get_rally_max() && update_cache()) {
+        ret = _cache[i];
+    } else {
+        _storage.read_block(&ret, i * sizeof(RallyLocation), sizeof(RallyLocation));
+    }
 
     if (ret.lat == 0 && ret.lng == 0) {
         return false; // sanity check
@@ -89,6 +152,9 @@ bool AP_Rally::set_rally_point_with_index(uint8_t i, const RallyLocation &rallyL
 
     _storage.write_block(i * sizeof(RallyLocation), &rallyLoc, sizeof(RallyLocation));
 
+    // reloaded on next use, so a whole upload is only sorted once
+    _cache_total = -1;
+
     _last_change_time_ms = AP_HAL::millis();
 
     AP::logger().Write_RallyPoint(_rally_point_total_count, i, rallyLoc);
@@ -119,18 +185,58 @@ Location AP_Rally::rally_location_to_location(const RallyLocation &rally_loc) co
 bool AP_Rally::find_nearest_rally_point(const Location &current_loc, RallyLocation &return_loc) const
 {
     float min_dis = -1;
-
-    for (uint8_t i = 0; i < (uint8_t) _rally_point_total_count; i++) {
-        RallyLocation next_rally;
-        if (!get_rally_point_with_index(i, next_rally)) {
-            continue;
+    const LocationOrigin origin(current_loc);
+
+    if (update_cache()) {
+        /*
+          search outwards in latitude from current_loc, stopping in
+          each direction once the latitude difference alone is
+          further than the nearest point found
+         */
+        const uint8_t start = cache_lower_bound(current_loc.lat);
+        uint8_t north = start;
+        uint8_t south = start;
+        while (north < _cache_valid_count || south > 0) {
+            const RallyLocation *next_north = north < _cache_valid_count ? &_cache[_cache_by_lat[north]] : nullptr;
+            const RallyLocation *next_south = south > 0 ? &_cache[_cache_by_lat[south-1]] : nullptr;
+            const float dlat_north = next_north ? (next_north->lat - current_loc.lat) * LOCATION_SCALING_FACTOR : -1;
+            const float dlat_south = next_south ? (current_loc.lat - next_south->lat) * LOCATION_SCALING_FACTOR : -1;
+            const RallyLocation *next_rally;
+            float dlat;
+            if (next_south == nullptr || (next_north != nullptr && dlat_north <= dlat_south)) {
+                next_rally = next_north;
+                dlat = dlat_north;
+                north++;
+            } else {
+                next_rally = next_south;
+                dlat = dlat_south;
+                south--;
+            }
+            if (min_dis >= 0 && dlat >= min_dis) {
+                // the remaining points are all further away
+                break;
+            }
+            Location rally_loc = rally_location_to_location(*next_rally);
+            float dis = origin.get_distance(rally_loc);
+
+            if (is_valid(rally_loc) && (dis < min_dis || min_dis < 0)) {
+                min_dis = dis;
+                return_loc = *next_rally;
+            }
         }
-        Location rally_loc = rally_location_to_location(next_rally);
-        float dis = current_loc.get_distance(rally_loc);
-
-        if (is_valid(rally_loc) && (dis < min_dis || min_dis < 0)) {
-            min_dis = dis;
-            return_loc = next_rally;
+    } else {
+        for (uint8_t i = 0; i < (uint8_t) _rally_point_total_count; i++) {
+            RallyLocation next_rally;
+            if (!get_rally_point_with_index(i, next_rally)) {
+                continue;
+            }
+            Location rally_loc = rally_location_to_location(next_rally);
+            float dis = origin.get_distance(rally_loc);
+
+            if (is_valid(rally_loc) && (dis < min_dis || min_dis < 0)) {
+                min_dis = dis;
+                return_loc = next_rally;
+            }
         }
     }
 
@@ -158,7 +264,8 @@ Location AP_Rally::calc_best_rally_or_home_location(const Location &current_loc,
     if (find_nearest_rally_point(current_loc, ral_loc)) {
         Location loc = rally_location_to_location(ral_loc);
         // use the rally point if it's closer then home, or we aren't generally considering home as acceptable
-        if (!_rally_incl_home  || (current_loc.get_distance(loc) < current_loc.get_distance(return_loc))) {
+        const LocationOrigin origin(current_loc);
+        if (!_rally_incl_home  || (origin.get_distance(loc) < origin.get_distance(return_loc))) {
             return_loc = rally_location_to_location(ral_loc);
         }
     }
@@ -72,6 +72,16 @@ private:
 
     static StorageAccess _storage;
 
+    // rally points are kept in RAM, with their indexes sorted by
+    // latitude so the nearest can be found without checking them all
+    bool update_cache(void) const;
+    uint8_t cache_lower_bound(int32_t lat) const;
+
+    mutable RallyLocation *_cache = nullptr;
+    mutable uint8_t *_cache_by_lat = nullptr;
+    mutable uint8_t _cache_valid_count = 0;
+    mutable int16_t _cache_total = -1;
+
     // parameters
     AP_Int8  _rally_point_total_count;
     AP_Float _rally_limit_km;
@@ -83,6 +83,7 @@ void AP_RangeFinder_BLPing::update(void)
     if (get_reading(state.distance_cm)) {
         // update range_valid state based on distance measured
         state.last_reading_ms = now;
+        update_reading_time(uart);
         update_status();
     } else if (now - state.last_reading_ms > BLPING_TIMEOUT_MS) {
         set_status(RangeFinder::RangeFinder_NoData);
@@ -159,14 +160,14 @@ bool AP_RangeFinder_BLPing::get_reading(uint16_t &reading_cm)
     float sum_cm = 0;
     uint16_t count = 0;
 
-    // read any available lines from the lidar
-    int16_t nbytes = uart->available();
-    while (nbytes-- > 0) {
-        const int16_t b = uart->read();
-        if (b < 0) {
-            break;
+    // read any available messages from the sensor
+    uint32_t nbytes = uart->available();
+    while (reader.fill(uart, nbytes)) {
+        // skip any bytes between messages
+        if (msg.state == ParseState::HEADER1 && !reader.skip_to(BLPING_FRAME_HEADER1)) {
+            continue;
         }
-        if (parse_byte(b)) {
+        if (parse_byte(reader.byte())) {
             count++;
             sum_cm += distance_cm;
         }
@@ -2,6 +2,7 @@
 
 #include "RangeFinder.h"
 #include "RangeFinder_Backend.h"
+#include <AP_HAL/utility/UARTReader.h>
 
 class AP_RangeFinder_BLPing : public AP_RangeFinder_Backend
 {
@@ -56,6 +57,7 @@ private:
     };
 
     AP_HAL::UARTDriver *uart;
+    UARTReader reader;
     uint32_t last_init_ms;      // system time that sensor was last initialised
     uint16_t distance_cm;       // latest distance
 
@@ -18,6 +18,7 @@
 #include <AP_SerialManager/AP_SerialManager.h>
 #include <ctype.h>
 #include <AP_HAL/utility/sparse-endian.h>
+#include <AP_Math/crc.h>
 
 extern const AP_HAL::HAL& hal;
 
@@ -83,62 +84,35 @@ bool AP_RangeFinder_Benewake::get_reading(uint16_t &reading_cm)
     uint16_t count = 0;
     uint16_t count_out_of_range = 0;
 
-    // read any available lines from the lidar
-    int16_t nbytes = uart->available();
-    while (nbytes-- > 0) {
-        int16_t r = uart->read();
-        if (r < 0) {
-            continue;
-        }
-        uint8_t c = (uint8_t)r;
-        // if buffer is empty and this byte is 0x59, add to buffer
-        if (linebuf_len == 0) {
-            if (c == BENEWAKE_FRAME_HEADER) {
-                linebuf[linebuf_len++] = c;
+    // read any available frames from the lidar
+    static const uint8_t header[] { BENEWAKE_FRAME_HEADER, BENEWAKE_FRAME_HEADER };
+    uint32_t nbytes = uart->available();
+    while (reader.fill(uart, nbytes)) {
+        while (reader.get_frame(linebuf, linebuf_len, BENEWAKE_FRAME_LENGTH, header, sizeof(header))) {
+            linebuf_len = 0;
+            // if checksum matches extract contents
+            if (crc_sum8(linebuf, BENEWAKE_FRAME_LENGTH-1) != linebuf[BENEWAKE_FRAME_LENGTH-1]) {
+                continue;
             }
-        } else if (linebuf_len == 1) {
-            // if buffer has 1 element and this byte is 0x59, add it to buffer
-            // if not clear the buffer
-            if (c == BENEWAKE_FRAME_HEADER) {
-                linebuf[linebuf_len++] = c;
+            // calculate distance
+            uint16_t dist = ((uint16_t)linebuf[3] << 8) | linebuf[2];
+            if (dist >= BENEWAKE_DIST_MAX_CM) {
+                // this reading is out of range
+                count_out_of_range++;
+            } else if (model_type == BENEWAKE_TFmini) {
+                // no signal byte from TFmini so add distance to sum
+                sum_cm += dist;
+                count++;
             } else {
-                linebuf_len = 0;
-            }
-        } else {
-            // add character to buffer
-            linebuf[linebuf_len++] = c;
-            // if buffer now has 9 items try to decode it
-            if (linebuf_len == BENEWAKE_FRAME_LENGTH) {
-                // calculate checksum
-                uint8_t checksum = 0;
-                for (uint8_t i=0; i<BENEWAKE_FRAME_LENGTH-1; i++) {
-                    checksum += linebuf[i];
-                }
-                // if checksum matches extract contents
-                if (checksum == linebuf[BENEWAKE_FRAME_LENGTH-1]) {
-                    // calculate distance
-                    uint16_t dist = ((uint16_t)linebuf[3] << 8) | linebuf[2];
-                    if (dist >= BENEWAKE_DIST_MAX_CM) {
-                        // this reading is out of range
-                        count_out_of_range++;
-                    } else if (model_type == BENEWAKE_TFmini) {
-                        // no signal byte from TFmini so add distance to sum
-                        sum_cm += dist;
-                        count++;
-                    } else {
-                        // TF02 provides signal reliability (good = 7 or 8)
-                        if (linebuf[6] >= 7) {
-                            // add distance to sum
-                            sum_cm += dist;
-                            count++;
-                        } else {
-                            // this reading is out of range
-                            count_out_of_range++;
-                        }
-                    }
+                // TF02 provides signal reliability (good = 7 or 8)
+                if (linebuf[6] >= 7) {
+                    // add distance to sum
+                    sum_cm += dist;
+                    count++;
+                } else {
+                    // this reading is out of range
+                    count_out_of_range++;
                 }
-                // clear buffer
-                linebuf_len = 0;
             }
         }
     }
@@ -169,6 +143,7 @@ void AP_RangeFinder_Benewake::update(void)
     if (get_reading(state.distance_cm)) {
         // update range_valid state based on distance measured
         state.last_reading_ms = AP_HAL::millis();
+        update_reading_time(uart);
         update_status();
     } else if (AP_HAL::millis() - state.last_reading_ms > 200) {
         set_status(RangeFinder::RangeFinder_NoData);
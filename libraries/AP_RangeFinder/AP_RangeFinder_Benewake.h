@@ -2,6 +2,7 @@
 
 #include "RangeFinder.h"
 #include "RangeFinder_Backend.h"
+#include <AP_HAL/utility/UARTReader.h>
 
 class AP_RangeFinder_Benewake : public AP_RangeFinder_Backend
 {
@@ -39,6 +40,7 @@ private:
     bool get_reading(uint16_t &reading_cm);
 
     AP_HAL::UARTDriver *uart = nullptr;
+    UARTReader reader;
     benewake_model_type model_type;
     uint8_t linebuf[10];
     uint8_t linebuf_len;
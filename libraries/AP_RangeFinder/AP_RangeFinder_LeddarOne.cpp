@@ -16,6 +16,7 @@
 #include <AP_HAL/AP_HAL.h>
 #include "AP_RangeFinder_LeddarOne.h"
 #include <AP_SerialManager/AP_SerialManager.h>
+#include <AP_Math/crc.h>
 
 extern const AP_HAL::HAL& hal;
 
@@ -130,43 +131,13 @@ void AP_RangeFinder_LeddarOne::update(void)
     if (get_reading(state.distance_cm)) {
         // update range_valid state based on distance measured
         state.last_reading_ms = AP_HAL::millis();
+        update_reading_time(uart);
         update_status();
     } else if (AP_HAL::millis() - state.last_reading_ms > 200) {
         set_status(RangeFinder::RangeFinder_NoData);
     }
 }
 
-/*
-   CRC16
-   CRC-16-IBM(x16+x15+x2+1)
-*/
-bool AP_RangeFinder_LeddarOne::CRC16(uint8_t *aBuffer, uint8_t aLength, bool aCheck)
-{
-    uint16_t crc = 0xFFFF;
-
-    for (uint32_t i=0; i<aLength; i++) {
-        crc ^= aBuffer[i];
-        for (uint32_t j=0; j<8; j++) {
-            if (crc & 1) {
-                crc = (crc >> 1) ^ 0xA001;
-            } else {
-                crc >>= 1;
-            }
-        }
-    }
-
-    uint8_t lCRCLo = LOWBYTE(crc);
-    uint8_t lCRCHi = HIGHBYTE(crc);
-
-    if (aCheck) {
-        return (aBuffer[aLength] == lCRCLo) && (aBuffer[aLength+1] == lCRCHi);
-    } else {
-        aBuffer[aLength] = lCRCLo;
-        aBuffer[aLength+1] = lCRCHi;
-        return true;
-    }
-}
-
  /*
     parse a response message from Modbus
     -----------------------------------------------
@@ -198,14 +169,14 @@ LeddarOne_Status AP_RangeFinder_LeddarOne::parse_response(uint8_t &number_detect
     uint32_t nbytes = uart->available();
 
     if (nbytes != 0)  {
-        for (index=read_len; index<nbytes+read_len; index++) {
-            if (index >= LEDDARONE_READ_BUFFER_SIZE) {
-                return LEDDARONE_STATE_ERR_BAD_RESPONSE;
-            }
-            read_buffer[index] = uart->read();
+        if (read_len + nbytes > LEDDARONE_READ_BUFFER_SIZE) {
+            return LEDDARONE_STATE_ERR_BAD_RESPONSE;
         }
 
-        read_len += nbytes;
+        const ssize_t n = uart->read(&read_buffer[read_len], nbytes);
+        if (n > 0) {
+            read_len += n;
+        }
 
         if (read_len < LEDDARONE_READ_BUFFER_SIZE) {
             return LEDDARONE_STATE_READING_BUFFER;
@@ -217,8 +188,8 @@ LeddarOne_Status AP_RangeFinder_LeddarOne::parse_response(uint8_t &number_detect
         return LEDDARONE_STATE_ERR_BAD_RESPONSE;
     }
 
-    // CRC16
-    if (!CRC16(read_buffer, read_len-2, true)) {
+    // CRC-16 of Modbus, low byte first
+    if (crc_modbus(read_buffer, read_len-2) != UINT16_VALUE(read_buffer[read_len-1], read_buffer[read_len-2])) {
         return LEDDARONE_STATE_ERR_BAD_CRC;
     }
 
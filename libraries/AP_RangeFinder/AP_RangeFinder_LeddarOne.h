@@ -63,9 +63,6 @@ private:
     // get a reading
     bool get_reading(uint16_t &reading_cm);
 
-    // CRC16
-    bool CRC16(uint8_t *aBuffer, uint8_t aLength, bool aCheck);
-
     // parse a response message from ModBus
     LeddarOne_Status parse_response(uint8_t &number_detections);
 
@@ -57,9 +57,9 @@ bool AP_RangeFinder_LightWareSerial::get_reading(uint16_t &reading_cm)
     // read any available lines from the lidar
     float sum = 0;
     uint16_t count = 0;
-    int16_t nbytes = uart->available();
-    while (nbytes-- > 0) {
-        char c = uart->read();
+    uint32_t nbytes = uart->available();
+    while (reader.fill(uart, nbytes)) {
+        char c = reader.byte();
         if (c == '\r') {
             linebuf[linebuf_len] = 0;
             sum += (float)atof(linebuf);
@@ -102,6 +102,7 @@ void AP_RangeFinder_LightWareSerial::update(void)
     if (get_reading(state.distance_cm)) {
         // update range_valid state based on distance measured
         state.last_reading_ms = AP_HAL::millis();
+        update_reading_time(uart);
         update_status();
     } else if (AP_HAL::millis() - state.last_reading_ms > 200) {
         set_status(RangeFinder::RangeFinder_NoData);
@@ -2,6 +2,7 @@
 
 #include "RangeFinder.h"
 #include "RangeFinder_Backend.h"
+#include <AP_HAL/utility/UARTReader.h>
 
 class AP_RangeFinder_LightWareSerial : public AP_RangeFinder_Backend
 {
@@ -30,6 +31,7 @@ private:
     bool get_reading(uint16_t &reading_cm);
 
     AP_HAL::UARTDriver *uart = nullptr;
+    UARTReader reader;
     char linebuf[10];
     uint8_t linebuf_len = 0;
     uint32_t last_init_ms;
@@ -96,6 +96,7 @@ void AP_RangeFinder_MaxsonarSerialLV::update(void)
     if (get_reading(state.distance_cm)) {
         // update range_valid state based on distance measured
         state.last_reading_ms = AP_HAL::millis();
+        update_reading_time(uart);
         update_status();
     } else if (AP_HAL::millis() - state.last_reading_ms > 500) {
         set_status(RangeFinder::RangeFinder_NoData);
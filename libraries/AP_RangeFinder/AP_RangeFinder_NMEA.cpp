@@ -50,6 +50,7 @@ void AP_RangeFinder_NMEA::update(void)
     if (get_reading(state.distance_cm)) {
         // update range_valid state based on distance measured
         state.last_reading_ms = now;
+        update_reading_time(uart);
         update_status();
     } else if ((now - state.last_reading_ms) > 3000) {
         set_status(RangeFinder::RangeFinder_NoData);
@@ -66,9 +67,9 @@ bool AP_RangeFinder_NMEA::get_reading(uint16_t &reading_cm)
     // read any available lines from the lidar
     float sum = 0.0f;
     uint16_t count = 0;
-    int16_t nbytes = uart->available();
-    while (nbytes-- > 0) {
-        char c = uart->read();
+    uint32_t nbytes = uart->available();
+    while (reader.fill(uart, nbytes)) {
+        char c = reader.byte();
         if (decode(c)) {
             sum += _distance_m;
             count++;
@@ -17,6 +17,7 @@
 
 #include "RangeFinder.h"
 #include "RangeFinder_Backend.h"
+#include <AP_HAL/utility/UARTReader.h>
 
 class AP_RangeFinder_NMEA : public AP_RangeFinder_Backend
 {
@@ -65,6 +66,7 @@ private:
     static int16_t char_to_hex(char a);
 
     AP_HAL::UARTDriver *uart = nullptr;     // pointer to serial uart
+    UARTReader reader;
 
     // message decoding related members
     char _term[15];                         // buffer for the current term within the current sentence
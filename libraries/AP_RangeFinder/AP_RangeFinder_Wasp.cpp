@@ -105,6 +105,7 @@ bool AP_RangeFinder_Wasp::get_reading(uint16_t &reading_cm) {
             linebuf[linebuf_len] = 0;
             linebuf_len = 0;
             state.last_reading_ms = AP_HAL::millis();
+            update_reading_time(uart);
             if (isalpha(linebuf[0])) {
                 parse_response();
             } else {
@@ -16,6 +16,7 @@
 #include <AP_HAL/AP_HAL.h>
 #include "AP_RangeFinder_uLanding.h"
 #include <AP_SerialManager/AP_SerialManager.h>
+#include <AP_Math/crc.h>
 #include <ctype.h>
 
 #define ULANDING_HDR 254   // Header Byte from uLanding (0xFE)
@@ -71,11 +72,11 @@ bool AP_RangeFinder_uLanding::detect_version(void)
     uint8_t count = 0;
 
     // read any available data from uLanding
-    int16_t nbytes = uart->available();
+    uint32_t nbytes = uart->available();
+
+    while (reader.fill(uart, nbytes)) {
+        uint8_t c = reader.byte();
 
-    while (nbytes-- > 0) {
-        uint8_t c = uart->read();
-        
         if (((c == ULANDING_HDR_V0) || (c == ULANDING_HDR)) && !hdr_found) {
             byte1 = c;
             hdr_found = true;
@@ -148,47 +149,25 @@ bool AP_RangeFinder_uLanding::get_reading(uint16_t &reading_cm)
         return false;
     }
 
-    // read any available lines from the uLanding
+    // read any available lines from the uLanding, of six bytes (or 3
+    // bytes for Version 0 firmware)
     float sum = 0;
     uint16_t count = 0;
-    bool hdr_found = false;
+    const uint8_t frame_len = (_version == 0) ? 3 : sizeof(_linebuf);
 
-    int16_t nbytes = uart->available();
+    uint32_t nbytes = uart->available();
 
-    while (nbytes-- > 0) {
-        uint8_t c = uart->read();
-        
-        if ((c == _header) && !hdr_found) {
-            // located header byte
+    while (reader.fill(uart, nbytes)) {
+        while (reader.get_frame(_linebuf, _linebuf_len, frame_len, &_header, 1)) {
             _linebuf_len = 0;
-            hdr_found   = true;
-        }
-        // decode index information
-        if (hdr_found) {
-            _linebuf[_linebuf_len++] = c;
-
-            if ((_linebuf_len < (sizeof(_linebuf)/sizeof(_linebuf[0]))) ||
-                (_version == 0 && _linebuf_len < 3)) {
-                /* don't process _linebuf until we've collected six bytes of data
-                 * (or 3 bytes for Version 0 firmware)
-                 */
-                continue;
-            } else {
-                if (_version == 0) {
-                    // parse data for Firmware Version #0
-                    sum += (_linebuf[2]&0x7F)*128 + (_linebuf[1]&0x7F);
-                    count++;
-                } else {
-                    // evaluate checksum
-                    if (((_linebuf[1] + _linebuf[2] + _linebuf[3] + _linebuf[4]) & 0xFF) == _linebuf[5]) {
-                        // if checksum passed, parse data for Firmware Version #1
-                        sum += _linebuf[3]*256 + _linebuf[2];
-                        count++;
-                    }
-                }
-
-                hdr_found = false;
-                _linebuf_len = 0;
+            if (_version == 0) {
+                // parse data for Firmware Version #0
+                sum += (_linebuf[2]&0x7F)*128 + (_linebuf[1]&0x7F);
+                count++;
+            } else if (crc_sum8(&_linebuf[1], 4) == _linebuf[5]) {
+                // if checksum passed, parse data for Firmware Version #1
+                sum += _linebuf[3]*256 + _linebuf[2];
+                count++;
             }
         }
     }
@@ -213,6 +192,7 @@ void AP_RangeFinder_uLanding::update(void)
 {
     if (get_reading(state.distance_cm)) {
         state.last_reading_ms = AP_HAL::millis();
+        update_reading_time(uart);
         // update range_valid state based on distance measured
         update_status();
     } else if (AP_HAL::millis() - state.last_reading_ms > 200) {
@@ -2,6 +2,7 @@
 
 #include "RangeFinder.h"
 #include "RangeFinder_Backend.h"
+#include <AP_HAL/utility/UARTReader.h>
 
 class AP_RangeFinder_uLanding : public AP_RangeFinder_Backend
 {
@@ -33,6 +34,7 @@ private:
     bool get_reading(uint16_t &reading_cm);
 
     AP_HAL::UARTDriver *uart;
+    UARTReader reader;
     uint8_t  _linebuf[6];
     uint8_t  _linebuf_len;
     bool     _version_known;
@@ -661,6 +661,15 @@ uint32_t RangeFinder::last_reading_ms(enum Rotation orientation) const
     return backend->last_reading_ms();
 }
 
+uint32_t RangeFinder::reading_time_ms(enum Rotation orientation) const
+{
+    AP_RangeFinder_Backend *backend = find_instance(orientation);
+    if (backend == nullptr) {
+        return 0;
+    }
+    return backend->reading_time_ms();
+}
+
 MAV_DISTANCE_SENSOR RangeFinder::get_mav_distance_sensor_type_orient(enum Rotation orientation) const
 {
     AP_RangeFinder_Backend *backend = find_instance(orientation);
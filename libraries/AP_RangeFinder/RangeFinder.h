@@ -95,6 +95,7 @@ public:
         uint16_t pre_arm_distance_min;  // min distance captured during pre-arm checks
         uint16_t pre_arm_distance_max;  // max distance captured during pre-arm checks
         uint32_t last_reading_ms;       // system time of last successful update from sensor
+        uint32_t reading_time_ms;       // system time the data for the last reading arrived, 0 if not known
 
         const struct AP_Param::GroupInfo *var_info;
     };
@@ -140,6 +141,7 @@ public:
     uint8_t range_valid_count_orient(enum Rotation orientation) const;
     const Vector3f &get_pos_offset_orient(enum Rotation orientation) const;
     uint32_t last_reading_ms(enum Rotation orientation) const;
+    uint32_t reading_time_ms(enum Rotation orientation) const;
 
     /*
       set an externally estimated terrain height. Used to enable power
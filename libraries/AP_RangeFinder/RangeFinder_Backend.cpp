@@ -79,6 +79,17 @@ void AP_RangeFinder_Backend::set_status(RangeFinder::RangeFinder_Status _status)
     }
 }
 
+/*
+  set the reading time from the UART's receive time for its newest
+  byte, so the EKF can use the time the reading arrived rather than
+  an assumed delay
+ */
+void AP_RangeFinder_Backend::update_reading_time(AP_HAL::UARTDriver *port)
+{
+    const uint64_t receive_us = port->receive_time_constraint_us(0);
+    state.reading_time_ms = receive_us / 1000U;
+}
+
 /*
   set pre-arm checks to passed if the range finder has been exercised through a reasonable range of movement
       max distance sensed is at least 50cm > min distance sensed
@@ -58,8 +58,16 @@ public:
     // return system time of last successful read from the sensor
     uint32_t last_reading_ms() const { return state.last_reading_ms; }
 
+    // return system time the data for the last reading arrived, or
+    // zero if the driver can't tell
+    uint32_t reading_time_ms() const { return state.reading_time_ms; }
+
 protected:
 
+    // set the reading time from when the last byte read from port
+    // arrived
+    void update_reading_time(AP_HAL::UARTDriver *port);
+
     // update status based on distance measurement
     void update_status();
 
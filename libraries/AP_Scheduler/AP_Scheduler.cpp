@@ -26,6 +26,7 @@
 #include <AP_Logger/AP_Logger.h>
 #include <AP_InertialSensor/AP_InertialSensor.h>
 #include <AP_InternalError/AP_InternalError.h>
+#include <GCS_MAVLink/GCS.h>
 
 #include <stdio.h>
 
@@ -35,6 +36,11 @@
 #define SCHEDULER_DEFAULT_LOOP_RATE  50
 #endif
 
+// runs before a task's learnt runtime is used for it, and before a bad
+// max_time_micros is reported
+#define AP_SCHEDULER_MODEL_MIN_RUNS    20
+#define AP_SCHEDULER_MODEL_REPORT_RUNS 200
+
 #define debug(level, fmt, args...)   do { if ((level) <= _debug.get()) { hal.console->printf(fmt, ##args); }} while (0)
 
 extern const AP_HAL::HAL& hal;
@@ -57,6 +63,33 @@ const AP_Param::GroupInfo AP_Scheduler::var_info[] = {
     // @User: Advanced
     AP_GROUPINFO("LOOP_RATE",  1, AP_Scheduler, _loop_rate_hz, SCHEDULER_DEFAULT_LOOP_RATE),
 
+    // @Param: OPTIONS
+    // @DisplayName: Scheduler options
+    // @Description: This controls optional aspects of the scheduler. RecordTaskInfo keeps per-task runtime, jitter and slip statistics and logs them in the TSK message when PM logging is enabled. ReportTaskInfo additionally sends the per-task statistics to the GCS as text messages. EarliestDeadlineFirst runs the tasks that are due in order of their deadline, so that when the loop is overloaded the tasks with the most slack are the ones that are skipped, rather than running them in task table order. PredictTaskTime learns the 95th percentile runtime of each task and uses it instead of the time in the task table to decide whether a task fits in the time left, and reports tasks whose table time is badly wrong. Changes take effect on restart.
+    // @Bitmask: 0:RecordTaskInfo,1:ReportTaskInfo,2:EarliestDeadlineFirst,3:PredictTaskTime
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("OPTIONS",  2, AP_Scheduler, _options, 0),
+
+#if AP_SCHEDULER_WORKERS_ENABLED
+    // @Param: WORKERS
+    // @DisplayName: Scheduler worker threads
+    // @Description: Number of worker threads used to run scheduler tasks which are marked as safe to run concurrently with the main loop. A value of 0 runs all tasks on the main thread. A task handed to a worker is not started again until its previous run has completed.
+    // @Range: 0 4
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("WORKERS",  3, AP_Scheduler, _num_workers, 0),
+#endif
+
+    // @Param: TASK_RATE
+    // @DisplayName: Scheduler task rate
+    // @Description: This controls the rate in Hz at which the scheduler checks which tasks in the task table are due, independently of the main loop rate at which the rate controllers run. The rates of the tasks are relative to this, and tasks asking for a higher rate run once per task tick. Due tasks which did not fit in the time left in a main loop are run in the following main loops. It is rounded so that it divides the main loop rate. A value of 0 uses the main loop rate. This only takes effect on restart.
+    // @Range: 0 2000
+    // @Units: Hz
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("TASK_RATE",  4, AP_Scheduler, _task_rate_hz, 0),
+
     AP_GROUPEND
 };
 
@@ -101,10 +134,44 @@ void AP_Scheduler::init(const AP_Scheduler::Task *tasks, uint8_t num_tasks, uint
     memset(_last_run, 0, sizeof(_last_run[0]) * _num_tasks);
     _tick_counter = 0;
 
+    // the number of main loops per task tick
+    const uint16_t loop_rate_hz = get_loop_rate_hz();
+    if (_task_rate_hz <= 0 || _task_rate_hz >= loop_rate_hz) {
+        _loops_per_tick = 1;
+    } else {
+        _loops_per_tick = MIN(loop_rate_hz / MAX(_task_rate_hz.get(), 1), UINT8_MAX);
+    }
+    _task_rate_hz.set(loop_rate_hz / _loops_per_tick);
+
     // setup initial performance counters
     perf_info.set_loop_rate(get_loop_rate_hz());
     perf_info.reset();
 
+    if (_options & (OPTION_RECORD_TASK_INFO | OPTION_REPORT_TASK_INFO)) {
+        perf_info.allocate_task_info(_num_tasks);
+    }
+
+    if (_options & OPTION_EARLIEST_DEADLINE_FIRST) {
+        _task_order = new uint8_t[_num_tasks];
+    }
+
+    if (_options & OPTION_PREDICT_TASK_TIME) {
+        _time_model = new TaskTimeModel[_num_tasks];
+        if (_time_model != nullptr) {
+            memset(_time_model, 0, sizeof(_time_model[0]) * _num_tasks);
+        }
+    }
+
+#if AP_SCHEDULER_WORKERS_ENABLED
+    if (_num_workers > 0) {
+        _workers = new AP_Scheduler_WorkerPool();
+        if (_workers != nullptr && !_workers->init(_num_workers, _num_tasks)) {
+            delete _workers;
+            _workers = nullptr;
+        }
+    }
+#endif
+
     _log_performance_bit = log_performance_bit;
 }
 
@@ -123,6 +190,9 @@ void AP_Scheduler::run(uint32_t time_available)
     uint32_t run_started_usec = AP_HAL::micros();
     uint32_t now = run_started_usec;
 
+    // set again below if a due task doesn't fit
+    _tasks_pending = false;
+
     if (_debug > 1 && _perf_counters == nullptr) {
         _perf_counters = new AP_HAL::Util::perf_counter_t[_num_tasks];
         if (_perf_counters != nullptr) {
@@ -132,16 +202,22 @@ void AP_Scheduler::run(uint32_t time_available)
         }
     }
     
-    for (uint8_t i=0; i<_num_tasks; i++) {
+    const uint8_t num_to_check = order_tasks_by_deadline();
+
+    for (uint8_t n=0; n<num_to_check; n++) {
+        const uint8_t i = task_at(n);
         uint16_t dt = _tick_counter - _last_run[i];
-        uint16_t interval_ticks = _loop_rate_hz / _tasks[i].rate_hz;
-        if (interval_ticks < 1) {
-            interval_ticks = 1;
-        }
+        const uint16_t interval_ticks = task_interval_ticks(i);
         if (dt < interval_ticks) {
             // this task is not yet scheduled to run again
             continue;
         }
+#if AP_SCHEDULER_WORKERS_ENABLED
+        if (dispatch_async(i)) {
+            continue;
+        }
+#endif
+
         // this task is due to run. Do we have enough time to run it?
         _task_time_allowed = _tasks[i].max_time_micros;
 
@@ -155,9 +231,11 @@ void AP_Scheduler::run(uint32_t time_available)
                   (unsigned)_task_time_allowed);
         }
 
-        if (_task_time_allowed > time_available) {
+        if (predicted_task_time(i) > time_available) {
             // not enough time to run this task.  Continue loop -
             // maybe another task will fit into time remaining
+            perf_info.task_slipped(i);
+            _tasks_pending = true;
             continue;
         }
 
@@ -180,8 +258,10 @@ void AP_Scheduler::run(uint32_t time_available)
         // work out how long the event actually took
         now = AP_HAL::micros();
         uint32_t time_taken = now - _task_time_started;
+        update_time_model(i, time_taken);
 
-        if (time_taken > _task_time_allowed) {
+        const bool overrun = time_taken > _task_time_allowed;
+        if (overrun) {
             // the event overran!
             debug(3, "Scheduler overrun task[%u-%s] (%u/%u)\n",
                   (unsigned)i,
@@ -189,8 +269,16 @@ void AP_Scheduler::run(uint32_t time_available)
                   (unsigned)time_taken,
                   (unsigned)_task_time_allowed);
         }
+        if (perf_info.has_task_info()) {
+            perf_info.update_task_info(i, _task_time_started, time_taken,
+                                       interval_ticks * get_task_period_us(), overrun);
+        }
         if (time_taken >= time_available) {
             time_available = 0;
+            _tasks_pending = true;
+            if (perf_info.has_task_info()) {
+                record_slipped_tasks(n+1, num_to_check);
+            }
             break;
         }
         time_available -= time_taken;
@@ -206,6 +294,164 @@ void AP_Scheduler::run(uint32_t time_available)
     }
 }
 
+#if AP_SCHEDULER_WORKERS_ENABLED
+/*
+  hand a due async-safe task to the worker pool. If the previous run
+  of the task has not completed yet the task is left due, so it is
+  picked up again on a later tick; it never runs twice concurrently
+ */
+bool AP_Scheduler::dispatch_async(uint8_t i)
+{
+    if (_workers == nullptr || !(_tasks[i].flags & TASK_FLAG_ASYNC_SAFE)) {
+        return false;
+    }
+    if (!_workers->dispatch(i, _tasks[i].function)) {
+        // still running from last time
+        perf_info.task_slipped(i);
+        return true;
+    }
+    _last_run[i] = _tick_counter;
+    return true;
+}
+#endif
+
+/*
+  return the number of ticks between runs of a task
+ */
+uint16_t AP_Scheduler::task_interval_ticks(uint8_t i) const
+{
+    const uint16_t interval_ticks = _task_rate_hz / _tasks[i].rate_hz;
+    if (interval_ticks < 1) {
+        return 1;
+    }
+    return interval_ticks;
+}
+
+/*
+  return the time to allow for task i when deciding whether it fits in
+  the time available. Until a task has run enough times for its model
+  to settle the time from the task table is used
+ */
+uint32_t AP_Scheduler::predicted_task_time(uint8_t i) const
+{
+    if (_time_model == nullptr || _time_model[i].runs < AP_SCHEDULER_MODEL_MIN_RUNS) {
+        return _tasks[i].max_time_micros;
+    }
+    return uint32_t(_time_model[i].p95_us) + 1;
+}
+
+/*
+  update the runtime model of a task. The 95th percentile is tracked
+  with a stochastic quantile estimate: a run longer than the estimate
+  raises it by 19 times as much as a shorter run lowers it, so it
+  settles where 5% of runs are longer. The step is proportional to the
+  estimate so it adapts at the same relative rate for short and long
+  tasks
+ */
+void AP_Scheduler::update_time_model(uint8_t i, uint32_t time_taken)
+{
+    if (_time_model == nullptr) {
+        return;
+    }
+    TaskTimeModel &m = _time_model[i];
+    if (m.runs == 0) {
+        m.p95_us = time_taken;
+    } else {
+        const float step = MAX(m.p95_us, 10.0f) * 0.05f;
+        if (time_taken > m.p95_us) {
+            m.p95_us += step * 0.95f;
+        } else {
+            m.p95_us = MAX(m.p95_us - step * 0.05f, 0.0f);
+        }
+    }
+    if (m.runs < UINT16_MAX) {
+        m.runs++;
+    }
+}
+
+/*
+  report, once per task, tasks whose max_time_micros in the task table
+  is less than their learnt runtime, so they cause overruns, or more
+  than four times it, so they waste slack
+ */
+void AP_Scheduler::check_task_times()
+{
+    if (_time_model == nullptr) {
+        return;
+    }
+    for (uint8_t i=0; i<_num_tasks; i++) {
+        TaskTimeModel &m = _time_model[i];
+        if (m.reported || m.runs < AP_SCHEDULER_MODEL_REPORT_RUNS) {
+            continue;
+        }
+        const uint32_t p95_us = uint32_t(m.p95_us) + 1;
+        const uint16_t max_time = _tasks[i].max_time_micros;
+        if (p95_us > max_time || p95_us * 4 < max_time) {
+            gcs().send_text(MAV_SEVERITY_DEBUG, "Sched: %s max_time %uus, p95 %uus",
+                            _tasks[i].name,
+                            (unsigned)max_time,
+                            (unsigned)p95_us);
+            m.reported = true;
+            // one per call to avoid flooding the link
+            break;
+        }
+    }
+}
+
+/*
+  when running in earliest-deadline-first mode fill _task_order with
+  the tasks which are due to run, most urgent first. A task released
+  at _last_run+interval has its deadline at the following release,
+  _last_run+2*interval, so the urgency is the number of ticks left
+  until then. Ties keep task table order. Returns the number of
+  entries run() should walk
+ */
+uint8_t AP_Scheduler::order_tasks_by_deadline()
+{
+    if (_task_order == nullptr) {
+        return _num_tasks;
+    }
+    uint8_t num_due = 0;
+    for (uint8_t i=0; i<_num_tasks; i++) {
+        const uint16_t dt = _tick_counter - _last_run[i];
+        const uint16_t interval_ticks = task_interval_ticks(i);
+        if (dt < interval_ticks) {
+            continue;
+        }
+        // insertion sort; the due list is short and mostly ordered
+        // already as fast tasks tend to be at the top of the table
+        const int32_t slack = 2*int32_t(interval_ticks) - dt;
+        uint8_t pos = num_due;
+        while (pos > 0) {
+            const uint8_t prev = _task_order[pos-1];
+            const int32_t prev_slack = 2*int32_t(task_interval_ticks(prev)) - uint16_t(_tick_counter - _last_run[prev]);
+            if (prev_slack <= slack) {
+                break;
+            }
+            _task_order[pos] = prev;
+            pos--;
+        }
+        _task_order[pos] = i;
+        num_due++;
+    }
+    return num_due;
+}
+
+/*
+  count the tasks from position first onwards which were due to run
+  but were left out because the time available ran out
+ */
+void AP_Scheduler::record_slipped_tasks(uint8_t first, uint8_t num_to_check)
+{
+    for (uint8_t n=first; n<num_to_check; n++) {
+        const uint8_t i = task_at(n);
+        const uint16_t dt = _tick_counter - _last_run[i];
+        if (dt >= task_interval_ticks(i)) {
+            perf_info.task_slipped(i);
+        }
+    }
+}
+
 /*
   return number of micros until the current task reaches its deadline
  */
@@ -251,17 +497,23 @@ void AP_Scheduler::loop()
         _fastloop_fn();
     }
 
-    // tell the scheduler one tick has passed
-    tick();
+    // tell the scheduler one task tick has passed, once every
+    // _loops_per_tick main loops
+    bool new_tick = false;
+    if (++_loops_since_tick >= _loops_per_tick) {
+        _loops_since_tick = 0;
+        tick();
+        new_tick = true;
+    }
 
-    // run all the tasks that are due to run. Note that we only
-    // have to call this once per loop, as the tasks are scheduled
-    // in multiples of the main loop tick. So if they don't run on
-    // the first call to the scheduler they won't run on a later
-    // call until scheduler.tick() is called again
-    const uint32_t loop_us = get_loop_period_us();
-    const uint32_t time_available = (sample_time_us + loop_us) - AP_HAL::micros();
-    run(time_available > loop_us ? 0u : time_available);
+    // run all the tasks that are due to run. On main loops between
+    // task ticks the tasks are only checked again if some of them
+    // didn't fit last time, so they get the rest of the task tick
+    if (new_tick || _tasks_pending) {
+        const uint32_t loop_us = get_loop_period_us();
+        const uint32_t time_available = (sample_time_us + loop_us) - AP_HAL::micros();
+        run(time_available > loop_us ? 0u : time_available);
+    }
 
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
     // move result of AP_HAL::micros() forward:
@@ -282,9 +534,84 @@ void AP_Scheduler::update_logging()
     if (_log_performance_bit != (uint32_t)-1 &&
         AP::logger().should_log(_log_performance_bit)) {
         Log_Write_Performance();
+        if (_options & OPTION_RECORD_TASK_INFO) {
+            Log_Write_Task_Info();
+        }
     }
+    if (_options & OPTION_REPORT_TASK_INFO) {
+        report_task_info();
+    }
+    check_task_times();
     perf_info.set_loop_rate(get_loop_rate_hz());
     perf_info.reset();
+    perf_info.reset_task_info();
+}
+
+// Write per-task performance packets, one per task that has run or
+// slipped since the last call
+void AP_Scheduler::Log_Write_Task_Info()
+{
+    const uint64_t now = AP_HAL::micros64();
+    for (uint8_t i=0; i<_num_tasks; i++) {
+        const AP::PerfInfo::TaskInfo *ti = perf_info.get_task_info(i);
+        if (ti == nullptr) {
+            return;
+        }
+        if (ti->tick_count == 0 && ti->slip_count == 0) {
+            continue;
+        }
+        struct log_SchedTask pkt = {
+            LOG_PACKET_HEADER_INIT(LOG_SCHED_TASK_MSG),
+            time_us          : now,
+            task_id          : i,
+            name             : {},
+            num_runs         : ti->tick_count,
+            avg_time         : ti->get_avg_time_us(),
+            max_time         : ti->max_time_us,
+            p99_time         : ti->get_p99_time_us(),
+            num_slips        : ti->slip_count,
+            num_overruns     : ti->overrun_count,
+            avg_jitter       : ti->get_avg_jitter_us(),
+            max_jitter       : ti->max_jitter_us
+        };
+        strncpy(pkt.name, _tasks[i].name, sizeof(pkt.name));
+        AP::logger().WriteBlock(&pkt, sizeof(pkt));
+    }
+}
+
+/*
+  send per-task statistics to the GCS. We only send a few tasks per
+  call to avoid flooding the link; tasks which have not run are
+  skipped
+ */
+void AP_Scheduler::report_task_info()
+{
+    const uint8_t max_per_call = 4;
+    uint8_t sent = 0;
+    for (uint8_t n=0; n<_num_tasks && sent < max_per_call; n++) {
+        const uint8_t i = _report_task_index;
+        _report_task_index = (_report_task_index + 1) % _num_tasks;
+        const AP::PerfInfo::TaskInfo *ti = perf_info.get_task_info(i);
+        if (ti == nullptr) {
+            return;
+        }
+        if (ti->tick_count == 0 && ti->slip_count == 0) {
+            continue;
+        }
+        gcs().send_text(MAV_SEVERITY_INFO,
+                        "TSK %u %s n=%u avg=%u max=%u p99=%u s=%u o=%u j=%u/%u",
+                        (unsigned)i,
+                        _tasks[i].name,
+                        (unsigned)ti->tick_count,
+                        (unsigned)ti->get_avg_time_us(),
+                        (unsigned)ti->max_time_us,
+                        (unsigned)ti->get_p99_time_us(),
+                        (unsigned)ti->slip_count,
+                        (unsigned)ti->overrun_count,
+                        (unsigned)ti->get_avg_jitter_us(),
+                        (unsigned)ti->max_jitter_us);
+        sent++;
+    }
 }
 
 // Write a performance monitoring packet
@@ -24,6 +24,7 @@
 #include <AP_HAL/Util.h>
 #include <AP_Math/AP_Math.h>
 #include "PerfInfo.h"       // loop perf monitoring
+#include "WorkerPool.h"     // worker threads for async-safe tasks
 
 #define AP_SCHEDULER_NAME_INITIALIZER(_name) .name = #_name,
 
@@ -37,6 +38,19 @@
     .max_time_micros = _max_time_micros\
 }
 
+/*
+  as SCHED_TASK_CLASS, but marks the task as safe to run on a worker
+  thread concurrently with the main loop. Only use this for tasks
+  which do their own locking of any state shared with the main thread
+ */
+#define SCHED_TASK_CLASS_ASYNC(classname, classptr, func, _rate_hz, _max_time_micros) { \
+    .function = FUNCTOR_BIND(classptr, &classname::func, void),\
+    AP_SCHEDULER_NAME_INITIALIZER(func)\
+    .rate_hz = _rate_hz,\
+    .max_time_micros = _max_time_micros,\
+    .flags = AP_Scheduler::TASK_FLAG_ASYNC_SAFE\
+}
+
 /*
   A task scheduler for APM main loops
 
@@ -72,6 +86,12 @@ public:
         const char *name;
         float rate_hz;
         uint16_t max_time_micros;
+        uint8_t flags;
+    };
+
+    enum {
+        // task may be run on a worker thread
+        TASK_FLAG_ASYNC_SAFE = (1U<<0),
     };
 
     // initialise scheduler
@@ -87,6 +107,9 @@ public:
     // write out PERF message to logger
     void Log_Write_Performance();
 
+    // write out per-task TSK messages to logger
+    void Log_Write_Task_Info();
+
     // call when one tick has passed
     void tick(void);
 
@@ -135,6 +158,16 @@ public:
         return perf_info.get_filtered_time();
     }
 
+    // get the rate in Hz at which tasks are checked, which divides the
+    // main loop rate
+    uint16_t get_task_rate_hz(void) const {
+        return _task_rate_hz;
+    }
+    // get the time between task ticks in microseconds
+    uint32_t get_task_period_us() {
+        return get_loop_period_us() * _loops_per_tick;
+    }
+
     // get the time in seconds that the last loop took
     float get_last_loop_time_s(void) const {
         return _last_loop_time_s;
@@ -148,7 +181,49 @@ public:
     // loop performance monitoring:
     AP::PerfInfo perf_info;
 
+    enum {
+        OPTION_RECORD_TASK_INFO = (1U<<0),
+        OPTION_REPORT_TASK_INFO = (1U<<1),
+        OPTION_EARLIEST_DEADLINE_FIRST = (1U<<2),
+        OPTION_PREDICT_TASK_TIME = (1U<<3),
+    };
+
 private:
+    // count due tasks that were not run because we ran out of time
+    void record_slipped_tasks(uint8_t first, uint8_t num_to_check);
+
+    // number of ticks between runs of task i
+    uint16_t task_interval_ticks(uint8_t i) const;
+
+    // build _task_order for earliest-deadline-first dispatch
+    uint8_t order_tasks_by_deadline();
+
+    // index of the task at position n in the dispatch order
+    uint8_t task_at(uint8_t n) const {
+        return _task_order != nullptr ? _task_order[n] : n;
+    }
+
+    // send per-task statistics to the GCS
+    void report_task_info();
+
+    // learnt runtime of a task, used instead of its max_time_micros to
+    // decide whether it fits in the time available
+    struct TaskTimeModel {
+        float p95_us;       // running estimate of the 95th percentile
+        uint16_t runs;      // number of runs learnt, saturating
+        bool reported;      // true once a bad max_time_micros was reported
+    };
+    TaskTimeModel *_time_model;
+
+    // time to allow for when deciding whether task i fits
+    uint32_t predicted_task_time(uint8_t i) const;
+
+    // update the runtime model of task i with a run
+    void update_time_model(uint8_t i, uint32_t time_taken);
+
+    // report tasks whose max_time_micros is far from their runtime
+    void check_task_times();
+
     // function that is called before anything in the scheduler table:
     scheduler_fastloop_fn_t _fastloop_fn;
 
@@ -160,6 +235,35 @@ private:
 
     // loop rate in Hz as set at startup
     AP_Int16 _active_loop_rate_hz;
+
+    // bitmask of OPTION_* values
+    AP_Int8 _options;
+
+    // rate in Hz of task ticks, as set at startup
+    AP_Int16 _task_rate_hz;
+
+    // number of main loops per task tick, and main loops since the
+    // last one
+    uint8_t _loops_per_tick = 1;
+    uint8_t _loops_since_tick;
+
+    // true if due tasks were left out of the last run() for lack of
+    // time
+    bool _tasks_pending;
+
+    // next task to send in report_task_info()
+    uint8_t _report_task_index;
+
+#if AP_SCHEDULER_WORKERS_ENABLED
+    // number of worker threads for async-safe tasks
+    AP_Int8 _num_workers;
+
+    // run a due async-safe task on a worker. Returns true if the task
+    // has been handled and the main thread should move on
+    bool dispatch_async(uint8_t i);
+
+    AP_Scheduler_WorkerPool *_workers;
+#endif
     
     // calculated loop period in usec
     uint16_t _loop_period_us;
@@ -180,6 +284,10 @@ private:
     // tick counter at the time we last ran each task
     uint16_t *_last_run;
 
+    // dispatch order of due tasks, only allocated in
+    // earliest-deadline-first mode
+    uint8_t *_task_order;
+
     // number of microseconds allowed for the current task
     uint32_t _task_time_allowed;
 
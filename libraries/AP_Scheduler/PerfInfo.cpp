@@ -41,12 +41,16 @@ void AP::PerfInfo::check_loop_time(uint32_t time_in_micros)
 
     if( time_in_micros > max_time) {
         max_time = time_in_micros;
+        if (max_time > boot_max_time) {
+            boot_max_time = max_time;
+        }
     }
     if( min_time == 0 || time_in_micros < min_time) {
         min_time = time_in_micros;
     }
     if (time_in_micros > overtime_threshold_micros) {
         long_running++;
+        boot_long_running++;
     }
     sigma_time += time_in_micros;
     sigmasquared_time += time_in_micros * time_in_micros;
@@ -133,3 +137,138 @@ void AP::PerfInfo::set_loop_rate(uint16_t rate_hz)
         filtered_loop_time = 1.0f / rate_hz;
     }
 }
+
+// allocate_task_info - allocate per-task records. Returns false if
+// there is not enough memory
+bool AP::PerfInfo::allocate_task_info(uint8_t num_tasks)
+{
+    if (_task_info != nullptr) {
+        return true;
+    }
+    _task_info = new TaskInfo[num_tasks];
+    if (_task_info == nullptr) {
+        return false;
+    }
+    _num_tasks = num_tasks;
+    reset_task_info();
+    return true;
+}
+
+// reset_task_info - clear all per-task statistics
+void AP::PerfInfo::reset_task_info()
+{
+    if (_task_info == nullptr) {
+        return;
+    }
+    for (uint8_t i=0; i<_num_tasks; i++) {
+        // keep the last start time so jitter stays valid across resets
+        const uint32_t last_start_us = _task_info[i].last_start_us;
+        memset(&_task_info[i], 0, sizeof(_task_info[i]));
+        _task_info[i].last_start_us = last_start_us;
+    }
+}
+
+// update_task_info - record a run of a task
+void AP::PerfInfo::update_task_info(uint8_t task_index, uint32_t start_us, uint32_t time_taken_us, uint32_t expected_interval_us, bool overrun)
+{
+    if (_task_info == nullptr || task_index >= _num_tasks) {
+        return;
+    }
+    _task_info[task_index].update(start_us, time_taken_us, expected_interval_us, overrun);
+}
+
+// task_slipped - record that a task was due but could not be run
+void AP::PerfInfo::task_slipped(uint8_t task_index)
+{
+    if (_task_info == nullptr || task_index >= _num_tasks) {
+        return;
+    }
+    if (_task_info[task_index].slip_count < UINT16_MAX) {
+        _task_info[task_index].slip_count++;
+    }
+}
+
+// get_task_info - return per-task record, or nullptr if not available
+const AP::PerfInfo::TaskInfo *AP::PerfInfo::get_task_info(uint8_t task_index) const
+{
+    if (_task_info == nullptr || task_index >= _num_tasks) {
+        return nullptr;
+    }
+    return &_task_info[task_index];
+}
+
+void AP::PerfInfo::TaskInfo::update(uint32_t start_us, uint32_t time_taken_us, uint32_t expected_interval_us, bool overrun)
+{
+    tick_count++;
+    elapsed_time_us += time_taken_us;
+    const uint16_t time_us16 = MIN(time_taken_us, UINT16_MAX);
+    if (time_us16 > max_time_us) {
+        max_time_us = time_us16;
+    }
+    if (overrun && overrun_count < UINT16_MAX) {
+        overrun_count++;
+    }
+
+    // log2 histogram bucket
+    uint8_t bucket = 0;
+    uint32_t v = time_taken_us >> 3;
+    while (v != 0 && bucket < PERF_TASK_HISTOGRAM_BUCKETS-1) {
+        v >>= 1;
+        bucket++;
+    }
+    if (histogram[bucket] < UINT16_MAX) {
+        histogram[bucket]++;
+    }
+
+    // start-time jitter relative to the interval implied by rate_hz
+    if (last_start_us != 0) {
+        const uint32_t interval_us = start_us - last_start_us;
+        const uint32_t jitter_us = interval_us > expected_interval_us ?
+            interval_us - expected_interval_us : expected_interval_us - interval_us;
+        const uint16_t jitter_us16 = MIN(jitter_us, UINT16_MAX);
+        jitter_sum_us += jitter_us16;
+        if (jitter_us16 > max_jitter_us) {
+            max_jitter_us = jitter_us16;
+        }
+    }
+    last_start_us = start_us;
+}
+
+uint16_t AP::PerfInfo::TaskInfo::get_avg_time_us() const
+{
+    if (tick_count == 0) {
+        return 0;
+    }
+    return elapsed_time_us / tick_count;
+}
+
+uint16_t AP::PerfInfo::TaskInfo::get_avg_jitter_us() const
+{
+    // the first run of a task has no jitter sample
+    if (tick_count < 2) {
+        return 0;
+    }
+    return jitter_sum_us / (tick_count - 1);
+}
+
+// get_p99_time_us - return the upper edge of the histogram bucket
+// holding the 99th percentile runtime, capped at the maximum runtime
+uint16_t AP::PerfInfo::TaskInfo::get_p99_time_us() const
+{
+    uint32_t total = 0;
+    for (uint8_t i=0; i<PERF_TASK_HISTOGRAM_BUCKETS; i++) {
+        total += histogram[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    const uint32_t threshold = (total * 99 + 99) / 100;
+    uint32_t count = 0;
+    for (uint8_t i=0; i<PERF_TASK_HISTOGRAM_BUCKETS-1; i++) {
+        count += histogram[i];
+        if (count >= threshold) {
+            return MIN(uint32_t(8U << i), max_time_us);
+        }
+    }
+    return max_time_us;
+}
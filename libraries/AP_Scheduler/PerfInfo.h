@@ -2,12 +2,36 @@
 
 #include <stdint.h>
 
+// number of log2 buckets in the per-task runtime histogram. Bucket 0
+// holds runtimes below 8us, bucket N holds [2^(N+2), 2^(N+3)) and the
+// last bucket holds everything longer
+#define PERF_TASK_HISTOGRAM_BUCKETS 12
+
 namespace AP {
 
 class PerfInfo {
 public:
     PerfInfo() {}
 
+    // per-task accounting, one of these per entry in the scheduler
+    // task table
+    struct TaskInfo {
+        uint32_t tick_count;       // number of times the task has run
+        uint32_t elapsed_time_us;  // cumulative runtime
+        uint32_t jitter_sum_us;    // cumulative start-time jitter
+        uint32_t last_start_us;    // time the task last started
+        uint16_t max_time_us;      // longest single run
+        uint16_t max_jitter_us;    // largest start-time jitter
+        uint16_t slip_count;       // times the task was due but did not fit in the time available
+        uint16_t overrun_count;    // times the task exceeded its max_time_micros
+        uint16_t histogram[PERF_TASK_HISTOGRAM_BUCKETS];
+
+        void update(uint32_t start_us, uint32_t time_taken_us, uint32_t expected_interval_us, bool overrun);
+        uint16_t get_avg_time_us() const;
+        uint16_t get_avg_jitter_us() const;
+        uint16_t get_p99_time_us() const;
+    };
+
     /* Do not allow copies */
     PerfInfo(const PerfInfo &other) = delete;
     PerfInfo &operator=(const PerfInfo&) = delete;
@@ -19,6 +43,9 @@ public:
     uint32_t get_max_time() const;
     uint32_t get_min_time() const;
     uint16_t get_num_long_running() const;
+    // counts since boot, which reset() leaves alone
+    uint32_t get_boot_long_running() const { return boot_long_running; }
+    uint32_t get_boot_max_time() const { return boot_max_time; }
     uint32_t get_avg_time() const;
     uint32_t get_stddev_time() const;
     float    get_filtered_time() const;
@@ -26,6 +53,15 @@ public:
 
     void update_logging();
 
+    // per-task accounting
+    bool allocate_task_info(uint8_t num_tasks);
+    void update_task_info(uint8_t task_index, uint32_t start_us, uint32_t time_taken_us, uint32_t expected_interval_us, bool overrun);
+    void task_slipped(uint8_t task_index);
+    void reset_task_info();
+    bool has_task_info() const { return _task_info != nullptr; }
+    uint8_t get_num_tasks() const { return _num_tasks; }
+    const TaskInfo *get_task_info(uint8_t task_index) const;
+
 private:
     uint16_t loop_rate_hz;
     uint16_t overtime_threshold_micros;
@@ -35,10 +71,15 @@ private:
     uint64_t sigma_time;
     uint64_t sigmasquared_time;
     uint16_t long_running;
+    uint32_t boot_long_running;
+    uint32_t boot_max_time;
     uint32_t last_check_us;
     float filtered_loop_time;
     bool ignore_loop;
 
+    // per-task records, only allocated when task info is enabled
+    TaskInfo *_task_info;
+    uint8_t _num_tasks;
 };
 
 };
@@ -0,0 +1,113 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorkerPool.h"
+
+#include <AP_Math/AP_Math.h>
+
+#if AP_SCHEDULER_WORKERS_ENABLED
+
+extern const AP_HAL::HAL& hal;
+
+// how long an idle worker sleeps before checking the queue again
+#define WORKER_IDLE_SLEEP_US 500
+
+bool AP_Scheduler_WorkerPool::init(uint8_t num_workers, uint8_t num_tasks)
+{
+    if (num_workers == 0 || num_tasks == 0) {
+        return false;
+    }
+    _queue = new Job[num_tasks];
+    _busy = new bool[num_tasks];
+    if (_queue == nullptr || _busy == nullptr) {
+        delete[] _queue;
+        delete[] _busy;
+        _queue = nullptr;
+        _busy = nullptr;
+        return false;
+    }
+    memset(_busy, 0, sizeof(_busy[0]) * num_tasks);
+    _queue_size = num_tasks;
+    _num_tasks = num_tasks;
+
+    static const char *names[AP_SCHEDULER_MAX_WORKERS] = {
+        "sched_w0", "sched_w1", "sched_w2", "sched_w3"
+    };
+    num_workers = MIN(num_workers, AP_SCHEDULER_MAX_WORKERS);
+    for (uint8_t i=0; i<num_workers; i++) {
+        // run just below the main thread so a busy worker can't
+        // delay the fast loop
+        if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&AP_Scheduler_WorkerPool::worker_main, void),
+                                          names[i], 8192, AP_HAL::Scheduler::PRIORITY_MAIN, -1)) {
+            break;
+        }
+        _num_workers++;
+    }
+    return _num_workers > 0;
+}
+
+bool AP_Scheduler_WorkerPool::dispatch(uint8_t task_index, task_fn_t fn)
+{
+    if (task_index >= _num_tasks || _num_workers == 0) {
+        return false;
+    }
+    WITH_SEMAPHORE(_sem);
+    if (_busy[task_index] || _queue_count >= _queue_size) {
+        return false;
+    }
+    const uint8_t idx = (_queue_head + _queue_count) % _queue_size;
+    _queue[idx].fn = fn;
+    _queue[idx].task_index = task_index;
+    _queue_count++;
+    _busy[task_index] = true;
+    return true;
+}
+
+bool AP_Scheduler_WorkerPool::busy(uint8_t task_index)
+{
+    if (task_index >= _num_tasks) {
+        return false;
+    }
+    WITH_SEMAPHORE(_sem);
+    return _busy[task_index];
+}
+
+void AP_Scheduler_WorkerPool::worker_main()
+{
+    while (true) {
+        Job job;
+        bool have_job = false;
+        {
+            WITH_SEMAPHORE(_sem);
+            if (_queue_count > 0) {
+                job = _queue[_queue_head];
+                _queue_head = (_queue_head + 1) % _queue_size;
+                _queue_count--;
+                have_job = true;
+            }
+        }
+        if (!have_job) {
+            hal.scheduler->delay_microseconds(WORKER_IDLE_SLEEP_US);
+            continue;
+        }
+
+        job.fn();
+
+        WITH_SEMAPHORE(_sem);
+        _busy[job.task_index] = false;
+    }
+}
+
+#endif // AP_SCHEDULER_WORKERS_ENABLED
@@ -0,0 +1,81 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+  pool of worker threads used to run scheduler tasks that have been
+  marked as async-safe off the main thread
+ */
+#pragma once
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Common/Semaphore.h>
+
+#ifndef AP_SCHEDULER_WORKERS_ENABLED
+#define AP_SCHEDULER_WORKERS_ENABLED (CONFIG_HAL_BOARD == HAL_BOARD_LINUX || CONFIG_HAL_BOARD == HAL_BOARD_SITL)
+#endif
+
+#define AP_SCHEDULER_MAX_WORKERS 4
+
+#if AP_SCHEDULER_WORKERS_ENABLED
+
+class AP_Scheduler_WorkerPool {
+public:
+    FUNCTOR_TYPEDEF(task_fn_t, void);
+
+    AP_Scheduler_WorkerPool() {}
+
+    /* Do not allow copies */
+    AP_Scheduler_WorkerPool(const AP_Scheduler_WorkerPool &other) = delete;
+    AP_Scheduler_WorkerPool &operator=(const AP_Scheduler_WorkerPool&) = delete;
+
+    // start num_workers threads able to run jobs for up to num_tasks
+    // distinct tasks. Returns false if no worker could be started
+    bool init(uint8_t num_workers, uint8_t num_tasks);
+
+    // queue a job for task_index. Returns false if that task still
+    // has a job queued or running, in which case the caller should
+    // treat the task as not yet complete
+    bool dispatch(uint8_t task_index, task_fn_t fn);
+
+    // true if task_index has a job that has not yet completed
+    bool busy(uint8_t task_index);
+
+    uint8_t get_num_workers() const { return _num_workers; }
+
+private:
+    struct Job {
+        task_fn_t fn;
+        uint8_t task_index;
+    };
+
+    void worker_main();
+
+    HAL_Semaphore _sem;
+
+    // queue of pending jobs. Each task has at most one outstanding
+    // job, so num_tasks entries are always enough
+    Job *_queue;
+    uint8_t _queue_size;
+    uint8_t _queue_head;
+    uint8_t _queue_count;
+
+    // one flag per task, set from dispatch() until the job completes
+    bool *_busy;
+    uint8_t _num_tasks;
+
+    uint8_t _num_workers;
+};
+
+#endif // AP_SCHEDULER_WORKERS_ENABLED
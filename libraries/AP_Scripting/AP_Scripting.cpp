@@ -63,6 +63,24 @@ const AP_Param::GroupInfo AP_Scripting::var_info[] = {
     // @RebootRequired: True
     AP_GROUPINFO("HEAP_SIZE", 3, AP_Scripting, _script_heap_size, 32*1024),
 
+    // @Param: RUN_TIME
+    // @DisplayName: Scripting Run Time Limit
+    // @Description: The time a script may take each time it is run before it is stopped, as well as the limit set by VM_I_COUNT. 0 for no time limit
+    // @Units: us
+    // @Range: 0 1000000
+    // @Increment: 1000
+    // @User: Advanced
+    AP_GROUPINFO("RUN_TIME", 4, AP_Scripting, _script_run_time_us, 0),
+
+    // @Param: RUN_MEM
+    // @DisplayName: Scripting Run Memory Limit
+    // @Description: The memory a script may allocate, less what it frees, each time it is run before it is stopped. 0 for no memory limit
+    // @Units: B
+    // @Range: 0 1048576
+    // @Increment: 1024
+    // @User: Advanced
+    AP_GROUPINFO("RUN_MEM", 5, AP_Scripting, _script_run_mem, 0),
+
     AP_GROUPEND
 };
 
@@ -92,7 +110,8 @@ bool AP_Scripting::init(void) {
 }
 
 void AP_Scripting::thread(void) {
-    lua_scripts *lua = new lua_scripts(_script_vm_exec_count, _script_heap_size);
+    lua_scripts *lua = new lua_scripts(_script_vm_exec_count, _script_heap_size,
+                                        _script_run_time_us, _script_run_mem);
     if (lua == nullptr) {
         gcs().send_text(MAV_SEVERITY_CRITICAL, "Unable to allocate scripting memory");
         return;
@@ -103,6 +122,12 @@ void AP_Scripting::thread(void) {
     gcs().send_text(MAV_SEVERITY_CRITICAL, "Scripting has died");
 }
 
+void AP_Scripting::handle_message(uint32_t msgid) {
+    if (_enable) {
+        lua_scripts::message_received(msgid);
+    }
+}
+
 AP_Scripting *AP_Scripting::_singleton = nullptr;
 
 namespace AP {
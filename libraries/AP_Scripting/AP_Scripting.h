@@ -32,6 +32,9 @@ public:
 
     static AP_Scripting * get_singleton(void) { return _singleton; }
 
+    // wake scripts subscribed to MAVLink messages with this id
+    void handle_message(uint32_t msgid);
+
     static const struct AP_Param::GroupInfo var_info[];
 
 private:
@@ -42,6 +45,8 @@ private:
     AP_Int8 _enable;
     AP_Int32 _script_vm_exec_count;
     AP_Int32 _script_heap_size;
+    AP_Int32 _script_run_time_us;
+    AP_Int32 _script_run_mem;
 
     static AP_Scripting *_singleton;
 
@@ -2,9 +2,41 @@
 #include <GCS_MAVLink/GCS.h>
 #include <SRV_Channel/SRV_Channel.h>
 #include <AP_Common/Location.h>
+#include <AP_AHRS/AP_AHRS.h>
 
 #include "lua_bindings.h"
 
+// registry references to the userdata metatables, which are quicker to
+// fetch than looking them up by name
+static int location_metatable;
+static int vector3f_metatable;
+
+// get the userdata at arg, checking it has the metatable registered at
+// metatable_ref. Raises an error naming the expected type if it doesn't
+static void *check_userdata(lua_State *L, int arg, int metatable_ref, const char *type_name) {
+    void *data = lua_touserdata(L, arg);
+    if (data != nullptr && lua_getmetatable(L, arg)) {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, metatable_ref);
+        const bool match = lua_rawequal(L, -1, -2);
+        lua_pop(L, 2);
+        if (match) {
+            return data;
+        }
+    }
+    luaL_argerror(L, arg, lua_pushfstring(L, "`%s` expected", type_name));
+    return nullptr;
+}
+
+// push a new userdata of size bytes, zeroed, with the metatable
+// registered at metatable_ref
+static void *new_userdata(lua_State *L, size_t size, int metatable_ref) {
+    void *data = lua_newuserdata(L, size);
+    lua_rawgeti(L, LUA_REGISTRYINDEX, metatable_ref);
+    lua_setmetatable(L, -2);
+    memset(data, 0, size);
+    return data;
+}
+
 int check_arguments(lua_State *L, int expected_arguments, const char *fn_name);
 int check_arguments(lua_State *L, int expected_arguments, const char *fn_name) {
 #if defined(AP_SCRIPTING_CHECKS) && AP_SCRIPTING_CHECKS >= 1
@@ -65,17 +97,12 @@ static const luaL_Reg servo_functions[] =
 
 // location stuff
 static int new_location(lua_State *L) {
-    Location *loc = (Location *)lua_newuserdata(L, sizeof(Location));
-    luaL_getmetatable(L, "location");
-    lua_setmetatable(L, -2);
-    memset((void *)loc, 0, sizeof(Location));
+    new_userdata(L, sizeof(Location), location_metatable);
     return 1;
 }
 
 static Location *check_location(lua_State *L, int arg) {
-    void *data = luaL_checkudata(L, arg, "location");
-    luaL_argcheck(L, data != NULL, arg, "`location` expected");
-    return (Location *)data;
+    return (Location *)check_userdata(L, arg, location_metatable, "location");
 }
 
 static int location_lat(lua_State *L) {
@@ -316,29 +343,116 @@ static const luaL_Reg locationMeta[] = {
   {NULL, NULL}
 };
 
-static int ahrs_position(lua_State *L) {
-    check_arguments(L, 1, "ahrs:position");
+// Vector3f stuff
+static int new_vector3f(lua_State *L) {
+    new_userdata(L, sizeof(Vector3f), vector3f_metatable);
+    return 1;
+}
 
-    new_location(L);
-    Location *loc = check_location(L, -1);
+static Vector3f *check_vector3f(lua_State *L, int arg) {
+    return (Vector3f *)check_userdata(L, arg, vector3f_metatable, "vector3f");
+}
+
+// get or set one component of a vector
+static int vector3f_component(lua_State *L, float Vector3f::*component) {
+    Vector3f *v = check_vector3f(L, 1);
+    switch(lua_gettop(L)) {
+        case 1: // access
+            lua_pushnumber(L, v->*component);
+            return 1;
+        case 2: // set
+            v->*component = luaL_checknumber(L, 2);
+            return 0;
+        default:
+            return luaL_argerror(L, lua_gettop(L), "too many arguments");
+    }
+}
+
+static int vector3f_x(lua_State *L) {
+    return vector3f_component(L, &Vector3f::x);
+}
+
+static int vector3f_y(lua_State *L) {
+    return vector3f_component(L, &Vector3f::y);
+}
+
+static int vector3f_z(lua_State *L) {
+    return vector3f_component(L, &Vector3f::z);
+}
+
+static int vector3f_length(lua_State *L) {
+    check_arguments(L, 1, "vector3f:length");
+
+    lua_pushnumber(L, check_vector3f(L, 1)->length());
+
+    return 1;
+}
+
+static int vector3f_tostring(lua_State *L) {
+    Vector3f *v = check_vector3f(L, -1);
+    char buf[64] = {};
+    snprintf(buf, sizeof(buf), "Vector3f(%f, %f, %f)", (double)v->x, (double)v->y, (double)v->z);
+    lua_pushstring(L, buf);
+    return 1;
+}
+
+static const luaL_Reg vector3fLib[] = {
+  {"new", new_vector3f},
+  {NULL, NULL}
+};
+
+static const luaL_Reg vector3fMeta[] = {
+  {"x", vector3f_x},
+  {"y", vector3f_y},
+  {"z", vector3f_z},
+  {"length", vector3f_length},
+  {"__tostring", vector3f_tostring},
+  {NULL, NULL}
+};
+
+/*
+  bindings returning a location or vector take an optional userdata of
+  that type to write the result into, which is then returned, so a
+  script polling them each run can reuse one object and not make
+  garbage. Without it a new userdata is returned
+ */
+static void *result_userdata(lua_State *L, const char *fn_name, size_t size, int metatable_ref, const char *type_name) {
+    switch (lua_gettop(L)) {
+        case 1:
+            return new_userdata(L, size, metatable_ref);
+        case 2:
+            return check_userdata(L, 2, metatable_ref, type_name);
+        default:
+            luaL_error(L, "%s expected 1 or 2 arguments got %d", fn_name, lua_gettop(L));
+            return nullptr;
+    }
+}
+
+static int ahrs_position(lua_State *L) {
+    Location *loc = (Location *)result_userdata(L, "ahrs:position", sizeof(Location), location_metatable, "location");
     AP::ahrs().get_position(*loc);
 
     return 1;
 }
 
 static int ahrs_get_home(lua_State *L) {
-    check_arguments(L, 1, "ahrs:home");
-
-    new_location(L);
-    Location *loc = check_location(L, -1);
+    Location *loc = (Location *)result_userdata(L, "ahrs:home", sizeof(Location), location_metatable, "location");
     *loc = AP::ahrs().get_home();
 
     return 1;
 }
 
+static int ahrs_get_gyro(lua_State *L) {
+    Vector3f *v = (Vector3f *)result_userdata(L, "ahrs:gyro", sizeof(Vector3f), vector3f_metatable, "vector3f");
+    *v = AP::ahrs().get_gyro();
+
+    return 1;
+}
+
 static const luaL_Reg ahrsMeta[] = {
   {"position", ahrs_position},
   {"home", ahrs_get_home},
+  {"gyro", ahrs_get_gyro},
   {NULL, NULL}
 };
 
@@ -357,10 +471,20 @@ void load_lua_bindings(lua_State *L) {
     lua_pushstring(L, "__index");
     lua_pushvalue(L, -2);
     lua_settable(L, -3);
-    lua_pop(L, 1);
+    location_metatable = luaL_ref(L, LUA_REGISTRYINDEX);
     luaL_newlib(L, locLib);
     lua_setglobal(L, "loc");
 
+    // Vector3f metatable
+    luaL_newmetatable(L, "vector3f");
+    luaL_setfuncs(L, vector3fMeta, 0);
+    lua_pushstring(L, "__index");
+    lua_pushvalue(L, -2);
+    lua_settable(L, -3);
+    vector3f_metatable = luaL_ref(L, LUA_REGISTRYINDEX);
+    luaL_newlib(L, vector3fLib);
+    lua_setglobal(L, "vector3f");
+
     // ahrs metatable
     luaL_newmetatable(L, "ahrs");
     luaL_setfuncs(L, ahrsMeta, 0);
@@ -0,0 +1,152 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lua_pool.h"
+#include <AP_HAL/AP_HAL.h>
+
+static_assert(LUA_POOL_PAGE_SIZE / LUA_POOL_CLASS_SIZE <= UINT8_MAX, "too many blocks in a page");
+static_assert(LUA_POOL_CLASS_SIZE >= sizeof(void *) && LUA_POOL_CLASS_SIZE % 8 == 0, "blocks must hold and align a pointer");
+
+extern const AP_HAL::HAL& hal;
+
+bool lua_pool::init(void *heap, uint32_t size) {
+    const uint32_t num_pages = MIN(size / (LUA_POOL_PAGE_SIZE + sizeof(page)), NO_PAGE);
+    if (num_pages == 0) {
+        return false;
+    }
+    _pages = (page *)hal.util->heap_realloc(heap, nullptr, num_pages * sizeof(page));
+    if (_pages == nullptr) {
+        return false;
+    }
+    // keep the blocks 8 byte aligned, as the heap may not be
+    uint8_t *region = (uint8_t *)hal.util->heap_realloc(heap, nullptr, num_pages * LUA_POOL_PAGE_SIZE + 7);
+    if (region == nullptr) {
+        hal.util->heap_realloc(heap, _pages, 0);
+        _pages = nullptr;
+        return false;
+    }
+    _base = (uint8_t *)(((uintptr_t)region + 7) & ~(uintptr_t)7);
+    _num_pages = num_pages;
+
+    // all pages start free
+    for (uint16_t i=0; i<_num_pages; i++) {
+        _pages[i].next = i + 1 < _num_pages ? i + 1 : NO_PAGE;
+    }
+    _free_pages = 0;
+    for (uint8_t i=0; i<LUA_POOL_NUM_CLASSES; i++) {
+        _partial[i] = NO_PAGE;
+    }
+    return true;
+}
+
+void *lua_pool::allocate(uint32_t size) {
+    if (size == 0 || size > LUA_POOL_MAX_BLOCK || _pages == nullptr) {
+        return nullptr;
+    }
+    const uint8_t size_class = (size - 1) / LUA_POOL_CLASS_SIZE;
+
+    uint16_t index = _partial[size_class];
+    if (index == NO_PAGE) {
+        // cut a free page into blocks of this class
+        index = _free_pages;
+        if (index == NO_PAGE) {
+            _fallbacks++;
+            return nullptr;
+        }
+        _free_pages = _pages[index].next;
+
+        page &p = _pages[index];
+        const uint32_t block = class_size(size_class);
+        uint8_t *start = _base + index * LUA_POOL_PAGE_SIZE;
+        const uint8_t count = LUA_POOL_PAGE_SIZE / block;
+        for (uint8_t i=0; i<count; i++) {
+            *(void **)&start[i * block] = i + 1 < count ? &start[(i + 1) * block] : nullptr;
+        }
+        p.free_list = start;
+        p.size_class = size_class;
+        p.used = 0;
+        link_page(index);
+    }
+
+    page &p = _pages[index];
+    void *ret = p.free_list;
+    p.free_list = *(void **)ret;
+    p.used++;
+    if (p.free_list == nullptr) {
+        // full, so no longer a source of blocks
+        unlink_page(index);
+    }
+
+    _blocks++;
+    _block_bytes += class_size(size_class);
+    return ret;
+}
+
+void lua_pool::release(void *ptr) {
+    const uint16_t index = page_index(ptr);
+    page &p = _pages[index];
+    const bool was_full = p.free_list == nullptr;
+
+    *(void **)ptr = p.free_list;
+    p.free_list = ptr;
+    p.used--;
+
+    _blocks--;
+    _block_bytes -= class_size(p.size_class);
+
+    if (p.used == 0) {
+        // give the page back, so any class can use it
+        if (!was_full) {
+            unlink_page(index);
+        }
+        p.next = _free_pages;
+        _free_pages = index;
+    } else if (was_full) {
+        link_page(index);
+    }
+}
+
+void lua_pool::link_page(uint16_t index) {
+    page &p = _pages[index];
+    p.prev = NO_PAGE;
+    p.next = _partial[p.size_class];
+    if (p.next != NO_PAGE) {
+        _pages[p.next].prev = index;
+    }
+    _partial[p.size_class] = index;
+}
+
+void lua_pool::unlink_page(uint16_t index) {
+    page &p = _pages[index];
+    if (p.prev != NO_PAGE) {
+        _pages[p.prev].next = p.next;
+    } else {
+        _partial[p.size_class] = p.next;
+    }
+    if (p.next != NO_PAGE) {
+        _pages[p.next].prev = p.prev;
+    }
+}
+
+void lua_pool::get_stats(stats &s) const {
+    s.pages = _num_pages;
+    s.free_pages = 0;
+    for (uint16_t i=_free_pages; i != NO_PAGE; i = _pages[i].next) {
+        s.free_pages++;
+    }
+    s.blocks = _blocks;
+    s.block_bytes = _block_bytes;
+    s.fallbacks = _fallbacks;
+}
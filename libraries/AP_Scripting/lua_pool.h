@@ -0,0 +1,103 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <AP_Common/AP_Common.h>
+
+// blocks of up to LUA_POOL_MAX_BLOCK bytes come from the pool, in size
+// classes LUA_POOL_CLASS_SIZE bytes apart
+#define LUA_POOL_CLASS_SIZE  8
+#define LUA_POOL_MAX_BLOCK   64
+#define LUA_POOL_NUM_CLASSES (LUA_POOL_MAX_BLOCK / LUA_POOL_CLASS_SIZE)
+#define LUA_POOL_PAGE_SIZE   256
+
+/*
+  pool of small blocks for the Lua allocator.
+
+  Lua makes many small, short lived allocations, which left to the
+  heap are scattered through it and break up its free space. The pool
+  is one region taken from the heap, divided into pages. A page is
+  given to a size class when that class needs more blocks, is cut into
+  blocks of that size, and goes back to the free pages once all of its
+  blocks are released, so the small allocations stay packed together
+  and out of the rest of the heap.
+ */
+class lua_pool
+{
+public:
+    struct stats {
+        uint16_t pages;       // pages in the pool
+        uint16_t free_pages;  // pages not given to a size class
+        uint32_t blocks;      // blocks allocated
+        uint32_t block_bytes; // bytes in the allocated blocks
+        uint32_t fallbacks;   // allocations which fitted but found the pool full
+    };
+
+    // take about size bytes from heap for the pool. Returns false if
+    // the heap doesn't have them
+    bool init(void *heap, uint32_t size);
+
+    // allocate a block of at least size bytes. Returns nullptr if size
+    // is too large for the pool, or the pool is full
+    void *allocate(uint32_t size);
+
+    // return a block to the pool
+    void release(void *ptr);
+
+    // returns true if ptr is a block from the pool
+    bool owns(const void *ptr) const {
+        return ptr >= _base && ptr < _base + _num_pages * LUA_POOL_PAGE_SIZE;
+    }
+
+    // get the usable size of a block from the pool
+    uint32_t block_size(const void *ptr) const {
+        return class_size(_pages[page_index(ptr)].size_class);
+    }
+
+    void get_stats(stats &s) const;
+
+private:
+    static const uint16_t NO_PAGE = 0xFFFF;
+
+    struct page {
+        void *free_list;    // free blocks in the page, linked through their first word
+        uint8_t size_class; // size class the page is cut into
+        uint8_t used;       // blocks allocated from the page
+        uint16_t next;      // next page in the class's list, or of the free pages
+        uint16_t prev;      // previous page in the class's list
+    };
+
+    static uint32_t class_size(uint8_t size_class) {
+        return (size_class + 1) * LUA_POOL_CLASS_SIZE;
+    }
+
+    uint16_t page_index(const void *ptr) const {
+        return ((const uint8_t *)ptr - _base) / LUA_POOL_PAGE_SIZE;
+    }
+
+    // add a page to the list of pages of its class with free blocks
+    void link_page(uint16_t index);
+    void unlink_page(uint16_t index);
+
+    uint8_t *_base;
+    page *_pages;
+    uint16_t _num_pages;
+    uint16_t _free_pages; // first page not given to a class
+    uint16_t _partial[LUA_POOL_NUM_CLASSES]; // first page of each class with free blocks
+
+    uint32_t _blocks;
+    uint32_t _block_bytes;
+    uint32_t _fallbacks;
+};
@@ -17,9 +17,17 @@
 #include <AP_HAL/AP_HAL.h>
 #include <GCS_MAVLink/GCS.h>
 #include <AP_ROMFS/AP_ROMFS.h>
+#include <AP_Math/crc.h>
+#include <AP_Logger/AP_Logger.h>
+#include <AP_Notify/AP_Notify.h>
+#include <AP_GPS/AP_GPS.h>
+#include <RC_Channel/RC_Channel.h>
 
 #if HAL_OS_POSIX_IO
 #include <dirent.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #if HAL_OS_FATFS_IO
@@ -34,17 +42,84 @@
   #endif //HAL_OS_FATFS_IO
 #endif // SCRIPTING_DIRECTORY
 
+// compiled chunks of the scripts from SCRIPTING_DIRECTORY are kept here
+#ifndef SCRIPTING_CACHE_DIRECTORY
+  #define SCRIPTING_CACHE_DIRECTORY SCRIPTING_DIRECTORY "/cache"
+#endif
+
+// scripts embedded in the firmware are given names starting with this
+#define SCRIPTING_ROMFS_PREFIX "@ROMFS/"
+#define SCRIPTING_ROMFS_DIRECTORY "scripts"
+
+#define SCRIPTING_CACHE_MAGIC 0x43504C41 // "ALPC"
+
+// share of the heap set aside for the small block pool
+#ifndef SCRIPTING_POOL_PERCENT
+  #define SCRIPTING_POOL_PERCENT 50
+#endif
+
+// the collector starts a cycle once the heap grows by this percentage
+// since the last, and does this percentage of the allocation in work
+// each step. Both are lower than Lua's defaults of 200, so a cycle
+// starts before the fixed heap fills and steps inside a script are short
+#ifndef SCRIPTING_GC_PAUSE
+  #define SCRIPTING_GC_PAUSE 150
+#endif
+#ifndef SCRIPTING_GC_STEPMUL
+  #define SCRIPTING_GC_STEPMUL 100
+#endif
+
+// time which may be spent collecting garbage after each run
+#ifndef SCRIPTING_GC_TIME_US
+  #define SCRIPTING_GC_TIME_US 500
+#endif
+
+// while waiting for the next script, events are checked this often
+#ifndef SCRIPTING_EVENT_POLL_MS
+  #define SCRIPTING_EVENT_POLL_MS 20
+#endif
+
+// RC channels which can be watched for switch changes
+#define SCRIPTING_EVENT_RC_CHANNELS 16
+
+static_assert(SCRIPTING_MAX_MAVLINK_IDS <= 8, "MAVLink subscriptions must fit in mavlink_slots");
+
+// the hook checks a running script's budget after this many VM instructions
+#ifndef SCRIPTING_HOOK_INSTRUCTIONS
+  #define SCRIPTING_HOOK_INSTRUCTIONS 100
+#endif
+
 extern const AP_HAL::HAL& hal;
 
 bool lua_scripts::overtime;
 jmp_buf lua_scripts::panic_jmp;
-
-lua_scripts::lua_scripts(const AP_Int32 &vm_steps, const AP_Int32 &heap_size)
-    : _vm_steps(vm_steps) {
+lua_scripts::run_state lua_scripts::current;
+uint32_t lua_scripts::mavlink_ids[SCRIPTING_MAX_MAVLINK_IDS];
+uint8_t lua_scripts::num_mavlink_ids;
+uint32_t lua_scripts::mavlink_received;
+
+lua_scripts::lua_scripts(const AP_Int32 &vm_steps, const AP_Int32 &heap_size,
+                         const AP_Int32 &run_time_us, const AP_Int32 &run_mem)
+    : _vm_steps(vm_steps),
+      _run_time_us(run_time_us),
+      _run_mem(run_mem) {
     _heap = hal.util->allocate_heap_memory(heap_size);
+    if (_heap != nullptr) {
+        // without a pool everything comes from the heap
+        _pool.init(_heap, heap_size * SCRIPTING_POOL_PERCENT / 100);
+    }
 }
 
 void lua_scripts::hook(lua_State *L, lua_Debug *ar) {
+    if (!overtime) {
+        current.instructions += SCRIPTING_HOOK_INSTRUCTIONS;
+        if (current.instructions < current.instruction_limit &&
+            (current.time_limit_us == 0 || AP_HAL::micros() - current.start_us < current.time_limit_us)) {
+            // still within budget
+            return;
+        }
+    }
+
     lua_scripts::overtime = true;
 
     // we need to aggressively bail out as we are over time
@@ -61,8 +136,143 @@ int lua_scripts::atpanic(lua_State *L) {
     return 0;
 }
 
+/*
+  a compiled chunk in the cache is preceded by this header, which
+  records the source it was compiled from. Lua's own header on the
+  chunk checks it was compiled for this build's version and types
+ */
+struct PACKED cache_header {
+    uint32_t magic;
+    uint32_t source_size;
+    uint32_t source_crc;
+};
+
+// reads a compiled chunk from a file for lua_load()
+struct cache_reader {
+    FILE *f;
+    char buf[128];
+};
+
+static const char *cache_read(lua_State *L, void *ud, size_t *size) {
+    (void)L;
+    cache_reader *r = (cache_reader *)ud;
+    *size = fread(r->buf, 1, sizeof(r->buf), r->f);
+    return *size > 0 ? r->buf : nullptr;
+}
+
+static int cache_write(lua_State *L, const void *p, size_t size, void *ud) {
+    (void)L;
+    return fwrite(p, 1, size, (FILE *)ud) == size ? 0 : 1;
+}
+
+// get the size and CRC of a file, returning false if it can't be read
+static bool file_crc(const char *filename, uint32_t &size, uint32_t &crc) {
+    FILE *f = fopen(filename, "rb");
+    if (f == nullptr) {
+        return false;
+    }
+    uint8_t buf[128];
+    size = 0;
+    crc = 0;
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        crc = crc_crc32(crc, buf, n);
+        size += n;
+    }
+    const bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+/*
+  load the source of a script from the scripts directory, using its
+  compiled chunk from the cache if it was compiled from the same
+  source, so the parser, and the heap it needs, is only used when a
+  script is new or has changed
+ */
+int lua_scripts::load_cached(lua_State *L, const char *filename) {
+    uint32_t source_size, source_crc;
+    const char *basename = strrchr(filename, '/');
+    char cache_name[64];
+    if (!file_crc(filename, source_size, source_crc) ||
+        hal.util->snprintf(cache_name, sizeof(cache_name), "%s/%s", SCRIPTING_CACHE_DIRECTORY,
+                           basename ? basename + 1 : filename) >= (int)sizeof(cache_name)) {
+        // no cache for this one, let Lua report any problem with the file
+        return luaL_loadfilex(L, filename, "t");
+    }
+
+    FILE *f = fopen(cache_name, "rb");
+    if (f != nullptr) {
+        cache_header header;
+        if (fread(&header, sizeof(header), 1, f) == 1 &&
+            header.magic == SCRIPTING_CACHE_MAGIC &&
+            header.source_size == source_size &&
+            header.source_crc == source_crc) {
+            cache_reader reader;
+            reader.f = f;
+            lua_pushfstring(L, "@%s", filename);
+            const int error = lua_load(L, cache_read, &reader, lua_tostring(L, -1), "b");
+            lua_remove(L, -2);
+            if (error == LUA_OK) {
+                fclose(f);
+                return LUA_OK;
+            }
+            // a chunk from an older build, or a partly written one
+            lua_pop(L, 1);
+        }
+        fclose(f);
+    }
+
+    const int error = luaL_loadfilex(L, filename, "t");
+    if (error != LUA_OK) {
+        return error;
+    }
+
+    // save the compiled chunk for next time. Failing to is harmless
+    mkdir(SCRIPTING_CACHE_DIRECTORY, 0755);
+    f = fopen(cache_name, "wb");
+    if (f == nullptr) {
+        return LUA_OK;
+    }
+    const cache_header header { SCRIPTING_CACHE_MAGIC, source_size, source_crc };
+    const bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+                    lua_dump(L, cache_write, f, 0) == 0;
+    fclose(f);
+    if (!ok) {
+        unlink(cache_name);
+    }
+    return LUA_OK;
+}
+
+/*
+  load the chunk of a script, leaving it on the stack. Returns a Lua
+  error code, with the error message on the stack if it fails
+ */
+int lua_scripts::load_chunk(lua_State *L, const char *filename) {
+    if (strncmp(filename, SCRIPTING_ROMFS_PREFIX, strlen(SCRIPTING_ROMFS_PREFIX)) == 0) {
+        // embedded in the firmware, and may be source or compiled
+        uint32_t size;
+        char *data = (char *)AP_ROMFS::find_decompress(&filename[strlen(SCRIPTING_ROMFS_PREFIX)], size);
+        if (data == nullptr) {
+            lua_pushfstring(L, "cannot open %s", filename);
+            return LUA_ERRFILE;
+        }
+        const int error = luaL_loadbufferx(L, data, size, filename, "bt");
+        free(data);
+        return error;
+    }
+
+    const size_t length = strlen(filename);
+    if (length > 5 && strcmp(&filename[length-5], ".luac") == 0) {
+        // compiled with luac, which Lua checks matches this build
+        return luaL_loadfilex(L, filename, "b");
+    }
+
+    return load_cached(L, filename);
+}
+
 lua_scripts::script_info *lua_scripts::load_script(lua_State *L, char *filename) {
-    if (int error = luaL_loadfile(L, filename)) {
+    if (int error = load_chunk(L, filename)) {
         switch (error) {
             case LUA_ERRSYNTAX:
                 gcs().send_text(MAV_SEVERITY_CRITICAL, "Lua: Syntax error in %s", filename);
@@ -88,6 +298,7 @@ lua_scripts::script_info *lua_scripts::load_script(lua_State *L, char *filename)
         return nullptr;
     }
 
+    memset(new_script, 0, sizeof(script_info));
     new_script->name = filename;
     new_script->next = nullptr;
 
@@ -118,7 +329,7 @@ void lua_scripts::load_all_scripts_in_dir(lua_State *L, const char *dirname) {
         return;
     }
 
-    // load anything that ends in .lua
+    // load anything that ends in .lua, or .luac if compiled
     for (struct dirent *de=readdir(d); de; de=readdir(d)) {
         uint8_t length = strlen(de->d_name);
         if (length < 5) {
@@ -126,8 +337,9 @@ void lua_scripts::load_all_scripts_in_dir(lua_State *L, const char *dirname) {
             continue;
         }
 
-        if (strncmp(&de->d_name[length-4], ".lua", 4)) {
-            // doesn't end in .lua
+        if (strncmp(&de->d_name[length-4], ".lua", 4) &&
+            (length < 6 || strncmp(&de->d_name[length-5], ".luac", 5))) {
+            // doesn't end in .lua or .luac
             continue;
         }
 
@@ -151,6 +363,27 @@ void lua_scripts::load_all_scripts_in_dir(lua_State *L, const char *dirname) {
     closedir(d);
 }
 
+void lua_scripts::load_all_scripts_in_romfs(lua_State *L) {
+    uint16_t ofs = 0;
+    for (const char *name = AP_ROMFS::dir_list(SCRIPTING_ROMFS_DIRECTORY, ofs);
+         name != nullptr;
+         name = AP_ROMFS::dir_list(SCRIPTING_ROMFS_DIRECTORY, ofs)) {
+        size_t size = strlen(SCRIPTING_ROMFS_PREFIX) + strlen(name) + 1;
+        char * filename = (char *) hal.util->heap_realloc(_heap, nullptr, size);
+        if (filename == nullptr) {
+            continue;
+        }
+        snprintf(filename, size, "%s%s", SCRIPTING_ROMFS_PREFIX, name);
+
+        script_info * script = load_script(L, filename);
+        if (script == nullptr) {
+            hal.util->heap_realloc(_heap, filename, 0);
+            continue;
+        }
+        reschedule_script(script);
+    }
+}
+
 void lua_scripts::run_next_script(lua_State *L) {
     if (scripts == nullptr) {
 #if defined(AP_SCRIPTING_CHECKS) && AP_SCRIPTING_CHECKS >= 1
@@ -166,20 +399,42 @@ void lua_scripts::run_next_script(lua_State *L) {
     script_info *script = scripts;
     scripts = script->next;
 
-    // reset the hook to clear the counter
-    const int32_t vm_steps = MAX(_vm_steps, 1000);
-    lua_sethook(L, hook, LUA_MASKCOUNT, vm_steps);
+    // set the budget for this run, and reset the hook to clear the counter
+    current.instruction_limit = MAX(_vm_steps, 1000);
+    current.time_limit_us = MAX(_run_time_us, 0);
+    current.mem_limit = MAX(_run_mem, 0);
+    current.instructions = 0;
+    current.allocated = 0;
+    current.freed = 0;
+    current.mem_exceeded = false;
+    lua_sethook(L, hook, LUA_MASKCOUNT, SCRIPTING_HOOK_INSTRUCTIONS);
 
     // store top of stack so we can calculate the number of return values
     int stack_top = lua_gettop(L);
 
-    // pop the function to the top of the stack
+    // pop the function to the top of the stack, passing it the events
+    // which woke it
     lua_rawgeti(L, LUA_REGISTRYINDEX, script->lua_ref);
+    lua_pushinteger(L, script->pending_events);
+    script->pending_events = 0;
+
+    current.script = script;
+    current.start_us = AP_HAL::micros();
+    current.active = true;
+    const int error = lua_pcall(L, 1, LUA_MULTRET, 0);
+    record_run(L, script);
+    current.script = nullptr;
 
-    if(lua_pcall(L, 0, LUA_MULTRET, 0)) {
+    if (error) {
         if (overtime) {
             // script has consumed an excessive amount of CPU time
-            gcs().send_text(MAV_SEVERITY_CRITICAL, "Lua: %s exceeded time limit (%d)", script->name,  vm_steps);
+            gcs().send_text(MAV_SEVERITY_CRITICAL, "Lua: %s exceeded time limit (%u instructions)",
+                            script->name, (unsigned)current.instructions);
+            remove_script(L, script);
+        } else if (error == LUA_ERRMEM && current.mem_exceeded) {
+            // script tried to allocate more than a run is allowed
+            gcs().send_text(MAV_SEVERITY_CRITICAL, "Lua: %s exceeded memory limit (%u bytes)",
+                            script->name, (unsigned)current.mem_limit);
             remove_script(L, script);
         } else {
             gcs().send_text(MAV_SEVERITY_INFO, "Lua: %s", lua_tostring(L, -1));
@@ -232,6 +487,226 @@ void lua_scripts::run_next_script(lua_State *L) {
      }
 }
 
+void lua_scripts::message_received(uint32_t msgid) {
+    const uint8_t count = __atomic_load_n(&num_mavlink_ids, __ATOMIC_ACQUIRE);
+    for (uint8_t i=0; i<count; i++) {
+        if (mavlink_ids[i] == msgid) {
+            __atomic_fetch_or(&mavlink_received, 1U<<i, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+void lua_scripts::check_events(void) {
+    uint8_t subscribed = 0;
+    for (script_info *script = scripts; script != nullptr; script = script->next) {
+        subscribed |= script->events;
+    }
+    if (subscribed == 0) {
+        // nothing to wake, and the state will be stale by the time
+        // something subscribes
+        _events_primed = false;
+        return;
+    }
+
+    const uint8_t mode = AP_Notify::flags.flight_mode;
+    const bool armed = hal.util->get_soft_armed();
+    const uint8_t gps_status = AP::gps().status();
+    uint32_t rc_positions = 0;
+    for (uint8_t i=0; i<SCRIPTING_EVENT_RC_CHANNELS; i++) {
+        // the same thresholds as RC auxiliary switches
+        const uint16_t pwm = RC_Channels::get_radio_in(i);
+        const uint32_t position = pwm < 1200 ? 0 : (pwm > 1800 ? 2 : 1);
+        rc_positions |= position << (i*2);
+    }
+
+    uint8_t fired = 0;
+    uint16_t rc_changed = 0;
+    if (_events_primed) {
+        if (mode != _last_mode) {
+            fired |= EVENT_MODE;
+        }
+        if (armed != _last_armed) {
+            fired |= EVENT_ARMING;
+        }
+        if (gps_status != _last_gps_status) {
+            fired |= EVENT_GPS_FIX;
+        }
+        const uint32_t rc_diff = rc_positions ^ _last_rc_positions;
+        for (uint8_t i=0; i<SCRIPTING_EVENT_RC_CHANNELS; i++) {
+            if ((rc_diff >> (i*2)) & 0x3) {
+                rc_changed |= 1U<<i;
+            }
+        }
+    }
+    _events_primed = true;
+    _last_mode = mode;
+    _last_armed = armed;
+    _last_gps_status = gps_status;
+    _last_rc_positions = rc_positions;
+
+    const uint32_t mavlink_fired = __atomic_exchange_n(&mavlink_received, 0, __ATOMIC_RELAXED);
+    if (fired == 0 && rc_changed == 0 && mavlink_fired == 0) {
+        return;
+    }
+
+    // take the woken scripts out of the list, then put them back due now
+    script_info *woken = nullptr;
+    for (script_info **link = &scripts; *link != nullptr; ) {
+        script_info *script = *link;
+        uint8_t matched = script->events & fired;
+        if (script->rc_channels & rc_changed) {
+            matched |= EVENT_RC_SWITCH;
+        }
+        if (script->mavlink_slots & mavlink_fired) {
+            matched |= EVENT_MAVLINK;
+        }
+        if (matched == 0) {
+            link = &script->next;
+            continue;
+        }
+        *link = script->next;
+        script->pending_events |= matched;
+        script->next = woken;
+        woken = script;
+    }
+
+    const uint64_t now_ms = AP_HAL::millis64();
+    while (woken != nullptr) {
+        script_info *script = woken;
+        woken = script->next;
+        script->next_run_ms = MIN(script->next_run_ms, now_ms);
+        reschedule_script(script);
+    }
+}
+
+int lua_scripts::events_subscribe(lua_State *L) {
+    script_info *script = current.script;
+    if (script == nullptr) {
+        return luaL_error(L, "events can only be subscribed to by a running script");
+    }
+
+    const lua_Integer event = luaL_checkinteger(L, 1);
+    switch (event) {
+        case EVENT_MODE:
+        case EVENT_ARMING:
+        case EVENT_GPS_FIX:
+            break;
+        case EVENT_RC_SWITCH:
+            {
+                const lua_Integer chan = luaL_checkinteger(L, 2);
+                luaL_argcheck(L, ((chan >= 1) && (chan <= SCRIPTING_EVENT_RC_CHANNELS)), 2, "channel out of range");
+                script->rc_channels |= 1U << (chan - 1);
+                break;
+            }
+        case EVENT_MAVLINK:
+            {
+                const lua_Integer msgid = luaL_checkinteger(L, 2);
+                luaL_argcheck(L, ((msgid >= 0) && (msgid <= 0xFFFFFF)), 2, "message id out of range");
+                uint8_t slot = 0;
+                while (slot < num_mavlink_ids && mavlink_ids[slot] != (uint32_t)msgid) {
+                    slot++;
+                }
+                if (slot == num_mavlink_ids) {
+                    if (slot == SCRIPTING_MAX_MAVLINK_IDS) {
+                        return luaL_error(L, "too many MAVLink messages subscribed to");
+                    }
+                    // only this thread adds ids, so it's enough to publish the count after the id
+                    mavlink_ids[slot] = msgid;
+                    __atomic_store_n(&num_mavlink_ids, slot + 1, __ATOMIC_RELEASE);
+                }
+                script->mavlink_slots |= 1U << slot;
+                break;
+            }
+        default:
+            return luaL_argerror(L, 1, "unknown event");
+    }
+    script->events |= event;
+    return 0;
+}
+
+int lua_scripts::events_unsubscribe(lua_State *L) {
+    script_info *script = current.script;
+    if (script == nullptr) {
+        return luaL_error(L, "events can only be unsubscribed from by a running script");
+    }
+
+    const lua_Integer event = luaL_checkinteger(L, 1);
+    if (event & EVENT_RC_SWITCH) {
+        script->rc_channels = 0;
+    }
+    if (event & EVENT_MAVLINK) {
+        script->mavlink_slots = 0;
+    }
+    script->events &= ~event;
+    return 0;
+}
+
+void lua_scripts::record_run(lua_State *L, script_info *script) {
+    const uint32_t run_end_us = AP_HAL::micros();
+    current.active = false;
+
+    // finalizers run by the collector must not trip the hook outside
+    // of the script's pcall
+    lua_sethook(L, nullptr, 0, 0);
+    const uint32_t run_time_us = run_end_us - current.start_us;
+
+    // collect garbage now, for up to SCRIPTING_GC_TIME_US or the end of
+    // the cycle, so the cost lands on the script which made it rather
+    // than on whichever script allocates next
+    bool cycle_done;
+    uint32_t gc_time_us;
+    do {
+        cycle_done = lua_gc(L, LUA_GCSTEP, 0);
+        gc_time_us = AP_HAL::micros() - run_end_us;
+    } while (!cycle_done && gc_time_us < SCRIPTING_GC_TIME_US);
+
+    script->run_count++;
+    script->instructions += current.instructions;
+    script->run_time_us += run_time_us;
+    script->max_run_time_us = MAX(script->max_run_time_us, run_time_us);
+    script->gc_time_us += gc_time_us;
+    script->allocated += current.allocated;
+    script->freed += current.freed;
+
+    const uint32_t heap_used = lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
+    gcs().send_text(MAV_SEVERITY_DEBUG, "Lua: Time: %u Mem: %d", (unsigned)run_time_us,
+                    (int)(current.allocated - current.freed));
+
+    const char *basename = strrchr(script->name, '/');
+    AP::logger().Write("SCR", "TimeUS,Name,Instr,RunUS,GcUS,Alloc,Free,Mem", "QNIIIIII",
+                       AP_HAL::micros64(),
+                       basename ? basename + 1 : script->name,
+                       current.instructions,
+                       run_time_us,
+                       gc_time_us,
+                       current.allocated,
+                       current.freed,
+                       heap_used);
+
+    log_pool_stats();
+}
+
+void lua_scripts::log_pool_stats(void) {
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - _last_pool_log_ms < 1000) {
+        return;
+    }
+    _last_pool_log_ms = now_ms;
+
+    lua_pool::stats stats;
+    _pool.get_stats(stats);
+    // bytes in the pages given to size classes which are not allocated
+    const uint32_t unused_bytes = (stats.pages - stats.free_pages) * LUA_POOL_PAGE_SIZE - stats.block_bytes;
+    AP::logger().Write("SCRP", "TimeUS,Pages,FreePg,Blocks,Bytes,Unused,Fallback", "QHHIIII",
+                       AP_HAL::micros64(),
+                       stats.pages,
+                       stats.free_pages,
+                       stats.blocks,
+                       stats.block_bytes,
+                       unused_bytes,
+                       stats.fallbacks);
+}
+
 void lua_scripts::remove_script(lua_State *L, script_info *script) {
     if (script == nullptr) {
         return;
@@ -295,10 +770,73 @@ void lua_scripts::reschedule_script(script_info *script) {
 }
 
 void *lua_scripts::_heap;
+lua_pool lua_scripts::_pool;
+
+void *lua_scripts::pool_realloc(void *ptr, size_t osize, size_t nsize) {
+    const bool in_pool = _pool.owns(ptr);
+    if (nsize == 0) {
+        if (in_pool) {
+            _pool.release(ptr);
+        } else if (ptr != nullptr) {
+            hal.util->heap_realloc(_heap, ptr, 0);
+        }
+        return nullptr;
+    }
+
+    if (in_pool && nsize <= _pool.block_size(ptr) && nsize + LUA_POOL_CLASS_SIZE > _pool.block_size(ptr)) {
+        // still the same size class
+        return ptr;
+    }
+
+    void *new_ptr = _pool.allocate(nsize);
+    if (new_ptr == nullptr) {
+        if (ptr != nullptr && !in_pool) {
+            new_ptr = hal.util->heap_realloc(_heap, ptr, nsize);
+            // Lua assumes shrinking never fails, and the old block is still good
+            return (new_ptr == nullptr && nsize <= osize) ? ptr : new_ptr;
+        }
+        new_ptr = hal.util->heap_realloc(_heap, nullptr, nsize);
+        if (new_ptr == nullptr) {
+            return (ptr != nullptr && nsize <= osize) ? ptr : nullptr;
+        }
+    }
+
+    if (ptr != nullptr) {
+        memcpy(new_ptr, ptr, MIN(osize, nsize));
+        if (in_pool) {
+            _pool.release(ptr);
+        } else {
+            hal.util->heap_realloc(_heap, ptr, 0);
+        }
+    }
+    return new_ptr;
+}
 
 void *lua_scripts::alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
-    (void)ud; (void)osize;  /* not used */
-    return hal.util->heap_realloc(_heap, ptr, nsize);
+    (void)ud;  /* not used */
+    if (!current.active) {
+        return pool_realloc(ptr, osize, nsize);
+    }
+
+    // when ptr is null osize is the type of object being allocated
+    const size_t old_size = ptr != nullptr ? osize : 0;
+    if (nsize > old_size && current.mem_limit != 0 &&
+        current.allocated + (nsize - old_size) > current.freed + current.mem_limit) {
+        // Lua raises a memory error in the script. Shrinking must never
+        // fail, so only growth is refused
+        current.mem_exceeded = true;
+        return nullptr;
+    }
+
+    void *ret = pool_realloc(ptr, osize, nsize);
+    if (ret != nullptr || nsize == 0) {
+        if (nsize > old_size) {
+            current.allocated += nsize - old_size;
+        } else {
+            current.freed += old_size - nsize;
+        }
+    }
+    return ret;
 }
 
 void lua_scripts::run(void) {
@@ -318,6 +856,8 @@ void lua_scripts::run(void) {
         }
         scripts = nullptr;
         overtime = false;
+        current.active = false;
+        current.script = nullptr;
     }
 
     lua_state = lua_newstate(alloc, NULL);
@@ -327,9 +867,34 @@ void lua_scripts::run(void) {
         return;
     }
     lua_atpanic(L, atpanic);
+    lua_gc(L, LUA_GCSETPAUSE, SCRIPTING_GC_PAUSE);
+    lua_gc(L, LUA_GCSETSTEPMUL, SCRIPTING_GC_STEPMUL);
     luaL_openlibs(L);
     load_lua_bindings(L);
 
+    // event subscription, which is bound here as it needs the running script
+    static const luaL_Reg events_functions[] = {
+        {"subscribe", events_subscribe},
+        {"unsubscribe", events_unsubscribe},
+        {NULL, NULL}
+    };
+    luaL_newlib(L, events_functions);
+    static const struct {
+        const char *name;
+        event_type event;
+    } events[] = {
+        {"MODE", EVENT_MODE},
+        {"ARMING", EVENT_ARMING},
+        {"GPS_FIX", EVENT_GPS_FIX},
+        {"RC_SWITCH", EVENT_RC_SWITCH},
+        {"MAVLINK", EVENT_MAVLINK},
+    };
+    for (uint8_t i=0; i<ARRAY_SIZE(events); i++) {
+        lua_pushinteger(L, events[i].event);
+        lua_setfield(L, -2, events[i].name);
+    }
+    lua_setglobal(L, "events");
+
     // load the sandbox creation function
     uint32_t sandbox_size;
     char *sandbox_data = (char *)AP_ROMFS::find_decompress("sandbox.lua", sandbox_size);
@@ -344,7 +909,8 @@ void lua_scripts::run(void) {
     }
     free(sandbox_data);
 
-    // Scan the filesystem in an appropriate manner and autostart scripts
+    // Scan the firmware and the filesystem in an appropriate manner and autostart scripts
+    load_all_scripts_in_romfs(L);
     load_all_scripts_in_dir(L, SCRIPTING_DIRECTORY);
 
     while (true) {
@@ -366,23 +932,24 @@ void lua_scripts::run(void) {
               }
 #endif // defined(AP_SCRIPTING_CHECKS) && AP_SCRIPTING_CHECKS >= 1
 
-            // compute delay time
+            // compute delay time, waking early for scripts woken by events
+            check_events();
             uint64_t now_ms = AP_HAL::millis64();
-            if (now_ms < scripts->next_run_ms) {
-                hal.scheduler->delay(scripts->next_run_ms - now_ms);
+            while (now_ms < scripts->next_run_ms) {
+                if (!_events_primed) {
+                    // nothing is waiting for an event
+                    hal.scheduler->delay(scripts->next_run_ms - now_ms);
+                    break;
+                }
+                hal.scheduler->delay(MIN(scripts->next_run_ms - now_ms, (uint64_t)SCRIPTING_EVENT_POLL_MS));
+                check_events();
+                now_ms = AP_HAL::millis64();
             }
 
             gcs().send_text(MAV_SEVERITY_DEBUG, "Lua: Running %s", scripts->name);
 
-            const uint32_t startMem = lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
-            const uint32_t loadEnd = AP_HAL::micros();
-
             run_next_script(L);
 
-            const uint32_t runEnd = AP_HAL::micros();
-            const uint32_t endMem = lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
-            gcs().send_text(MAV_SEVERITY_DEBUG, "Lua: Time: %d Mem: %d", runEnd - loadEnd, endMem - startMem);
-
         } else {
             gcs().send_text(MAV_SEVERITY_DEBUG, "Lua: No scripts to run");
             hal.scheduler->delay(10000);
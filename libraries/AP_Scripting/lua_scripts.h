@@ -19,11 +19,18 @@
 #include <setjmp.h>
 
 #include "lua_bindings.h"
+#include "lua_pool.h"
+
+// number of different MAVLink messages scripts can subscribe to
+#ifndef SCRIPTING_MAX_MAVLINK_IDS
+  #define SCRIPTING_MAX_MAVLINK_IDS 8
+#endif
 
 class lua_scripts
 {
 public:
-    lua_scripts(const AP_Int32 &vm_steps, const AP_Int32 &heap_size);
+    lua_scripts(const AP_Int32 &vm_steps, const AP_Int32 &heap_size,
+                const AP_Int32 &run_time_us, const AP_Int32 &run_mem);
 
     /* Do not allow copies */
     lua_scripts(const lua_scripts &other) = delete;
@@ -33,6 +40,21 @@ public:
     void run(void);
 
     static bool overtime; // script exceeded it's execution slot, and we are bailing out
+
+    // wake the scripts subscribed to MAVLink messages with this id.
+    // Safe to call from any thread
+    static void message_received(uint32_t msgid);
+
+    // kinds of event a script can subscribe to, passed to it as a mask
+    // when it is woken by one
+    enum event_type : uint8_t {
+        EVENT_MODE      = (1U<<0), // flight mode changed
+        EVENT_ARMING    = (1U<<1), // vehicle armed or disarmed
+        EVENT_GPS_FIX   = (1U<<2), // fix status of the primary GPS changed
+        EVENT_RC_SWITCH = (1U<<3), // a watched RC channel moved to another switch position
+        EVENT_MAVLINK   = (1U<<4), // a watched MAVLink message arrived
+    };
+
 private:
 
     typedef struct script_info {
@@ -40,14 +62,78 @@ private:
        uint64_t next_run_ms; // time (in milliseconds) the script should next be run at
        char *name;           // filename for the script // FIXME: This information should be available from Lua
        script_info *next;
+
+       // accounting for the script, over all of its runs
+       uint32_t run_count;       // number of times the script has been run
+       uint64_t instructions;    // VM instructions executed, to within SCRIPTING_HOOK_INSTRUCTIONS a run
+       uint64_t run_time_us;     // time spent running
+       uint32_t max_run_time_us; // longest single run
+       uint64_t gc_time_us;      // time spent collecting garbage after runs
+       uint64_t allocated;       // bytes allocated by the script
+       uint64_t freed;           // bytes freed while the script was running
+
+       // events the script is woken by
+       uint8_t events;           // event_type mask subscribed to
+       uint8_t pending_events;   // event_type mask fired since the script last ran
+       uint16_t rc_channels;     // RC channels watched, bit 0 is channel 1
+       uint8_t mavlink_slots;    // entries of mavlink_ids watched
     } script_info;
 
+    // accounting for the script which is currently running, kept
+    // statically so the hook and allocator can reach it
+    struct run_state {
+        bool active;                // a script is running, so account for it
+        bool mem_exceeded;          // the script was refused memory
+        uint32_t instructions;      // VM instructions executed this run
+        uint32_t start_us;          // time the run started
+        uint32_t allocated;         // bytes allocated this run
+        uint32_t freed;             // bytes freed this run
+        uint32_t instruction_limit; // VM instructions allowed per run
+        uint32_t time_limit_us;     // time allowed per run, 0 for no limit
+        uint32_t mem_limit;         // net bytes a run may allocate, 0 for no limit
+        script_info *script;        // the script
+    };
+    static run_state current;
+
+    // stop accounting for the script which has just run, collect its
+    // garbage, then add the run to its totals and log them
+    void record_run(lua_State *L, script_info *script);
+
+    int load_chunk(lua_State *L, const char *filename);
+
+    int load_cached(lua_State *L, const char *filename);
+
     script_info *load_script(lua_State *L, char *filename);
 
     void load_all_scripts_in_dir(lua_State *L, const char *dirname);
 
+    // load the scripts embedded in the firmware
+    void load_all_scripts_in_romfs(lua_State *L);
+
     void run_next_script(lua_State *L);
 
+    // look for events scripts are subscribed to, and bring the
+    // scripts they wake to the front of the list
+    void check_events(void);
+
+    // state the events are detected from, as of the last check
+    bool _events_primed;
+    uint8_t _last_mode;
+    bool _last_armed;
+    uint8_t _last_gps_status;
+    uint32_t _last_rc_positions; // two bits for each channel
+
+    // MAVLink message ids watched by any script, and the entries
+    // received since the last check
+    static uint32_t mavlink_ids[SCRIPTING_MAX_MAVLINK_IDS];
+    static uint8_t num_mavlink_ids;
+    static uint32_t mavlink_received;
+
+    // bindings to subscribe the running script to an event, and to
+    // unsubscribe it
+    static int events_subscribe(lua_State *L);
+    static int events_unsubscribe(lua_State *L);
+
     void remove_script(lua_State *L, script_info *script);
 
     // reschedule the script for execution. It is assumed the script is not in the list already
@@ -55,7 +141,8 @@ private:
 
     script_info *scripts; // linked list of scripts to be run, sorted by next run time (soonest first)
 
-    // hook will be run when CPU time for a script is exceeded
+    // hook will be run every SCRIPTING_HOOK_INSTRUCTIONS instructions, and
+    // stops the script once its instruction or CPU time budget is used
     // it must be static to be passed to the C API
     static void hook(lua_State *L, lua_Debug *ar);
 
@@ -66,8 +153,19 @@ private:
     lua_State *lua_state;
 
     const AP_Int32 & _vm_steps;
+    const AP_Int32 & _run_time_us;
+    const AP_Int32 & _run_mem;
 
     static void *alloc(void *ud, void *ptr, size_t osize, size_t nsize);
 
+    // resize a block, taking small blocks from the pool and the rest
+    // from the heap
+    static void *pool_realloc(void *ptr, size_t osize, size_t nsize);
+
+    // log the pool statistics, at most once a second
+    void log_pool_stats(void);
+    uint32_t _last_pool_log_ms;
+
     static void *_heap;
+    static lua_pool _pool;
 };
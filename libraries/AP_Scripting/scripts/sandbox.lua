@@ -32,6 +32,10 @@ function get_sandbox_env ()
           gcs = { send_text = gcs.send_text},
           servo = { set_output_pwm = servo.set_output_pwm},
           location = { new = loc.new},
+          vector3f = { new = vector3f.new},
+          events = { subscribe = events.subscribe, unsubscribe = events.unsubscribe,
+                     MODE = events.MODE, ARMING = events.ARMING, GPS_FIX = events.GPS_FIX,
+                     RC_SWITCH = events.RC_SWITCH, MAVLINK = events.MAVLINK },
           ahrs = ahrs
         }
 end
@@ -105,6 +105,7 @@ public:
         SerialProtocol_Devo_Telem = 17,
         SerialProtocol_OpticalFlow = 18,
         SerialProtocol_Robotis = 19,
+        SerialProtocol_MAVLinkHighRate = 20,         // MAVLink2 with high rate subscriptions
     };
 
     // get singleton instance
@@ -30,8 +30,8 @@ const AP_Param::GroupInfo AP_SmartRTL::var_info[] = {
 
     // @Param: POINTS
     // @DisplayName: SmartRTL maximum number of points on path
-    // @Description: SmartRTL maximum number of points on path. Set to 0 to disable SmartRTL.  100 points consumes about 3k of memory.
-    // @Range: 0 500
+    // @Description: SmartRTL maximum number of points on path. Set to 0 to disable SmartRTL.  100 points consumes about 1.5k of memory.  Boards with HAL_MINIMIZE_FEATURES are limited to 500 points.
+    // @Range: 0 5000
     // @User: Advanced
     // @RebootRequired: True
     AP_GROUPINFO("POINTS", 1, AP_SmartRTL, _points_max, SMARTRTL_POINTS_DEFAULT),
@@ -61,9 +61,11 @@ const AP_Param::GroupInfo AP_SmartRTL::var_info[] = {
 *    for a more complete description.
 *
 *    The simplification and pruning algorithms run in the background and do not
-*    alter the path in memory.  Two definitions, SMARTRTL_SIMPLIFY_TIME_US and
-*    SMARTRTL_PRUNING_LOOP_TIME_US are used to limit how long each algorithm will
-*    be run before they save their state and return.
+*    alter the path in memory.  They run in their own thread where the board can
+*    create one, otherwise in the IO thread where two definitions,
+*    SMARTRTL_SIMPLIFY_TIME_US and SMARTRTL_PRUNING_LOOP_TIME_US are used to
+*    limit how long each algorithm will be run before they save their state and
+*    return.
 *
 *    Both algorithms are "anytime algorithms" meaning they can be interrupted
 *    before they complete which is helpful when memory is filling up and we just
@@ -80,7 +82,6 @@ AP_SmartRTL::AP_SmartRTL(bool example_mode) :
     _example_mode(example_mode)
 {
     AP_Param::setup_object_defaults(this, var_info);
-    _simplify.bitmask.setall();
 }
 
 // initialise safe rtl including setting up background processes
@@ -100,7 +101,8 @@ void AP_SmartRTL::init()
     }
 
     // allocate arrays
-    _path = (Vector3f*)calloc(_points_max, sizeof(Vector3f));
+    _path = (path_point_t*)calloc(_points_max, sizeof(path_point_t));
+    _path_blocks = (path_block_t*)calloc((_points_max + SMARTRTL_PATH_BLOCK_LEN - 1) / SMARTRTL_PATH_BLOCK_LEN, sizeof(path_block_t));
 
     _prune.loops_max = _points_max * SMARTRTL_PRUNING_LOOP_BUFFER_LEN_MULT;
     _prune.loops = (prune_loop_t*)calloc(_prune.loops_max, sizeof(prune_loop_t));
@@ -108,22 +110,44 @@ void AP_SmartRTL::init()
     _simplify.stack_max = _points_max * SMARTRTL_SIMPLIFY_STACK_LEN_MULT;
     _simplify.stack = (simplify_start_finish_t*)calloc(_simplify.stack_max, sizeof(simplify_start_finish_t));
 
+    _simplify.bitmask = new Bitmask(_points_max);
+
     // check if memory allocation failed
-    if (_path == nullptr || _prune.loops == nullptr || _simplify.stack == nullptr) {
+    if (_path == nullptr || _path_blocks == nullptr || _prune.loops == nullptr || _simplify.stack == nullptr || _simplify.bitmask == nullptr) {
         log_action(SRTL_DEACTIVATED_INIT_FAILED);
         gcs().send_text(MAV_SEVERITY_WARNING, "SmartRTL deactivated: init failed");
         free(_path);
+        free(_path_blocks);
         free(_prune.loops);
         free(_simplify.stack);
+        delete _simplify.bitmask;
+        _path = nullptr;
+        _path_blocks = nullptr;
+        _simplify.bitmask = nullptr;
         return;
     }
+    _simplify.bitmask->setall();
 
     _path_points_max = _points_max;
 
     // when running the example sketch, we want the cleanup tasks to run when we tell them to, not in the background (so that they can be timed.)
     if (!_example_mode){
-        // register background cleanup to run in IO thread
-        hal.scheduler->register_io_process(FUNCTOR_BIND_MEMBER(&AP_SmartRTL::run_background_cleanup, void));
+        // run background cleanup in its own thread so it can run each step to completion,
+        // falling back to time sliced steps in the IO thread
+        if (hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&AP_SmartRTL::cleanup_thread, void), "SmartRTL", 2048, AP_HAL::Scheduler::PRIORITY_IO, -1)) {
+            _time_sliced = false;
+        } else {
+            hal.scheduler->register_io_process(FUNCTOR_BIND_MEMBER(&AP_SmartRTL::run_background_cleanup, void));
+        }
+    }
+}
+
+// main loop of the cleanup thread
+void AP_SmartRTL::cleanup_thread()
+{
+    while (true) {
+        hal.scheduler->delay(SMARTRTL_THREAD_PERIOD_MS);
+        run_background_cleanup();
     }
 }
 
@@ -154,7 +178,7 @@ bool AP_SmartRTL::pop_point(Vector3f& point)
     }
 
     // return last point and remove from path
-    point = _path[--_path_points_count];
+    point = get_path_point(--_path_points_count);
 
     // record count of last point popped
     _path_points_completed_limit = _path_points_count;
@@ -292,7 +316,7 @@ bool AP_SmartRTL::add_point(const Vector3f& point)
 
     // check if we have traveled far enough
     if (_path_points_count > 0) {
-        const Vector3f& last_pos = _path[_path_points_count-1];
+        const Vector3f last_pos = get_path_point(_path_points_count-1);
         if (last_pos.distance_squared(point) < sq(_accuracy.get())) {
             _path_sem.give();
             return true;
@@ -307,14 +331,66 @@ bool AP_SmartRTL::add_point(const Vector3f& point)
     }
 
     // add point to path
-    _path[_path_points_count++] = point;
+    // background detection may be reading the points of a re-encoded block, so make it start again
+    if (set_path_point(_path_points_count, point)) {
+        _path_reencoded = true;
+    }
+    _path_points_count++;
     log_action(SRTL_POINT_ADD, point);
 
     _path_sem.give();
     return true;
 }
 
-// run background cleanup - should be run regularly from the IO thread
+// get a point from the path storage
+Vector3f AP_SmartRTL::get_path_point(uint16_t index) const
+{
+    const path_block_t &block = _path_blocks[index / SMARTRTL_PATH_BLOCK_LEN];
+    const path_point_t &ofs = _path[index];
+    return block.base + Vector3f(ofs.x, ofs.y, ofs.z) * block.scale;
+}
+
+// store a point in the path storage.  The first point of a block becomes its base, and the block is
+// re-encoded at a coarser scale if the point is too far from the base for the current scale.
+// Points past the end of the path are not kept.  Returns true if other points in the block were re-encoded
+bool AP_SmartRTL::set_path_point(uint16_t index, const Vector3f& point)
+{
+    path_block_t &block = _path_blocks[index / SMARTRTL_PATH_BLOCK_LEN];
+    const uint16_t first = index - index % SMARTRTL_PATH_BLOCK_LEN;
+
+    if (index != first && is_positive(block.scale)) {
+        const Vector3f ofs = (point - block.base) / block.scale;
+        if (fabsf(ofs.x) <= INT16_MAX && fabsf(ofs.y) <= INT16_MAX && fabsf(ofs.z) <= INT16_MAX) {
+            _path[index] = path_point_t {int16_t(lrintf(ofs.x)), int16_t(lrintf(ofs.y)), int16_t(lrintf(ofs.z))};
+            return false;
+        }
+    }
+
+    // decode the block's points with the new point in place
+    const uint16_t last = MIN(uint16_t(first + SMARTRTL_PATH_BLOCK_LEN), MAX(_path_points_count, uint16_t(index + 1)));
+    const Vector3f base = (index == first) ? point : block.base;
+    Vector3f points[SMARTRTL_PATH_BLOCK_LEN];
+    float max_ofs = 0.0f;
+    for (uint16_t i = first; i < last; i++) {
+        const Vector3f p = (i == index) ? point : get_path_point(i);
+        points[i - first] = p;
+        const Vector3f ofs = p - base;
+        max_ofs = MAX(max_ofs, MAX(fabsf(ofs.x), MAX(fabsf(ofs.y), fabsf(ofs.z))));
+    }
+
+    // re-encode them relative to the new base
+    block.base = base;
+    block.scale = MAX(SMARTRTL_PATH_SCALE_MIN, max_ofs / INT16_MAX);
+    for (uint16_t i = first; i < last; i++) {
+        const Vector3f ofs = (points[i - first] - base) / block.scale;
+        _path[i] = path_point_t {int16_t(constrain_float(roundf(ofs.x), -INT16_MAX, INT16_MAX)),
+                                 int16_t(constrain_float(roundf(ofs.y), -INT16_MAX, INT16_MAX)),
+                                 int16_t(constrain_float(roundf(ofs.z), -INT16_MAX, INT16_MAX))};
+    }
+    return (last - first) > 1;
+}
+
+// run background cleanup - should be run regularly from the IO thread or the cleanup thread
 void AP_SmartRTL::run_background_cleanup()
 {
     if (!_active) {
@@ -329,8 +405,16 @@ void AP_SmartRTL::run_background_cleanup()
     const uint16_t path_points_count = _path_points_count;
     const uint16_t path_points_completed_limit = _path_points_completed_limit;
     _path_points_completed_limit = SMARTRTL_POINTS_MAX;
+    const bool path_reencoded = _path_reencoded;
+    _path_reencoded = false;
     _path_sem.give();
 
+    // points were re-encoded while detection may have been reading them, so start again
+    if (path_reencoded) {
+        reset_simplification();
+        reset_pruning();
+    }
+
     // check if thorough cleanup is required
     if (_thorough_clean_request_ms > 0) {
         // check if we have already completed the request
@@ -469,7 +553,8 @@ void AP_SmartRTL::detect_simplifications()
     while (_simplify.stack_count > 0) { // while there is something to do
 
         // if this method has run for long enough, exit
-        if (AP_HAL::micros() - start_time_us > SMARTRTL_SIMPLIFY_TIME_US) {
+        if (_time_sliced && (AP_HAL::micros() - start_time_us > SMARTRTL_SIMPLIFY_TIME_US)) {
+            _simplify.time_us += AP_HAL::micros() - start_time_us;
             return;
         }
 
@@ -481,10 +566,12 @@ void AP_SmartRTL::detect_simplifications()
         // find the point between start and end points that is farthest from the start-end line segment
         float max_dist = 0.0f;
         uint16_t farthest_point_index = start_index;
+        const Vector3f start_point = get_path_point(start_index);
+        const Vector3f end_point = get_path_point(end_index);
         for (uint16_t i = start_index + 1; i < end_index; i++) {
             // only check points that have not already been flagged for simplification
-            if (_simplify.bitmask.get(i)) {
-                const float dist = _path[i].distance_to_segment(_path[start_index], _path[end_index]);
+            if (_simplify.bitmask->get(i)) {
+                const float dist = get_path_point(i).distance_to_segment(start_point, end_point);
                 if (dist > max_dist) {
                     farthest_point_index = i;
                     max_dist = dist;
@@ -498,6 +585,7 @@ void AP_SmartRTL::detect_simplifications()
             // if the to-do list is full, give up on simplifying. This should never happen.
             if (_simplify.stack_count >= _simplify.stack_max) {
                 _simplify.complete = true;
+                _simplify.time_us += AP_HAL::micros() - start_time_us;
                 return;
             }
             _simplify.stack[_simplify.stack_count++] = simplify_start_finish_t {start_index, farthest_point_index};
@@ -505,11 +593,16 @@ void AP_SmartRTL::detect_simplifications()
         } else {
             // if the farthest point was closer than ACCURACY * 0.5 we can simplify all points between start and end
             for (uint16_t i = start_index + 1; i < end_index; i++) {
-                _simplify.bitmask.clear(i);
+                if (_simplify.bitmask->get(i)) {
+                    _simplify.bitmask->clear(i);
+                    _simplify.found++;
+                }
                 _simplify.removal_required = true;
             }
         }
     }
+    _simplify.time_us += AP_HAL::micros() - start_time_us;
+    log_cleanup(0, _simplify.path_points_count - _simplify.path_points_completed, _simplify.time_us, _simplify.found);
     _simplify.path_points_completed = _simplify.path_points_count;
     _simplify.complete = true;
 }
@@ -533,7 +626,7 @@ void AP_SmartRTL::detect_loops()
     const uint32_t start_time_us = AP_HAL::micros();
 
     // run for defined amount of time
-    while (AP_HAL::micros() - start_time_us < SMARTRTL_PRUNING_LOOP_TIME_US) {
+    while (!_time_sliced || (AP_HAL::micros() - start_time_us < SMARTRTL_PRUNING_LOOP_TIME_US)) {
 
         // advance inner loop
         _prune.j++;
@@ -544,6 +637,8 @@ void AP_SmartRTL::detect_loops()
             _prune.i--;
             // complete when outer loop has run out of new points to check
             if (_prune.i < 4 || _prune.i < _prune.path_points_completed) {
+                _prune.time_us += AP_HAL::micros() - start_time_us;
+                log_cleanup(1, _prune.path_points_count - _prune.path_points_completed, _prune.time_us, _prune.loops_count);
                 _prune.complete = true;
                 _prune.path_points_completed = _prune.path_points_count;
                 return;
@@ -551,17 +646,20 @@ void AP_SmartRTL::detect_loops()
         }
 
         // find the closest distance between two line segments and the mid-point
-        dist_point dp = segment_segment_dist(_path[_prune.i], _path[_prune.i-1], _path[_prune.j-1], _path[_prune.j]);
+        dist_point dp = segment_segment_dist(get_path_point(_prune.i), get_path_point(_prune.i-1), get_path_point(_prune.j-1), get_path_point(_prune.j));
         if (dp.distance < SMARTRTL_PRUNING_DELTA) {
             // if there is a loop here, add to loop array
             if (!add_loop(_prune.j, _prune.i-1, dp.midpoint)) {
                 // if the buffer is full, stop trying to prune
                 _prune.complete = true;
+                _prune.time_us += AP_HAL::micros() - start_time_us;
+                return;
             }
             // set inner loop forward to trigger outer loop move to next segment
             _prune.j = _prune.i;
         }
     }
+    _prune.time_us += AP_HAL::micros() - start_time_us;
 }
 
 // restart simplify if new points have been added to path
@@ -588,9 +686,11 @@ void AP_SmartRTL::restart_simplification(uint16_t path_points_count)
 {
     _simplify.complete = false;
     _simplify.removal_required = false;
-    _simplify.bitmask.setall();
+    _simplify.bitmask->setall();
     _simplify.stack_count = 0;
     _simplify.path_points_count = path_points_count;
+    _simplify.time_us = 0;
+    _simplify.found = 0;
 }
 
 // reset simplification algorithm so that it will re-check all points in the path
@@ -607,6 +707,7 @@ void AP_SmartRTL::restart_pruning(uint16_t path_points_count)
     _prune.i = (path_points_count > 0) ? path_points_count - 1 : 0;
     _prune.j = 0;
     _prune.path_points_count = path_points_count;
+    _prune.time_us = 0;
 }
 
 // reset pruning algorithm so that it will re-check all points in the path
@@ -627,11 +728,11 @@ void AP_SmartRTL::remove_points_by_simplify_bitmask()
     uint16_t dest = 1;
     uint16_t removed = 0;
     for (uint16_t src = 1; src < _path_points_count; src++) {
-        if (!_simplify.bitmask.get(src)) {
-            log_action(SRTL_POINT_SIMPLIFY, _path[src]);
+        if (!_simplify.bitmask->get(src)) {
+            log_action(SRTL_POINT_SIMPLIFY, get_path_point(src));
             removed++;
         } else {
-            _path[dest] = _path[src];
+            set_path_point(dest, get_path_point(src));
             dest++;
         }
     }
@@ -649,7 +750,7 @@ void AP_SmartRTL::remove_points_by_simplify_bitmask()
     _path_sem.give();
 
     // flag point removal is complete
-    _simplify.bitmask.setall();
+    _simplify.bitmask->setall();
     _simplify.removal_required = false;
 }
 
@@ -675,13 +776,13 @@ bool AP_SmartRTL::remove_points_by_loops(uint16_t num_points_to_remove)
         prune_loop_t loop = _prune.loops[i];
 
         // midpoint goes into start_index (this is the end point of the first segment)
-        _path[loop.start_index] = loop.midpoint;
+        set_path_point(loop.start_index, loop.midpoint);
 
         // shift points after the end of the loop down by the number of points in the loop
         uint16_t loop_num_points_to_remove = loop.end_index - loop.start_index;
         for (uint16_t dest = loop.start_index + 1; dest < _path_points_count - loop_num_points_to_remove; dest++) {
-            log_action(SRTL_POINT_PRUNE, _path[dest]);
-            _path[dest] = _path[dest + loop_num_points_to_remove];
+            log_action(SRTL_POINT_PRUNE, get_path_point(dest));
+            set_path_point(dest, get_path_point(dest + loop_num_points_to_remove));
         }
 
         if (_path_points_count > loop_num_points_to_remove) {
@@ -731,9 +832,9 @@ bool AP_SmartRTL::add_loop(uint16_t start_index, uint16_t end_index, const Vecto
 
     // create new loop structure and calculate length squared of loop
     prune_loop_t new_loop = {start_index, end_index, midpoint, 0.0f};
-    new_loop.length_squared = midpoint.distance_squared(_path[start_index]) + midpoint.distance_squared(_path[end_index]);
+    new_loop.length_squared = midpoint.distance_squared(get_path_point(start_index)) + midpoint.distance_squared(get_path_point(end_index));
     for (uint16_t i = start_index; i < end_index; i++) {
-        new_loop.length_squared += _path[i].distance_squared(_path[i+1]);
+        new_loop.length_squared += get_path_point(i).distance_squared(get_path_point(i+1));
     }
 
     // look for overlapping loops and find their combined length
@@ -833,6 +934,19 @@ void AP_SmartRTL::log_action(SRTL_Actions action, const Vector3f &point)
     }
 }
 
+// log how many points a simplify (type 0) or prune (type 1) pass checked, the time it took and what it found
+void AP_SmartRTL::log_cleanup(uint8_t type, uint16_t points, uint32_t time_us, uint16_t found)
+{
+    if (!_example_mode) {
+        AP::logger().Write("SRTC", "TimeUS,Type,Pts,US,Found", "QBHIH",
+                           AP_HAL::micros64(),
+                           type,
+                           points,
+                           time_us,
+                           found);
+    }
+}
+
 // returns true if the two loops overlap (used within add_loop to determine which loops to keep or throw away)
 bool AP_SmartRTL::loops_overlap(const prune_loop_t &loop1, const prune_loop_t &loop2) const
 {
@@ -6,8 +6,12 @@
 
 // definitions and macros
 #define SMARTRTL_ACCURACY_DEFAULT        2.0f   // default _ACCURACY parameter value.  Points will be no closer than this distance (in meters) together.
-#define SMARTRTL_POINTS_DEFAULT          300    // default _POINTS parameter value.  High numbers improve path pruning but use more memory and CPU for cleanup. Memory used will be 20bytes * this number.
+#define SMARTRTL_POINTS_DEFAULT          300    // default _POINTS parameter value.  High numbers improve path pruning but use more memory and CPU for cleanup. Memory used will be about 15bytes * this number.
+#if HAL_MINIMIZE_FEATURES
 #define SMARTRTL_POINTS_MAX              500    // the absolute maximum number of points this library can support.
+#else
+#define SMARTRTL_POINTS_MAX              5000   // the absolute maximum number of points this library can support.
+#endif
 #define SMARTRTL_TIMEOUT                 15000  // the time in milliseconds with no points saved to the path (for whatever reason), before SmartRTL is disabled for the flight
 #define SMARTRTL_CLEANUP_POINT_TRIGGER   50     // simplification will trigger when this many points are added to the path
 #define SMARTRTL_CLEANUP_START_MARGIN    10     // routine cleanup algorithms begin when the path array has only this many empty slots remaining
@@ -20,6 +24,9 @@
 #define SMARTRTL_PRUNING_DELTA (_accuracy * 0.99)   // How many meters apart must two points be, such that we can assume that there is no obstacle between them.  must be smaller than _ACCURACY parameter
 #define SMARTRTL_PRUNING_LOOP_BUFFER_LEN_MULT 0.25f // pruning loop buffer size as compared to maximum number of points
 #define SMARTRTL_PRUNING_LOOP_TIME_US    200    // maximum time (in microseconds) that the loop finding algorithm will run before returning
+#define SMARTRTL_THREAD_PERIOD_MS        5      // the cleanup thread runs a cleanup step this often.  Steps in the thread are not time limited
+#define SMARTRTL_PATH_BLOCK_LEN          16     // number of points which share a base position and scale in the path storage
+#define SMARTRTL_PATH_SCALE_MIN          0.01f  // finest resolution (in meters) of points in the path storage
 
 class AP_SmartRTL {
 
@@ -38,7 +45,7 @@ public:
     uint16_t get_num_points() const;
 
     // get a point on the path
-    const Vector3f& get_point(uint16_t index) const { return _path[index]; }
+    Vector3f get_point(uint16_t index) const { return get_path_point(index); }
 
     // get next point on the path to home, returns true on success
     bool pop_point(Vector3f& point);
@@ -71,7 +78,7 @@ public:
     // cancel request for thorough cleanup
     void cancel_request_for_thorough_cleanup();
 
-    // run background cleanup - should be run regularly from the IO thread
+    // run background cleanup - should be run regularly from the IO thread or the cleanup thread
     void run_background_cleanup();
 
     // parameter var table
@@ -97,6 +104,13 @@ private:
     // add point to end of path
     bool add_point(const Vector3f& point);
 
+    // get or set a point in the path storage, set returns true if other points in its block were re-encoded
+    Vector3f get_path_point(uint16_t index) const;
+    bool set_path_point(uint16_t index, const Vector3f& point);
+
+    // main loop of the cleanup thread
+    void cleanup_thread();
+
     // routine cleanup attempts to remove 10 points (see SMARTRTL_CLEANUP_POINT_MIN definition) by simplification or loop pruning
     void routine_cleanup(uint16_t path_points_count, uint16_t path_points_complete_limit);
 
@@ -161,6 +175,9 @@ private:
     // logging
     void log_action(SRTL_Actions action, const Vector3f &point = Vector3f());
 
+    // log how many points a simplify (type 0) or prune (type 1) pass checked, the time it took and what it found
+    void log_cleanup(uint8_t type, uint16_t points, uint32_t time_us, uint16_t found);
+
     // parameters
     AP_Float _accuracy;
     AP_Int16 _points_max;
@@ -174,9 +191,22 @@ private:
     uint32_t _thorough_clean_request_ms;// the last system time the thorough cleanup was requested (set by thorough_cleanup method, used by background cleanup)
     uint32_t _thorough_clean_complete_ms; // set to _thorough_clean_request_ms when the background thread completes the thorough cleanup
     ThoroughCleanupType _thorough_clean_type;   // used by example sketch to test simplify and prune separately
+    bool _time_sliced = true;   // true if the cleanup steps are limited to SMARTRTL_SIMPLIFY_TIME_US and SMARTRTL_PRUNING_LOOP_TIME_US, false when they run in their own thread
 
     // path variables
-    Vector3f* _path;    // points are stored in meters from EKF origin in NED
+    // points are stored in meters from EKF origin in NED, as int16 offsets from the base of their
+    // block of SMARTRTL_PATH_BLOCK_LEN points in units of the block's scale.  The scale grows to fit
+    // the block's points, so the resolution is never worse than the block's extent / 65534
+    typedef struct {
+        int16_t x, y, z;
+    } path_point_t;
+    typedef struct {
+        Vector3f base;
+        float scale;
+    } path_block_t;
+    path_point_t* _path;
+    path_block_t* _path_blocks;
+    bool _path_reencoded;       // true if add_point re-encoded points which background detection may have been reading
     uint16_t _path_points_max;  // after the array has been allocated, we will need to know how big it is. We can't use the parameter, because a user could change the parameter in-flight
     uint16_t _path_points_count;// number of points in the path array
     uint16_t _path_points_completed_limit;  // set by main thread to the path_point_count when a point is popped.  used by simplify and prune algorithms to detect path shrinking
@@ -196,7 +226,9 @@ private:
         simplify_start_finish_t* stack;
         uint16_t stack_max;     // maximum number of elements in the _simplify_stack array
         uint16_t stack_count;   // number of elements in _simplify_stack array
-        Bitmask bitmask{SMARTRTL_POINTS_MAX};  // simplify algorithm clears bits for each point that can be removed
+        Bitmask *bitmask;       // simplify algorithm clears bits for each point that can be removed
+        uint32_t time_us;       // time spent by this pass (for logging)
+        uint16_t found;         // number of points found by this pass which can be removed (for logging)
     } _simplify;
 
     // Pruning
@@ -215,6 +247,7 @@ private:
         prune_loop_t* loops;// the result of the pruning algorithm
         uint16_t loops_max; // maximum number of elements in the _prunable_loops array
         uint16_t loops_count;   // number of elements in the _prunable_loops array
+        uint32_t time_us;       // time spent by this pass (for logging)
     } _prune;
 
     // returns true if the two loops overlap (used within add_loop to determine which loops to keep or throw away)
@@ -99,11 +99,11 @@ void check_path(const std::vector<Vector3f>& correct_path, const char* test_name
     bool num_points_match = correct_path.size() == smart_rtl.get_num_points();
     uint16_t points_to_compare = MIN(correct_path.size(), smart_rtl.get_num_points());
 
-    // check all points match
+    // check all points match, to within the resolution of the path storage
     bool points_match = true;
     uint16_t failure_index = 0;
     for (uint16_t i = 0; i < points_to_compare; i++) {
-        if (smart_rtl.get_point(i) != correct_path[i]) {
+        if ((smart_rtl.get_point(i) - correct_path[i]).length() > SMARTRTL_PATH_SCALE_MIN) {
             failure_index = i;
             points_match = false;
         }
@@ -118,7 +118,7 @@ void check_path(const std::vector<Vector3f>& correct_path, const char* test_name
     // display the first failed point and all subsequent points
     if (!points_match) {
         for (uint16_t j = failure_index; j < points_to_compare; j++) {
-            const Vector3f& smartrtl_point = smart_rtl.get_point(j);
+            const Vector3f smartrtl_point = smart_rtl.get_point(j);
             hal.console->printf("   expected point %d to be %4.2f,%4.2f,%4.2f, got %4.2f,%4.2f,%4.2f\n",
                             (int)j,
                             (double)correct_path[j].x,
@@ -177,7 +177,7 @@ bool SoaringController::check_thermal_criteria()
 
 bool SoaringController::check_cruise_criteria()
 {
-    float thermalability = (_ekf.X[0]*expf(-powf(_loiter_rad / _ekf.X[1], 2))) - EXPECTED_THERMALLING_SINK;
+    float thermalability = (_ekf.X[0]*expf(-sq(_loiter_rad / _ekf.X[1]))) - EXPECTED_THERMALLING_SINK;
     float alt = _vario.alt;
 
     if (soar_active && (AP_HAL::micros64() - _thermal_start_time_us) > ((unsigned)min_thermal_s * 1e6) && thermalability < McCready(alt)) {
@@ -212,18 +212,34 @@ void SoaringController::init_thermalling()
     const float init_p[4] = {INITIAL_STRENGTH_COVARIANCE, INITIAL_RADIUS_COVARIANCE, INITIAL_POSITION_COVARIANCE, INITIAL_POSITION_COVARIANCE};
     const MatrixN<float,4> p{init_p};
 
+    _ahrs.get_position(_prev_update_location);
+    _prev_update_time = AP_HAL::micros64();
+
     // New state vector filter will be reset. Thermal location is placed in front of a/c
-    const float init_xr[4] = {INITIAL_THERMAL_STRENGTH,
-                              INITIAL_THERMAL_RADIUS,
-                              thermal_distance_ahead * cosf(_ahrs.yaw),
-                              thermal_distance_ahead * sinf(_ahrs.yaw)};
+    float init_xr[4] = {INITIAL_THERMAL_STRENGTH,
+                        INITIAL_THERMAL_RADIUS,
+                        thermal_distance_ahead * cosf(_ahrs.yaw),
+                        thermal_distance_ahead * sinf(_ahrs.yaw)};
+
+    // unless this is a thermal we have been in before, in which case
+    // start from where it has drifted to. The strength is left at the
+    // initial guess as it varies much more over time than the radius,
+    // and the filter is slow to move it
+    const uint32_t now_ms = AP_HAL::millis();
+    const Vector3f wind = _ahrs.wind_estimate();
+    ThermalMap::thermal known;
+    _thermal_idx = _thermal_map.find(_prev_update_location, wind, _loiter_rad, now_ms);
+    if (_thermal_map.get(_thermal_idx, wind, now_ms, known)) {
+        const Vector2f ofs = _prev_update_location.get_distance_NE(known.centre);
+        init_xr[1] = known.radius;
+        init_xr[2] = ofs.x;
+        init_xr[3] = ofs.y;
+        gcs().send_text(MAV_SEVERITY_INFO, "Soaring: Known thermal %u, %.0fm away", (unsigned)_thermal_idx, (double)ofs.length());
+    }
     const VectorN<float,4> xr{init_xr};
 
     // Also reset covariance matrix p so filter is not affected by previous data
     _ekf.reset(xr, p, q, r);
-
-    _ahrs.get_position(_prev_update_location);
-    _prev_update_time = AP_HAL::micros64();
     _thermal_start_time_us = AP_HAL::micros64();
 }
 
@@ -297,6 +313,11 @@ void SoaringController::update_thermalling()
         //log_data();
         _ekf.update(_vario.reading,dx, dy);       // update the filter
 
+        // keep the map's entry for this thermal up to date
+        Location centre = current_loc;
+        centre.offset(_ekf.X[2], _ekf.X[3]);
+        _thermal_idx = _thermal_map.update(_thermal_idx, centre, _ekf.X[0], _ekf.X[1], AP_HAL::millis());
+
         _prev_update_location = current_loc;      // save for next time
         _prev_update_time = AP_HAL::micros64();
         _vario.new_data = false;
@@ -15,6 +15,7 @@
 #include <AP_Math/AP_Math.h>
 #include "ExtendedKalmanFilter.h"
 #include "Variometer.h"
+#include "ThermalMap.h"
 #include <AP_SpdHgtControl/AP_SpdHgtControl.h>
 
 #define EXPECTED_THERMALLING_SINK 0.7
@@ -31,6 +32,10 @@ class SoaringController {
     AP_SpdHgtControl &_spdHgt;
     Variometer _vario;
 
+    // thermals found so far, and the entry for the one being thermalled
+    ThermalMap _thermal_map;
+    int8_t _thermal_idx = -1;
+
     // store aircraft location at last update
     struct Location _prev_update_location;
 
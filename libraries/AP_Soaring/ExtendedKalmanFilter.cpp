@@ -1,3 +1,4 @@
+#include <AP_Math/AP_Math.h>
 #include "ExtendedKalmanFilter.h"
 #include "AP_Math/matrixN.h"
 
@@ -6,16 +7,19 @@ float ExtendedKalmanFilter::measurementpredandjacobian(VectorN<float,N> &A)
 {
     // This function computes the Jacobian using equations from
     // analytical derivation of Gaussian updraft distribution
-    // This expression gets used lots
-    float expon = expf(- (powf(X[2], 2) + powf(X[3], 2)) / powf(X[1], 2));
+    // These expressions get used lots
+    const float dist_sq = sq(X[2]) + sq(X[3]);
+    const float inv_radius_sq = 1.0f / sq(X[1]);
+    const float expon = expf(-dist_sq * inv_radius_sq);
     // Expected measurement
-    float w = X[0] * expon;
+    const float w = X[0] * expon;
 
     // Elements of the Jacobian
+    const float k = -2 * X[0] * inv_radius_sq * expon;
     A[0] = expon;
-    A[1] = 2 * X[0] * ((powf(X[2],2) + powf(X[3],2)) / powf(X[1],3)) * expon;
-    A[2] = -2 * (X[0] * X[2] / powf(X[1],2)) * expon;
-    A[3] = A[2] * X[3] / X[2];
+    A[1] = -k * dist_sq / X[1];
+    A[2] = k * X[2];
+    A[3] = k * X[3];
     return w;
 }
 
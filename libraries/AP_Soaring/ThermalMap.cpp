@@ -0,0 +1,74 @@
+#include "ThermalMap.h"
+
+int8_t ThermalMap::find(const Location &loc, const Vector3f &wind, float margin, uint32_t now_ms) const
+{
+    const LocationOrigin origin(loc);
+    int8_t best = -1;
+    float best_dist = 0;
+    thermal t;
+    for (uint8_t i=0; i<THERMAL_MAP_SIZE; i++) {
+        if (!get(i, wind, now_ms, t)) {
+            continue;
+        }
+        const float dist = origin.get_distance(t.centre);
+        if (dist > t.radius + margin) {
+            continue;
+        }
+        if (best == -1 || dist < best_dist) {
+            best = i;
+            best_dist = dist;
+        }
+    }
+    return best;
+}
+
+bool ThermalMap::get(int8_t idx, const Vector3f &wind, uint32_t now_ms, thermal &t) const
+{
+    if (idx < 0 || idx >= THERMAL_MAP_SIZE || !valid(idx, now_ms)) {
+        return false;
+    }
+    t = _thermals[idx];
+    const float age_s = (now_ms - t.last_update_ms) * 0.001f;
+    t.centre.offset(wind.x * age_s, wind.y * age_s);
+    return true;
+}
+
+int8_t ThermalMap::update(int8_t idx, const Location &centre, float strength, float radius, uint32_t now_ms)
+{
+    if (idx < 0 || idx >= THERMAL_MAP_SIZE) {
+        // pick an empty or expired entry, otherwise the one least worth
+        // coming back to: the weakest, counting older thermals as weaker
+        float worst_score = 0;
+        idx = 0;
+        for (uint8_t i=0; i<THERMAL_MAP_SIZE; i++) {
+            if (!valid(i, now_ms)) {
+                idx = i;
+                break;
+            }
+            const float age_frac = (now_ms - _thermals[i].last_update_ms) / (float)THERMAL_MAP_TIMEOUT_MS;
+            const float score = _thermals[i].strength * (1.0f - age_frac);
+            if (i == 0 || score < worst_score) {
+                idx = i;
+                worst_score = score;
+            }
+        }
+    }
+    thermal &t = _thermals[idx];
+    t.centre = centre;
+    t.strength = strength;
+    t.radius = radius;
+    // zero marks an empty entry
+    t.last_update_ms = MAX(now_ms, 1U);
+    return idx;
+}
+
+uint8_t ThermalMap::count(uint32_t now_ms) const
+{
+    uint8_t n = 0;
+    for (uint8_t i=0; i<THERMAL_MAP_SIZE; i++) {
+        if (valid(i, now_ms)) {
+            n++;
+        }
+    }
+    return n;
+}
@@ -0,0 +1,50 @@
+/*
+  Map of the thermals found during a flight.
+
+  The soaring controller keeps the estimate of each thermal it has
+  worked here, so that when it comes back to one thermalling can start
+  from where the thermal was found, moved on with the wind, rather
+  than from a guess ahead of the aircraft.
+*/
+#pragma once
+
+#include <AP_Common/Location.h>
+#include <AP_Math/AP_Math.h>
+
+#define THERMAL_MAP_SIZE        8
+#define THERMAL_MAP_TIMEOUT_MS  (20*60*1000U)   // thermals not updated for this long are forgotten
+
+class ThermalMap {
+public:
+    struct thermal {
+        Location centre;        // estimated centre when last updated
+        float strength;         // m/s at the centre
+        float radius;           // m
+        uint32_t last_update_ms;
+    };
+
+    // return the index of the known thermal whose centre, drifted with
+    // the wind, is nearest loc and within its radius plus margin of it,
+    // or -1 if there is none
+    int8_t find(const Location &loc, const Vector3f &wind, float margin, uint32_t now_ms) const;
+
+    // get a thermal with its centre drifted with the wind to now_ms,
+    // returns false if there is no thermal at idx
+    bool get(int8_t idx, const Vector3f &wind, uint32_t now_ms, thermal &t) const;
+
+    // store an estimate of the thermal at idx, or in a new entry if idx
+    // is -1. When the map is full new thermals replace the oldest or
+    // weakest. Returns the index the thermal was stored at
+    int8_t update(int8_t idx, const Location &centre, float strength, float radius, uint32_t now_ms);
+
+    // number of thermals in the map
+    uint8_t count(uint32_t now_ms) const;
+
+private:
+    thermal _thermals[THERMAL_MAP_SIZE];
+
+    bool valid(uint8_t idx, uint32_t now_ms) const {
+        return _thermals[idx].last_update_ms != 0 &&
+               now_ms - _thermals[idx].last_update_ms < THERMAL_MAP_TIMEOUT_MS;
+    }
+};
@@ -0,0 +1,77 @@
+#include <AP_gtest.h>
+
+#include <AP_Soaring/ThermalMap.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static const Location home(-353632620, 1491652370, 0, Location::AltFrame::ABSOLUTE);
+
+static Location offset_loc(float north, float east)
+{
+    Location loc = home;
+    loc.offset(north, east);
+    return loc;
+}
+
+TEST(ThermalMap, FindNearest)
+{
+    ThermalMap map;
+    const Vector3f no_wind;
+    const uint32_t now_ms = 1000;
+
+    EXPECT_EQ(-1, map.find(home, no_wind, 50, now_ms));
+
+    const int8_t a = map.update(-1, offset_loc(500, 0), 2.0f, 40.0f, now_ms);
+    const int8_t b = map.update(-1, offset_loc(-500, 0), 2.0f, 40.0f, now_ms);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(2, map.count(now_ms));
+
+    EXPECT_EQ(a, map.find(offset_loc(450, 20), no_wind, 50, now_ms));
+    EXPECT_EQ(b, map.find(offset_loc(-520, 0), no_wind, 50, now_ms));
+    // too far from either
+    EXPECT_EQ(-1, map.find(home, no_wind, 50, now_ms));
+
+    // updating an entry moves it rather than adding one
+    EXPECT_EQ(a, map.update(a, offset_loc(0, 30), 2.5f, 45.0f, now_ms));
+    EXPECT_EQ(2, map.count(now_ms));
+    EXPECT_EQ(a, map.find(home, no_wind, 50, now_ms));
+}
+
+TEST(ThermalMap, Drift)
+{
+    ThermalMap map;
+    const Vector3f wind(0, 5, 0);
+    const int8_t idx = map.update(-1, home, 2.0f, 40.0f, 1000);
+
+    // after 60s at 5m/s east the thermal is 300m east
+    ThermalMap::thermal t;
+    ASSERT_TRUE(map.get(idx, wind, 61000, t));
+    const Vector2f ofs = home.get_distance_NE(t.centre);
+    EXPECT_NEAR(0, ofs.x, 0.5);
+    EXPECT_NEAR(300, ofs.y, 0.5);
+    EXPECT_EQ(-1, map.find(home, wind, 50, 61000));
+    EXPECT_EQ(idx, map.find(offset_loc(0, 300), wind, 50, 61000));
+}
+
+TEST(ThermalMap, Replacement)
+{
+    ThermalMap map;
+    const Vector3f no_wind;
+    uint32_t now_ms = 1000;
+
+    // fill the map, with the thermal at index 3 the weakest
+    for (uint8_t i=0; i<THERMAL_MAP_SIZE; i++) {
+        EXPECT_EQ(i, map.update(-1, offset_loc(i*1000, 0), i==3?0.5f:2.0f, 40.0f, now_ms));
+    }
+    EXPECT_EQ(THERMAL_MAP_SIZE, map.count(now_ms));
+    EXPECT_EQ(3, map.update(-1, offset_loc(0, 1000), 2.0f, 40.0f, now_ms));
+
+    // old thermals are forgotten
+    now_ms += THERMAL_MAP_TIMEOUT_MS;
+    EXPECT_EQ(0, map.count(now_ms));
+    EXPECT_EQ(-1, map.find(home, no_wind, 50, now_ms));
+    ThermalMap::thermal t;
+    EXPECT_FALSE(map.get(0, no_wind, now_ms, t));
+}
+
+AP_GTEST_MAIN()
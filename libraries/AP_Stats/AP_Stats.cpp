@@ -2,6 +2,10 @@
 
 #include <AP_Math/AP_Math.h>
 #include <AP_RTC/AP_RTC.h>
+#include <AP_AHRS/AP_AHRS.h>
+#include <AP_InertialSensor/AP_InertialSensor.h>
+#include <AP_Logger/AP_Logger.h>
+#include <AP_Scheduler/AP_Scheduler.h>
 
 const extern AP_HAL::HAL& hal;
 
@@ -39,6 +43,88 @@ const AP_Param::GroupInfo AP_Stats::var_info[] = {
     // @User: Standard
     AP_GROUPINFO("_RESET",    3, AP_Stats, params.reset, 1),
 
+    // @Param: _LOOP_OVR
+    // @DisplayName: Total loop overruns
+    // @Description: Total number of main loops which took longer than the loop period
+    // @ReadOnly: True
+    // @User: Advanced
+    AP_GROUPINFO("_LOOP_OVR",   4, AP_Stats, params.counts[COUNT_LOOP_OVERRUNS], 0),
+
+    // @Param: _LOOP_MAX
+    // @DisplayName: Longest loop time
+    // @Description: Longest time taken by a main loop
+    // @Units: us
+    // @ReadOnly: True
+    // @User: Advanced
+    AP_GROUPINFO("_LOOP_MAX",   5, AP_Stats, params.loop_max, 0),
+
+    // @Param: _LOG_DROP
+    // @DisplayName: Total log drops
+    // @Description: Total number of log messages dropped because the logger could not keep up
+    // @ReadOnly: True
+    // @User: Advanced
+    AP_GROUPINFO("_LOG_DROP",   6, AP_Stats, params.counts[COUNT_LOG_DROPS], 0),
+
+    // @Param: _EKF_SW
+    // @DisplayName: Total EKF lane switches
+    // @Description: Total number of times the EKF has changed its primary core
+    // @ReadOnly: True
+    // @User: Advanced
+    AP_GROUPINFO("_EKF_SW",     7, AP_Stats, params.counts[COUNT_EKF_LANE_SWITCHES], 0),
+
+    // @Param: _CLIP1
+    // @DisplayName: Total first IMU accel clips
+    // @Description: Total number of samples where the first accelerometer reached its limit
+    // @ReadOnly: True
+    // @User: Advanced
+    AP_GROUPINFO("_CLIP1",      8, AP_Stats, params.counts[COUNT_ACCEL_CLIPS], 0),
+
+    // @Param: _CLIP2
+    // @DisplayName: Total second IMU accel clips
+    // @Description: Total number of samples where the second accelerometer reached its limit
+    // @ReadOnly: True
+    // @User: Advanced
+    AP_GROUPINFO("_CLIP2",      9, AP_Stats, params.counts[COUNT_ACCEL_CLIPS+1], 0),
+
+    // @Param: _CLIP3
+    // @DisplayName: Total third IMU accel clips
+    // @Description: Total number of samples where the third accelerometer reached its limit
+    // @ReadOnly: True
+    // @User: Advanced
+    AP_GROUPINFO("_CLIP3",     10, AP_Stats, params.counts[COUNT_ACCEL_CLIPS+2], 0),
+
+    // @Param: _MOT_T1
+    // @DisplayName: Motor time at low throttle
+    // @Description: Total time the motors have run at up to 25% throttle
+    // @Units: s
+    // @ReadOnly: True
+    // @User: Advanced
+    AP_GROUPINFO("_MOT_T1",    11, AP_Stats, params.counts[COUNT_MOTOR_TIME], 0),
+
+    // @Param: _MOT_T2
+    // @DisplayName: Motor time at low-mid throttle
+    // @Description: Total time the motors have run at 25% to 50% throttle
+    // @Units: s
+    // @ReadOnly: True
+    // @User: Advanced
+    AP_GROUPINFO("_MOT_T2",    12, AP_Stats, params.counts[COUNT_MOTOR_TIME+1], 0),
+
+    // @Param: _MOT_T3
+    // @DisplayName: Motor time at mid-high throttle
+    // @Description: Total time the motors have run at 50% to 75% throttle
+    // @Units: s
+    // @ReadOnly: True
+    // @User: Advanced
+    AP_GROUPINFO("_MOT_T3",    13, AP_Stats, params.counts[COUNT_MOTOR_TIME+2], 0),
+
+    // @Param: _MOT_T4
+    // @DisplayName: Motor time at high throttle
+    // @Description: Total time the motors have run above 75% throttle
+    // @Units: s
+    // @ReadOnly: True
+    // @User: Advanced
+    AP_GROUPINFO("_MOT_T4",    14, AP_Stats, params.counts[COUNT_MOTOR_TIME+3], 0),
+
     AP_GROUPEND
 };
 
@@ -56,6 +142,10 @@ void AP_Stats::copy_variables_from_parameters()
     runtime = params.runtime;
     reset = params.reset;
     flttime_boot = flttime;
+    for (uint8_t i=0; i<COUNT_MAX; i++) {
+        counts[i] = params.counts[i];
+    }
+    loop_max_us = params.loop_max;
 }
 
 void AP_Stats::init()
@@ -71,6 +161,59 @@ void AP_Stats::flush()
 {
     params.flttime.set_and_save_ifchanged(flttime);
     params.runtime.set_and_save_ifchanged(runtime);
+    // only counters which have changed are written, so a vehicle
+    // without problems doesn't wear its storage
+    for (uint8_t i=0; i<COUNT_MAX; i++) {
+        params.counts[i].set_and_save_ifchanged(counts[i]);
+    }
+    params.loop_max.set_and_save_ifchanged(loop_max_us);
+}
+
+/*
+  add the increases in the counts kept since boot by other libraries
+  to the lifetime counters
+ */
+void AP_Stats::update_counters()
+{
+    uint32_t source[COUNT_MOTOR_TIME] {};
+    const AP::PerfInfo &perf_info = AP::scheduler().perf_info;
+    source[COUNT_LOOP_OVERRUNS] = perf_info.get_boot_long_running();
+    source[COUNT_LOG_DROPS] = AP::logger().num_dropped();
+    const AP_AHRS *ahrs = AP_AHRS::get_singleton();
+    if (ahrs != nullptr) {
+        source[COUNT_EKF_LANE_SWITCHES] = ahrs->get_lane_switch_count();
+    }
+    const AP_InertialSensor &ins = AP::ins();
+    for (uint8_t i=0; i<AP_STATS_IMUS; i++) {
+        source[COUNT_ACCEL_CLIPS+i] = ins.get_accel_clip_count(i);
+    }
+
+    for (uint8_t i=0; i<COUNT_MOTOR_TIME; i++) {
+        // a count which went backwards was reset, e.g. on a new log
+        const uint32_t delta = source[i] >= last_source_count[i] ? source[i] - last_source_count[i] : source[i];
+        counts[i] += delta;
+        last_source_count[i] = source[i];
+    }
+    loop_max_us = MAX(loop_max_us, perf_info.get_boot_max_time());
+}
+
+/*
+  add the time since the last call to the motor time of the band of
+  the last throttle set
+ */
+void AP_Stats::update_motor_time()
+{
+    const uint32_t now = AP_HAL::millis();
+    const uint32_t delta_ms = now - _last_motor_ms;
+    _last_motor_ms = now;
+    if (_motor_throttle < 0 || delta_ms > 10000) {
+        return;
+    }
+    const uint8_t band = MIN(uint8_t(_motor_throttle * AP_STATS_THROTTLE_BANDS), AP_STATS_THROTTLE_BANDS-1);
+    uint16_t &band_ms = _motor_band_ms[band];
+    band_ms += delta_ms;
+    counts[COUNT_MOTOR_TIME+band] += band_ms / 1000;
+    band_ms %= 1000;
 }
 
 void AP_Stats::update_flighttime()
@@ -93,10 +236,13 @@ void AP_Stats::update_runtime()
 
 void AP_Stats::update()
 {
+    update_motor_time();
+
     const uint32_t now_ms = AP_HAL::millis();
     if (now_ms -  last_flush_ms > flush_interval_ms) {
         update_flighttime();
         update_runtime();
+        update_counters();
         flush();
         last_flush_ms = now_ms;
     }
@@ -105,6 +251,10 @@ void AP_Stats::update()
         params.bootcount.set_and_save_ifchanged(params_reset == 0 ? 1 : 0);
         params.flttime.set_and_save_ifchanged(0);
         params.runtime.set_and_save_ifchanged(0);
+        for (uint8_t i=0; i<COUNT_MAX; i++) {
+            params.counts[i].set_and_save_ifchanged(0);
+        }
+        params.loop_max.set_and_save_ifchanged(0);
         uint32_t system_clock = 0; // in seconds
         uint64_t rtc_clock_us;
         if (AP::rtc().get_utc_usec(rtc_clock_us)) {
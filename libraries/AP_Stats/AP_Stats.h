@@ -6,6 +6,11 @@
 #include <AP_Common/AP_Common.h>
 #include <AP_Param/AP_Param.h>
 
+// number of IMUs with a clip count, and of throttle bands, each a
+// quarter of the throttle range, with a motor time
+#define AP_STATS_IMUS 3
+#define AP_STATS_THROTTLE_BANDS 4
+
 class AP_Stats
 {
 public:
@@ -31,6 +36,12 @@ public:
 
     void set_flying(bool b);
 
+    // set the motor throttle, from 0 to 1, or negative if the motors
+    // are stopped. Call at least 1Hz for the motor time statistics
+    void set_motor_throttle(float throttle) {
+        _motor_throttle = throttle;
+    }
+
     // accessor for is_flying
     bool get_is_flying(void) {
         return _flying_ms != 0;
@@ -50,13 +61,36 @@ public:
 private:
     static AP_Stats *_singleton;
     
+    // lifetime performance counters, since the last reset
+    enum {
+        COUNT_LOOP_OVERRUNS = 0,
+        COUNT_LOG_DROPS,
+        COUNT_EKF_LANE_SWITCHES,
+        COUNT_ACCEL_CLIPS,          // one per IMU
+        COUNT_MOTOR_TIME = COUNT_ACCEL_CLIPS + AP_STATS_IMUS,  // seconds, one per throttle band
+        COUNT_MAX = COUNT_MOTOR_TIME + AP_STATS_THROTTLE_BANDS
+    };
+
     struct {
         AP_Int16 bootcount;
         AP_Int32 flttime;
         AP_Int32 runtime;
         AP_Int32 reset;
+        AP_Int32 loop_max;
+        AP_Int32 counts[COUNT_MAX];
     } params;
 
+    uint32_t counts[COUNT_MAX];
+    uint32_t loop_max_us;
+
+    // last seen values of the counts kept since boot by other
+    // libraries, which are added to the lifetime counters
+    uint32_t last_source_count[COUNT_MOTOR_TIME];
+
+    float _motor_throttle = -1;
+    uint32_t _last_motor_ms;
+    uint16_t _motor_band_ms[AP_STATS_THROTTLE_BANDS];
+
     void copy_variables_from_parameters();
 
     uint64_t last_flush_ms; // in terms of system uptime
@@ -67,6 +101,8 @@ private:
 
     void update_flighttime();
     void update_runtime();
+    void update_counters();
+    void update_motor_time();
 
 };
 
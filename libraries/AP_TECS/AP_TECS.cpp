@@ -630,8 +630,9 @@ void AP_TECS::_update_throttle_with_airspeed(void)
         // Use the demanded rate of change of total energy as the feed-forward demand, but add
         // additional component which scales with (1/cos(bank angle) - 1) to compensate for induced
         // drag increase during turns.
-        float cosPhi = sqrtf((rotMat.a.y*rotMat.a.y) + (rotMat.b.y*rotMat.b.y));
-        STEdot_dem = STEdot_dem + _rollComp * (1.0f/constrain_float(cosPhi * cosPhi , 0.1f, 1.0f) - 1.0f);
+        // the squared cosine of the bank angle comes straight from the rotation matrix
+        const float cosPhi_sq = sq(rotMat.a.y) + sq(rotMat.b.y);
+        STEdot_dem = STEdot_dem + _rollComp * (1.0f/constrain_float(cosPhi_sq, 0.1f, 1.0f) - 1.0f);
         ff_throttle = nomThr + STEdot_dem / (_STEdot_max - _STEdot_min) * (_THRmaxf - _THRminf);
 
         // Calculate PD + FF throttle
@@ -736,8 +737,8 @@ void AP_TECS::_update_throttle_without_airspeed(int16_t throttle_nudge)
     // Use the demanded rate of change of total energy as the feed-forward demand, but add
     // additional component which scales with (1/cos(bank angle) - 1) to compensate for induced
     // drag increase during turns.
-    float cosPhi = sqrtf((rotMat.a.y*rotMat.a.y) + (rotMat.b.y*rotMat.b.y));
-    float STEdot_dem = _rollComp * (1.0f/constrain_float(cosPhi * cosPhi , 0.1f, 1.0f) - 1.0f);
+    const float cosPhi_sq = sq(rotMat.a.y) + sq(rotMat.b.y);
+    float STEdot_dem = _rollComp * (1.0f/constrain_float(cosPhi_sq, 0.1f, 1.0f) - 1.0f);
     _throttle_dem = _throttle_dem + STEdot_dem / (_STEdot_max - _STEdot_min) * (_THRmaxf - _THRminf);
 }
 
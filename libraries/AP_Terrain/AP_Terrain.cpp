@@ -46,12 +46,40 @@ const AP_Param::GroupInfo AP_Terrain::var_info[] = {
 
     // @Param: SPACING
     // @DisplayName: Terrain grid spacing
-    // @Description: Distance between terrain grid points in meters. This controls the horizontal resolution of the terrain data that is stored on te SD card and requested from the ground station. If your GCS is using the worldwide SRTM database then a resolution of 100 meters is appropriate. Some parts of the world may have higher resolution data available, such as 30 meter data available in the SRTM database in the USA. The grid spacing also controls how much data is kept in memory during flight. A larger grid spacing will allow for a larger amount of data in memory. A grid spacing of 100 meters results in the vehicle keeping 12 grid squares in memory with each grid square having a size of 2.7 kilometers by 3.2 kilometers. Any additional grid squares are stored on the SD once they are fetched from the GCS and will be demand loaded as needed.
+    // @Description: Distance between terrain grid points in meters. This controls the horizontal resolution of the terrain data that is stored on te SD card and requested from the ground station. If your GCS is using the worldwide SRTM database then a resolution of 100 meters is appropriate. Some parts of the world may have higher resolution data available, such as 30 meter data available in the SRTM database in the USA. The grid spacing also controls how much data is kept in memory during flight. A larger grid spacing will allow for a larger amount of data in memory. A grid spacing of 100 meters results in each of the TERRAIN_CACHE_SZ grid squares kept in memory having a size of 2.7 kilometers by 3.2 kilometers. Any additional grid squares are stored on the SD once they are fetched from the GCS and will be demand loaded as needed.
     // @Units: m
     // @Increment: 1
     // @User: Advanced
     AP_GROUPINFO("SPACING",   1, AP_Terrain, grid_spacing, 100),
 
+    // @Param: CACHE_SZ
+    // @DisplayName: Terrain cache size
+    // @Description: The number of grid squares of terrain data kept in memory. Each grid square takes about 2k of memory. Larger caches avoid reloading squares from the SD card on long or fast flights, and leave more room for squares being loaded ahead of the vehicle. If there is not enough memory a smaller cache is used.
+    // @Range: 4 128
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("CACHE_SZ",  2, AP_Terrain, cache_size_param, TERRAIN_GRID_BLOCK_CACHE_SIZE),
+
+#if AP_TERRAIN_MMAP_ENABLED
+    // @Param: MMAP
+    // @DisplayName: Terrain files mapped into memory
+    // @Description: Map the terrain data files into memory, and read terrain heights directly from them where a file has complete grid squares. This avoids loading those squares into the cache from disk and requesting them from the ground station. It is only available on boards with an operating system, and is most useful with a preloaded terrain directory.
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO("MMAP",      3, AP_Terrain, mmap_enable, 0),
+#endif
+
+#if AP_TERRAIN_COMPRESS_ENABLED
+    // @Param: FORMAT
+    // @DisplayName: Terrain data format
+    // @Description: The format of the terrain data stored on the SD card. The compressed format takes half the space of the normal format, allowing a smaller TERRAIN_SPACING for the same storage. It is exact for nearly all terrain, and where it can't be, heights are rounded up. Compressed data is kept in separate files, so changing the format requires the data to be fetched from the ground station again. Mapping the files into memory is not available with the compressed format.
+    // @Values: 1:Normal,2:Compressed
+    // @RebootRequired: True
+    // @User: Advanced
+    AP_GROUPINFO("FORMAT",    4, AP_Terrain, format_param, TERRAIN_GRID_FORMAT_VERSION),
+#endif
+
+
     AP_GROUPEND
 };
 
@@ -96,8 +124,10 @@ bool AP_Terrain::height_amsl(const Location &loc, float &height, bool corrected)
 
     calculate_grid_info(loc, info);
 
-    // find the grid
-    const struct grid_block &grid = find_grid_cache(info).grid;
+    // find the grid, straight from a mapped degree file if it has
+    // the whole block
+    const struct grid_block *mapped = find_mmap_block(info);
+    const struct grid_block &grid = mapped != nullptr ? *mapped : find_grid_cache(info).grid;
 
     /*
       note that we rely on the one square overlap to ensure these
@@ -318,6 +348,9 @@ void AP_Terrain::update(void)
     // check for pending rally data
     update_rally_data();
 
+    // load blocks we are heading into
+    update_prefetch();
+
     // update capabilities and status
     if (allocate()) {
         if (!pos_valid) {
@@ -348,10 +381,12 @@ void AP_Terrain::log_terrain_data()
     float terrain_height = 0;
     float current_height = 0;
     uint16_t pending, loaded;
+    uint16_t io_queued, io_latency_ms;
 
     height_amsl(loc, terrain_height, false);
     height_above_terrain(current_height, true);
     get_statistics(pending, loaded);
+    get_io_statistics(io_queued, io_latency_ms);
 
     struct log_TERRAIN pkt = {
         LOG_PACKET_HEADER_INIT(LOG_TERRAIN_MSG),
@@ -366,6 +401,14 @@ void AP_Terrain::log_terrain_data()
         loaded         : loaded
     };
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
+
+    struct log_TERRAIN_IO io_pkt = {
+        LOG_PACKET_HEADER_INIT(LOG_TERRAIN_IO_MSG),
+        time_us        : AP_HAL::micros64(),
+        queued         : io_queued,
+        max_latency_ms : io_latency_ms
+    };
+    AP::logger().WriteBlock(&io_pkt, sizeof(io_pkt));
 }
 
 /*
@@ -380,13 +423,42 @@ bool AP_Terrain::allocate(void)
     if (cache != nullptr) {
         return true;
     }
-    cache = (struct grid_cache *)calloc(TERRAIN_GRID_BLOCK_CACHE_SIZE, sizeof(cache[0]));
-    if (cache == nullptr) {
+    uint8_t size = constrain_int16(cache_size_param, TERRAIN_GRID_BLOCK_CACHE_MIN, UINT8_MAX);
+    while (true) {
+        cache = (struct grid_cache *)calloc(size, sizeof(cache[0]));
+        if (cache != nullptr) {
+            break;
+        }
+        if (size <= TERRAIN_GRID_BLOCK_CACHE_MIN) {
+            enable.set(0);
+            gcs().send_text(MAV_SEVERITY_CRITICAL, "Terrain: Allocation failed");
+            return false;
+        }
+        size = MAX(size/2, TERRAIN_GRID_BLOCK_CACHE_MIN);
+    }
+    // a full batch of disk IO buffers if there is room, otherwise one
+    disk_io_size = TERRAIN_IO_BATCH_SIZE;
+    disk_blocks = (union grid_io_block *)calloc(disk_io_size, sizeof(disk_blocks[0]));
+    if (disk_blocks == nullptr) {
+        disk_io_size = 1;
+        disk_blocks = (union grid_io_block *)calloc(disk_io_size, sizeof(disk_blocks[0]));
+    }
+    if (disk_blocks == nullptr) {
+        free(cache);
+        cache = nullptr;
         enable.set(0);
         gcs().send_text(MAV_SEVERITY_CRITICAL, "Terrain: Allocation failed");
         return false;
     }
-    cache_size = TERRAIN_GRID_BLOCK_CACHE_SIZE;
+    if (size != cache_size_param) {
+        gcs().send_text(MAV_SEVERITY_WARNING, "Terrain: cache size %u", (unsigned)size);
+    }
+#if AP_TERRAIN_COMPRESS_ENABLED
+    if (format_param == TERRAIN_GRID_FORMAT_COMPRESSED) {
+        file_format = TERRAIN_GRID_FORMAT_COMPRESSED;
+    }
+#endif
+    cache_size = size;
     return true;
 }
 
@@ -52,12 +52,53 @@
 #define TERRAIN_GRID_BLOCK_SIZE_X (TERRAIN_GRID_MAVLINK_SIZE*TERRAIN_GRID_BLOCK_MUL_X)
 #define TERRAIN_GRID_BLOCK_SIZE_Y (TERRAIN_GRID_MAVLINK_SIZE*TERRAIN_GRID_BLOCK_MUL_Y)
 
-// number of grid_blocks in the LRU memory cache
+// default number of grid_blocks in the LRU memory cache. Boards with
+// plenty of RAM may raise this in their hwdef.  The TERRAIN_CACHE_SZ
+// parameter can change it at boot
+#ifndef TERRAIN_GRID_BLOCK_CACHE_SIZE
 #define TERRAIN_GRID_BLOCK_CACHE_SIZE 12
+#endif
+
+// don't fall back to less than this many cache blocks if allocation
+// of TERRAIN_CACHE_SZ fails
+#define TERRAIN_GRID_BLOCK_CACHE_MIN 4
+
+// seconds of travel along the ground velocity to prefetch blocks for
+#define TERRAIN_PREFETCH_TIME_S 120
+
+// number of grid_blocks in a batch of disk IO, each taking a 2k
+// buffer. Blocks which follow each other in a file are read or written
+// together, and spare buffers are used to read ahead
+#ifndef TERRAIN_IO_BATCH_SIZE
+#if HAL_MINIMIZE_FEATURES
+#define TERRAIN_IO_BATCH_SIZE 2
+#else
+#define TERRAIN_IO_BATCH_SIZE 4
+#endif
+#endif
+
+// on boards with a full OS the degree files can be mapped into
+// memory, and height_amsl() reads complete blocks straight from them
+#ifndef AP_TERRAIN_MMAP_ENABLED
+#define AP_TERRAIN_MMAP_ENABLED (HAL_OS_POSIX_IO && (CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX))
+#endif
+
+// number of degree files which can be mapped at once
+#ifndef TERRAIN_MMAP_FILES
+#define TERRAIN_MMAP_FILES 4
+#endif
 
 // format of grid on disk
 #define TERRAIN_GRID_FORMAT_VERSION 1
 
+// format of compressed grids on disk, selected with TERRAIN_FORMAT.
+// These take half the space of the normal format, allowing a finer
+// grid spacing for the same storage
+#ifndef AP_TERRAIN_COMPRESS_ENABLED
+#define AP_TERRAIN_COMPRESS_ENABLED !HAL_MINIMIZE_FEATURES
+#endif
+#define TERRAIN_GRID_FORMAT_COMPRESSED 2
+
 #if TERRAIN_DEBUG
 #define ASSERT_RANGE(v,minv,maxv) assert((v)<=(maxv)&&(v)>=(minv))
 #else
@@ -179,6 +220,12 @@ public:
      */
     void get_statistics(uint16_t &pending, uint16_t &loaded);
 
+    /*
+      get the number of blocks waiting for disk IO, and the longest
+      time a batch of IO has taken since the last call
+     */
+    void get_io_statistics(uint16_t &queued, uint16_t &max_latency_ms);
+
 private:
     // allocate the terrain subsystem data
     bool allocate(void);
@@ -225,6 +272,58 @@ private:
         uint8_t buffer[2048];
     };
 
+#if AP_TERRAIN_COMPRESS_ENABLED
+    /*
+      a grid_block in the compressed format. Each height is stored as
+      the difference from a prediction made from the heights to the
+      south and west of it, in units of 1<<shift meters. The shift is
+      the smallest that fits every difference in 8 bits, normally
+      zero. Where it isn't zero heights are rounded up
+     */
+    struct PACKED grid_block_z {
+        // bitmap of 4x4 grids filled in from GCS (56 bits are used)
+        uint64_t bitmap;
+
+        // south west corner of block in degrees*10^7
+        int32_t lat;
+        int32_t lon;
+
+        // crc of whole block, taken with crc=0
+        uint16_t crc;
+
+        // format version number
+        uint16_t version;
+
+        // grid spacing in meters
+        uint16_t spacing;
+
+        // indices info 32x28 grids for this degree reference
+        uint16_t grid_idx_x;
+        uint16_t grid_idx_y;
+
+        // rounded latitude/longitude in degrees.
+        int16_t lon_degrees;
+        int8_t lat_degrees;
+
+        // scale of the differences
+        uint8_t shift;
+
+        // height of the south west corner in meters
+        int16_t base;
+
+        // differences of the heights from their prediction
+        int8_t delta[TERRAIN_GRID_BLOCK_SIZE_X][TERRAIN_GRID_BLOCK_SIZE_Y];
+    };
+
+    /*
+      grid_block_z for disk IO, aligned on 1024 byte boundaries
+     */
+    union grid_io_block_z {
+        struct grid_block_z block;
+        uint8_t buffer[1024];
+    };
+#endif
+
     enum GridCacheState {
         GRID_CACHE_INVALID=0,    // when first initialised
         GRID_CACHE_DISKWAIT=1,   // when waiting for disk read
@@ -310,18 +409,60 @@ private:
      */
     uint8_t bitcount64(uint64_t b);
 
+    /*
+      a block in a batch of disk IO
+     */
+    struct disk_io_block {
+        // south west corner of block in degrees*10^7
+        int32_t lat;
+        int32_t lon;
+
+        // the degree file and the position in the file, in blocks
+        int8_t lat_degrees;
+        int16_t lon_degrees;
+        uint16_t grid_idx_x;
+        uint16_t grid_idx_y;
+        uint32_t offset;
+
+        // bitmap of the block written
+        uint64_t bitmap;
+
+        // read without being wanted by the cache
+        bool read_ahead;
+    };
+
     /*
       disk IO functions
      */
-    int16_t find_io_idx(enum GridCacheState state);
-    uint16_t get_block_crc(struct grid_block &block);
+    int16_t find_io_idx(int32_t lat, int32_t lon, enum GridCacheState state);
+    uint16_t get_block_crc(const struct grid_block &block) const;
+    uint16_t east_blocks(int8_t lat_degrees, int16_t lon_degrees) const;
+    uint32_t file_offset(const struct disk_io_block &io) const;
+    void make_disk_io(const struct grid_block &block, struct disk_io_block &io) const;
+    bool add_disk_io(const struct disk_io_block &io);
+    void add_read_ahead(const struct grid_block &block, int8_t dy);
     void check_disk_read(void);
     void check_disk_write(void);
+    void finish_disk_read(void);
+    void finish_disk_write(void);
     void io_timer(void);
-    void open_file(void);
-    void seek_offset(void);
-    void write_block(void);
-    void read_block(void);
+    bool set_file_path(int8_t lat_degrees, int16_t lon_degrees);
+    void open_file(const struct disk_io_block &io);
+    uint32_t io_block_size(void) const;
+    void seek_offset(uint32_t offset);
+    void write_blocks(uint8_t first, uint8_t count);
+    void read_blocks(uint8_t first, uint8_t count);
+
+#if AP_TERRAIN_COMPRESS_ENABLED
+    /*
+      compressed format functions
+     */
+    uint16_t get_zblock_crc(const struct grid_block_z &block) const;
+    void compress_block(const struct grid_block &block, struct grid_block_z &zblock);
+    void expand_block(const struct grid_block_z &zblock, struct grid_block &block) const;
+    void write_zblocks(uint8_t first, uint8_t count);
+    void read_zblocks(uint8_t first, uint8_t count);
+#endif
 
     /*
       check for missing mission terrain data
@@ -333,10 +474,38 @@ private:
      */
     void update_rally_data(void);
 
+    /*
+      load blocks ahead of the vehicle
+     */
+    void update_prefetch(void);
+    void prefetch_line(Location loc, float bearing, float distance, uint8_t &count, uint8_t max_blocks);
+
+    /*
+      find a complete block in a mapped degree file, or nullptr if
+      it isn't mapped, in which case the grid_cache is used
+     */
+#if AP_TERRAIN_MMAP_ENABLED
+    const struct grid_block *find_mmap_block(const struct grid_info &info);
+    void mmap_block_written(const struct disk_io_block &io);
+    void mmap_io(void);
+#else
+    const struct grid_block *find_mmap_block(const struct grid_info &info) { return nullptr; }
+#endif
+
 
     // parameters
     AP_Int8  enable;
     AP_Int16 grid_spacing; // meters between grid points
+    AP_Int16 cache_size_param; // grid_blocks to keep in memory
+#if AP_TERRAIN_MMAP_ENABLED
+    AP_Int8  mmap_enable;
+#endif
+#if AP_TERRAIN_COMPRESS_ENABLED
+    AP_Int8  format_param; // format of grids on disk
+#endif
+
+    // format of grids on disk, fixed at allocate()
+    uint8_t file_format = TERRAIN_GRID_FORMAT_VERSION;
 
     // reference to AP_Mission, so we can ask preload terrain data for 
     // all waypoints
@@ -346,7 +515,12 @@ private:
     uint8_t cache_size = 0;
     struct grid_cache *cache = nullptr;
 
-    // a grid_cache block waiting for disk IO
+    // index of the last block found, which is the one most likely to
+    // be wanted next
+    uint8_t last_cache_idx;
+
+    // a batch of grid_cache blocks waiting for disk IO, with a buffer
+    // for each, allocated with the cache
     enum DiskIoState {
         DiskIoIdle      = 0,
         DiskIoWaitWrite = 1,
@@ -355,7 +529,53 @@ private:
         DiskIoDoneWrite = 4
     };
     volatile enum DiskIoState disk_io_state;
-    union grid_io_block disk_block;
+    struct disk_io_block disk_io[TERRAIN_IO_BATCH_SIZE];
+    union grid_io_block *disk_blocks = nullptr;
+    uint8_t disk_io_size;
+    uint8_t disk_io_count;
+#if AP_TERRAIN_COMPRESS_ENABLED
+    // a compressed block being packed or unpacked by the IO thread
+    union grid_io_block_z disk_zblock;
+#endif
+
+    // when the batch in progress was started, and the longest a batch
+    // has taken since get_io_statistics()
+    uint32_t disk_io_start_ms;
+    uint32_t disk_io_max_latency_ms;
+
+#if AP_TERRAIN_MMAP_ENABLED
+    /*
+      degree files mapped into memory. The main thread owns an entry
+      when it is MmapFree, MmapMissing or MmapMapped, and moves it to
+      MmapWanted or MmapRelease for the IO thread to map or unmap it
+     */
+    enum MmapState {
+        MmapFree    = 0,
+        MmapWanted  = 1,
+        MmapMapped  = 2,
+        MmapMissing = 3,
+        MmapRelease = 4
+    };
+    enum MmapBlockCheck {
+        MmapBlockUnchecked = 0,
+        MmapBlockGood      = 1,
+        MmapBlockBad       = 2
+    };
+    struct mmap_file {
+        volatile enum MmapState state;
+        int8_t lat_degrees;
+        int16_t lon_degrees;
+        uint16_t spacing;
+        uint16_t east_blocks;
+        uint32_t last_access_ms;
+        const union grid_io_block *blocks;
+        uint32_t num_blocks;
+        // a MmapBlockCheck for each block, so the CRC is only checked
+        // the first time a block is used
+        uint8_t *checked;
+    } mmap_files[TERRAIN_MMAP_FILES];
+    uint8_t last_mmap_idx;
+#endif
 
     // last time we asked for more grids
     uint32_t last_request_time_ms[MAVLINK_COMM_NUM_BUFFERS];
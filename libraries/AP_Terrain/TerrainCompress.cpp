@@ -0,0 +1,220 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  compressed format of grid blocks on disk
+
+  Each height is predicted from the plane through the heights already
+  decoded to the south, west and south-west of it, and only the
+  difference is stored, in 8 bits. Real terrain is smooth enough at
+  the grid spacings used that the differences nearly always fit, so
+  the block is stored exactly in half the space. Where they don't fit
+  the differences are scaled down by a power of two for the whole
+  block, and rounded up so that terrain is never lower than the data
+  from the GCS
+ */
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Common/AP_Common.h>
+#include <AP_Math/AP_Math.h>
+#include "AP_Terrain.h"
+
+#if AP_TERRAIN_AVAILABLE && AP_TERRAIN_COMPRESS_ENABLED
+
+#include <assert.h>
+#include <stdio.h>
+#if HAL_OS_POSIX_IO
+#include <unistd.h>
+#include <errno.h>
+#endif
+#include <sys/types.h>
+
+extern const AP_HAL::HAL& hal;
+
+/*
+  predict the height at y in row cur from the decoded heights to the
+  south, in row prev, and to the west
+ */
+static int32_t predict_height(const int16_t *prev, const int16_t *cur, uint8_t x, uint8_t y, int16_t base)
+{
+    if (x == 0) {
+        return y == 0 ? base : cur[y-1];
+    }
+    if (y == 0) {
+        return prev[0];
+    }
+    return prev[y] + cur[y-1] - prev[y-1];
+}
+
+/*
+  compress a grid block. Heights in 4x4 grids missing from the bitmap
+  are stored as their prediction, so they don't affect the scale
+ */
+void AP_Terrain::compress_block(const struct grid_block &block, struct grid_block_z &zblock)
+{
+    memset(&zblock, 0, sizeof(zblock));
+    zblock.bitmap = block.bitmap;
+    zblock.lat = block.lat;
+    zblock.lon = block.lon;
+    zblock.version = TERRAIN_GRID_FORMAT_COMPRESSED;
+    zblock.spacing = block.spacing;
+    zblock.grid_idx_x = block.grid_idx_x;
+    zblock.grid_idx_y = block.grid_idx_y;
+    zblock.lon_degrees = block.lon_degrees;
+    zblock.lat_degrees = block.lat_degrees;
+    zblock.base = block.height[0][0];
+
+    // the two rows of heights as expand_block() will decode them
+    int16_t rows[2][TERRAIN_GRID_BLOCK_SIZE_Y];
+
+    for (uint8_t shift=0; shift<16; shift++) {
+        bool fits = true;
+        for (uint8_t x=0; x<TERRAIN_GRID_BLOCK_SIZE_X && fits; x++) {
+            const int16_t *prev = rows[(x+1)%2];
+            int16_t *cur = rows[x%2];
+            for (uint8_t y=0; y<TERRAIN_GRID_BLOCK_SIZE_Y; y++) {
+                const int32_t prediction = predict_height(prev, cur, x, y, zblock.base);
+                int32_t delta = 0;
+                if (check_bitmap(block, x, y)) {
+                    // rounded up
+                    const int32_t diff = block.height[x][y] - prediction;
+                    delta = diff >= 0 ? (diff + (1L<<shift) - 1) >> shift : -((-diff) >> shift);
+                }
+                if (delta < INT8_MIN || delta > INT8_MAX) {
+                    fits = false;
+                    break;
+                }
+                zblock.delta[x][y] = delta;
+                cur[y] = constrain_int32(prediction + delta * (1L<<shift), INT16_MIN, INT16_MAX);
+            }
+        }
+        if (fits) {
+            zblock.shift = shift;
+            break;
+        }
+    }
+    zblock.crc = get_zblock_crc(zblock);
+}
+
+/*
+  expand a compressed block into a grid block
+ */
+void AP_Terrain::expand_block(const struct grid_block_z &zblock, struct grid_block &block) const
+{
+    memset(&block, 0, sizeof(block));
+    block.bitmap = zblock.bitmap;
+    block.lat = zblock.lat;
+    block.lon = zblock.lon;
+    block.version = TERRAIN_GRID_FORMAT_VERSION;
+    block.spacing = zblock.spacing;
+    block.grid_idx_x = zblock.grid_idx_x;
+    block.grid_idx_y = zblock.grid_idx_y;
+    block.lon_degrees = zblock.lon_degrees;
+    block.lat_degrees = zblock.lat_degrees;
+
+    // decoded into aligned rows, as the block is packed
+    int16_t rows[2][TERRAIN_GRID_BLOCK_SIZE_Y];
+    for (uint8_t x=0; x<TERRAIN_GRID_BLOCK_SIZE_X; x++) {
+        const int16_t *prev = rows[(x+1)%2];
+        int16_t *cur = rows[x%2];
+        for (uint8_t y=0; y<TERRAIN_GRID_BLOCK_SIZE_Y; y++) {
+            const int32_t prediction = predict_height(prev, cur, x, y, zblock.base);
+            cur[y] = constrain_int32(prediction + zblock.delta[x][y] * (1L<<zblock.shift), INT16_MIN, INT16_MAX);
+            block.height[x][y] = cur[y];
+        }
+    }
+    block.crc = get_block_crc(block);
+}
+
+/********************************************************
+The functions below run in the IO timer context, on the batch owned
+by it
+*********************************************************/
+
+/*
+  write out count blocks of the batch from first in the compressed
+  format. The blocks are packed into the start of the batch buffers
+  so they are written together
+ */
+void AP_Terrain::write_zblocks(uint8_t first, uint8_t count)
+{
+    uint8_t *buf = disk_blocks[first].buffer;
+    for (uint8_t i=0; i<count; i++) {
+        // block i is packed over blocks already compressed
+        compress_block(disk_blocks[first+i].block, disk_zblock.block);
+        memcpy(&buf[i*sizeof(disk_zblock)], &disk_zblock, sizeof(disk_zblock));
+    }
+
+    const ssize_t len = count * sizeof(disk_zblock);
+    ssize_t ret = ::write(fd, buf, len);
+    if (ret != len) {
+#if TERRAIN_DEBUG
+        hal.console->printf("write failed - %s\n", strerror(errno));
+#endif
+        ::close(fd);
+        fd = -1;
+        io_failure = true;
+    } else {
+        ::fsync(fd);
+#if TERRAIN_DEBUG
+        printf("wrote %u compressed blocks at %ld %ld ret=%d\n",
+               (unsigned)count,
+               (long)disk_io[first].lat,
+               (long)disk_io[first].lon,
+               (int)ret);
+#endif
+    }
+}
+
+/*
+  read in count blocks of the batch from first in the compressed
+  format. They are read into the end of the batch buffers, and each is
+  expanded into its buffer, which never overlaps the blocks after it
+ */
+void AP_Terrain::read_zblocks(uint8_t first, uint8_t count)
+{
+    uint8_t *buf = disk_blocks[first].buffer;
+    const uint32_t zofs = count * (sizeof(disk_blocks[0]) - sizeof(disk_zblock));
+    const ssize_t ret = ::read(fd, &buf[zofs], count * sizeof(disk_zblock));
+    for (uint8_t i=0; i<count; i++) {
+        memcpy(&disk_zblock, &buf[zofs + i*sizeof(disk_zblock)], sizeof(disk_zblock));
+        const struct grid_block_z &zblock = disk_zblock.block;
+        struct grid_block &block = disk_blocks[first+i].block;
+        const int32_t lat = disk_io[first+i].lat;
+        const int32_t lon = disk_io[first+i].lon;
+        if (ret < (ssize_t)((i+1) * sizeof(disk_zblock)) ||
+            zblock.lat != lat ||
+            zblock.lon != lon ||
+            zblock.bitmap == 0 ||
+            zblock.spacing != grid_spacing ||
+            zblock.version != TERRAIN_GRID_FORMAT_COMPRESSED ||
+            zblock.crc != get_zblock_crc(zblock)) {
+            // a missing block on disk
+            memset(&disk_blocks[first+i], 0, sizeof(disk_blocks[0]));
+            block.lat = lat;
+            block.lon = lon;
+            block.bitmap = 0;
+        } else {
+            expand_block(zblock, block);
+#if TERRAIN_DEBUG
+            printf("read compressed block at %ld %ld shift=%u\n",
+                   (long)lat,
+                   (long)lon,
+                   (unsigned)zblock.shift);
+#endif
+        }
+    }
+}
+
+#endif // AP_TERRAIN_AVAILABLE && AP_TERRAIN_COMPRESS_ENABLED
@@ -73,6 +73,11 @@ bool AP_Terrain::request_missing(mavlink_channel_t chan, struct grid_cache &gcac
  */
 bool AP_Terrain::request_missing(mavlink_channel_t chan, const struct grid_info &info)
 {
+    if (find_mmap_block(info) != nullptr) {
+        // a complete block in a mapped file
+        return false;
+    }
+
     // find the grid
     struct grid_cache &gcache = find_grid_cache(info);
     return request_missing(chan, gcache);
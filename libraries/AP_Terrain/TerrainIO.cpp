@@ -37,18 +37,127 @@
 
 extern const AP_HAL::HAL& hal;
 
+/*
+  add a block to the batch for the IO thread, keeping the batch in
+  file order so that blocks which follow each other in a file are done
+  with one read or write. Returns false if the batch is full or
+  already has the block
+ */
+bool AP_Terrain::add_disk_io(const struct disk_io_block &io)
+{
+    if (disk_io_count >= disk_io_size) {
+        return false;
+    }
+    for (uint8_t i=0; i<disk_io_count; i++) {
+        if (disk_io[i].lat == io.lat && disk_io[i].lon == io.lon) {
+            return false;
+        }
+    }
+    uint8_t i = disk_io_count;
+    while (i > 0) {
+        const struct disk_io_block &prev = disk_io[i-1];
+        if (prev.lat_degrees < io.lat_degrees ||
+            (prev.lat_degrees == io.lat_degrees &&
+             (prev.lon_degrees < io.lon_degrees ||
+              (prev.lon_degrees == io.lon_degrees && prev.offset < io.offset)))) {
+            break;
+        }
+        disk_io[i] = prev;
+        i--;
+    }
+    disk_io[i] = io;
+    disk_io_count++;
+    return true;
+}
+
+/*
+  fill in a disk_io_block for a grid block
+ */
+void AP_Terrain::make_disk_io(const struct grid_block &block, struct disk_io_block &io) const
+{
+    io.lat = block.lat;
+    io.lon = block.lon;
+    io.lat_degrees = block.lat_degrees;
+    io.lon_degrees = block.lon_degrees;
+    io.grid_idx_x = block.grid_idx_x;
+    io.grid_idx_y = block.grid_idx_y;
+    io.offset = file_offset(io);
+    io.bitmap = block.bitmap;
+    io.read_ahead = false;
+}
+
+/*
+  add a read of the block next to block in its file, dy blocks to the
+  east, if it isn't in the cache. It costs little more than the read
+  of block, and is likely to be wanted soon
+ */
+void AP_Terrain::add_read_ahead(const struct grid_block &block, int8_t dy)
+{
+    if (block.grid_idx_y + dy < 0 ||
+        block.grid_idx_y + dy >= east_blocks(block.lat_degrees, block.lon_degrees)) {
+        return;
+    }
+    struct disk_io_block io;
+    io.lat_degrees = block.lat_degrees;
+    io.lon_degrees = block.lon_degrees;
+    io.grid_idx_x = block.grid_idx_x;
+    io.grid_idx_y = block.grid_idx_y + dy;
+
+    // the SW corner, as calculate_grid_info() finds it
+    Location ref;
+    ref.lat = io.lat_degrees*10*1000*1000L;
+    ref.lng = io.lon_degrees*10*1000*1000L;
+    ref.offset(io.grid_idx_x * TERRAIN_GRID_BLOCK_SPACING_X * (float)grid_spacing,
+               io.grid_idx_y * TERRAIN_GRID_BLOCK_SPACING_Y * (float)grid_spacing);
+    io.lat = ref.lat;
+    io.lon = ref.lng;
+
+    for (uint16_t i=0; i<cache_size; i++) {
+        if (cache[i].grid.lat == io.lat &&
+            cache[i].grid.lon == io.lon &&
+            cache[i].grid.spacing == grid_spacing) {
+            return;
+        }
+    }
+    io.offset = file_offset(io);
+    io.bitmap = 0;
+    io.read_ahead = true;
+    add_disk_io(io);
+}
+
 /*
   check for blocks that need to be read from disk
  */
 void AP_Terrain::check_disk_read(void)
 {
+    disk_io_count = 0;
     for (uint16_t i=0; i<cache_size; i++) {
         if (cache[i].state == GRID_CACHE_DISKWAIT) {
-            disk_block.block = cache[i].grid;
-            disk_io_state = DiskIoWaitRead;
-            return;
+            struct disk_io_block io;
+            make_disk_io(cache[i].grid, io);
+            add_disk_io(io);
+        }
+    }
+    if (disk_io_count == 0) {
+        return;
+    }
+
+    // fill any spare buffers with the neighbours of the wanted blocks
+    for (uint16_t i=0; i<cache_size && disk_io_count < disk_io_size; i++) {
+        if (cache[i].state == GRID_CACHE_DISKWAIT) {
+            add_read_ahead(cache[i].grid, 1);
+            add_read_ahead(cache[i].grid, -1);
         }
-    }    
+    }
+
+    // the buffers start out with the block expected in them
+    for (uint8_t i=0; i<disk_io_count; i++) {
+        memset(&disk_blocks[i], 0, sizeof(disk_blocks[i]));
+        disk_blocks[i].block.lat = disk_io[i].lat;
+        disk_blocks[i].block.lon = disk_io[i].lon;
+    }
+    disk_io_start_ms = AP_HAL::millis();
+    disk_io_state = DiskIoWaitRead;
 }
 
 /*
@@ -56,13 +165,94 @@ void AP_Terrain::check_disk_read(void)
  */
 void AP_Terrain::check_disk_write(void)
 {
+    disk_io_count = 0;
     for (uint16_t i=0; i<cache_size; i++) {
         if (cache[i].state == GRID_CACHE_DIRTY) {
-            disk_block.block = cache[i].grid;
-            disk_io_state = DiskIoWaitWrite;
-            return;
+            struct disk_io_block io;
+            make_disk_io(cache[i].grid, io);
+            if (!add_disk_io(io) && disk_io_count == disk_io_size) {
+                break;
+            }
+        }
+    }
+    if (disk_io_count == 0) {
+        return;
+    }
+    for (uint8_t i=0; i<disk_io_count; i++) {
+        const int16_t cache_idx = find_io_idx(disk_io[i].lat, disk_io[i].lon, GRID_CACHE_DIRTY);
+        disk_blocks[i].block = cache[cache_idx].grid;
+    }
+    disk_io_start_ms = AP_HAL::millis();
+    disk_io_state = DiskIoWaitWrite;
+}
+
+/*
+  put the blocks of a completed read into the cache
+ */
+void AP_Terrain::finish_disk_read(void)
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    for (uint8_t i=0; i<disk_io_count; i++) {
+        const struct grid_block &block = disk_blocks[i].block;
+        int16_t cache_idx = find_io_idx(block.lat, block.lon, GRID_CACHE_DISKWAIT);
+        if (disk_io[i].read_ahead) {
+            if (cache_idx != -1 && cache[cache_idx].state != GRID_CACHE_DISKWAIT) {
+                // it has been loaded some other way
+                continue;
+            }
+            if (cache_idx == -1) {
+                if (block.bitmap == 0) {
+                    continue;
+                }
+                // only displace a block nothing has wanted for as long
+                // as we prefetch for
+                for (uint16_t j=0; j<cache_size; j++) {
+                    if (cache[j].state == GRID_CACHE_INVALID) {
+                        cache_idx = j;
+                        break;
+                    }
+                    if (cache[j].state == GRID_CACHE_VALID &&
+                        now_ms - cache[j].last_access_ms > TERRAIN_PREFETCH_TIME_S*1000UL &&
+                        (cache_idx == -1 || cache[j].last_access_ms < cache[cache_idx].last_access_ms)) {
+                        cache_idx = j;
+                    }
+                }
+                if (cache_idx == -1) {
+                    continue;
+                }
+            }
         }
-    }    
+        if (cache_idx != -1) {
+            if (block.bitmap != 0) {
+                // when bitmap is zero we read an empty block
+                cache[cache_idx].grid = block;
+            }
+            cache[cache_idx].state = GRID_CACHE_VALID;
+            cache[cache_idx].last_access_ms = now_ms;
+        }
+    }
+}
+
+/*
+  mark the blocks of a completed write as clean
+ */
+void AP_Terrain::finish_disk_write(void)
+{
+    // the buffers may have been packed in place, so only the batch
+    // describes what was written
+    for (uint8_t i=0; i<disk_io_count; i++) {
+        const struct disk_io_block &io = disk_io[i];
+        int16_t cache_idx = find_io_idx(io.lat, io.lon, GRID_CACHE_DIRTY);
+        if (cache_idx != -1) {
+            if (cache[cache_idx].grid.bitmap == io.bitmap) {
+                // only mark valid if more grids haven't been added
+                cache[cache_idx].state = GRID_CACHE_VALID;
+            }
+        }
+#if AP_TERRAIN_MMAP_ENABLED
+        mmap_block_written(io);
+#endif
+    }
 }
 
 /*
@@ -81,7 +271,7 @@ void AP_Terrain::schedule_disk_io(void)
 
     switch (disk_io_state) {
     case DiskIoIdle:
-        // look for a block that needs reading or writing
+        // look for blocks that need reading or writing
         check_disk_read();
         if (disk_io_state == DiskIoIdle) {
             // still idle, check for writes
@@ -89,34 +279,17 @@ void AP_Terrain::schedule_disk_io(void)
         }
         break;
         
-    case DiskIoDoneRead: {
-        // a read has completed
-        int16_t cache_idx = find_io_idx(GRID_CACHE_DISKWAIT);
-        if (cache_idx != -1) {
-            if (disk_block.block.bitmap != 0) {
-                // when bitmap is zero we read an empty block
-                cache[cache_idx].grid = disk_block.block;
-            }
-            cache[cache_idx].state = GRID_CACHE_VALID;
-            cache[cache_idx].last_access_ms = AP_HAL::millis();
+    case DiskIoDoneRead:
+    case DiskIoDoneWrite:
+        if (disk_io_state == DiskIoDoneRead) {
+            finish_disk_read();
+        } else {
+            finish_disk_write();
         }
+        disk_io_max_latency_ms = MAX(disk_io_max_latency_ms, AP_HAL::millis() - disk_io_start_ms);
         disk_io_state = DiskIoIdle;
         break;
-    }
 
-    case DiskIoDoneWrite: {
-        // a write has completed
-        int16_t cache_idx = find_io_idx(GRID_CACHE_DIRTY);
-        if (cache_idx != -1) {
-            if (cache[cache_idx].grid.bitmap == disk_block.block.bitmap) {
-                // only mark valid if more grids haven't been added
-                cache[cache_idx].state = GRID_CACHE_VALID;
-            }
-        }
-        disk_io_state = DiskIoIdle;
-        break;
-    }
-        
     case DiskIoWaitWrite:
     case DiskIoWaitRead:
         // waiting for io_timer()
@@ -124,6 +297,49 @@ void AP_Terrain::schedule_disk_io(void)
     }
 }
 
+/*
+  get the number of blocks waiting for disk IO, and the longest time
+  a batch of IO has taken since the last call
+ */
+void AP_Terrain::get_io_statistics(uint16_t &queued, uint16_t &max_latency_ms)
+{
+    queued = 0;
+    for (uint16_t i=0; i<cache_size; i++) {
+        if (cache[i].state == GRID_CACHE_DISKWAIT ||
+            cache[i].state == GRID_CACHE_DIRTY) {
+            queued++;
+        }
+    }
+    max_latency_ms = MIN(disk_io_max_latency_ms, (uint32_t)UINT16_MAX);
+    disk_io_max_latency_ms = 0;
+}
+
+/*
+  the number of grid blocks east to west in a degree file at a
+  latitude, being the length of each row of the file
+ */
+uint16_t AP_Terrain::east_blocks(int8_t lat_degrees, int16_t lon_degrees) const
+{
+    Location loc1, loc2;
+    loc1.lat = lat_degrees*10*1000*1000L;
+    loc1.lng = lon_degrees*10*1000*1000L;
+    loc2.lat = lat_degrees*10*1000*1000L;
+    loc2.lng = (lon_degrees+1)*10*1000*1000L;
+
+    // shift another two blocks east to ensure room is available
+    loc2.offset(0, 2*grid_spacing*TERRAIN_GRID_BLOCK_SIZE_Y);
+    const Vector2f offset = loc1.get_distance_NE(loc2);
+    return offset.y / (grid_spacing*TERRAIN_GRID_BLOCK_SIZE_Y);
+}
+
+/*
+  the position of a block in its degree file, in blocks
+ */
+uint32_t AP_Terrain::file_offset(const struct disk_io_block &io) const
+{
+    return east_blocks(io.lat_degrees, io.lon_degrees) * io.grid_idx_x + io.grid_idx_y;
+}
+
 
 /********************************************************
 All the functions below this point run in the IO timer context, which
@@ -131,26 +347,20 @@ is a separate thread. The code uses the state machine controlled by
 disk_io_state to manage who has access to the structures and to
 prevent race conditions.
 
-The IO timer context owns the data when disk_io_state is
-DiskIoWaitWrite or DiskIoWaitRead. The main thread owns the data when
-disk_io_state is DiskIoIdle, DiskIoDoneWrite or DiskIoDoneRead
+The IO timer context owns the batch in disk_io and disk_blocks when
+disk_io_state is DiskIoWaitWrite or DiskIoWaitRead. The main thread
+owns them when disk_io_state is DiskIoIdle, DiskIoDoneWrite or
+DiskIoDoneRead
 
 All file operations are done by the IO thread.
 *********************************************************/
 
 
 /*
-  open the current degree file
+  set file_path to the name of a degree file
  */
-void AP_Terrain::open_file(void)
+bool AP_Terrain::set_file_path(int8_t lat_degrees, int16_t lon_degrees)
 {
-    struct grid_block &block = disk_block.block;
-    if (fd != -1 && 
-        block.lat_degrees == file_lat_degrees &&
-        block.lon_degrees == file_lon_degrees) {
-        // already open on right file
-        return;
-    }
     if (file_path == nullptr) {
         const char* terrain_dir = hal.util->get_custom_terrain_directory();
         if (terrain_dir == nullptr) {
@@ -159,26 +369,45 @@ void AP_Terrain::open_file(void)
         if (asprintf(&file_path, "%s/NxxExxx.DAT", terrain_dir) <= 0) {
             io_failure = true;
             file_path = nullptr;
-            return;
+            return false;
         }
     }
     if (file_path == nullptr) {
         io_failure = true;
-        return;
+        return false;
     }
     char *p = &file_path[strlen(file_path)-12];
     if (*p != '/') {
         io_failure = true;
-        return;        
+        return false;
+    }
+    snprintf(p, 13, "/%c%02u%c%03u.%s",
+             lat_degrees<0?'S':'N',
+             (unsigned)MIN(abs((int32_t)lat_degrees), 99),
+             lon_degrees<0?'W':'E',
+             (unsigned)MIN(abs((int32_t)lon_degrees), 999),
+             file_format == TERRAIN_GRID_FORMAT_VERSION ? "DAT" : "DTZ");
+    return true;
+}
+
+/*
+  open the degree file of a block
+ */
+void AP_Terrain::open_file(const struct disk_io_block &io)
+{
+    if (fd != -1 && 
+        io.lat_degrees == file_lat_degrees &&
+        io.lon_degrees == file_lon_degrees) {
+        // already open on right file
+        return;
+    }
+    if (!set_file_path(io.lat_degrees, io.lon_degrees)) {
+        return;
     }
-    snprintf(p, 13, "/%c%02u%c%03u.DAT",
-             block.lat_degrees<0?'S':'N',
-             (unsigned)MIN(abs((int32_t)block.lat_degrees), 99),
-             block.lon_degrees<0?'W':'E',
-             (unsigned)MIN(abs((int32_t)block.lon_degrees), 999));
 
     // create directory if need be
     if (!directory_created) {
+        char *p = &file_path[strlen(file_path)-12];
         *p = 0;
         directory_created = !mkdir(file_path, 0755);
         *p = '/';
@@ -212,30 +441,29 @@ void AP_Terrain::open_file(void)
         return;
     }
 
-    file_lat_degrees = block.lat_degrees;
-    file_lon_degrees = block.lon_degrees;
+    file_lat_degrees = io.lat_degrees;
+    file_lon_degrees = io.lon_degrees;
 }
 
 /*
-  seek to the right offset for disk_block
+  the size of a block in the files
  */
-void AP_Terrain::seek_offset(void)
+uint32_t AP_Terrain::io_block_size(void) const
 {
-    struct grid_block &block = disk_block.block;
-    // work out how many longitude blocks there are at this latitude
-    Location loc1, loc2;
-    loc1.lat = block.lat_degrees*10*1000*1000L;
-    loc1.lng = block.lon_degrees*10*1000*1000L;
-    loc2.lat = block.lat_degrees*10*1000*1000L;
-    loc2.lng = (block.lon_degrees+1)*10*1000*1000L;
-
-    // shift another two blocks east to ensure room is available
-    loc2.offset(0, 2*grid_spacing*TERRAIN_GRID_BLOCK_SIZE_Y);
-    const Vector2f offset = loc1.get_distance_NE(loc2);
-    uint16_t east_blocks = offset.y / (grid_spacing*TERRAIN_GRID_BLOCK_SIZE_Y);
+#if AP_TERRAIN_COMPRESS_ENABLED
+    if (file_format == TERRAIN_GRID_FORMAT_COMPRESSED) {
+        return sizeof(union grid_io_block_z);
+    }
+#endif
+    return sizeof(union grid_io_block);
+}
 
-    uint32_t file_offset = (east_blocks * block.grid_idx_x + 
-                            block.grid_idx_y) * sizeof(union grid_io_block);
+/*
+  seek to a block in the open file
+ */
+void AP_Terrain::seek_offset(uint32_t offset)
+{
+    const uint32_t file_offset = offset * io_block_size();
     if (::lseek(fd, file_offset, SEEK_SET) != (off_t)file_offset) {
 #if TERRAIN_DEBUG
         hal.console->printf("Seek %lu failed - %s\n",
@@ -248,19 +476,29 @@ void AP_Terrain::seek_offset(void)
 }
 
 /*
-  write out disk_block
+  write out count blocks of the batch from first, which follow each
+  other in the file
  */
-void AP_Terrain::write_block(void)
+void AP_Terrain::write_blocks(uint8_t first, uint8_t count)
 {
-    seek_offset();
+    seek_offset(disk_io[first].offset);
     if (io_failure) {
         return;
     }
+#if AP_TERRAIN_COMPRESS_ENABLED
+    if (file_format == TERRAIN_GRID_FORMAT_COMPRESSED) {
+        write_zblocks(first, count);
+        return;
+    }
+#endif
 
-    disk_block.block.crc = get_block_crc(disk_block.block);
+    for (uint8_t i=first; i<first+count; i++) {
+        disk_blocks[i].block.crc = get_block_crc(disk_blocks[i].block);
+    }
 
-    ssize_t ret = ::write(fd, &disk_block, sizeof(disk_block));
-    if (ret  != sizeof(disk_block)) {
+    const ssize_t len = count * sizeof(disk_blocks[0]);
+    ssize_t ret = ::write(fd, &disk_blocks[first], len);
+    if (ret != len) {
 #if TERRAIN_DEBUG
         hal.console->printf("write failed - %s\n", strerror(errno));
 #endif
@@ -270,58 +508,66 @@ void AP_Terrain::write_block(void)
     } else {
         ::fsync(fd);
 #if TERRAIN_DEBUG
-        printf("wrote block at %ld %ld ret=%d mask=%07llx\n",
-               (long)disk_block.block.lat,
-               (long)disk_block.block.lon,
-               (int)ret,
-               (unsigned long long)disk_block.block.bitmap);
+        printf("wrote %u blocks at %ld %ld ret=%d\n",
+               (unsigned)count,
+               (long)disk_blocks[first].block.lat,
+               (long)disk_blocks[first].block.lon,
+               (int)ret);
 #endif
     }
-    disk_io_state = DiskIoDoneWrite;
 }
 
 /*
-  read in disk_block
+  read in count blocks of the batch from first, which follow each
+  other in the file
  */
-void AP_Terrain::read_block(void)
+void AP_Terrain::read_blocks(uint8_t first, uint8_t count)
 {
-    seek_offset();
+    seek_offset(disk_io[first].offset);
     if (io_failure) {
         return;
     }
-    int32_t lat = disk_block.block.lat;
-    int32_t lon = disk_block.block.lon;
-
-    ssize_t ret = ::read(fd, &disk_block, sizeof(disk_block));
-    if (ret != sizeof(disk_block) || 
-        disk_block.block.lat != lat || 
-        disk_block.block.lon != lon ||
-        disk_block.block.bitmap == 0 ||
-        disk_block.block.spacing != grid_spacing ||
-        disk_block.block.version != TERRAIN_GRID_FORMAT_VERSION ||
-        disk_block.block.crc != get_block_crc(disk_block.block)) {
+#if AP_TERRAIN_COMPRESS_ENABLED
+    if (file_format == TERRAIN_GRID_FORMAT_COMPRESSED) {
+        read_zblocks(first, count);
+        return;
+    }
+#endif
+
+    const ssize_t ret = ::read(fd, &disk_blocks[first], count * sizeof(disk_blocks[0]));
+    for (uint8_t i=first; i<first+count; i++) {
+        struct grid_block &block = disk_blocks[i].block;
+        const int32_t lat = disk_io[i].lat;
+        const int32_t lon = disk_io[i].lon;
+        if (ret < (ssize_t)((i+1-first) * sizeof(disk_blocks[0])) ||
+            block.lat != lat || 
+            block.lon != lon ||
+            block.bitmap == 0 ||
+            block.spacing != grid_spacing ||
+            block.version != TERRAIN_GRID_FORMAT_VERSION ||
+            block.crc != get_block_crc(block)) {
 #if TERRAIN_DEBUG
-        printf("read empty block at %ld %ld ret=%d\n",
-               (long)lat,
-               (long)lon,
-               (int)ret);
+            printf("read empty block at %ld %ld ret=%d\n",
+                   (long)lat,
+                   (long)lon,
+                   (int)ret);
 #endif
-        // a short read or bad data is not an IO failure, just a
-        // missing block on disk
-        memset(&disk_block, 0, sizeof(disk_block));
-        disk_block.block.lat = lat;
-        disk_block.block.lon = lon;
-        disk_block.block.bitmap = 0;
-    } else {
+            // a short read or bad data is not an IO failure, just a
+            // missing block on disk
+            memset(&disk_blocks[i], 0, sizeof(disk_blocks[i]));
+            block.lat = lat;
+            block.lon = lon;
+            block.bitmap = 0;
+        } else {
 #if TERRAIN_DEBUG
-        printf("read block at %ld %ld ret=%d mask=%07llx\n",
-               (long)lat,
-               (long)lon,
-               (int)ret,
-               (unsigned long long)disk_block.block.bitmap);
+            printf("read block at %ld %ld ret=%d mask=%07llx\n",
+                   (long)lat,
+                   (long)lon,
+                   (int)ret,
+                   (unsigned long long)block.bitmap);
 #endif
+        }
     }
-    disk_io_state = DiskIoDoneRead;
 }
 
 /*
@@ -335,6 +581,10 @@ void AP_Terrain::io_timer(void)
         return;
     }
 
+#if AP_TERRAIN_MMAP_ENABLED
+    mmap_io();
+#endif
+
     switch (disk_io_state) {
     case DiskIoIdle:
     case DiskIoDoneRead:
@@ -343,23 +593,36 @@ void AP_Terrain::io_timer(void)
         break;
         
     case DiskIoWaitWrite:
-        // need to write out the block
-        open_file();
-        if (fd == -1) {
-            return;
-        }
-        write_block();
-        break;
-
-    case DiskIoWaitRead:
-        // need to read in the block
-        open_file();
-        if (fd == -1) {
-            return;
+    case DiskIoWaitRead: {
+        // each run of blocks which follow each other in one file is a
+        // single read or write
+        uint8_t first = 0;
+        while (first < disk_io_count) {
+            uint8_t count = 1;
+            while (first+count < disk_io_count &&
+                   disk_io[first+count].lat_degrees == disk_io[first].lat_degrees &&
+                   disk_io[first+count].lon_degrees == disk_io[first].lon_degrees &&
+                   disk_io[first+count].offset == disk_io[first].offset + count) {
+                count++;
+            }
+            open_file(disk_io[first]);
+            if (fd == -1) {
+                return;
+            }
+            if (disk_io_state == DiskIoWaitWrite) {
+                write_blocks(first, count);
+            } else {
+                read_blocks(first, count);
+            }
+            if (io_failure) {
+                return;
+            }
+            first += count;
         }
-        read_block();
+        disk_io_state = (disk_io_state == DiskIoWaitWrite) ? DiskIoDoneWrite : DiskIoDoneRead;
         break;
     }
+    }
 }
 
 #endif // AP_TERRAIN_AVAILABLE
@@ -163,4 +163,66 @@ void AP_Terrain::update_rally_data(void)
     }
 }
 
+/*
+  load the blocks the vehicle is heading into, along its ground
+  velocity and along the current mission leg, so height_amsl() finds
+  them in the cache when it gets there
+ */
+void AP_Terrain::update_prefetch(void)
+{
+    AP_AHRS &ahrs = AP::ahrs();
+    Location loc;
+    if (grid_spacing <= 0 || !ahrs.get_position(loc)) {
+        return;
+    }
+
+    // prefetching uses at most half the cache, so the blocks around
+    // the vehicle, which are accessed far more often, are never
+    // replaced by it
+    const uint8_t max_blocks = cache_size / 2;
+    uint8_t count = 0;
+
+    const AP_Mission::Mission_Command &cmd = mission.get_current_nav_cmd();
+    if (mission.state() == AP_Mission::MISSION_RUNNING &&
+        (cmd.content.location.lat != 0 || cmd.content.location.lng != 0)) {
+        prefetch_line(loc, loc.get_bearing_to(cmd.content.location) * 0.01f,
+                      loc.get_distance(cmd.content.location), count, max_blocks);
+    }
+
+    const Vector2f vel = ahrs.groundspeed_vector();
+    const float speed = vel.length();
+    if (speed > 1) {
+        prefetch_line(loc, wrap_360(degrees(atan2f(vel.y, vel.x))),
+                      speed * TERRAIN_PREFETCH_TIME_S, count, max_blocks);
+    }
+}
+
+/*
+  load the blocks along a line from loc, counting the blocks touched
+  in count
+ */
+void AP_Terrain::prefetch_line(Location loc, float bearing, float distance, uint8_t &count, uint8_t max_blocks)
+{
+    // step by half the smaller block dimension, so no block crossed
+    // by the line is missed
+    const float step = 0.5f * MIN(TERRAIN_GRID_BLOCK_SPACING_X, TERRAIN_GRID_BLOCK_SPACING_Y) * grid_spacing;
+    int32_t last_grid_lat = 0;
+    int32_t last_grid_lon = 0;
+    while (distance > 0 && count < max_blocks) {
+        struct grid_info info;
+        calculate_grid_info(loc, info);
+        if (info.grid_lat != last_grid_lat || info.grid_lon != last_grid_lon) {
+            // this starts the disk read, or the GCS request, if needed
+            if (find_mmap_block(info) == nullptr) {
+                find_grid_cache(info);
+            }
+            last_grid_lat = info.grid_lat;
+            last_grid_lon = info.grid_lon;
+            count++;
+        }
+        loc.offset_bearing(bearing, step);
+        distance -= step;
+    }
+}
+
 #endif // AP_TERRAIN_AVAILABLE
@@ -0,0 +1,222 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  terrain lookups from degree files mapped into memory
+
+  On boards with a full OS and plenty of storage the degree files are
+  mapped whole, and complete blocks are read straight from them. Once
+  a block has been checked it costs no cache lookups, disk IO or GCS
+  requests. Blocks which are missing or incomplete in the file are
+  left to the grid_cache, which fills them from the GCS and writes
+  them to the file as before
+ */
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Common/AP_Common.h>
+#include "AP_Terrain.h"
+
+#if AP_TERRAIN_AVAILABLE && AP_TERRAIN_MMAP_ENABLED
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+extern const AP_HAL::HAL& hal;
+
+/*
+  find a complete block in a mapped degree file. If the degree file
+  isn't mapped yet, ask the IO thread to map it and return nullptr
+ */
+const AP_Terrain::grid_block *AP_Terrain::find_mmap_block(const struct grid_info &info)
+{
+    if (mmap_enable == 0 || file_format != TERRAIN_GRID_FORMAT_VERSION) {
+        // compressed blocks have to be expanded into the cache
+        return nullptr;
+    }
+
+    const uint32_t now_ms = AP_HAL::millis();
+    struct mmap_file *mf = nullptr;
+    if (last_mmap_idx < TERRAIN_MMAP_FILES) {
+        struct mmap_file &last = mmap_files[last_mmap_idx];
+        if (last.state != MmapFree &&
+            last.lat_degrees == info.lat_degrees &&
+            last.lon_degrees == info.lon_degrees &&
+            last.spacing == grid_spacing) {
+            mf = &last;
+        }
+    }
+    if (mf == nullptr) {
+        int8_t free_i = -1;
+        int8_t oldest_i = -1;
+        for (uint8_t i=0; i<TERRAIN_MMAP_FILES; i++) {
+            struct mmap_file &f = mmap_files[i];
+            if (f.state == MmapFree) {
+                free_i = i;
+                continue;
+            }
+            if (f.lat_degrees == info.lat_degrees &&
+                f.lon_degrees == info.lon_degrees &&
+                f.spacing == grid_spacing) {
+                mf = &f;
+                last_mmap_idx = i;
+                break;
+            }
+            if ((f.state == MmapMapped || f.state == MmapMissing) &&
+                (oldest_i == -1 || f.last_access_ms < mmap_files[oldest_i].last_access_ms)) {
+                oldest_i = i;
+            }
+        }
+        if (mf == nullptr) {
+            if (free_i != -1) {
+                // the IO thread maps it, ready for a later lookup
+                struct mmap_file &f = mmap_files[free_i];
+                f.lat_degrees = info.lat_degrees;
+                f.lon_degrees = info.lon_degrees;
+                f.spacing = grid_spacing;
+                f.east_blocks = east_blocks(info.lat_degrees, info.lon_degrees);
+                f.last_access_ms = now_ms;
+                f.state = MmapWanted;
+            } else if (oldest_i != -1) {
+                // make room, including for files of an old grid spacing
+                mmap_files[oldest_i].state = MmapRelease;
+            }
+            return nullptr;
+        }
+    }
+
+    mf->last_access_ms = now_ms;
+    if (mf->state != MmapMapped) {
+        return nullptr;
+    }
+    const uint32_t offset = mf->east_blocks * info.grid_idx_x + info.grid_idx_y;
+    if (offset >= mf->num_blocks) {
+        return nullptr;
+    }
+
+    const struct grid_block &block = mf->blocks[offset].block;
+    uint8_t &checked = mf->checked[offset];
+    if (checked == MmapBlockUnchecked) {
+        // only complete blocks are used, so there is never anything
+        // to request from the GCS for them
+        if (block.lat == info.grid_lat &&
+            block.lon == info.grid_lon &&
+            block.spacing == grid_spacing &&
+            block.version == TERRAIN_GRID_FORMAT_VERSION &&
+            (block.bitmap & bitmap_mask) == bitmap_mask &&
+            block.crc == get_block_crc(block)) {
+            checked = MmapBlockGood;
+        } else {
+            checked = MmapBlockBad;
+        }
+    }
+    if (checked != MmapBlockGood) {
+        return nullptr;
+    }
+    return &block;
+}
+
+/*
+  called when the IO thread has written a block to its degree file, so
+  that it is checked again. A file which didn't have room for it, or
+  didn't exist, is mapped again
+ */
+void AP_Terrain::mmap_block_written(const struct disk_io_block &io)
+{
+    for (uint8_t i=0; i<TERRAIN_MMAP_FILES; i++) {
+        struct mmap_file &f = mmap_files[i];
+        if (f.lat_degrees != io.lat_degrees ||
+            f.lon_degrees != io.lon_degrees ||
+            f.spacing != grid_spacing) {
+            continue;
+        }
+        if (f.state == MmapMissing) {
+            f.state = MmapRelease;
+        } else if (f.state == MmapMapped) {
+            if (io.offset < f.num_blocks) {
+                f.checked[io.offset] = MmapBlockUnchecked;
+            } else {
+                f.state = MmapRelease;
+            }
+        }
+    }
+}
+
+/*
+  map and unmap degree files for the main thread. This runs in the IO
+  timer context
+ */
+void AP_Terrain::mmap_io(void)
+{
+    for (uint8_t i=0; i<TERRAIN_MMAP_FILES; i++) {
+        struct mmap_file &f = mmap_files[i];
+        if (f.state == MmapRelease) {
+            if (f.blocks != nullptr) {
+                ::munmap((void *)f.blocks, f.num_blocks * sizeof(f.blocks[0]));
+                f.blocks = nullptr;
+            }
+            free(f.checked);
+            f.checked = nullptr;
+            f.num_blocks = 0;
+            f.state = MmapFree;
+            continue;
+        }
+        if (f.state != MmapWanted) {
+            continue;
+        }
+
+        if (!set_file_path(f.lat_degrees, f.lon_degrees)) {
+            return;
+        }
+        const int mfd = ::open(file_path, O_RDONLY|O_CLOEXEC);
+        struct stat st;
+        if (mfd == -1 || ::fstat(mfd, &st) != 0 ||
+            st.st_size < (off_t)sizeof(union grid_io_block)) {
+            if (mfd != -1) {
+                ::close(mfd);
+            }
+            f.state = MmapMissing;
+            continue;
+        }
+        const uint32_t num_blocks = st.st_size / sizeof(union grid_io_block);
+        int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+        // read the whole file now, rather than on first touch in the
+        // main thread
+        flags |= MAP_POPULATE;
+#endif
+        void *p = ::mmap(nullptr, num_blocks * sizeof(union grid_io_block), PROT_READ, flags, mfd, 0);
+        ::close(mfd);
+        uint8_t *checked = (uint8_t *)calloc(num_blocks, sizeof(checked[0]));
+        if (p == MAP_FAILED || checked == nullptr) {
+            if (p != MAP_FAILED) {
+                ::munmap(p, num_blocks * sizeof(union grid_io_block));
+            }
+            free(checked);
+            f.state = MmapMissing;
+            continue;
+        }
+#if TERRAIN_DEBUG
+        hal.console->printf("mapped %s with %u blocks\n", file_path, (unsigned)num_blocks);
+#endif
+        f.blocks = (const union grid_io_block *)p;
+        f.checked = checked;
+        f.num_blocks = num_blocks;
+        f.state = MmapMapped;
+    }
+}
+
+#endif // AP_TERRAIN_AVAILABLE && AP_TERRAIN_MMAP_ENABLED
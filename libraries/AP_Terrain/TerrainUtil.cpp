@@ -27,6 +27,7 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <stddef.h>
 #if HAL_OS_POSIX_IO
 #include <unistd.h>
 #include <sys/stat.h>
@@ -117,23 +118,48 @@ void AP_Terrain::calculate_grid_info(const Location &loc, struct grid_info &info
  */
 AP_Terrain::grid_cache &AP_Terrain::find_grid_cache(const struct grid_info &info)
 {
+    const uint32_t now_ms = AP_HAL::millis();
+
+    // nearly all lookups are for the same block as the last one
+    if (last_cache_idx < cache_size) {
+        struct grid_cache &last = cache[last_cache_idx];
+        if (last.grid.lat == info.grid_lat &&
+            last.grid.lon == info.grid_lon &&
+            last.grid.spacing == grid_spacing) {
+            last.last_access_ms = now_ms;
+            return last;
+        }
+    }
+
     uint16_t oldest_i = 0;
+    int16_t oldest_clean_i = -1;
 
     // see if we have that grid
     for (uint16_t i=0; i<cache_size; i++) {
         if (cache[i].grid.lat == info.grid_lat && 
             cache[i].grid.lon == info.grid_lon &&
             cache[i].grid.spacing == grid_spacing) {
-            cache[i].last_access_ms = AP_HAL::millis();
+            cache[i].last_access_ms = now_ms;
+            last_cache_idx = i;
             return cache[i];
         }
         if (cache[i].last_access_ms < cache[oldest_i].last_access_ms) {
             oldest_i = i;
         }
+        if (cache[i].state != GRID_CACHE_DIRTY &&
+            (oldest_clean_i == -1 ||
+             cache[i].last_access_ms < cache[oldest_clean_i].last_access_ms)) {
+            oldest_clean_i = i;
+        }
     }
 
-    // Not found. Use the oldest grid and make it this grid,
-    // initially unpopulated
+    // Not found. Use the least recently used grid and make it this
+    // grid, initially unpopulated.  Grids with data not yet written
+    // to disk are only replaced if every grid is in that state
+    if (oldest_clean_i != -1) {
+        oldest_i = oldest_clean_i;
+    }
+    last_cache_idx = oldest_i;
     struct grid_cache &grid = cache[oldest_i];
     memset(&grid, 0, sizeof(grid));
 
@@ -145,7 +171,7 @@ AP_Terrain::grid_cache &AP_Terrain::find_grid_cache(const struct grid_info &info
     grid.grid.lat_degrees = info.lat_degrees;
     grid.grid.lon_degrees = info.lon_degrees;
     grid.grid.version = TERRAIN_GRID_FORMAT_VERSION;
-    grid.last_access_ms = AP_HAL::millis();
+    grid.last_access_ms = now_ms;
 
     // mark as waiting for disk read
     grid.state = GRID_CACHE_DISKWAIT;
@@ -154,38 +180,56 @@ AP_Terrain::grid_cache &AP_Terrain::find_grid_cache(const struct grid_info &info
 }
 
 /*
-  find cache index of disk_block
+  find cache index of the block at lat/lon
  */
-int16_t AP_Terrain::find_io_idx(enum GridCacheState state)
+int16_t AP_Terrain::find_io_idx(int32_t lat, int32_t lon, enum GridCacheState state)
 {
     // try first with given state
     for (uint16_t i=0; i<cache_size; i++) {
-        if (disk_block.block.lat == cache[i].grid.lat &&
-            disk_block.block.lon == cache[i].grid.lon && 
+        if (lat == cache[i].grid.lat &&
+            lon == cache[i].grid.lon && 
             cache[i].state == state) {
             return i;
         }
     }    
     // then any state
     for (uint16_t i=0; i<cache_size; i++) {
-        if (disk_block.block.lat == cache[i].grid.lat &&
-            disk_block.block.lon == cache[i].grid.lon) {
+        if (lat == cache[i].grid.lat &&
+            lon == cache[i].grid.lon) {
             return i;
         }
     }    
     return -1;
 }
 
+/*
+  CRC of len bytes with the 16 bit crc at crc_ofs taken as zero,
+  without changing them, as they may be in a read only mapping
+ */
+static uint16_t crc_without_crc(const uint8_t *b, uint32_t len, uint32_t crc_ofs)
+{
+    const uint8_t zero_crc[sizeof(uint16_t)] {};
+    uint16_t ret = crc16_ccitt(b, crc_ofs, 0);
+    ret = crc16_ccitt(zero_crc, sizeof(zero_crc), ret);
+    return crc16_ccitt(&b[crc_ofs+sizeof(zero_crc)], len-(crc_ofs+sizeof(zero_crc)), ret);
+}
+
 /*
   get CRC for a block
  */
-uint16_t AP_Terrain::get_block_crc(struct grid_block &block)
+uint16_t AP_Terrain::get_block_crc(const struct grid_block &block) const
+{
+    return crc_without_crc((const uint8_t *)&block, sizeof(block), offsetof(struct grid_block, crc));
+}
+
+#if AP_TERRAIN_COMPRESS_ENABLED
+/*
+  get CRC for a compressed block
+ */
+uint16_t AP_Terrain::get_zblock_crc(const struct grid_block_z &block) const
 {
-    uint16_t saved_crc = block.crc;
-    block.crc = 0;
-    uint16_t ret = crc16_ccitt((const uint8_t *)&block, sizeof(block), 0);
-    block.crc = saved_crc;
-    return ret;
+    return crc_without_crc((const uint8_t *)&block, sizeof(block), offsetof(struct grid_block_z, crc));
 }
+#endif
 
 #endif // AP_TERRAIN_AVAILABLE
@@ -28,6 +28,7 @@
 #include <GCS_MAVLink/GCS.h>
 #include "AP_ToshibaCAN.h"
 #include <AP_Logger/AP_Logger.h>
+#include <AP_ESC_Telem/AP_ESC_Telem.h>
 
 extern const AP_HAL::HAL& hal;
 
@@ -101,6 +102,20 @@ void AP_ToshibaCAN::init(uint8_t driver_index, bool enable_filters)
         return;
     }
 
+    // only accept the rpm/voltage and temperature replies in hardware,
+    // so other traffic on the bus doesn't fill the receive queue
+    if (enable_filters) {
+        uavcan::CanFilterConfig filters[2];
+        filters[0].id = MOTOR_DATA1;
+        filters[1].id = MOTOR_DATA2;
+        for (uavcan::CanFilterConfig &f : filters) {
+            f.mask = 0x7F0 | uavcan::CanFrame::FlagEFF | uavcan::CanFrame::FlagRTR;
+        }
+        if (_can_driver->getIface(CAN_IFACE_INDEX)->configureFilters(filters, ARRAY_SIZE(filters)) < 0) {
+            debug_can(1, "ToshibaCAN: couldn't configure filters\n\r");
+        }
+    }
+
     // start calls to loop in separate thread
     if (!hal.scheduler->thread_create(FUNCTOR_BIND_MEMBER(&AP_ToshibaCAN::loop, void), _thread_name, 4096, AP_HAL::Scheduler::PRIORITY_MAIN, 1)) {
         debug_can(1, "ToshibaCAN: couldn't create thread\n\r");
@@ -120,6 +135,12 @@ void AP_ToshibaCAN::loop()
     uavcan::MonotonicTime timeout;
     const uint32_t timeout_us = MIN(AP::scheduler().get_loop_period_us(), TOSHIBACAN_SEND_TIMEOUT_US);
 
+    // the lock and motor frames of one output update are sent as a
+    // burst with one deadline for all of them, so the motors get their
+    // outputs within a loop period of each other. A burst that misses
+    // its deadline is dropped and the latest outputs sent instead
+    uavcan::MonotonicTime output_deadline;
+
     while (true) {
         if (!_initialized) {
             // if not initialised wait 2ms
@@ -178,7 +199,9 @@ void AP_ToshibaCAN::loop()
 
                 // copy update time
                 update_count_buffered = update_count;
+                update_us_buffered = update_us;
             }
+            output_deadline = uavcan::MonotonicTime::fromUSec(AP_HAL::micros64() + AP::scheduler().get_loop_period_us());
             unlock_frame = {(uint8_t)COMMAND_LOCK, unlock_cmd.data, sizeof(unlock_cmd.data)};
             mot_rot_frame1 = {((uint8_t)COMMAND_MOTOR1 & uavcan::CanFrame::MaskStdID), mot_rot_cmd1.data, sizeof(mot_rot_cmd1.data)};
             mot_rot_frame2 = {((uint8_t)COMMAND_MOTOR2 & uavcan::CanFrame::MaskStdID), mot_rot_cmd2.data, sizeof(mot_rot_cmd2.data)};
@@ -188,40 +211,22 @@ void AP_ToshibaCAN::loop()
             send_stage++;
         }
 
-        // send unlock command
-        if (send_stage == 1) {
-            timeout = uavcan::MonotonicTime::fromUSec(AP_HAL::micros64() + timeout_us);
-            if (!write_frame(unlock_frame, timeout)) {
-                continue;
-            }
-            send_stage++;
-        }
-
-        // send output to motor bank3
-        if (send_stage == 2) {
-            timeout = uavcan::MonotonicTime::fromUSec(AP_HAL::micros64() + timeout_us);
-            if (!write_frame(mot_rot_frame3, timeout)) {
-                continue;
-            }
-            send_stage++;
-        }
-
-        // send output to motor bank2
-        if (send_stage == 3) {
-            timeout = uavcan::MonotonicTime::fromUSec(AP_HAL::micros64() + timeout_us);
-            if (!write_frame(mot_rot_frame2, timeout)) {
-                continue;
+        // send unlock command and output to motor banks 3, 2 and 1,
+        // in CAN ID (and so bus priority) order
+        if (send_stage >= 1 && send_stage <= 4) {
+            uavcan::CanFrame *output_frames[] { &unlock_frame, &mot_rot_frame3, &mot_rot_frame2, &mot_rot_frame1 };
+            while (send_stage <= 4 && write_frame(*output_frames[send_stage-1], output_deadline)) {
+                send_stage++;
             }
-            send_stage++;
-        }
-
-        // send output to motor bank1
-        if (send_stage == 4) {
-            timeout = uavcan::MonotonicTime::fromUSec(AP_HAL::micros64() + timeout_us);
-            if (!write_frame(mot_rot_frame1, timeout)) {
+            if (send_stage <= 4) {
+                if (AP_HAL::micros64() >= output_deadline.toUSec()) {
+                    // too late, start again with the latest outputs
+                    _latency.missed++;
+                    send_stage = 0;
+                }
                 continue;
             }
-            send_stage++;
+            update_latency(AP_HAL::micros() - update_us_buffered);
         }
 
         // check if we should request update from ESCs
@@ -318,6 +323,11 @@ void AP_ToshibaCAN::loop()
                         _telemetry[esc_id].count++;
                         _telemetry[esc_id].new_data = true;
                         _esc_present_bitmask |= ((uint32_t)1 << esc_id);
+
+                        AP_ESC_Telem::TelemetryData td {};
+                        td.rpm = _telemetry[esc_id].rpm;
+                        td.voltage = _telemetry[esc_id].millivolts * 0.001f;
+                        AP::esc_telem().update_telem_data(esc_id, td, AP_ESC_Telem::TELEM_RPM | AP_ESC_Telem::TELEM_VOLTAGE, AP_ESC_Telem::Source::TOSHIBACAN);
                     }
                 }
 
@@ -340,6 +350,10 @@ void AP_ToshibaCAN::loop()
                         WITH_SEMAPHORE(_telem_sem);
                         _telemetry[esc_id].temperature = temp_max < 20 ? 0 : temp_max / 5 - 20;
                         _esc_present_bitmask |= ((uint32_t)1 << esc_id);
+
+                        AP_ESC_Telem::TelemetryData td {};
+                        td.temperature = _telemetry[esc_id].temperature;
+                        AP::esc_telem().update_telem_data(esc_id, td, AP_ESC_Telem::TELEM_TEMPERATURE, AP_ESC_Telem::Source::TOSHIBACAN);
                     }
                 }
             }
@@ -353,10 +367,28 @@ void AP_ToshibaCAN::loop()
     }
 }
 
+// record the time from an output update to its motor frames being queued
+void AP_ToshibaCAN::update_latency(uint32_t latency_us)
+{
+    _latency.sum_us += latency_us;
+    _latency.max_us = MAX(_latency.max_us, latency_us);
+    _latency.count++;
+
+    const uint32_t now_ms = AP_HAL::millis();
+    if (now_ms - _latency.last_report_ms >= 1000) {
+        debug_can(2, "ToshibaCAN: output latency avg %u max %u us, %u missed\n\r",
+                  (unsigned)(_latency.sum_us / _latency.count),
+                  (unsigned)_latency.max_us,
+                  (unsigned)_latency.missed);
+        _latency = {};
+        _latency.last_report_ms = now_ms;
+    }
+}
+
 // write frame on CAN bus
 bool AP_ToshibaCAN::write_frame(uavcan::CanFrame &out_frame, uavcan::MonotonicTime timeout)
 {
-    // wait for space in buffer to send command
+    // wait for space in buffer to send command, until the timeout
     uavcan::CanSelectMasks inout_mask;
     do {
         inout_mask.read = 0;
@@ -366,6 +398,9 @@ bool AP_ToshibaCAN::write_frame(uavcan::CanFrame &out_frame, uavcan::MonotonicTi
 
         // delay if no space is available to send
         if (!inout_mask.write) {
+            if (AP_HAL::micros64() >= timeout.toUSec()) {
+                return false;
+            }
             hal.scheduler->delay_microseconds(50);
         }
     } while (!inout_mask.write);
@@ -418,6 +453,7 @@ void AP_ToshibaCAN::update()
             }
         }
         update_count++;
+        update_us = AP_HAL::micros();
     }
 
     // log ESCs telemetry info
@@ -52,6 +52,9 @@ private:
     // read frame on CAN bus, returns true on success
     bool read_frame(uavcan::CanFrame &recv_frame, uavcan::MonotonicTime timeout);
 
+    // record the time from an output update to its motor frames being queued
+    void update_latency(uint32_t latency_us);
+
     bool _initialized;
     char _thread_name[9];
     uint8_t _driver_index;
@@ -65,6 +68,18 @@ private:
     uint16_t update_count_buffered; // counter when outputs copied to buffer before before sending to ESCs
     uint16_t update_count_sent;     // counter of outputs successfully sent
     uint8_t send_stage;             // stage of sending algorithm (each stage sends one frame to ESCs)
+    uint32_t update_us;             // system time of the last update of outputs by the main thread
+    uint32_t update_us_buffered;    // update_us of the outputs being sent
+
+    // time from the main thread updating the outputs to the last
+    // motor frame being queued, reported once a second
+    struct {
+        uint32_t sum_us;
+        uint32_t max_us;
+        uint16_t count;
+        uint16_t missed;            // cycles abandoned because they could not be sent in time
+        uint32_t last_report_ms;
+    } _latency;
 
     // telemetry data (rpm, voltage)
     HAL_Semaphore _telem_sem;
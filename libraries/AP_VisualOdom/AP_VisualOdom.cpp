@@ -85,36 +85,32 @@ bool AP_VisualOdom::enabled() const
     return ((_type != AP_VisualOdom_Type_None) && (_driver != nullptr));
 }
 
-// update visual odometry sensor
-void AP_VisualOdom::update()
+// pass the latest deltas to the EKF and log them. Called by the
+// backend as each message is received rather than from the scheduler,
+// so no message is overwritten by the next before it is used and none
+// waits for the next run of a task
+void AP_VisualOdom::write_to_ekf()
 {
-    if (!enabled()) {
-        return;
-    }
-
-    // check for updates
-    if (_state.last_processed_sensor_update_ms == _state.last_sensor_update_ms) {
-        // This reading has already been processed
-        return;
-    }
-    _state.last_processed_sensor_update_ms = _state.last_sensor_update_ms;
-
     const float time_delta_sec = get_time_delta_usec() / 1000000.0f;
 
     AP::ahrs_navekf().writeBodyFrameOdom(get_confidence(),
                                          get_position_delta(),
                                          get_angle_delta(),
                                          time_delta_sec,
-                                         get_last_update_ms(),
+                                         get_sensor_time_ms(),
                                          get_pos_offset());
-    // log sensor data
+
+    // log sensor data, with the time from the sensor taking the
+    // deltas to their reception and the time from reception to
+    // fusion of the last the EKF fused
     AP::logger().Write_VisualOdom(time_delta_sec,
                                   get_angle_delta(),
                                   get_position_delta(),
-                                  get_confidence());
+                                  get_confidence(),
+                                  get_last_update_ms() - get_sensor_time_ms(),
+                                  AP::ahrs_navekf().get_NavEKF3_const().getBodyFrameOdomFusionDelay(-1));
 }
 
-// return true if sensor is basically healthy (we are receiving data)
 bool AP_VisualOdom::healthy() const
 {
     if (!enabled()) {
@@ -126,7 +122,7 @@ bool AP_VisualOdom::healthy() const
 }
 
 // consume VISION_POSITION_DELTA MAVLink message
-void AP_VisualOdom::handle_msg(mavlink_message_t *msg)
+void AP_VisualOdom::handle_msg(mavlink_message_t *msg, uint32_t timestamp_ms)
 {
     // exit immediately if not enabled
     if (!enabled()) {
@@ -135,7 +131,7 @@ void AP_VisualOdom::handle_msg(mavlink_message_t *msg)
 
     // call backend
     if (_driver != nullptr) {
-        _driver->handle_msg(msg);
+        _driver->handle_msg(msg, timestamp_ms);
     }
 }
 
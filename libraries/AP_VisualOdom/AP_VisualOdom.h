@@ -49,17 +49,13 @@ public:
         uint64_t time_delta_usec;   // time delta (in usec) between previous and most recent update
         float confidence;           // confidence expressed as a value from 0 (no confidence) to 100 (very confident)
         uint32_t last_sensor_update_ms;    // system time (in milliseconds) of last update from sensor
-        uint32_t last_processed_sensor_update_ms; // timestamp of last sensor update that was processed
+        uint32_t sensor_time_ms;    // system time (in milliseconds) the sensor took the most recent update
 
     };
 
     // detect and initialise any sensors
     void init();
 
-    // should be called really, really often.  The faster you call
-    // this the lower the latency of the data fed to the estimator.
-    void update();
-
     // return true if sensor is enabled
     bool enabled() const;
 
@@ -69,8 +65,9 @@ public:
     // return a 3D vector defining the position offset of the camera in meters relative to the body frame origin
     const Vector3f &get_pos_offset(void) const { return _pos_offset; }
 
-    // consume data from MAVLink messages
-    void handle_msg(mavlink_message_t *msg);
+    // consume data from MAVLink messages. timestamp_ms is the
+    // message's time, corrected to system time
+    void handle_msg(mavlink_message_t *msg, uint32_t timestamp_ms);
 
     static const struct AP_Param::GroupInfo var_info[];
 
@@ -78,12 +75,16 @@ private:
 
     static AP_VisualOdom *_singleton;
 
+    // pass the latest deltas to the EKF, called by the backend as they arrive
+    void write_to_ekf();
+
     // state accessors
     const Vector3f &get_angle_delta() const { return _state.angle_delta; }
     const Vector3f &get_position_delta() const { return _state.position_delta; }
     uint64_t get_time_delta_usec() const { return _state.time_delta_usec; }
     float get_confidence() const { return _state.confidence; }
     uint32_t get_last_update_ms() const { return _state.last_sensor_update_ms; }
+    uint32_t get_sensor_time_ms() const { return _state.sensor_time_ms; }
 
     // parameters
     AP_Int8 _type;
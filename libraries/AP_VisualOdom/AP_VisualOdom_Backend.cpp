@@ -25,7 +25,7 @@ AP_VisualOdom_Backend::AP_VisualOdom_Backend(AP_VisualOdom &frontend) :
 }
 
 // set deltas (used by backend to update state)
-void AP_VisualOdom_Backend::set_deltas(const Vector3f &angle_delta, const Vector3f& position_delta, uint64_t time_delta_usec, float confidence)
+void AP_VisualOdom_Backend::set_deltas(const Vector3f &angle_delta, const Vector3f& position_delta, uint64_t time_delta_usec, float confidence, uint32_t sensor_time_ms)
 {
     // rotate and store angle_delta
     _frontend._state.angle_delta = angle_delta;
@@ -38,4 +38,7 @@ void AP_VisualOdom_Backend::set_deltas(const Vector3f &angle_delta, const Vector
     _frontend._state.time_delta_usec = time_delta_usec;
     _frontend._state.confidence = confidence;
     _frontend._state.last_sensor_update_ms = AP_HAL::millis();
+    _frontend._state.sensor_time_ms = sensor_time_ms;
+
+    _frontend.write_to_ekf();
 }
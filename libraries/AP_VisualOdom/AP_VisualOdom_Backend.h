@@ -25,12 +25,12 @@ public:
 	AP_VisualOdom_Backend(AP_VisualOdom &frontend);
 
     // consume VISION_POSITION_DELTA MAVLink message
-	virtual void handle_msg(mavlink_message_t *msg) {};
+	virtual void handle_msg(mavlink_message_t *msg, uint32_t timestamp_ms) {};
 
 protected:
 
     // set deltas (used by backend to update state)
-    void set_deltas(const Vector3f &angle_delta, const Vector3f& position_delta, uint64_t time_delta_usec, float confidence);
+    void set_deltas(const Vector3f &angle_delta, const Vector3f& position_delta, uint64_t time_delta_usec, float confidence, uint32_t sensor_time_ms);
 
 private:
 
@@ -26,7 +26,7 @@ AP_VisualOdom_MAV::AP_VisualOdom_MAV(AP_VisualOdom &frontend) :
 }
 
 // consume VISIOIN_POSITION_DELTA MAVLink message
-void AP_VisualOdom_MAV::handle_msg(mavlink_message_t *msg)
+void AP_VisualOdom_MAV::handle_msg(mavlink_message_t *msg, uint32_t timestamp_ms)
 {
     // decode message
     mavlink_vision_position_delta_t packet;
@@ -34,5 +34,5 @@ void AP_VisualOdom_MAV::handle_msg(mavlink_message_t *msg)
 
     const Vector3f angle_delta(packet.angle_delta[0], packet.angle_delta[1], packet.angle_delta[2]);
     const Vector3f position_delta(packet.position_delta[0], packet.position_delta[1], packet.position_delta[2]);
-    set_deltas(angle_delta, position_delta, packet.time_delta_usec, packet.confidence);
+    set_deltas(angle_delta, position_delta, packet.time_delta_usec, packet.confidence, timestamp_ms);
 }
@@ -10,5 +10,5 @@ public:
     AP_VisualOdom_MAV(AP_VisualOdom &frontend);
 
     // consume VISION_POSITION_DELTA MAVLink message
-    void handle_msg(mavlink_message_t *msg) override;
+    void handle_msg(mavlink_message_t *msg, uint32_t timestamp_ms) override;
 };
@@ -284,12 +284,12 @@ float AP_WheelEncoder::get_rate(uint8_t instance) const
     }
 
     // protect against divide by zero
-    if ((state[instance].dt_ms == 0) || _counts_per_revolution[instance] == 0) {
+    if ((state[instance].dt_us == 0) || _counts_per_revolution[instance] == 0) {
         return 0;
     }
 
     // calculate delta_angle (in radians) per second
-    return M_2PI * (state[instance].dist_count_change / ((float)_counts_per_revolution[instance])) / (state[instance].dt_ms * 1e-3f);
+    return M_2PI * (state[instance].dist_count_change / ((float)_counts_per_revolution[instance])) / (state[instance].dt_us * 1e-6f);
 }
 
 // get the total number of sensor reading from the encoder
@@ -331,3 +331,15 @@ uint32_t AP_WheelEncoder::get_last_reading_ms(uint8_t instance) const
     }
     return state[instance].last_reading_ms;
 }
+
+// get the distance count and the system time (in microseconds) it was taken at
+bool AP_WheelEncoder::get_sample(uint8_t instance, int32_t &distance_count, uint32_t &timestamp_us) const
+{
+    // for invalid instances return false
+    if (instance >= WHEELENCODER_MAX_INSTANCES) {
+        return false;
+    }
+    distance_count = state[instance].distance_count;
+    timestamp_us = state[instance].last_reading_us;
+    return true;
+}
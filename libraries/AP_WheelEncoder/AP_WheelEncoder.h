@@ -52,8 +52,9 @@ public:
         uint32_t               total_count;     // total number of successful readings from sensor (used for sensor quality calcs)
         uint32_t               error_count;     // total number of errors reading from sensor (used for sensor quality calcs)
         uint32_t               last_reading_ms; // time of last reading
+        uint32_t               last_reading_us; // time of last reading in microseconds
         int32_t                dist_count_change; // distance count change during the last update (used to calculating rate)
-        uint32_t               dt_ms;             // time change (in milliseconds) for the previous period (used to calculating rate)
+        uint32_t               dt_us;             // time change (in microseconds) for the previous period (used to calculating rate)
     };
 
     // detect and initialise any available rpm sensors
@@ -104,6 +105,12 @@ public:
     // get the system time (in milliseconds) of the last update
     uint32_t get_last_reading_ms(uint8_t instance) const;
 
+    // get the distance count and the system time (in microseconds)
+    // of the encoder edge it was taken at. Rates worked out from
+    // successive samples are not limited by the rate update() is called
+    // at. Returns false for invalid instances
+    bool get_sample(uint8_t instance, int32_t &distance_count, uint32_t &timestamp_us) const;
+
     static const struct AP_Param::GroupInfo var_info[];
 
 protected:
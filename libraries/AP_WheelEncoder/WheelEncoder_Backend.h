@@ -38,7 +38,8 @@ protected:
     int8_t get_pin_b() const;
 
     // copy state to front end helper function
-    void copy_state_to_frontend(int32_t distance_count, uint32_t total_count, uint32_t error_count, uint32_t last_reading_ms);
+    // last_reading_us is the system time in microseconds of the encoder edge that gave distance_count
+    void copy_state_to_frontend(int32_t distance_count, uint32_t total_count, uint32_t error_count, uint32_t last_reading_us);
 
     AP_WheelEncoder &_frontend;
     AP_WheelEncoder::WheelEncoder_State &_state;
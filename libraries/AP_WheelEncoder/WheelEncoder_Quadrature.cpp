@@ -21,6 +21,15 @@
 
 extern const AP_HAL::HAL& hal;
 
+// indexed by (phase before << 2) | phase after, one step forward is
+// +1, one step back is -1 and anything else is an error
+const int8_t AP_WheelEncoder_Quadrature::step_table[16] = {
+     0,  1,  0, -1,
+    -1,  0,  1,  0,
+     0, -1,  0,  1,
+     1,  0, -1,  0,
+};
+
 // constructor
 AP_WheelEncoder_Quadrature::AP_WheelEncoder_Quadrature(AP_WheelEncoder &frontend, uint8_t instance, AP_WheelEncoder::WheelEncoder_State &state) :
 	AP_WheelEncoder_Backend(frontend, instance, state)
@@ -75,49 +84,20 @@ void AP_WheelEncoder_Quadrature::update(void)
     copy_state_to_frontend(irq_state.distance_count,
                            irq_state.total_count,
                            irq_state.error_count,
-                           irq_state.last_reading_ms);
+                           irq_state.last_reading_us);
 
     // restore interrupts
     hal.scheduler->restore_interrupts(irqstate);
 }
 
-// convert pin a and pin b state to a wheel encoder phase
-uint8_t AP_WheelEncoder_Quadrature::pin_ab_to_phase(bool pin_a, bool pin_b)
-{
-    if (!pin_a) {
-        if (!pin_b) {
-            // A = 0, B = 0
-            return 0;
-        } else {
-            // A = 0, B = 1
-            return 1;
-        }
-    } else {
-        if (!pin_b) {
-            // A = 1, B = 0
-            return 3;
-        } else {
-            // A = 1, B = 1
-            return 2;
-        }
-    }
-    return (uint8_t)pin_a << 1 | (uint8_t)pin_b;
-}
-
 void AP_WheelEncoder_Quadrature::update_phase_and_error_count()
 {
-    // convert pin state before and after to phases
-    uint8_t phase_after = pin_ab_to_phase(last_pin_a_value, last_pin_b_value);
-
-    // look for invalid changes
-    uint8_t step_forward = irq_state.phase < 3 ? irq_state.phase+1 : 0;
-    uint8_t step_back = irq_state.phase > 0 ? irq_state.phase-1 : 3;
-    if (phase_after == step_forward) {
-        irq_state.phase = phase_after;
-        irq_state.distance_count++;
-    } else if (phase_after == step_back) {
-        irq_state.phase = phase_after;
-        irq_state.distance_count--;
+    // this runs on every edge of either pin, so decode with a table
+    // lookup rather than comparing against the neighbouring phases
+    const int8_t step = phase_step(irq_state.phase, last_pin_a_value, last_pin_b_value);
+    if (step != 0) {
+        irq_state.phase = (irq_state.phase + step) & 0x03;
+        irq_state.distance_count += step;
     } else {
         irq_state.error_count++;
     }
@@ -144,5 +124,5 @@ void AP_WheelEncoder_Quadrature::irq_handler(uint8_t pin,
     update_phase_and_error_count();
 
     // record update time
-    irq_state.last_reading_ms = timestamp;
+    irq_state.last_reading_us = timestamp;
 }
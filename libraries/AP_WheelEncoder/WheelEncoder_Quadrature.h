@@ -28,6 +28,22 @@ public:
     // update state
     void update(void) override;
 
+    // return the change in distance count, +1 or -1, for a move from
+    // phase to the phase of pin a and b. Returns zero for a move that
+    // is not a single step, which is counted as an error
+    static int8_t phase_step(uint8_t phase, bool pin_a, bool pin_b) {
+        return step_table[(phase << 2) | pin_ab_to_phase(pin_a, pin_b)];
+    }
+
+    // convert pin a and b status to phase
+    static uint8_t pin_ab_to_phase(bool pin_a, bool pin_b) {
+        // A = 0, B = 0: 0
+        // A = 0, B = 1: 1
+        // A = 1, B = 1: 2
+        // A = 1, B = 0: 3
+        return ((uint8_t)pin_a << 1) | (uint8_t)(pin_a ^ pin_b);
+    }
+
 private:
 
     // check if pin has changed and initialise gpio event callback
@@ -36,9 +52,6 @@ private:
     // gpio interrupt handlers
     void irq_handler(uint8_t pin, bool pin_value, uint32_t timestamp);  // combined irq handler
 
-    // convert pin a and b status to phase
-    static uint8_t pin_ab_to_phase(bool pin_a, bool pin_b);
-
     // update phase, distance_count and error count using pin a and b's latest state
     void update_phase_and_error_count();
 
@@ -47,9 +60,12 @@ private:
         int32_t  distance_count;    // distance measured by cumulative steps forward or backwards since last update
         uint32_t total_count;       // total number of successful readings from sensor (used for sensor quality calcs)
         uint32_t error_count;       // total number of errors reading from sensor (used for sensor quality calcs)
-        uint32_t last_reading_ms;   // system time of last update from encoder
+        uint32_t last_reading_us;   // system time of last update from encoder
     } irq_state;
 
+    // distance count change indexed by phase before and after an edge
+    static const int8_t step_table[16];
+
     // private members
     uint8_t last_pin_a = -1;
     uint8_t last_pin_b = -1;
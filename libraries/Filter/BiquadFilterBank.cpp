@@ -0,0 +1,137 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BiquadFilterBank.h"
+#include "LowPassFilter2p.h"
+#include "NotchFilter.h"
+#include <AP_Math/simd.h>
+
+#if AP_MATH_SIMD_SSE
+#include <xmmintrin.h>
+#elif AP_MATH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+BiquadFilterBank::~BiquadFilterBank()
+{
+    free(_mem);
+}
+
+bool BiquadFilterBank::init(uint8_t num_channels)
+{
+    if (_mem != nullptr || num_channels == 0) {
+        return false;
+    }
+    _mem = (float *)calloc(7 * num_channels, sizeof(float));
+    if (_mem == nullptr) {
+        return false;
+    }
+    _num_channels = num_channels;
+    _b0 = &_mem[0];
+    _b1 = &_mem[num_channels];
+    _b2 = &_mem[2*num_channels];
+    _a1 = &_mem[3*num_channels];
+    _a2 = &_mem[4*num_channels];
+    _z1 = &_mem[5*num_channels];
+    _z2 = &_mem[6*num_channels];
+    for (uint8_t i=0; i<num_channels; i++) {
+        _b0[i] = 1;
+    }
+    return true;
+}
+
+void BiquadFilterBank::set_coefficients(uint8_t channel, float b0, float b1, float b2, float a1, float a2)
+{
+    if (channel >= _num_channels) {
+        return;
+    }
+    _b0[channel] = b0;
+    _b1[channel] = b1;
+    _b2[channel] = b2;
+    _a1[channel] = a1;
+    _a2[channel] = a2;
+}
+
+void BiquadFilterBank::set_low_pass(uint8_t channel, float sample_freq_hz, float cutoff_freq_hz)
+{
+    if (!is_positive(cutoff_freq_hz)) {
+        set_coefficients(channel, 1, 0, 0, 0, 0);
+        return;
+    }
+    DigitalBiquadFilter<float>::biquad_params p;
+    DigitalBiquadFilter<float>::compute_params(sample_freq_hz, cutoff_freq_hz, p);
+    set_coefficients(channel, p.b0, p.b1, p.b2, p.a1, p.a2);
+}
+
+void BiquadFilterBank::set_notch(uint8_t channel, float sample_freq_hz, float center_freq_hz, float bandwidth_hz, float attenuation_dB)
+{
+    float A, Q;
+    NotchFilterFloat::calculate_A_and_Q(center_freq_hz, bandwidth_hz, attenuation_dB, A, Q);
+    const float omega = 2.0 * M_PI * center_freq_hz / sample_freq_hz;
+    const float alpha = sinf(omega) / (2 * Q/A);
+    const float a0_inv = 1.0/(1.0 + alpha/A);
+    const float b1 = -2.0 * cosf(omega) * a0_inv;
+    set_coefficients(channel, (1.0 + alpha*A) * a0_inv, b1, (1.0 - alpha*A) * a0_inv,
+                     b1, (1.0 - alpha/A) * a0_inv);
+}
+
+void BiquadFilterBank::reset()
+{
+    memset(_z1, 0, _num_channels * sizeof(float));
+    memset(_z2, 0, _num_channels * sizeof(float));
+}
+
+void BiquadFilterBank::apply(const float *in, float *out)
+{
+    uint8_t i = 0;
+
+#if AP_MATH_SIMD_SSE
+    for (; i+4 <= _num_channels; i += 4) {
+        const __m128 x = _mm_loadu_ps(&in[i]);
+        const __m128 y = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&_b0[i]), x), _mm_loadu_ps(&_z1[i]));
+        const __m128 z1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(&_b1[i]), x),
+                                                _mm_mul_ps(_mm_loadu_ps(&_a1[i]), y)),
+                                     _mm_loadu_ps(&_z2[i]));
+        const __m128 z2 = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(&_b2[i]), x),
+                                     _mm_mul_ps(_mm_loadu_ps(&_a2[i]), y));
+        _mm_storeu_ps(&_z1[i], z1);
+        _mm_storeu_ps(&_z2[i], z2);
+        _mm_storeu_ps(&out[i], y);
+    }
+#elif AP_MATH_SIMD_NEON
+    for (; i+4 <= _num_channels; i += 4) {
+        const float32x4_t x = vld1q_f32(&in[i]);
+        const float32x4_t y = vaddq_f32(vmulq_f32(vld1q_f32(&_b0[i]), x), vld1q_f32(&_z1[i]));
+        const float32x4_t z1 = vaddq_f32(vsubq_f32(vmulq_f32(vld1q_f32(&_b1[i]), x),
+                                                   vmulq_f32(vld1q_f32(&_a1[i]), y)),
+                                         vld1q_f32(&_z2[i]));
+        const float32x4_t z2 = vsubq_f32(vmulq_f32(vld1q_f32(&_b2[i]), x),
+                                         vmulq_f32(vld1q_f32(&_a2[i]), y));
+        vst1q_f32(&_z1[i], z1);
+        vst1q_f32(&_z2[i], z2);
+        vst1q_f32(&out[i], y);
+    }
+#endif
+
+    // the remaining channels, or all of them without SIMD, with the
+    // same operations in the same order
+    for (; i < _num_channels; i++) {
+        const float x = in[i];
+        const float y = _b0[i] * x + _z1[i];
+        _z1[i] = (_b1[i] * x - _a1[i] * y) + _z2[i];
+        _z2[i] = _b2[i] * x - _a2[i] * y;
+        out[i] = y;
+    }
+}
@@ -0,0 +1,68 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+  a bank of independent biquad filters, all updated together.
+
+  The coefficients and state of each channel are held as a structure
+  of arrays, so groups of four channels are filtered with one set of
+  SSE or NEON operations. Boards without floating point SIMD use the
+  same loop in scalar code, which still gains from the contiguous
+  layout. Each channel is a transposed direct form II section.
+ */
+
+#include <AP_Math/AP_Math.h>
+
+class BiquadFilterBank {
+public:
+    ~BiquadFilterBank();
+
+    // allocate num_channels channels, each initially a pass-through.
+    // Returns false if out of memory
+    bool init(uint8_t num_channels);
+
+    uint8_t num_channels() const { return _num_channels; }
+
+    // set a channel's coefficients, normalised so that a0 is 1
+    void set_coefficients(uint8_t channel, float b0, float b1, float b2, float a1, float a2);
+
+    // make a channel a second order Butterworth low pass, matching
+    // LowPassFilter2p. A zero cutoff makes it a pass-through
+    void set_low_pass(uint8_t channel, float sample_freq_hz, float cutoff_freq_hz);
+
+    // make a channel a notch, matching NotchFilter
+    void set_notch(uint8_t channel, float sample_freq_hz, float center_freq_hz, float bandwidth_hz, float attenuation_dB);
+
+    // filter one sample for every channel. in and out hold
+    // num_channels() values and may be the same array
+    void apply(const float *in, float *out);
+
+    // clear the history of every channel
+    void reset();
+
+private:
+    uint8_t _num_channels;
+
+    // one allocation of seven arrays of _num_channels floats
+    float *_mem;
+    float *_b0;
+    float *_b1;
+    float *_b2;
+    float *_a1;
+    float *_a2;
+    float *_z1;
+    float *_z2;
+};
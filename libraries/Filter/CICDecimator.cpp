@@ -0,0 +1,65 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CICDecimator.h"
+
+bool CICDecimator::set_ratio(uint8_t ratio)
+{
+    if (ratio == 0 || ratio > CIC_DECIMATOR_MAX_RATIO || (ratio & (ratio-1)) != 0) {
+        return false;
+    }
+    _ratio = ratio;
+    // the gain of the filter is ratio^3
+    _scale = 1.0f / (uint32_t(ratio) * ratio * ratio);
+    reset();
+    return true;
+}
+
+void CICDecimator::reset()
+{
+    _count = 0;
+    memset(_integrator, 0, sizeof(_integrator));
+    memset(_comb, 0, sizeof(_comb));
+}
+
+bool CICDecimator::apply(int32_t x, int32_t y, int32_t z, Vector3f &out)
+{
+    const int32_t in[3] { x, y, z };
+    for (uint8_t axis=0; axis<3; axis++) {
+        uint32_t *integ = _integrator[axis];
+        integ[0] += uint32_t(in[axis]);
+        integ[1] += integ[0];
+        integ[2] += integ[1];
+    }
+    if (++_count < _ratio) {
+        return false;
+    }
+    _count = 0;
+
+    float result[3];
+    for (uint8_t axis=0; axis<3; axis++) {
+        uint32_t *comb = _comb[axis];
+        const uint32_t c0 = _integrator[axis][2];
+        const uint32_t c1 = c0 - comb[0];
+        const uint32_t c2 = c1 - comb[1];
+        const uint32_t c3 = c2 - comb[2];
+        comb[0] = c0;
+        comb[1] = c1;
+        comb[2] = c2;
+        result[axis] = int32_t(c3) * _scale;
+    }
+    out = Vector3f(result[0], result[1], result[2]);
+    return true;
+}
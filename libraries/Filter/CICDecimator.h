@@ -0,0 +1,64 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+  third order cascaded integrator-comb (CIC) decimator for three axes
+  of raw integer sensor samples.
+
+  Each output is a sinc^3 weighted average of the last 3*ratio-2
+  inputs. A plain average of ratio inputs is sinc^1, so this has the
+  same nulls at multiples of the output rate but attenuates the
+  vibration which would alias into the low frequencies by three times
+  as many dB. The delay is 1.5*(ratio-1) input samples.
+
+  The integrators and combs are 32 bit integers which are allowed to
+  wrap. The comb differences are still exact as the output needs at
+  most 17 + 3*log2(ratio) bits, which fits for inputs of up to 17 bits
+  and a ratio up to 16. Only the output is converted to float.
+ */
+
+#include <AP_Math/AP_Math.h>
+
+#define CIC_DECIMATOR_MAX_RATIO 16
+
+class CICDecimator {
+public:
+    // set the decimation ratio, a power of two from 1 to
+    // CIC_DECIMATOR_MAX_RATIO, and clear the history. Returns false
+    // on any other ratio
+    bool set_ratio(uint8_t ratio);
+
+    uint8_t get_ratio() const { return _ratio; }
+
+    // add a sample. Returns true on every ratio'th sample, with out
+    // set to the decimated sample in the units of the input
+    bool apply(int32_t x, int32_t y, int32_t z, Vector3f &out);
+
+    // delay of the output in input samples
+    float get_delay_samples() const { return 1.5f * (_ratio - 1); }
+
+    // clear the history
+    void reset();
+
+private:
+    uint8_t _ratio = 1;
+    uint8_t _count;
+    float _scale = 1;
+
+    // per axis integrator and comb delay state, wrapping
+    uint32_t _integrator[3][3];
+    uint32_t _comb[3][3];
+};
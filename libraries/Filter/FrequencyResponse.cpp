@@ -0,0 +1,115 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrequencyResponse.h"
+
+// samples between renormalisations of the phasors, which otherwise
+// drift in magnitude with rounding
+#define FREQUENCY_RESPONSE_RENORM_SAMPLES 256
+
+// a band is only measured if its input bin has at least this
+// fraction of the largest input bin's magnitude
+#define FREQUENCY_RESPONSE_MIN_INPUT_RATIO 0.01f
+
+void FrequencyResponse::init(float frequency_min_hz, float frequency_max_hz, uint8_t _num_bands, float sample_rate_hz)
+{
+    num_bands = constrain_int16(_num_bands, 1, FREQUENCY_RESPONSE_MAX_BANDS);
+    frequency_min_hz = MAX(frequency_min_hz, 0.01f);
+    frequency_max_hz = MAX(frequency_max_hz, frequency_min_hz);
+    const float ratio = num_bands > 1 ? powf(frequency_max_hz / frequency_min_hz, 1.0f / (num_bands - 1)) : 1;
+
+    float frequency = frequency_min_hz;
+    for (uint8_t i=0; i<num_bands; i++) {
+        struct band &b = bands[i];
+        b.frequency_hz = frequency;
+        const float step = M_2PI * frequency / sample_rate_hz;
+        b.step_cos = cosf(step);
+        b.step_sin = sinf(step);
+        frequency *= ratio;
+    }
+    reset();
+}
+
+void FrequencyResponse::reset(void)
+{
+    for (uint8_t i=0; i<num_bands; i++) {
+        struct band &b = bands[i];
+        b.phasor_re = 1;
+        b.phasor_im = 0;
+        b.input_re = 0;
+        b.input_im = 0;
+        b.output_re = 0;
+        b.output_im = 0;
+    }
+    num_samples = 0;
+}
+
+void FrequencyResponse::update(float input, float output)
+{
+    const bool renormalise = (++num_samples % FREQUENCY_RESPONSE_RENORM_SAMPLES) == 0;
+    for (uint8_t i=0; i<num_bands; i++) {
+        struct band &b = bands[i];
+
+        // correlate with e^(-j*w*t)
+        b.input_re += input * b.phasor_re;
+        b.input_im -= input * b.phasor_im;
+        b.output_re += output * b.phasor_re;
+        b.output_im -= output * b.phasor_im;
+
+        // advance to the next sample
+        const float re = b.phasor_re * b.step_cos - b.phasor_im * b.step_sin;
+        const float im = b.phasor_re * b.step_sin + b.phasor_im * b.step_cos;
+        b.phasor_re = re;
+        b.phasor_im = im;
+
+        if (renormalise) {
+            const float scale = 1.0f / norm(b.phasor_re, b.phasor_im);
+            b.phasor_re *= scale;
+            b.phasor_im *= scale;
+        }
+    }
+}
+
+float FrequencyResponse::get_frequency_hz(uint8_t band) const
+{
+    if (band >= num_bands) {
+        return 0;
+    }
+    return bands[band].frequency_hz;
+}
+
+bool FrequencyResponse::get_response(uint8_t band, float &gain, float &phase_deg) const
+{
+    if (band >= num_bands || num_samples == 0) {
+        return false;
+    }
+
+    float max_input = 0;
+    for (uint8_t i=0; i<num_bands; i++) {
+        max_input = MAX(max_input, norm(bands[i].input_re, bands[i].input_im));
+    }
+    const struct band &b = bands[band];
+    const float input = norm(b.input_re, b.input_im);
+    if (!is_positive(input) || input < FREQUENCY_RESPONSE_MIN_INPUT_RATIO * max_input) {
+        return false;
+    }
+
+    // output * conj(input), whose angle is the phase of the response
+    const float re = b.output_re * b.input_re + b.output_im * b.input_im;
+    const float im = b.output_im * b.input_re - b.output_re * b.input_im;
+    gain = norm(b.output_re, b.output_im) / input;
+    phase_deg = degrees(atan2f(im, re));
+    return true;
+}
@@ -0,0 +1,79 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+  on-board estimate of the frequency response of a system, from its
+  input and output sampled at a fixed rate, as when a chirp is injected
+  for system identification.
+
+  Each band accumulates a single bin DFT of the input and of the output
+  at its frequency, using a phasor rotated by a fixed step each sample,
+  so a sample costs a few multiplies per band and no trig. The response
+  at a band is the ratio of the output to the input bin
+ */
+
+#include <AP_Math/AP_Math.h>
+#include <inttypes.h>
+
+#ifndef FREQUENCY_RESPONSE_MAX_BANDS
+#define FREQUENCY_RESPONSE_MAX_BANDS 16
+#endif
+
+class FrequencyResponse {
+public:
+    // track num_bands frequencies, logarithmically spaced from
+    // frequency_min_hz to frequency_max_hz, for samples at sample_rate_hz
+    void init(float frequency_min_hz, float frequency_max_hz, uint8_t num_bands, float sample_rate_hz);
+
+    // clear the accumulated response
+    void reset(void);
+
+    // add a sample of the system's input and output
+    void update(float input, float output);
+
+    uint8_t get_num_bands(void) const { return num_bands; }
+    float get_frequency_hz(uint8_t band) const;
+    uint32_t get_num_samples(void) const { return num_samples; }
+
+    /*
+      get the gain and phase in degrees of the output relative to the
+      input at a band, a lag giving a negative phase. Returns false if
+      the input had too little energy at the band to measure it
+     */
+    bool get_response(uint8_t band, float &gain, float &phase_deg) const;
+
+private:
+    struct band {
+        float frequency_hz;
+
+        // the phasor's rotation for each sample
+        float step_cos;
+        float step_sin;
+
+        // e^(j*w*t) at the current sample
+        float phasor_re;
+        float phasor_im;
+
+        // DFT bins of input and output
+        float input_re;
+        float input_im;
+        float output_re;
+        float output_im;
+    } bands[FREQUENCY_RESPONSE_MAX_BANDS];
+
+    uint8_t num_bands;
+    uint32_t num_samples;
+};
@@ -0,0 +1,189 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "HarmonicNotchFilter.h"
+
+// notches closer than this to the Nyquist frequency are left out
+#define HNF_MAX_FREQ_RATIO 0.4f
+
+template <class T>
+HarmonicNotchFilter<T>::~HarmonicNotchFilter()
+{
+    delete[] _filters;
+}
+
+/*
+  allocate the filter bank
+ */
+template <class T>
+void HarmonicNotchFilter<T>::allocate_filters(uint8_t harmonics)
+{
+    if (_filters != nullptr) {
+        return;
+    }
+    uint8_t count = 0;
+    for (uint8_t i=0; i<HNF_MAX_HARMONICS; i++) {
+        if (harmonics & (1U<<i)) {
+            count++;
+        }
+    }
+    if (count == 0) {
+        return;
+    }
+    _filters = new NotchFilter<T>[count];
+    if (_filters == nullptr) {
+        return;
+    }
+    _num_filters = count;
+    _harmonics = harmonics;
+}
+
+/*
+  initialise the filter bank
+ */
+template <class T>
+void HarmonicNotchFilter<T>::init(float sample_freq_hz, float center_freq_hz, float bandwidth_hz, float attenuation_dB)
+{
+    if (_filters == nullptr || !is_positive(sample_freq_hz) ||
+        !is_positive(center_freq_hz) || bandwidth_hz >= 2 * center_freq_hz) {
+        return;
+    }
+    _sample_freq_hz = sample_freq_hz;
+    NotchFilter<T>::calculate_A_and_Q(center_freq_hz, bandwidth_hz, attenuation_dB, _A, _Q);
+    _initialised = true;
+    update(center_freq_hz);
+}
+
+/*
+  move the notches. Keeping A and Q gives each harmonic the same shape
+  relative to its frequency, and leaves only a sine and cosine per
+  notch to calculate
+ */
+template <class T>
+void HarmonicNotchFilter<T>::update(float center_freq_hz)
+{
+    if (!_initialised || !is_positive(center_freq_hz)) {
+        return;
+    }
+    const float max_freq_hz = _sample_freq_hz * HNF_MAX_FREQ_RATIO;
+    uint8_t n = 0;
+    for (uint8_t i=0; i<HNF_MAX_HARMONICS && n<_num_filters; i++) {
+        if (!(_harmonics & (1U<<i))) {
+            continue;
+        }
+        const float notch_freq_hz = center_freq_hz * (i+1);
+        if (notch_freq_hz > max_freq_hz) {
+            // the higher harmonics are out of range too
+            break;
+        }
+        if (n >= _num_enabled_filters) {
+            // don't start from the history of an earlier frequency
+            _filters[n].reset();
+        }
+        _filters[n].init_with_A_and_Q(_sample_freq_hz, notch_freq_hz, _A, _Q);
+        n++;
+    }
+    _num_enabled_filters = n;
+}
+
+/*
+  apply a sample to each of the notches in turn
+ */
+template <class T>
+T HarmonicNotchFilter<T>::apply(const T &sample)
+{
+    T output = sample;
+    for (uint8_t i=0; i<_num_enabled_filters; i++) {
+        output = _filters[i].apply(output);
+    }
+    return output;
+}
+
+template <class T>
+void HarmonicNotchFilter<T>::reset()
+{
+    for (uint8_t i=0; i<_num_filters; i++) {
+        _filters[i].reset();
+    }
+}
+
+// table of user settable parameters
+const AP_Param::GroupInfo HarmonicNotchFilterParams::var_info[] = {
+
+    // @Param: ENABLE
+    // @DisplayName: Harmonic notch filter enable
+    // @Description: Enable the harmonic notch filter on all gyros
+    // @Values: 0:Disabled,1:Enabled
+    // @User: Advanced
+    AP_GROUPINFO_FLAGS("ENABLE", 1, HarmonicNotchFilterParams, _enable, 0, AP_PARAM_FLAG_ENABLE),
+
+    // @Param: FREQ
+    // @DisplayName: Harmonic notch base frequency
+    // @Description: Center frequency of the fundamental notch in Hz. With a throttle reference this is the frequency at hover throttle. With the other dynamic references the notch is never moved below this frequency
+    // @Range: 10 400
+    // @Units: Hz
+    // @User: Advanced
+    AP_GROUPINFO("FREQ", 2, HarmonicNotchFilterParams, _center_freq_hz, 80),
+
+    // @Param: BW
+    // @DisplayName: Harmonic notch bandwidth
+    // @Description: Bandwidth of the fundamental notch at the base frequency in Hz. The other notches, and the fundamental as it moves, keep the same bandwidth relative to their frequency
+    // @Range: 5 100
+    // @Units: Hz
+    // @User: Advanced
+    AP_GROUPINFO("BW", 3, HarmonicNotchFilterParams, _bandwidth_hz, 40),
+
+    // @Param: ATT
+    // @DisplayName: Harmonic notch attenuation
+    // @Description: Attenuation at the center of each notch in dB
+    // @Range: 5 50
+    // @Units: dB
+    // @User: Advanced
+    AP_GROUPINFO("ATT", 4, HarmonicNotchFilterParams, _attenuation_dB, 15),
+
+    // @Param: HMNCS
+    // @DisplayName: Harmonics
+    // @Description: Bitmask of the harmonics to notch, where the fundamental is the first harmonic. Each is a separate filter, adding load and phase lag
+    // @Bitmask: 0:1st harmonic,1:2nd harmonic,2:3rd harmonic,3:4th harmonic,4:5th harmonic,5:6th harmonic,6:7th harmonic,7:8th harmonic
+    // @User: Advanced
+    // @RebootRequired: True
+    AP_GROUPINFO("HMNCS", 5, HarmonicNotchFilterParams, _harmonics, 3),
+
+    // @Param: REF
+    // @DisplayName: Harmonic notch reference
+    // @Description: Source of the fundamental frequency. Throttle scales the base frequency by the square root of the throttle relative to hover throttle. RPM sensor and ESC telemetry use the motor RPM. Gyro FFT uses the strongest roll and pitch vibration found by the on-board FFT
+    // @Values: 0:Fixed,1:Throttle,2:RPM sensor,3:ESC telemetry,4:Gyro FFT
+    // @User: Advanced
+    AP_GROUPINFO("REF", 6, HarmonicNotchFilterParams, _reference, 1),
+
+    // @Param: SCALE
+    // @DisplayName: Harmonic notch RPM scale
+    // @Description: Scale applied to the RPM, divided by 60, to give the fundamental frequency with the RPM sensor and ESC telemetry references. For example the blade count for a sensor on the rotor of a helicopter
+    // @Range: 0.1 10
+    // @User: Advanced
+    AP_GROUPINFO("SCALE", 7, HarmonicNotchFilterParams, _rpm_scale, 1),
+
+    AP_GROUPEND
+};
+
+HarmonicNotchFilterParams::HarmonicNotchFilterParams(void)
+{
+    AP_Param::setup_object_defaults(this, var_info);
+}
+
+/*
+   instantiate template classes
+ */
+template class HarmonicNotchFilter<Vector3f>;
@@ -0,0 +1,93 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+/*
+  a bank of notch filters on the harmonics of a center frequency that
+  can be moved every loop, for tracking motor noise
+ */
+
+#include <AP_Math/AP_Math.h>
+#include <AP_Param/AP_Param.h>
+#include "NotchFilter.h"
+
+// the harmonics bitmask covers the fundamental and up to this
+#define HNF_MAX_HARMONICS 8
+
+template <class T>
+class HarmonicNotchFilter {
+public:
+    ~HarmonicNotchFilter();
+    // allocate a notch filter for each bit set in harmonics, where
+    // bit 0 is the fundamental
+    void allocate_filters(uint8_t harmonics);
+    // set the sample rate, and the shape of the notches from the
+    // bandwidth and attenuation at center_freq_hz
+    void init(float sample_freq_hz, float center_freq_hz, float bandwidth_hz, float attenuation_dB);
+    // move the fundamental, keeping the shape of each notch
+    void update(float center_freq_hz);
+    T apply(const T &sample);
+    void reset();
+
+private:
+    NotchFilter<T> *_filters;
+    uint8_t _num_filters;
+    // the filters in use, those below the Nyquist limit
+    uint8_t _num_enabled_filters;
+    uint8_t _harmonics;
+
+    float _sample_freq_hz;
+    float _A;
+    float _Q;
+    bool _initialised;
+};
+
+/*
+  harmonic notch parameters
+ */
+class HarmonicNotchFilterParams {
+public:
+    // source of the center frequency
+    enum class Reference {
+        Fixed        = 0,
+        Throttle     = 1,
+        RPMSensor    = 2,
+        ESCTelemetry = 3,
+        GyroFFT      = 4,
+    };
+
+    HarmonicNotchFilterParams(void);
+
+    bool enabled() const { return _enable; }
+    float center_freq_hz() const { return _center_freq_hz; }
+    float bandwidth_hz() const { return _bandwidth_hz; }
+    float attenuation_dB() const { return _attenuation_dB; }
+    uint8_t harmonics() const { return _harmonics; }
+    Reference reference() const { return (Reference)_reference.get(); }
+    float rpm_scale() const { return _rpm_scale; }
+
+    static const struct AP_Param::GroupInfo var_info[];
+
+private:
+    AP_Int8 _enable;
+    AP_Float _center_freq_hz;
+    AP_Float _bandwidth_hz;
+    AP_Float _attenuation_dB;
+    AP_Int8 _harmonics;
+    AP_Int8 _reference;
+    AP_Float _rpm_scale;
+};
+
+typedef HarmonicNotchFilter<Vector3f> HarmonicNotchFilterVector3f;
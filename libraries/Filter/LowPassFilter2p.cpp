@@ -108,3 +108,6 @@ template class LowPassFilter2p<long>;
 template class LowPassFilter2p<float>;
 template class LowPassFilter2p<Vector2f>;
 template class LowPassFilter2p<Vector3f>;
+
+// used directly by BiquadFilterBank
+template class DigitalBiquadFilter<float>;
@@ -21,17 +21,38 @@
 template <class T>
 void NotchFilter<T>::init(float sample_freq_hz, float center_freq_hz, float bandwidth_hz, float attenuation_dB)
 {
-    float omega = 2.0 * M_PI * center_freq_hz / sample_freq_hz;
+    float A, Q;
+    calculate_A_and_Q(center_freq_hz, bandwidth_hz, attenuation_dB, A, Q);
+    init_with_A_and_Q(sample_freq_hz, center_freq_hz, A, Q);
+}
+
+/*
+  calculate the attenuation and quality factor, which depend only on
+  the shape of the notch
+ */
+template <class T>
+void NotchFilter<T>::calculate_A_and_Q(float center_freq_hz, float bandwidth_hz, float attenuation_dB, float& A, float& Q)
+{
     float octaves = log2f(center_freq_hz  / (center_freq_hz - bandwidth_hz/2)) * 2;
-    float A = powf(10, -attenuation_dB/40);
-    float Q = sqrtf(powf(2, octaves)) / (powf(2,octaves) - 1);
+    A = powf(10, -attenuation_dB/40);
+    Q = sqrtf(powf(2, octaves)) / (powf(2,octaves) - 1);
+}
+
+/*
+  initialise filter from a precalculated A and Q. This only needs a
+  sine and cosine, so is cheap enough to do every loop
+ */
+template <class T>
+void NotchFilter<T>::init_with_A_and_Q(float sample_freq_hz, float center_freq_hz, float A, float Q)
+{
+    float omega = 2.0 * M_PI * center_freq_hz / sample_freq_hz;
     float alpha = sinf(omega) / (2 * Q/A);
-    b0 =  1.0 + alpha*A;
-    b1 = -2.0 * cosf(omega);
-    b2 =  1.0 - alpha*A;
-    a0_inv =  1.0/(1.0 + alpha/A);
-    a1 = -2.0 * cosf(omega);
-    a2 =  1.0 - alpha/A;
+    const float a0_inv = 1.0/(1.0 + alpha/A);
+    b0 = (1.0 + alpha*A) * a0_inv;
+    b1 = -2.0 * cosf(omega) * a0_inv;
+    b2 = (1.0 - alpha*A) * a0_inv;
+    a1 = b1;
+    a2 = (1.0 - alpha/A) * a0_inv;
     initialised = true;
 }
 
@@ -49,21 +70,31 @@ T NotchFilter<T>::apply(const T &sample)
     ntchsig2 = ntchsig1;
     ntchsig1 = ntchsig;
     ntchsig = sample;
-    T output = (ntchsig*b0 + ntchsig1*b1 + ntchsig2*b2 - signal1*a1 - signal2*a2) * a0_inv;
+    T output = ntchsig*b0 + ntchsig1*b1 + ntchsig2*b2 - signal1*a1 - signal2*a2;
     signal2 = signal1;
     signal1 = output;
     return output;
 }
 
+/*
+  clear the filter history
+ */
+template <class T>
+void NotchFilter<T>::reset()
+{
+    ntchsig2 = ntchsig1 = ntchsig = T();
+    signal2 = signal1 = T();
+}
+
 // table of user settable parameters
-const AP_Param::GroupInfo NotchFilterVector3fParam::var_info[] = {
+const AP_Param::GroupInfo NotchFilterParams::var_info[] = {
 
     // @Param: ENABLE
     // @DisplayName: Enable
     // @Description: Enable notch filter
     // @Values: 0:Disabled,1:Enabled
     // @User: Advanced
-    AP_GROUPINFO_FLAGS("ENABLE", 1, NotchFilterVector3fParam, enable, 0, AP_PARAM_FLAG_ENABLE),
+    AP_GROUPINFO_FLAGS("ENABLE", 1, NotchFilterParams, _enable, 0, AP_PARAM_FLAG_ENABLE),
 
     // @Param: FREQ
     // @DisplayName: Frequency
@@ -71,7 +102,7 @@ const AP_Param::GroupInfo NotchFilterVector3fParam::var_info[] = {
     // @Range: 10 200
     // @Units: Hz
     // @User: Advanced
-    AP_GROUPINFO("FREQ", 2, NotchFilterVector3fParam, center_freq_hz, 80),
+    AP_GROUPINFO("FREQ", 2, NotchFilterParams, _center_freq_hz, 80),
 
     // @Param: BW
     // @DisplayName: Bandwidth
@@ -79,7 +110,7 @@ const AP_Param::GroupInfo NotchFilterVector3fParam::var_info[] = {
     // @Range: 5 50
     // @Units: Hz
     // @User: Advanced
-    AP_GROUPINFO("BW", 3, NotchFilterVector3fParam, bandwidth_hz, 20),
+    AP_GROUPINFO("BW", 3, NotchFilterParams, _bandwidth_hz, 20),
 
     // @Param: ATT
     // @DisplayName: Attenuation
@@ -87,52 +118,14 @@ const AP_Param::GroupInfo NotchFilterVector3fParam::var_info[] = {
     // @Range: 5 30
     // @Units: dB
     // @User: Advanced
-    AP_GROUPINFO("ATT", 4, NotchFilterVector3fParam, attenuation_dB, 15),
+    AP_GROUPINFO("ATT", 4, NotchFilterParams, _attenuation_dB, 15),
     
     AP_GROUPEND
 };
 
-/*
-  a notch filter with enable and filter parameters - constructor
- */
-NotchFilterVector3fParam::NotchFilterVector3fParam(void)
-{
-    AP_Param::setup_object_defaults(this, var_info);    
-}
-
-/*
-  initialise filter
- */
-void NotchFilterVector3fParam::init(float _sample_freq_hz)
+NotchFilterParams::NotchFilterParams(void)
 {
-    filter.init(_sample_freq_hz, center_freq_hz, bandwidth_hz, attenuation_dB);
-
-    sample_freq_hz = _sample_freq_hz;
-    last_center_freq = center_freq_hz;
-    last_bandwidth = bandwidth_hz;
-    last_attenuation = attenuation_dB;
-}
-
-/*
-  apply a filter sample
- */
-Vector3f NotchFilterVector3fParam::apply(const Vector3f &sample)
-{
-    if (!enable) {
-        // when not enabled it is a simple pass-through
-        return sample;
-    }
-
-    // check for changed parameters
-    if (!is_equal(center_freq_hz.get(), last_center_freq) ||
-        !is_equal(bandwidth_hz.get(), last_bandwidth) ||
-        !is_equal(attenuation_dB.get(), last_attenuation)) {
-        if (!is_zero(sample_freq_hz)) {
-            init(sample_freq_hz);
-        }
-    }
-    
-    return filter.apply(sample);
+    AP_Param::setup_object_defaults(this, var_info);
 }
 
 /* 
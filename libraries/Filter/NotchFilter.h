@@ -31,38 +31,41 @@ class NotchFilter {
 public:
     // set parameters
     void init(float sample_freq_hz, float center_freq_hz, float bandwidth_hz, float attenuation_dB);
+    // set parameters from a precalculated A and Q, which is all that
+    // is needed to move the center frequency
+    void init_with_A_and_Q(float sample_freq_hz, float center_freq_hz, float A, float Q);
     T apply(const T &sample);
+    void reset();
+
+    // calculate the attenuation and quality factor of a notch
+    static void calculate_A_and_Q(float center_freq_hz, float bandwidth_hz, float attenuation_dB, float& A, float& Q);
 
 private:
     bool initialised;
-    float b0, b1, b2, a1, a2, a0_inv;
+    // coefficients, normalised by a0
+    float b0, b1, b2, a1, a2;
     T ntchsig, ntchsig1, ntchsig2, signal2, signal1;
 };
 
 /*
-  a notch filter with enable and filter parameters
+  notch filter enable and filter parameters
  */
-class NotchFilterVector3fParam {
+class NotchFilterParams {
 public:
-    NotchFilterVector3fParam(void);
-    void init(float sample_freq_hz);
-    Vector3f apply(const Vector3f &sample);
+    NotchFilterParams(void);
 
-    static const struct AP_Param::GroupInfo var_info[];
-    
-private:
-    AP_Int8 enable;
-    AP_Float center_freq_hz;
-    AP_Float bandwidth_hz;
-    AP_Float attenuation_dB;
+    bool enabled() const { return _enable; }
+    float center_freq_hz() const { return _center_freq_hz; }
+    float bandwidth_hz() const { return _bandwidth_hz; }
+    float attenuation_dB() const { return _attenuation_dB; }
 
-    float sample_freq_hz;
+    static const struct AP_Param::GroupInfo var_info[];
 
-    float last_center_freq;
-    float last_bandwidth;
-    float last_attenuation;
-    
-    NotchFilter<Vector3f> filter;
+private:
+    AP_Int8 _enable;
+    AP_Float _center_freq_hz;
+    AP_Float _bandwidth_hz;
+    AP_Float _attenuation_dB;
 };
 
 typedef NotchFilter<float> NotchFilterFloat;
@@ -0,0 +1,78 @@
+/*
+ *       Example sketch to time BiquadFilterBank against separate
+ *       LowPassFilter2p filters, for 3, 12 and 48 channels
+ */
+
+#include <AP_HAL/AP_HAL.h>
+#include <Filter/BiquadFilterBank.h>
+#include <Filter/LowPassFilter2p.h>
+
+void setup();
+void loop();
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+#define MAX_CHANNELS 48
+#define SAMPLES 2000
+
+static const float sample_rate_hz = 1000;
+static const uint8_t channel_counts[] = { 3, 12, 48 };
+
+static LowPassFilter2pFloat filters[MAX_CHANNELS];
+static BiquadFilterBank banks[ARRAY_SIZE(channel_counts)];
+static float in[MAX_CHANNELS];
+static float out[MAX_CHANNELS];
+
+// time per sample per channel, in nanoseconds
+static float time_filters(uint8_t num_channels)
+{
+    const uint32_t start_us = AP_HAL::micros();
+    for (uint16_t s=0; s<SAMPLES; s++) {
+        for (uint8_t c=0; c<num_channels; c++) {
+            out[c] = filters[c].apply(in[c]);
+        }
+    }
+    return (AP_HAL::micros() - start_us) * 1000.0f / (SAMPLES * num_channels);
+}
+
+static float time_bank(BiquadFilterBank &bank)
+{
+    const uint32_t start_us = AP_HAL::micros();
+    for (uint16_t s=0; s<SAMPLES; s++) {
+        bank.apply(in, out);
+    }
+    return (AP_HAL::micros() - start_us) * 1000.0f / (SAMPLES * bank.num_channels());
+}
+
+void setup()
+{
+    hal.console->printf("ArduPilot BiquadFilterBank timing\n\n");
+
+    for (uint8_t c=0; c<MAX_CHANNELS; c++) {
+        filters[c].set_cutoff_frequency(sample_rate_hz, 20 + c);
+        in[c] = sinf(c);
+    }
+    for (uint8_t i=0; i<ARRAY_SIZE(channel_counts); i++) {
+        if (!banks[i].init(channel_counts[i])) {
+            AP_HAL::panic("out of memory");
+        }
+        for (uint8_t c=0; c<channel_counts[i]; c++) {
+            banks[i].set_low_pass(c, sample_rate_hz, 20 + c);
+        }
+    }
+}
+
+void loop()
+{
+    for (uint8_t i=0; i<ARRAY_SIZE(channel_counts); i++) {
+        const uint8_t n = channel_counts[i];
+        const float filters_ns = time_filters(n);
+        const float bank_ns = time_bank(banks[i]);
+        hal.console->printf("%2u channels: separate %.1fns bank %.1fns per channel sample\n",
+                            (unsigned)n, (double)filters_ns, (double)bank_ns);
+    }
+    hal.console->printf("\n");
+    hal.scheduler->delay(5000);
+}
+
+AP_HAL_MAIN();
@@ -0,0 +1,102 @@
+#include <AP_gtest.h>
+
+#include <Filter/BiquadFilterBank.h>
+#include <Filter/LowPassFilter2p.h>
+#include <Filter/NotchFilter.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static const float sample_rate_hz = 1000;
+
+// channels not a multiple of four, to cover both the SIMD and scalar
+// paths
+#define NUM_CHANNELS 7
+
+static float input(uint16_t i, uint8_t channel)
+{
+    return sinf(i * (0.05f + 0.03f * channel)) + 0.2f * channel;
+}
+
+TEST(BiquadFilterBankTest, MatchesSingleFilters)
+{
+    BiquadFilterBank bank {};
+    ASSERT_TRUE(bank.init(NUM_CHANNELS));
+
+    LowPassFilter2pFloat low_pass[NUM_CHANNELS];
+    NotchFilterFloat notch[NUM_CHANNELS] {};
+    for (uint8_t c=0; c<NUM_CHANNELS; c++) {
+        if (c % 2 == 0) {
+            const float cutoff_hz = 20 + 10 * c;
+            low_pass[c].set_cutoff_frequency(sample_rate_hz, cutoff_hz);
+            bank.set_low_pass(c, sample_rate_hz, cutoff_hz);
+        } else {
+            const float center_hz = 50 + 20 * c;
+            notch[c].init(sample_rate_hz, center_hz, 20, 20);
+            bank.set_notch(c, sample_rate_hz, center_hz, 20, 20);
+        }
+    }
+
+    float in[NUM_CHANNELS];
+    float out[NUM_CHANNELS];
+    for (uint16_t i=0; i<2000; i++) {
+        for (uint8_t c=0; c<NUM_CHANNELS; c++) {
+            in[c] = input(i, c);
+        }
+        bank.apply(in, out);
+        for (uint8_t c=0; c<NUM_CHANNELS; c++) {
+            const float expected = (c % 2 == 0) ? low_pass[c].apply(in[c]) : notch[c].apply(in[c]);
+            EXPECT_NEAR(out[c], expected, 1.0e-4f);
+        }
+    }
+}
+
+TEST(BiquadFilterBankTest, InPlaceAndReset)
+{
+    BiquadFilterBank bank {};
+    ASSERT_TRUE(bank.init(NUM_CHANNELS));
+    for (uint8_t c=0; c<NUM_CHANNELS; c++) {
+        bank.set_low_pass(c, sample_rate_hz, 30);
+    }
+
+    float first[NUM_CHANNELS];
+    float buf[NUM_CHANNELS];
+    for (uint8_t c=0; c<NUM_CHANNELS; c++) {
+        buf[c] = 1;
+    }
+    bank.apply(buf, first);
+    for (uint16_t i=0; i<100; i++) {
+        for (uint8_t c=0; c<NUM_CHANNELS; c++) {
+            buf[c] = 1;
+        }
+        bank.apply(buf, buf);
+    }
+
+    // after a reset a step gives the same first output again
+    bank.reset();
+    for (uint8_t c=0; c<NUM_CHANNELS; c++) {
+        buf[c] = 1;
+    }
+    bank.apply(buf, buf);
+    for (uint8_t c=0; c<NUM_CHANNELS; c++) {
+        EXPECT_FLOAT_EQ(buf[c], first[c]);
+    }
+}
+
+TEST(BiquadFilterBankTest, PassThroughByDefault)
+{
+    BiquadFilterBank bank {};
+    ASSERT_TRUE(bank.init(NUM_CHANNELS));
+    bank.set_low_pass(2, sample_rate_hz, 0);
+
+    float in[NUM_CHANNELS];
+    float out[NUM_CHANNELS];
+    for (uint8_t c=0; c<NUM_CHANNELS; c++) {
+        in[c] = c - 3.5f;
+    }
+    bank.apply(in, out);
+    for (uint8_t c=0; c<NUM_CHANNELS; c++) {
+        EXPECT_FLOAT_EQ(out[c], in[c]);
+    }
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,109 @@
+#include <AP_gtest.h>
+
+#include <Filter/CICDecimator.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+TEST(CICDecimatorTest, Ratios)
+{
+    CICDecimator cic;
+    EXPECT_FALSE(cic.set_ratio(0));
+    EXPECT_FALSE(cic.set_ratio(3));
+    EXPECT_FALSE(cic.set_ratio(2*CIC_DECIMATOR_MAX_RATIO));
+    EXPECT_TRUE(cic.set_ratio(8));
+    EXPECT_EQ(cic.get_ratio(), 8);
+    EXPECT_FLOAT_EQ(cic.get_delay_samples(), 10.5f);
+
+    // a ratio of one passes samples through
+    EXPECT_TRUE(cic.set_ratio(1));
+    Vector3f out;
+    EXPECT_TRUE(cic.apply(5, -7, 32767, out));
+    EXPECT_FLOAT_EQ(out.x, 5);
+    EXPECT_FLOAT_EQ(out.y, -7);
+    EXPECT_FLOAT_EQ(out.z, 32767);
+}
+
+/*
+  compare against a direct sinc^3 FIR, using full scale inputs for
+  long enough that the integrators wrap many times
+ */
+TEST(CICDecimatorTest, MatchesFIR)
+{
+    const uint8_t ratio = 8;
+    CICDecimator cic;
+    ASSERT_TRUE(cic.set_ratio(ratio));
+
+    // impulse response of three boxcars of length ratio
+    const uint8_t taps = 3*ratio - 2;
+    int32_t h[taps] {};
+    for (uint8_t i=0; i<ratio; i++) {
+        for (uint8_t j=0; j<ratio; j++) {
+            for (uint8_t k=0; k<ratio; k++) {
+                h[i+j+k]++;
+            }
+        }
+    }
+
+    int32_t history[taps] {};
+    uint8_t outputs = 0;
+    for (uint32_t n=0; n<200000; n++) {
+        const int32_t x = (n * 7919) % 65536 - 32768;
+        memmove(&history[1], &history[0], sizeof(history[0]) * (taps-1));
+        history[0] = x;
+        Vector3f out;
+        if (!cic.apply(x, -x, 32767, out)) {
+            continue;
+        }
+        if (outputs < 3) {
+            // the history is still filling
+            outputs++;
+            continue;
+        }
+        int64_t sum = 0;
+        for (uint8_t i=0; i<taps; i++) {
+            sum += int64_t(h[i]) * history[i];
+        }
+        const float expected = float(sum) / (ratio * ratio * ratio);
+        ASSERT_NEAR(out.x, expected, 1.0e-2f);
+        ASSERT_NEAR(out.y, -expected, 1.0e-2f);
+        ASSERT_NEAR(out.z, 32767, 1.0e-2f);
+    }
+}
+
+/*
+  a tone just below the output rate aliases to a low frequency. The
+  CIC should attenuate it by the cube of a plain average
+ */
+TEST(CICDecimatorTest, AliasRejection)
+{
+    const float input_rate_hz = 8000;
+    const uint8_t ratio = 8;
+    const float tone_hz = 950;
+
+    CICDecimator cic;
+    ASSERT_TRUE(cic.set_ratio(ratio));
+
+    float cic_peak = 0;
+    float average_peak = 0;
+    float sum = 0;
+    for (uint32_t n=0; n<8000; n++) {
+        const int32_t x = lrintf(10000 * sinf(M_2PI * tone_hz * n / input_rate_hz));
+        sum += x;
+        Vector3f out;
+        if (cic.apply(x, 0, 0, out)) {
+            if (n > 100) {
+                cic_peak = MAX(cic_peak, fabsf(out.x));
+                average_peak = MAX(average_peak, fabsf(sum / ratio));
+            }
+            sum = 0;
+        }
+    }
+
+    const float average_gain = average_peak / 10000;
+    const float cic_gain = cic_peak / 10000;
+    EXPECT_LT(average_gain, 0.1f);
+    EXPECT_GT(cic_gain, 0.5f * powf(average_gain, 3));
+    EXPECT_LT(cic_gain, 2.0f * powf(average_gain, 3));
+}
+
+AP_GTEST_MAIN()
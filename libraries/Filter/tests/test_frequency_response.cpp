@@ -0,0 +1,62 @@
+#include <AP_gtest.h>
+
+#include <Filter/FrequencyResponse.h>
+#include <AP_Math/chirp.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static const float sample_rate_hz = 400;
+
+// a system with a gain of 0.5 and a delay of 4 samples, driven by a
+// chirp covering all the bands
+TEST(FrequencyResponseTest, GainAndDelay)
+{
+    const uint8_t delay = 4;
+    FrequencyResponse response;
+    response.init(1, 20, 8, sample_rate_hz);
+    EXPECT_EQ(8, response.get_num_bands());
+    EXPECT_FLOAT_EQ(1, response.get_frequency_hz(0));
+    EXPECT_NEAR(20, response.get_frequency_hz(7), 1.0e-3f);
+
+    Chirp chirp;
+    chirp.init(30, 0.5f, 30, 1, 1, 2);
+    float history[delay] {};
+    uint32_t i = 0;
+    while (!chirp.completed()) {
+        const float input = chirp.update(i / sample_rate_hz, 1);
+        const float output = 0.5f * history[i % delay];
+        history[i % delay] = input;
+        response.update(input, output);
+        i++;
+    }
+
+    for (uint8_t band=0; band<response.get_num_bands(); band++) {
+        float gain, phase_deg;
+        ASSERT_TRUE(response.get_response(band, gain, phase_deg));
+        const float f = response.get_frequency_hz(band);
+        EXPECT_NEAR(0.5f, gain, 0.02f);
+        EXPECT_NEAR(-360 * f * delay / sample_rate_hz, phase_deg, 2);
+    }
+}
+
+// a band the input doesn't reach is not measured
+TEST(FrequencyResponseTest, NoInput)
+{
+    FrequencyResponse response;
+    response.init(1, 100, 4, sample_rate_hz);
+    float gain, phase_deg;
+    EXPECT_FALSE(response.get_response(0, gain, phase_deg));
+    for (uint16_t i=0; i<20000; i++) {
+        const float input = sinf(M_2PI * i / sample_rate_hz);
+        response.update(input, input);
+    }
+    EXPECT_TRUE(response.get_response(0, gain, phase_deg));
+    EXPECT_NEAR(1, gain, 1.0e-3f);
+    EXPECT_NEAR(0, phase_deg, 0.1f);
+    EXPECT_FALSE(response.get_response(3, gain, phase_deg));
+
+    response.reset();
+    EXPECT_FALSE(response.get_response(0, gain, phase_deg));
+}
+
+AP_GTEST_MAIN()
@@ -0,0 +1,78 @@
+#include <AP_gtest.h>
+
+#include <Filter/HarmonicNotchFilter.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+static const float sample_rate_hz = 1000;
+
+// peak output amplitude of filter given a sine at freq_hz, after
+// letting it settle
+static float response(HarmonicNotchFilterVector3f &filter, float freq_hz)
+{
+    filter.reset();
+    float peak = 0;
+    for (uint16_t i=0; i<4000; i++) {
+        const float v = sinf(M_2PI * freq_hz * i / sample_rate_hz);
+        const Vector3f out = filter.apply(Vector3f(v, v, v));
+        if (i >= 2000) {
+            peak = MAX(peak, fabsf(out.x));
+        }
+    }
+    return peak;
+}
+
+TEST(NotchFilterTest, AandQMatchesInit)
+{
+    NotchFilterFloat filter1 {};
+    NotchFilterFloat filter2 {};
+    float A, Q;
+    filter1.init(sample_rate_hz, 80, 20, 15);
+    NotchFilterFloat::calculate_A_and_Q(80, 20, 15, A, Q);
+    filter2.init_with_A_and_Q(sample_rate_hz, 80, A, Q);
+    for (uint16_t i=0; i<100; i++) {
+        const float v = sinf(i * 0.3f);
+        EXPECT_FLOAT_EQ(filter1.apply(v), filter2.apply(v));
+    }
+}
+
+TEST(HarmonicNotchFilterTest, NotchesHarmonics)
+{
+    HarmonicNotchFilterVector3f filter {};
+    // first and second harmonics
+    filter.allocate_filters(0x03);
+    filter.init(sample_rate_hz, 60, 20, 30);
+
+    EXPECT_LT(response(filter, 60), 0.1f);
+    EXPECT_LT(response(filter, 120), 0.1f);
+    EXPECT_GT(response(filter, 180), 0.9f);
+    EXPECT_GT(response(filter, 10), 0.9f);
+
+    // follow the fundamental
+    filter.update(90);
+    EXPECT_GT(response(filter, 60), 0.9f);
+    EXPECT_LT(response(filter, 90), 0.1f);
+    EXPECT_LT(response(filter, 180), 0.1f);
+}
+
+TEST(HarmonicNotchFilterTest, SkipsHarmonicsNearNyquist)
+{
+    HarmonicNotchFilterVector3f filter {};
+    filter.allocate_filters(0x03);
+    filter.init(sample_rate_hz, 100, 20, 30);
+
+    // the second harmonic is above the limit, so is passed
+    filter.update(300);
+    EXPECT_LT(response(filter, 300), 0.1f);
+    EXPECT_GT(response(filter, 450), 0.8f);
+}
+
+TEST(HarmonicNotchFilterTest, UnallocatedPassesThrough)
+{
+    HarmonicNotchFilterVector3f filter {};
+    filter.init(sample_rate_hz, 60, 20, 30);
+    const Vector3f v(1, 2, 3);
+    EXPECT_TRUE(filter.apply(v) == v);
+}
+
+AP_GTEST_MAIN()
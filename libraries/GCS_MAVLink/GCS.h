@@ -21,6 +21,29 @@
 
 #define GCS_DEBUG_SEND_MESSAGE_TIMINGS 0
 
+#ifndef GCS_HIGH_RATE_ENABLED
+#define GCS_HIGH_RATE_ENABLED !HAL_MINIMIZE_FEATURES
+#endif
+
+// handle position estimates from vision and motion capture systems
+#ifndef GCS_EXTERNAL_NAV_ENABLED
+#define GCS_EXTERNAL_NAV_ENABLED !HAL_MINIMIZE_FEATURES
+#endif
+
+// number of mission items requested ahead of the next expected item during a pipelined upload
+#define GCS_MISSION_UPLOAD_WINDOW 8
+
+// timesync answers with longer round trips than this don't give a clock offset
+#define GCS_TIMESYNC_MAX_RTT_US         20000
+// clock offsets are forgotten when not refreshed for this long
+#define GCS_TIMESYNC_OFFSET_TIMEOUT_MS  60000
+// timestamps more than this far before the message was received aren't believed
+#define GCS_TIMESYNC_MAX_LAG_US         500000
+
+// identical statustext messages within this time of the last one queued
+// are counted rather than sent, and the count sent with the next one queued
+#define GCS_STATUSTEXT_REPEAT_MS        1000
+
 // check if a message will fit in the payload space available
 #define PAYLOAD_SIZE(chan, id) (GCS_MAVLINK::packet_overhead_chan(chan)+MAVLINK_MSG_ID_ ## id ## _LEN)
 #define HAVE_PAYLOAD_SPACE(chan, id) (comm_get_txspace(chan) >= PAYLOAD_SIZE(chan, id))
@@ -211,7 +234,8 @@ public:
 #if AP_AHRS_NAVEKF_AVAILABLE
     void send_opticalflow();
 #endif
-    virtual void send_attitude() const;
+    void send_attitude() const;
+    virtual void pack_attitude(mavlink_attitude_t &packet) const;
     void send_autopilot_version() const;
     void send_extended_sys_state() const;
     void send_local_position() const;
@@ -358,7 +382,10 @@ protected:
     void handle_param_value(mavlink_message_t *msg);
     void handle_radio_status(mavlink_message_t *msg, bool log_radio);
     void handle_serial_control(const mavlink_message_t *msg);
+    void handle_file_transfer_protocol(const mavlink_message_t *msg);
+#if GCS_EXTERNAL_NAV_ENABLED
     void handle_vision_position_delta(mavlink_message_t *msg);
+#endif
 
     void handle_common_message(mavlink_message_t *msg);
     void handle_set_gps_global_origin(const mavlink_message_t *msg);
@@ -379,6 +406,7 @@ protected:
     MAV_RESULT handle_command_request_autopilot_capabilities(const mavlink_command_long_t &packet);
 
     virtual void send_banner();
+    void send_boot_report();
 
     void handle_device_op_read(mavlink_message_t *msg);
     void handle_device_op_write(mavlink_message_t *msg);
@@ -389,12 +417,25 @@ protected:
     // returns a timestamp suitable for packing into the ts1 field of TIMESYNC:
     uint64_t timesync_timestamp_ns() const;
     void handle_timesync(mavlink_message_t *msg);
+    void update_timesync_offset(const mavlink_message_t &msg, const mavlink_timesync_t &tsync, uint64_t round_trip_time_us);
     struct {
         int64_t sent_ts1;
         uint32_t last_sent_ms;
         const uint16_t interval_ms = 10000;
     }  _timesync_request;
 
+    // offsets of the clocks of the systems answering our timesync
+    // requests from ours, typically a companion computer and a GCS,
+    // so their timestamps can be converted to local time directly
+    // rather than by jitter correction
+    struct {
+        int64_t offset_us;          // remote time minus local time
+        uint32_t round_trip_us;     // round trip time of the request it came from
+        uint32_t last_update_ms;    // zero if the entry is free
+        uint8_t sysid;
+        uint8_t compid;
+    } _timesync_offset[2];
+
     void handle_statustext(mavlink_message_t *msg);
 
     bool telemetry_delayed() const;
@@ -432,12 +473,18 @@ protected:
     // vehicle-overridable message send function
     virtual bool try_send_message(enum ap_message id);
     virtual void send_global_position_int();
+    void pack_global_position_int(mavlink_global_position_int_t &packet);
+
+    // time of the IMU sample the current AHRS output comes from
+    static uint64_t ins_sample_time_us();
 
     // message sending functions:
     bool try_send_compass_message(enum ap_message id);
     bool try_send_mission_message(enum ap_message id);
     void send_hwstatus();
+#if HAL_RCINPUT_WITH_AP_RADIO
     void handle_data_packet(mavlink_message_t *msg);
+#endif
 
     // these two methods are called after current_loc is updated:
     virtual int32_t global_position_int_alt() const;
@@ -499,6 +546,10 @@ private:
     uint32_t        waypoint_timelast_receive; // milliseconds
     uint32_t        waypoint_timelast_request; // milliseconds
     const uint16_t  waypoint_receive_timeout = 8000; // milliseconds
+    bool            waypoint_pipelined = false; // true if requesting up to GCS_MISSION_UPLOAD_WINDOW items ahead
+    uint16_t        waypoint_request_sent;  // next index to request when pipelining
+    uint32_t        waypoint_upload_start_ms; // time the upload started, for reporting its rate
+    uint16_t        waypoint_upload_count;  // number of items in the upload
 
     // number of extra ms to add to slow things down for the radio
     uint16_t         stream_slowdown_ms;
@@ -545,6 +596,52 @@ private:
     ap_message next_deferred_bucket_message_to_send();
     void find_next_bucket_to_send();
     void remove_message_from_bucket(int8_t bucket, ap_message id);
+    // note that id has been sent (or dropped) from the sending
+    // bucket, rescheduling the bucket if it is now empty
+    void bucket_message_done(ap_message id);
+    // true if the sending bucket is more than an interval late
+    bool sending_bucket_behind() const;
+
+    // when the link can't keep up, the most important messages in a
+    // bucket are sent first and the least important are dropped
+    enum message_priority : uint8_t {
+        MESSAGE_PRIORITY_LOW,
+        MESSAGE_PRIORITY_NORMAL,
+        MESSAGE_PRIORITY_HIGH,
+    };
+    static enum message_priority ap_message_priority(ap_message id);
+
+    // achieved against requested stream rates since last logged
+    struct {
+        uint16_t sent;
+        uint16_t dropped;
+    } stream_stats;
+    uint16_t stream_messages_per_second() const;
+
+#if GCS_HIGH_RATE_ENABLED
+    /*
+      on ports with the MAVLinkHighRate serial protocol a client may
+      subscribe to a few cheap state messages with SET_MESSAGE_INTERVAL
+      at up to the main loop rate.  These are sent from the vehicle's
+      fast loop, just after the AHRS update, rather than through the
+      stream buckets
+     */
+    static const uint8_t HIGH_RATE_MAX_SUBSCRIPTIONS = 8;
+    struct high_rate_subscription {
+        ap_message id;
+        uint32_t interval_us;
+        uint32_t next_send_us;
+    } high_rate_subscriptions[HIGH_RATE_MAX_SUBSCRIPTIONS];
+    uint8_t num_high_rate_subscriptions;
+    bool high_rate_enabled;
+    static bool high_rate_capable(ap_message id);
+    // add, change or remove (interval_us==0) a subscription.  Returns
+    // false if the subscription table is full
+    bool set_high_rate_interval(ap_message id, uint32_t interval_us);
+    // returns the subscribed interval for id, or 0 if not subscribed
+    uint32_t get_high_rate_interval(ap_message id) const;
+    void update_high_rate_send(uint32_t sample_us);
+#endif
 
     // bitmask of IDs the code has spontaneously decided it wants to
     // send out.  Examples include HEARTBEAT (gcs_send_heartbeat)
@@ -631,17 +728,114 @@ private:
 
     uint8_t send_parameter_async_replies();
 
+    /*
+      MAVLink FTP, serving the file @PARAM/param.pck: every
+      parameter packed with its name prefix-compressed against the
+      previous one. A GCS can fetch this with a burst read in a
+      fraction of the time a PARAM_REQUEST_LIST takes. The shared DMA
+      and serial port statistics can also be read as @SYS/dma.txt and
+      @SYS/uarts.txt. On boards with a filesystem, other paths
+      are files on it, which can be listed, read, written and
+      removed, for fetching logs and pushing scripts and terrain.
+      Requests are handled in the IO thread as packing the
+      parameters and file IO are slow, and a burst read of a file is
+      read ahead there; replies and burst data are sent from
+      queued_param_send()
+     */
+    struct PACKED ftp_op {
+        uint16_t seq_number;
+        uint8_t session;
+        uint8_t opcode;
+        uint8_t size;
+        uint8_t req_opcode;
+        uint8_t burst_complete;
+        uint8_t padding;
+        uint32_t offset;
+        uint8_t data[239];
+    };
+    struct ftp_request {
+        mavlink_channel_t chan;
+        uint8_t sysid;
+        uint8_t compid;
+        struct ftp_op op;
+    };
+    struct ftp_state {
+        ObjectBuffer<ftp_request> requests{5};
+        ObjectBuffer<ftp_request> replies{5};
+        HAL_Semaphore sem;
+        bool timer_registered;
+        // the packed parameters or text of the open session
+        uint8_t *file;
+        uint32_t file_len;
+        uint32_t last_request_ms;
+        // or the file on the filesystem of the open session
+        int fd = -1;
+        bool fd_writable;
+        // data of the file read ahead of a burst by the IO thread
+        ByteBuffer *burst_data;
+        // burst read in progress
+        struct {
+            bool active;
+            mavlink_channel_t chan;
+            uint8_t sysid;
+            uint8_t compid;
+            uint16_t seq_number;
+            uint32_t offset;
+            // offset in the file the read ahead has reached
+            uint32_t read_offset;
+        } burst;
+    };
+    static struct ftp_state ftp;
+
+    /*
+      payloads of messages which are the same on every channel.  The
+      first channel to send one in a call to GCS::update_send() packs
+      it, the others send the packed copy, each with its own sequence
+      number and signature
+     */
+    template <typename T>
+    struct cached_payload {
+        uint32_t send_tick;
+        T packet;
+        // true if the payload was packed earlier in this update_send()
+        bool valid() const;
+    };
+    struct message_cache {
+        cached_payload<mavlink_attitude_t> attitude;
+        cached_payload<mavlink_global_position_int_t> global_position_int;
+        Location global_position_loc;
+        cached_payload<mavlink_sys_status_t> sys_status;
+    };
+    static struct message_cache _message_cache;
+    void pack_sys_status(mavlink_sys_status_t &packet) const;
+    void ftp_io_timer(void);
+    void ftp_handle_request(struct ftp_request &req);
+    void ftp_close_session(void);
+    uint8_t ftp_open_file(const char *path, bool writable, bool truncate);
+    uint8_t ftp_remove_file(const char *path);
+    uint8_t ftp_read_file(struct ftp_op &op);
+    uint8_t ftp_start_burst(const struct ftp_request &req);
+    uint8_t ftp_write_file(struct ftp_op &op);
+    uint8_t ftp_list_directory(struct ftp_op &op, const char *path);
+    void ftp_read_ahead(void);
+    bool ftp_pack_params(void);
+    bool ftp_dma_stats(void);
+    bool ftp_uart_stats(void);
+    void send_ftp_replies(void);
+
     void send_distance_sensor(const AP_RangeFinder_Backend *sensor, const uint8_t instance) const;
 
     virtual bool handle_guided_request(AP_Mission::Mission_Command &cmd) = 0;
     virtual void handle_change_alt_request(AP_Mission::Mission_Command &cmd) = 0;
     void handle_common_mission_message(mavlink_message_t *msg);
 
+#if GCS_EXTERNAL_NAV_ENABLED
     void handle_vicon_position_estimate(mavlink_message_t *msg);
     void handle_vision_position_estimate(mavlink_message_t *msg);
     void handle_global_vision_position_estimate(mavlink_message_t *msg);
     void handle_att_pos_mocap(mavlink_message_t *msg);
-    void handle_common_vision_position_estimate_data(const uint64_t usec,
+    void handle_common_vision_position_estimate_data(const mavlink_message_t *msg,
+                                                     const uint64_t usec,
                                                      const float x,
                                                      const float y,
                                                      const float z,
@@ -656,14 +850,19 @@ private:
                                            const float roll,
                                            const float pitch,
                                            const float yaw);
+#endif
 
     void lock_channel(mavlink_channel_t chan, bool lock);
 
     /*
       correct an offboard timestamp in microseconds to a local time
-      since boot in milliseconds
+      since boot in milliseconds. If msg is given and its sender has
+      answered our timesync requests the sender's clock offset is
+      used, which is exact to half the round trip time rather than
+      converging on the lowest lag seen
      */
     uint32_t correct_offboard_timestamp_usec_to_ms(uint64_t offboard_usec, uint16_t payload_size);
+    uint32_t correct_offboard_timestamp_usec_to_ms(const mavlink_message_t *msg, uint64_t offboard_usec, uint16_t payload_size);
     
     mavlink_signing_t signing;
     static mavlink_signing_streams_t signing_streams;
@@ -756,11 +955,19 @@ public:
 
     void update_send();
     void update_receive();
+    // send high rate subscriptions; called from the vehicle's fast
+    // loop after the AHRS update
+    void update_high_rate_send();
     virtual void setup_uarts(AP_SerialManager &serial_manager);
 
     bool out_of_time() const {
         return _out_of_time;
     }
+
+    // incremented on each call to update_send(), never zero
+    uint32_t send_tick() const {
+        return _send_tick;
+    }
     void set_out_of_time(bool val) {
         _out_of_time = val;
     }
@@ -803,9 +1010,23 @@ private:
 
     struct statustext_t {
         uint8_t                 bitmask;
+        uint16_t                repeats;    // identical messages suppressed before this one
         mavlink_statustext_t    msg;
     };
 
+    // recently queued distinct messages, for rate limiting repeats
+    struct statustext_recent_t {
+        uint32_t    crc;
+        uint8_t     bitmask;
+        uint32_t    queued_ms;
+        uint16_t    suppressed;
+    };
+    static const uint8_t _statustext_recent_count = 4;
+    statustext_recent_t _statustext_recent[_statustext_recent_count];
+    uint8_t _statustext_recent_next;
+    bool statustext_is_repeat(const statustext_t &statustext, uint16_t &repeats);
+    void send_queued_statustext(statustext_t &statustext);
+
 #if HAL_CPU_CLASS <= HAL_CPU_CLASS_150 || CONFIG_HAL_BOARD == HAL_BOARD_SITL
     static const uint8_t _status_capacity = 5;
 #else
@@ -822,6 +1043,8 @@ private:
     // true if we are running short on time in our main loop
     bool _out_of_time;
 
+    uint32_t _send_tick = 1;
+
     // handle passthru between two UARTs
     struct {
         bool enabled;
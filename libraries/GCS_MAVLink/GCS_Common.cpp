@@ -30,8 +30,10 @@
 #include <AP_Scheduler/AP_Scheduler.h>
 #include <AP_Mount/AP_Mount.h>
 #include <AP_Common/AP_FWVersion.h>
+#include <AP_Math/crc.h>
 #include <AP_VisualOdom/AP_VisualOdom.h>
 #include <AP_OpticalFlow/OpticalFlow.h>
+#include <AP_Scripting/AP_Scripting.h>
 
 #include "GCS.h"
 
@@ -63,6 +65,7 @@ uint32_t GCS_MAVLINK::last_radio_status_remrssi_ms;
 uint8_t GCS_MAVLINK::mavlink_active = 0;
 uint8_t GCS_MAVLINK::chan_is_streaming = 0;
 uint32_t GCS_MAVLINK::reserve_param_space_start_ms;
+struct GCS_MAVLINK::message_cache GCS_MAVLINK::_message_cache;
 
 // private channels are ones used for point-to-point protocols, and
 // don't get broadcasts or fwded packets
@@ -155,7 +158,12 @@ GCS_MAVLINK::setup_uart(const AP_SerialManager& serial_manager, AP_SerialManager
         return;
     }
     
-    if (mavlink_protocol == AP_SerialManager::SerialProtocol_MAVLink2) {
+#if GCS_HIGH_RATE_ENABLED
+    high_rate_enabled = (mavlink_protocol == AP_SerialManager::SerialProtocol_MAVLinkHighRate);
+#endif
+
+    if (mavlink_protocol == AP_SerialManager::SerialProtocol_MAVLink2 ||
+        mavlink_protocol == AP_SerialManager::SerialProtocol_MAVLinkHighRate) {
         // load signing key
         load_signing_key();
 
@@ -178,20 +186,41 @@ GCS_MAVLINK::setup_uart(const AP_SerialManager& serial_manager, AP_SerialManager
 
 /**
  * @brief Send the next pending waypoint, called from deferred message
- * handling code
+ * handling code.  When pipelining, request each item of the window
+ * which has not been requested yet, as far as space allows
  */
 void
 GCS_MAVLINK::queued_mission_request_send()
 {
-    if (initialised &&
-        waypoint_receiving &&
-        waypoint_request_i <= waypoint_request_last) {
+    if (!initialised ||
+        !waypoint_receiving ||
+        waypoint_request_i > waypoint_request_last) {
+        return;
+    }
+
+    if (!waypoint_pipelined) {
         mavlink_msg_mission_request_send(
             chan,
             waypoint_dest_sysid,
             waypoint_dest_compid,
             waypoint_request_i,
             MAV_MISSION_TYPE_MISSION);
+        return;
+    }
+
+    if (waypoint_request_sent < waypoint_request_i) {
+        waypoint_request_sent = waypoint_request_i;
+    }
+    const uint16_t window_end = MIN(uint32_t(waypoint_request_i) + GCS_MISSION_UPLOAD_WINDOW, waypoint_request_last);
+    while (waypoint_request_sent < window_end &&
+           HAVE_PAYLOAD_SPACE(chan, MISSION_REQUEST)) {
+        mavlink_msg_mission_request_send(
+            chan,
+            waypoint_dest_sysid,
+            waypoint_dest_compid,
+            waypoint_request_sent,
+            MAV_MISSION_TYPE_MISSION);
+        waypoint_request_sent++;
     }
 }
 
@@ -610,6 +639,11 @@ void GCS_MAVLINK::handle_mission_count(AP_Mission &mission, mavlink_message_t *m
 
     waypoint_dest_sysid = msg->sysid;       // record system id of GCS who wants to upload the mission
     waypoint_dest_compid = msg->compid;     // record component id of GCS who wants to upload the mission
+
+    waypoint_pipelined = mission.pipelined_upload_enabled();
+    waypoint_request_sent = 0;
+    waypoint_upload_start_ms = waypoint_timelast_receive;
+    waypoint_upload_count = packet.count;
 }
 
 /*
@@ -659,6 +693,11 @@ void GCS_MAVLINK::handle_mission_write_partial_list(AP_Mission &mission, mavlink
 
     waypoint_dest_sysid = msg->sysid;       // record system id of GCS who wants to partially update the mission
     waypoint_dest_compid = msg->compid;     // record component id of GCS who wants to partially update the mission
+
+    waypoint_pipelined = mission.pipelined_upload_enabled();
+    waypoint_request_sent = packet.start_index;
+    waypoint_upload_start_ms = waypoint_timelast_receive;
+    waypoint_upload_count = packet.end_index - packet.start_index;
 }
 
 
@@ -728,6 +767,9 @@ void GCS_MAVLINK::handle_radio_status(mavlink_message_t *msg, bool log_radio)
         stream_slowdown_ms -= 20;
     }
 
+    // remote logging over this link shares the radio's buffer too
+    AP::logger().handle_radio_status(chan, packet.txbuf);
+
 #if GCS_DEBUG_SEND_MESSAGE_TIMINGS
     if (stream_slowdown_ms > max_slowdown_ms) {
         max_slowdown_ms = stream_slowdown_ms;
@@ -812,6 +854,12 @@ bool GCS_MAVLINK::handle_mission_item(mavlink_message_t *msg, AP_Mission &missio
 
     // check if this is the requested waypoint
     if (seq != waypoint_request_i) {
+        if (waypoint_pipelined && seq < waypoint_request_sent) {
+            // a repeat of an item we already have, or one which was
+            // requested ahead and arrived after an item was lost.  The
+            // lost item is requested again when the request times out
+            return false;
+        }
         result = MAV_MISSION_INVALID_SEQUENCE;
         goto mission_ack;
     }
@@ -860,6 +908,10 @@ bool GCS_MAVLINK::handle_mission_item(mavlink_message_t *msg, AP_Mission &missio
             MAV_MISSION_TYPE_MISSION);
         
         send_text(MAV_SEVERITY_INFO,"Flight plan received");
+        const uint32_t upload_ms = MAX(AP_HAL::millis() - waypoint_upload_start_ms, 1U);
+        send_text(MAV_SEVERITY_DEBUG, "Mission upload: %u items at %.1f items/s",
+                  (unsigned)waypoint_upload_count,
+                  (double)(waypoint_upload_count * 1000.0f / upload_ms));
         waypoint_receiving = false;
         mission_is_complete = true;
         // XXX ignores waypoint radius for individual waypoints, can
@@ -1041,6 +1093,11 @@ void GCS_MAVLINK::find_next_bucket_to_send()
     // all done sending this bucket... find another bucket...
     sending_bucket_id = no_bucket_to_send;
     uint16_t ms_before_send_next_bucket_to_send = UINT16_MAX;
+    // when the link can't keep up several buckets are overdue.  Take
+    // the one furthest behind for its interval, so every stream slows
+    // in proportion rather than the first bucket starving the rest
+    uint16_t overdue_ms = 0;
+    uint16_t overdue_interval = 1;
     for (uint8_t i=0; i<ARRAY_SIZE(deferred_message_bucket); i++) {
         if (deferred_message_bucket[i].ap_message_ids.count() == 0) {
             // no entries
@@ -1048,13 +1105,19 @@ void GCS_MAVLINK::find_next_bucket_to_send()
         }
         const uint16_t interval = get_reschedule_interval_ms(deferred_message_bucket[i]);
         const uint16_t ms_since_last_sent = now16_ms - deferred_message_bucket[i].last_sent_ms;
-        uint16_t ms_before_send_this_bucket;
         if (ms_since_last_sent > interval) {
             // should already have sent this bucket!
-            ms_before_send_this_bucket = 0;
-        } else {
-            ms_before_send_this_bucket = interval - ms_since_last_sent;
+            const uint16_t late_ms = ms_since_last_sent - interval;
+            if (ms_before_send_next_bucket_to_send != 0 ||
+                uint32_t(late_ms) * overdue_interval > uint32_t(overdue_ms) * interval) {
+                sending_bucket_id = i;
+                ms_before_send_next_bucket_to_send = 0;
+                overdue_ms = late_ms;
+                overdue_interval = MAX(interval, 1);
+            }
+            continue;
         }
+        const uint16_t ms_before_send_this_bucket = interval - ms_since_last_sent;
         if (ms_before_send_this_bucket < ms_before_send_next_bucket_to_send) {
             sending_bucket_id = i;
             ms_before_send_next_bucket_to_send = ms_before_send_this_bucket;
@@ -1098,9 +1161,107 @@ ap_message GCS_MAVLINK::next_deferred_bucket_message_to_send()
         find_next_bucket_to_send();
         return no_message_to_send;
     }
+
+    // send the most important messages in the bucket first, so they
+    // get the space there is
+    for (uint8_t i=next; i<MSG_LAST; i++) {
+        if (bucket_message_ids_to_send.get(i) &&
+            ap_message_priority((ap_message)i) == MESSAGE_PRIORITY_HIGH) {
+            return (ap_message)i;
+        }
+    }
     return (ap_message)next;
 }
 
+/*
+  priority of a stream message when the link is congested.  Anything
+  not listed here is MESSAGE_PRIORITY_NORMAL
+ */
+enum GCS_MAVLINK::message_priority GCS_MAVLINK::ap_message_priority(const ap_message id)
+{
+    switch (id) {
+    case MSG_SYS_STATUS:
+    case MSG_EXTENDED_SYS_STATE:
+    case MSG_LOCATION:
+    case MSG_GPS_RAW:
+    case MSG_CURRENT_WAYPOINT:
+    case MSG_MISSION_ITEM_REACHED:
+    case MSG_HOME:
+    case MSG_FENCE_STATUS:
+    case MSG_BATTERY_STATUS:
+    case MSG_EKF_STATUS_REPORT:
+        return MESSAGE_PRIORITY_HIGH;
+    case MSG_RAW_IMU:
+    case MSG_SCALED_IMU:
+    case MSG_SCALED_IMU2:
+    case MSG_SCALED_IMU3:
+    case MSG_SCALED_PRESSURE:
+    case MSG_SCALED_PRESSURE2:
+    case MSG_SCALED_PRESSURE3:
+    case MSG_SENSOR_OFFSETS:
+    case MSG_SERVO_OUTPUT_RAW:
+    case MSG_RADIO_IN:
+    case MSG_MEMINFO:
+    case MSG_HWSTATUS:
+    case MSG_SIMSTATE:
+    case MSG_AHRS2:
+    case MSG_AHRS3:
+    case MSG_PID_TUNING:
+    case MSG_VIBRATION:
+    case MSG_RPM:
+    case MSG_ESC_TELEMETRY:
+    case MSG_NAMED_FLOAT:
+        return MESSAGE_PRIORITY_LOW;
+    default:
+        return MESSAGE_PRIORITY_NORMAL;
+    }
+}
+
+/*
+  return true if the bucket being sent is more than one interval
+  behind, meaning the link can't keep up with it
+ */
+bool GCS_MAVLINK::sending_bucket_behind() const
+{
+    const deferred_message_bucket_t &bucket = deferred_message_bucket[sending_bucket_id];
+    const uint16_t ms_since_last_sent = AP_HAL::millis16() - bucket.last_sent_ms;
+    return ms_since_last_sent >= 2 * get_reschedule_interval_ms(bucket);
+}
+
+void GCS_MAVLINK::bucket_message_done(const ap_message id)
+{
+    bucket_message_ids_to_send.clear(id);
+    if (bucket_message_ids_to_send.count() != 0) {
+        return;
+    }
+    // we sent everything in the bucket.  Reschedule it.
+    deferred_message_bucket_t &bucket = deferred_message_bucket[sending_bucket_id];
+    const uint16_t interval = get_reschedule_interval_ms(bucket);
+    bucket.last_sent_ms += interval;
+    if (uint16_t(AP_HAL::millis16() - bucket.last_sent_ms) >= interval) {
+        // still behind; skip the sends we missed rather than
+        // sending them back to back
+        bucket.last_sent_ms = AP_HAL::millis16();
+    }
+    find_next_bucket_to_send();
+}
+
+/*
+  number of stream messages per second that have been asked for
+ */
+uint16_t GCS_MAVLINK::stream_messages_per_second() const
+{
+    uint32_t ret = 0;
+    for (uint8_t i=0; i<ARRAY_SIZE(deferred_message_bucket); i++) {
+        const deferred_message_bucket_t &bucket = deferred_message_bucket[i];
+        if (bucket.interval_ms == 0) {
+            continue;
+        }
+        ret += bucket.ap_message_ids.count() * 1000U / bucket.interval_ms;
+    }
+    return MIN(ret, UINT16_MAX);
+}
+
 // call try_send_message if appropriate.  Incorporates debug code to
 // record how long it takes to send a message.  try_send_message is
 // expected to be overridden, not this function.
@@ -1254,16 +1415,19 @@ void GCS_MAVLINK::update_send()
 
         ap_message next = next_deferred_bucket_message_to_send();
         if (next != no_message_to_send) {
+            if (ap_message_priority(next) == MESSAGE_PRIORITY_LOW &&
+                sending_bucket_behind()) {
+                // the link isn't keeping up; drop this one this time
+                // around to leave the space for more important messages
+                stream_stats.dropped++;
+                bucket_message_done(next);
+                continue;
+            }
             if (!do_try_send_message(next)) {
                 break;
             }
-            bucket_message_ids_to_send.clear(next);
-            if (bucket_message_ids_to_send.count() == 0) {
-                // we sent everything in the bucket.  Reschedule it.
-                deferred_message_bucket[sending_bucket_id].last_sent_ms +=
-                    get_reschedule_interval_ms(deferred_message_bucket[sending_bucket_id]);
-                find_next_bucket_to_send();
-            }
+            stream_stats.sent++;
+            bucket_message_done(next);
 #if GCS_DEBUG_SEND_MESSAGE_TIMINGS
                 const uint32_t stop = AP_HAL::micros();
                 const uint32_t delta = stop - retry_deferred_body_start;
@@ -1462,6 +1626,12 @@ void GCS_MAVLINK::packetReceived(const mavlink_status_t &status,
         // e.g. enforce-sysid says we shouldn't look at this packet
         return;
     }
+#ifdef ENABLE_SCRIPTING
+    AP_Scripting *scripting = AP::scripting();
+    if (scripting != nullptr) {
+        scripting->handle_message(msg.msgid);
+    }
+#endif
     handleMessage(&msg);
 }
 
@@ -1478,52 +1648,58 @@ GCS_MAVLINK::update_receive(uint32_t max_time_us)
 
     status.packet_rx_drop_count = 0;
 
-    // process received bytes
-    uint16_t nbytes = comm_get_available(chan);
-    for (uint16_t i=0; i<nbytes; i++)
-    {
-        const uint8_t c = (uint8_t)_port->read();
-        const uint32_t protocol_timeout = 4000;
-        
-        if (alternative.handler &&
-            now_ms - alternative.last_mavlink_ms > protocol_timeout) {
-            /*
-              we have an alternative protocol handler installed and we
-              haven't parsed a MAVLink packet for 4 seconds. Try
-              parsing using alternative handler
-             */
-            if (alternative.handler(c, mavlink_comm_port[chan])) {
-                alternative.last_alternate_ms = now_ms;
-                gcs_alternative_active[chan] = true;
-            }
-            
-            /*
-              we may also try parsing as MAVLink if we haven't had a
-              successful parse on the alternative protocol for 4s
-             */
-            if (now_ms - alternative.last_alternate_ms <= protocol_timeout) {
-                continue;
-            }
+    // process received bytes, taking them from the port a block at a
+    // time.  The time limit is checked per block, as bytes taken from
+    // the port have to be parsed
+    const uint16_t nbytes = comm_get_available(chan);
+    uint16_t nparsed = 0;
+    uint8_t buf[64];
+    bool out_of_time = false;
+    while (nparsed < nbytes && !out_of_time) {
+        const ssize_t nread = _port->read(buf, MIN(nbytes - nparsed, sizeof(buf)));
+        if (nread <= 0) {
+            break;
         }
+        nparsed += nread;
+        for (uint8_t i=0; i<nread; i++) {
+            const uint8_t c = buf[i];
+            const uint32_t protocol_timeout = 4000;
+
+            if (alternative.handler &&
+                now_ms - alternative.last_mavlink_ms > protocol_timeout) {
+                /*
+                  we have an alternative protocol handler installed and we
+                  haven't parsed a MAVLink packet for 4 seconds. Try
+                  parsing using alternative handler
+                 */
+                if (alternative.handler(c, mavlink_comm_port[chan])) {
+                    alternative.last_alternate_ms = now_ms;
+                    gcs_alternative_active[chan] = true;
+                }
 
-        bool parsed_packet = false;
-
-        // Try to get a new message
-        if (mavlink_parse_char(chan, c, &msg, &status)) {
-            hal.util->perf_begin(_perf_packet);
-            packetReceived(status, msg);
-            hal.util->perf_end(_perf_packet);
-            parsed_packet = true;
-            gcs_alternative_active[chan] = false;
-            alternative.last_mavlink_ms = now_ms;
-        }
+                /*
+                  we may also try parsing as MAVLink if we haven't had a
+                  successful parse on the alternative protocol for 4s
+                 */
+                if (now_ms - alternative.last_alternate_ms <= protocol_timeout) {
+                    continue;
+                }
+            }
 
-        if (parsed_packet || i % 100 == 0) {
-            // make sure we don't spend too much time parsing mavlink messages
-            if (AP_HAL::micros() - tstart_us > max_time_us) {
-                break;
+            // Try to get a new message
+            if (mavlink_parse_char(chan, c, &msg, &status)) {
+                hal.util->perf_begin(_perf_packet);
+                packetReceived(status, msg);
+                hal.util->perf_end(_perf_packet);
+                gcs_alternative_active[chan] = false;
+                alternative.last_mavlink_ms = now_ms;
             }
         }
+        comm_signing_receive_done(chan);
+        // make sure we don't spend too much time parsing mavlink messages
+        if (AP_HAL::micros() - tstart_us > max_time_us) {
+            out_of_time = true;
+        }
     }
 
     const uint32_t tnow = AP_HAL::millis();
@@ -1621,6 +1797,8 @@ GCS_MAVLINK::update_receive(uint32_t max_time_us)
             gcs().send_text(MAV_SEVERITY_WARNING, "Mission upload timeout");
         } else if (tnow - waypoint_timelast_request > wp_recv_time) {
             waypoint_timelast_request = tnow;
+            // request the whole window again, from the item we are waiting for
+            waypoint_request_sent = waypoint_request_i;
             send_message(MSG_NEXT_MISSION_REQUEST);
         }
     }
@@ -1638,16 +1816,27 @@ void GCS_MAVLINK::log_mavlink_stats()
         return;
     }
 
+    uint16_t signing_count;
+    uint32_t signing_time_us;
+    comm_signing_stats(chan, signing_count, signing_time_us);
+
     const struct log_MAV pkt = {
     LOG_PACKET_HEADER_INIT(LOG_MAV_MSG),
     time_us                : AP_HAL::micros64(),
     chan                   : (uint8_t)chan,
     packet_tx_count        : send_packet_count,
     packet_rx_success_count: status->packet_rx_success_count,
-    packet_rx_drop_count   : status->packet_rx_drop_count
+    packet_rx_drop_count   : status->packet_rx_drop_count,
+    stream_requested       : stream_messages_per_second(),
+    stream_sent            : stream_stats.sent,
+    stream_dropped         : stream_stats.dropped,
+    signing_count          : signing_count,
+    signing_time_us        : signing_time_us,
     };
 
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
+    stream_stats.sent = 0;
+    stream_stats.dropped = 0;
 }
 
 /*
@@ -1727,6 +1916,102 @@ void GCS_MAVLINK::send_radio_in()
         receiver_rssi);        
 }
 
+/*
+  time of the IMU sample the current AHRS output comes from, which
+  lets a companion computer line our data up with its own sensors
+ */
+uint64_t GCS_MAVLINK::ins_sample_time_us()
+{
+    const uint32_t age_us = AP_HAL::micros() - AP::ins().get_last_update_usec();
+    return AP_HAL::micros64() - age_us;
+}
+
+#if GCS_HIGH_RATE_ENABLED
+// messages cheap enough to send from the fast loop
+bool GCS_MAVLINK::high_rate_capable(const ap_message id)
+{
+    switch (id) {
+    case MSG_ATTITUDE:
+    case MSG_LOCATION:
+    case MSG_LOCAL_POSITION:
+    case MSG_RAW_IMU:
+    case MSG_SCALED_IMU:
+    case MSG_SCALED_IMU2:
+    case MSG_SCALED_IMU3:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool GCS_MAVLINK::set_high_rate_interval(const ap_message id, uint32_t interval_us)
+{
+    uint8_t i;
+    for (i=0; i<num_high_rate_subscriptions; i++) {
+        if (high_rate_subscriptions[i].id == id) {
+            break;
+        }
+    }
+    if (interval_us == 0) {
+        if (i < num_high_rate_subscriptions) {
+            high_rate_subscriptions[i] = high_rate_subscriptions[--num_high_rate_subscriptions];
+        }
+        return true;
+    }
+    if (i == num_high_rate_subscriptions) {
+        if (num_high_rate_subscriptions == HIGH_RATE_MAX_SUBSCRIPTIONS) {
+            return false;
+        }
+        num_high_rate_subscriptions++;
+    }
+
+    // no faster than the main loop
+    interval_us = MAX(interval_us, AP::scheduler().get_loop_period_us());
+
+    struct high_rate_subscription &sub = high_rate_subscriptions[i];
+    sub.id = id;
+    sub.interval_us = interval_us;
+    sub.next_send_us = AP::ins().get_last_update_usec();
+    return true;
+}
+
+uint32_t GCS_MAVLINK::get_high_rate_interval(const ap_message id) const
+{
+    for (uint8_t i=0; i<num_high_rate_subscriptions; i++) {
+        if (high_rate_subscriptions[i].id == id) {
+            return high_rate_subscriptions[i].interval_us;
+        }
+    }
+    return 0;
+}
+
+/*
+  send the high rate subscriptions due at IMU sample time sample_us.
+  Scheduling on sample times rather than on when this is called keeps
+  the spacing of messages as even as the IMU samples
+ */
+void GCS_MAVLINK::update_high_rate_send(const uint32_t sample_us)
+{
+    // a message is sent on the sample nearest its due time
+    const int32_t tolerance_us = AP::scheduler().get_loop_period_us() / 2;
+    for (uint8_t i=0; i<num_high_rate_subscriptions; i++) {
+        struct high_rate_subscription &sub = high_rate_subscriptions[i];
+        const int32_t late_us = sample_us - sub.next_send_us;
+        if (late_us < -tolerance_us) {
+            continue;
+        }
+        // if there is no space the message is dropped, as the next
+        // sample will have a fresher copy
+        try_send_message(sub.id);
+        sub.next_send_us += sub.interval_us;
+        if (late_us > (int32_t)sub.interval_us) {
+            // more than an interval behind, resync rather than burst
+            sub.next_send_us = sample_us + sub.interval_us;
+        }
+    }
+}
+#endif
+
 void GCS_MAVLINK::send_raw_imu()
 {
     const AP_InertialSensor &ins = AP::ins();
@@ -1743,7 +2028,7 @@ void GCS_MAVLINK::send_raw_imu()
 
     mavlink_msg_raw_imu_send(
         chan,
-        AP_HAL::micros(),
+        ins_sample_time_us(),
         accel.x * 1000.0f / GRAVITY_MSS,
         accel.y * 1000.0f / GRAVITY_MSS,
         accel.z * 1000.0f / GRAVITY_MSS,
@@ -1781,7 +2066,7 @@ void GCS_MAVLINK::send_scaled_imu(uint8_t instance, void (*send_fn)(mavlink_chan
     }
     send_fn(
         chan,
-        AP_HAL::millis(),
+        ins_sample_time_us() / 1000,
         accel.x * 1000.0f / GRAVITY_MSS,
         accel.y * 1000.0f / GRAVITY_MSS,
         accel.z * 1000.0f / GRAVITY_MSS,
@@ -1925,16 +2210,108 @@ void GCS::send_statustext(MAV_SEVERITY severity, uint8_t dest_bitmask, const cha
     strncpy(statustext.msg.text, text, sizeof(statustext.msg.text));
 
     WITH_SEMAPHORE(_statustext_sem);
-    
-    // The force push will ensure comm links do not block other comm links forever if they fail.
-    // If we push to a full buffer then we overwrite the oldest entry, effectively removing the
-    // block but not until the buffer fills up.
-    _statustext_queue.push_force(statustext);
+
+    if (statustext_is_repeat(statustext, statustext.repeats)) {
+        return;
+    }
+
+    // Overwriting a full buffer ensures comm links do not block other comm links forever if
+    // they fail. The oldest of the least important messages is dropped, unless the new
+    // message is less important still
+    if (_statustext_queue.space() == 0) {
+        uint8_t drop_idx = 0;
+        uint8_t drop_severity = 0;
+        for (uint8_t idx=0; idx<_statustext_queue.available(); idx++) {
+            const uint8_t queued_severity = _statustext_queue[idx]->msg.severity;
+            if (idx == 0 || queued_severity > drop_severity) {
+                drop_idx = idx;
+                drop_severity = queued_severity;
+            }
+        }
+        if (severity > drop_severity) {
+            return;
+        }
+        _statustext_queue.remove(drop_idx);
+    }
+    _statustext_queue.push(statustext);
 
     // try and send immediately if possible
     service_statustext();
 }
 
+/*
+    return true if the same message went to the same ports less than
+    GCS_STATUSTEXT_REPEAT_MS ago, counting it. Otherwise return the
+    number of repeats suppressed since it was last queued
+ */
+bool GCS::statustext_is_repeat(const statustext_t &statustext, uint16_t &repeats)
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    const uint32_t crc = crc_crc32(statustext.msg.severity,
+                                   (const uint8_t *)statustext.msg.text,
+                                   strnlen(statustext.msg.text, sizeof(statustext.msg.text)));
+
+    statustext_recent_t *recent = nullptr;
+    for (uint8_t i=0; i<_statustext_recent_count; i++) {
+        if (_statustext_recent[i].crc == crc &&
+            _statustext_recent[i].bitmask == statustext.bitmask) {
+            recent = &_statustext_recent[i];
+            break;
+        }
+    }
+    if (recent == nullptr) {
+        // replace the oldest
+        recent = &_statustext_recent[_statustext_recent_next];
+        _statustext_recent_next = (_statustext_recent_next + 1) % _statustext_recent_count;
+        recent->crc = crc;
+        recent->bitmask = statustext.bitmask;
+        recent->suppressed = 0;
+    } else if (now_ms - recent->queued_ms < GCS_STATUSTEXT_REPEAT_MS) {
+        if (recent->suppressed < UINT16_MAX) {
+            recent->suppressed++;
+        }
+        return true;
+    }
+
+    repeats = recent->suppressed;
+    recent->suppressed = 0;
+    recent->queued_ms = now_ms;
+    return false;
+}
+
+/*
+    send a queued statustext to each port in its bitmask with room for
+    it, with the count of suppressed repeats appended
+ */
+void GCS::send_queued_statustext(statustext_t &statustext)
+{
+    char text[sizeof(statustext.msg.text)] {};
+    const char *send_text = statustext.msg.text;
+    if (statustext.repeats != 0) {
+        char suffix[12];
+        const uint8_t suffix_len = hal.util->snprintf(suffix, sizeof(suffix), " (x%u)", (unsigned)statustext.repeats+1);
+        const uint8_t len = MIN(strnlen(statustext.msg.text, sizeof(text)), sizeof(text) - suffix_len);
+        memcpy(text, statustext.msg.text, len);
+        memcpy(&text[len], suffix, suffix_len);
+        send_text = text;
+    }
+
+    // try and send to all active mavlink ports listed in the statustext.bitmask
+    for (uint8_t i=0; i<MAVLINK_COMM_NUM_BUFFERS; i++) {
+        uint8_t chan_bit = (1U<<i);
+        // logical AND (&) to mask them together
+        if (statustext.bitmask & chan_bit) {
+            // something is queued on a port and that's the port index we're looped at
+            mavlink_channel_t chan_index = (mavlink_channel_t)(MAVLINK_COMM_0+i);
+            if (HAVE_PAYLOAD_SPACE(chan_index, STATUSTEXT)) {
+                // we have space so send then clear that channel bit on the mask
+                mavlink_msg_statustext_send(chan_index, statustext.msg.severity, send_text);
+                statustext.bitmask &= ~chan_bit;
+            }
+        }
+    }
+}
+
 /*
     send a statustext message to specific MAVLink connections in a bitmask
  */
@@ -1953,27 +2330,23 @@ void GCS::service_statustext(void)
         return;
     }
 
+    // warnings and worse are sent first, so they get what room there is on a busy port
+    for (uint8_t pass=0; pass<2; pass++) {
+        for (uint8_t idx=0; idx<_statustext_queue.available(); idx++) {
+            statustext_t *statustext = _statustext_queue[idx];
+            const bool urgent = statustext->msg.severity <= MAV_SEVERITY_WARNING;
+            if (urgent == (pass == 0)) {
+                send_queued_statustext(*statustext);
+            }
+        }
+    }
+
     for (uint8_t idx=0; idx<_status_capacity; ) {
         statustext_t *statustext = _statustext_queue[idx];
         if (statustext == nullptr) {
             break;
         }
 
-        // try and send to all active mavlink ports listed in the statustext.bitmask
-        for (uint8_t i=0; i<MAVLINK_COMM_NUM_BUFFERS; i++) {
-            uint8_t chan_bit = (1U<<i);
-            // logical AND (&) to mask them together
-            if (statustext->bitmask & chan_bit) {
-                // something is queued on a port and that's the port index we're looped at
-                mavlink_channel_t chan_index = (mavlink_channel_t)(MAVLINK_COMM_0+i);
-                if (HAVE_PAYLOAD_SPACE(chan_index, STATUSTEXT)) {
-                    // we have space so send then clear that channel bit on the mask
-                    mavlink_msg_statustext_send(chan_index, statustext->msg.severity, statustext->msg.text);
-                    statustext->bitmask &= ~chan_bit;
-                }
-            }
-        }
-
         if (statustext->bitmask == 0) {
             _statustext_queue.remove(idx);
         } else {
@@ -1992,8 +2365,30 @@ void GCS::send_message(enum ap_message id)
     }
 }
 
+void GCS::update_high_rate_send()
+{
+#if GCS_HIGH_RATE_ENABLED
+    // the cached payloads from the last update_send() are stale
+    _send_tick++;
+    if (_send_tick == 0) {
+        _send_tick = 1;
+    }
+    const uint32_t sample_us = AP::ins().get_last_update_usec();
+    for (uint8_t i=0; i<num_gcs(); i++) {
+        if (chan(i).initialised && chan(i).num_high_rate_subscriptions != 0) {
+            chan(i).update_high_rate_send(sample_us);
+        }
+    }
+#endif
+}
+
 void GCS::update_send()
 {
+    _send_tick++;
+    if (_send_tick == 0) {
+        // zero marks an empty message cache entry
+        _send_tick = 1;
+    }
     for (uint8_t i=0; i<num_gcs(); i++) {
         if (chan(i).initialised) {
             chan(i).update_send();
@@ -2210,7 +2605,7 @@ void GCS_MAVLINK::send_local_position() const
 
     mavlink_msg_local_position_ned_send(
         chan,
-        AP_HAL::millis(),
+        ins_sample_time_us() / 1000,
         local_position.x,
         local_position.y,
         local_position.z,
@@ -2299,6 +2694,24 @@ MAV_RESULT GCS_MAVLINK::handle_command_set_message_interval(const mavlink_comman
     const uint32_t msg_id = (uint32_t)packet.param1;
     const int32_t interval_us = (int32_t)packet.param2;
 
+#if GCS_HIGH_RATE_ENABLED
+    if (high_rate_enabled) {
+        const ap_message id = mavlink_id_to_ap_message_id(msg_id);
+        if (high_rate_capable(id)) {
+            if (interval_us > 0) {
+                if (!set_high_rate_interval(id, interval_us)) {
+                    return MAV_RESULT_FAILED;
+                }
+                // stop the stream bucket also sending it
+                set_ap_message_interval(id, 0);
+                return MAV_RESULT_ACCEPTED;
+            }
+            // default or stop; the stream buckets take over
+            set_high_rate_interval(id, 0);
+        }
+    }
+#endif
+
     uint16_t interval_ms;
     if (interval_us == 0) {
         // zero is "reset to default rate"
@@ -2374,6 +2787,14 @@ MAV_RESULT GCS_MAVLINK::handle_command_get_message_interval(const mavlink_comman
         return MAV_RESULT_FAILED;
     }
 
+#if GCS_HIGH_RATE_ENABLED
+    const uint32_t high_rate_interval_us = get_high_rate_interval(id);
+    if (high_rate_interval_us != 0) {
+        mavlink_msg_message_interval_send(chan, mavlink_id, high_rate_interval_us);
+        return MAV_RESULT_ACCEPTED;
+    }
+#endif
+
     uint16_t interval_ms = 0;
     if (!get_ap_message_interval(id, interval_ms)) {
         // not streaming this message at the moment...
@@ -2647,6 +3068,7 @@ void GCS_MAVLINK::handle_timesync(mavlink_message_t *msg)
                         msg->sysid,
                         round_trip_time_us*0.001f);
 #endif
+        update_timesync_offset(*msg, tsync, round_trip_time_us);
         AP_Logger *logger = AP_Logger::get_singleton();
         if (logger != nullptr) {
             AP::logger().Write(
@@ -2683,6 +3105,41 @@ void GCS_MAVLINK::handle_timesync(mavlink_message_t *msg)
         );
 }
 
+/*
+  keep the clock offset of a system answering our timesync request,
+  if the round trip was quick enough for it to be accurate
+ */
+void GCS_MAVLINK::update_timesync_offset(const mavlink_message_t &msg, const mavlink_timesync_t &tsync, uint64_t round_trip_time_us)
+{
+    if (round_trip_time_us > GCS_TIMESYNC_MAX_RTT_US) {
+        return;
+    }
+
+    // the answering system's time was tc1 at about the middle of the round trip
+    const int64_t local_us = (tsync.ts1 / 1000) + int64_t(round_trip_time_us / 2);
+    const int64_t offset_us = (tsync.tc1 / 1000) - local_us;
+
+    // use the system's entry, or a free or stale one, or the oldest
+    const uint32_t now_ms = AP_HAL::millis();
+    uint8_t index = 0;
+    for (uint8_t i=0; i<ARRAY_SIZE(_timesync_offset); i++) {
+        if (_timesync_offset[i].last_update_ms != 0 &&
+            _timesync_offset[i].sysid == msg.sysid &&
+            _timesync_offset[i].compid == msg.compid) {
+            index = i;
+            break;
+        }
+        if (now_ms - _timesync_offset[i].last_update_ms > now_ms - _timesync_offset[index].last_update_ms) {
+            index = i;
+        }
+    }
+    _timesync_offset[index].offset_us = offset_us;
+    _timesync_offset[index].round_trip_us = round_trip_time_us;
+    _timesync_offset[index].last_update_ms = MAX(now_ms, 1U);
+    _timesync_offset[index].sysid = msg.sysid;
+    _timesync_offset[index].compid = msg.compid;
+}
+
 /*
  * broadcast a timesync message.  We may get multiple responses to this request.
  */
@@ -2820,12 +3277,12 @@ void GCS_MAVLINK::handle_set_gps_global_origin(const mavlink_message_t *msg)
     set_ekf_origin(ekf_origin);
 }
 
+#if HAL_RCINPUT_WITH_AP_RADIO
 /*
   handle a DATA96 message
  */
 void GCS_MAVLINK::handle_data_packet(mavlink_message_t *msg)
 {
-#if HAL_RCINPUT_WITH_AP_RADIO
     mavlink_data96_t m;
     mavlink_msg_data96_decode(msg, &m);
     switch (m.type) {
@@ -2842,16 +3299,21 @@ void GCS_MAVLINK::handle_data_packet(mavlink_message_t *msg)
         // unknown
         break;
     }
-#endif
 }
+#endif // HAL_RCINPUT_WITH_AP_RADIO
 
+#if GCS_EXTERNAL_NAV_ENABLED
 void GCS_MAVLINK::handle_vision_position_delta(mavlink_message_t *msg)
 {
     AP_VisualOdom *visual_odom = AP::visualodom();
     if (visual_odom == nullptr) {
         return;
     }
-    visual_odom->handle_msg(msg);
+    // correct offboard timestamp to be in local ms since boot
+    const uint32_t timestamp_ms = correct_offboard_timestamp_usec_to_ms(msg,
+                                                                        mavlink_msg_vision_position_delta_get_time_usec(msg),
+                                                                        PAYLOAD_SIZE(chan, VISION_POSITION_DELTA));
+    visual_odom->handle_msg(msg, timestamp_ms);
 }
 
 void GCS_MAVLINK::handle_vision_position_estimate(mavlink_message_t *msg)
@@ -2859,7 +3321,7 @@ void GCS_MAVLINK::handle_vision_position_estimate(mavlink_message_t *msg)
     mavlink_vision_position_estimate_t m;
     mavlink_msg_vision_position_estimate_decode(msg, &m);
 
-    handle_common_vision_position_estimate_data(m.usec, m.x, m.y, m.z, m.roll, m.pitch, m.yaw,
+    handle_common_vision_position_estimate_data(msg, m.usec, m.x, m.y, m.z, m.roll, m.pitch, m.yaw,
                                                 PAYLOAD_SIZE(chan, VISION_POSITION_ESTIMATE));
 }
 
@@ -2868,7 +3330,7 @@ void GCS_MAVLINK::handle_global_vision_position_estimate(mavlink_message_t *msg)
     mavlink_global_vision_position_estimate_t m;
     mavlink_msg_global_vision_position_estimate_decode(msg, &m);
 
-    handle_common_vision_position_estimate_data(m.usec, m.x, m.y, m.z, m.roll, m.pitch, m.yaw,
+    handle_common_vision_position_estimate_data(msg, m.usec, m.x, m.y, m.z, m.roll, m.pitch, m.yaw,
                                                 PAYLOAD_SIZE(chan, GLOBAL_VISION_POSITION_ESTIMATE));
 }
 
@@ -2877,14 +3339,15 @@ void GCS_MAVLINK::handle_vicon_position_estimate(mavlink_message_t *msg)
     mavlink_vicon_position_estimate_t m;
     mavlink_msg_vicon_position_estimate_decode(msg, &m);
 
-    handle_common_vision_position_estimate_data(m.usec, m.x, m.y, m.z, m.roll, m.pitch, m.yaw,
+    handle_common_vision_position_estimate_data(msg, m.usec, m.x, m.y, m.z, m.roll, m.pitch, m.yaw,
                                                 PAYLOAD_SIZE(chan, VICON_POSITION_ESTIMATE));
 }
 
 // there are several messages which all have identical fields in them.
 // This function provides common handling for the data contained in
 // these packets
-void GCS_MAVLINK::handle_common_vision_position_estimate_data(const uint64_t usec,
+void GCS_MAVLINK::handle_common_vision_position_estimate_data(const mavlink_message_t *msg,
+                                                              const uint64_t usec,
                                                               const float x,
                                                               const float y,
                                                               const float z,
@@ -2894,7 +3357,7 @@ void GCS_MAVLINK::handle_common_vision_position_estimate_data(const uint64_t use
                                                               const uint16_t payload_size)
 {
     // correct offboard timestamp to be in local ms since boot
-    uint32_t timestamp_ms = correct_offboard_timestamp_usec_to_ms(usec, payload_size);
+    uint32_t timestamp_ms = correct_offboard_timestamp_usec_to_ms(msg, usec, payload_size);
     
     // sensor assumed to be at 0,0,0 body-frame; need parameters for this?
     // or a new message 
@@ -2957,7 +3420,7 @@ void GCS_MAVLINK::handle_att_pos_mocap(mavlink_message_t *msg)
     const float posErr = 0; // parameter required?
     const float angErr = 0; // parameter required?
     // correct offboard timestamp to be in local ms since boot
-    uint32_t timestamp_ms = correct_offboard_timestamp_usec_to_ms(m.time_usec, PAYLOAD_SIZE(chan, ATT_POS_MOCAP));
+    uint32_t timestamp_ms = correct_offboard_timestamp_usec_to_ms(msg, m.time_usec, PAYLOAD_SIZE(chan, ATT_POS_MOCAP));
     const uint32_t reset_timestamp_ms = 0; // no data available
 
     AP::ahrs().writeExtNavData(sensor_offset,
@@ -2976,6 +3439,7 @@ void GCS_MAVLINK::handle_att_pos_mocap(mavlink_message_t *msg)
 
     log_vision_position_estimate_data(m.time_usec, m.x, m.y, m.z, roll, pitch, yaw);
 }
+#endif // GCS_EXTERNAL_NAV_ENABLED
 
 void GCS_MAVLINK::handle_command_ack(const mavlink_message_t* msg)
 {
@@ -3126,6 +3590,10 @@ void GCS_MAVLINK::handle_common_message(mavlink_message_t *msg)
         handle_serial_control(msg);
         break;
 
+    case MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL:
+        handle_file_transfer_protocol(msg);
+        break;
+
     case MAVLINK_MSG_ID_GPS_RTCM_DATA:
     case MAVLINK_MSG_ID_GPS_INPUT:
     case MAVLINK_MSG_ID_HIL_GPS:
@@ -3161,10 +3629,13 @@ void GCS_MAVLINK::handle_common_message(mavlink_message_t *msg)
         handle_request_data_stream(msg);
         break;
 
+#if HAL_RCINPUT_WITH_AP_RADIO
     case MAVLINK_MSG_ID_DATA96:
         handle_data_packet(msg);
-        break;        
+        break;
+#endif
 
+#if GCS_EXTERNAL_NAV_ENABLED
     case MAVLINK_MSG_ID_VISION_POSITION_DELTA:
         handle_vision_position_delta(msg);
         break;
@@ -3184,6 +3655,7 @@ void GCS_MAVLINK::handle_common_message(mavlink_message_t *msg)
     case MAVLINK_MSG_ID_ATT_POS_MOCAP:
         handle_att_pos_mocap(msg);
         break;
+#endif
 
     case MAVLINK_MSG_ID_SYSTEM_TIME:
         handle_system_time_message(msg);
@@ -3485,9 +3957,37 @@ MAV_RESULT GCS_MAVLINK::handle_command_request_autopilot_capabilities(const mavl
 MAV_RESULT GCS_MAVLINK::handle_command_do_send_banner(const mavlink_command_long_t &packet)
 {
     send_banner();
+    if (is_equal(packet.param1, 1.0f)) {
+        send_boot_report();
+    }
     return MAV_RESULT_ACCEPTED;
 }
 
+/*
+  send the boot timeline and memory use recorded by
+  AP_Logger::note_boot_stage(), followed by the memory free now in
+  total and in each memory region
+ */
+void GCS_MAVLINK::send_boot_report()
+{
+    const AP_Logger *logger = AP_Logger::get_singleton();
+    if (logger != nullptr) {
+        char msg[MAVLINK_MSG_STATUSTEXT_FIELD_TEXT_LEN+1] {};
+        for (uint8_t i = 0; logger->format_boot_stage(i, msg, sizeof(msg)); i++) {
+            send_text(MAV_SEVERITY_INFO, "%s", msg);
+        }
+    }
+    send_text(MAV_SEVERITY_INFO, "Free mem %u dma %u",
+              (unsigned)hal.util->available_memory(),
+              (unsigned)hal.util->available_memory_dma());
+    uint32_t size, available;
+    uint8_t flags;
+    for (uint8_t i = 0; hal.util->memory_region_info(i, size, available, flags); i++) {
+        send_text(MAV_SEVERITY_INFO, "Mem region %u: %u/%u free flags 0x%x",
+                  (unsigned)i, (unsigned)available, (unsigned)size, (unsigned)flags);
+    }
+}
+
 MAV_RESULT GCS_MAVLINK::handle_command_do_set_mode(const mavlink_command_long_t &packet)
 {
     const MAV_MODE _base_mode = (MAV_MODE)packet.param1;
@@ -3917,6 +4417,12 @@ void GCS_MAVLINK::send_rpm() const
         rpm->get_rpm(1));
 }
 
+template <typename T>
+bool GCS_MAVLINK::cached_payload<T>::valid() const
+{
+    return send_tick == gcs().send_tick();
+}
+
 void GCS_MAVLINK::send_sys_status()
 {
     // send extended status only once vehicle has been initialised
@@ -3925,6 +4431,21 @@ void GCS_MAVLINK::send_sys_status()
         return;
     }
 
+    cached_payload<mavlink_sys_status_t> &cache = _message_cache.sys_status;
+    if (!cache.valid()) {
+        pack_sys_status(cache.packet);
+        cache.send_tick = gcs().send_tick();
+    }
+    _mav_finalize_message_chan_send(chan,
+                                    MAVLINK_MSG_ID_SYS_STATUS,
+                                    (const char *)&cache.packet,
+                                    MAVLINK_MSG_ID_SYS_STATUS_MIN_LEN,
+                                    MAVLINK_MSG_ID_SYS_STATUS_LEN,
+                                    MAVLINK_MSG_ID_SYS_STATUS_CRC);
+}
+
+void GCS_MAVLINK::pack_sys_status(mavlink_sys_status_t &packet) const
+{
     int16_t battery_current = -1;
     int8_t battery_remaining = -1;
 
@@ -3941,21 +4462,15 @@ void GCS_MAVLINK::send_sys_status()
 
     gcs().get_sensor_status_flags(control_sensors_present, control_sensors_enabled, control_sensors_health);
 
-    mavlink_msg_sys_status_send(
-        chan,
-        control_sensors_present,
-        control_sensors_enabled,
-        control_sensors_health,
-        static_cast<uint16_t>(AP::scheduler().load_average() * 1000),
-        battery.voltage() * 1000,  // mV
-        battery_current,        // in 10mA units
-        battery_remaining,      // in %
-        0,  // comm drops %,
-        0,  // comm drops in pkts,
-        gcs().sys_status_errors1(),
-        0,  // errors2
-        0,  // errors3
-        0); // errors4
+    memset(&packet, 0, sizeof(packet));
+    packet.onboard_control_sensors_present = control_sensors_present;
+    packet.onboard_control_sensors_enabled = control_sensors_enabled;
+    packet.onboard_control_sensors_health = control_sensors_health;
+    packet.load = static_cast<uint16_t>(AP::scheduler().load_average() * 1000);
+    packet.voltage_battery = battery.voltage() * 1000;  // mV
+    packet.current_battery = battery_current;           // in 10mA units
+    packet.battery_remaining = battery_remaining;       // in %
+    packet.errors_count1 = gcs().sys_status_errors1();
 }
 
 void GCS_MAVLINK::send_extended_sys_state() const
@@ -3964,18 +4479,31 @@ void GCS_MAVLINK::send_extended_sys_state() const
 }
 
 void GCS_MAVLINK::send_attitude() const
+{
+    cached_payload<mavlink_attitude_t> &cache = _message_cache.attitude;
+    if (!cache.valid()) {
+        pack_attitude(cache.packet);
+        cache.send_tick = gcs().send_tick();
+    }
+    _mav_finalize_message_chan_send(chan,
+                                    MAVLINK_MSG_ID_ATTITUDE,
+                                    (const char *)&cache.packet,
+                                    MAVLINK_MSG_ID_ATTITUDE_MIN_LEN,
+                                    MAVLINK_MSG_ID_ATTITUDE_LEN,
+                                    MAVLINK_MSG_ID_ATTITUDE_CRC);
+}
+
+void GCS_MAVLINK::pack_attitude(mavlink_attitude_t &packet) const
 {
     const AP_AHRS &ahrs = AP::ahrs();
     const Vector3f omega = ahrs.get_gyro();
-    mavlink_msg_attitude_send(
-        chan,
-        AP_HAL::millis(),
-        ahrs.roll,
-        ahrs.pitch,
-        ahrs.yaw,
-        omega.x,
-        omega.y,
-        omega.z);
+    packet.time_boot_ms = ins_sample_time_us() / 1000;
+    packet.roll = ahrs.roll;
+    packet.pitch = ahrs.pitch;
+    packet.yaw = ahrs.yaw;
+    packet.rollspeed = omega.x;
+    packet.pitchspeed = omega.y;
+    packet.yawspeed = omega.z;
 }
 
 int32_t GCS_MAVLINK::global_position_int_alt() const {
@@ -3988,6 +4516,24 @@ int32_t GCS_MAVLINK::global_position_int_relative_alt() const {
     return posD;
 }
 void GCS_MAVLINK::send_global_position_int()
+{
+    cached_payload<mavlink_global_position_int_t> &cache = _message_cache.global_position_int;
+    if (!cache.valid()) {
+        pack_global_position_int(cache.packet);
+        _message_cache.global_position_loc = global_position_current_loc;
+        cache.send_tick = gcs().send_tick();
+    } else {
+        global_position_current_loc = _message_cache.global_position_loc;
+    }
+    _mav_finalize_message_chan_send(chan,
+                                    MAVLINK_MSG_ID_GLOBAL_POSITION_INT,
+                                    (const char *)&cache.packet,
+                                    MAVLINK_MSG_ID_GLOBAL_POSITION_INT_MIN_LEN,
+                                    MAVLINK_MSG_ID_GLOBAL_POSITION_INT_LEN,
+                                    MAVLINK_MSG_ID_GLOBAL_POSITION_INT_CRC);
+}
+
+void GCS_MAVLINK::pack_global_position_int(mavlink_global_position_int_t &packet)
 {
     AP_AHRS &ahrs = AP::ahrs();
 
@@ -3998,17 +4544,15 @@ void GCS_MAVLINK::send_global_position_int()
         vel.zero();
     }
 
-    mavlink_msg_global_position_int_send(
-        chan,
-        AP_HAL::millis(),
-        global_position_current_loc.lat, // in 1E7 degrees
-        global_position_current_loc.lng, // in 1E7 degrees
-        global_position_int_alt(),       // millimeters above ground/sea level
-        global_position_int_relative_alt(), // millimeters above home
-        vel.x * 100,                     // X speed cm/s (+ve North)
-        vel.y * 100,                     // Y speed cm/s (+ve East)
-        vel.z * 100,                     // Z speed cm/s (+ve Down)
-        ahrs.yaw_sensor);                // compass heading in 1/100 degree
+    packet.time_boot_ms = AP_HAL::millis();
+    packet.lat = global_position_current_loc.lat;      // in 1E7 degrees
+    packet.lon = global_position_current_loc.lng;      // in 1E7 degrees
+    packet.alt = global_position_int_alt();            // millimeters above ground/sea level
+    packet.relative_alt = global_position_int_relative_alt(); // millimeters above home
+    packet.vx = vel.x * 100;                           // X speed cm/s (+ve North)
+    packet.vy = vel.y * 100;                           // Y speed cm/s (+ve East)
+    packet.vz = vel.z * 100;                           // Z speed cm/s (+ve Down)
+    packet.hdg = ahrs.yaw_sensor;                      // compass heading in 1/100 degree
 }
 
 void GCS_MAVLINK::send_gimbal_report() const
@@ -4458,6 +5002,34 @@ uint32_t GCS_MAVLINK::correct_offboard_timestamp_usec_to_ms(uint64_t offboard_us
     return corrected_us / 1000U;
 }
 
+uint32_t GCS_MAVLINK::correct_offboard_timestamp_usec_to_ms(const mavlink_message_t *msg, uint64_t offboard_usec, uint16_t payload_size)
+{
+    const uint32_t now_ms = AP_HAL::millis();
+    for (uint8_t i=0; i<ARRAY_SIZE(_timesync_offset); i++) {
+        const auto &timesync = _timesync_offset[i];
+        if (timesync.last_update_ms == 0 ||
+            now_ms - timesync.last_update_ms > GCS_TIMESYNC_OFFSET_TIMEOUT_MS ||
+            timesync.sysid != msg->sysid ||
+            timesync.compid != msg->compid) {
+            continue;
+        }
+        uint64_t receive_us = _port->receive_time_constraint_us(payload_size);
+        if (receive_us == 0) {
+            receive_us = AP_HAL::micros64();
+        }
+        const int64_t local_us = int64_t(offboard_usec) - timesync.offset_us;
+        // the message can't have been sent after it was received, to
+        // within the accuracy of the offset, or long before. If it
+        // was the sender's timestamps are in some other time base
+        const int64_t lag_us = int64_t(receive_us) - local_us;
+        if (lag_us >= -int64_t(timesync.round_trip_us) && lag_us <= GCS_TIMESYNC_MAX_LAG_US) {
+            return MIN(uint64_t(local_us), receive_us) / 1000U;
+        }
+        break;
+    }
+    return correct_offboard_timestamp_usec_to_ms(offboard_usec, payload_size);
+}
+
 /*
   return true if we will accept this packet. Used to implement SYSID_ENFORCE
  */
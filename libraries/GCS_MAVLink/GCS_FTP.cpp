@@ -0,0 +1,769 @@
+/*
+  MAVLink FTP handling, serving the parameter list as a packed file,
+  the shared DMA and serial port statistics as text, and the files on
+  the board's filesystem
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+  The packed parameter file is a header of three uint16_t: the magic
+  0x671b, the number of parameters in the file and the total number of
+  parameters. Each parameter follows as:
+
+     uint8_t  type (AP_PARAM_*)
+     uint8_t  common_len | (suffix_len-1)<<4
+     char     name[suffix_len]
+     value    1, 2 or 4 bytes, little endian
+
+  where the name is the first common_len characters of the previous
+  parameter's name followed by suffix_len more.
+
+  @SYS/dma.txt has a line per shared DMA stream in use, with its
+  statistics since boot, for choosing DMA_PRIORITY and DMA_NOSHARE in
+  a board's hwdef.dat
+
+  @SYS/uarts.txt has a line per serial port whose driver keeps
+  statistics, with its throughput, losses, most bytes buffered and
+  write latency since boot
+
+  Any other path is a file or directory on the filesystem, on boards
+  with one. A burst read of a file is read ahead into burst_data by
+  the IO thread, so it goes as fast as the link allows rather than
+  waiting on a read per packet
+ */
+
+#include <AP_HAL/AP_HAL.h>
+#include <AP_Common/Semaphore.h>
+#include "GCS.h"
+
+#define FTP_FILESYSTEM (HAL_OS_POSIX_IO || HAL_OS_FATFS_IO)
+
+#if FTP_FILESYSTEM
+#include <stdio.h>
+#if HAL_OS_POSIX_IO
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#endif
+#endif
+
+extern const AP_HAL::HAL& hal;
+
+#define FTP_PARAM_FILE "@PARAM/param.pck"
+#define FTP_PARAM_MAGIC 0x671b
+#define FTP_DMA_FILE "@SYS/dma.txt"
+#define FTP_UART_FILE "@SYS/uarts.txt"
+
+// close the session if it is idle for this long
+#define FTP_SESSION_TIMEOUT_MS 10000
+
+// size of the buffer a burst read of a file is read ahead into
+#ifndef HAL_FTP_READAHEAD_SIZE
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL || CONFIG_HAL_BOARD == HAL_BOARD_LINUX
+#define HAL_FTP_READAHEAD_SIZE (16*1024UL)
+#else
+#define HAL_FTP_READAHEAD_SIZE (4*1024UL)
+#endif
+#endif
+
+enum ftp_opcode {
+    FTP_OP_NONE            = 0,
+    FTP_OP_TERMINATE       = 1,
+    FTP_OP_RESET           = 2,
+    FTP_OP_LIST_DIRECTORY  = 3,
+    FTP_OP_OPEN_RO         = 4,
+    FTP_OP_READ            = 5,
+    FTP_OP_CREATE_FILE     = 6,
+    FTP_OP_WRITE           = 7,
+    FTP_OP_REMOVE_FILE     = 8,
+    FTP_OP_OPEN_WO         = 11,
+    FTP_OP_BURST_READ      = 15,
+    FTP_OP_ACK             = 128,
+    FTP_OP_NAK             = 129,
+};
+
+enum ftp_error {
+    FTP_ERR_FAIL           = 1,
+    FTP_ERR_INVALID_SESSION = 4,
+    FTP_ERR_NO_SESSIONS    = 5,
+    FTP_ERR_EOF            = 6,
+    FTP_ERR_UNKNOWN_COMMAND = 7,
+    FTP_ERR_FILE_NOT_FOUND = 10,
+};
+
+struct GCS_MAVLINK::ftp_state GCS_MAVLINK::ftp;
+
+// bytes in the packed value of a scalar parameter
+static uint8_t ftp_value_len(enum ap_var_type type)
+{
+    switch (type) {
+    case AP_PARAM_INT8:
+        return 1;
+    case AP_PARAM_INT16:
+        return 2;
+    case AP_PARAM_INT32:
+    case AP_PARAM_FLOAT:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+void GCS_MAVLINK::handle_file_transfer_protocol(const mavlink_message_t *msg)
+{
+    mavlink_file_transfer_protocol_t packet;
+    mavlink_msg_file_transfer_protocol_decode(msg, &packet);
+
+    if ((packet.target_system != 0 && packet.target_system != mavlink_system.sysid) ||
+        (packet.target_component != 0 && packet.target_component != mavlink_system.compid)) {
+        return;
+    }
+    if (ftp.requests.space() == 0) {
+        // the GCS will retry
+        return;
+    }
+
+    struct ftp_request req;
+    req.chan = chan;
+    req.sysid = msg->sysid;
+    req.compid = msg->compid;
+    memcpy(&req.op, packet.payload, sizeof(req.op));
+    ftp.requests.push(req);
+
+    if (!ftp.timer_registered) {
+        ftp.timer_registered = true;
+        hal.scheduler->register_io_process(FUNCTOR_BIND_MEMBER(&GCS_MAVLINK::ftp_io_timer, void));
+    }
+}
+
+/*
+  IO timer callback for FTP requests
+ */
+void GCS_MAVLINK::ftp_io_timer(void)
+{
+    if ((ftp.file != nullptr || ftp.fd != -1) && !ftp.burst.active &&
+        AP_HAL::millis() - ftp.last_request_ms > FTP_SESSION_TIMEOUT_MS) {
+        ftp_close_session();
+    }
+
+    ftp_read_ahead();
+
+    if (ftp.replies.space() == 0) {
+        return;
+    }
+    struct ftp_request req;
+    if (!ftp.requests.pop(req)) {
+        return;
+    }
+    ftp.last_request_ms = AP_HAL::millis();
+    ftp_handle_request(req);
+}
+
+/*
+  turn a request into its reply, in place
+ */
+void GCS_MAVLINK::ftp_handle_request(struct ftp_request &req)
+{
+    struct ftp_op &op = req.op;
+    const uint8_t req_opcode = op.opcode;
+    uint8_t error = 0;
+    bool send = true;
+
+    // the path of requests which take one
+    char path[sizeof(op.data)+1];
+    const uint8_t path_len = MIN(op.size, sizeof(op.data));
+    memcpy(path, op.data, path_len);
+    path[path_len] = 0;
+
+    op.seq_number++;
+    op.req_opcode = req_opcode;
+    op.burst_complete = 0;
+    op.padding = 0;
+
+    switch (req_opcode) {
+    case FTP_OP_NONE:
+        send = false;
+        break;
+
+    case FTP_OP_TERMINATE:
+    case FTP_OP_RESET:
+        ftp_close_session();
+        op.size = 0;
+        break;
+
+    case FTP_OP_LIST_DIRECTORY:
+        error = ftp_list_directory(op, path);
+        break;
+
+    case FTP_OP_OPEN_RO: {
+        if (ftp.file != nullptr || ftp.fd != -1) {
+            // only one session at a time
+            error = FTP_ERR_NO_SESSIONS;
+            break;
+        }
+        if (strcmp(path, FTP_PARAM_FILE) == 0) {
+            error = ftp_pack_params() ? 0 : FTP_ERR_FAIL;
+        } else if (strcmp(path, FTP_DMA_FILE) == 0) {
+            error = ftp_dma_stats() ? 0 : FTP_ERR_FAIL;
+        } else if (strcmp(path, FTP_UART_FILE) == 0) {
+            error = ftp_uart_stats() ? 0 : FTP_ERR_FAIL;
+        } else {
+            error = ftp_open_file(path, false, false);
+        }
+        if (error == 0) {
+            op.session = 0;
+            op.size = sizeof(ftp.file_len);
+            memcpy(op.data, &ftp.file_len, sizeof(ftp.file_len));
+        }
+        break;
+    }
+
+    case FTP_OP_CREATE_FILE:
+    case FTP_OP_OPEN_WO:
+        if (ftp.file != nullptr || ftp.fd != -1) {
+            error = FTP_ERR_NO_SESSIONS;
+            break;
+        }
+        error = ftp_open_file(path, true, req_opcode == FTP_OP_CREATE_FILE);
+        if (error == 0) {
+            op.session = 0;
+            op.size = 0;
+        }
+        break;
+
+    case FTP_OP_WRITE:
+        if (ftp.fd == -1 || !ftp.fd_writable || op.session != 0) {
+            error = FTP_ERR_INVALID_SESSION;
+        } else {
+            error = ftp_write_file(op);
+        }
+        break;
+
+    case FTP_OP_REMOVE_FILE:
+        error = ftp_remove_file(path);
+        op.size = 0;
+        break;
+
+    case FTP_OP_READ:
+    case FTP_OP_BURST_READ: {
+        if ((ftp.file == nullptr && (ftp.fd == -1 || ftp.fd_writable)) || op.session != 0) {
+            error = FTP_ERR_INVALID_SESSION;
+        } else if (op.offset >= ftp.file_len) {
+            error = FTP_ERR_EOF;
+        } else if (ftp.file == nullptr) {
+            // from the filesystem
+            if (req_opcode == FTP_OP_BURST_READ) {
+                error = ftp_start_burst(req);
+                send = (error != 0);
+            } else {
+                error = ftp_read_file(op);
+            }
+        } else if (req_opcode == FTP_OP_BURST_READ) {
+            WITH_SEMAPHORE(ftp.sem);
+            // the data is sent by send_ftp_replies()
+            ftp.burst.active = true;
+            ftp.burst.chan = req.chan;
+            ftp.burst.sysid = req.sysid;
+            ftp.burst.compid = req.compid;
+            ftp.burst.seq_number = op.seq_number;
+            ftp.burst.offset = op.offset;
+            send = false;
+        } else {
+            WITH_SEMAPHORE(ftp.sem);
+            op.size = MIN(ftp.file_len - op.offset, sizeof(op.data));
+            memcpy(op.data, &ftp.file[op.offset], op.size);
+        }
+        break;
+    }
+
+    default:
+        error = FTP_ERR_UNKNOWN_COMMAND;
+        break;
+    }
+
+    if (!send) {
+        return;
+    }
+    if (error != 0) {
+        op.opcode = FTP_OP_NAK;
+        op.size = 1;
+        op.data[0] = error;
+    } else {
+        op.opcode = FTP_OP_ACK;
+    }
+    ftp.replies.push(req);
+}
+
+/*
+  close the open session, whether a generated file or one on the
+  filesystem
+ */
+void GCS_MAVLINK::ftp_close_session(void)
+{
+    int fd;
+    bool fd_writable;
+    ByteBuffer *burst_data;
+    {
+        // the file is closed outside the lock, as it can be slow
+        WITH_SEMAPHORE(ftp.sem);
+        ftp.burst.active = false;
+        free(ftp.file);
+        ftp.file = nullptr;
+        fd = ftp.fd;
+        fd_writable = ftp.fd_writable;
+        burst_data = ftp.burst_data;
+        ftp.fd = -1;
+        ftp.burst_data = nullptr;
+    }
+    delete burst_data;
+#if FTP_FILESYSTEM
+    if (fd != -1) {
+        if (fd_writable) {
+            ::fsync(fd);
+        }
+        ::close(fd);
+    }
+#else
+    (void)fd;
+    (void)fd_writable;
+#endif
+}
+
+#if FTP_FILESYSTEM
+/*
+  open a file on the filesystem as the session
+ */
+uint8_t GCS_MAVLINK::ftp_open_file(const char *path, bool writable, bool truncate)
+{
+    int flags = O_RDONLY;
+    if (writable) {
+        flags = O_WRONLY|O_CREAT|(truncate?O_TRUNC:0);
+    }
+#if HAL_OS_POSIX_IO
+    const int fd = ::open(path, flags|O_CLOEXEC, 0644);
+#else
+    const int fd = ::open(path, flags|O_CLOEXEC);
+#endif
+    if (fd == -1) {
+        return writable ? FTP_ERR_FAIL : FTP_ERR_FILE_NOT_FOUND;
+    }
+    uint32_t file_len = 0;
+    if (!writable) {
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return FTP_ERR_FAIL;
+        }
+        file_len = st.st_size;
+    }
+    WITH_SEMAPHORE(ftp.sem);
+    ftp.fd = fd;
+    ftp.fd_writable = writable;
+    ftp.file_len = file_len;
+    return 0;
+}
+
+/*
+  read a packet of the session's file at op.offset into op
+ */
+uint8_t GCS_MAVLINK::ftp_read_file(struct ftp_op &op)
+{
+    if (::lseek(ftp.fd, op.offset, SEEK_SET) != (off_t)op.offset) {
+        return FTP_ERR_FAIL;
+    }
+    const ssize_t ret = ::read(ftp.fd, op.data, MIN(ftp.file_len - op.offset, sizeof(op.data)));
+    if (ret < 0) {
+        return FTP_ERR_FAIL;
+    }
+    if (ret == 0) {
+        return FTP_ERR_EOF;
+    }
+    op.size = ret;
+    return 0;
+}
+
+/*
+  start a burst read of the session's file from the request's offset,
+  which is sent from the read ahead by send_ftp_replies()
+ */
+uint8_t GCS_MAVLINK::ftp_start_burst(const struct ftp_request &req)
+{
+    if (ftp.burst_data == nullptr) {
+        ByteBuffer *burst_data = new ByteBuffer(HAL_FTP_READAHEAD_SIZE);
+        if (burst_data == nullptr || burst_data->get_size() == 0) {
+            delete burst_data;
+            return FTP_ERR_FAIL;
+        }
+        WITH_SEMAPHORE(ftp.sem);
+        ftp.burst_data = burst_data;
+    }
+    if (::lseek(ftp.fd, req.op.offset, SEEK_SET) != (off_t)req.op.offset) {
+        return FTP_ERR_FAIL;
+    }
+
+    WITH_SEMAPHORE(ftp.sem);
+    ftp.burst_data->clear();
+    ftp.burst.active = true;
+    ftp.burst.chan = req.chan;
+    ftp.burst.sysid = req.sysid;
+    ftp.burst.compid = req.compid;
+    ftp.burst.seq_number = req.op.seq_number;
+    ftp.burst.offset = req.op.offset;
+    ftp.burst.read_offset = req.op.offset;
+    return 0;
+}
+
+/*
+  read ahead of a burst read of a file, in the IO thread. A file which
+  gets shorter ends the burst where reading stops
+ */
+void GCS_MAVLINK::ftp_read_ahead(void)
+{
+    if (!ftp.burst.active || ftp.fd == -1 || ftp.burst_data == nullptr) {
+        return;
+    }
+    const uint32_t tstart = AP_HAL::micros();
+    uint8_t buf[sizeof(ftp_op::data)];
+    while (ftp.burst.read_offset < ftp.file_len &&
+           ftp.burst_data->space() >= sizeof(buf)) {
+        const ssize_t ret = ::read(ftp.fd, buf, MIN(ftp.file_len - ftp.burst.read_offset, sizeof(buf)));
+        if (ret <= 0) {
+            WITH_SEMAPHORE(ftp.sem);
+            ftp.file_len = ftp.burst.read_offset;
+            break;
+        }
+        ftp.burst_data->write(buf, ret);
+        ftp.burst.read_offset += ret;
+        if (AP_HAL::micros() - tstart > 2000) {
+            break;
+        }
+    }
+}
+
+/*
+  write op's data into the session's file at op.offset
+ */
+uint8_t GCS_MAVLINK::ftp_write_file(struct ftp_op &op)
+{
+    const uint8_t len = MIN(op.size, sizeof(op.data));
+    if (::lseek(ftp.fd, op.offset, SEEK_SET) != (off_t)op.offset ||
+        ::write(ftp.fd, op.data, len) != len) {
+        return FTP_ERR_FAIL;
+    }
+    op.size = 0;
+    return 0;
+}
+
+uint8_t GCS_MAVLINK::ftp_remove_file(const char *path)
+{
+    if (::unlink(path) != 0) {
+        return FTP_ERR_FILE_NOT_FOUND;
+    }
+    return 0;
+}
+
+/*
+  list the directory at path into op, starting at entry op.offset. A
+  file is "F<name>\t<size>", a directory "D<name>" and an entry which
+  can't be described "S", each nul terminated
+ */
+uint8_t GCS_MAVLINK::ftp_list_directory(struct ftp_op &op, const char *path)
+{
+    DIR *dir = ::opendir(path);
+    if (dir == nullptr) {
+        return FTP_ERR_FILE_NOT_FOUND;
+    }
+
+    uint32_t index = 0;
+    uint8_t ofs = 0;
+    for (struct dirent *de=::readdir(dir); de != nullptr; de=::readdir(dir)) {
+        if (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0) {
+            continue;
+        }
+        if (index++ < op.offset) {
+            continue;
+        }
+        char entry[sizeof(op.data)];
+        char full_path[sizeof(op.data)+sizeof(de->d_name)+2];
+        hal.util->snprintf(full_path, sizeof(full_path), "%s/%s", path, de->d_name);
+        struct stat st;
+        int len;
+        if (::stat(full_path, &st) != 0) {
+            len = hal.util->snprintf(entry, sizeof(entry), "S");
+        } else if (S_ISDIR(st.st_mode)) {
+            len = hal.util->snprintf(entry, sizeof(entry), "D%s", de->d_name);
+        } else {
+            len = hal.util->snprintf(entry, sizeof(entry), "F%s\t%u", de->d_name, (unsigned)st.st_size);
+        }
+        if (len <= 0 || len >= (int)sizeof(entry) || ofs + len + 1 > sizeof(op.data)) {
+            // the GCS asks again from the entry which didn't fit
+            break;
+        }
+        memcpy(&op.data[ofs], entry, len + 1);
+        ofs += len + 1;
+    }
+    ::closedir(dir);
+
+    if (ofs == 0) {
+        return FTP_ERR_EOF;
+    }
+    op.size = ofs;
+    return 0;
+}
+
+#else
+// no filesystem, only the generated files are served
+
+uint8_t GCS_MAVLINK::ftp_open_file(const char *path, bool writable, bool truncate)
+{
+    return FTP_ERR_FILE_NOT_FOUND;
+}
+
+uint8_t GCS_MAVLINK::ftp_read_file(struct ftp_op &op)
+{
+    return FTP_ERR_INVALID_SESSION;
+}
+
+uint8_t GCS_MAVLINK::ftp_start_burst(const struct ftp_request &req)
+{
+    return FTP_ERR_INVALID_SESSION;
+}
+
+void GCS_MAVLINK::ftp_read_ahead(void)
+{
+}
+
+uint8_t GCS_MAVLINK::ftp_write_file(struct ftp_op &op)
+{
+    return FTP_ERR_INVALID_SESSION;
+}
+
+uint8_t GCS_MAVLINK::ftp_remove_file(const char *path)
+{
+    return FTP_ERR_FILE_NOT_FOUND;
+}
+
+uint8_t GCS_MAVLINK::ftp_list_directory(struct ftp_op &op, const char *path)
+{
+    return FTP_ERR_FILE_NOT_FOUND;
+}
+#endif // FTP_FILESYSTEM
+
+/*
+  pack all the parameters into ftp.file
+ */
+bool GCS_MAVLINK::ftp_pack_params(void)
+{
+    // size the file first, so it can be allocated in one go
+    uint32_t len = 3*sizeof(uint16_t);
+    uint16_t count = 0;
+    AP_Param::ParamToken token;
+    enum ap_var_type type;
+    char name[AP_MAX_NAME_SIZE+1];
+    char last_name[AP_MAX_NAME_SIZE+1] {};
+    for (AP_Param *vp = AP_Param::first(&token, &type);
+         vp != nullptr;
+         vp = AP_Param::next_scalar(&token, &type)) {
+        vp->copy_name_token(token, name, sizeof(name), true);
+        name[AP_MAX_NAME_SIZE] = 0;
+        uint8_t common_len = 0;
+        while (common_len < 15 && name[common_len] != 0 && name[common_len] == last_name[common_len]) {
+            common_len++;
+        }
+        len += 2 + strlen(name) - common_len + ftp_value_len(type);
+        memcpy(last_name, name, sizeof(name));
+        count++;
+    }
+
+    uint8_t *file = (uint8_t *)malloc(len);
+    if (file == nullptr) {
+        return false;
+    }
+
+    // the parameter values are as of now; one set while the file is
+    // being packed may appear with either its old or new value
+    const uint16_t header[3] { FTP_PARAM_MAGIC, count, count };
+    memcpy(file, header, sizeof(header));
+    uint32_t ofs = sizeof(header);
+    uint16_t packed = 0;
+    memset(last_name, 0, sizeof(last_name));
+    for (AP_Param *vp = AP_Param::first(&token, &type);
+         vp != nullptr && packed < count;
+         vp = AP_Param::next_scalar(&token, &type)) {
+        vp->copy_name_token(token, name, sizeof(name), true);
+        name[AP_MAX_NAME_SIZE] = 0;
+        uint8_t common_len = 0;
+        while (common_len < 15 && name[common_len] != 0 && name[common_len] == last_name[common_len]) {
+            common_len++;
+        }
+        const uint8_t suffix_len = strlen(name) - common_len;
+        const uint8_t value_len = ftp_value_len(type);
+        if (suffix_len == 0 || ofs + 2 + suffix_len + value_len > len) {
+            // a parameter without a name, or the table changed
+            break;
+        }
+        file[ofs++] = type;
+        file[ofs++] = common_len | ((suffix_len-1)<<4);
+        memcpy(&file[ofs], &name[common_len], suffix_len);
+        ofs += suffix_len;
+        memcpy(&file[ofs], vp, value_len);
+        ofs += value_len;
+        memcpy(last_name, name, sizeof(name));
+        packed++;
+    }
+    if (packed != count) {
+        // rewrite the count to match what was packed
+        memcpy(&file[sizeof(uint16_t)], &packed, sizeof(packed));
+    }
+
+    WITH_SEMAPHORE(ftp.sem);
+    free(ftp.file);
+    ftp.file = file;
+    ftp.file_len = ofs;
+    return true;
+}
+
+/*
+  write the shared DMA statistics into ftp.file
+ */
+bool GCS_MAVLINK::ftp_dma_stats(void)
+{
+    const uint16_t line_len = 160;
+    AP_HAL::Util::DMAStats stats;
+    uint8_t count = 0;
+    while (hal.util->get_dma_stats(count, stats)) {
+        count++;
+    }
+    const uint32_t len = (count + 1) * line_len;
+    char *file = (char *)malloc(len);
+    if (file == nullptr) {
+        return false;
+    }
+    uint32_t ofs = hal.util->snprintf(file, len, "DMA  OWN LOCKS CONTENDED HANDOVERS HOLDAVG HOLDMAX WAIT<16,32,64,128,256,512,1024,more\n");
+    for (uint8_t i=0; i<count && ofs < len; i++) {
+        if (!hal.util->get_dma_stats(i, stats)) {
+            break;
+        }
+        ofs += hal.util->snprintf(&file[ofs], len - ofs,
+                                  "%u:%u %3u %5u %9u %9u %7u %7u %u,%u,%u,%u,%u,%u,%u,%u\n",
+                                  stats.controller, stats.stream, stats.owners,
+                                  (unsigned)stats.locks, (unsigned)stats.contended,
+                                  (unsigned)stats.handovers,
+                                  (unsigned)stats.hold_avg_us, (unsigned)stats.hold_max_us,
+                                  (unsigned)stats.wait_hist[0], (unsigned)stats.wait_hist[1],
+                                  (unsigned)stats.wait_hist[2], (unsigned)stats.wait_hist[3],
+                                  (unsigned)stats.wait_hist[4], (unsigned)stats.wait_hist[5],
+                                  (unsigned)stats.wait_hist[6], (unsigned)stats.wait_hist[7]);
+    }
+
+    WITH_SEMAPHORE(ftp.sem);
+    free(ftp.file);
+    ftp.file = (uint8_t *)file;
+    ftp.file_len = MIN(ofs, len);
+    return true;
+}
+
+/*
+  write the serial port statistics into ftp.file
+ */
+bool GCS_MAVLINK::ftp_uart_stats(void)
+{
+    const uint16_t line_len = 140;
+    const uint32_t len = (hal.num_serial + 1) * line_len;
+    char *file = (char *)malloc(len);
+    if (file == nullptr) {
+        return false;
+    }
+    uint32_t ofs = hal.util->snprintf(file, len, "SERIAL RX TX IRQS OVERRUNS RXDROP TXFULL TXDROP RXMAX TXMAX LATAVG LATMAX\n");
+    AP_HAL::UARTDriver::UARTStats stats;
+    for (uint8_t i=0; i<hal.num_serial && ofs < len; i++) {
+        AP_HAL::UARTDriver *uart = hal.serial(i);
+        if (uart == nullptr || !uart->get_stats(stats)) {
+            continue;
+        }
+        ofs += hal.util->snprintf(&file[ofs], len - ofs,
+                                  "%u %u %u %u %u %u %u %u %u %u %u %u\n",
+                                  i,
+                                  (unsigned)stats.rx_bytes, (unsigned)stats.tx_bytes,
+                                  (unsigned)stats.irqs, (unsigned)stats.rx_overruns,
+                                  (unsigned)stats.rx_dropped, (unsigned)stats.tx_full,
+                                  (unsigned)stats.tx_dropped,
+                                  stats.rx_max_used, stats.tx_max_used,
+                                  (unsigned)stats.tx_latency_avg_us,
+                                  (unsigned)stats.tx_latency_max_us);
+    }
+
+    WITH_SEMAPHORE(ftp.sem);
+    free(ftp.file);
+    ftp.file = (uint8_t *)file;
+    ftp.file_len = MIN(ofs, len);
+    return true;
+}
+
+/*
+  send FTP replies and burst read data, called from queued_param_send()
+ */
+void GCS_MAVLINK::send_ftp_replies(void)
+{
+    struct ftp_request req;
+    while (ftp.replies.peek(req)) {
+        if (!HAVE_PAYLOAD_SPACE(req.chan, FILE_TRANSFER_PROTOCOL)) {
+            return;
+        }
+        ftp.replies.pop();
+        mavlink_msg_file_transfer_protocol_send(
+            req.chan, 0, req.sysid, req.compid, (const uint8_t *)&req.op);
+    }
+
+    WITH_SEMAPHORE(ftp.sem);
+    if (!ftp.burst.active || ftp.burst.chan != chan) {
+        return;
+    }
+    const uint32_t tstart = AP_HAL::micros();
+    struct ftp_op op {};
+    while (HAVE_PAYLOAD_SPACE(chan, FILE_TRANSFER_PROTOCOL)) {
+        const uint8_t size = MIN(ftp.file_len - ftp.burst.offset, sizeof(op.data));
+        if (ftp.file != nullptr) {
+            memcpy(op.data, &ftp.file[ftp.burst.offset], size);
+        } else if (ftp.burst_data->available() < size) {
+            // wait for the IO thread to read ahead
+            break;
+        } else {
+            ftp.burst_data->read(op.data, size);
+        }
+        op.seq_number = ftp.burst.seq_number++;
+        op.session = 0;
+        op.opcode = FTP_OP_ACK;
+        op.req_opcode = FTP_OP_BURST_READ;
+        op.offset = ftp.burst.offset;
+        op.size = size;
+        ftp.burst.offset += op.size;
+        op.burst_complete = (ftp.burst.offset >= ftp.file_len);
+        mavlink_msg_file_transfer_protocol_send(
+            chan, 0, ftp.burst.sysid, ftp.burst.compid, (const uint8_t *)&op);
+        if (op.burst_complete) {
+            ftp.burst.active = false;
+            break;
+        }
+        if (AP_HAL::micros() - tstart > 1000) {
+            // as for parameters, at most 1ms at a time
+            break;
+        }
+    }
+    ftp.last_request_ms = AP_HAL::millis();
+}
@@ -36,6 +36,7 @@ extern const AP_HAL::HAL& hal;
 #include "include/mavlink/v2.0/mavlink_helpers.h"
 #pragma GCC diagnostic pop
 #endif
+#include "include/mavlink/v2.0/mavlink_sha256.h"
 
 AP_HAL::UARTDriver	*mavlink_comm_port[MAVLINK_COMM_NUM_BUFFERS];
 bool gcs_alternative_active[MAVLINK_COMM_NUM_BUFFERS];
@@ -43,6 +44,20 @@ bool gcs_alternative_active[MAVLINK_COMM_NUM_BUFFERS];
 // per-channel lock
 static HAL_Semaphore chan_locks[MAVLINK_COMM_NUM_BUFFERS];
 
+/*
+  the MAVLink helpers send a message as its header, payload, CRC and
+  signature between comm_send_lock() and comm_send_unlock(). The
+  fragments are gathered here, pointing into the sender's buffers
+  which are still valid at the unlock, and written with one writev()
+ */
+#define COMM_SEND_MAX_FRAGMENTS 4
+static struct {
+    AP_HAL::UARTDriver::WriteVec vec[COMM_SEND_MAX_FRAGMENTS];
+    uint8_t count;
+    uint8_t lock_depth;
+} chan_gather[MAVLINK_COMM_NUM_BUFFERS];
+static void comm_send_flush(mavlink_channel_t chan);
+
 mavlink_system_t mavlink_system = {7,1};
 
 // mask of serial ports disabled to allow for SERIAL_CONTROL
@@ -145,7 +160,227 @@ void comm_send_buffer(mavlink_channel_t chan, const uint8_t *buf, uint8_t len)
         // an alternative protocol is active
         return;
     }
-    mavlink_comm_port[chan]->write(buf, len);
+    auto &gather = chan_gather[chan];
+    if (gather.lock_depth == 0) {
+        mavlink_comm_port[chan]->write(buf, len);
+        return;
+    }
+    if (gather.count == COMM_SEND_MAX_FRAGMENTS) {
+        comm_send_flush(chan);
+    }
+    gather.vec[gather.count].data = buf;
+    gather.vec[gather.count].len = len;
+    gather.count++;
+}
+
+/*
+  write the gathered fragments of a channel
+ */
+static void comm_send_flush(mavlink_channel_t chan)
+{
+    auto &gather = chan_gather[chan];
+    if (gather.count > 0) {
+        mavlink_comm_port[chan]->writev(gather.vec, gather.count);
+        gather.count = 0;
+    }
+}
+
+/*
+  MAVLink2 signing. The hash state after the secret key is kept for
+  each signing structure, saving setting it up for every packet. The
+  signing structure doesn't say which channel a packet is for, so the
+  time taken is held as pending until the channel is known: when it is
+  locked for sending the packet, or when update_receive() has parsed a
+  block of bytes. With several threads sending at once a packet may be
+  counted against the wrong channel
+ */
+static struct {
+    const mavlink_signing_t *signing;
+    mavlink_sha256_ctx ctx;
+} signing_key_ctx[MAVLINK_COMM_NUM_BUFFERS];
+
+struct signing_stats_t {
+    uint16_t count;
+    uint32_t time_us;
+};
+static signing_stats_t signing_stats[MAVLINK_COMM_NUM_BUFFERS];
+static signing_stats_t signing_pending_send;
+static signing_stats_t signing_pending_receive;
+
+static void signing_stats_add(mavlink_channel_t chan, signing_stats_t &pending)
+{
+    if (pending.count == 0) {
+        return;
+    }
+    signing_stats[chan].count += pending.count;
+    signing_stats[chan].time_us += pending.time_us;
+    pending.count = 0;
+    pending.time_us = 0;
+}
+
+/*
+  the signing structure is linked to the channel of the GCS_MAVLINK
+  that owns it, see load_signing_key()
+ */
+void comm_signing_key_changed(const mavlink_signing_t *signing)
+{
+    if (signing->link_id >= MAVLINK_COMM_NUM_BUFFERS) {
+        return;
+    }
+    auto &key = signing_key_ctx[signing->link_id];
+    key.signing = nullptr;
+    mavlink_sha256_init(&key.ctx);
+    mavlink_sha256_update(&key.ctx, signing->secret_key, sizeof(signing->secret_key));
+    key.signing = signing;
+}
+
+// start a hash of a packet with the secret key
+static void signing_hash_start(const mavlink_signing_t *signing, mavlink_sha256_ctx &ctx)
+{
+    if (signing->link_id < MAVLINK_COMM_NUM_BUFFERS &&
+        signing_key_ctx[signing->link_id].signing == signing) {
+        ctx = signing_key_ctx[signing->link_id].ctx;
+        return;
+    }
+    mavlink_sha256_init(&ctx);
+    mavlink_sha256_update(&ctx, signing->secret_key, sizeof(signing->secret_key));
+}
+
+/*
+  create the signature block for a packet
+ */
+uint8_t mavlink_sign_packet(mavlink_signing_t *signing,
+                            uint8_t signature[MAVLINK_SIGNATURE_BLOCK_LEN],
+                            const uint8_t *header, uint8_t header_len,
+                            const uint8_t *packet, uint8_t packet_len,
+                            const uint8_t crc[2])
+{
+    if (signing == nullptr || !(signing->flags & MAVLINK_SIGNING_FLAG_SIGN_OUTGOING)) {
+        return 0;
+    }
+    const uint32_t tstart_us = AP_HAL::micros();
+
+    // the link ID and the 48 bit timestamp, little endian
+    signature[0] = signing->link_id;
+    for (uint8_t i=0; i<6; i++) {
+        signature[1+i] = (signing->timestamp >> (8*i)) & 0xFF;
+    }
+    signing->timestamp++;
+
+    mavlink_sha256_ctx ctx;
+    signing_hash_start(signing, ctx);
+    mavlink_sha256_update(&ctx, header, header_len);
+    mavlink_sha256_update(&ctx, packet, packet_len);
+    mavlink_sha256_update(&ctx, crc, 2);
+    mavlink_sha256_update(&ctx, signature, 7);
+    mavlink_sha256_final_48(&ctx, &signature[7]);
+
+    signing_pending_send.count++;
+    signing_pending_send.time_us += AP_HAL::micros() - tstart_us;
+
+    return MAVLINK_SIGNATURE_BLOCK_LEN;
+}
+
+/*
+  check the signature of a received packet. The stream checks which
+  don't need the signature are done first, so a replayed packet or one
+  with an old timestamp costs no hashing, but a new stream is only
+  added once the signature is good
+ */
+bool mavlink_signature_check(mavlink_signing_t *signing,
+                             mavlink_signing_streams_t *signing_streams,
+                             const mavlink_message_t *msg)
+{
+    if (signing == nullptr) {
+        return true;
+    }
+    const uint8_t *psig = msg->signature;
+    const uint8_t link_id = psig[0];
+    uint64_t timestamp = 0;
+    for (uint8_t i=0; i<6; i++) {
+        timestamp |= uint64_t(psig[1+i]) << (8*i);
+    }
+
+    if (signing_streams == nullptr) {
+        signing->last_status = MAVLINK_SIGNING_STATUS_NO_STREAMS;
+        return false;
+    }
+
+    // find the stream
+    uint16_t i;
+    for (i=0; i<signing_streams->num_signing_streams; i++) {
+        if (msg->sysid == signing_streams->stream[i].sysid &&
+            msg->compid == signing_streams->stream[i].compid &&
+            link_id == signing_streams->stream[i].link_id) {
+            break;
+        }
+    }
+    if (i == signing_streams->num_signing_streams) {
+        if (signing_streams->num_signing_streams >= MAVLINK_MAX_SIGNING_STREAMS) {
+            signing->last_status = MAVLINK_SIGNING_STATUS_TOO_MANY_STREAMS;
+            return false;
+        }
+        // only accept a new stream if its timestamp is not more than
+        // a minute old
+        if (timestamp + 6000*1000UL < signing->timestamp) {
+            signing->last_status = MAVLINK_SIGNING_STATUS_OLD_TIMESTAMP;
+            return false;
+        }
+    } else {
+        uint64_t last_timestamp = 0;
+        for (uint8_t j=0; j<6; j++) {
+            last_timestamp |= uint64_t(signing_streams->stream[i].timestamp_bytes[j]) << (8*j);
+        }
+        if (timestamp <= last_timestamp) {
+            signing->last_status = MAVLINK_SIGNING_STATUS_REPLAY;
+            return false;
+        }
+    }
+
+    const uint32_t tstart_us = AP_HAL::micros();
+    mavlink_sha256_ctx ctx;
+    uint8_t signature[6];
+    signing_hash_start(signing, ctx);
+    mavlink_sha256_update(&ctx, (const uint8_t *)&msg->magic, MAVLINK_NUM_HEADER_BYTES);
+    mavlink_sha256_update(&ctx, _MAV_PAYLOAD(msg), msg->len);
+    mavlink_sha256_update(&ctx, msg->ck, 2);
+    mavlink_sha256_update(&ctx, psig, 1+6);
+    mavlink_sha256_final_48(&ctx, signature);
+    signing_pending_receive.count++;
+    signing_pending_receive.time_us += AP_HAL::micros() - tstart_us;
+
+    if (memcmp(signature, &psig[7], 6) != 0) {
+        signing->last_status = MAVLINK_SIGNING_STATUS_BAD_SIGNATURE;
+        return false;
+    }
+
+    if (i == signing_streams->num_signing_streams) {
+        signing_streams->stream[i].sysid = msg->sysid;
+        signing_streams->stream[i].compid = msg->compid;
+        signing_streams->stream[i].link_id = link_id;
+        signing_streams->num_signing_streams++;
+    }
+    memcpy(signing_streams->stream[i].timestamp_bytes, &psig[1], 6);
+
+    // our next timestamp must be at least this timestamp
+    if (timestamp > signing->timestamp) {
+        signing->timestamp = timestamp;
+    }
+    signing->last_status = MAVLINK_SIGNING_STATUS_OK;
+    return true;
+}
+
+void comm_signing_receive_done(mavlink_channel_t chan)
+{
+    signing_stats_add(chan, signing_pending_receive);
+}
+
+void comm_signing_stats(mavlink_channel_t chan, uint16_t &count, uint32_t &time_us)
+{
+    count = signing_stats[chan].count;
+    time_us = signing_stats[chan].time_us;
+    signing_stats[chan].count = 0;
+    signing_stats[chan].time_us = 0;
 }
 
 /*
@@ -154,12 +389,18 @@ void comm_send_buffer(mavlink_channel_t chan, const uint8_t *buf, uint8_t len)
 void comm_send_lock(mavlink_channel_t chan)
 {
     chan_locks[(uint8_t)chan].take_blocking();
+    chan_gather[(uint8_t)chan].lock_depth++;
+    signing_stats_add(chan, signing_pending_send);
 }
 
 /*
-  unlock a channel
+  unlock a channel, writing the message sent while it was locked
  */
 void comm_send_unlock(mavlink_channel_t chan)
 {
+    auto &gather = chan_gather[(uint8_t)chan];
+    if (--gather.lock_depth == 0) {
+        comm_send_flush(chan);
+    }
     chan_locks[(uint8_t)chan].give();
 }
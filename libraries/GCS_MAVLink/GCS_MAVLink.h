@@ -14,6 +14,10 @@
 #define MAVLINK_START_UART_SEND(chan, size) comm_send_lock(chan)
 #define MAVLINK_END_UART_SEND(chan, size) comm_send_unlock(chan)
 
+// the signing functions of the helpers are replaced by ours
+#define MAVLINK_NO_SIGN_PACKET
+#define MAVLINK_NO_SIGNATURE_CHECK
+
 #if CONFIG_HAL_BOARD == HAL_BOARD_SITL
 // allow extra mavlink channels in SITL for:
 //    Vicon
@@ -79,4 +83,25 @@ MAV_PARAM_TYPE mav_param_type(enum ap_var_type t);
 void comm_send_lock(mavlink_channel_t chan);
 void comm_send_unlock(mavlink_channel_t chan);
 
+// MAVLink2 signing, used by the helpers
+uint8_t mavlink_sign_packet(mavlink_signing_t *signing,
+                            uint8_t signature[MAVLINK_SIGNATURE_BLOCK_LEN],
+                            const uint8_t *header, uint8_t header_len,
+                            const uint8_t *packet, uint8_t packet_len,
+                            const uint8_t crc[2]);
+bool mavlink_signature_check(mavlink_signing_t *signing,
+                             mavlink_signing_streams_t *signing_streams,
+                             const mavlink_message_t *msg);
+
+// to be called when the secret key of signing has changed
+void comm_signing_key_changed(const mavlink_signing_t *signing);
+
+// add the time spent checking signatures since the last call to the
+// statistics of chan, called after parsing bytes from it
+void comm_signing_receive_done(mavlink_channel_t chan);
+
+// get and reset the number of packets signed or checked on chan and
+// the time spent on them
+void comm_signing_stats(mavlink_channel_t chan, uint16_t &count, uint32_t &time_us);
+
 #pragma GCC diagnostic pop
@@ -43,6 +43,9 @@ GCS_MAVLINK::queued_param_send()
     // send parameter async replies
     uint8_t async_replies_sent_count = send_parameter_async_replies();
 
+    // and any parameter file transfer
+    send_ftp_replies();
+
     const uint32_t tnow = AP_HAL::millis();
     const uint32_t tstart = AP_HAL::micros();
 
@@ -139,6 +139,7 @@ void GCS_MAVLINK::load_signing_key(void)
     signing.timestamp = key.timestamp + 60UL * 100UL * 1000UL;
     signing.flags = MAVLINK_SIGNING_FLAG_SIGN_OUTGOING;
     signing.accept_unsigned_callback = accept_unsigned_callback;
+    comm_signing_key_changed(&signing);
 
     // if timestamp and key are all zero then we disable signing
     bool all_zero = (key.timestamp == 0);
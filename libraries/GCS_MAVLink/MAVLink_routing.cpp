@@ -27,7 +27,11 @@ extern const AP_HAL::HAL& hal;
 #define ROUTING_DEBUG 0
 
 // constructor
-MAVLink_routing::MAVLink_routing(void) : num_routes(0) {}
+MAVLink_routing::MAVLink_routing(void) : num_routes(0)
+{
+    memset(sys_head, no_route, sizeof(sys_head));
+    memset(pair_head, no_route, sizeof(pair_head));
+}
 
 /*
   forward a MAVLink message to the right port. This also
@@ -134,11 +138,14 @@ bool MAVLink_routing::check_and_forward(mavlink_channel_t in_channel, const mavl
         return true;
     }
 
-    // forward on any channels matching the targets
+    // forward on any channels matching the targets. Only a broadcast
+    // needs to look at every route, otherwise just the routes for the
+    // target system can match
     bool forwarded = false;
     bool sent_to_chan[MAVLINK_COMM_NUM_BUFFERS];
     memset(sent_to_chan, 0, sizeof(sent_to_chan));
-    for (uint8_t i=0; i<num_routes; i++) {
+    const uint8_t first = broadcast_system ? 0 : sys_head[sys_hash(target_system)];
+    for (uint8_t i=first; i<num_routes; i = broadcast_system ? i+1 : routes[i].next_sys) {
     
         // Skip if channel is private and the target system or component IDs do not match
         if ((GCS_MAVLINK::is_private(routes[i].channel)) &&
@@ -165,6 +172,7 @@ bool MAVLink_routing::check_and_forward(mavlink_channel_t in_channel, const mavl
                              (int)target_component);
 #endif
                     _mavlink_resend_uart(routes[i].channel, msg);
+                    routes[i].packets_forwarded++;
                 }
                 sent_to_chan[routes[i].channel] = true;
                 forwarded = true;
@@ -190,7 +198,7 @@ void MAVLink_routing::send_to_components(const mavlink_message_t* msg)
     memset(sent_to_chan, 0, sizeof(sent_to_chan));
 
     // check learned routes
-    for (uint8_t i=0; i<num_routes; i++) {
+    for (uint8_t i=sys_head[sys_hash(mavlink_system.sysid)]; i!=no_route; i=routes[i].next_sys) {
         if ((routes[i].sysid == mavlink_system.sysid) && !sent_to_chan[routes[i].channel]) {
             if (comm_get_txspace(routes[i].channel) >= ((uint16_t)msg->len) +
                 GCS_MAVLINK::packet_overhead_chan(routes[i].channel)) {
@@ -202,6 +210,7 @@ void MAVLink_routing::send_to_components(const mavlink_message_t* msg)
                          (unsigned)routes[i].compid);
 #endif
                 _mavlink_resend_uart(routes[i].channel, msg);
+                routes[i].packets_forwarded++;
                 sent_to_chan[routes[i].channel] = true;
             }
         }
@@ -228,35 +237,96 @@ bool MAVLink_routing::find_by_mavtype(uint8_t mavtype, uint8_t &sysid, uint8_t &
     return false;
 }
 
+/*
+  find the route for sysid/compid on channel, returning no_route if
+  there isn't one
+*/
+uint8_t MAVLink_routing::find_route(uint8_t sysid, uint8_t compid, mavlink_channel_t channel) const
+{
+    for (uint8_t i=pair_head[pair_hash(sysid, compid)]; i!=no_route; i=routes[i].next_pair) {
+        if (routes[i].sysid == sysid &&
+            routes[i].compid == compid &&
+            routes[i].channel == channel) {
+            return i;
+        }
+    }
+    return no_route;
+}
+
+void MAVLink_routing::link_route(uint8_t i)
+{
+    const uint8_t sh = sys_hash(routes[i].sysid);
+    const uint8_t ph = pair_hash(routes[i].sysid, routes[i].compid);
+    routes[i].next_sys = sys_head[sh];
+    sys_head[sh] = i;
+    routes[i].next_pair = pair_head[ph];
+    pair_head[ph] = i;
+}
+
+void MAVLink_routing::unlink_route(uint8_t i)
+{
+    uint8_t *p = &sys_head[sys_hash(routes[i].sysid)];
+    while (*p != no_route && *p != i) {
+        p = &routes[*p].next_sys;
+    }
+    if (*p == i) {
+        *p = routes[i].next_sys;
+    }
+    p = &pair_head[pair_hash(routes[i].sysid, routes[i].compid)];
+    while (*p != no_route && *p != i) {
+        p = &routes[*p].next_pair;
+    }
+    if (*p == i) {
+        *p = routes[i].next_pair;
+    }
+}
+
+/*
+  add a route, returning its index. If the table is full the route
+  heard from least recently is replaced
+*/
+uint8_t MAVLink_routing::add_route(uint8_t sysid, uint8_t compid, mavlink_channel_t channel)
+{
+    uint8_t i;
+    if (num_routes < MAVLINK_MAX_ROUTES) {
+        i = num_routes++;
+    } else {
+        const uint32_t now_ms = AP_HAL::millis();
+        i = 0;
+        for (uint8_t j=1; j<num_routes; j++) {
+            if (now_ms - routes[j].last_seen_ms > now_ms - routes[i].last_seen_ms) {
+                i = j;
+            }
+        }
+#if ROUTING_DEBUG
+        ::printf("forgot route %u %u via %u\n",
+                 (unsigned)routes[i].sysid,
+                 (unsigned)routes[i].compid,
+                 (unsigned)routes[i].channel);
+#endif
+        unlink_route(i);
+    }
+    memset(&routes[i], 0, sizeof(routes[i]));
+    routes[i].sysid = sysid;
+    routes[i].compid = compid;
+    routes[i].channel = channel;
+    link_route(i);
+    return i;
+}
+
 /*
   see if the message is for a new route and learn it
 */
 void MAVLink_routing::learn_route(mavlink_channel_t in_channel, const mavlink_message_t* msg)
 {
-    uint8_t i;
     if (msg->sysid == 0 || 
         (msg->sysid == mavlink_system.sysid && 
          msg->compid == mavlink_system.compid)) {
         return;
     }
-    for (i=0; i<num_routes; i++) {
-        if (routes[i].sysid == msg->sysid && 
-            routes[i].compid == msg->compid &&
-            routes[i].channel == in_channel) {
-            if (routes[i].mavtype == 0 && msg->msgid == MAVLINK_MSG_ID_HEARTBEAT) {
-                routes[i].mavtype = mavlink_msg_heartbeat_get_type(msg);
-            }
-            break;
-        }
-    }
-    if (i == num_routes && i<MAVLINK_MAX_ROUTES) {
-        routes[i].sysid = msg->sysid;
-        routes[i].compid = msg->compid;
-        routes[i].channel = in_channel;
-        if (msg->msgid == MAVLINK_MSG_ID_HEARTBEAT) {
-            routes[i].mavtype = mavlink_msg_heartbeat_get_type(msg);
-        }
-        num_routes++;
+    uint8_t i = find_route(msg->sysid, msg->compid, in_channel);
+    if (i == no_route) {
+        i = add_route(msg->sysid, msg->compid, in_channel);
 #if ROUTING_DEBUG
         ::printf("learned route %u %u via %u\n",
                  (unsigned)msg->sysid, 
@@ -264,6 +334,12 @@ void MAVLink_routing::learn_route(mavlink_channel_t in_channel, const mavlink_me
                  (unsigned)in_channel);
 #endif
     }
+    struct route &r = routes[i];
+    r.last_seen_ms = AP_HAL::millis();
+    r.packets_received++;
+    if (r.mavtype == 0 && msg->msgid == MAVLINK_MSG_ID_HEARTBEAT) {
+        r.mavtype = mavlink_msg_heartbeat_get_type(msg);
+    }
 }
 
 
@@ -284,7 +360,7 @@ void MAVLink_routing::handle_heartbeat(mavlink_channel_t in_channel, const mavli
     mask &= ~no_route_mask;
     
     // mask out channels that are known sources for this sysid/compid
-    for (uint8_t i=0; i<num_routes; i++) {
+    for (uint8_t i=pair_head[pair_hash(msg->sysid, msg->compid)]; i!=no_route; i=routes[i].next_pair) {
         if (routes[i].sysid == msg->sysid && routes[i].compid == msg->compid) {
             mask &= ~(1U<<((unsigned)(routes[i].channel-MAVLINK_COMM_0)));
         }
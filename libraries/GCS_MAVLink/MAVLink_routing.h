@@ -6,9 +6,18 @@
 #include <AP_Common/AP_Common.h>
 #include "GCS_MAVLink.h"
 
-// 20 routes should be enough for now. This may need to increase as
-// we make more extensive use of MAVLink forwarding
+// the most routes learned. When full, the route heard from least
+// recently is forgotten to make room for a new one
+#ifndef MAVLINK_MAX_ROUTES
+#if HAL_MINIMIZE_FEATURES
 #define MAVLINK_MAX_ROUTES 20
+#else
+#define MAVLINK_MAX_ROUTES 64
+#endif
+#endif
+
+// number of hash chains for looking up routes
+#define MAVLINK_ROUTE_HASH_SIZE 16
 
 /*
   object to handle MAVLink packet routing
@@ -41,16 +50,42 @@ public:
      */
     bool find_by_mavtype(uint8_t mavtype, uint8_t &sysid, uint8_t &compid, mavlink_channel_t &channel);
 
-private:
-    // a simple linear routing table. We don't expect to have a lot of
-    // routes, so a scalable structure isn't worthwhile yet.
-    uint8_t num_routes;
     struct route {
         uint8_t sysid;
         uint8_t compid;
         mavlink_channel_t channel;
         uint8_t mavtype;
-    } routes[MAVLINK_MAX_ROUTES];
+        uint8_t next_sys;       // next route in the sysid hash chain
+        uint8_t next_pair;      // next route in the sysid/compid hash chain
+        uint32_t last_seen_ms;
+        uint32_t packets_received;
+        uint32_t packets_forwarded;
+    };
+
+    // access to the learned routes, for reporting
+    uint8_t get_num_routes(void) const { return num_routes; }
+    const struct route *get_route(uint8_t i) const { return i < num_routes ? &routes[i] : nullptr; }
+
+private:
+    // the routes are in an array, with hash chains through it so a
+    // packet only looks at the routes for its sysid, or its
+    // sysid/compid. A chain ends with no_route
+    static const uint8_t no_route = 0xFF;
+    uint8_t num_routes;
+    struct route routes[MAVLINK_MAX_ROUTES];
+    uint8_t sys_head[MAVLINK_ROUTE_HASH_SIZE];
+    uint8_t pair_head[MAVLINK_ROUTE_HASH_SIZE];
+
+    static uint8_t sys_hash(uint8_t sysid) { return sysid % MAVLINK_ROUTE_HASH_SIZE; }
+    static uint8_t pair_hash(uint8_t sysid, uint8_t compid) { return (sysid * 31U + compid) % MAVLINK_ROUTE_HASH_SIZE; }
+
+    // find the route for sysid/compid on channel, or no_route
+    uint8_t find_route(uint8_t sysid, uint8_t compid, mavlink_channel_t channel) const;
+
+    // add a route, forgetting the least recently heard route if full
+    uint8_t add_route(uint8_t sysid, uint8_t compid, mavlink_channel_t channel);
+    void unlink_route(uint8_t i);
+    void link_route(uint8_t i);
     
     // a channel mask to block routing as required
     uint8_t no_route_mask;
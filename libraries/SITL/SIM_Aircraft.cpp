@@ -249,9 +249,30 @@ void Aircraft::time_advance()
         time_now_us += frame_time_us;
     }
     last_time_us = time_now_us;
-    if (use_time_sync) {
+    if (use_time_sync && !lockstep) {
         sync_frame_time();
     }
+    update_achieved_speedup();
+}
+
+/*
+  measure the achieved speedup over each second of wall clock time
+ */
+void Aircraft::update_achieved_speedup(void)
+{
+    const uint64_t now = get_wall_time_us();
+    if (speedup_wall_start_us == 0 || now < speedup_wall_start_us) {
+        speedup_wall_start_us = now;
+        speedup_sim_start_us = time_now_us;
+        return;
+    }
+    const uint64_t wall_dt_us = now - speedup_wall_start_us;
+    if (wall_dt_us < 1000000) {
+        return;
+    }
+    achieved_speedup = (time_now_us - speedup_sim_start_us) / float(wall_dt_us);
+    speedup_wall_start_us = now;
+    speedup_sim_start_us = time_now_us;
 }
 
 /* setup the frame step time */
@@ -398,6 +419,7 @@ void Aircraft::fill_fdm(struct sitl_fdm &fdm)
     fdm.range = range;
     memcpy(fdm.rcin, rcin, rcin_chan_count * sizeof(float));
     fdm.bodyMagField = mag_bf;
+    fdm.speedup = achieved_speedup;
 
     // copy laser scanner results
     fdm.scanner.points = scanner.points;
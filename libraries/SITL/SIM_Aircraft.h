@@ -43,6 +43,14 @@ public:
      */
     void set_speedup(float speedup);
 
+    /*
+      set lockstep mode. Time then only advances as fast as the
+      vehicle code can run, with no sleeps to match the wall clock
+     */
+    void set_lockstep(bool _lockstep) {
+        lockstep = _lockstep;
+    }
+
     /*
       set instance number
      */
@@ -176,8 +184,14 @@ protected:
     const char *autotest_dir;
     const char *frame;
     bool use_time_sync = true;
+    bool lockstep = false;
     float last_speedup = -1.0f;
 
+    // measurement of the speedup actually achieved
+    float achieved_speedup = 1.0f;
+    uint64_t speedup_wall_start_us = 0;
+    uint64_t speedup_sim_start_us = 0;
+
     // allow for AHRS_ORIENTATION
     AP_Int8 *ahrs_orientation;
 
@@ -220,6 +234,9 @@ protected:
        into account desired speedup */
     void sync_frame_time(void);
 
+    /* measure the ratio of simulation time to wall clock time */
+    void update_achieved_speedup(void);
+
     /* add noise based on throttle level (from 0..1) */
     void add_noise(float throttle);
 
@@ -216,6 +216,26 @@ void Frame::init(float _mass, float hover_throttle, float _terminal_velocity, fl
 
     terminal_velocity = _terminal_velocity;
     terminal_rotation_rate = _terminal_rotation_rate;
+
+    // the arm and yaw torques of an untilted motor are a fixed
+    // multiple of its speed. These fudge factors match those in
+    // Motor::calculate_forces()
+    const float arm_scale = radians(5000);
+    const float yaw_scale = radians(400);
+    num_fixed_motors = 0;
+    have_tilt_motors = false;
+    for (uint8_t i=0; i<num_motors; i++) {
+        const Motor &m = motors[i];
+        if (m.roll_servo >= 0 || m.pitch_servo >= 0) {
+            have_tilt_motors = true;
+            continue;
+        }
+        fixed_servo[num_fixed_motors] = m.servo;
+        fixed_arm_x[num_fixed_motors] = arm_scale * cosf(radians(m.angle));
+        fixed_arm_y[num_fixed_motors] = arm_scale * sinf(radians(m.angle));
+        fixed_yaw[num_fixed_motors] = m.yaw_factor * yaw_scale;
+        num_fixed_motors++;
+    }
 }
 
 /*
@@ -240,11 +260,26 @@ void Frame::calculate_forces(const Aircraft &aircraft,
 {
     Vector3f thrust; // newtons
 
-    for (uint8_t i=0; i<num_motors; i++) {
-        Vector3f mraccel, mthrust;
-        motors[i].calculate_forces(input, thrust_scale, motor_offset, mraccel, mthrust);
-        rot_accel += mraccel;
-        thrust += mthrust;
+    // an untilted motor thrusts straight up, giving a torque of
+    // arm % (0,0,-speed) plus its yaw torque
+    for (uint8_t i=0; i<num_fixed_motors; i++) {
+        const float motor_speed = constrain_float((input.servos[motor_offset+fixed_servo[i]]-1100)/900.0, 0, 1);
+        rot_accel.x -= fixed_arm_y[i] * motor_speed;
+        rot_accel.y += fixed_arm_x[i] * motor_speed;
+        rot_accel.z += fixed_yaw[i] * motor_speed;
+        thrust.z -= motor_speed * thrust_scale;
+    }
+
+    if (have_tilt_motors) {
+        for (uint8_t i=0; i<num_motors; i++) {
+            if (motors[i].roll_servo < 0 && motors[i].pitch_servo < 0) {
+                continue;
+            }
+            Vector3f mraccel, mthrust;
+            motors[i].calculate_forces(input, thrust_scale, motor_offset, mraccel, mthrust);
+            rot_accel += mraccel;
+            thrust += mthrust;
+        }
     }
 
     body_accel = thrust/aircraft.gross_mass();
@@ -26,6 +26,9 @@ namespace SITL {
 /*
   class to describe a multicopter frame type
  */
+// most motors a frame can have, one per servo output
+#define SIM_FRAME_MAX_MOTORS 16
+
 class Frame {
 public:
     const char *name;
@@ -58,5 +61,18 @@ public:
 
     // calculate current and voltage
     void current_and_voltage(const struct sitl_input &input, float &voltage, float &current);
+
+private:
+    /*
+      the motors which can't tilt, packed by init() so
+      calculate_forces() can sum them in one pass. Motors which tilt
+      go through Motor::calculate_forces()
+     */
+    uint8_t num_fixed_motors;
+    uint8_t fixed_servo[SIM_FRAME_MAX_MOTORS];
+    float fixed_arm_x[SIM_FRAME_MAX_MOTORS];
+    float fixed_arm_y[SIM_FRAME_MAX_MOTORS];
+    float fixed_yaw[SIM_FRAME_MAX_MOTORS];
+    bool have_tilt_motors;
 };
 }
@@ -30,7 +30,8 @@ namespace SITL {
 Gazebo::Gazebo(const char *home_str, const char *frame_str) :
     Aircraft(home_str, frame_str),
     last_timestamp(0),
-    socket_sitl{true}
+    socket_sitl{true},
+    use_shm(false)
 {
     // try to bind to a specific port so that if we restart ArduPilot
     // Gazebo keeps sending us packets. Not strictly necessary but
@@ -43,6 +44,14 @@ Gazebo::Gazebo(const char *home_str, const char *frame_str) :
 */
 void Gazebo::set_interface_ports(const char* address, const int port_in, const int port_out)
 {
+    if (strncmp(address, "shm:", 4) == 0) {
+        if (!shm.open(address+4)) {
+            fprintf(stderr, "Abording launch...\n");
+            exit(1);
+        }
+        use_shm = true;
+        return;
+    }
     if (!socket_sitl.bind("0.0.0.0", port_in)) {
         fprintf(stderr, "SITL: socket in bind failed on sim in : %d  - %s\n", port_in, strerror(errno));
         fprintf(stderr, "Abording launch...\n");
@@ -69,7 +78,11 @@ void Gazebo::send_servos(const struct sitl_input &input)
     {
       pkt.motor_speed[i] = (input.servos[i]-1000) / 1000.0f;
     }
-    socket_sitl.sendto(&pkt, sizeof(pkt), _gazebo_address, _gazebo_port);
+    if (use_shm) {
+        shm.send(&pkt, sizeof(pkt));
+    } else {
+        socket_sitl.sendto(&pkt, sizeof(pkt), _gazebo_address, _gazebo_port);
+    }
 }
 
 /*
@@ -84,7 +97,7 @@ void Gazebo::recv_fdm(const struct sitl_input &input)
       we re-send the servo packet every 0.1 seconds until we get a
       reply. This allows us to cope with some packet loss to the FDM
      */
-    while (socket_sitl.recv(&pkt, sizeof(pkt), 100) != sizeof(pkt)) {
+    while ((use_shm ? shm.recv(&pkt, sizeof(pkt), 100) : socket_sitl.recv(&pkt, sizeof(pkt), 100)) != sizeof(pkt)) {
         send_servos(input);
         // Reset the timestamp after a long disconnection, also catch gazebo reset
         if (get_wall_time_us() > last_wall_time_us + GAZEBO_TIMEOUT_US) {
@@ -167,7 +180,9 @@ void Gazebo::update(const struct sitl_input &input)
     time_advance();
     // update magnetic field
     update_mag_field_bf();
-    drain_sockets();
+    if (!use_shm) {
+        drain_sockets();
+    }
 }
 
 }  // namespace SITL
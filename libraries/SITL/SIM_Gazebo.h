@@ -20,6 +20,7 @@
 
 #include "SIM_Aircraft.h"
 #include <AP_HAL/utility/Socket.h>
+#include "SIM_SharedMemory.h"
 
 namespace SITL {
 
@@ -38,7 +39,8 @@ public:
         return new Gazebo(home_str, frame_str);
     }
 
-    /*  Create and set in/out socket for Gazebo simulator */
+    /*  Create and set in/out socket for Gazebo simulator. An address
+        of shm:/name uses shared memory instead of sockets */
     void set_interface_ports(const char* address, const int port_in, const int port_out) override;
 
 private:
@@ -69,6 +71,8 @@ private:
     double last_timestamp;
 
     SocketAPM socket_sitl;
+    SharedMemoryFDM shm;
+    bool use_shm;
     const char *_gazebo_address = "127.0.0.1";
     int _gazebo_port = 9002;
     static const uint64_t GAZEBO_TIMEOUT_US = 5000000;
@@ -0,0 +1,142 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  shared memory transport for external simulators
+*/
+
+#include "SIM_SharedMemory.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+namespace SITL {
+
+SharedMemoryFDM::~SharedMemoryFDM()
+{
+    if (shm != nullptr) {
+        munmap(shm, sizeof(region));
+    }
+}
+
+bool SharedMemoryFDM::open(const char *name)
+{
+    const int fd = shm_open(name, O_RDWR | O_CREAT, 0666);
+    if (fd == -1) {
+        fprintf(stderr, "SITL: shm_open(%s) failed - %s\n", name, strerror(errno));
+        return false;
+    }
+    if (ftruncate(fd, sizeof(region)) != 0) {
+        fprintf(stderr, "SITL: ftruncate(%s) failed - %s\n", name, strerror(errno));
+        close(fd);
+        return false;
+    }
+    void *p = mmap(nullptr, sizeof(region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        fprintf(stderr, "SITL: mmap(%s) failed - %s\n", name, strerror(errno));
+        return false;
+    }
+    shm = (region *)p;
+
+    if (__atomic_load_n(&shm->magic, __ATOMIC_ACQUIRE) != SITL_SHM_MAGIC ||
+        shm->version != SITL_SHM_VERSION) {
+        // new region, or one left by an older version. The magic is
+        // written last so a simulator won't use a half set up region
+        memset(shm, 0, sizeof(region));
+        shm->version = SITL_SHM_VERSION;
+        __atomic_store_n(&shm->magic, SITL_SHM_MAGIC, __ATOMIC_RELEASE);
+    }
+    printf("SITL: using shared memory %s for the FDM\n", name);
+    return true;
+}
+
+bool SharedMemoryFDM::send(const void *pkt, uint32_t len)
+{
+    if (shm == nullptr || len > SITL_SHM_MAX_PACKET) {
+        return false;
+    }
+    memcpy(shm->servo_pkt, pkt, len);
+    shm->servo_len = len;
+    __atomic_add_fetch(&shm->servo_seq, 1, __ATOMIC_RELEASE);
+    wake_word(&shm->servo_seq);
+    return true;
+}
+
+ssize_t SharedMemoryFDM::recv(void *pkt, uint32_t len, uint32_t timeout_ms)
+{
+    if (shm == nullptr) {
+        return -1;
+    }
+    // only we write servo_seq
+    const uint32_t seq = shm->servo_seq;
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    const uint64_t start_us = ts.tv_sec*1000000ULL + ts.tv_nsec/1000;
+    const uint64_t timeout_us = timeout_ms * 1000ULL;
+
+    while (true) {
+        const uint32_t fdm_seq = __atomic_load_n(&shm->fdm_seq, __ATOMIC_ACQUIRE);
+        if (fdm_seq == seq) {
+            const uint32_t fdm_len = shm->fdm_len;
+            if (fdm_len > SITL_SHM_MAX_PACKET) {
+                return -1;
+            }
+            memcpy(pkt, shm->fdm_pkt, fdm_len < len ? fdm_len : len);
+            return fdm_len;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        const uint64_t elapsed_us = ts.tv_sec*1000000ULL + ts.tv_nsec/1000 - start_us;
+        if (elapsed_us >= timeout_us) {
+            return -1;
+        }
+        wait_word(&shm->fdm_seq, fdm_seq, timeout_us - elapsed_us);
+    }
+}
+
+void SharedMemoryFDM::wait_word(uint32_t *word, uint32_t value, uint32_t timeout_us)
+{
+#ifdef __linux__
+    // not FUTEX_PRIVATE, as the other side is another process
+    const struct timespec ts { time_t(timeout_us / 1000000), long(timeout_us % 1000000) * 1000 };
+    syscall(SYS_futex, word, FUTEX_WAIT, value, &ts, nullptr, 0);
+#else
+    (void)word;
+    (void)value;
+    usleep(timeout_us < 50 ? timeout_us : 50);
+#endif
+}
+
+void SharedMemoryFDM::wake_word(uint32_t *word)
+{
+#ifdef __linux__
+    syscall(SYS_futex, word, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+}  // namespace SITL
@@ -0,0 +1,97 @@
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+  shared memory transport for exchanging servo and FDM packets with an
+  external simulator on the same machine, without a socket syscall per
+  packet.
+
+  The region is a POSIX shared memory object (shm_open) of
+  SITL_SHM_REGION_SIZE bytes, laid out in native byte order as:
+
+    offset  size  field
+    0       4     magic, SITL_SHM_MAGIC ("APSM")
+    4       4     version, SITL_SHM_VERSION
+    8       4     servo_seq, incremented by ArduPilot after each servo packet
+    12      4     fdm_seq, set by the simulator to the servo_seq it answers
+    16      4     servo_len, length of the servo packet
+    20      4     fdm_len, length of the FDM packet
+    64      1024  servo packet
+    1088    1024  FDM packet
+
+  The packets are the fixed size binary structures of the backend using
+  the transport; for Gazebo they are its servo_packet and fdm_packet.
+
+  Each physics step ArduPilot writes the servo packet and its length,
+  then increments servo_seq. The simulator waits for servo_seq to
+  change, runs one step, writes the FDM packet and its length, then
+  sets fdm_seq to servo_seq. ArduPilot waits for fdm_seq to match
+  before reading the FDM packet, so the two run in lockstep and each
+  packet is only touched by one side at a time.
+
+  The sequence words are written with release and read with acquire
+  ordering. On Linux each side sleeps on the other's word with
+  FUTEX_WAIT and wakes the other with FUTEX_WAKE after writing its
+  own. A simulator may instead just poll the words.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#define SITL_SHM_MAGIC       0x4D535041
+#define SITL_SHM_VERSION     1
+#define SITL_SHM_MAX_PACKET  1024
+#define SITL_SHM_REGION_SIZE (64 + 2*SITL_SHM_MAX_PACKET)
+
+namespace SITL {
+
+class SharedMemoryFDM {
+public:
+    ~SharedMemoryFDM();
+
+    // open, creating if needed, the shared memory object called name,
+    // which should start with a '/'
+    bool open(const char *name);
+
+    // publish a servo packet for the simulator
+    bool send(const void *pkt, uint32_t len);
+
+    // wait up to timeout_ms for the simulator to answer the last servo
+    // packet, returning the length of the FDM packet or -1 on timeout
+    ssize_t recv(void *pkt, uint32_t len, uint32_t timeout_ms);
+
+private:
+    struct region {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t servo_seq;
+        uint32_t fdm_seq;
+        uint32_t servo_len;
+        uint32_t fdm_len;
+        uint8_t pad[40];
+        uint8_t servo_pkt[SITL_SHM_MAX_PACKET];
+        uint8_t fdm_pkt[SITL_SHM_MAX_PACKET];
+    };
+    static_assert(sizeof(region) == SITL_SHM_REGION_SIZE, "bad shared memory layout");
+
+    // sleep until *word is no longer value, or timeout_us passes
+    static void wait_word(uint32_t *word, uint32_t value, uint32_t timeout_us);
+    static void wake_word(uint32_t *word);
+
+    region *shm = nullptr;
+};
+
+}  // namespace SITL
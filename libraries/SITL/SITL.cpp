@@ -211,6 +211,10 @@ void SITL::Log_Write_SIMSTATE()
         q4      : state.quaternion.q4,
     };
     AP::logger().WriteBlock(&pkt, sizeof(pkt));
+
+    AP::logger().Write("SIMT", "TimeUS,Speedup", "Qf",
+                       pkt.time_us,
+                       (double)state.speedup);
 }
 
 /*
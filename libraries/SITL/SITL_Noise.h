@@ -0,0 +1,59 @@
+#pragma once
+
+#include <AP_Math/AP_Math.h>
+
+#define SITL_NOISE_BUFFER_SIZE 64
+
+namespace SITL {
+
+/*
+  a source of uniform noise between -1 and 1 for the simulated
+  sensors. Values are generated a buffer at a time with a xorshift
+  generator, which is much cheaper than rand_float() and its calls to
+  random(). Each sensor instance has its own, so their noise is
+  independent and repeatable
+ */
+class Noise {
+public:
+    void init(uint32_t seed) {
+        state = seed != 0 ? seed : 1;
+        idx = SITL_NOISE_BUFFER_SIZE;
+    }
+
+    float next(void) {
+        if (idx >= SITL_NOISE_BUFFER_SIZE) {
+            fill();
+        }
+        return buffer[idx++];
+    }
+
+    Vector3f next_vec3f(void) {
+        const float x = next();
+        const float y = next();
+        return Vector3f(x, y, next());
+    }
+
+private:
+    void fill(void) {
+        uint32_t raw[SITL_NOISE_BUFFER_SIZE];
+        uint32_t x = state;
+        for (uint8_t i=0; i<SITL_NOISE_BUFFER_SIZE; i++) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            raw[i] = x;
+        }
+        state = x;
+        // converted in a separate loop, which the compiler can vectorise
+        for (uint8_t i=0; i<SITL_NOISE_BUFFER_SIZE; i++) {
+            buffer[i] = int32_t(raw[i]) * (1.0f / 2147483648.0f);
+        }
+        idx = 0;
+    }
+
+    float buffer[SITL_NOISE_BUFFER_SIZE];
+    uint8_t idx = SITL_NOISE_BUFFER_SIZE;
+    uint32_t state = 1;
+};
+
+}
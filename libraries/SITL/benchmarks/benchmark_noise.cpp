@@ -0,0 +1,51 @@
+#include <AP_gbenchmark.h>
+
+#include <AP_Math/AP_Math.h>
+#include <SITL/SITL_Noise.h>
+
+/*
+  cost of the noise for one millisecond of simulated IMU data, for
+  three IMUs with accels and gyros sampled at 1kHz, from rand_float()
+  and from the buffered SITL::Noise sources the sensors use
+ */
+
+#define BENCH_IMUS 3
+
+// rand_float() is only built for SITL
+#if CONFIG_HAL_BOARD == HAL_BOARD_SITL
+static void BM_SensorNoiseRandFloat(benchmark::State& state)
+{
+    while (state.KeepRunning()) {
+        for (uint8_t i=0; i<BENCH_IMUS; i++) {
+            Vector3f accel(rand_float(), rand_float(), rand_float());
+            Vector3f gyro(rand_float(), rand_float(), rand_float());
+            gbenchmark_escape(&accel);
+            gbenchmark_escape(&gyro);
+        }
+    }
+}
+
+BENCHMARK(BM_SensorNoiseRandFloat);
+#endif
+
+static void BM_SensorNoiseBuffered(benchmark::State& state)
+{
+    SITL::Noise accel_noise[BENCH_IMUS];
+    SITL::Noise gyro_noise[BENCH_IMUS];
+    for (uint8_t i=0; i<BENCH_IMUS; i++) {
+        accel_noise[i].init(0x1000 + i);
+        gyro_noise[i].init(0x2000 + i);
+    }
+    while (state.KeepRunning()) {
+        for (uint8_t i=0; i<BENCH_IMUS; i++) {
+            Vector3f accel = accel_noise[i].next_vec3f();
+            Vector3f gyro = gyro_noise[i].next_vec3f();
+            gbenchmark_escape(&accel);
+            gbenchmark_escape(&gyro);
+        }
+    }
+}
+
+BENCHMARK(BM_SensorNoiseBuffered);
+
+BENCHMARK_MAIN()
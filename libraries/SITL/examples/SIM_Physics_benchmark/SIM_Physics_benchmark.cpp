@@ -0,0 +1,84 @@
+/*
+ *  Benchmark of the SITL physics models
+ *
+ *  steps quad, hexa, octa and heli models without syncing to the wall
+ *  clock and reports the steps per second each achieves. Run it with
+ *  any model, which is ignored, e.g.
+ *    build/sitl/examples/SIM_Physics_benchmark --model quad
+ */
+
+#include <AP_HAL/AP_HAL.h>
+#include <SITL/SITL.h>
+#include <SITL/SIM_Multicopter.h>
+#include <SITL/SIM_Helicopter.h>
+
+#include <time.h>
+
+const AP_HAL::HAL& hal = AP_HAL::get_HAL();
+
+void setup();
+void loop();
+
+#define BENCHMARK_STEPS     200000  // model updates timed for each frame
+
+// the models get their SIM_ parameters from here
+SITL::SITL sitl;
+
+static const char *home_str = "-35.363261,149.165230,584,353";
+
+static const struct {
+    const char *name;
+    SITL::Aircraft *(*create)(const char *home_str, const char *frame_str);
+} models[] = {
+    { "quad",  SITL::MultiCopter::create },
+    { "hexa",  SITL::MultiCopter::create },
+    { "octa",  SITL::MultiCopter::create },
+    { "heli",  SITL::Helicopter::create },
+};
+
+// the models are timed against the wall clock, not the simulated one
+static uint64_t wall_time_us()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec*1000000ULL + ts.tv_nsec/1000;
+}
+
+static void benchmark_model(const char *name, SITL::Aircraft *model)
+{
+    model->set_lockstep(true);
+
+    struct sitl_input input {};
+    for (uint8_t i=0; i<ARRAY_SIZE(input.servos); i++) {
+        input.servos[i] = 1500;
+    }
+
+    const uint64_t start_us = wall_time_us();
+    for (uint32_t i=0; i<BENCHMARK_STEPS; i++) {
+        // vary the outputs so the motors aren't all equal
+        input.servos[i % 8] = 1400 + (i % 200);
+        model->update(input);
+    }
+    const uint64_t elapsed_us = wall_time_us() - start_us;
+
+    hal.console->printf("%s: %.0f steps per second\n", name,
+                        (double)(BENCHMARK_STEPS * 1.0e6 / elapsed_us));
+}
+
+void setup()
+{
+    hal.console->printf("SITL physics benchmark\n");
+
+    for (uint8_t i=0; i<ARRAY_SIZE(models); i++) {
+        // the models are left allocated, as Aircraft has no virtual
+        // destructor
+        benchmark_model(models[i].name, models[i].create(home_str, models[i].name));
+    }
+}
+
+void loop()
+{
+    hal.scheduler->delay(1000);
+}
+
+AP_HAL_MAIN();
@@ -118,6 +118,19 @@ void SRV_Channel::calc_pwm(int16_t output_scaled)
         output_scaled = 0;
     }
 
+    if (calc_cache.valid &&
+        calc_cache.scaled == output_scaled &&
+        calc_cache.servo_min == servo_min &&
+        calc_cache.servo_max == servo_max &&
+        calc_cache.servo_trim == servo_trim &&
+        calc_cache.reversed == bool(reversed) &&
+        calc_cache.type_angle == type_angle &&
+        calc_cache.high_out == high_out) {
+        // nothing has changed since the last calculation
+        set_output_pwm(calc_cache.pwm);
+        return;
+    }
+
     uint16_t pwm;
     if (type_angle) {
         pwm = pwm_from_angle(output_scaled);
@@ -125,6 +138,16 @@ void SRV_Channel::calc_pwm(int16_t output_scaled)
         pwm = pwm_from_range(output_scaled);
     }
     set_output_pwm(pwm);
+
+    calc_cache.valid = true;
+    calc_cache.scaled = output_scaled;
+    calc_cache.servo_min = servo_min;
+    calc_cache.servo_max = servo_max;
+    calc_cache.servo_trim = servo_trim;
+    calc_cache.reversed = bool(reversed);
+    calc_cache.type_angle = type_angle;
+    calc_cache.high_out = high_out;
+    calc_cache.pwm = pwm;
 }
 
 void SRV_Channel::set_output_pwm(uint16_t pwm)
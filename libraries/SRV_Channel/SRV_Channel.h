@@ -241,6 +241,24 @@ private:
     // high point of angle or range output
     uint16_t high_out;
 
+    // what output_pwm was last calculated from. Outputs such as a
+    // camera trigger or gripper rarely change, so calc_pwm() only
+    // recalculates when the scaled value or the output range changes
+    struct {
+        bool valid;
+        bool reversed;
+        bool type_angle;
+        int16_t scaled;
+        uint16_t servo_min;
+        uint16_t servo_max;
+        uint16_t servo_trim;
+        uint16_t high_out;
+        uint16_t pwm;
+    } calc_cache;
+
+    // the last value given to hal.rcout->write()
+    uint16_t last_written_pwm;
+
     // convert a 0..range_max to a pwm
     uint16_t pwm_from_range(int16_t scaled_value) const;
 
@@ -503,6 +521,12 @@ private:
 #endif
     static uint16_t disabled_mask;
 
+    // mask of channels whose current output has been written to the
+    // HAL, so output_ch() only writes changes
+    static SRV_Channel::servo_mask_t written_mask;
+    static uint32_t last_full_output_ms;
+    static AP_HAL::Util::safety_state last_safety_state;
+
     // mask of outputs which use a digital output protocol, not
     // PWM (eg. DShot)
     static uint16_t digital_mask;
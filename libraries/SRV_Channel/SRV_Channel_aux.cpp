@@ -50,16 +50,36 @@ void SRV_Channel::output_ch(void)
             }
         }
     }
-    if (!(SRV_Channels::disabled_mask & (1U<<ch_num))) {
+    const SRV_Channel::servo_mask_t mask = 1U<<ch_num;
+    if (SRV_Channels::disabled_mask & mask) {
+        // write again when re-enabled, as something else has been
+        // driving the output
+        SRV_Channels::written_mask &= ~mask;
+    } else if (!(SRV_Channels::written_mask & mask) || output_pwm != last_written_pwm) {
         hal.rcout->write(ch_num, output_pwm);
+        last_written_pwm = output_pwm;
+        SRV_Channels::written_mask |= mask;
     }
 }
 
 /*
-  call output_ch() on all channels
+  call output_ch() on all channels. Only outputs which have changed are
+  written to the HAL, so the vehicle should cork() before and push()
+  after to send them together
  */
 void SRV_Channels::output_ch_all(void)
 {
+    // the HAL may output something other than what was written, such
+    // as the safety PWM while the safety switch is on, so write all
+    // outputs again when that changes, and once a second in case
+    // something else has written to the HAL
+    const AP_HAL::Util::safety_state safety = hal.util->safety_switch_state();
+    const uint32_t now_ms = AP_HAL::millis();
+    if (safety != last_safety_state || now_ms - last_full_output_ms >= 1000) {
+        written_mask = 0;
+        last_safety_state = safety;
+        last_full_output_ms = now_ms;
+    }
     for (uint8_t i = 0; i < NUM_SERVO_CHANNELS; i++) {
         channels[i].output_ch();
     }
@@ -157,6 +177,9 @@ void SRV_Channels::enable_aux_servos()
 
     update_aux_servo_function();
 
+    // write every output again on the next output_ch_all()
+    written_mask = 0;
+
     // enable all channels that are set to a valid function. This
     // includes k_none servos, which allows those to get their initial
     // trim value on startup
@@ -196,6 +219,7 @@ void SRV_Channels::enable_aux_servos()
 /// enable output channels using a channel mask
 void SRV_Channels::enable_by_mask(uint16_t mask)
 {
+    written_mask &= ~mask;
     for (uint8_t i = 0; i < 16; i++) {
         if (mask & (1U<<i)) {
             hal.rcout->enable_ch(i);
@@ -46,6 +46,9 @@ AP_BLHeli *SRV_Channels::blheli_ptr;
 #endif
 
 uint16_t SRV_Channels::disabled_mask;
+SRV_Channel::servo_mask_t SRV_Channels::written_mask;
+uint32_t SRV_Channels::last_full_output_ms;
+AP_HAL::Util::safety_state SRV_Channels::last_safety_state;
 uint16_t SRV_Channels::digital_mask;
 uint16_t SRV_Channels::reversible_mask;
 
@@ -0,0 +1,86 @@
+#include <AP_gbenchmark.h>
+
+#include <SRV_Channel/SRV_Channel.h>
+
+const AP_HAL::HAL &hal = AP_HAL::get_HAL();
+
+/*
+  cost of one output update for a 16 channel plane. Only the four
+  primary surfaces move each loop in BM_SRVChannelsPlane, while the
+  flaps, mount, camera, gripper and other auxiliary functions hold
+  their values, which is the usual case in flight.
+  BM_SRVChannelsPlaneAllMoving changes every output each loop for
+  comparison
+ */
+
+static SRV_Channels srv_channels;
+
+static const SRV_Channel::Aux_servo_function_t plane_functions[16] = {
+    SRV_Channel::k_aileron,
+    SRV_Channel::k_elevator,
+    SRV_Channel::k_throttle,
+    SRV_Channel::k_rudder,
+    SRV_Channel::k_flap_auto,
+    SRV_Channel::k_flap,
+    SRV_Channel::k_mount_pan,
+    SRV_Channel::k_mount_tilt,
+    SRV_Channel::k_cam_trigger,
+    SRV_Channel::k_gripper,
+    SRV_Channel::k_landing_gear_control,
+    SRV_Channel::k_parachute_release,
+    SRV_Channel::k_egg_drop,
+    SRV_Channel::k_steering,
+    SRV_Channel::k_dspoilerLeft1,
+    SRV_Channel::k_dspoilerRight1,
+};
+
+static void setup_plane(void)
+{
+    static bool done;
+    if (done) {
+        return;
+    }
+    done = true;
+    for (uint8_t i=0; i<ARRAY_SIZE(plane_functions); i++) {
+        SRV_Channels::set_aux_channel_default(plane_functions[i], i);
+    }
+    SRV_Channels::set_angle(SRV_Channel::k_aileron, 4500);
+    SRV_Channels::set_angle(SRV_Channel::k_elevator, 4500);
+    SRV_Channels::set_angle(SRV_Channel::k_rudder, 4500);
+    SRV_Channels::set_range(SRV_Channel::k_throttle, 100);
+}
+
+static void run_plane(benchmark::State& state, bool all_moving)
+{
+    setup_plane();
+    hal.rcout->cork();
+    int16_t v = 0;
+    while (state.KeepRunning()) {
+        v = (v + 37) % 4500;
+        SRV_Channels::set_output_scaled(SRV_Channel::k_aileron, v);
+        SRV_Channels::set_output_scaled(SRV_Channel::k_elevator, -v);
+        SRV_Channels::set_output_scaled(SRV_Channel::k_rudder, v/2);
+        SRV_Channels::set_output_scaled(SRV_Channel::k_throttle, v/45);
+        const int16_t aux = all_moving ? v/45 : 0;
+        for (uint8_t i=4; i<ARRAY_SIZE(plane_functions); i++) {
+            SRV_Channels::set_output_scaled(plane_functions[i], aux);
+        }
+        SRV_Channels::calc_pwm();
+        SRV_Channels::output_ch_all();
+    }
+}
+
+static void BM_SRVChannelsPlane(benchmark::State& state)
+{
+    run_plane(state, false);
+}
+
+static void BM_SRVChannelsPlaneAllMoving(benchmark::State& state)
+{
+    run_plane(state, true);
+}
+
+BENCHMARK(BM_SRVChannelsPlane);
+BENCHMARK(BM_SRVChannelsPlaneAllMoving);
+
+BENCHMARK_MAIN()